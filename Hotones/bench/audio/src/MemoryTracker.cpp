@@ -0,0 +1,4 @@
+// SoundBus counts its buffers in a Memory::TaggedBytes, which reports to
+// the engine's tracker; compile MemoryTracker.cpp into the bench rather
+// than linking the game, as the server does.
+#include "../../../src/Memory/MemoryTracker.cpp"
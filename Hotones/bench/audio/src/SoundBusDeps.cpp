@@ -0,0 +1,34 @@
+// The mixer lives in the engine's SoundBus.cpp; compile it into the bench
+// rather than linking the game.  The bench plays PCM from memory only, so
+// the asset lookups SoundBus.cpp makes for files get inert stand-ins
+// instead of the Vfs, the asset cache and their archive and cook code.
+#include "../../../src/SFX/SoundBus.cpp"
+
+namespace Hotones::Assets {
+
+Vfs& Vfs::Get()
+{
+    static Vfs s_instance;
+    return s_instance;
+}
+
+bool Vfs::Exists(const std::string& /*path*/) const { return false; }
+
+std::string NormalisePath(const std::string& path) { return path; }
+FileView    ReadFile(const std::string& /*path*/) { return {}; }
+
+AssetCache& AssetCache::Get()
+{
+    static AssetCache s_instance;
+    return s_instance;
+}
+
+WaveHandle AssetCache::LoadWave(const std::string& /*path*/) { return nullptr; }
+
+} // namespace Hotones::Assets
+
+namespace Ho_tones::Assets {
+
+bool FindAsset(const std::string& /*relativePath*/, std::string& /*outPath*/) { return false; }
+
+} // namespace Ho_tones::Assets
@@ -0,0 +1,155 @@
+// ---------------------------------------------------------------------------
+// Audio mixer benchmark suite.
+//
+// Build with meow from this directory, then run ./build/habenero-bench-audio.
+// Times SoundBus::MixInto, the audio thread's whole job, with 8, 32, 128
+// and 512 voices into stereo and 5.1 output at 48 kHz.  The voices play
+// PCM at 22050, 44100 and 48000 Hz, mono and stereo, so most of them go
+// through the resampler and the channel mapping; each reads its own
+// buffer (a tone of its own pitch) rather than all sharing one.
+//
+// ns/op is per MixInto call of one callback block.  Next to it each case
+// prints the share of the block's playing time the mix took: at 100% or
+// more the device would underrun (SoundBus::GetMixStats counts those in
+// the game).
+//
+// A SoundBus holds MAX_VOICES (64); larger cases mix that many per bus on
+// as many buses as it takes, each into its own buffer, and sum those into
+// the output — what the mixer's per-voice cost would come to with a
+// bigger pool.
+//
+//   --block <frames>        frames per MixInto call (default 512)
+//   --quick                 fewer mixes per case
+//   --json <file>           write every timing result as JSON
+//   --baseline <file>       compare against an earlier --json run
+//   --threshold <percent>   allowed slowdown per case (default 10)
+//
+// Needs no window or audio device: MixInto is called directly.
+// ---------------------------------------------------------------------------
+
+#include "Bench.hpp"
+
+#include <SoundBus.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Hotones::Bench;
+using Ho_tones::SoundBus;
+
+namespace {
+
+constexpr int   OUT_RATE       = 48000;
+constexpr float SOURCE_SECONDS = 1.0f;   // outlasts every timed run
+
+struct Format {
+    int rate;
+    int channels;
+};
+constexpr Format FORMATS[] = {
+    { 22050, 1 }, { 22050, 2 }, { 44100, 1 }, { 44100, 2 }, { 48000, 1 }, { 48000, 2 },
+};
+constexpr int FORMAT_COUNT = (int)(sizeof(FORMATS) / sizeof(FORMATS[0]));
+
+// A second of a quiet tone, `hz` on every channel
+std::vector<int16_t> MakeTone(const Format& fmt, float hz) {
+    const size_t frames = (size_t)(fmt.rate * SOURCE_SECONDS);
+    std::vector<int16_t> pcm(frames * (size_t)fmt.channels);
+    for (size_t i = 0; i < frames; ++i) {
+        const int16_t s = (int16_t)(2000.0f * std::sin(6.2831853f * hz * (float)i / (float)fmt.rate));
+        for (int c = 0; c < fmt.channels; ++c) pcm[i * fmt.channels + c] = s;
+    }
+    return pcm;
+}
+
+// `voices` tones, cycling through FORMATS, spread over as few buses as hold them
+struct Mixer {
+    std::vector<std::unique_ptr<SoundBus>> buses;
+    std::vector<float>                     scratch;   // one bus's mix, when there are several
+
+    void Start(const std::vector<std::vector<int16_t>>& tones, int voices, int outChannels) {
+        buses.clear();
+        for (int v = 0; v < voices; ++v) {
+            if (v % (int)SoundBus::MAX_VOICES == 0) buses.push_back(std::make_unique<SoundBus>());
+            const Format& fmt = FORMATS[v % FORMAT_COUNT];
+            buses.back()->PlayPCM(tones[v], fmt.rate, fmt.channels, 0.5f);
+        }
+        // One frame untimed, so the timed mixes don't include starting the voices
+        float frame[8];
+        for (auto& bus : buses) bus->MixInto(frame, 1, OUT_RATE, outChannels);
+    }
+
+    void Mix(float* out, size_t frames, int outChannels) {
+        buses[0]->MixInto(out, frames, OUT_RATE, outChannels);
+        const size_t samples = frames * (size_t)outChannels;
+        scratch.resize(samples);
+        for (size_t b = 1; b < buses.size(); ++b) {
+            buses[b]->MixInto(scratch.data(), frames, OUT_RATE, outChannels);
+            for (size_t i = 0; i < samples; ++i) out[i] += scratch[i];
+        }
+    }
+};
+
+void BenchMix(Suite& suite, int voices, int outChannels, size_t block, int mixes, int iterations) {
+    std::vector<std::vector<int16_t>> tones;
+    for (int v = 0; v < voices; ++v) tones.push_back(MakeTone(FORMATS[v % FORMAT_COUNT], 110.0f + 7.0f * v));
+
+    Mixer mixer;
+    std::vector<float> out(block * (size_t)outChannels);
+    const double ns = BestOfNs(iterations,
+        [&] { mixer.Start(tones, voices, outChannels); },
+        [&] {
+            for (int i = 0; i < mixes; ++i) mixer.Mix(out.data(), block, outChannels);
+            DoNotOptimize(out[0]);
+        });
+
+    const std::string name = "mix/" + std::to_string(voices) + "v/" + std::to_string(outChannels) + "ch";
+    suite.Time(name, (uint64_t)voices, (uint64_t)mixes, ns);
+    const double budgetNs = (double)block * 1e9 / OUT_RATE;
+    std::printf("  %6.2f%% of the %.2f ms budget  %7.1f ns/voice/mix\n", ns / mixes / budgetNs * 100.0,
+                budgetNs / 1e6, ns / mixes / voices);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    size_t      block     = 512;
+    int         mixes     = 200;
+    const char* jsonPath  = nullptr;
+    const char* basePath  = nullptr;
+    double      threshold = 10.0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if      (a == "--quick")                        mixes     = 20;
+        else if (a == "--block"     && i + 1 < argc)    block     = (size_t)std::max(1, std::atoi(argv[++i]));
+        else if (a == "--json"      && i + 1 < argc)    jsonPath  = argv[++i];
+        else if (a == "--baseline"  && i + 1 < argc)    basePath  = argv[++i];
+        else if (a == "--threshold" && i + 1 < argc)    threshold = std::atof(argv[++i]);
+        else { std::fprintf(stderr, "unknown argument: %s\n", argv[i]); return 1; }
+    }
+    // Every voice has to last the whole run
+    mixes = std::min<int>(mixes, (int)(SOURCE_SECONDS * OUT_RATE / (float)block) - 1);
+    if (mixes < 1) { std::fprintf(stderr, "--block too large\n"); return 1; }
+
+    std::printf("MixInto, %zu frames per call at %d Hz (%d calls per run)\n", block, OUT_RATE, mixes);
+    Suite suite("audio");
+    for (int channels : { 2, 6 }) {
+        std::printf("\n%d-channel output\n", channels);
+        for (int voices : { 8, 32, 128, 512 })
+            BenchMix(suite, voices, channels, block, mixes, 5);
+    }
+
+    if (jsonPath && !suite.WriteJson(jsonPath)) return 1;
+    if (basePath) {
+        const int regressions = suite.Compare(basePath, threshold);
+        if (regressions < 0) return 1;
+        std::printf("%d regression(s)\n", regressions);
+        return regressions > 0 ? 2 : 0;
+    }
+    return 0;
+}
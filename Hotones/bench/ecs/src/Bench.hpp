@@ -0,0 +1,171 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Bench.hpp — minimal timing helpers and result collection shared by the
+// ECS benchmarks.
+// ---------------------------------------------------------------------------
+
+namespace Hotones::Bench {
+
+// Prevent the optimiser from discarding a computed value.
+template<typename T>
+inline void DoNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Run fn `iterations` times and return the best wall-clock time in ns.
+// The best-of-N is less noisy than the mean on a busy desktop.
+template<typename Fn>
+[[nodiscard]] inline double BestOfNs(int iterations, Fn&& fn) {
+    double best = 1e30;
+    for (int i = 0; i < iterations; ++i) {
+        const auto t0 = std::chrono::steady_clock::now();
+        fn();
+        const auto t1 = std::chrono::steady_clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        if (ns < best) best = ns;
+    }
+    return best;
+}
+
+// Like BestOfNs, but setup() runs before every iteration outside the timed
+// region (e.g. to repopulate a registry that the timed body destroys).
+template<typename Setup, typename Fn>
+[[nodiscard]] inline double BestOfNs(int iterations, Setup&& setup, Fn&& fn) {
+    double best = 1e30;
+    for (int i = 0; i < iterations; ++i) {
+        setup();
+        const auto t0 = std::chrono::steady_clock::now();
+        fn();
+        const auto t1 = std::chrono::steady_clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        if (ns < best) best = ns;
+    }
+    return best;
+}
+
+inline void Report(const char* name, double ns, uint64_t ops) {
+    std::printf("%-40s %12.0f ns  %8.2f ns/op\n", name, ns, ops ? ns / double(ops) : 0.0);
+}
+
+// ---------------------------------------------------------------------------
+// Suite — collects results, writes them as JSON and compares two runs.
+//
+// The JSON keeps one result per line so a plain text diff of two runs
+// lines up case by case:
+//
+//   {"suite": "ecs", "results": [
+//     {"name": "view2/100000", "entities": 100000, "ops": 50000, "ns": 101234, "ns_per_op": 2.02, "bytes": 0},
+//     ...
+//   ]}
+//
+// Timing cases are compared by ns_per_op, memory cases (ops == 0) by bytes.
+// ---------------------------------------------------------------------------
+class Suite {
+public:
+    struct Result {
+        std::string name;
+        uint64_t    entities = 0;
+        uint64_t    ops      = 0;
+        double      ns       = 0.0;
+        uint64_t    bytes    = 0;
+
+        [[nodiscard]] double Metric() const {
+            return ops ? ns / double(ops) : double(bytes);
+        }
+    };
+
+    explicit Suite(std::string name) : m_name(std::move(name)) {}
+
+    void Time(const std::string& name, uint64_t entities, uint64_t ops, double ns) {
+        m_results.push_back({ name, entities, ops, ns, 0 });
+        Report(name.c_str(), ns, ops);
+    }
+
+    void Memory(const std::string& name, uint64_t entities, uint64_t bytes) {
+        m_results.push_back({ name, entities, 0, 0.0, bytes });
+        std::printf("%-40s %12llu bytes  %8.2f B/entity\n", name.c_str(),
+                    static_cast<unsigned long long>(bytes),
+                    entities ? double(bytes) / double(entities) : 0.0);
+    }
+
+    [[nodiscard]] const std::vector<Result>& Results() const { return m_results; }
+
+    bool WriteJson(const char* path) const {
+        FILE* f = std::fopen(path, "w");
+        if (!f) { std::fprintf(stderr, "bench: cannot write %s\n", path); return false; }
+        std::fprintf(f, "{\"suite\": \"%s\", \"results\": [\n", m_name.c_str());
+        for (size_t i = 0; i < m_results.size(); ++i) {
+            const Result& r = m_results[i];
+            std::fprintf(f,
+                "  {\"name\": \"%s\", \"entities\": %llu, \"ops\": %llu, \"ns\": %.0f, "
+                "\"ns_per_op\": %.4f, \"bytes\": %llu}%s\n",
+                r.name.c_str(), static_cast<unsigned long long>(r.entities),
+                static_cast<unsigned long long>(r.ops), r.ns,
+                r.ops ? r.ns / double(r.ops) : 0.0,
+                static_cast<unsigned long long>(r.bytes),
+                i + 1 < m_results.size() ? "," : "");
+        }
+        std::fprintf(f, "]}\n");
+        std::fclose(f);
+        return true;
+    }
+
+    // Read results previously written by WriteJson (one object per line).
+    static std::vector<Result> ReadJson(const char* path) {
+        std::vector<Result> out;
+        FILE* f = std::fopen(path, "r");
+        if (!f) { std::fprintf(stderr, "bench: cannot read %s\n", path); return out; }
+        char line[512];
+        while (std::fgets(line, sizeof(line), f)) {
+            char               name[256];
+            unsigned long long entities = 0, ops = 0, bytes = 0;
+            double             ns = 0.0, perOp = 0.0;
+            const char*        p = std::strstr(line, "{\"name\"");
+            if (!p) continue;
+            if (std::sscanf(p,
+                    "{\"name\": \"%255[^\"]\", \"entities\": %llu, \"ops\": %llu, \"ns\": %lf, "
+                    "\"ns_per_op\": %lf, \"bytes\": %llu}",
+                    name, &entities, &ops, &ns, &perOp, &bytes) == 6)
+                out.push_back({ name, entities, ops, ns, bytes });
+        }
+        std::fclose(f);
+        return out;
+    }
+
+    // Compare against a baseline file.  Prints every case present in both
+    // and returns the number that got worse by more than thresholdPct.
+    int Compare(const char* baselinePath, double thresholdPct) const {
+        const std::vector<Result> base = ReadJson(baselinePath);
+        if (base.empty()) return -1;
+
+        int regressions = 0;
+        std::printf("\nCompared with %s (threshold %.1f%%)\n", baselinePath, thresholdPct);
+        for (const Result& cur : m_results) {
+            for (const Result& old : base) {
+                if (old.name != cur.name) continue;
+                const double a = old.Metric(), b = cur.Metric();
+                const double delta = a > 0.0 ? (b - a) / a * 100.0 : 0.0;
+                const bool   worse = delta > thresholdPct;
+                regressions += worse ? 1 : 0;
+                std::printf("%-40s %10.2f -> %10.2f  %+7.1f%%%s\n", cur.name.c_str(), a, b, delta,
+                            worse ? "  REGRESSION" : "");
+                break;
+            }
+        }
+        return regressions;
+    }
+
+private:
+    std::string         m_name;
+    std::vector<Result> m_results;
+};
+
+} // namespace Hotones::Bench
@@ -0,0 +1,366 @@
+// ---------------------------------------------------------------------------
+// ECS benchmark suite.
+//
+// Build with meow from this directory, then run ./build/habenero-bench-ecs.
+//
+//   --quick                 skip the 1M-entity cases
+//   --json <file>           write every result as JSON
+//   --baseline <file>       compare against an earlier --json run
+//   --threshold <percent>   allowed slowdown per case (default 10)
+//
+// With --baseline the exit code is 2 when any case regressed (1 on usage or
+// I/O errors), so a CI job can gate Registry.hpp / ComponentPool.hpp
+// changes on it:
+//
+//   habenero-bench-ecs --json new.json --baseline main.json
+// ---------------------------------------------------------------------------
+
+#include "Bench.hpp"
+
+#include <ECS/ECS.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+using namespace Hotones::ECS;
+using namespace Hotones::Bench;
+
+namespace {
+
+// The pool table the Registry used before ComponentTypeId: one hash lookup
+// per Pool<T>() / PoolPtr<T>() call.
+struct TypeIndexTable {
+    std::unordered_map<std::type_index, std::unique_ptr<IPool>> pools;
+
+    template<typename T>
+    ComponentPool<T>* Get() {
+        const auto it = pools.find(std::type_index(typeid(T)));
+        return it != pools.end() ? static_cast<ComponentPool<T>*>(it->second.get()) : nullptr;
+    }
+};
+
+// The current layout: flat vector indexed by ComponentTypeId.
+struct TypeIdTable {
+    std::vector<std::unique_ptr<IPool>> pools;
+
+    template<typename T>
+    ComponentPool<T>* Get() {
+        const ComponentTypeId id = ComponentType<T>();
+        return id < pools.size() ? static_cast<ComponentPool<T>*>(pools[id].get()) : nullptr;
+    }
+};
+
+void Install(TypeIndexTable& table, IPool* t, IPool* v) {
+    table.pools.emplace(std::type_index(typeid(TransformComponent)), std::unique_ptr<IPool>(t));
+    table.pools.emplace(std::type_index(typeid(VelocityComponent)),  std::unique_ptr<IPool>(v));
+}
+
+void Install(TypeIdTable& table, IPool* t, IPool* v) {
+    const ComponentTypeId tid = ComponentType<TransformComponent>();
+    const ComponentTypeId vid = ComponentType<VelocityComponent>();
+    table.pools.resize(std::max(tid, vid) + 1);
+    table.pools[tid].reset(t);
+    table.pools[vid].reset(v);
+}
+
+// Every entity gets a Transform, every other entity a Velocity.
+template<typename Table>
+void Populate(Table& table, uint32_t count) {
+    auto* tp = new ComponentPool<TransformComponent>();
+    auto* vp = new ComponentPool<VelocityComponent>();
+    for (uint32_t i = 0; i < count; ++i) {
+        tp->Emplace(i);
+        if (i % 2 == 0) vp->Emplace(i);
+    }
+    Install(table, tp, vp);
+}
+
+// The old View inner loop: re-resolve every pool for every entity.
+template<typename Table>
+uint64_t IntersectLoop(Table& table, uint32_t count) {
+    uint64_t hits = 0;
+    for (uint32_t idx = 0; idx < count; ++idx) {
+        auto* t = table.template Get<TransformComponent>();
+        auto* v = table.template Get<VelocityComponent>();
+        if (t && v && t->Has(idx) && v->Has(idx)) ++hits;
+    }
+    return hits;
+}
+
+// Spawn `count` projectile-like entities; every `stride`-th one is expired.
+std::vector<EntityId> SpawnProjectiles(Registry& reg, uint32_t count, uint32_t stride) {
+    std::vector<EntityId> expired;
+    for (uint32_t i = 0; i < count; ++i) {
+        const EntityId e = reg.CreateEntity();
+        reg.AddComponent<TransformComponent>(e);
+        reg.AddComponent<VelocityComponent>(e);
+        reg.AddComponent<LifetimeComponent>(e, i % stride == 0 ? 0.0f : 10.0f);
+        if (i % stride == 0) expired.push_back(e);
+    }
+    return expired;
+}
+
+// Every entity gets a Transform, every 2nd a Velocity, every 4th a Lifetime,
+// so View<T>, View<T,V> and View<T,V,L> visit N, N/2 and N/4 entities.
+void PopulateMixed(Registry& reg, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        const EntityId e = reg.CreateEntity();
+        reg.AddComponent<TransformComponent>(e);
+        if (i % 2 == 0) reg.AddComponent<VelocityComponent>(e);
+        if (i % 4 == 0) reg.AddComponent<LifetimeComponent>(e);
+    }
+}
+
+std::string CaseName(const char* base, uint32_t count) {
+    return std::string(base) + "/" + std::to_string(count);
+}
+
+// Best-of-N time of DestroyEntity over the expired set; the spawn is not timed.
+double DespawnNs(int runs, uint32_t count, uint32_t stride) {
+    std::unique_ptr<Registry> reg;
+    std::vector<EntityId>     expired;
+    return BestOfNs(runs,
+        [&] {
+            reg = std::make_unique<Registry>();
+            // Register unrelated pools so a destroy that visits every pool pays for them.
+            (void)reg->Pool<TagComponent>();
+            (void)reg->Pool<HealthComponent>();
+            (void)reg->Pool<ColliderSphereComponent>();
+            expired = SpawnProjectiles(*reg, count, stride);
+        },
+        [&] {
+            for (EntityId e : expired) reg->DestroyEntity(e);
+            DoNotOptimize(reg->EntityCount());
+        });
+}
+
+// The alive-list removal DestroyEntity used to do: std::find + erase.
+double FindEraseNs(int runs, uint32_t count, uint32_t stride) {
+    std::vector<EntityId> alive;
+    return BestOfNs(runs,
+        [&] {
+            alive.resize(count);
+            for (uint32_t i = 0; i < count; ++i) alive[i] = MakeEntity(i, 0);
+        },
+        [&] {
+            for (uint32_t i = 0; i < count; i += stride) {
+                auto it = std::find(alive.begin(), alive.end(), MakeEntity(i, 0));
+                if (it != alive.end()) alive.erase(it);
+            }
+            DoNotOptimize(alive.size());
+        });
+}
+
+// ── Cases ─────────────────────────────────────────────────────────────────────
+
+void BenchLookup(Suite& suite, int runs) {
+    constexpr uint32_t N = 100000;
+    TypeIndexTable mapTable;
+    TypeIdTable    idTable;
+    Populate(mapTable, N);
+    Populate(idTable,  N);
+
+    std::printf("\nPool lookup — %u entities\n", N);
+    suite.Time("lookup/type_index_map", N, N,
+               BestOfNs(runs, [&] { DoNotOptimize(IntersectLoop(mapTable, N)); }));
+    suite.Time("lookup/type_id_vector", N, N,
+               BestOfNs(runs, [&] { DoNotOptimize(IntersectLoop(idTable, N)); }));
+}
+
+// Create `count` entities with two components, then destroy them all.
+void BenchChurn(Suite& suite, uint32_t count, int runs) {
+    Registry reg;
+    std::vector<EntityId> ids(count);
+    const double ns = BestOfNs(runs, [&] {
+        for (uint32_t i = 0; i < count; ++i) {
+            ids[i] = reg.CreateEntity();
+            reg.AddComponent<TransformComponent>(ids[i]);
+            reg.AddComponent<VelocityComponent>(ids[i]);
+        }
+        for (uint32_t i = 0; i < count; ++i) reg.DestroyEntity(ids[i]);
+    });
+    suite.Time(CaseName("churn", count), count, count, ns);
+}
+
+void BenchQueries(Suite& suite, uint32_t count, int runs) {
+    Registry reg;
+    PopulateMixed(reg, count);
+    std::printf("\nQueries — %u entities\n", count);
+
+    suite.Time(CaseName("view1", count), count, count, BestOfNs(runs, [&] {
+        reg.View<TransformComponent>(
+            [](EntityId, TransformRef t) { t.position.x += 1.0f; });
+    }));
+    suite.Time(CaseName("view2", count), count, count / 2, BestOfNs(runs, [&] {
+        reg.View<TransformComponent, VelocityComponent>(
+            [](EntityId, TransformRef t, VelocityRef v) { t.position.x += v.linear.x; });
+    }));
+    suite.Time(CaseName("view3", count), count, count / 4, BestOfNs(runs, [&] {
+        reg.View<TransformComponent, VelocityComponent, LifetimeComponent>(
+            [](EntityId, TransformRef t, VelocityRef v, LifetimeComponent& l) {
+                t.position.x += v.linear.x * l.remaining;
+            });
+    }));
+    suite.Time(CaseName("each", count), count, count, BestOfNs(runs, [&] {
+        reg.Each<TransformComponent>(
+            [](EntityId, TransformRef t) { t.position.x += 1.0f; });
+    }));
+    suite.Time(CaseName("parallel_view2", count), count, count / 2, BestOfNs(runs, [&] {
+        reg.ParallelView<TransformComponent, VelocityComponent>(
+            [](EntityId, TransformRef t, VelocityRef v) { t.position.x += v.linear.x; });
+    }));
+
+    // Random access: GetComponent over the live entities in shuffled order.
+    std::vector<EntityId> order = reg.Entities();
+    std::shuffle(order.begin(), order.end(), std::mt19937(1234));
+    suite.Time(CaseName("get_random", count), count, count, BestOfNs(runs, [&] {
+        float sum = 0.0f;
+        for (EntityId e : order) sum += reg.GetComponent<TransformComponent>(e).position.x;
+        DoNotOptimize(sum);
+    }));
+
+    suite.Memory(CaseName("memory/transform_pool", count), count,
+                 reg.PoolMemory<TransformComponent>().TotalBytes());
+    suite.Memory(CaseName("memory/all_pools", count), count, reg.MemoryStats().TotalBytes());
+
+    // Owning group last: it re-sorts the pools the cases above walked.
+    auto movers = reg.Group<TransformComponent, VelocityComponent>();
+    suite.Time(CaseName("group2_each", count), count, movers.Size(), BestOfNs(runs, [&] {
+        movers.Each([](EntityId, TransformRef t, VelocityRef v) { t.position.x += v.linear.x; });
+    }));
+
+    // Transform is stored SoA: the position array alone, as a SIMD kernel sees it.
+    suite.Time(CaseName("group2_position_stream", count), count, movers.Size(), BestOfNs(runs, [&] {
+        Vector3*                 pos = movers.Field<&TransformComponent::position>();
+        const Vector3*           vel = movers.Field<&VelocityComponent::linear>();
+        const size_t             n   = movers.Size();
+        for (size_t i = 0; i < n; ++i) {
+            pos[i].x += vel[i].x;
+            pos[i].y += vel[i].y;
+            pos[i].z += vel[i].z;
+        }
+        DoNotOptimize(pos[0]);
+    }));
+
+    // Built-in systems under the scheduler (dt small enough that nothing expires).
+    SystemScheduler systems;
+    systems.Add<MovementSystem>();
+    systems.Add<LifetimeSystem>();
+    systems.Init(reg);
+    suite.Time(CaseName("system/movement_lifetime", count), count, movers.Size() + count / 4,
+               BestOfNs(runs, [&] { systems.Update(reg, 1e-6f); }));
+    systems.Shutdown(reg);
+}
+
+// Mass despawn: 10% of the projectiles expire in one frame.
+void BenchDespawn(Suite& suite, int runs) {
+    constexpr uint32_t N      = 100000;
+    constexpr uint32_t STRIDE = 10;
+    std::printf("\nDespawn — %u of %u entities\n", N / STRIDE, N);
+    suite.Time("despawn/find_erase_reference", N, N / STRIDE, FindEraseNs(runs, N, STRIDE));
+    suite.Time("despawn/destroy_entity",       N, N / STRIDE, DespawnNs(runs, N, STRIDE));
+}
+
+// Sparse memory: one rare component on a high entity index.
+void BenchSparseMemory(Suite& suite) {
+    constexpr uint32_t N = 900001;
+    Registry reg;
+    EntityId last = INVALID_ENTITY;
+    for (uint32_t i = 0; i < N; ++i) last = reg.CreateEntity();
+    reg.AddComponent<PlayerComponent>(last);
+    std::printf("\nSparse memory — PlayerComponent on entity #%u\n", N - 1);
+    suite.Memory("memory/rare_high_index", 1, reg.PoolMemory<PlayerComponent>().TotalBytes());
+}
+
+// 64-byte payloads, once in a vector-backed pool and once in a stable one.
+struct FatComponent       { float data[16] = {}; };
+struct StableFatComponent { float data[16] = {}; };
+
+} // namespace
+
+template<> struct Hotones::ECS::ComponentTraits<StableFatComponent> : DefaultComponentTraits {
+    static constexpr bool stableStorage = true;
+};
+
+namespace {
+
+// Slowest single AddComponent while a pool grows to `count` (best of
+// `runs`): the vector pool pays a full copy at every reallocation, the
+// chunked one never does.
+template<typename T>
+double WorstAddNs(int runs, uint32_t count) {
+    double best = 1e30;
+    for (int r = 0; r < runs; ++r) {
+        Registry reg;
+        double worst = 0.0;
+        for (uint32_t i = 0; i < count; ++i) {
+            const EntityId e  = reg.CreateEntity();
+            const auto     t0 = std::chrono::steady_clock::now();
+            reg.AddComponent<T>(e);
+            const auto     t1 = std::chrono::steady_clock::now();
+            worst = std::max(worst, std::chrono::duration<double, std::nano>(t1 - t0).count());
+        }
+        best = std::min(best, worst);
+    }
+    return best;
+}
+
+void BenchStableGrowth(Suite& suite, int runs) {
+    constexpr uint32_t N = 200000;
+    std::printf("\nPool growth — worst single add of %u\n", N);
+    suite.Time("grow_worst_add/vector", N, 1, WorstAddNs<FatComponent>(runs, N));
+    suite.Time("grow_worst_add/stable", N, 1, WorstAddNs<StableFatComponent>(runs, N));
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bool        quick     = false;
+    const char* jsonPath  = nullptr;
+    const char* basePath  = nullptr;
+    double      threshold = 10.0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if      (a == "--quick")                        quick     = true;
+        else if (a == "--json"      && i + 1 < argc)    jsonPath  = argv[++i];
+        else if (a == "--baseline"  && i + 1 < argc)    basePath  = argv[++i];
+        else if (a == "--threshold" && i + 1 < argc)    threshold = std::atof(argv[++i]);
+        else { std::fprintf(stderr, "unknown argument: %s\n", argv[i]); return 1; }
+    }
+
+    Suite suite("ecs");
+    BenchLookup(suite, 20);
+
+    std::printf("\nCreate / destroy churn\n");
+    BenchChurn(suite, 10000,  20);
+    BenchChurn(suite, 100000, 10);
+
+    BenchQueries(suite, 10000,  50);
+    BenchQueries(suite, 100000, 20);
+    if (!quick) {
+        BenchChurn(suite, 1000000, 3);
+        BenchQueries(suite, 1000000, 5);
+    }
+
+    BenchDespawn(suite, 5);
+    BenchSparseMemory(suite);
+    BenchStableGrowth(suite, 3);
+
+    if (jsonPath && !suite.WriteJson(jsonPath)) return 1;
+    if (basePath) {
+        const int regressions = suite.Compare(basePath, threshold);
+        if (regressions < 0) return 1;
+        std::printf("%d regression(s)\n", regressions);
+        return regressions > 0 ? 2 : 0;
+    }
+    return 0;
+}
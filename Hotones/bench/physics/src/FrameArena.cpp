@@ -0,0 +1,4 @@
+// Scene::Update keeps its per-step scratch in Memory::FrameVector; compile
+// the engine's FrameArena.cpp (and MemoryTracker.cpp, which it reports to)
+// into the bench rather than linking the game, as the server does.
+#include "../../../src/Memory/FrameArena.cpp"
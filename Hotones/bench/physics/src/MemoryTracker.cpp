@@ -0,0 +1,2 @@
+// What FrameArena.cpp reports its bytes to; see FrameArena.cpp
+#include "../../../src/Memory/MemoryTracker.cpp"
@@ -0,0 +1,9 @@
+// The job system's workers name their threads and the code under test opens
+// zones for the engine's profiler; compile its Profiler.cpp into the bench
+// rather than linking the game, as the server does.  The bench links
+// neither raylib nor GL, so the two rlgl calls behind its GPU timers get
+// stand-ins that keep the timers off (as in the server's RaylibStandIns.cpp).
+#include "../../../src/Profile/Profiler.cpp"
+
+int  rlGetVersion() { return RL_OPENGL_11; }
+void rlDrawRenderBatchActive() {}
@@ -0,0 +1,4 @@
+// The rigid-body Scene lives in the engine's physics.cpp, which needs only
+// raymath and the job system; compile it into the bench rather than
+// linking the game.
+#include "../../../src/Physics/physics.cpp"
@@ -0,0 +1,356 @@
+// ---------------------------------------------------------------------------
+// Physics BVH benchmark suite.
+//
+// Build with meow from this directory, then run ./build/habenero-bench-physics.
+// Builds the static-mesh BVH with every BVHBuildQuality, collapses each into
+// the 4-wide QBVH the engine queries, and compares build time, tree shape,
+// node visits per query and query time for rays, sphere sweeps and
+// penetration tests.  For the QBVH, nodes/query counts child boxes tested
+// and tris/query the triangle lanes tested.  A second part steps the
+// rigid-body Scene (Physics/physics.h) with 10, 100 and 1000 spheres.
+//
+//   --model <file.obj>      triangle soup to test (default ../../assets/Home.obj,
+//                           exported from assets/Home.blend)
+//   --queries <n>           queries per kind (default 20000)
+//   --quick                 2000 queries per kind
+//   --json <file>           write every timing result as JSON
+//   --baseline <file>       compare against an earlier --json run
+//   --threshold <percent>   allowed slowdown per case (default 10)
+//
+// When the model cannot be read a procedural house (rooms, walls with
+// doorways, furniture boxes) stands in, so the suite always runs.
+// ---------------------------------------------------------------------------
+
+#include "Bench.hpp"
+
+#include <Physics/BVH.hpp>
+#include <Physics/QBVH.hpp>
+#include <Physics/physics.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Hotones::Physics;
+using namespace Hotones::Bench;
+
+namespace {
+
+Tri MakeTri(Vector3 a, Vector3 b, Vector3 c) {
+    Tri t;
+    t.a = a; t.b = b; t.c = c;
+    t.centroid = v3scale(v3add(a, v3add(b, c)), 1.f / 3.f);
+    return t;
+}
+
+// Minimal Wavefront OBJ reader: `v` positions and `f` polygons (fan
+// triangulated, v/vt/vn and negative indices accepted).  Everything else
+// is ignored — the BVH only needs positions.
+bool LoadObjTriangles(const char* path, std::vector<Tri>& out) {
+    FILE* f = std::fopen(path, "r");
+    if (!f) return false;
+    std::vector<Vector3> verts;
+    char line[1024];
+    while (std::fgets(line, sizeof(line), f)) {
+        if (line[0] == 'v' && line[1] == ' ') {
+            Vector3 v{};
+            if (std::sscanf(line + 2, "%f %f %f", &v.x, &v.y, &v.z) == 3) verts.push_back(v);
+        } else if (line[0] == 'f' && line[1] == ' ') {
+            int  idx[64];
+            int  n = 0;
+            char* p = line + 2;
+            while (n < 64) {
+                char* endp = nullptr;
+                const long i = std::strtol(p, &endp, 10);
+                if (endp == p) break;
+                idx[n++] = i < 0 ? (int)verts.size() + (int)i : (int)i - 1;
+                p = endp;
+                while (*p && *p != ' ' && *p != '\t') ++p;   // skip /vt/vn
+            }
+            for (int k = 0; k < n; ++k)
+                if (idx[k] < 0 || idx[k] >= (int)verts.size()) n = 0;
+            for (int k = 2; k < n; ++k)
+                out.push_back(MakeTri(verts[idx[0]], verts[idx[k - 1]], verts[idx[k]]));
+        }
+    }
+    std::fclose(f);
+    return !out.empty();
+}
+
+// Axis-aligned quad split into cells×cells pairs of triangles, the way
+// exported level geometry usually arrives.
+void AddQuad(std::vector<Tri>& out, Vector3 o, Vector3 u, Vector3 v, int cells) {
+    for (int i = 0; i < cells; ++i)
+        for (int j = 0; j < cells; ++j) {
+            const float s0 = float(i) / cells, s1 = float(i + 1) / cells;
+            const float t0 = float(j) / cells, t1 = float(j + 1) / cells;
+            auto at = [&](float s, float t) { return v3add(o, v3add(v3scale(u, s), v3scale(v, t))); };
+            out.push_back(MakeTri(at(s0, t0), at(s1, t0), at(s1, t1)));
+            out.push_back(MakeTri(at(s0, t0), at(s1, t1), at(s0, t1)));
+        }
+}
+
+void AddBox(std::vector<Tri>& out, Vector3 mn, Vector3 mx) {
+    const Vector3 e = v3sub(mx, mn);
+    AddQuad(out, mn, { e.x, 0, 0 }, { 0, 0, e.z }, 1);
+    AddQuad(out, { mn.x, mx.y, mn.z }, { e.x, 0, 0 }, { 0, 0, e.z }, 1);
+    AddQuad(out, mn, { e.x, 0, 0 }, { 0, e.y, 0 }, 1);
+    AddQuad(out, { mn.x, mn.y, mx.z }, { e.x, 0, 0 }, { 0, e.y, 0 }, 1);
+    AddQuad(out, mn, { 0, 0, e.z }, { 0, e.y, 0 }, 1);
+    AddQuad(out, { mx.x, mn.y, mn.z }, { 0, 0, e.z }, { 0, e.y, 0 }, 1);
+}
+
+// A grid of rooms with tessellated floors, ceilings and walls (each with a
+// doorway gap) plus a few furniture boxes per room: large, thin, axis-aligned
+// triangles next to small clutter — the case where mean splits do badly.
+std::vector<Tri> MakeHouse(int rooms, uint32_t seed) {
+    const float ROOM = 6.f, HEIGHT = 3.f, DOOR = 1.2f;
+    std::vector<Tri> out;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> u01(0.f, 1.f);
+    for (int rx = 0; rx < rooms; ++rx)
+        for (int rz = 0; rz < rooms; ++rz) {
+            const float x = rx * ROOM, z = rz * ROOM;
+            AddQuad(out, { x, 0, z },      { ROOM, 0, 0 }, { 0, 0, ROOM }, 8);
+            AddQuad(out, { x, HEIGHT, z }, { ROOM, 0, 0 }, { 0, 0, ROOM }, 4);
+            // Two walls per room (the neighbours supply the others), split
+            // around a doorway in the middle
+            const float side = (ROOM - DOOR) * 0.5f;
+            AddQuad(out, { x, 0, z },                { side, 0, 0 }, { 0, HEIGHT, 0 }, 3);
+            AddQuad(out, { x + side + DOOR, 0, z },  { side, 0, 0 }, { 0, HEIGHT, 0 }, 3);
+            AddQuad(out, { x, 0, z },                { 0, 0, side }, { 0, HEIGHT, 0 }, 3);
+            AddQuad(out, { x, 0, z + side + DOOR },  { 0, 0, side }, { 0, HEIGHT, 0 }, 3);
+            for (int k = 0; k < 4; ++k) {
+                const Vector3 mn = { x + 0.5f + u01(rng) * (ROOM - 2.f), 0.f, z + 0.5f + u01(rng) * (ROOM - 2.f) };
+                AddBox(out, mn, { mn.x + 0.3f + u01(rng), 0.4f + u01(rng) * 1.5f, mn.z + 0.3f + u01(rng) });
+            }
+        }
+    return out;
+}
+
+struct Queries {
+    std::vector<Vector3> origin;   // ray origin / sweep start / sphere centre
+    std::vector<Vector3> dir;      // ray direction / sweep delta
+};
+
+// Player-like queries spread over the scene bounds: long rays in random
+// directions, short sweeps and sphere overlaps at walking height.
+Queries MakeQueries(const BVH& bvh, int count, uint32_t seed) {
+    Queries q;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> u01(0.f, 1.f), sym(-1.f, 1.f);
+    const Vector3 mn = bvh.nodes[0].bmin, mx = bvh.nodes[0].bmax;
+    for (int i = 0; i < count; ++i) {
+        q.origin.push_back({ mn.x + u01(rng) * (mx.x - mn.x),
+                             mn.y + u01(rng) * (mx.y - mn.y),
+                             mn.z + u01(rng) * (mx.z - mn.z) });
+        q.dir.push_back(v3norm({ sym(rng), sym(rng) * 0.5f, sym(rng) }));
+    }
+    return q;
+}
+
+struct TreeShape {
+    int leaves   = 0;
+    int maxDepth = 0;
+    int maxLeaf  = 0;
+};
+
+void Measure(const BVH& bvh, int idx, int depth, TreeShape& s) {
+    const BVHNode& n = bvh.nodes[idx];
+    if (depth > s.maxDepth) s.maxDepth = depth;
+    if (n.rightChild == -1) {
+        ++s.leaves;
+        if (n.triCount > s.maxLeaf) s.maxLeaf = n.triCount;
+        return;
+    }
+    Measure(bvh, idx + 1, depth + 1, s);
+    Measure(bvh, n.rightChild, depth + 1, s);
+}
+
+void BenchQuality(Suite& suite, const char* label, BVHBuildQuality quality,
+                  const std::vector<Tri>& source, int queries, int iterations) {
+    const uint64_t triCount = source.size();
+    std::printf("\n%s build (%llu triangles)\n", label, static_cast<unsigned long long>(triCount));
+
+    BVH bvh;
+    const double buildNs = BestOfNs(std::max(1, iterations / 2), [&] {
+        std::vector<Tri> copy = source;
+        bvh.Build(std::move(copy), quality);
+    });
+    suite.Time(std::string("build/") + label, triCount, triCount, buildNs);
+
+    TreeShape shape;
+    Measure(bvh, 0, 0, shape);
+    std::printf("  nodes %zu  leaves %d  depth %d  max leaf %d  SAH cost %.2f\n",
+                bvh.nodes.size(), shape.leaves, shape.maxDepth, shape.maxLeaf, bvh.SahCost());
+
+    const Queries q = MakeQueries(bvh, queries, 1234u);
+    const Vector3 ext = v3sub(bvh.nodes[0].bmax, bvh.nodes[0].bmin);
+    const float   rayLen = v3len(ext);
+    const float   RADIUS = 0.4f, STEP = 0.5f;
+
+    // One untimed pass per query kind to count visits, then timed passes.
+    // Each kind runs on the binary tree and on its 4-wide collapse.
+    auto runAll = [&](const auto& tree, const std::string& name) {
+        auto raycasts = [&](BVHTraversalStats* stats) {
+            int hits = 0;
+            for (int i = 0; i < queries; ++i) {
+                float   bestT = rayLen;
+                Vector3 n;
+                RaycastNodeBVH(tree, q.origin[i], q.dir[i], bestT, n, stats);
+                hits += bestT < rayLen;
+            }
+            DoNotOptimize(hits);
+        };
+        auto sweeps = [&](BVHTraversalStats* stats) {
+            int hits = 0;
+            for (int i = 0; i < queries; ++i) {
+                float   bestT = FLT_MAX;
+                Vector3 n;
+                SweepNodeBVH(tree, q.origin[i], v3add(q.origin[i], v3scale(q.dir[i], STEP)),
+                             RADIUS, bestT, n, stats);
+                hits += bestT <= 1.f;
+            }
+            DoNotOptimize(hits);
+        };
+        auto overlaps = [&](BVHTraversalStats* stats) {
+            int pushed = 0;
+            for (int i = 0; i < queries; ++i) {
+                Vector3 push = { 0, 0, 0 };
+                bool    did  = false;
+                PenetrationNodeBVH(tree, q.origin[i], RADIUS, push, did, stats);
+                pushed += did;
+            }
+            DoNotOptimize(pushed);
+        };
+
+        auto run = [&](const char* kind, auto&& body) {
+            BVHTraversalStats stats;
+            body(&stats);
+            const double ns = BestOfNs(iterations, [&] { body(nullptr); });
+            suite.Time(std::string(kind) + "/" + name, triCount, (uint64_t)queries, ns);
+            std::printf("  %-10s %8.1f nodes/query  %8.1f tris/query\n", kind,
+                        double(stats.nodesVisited) / queries, double(stats.trianglesTested) / queries);
+        };
+        run("raycast", raycasts);
+        run("sweep", sweeps);
+        run("overlap", overlaps);
+    };
+    runAll(bvh, label);
+
+    QBVH wide;
+    const double collapseNs = BestOfNs(std::max(1, iterations / 2), [&] { wide.Build(bvh); });
+    suite.Time(std::string("collapse/") + label, triCount, triCount, collapseNs);
+    std::printf("  qbvh nodes %zu  packets %zu  (%s lanes)\n", wide.nodes.size(), wide.packets.size(),
+#if defined(HOTONES_FLOAT4_SSE2)
+                "sse2"
+#elif defined(HOTONES_FLOAT4_NEON)
+                "neon"
+#else
+                "scalar"
+#endif
+                );
+    runAll(wide, std::string(label) + "-qbvh");
+
+    CompactQBVH compact;
+    if (!compact.Build(wide)) {
+        std::printf("  compact qbvh: layout does not fit\n");
+        return;
+    }
+    std::printf("  compact qbvh %zu bytes vs %zu (%.2fx), %zu welded vertices\n", compact.MemoryBytes(),
+                wide.MemoryBytes(), double(wide.MemoryBytes()) / double(compact.MemoryBytes()),
+                compact.vertices.size());
+    runAll(compact, std::string(label) + "-cqbvh");
+}
+
+// Spheres dropped in a loose grid onto a huge static ground sphere, as
+// Scene::Initialize sets up its demo, with seeded sideways velocities so
+// neighbours meet and islands merge.  Each timed run restores the initial
+// bodies and steps one second at 60 Hz; ns/op is per Update.
+void BenchRigidBodies(Suite& suite, int bodyCount, int iterations) {
+    const int   STEPS = 60;
+    const float DT    = 1.f / 60.f;
+
+    Sphere ground(1000.f), ball(0.5f);
+    std::vector<Body> initial;
+    Body b{};
+    b.rotation               = Quaternion{ 0, 0, 0, 1 };
+    b.position               = Vector3{ 0, -1000, 0 };
+    b.invertedMass           = 0.f;
+    b.restitutionCoefficient = 1.f;
+    b.shape                  = &ground;
+    initial.push_back(b);
+
+    std::mt19937 rng(777u);
+    std::uniform_real_distribution<float> sym(-1.f, 1.f);
+    const int side = (int)std::ceil(std::sqrt((float)bodyCount));
+    for (int i = 0; i < bodyCount; ++i) {
+        b.position               = Vector3{ (i % side) * 1.5f, 2.f + (i / side % 4) * 1.5f + sym(rng), (i / side) * 1.5f };
+        b.linearVelocity         = Vector3{ sym(rng) * 2.f, 0.f, sym(rng) * 2.f };
+        b.invertedMass           = 1.f;
+        b.restitutionCoefficient = 0.5f;
+        b.shape                  = &ball;
+        initial.push_back(b);
+    }
+
+    Scene scene;
+    int islands = 0;
+    const double ns = BestOfNs(iterations,
+        [&] { scene.bodies = initial; },
+        [&] {
+            for (int i = 0; i < STEPS; ++i) scene.Update(DT);
+            islands = scene.GetIslandCount();
+        });
+    suite.Time("scene/" + std::to_string(bodyCount), (uint64_t)bodyCount, STEPS, ns);
+    std::printf("  %d islands after the last step\n", islands);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const char* modelPath = "../../assets/Home.obj";
+    int         queries   = 20000;
+    const char* jsonPath  = nullptr;
+    const char* basePath  = nullptr;
+    double      threshold = 10.0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if      (a == "--quick")                        queries   = 2000;
+        else if (a == "--model"     && i + 1 < argc)    modelPath = argv[++i];
+        else if (a == "--queries"   && i + 1 < argc)    queries   = std::max(1, std::atoi(argv[++i]));
+        else if (a == "--json"      && i + 1 < argc)    jsonPath  = argv[++i];
+        else if (a == "--baseline"  && i + 1 < argc)    basePath  = argv[++i];
+        else if (a == "--threshold" && i + 1 < argc)    threshold = std::atof(argv[++i]);
+        else { std::fprintf(stderr, "unknown argument: %s\n", argv[i]); return 1; }
+    }
+
+    std::vector<Tri> tris;
+    if (LoadObjTriangles(modelPath, tris)) {
+        std::printf("Scene: %s\n", modelPath);
+    } else {
+        std::printf("Scene: %s not readable, using procedural house\n", modelPath);
+        tris = MakeHouse(12, 42u);
+    }
+
+    Suite suite("physics");
+    BenchQuality(suite, "fast", BVHBuildQuality::Fast, tris, queries, 5);
+    BenchQuality(suite, "sah",  BVHBuildQuality::SAH,  tris, queries, 5);
+
+    std::printf("\nRigid-body scene (%d Updates per run)\n", 60);
+    for (int bodies : { 10, 100, 1000 })
+        BenchRigidBodies(suite, bodies, bodies >= 1000 ? 3 : 5);
+
+    if (jsonPath && !suite.WriteJson(jsonPath)) return 1;
+    if (basePath) {
+        const int regressions = suite.Compare(basePath, threshold);
+        if (regressions < 0) return 1;
+        std::printf("%d regression(s)\n", regressions);
+        return regressions > 0 ? 2 : 0;
+    }
+    return 0;
+}
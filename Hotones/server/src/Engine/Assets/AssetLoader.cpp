@@ -0,0 +1 @@
+#include "../../../../src/Assets/AssetLoader.cpp"
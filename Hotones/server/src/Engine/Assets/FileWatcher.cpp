@@ -0,0 +1 @@
+#include "../../../../src/Assets/FileWatcher.cpp"
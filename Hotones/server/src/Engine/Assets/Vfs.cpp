@@ -0,0 +1 @@
+#include "../../../../src/Assets/Vfs.cpp"
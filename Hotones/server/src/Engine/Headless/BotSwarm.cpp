@@ -0,0 +1 @@
+#include "../../../../src/Headless/BotSwarm.cpp"
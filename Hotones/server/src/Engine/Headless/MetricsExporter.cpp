@@ -0,0 +1 @@
+#include "../../../../src/Headless/MetricsExporter.cpp"
@@ -0,0 +1 @@
+#include "../../../../src/Headless/NetworkManager.cpp"
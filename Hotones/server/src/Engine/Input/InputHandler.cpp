@@ -0,0 +1 @@
+#include "../../../../src/Input/InputHandler.cpp"
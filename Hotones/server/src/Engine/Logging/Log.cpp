@@ -0,0 +1 @@
+#include "../../../../src/Logging/Log.cpp"
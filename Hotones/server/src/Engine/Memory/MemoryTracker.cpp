@@ -0,0 +1 @@
+#include "../../../../src/Memory/MemoryTracker.cpp"
@@ -0,0 +1 @@
+#include "../../../../src/Physics/BVHCache.cpp"
@@ -0,0 +1 @@
+#include "../../../../src/Physics/MappedFile.cpp"
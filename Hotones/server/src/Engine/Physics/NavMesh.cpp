@@ -0,0 +1 @@
+#include "../../../../src/Physics/NavMesh.cpp"
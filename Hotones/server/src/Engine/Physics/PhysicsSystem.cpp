@@ -0,0 +1 @@
+#include "../../../../src/Physics/PhysicsSystem.cpp"
@@ -0,0 +1 @@
+#include "../../../../src/Profile/Profiler.cpp"
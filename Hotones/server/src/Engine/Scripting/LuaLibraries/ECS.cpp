@@ -0,0 +1 @@
+#include "../../../../../src/Scripting/LuaLibraries/ECS.cpp"
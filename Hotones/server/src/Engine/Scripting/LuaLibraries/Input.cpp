@@ -0,0 +1 @@
+#include "../../../../../src/Scripting/LuaLibraries/Input.cpp"
@@ -0,0 +1 @@
+#include "../../../../../src/Scripting/LuaLibraries/ServerLib.cpp"
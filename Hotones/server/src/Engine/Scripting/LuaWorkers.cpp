@@ -0,0 +1 @@
+#include "../../../../src/Scripting/LuaWorkers.cpp"
@@ -0,0 +1 @@
+#include "../../../../src/Scripting/PackScripts.cpp"
@@ -0,0 +1,58 @@
+// The raylib entry points the server's sources call, so the server links
+// without raylib: logging, its allocator, and the file-load hooks the Vfs
+// installs, and input devices with nothing attached for the Lua input
+// library (InputHandler reads them like a client's).  raymath is header-only and comes from raylib's header as
+// usual.  The rlgl calls are the profiler's GPU timers, which never start
+// without a GL context.
+#include <raylib.h>
+#include <rlgl.h>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+int              s_logLevel    = LOG_INFO;
+TraceLogCallback s_logCallback = nullptr;
+
+} // namespace
+
+void SetTraceLogLevel(int logLevel) { s_logLevel = logLevel; }
+void SetTraceLogCallback(TraceLogCallback callback) { s_logCallback = callback; }
+
+void TraceLog(int logLevel, const char* text, ...)
+{
+    if (logLevel < s_logLevel) return;
+    va_list args;
+    va_start(args, text);
+    if (s_logCallback) {
+        s_logCallback(logLevel, text, args);
+    } else {
+        static const char* const PREFIX[] = { "", "TRACE: ", "DEBUG: ", "INFO: ", "WARNING: ", "ERROR: ", "FATAL: " };
+        std::fputs(logLevel >= LOG_TRACE && logLevel <= LOG_FATAL ? PREFIX[logLevel] : "", stdout);
+        std::vfprintf(stdout, text, args);
+        std::fputc('\n', stdout);
+    }
+    va_end(args);
+    if (logLevel == LOG_FATAL) std::exit(EXIT_FAILURE);
+}
+
+void* MemAlloc(unsigned int size) { return std::calloc(size, 1); }
+void* MemRealloc(void* ptr, unsigned int size) { return std::realloc(ptr, size); }
+void  MemFree(void* ptr) { std::free(ptr); }
+
+// Nothing on a server loads files through raylib
+void SetLoadFileDataCallback(LoadFileDataCallback /*callback*/) {}
+void SetLoadFileTextCallback(LoadFileTextCallback /*callback*/) {}
+
+int  rlGetVersion() { return RL_OPENGL_11; }
+void rlDrawRenderBatchActive() {}
+
+// No keyboard or mouse
+bool    IsKeyDown(int /*key*/) { return false; }
+bool    IsKeyPressedRepeat(int /*key*/) { return false; }
+bool    IsMouseButtonDown(int /*button*/) { return false; }
+int     GetCharPressed() { return 0; }
+float   GetMouseWheelMove() { return 0.f; }
+Vector2 GetMouseDelta() { return { 0.f, 0.f }; }
+Vector2 GetMousePosition() { return { 0.f, 0.f }; }
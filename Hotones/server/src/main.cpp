@@ -0,0 +1,132 @@
+// ---------------------------------------------------------------------------
+// Dedicated server build.
+//
+// The same headless modes as `habenero --server` (RunHeadlessServer and the
+// rest, server/Server.hpp), linked without the client: no window, GL,
+// audio, ImGui, assimp or raylib.  Engine sources come in through
+// src/Engine/, one wrapper per file (Net, Scripting, Physics, Memory and
+// what they read packs with); ECS and the job system are header-only.
+// Built with HOTONES_HEADLESS, so packs get no rendering, audio, meshgen,
+// lighting or localPlayer libraries (Scripting/CupLoader.hpp); input reads
+// the stand-in devices in RaylibStandIns.cpp, which never report anything.
+//
+// Build with meow from this directory, then run ./build/habenero-server.
+//
+//   habenero-server --pak game.cup --port 27015 --tick-rate 100
+//   habenero-server --pak game.cup --matches 8 --match-threads 4
+//   habenero-server --master
+//   habenero-server --bots 64 --connect 10.0.0.2
+//
+// The flags are the client's (docs/cupformat.md); --server is implied and
+// accepted for scripts written against the client binary.
+// ---------------------------------------------------------------------------
+
+#include <raylib.h>
+#include <server/Server.hpp>
+#include <Logging/Log.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+int main(int argc, char** argv)
+{
+    Hotones::Log::Install();   // TraceLog() output off the calling thread
+
+    uint16_t    serverPort   = Hotones::Net::DEFAULT_PORT;
+    uint16_t    maxPlayers   = Hotones::Net::DEFAULT_MAX_PLAYERS;
+    int         tickRate     = 100;
+    int         matches      = 1;
+    int         matchThreads = 0;
+    std::string connectHost;
+    uint16_t    connectPort  = Hotones::Net::DEFAULT_PORT;
+    std::string pakPath;
+    bool        isMaster     = false;
+    bool        portGiven    = false;
+    Hotones::Net::LinkConditions netConditions;   // --net-* test flags
+    Hotones::Net::BotOptions     bots;            // --bots load test
+    Hotones::Net::ServerEndpoint masterServer { {}, Hotones::Net::DEFAULT_MASTER_PORT };
+    Hotones::Net::MetricsOptions metrics;         // --metrics statsd collector
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--server") {
+            // the only mode there is
+        } else if (arg == "--port" && i + 1 < argc) {
+            serverPort = static_cast<uint16_t>(std::stoi(argv[++i]));
+            portGiven  = true;
+        } else if (arg == "--master") {
+            isMaster = true;
+        } else if (arg == "--master-server" && i + 1 < argc) {
+            // host or host:port
+            const std::string spec  = argv[++i];
+            const size_t      colon = spec.rfind(':');
+            masterServer.host = spec.substr(0, colon);
+            if (colon != std::string::npos)
+                masterServer.port = static_cast<uint16_t>(std::stoi(spec.substr(colon + 1)));
+        } else if (arg == "--metrics" && i + 1 < argc) {
+            // host or host:port
+            const std::string spec  = argv[++i];
+            const size_t      colon = spec.rfind(':');
+            metrics.host = spec.substr(0, colon);
+            if (colon != std::string::npos)
+                metrics.port = static_cast<uint16_t>(std::stoi(spec.substr(colon + 1)));
+        } else if (arg == "--metrics-prefix" && i + 1 < argc) {
+            metrics.prefix = argv[++i];
+        } else if (arg == "--max-players" && i + 1 < argc) {
+            maxPlayers = static_cast<uint16_t>(std::stoi(argv[++i]));
+        } else if (arg == "--tick-rate" && i + 1 < argc) {
+            tickRate = std::stoi(argv[++i]);
+        } else if (arg == "--matches" && i + 1 < argc) {
+            matches = std::stoi(argv[++i]);
+        } else if (arg == "--match-threads" && i + 1 < argc) {
+            matchThreads = std::stoi(argv[++i]);
+        } else if (arg == "--connect" && i + 1 < argc) {
+            connectHost = argv[++i];
+        } else if (arg == "--cport" && i + 1 < argc) {
+            connectPort = static_cast<uint16_t>(std::stoi(argv[++i]));
+        } else if (arg == "--pak" && i + 1 < argc) {
+            pakPath = argv[++i];
+        } else if (arg == "--net-latency" && i + 1 < argc) {
+            netConditions.latencyMs = std::stoi(argv[++i]);
+        } else if (arg == "--net-jitter" && i + 1 < argc) {
+            netConditions.jitterMs = std::stoi(argv[++i]);
+        } else if (arg == "--net-loss" && i + 1 < argc) {
+            netConditions.lossPercent = std::stof(argv[++i]);
+        } else if (arg == "--net-dup" && i + 1 < argc) {
+            netConditions.duplicatePercent = std::stof(argv[++i]);
+        } else if (arg == "--net-seed" && i + 1 < argc) {
+            netConditions.seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--bots" && i + 1 < argc) {
+            bots.count = std::stoi(argv[++i]);
+        } else if (arg == "--bot-rate" && i + 1 < argc) {
+            bots.sendHz = std::stoi(argv[++i]);
+        } else if (arg == "--bot-area" && i + 1 < argc) {
+            bots.areaRadius = std::stof(argv[++i]);
+        } else {
+            std::fprintf(stderr, "Unknown or incomplete argument: %s\n", arg.c_str());
+            return 1;
+        }
+    }
+    Hotones::Log::SetLevel(LOG_WARNING);
+
+    if (isMaster) {
+        Hotones::RunMasterServer(portGiven ? serverPort : Hotones::Net::DEFAULT_MASTER_PORT);
+        return 0;
+    }
+    // Bots against a remote server
+    if (bots.count > 0 && !connectHost.empty()) {
+        bots.link = netConditions;
+        Hotones::RunBotClients(connectHost, connectPort, bots);
+        return 0;
+    }
+    if (matches > 1) {
+        if (bots.count > 0) TraceLog(LOG_WARNING, "--bots is ignored with --matches");
+        Hotones::RunMatchServer(serverPort, pakPath, maxPlayers, tickRate, matches, matchThreads,
+                                netConditions, masterServer, metrics);
+        return 0;
+    }
+    Hotones::RunHeadlessServer(serverPort, pakPath, maxPlayers, tickRate, netConditions, bots, masterServer,
+                                   metrics);
+    return 0;
+}
@@ -0,0 +1,343 @@
+// AssetCache.cpp — shared, content-keyed models, textures and waves
+
+#include <Assets/AssetCache.hpp>
+#include <Assets/TextureCook.hpp>
+#include <Assets/Vfs.hpp>
+#include <Jobs/MainThread.hpp>
+#include <Memory/MemoryTracker.hpp>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace Hotones::Assets {
+
+namespace {
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME  = 1099511628211ull;
+
+uint64_t Fnv1a(const unsigned char* data, size_t size, uint64_t h = FNV_OFFSET)
+{
+    for (size_t i = 0; i < size; ++i) h = (h ^ data[i]) * FNV_PRIME;
+    return h;
+}
+
+// Size and modification time, or CRC for a file in a mounted archive
+bool FileStamp(const std::string& path, uint64_t& size, uint64_t& stamp)
+{
+    uint32_t crc;
+    if (Vfs::Get().Stat(path, size, crc)) {
+        stamp = crc;
+        return true;
+    }
+    std::error_code ec;
+    size = (uint64_t)fs::file_size(path, ec);
+    if (ec) return false;
+    const auto mtime = fs::last_write_time(path, ec);
+    if (ec) return false;
+    stamp = (uint64_t)mtime.time_since_epoch().count();
+    return true;
+}
+
+size_t ModelBytes(const Model& model)
+{
+    size_t bytes = 0;
+    for (int i = 0; i < model.meshCount; ++i) {
+        const Mesh& m = model.meshes[i];
+        bytes += (size_t)m.vertexCount * sizeof(float) * (3 + 3 + 2 + (m.tangents ? 4 : 0));
+        if (m.colors)  bytes += (size_t)m.vertexCount * 4;
+        if (m.indices) bytes += (size_t)m.triangleCount * 3 * sizeof(unsigned short);
+    }
+    return bytes;
+}
+
+// Every mip level's bytes
+size_t ImageBytes(const Image& image)
+{
+    size_t bytes = 0;
+    for (int i = 0, w = image.width, h = image.height; i < std::max(image.mipmaps, 1); ++i) {
+        bytes += (size_t)GetPixelDataSize(w, h, image.format);
+        w = std::max(1, w / 2);
+        h = std::max(1, h / 2);
+    }
+    return bytes;
+}
+
+bool IsCompressed(int format) { return format >= PIXELFORMAT_COMPRESSED_DXT1_RGB; }
+
+// Set once a compressed upload fails: the GPU takes no DXT, so cooked
+// textures go straight to the fallback
+std::atomic<bool> s_noCompressedUpload{ false };
+
+// Handles count their bytes with the MemoryTracker while they live
+TextureHandle MakeTexture(Texture2D texture, size_t bytes)
+{
+    Memory::Allocated(Memory::Tag::Textures, bytes);
+    return TextureHandle(new Texture2D(texture), [bytes](Texture2D* t) {
+        if (IsWindowReady()) UnloadTexture(*t);   // else the context, and with it the texture, is gone
+        delete t;
+        Memory::Freed(Memory::Tag::Textures, bytes);
+    });
+}
+
+} // namespace
+
+AssetCache& AssetCache::Get()
+{
+    static AssetCache s_instance;
+    return s_instance;
+}
+
+uint64_t AssetCache::Identify(const std::string& path, Kind kind)
+{
+    const std::string norm = NormalisePath(path);
+    uint64_t size, stamp;
+    if (!FileStamp(norm, size, stamp)) return 0;
+
+    uint64_t hash = 0;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        auto it = m_paths.find(norm);
+        if (it != m_paths.end() && it->second.size == size && it->second.stamp == stamp) hash = it->second.key;
+    }
+    if (hash == 0) {   // new or changed: hash what's in it now
+        const FileView file = ReadFile(norm);
+        if (!file) return 0;
+        hash = Fnv1a(file.data, file.size);
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_paths[norm] = { size, stamp, hash };
+    }
+
+    uint64_t key = (hash ^ (uint64_t)kind) * FNV_PRIME;
+    if (kind == Kind::Model) {   // side files are looked up next to it
+        const std::string dir = fs::path(norm).parent_path().generic_string();
+        key = Fnv1a(reinterpret_cast<const unsigned char*>(dir.data()), dir.size(), key);
+    }
+    return key != 0 ? key : 1;
+}
+
+std::shared_ptr<void> AssetCache::Touch(uint64_t key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) return nullptr;
+    it->second.lastUse = ++m_clock;
+    m_stats.hits++;
+    return it->second.asset;
+}
+
+std::shared_ptr<void> AssetCache::Insert(uint64_t key, Kind kind, std::shared_ptr<void> asset, size_t bytes,
+                                         const std::string& path)
+{
+    if (auto existing = Touch(key)) return existing;   // loaded by another thread meanwhile
+    m_entries[key] = { kind, asset, bytes, ++m_clock, path };
+    m_stats.loads++;
+    // Off the main thread only waves may be unloaded
+    TrimLocked(MAX_UNUSED_ASSETS, kind != Kind::Wave);
+    return asset;
+}
+
+void AssetCache::TrimLocked(int keepUnused, bool gpu)
+{
+    std::vector<std::pair<uint64_t, uint64_t>> unused;   // lastUse, key
+    for (const auto& [key, e] : m_entries)
+        if (e.asset.use_count() == 1 && (gpu || e.kind == Kind::Wave)) unused.push_back({ e.lastUse, key });
+    if ((int)unused.size() <= keepUnused) return;
+
+    std::sort(unused.begin(), unused.end(), std::greater<>());
+    for (size_t i = (size_t)std::max(keepUnused, 0); i < unused.size(); ++i) {
+        auto it = m_entries.find(unused[i].second);
+        TraceLog(LOG_DEBUG, "AssetCache: unloading %s", it->second.path.c_str());
+        m_entries.erase(it);   // the last reference: unloads it
+        m_stats.evictions++;
+    }
+}
+
+ModelHandle AssetCache::LoadModel(const std::string& path)
+{
+    // Uploads need the GL context: from the simulation thread, the main
+    // thread loads it
+    auto& main = Jobs::MainThread::Get();
+    if (main.Forwarding()) {
+        ModelHandle model;
+        main.Run([&] { model = LoadModel(path); });
+        return model;
+    }
+
+    const uint64_t key = Identify(path, Kind::Model);
+    if (key == 0) return nullptr;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (auto hit = Touch(key)) return std::static_pointer_cast<Model>(hit);
+    }
+
+    Model model = ::LoadModel(path.c_str());
+    if (model.meshCount <= 0 || model.meshes == nullptr) {
+        TraceLog(LOG_WARNING, "AssetCache: %s has no meshes", path.c_str());
+        if (model.meshes || model.materials) UnloadModel(model);
+        return nullptr;
+    }
+    const size_t bytes = ModelBytes(model);
+    Memory::Allocated(Memory::Tag::Meshes, bytes);
+    ModelHandle handle(new Model(model), [bytes](Model* m) {
+        if (IsWindowReady()) UnloadModel(*m);
+        delete m;
+        Memory::Freed(Memory::Tag::Meshes, bytes);
+    });
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return std::static_pointer_cast<Model>(Insert(key, Kind::Model, handle, bytes, path));
+}
+
+TextureHandle AssetCache::LoadTexture(const std::string& path)
+{
+    if (TextureHandle hit = FindTexture(path)) return hit;
+    Image image = LoadTextureImage(path);
+    if (!image.data) return nullptr;
+    return AddTexture(path, image);
+}
+
+TextureHandle AssetCache::FindTexture(const std::string& path)
+{
+    const uint64_t key = Identify(path, Kind::Texture);
+    if (key == 0) return nullptr;
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return std::static_pointer_cast<Texture2D>(Touch(key));
+}
+
+TextureHandle AssetCache::AddTexture(const std::string& path, Image image)
+{
+    // Decoded here, uploaded on the main thread (see LoadModel)
+    auto& main = Jobs::MainThread::Get();
+    if (main.Forwarding()) {
+        TextureHandle texture;
+        main.Run([&] { texture = AddTexture(path, image); });
+        return texture;
+    }
+
+    const uint64_t key = Identify(path, Kind::Texture);
+    if (key != 0) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (auto hit = Touch(key)) {
+            UnloadImage(image);
+            return std::static_pointer_cast<Texture2D>(hit);
+        }
+    }
+
+    Texture2D texture{};
+    if (!IsCompressed(image.format) || !s_noCompressedUpload.load()) texture = LoadTextureFromImage(image);
+    if (texture.id == 0 && IsCompressed(image.format)) {
+        // No DXT on this GPU: the source file, uncompressed, instead
+        if (!s_noCompressedUpload.exchange(true))
+            TraceLog(LOG_WARNING, "AssetCache: GPU can't take compressed textures; loading sources instead");
+        UnloadImage(image);
+        image = LoadImage(path.c_str());
+        if (!image.data) return nullptr;
+        texture = LoadTextureFromImage(image);
+    }
+    const size_t bytes = ImageBytes(image);
+    UnloadImage(image);
+    if (texture.id == 0) return nullptr;
+    // Mip levels for distance, still sampled nearest so pixels stay crisp
+    if (texture.mipmaps > 1) SetTextureFilter(texture, TEXTURE_FILTER_POINT);
+    TextureHandle handle = MakeTexture(texture, bytes);
+    if (key == 0) return handle;   // not a file we can key: shared by nobody else
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return std::static_pointer_cast<Texture2D>(Insert(key, Kind::Texture, handle, bytes, path));
+}
+
+WaveHandle AssetCache::LoadWave(const std::string& path)
+{
+    const uint64_t key = Identify(path, Kind::Wave);
+    if (key == 0) return nullptr;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (auto hit = Touch(key)) return std::static_pointer_cast<Wave>(hit);
+    }
+
+    const Wave wave = ::LoadWave(path.c_str());
+    if (!wave.data) return nullptr;
+    const size_t bytes = (size_t)wave.frameCount * wave.channels * (wave.sampleSize / 8);
+    Memory::Allocated(Memory::Tag::Audio, bytes);
+    WaveHandle handle(new Wave(wave), [bytes](Wave* w) {
+        UnloadWave(*w);
+        delete w;
+        Memory::Freed(Memory::Tag::Audio, bytes);
+    });
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return std::static_pointer_cast<Wave>(Insert(key, Kind::Wave, handle, bytes, path));
+}
+
+int AssetCache::Reload(const std::string& path)
+{
+    auto& main = Jobs::MainThread::Get();
+    if (main.Forwarding()) {   // updates textures in place (see LoadModel)
+        int reloaded = 0;
+        main.Run([&] { reloaded = Reload(path); });
+        return reloaded;
+    }
+
+    const std::string norm = NormalisePath(path);
+    std::vector<std::pair<uint64_t, Entry>> stale;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_paths.erase(norm);   // hash it afresh on the next load
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            if (NormalisePath(it->second.path) != norm) { ++it; continue; }
+            stale.push_back({ it->first, std::move(it->second) });
+            it = m_entries.erase(it);
+        }
+    }
+
+    for (auto& [oldKey, e] : stale) {
+        if (e.kind != Kind::Texture) continue;   // the next load imports it
+        Texture2D& texture = *std::static_pointer_cast<Texture2D>(e.asset);
+        if (IsCompressed(texture.format)) {   // no partial updates of those
+            TraceLog(LOG_INFO, "AssetCache: %s is compressed; reload what uses it to see it", e.path.c_str());
+            continue;
+        }
+        Image image = LoadImage(e.path.c_str());
+        if (!image.data) continue;
+        if (texture.mipmaps > 1) ImageFormat(&image, texture.format);   // cooked to RGBA8
+        if (image.width != texture.width || image.height != texture.height || image.format != texture.format) {
+            TraceLog(LOG_INFO, "AssetCache: %s changed size or format; reload what uses it to see it", e.path.c_str());
+            UnloadImage(image);
+            continue;
+        }
+        UpdateTexture(texture, image.data);
+        UnloadImage(image);
+        if (texture.mipmaps > 1) {
+            GenTextureMipmaps(&texture);
+            SetTextureFilter(texture, TEXTURE_FILTER_POINT);
+        }
+
+        // Same texture object, new content: file it under its new key
+        const uint64_t key = Identify(e.path, Kind::Texture);
+        if (key == 0) continue;
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_entries.try_emplace(key, std::move(e));
+    }
+    return (int)stale.size();   // dropped entries nobody holds unload here
+}
+
+void AssetCache::Trim(int keepUnused)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    TrimLocked(keepUnused, true);
+}
+
+AssetCache::Stats AssetCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    Stats stats = m_stats;
+    for (const auto& [key, e] : m_entries) {
+        if (e.asset.use_count() == 1) stats.unused++;
+        else stats.live++;
+        stats.bytes += e.bytes;
+    }
+    return stats;
+}
+
+} // namespace Hotones::Assets
@@ -1,6 +1,9 @@
 #include <Assets/AssetLoader.hpp>
 #include <filesystem>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #if defined(_WIN32)
 #include <windows.h>
 #elif defined(__linux__)
@@ -13,7 +16,12 @@ namespace fs = std::filesystem;
 namespace Ho_tones {
 namespace Assets {
 
-std::string GetExecutableDir() {
+// FindAsset() answers, hits and misses, by the path asked for; emptied by
+// InvalidateAssetPaths()
+static std::mutex                                                   s_pathMutex;
+static std::unordered_map<std::string, std::optional<std::string>>  s_resolved;
+
+static std::string QueryExecutableDir() {
 #if defined(_WIN32)
     char buf[MAX_PATH];
     DWORD len = GetModuleFileNameA(NULL, buf, MAX_PATH);
@@ -33,6 +41,11 @@ std::string GetExecutableDir() {
 #endif
 }
 
+std::string GetExecutableDir() {
+    static const std::string dir = QueryExecutableDir();   // the executable doesn't move
+    return dir;
+}
+
 std::string ResolveRelativeToExe(const std::string& relativePath) {
     std::string exeDir = GetExecutableDir();
     if (exeDir.empty()) return {};
@@ -40,28 +53,55 @@ std::string ResolveRelativeToExe(const std::string& relativePath) {
     return combined.string();
 }
 
-bool FindAsset(const std::string& relativePath, std::string& outPath) {
+static std::optional<std::string> ProbeAsset(const std::string& relativePath) {
     // Check given path as-is (relative to cwd)
     fs::path p1 = relativePath;
-    if (fs::exists(p1)) { outPath = fs::absolute(p1).string(); return true; }
+    if (fs::exists(p1)) return fs::absolute(p1).string();
 
     // Check relative to executable directory
     std::string exeDir = GetExecutableDir();
     if (!exeDir.empty()) {
         fs::path p2 = fs::path(exeDir) / relativePath;
-        if (fs::exists(p2)) { outPath = fs::absolute(p2).string(); return true; }
+        if (fs::exists(p2)) return fs::absolute(p2).string();
 
         // Also try one level up (app installed next to a data folder)
         fs::path p3 = fs::path(exeDir).parent_path() / relativePath;
-        if (fs::exists(p3)) { outPath = fs::absolute(p3).string(); return true; }
+        if (fs::exists(p3)) return fs::absolute(p3).string();
     }
 
     // Check common build/data folders relative to cwd
     fs::path p4 = fs::path("build") / relativePath;
-    if (fs::exists(p4)) { outPath = fs::absolute(p4).string(); return true; }
+    if (fs::exists(p4)) return fs::absolute(p4).string();
 
     // Not found
-    return false;
+    return std::nullopt;
+}
+
+bool FindAsset(const std::string& relativePath, std::string& outPath) {
+    {
+        std::lock_guard<std::mutex> lk(s_pathMutex);
+        auto it = s_resolved.find(relativePath);
+        if (it != s_resolved.end()) {
+            if (!it->second) return false;
+            outPath = *it->second;
+            return true;
+        }
+    }
+
+    // Probe outside the lock; racing probes of one path agree anyway
+    std::optional<std::string> found = ProbeAsset(relativePath);
+    {
+        std::lock_guard<std::mutex> lk(s_pathMutex);
+        s_resolved[relativePath] = found;
+    }
+    if (!found) return false;
+    outPath = std::move(*found);
+    return true;
+}
+
+void InvalidateAssetPaths() {
+    std::lock_guard<std::mutex> lk(s_pathMutex);
+    s_resolved.clear();
 }
 
 } // namespace Assets
@@ -0,0 +1,192 @@
+// FileWatcher.cpp — changed-file reports from inotify / ReadDirectoryChangesW
+
+#include <Assets/FileWatcher.hpp>
+#include <Assets/Vfs.hpp>
+#include <filesystem>
+#include <system_error>
+#include <unordered_map>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+using Clock  = std::chrono::steady_clock;
+
+namespace Hotones::Assets {
+
+struct FileWatcher::Impl {
+    std::string root;
+    std::unordered_map<std::string, Clock::time_point> pending;   // path → last write seen
+
+    void Touch(const fs::path& path) { pending[NormalisePath(path.string())] = Clock::now(); }
+
+#if defined(_WIN32)
+    HANDLE     dir = INVALID_HANDLE_VALUE;
+    OVERLAPPED ov  = {};
+    alignas(DWORD) unsigned char buf[64 * 1024];
+
+    bool Arm() {
+        return ReadDirectoryChangesW(dir, buf, sizeof(buf), TRUE,
+                                     FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME,
+                                     nullptr, &ov, nullptr) != 0;
+    }
+
+    bool Open() {
+        dir = CreateFileA(root.c_str(), FILE_LIST_DIRECTORY,
+                          FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                          FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+        if (dir == INVALID_HANDLE_VALUE) return false;
+        ov.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+        if (ov.hEvent && Arm()) return true;
+        Close();
+        return false;
+    }
+
+    void Close() {
+        if (dir != INVALID_HANDLE_VALUE) {
+            DWORD bytes;
+            if (CancelIo(dir)) GetOverlappedResult(dir, &ov, &bytes, TRUE);   // the kernel is done with buf
+            CloseHandle(dir);
+            dir = INVALID_HANDLE_VALUE;
+        }
+        if (ov.hEvent) CloseHandle(ov.hEvent);
+        ov = {};
+    }
+
+    bool IsOpen() const { return dir != INVALID_HANDLE_VALUE; }
+
+    void Drain() {
+        DWORD bytes = 0;
+        while (IsOpen() && GetOverlappedResult(dir, &ov, &bytes, FALSE)) {
+            // Zero bytes: the buffer overflowed and the changes are lost
+            for (DWORD offset = 0; bytes > 0;) {
+                const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(buf + offset);
+                if (info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_MODIFIED ||
+                    info->Action == FILE_ACTION_RENAMED_NEW_NAME) {
+                    const fs::path path = fs::path(root) /
+                        std::wstring(info->FileName, info->FileNameLength / sizeof(WCHAR));
+                    std::error_code ec;
+                    if (fs::is_regular_file(path, ec)) Touch(path);
+                }
+                if (info->NextEntryOffset == 0) break;
+                offset += info->NextEntryOffset;
+            }
+            ResetEvent(ov.hEvent);
+            if (!Arm()) Close();
+        }
+    }
+#elif defined(__linux__)
+    int fd = -1;
+    std::unordered_map<int, fs::path> dirs;   // watch descriptor → directory
+
+    void AddTree(const fs::path& top) {
+        AddDir(top);
+        std::error_code ec;
+        for (fs::recursive_directory_iterator it(top, fs::directory_options::skip_permission_denied, ec), end;
+             !ec && it != end; it.increment(ec)) {
+            if (it->is_directory(ec)) AddDir(it->path());
+        }
+    }
+
+    void AddDir(const fs::path& dir) {
+        const int wd = inotify_add_watch(fd, dir.c_str(),
+                                         IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR);
+        if (wd >= 0) dirs[wd] = dir;
+    }
+
+    bool Open() {
+        fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd < 0) return false;
+        AddTree(root);
+        if (!dirs.empty()) return true;
+        Close();
+        return false;
+    }
+
+    void Close() {
+        if (fd >= 0) close(fd);
+        fd = -1;
+        dirs.clear();
+    }
+
+    bool IsOpen() const { return fd >= 0; }
+
+    void Drain() {
+        alignas(inotify_event) char buf[16 * 1024];
+        for (;;) {
+            const ssize_t len = read(fd, buf, sizeof(buf));
+            if (len <= 0) break;   // EAGAIN: nothing more queued
+            for (ssize_t offset = 0; offset < len;) {
+                const auto* ev = reinterpret_cast<const inotify_event*>(buf + offset);
+                offset += (ssize_t)sizeof(inotify_event) + ev->len;
+
+                if (ev->mask & IN_IGNORED) { dirs.erase(ev->wd); continue; }
+                auto it = dirs.find(ev->wd);
+                if (it == dirs.end() || ev->len == 0) continue;
+                const fs::path path = it->second / ev->name;
+                if (ev->mask & IN_ISDIR) {
+                    // A new directory: watch it, and take what was written
+                    // into it before the watch existed
+                    if (ev->mask & (IN_CREATE | IN_MOVED_TO)) {
+                        AddTree(path);
+                        std::error_code ec;
+                        for (fs::recursive_directory_iterator f(path, ec), end; !ec && f != end; f.increment(ec))
+                            if (f->is_regular_file(ec)) Touch(f->path());
+                    }
+                } else if (ev->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                    Touch(path);
+                }
+            }
+        }
+    }
+#else
+    bool Open() { return false; }
+    void Close() {}
+    bool IsOpen() const { return false; }
+    void Drain() {}
+#endif
+};
+
+FileWatcher::FileWatcher() : m_impl(std::make_unique<Impl>()) {}
+
+FileWatcher::~FileWatcher() { Stop(); }
+
+bool FileWatcher::Watch(const std::string& root)
+{
+    Stop();
+    std::error_code ec;
+    if (!fs::is_directory(root, ec)) return false;
+    m_impl->root = NormalisePath(root);
+    return m_impl->Open();
+}
+
+void FileWatcher::Stop()
+{
+    m_impl->Close();
+    m_impl->pending.clear();
+}
+
+bool FileWatcher::IsWatching() const { return m_impl->IsOpen(); }
+
+std::vector<std::string> FileWatcher::Poll()
+{
+    std::vector<std::string> settled;
+    if (!m_impl->IsOpen()) return settled;
+    m_impl->Drain();
+
+    const Clock::time_point now = Clock::now();
+    for (auto it = m_impl->pending.begin(); it != m_impl->pending.end();) {
+        if (now - it->second < SETTLE_TIME) { ++it; continue; }
+        std::error_code ec;
+        if (fs::is_regular_file(it->first, ec)) settled.push_back(it->first);   // not a temp file renamed away
+        it = m_impl->pending.erase(it);
+    }
+    return settled;
+}
+
+} // namespace Hotones::Assets
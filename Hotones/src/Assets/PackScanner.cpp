@@ -1,12 +1,165 @@
 #include <Assets/PackScanner.hpp>
-#include <filesystem>
+#include <Jobs/JobSystem.hpp>
+#include <miniz.h>
 #include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <regex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
 
 namespace Hotones::Assets {
 
-std::vector<PackEntry> ScanPacksDir(const std::string& basePath) {
+namespace {
+
+constexpr const char* INDEX_MAGIC = "HTPACKIDX 1";
+
+// One line of the index: what a pack was when it was last probed
+struct IndexRecord {
+    uint64_t    size  = 0;
+    int64_t     mtime = 0;
+    std::string name, version;
+};
+using PackIndex = std::unordered_map<std::string, IndexRecord>;   // by fullPath
+
+PackIndex ReadIndex(const std::string& indexPath) {
+    PackIndex index;
+    std::ifstream in(indexPath);
+    std::string line;
+    if (!std::getline(in, line) || line != INDEX_MAGIC) return index;   // missing or another format
+    while (std::getline(in, line)) {
+        // path \t size \t mtime \t name \t version
+        std::vector<std::string> f;
+        std::istringstream ss(line);
+        for (std::string field; std::getline(ss, field, '\t');) f.push_back(field);
+        if (f.size() < 3) continue;
+        IndexRecord r;
+        try {
+            r.size  = std::stoull(f[1]);
+            r.mtime = std::stoll(f[2]);
+        } catch (...) { continue; }
+        if (f.size() > 3) r.name    = f[3];
+        if (f.size() > 4) r.version = f[4];
+        index[f[0]] = std::move(r);
+    }
+    return index;
+}
+
+// Replace the index's records for `basePath`'s packs with `entries`,
+// keeping other directories' records
+void WriteIndex(const std::string& indexPath, const std::string& basePath, const std::vector<PackEntry>& entries) {
+    PackIndex index = ReadIndex(indexPath);
+    const fs::path base = fs::path(basePath).lexically_normal();
+    std::erase_if(index, [&](const auto& kv) { return fs::path(kv.first).parent_path().lexically_normal() == base; });
+    for (const PackEntry& e : entries)
+        if (e.probed) index[e.fullPath] = { e.size, e.mtime, e.name, e.version };
+
+    std::error_code ec;
+    const fs::path path(indexPath);
+    if (path.has_parent_path()) fs::create_directories(path.parent_path(), ec);
+    const fs::path tmp = path.string() + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (!out) return;
+        out << INDEX_MAGIC << '\n';
+        for (const auto& [p, r] : index)
+            out << p << '\t' << r.size << '\t' << r.mtime << '\t' << r.name << '\t' << r.version << '\n';
+        if (!out) return;
+    }
+    fs::rename(tmp, path, ec);   // readers never see half a file
+}
+
+// Keep a declared name printable and the index line intact
+std::string Clean(std::string s) {
+    for (char& c : s)
+        if ((unsigned char)c < 0x20) c = ' ';
+    return s;
+}
+
+// Init.Name / Init.Version as written in init.lua: read from the text, not
+// by running it, so a probe can't execute a pack
+void ParseInitMeta(const std::string& src, std::string& name, std::string& version) {
+    static const std::regex initOpen(R"((^|[^\w.])Init\s*=\s*\{)");
+    std::smatch m;
+    if (!std::regex_search(src, m, initOpen)) return;
+
+    // The table's body up to the brace closing it, less comments; braces in
+    // strings don't count
+    std::string body;
+    for (size_t i = (size_t)(m.position(0) + m.length(0)), depth = 1; i < src.size(); ++i) {
+        const char c = src[i];
+        if (c == '-' && i + 1 < src.size() && src[i + 1] == '-') {
+            i = std::min(src.find('\n', i), src.size());
+            body += '\n';
+            continue;
+        }
+        if (c == '}' && --depth == 0) break;
+        if (c == '{') ++depth;
+        body += c;
+        if (c == '"' || c == '\'') {
+            for (++i; i < src.size() && src[i] != '\n'; ++i) {
+                body += src[i];
+                if (src[i] == c) break;
+                if (src[i] == '\\' && i + 1 < src.size()) body += src[++i];
+            }
+        }
+    }
+
+    static const std::regex field(R"re((^|[^\w.])(Name|Version)\s*=\s*("([^"\n]*)"|'([^'\n]*)'))re");
+    for (std::sregex_iterator it(body.begin(), body.end(), field), last; it != last; ++it) {
+        const std::string value = Clean((*it)[4].matched ? (*it)[4].str() : (*it)[5].str());
+        if ((*it)[2] == "Name") { if (name.empty()) name = value; }
+        else if (version.empty()) version = value;
+    }
+}
+
+// Read the pack's init.lua (out of the zip for archives) and fill in its
+// name and version
+void ProbePack(PackEntry& e) {
+    std::string text;
+    if (e.type == PackEntry::Type::Directory) {
+        std::ifstream in(fs::path(e.fullPath) / "init.lua", std::ios::binary);
+        std::ostringstream ss;
+        ss << in.rdbuf();
+        text = ss.str();
+    } else {
+        mz_zip_archive zip{};
+        if (mz_zip_reader_init_file(&zip, e.fullPath.c_str(), 0)) {
+            const int idx = mz_zip_reader_locate_file(&zip, "init.lua", nullptr, 0);
+            size_t size = 0;
+            void* data = idx >= 0 ? mz_zip_reader_extract_to_heap(&zip, (mz_uint)idx, &size, 0) : nullptr;
+            if (data) text.assign(static_cast<const char*>(data), size);
+            mz_free(data);
+            mz_zip_reader_end(&zip);
+        }
+    }
+    e.name.clear();
+    e.version.clear();
+    ParseInitMeta(text, e.name, e.version);
+    e.probed = true;   // even if it declares nothing: don't open it again until it changes
+}
+
+int64_t MtimeOf(const fs::path& p, std::error_code& ec) {
+    const auto t = fs::last_write_time(p, ec);
+    return ec ? 0 : (int64_t)t.time_since_epoch().count();
+}
+
+// Probes are mostly waiting on the disk; kept off JobSystem::Get() so they
+// never hold up frame work
+Jobs::JobSystem& ScanJobs() {
+    static Jobs::JobSystem s_jobs(std::max(2u, std::thread::hardware_concurrency() / 4));
+    return s_jobs;
+}
+
+} // namespace
+
+std::vector<PackEntry> ScanPacksDir(const std::string& basePath, const std::string& indexPath) {
     std::vector<PackEntry> out;
-    namespace fs = std::filesystem;
 
     std::error_code ec;
     if (!fs::exists(basePath, ec) || !fs::is_directory(basePath, ec))
@@ -19,20 +172,36 @@ std::vector<PackEntry> ScanPacksDir(const std::string& basePath) {
         pe.fullPath    = e.path().string();
         pe.displayName = e.path().filename().string();
 
+        std::error_code statEc;   // a pack we can't stat just isn't revalidated
         if (e.is_directory(ec)) {
-            if (fs::exists(e.path() / "init.lua", ec)) {
-                pe.type = PackEntry::Type::Directory;
+            const fs::path init = e.path() / "init.lua";
+            if (fs::exists(init, ec)) {
+                pe.type  = PackEntry::Type::Directory;
+                pe.size  = (uint64_t)fs::file_size(init, statEc);
+                pe.mtime = MtimeOf(init, statEc);
                 out.push_back(pe);
             }
         } else if (e.is_regular_file(ec)) {
             auto ext = e.path().extension().string();
             if (ext == ".cup" || ext == ".zip") {
-                pe.type = PackEntry::Type::ZipFile;
+                pe.type  = PackEntry::Type::ZipFile;
+                pe.size  = (uint64_t)e.file_size(statEc);
+                pe.mtime = MtimeOf(e.path(), statEc);
                 out.push_back(pe);
             }
         }
     }
 
+    // What the index knows of packs that haven't changed since
+    const PackIndex index = ReadIndex(indexPath);
+    for (PackEntry& pe : out) {
+        auto it = index.find(pe.fullPath);
+        if (it == index.end() || it->second.size != pe.size || it->second.mtime != pe.mtime) continue;
+        pe.name    = it->second.name;
+        pe.version = it->second.version;
+        pe.probed  = true;
+    }
+
     std::sort(out.begin(), out.end(), [](const PackEntry& a, const PackEntry& b) {
         return a.displayName < b.displayName;
     });
@@ -40,4 +209,87 @@ std::vector<PackEntry> ScanPacksDir(const std::string& basePath) {
     return out;
 }
 
+// ─── PackScan ─────────────────────────────────────────────────────────────────
+
+struct PackScan::State {
+    std::string basePath, indexPath;
+    std::atomic<bool> cancelled{false};
+
+    std::mutex             mutex;
+    std::vector<PackEntry> entries;        // guarded by mutex
+    uint64_t               revision = 0;   // bumped on every change; guarded
+    int                    pending  = 1;   // the listing + probes outstanding; guarded
+    bool                   probed   = false;   // the index is behind; guarded
+};
+
+// One job done; the last one writes the index back
+static void FinishScanJob(PackScan::State& s, bool probed) {
+    std::vector<PackEntry> snapshot;
+    {
+        std::lock_guard<std::mutex> lk(s.mutex);
+        s.probed = s.probed || probed;
+        if (--s.pending > 0 || !s.probed) return;   // cancelled too: keep what was probed
+        snapshot = s.entries;
+    }
+    WriteIndex(s.indexPath, s.basePath, snapshot);
+}
+
+static void RunProbe(const std::shared_ptr<PackScan::State>& s, size_t i, PackEntry e) {
+    if (s->cancelled.load()) { FinishScanJob(*s, false); return; }
+    try {
+        ProbePack(e);
+    } catch (...) {
+        e.probed = true;   // unreadable as it is; retried once it changes
+    }
+    {
+        std::lock_guard<std::mutex> lk(s->mutex);
+        s->entries[i] = std::move(e);
+        s->revision++;
+    }
+    FinishScanJob(*s, true);
+}
+
+static void RunListing(const std::shared_ptr<PackScan::State>& s) {
+    std::vector<PackEntry> entries;
+    try {
+        entries = ScanPacksDir(s->basePath, s->indexPath);
+    } catch (...) {}
+
+    std::vector<size_t> unprobed;
+    for (size_t i = 0; i < entries.size(); ++i)
+        if (!entries[i].probed) unprobed.push_back(i);
+    {
+        std::lock_guard<std::mutex> lk(s->mutex);
+        s->entries = entries;
+        s->revision++;
+        s->pending += (int)unprobed.size();
+    }
+    for (size_t i : unprobed)
+        ScanJobs().Submit([s, i, e = entries[i]] { RunProbe(s, i, e); });
+    FinishScanJob(*s, false);
+}
+
+PackScan::PackScan(const std::string& basePath, const std::string& indexPath)
+    : m_state(std::make_shared<State>())
+{
+    m_state->basePath  = basePath;
+    m_state->indexPath = indexPath;
+    ScanJobs().Submit([s = m_state] { RunListing(s); });
+}
+
+PackScan::~PackScan() { m_state->cancelled.store(true); }
+
+bool PackScan::Poll(std::vector<PackEntry>& out) {
+    std::lock_guard<std::mutex> lk(m_state->mutex);
+    if (m_state->revision == m_seen) return false;
+    m_seen = m_state->revision;
+    out    = m_state->entries;
+    return true;
+}
+
+bool PackScan::Done() const {
+    std::lock_guard<std::mutex> lk(m_state->mutex);
+    return m_state->pending == 0;
+}
+
 } // namespace Hotones::Assets
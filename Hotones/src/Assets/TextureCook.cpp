@@ -0,0 +1,464 @@
+// TextureCook.cpp — mip chains and BC1/BC3 compression, stored as .dds
+//
+// Cooked texture file: a standard DDS (native byte order; every platform we
+// ship is little-endian, as DDS is), readable by any DDS tool:
+//
+//   "DDS "        4 bytes
+//   DdsHeader     124 bytes; reserved1[0..3] hold TEXTURE_COOK_MARKER, the
+//                 cook version and the 64-bit key
+//   levels        largest first, each tightly packed: 4x4 blocks for
+//                 DXT1/DXT5, rows of RGBA8 otherwise
+
+#include <Assets/TextureCook.hpp>
+#include <Assets/Vfs.hpp>
+#include <Physics/BVHCache.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace Hotones::Assets {
+
+namespace {
+
+// Bump whenever the encoder, the mip filter or the layout changes
+constexpr uint32_t TEXTURE_COOK_VERSION = 1;
+constexpr uint32_t TEXTURE_COOK_MARKER  = 0x58545448u;   // "HTTX"
+
+constexpr uint32_t FourCC(char a, char b, char c, char d)
+{
+    return (uint32_t)(unsigned char)a | (uint32_t)(unsigned char)b << 8 |
+           (uint32_t)(unsigned char)c << 16 | (uint32_t)(unsigned char)d << 24;
+}
+
+struct DdsPixelFormat {
+    uint32_t size, flags, fourCC, rgbBitCount, rMask, gMask, bMask, aMask;
+};
+
+struct DdsHeader {
+    uint32_t       size, flags, height, width, pitchOrLinearSize, depth, mipMapCount;
+    uint32_t       reserved1[11];
+    DdsPixelFormat ddspf;
+    uint32_t       caps, caps2, caps3, caps4, reserved2;
+};
+static_assert(sizeof(DdsHeader) == 124, "DDS header layout");
+
+constexpr uint32_t DDSD_CAPS = 0x1, DDSD_HEIGHT = 0x2, DDSD_WIDTH = 0x4, DDSD_PITCH = 0x8,
+                   DDSD_PIXELFORMAT = 0x1000, DDSD_MIPMAPCOUNT = 0x20000, DDSD_LINEARSIZE = 0x80000;
+constexpr uint32_t DDPF_ALPHAPIXELS = 0x1, DDPF_FOURCC = 0x4, DDPF_RGB = 0x40;
+constexpr uint32_t DDSCAPS_COMPLEX = 0x8, DDSCAPS_TEXTURE = 0x1000, DDSCAPS_MIPMAP = 0x400000;
+constexpr int      MAX_MIP_LEVELS = 16;
+
+bool IsPow2(int n) { return n > 0 && (n & (n - 1)) == 0; }
+
+// Bytes of one mip level; the formats a cooked file holds only
+size_t LevelBytes(int w, int h, int format)
+{
+    const size_t blocks = (size_t)std::max(1, (w + 3) / 4) * (size_t)std::max(1, (h + 3) / 4);
+    switch (format) {
+        case PIXELFORMAT_COMPRESSED_DXT1_RGB:  return blocks * 8;
+        case PIXELFORMAT_COMPRESSED_DXT5_RGBA: return blocks * 16;
+        default:                               return (size_t)w * h * 4;
+    }
+}
+
+size_t ChainBytes(int w, int h, int mipmaps, int format)
+{
+    size_t bytes = 0;
+    for (int i = 0; i < mipmaps; ++i, w = std::max(1, w / 2), h = std::max(1, h / 2))
+        bytes += LevelBytes(w, h, format);
+    return bytes;
+}
+
+// ── Mip chain ────────────────────────────────────────────────────────────────
+
+struct Level {
+    int                  w = 0, h = 0;
+    std::vector<uint8_t> rgba;
+};
+
+// 2x2 box filter; an odd last row or column folds into its neighbour
+Level Downsample(const Level& src)
+{
+    Level dst;
+    dst.w = std::max(1, src.w / 2);
+    dst.h = std::max(1, src.h / 2);
+    dst.rgba.resize((size_t)dst.w * dst.h * 4);
+    for (int y = 0; y < dst.h; ++y) {
+        const int y0 = std::min(y * 2, src.h - 1), y1 = std::min(y * 2 + 1, src.h - 1);
+        for (int x = 0; x < dst.w; ++x) {
+            const int x0 = std::min(x * 2, src.w - 1), x1 = std::min(x * 2 + 1, src.w - 1);
+            for (int c = 0; c < 4; ++c) {
+                const unsigned sum = src.rgba[((size_t)y0 * src.w + x0) * 4 + c] + src.rgba[((size_t)y0 * src.w + x1) * 4 + c] +
+                                     src.rgba[((size_t)y1 * src.w + x0) * 4 + c] + src.rgba[((size_t)y1 * src.w + x1) * 4 + c];
+                dst.rgba[((size_t)y * dst.w + x) * 4 + c] = (uint8_t)((sum + 2) / 4);
+            }
+        }
+    }
+    return dst;
+}
+
+// ── BC1 / BC3 blocks ─────────────────────────────────────────────────────────
+//
+// Colour endpoints are range-fit along the block's principal axis (the
+// covariance's dominant eigenvector, by power iteration) and inset by a
+// sixteenth of the range, which keeps the extremes from dominating the
+// error; each pixel then takes the nearest of the four palette entries.
+// Alpha uses the block's min and max, so 0/255 cut-outs stay exact.
+
+uint16_t To565(const float c[3])
+{
+    const int r = std::clamp((int)std::lround(c[0] * 31.f / 255.f), 0, 31);
+    const int g = std::clamp((int)std::lround(c[1] * 63.f / 255.f), 0, 63);
+    const int b = std::clamp((int)std::lround(c[2] * 31.f / 255.f), 0, 31);
+    return (uint16_t)(r << 11 | g << 5 | b);
+}
+
+void From565(uint16_t v, float out[3])
+{
+    const int r = v >> 11, g = (v >> 5) & 63, b = v & 31;
+    out[0] = (float)(r << 3 | r >> 2);
+    out[1] = (float)(g << 2 | g >> 4);
+    out[2] = (float)(b << 3 | b >> 2);
+}
+
+void Put16(uint8_t* p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+
+void EncodeColour(const uint8_t px[16][4], uint8_t out[8])
+{
+    float mean[3] = {};
+    for (int i = 0; i < 16; ++i)
+        for (int c = 0; c < 3; ++c) mean[c] += px[i][c] / 16.f;
+
+    float cov[6] = {};   // xx xy xz yy yz zz
+    for (int i = 0; i < 16; ++i) {
+        const float d[3] = { px[i][0] - mean[0], px[i][1] - mean[1], px[i][2] - mean[2] };
+        cov[0] += d[0] * d[0]; cov[1] += d[0] * d[1]; cov[2] += d[0] * d[2];
+        cov[3] += d[1] * d[1]; cov[4] += d[1] * d[2]; cov[5] += d[2] * d[2];
+    }
+    // Start from the channel that varies most, so the first step can't vanish
+    const int widest = cov[0] >= cov[3] && cov[0] >= cov[5] ? 0 : cov[3] >= cov[5] ? 1 : 2;
+    float axis[3] = { widest == 0 ? 1.f : 0.f, widest == 1 ? 1.f : 0.f, widest == 2 ? 1.f : 0.f };
+    for (int it = 0; it < 8; ++it) {
+        const float n[3] = { cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+                             cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+                             cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2] };
+        const float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (len < 1e-6f) break;   // flat block: any axis will do
+        for (int c = 0; c < 3; ++c) axis[c] = n[c] / len;
+    }
+
+    float tmin = 0.f, tmax = 0.f;
+    for (int i = 0; i < 16; ++i) {
+        const float t = (px[i][0] - mean[0]) * axis[0] + (px[i][1] - mean[1]) * axis[1] + (px[i][2] - mean[2]) * axis[2];
+        tmin = std::min(tmin, t);
+        tmax = std::max(tmax, t);
+    }
+    const float inset = (tmax - tmin) / 16.f;
+    tmin += inset;
+    tmax -= inset;
+    float e0[3], e1[3];
+    for (int c = 0; c < 3; ++c) {
+        e0[c] = mean[c] + axis[c] * tmax;
+        e1[c] = mean[c] + axis[c] * tmin;
+    }
+    uint16_t c0 = To565(e0), c1 = To565(e1);
+    if (c0 < c1) std::swap(c0, c1);   // c0 > c1 selects the four-colour palette
+
+    uint32_t indices = 0;
+    if (c0 != c1) {
+        float pal[4][3];
+        From565(c0, pal[0]);
+        From565(c1, pal[1]);
+        for (int c = 0; c < 3; ++c) {
+            pal[2][c] = (2.f * pal[0][c] + pal[1][c]) / 3.f;
+            pal[3][c] = (pal[0][c] + 2.f * pal[1][c]) / 3.f;
+        }
+        for (int i = 0; i < 16; ++i) {
+            uint32_t best = 0;
+            float    bestErr = 1e30f;
+            for (uint32_t p = 0; p < 4; ++p) {
+                const float dr = px[i][0] - pal[p][0], dg = px[i][1] - pal[p][1], db = px[i][2] - pal[p][2];
+                const float err = dr * dr + dg * dg + db * db;
+                if (err < bestErr) { bestErr = err; best = p; }
+            }
+            indices |= best << (i * 2);
+        }
+    }
+    Put16(out, c0);
+    Put16(out + 2, c1);
+    for (int b = 0; b < 4; ++b) out[4 + b] = (uint8_t)(indices >> (b * 8));
+}
+
+void EncodeAlpha(const uint8_t px[16][4], uint8_t out[8])
+{
+    int amin = 255, amax = 0;
+    for (int i = 0; i < 16; ++i) {
+        amin = std::min(amin, (int)px[i][3]);
+        amax = std::max(amax, (int)px[i][3]);
+    }
+    uint64_t indices = 0;
+    if (amax > amin) {   // a0 > a1: the eight-value palette
+        int pal[8] = { amax, amin };
+        for (int p = 1; p < 7; ++p) pal[p + 1] = ((7 - p) * amax + p * amin + 3) / 7;
+        for (int i = 0; i < 16; ++i) {
+            uint64_t best = 0;
+            int      bestErr = 256;
+            for (uint64_t p = 0; p < 8; ++p) {
+                const int err = std::abs(px[i][3] - pal[p]);
+                if (err < bestErr) { bestErr = err; best = p; }
+            }
+            indices |= best << (i * 3);
+        }
+    }
+    out[0] = (uint8_t)amax;
+    out[1] = (uint8_t)amin;
+    for (int b = 0; b < 6; ++b) out[2 + b] = (uint8_t)(indices >> (b * 8));
+}
+
+// One level into `out`; blocks past a small level's edge repeat its last pixels
+void EncodeLevel(const Level& level, bool alpha, uint8_t* out)
+{
+    uint8_t px[16][4];
+    for (int by = 0; by < level.h; by += 4) {
+        for (int bx = 0; bx < level.w; bx += 4) {
+            for (int i = 0; i < 16; ++i) {
+                const int x = std::min(bx + i % 4, level.w - 1), y = std::min(by + i / 4, level.h - 1);
+                std::memcpy(px[i], &level.rgba[((size_t)y * level.w + x) * 4], 4);
+            }
+            if (alpha) {
+                EncodeAlpha(px, out);
+                out += 8;
+            }
+            EncodeColour(px, out);
+            out += 8;
+        }
+    }
+}
+
+// ── Files ────────────────────────────────────────────────────────────────────
+
+bool SourceStamp(const std::string& path, uint64_t& size, uint64_t& stamp)
+{
+    uint32_t crc;
+    if (Vfs::Get().Stat(path, size, crc)) {   // inside a mounted archive the CRC stands in for the mtime
+        stamp = crc;
+        return true;
+    }
+    std::error_code ec;
+    size = (uint64_t)fs::file_size(path, ec);
+    if (ec) return false;
+    const auto mtime = fs::last_write_time(path, ec);
+    if (ec) return false;
+    stamp = (uint64_t)mtime.time_since_epoch().count();
+    return true;
+}
+
+// Decode, cook and store `sourcePath`; data null if it doesn't decode
+Image CookFromSource(const std::string& sourcePath, const std::string& cookPath, uint64_t key)
+{
+    Image source = LoadImage(sourcePath.c_str());   // raylib reads through the Vfs
+    if (!source.data) return source;
+    Image cooked = CookImage(source);
+    UnloadImage(source);
+    if (cooked.data && !StoreCookedTexture(cookPath, key, cooked))
+        TraceLog(LOG_WARNING, "TextureCook: could not write %s", cookPath.c_str());
+    return cooked;
+}
+
+} // namespace
+
+uint64_t TextureCookKey(const std::string& sourcePath)
+{
+    const std::string norm = NormalisePath(sourcePath);
+    uint64_t size = 0, stamp = 0;
+    if (!SourceStamp(norm, size, stamp)) return 0;
+
+    uint64_t h = 14695981039346656037ull;
+    auto mix = [&](uint64_t w) { h = (h ^ w) * 1099511628211ull; };
+    mix(TEXTURE_COOK_VERSION);
+    for (const char c : norm) mix((unsigned char)c);
+    mix(size);
+    mix(stamp);
+    return h != 0 ? h : 1;
+}
+
+std::string TextureCookPath(const std::string& dir, uint64_t key)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.dds", static_cast<unsigned long long>(key));
+    return (fs::path(dir) / name).string();
+}
+
+Image CookImage(const Image& image)
+{
+    if (image.format >= PIXELFORMAT_COMPRESSED_DXT1_RGB) return ImageCopy(image);   // cooked already
+
+    Image rgba = ImageCopy(image);   // level 0 is all that's read; the rest is regenerated
+    if (!rgba.data) return rgba;
+    ImageFormat(&rgba, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    std::vector<Level> levels(1);
+    levels[0].w = rgba.width;
+    levels[0].h = rgba.height;
+    levels[0].rgba.assign((const uint8_t*)rgba.data, (const uint8_t*)rgba.data + (size_t)rgba.width * rgba.height * 4);
+    UnloadImage(rgba);
+    while ((levels.back().w > 1 || levels.back().h > 1) && (int)levels.size() < MAX_MIP_LEVELS)
+        levels.push_back(Downsample(levels.back()));
+
+    const Level& top = levels[0];
+    bool opaque = true;
+    for (size_t i = 3; i < top.rgba.size() && opaque; i += 4) opaque = top.rgba[i] == 255;
+    const bool compress = top.w == top.h && IsPow2(top.w) && top.w >= 4;
+    const int  format   = !compress ? PIXELFORMAT_UNCOMPRESSED_R8G8B8A8
+                        : opaque    ? PIXELFORMAT_COMPRESSED_DXT1_RGB
+                                    : PIXELFORMAT_COMPRESSED_DXT5_RGBA;
+
+    Image out{};
+    out.width   = top.w;
+    out.height  = top.h;
+    out.mipmaps = (int)levels.size();
+    out.format  = format;
+    out.data    = MemAlloc((unsigned int)ChainBytes(out.width, out.height, out.mipmaps, format));
+    if (!out.data) return Image{};
+    auto* dst = static_cast<uint8_t*>(out.data);
+    for (const Level& level : levels) {
+        if (compress) EncodeLevel(level, !opaque, dst);
+        else std::memcpy(dst, level.rgba.data(), level.rgba.size());
+        dst += LevelBytes(level.w, level.h, format);
+    }
+    return out;
+}
+
+bool LoadCookedTexture(const std::string& path, uint64_t key, Image& out)
+{
+    Physics::MappedFile file;
+    if (!file.Open(path) || file.Size() < 4 + sizeof(DdsHeader)) return false;
+    if (std::memcmp(file.Data(), "DDS ", 4) != 0) return false;
+    DdsHeader hdr;
+    std::memcpy(&hdr, file.Data() + 4, sizeof(hdr));
+    if (hdr.size != sizeof(DdsHeader) || hdr.reserved1[0] != TEXTURE_COOK_MARKER ||
+        hdr.reserved1[1] != TEXTURE_COOK_VERSION ||
+        hdr.reserved1[2] != (uint32_t)key || hdr.reserved1[3] != (uint32_t)(key >> 32))
+        return false;
+
+    int format;
+    if (hdr.ddspf.flags & DDPF_FOURCC) {
+        if (hdr.ddspf.fourCC == FourCC('D', 'X', 'T', '1'))      format = PIXELFORMAT_COMPRESSED_DXT1_RGB;
+        else if (hdr.ddspf.fourCC == FourCC('D', 'X', 'T', '5')) format = PIXELFORMAT_COMPRESSED_DXT5_RGBA;
+        else return false;
+    } else if ((hdr.ddspf.flags & DDPF_RGB) && hdr.ddspf.rgbBitCount == 32) {
+        format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    } else {
+        return false;
+    }
+    const int mipmaps = std::max(1, (int)hdr.mipMapCount);
+    if (hdr.width == 0 || hdr.height == 0 || hdr.width > 16384 || hdr.height > 16384 || mipmaps > MAX_MIP_LEVELS)
+        return false;
+    const size_t bytes = ChainBytes((int)hdr.width, (int)hdr.height, mipmaps, format);
+    if (file.Size() - 4 - sizeof(DdsHeader) < bytes) return false;
+
+    void* data = MemAlloc((unsigned int)bytes);
+    if (!data) return false;
+    std::memcpy(data, file.Data() + 4 + sizeof(DdsHeader), bytes);
+    out = Image{ data, (int)hdr.width, (int)hdr.height, mipmaps, format };
+    return true;
+}
+
+bool StoreCookedTexture(const std::string& path, uint64_t key, const Image& image)
+{
+    const bool compressed = image.format == PIXELFORMAT_COMPRESSED_DXT1_RGB ||
+                            image.format == PIXELFORMAT_COMPRESSED_DXT5_RGBA;
+    if (!image.data || (!compressed && image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)) return false;
+
+    DdsHeader hdr{};
+    hdr.size         = sizeof(DdsHeader);
+    hdr.flags        = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT |
+                       (compressed ? DDSD_LINEARSIZE : DDSD_PITCH);
+    hdr.height       = (uint32_t)image.height;
+    hdr.width        = (uint32_t)image.width;
+    hdr.pitchOrLinearSize = compressed ? (uint32_t)LevelBytes(image.width, image.height, image.format)
+                                       : (uint32_t)image.width * 4;
+    hdr.mipMapCount  = (uint32_t)image.mipmaps;
+    hdr.reserved1[0] = TEXTURE_COOK_MARKER;
+    hdr.reserved1[1] = TEXTURE_COOK_VERSION;
+    hdr.reserved1[2] = (uint32_t)key;
+    hdr.reserved1[3] = (uint32_t)(key >> 32);
+    hdr.ddspf.size   = sizeof(DdsPixelFormat);
+    if (compressed) {
+        hdr.ddspf.flags  = DDPF_FOURCC;
+        hdr.ddspf.fourCC = image.format == PIXELFORMAT_COMPRESSED_DXT1_RGB ? FourCC('D', 'X', 'T', '1')
+                                                                          : FourCC('D', 'X', 'T', '5');
+    } else {
+        hdr.ddspf.flags       = DDPF_RGB | DDPF_ALPHAPIXELS;
+        hdr.ddspf.rgbBitCount = 32;
+        hdr.ddspf.rMask       = 0x000000ffu;
+        hdr.ddspf.gMask       = 0x0000ff00u;
+        hdr.ddspf.bMask       = 0x00ff0000u;
+        hdr.ddspf.aMask       = 0xff000000u;
+    }
+    hdr.caps = DDSCAPS_TEXTURE | (image.mipmaps > 1 ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0);
+
+    std::error_code ec;
+    const fs::path dir = fs::path(path).parent_path();
+    if (!dir.empty()) fs::create_directories(dir, ec);
+    if (ec) return false;
+
+    // Unique per writer; see StoreBVHCache
+    const size_t salt = std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+                        static_cast<size_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    const std::string tmpPath = path + "." + std::to_string(salt) + ".tmp";
+    {
+        std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!ofs) return false;
+        ofs.write("DDS ", 4);
+        ofs.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        ofs.write(static_cast<const char*>(image.data),
+                  static_cast<std::streamsize>(ChainBytes(image.width, image.height, image.mipmaps, image.format)));
+        if (!ofs) {
+            ofs.close();
+            fs::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    fs::rename(tmpPath, path, ec);
+    if (ec) {
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+Image LoadTextureImage(const std::string& sourcePath, const std::string& cookDir)
+{
+    const uint64_t key = cookDir.empty() ? 0 : TextureCookKey(sourcePath);
+    if (key == 0) return LoadImage(sourcePath.c_str());
+
+    const std::string cookPath = TextureCookPath(cookDir, key);
+    Image image{};
+    if (LoadCookedTexture(cookPath, key, image)) return image;
+    return CookFromSource(sourcePath, cookPath, key);
+}
+
+bool CookTexture(const std::string& sourcePath, const std::string& cookDir)
+{
+    const uint64_t key = cookDir.empty() ? 0 : TextureCookKey(sourcePath);
+    if (key == 0) return false;
+
+    const std::string cookPath = TextureCookPath(cookDir, key);
+    Image image{};
+    if (!LoadCookedTexture(cookPath, key, image)) image = CookFromSource(sourcePath, cookPath, key);
+    const bool ok = image.data != nullptr;
+    UnloadImage(image);
+    return ok && fs::exists(cookPath);
+}
+
+} // namespace Hotones::Assets
@@ -0,0 +1,329 @@
+// Vfs.cpp — zip archives mounted as read-only directories
+
+#include <Assets/Vfs.hpp>
+#include <Physics/BVHCache.hpp>
+#include <miniz.h>
+#include <raylib.h>
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace Hotones::Assets {
+
+struct Vfs::Archive {
+    struct Entry {
+        uint32_t index;        // position in the central directory (cache key)
+        uint64_t localHeader;  // offset of the entry's local file header
+        uint64_t compSize, size;
+        uint32_t crc;
+        uint16_t method;       // 0 stored, 8 deflated
+    };
+
+    Physics::MappedFile                    file;
+    std::unordered_map<std::string, Entry> entries;   // files only, by normalised name
+};
+
+namespace {
+
+constexpr uint32_t LOCAL_HEADER_SIG  = 0x04034b50;
+constexpr uint64_t LOCAL_HEADER_SIZE = 30;
+constexpr uint16_t METHOD_STORED     = 0;
+constexpr uint16_t METHOD_DEFLATED   = 8;
+
+uint32_t Le16(const unsigned char* p) { return (uint32_t)p[0] | (uint32_t)p[1] << 8; }
+uint32_t Le32(const unsigned char* p) { return Le16(p) | Le16(p + 2) << 16; }
+
+// Where the entry's data starts: past the local header, whose name and
+// extra field lengths needn't match the central directory's
+bool DataOffset(const Physics::MappedFile& file, uint64_t localHeader, uint64_t compSize, uint64_t& out)
+{
+    if (localHeader + LOCAL_HEADER_SIZE > file.Size()) return false;
+    const unsigned char* h = file.Data() + localHeader;
+    if (Le32(h) != LOCAL_HEADER_SIG) return false;
+    out = localHeader + LOCAL_HEADER_SIZE + Le16(h + 26) + Le16(h + 28);
+    return out + compSize <= file.Size();
+}
+
+FileView ReadDisk(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return {};
+    const std::streamoff size = in.tellg();
+    if (size < 0) return {};
+    auto bytes = std::make_shared<std::vector<unsigned char>>((size_t)size);
+    in.seekg(0);
+    if (size > 0 && !in.read(reinterpret_cast<char*>(bytes->data()), size)) return {};
+    return { bytes->data(), bytes->size(), bytes };
+}
+
+// raylib's own LoadFileData()/LoadFileText(), for paths no archive holds;
+// buffers come from MemAlloc() since raylib frees them with MemFree()
+unsigned char* LoadDiskData(const char* fileName, int* dataSize)
+{
+    FILE* f = std::fopen(fileName, "rb");
+    if (!f) {
+        TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to open file", fileName);
+        return nullptr;
+    }
+    std::fseek(f, 0, SEEK_END);
+    const long size = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+    unsigned char* data = nullptr;
+    if (size > 0 && size <= INT_MAX) {
+        data = (unsigned char*)MemAlloc((unsigned int)size);
+        if (data && std::fread(data, 1, (size_t)size, f) == (size_t)size) *dataSize = (int)size;
+        else { MemFree(data); data = nullptr; }
+    }
+    std::fclose(f);
+    if (!data) TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to read file", fileName);
+    return data;
+}
+
+unsigned char* LoadVfsData(const char* fileName, int* dataSize)
+{
+    *dataSize = 0;
+    if (!fileName) return nullptr;
+    const FileView f = Vfs::Get().Read(fileName);
+    if (!f) return LoadDiskData(fileName, dataSize);
+    if (f.size == 0 || f.size > INT_MAX) {
+        TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to read file", fileName);
+        return nullptr;
+    }
+    auto* data = (unsigned char*)MemAlloc((unsigned int)f.size);
+    if (!data) return nullptr;
+    std::memcpy(data, f.data, f.size);
+    *dataSize = (int)f.size;
+    return data;
+}
+
+char* LoadVfsText(const char* fileName)
+{
+    if (!fileName) return nullptr;
+    FileView f = Vfs::Get().Read(fileName);
+    if (!f) f = ReadDisk(fileName);
+    if (!f || f.size >= INT_MAX) {
+        TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to open text file", fileName);
+        return nullptr;
+    }
+    auto* text = (char*)MemAlloc((unsigned int)f.size + 1);
+    if (!text) return nullptr;
+    if (f.size) std::memcpy(text, f.data, f.size);
+    text[f.size] = '\0';
+    return text;
+}
+
+} // namespace
+
+Vfs& Vfs::Get()
+{
+    static Vfs s_instance;
+    return s_instance;
+}
+
+bool Vfs::Mount(const std::string& root, const std::string& archivePath)
+{
+    auto archive = std::make_shared<Archive>();
+    if (!archive->file.Open(archivePath)) {
+        TraceLog(LOG_ERROR, "Vfs: can't map %s", archivePath.c_str());
+        return false;
+    }
+
+    mz_zip_archive zip{};
+    if (!mz_zip_reader_init_mem(&zip, archive->file.Data(), archive->file.Size(), 0)) {
+        TraceLog(LOG_ERROR, "Vfs: %s is not a zip archive", archivePath.c_str());
+        return false;
+    }
+    const mz_uint count = mz_zip_reader_get_num_files(&zip);
+    for (mz_uint i = 0; i < count; ++i) {
+        mz_zip_archive_file_stat stat{};
+        if (!mz_zip_reader_file_stat(&zip, i, &stat) || stat.m_is_directory) continue;
+        if (stat.m_is_encrypted || (stat.m_method != METHOD_STORED && stat.m_method != METHOD_DEFLATED)) {
+            TraceLog(LOG_WARNING, "Vfs: %s: skipping %s (encrypted or unsupported compression)",
+                     archivePath.c_str(), stat.m_filename);
+            continue;
+        }
+        std::string name = stat.m_filename;
+        std::replace(name.begin(), name.end(), '\\', '/');
+        name = fs::path(name).lexically_normal().generic_string();
+        archive->entries[name] = { (uint32_t)i, stat.m_local_header_ofs, stat.m_comp_size,
+                                   stat.m_uncomp_size, stat.m_crc32, (uint16_t)stat.m_method };
+    }
+    mz_zip_reader_end(&zip);
+
+    const std::string key = NormalisePath(root);
+    const size_t      files = archive->entries.size();
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        Drop(key);
+        m_mounts.push_back({ key, std::move(archive) });
+    }
+
+    // Everything raylib loads by name now looks in the archives first
+    static std::once_flag s_callbacks;
+    std::call_once(s_callbacks, [] {
+        SetLoadFileDataCallback(LoadVfsData);
+        SetLoadFileTextCallback(LoadVfsText);
+    });
+
+    TraceLog(LOG_INFO, "Vfs: mounted %s at %s (%zu files)", archivePath.c_str(), key.c_str(), files);
+    return true;
+}
+
+void Vfs::Unmount(const std::string& root)
+{
+    const std::string key = NormalisePath(root);
+    std::lock_guard<std::mutex> lk(m_mutex);
+    Drop(key);
+}
+
+void Vfs::Drop(const std::string& root)
+{
+    auto it = std::find_if(m_mounts.begin(), m_mounts.end(), [&](const Mounted& m) { return m.root == root; });
+    if (it == m_mounts.end()) return;
+    const Archive* archive = it->archive.get();
+    m_cache.remove_if([&](const CacheEntry& c) {
+        if (c.archive != archive) return false;
+        m_cacheBytes -= c.bytes->size();
+        return true;
+    });
+    m_mounts.erase(it);
+}
+
+const Vfs::Mounted* Vfs::Find(const std::string& path, std::string& name) const
+{
+    if (m_mounts.empty()) return nullptr;
+    const std::string full = NormalisePath(path);
+    for (const Mounted& m : m_mounts) {
+        if (full.size() <= m.root.size() + 1 || full.compare(0, m.root.size(), m.root) != 0 ||
+            full[m.root.size()] != '/')
+            continue;
+        name = full.substr(m.root.size() + 1);
+        return &m;
+    }
+    return nullptr;
+}
+
+bool Vfs::Exists(const std::string& path) const
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    std::string name;
+    const Mounted* m = Find(path, name);
+    return m && m->archive->entries.count(name) != 0;
+}
+
+bool Vfs::Stat(const std::string& path, uint64_t& size, uint32_t& crc) const
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    std::string name;
+    const Mounted* m = Find(path, name);
+    if (!m) return false;
+    auto it = m->archive->entries.find(name);
+    if (it == m->archive->entries.end()) return false;
+    size = it->second.size;
+    crc  = it->second.crc;
+    return true;
+}
+
+FileView Vfs::Read(const std::string& path)
+{
+    std::shared_ptr<Archive> archive;
+    Archive::Entry           entry;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        std::string name;
+        const Mounted* m = Find(path, name);
+        if (!m) return {};
+        auto it = m->archive->entries.find(name);
+        if (it == m->archive->entries.end()) return {};
+        archive = m->archive;
+        entry   = it->second;
+
+        if (entry.method == METHOD_DEFLATED) {
+            for (auto c = m_cache.begin(); c != m_cache.end(); ++c) {
+                if (c->archive != archive.get() || c->index != entry.index) continue;
+                m_cache.splice(m_cache.begin(), m_cache, c);
+                m_hits++;
+                const auto& bytes = m_cache.front().bytes;
+                return { bytes->data(), bytes->size(), bytes };
+            }
+        }
+    }
+
+    uint64_t offset;
+    if (!DataOffset(archive->file, entry.localHeader, entry.compSize, offset)) {
+        TraceLog(LOG_WARNING, "Vfs: %s: bad local header", path.c_str());
+        return {};
+    }
+    const unsigned char* src = archive->file.Data() + offset;
+    if (entry.method == METHOD_STORED) {
+        if (entry.compSize != entry.size) return {};
+        return { src, (size_t)entry.size, archive };   // in place
+    }
+
+    // Inflated outside the lock so other readers aren't held up
+    auto bytes = std::make_shared<std::vector<unsigned char>>((size_t)entry.size);
+    if (entry.size > 0) {
+        const size_t got = tinfl_decompress_mem_to_mem(bytes->data(), bytes->size(), src, (size_t)entry.compSize, 0);
+        if (got != entry.size || mz_crc32(MZ_CRC32_INIT, bytes->data(), bytes->size()) != entry.crc) {
+            TraceLog(LOG_WARNING, "Vfs: %s: corrupt compressed data", path.c_str());
+            return {};
+        }
+    }
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_inflates++;
+    const bool mounted = std::any_of(m_mounts.begin(), m_mounts.end(),
+                                     [&](const Mounted& m) { return m.archive == archive; });
+    if (mounted && bytes->size() <= CACHE_BUDGET / 4) {   // a single huge file would flush everything else
+        m_cache.push_front({ archive.get(), entry.index, bytes });
+        m_cacheBytes += bytes->size();
+        while (m_cacheBytes > CACHE_BUDGET) {
+            m_cacheBytes -= m_cache.back().bytes->size();
+            m_cache.pop_back();
+        }
+    }
+    return { bytes->data(), bytes->size(), bytes };
+}
+
+Vfs::Stats Vfs::GetStats() const
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    Stats stats;
+    stats.mounts     = (int)m_mounts.size();
+    stats.cacheBytes = m_cacheBytes;
+    stats.hits       = m_hits;
+    stats.inflates   = m_inflates;
+    for (const Mounted& m : m_mounts) stats.mappedBytes += m.archive->file.Size();
+    return stats;
+}
+
+std::string NormalisePath(const std::string& path)
+{
+    std::error_code ec;
+    fs::path p = fs::absolute(fs::path(path), ec);
+    if (ec) p = path;
+    std::string s = p.lexically_normal().generic_string();
+    while (s.size() > 1 && s.back() == '/') s.pop_back();
+    return s;
+}
+
+bool FileExists(const std::string& path)
+{
+    if (Vfs::Get().Exists(path)) return true;
+    std::error_code ec;
+    return fs::is_regular_file(path, ec);
+}
+
+FileView ReadFile(const std::string& path)
+{
+    FileView f = Vfs::Get().Read(path);
+    return f ? f : ReadDisk(path);
+}
+
+} // namespace Hotones::Assets
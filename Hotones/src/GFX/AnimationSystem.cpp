@@ -0,0 +1,301 @@
+// AnimationSystem.cpp — skeletal animation with distance-based pose LOD, GPU skinned
+
+#include <GFX/AnimationSystem.hpp>
+#include <GFX/LightingSystem.hpp>
+#include <GFX/OcclusionCulling.hpp>
+#include <Jobs/JobSystem.hpp>
+#include <raymath.h>
+#include <rlgl.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Hotones::GFX {
+
+namespace {
+
+// Key pair around `time` and how far between them; past the ends, the end
+template<typename Key>
+const Key* Bracket(const std::vector<Key>& keys, float time, const Key*& next, float& t)
+{
+    const auto after = std::upper_bound(keys.begin(), keys.end(), time,
+                                        [](float v, const Key& k) { return v < k.time; });
+    if (after == keys.begin()) { next = &keys.front(); t = 0.f; return next; }
+    if (after == keys.end())   { next = &keys.back();  t = 0.f; return next; }
+    const Key* before = &*(after - 1);
+    next = &*after;
+    const float span = next->time - before->time;
+    t = span > 0.f ? (time - before->time) / span : 0.f;
+    return before;
+}
+
+Vector3 SampleVector(const std::vector<SceneVectorKey>& keys, float time)
+{
+    const SceneVectorKey* next;
+    float t;
+    const SceneVectorKey* key = Bracket(keys, time, next, t);
+    return Vector3Lerp(key->value, next->value, t);
+}
+
+Quaternion SampleRotation(const std::vector<SceneRotationKey>& keys, float time)
+{
+    const SceneRotationKey* next;
+    float t;
+    const SceneRotationKey* key = Bracket(keys, time, next, t);
+    return QuaternionSlerp(key->value, next->value, t);
+}
+
+// A node's local transform at `time`: its channel's keys, the bind pose
+// for whatever the channel has no keys for
+Matrix SampleLocal(const SceneAnimChannel& ch, const Matrix& bind, float time)
+{
+    Vector3    translation = { bind.m12, bind.m13, bind.m14 };
+    Vector3    scale       = { Vector3Length({ bind.m0, bind.m1, bind.m2 }),
+                               Vector3Length({ bind.m4, bind.m5, bind.m6 }),
+                               Vector3Length({ bind.m8, bind.m9, bind.m10 }) };
+    Quaternion rotation;
+    if (!ch.positions.empty()) translation = SampleVector(ch.positions, time);
+    if (!ch.scales.empty())    scale       = SampleVector(ch.scales, time);
+    if (!ch.rotations.empty()) {
+        rotation = SampleRotation(ch.rotations, time);
+    } else {
+        Matrix r = bind;
+        r.m12 = r.m13 = r.m14 = 0.f;
+        if (scale.x > 0.f) { r.m0 /= scale.x; r.m1 /= scale.x; r.m2 /= scale.x; }
+        if (scale.y > 0.f) { r.m4 /= scale.y; r.m5 /= scale.y; r.m6 /= scale.y; }
+        if (scale.z > 0.f) { r.m8 /= scale.z; r.m9 /= scale.z; r.m10 /= scale.z; }
+        rotation = QuaternionFromMatrix(r);
+    }
+    // Scale, then rotate, then translate
+    return MatrixMultiply(MatrixMultiply(MatrixScale(scale.x, scale.y, scale.z), QuaternionToMatrix(rotation)),
+                          MatrixTranslate(translation.x, translation.y, translation.z));
+}
+
+int PaletteSize(const ImportedScene& rig)
+{
+    int bones = 0;
+    for (const SceneMesh& sm : rig.meshes) bones += (int)sm.skin.bones.size();
+    return bones;
+}
+
+// Point `m` at `palette` for the skinned shader; false when raylib can't skin
+bool BindPalette(Mesh& m, const Matrix* palette, int count)
+{
+#if defined(RL_DEFAULT_SHADER_ATTRIB_NAME_BONEIDS)
+    m.boneMatrices = const_cast<Matrix*>(palette);   // read only, by DrawMesh()
+    m.boneCount    = count;
+    return true;
+#else
+    (void)m; (void)palette; (void)count;
+    return false;
+#endif
+}
+
+} // namespace
+
+// ── Simulation ────────────────────────────────────────────────────────────────
+
+void AnimationSystem::SetView(const Camera& camera, float aspect)
+{
+    m_hasView     = true;
+    m_viewPos     = camera.position;
+    m_viewFrustum = Frustum::FromCamera(camera, aspect);
+}
+
+void AnimationSystem::SetBands(std::vector<Band> bands, Band beyond)
+{
+    const auto fix = [](Band& b) {
+        b.interval = std::max(b.interval, 0.f);
+        b.level    = std::clamp(b.level, 0, SKIN_LOD_LEVELS - 1);
+    };
+    for (Band& b : bands) fix(b);
+    fix(beyond);
+    m_bands  = std::move(bands);
+    m_beyond = beyond;
+}
+
+void AnimationSystem::Update(ECS::Registry& reg, float dt)
+{
+    ++m_tick;
+    m_stats.characters = m_stats.posed = m_stats.bones = 0;
+
+    // ── Gather: advance the clips, find the poses due ─────────────────────────
+    m_due.clear();
+    reg.View<ECS::SkinnedModelComponent, ECS::TransformComponent>(
+        [&](ECS::EntityId id, ECS::SkinnedModelComponent& sm, auto&& tr) {
+            if (!sm.rig) return;
+            const ImportedScene& rig = *sm.rig;
+
+            if (sm.clip >= 0 && sm.clip < (int)rig.animations.size()) {
+                const float duration = rig.animations[sm.clip].duration;
+                sm.time += dt * sm.speed;
+                if (sm.loop && duration > 0.f) {
+                    sm.time = fmodf(sm.time, duration);
+                    if (sm.time < 0.f) sm.time += duration;
+                } else {
+                    sm.time = std::clamp(sm.time, 0.f, duration);
+                }
+            }
+
+            Character& c = m_characters[id];
+            if (c.rig != sm.rig) {
+                c.rig    = sm.rig;
+                c.posed  = false;
+                c.palette.assign(PaletteSize(rig), MatrixIdentity());
+                bool any = false;
+                for (const SceneMesh& m : rig.meshes) {
+                    if (m.skin.Empty()) continue;
+                    c.rigBounds.min = any ? Vector3Min(c.rigBounds.min, m.bounds.min) : m.bounds.min;
+                    c.rigBounds.max = any ? Vector3Max(c.rigBounds.max, m.bounds.max) : m.bounds.max;
+                    any = true;
+                }
+                const Vector3 grow = Vector3Scale(Vector3Subtract(c.rigBounds.max, c.rigBounds.min), 0.25f);
+                c.rigBounds.min = Vector3Subtract(c.rigBounds.min, grow);
+                c.rigBounds.max = Vector3Add(c.rigBounds.max, grow);
+            }
+            c.seenTick = m_tick;
+            c.clip     = sm.clip;
+            c.time     = sm.time;
+            c.world    = tr.ToMatrix();
+            c.tint     = sm.tint;
+            c.visible  = sm.visible;
+            c.bounds   = TransformBox(c.rigBounds, c.world);
+            m_stats.characters++;
+
+            // Its band: by distance when in view, else the slowest
+            Band band;   // no view yet: every tick, in full
+            if (m_hasView) {
+                band = m_beyond;
+                if (sm.visible && m_viewFrustum.Intersects(c.bounds)) {
+                    const float distance = Vector3Distance(m_viewPos, tr.position);
+                    for (const Band& b : m_bands)
+                        if (distance < b.distance) { band = b; break; }
+                }
+            }
+            c.sincePose += dt;
+            if (c.posed && c.sincePose < band.interval) return;
+            c.sincePose = 0.f;
+            c.level     = std::min(band.level, (int)rig.poseNodes.size() - 1);
+            c.posed     = true;
+            m_due.push_back(&c);
+        });
+
+    // Characters removed, or whose entity is gone; their rigs go with them
+    for (auto it = m_characters.begin(); it != m_characters.end();) {
+        if (it->second.seenTick == m_tick) { ++it; continue; }
+        it = m_characters.erase(it);
+    }
+    if (m_due.empty()) return;
+
+    Jobs::JobSystem::Get().ParallelFor(m_due.size(), GRAIN,
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) Pose(*m_due[i]);
+        });
+    m_stats.posed = (int)m_due.size();
+    for (const Character* c : m_due) {
+        for (const SceneMesh& m : c->rig->meshes) {
+            if (m.skin.Empty()) continue;
+            const std::vector<uint8_t>& posedAs = m.skin.lodBones[c->level];
+            for (size_t b = 0; b < posedAs.size(); ++b) m_stats.bones += posedAs[b] == b;
+        }
+    }
+}
+
+void AnimationSystem::Pose(Character& c)
+{
+    const ImportedScene& rig = *c.rig;
+    if (c.level < 0) return;   // no skins
+
+    // ── The nodes this level needs, parents first ─────────────────────────────
+    thread_local std::vector<Matrix> nodeWorld;
+    nodeWorld.resize(rig.nodes.size());
+    const SceneAnimation* clip = c.clip >= 0 && c.clip < (int)rig.animations.size()
+                                     ? &rig.animations[c.clip] : nullptr;
+    for (const int n : rig.poseNodes[c.level]) {
+        const SceneNode& node    = rig.nodes[n];
+        const int        channel = clip ? clip->nodeChannel[n] : -1;
+        const Matrix     local   = channel >= 0 ? SampleLocal(clip->channels[channel], node.local, c.time)
+                                                : node.local;
+        nodeWorld[n] = node.parent >= 0 ? MatrixMultiply(local, nodeWorld[node.parent]) : local;
+    }
+
+    // ── Bone matrices: mesh → bone (bind pose) → posed node → mesh ────────────
+    Matrix* palette = c.palette.data();
+    for (const SceneMesh& m : rig.meshes) {
+        const std::vector<SceneBone>& bones = m.skin.bones;
+        if (bones.empty()) continue;
+        const std::vector<uint8_t>& posedAs = m.skin.lodBones[c.level];
+        const Matrix toMesh = MatrixInvert(m.transform);
+        for (size_t b = 0; b < bones.size(); ++b) {
+            if (posedAs[b] != b) continue;
+            palette[b] = bones[b].node >= 0
+                       ? MatrixMultiply(MatrixMultiply(bones[b].offset, nodeWorld[bones[b].node]), toMesh)
+                       : MatrixIdentity();
+        }
+        // Dropped bones move with the ancestor standing in for them
+        for (size_t b = 0; b < bones.size(); ++b)
+            if (posedAs[b] != b) palette[b] = palette[posedAs[b]];
+        palette += bones.size();
+    }
+}
+
+// ── Drawing ───────────────────────────────────────────────────────────────────
+
+void AnimationSystem::Capture(Frame& out) const
+{
+    out.Clear();
+    for (const auto& [id, c] : m_characters) {
+        if (!c.visible || !c.posed || c.palette.empty()) continue;
+        out.characters.push_back({ c.rig, c.world, c.tint, c.bounds, out.palettes.size() });
+        out.palettes.insert(out.palettes.end(), c.palette.begin(), c.palette.end());
+    }
+}
+
+void AnimationSystem::Draw(const Frame& frame, const Frustum& frustum, RenderQueue& queue,
+                           const OcclusionCuller* occlusion)
+{
+    m_stats.drawn = m_stats.culled = m_stats.occluded = m_stats.drawCalls = 0;
+    const Shader& skinned = LightingSystem::Get().GetSkinnedShader();
+    if (skinned.id == 0) return;
+
+    // The queue keeps pointers: room for every draw up front
+    size_t draws = 0;
+    for (const Frame::Character& c : frame.characters)
+        for (const SceneMesh& m : c.rig->meshes) draws += !m.skin.Empty();
+    m_meshes.clear();
+    m_meshes.reserve(draws);
+
+    for (const Frame::Character& c : frame.characters) {
+        if (!frustum.Intersects(c.bounds)) {
+            m_stats.culled++;
+            continue;
+        }
+        if (occlusion && !occlusion->IsVisible(c.bounds)) {
+            m_stats.occluded++;
+            continue;
+        }
+        const Matrix* palette = frame.palettes.data() + c.first;
+        for (const SceneMesh& sm : c.rig->meshes) {
+            if (sm.skin.Empty()) continue;
+            Mesh& mesh = m_meshes.emplace_back(sm.mesh);
+            const int bones = (int)sm.skin.bones.size();
+            if (!BindPalette(mesh, palette, bones)) return;
+            palette += bones;
+
+            Material material = sm.mat;
+            material.shader   = skinned;
+            // Tint the diffuse colour as DrawModelEx does
+            const Color base    = material.maps[MATERIAL_MAP_DIFFUSE].color;
+            const Color diffuse = {
+                (unsigned char)(((int)base.r * (int)c.tint.r) / 255),
+                (unsigned char)(((int)base.g * (int)c.tint.g) / 255),
+                (unsigned char)(((int)base.b * (int)c.tint.b) / 255),
+                (unsigned char)(((int)base.a * (int)c.tint.a) / 255),
+            };
+            queue.Submit(mesh, material, diffuse, MatrixMultiply(sm.transform, c.world));
+            m_stats.drawCalls++;
+        }
+        m_stats.drawn++;
+    }
+}
+
+} // namespace Hotones::GFX
@@ -1,5 +1,7 @@
 #include "AssetPath.hpp"
+#include <mutex>
 #include <string>
+#include <unordered_set>
 #include <stdio.h>
 
 #ifdef _WIN32
@@ -12,7 +14,7 @@
 #include <libgen.h>
 #endif
 
-static std::string GetExecutableDir()
+static std::string QueryExecutableDir()
 {
 #ifdef _WIN32
     std::vector<char> buf(MAX_PATH);
@@ -34,6 +36,12 @@ static std::string GetExecutableDir()
 #endif
 }
 
+static const std::string& GetExecutableDir()
+{
+    static const std::string dir = QueryExecutableDir();   // the executable doesn't move
+    return dir;
+}
+
 static bool IsAbsolutePath(const std::string &p)
 {
 #ifdef _WIN32
@@ -51,7 +59,7 @@ std::string ResolveAssetPath(const std::string &assetPath)
     if (assetPath.empty()) return assetPath;
     if (IsAbsolutePath(assetPath)) return assetPath;
 
-    std::string exeDir = GetExecutableDir();
+    const std::string& exeDir = GetExecutableDir();
     if (exeDir.empty()) return assetPath;
 
 #ifdef _WIN32
@@ -62,7 +70,15 @@ std::string ResolveAssetPath(const std::string &assetPath)
     std::string out = exeDir;
     if (out.back() != sep) out.push_back(sep);
     out += assetPath;
-    // Log resolved path and whether file exists
+
+    // Log resolved path and whether file exists, the first time it is asked
+    // for; loads resolve the same paths over and over
+    static std::mutex                      s_loggedMutex;
+    static std::unordered_set<std::string> s_logged;
+    {
+        std::lock_guard<std::mutex> lk(s_loggedMutex);
+        if (!s_logged.insert(assetPath).second) return out;
+    }
     FILE *f = fopen(out.c_str(), "rb");
     if (f) {
         fprintf(stderr, "ResolveAssetPath: found asset at %s\n", out.c_str());
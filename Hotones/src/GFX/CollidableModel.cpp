@@ -1,5 +1,7 @@
 #include <GFX/CollidableModel.hpp>
 #include "AssetPath.hpp"
+#include <Assets/AssetCache.hpp>
+#include <Assets/Vfs.hpp>
 #include <raylib.h>
 #include <raymath.h>
 #include <GFX/bsp.hpp>
@@ -7,43 +9,75 @@
 #include <crtdbg.h>
 #endif
 #include <Physics/PhysicsSystem.hpp>
+#include <mutex>
+#include <unordered_map>
 
 namespace Hotones {
 
+namespace {
+
+// Collision shapes by model.  Loads of one file share the AssetCache's
+// model, so every CollidableModel placing it shares one tree too.
+struct SharedShape {
+    int shape = -1;
+    int users = 0;
+};
+std::mutex                                     s_shapeMutex;
+std::unordered_map<const Mesh*, SharedShape>   s_shapes;   // by model.meshes
+
+int AcquireShape(const Model& model) {
+    if (model.meshCount <= 0 || model.meshes == NULL) return -1;
+    std::lock_guard<std::mutex> lk(s_shapeMutex);
+    SharedShape& shared = s_shapes[model.meshes];
+    if (shared.users == 0) shared.shape = Physics::RegisterMeshShape(model);
+    if (shared.shape < 0) {
+        s_shapes.erase(model.meshes);
+        return -1;
+    }
+    ++shared.users;
+    return shared.shape;
+}
+
+void ReleaseShape(const Mesh* key) {
+    std::lock_guard<std::mutex> lk(s_shapeMutex);
+    auto it = s_shapes.find(key);
+    if (it == s_shapes.end() || --it->second.users > 0) return;
+    Physics::UnregisterMeshShape(it->second.shape);
+    s_shapes.erase(it);
+}
+
+} // namespace
+
 CollidableModel::CollidableModel(const std::string& path, Vector3 position)
     : position(position)
 {
     std::string resolved = ResolveAssetPath(path);
     const char* loadPath = (!resolved.empty() ? resolved.c_str() : path.c_str());
     TraceLog(LOG_INFO, "CollidableModel: loading model '%s'", loadPath);
-    // Check file exists before calling into raylib's loaders (can crash if file missing/corrupt)
-    FILE *f = fopen(loadPath, "rb");
-    if (!f) {
+    // Check file exists before calling into raylib's loaders (can crash if file missing/corrupt).
+    // Models inside a mounted .cup only exist in the Vfs, which raylib reads through.
+    if (!Assets::FileExists(loadPath)) {
         TraceLog(LOG_ERROR, "CollidableModel: model file not found: %s", loadPath);
         model = {0};
     } else {
-        fclose(f);
         // If the file appears to be a BSP, attempt to load via the BSP importer
         try {
             std::filesystem::path p(loadPath);
             std::string ext = p.extension().string();
             for (auto &c : ext) c = (char)tolower(c);
-            // if (ext == ".bsp") {
-            //     auto models = LoadModelsFromBSPFile(p);
-            //     if (!models.empty()) {
-            //         // Use the first generated model and unload any extras
-            //         model = std::move(models[0]);
-            //         for (size_t i = 1; i < models.size(); ++i) {
-            //             UnloadModel(models[i]);
-            //         }
-            //     } else {
-            //         TraceLog(LOG_ERROR, "CollidableModel: failed to import BSP: %s", loadPath);
-            //         model = {0};
-            //     }
-            // } else {
-            model = LoadModel(loadPath);
-            
-            
+            if (ext == ".bsp") {
+                // Quake map: the world's faces plus the leaves and PVS Draw(viewPos, ...) culls with
+                bsp = std::make_unique<BSPWorld>();
+                if (!bsp->Load(p, model)) {
+                    TraceLog(LOG_ERROR, "CollidableModel: failed to import BSP: %s", loadPath);
+                    bsp.reset();
+                    model = {0};
+                }
+            } else {
+                // Shared with every other load of the same file
+                asset = Assets::AssetCache::Get().LoadModel(loadPath);
+                if (asset) model = *asset;
+            }
         } catch (const std::exception &e) {
             TraceLog(LOG_ERROR, "CollidableModel: exception while loading model: %s: %s", loadPath, e.what());
             model = {0};
@@ -57,14 +91,30 @@ CollidableModel::CollidableModel(const std::string& path, Vector3 position)
     }
     UpdateBoundingBox();
 
-    // Register this model's geometry with the physics system (best-effort).
+    // Place this model's collision shape, shared with other loads of the
+    // same file, in the physics system (best-effort)
     physicsHandle = -1;
-    physicsHandle = Hotones::Physics::RegisterStaticMeshFromModel(model, position);
+    const int shape = AcquireShape(model);
+    if (shape >= 0) {
+        shapeKey      = model.meshes;
+        physicsHandle = Physics::CreateMeshInstance(shape, MatrixTranslate(position.x, position.y, position.z));
+    }
 }
 
 CollidableModel::~CollidableModel() {
+    // Unregister from physics system if needed
+    if (physicsHandle != -1) {
+        Hotones::Physics::UnregisterStaticMesh(physicsHandle);
+        physicsHandle = -1;
+    }
+    if (shapeKey) ReleaseShape(shapeKey);
     TraceLog(LOG_INFO, "CollidableModel: unloading model (meshes=%p, meshCount=%d, materials=%p, materialCount=%d)",
              (const void*)model.meshes, model.meshCount, (const void*)model.materials, model.materialCount);
+    // A cached model is the cache's to unload, once nobody holds it
+    if (asset) {
+        model = {0};
+        asset.reset();
+    }
     // Only call UnloadModel if there is something to unload or pointers are non-null
     if (model.meshCount > 0 || model.materialCount > 0 || model.meshes != NULL || model.materials != NULL) {
 #if defined(_WIN32)
@@ -79,20 +129,54 @@ CollidableModel::~CollidableModel() {
         // Clear the model struct so dangling pointers are not reused
         model = {0};
     }
-    // Unregister from physics system if needed
-    if (physicsHandle != -1) {
-        Hotones::Physics::UnregisterStaticMesh(physicsHandle);
-        physicsHandle = -1;
-    }
+    if (bsp) bsp->Unload();
 }
 
 void CollidableModel::Draw() {
     DrawModel(model, position, 1.0f, WHITE);
 }
 
+void CollidableModel::Draw(const GFX::Frustum& frustum) {
+    // DrawModel(model, position, 1, WHITE) for the meshes in view
+    const Matrix transform = MatrixMultiply(model.transform, MatrixTranslate(position.x, position.y, position.z));
+    cullTree.Query(frustum, [&](uint32_t i) {
+        DrawMesh(model.meshes[i], model.materials[model.meshMaterial[i]], transform);
+    });
+}
+
+void CollidableModel::Draw(const GFX::Frustum& frustum, GFX::RenderQueue& queue,
+                           const GFX::OcclusionCuller* occlusion) {
+    const Matrix transform = MatrixMultiply(model.transform, MatrixTranslate(position.x, position.y, position.z));
+    cullTree.Query(frustum, [&](uint32_t i) {
+        if (occlusion && !occlusion->IsVisible(meshBounds[i])) return;
+        queue.Submit(model.meshes[i], model.materials[model.meshMaterial[i]], transform);
+    });
+}
+
+void CollidableModel::Draw(Vector3 viewPos, const GFX::Frustum& frustum, GFX::RenderQueue& queue,
+                           const GFX::OcclusionCuller* occlusion) {
+    if (!bsp) {
+        Draw(frustum, queue, occlusion);
+        return;
+    }
+    const Matrix transform = MatrixMultiply(model.transform, MatrixTranslate(position.x, position.y, position.z));
+    bsp->Draw(model, transform, viewPos, frustum, queue);
+}
+
+void CollidableModel::DrawOccluders(const GFX::Frustum& frustum, GFX::RenderQueue& queue) {
+    const Matrix transform = MatrixMultiply(model.transform, MatrixTranslate(position.x, position.y, position.z));
+    cullTree.Query(frustum, [&](uint32_t i) {
+        const Material& material = model.materials[model.meshMaterial[i]];
+        if (material.maps[MATERIAL_MAP_DIFFUSE].color.a < 255) return;   // see-through
+        if (Vector3Distance(meshBounds[i].min, meshBounds[i].max) < GFX::OCCLUDER_MIN_SIZE) return;
+        queue.Submit(model.meshes[i], material, transform, GFX::RenderPass::Opaque);
+    });
+}
+
 void CollidableModel::SetPosition(Vector3 pos) {
     position = pos;
     UpdateBoundingBox();
+    if (physicsHandle != -1) Physics::SetMeshTransform(physicsHandle, MatrixTranslate(pos.x, pos.y, pos.z));
 }
 
 Vector3 CollidableModel::GetPosition() const {
@@ -117,6 +201,16 @@ bool CollidableModel::ResolveSphereCollision(Vector3 &center, float radius) {
     return Hotones::Physics::ResolveSphereAgainstStatic(physicsHandle, center, radius);
 }
 
+bool CollidableModel::IsPhysicsReady() const {
+    return physicsHandle != -1 && Hotones::Physics::IsMeshReady(physicsHandle);
+}
+
+bool CollidableModel::WaitForPhysics(float timeoutSeconds) const {
+    if (physicsHandle == -1) return false;
+    const int handles[] = { physicsHandle };
+    return Hotones::Physics::WaitForMeshes(handles, timeoutSeconds);
+}
+
 bool Hotones::CollidableModel::SweepSphere(const Vector3 &start, const Vector3 &end,
                                            float radius,
                                            Vector3 &hitPos, Vector3 &hitNormal, float &t) {
@@ -143,6 +237,27 @@ bool Hotones::CollidableModel::SweepSphere(const Vector3 &start, const Vector3 &
     return hit;
 }
 
+Hotones::Physics::SlideResult Hotones::CollidableModel::SlideSphere(const Vector3 &start, const Vector3 &motion,
+                                                                    float radius,
+                                                                    const Physics::SlideParams &params,
+                                                                    Vector3 *velocity) {
+    Physics::SlideResult result;
+    if (physicsHandle == -1) {
+        result.position = Vector3Add(start, motion);
+    } else {
+        result = Hotones::Physics::SlideSphereAgainstStatic(physicsHandle, start, motion, radius, params, velocity);
+    }
+
+    // Debug view shows the whole move and where it ended
+    lastSweepStart     = start;
+    lastSweepEnd       = Vector3Add(start, motion);
+    lastSweepHit       = result.contacts > 0;
+    lastSweepHitPos    = result.position;
+    lastSweepHitNormal = result.groundNormal;
+    lastSweepT         = 0.f;
+    return result;
+}
+
 void Hotones::CollidableModel::DrawDebug() const {
     // draw per-mesh AABBs
     if (model.meshCount > 0 && model.meshes != NULL) {
@@ -215,6 +330,13 @@ void CollidableModel::UpdateBoundingBox() {
         bbox.min = position;
         bbox.max = position;
     }
+
+    // Per-mesh bounds for frustum culling, as Draw() places the meshes
+    const Matrix transform = MatrixMultiply(model.transform, MatrixTranslate(position.x, position.y, position.z));
+    meshBounds.clear();
+    for (int i = 0; i < model.meshCount && model.meshes != NULL; ++i)
+        meshBounds.push_back(GFX::TransformBox(GetMeshBoundingBox(model.meshes[i]), transform));
+    cullTree.Build(meshBounds);
 }
 
 } // namespace Hotones
@@ -0,0 +1,153 @@
+// DrawList.cpp — recorded immediate-mode draws, replayed on the main thread
+
+#include <GFX/DrawList.hpp>
+#include <GFX/PrimitiveBatch.hpp>
+#include <GFX/TextCache.hpp>
+#include <raylib.h>
+
+namespace Hotones::GFX {
+
+namespace {
+    thread_local DrawList* t_recording = nullptr;
+}
+
+DrawList* DrawList::Recording() { return t_recording; }
+
+DrawList::Scope::Scope(DrawList& list)
+    : m_previous(t_recording)
+{
+    t_recording = &list;
+}
+
+DrawList::Scope::~Scope() { t_recording = m_previous; }
+
+// ── Recording ─────────────────────────────────────────────────────────────────
+
+DrawList::Command& DrawList::Add(Op op, Color color)
+{
+    Command& c = m_commands.emplace_back();
+    c.op    = op;
+    c.color = color;
+    return c;
+}
+
+void DrawList::ClearScreen(Color color) { Add(Op::ClearScreen, color); }
+
+void DrawList::Text(std::string_view text, int x, int y, int fontSize, Color color)
+{
+    Command& c   = Add(Op::Text, color);
+    c.a          = { (float)fontSize, 0.f, 0.f };
+    c.n0         = x;
+    c.n1         = y;
+    c.text       = (uint32_t)m_text.size();
+    c.textLength = (uint32_t)text.size();
+    m_text.append(text);
+}
+
+void DrawList::Rect(int x, int y, int width, int height, Color color)
+{
+    Command& c = Add(Op::Rect, color);
+    c.n0 = x;
+    c.n1 = y;
+    c.b  = { (float)width, (float)height, 0.f };
+}
+
+void DrawList::Line3D(Vector3 start, Vector3 end, Color color)
+{
+    Command& c = Add(Op::Line3D, color);
+    c.a = start;
+    c.b = end;
+}
+
+void DrawList::CubeWires(Vector3 centre, Vector3 size, Color color)
+{
+    Command& c = Add(Op::CubeWires, color);
+    c.a = centre;
+    c.b = size;
+}
+
+void DrawList::Grid(int slices, float spacing)
+{
+    Command& c = Add(Op::Grid, WHITE);
+    c.n0  = slices;
+    c.b.x = spacing;
+}
+
+void DrawList::Box(Vector3 centre, Vector3 size, Color color)
+{
+    Command& c = Add(Op::Box, color);
+    c.a = centre;
+    c.b = size;
+}
+
+void DrawList::Plane(Vector3 centre, Vector2 size, Color color)
+{
+    Command& c = Add(Op::Plane, color);
+    c.a = centre;
+    c.b = { size.x, size.y, 0.f };
+}
+
+void DrawList::Sphere(Vector3 centre, float radius, int rings, int slices, Color color)
+{
+    Command& c = Add(Op::Sphere, color);
+    c.a   = centre;
+    c.b.x = radius;
+    c.n0  = rings;
+    c.n1  = slices;
+}
+
+void DrawList::Cylinder(Vector3 base, float radiusTop, float radiusBottom, float height, int slices, Color color)
+{
+    Command& c = Add(Op::Cylinder, color);
+    c.a  = base;
+    c.b  = { radiusTop, radiusBottom, height };
+    c.n0 = slices;
+}
+
+// ── Replay ────────────────────────────────────────────────────────────────────
+
+void DrawList::Replay(PrimitiveBatch* batch) const
+{
+    const bool batching = batch && batch->IsReady();
+    for (const Command& c : m_commands) {
+        switch (c.op) {
+        case Op::ClearScreen:
+            ClearBackground(c.color);
+            break;
+        case Op::Text:
+            TextCache::Get().DrawTextEx(GetFontDefault(), std::string_view(m_text).substr(c.text, c.textLength),
+                                        Vector2{ (float)c.n0, (float)c.n1 }, c.a.x, 0.0f, c.color);
+            break;
+        case Op::Rect:
+            DrawRectangle(c.n0, c.n1, (int)c.b.x, (int)c.b.y, c.color);
+            break;
+        case Op::Line3D:
+            DrawLine3D(c.a, c.b, c.color);
+            break;
+        case Op::CubeWires:
+            DrawCubeWiresV(c.a, c.b, c.color);
+            break;
+        case Op::Grid:
+            DrawGrid(c.n0, c.b.x);
+            break;
+        case Op::Box:
+            if (batching) batch->Box(c.a, c.b, c.color);
+            else          DrawCubeV(c.a, c.b, c.color);
+            break;
+        case Op::Plane:
+            if (batching) batch->Plane(c.a, { c.b.x, c.b.y }, c.color);
+            else          DrawPlane(c.a, { c.b.x, c.b.y }, c.color);
+            break;
+        case Op::Sphere:
+            if (batching) batch->Sphere(c.a, c.b.x, c.n0, c.n1, c.color);
+            else          DrawSphereEx(c.a, c.b.x, c.n0, c.n1, c.color);
+            break;
+        case Op::Cylinder:
+            if (batching) batch->Cylinder(c.a, c.b.x, c.b.y, c.b.z, c.n0, c.color);
+            else          DrawCylinderEx(c.a, { c.a.x, c.a.y + c.b.z, c.a.z }, c.b.y, c.b.x, c.n0, c.color);
+            break;
+        }
+    }
+}
+
+} // namespace Hotones::GFX
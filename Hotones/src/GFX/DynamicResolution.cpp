@@ -0,0 +1,246 @@
+// DynamicResolution.cpp — a scaled 3-D pass, sized from GPU frame times
+
+#include <GFX/DynamicResolution.hpp>
+#include <GFX/RenderTargetPool.hpp>
+#include <rlgl.h>
+#include <algorithm>
+#include <cmath>
+
+#if defined(_WIN32)
+extern "C" __declspec(dllimport) void* __stdcall GetModuleHandleA(const char* name);
+extern "C" __declspec(dllimport) void* __stdcall GetProcAddress(void* module, const char* name);
+#define HOTONES_GLAPI __stdcall
+#else
+#include <dlfcn.h>
+#define HOTONES_GLAPI
+#endif
+
+namespace Hotones::GFX {
+
+namespace {
+
+// Frames read back, since a change, before the scale may drop again (the
+// times in flight were drawn at the old one) or rise a step
+constexpr int   SETTLE_FRAMES = 8;
+constexpr int   RAISE_FRAMES  = 45;
+constexpr float SMOOTHING     = 0.2f;   // weight of each new time in Stats::gpuMs
+
+// GL timer queries (core in 3.3); raylib doesn't expose its loader, so
+// they're looked up like the profiler's
+constexpr unsigned GL_TIMESTAMP_              = 0x8E28;
+constexpr unsigned GL_QUERY_RESULT_           = 0x8866;
+constexpr unsigned GL_QUERY_RESULT_AVAILABLE_ = 0x8867;
+
+using GenQueriesFn         = void (HOTONES_GLAPI*)(int, unsigned*);
+using DeleteQueriesFn      = void (HOTONES_GLAPI*)(int, const unsigned*);
+using QueryCounterFn       = void (HOTONES_GLAPI*)(unsigned, unsigned);
+using GetQueryObjectivFn   = void (HOTONES_GLAPI*)(unsigned, unsigned, int*);
+using GetQueryObjectui64Fn = void (HOTONES_GLAPI*)(unsigned, unsigned, uint64_t*);
+
+struct GL {
+    GenQueriesFn         GenQueries         = nullptr;
+    DeleteQueriesFn      DeleteQueries      = nullptr;
+    QueryCounterFn       QueryCounter       = nullptr;
+    GetQueryObjectivFn   GetQueryObjectiv   = nullptr;
+    GetQueryObjectui64Fn GetQueryObjectui64 = nullptr;
+};
+GL g_gl;
+
+void* GetGLProc(const char* name)
+{
+#if defined(_WIN32)
+    // Entry points past GL 1.1 only come from wglGetProcAddress
+    using WglGetProcAddressFn = void* (__stdcall*)(const char*);
+    void* gl = GetModuleHandleA("opengl32.dll");
+    if (!gl) return nullptr;
+    const auto wglGetProc = reinterpret_cast<WglGetProcAddressFn>(GetProcAddress(gl, "wglGetProcAddress"));
+    return wglGetProc ? wglGetProc(name) : nullptr;
+#else
+    return dlsym(RTLD_DEFAULT, name);
+#endif
+}
+
+template<typename Fn>
+bool LoadProc(Fn& fn, const char* name)
+{
+    fn = reinterpret_cast<Fn>(GetGLProc(name));
+    return fn != nullptr;
+}
+
+bool SameScale(float a, float b)
+{
+    return std::fabs(a - b) < 1e-4f;
+}
+
+} // namespace
+
+DynamicResolution& DynamicResolution::Get()
+{
+    static DynamicResolution s_instance;
+    return s_instance;
+}
+
+bool DynamicResolution::Init()
+{
+    if (m_ready) return true;
+    const int version = rlGetVersion();
+    if (version != RL_OPENGL_33 && version != RL_OPENGL_43) return false;
+
+    if (!LoadProc(g_gl.GenQueries, "glGenQueries") || !LoadProc(g_gl.DeleteQueries, "glDeleteQueries") ||
+        !LoadProc(g_gl.QueryCounter, "glQueryCounter") ||
+        !LoadProc(g_gl.GetQueryObjectiv, "glGetQueryObjectiv") ||
+        !LoadProc(g_gl.GetQueryObjectui64, "glGetQueryObjectui64v")) {
+        g_gl = {};
+        return false;
+    }
+    for (TimedFrame& f : m_frames) {
+        f = {};
+        g_gl.GenQueries(2, f.queries);
+    }
+    m_current = -1;
+    m_ready   = true;
+    return true;
+}
+
+void DynamicResolution::Unload()
+{
+    RenderTargetPool::Get().Release(m_target);
+    m_active = false;
+    if (m_ready)
+        for (TimedFrame& f : m_frames) g_gl.DeleteQueries(2, f.queries);
+    for (TimedFrame& f : m_frames) f = {};
+    m_ready   = false;
+    m_current = -1;
+}
+
+void DynamicResolution::SetSettings(const Settings& settings)
+{
+    m_settings = settings;
+    Settings& s = m_settings;
+    s.step     = std::clamp(s.step, 0.01f, 0.5f);
+    s.minScale = std::clamp(std::round(s.minScale / s.step) * s.step, s.step, 1.f);
+    s.maxScale = std::clamp(std::round(s.maxScale / s.step) * s.step, s.minScale, 1.f);
+    s.targetMs = std::max(s.targetMs, 0.1f);
+    s.headroom = std::clamp(s.headroom, 0.1f, 1.f);
+
+    // Without timers nothing moves the scale: it stays at the most allowed
+    m_scale       = m_ready ? std::clamp(m_scale, s.minScale, s.maxScale) : s.maxScale;
+    m_stats.scale = s.enabled ? m_scale : 1.f;
+    m_sinceChange = 0;
+}
+
+// ── Frame timing ──────────────────────────────────────────────────────────────
+
+void DynamicResolution::BeginFrame()
+{
+    ++m_frame;
+    if (!m_ready) return;
+    EndFrame();   // one left open
+
+    m_current = (int)(m_frame % TIMED_FRAMES);
+    TimedFrame& f = m_frames[m_current];
+    f.pending = false;   // not read back yet: the GPU is too far behind, drop it
+    f.frame   = m_frame;
+    // Queries land where the GPU reaches them in the command stream: flush
+    // what's batched so the frame's own draws come after
+    rlDrawRenderBatchActive();
+    g_gl.QueryCounter(f.queries[0], GL_TIMESTAMP_);
+}
+
+void DynamicResolution::EndFrame()
+{
+    if (!m_ready || m_current < 0) return;
+    TimedFrame& f = m_frames[m_current];
+    rlDrawRenderBatchActive();
+    g_gl.QueryCounter(f.queries[1], GL_TIMESTAMP_);
+    f.pending = true;
+    m_current = -1;
+
+    // Every frame whose times have landed, oldest first
+    for (uint64_t n = m_frame >= TIMED_FRAMES ? m_frame - TIMED_FRAMES + 1 : 1; n <= m_frame; ++n) {
+        TimedFrame& done = m_frames[n % TIMED_FRAMES];
+        if (!done.pending || done.frame != n) continue;
+        int available = 0;
+        g_gl.GetQueryObjectiv(done.queries[1], GL_QUERY_RESULT_AVAILABLE_, &available);
+        if (!available) break;   // later ones can't have landed either
+        uint64_t start = 0, end = 0;
+        g_gl.GetQueryObjectui64(done.queries[0], GL_QUERY_RESULT_, &start);
+        g_gl.GetQueryObjectui64(done.queries[1], GL_QUERY_RESULT_, &end);
+        done.pending = false;
+        if (end > start) Adjust((float)((double)(end - start) / 1e6));
+    }
+}
+
+void DynamicResolution::Adjust(float gpuMs)
+{
+    m_stats.gpuMs = m_stats.gpuMs > 0.f ? m_stats.gpuMs + (gpuMs - m_stats.gpuMs) * SMOOTHING : gpuMs;
+    ++m_sinceChange;
+    if (!m_settings.enabled) return;
+
+    const Settings& s = m_settings;
+    // The scale whose pixel count should take the aimed-for time
+    const float fits = m_scale * std::sqrt(s.targetMs * s.headroom / std::max(m_stats.gpuMs, 0.01f));
+
+    float next = m_scale;
+    if (m_stats.gpuMs > s.targetMs && m_sinceChange >= SETTLE_FRAMES)
+        next = std::min(std::floor(fits / s.step) * s.step, m_scale - s.step);
+    else if (fits >= m_scale + s.step && m_sinceChange >= RAISE_FRAMES)
+        next = m_scale + s.step;
+    next = std::clamp(std::round(next / s.step) * s.step, s.minScale, s.maxScale);
+    if (SameScale(next, m_scale)) return;
+
+    // Times still in flight were drawn at the old scale: expect what the
+    // new one should take, rather than react to them again
+    m_stats.gpuMs *= (next * next) / (m_scale * m_scale);
+    m_scale         = next;
+    m_stats.scale   = next;
+    m_stats.changes++;
+    m_sinceChange   = 0;
+}
+
+// ── Scaled 3-D pass ───────────────────────────────────────────────────────────
+
+bool DynamicResolution::Begin3D()
+{
+    if (m_active) return false;
+    m_stats.width = m_stats.height = 0;
+    if (!m_settings.enabled || SameScale(m_scale, 1.f)) {
+        RenderTargetPool::Get().Release(m_target);   // for others until it's wanted again
+        return false;
+    }
+    if (rlGetActiveFramebuffer() != 0) return false;   // a target of someone else's
+
+    const int width  = std::max(1, (int)std::lround((float)GetScreenWidth()  * m_scale));
+    const int height = std::max(1, (int)std::lround((float)GetScreenHeight() * m_scale));
+    if (m_target.texture.width != width || m_target.texture.height != height) {
+        RenderTargetPool& pool = RenderTargetPool::Get();
+        pool.Release(m_target);
+        m_target = pool.Acquire(width, height);
+        if (m_target.id == 0) return false;
+        SetTextureFilter(m_target.texture, TEXTURE_FILTER_BILINEAR);
+    }
+
+    BeginTextureMode(m_target);
+    m_active       = true;
+    m_stats.width  = width;
+    m_stats.height = height;
+    return true;
+}
+
+void DynamicResolution::End3D()
+{
+    if (!m_active) return;
+    m_active = false;
+    EndTextureMode();
+
+    const Rectangle src = { 0.f, 0.f, (float)m_target.texture.width, -(float)m_target.texture.height };
+    const Rectangle dst = { 0.f, 0.f, (float)GetScreenWidth(), (float)GetScreenHeight() };
+    // Copied, not blended: translucent draws left the target's alpha below 1
+    rlDrawRenderBatchActive();
+    rlDisableColorBlend();
+    DrawTexturePro(m_target.texture, src, dst, { 0.f, 0.f }, 0.f, WHITE);
+    rlDrawRenderBatchActive();
+    rlEnableColorBlend();
+}
+
+} // namespace Hotones::GFX
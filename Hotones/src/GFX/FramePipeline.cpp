@@ -0,0 +1,82 @@
+// FramePipeline.cpp — the simulation thread of a pipelined frame
+
+#include <GFX/FramePipeline.hpp>
+#include <Jobs/MainThread.hpp>
+#include <Memory/FrameArena.hpp>
+#include <Profile/Profiler.hpp>
+#include <utility>
+
+namespace Hotones::GFX {
+
+void FramePipeline::Start()
+{
+    if (IsRunning()) return;
+    Jobs::MainThread::Get().Bind();
+    m_stop = false;
+    m_thread = std::thread([this] { Loop(); });
+}
+
+void FramePipeline::Stop()
+{
+    if (!IsRunning()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+}
+
+void FramePipeline::Begin(std::function<void()> step)
+{
+    m_done.store(false, std::memory_order_relaxed);
+    m_inFlight = true;
+    Jobs::MainThread::Get().Serve(true);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_step = std::move(step);
+    }
+    m_wake.notify_all();
+}
+
+void FramePipeline::Finish()
+{
+    if (!m_inFlight) return;
+    HOTONES_ZONE("Wait for simulation");
+    const int64_t start = Profile::Now();
+    auto& main = Jobs::MainThread::Get();
+    main.PumpUntil([this] { return m_done.load(std::memory_order_acquire); });
+    main.Serve(false);
+    m_inFlight     = false;
+    m_stats.waitMs = (double)(Profile::Now() - start) / 1.0e6;
+    m_stats.simMs  = (double)m_simNs.load(std::memory_order_relaxed) / 1.0e6;
+}
+
+void FramePipeline::Loop()
+{
+    HOTONES_THREAD("Simulation");
+    for (;;) {
+        std::function<void()> step;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stop || m_step; });
+            if (m_stop) return;
+            step = std::move(m_step);
+            m_step = nullptr;
+        }
+
+        // This thread's frame allocations live until its next step
+        Memory::FrameArena::Get().NextFrame();
+        const int64_t start = Profile::Now();
+        {
+            HOTONES_ZONE("Simulation step");
+            step();
+        }
+        m_simNs.store(Profile::Now() - start, std::memory_order_relaxed);
+
+        m_done.store(true, std::memory_order_release);
+        Jobs::MainThread::Get().Notify();
+    }
+}
+
+} // namespace Hotones::GFX
@@ -1,4 +1,5 @@
 #include <GFX/GameScene.hpp>
+#include <Input/Input.hpp>
 #include <raymath.h>
 #include <GFX/CollidableModel.hpp>
 #include <server/NetworkManager.hpp>
@@ -38,6 +39,14 @@ void GameScene::Init()
     worldModel = std::make_shared<CollidableModel>("assets/hsome.obj", (Vector3){0,0,0}); // TODO: Change this after testing pak
     // Let player use the world for collisions (shared ownership)
     player.AttachWorld(worldModel);
+    // The world BVH builds in the background; without it the first
+    // Update() would let the player fall through the floor
+    worldModel->WaitForPhysics();
+}
+
+void GameScene::FixedUpdate(float dt)
+{
+    player.FixedUpdate(dt);
 }
 
 void GameScene::Update()
@@ -45,7 +54,7 @@ void GameScene::Update()
     player.Update();
 
     // Toggle world debug visuals (moved to F2 to reserve F1 for ImGui)
-    if (IsKeyPressed(KEY_F2)) {
+    if (Hotones::Input::IsKeyPressed(KEY_F2)) {
         worldDebug = !worldDebug;
         if (worldModel) worldModel->SetDebug(worldDebug);
     }
@@ -63,7 +72,7 @@ void GameScene::Draw()
 
     // Draw other connected players as coloured ghost shapes
     if (m_netMgr) {
-        for (auto& [id, rp] : m_netMgr->GetRemotePlayers()) {
+        for (const auto& rp : m_netMgr->GetRemotePlayers()) {
             if (!rp.active) continue;
             // Body (tall box)
             DrawCube({ rp.posX, rp.posY + 1.0f, rp.posZ }, 0.6f, 2.0f, 0.6f,
@@ -92,7 +101,7 @@ void GameScene::DrawLevel()
 {
     // Draw the main world model and its bounding box
     if (worldModel) {
-        worldModel->Draw();
+        worldModel->Draw(GFX::Frustum::FromCamera(camera, (float)GetScreenWidth() / (float)GetScreenHeight()));
         // Draw per-mesh boxes in red so they align exactly with the F1 debug boxes
         worldModel->DrawMeshBoundingBoxes(RED);
         if (worldDebug) worldModel->DrawDebug();
@@ -14,6 +14,7 @@ public:
     ~GameScene() override = default;
 
     void Init() override;
+    void FixedUpdate(float dt) override;
     void Update() override;
     void Draw() override;
     void Unload() override;
@@ -1,44 +1,78 @@
 #include "GFX/LayoutEngine.hpp"
+#include "GFX/TextCache.hpp"
 
 #include <algorithm>
 
 using namespace Hotones::GFX;
 
+// ---------------- UIElement ----------------
+UISize UIElement::Measure(int availW, int availH) {
+    if (measureDirty || availW != measuredAvailW || availH != measuredAvailH) {
+        measuredSize   = OnMeasure(availW, availH);
+        measuredAvailW = availW;
+        measuredAvailH = availH;
+        measureDirty   = false;
+        layoutDirty    = true;   // children may have new sizes to place
+    }
+    return measuredSize;
+}
+
+void UIElement::Layout(int x, int y, int w, int h) {
+    const Rectangle r{ (float)x, (float)y, (float)w, (float)h };
+    if (!layoutDirty && r.x == rect.x && r.y == rect.y && r.width == rect.width && r.height == rect.height)
+        return;
+    rect = r;
+    OnLayout();
+    layoutDirty = false;
+}
+
+void UIElement::Invalidate() {
+    for (UIElement* e = this; e; e = e->parent) {
+        e->measureDirty = true;
+        e->layoutDirty  = true;
+    }
+}
+
 // ---------------- LabelElement ----------------
 LabelElement::LabelElement(std::string txt, int fontSize, Color col)
     : text(std::move(txt)), fs(fontSize), color(col) {}
 
-UISize LabelElement::Measure(int availW, int /*availH") */) {
-    int w = MeasureText(text.c_str(), fs);
-    int h = fs + 4;
-    return UISize{w, h};
+void LabelElement::SetText(std::string txt) {
+    if (txt == text) return;
+    text = std::move(txt);
+    textW = -1;
+    Invalidate();
+}
+
+void LabelElement::SetFontSize(int fontSize) {
+    if (fontSize == fs) return;
+    fs = fontSize;
+    textW = -1;
+    Invalidate();
 }
 
-void LabelElement::Layout(int x, int y, int w, int h) {
-    rect.x = (float)x;
-    rect.y = (float)y;
-    rect.width = (float)w;
-    rect.height = (float)h;
+UISize LabelElement::OnMeasure(int /*availW*/, int /*availH*/) {
+    if (textW < 0) textW = TextCache::Get().MeasureText(text, fs);
+    return UISize{textW, fs + 4};
 }
 
 void LabelElement::Draw() {
     // Draw at top-left of assigned rect with given font size and color
-    DrawText(text.c_str(), (int)rect.x, (int)rect.y, fs, color);
+    TextCache::Get().DrawText(text, (int)rect.x, (int)rect.y, fs, color);
 }
 
 // ---------------- SpacerElement ----------------
 SpacerElement::SpacerElement(int height)
     : desiredH(height) {}
 
-UISize SpacerElement::Measure(int availW, int /*availH*/) {
-    return UISize{availW, desiredH};
+void SpacerElement::SetHeight(int height) {
+    if (height == desiredH) return;
+    desiredH = height;
+    Invalidate();
 }
 
-void SpacerElement::Layout(int x, int y, int w, int h) {
-    rect.x = (float)x;
-    rect.y = (float)y;
-    rect.width = (float)w;
-    rect.height = (float)h;
+UISize SpacerElement::OnMeasure(int availW, int /*availH*/) {
+    return UISize{availW, desiredH};
 }
 
 void SpacerElement::Draw() {
@@ -49,13 +83,33 @@ void SpacerElement::Draw() {
 LayoutBox::LayoutBox(Direction d, int spacing_, int padding_)
     : dir(d), spacing(spacing_), padding(padding_) {}
 
-LayoutBox::~LayoutBox() = default;
+LayoutBox::~LayoutBox() {
+    for (auto *c : children) c->parent = nullptr;
+}
 
 void LayoutBox::AddChild(UIElement* child) {
+    if (child->parent) child->parent->RemoveChild(child);
     children.push_back(child);
+    child->parent = this;
+    Invalidate();
+}
+
+void LayoutBox::RemoveChild(UIElement* child) {
+    auto it = std::find(children.begin(), children.end(), child);
+    if (it == children.end()) return;
+    children.erase(it);
+    child->parent = nullptr;
+    Invalidate();
 }
 
-UISize LayoutBox::Measure(int availW, int availH) {
+void LayoutBox::ClearChildren() {
+    if (children.empty()) return;
+    for (auto *c : children) c->parent = nullptr;
+    children.clear();
+    Invalidate();
+}
+
+UISize LayoutBox::OnMeasure(int availW, int availH) {
     measured.clear();
     if (children.empty()) return UISize{0,0};
 
@@ -86,14 +140,10 @@ UISize LayoutBox::Measure(int availW, int availH) {
     }
 }
 
-void LayoutBox::Layout(int x, int y, int w, int h) {
-    rect.x = (float)x;
-    rect.y = (float)y;
-    rect.width = (float)w;
-    rect.height = (float)h;
-
+void LayoutBox::OnLayout() {
     if (children.empty()) return;
 
+    const int x = (int)rect.x, y = (int)rect.y, w = (int)rect.width, h = (int)rect.height;
     if (dir == Direction::Vertical) {
         int childX = x + padding;
         int childW = std::max(0, w - padding*2);
@@ -0,0 +1,573 @@
+// LightBake.cpp — lightmaps, light probes and the on-disk bake cache
+//
+// Lightmaps are filled by rasterising each triangle into its mesh's
+// lightmap UVs: a texel whose centre falls inside takes the triangle's
+// position and normal there, texels the triangle only grazes (within a
+// texel of it) the nearest point on it, so thin triangles and chart edges
+// are not lost.  Each covered texel is lit, then a couple of dilation
+// passes spread the charts' edges outward so bilinear filtering never
+// reaches an unlit texel.
+//
+// Bake cache file (native byte order, checked on load):
+//
+//   BakeCacheHeader                             32 bytes
+//   BakeCacheProbes                             grid placement and size
+//   Vector3          faces[probe count * 6]
+//   per lightmap:    BakeCacheLightmap, then width * height * 4 texel bytes
+
+#include <GFX/LightBake.hpp>
+#include <GFX/SceneImporter.hpp>
+#include <Jobs/JobSystem.hpp>
+#include <Physics/BVH.hpp>
+#include <Physics/BVHCache.hpp>
+#include <raymath.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+namespace Hotones::GFX {
+
+Vector3 LightProbeGrid::Sample(Vector3 pos, Vector3 normal) const
+{
+    if (Empty() || spacing <= 0.f) return { 0.f, 0.f, 0.f };
+    const float g[3] = {
+        Clamp((pos.x - origin.x) / spacing, 0.f, (float)(countX - 1)),
+        Clamp((pos.y - origin.y) / spacing, 0.f, (float)(countY - 1)),
+        Clamp((pos.z - origin.z) / spacing, 0.f, (float)(countZ - 1)),
+    };
+    const int   count[3] = { countX, countY, countZ };
+    int         lo[3], hi[3];
+    float       f[3];
+    for (int a = 0; a < 3; ++a) {
+        lo[a] = (int)g[a];
+        hi[a] = std::min(lo[a] + 1, count[a] - 1);
+        f[a]  = g[a] - (float)lo[a];
+    }
+    const Vector3 n2   = { normal.x * normal.x, normal.y * normal.y, normal.z * normal.z };
+    const int     face[3] = { normal.x < 0.f ? 1 : 0, normal.y < 0.f ? 3 : 2, normal.z < 0.f ? 5 : 4 };
+
+    Vector3 sum = { 0.f, 0.f, 0.f };
+    for (int corner = 0; corner < 8; ++corner) {
+        const int x = corner & 1 ? hi[0] : lo[0];
+        const int y = corner & 2 ? hi[1] : lo[1];
+        const int z = corner & 4 ? hi[2] : lo[2];
+        const float w = (corner & 1 ? f[0] : 1.f - f[0]) * (corner & 2 ? f[1] : 1.f - f[1])
+                      * (corner & 4 ? f[2] : 1.f - f[2]);
+        if (w <= 0.f) continue;
+        const Vector3* p = &faces[((size_t)(z * countY + y) * countX + x) * 6];
+        const Vector3  e = Vector3Add(Vector3Add(Vector3Scale(p[face[0]], n2.x), Vector3Scale(p[face[1]], n2.y)),
+                                      Vector3Scale(p[face[2]], n2.z));
+        sum = Vector3Add(sum, Vector3Scale(e, w));
+    }
+    return sum;
+}
+
+namespace {
+
+// ── Scene ───────────────────────────────────────────────────────────────────
+
+// A light as LightingSystem shades it
+struct BakeLight {
+    int     type     = 0;   // LightType: 0 point, 1 directional, 2 spot
+    Vector3 position = {};
+    Vector3 dir      = {};  // normalised, the way the light travels
+    Vector3 color    = {};  // linear, intensity applied
+    float   range    = 0.f;
+    float   innerCos = 1.f;
+    float   outerCos = 0.f;
+};
+
+// A static mesh in world space
+struct BakeMesh {
+    int                   mesh = -1;   // into ImportedScene::meshes
+    std::vector<Vector3>  positions;
+    std::vector<Vector3>  normals;     // per vertex; empty → face normals
+    std::vector<uint32_t> indices;
+    float                 area = 0.f;
+};
+
+struct BakeScene {
+    std::vector<BakeLight> lights;
+    std::vector<BakeMesh>  meshes;
+    Physics::BVH           bvh;        // every static triangle, for shadows
+    BoundingBox            bounds = {};
+    float                  reach  = 0.f;   // past the scene, for directional shadows
+};
+
+template<typename Fn>
+void ForRange(Jobs::JobSystem* jobs, size_t count, size_t grain, Fn&& fn)
+{
+    if (jobs) jobs->ParallelFor(count, grain, fn);
+    else if (count > 0) fn(size_t(0), count);
+}
+
+std::vector<BakeLight> GatherLights(const ImportedScene& scene, const LightBakeOptions& opts)
+{
+    std::vector<BakeLight> out;
+    for (const SceneLight& l : scene.lights) {
+        if (!l.properties.GetBool("bake", true)) continue;
+        BakeLight b;
+        b.type     = l.type == SceneLightType::Directional ? 1 : l.type == SceneLightType::Spot ? 2 : 0;
+        b.position = l.position;
+        b.dir      = Vector3Normalize(l.direction);
+        const float k = l.intensity * opts.intensityScale / 255.f;
+        b.color    = { l.color.r * k, l.color.g * k, l.color.b * k };
+        b.range    = l.range;
+        b.innerCos = cosf(l.innerAngle);
+        b.outerCos = cosf(l.outerAngle);
+        if (b.innerCos - b.outerCos < 1e-4f) b.innerCos = b.outerCos + 1e-4f;
+        if (b.color.x + b.color.y + b.color.z <= 0.f || (b.type != 1 && b.range <= 0.f)) continue;
+        out.push_back(b);
+    }
+    return out;
+}
+
+void GatherMeshes(const ImportedScene& scene, BakeScene& out, Jobs::JobSystem* jobs)
+{
+    std::vector<Physics::Tri> tris;
+    out.bounds = { { FLT_MAX, FLT_MAX, FLT_MAX }, { -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+    for (int i = 0; i < (int)scene.meshes.size(); ++i) {
+        const SceneMesh& sm = scene.meshes[i];
+        const Mesh&      m  = sm.mesh;
+        if (!sm.skin.Empty() || m.vertexCount == 0 || m.vertices == nullptr) continue;
+
+        BakeMesh& bm = out.meshes.emplace_back();
+        bm.mesh = i;
+        Matrix linear = sm.transform;
+        linear.m12 = linear.m13 = linear.m14 = 0.f;
+        const Matrix normalTm = MatrixTranspose(MatrixInvert(linear));
+        bm.positions.resize(m.vertexCount);
+        for (int v = 0; v < m.vertexCount; ++v) {
+            bm.positions[v] = Vector3Transform({ m.vertices[v*3], m.vertices[v*3+1], m.vertices[v*3+2] }, sm.transform);
+            out.bounds.min = Vector3Min(out.bounds.min, bm.positions[v]);
+            out.bounds.max = Vector3Max(out.bounds.max, bm.positions[v]);
+        }
+        if (m.normals) {
+            bm.normals.resize(m.vertexCount);
+            for (int v = 0; v < m.vertexCount; ++v)
+                bm.normals[v] = Vector3Normalize(Vector3Transform({ m.normals[v*3], m.normals[v*3+1], m.normals[v*3+2] },
+                                                                  normalTm));
+        }
+        const int indexCount = m.indices ? m.triangleCount * 3 : m.vertexCount / 3 * 3;
+        bm.indices.resize(indexCount);
+        for (int k = 0; k < indexCount; ++k) bm.indices[k] = m.indices ? m.indices[k] : (uint32_t)k;
+
+        for (int t = 0; t + 2 < indexCount; t += 3) {
+            Physics::Tri tri;
+            tri.a = bm.positions[bm.indices[t]];
+            tri.b = bm.positions[bm.indices[t + 1]];
+            tri.c = bm.positions[bm.indices[t + 2]];
+            tri.centroid = Vector3Scale(Vector3Add(Vector3Add(tri.a, tri.b), tri.c), 1.f / 3.f);
+            tri.source   = (uint32_t)tris.size();
+            bm.area += 0.5f * Vector3Length(Vector3CrossProduct(Vector3Subtract(tri.b, tri.a),
+                                                                Vector3Subtract(tri.c, tri.a)));
+            tris.push_back(tri);
+        }
+    }
+    if (out.meshes.empty()) out.bounds = {};
+    out.reach = Vector3Distance(out.bounds.min, out.bounds.max) + 1.f;
+    out.bvh.Build(std::move(tris), Physics::BVHBuildQuality::SAH, jobs);
+}
+
+// ── Lighting ────────────────────────────────────────────────────────────────
+
+// fn(L, light) for each light reaching `p`: L towards it, light its colour
+// after falloff and shadowing.  Shadow rays leave from p + offset.
+template<typename Fn>
+void ForEachLight(const BakeScene& bake, const LightBakeOptions& opts, Vector3 p, Vector3 offset, Fn&& fn)
+{
+    for (const BakeLight& l : bake.lights) {
+        Vector3 L;
+        float   dist, att = 1.f;
+        if (l.type == 1) {
+            L    = Vector3Negate(l.dir);
+            dist = bake.reach;
+        } else {
+            const Vector3 toLight = Vector3Subtract(l.position, p);
+            dist = Vector3Length(toLight);
+            if (dist >= l.range || dist < 1e-6f) continue;
+            L   = Vector3Scale(toLight, 1.f / dist);
+            att = Clamp(1.f - (dist / l.range) * (dist / l.range), 0.f, 1.f);
+            if (l.type == 2)
+                att *= Clamp((Vector3DotProduct(L, Vector3Negate(l.dir)) - l.outerCos) / (l.innerCos - l.outerCos),
+                             0.f, 1.f);
+            if (att <= 0.f) continue;
+        }
+        if (opts.shadows) {
+            // Stopping short of the light, so its own fitting doesn't hide it
+            const Vector3 from  = Vector3Add(p, offset);
+            const float   limit = l.type == 1 ? dist : Vector3Distance(from, l.position) - opts.shadowBias;
+            float   bestT = limit;
+            Vector3 n;
+            Physics::RaycastNodeBVH(bake.bvh, from, L, bestT, n);
+            if (bestT < limit) continue;
+        }
+        fn(L, Vector3Scale(l.color, att));
+    }
+}
+
+Vector3 SurfaceLight(const BakeScene& bake, const LightBakeOptions& opts, Vector3 p, Vector3 n)
+{
+    Vector3 sum = { 0.f, 0.f, 0.f };
+    ForEachLight(bake, opts, p, Vector3Scale(n, opts.shadowBias), [&](Vector3 L, Vector3 light) {
+        const float diff = Vector3DotProduct(n, L);
+        if (diff > 0.f) sum = Vector3Add(sum, Vector3Scale(light, diff));
+    });
+    return sum;
+}
+
+// ── Lightmaps ───────────────────────────────────────────────────────────────
+
+int LightmapSize(float area, const LightBakeOptions& opts)
+{
+    const float want = sqrtf(std::max(area, 0.f)) * opts.texelsPerUnit;
+    int size = 1;
+    while (size < want && size < opts.maxLightmapSize) size *= 2;
+    return std::clamp(size, std::max(opts.minLightmapSize, 1), std::max(opts.maxLightmapSize, 1));
+}
+
+void EncodeRGBM(Vector3 c, uint8_t* out)
+{
+    const float m = Clamp(std::max({ c.x, c.y, c.z }) / LIGHTMAP_RANGE, 1.f / 255.f, 1.f);
+    const float a = ceilf(m * 255.f) / 255.f;
+    const float k = 255.f / (a * LIGHTMAP_RANGE);
+    out[0] = (uint8_t)Clamp(c.x * k + 0.5f, 0.f, 255.f);
+    out[1] = (uint8_t)Clamp(c.y * k + 0.5f, 0.f, 255.f);
+    out[2] = (uint8_t)Clamp(c.z * k + 0.5f, 0.f, 255.f);
+    out[3] = (uint8_t)(a * 255.f + 0.5f);
+}
+
+Lightmap BakeLightmap(const BakeScene& bake, const BakeMesh& bm, const Mesh& mesh,
+                      const LightBakeOptions& opts, Jobs::JobSystem* jobs)
+{
+    Lightmap map;
+    map.mesh  = bm.mesh;
+    map.width = map.height = LightmapSize(bm.area, opts);
+    const int w = map.width, h = map.height;
+
+    // Surface point per texel; coverage 0 none, 1 grazed, 2 centre inside
+    std::vector<Vector3> pos((size_t)w * h), nrm((size_t)w * h);
+    std::vector<uint8_t> cover((size_t)w * h, 0);
+    for (size_t t = 0; t + 2 < bm.indices.size(); t += 3) {
+        const uint32_t i[3] = { bm.indices[t], bm.indices[t + 1], bm.indices[t + 2] };
+        Vector2 uv[3];
+        for (int k = 0; k < 3; ++k) uv[k] = { mesh.texcoords2[i[k]*2] * w, mesh.texcoords2[i[k]*2+1] * h };
+        const float det = (uv[1].x - uv[0].x) * (uv[2].y - uv[0].y) - (uv[2].x - uv[0].x) * (uv[1].y - uv[0].y);
+        if (fabsf(det) < 1e-12f) continue;
+        const Vector3 face = Vector3Normalize(Vector3CrossProduct(Vector3Subtract(bm.positions[i[1]], bm.positions[i[0]]),
+                                                                  Vector3Subtract(bm.positions[i[2]], bm.positions[i[0]])));
+
+        const int x0 = std::max(0,     (int)floorf(std::min({ uv[0].x, uv[1].x, uv[2].x }) - 1.f));
+        const int x1 = std::min(w - 1, (int)ceilf (std::max({ uv[0].x, uv[1].x, uv[2].x }) + 1.f));
+        const int y0 = std::max(0,     (int)floorf(std::min({ uv[0].y, uv[1].y, uv[2].y }) - 1.f));
+        const int y1 = std::min(h - 1, (int)ceilf (std::max({ uv[0].y, uv[1].y, uv[2].y }) + 1.f));
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x) {
+                const float px = x + 0.5f, py = y + 0.5f;
+                float b1 = ((px - uv[0].x) * (uv[2].y - uv[0].y) - (uv[2].x - uv[0].x) * (py - uv[0].y)) / det;
+                float b2 = ((uv[1].x - uv[0].x) * (py - uv[0].y) - (px - uv[0].x) * (uv[1].y - uv[0].y)) / det;
+                float b0 = 1.f - b1 - b2;
+                const bool inside = b0 >= 0.f && b1 >= 0.f && b2 >= 0.f;
+                const size_t at = (size_t)y * w + x;
+                if (cover[at] == 2 || (!inside && cover[at] == 1)) continue;
+                if (!inside) {
+                    // The nearest point of the triangle, roughly: within a texel?
+                    b0 = std::max(b0, 0.f); b1 = std::max(b1, 0.f); b2 = std::max(b2, 0.f);
+                    const float sum = b0 + b1 + b2;
+                    b0 /= sum; b1 /= sum; b2 /= sum;
+                    const float qx = uv[0].x * b0 + uv[1].x * b1 + uv[2].x * b2;
+                    const float qy = uv[0].y * b0 + uv[1].y * b1 + uv[2].y * b2;
+                    if ((qx - px) * (qx - px) + (qy - py) * (qy - py) > 1.f) continue;
+                }
+                pos[at] = Vector3Add(Vector3Add(Vector3Scale(bm.positions[i[0]], b0), Vector3Scale(bm.positions[i[1]], b1)),
+                                     Vector3Scale(bm.positions[i[2]], b2));
+                nrm[at] = bm.normals.empty() ? face
+                        : Vector3Normalize(Vector3Add(Vector3Add(Vector3Scale(bm.normals[i[0]], b0),
+                                                                 Vector3Scale(bm.normals[i[1]], b1)),
+                                                      Vector3Scale(bm.normals[i[2]], b2)));
+                cover[at] = inside ? 2 : 1;
+            }
+    }
+
+    std::vector<Vector3> light((size_t)w * h, Vector3{ 0.f, 0.f, 0.f });
+    ForRange(jobs, (size_t)h, 4, [&](size_t begin, size_t end) {
+        for (size_t y = begin; y < end; ++y)
+            for (int x = 0; x < w; ++x) {
+                const size_t at = y * w + x;
+                if (cover[at]) light[at] = SurfaceLight(bake, opts, pos[at], nrm[at]);
+            }
+    });
+
+    // Grow the charts: an empty texel takes the mean of its covered neighbours
+    constexpr int DILATE_PASSES = 2;
+    std::vector<uint8_t> grown;
+    for (int pass = 0; pass < DILATE_PASSES; ++pass) {
+        grown = cover;
+        for (int y = 0; y < h; ++y)
+            for (int x = 0; x < w; ++x) {
+                if (cover[(size_t)y * w + x]) continue;
+                Vector3 sum = { 0.f, 0.f, 0.f };
+                int     n   = 0;
+                for (int dy = -1; dy <= 1; ++dy)
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        const int nx = x + dx, ny = y + dy;
+                        if (nx < 0 || ny < 0 || nx >= w || ny >= h || !cover[(size_t)ny * w + nx]) continue;
+                        sum = Vector3Add(sum, light[(size_t)ny * w + nx]);
+                        n++;
+                    }
+                if (n == 0) continue;
+                light[(size_t)y * w + x] = Vector3Scale(sum, 1.f / n);
+                grown[(size_t)y * w + x] = 1;
+            }
+        cover.swap(grown);
+    }
+
+    map.texels.resize((size_t)w * h * 4);
+    for (size_t at = 0; at < light.size(); ++at) EncodeRGBM(light[at], &map.texels[at * 4]);
+    return map;
+}
+
+// ── Probes ──────────────────────────────────────────────────────────────────
+
+LightProbeGrid BakeProbes(const BakeScene& bake, const LightBakeOptions& opts, Jobs::JobSystem* jobs)
+{
+    LightProbeGrid grid;
+    const Vector3 extent = Vector3Subtract(bake.bounds.max, bake.bounds.min);
+    float spacing = std::max(opts.probeSpacing, 0.01f);
+    const auto countOf = [&](float e) { return std::max(1, (int)ceilf(e / spacing) + 1); };
+    while ((int64_t)countOf(extent.x) * countOf(extent.y) * countOf(extent.z) > MAX_LIGHT_PROBES)
+        spacing *= 1.26f;   // about twice as sparse
+
+    grid.origin  = bake.bounds.min;
+    grid.spacing = spacing;
+    grid.countX  = countOf(extent.x);
+    grid.countY  = countOf(extent.y);
+    grid.countZ  = countOf(extent.z);
+    grid.faces.assign((size_t)grid.Count() * 6, Vector3{ 0.f, 0.f, 0.f });
+
+    ForRange(jobs, (size_t)grid.Count(), 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const int x = (int)(i % grid.countX);
+            const int y = (int)(i / grid.countX % grid.countY);
+            const int z = (int)(i / grid.countX / grid.countY);
+            const Vector3 p = Vector3Add(grid.origin, Vector3Scale({ (float)x, (float)y, (float)z }, spacing));
+            Vector3* faces = &grid.faces[i * 6];
+            ForEachLight(bake, opts, p, Vector3{ 0.f, 0.f, 0.f }, [&](Vector3 L, Vector3 light) {
+                const float w[6] = { std::max(L.x, 0.f), std::max(-L.x, 0.f), std::max(L.y, 0.f),
+                                     std::max(-L.y, 0.f), std::max(L.z, 0.f), std::max(-L.z, 0.f) };
+                for (int f = 0; f < 6; ++f) faces[f] = Vector3Add(faces[f], Vector3Scale(light, w[f]));
+            });
+        }
+    });
+    return grid;
+}
+
+// ── Cache ───────────────────────────────────────────────────────────────────
+
+// Bump whenever the bake changes what it produces
+constexpr uint32_t BAKE_CACHE_VERSION    = 1;
+constexpr uint32_t BAKE_CACHE_BYTE_ORDER = 0x01020304u;
+constexpr char     BAKE_CACHE_MAGIC[8]   = { 'H', 'O', 'B', 'A', 'K', 'E', '\0', '\0' };
+
+struct BakeCacheHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t key;
+    uint32_t lightmapCount;
+    uint32_t meshCount;   // of the scene, bounding every lightmap's mesh
+};
+static_assert(sizeof(BakeCacheHeader) == 32, "bake cache header layout");
+
+struct BakeCacheProbes {
+    Vector3 origin;
+    float   spacing;
+    int32_t countX, countY, countZ;
+};
+
+struct BakeCacheLightmap {
+    int32_t mesh, width, height;
+};
+
+std::string CachePath(const std::string& dir, uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bake", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(dir) / name).string();
+}
+
+uint64_t CacheKey(const ImportedScene& scene, const BakeScene& bake, const LightBakeOptions& opts) {
+    uint64_t h = 14695981039346656037ull;
+    auto mix = [&](uint32_t w) { h = (h ^ w) * 1099511628211ull; };
+    auto mixFloat = [&](float f) {
+        uint32_t w;
+        std::memcpy(&w, &f, sizeof(w));
+        mix(w);
+    };
+    auto mixFloats = [&](const float* f, size_t n) { for (size_t i = 0; f && i < n; ++i) mixFloat(f[i]); };
+    mix(BAKE_CACHE_VERSION);
+    mixFloat(opts.texelsPerUnit);
+    mix((uint32_t)opts.minLightmapSize);
+    mix((uint32_t)opts.maxLightmapSize);
+    mixFloat(opts.probeSpacing);
+    mix(opts.shadows);
+    mixFloat(opts.shadowBias);
+    for (const BakeLight& l : bake.lights) {
+        mix((uint32_t)l.type);
+        mixFloats(&l.position.x, 3);
+        mixFloats(&l.dir.x, 3);
+        mixFloats(&l.color.x, 3);
+        mixFloat(l.range);
+        mixFloat(l.innerCos);
+        mixFloat(l.outerCos);
+    }
+    mix((uint32_t)scene.meshes.size());
+    for (const BakeMesh& bm : bake.meshes) {
+        const SceneMesh& sm = scene.meshes[bm.mesh];
+        const Mesh&      m  = sm.mesh;
+        mix((uint32_t)bm.mesh);
+        mix((uint32_t)m.vertexCount);
+        mix((uint32_t)m.triangleCount);
+        mixFloats(&sm.transform.m0, 16);
+        mixFloats(m.vertices,   (size_t)m.vertexCount * 3);
+        mixFloats(m.normals,    (size_t)m.vertexCount * 3);
+        mixFloats(m.texcoords2, (size_t)m.vertexCount * 2);
+        for (uint32_t i : bm.indices) mix(i);
+    }
+    return h;
+}
+
+bool LoadBakeCache(const std::string& dir, uint64_t key, const ImportedScene& scene, BakedLighting& out) {
+    out = {};
+    Physics::MappedFile file;
+    if (!file.Open(CachePath(dir, key)) || file.Size() < sizeof(BakeCacheHeader) + sizeof(BakeCacheProbes)) return false;
+
+    BakeCacheHeader hdr;
+    std::memcpy(&hdr, file.Data(), sizeof(hdr));
+    if (std::memcmp(hdr.magic, BAKE_CACHE_MAGIC, sizeof(hdr.magic)) != 0 ||
+        hdr.version != BAKE_CACHE_VERSION || hdr.byteOrder != BAKE_CACHE_BYTE_ORDER ||
+        hdr.key != key || hdr.meshCount != (uint32_t)scene.meshes.size()) return false;
+
+    size_t offset = sizeof(hdr);
+    BakeCacheProbes probes;
+    std::memcpy(&probes, file.Data() + offset, sizeof(probes));
+    offset += sizeof(probes);
+    const int64_t probeCount = (int64_t)probes.countX * probes.countY * probes.countZ;
+    if (probes.countX < 0 || probes.countY < 0 || probes.countZ < 0 || probeCount > MAX_LIGHT_PROBES) return false;
+    const size_t faceBytes = (size_t)probeCount * 6 * sizeof(Vector3);
+    if (offset + faceBytes > file.Size()) return false;
+    out.probes.origin  = probes.origin;
+    out.probes.spacing = probes.spacing;
+    out.probes.countX  = probes.countX;
+    out.probes.countY  = probes.countY;
+    out.probes.countZ  = probes.countZ;
+    out.probes.faces.resize((size_t)probeCount * 6);
+    std::memcpy(out.probes.faces.data(), file.Data() + offset, faceBytes);
+    offset += faceBytes;
+
+    for (uint32_t l = 0; l < hdr.lightmapCount; ++l) {
+        BakeCacheLightmap entry;
+        if (offset + sizeof(entry) > file.Size()) break;
+        std::memcpy(&entry, file.Data() + offset, sizeof(entry));
+        offset += sizeof(entry);
+        const size_t bytes = (size_t)std::max(entry.width, 0) * std::max(entry.height, 0) * 4;
+        if (entry.mesh < 0 || entry.mesh >= (int32_t)scene.meshes.size() || entry.width <= 0 || entry.height <= 0 ||
+            offset + bytes > file.Size()) break;
+        Lightmap& map = out.lightmaps.emplace_back();
+        map.mesh   = entry.mesh;
+        map.width  = entry.width;
+        map.height = entry.height;
+        map.texels.assign(file.Data() + offset, file.Data() + offset + bytes);
+        offset += bytes;
+    }
+    if (out.lightmaps.size() != hdr.lightmapCount || offset != file.Size()) {
+        out = {};
+        return false;
+    }
+    return true;
+}
+
+bool StoreBakeCache(const std::string& dir, uint64_t key, const ImportedScene& scene, const BakedLighting& baked) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if (ec) return false;
+
+    BakeCacheHeader hdr{};
+    std::memcpy(hdr.magic, BAKE_CACHE_MAGIC, sizeof(hdr.magic));
+    hdr.version       = BAKE_CACHE_VERSION;
+    hdr.byteOrder     = BAKE_CACHE_BYTE_ORDER;
+    hdr.key           = key;
+    hdr.lightmapCount = (uint32_t)baked.lightmaps.size();
+    hdr.meshCount     = (uint32_t)scene.meshes.size();
+    const BakeCacheProbes probes{ baked.probes.origin, baked.probes.spacing,
+                                  baked.probes.countX, baked.probes.countY, baked.probes.countZ };
+
+    // Unique per writer; see StoreBVHCache
+    const std::string finalPath = CachePath(dir, key);
+    const size_t salt = std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+                        static_cast<size_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    const std::string tmpPath = finalPath + "." + std::to_string(salt) + ".tmp";
+    {
+        std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!ofs) return false;
+        ofs.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        ofs.write(reinterpret_cast<const char*>(&probes), sizeof(probes));
+        ofs.write(reinterpret_cast<const char*>(baked.probes.faces.data()),
+                  static_cast<std::streamsize>(baked.probes.faces.size() * sizeof(Vector3)));
+        for (const Lightmap& map : baked.lightmaps) {
+            const BakeCacheLightmap entry{ map.mesh, map.width, map.height };
+            ofs.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+            ofs.write(reinterpret_cast<const char*>(map.texels.data()),
+                      static_cast<std::streamsize>(map.texels.size()));
+        }
+        if (!ofs) {
+            ofs.close();
+            fs::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    fs::rename(tmpPath, finalPath, ec);
+    if (ec) {
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+BakedLighting BakeLighting(const ImportedScene& scene, const LightBakeOptions& opts, Jobs::JobSystem* jobs)
+{
+    BakedLighting baked;
+    BakeScene     bake;
+    bake.lights = GatherLights(scene, opts);
+    if (bake.lights.empty()) return baked;
+    GatherMeshes(scene, bake, jobs);
+    if (bake.meshes.empty()) return baked;
+
+    const uint64_t key = opts.cacheDir.empty() ? 0 : CacheKey(scene, bake, opts);
+    if (!opts.cacheDir.empty() && LoadBakeCache(opts.cacheDir, key, scene, baked)) return baked;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (const BakeMesh& bm : bake.meshes) {
+        const Mesh& mesh = scene.meshes[bm.mesh].mesh;
+        if (mesh.texcoords2 != nullptr && !bm.indices.empty())
+            baked.lightmaps.push_back(BakeLightmap(bake, bm, mesh, opts, jobs));
+    }
+    baked.probes = BakeProbes(bake, opts, jobs);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    TraceLog(LOG_INFO, "LightBake: %d lights into %d lightmaps and %d probes in %.0f ms",
+             (int)bake.lights.size(), (int)baked.lightmaps.size(), baked.probes.Count(), ms);
+
+    if (!opts.cacheDir.empty() && !StoreBakeCache(opts.cacheDir, key, scene, baked))
+        TraceLog(LOG_WARNING, "LightBake: could not write bake cache to %s", opts.cacheDir.c_str());
+    return baked;
+}
+
+} // namespace Hotones::GFX
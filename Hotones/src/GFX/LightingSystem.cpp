@@ -1,11 +1,21 @@
 // LightingSystem.cpp — custom Blinn-Phong lighting shader + runtime light manager
 //
 // The GLSL shaders are embedded as raw string literals so no external shader
-// files are needed.  Uniforms are uploaded every frame via UploadUniforms().
+// files are needed.  Changed lights are uploaded, and the lights re-binned
+// into clusters when they or the view moved, by UploadUniforms().
 
 #include <GFX/LightingSystem.hpp>
+#include <GFX/Culling.hpp>
+#include <GFX/SceneImporter.hpp>
+#include <GFX/ShaderCache.hpp>
 #include <raylib.h>
+#include <raymath.h>
+#include <rlgl.h>
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
+#include <cstring>
+#include <string>
 
 // ─── Embedded GLSL — vertex shader ───────────────────────────────────────────
 //
@@ -40,16 +50,129 @@ void main()
 }
 )";
 
-// ─── Embedded GLSL — fragment shader ─────────────────────────────────────────
+// ─── Embedded GLSL — lightmapped vertex shader ───────────────────────────────
 //
-// Supports point, directional and spot lights via parallel uniform arrays.
-// Lighting model: Blinn-Phong with squared-distance attenuation.
+// kLitVS for meshes with baked lighting (see LightBake.hpp): their lightmap
+// UVs, the second set, go along to the fragment shader.
 
-static const char* kLitFS = R"(
+static const char* kLitLightmappedVS = R"(
 #version 330
 
-#define MAX_LIGHTS 8
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in vec2 vertexTexCoord2;
+in vec3 vertexNormal;
+in vec4 vertexColor;
+
+uniform mat4 mvp;
+uniform mat4 matModel;
+uniform mat4 matNormal;
+
+out vec3 fragPos;
+out vec2 fragTexCoord;
+out vec2 fragTexCoord2;
+out vec4 fragColor;
+out vec3 fragNormal;
+
+void main()
+{
+    fragPos       = vec3(matModel * vec4(vertexPosition, 1.0));
+    fragTexCoord  = vertexTexCoord;
+    fragTexCoord2 = vertexTexCoord2;
+    fragColor     = vertexColor;
+    fragNormal    = normalize(mat3(matNormal) * vertexNormal);
+    gl_Position   = mvp * vec4(vertexPosition, 1.0);
+}
+)";
 
+// ─── Embedded GLSL — instancing vertex shader ────────────────────────────────
+//
+// Same outputs as kLitVS, for DrawMeshInstanced(): the model matrix arrives
+// per instance in the instanceTransform attribute and raylib passes only
+// view × projection in mvp.  The normal matrix is derived per vertex, since
+// instances may be scaled unevenly.
+
+static const char* kLitInstancedVS = R"(
+#version 330
+
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in vec3 vertexNormal;
+in vec4 vertexColor;
+in mat4 instanceTransform;
+
+uniform mat4 mvp;
+
+out vec3 fragPos;
+out vec2 fragTexCoord;
+out vec4 fragColor;
+out vec3 fragNormal;
+
+void main()
+{
+    vec4 world   = instanceTransform * vec4(vertexPosition, 1.0);
+    fragPos      = world.xyz;
+    fragTexCoord = vertexTexCoord;
+    fragColor    = vertexColor;
+    fragNormal   = normalize(transpose(inverse(mat3(instanceTransform))) * vertexNormal);
+    gl_Position  = mvp * world;
+}
+)";
+
+// ─── Embedded GLSL — skinning vertex shader ──────────────────────────────────
+//
+// Same outputs as kLitVS for meshes with bone weights (see AnimationSystem):
+// each vertex is moved by the weighted sum of up to four of boneMatrices,
+// which raylib uploads from mesh.boneMatrices.  A vertex weighted to no
+// bone stays put.  MAX_SKIN_BONES is prepended as a #define at Init().
+
+static const char* kLitSkinnedVSBody = R"(
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in vec3 vertexNormal;
+in vec4 vertexColor;
+in vec4 vertexBoneIds;
+in vec4 vertexBoneWeights;
+
+uniform mat4 mvp;
+uniform mat4 matModel;
+uniform mat4 matNormal;
+uniform mat4 boneMatrices[MAX_SKIN_BONES];
+
+out vec3 fragPos;
+out vec2 fragTexCoord;
+out vec4 fragColor;
+out vec3 fragNormal;
+
+void main()
+{
+    mat4 skin = mat4(1.0);
+    if (dot(vertexBoneWeights, vec4(1.0)) > 0.0)
+        skin = boneMatrices[int(vertexBoneIds.x)] * vertexBoneWeights.x
+             + boneMatrices[int(vertexBoneIds.y)] * vertexBoneWeights.y
+             + boneMatrices[int(vertexBoneIds.z)] * vertexBoneWeights.z
+             + boneMatrices[int(vertexBoneIds.w)] * vertexBoneWeights.w;
+    vec4 position = skin * vec4(vertexPosition, 1.0);
+
+    fragPos      = vec3(matModel * position);
+    fragTexCoord = vertexTexCoord;
+    fragColor    = vertexColor;
+    fragNormal   = normalize(mat3(matNormal) * (mat3(skin) * vertexNormal));
+    gl_Position  = mvp * position;
+}
+)";
+
+// ─── Embedded GLSL — fragment shader ─────────────────────────────────────────
+//
+// Clustered forward shading: the fragment finds its cluster from its screen
+// tile and view depth, then shades the directional lights and its cluster's
+// lights, fetched from the light textures LightingSystem uploads.
+// Lighting model: Blinn-Phong with squared-distance attenuation.  The
+// cluster constants are prepended as #defines at Init() (FragmentSource()).
+// Baked light comes on top: the lightmap where LIGHTMAPPED is defined, the
+// light probe grid everywhere else.
+
+static const char* kLitFSBody = R"(
 in vec3 fragPos;
 in vec2 fragTexCoord;
 in vec4 fragColor;
@@ -58,60 +181,167 @@ in vec3 fragNormal;
 uniform sampler2D texture0;
 uniform vec4      colDiffuse;
 
+#ifdef LIGHTMAPPED
+in vec2 fragTexCoord2;
+uniform sampler2D lightmap;    // RGBM: rgb * a * LIGHTMAP_RANGE
+#else
+// Light probes (see LightProbeGrid): six texels per probe, +X -X +Y -Y +Z -Z,
+// PROBES_PER_ROW probes a row.  probeCount.x == 0: none.
+uniform sampler2D lightProbes;
+uniform vec3      probeOrigin;
+uniform float     probeSpacing;
+uniform ivec3     probeCount;
+#endif
+
 uniform vec3  viewPos;
+uniform vec3  viewForward;     // normalised camera direction
+uniform vec2  screenSize;      // render target, in pixels
+uniform vec4  clusterDepth;    // zNear, slices per log unit, ortho (0/1), slices per unit (ortho)
+uniform int   dirLightCount;   // directional lights at the head of lightIndices
 uniform vec3  ambientColor;
 uniform float ambientIntensity;
 
-// Parallel arrays — one element per light slot (always MAX_LIGHTS elements)
-uniform int   lightEnabled[MAX_LIGHTS];
-uniform int   lightType[MAX_LIGHTS];       // 0=point  1=directional  2=spot
-uniform vec3  lightPos[MAX_LIGHTS];
-uniform vec3  lightDir[MAX_LIGHTS];        // normalised world-space direction
-uniform vec3  lightColor[MAX_LIGHTS];      // linear 0-1
-uniform float lightIntensity[MAX_LIGHTS];
-uniform float lightRange[MAX_LIGHTS];
-uniform float lightInnerCos[MAX_LIGHTS];   // cos(innerAngle)
-uniform float lightOuterCos[MAX_LIGHTS];   // cos(outerAngle)
+// Shadow atlas (see ShadowAtlas): per tile, world → (u, v, depth)
+uniform sampler2D shadowAtlas;
+uniform mat4      shadowMatrices[SHADOW_TILES];
+uniform vec3      cascadeSplits;   // view depth where each cascade ends
+
+// One row of four texels per light:
+//   (pos.xyz, type) (dir.xyz, range) (color * intensity, innerCos) (outerCos, shadow tile, -, -)
+uniform sampler2D lightData;
+// One texel per cluster: (offset into lightIndices, count, -, -)
+uniform sampler2D lightGrid;
+// Light indices, LIGHT_INDEX_WIDTH per row
+uniform sampler2D lightIndices;
 
 out vec4 finalColor;
 
-// ── Point light ──────────────────────────────────────────────────────────────
-vec3 CalcPointLight(int i, vec3 N, vec3 V)
+struct Light {
+    int   type;       // 0=point  1=directional  2=spot
+    vec3  pos;
+    vec3  dir;        // normalised world-space direction
+    vec3  color;      // linear, intensity applied
+    float range;
+    float innerCos;
+    float outerCos;
+    int   shadow;     // first shadow-atlas tile, -1 for none
+};
+
+Light FetchLight(int slot)
 {
-    vec3  L   = normalize(lightPos[i] - fragPos);
-    float d   = length(lightPos[i] - fragPos);
-    float att = clamp(1.0 - (d / lightRange[i]) * (d / lightRange[i]), 0.0, 1.0);
-    float diff = max(dot(N, L), 0.0);
-    vec3  H    = normalize(L + V);
-    float spec = pow(max(dot(N, H), 0.0), 32.0) * 0.3;
-    return lightColor[i] * lightIntensity[i] * att * (diff + spec);
+    vec4 t0 = texelFetch(lightData, ivec2(0, slot), 0);
+    vec4 t1 = texelFetch(lightData, ivec2(1, slot), 0);
+    vec4 t2 = texelFetch(lightData, ivec2(2, slot), 0);
+    vec4 t3 = texelFetch(lightData, ivec2(3, slot), 0);
+    return Light(int(t0.w + 0.5), t0.xyz, t1.xyz, t2.xyz, t1.w, t2.w, t3.x, int(floor(t3.y + 0.5)));
 }
 
-// ── Directional light ─────────────────────────────────────────────────────────
-vec3 CalcDirLight(int i, vec3 N, vec3 V)
+int LightIndex(int i)
 {
-    vec3  L    = normalize(-lightDir[i]);
-    float diff = max(dot(N, L), 0.0);
-    vec3  H    = normalize(L + V);
-    float spec = pow(max(dot(N, H), 0.0), 32.0) * 0.3;
-    return lightColor[i] * lightIntensity[i] * (diff + spec);
+    return int(texelFetch(lightIndices, ivec2(i % LIGHT_INDEX_WIDTH, i / LIGHT_INDEX_WIDTH), 0).r + 0.5);
 }
 
-// ── Spot light ────────────────────────────────────────────────────────────────
-vec3 CalcSpotLight(int i, vec3 N, vec3 V)
+// 3×3 PCF in one tile, kept inside it
+float ShadowTile(int tile, vec3 pos)
 {
-    vec3  L    = normalize(lightPos[i] - fragPos);
-    float d    = length(lightPos[i] - fragPos);
-    float att  = clamp(1.0 - (d / lightRange[i]) * (d / lightRange[i]), 0.0, 1.0);
-    float cosA = dot(L, normalize(-lightDir[i]));
-    float eps  = lightInnerCos[i] - lightOuterCos[i];
-    float spot = clamp((cosA - lightOuterCos[i]) / eps, 0.0, 1.0);
+    vec4 p = shadowMatrices[tile] * vec4(pos, 1.0);
+    p.xyz /= p.w;
+    if (p.z >= 1.0) return 1.0;
+    const float texel = 1.0 / float(SHADOW_ATLAS_SIZE);
+    vec2 lo = vec2(tile % SHADOW_GRID, tile / SHADOW_GRID) / float(SHADOW_GRID) + texel;
+    vec2 hi = lo + 1.0 / float(SHADOW_GRID) - 2.0 * texel;
+    float lit = 0.0;
+    for (int y = -1; y <= 1; y++)
+        for (int x = -1; x <= 1; x++) {
+            vec2 uv = clamp(p.xy + vec2(x, y) * texel, lo, hi);
+            lit += p.z - 0.0005 <= texture(shadowAtlas, uv).r ? 1.0 : 0.0;
+        }
+    return lit / 9.0;
+}
+
+float Shadow(Light l, vec3 N, vec3 L)
+{
+    if (l.shadow < 0) return 1.0;
+    // Normal offset against acne, larger at grazing angles
+    vec3 pos  = fragPos + N * (0.02 + 0.08 * (1.0 - max(dot(N, L), 0.0)));
+    int  tile = l.shadow;
+    if (l.type == 1) {
+        float depth = dot(fragPos - viewPos, viewForward);
+        int c = 0;
+        while (c < SHADOW_CASCADES && depth >= cascadeSplits[c]) c++;
+        if (c == SHADOW_CASCADES) return 1.0;
+        tile += c;
+    } else if (l.type == 0) {
+        vec3 d = fragPos - l.pos;
+        vec3 a = abs(d);
+        tile += a.x >= a.y && a.x >= a.z ? (d.x > 0.0 ? 0 : 1)
+              : a.y >= a.z               ? (d.y > 0.0 ? 2 : 3)
+              :                            (d.z > 0.0 ? 4 : 5);
+    }
+    return ShadowTile(tile, pos);
+}
+
+vec3 CalcLight(Light l, vec3 N, vec3 V)
+{
+    vec3  L;
+    float att = 1.0;
+    if (l.type == 1) {
+        L = normalize(-l.dir);
+    } else {
+        L = normalize(l.pos - fragPos);
+        float d = length(l.pos - fragPos);
+        att = clamp(1.0 - (d / l.range) * (d / l.range), 0.0, 1.0);
+        if (l.type == 2) {
+            float cosA = dot(L, normalize(-l.dir));
+            att *= clamp((cosA - l.outerCos) / (l.innerCos - l.outerCos), 0.0, 1.0);
+        }
+    }
     float diff = max(dot(N, L), 0.0);
     vec3  H    = normalize(L + V);
     float spec = pow(max(dot(N, H), 0.0), 32.0) * 0.3;
-    return lightColor[i] * lightIntensity[i] * att * spot * (diff + spec);
+    if (diff <= 0.0 || att <= 0.0) return vec3(0.0);
+    return l.color * att * (diff + spec) * Shadow(l, N, L);
 }
 
+ivec2 ClusterRange()
+{
+    vec2  tile  = floor(gl_FragCoord.xy / screenSize * vec2(CLUSTER_X, CLUSTER_Y));
+    float depth = dot(fragPos - viewPos, viewForward);
+    float slice = clusterDepth.z > 0.5
+                ? floor(depth * clusterDepth.w)
+                : (depth < clusterDepth.x ? 0.0 : 1.0 + floor(log(depth / clusterDepth.x) * clusterDepth.y));
+    ivec3 c = clamp(ivec3(tile, slice), ivec3(0), ivec3(CLUSTER_X - 1, CLUSTER_Y - 1, CLUSTER_Z - 1));
+    vec4 cell = texelFetch(lightGrid, ivec2(c.y * CLUSTER_X + c.x, c.z), 0);
+    return ivec2(int(cell.x + 0.5), int(cell.y + 0.5));
+}
+
+#ifndef LIGHTMAPPED
+vec3 ProbeFace(int probe, int face)
+{
+    return texelFetch(lightProbes, ivec2((probe % PROBES_PER_ROW) * 6 + face, probe / PROBES_PER_ROW), 0).rgb;
+}
+
+// The eight probes around the fragment blended, each an ambient cube
+vec3 ProbeLight(vec3 N)
+{
+    if (probeCount.x == 0) return vec3(0.0);
+    vec3  g  = clamp((fragPos - probeOrigin) / probeSpacing, vec3(0.0), vec3(probeCount - 1));
+    ivec3 lo = ivec3(g);
+    ivec3 hi = min(lo + 1, probeCount - 1);
+    vec3  f  = g - vec3(lo);
+    vec3  n2 = N * N;
+    ivec3 face = ivec3(N.x < 0.0 ? 1 : 0, N.y < 0.0 ? 3 : 2, N.z < 0.0 ? 5 : 4);
+    vec3 sum = vec3(0.0);
+    for (int i = 0; i < 8; i++) {
+        ivec3 c = ivec3((i & 1) != 0 ? hi.x : lo.x, (i & 2) != 0 ? hi.y : lo.y, (i & 4) != 0 ? hi.z : lo.z);
+        vec3  w = mix(1.0 - f, f, vec3((i & 1) != 0, (i & 2) != 0, (i & 4) != 0));
+        int   p = (c.z * probeCount.y + c.y) * probeCount.x + c.x;
+        sum += w.x * w.y * w.z * (n2.x * ProbeFace(p, face.x) + n2.y * ProbeFace(p, face.y) + n2.z * ProbeFace(p, face.z));
+    }
+    return sum;
+}
+#endif
+
 void main()
 {
     vec4 texColor  = texture(texture0, fragTexCoord);
@@ -121,13 +351,19 @@ void main()
     vec3 V = normalize(viewPos - fragPos);
 
     vec3 result = ambientColor * ambientIntensity;
+#ifdef LIGHTMAPPED
+    vec4 baked = texture(lightmap, fragTexCoord2);
+    result += baked.rgb * baked.a * LIGHTMAP_RANGE;
+#else
+    result += ProbeLight(N);
+#endif
 
-    for (int i = 0; i < MAX_LIGHTS; i++) {
-        if (lightEnabled[i] == 0) continue;
-        if      (lightType[i] == 0) result += CalcPointLight(i, N, V);
-        else if (lightType[i] == 1) result += CalcDirLight(i, N, V);
-        else if (lightType[i] == 2) result += CalcSpotLight(i, N, V);
-    }
+    for (int i = 0; i < dirLightCount; i++)
+        result += CalcLight(FetchLight(LightIndex(i)), N, V);
+
+    ivec2 range = ClusterRange();
+    for (int i = range.x; i < range.x + range.y; i++)
+        result += CalcLight(FetchLight(LightIndex(i)), N, V);
 
     finalColor   = vec4(result, 1.0) * baseColor;
     finalColor.a = baseColor.a;
@@ -144,19 +380,104 @@ LightingSystem& LightingSystem::Get()
     return s_instance;
 }
 
+namespace {
+    // shadowAtlas, then lightData, lightGrid, lightIndices: past the units
+    // DrawMesh() uses for material maps and rlgl's batch uses for its
+    // textures.  The light probes take the unit of the last of raylib's 12
+    // material map slots, the one it names no map for.
+    constexpr int PROBE_TEXTURE_UNIT  = MATERIAL_MAP_BRDF + 1;
+    constexpr int SHADOW_TEXTURE_UNIT = 12;
+    constexpr int LIGHT_TEXTURE_UNIT  = 13;
+    static_assert(PROBE_TEXTURE_UNIT < SHADOW_TEXTURE_UNIT, "the probe unit must be one no material map uses");
+
+    // Light probe texture: a row of PROBES_PER_ROW probes, six texels each
+    constexpr int PROBES_PER_ROW = 128;
+    static_assert(SHADOW_CASCADES == 3, "cascadeSplits is a vec3");
+
+    constexpr int LIGHT_INDEX_WIDTH  = 1024;
+    constexpr int LIGHT_INDEX_HEIGHT = MAX_CLUSTER_INDICES / LIGHT_INDEX_WIDTH;
+    static_assert(MAX_CLUSTER_INDICES % LIGHT_INDEX_WIDTH == 0, "index texture rows must be whole");
+
+    // Depth slicing: slice 0 is [0, CLUSTER_NEAR), the rest split
+    // [CLUSTER_NEAR, CULL_FAR) exponentially (linearly for orthographic views)
+    constexpr float CLUSTER_NEAR = 1.0f;
+
+    std::string FragmentSource(bool lightmapped)
+    {
+        return std::string("#version 330\n")
+               + (lightmapped ? "#define LIGHTMAPPED\n" : "") +
+               "#define LIGHTMAP_RANGE "    + std::to_string(LIGHTMAP_RANGE)    + "\n"
+               "#define PROBES_PER_ROW "    + std::to_string(PROBES_PER_ROW)    + "\n"
+               "#define CLUSTER_X "         + std::to_string(CLUSTER_X)         + "\n"
+               "#define CLUSTER_Y "         + std::to_string(CLUSTER_Y)         + "\n"
+               "#define CLUSTER_Z "         + std::to_string(CLUSTER_Z)         + "\n"
+               "#define LIGHT_INDEX_WIDTH " + std::to_string(LIGHT_INDEX_WIDTH) + "\n"
+               "#define SHADOW_ATLAS_SIZE " + std::to_string(SHADOW_ATLAS_SIZE) + "\n"
+               "#define SHADOW_GRID "       + std::to_string(SHADOW_GRID)       + "\n"
+               "#define SHADOW_TILES "      + std::to_string(SHADOW_TILES)      + "\n"
+               "#define SHADOW_CASCADES "   + std::to_string(SHADOW_CASCADES)   + "\n"
+               + kLitFSBody;
+    }
+
+    std::string SkinnedVertexSource()
+    {
+        return "#version 330\n"
+               "#define MAX_SKIN_BONES " + std::to_string(MAX_SKIN_BONES) + "\n"
+               + kLitSkinnedVSBody;
+    }
+}
+
 bool LightingSystem::Init()
 {
     if (m_ready) return true;
 
-    m_shader = LoadShaderFromMemory(kLitVS, kLitFS);
+    const std::string fs = FragmentSource(false);
+    m_shader = ShaderCache::Get().Load(kLitVS, fs.c_str());
     if (m_shader.id == 0) {
         TraceLog(LOG_ERROR, "LightingSystem: failed to compile lighting shader");
         return false;
     }
+    if (!LoadLightTextures()) {
+        TraceLog(LOG_ERROR, "LightingSystem: failed to create light textures");
+        UnloadShader(m_shader);
+        m_shader = {};
+        return false;
+    }
+
+    CacheLocations(m_shader, m_locs);
+
+    // Instancing is optional: without it models are drawn one call each
+    m_instancedShader = ShaderCache::Get().Load(kLitInstancedVS, fs.c_str());
+    if (m_instancedShader.id != 0) {
+        m_instancedShader.locs[SHADER_LOC_MATRIX_MODEL] =
+            GetShaderLocationAttrib(m_instancedShader, "instanceTransform");
+        CacheLocations(m_instancedShader, m_instancedLocs);
+    } else {
+        TraceLog(LOG_WARNING, "LightingSystem: failed to compile instancing shader");
+    }
+
+    // Skinning too: without it characters are not drawn
+    m_skinnedShader = ShaderCache::Get().Load(SkinnedVertexSource().c_str(), fs.c_str());
+    if (m_skinnedShader.id != 0) CacheLocations(m_skinnedShader, m_skinnedLocs);
+    else TraceLog(LOG_WARNING, "LightingSystem: failed to compile skinning shader");
+
+    // And baked lighting: without it lightmapped meshes are lit by probes
+    // (SceneImporter leaves them the default shader)
+    m_lightmappedShader = ShaderCache::Get().Load(kLitLightmappedVS, FragmentSource(true).c_str());
+    if (m_lightmappedShader.id != 0) {
+        m_lightmappedShader.locs[SHADER_LOC_MAP_DIFFUSE + LIGHTMAP_MATERIAL_MAP] =
+            GetShaderLocation(m_lightmappedShader, "lightmap");
+        CacheLocations(m_lightmappedShader, m_lightmappedLocs);
+    } else {
+        TraceLog(LOG_WARNING, "LightingSystem: failed to compile lightmapped shader");
+    }
+
+    // Without shadows lighting still works, unshadowed
+    m_shadows.Init();
 
-    CacheLocations();
     m_ready = true;
-    TraceLog(LOG_INFO, "LightingSystem: ready (MAX_LIGHTS=%d)", MAX_LIGHTS);
+    TraceLog(LOG_INFO, "LightingSystem: ready (MAX_LIGHTS=%d, %dx%dx%d clusters)",
+             MAX_LIGHTS, CLUSTER_X, CLUSTER_Y, CLUSTER_Z);
     return true;
 }
 
@@ -164,40 +485,106 @@ void LightingSystem::Unload()
 {
     if (!m_ready) return;
     UnloadShader(m_shader);
-    m_shader = {};
+    if (m_instancedShader.id != 0) UnloadShader(m_instancedShader);
+    if (m_skinnedShader.id != 0) UnloadShader(m_skinnedShader);
+    if (m_lightmappedShader.id != 0) UnloadShader(m_lightmappedShader);
+    if (m_probeTex != 0) rlUnloadTexture(m_probeTex);
+    rlUnloadTexture(m_lightDataTex);
+    rlUnloadTexture(m_lightGridTex);
+    rlUnloadTexture(m_lightIndexTex);
+    m_shadows.Unload();
+    m_shader          = {};
+    m_instancedShader = {};
+    m_skinnedShader   = {};
+    m_lightmappedShader = {};
+    m_lightDataTex = m_lightGridTex = m_lightIndexTex = m_probeTex = 0;
+    m_probeCount   = {};
     m_ready  = false;
 }
 
-void LightingSystem::CacheLocations()
+bool LightingSystem::LoadLightTextures()
+{
+    m_lightData.assign((size_t)MAX_LIGHTS * 16, 0.f);
+    m_gridData.assign((size_t)CLUSTER_COUNT * 4, 0.f);
+    m_indexData.assign((size_t)MAX_CLUSTER_INDICES, 0.f);
+    m_clusterFill.assign(CLUSTER_COUNT, 0);
+
+    // Fresh textures: everything goes up again
+    m_shadowTile.fill(-1);
+    m_changed.set();
+    m_binned         = false;
+    m_ambientChanged = true;
+    m_probesChanged  = true;
+
+    m_lightDataTex  = rlLoadTexture(m_lightData.data(), 4, MAX_LIGHTS,
+                                    RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, 1);
+    m_lightGridTex  = rlLoadTexture(m_gridData.data(), CLUSTER_X * CLUSTER_Y, CLUSTER_Z,
+                                    RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, 1);
+    m_lightIndexTex = rlLoadTexture(m_indexData.data(), LIGHT_INDEX_WIDTH, LIGHT_INDEX_HEIGHT,
+                                    RL_PIXELFORMAT_UNCOMPRESSED_R32, 1);
+    if (m_lightDataTex != 0 && m_lightGridTex != 0 && m_lightIndexTex != 0) return true;
+
+    rlUnloadTexture(m_lightDataTex);
+    rlUnloadTexture(m_lightGridTex);
+    rlUnloadTexture(m_lightIndexTex);
+    m_lightDataTex = m_lightGridTex = m_lightIndexTex = 0;
+    return false;
+}
+
+void LightingSystem::BindLightTextures() const
+{
+    const unsigned int ids[4] = { m_shadows.Texture(), m_lightDataTex, m_lightGridTex, m_lightIndexTex };
+    for (int i = 0; i < 4; i++) {
+        if (ids[i] == 0) continue;
+        rlActiveTextureSlot(SHADOW_TEXTURE_UNIT + i);
+        rlEnableTexture(ids[i]);
+    }
+    if (m_probeTex != 0) {
+        rlActiveTextureSlot(PROBE_TEXTURE_UNIT);
+        rlEnableTexture(m_probeTex);
+    }
+    rlActiveTextureSlot(0);
+}
+
+void LightingSystem::CacheLocations(const Shader& shader, Locs& locs)
 {
-    m_locs.viewPos          = GetShaderLocation(m_shader, "viewPos");
-    m_locs.ambientColor     = GetShaderLocation(m_shader, "ambientColor");
-    m_locs.ambientIntensity = GetShaderLocation(m_shader, "ambientIntensity");
-
-    // Uniform arrays: query the base location via the [0] element
-    m_locs.lightEnabled   = GetShaderLocation(m_shader, "lightEnabled[0]");
-    m_locs.lightType      = GetShaderLocation(m_shader, "lightType[0]");
-    m_locs.lightPos       = GetShaderLocation(m_shader, "lightPos[0]");
-    m_locs.lightDir       = GetShaderLocation(m_shader, "lightDir[0]");
-    m_locs.lightColor     = GetShaderLocation(m_shader, "lightColor[0]");
-    m_locs.lightIntensity = GetShaderLocation(m_shader, "lightIntensity[0]");
-    m_locs.lightRange     = GetShaderLocation(m_shader, "lightRange[0]");
-    m_locs.lightInnerCos  = GetShaderLocation(m_shader, "lightInnerCos[0]");
-    m_locs.lightOuterCos  = GetShaderLocation(m_shader, "lightOuterCos[0]");
+    locs.viewPos          = GetShaderLocation(shader, "viewPos");
+    locs.viewForward      = GetShaderLocation(shader, "viewForward");
+    locs.screenSize       = GetShaderLocation(shader, "screenSize");
+    locs.clusterDepth     = GetShaderLocation(shader, "clusterDepth");
+    locs.dirLightCount    = GetShaderLocation(shader, "dirLightCount");
+    locs.ambientColor     = GetShaderLocation(shader, "ambientColor");
+    locs.ambientIntensity = GetShaderLocation(shader, "ambientIntensity");
+    locs.probeOrigin      = GetShaderLocation(shader, "probeOrigin");
+    locs.probeSpacing     = GetShaderLocation(shader, "probeSpacing");
+    locs.probeCount       = GetShaderLocation(shader, "probeCount");
+
+    locs.cascadeSplits    = GetShaderLocation(shader, "cascadeSplits");
+    for (int i = 0; i < SHADOW_TILES; i++)
+        locs.shadowMatrix[i] = GetShaderLocation(shader, TextFormat("shadowMatrices[%d]", i));
+
+    // The samplers never move: point them at their units once
+    const char* samplers[4] = { "shadowAtlas", "lightData", "lightGrid", "lightIndices" };
+    for (int i = 0; i < 4; i++) {
+        const int unit = SHADOW_TEXTURE_UNIT + i;
+        SetShaderValue(shader, GetShaderLocation(shader, samplers[i]), &unit, SHADER_UNIFORM_INT);
+    }
+    SetShaderValue(shader, GetShaderLocation(shader, "lightProbes"), &PROBE_TEXTURE_UNIT, SHADER_UNIFORM_INT);
 }
 
 int LightingSystem::AddLight(LightType type, Vector3 pos, Vector3 dir,
                               Vector3 colorLinear, float intensity, float range)
 {
     for (int i = 0; i < MAX_LIGHTS; i++) {
-        if (!m_lights[i].enabled) {
-            m_lights[i].type      = type;
-            m_lights[i].enabled   = true;
-            m_lights[i].position  = pos;
-            m_lights[i].direction = dir;
-            m_lights[i].color     = colorLinear;
-            m_lights[i].intensity = intensity;
-            m_lights[i].range     = range;
+        if (!m_pending[i].enabled) {
+            m_pending[i].type      = type;
+            m_pending[i].enabled   = true;
+            m_pending[i].position  = pos;
+            m_pending[i].direction = dir;
+            m_pending[i].color     = colorLinear;
+            m_pending[i].intensity = intensity;
+            m_pending[i].range     = range;
+            m_pendingChanged.set(i);
             return i + 1;   // 1-based handle
         }
     }
@@ -208,7 +595,8 @@ int LightingSystem::AddLight(LightType type, Vector3 pos, Vector3 dir,
 void LightingSystem::RemoveLight(int handle)
 {
     if (!IsValidHandle(handle)) return;
-    m_lights[handle - 1] = LightDesc{};  // resets enabled = false
+    m_pending[handle - 1] = LightDesc{};  // resets enabled = false
+    m_pendingChanged.set(handle - 1);
 }
 
 bool LightingSystem::IsValidHandle(int handle) const
@@ -219,65 +607,269 @@ bool LightingSystem::IsValidHandle(int handle) const
 LightDesc* LightingSystem::GetLight(int handle)
 {
     if (!IsValidHandle(handle)) return nullptr;
-    return &m_lights[handle - 1];
+    m_pendingChanged.set(handle - 1);   // the caller is about to write it
+    return &m_pending[handle - 1];
 }
 
 void LightingSystem::SetAmbient(Vector3 colorLinear, float intensity)
 {
-    m_ambientColor     = colorLinear;
-    m_ambientIntensity = intensity;
+    m_pendingAmbientColor     = colorLinear;
+    m_pendingAmbientIntensity = intensity;
+    m_pendingAmbient          = true;
 }
 
-void LightingSystem::UploadUniforms(Camera camera)
+void LightingSystem::Publish()
 {
-    if (!m_ready) return;
+    for (int i = 0; i < MAX_LIGHTS; i++) {
+        if (!m_pendingChanged.test(i)) continue;
+        m_lights[i] = m_pending[i];
+    }
+    m_changed |= m_pendingChanged;
+    m_pendingChanged.reset();
+    if (m_pendingAmbient) {
+        m_ambientColor     = m_pendingAmbientColor;
+        m_ambientIntensity = m_pendingAmbientIntensity;
+        m_ambientChanged   = true;
+        m_pendingAmbient   = false;
+    }
+    if (m_pendingShadowBudget != 0) {
+        m_shadows.SetBudget(m_pendingShadowBudget);
+        m_pendingShadowBudget = 0;
+    }
+}
 
-    // View position
-    SetShaderValue(m_shader, m_locs.viewPos, &camera.position, SHADER_UNIFORM_VEC3);
+int LightingSystem::BinLights(const Camera& camera, float aspect)
+{
+    // View basis as MatrixLookAt builds it
+    const Vector3 fwd   = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    const Vector3 right = Vector3Normalize(Vector3CrossProduct(fwd, camera.up));
+    const Vector3 up    = Vector3CrossProduct(right, fwd);
+
+    const bool  ortho = camera.projection == CAMERA_ORTHOGRAPHIC;
+    const float halfH = ortho ? camera.fovy * 0.5f : tanf(camera.fovy * 0.5f * DEG2RAD);
+    const float halfW = halfH * aspect;
+    const float logScale = (float)(CLUSTER_Z - 1) / logf(CULL_FAR / CLUSTER_NEAR);
+
+    const auto sliceOf = [&](float depth) {
+        const int z = ortho ? (int)(depth * CLUSTER_Z / CULL_FAR)
+                    : depth < CLUSTER_NEAR ? 0 : 1 + (int)(logf(depth / CLUSTER_NEAR) * logScale);
+        return std::clamp(z, 0, CLUSTER_Z - 1);
+    };
+    const auto sliceStart = [&](int z) {
+        if (ortho) return z * CULL_FAR / CLUSTER_Z;
+        return z == 0 ? 0.f : CLUSTER_NEAR * expf((float)(z - 1) / logScale);
+    };
+    const auto tileOf = [](float ndc, int tiles) {
+        return std::clamp((int)floorf((ndc * 0.5f + 0.5f) * tiles), 0, tiles - 1);
+    };
+
+    // fn(cluster) for every cluster the light's range sphere may reach: per
+    // slice, the tiles under the sphere's box clipped to the slice.  Spot
+    // lights are binned by their whole sphere.
+    const auto forEachCluster = [&](const LightDesc& l, auto&& fn) {
+        const Vector3 rel = Vector3Subtract(l.position, camera.position);
+        const float x = Vector3DotProduct(rel, right);
+        const float y = Vector3DotProduct(rel, up);
+        const float d = Vector3DotProduct(rel, fwd);
+        const float r = l.range;
+        if (d + r <= 0.f || d - r >= CULL_FAR) return;
+
+        const int z0 = sliceOf(std::max(d - r, 0.f));
+        const int z1 = sliceOf(std::min(d + r, CULL_FAR));
+        for (int z = z0; z <= z1; z++) {
+            float x0 = (x - r) / halfW, x1 = (x + r) / halfW;
+            float y0 = (y - r) / halfH, y1 = (y + r) / halfH;
+            if (!ortho) {
+                // x / depth over the part of the sphere in this slice
+                const float dn = std::max({ d - r, sliceStart(z), 1e-4f });
+                const float df = std::max(std::min(d + r, z + 1 < CLUSTER_Z ? sliceStart(z + 1) : CULL_FAR), dn);
+                x0 = std::min(x0 / dn, x0 / df); x1 = std::max(x1 / dn, x1 / df);
+                y0 = std::min(y0 / dn, y0 / df); y1 = std::max(y1 / dn, y1 / df);
+            }
+            if (x1 < -1.f || x0 > 1.f || y1 < -1.f || y0 > 1.f) continue;
+            const int tx0 = tileOf(x0, CLUSTER_X), tx1 = tileOf(x1, CLUSTER_X);
+            const int ty0 = tileOf(y0, CLUSTER_Y), ty1 = tileOf(y1, CLUSTER_Y);
+            for (int ty = ty0; ty <= ty1; ty++)
+                for (int tx = tx0; tx <= tx1; tx++)
+                    fn((z * CLUSTER_Y + ty) * CLUSTER_X + tx);
+        }
+    };
 
-    // Ambient
-    SetShaderValue(m_shader, m_locs.ambientColor,     &m_ambientColor,     SHADER_UNIFORM_VEC3);
-    SetShaderValue(m_shader, m_locs.ambientIntensity, &m_ambientIntensity, SHADER_UNIFORM_FLOAT);
+    // Directional lights lead the index list: every fragment shades them
+    int used = 0;
+    m_active.clear();
+    for (int i = 0; i < MAX_LIGHTS; i++) {
+        const LightDesc& l = m_lights[i];
+        if (!l.enabled) continue;
+        if (l.type == LightType::Directional) m_indexData[used++] = (float)i;
+        else m_active.push_back(i);
+    }
+    const int dirCount = used;
+
+    // Count, lay the clusters out, then fill
+    std::fill(m_clusterFill.begin(), m_clusterFill.end(), 0u);
+    for (int i : m_active)
+        forEachCluster(m_lights[i], [&](int c) { m_clusterFill[c]++; });
+
+    for (int c = 0; c < CLUSTER_COUNT; c++) {
+        const int want  = (int)m_clusterFill[c];
+        const int count = std::min(want, MAX_CLUSTER_INDICES - used);
+        m_gridData[c * 4 + 0] = (float)used;
+        m_gridData[c * 4 + 1] = (float)count;
+        used += count;
+        m_stats.dropped += want - count;
+        m_clusterFill[c] = 0;
+    }
+    for (int i : m_active)
+        forEachCluster(m_lights[i], [&](int c) {
+            const uint32_t at = m_clusterFill[c];
+            if (at < (uint32_t)m_gridData[c * 4 + 1]) {
+                m_indexData[(size_t)m_gridData[c * 4 + 0] + at] = (float)i;
+                m_clusterFill[c] = at + 1;
+            }
+        });
+
+    m_stats.lights = dirCount + (int)m_active.size();
+    m_stats.binned = used - dirCount;
+    return dirCount;
+}
 
-    // Pack per-light data into flat arrays for batch upload
-    int   enabled[MAX_LIGHTS]   = {};
-    int   type[MAX_LIGHTS]      = {};
-    float pos[MAX_LIGHTS * 3]   = {};
-    float dir[MAX_LIGHTS * 3]   = {};
-    float color[MAX_LIGHTS * 3] = {};
-    float intensity[MAX_LIGHTS] = {};
-    float range[MAX_LIGHTS]     = {};
-    float innerCos[MAX_LIGHTS]  = {};
-    float outerCos[MAX_LIGHTS]  = {};
+void LightingSystem::RenderShadows(Camera camera, const ShadowCasters& casters)
+{
+    if (!m_ready || !m_shadows.IsReady()) return;
+    if (!m_manualPublish) Publish();
+    const int w = GetRenderWidth(), h = GetRenderHeight();
+    if (w <= 0 || h <= 0) return;
+    m_shadows.Render(camera, (float)w / (float)h, m_lights.data(), MAX_LIGHTS, casters);
 
+    // Tiles handed out, taken back or first ready: those rows go up again
     for (int i = 0; i < MAX_LIGHTS; i++) {
-        const LightDesc& l = m_lights[i];
-        enabled[i]   = l.enabled ? 1 : 0;
-        type[i]      = static_cast<int>(l.type);
-        pos[i*3+0]   = l.position.x;
-        pos[i*3+1]   = l.position.y;
-        pos[i*3+2]   = l.position.z;
-        dir[i*3+0]   = l.direction.x;
-        dir[i*3+1]   = l.direction.y;
-        dir[i*3+2]   = l.direction.z;
-        color[i*3+0] = l.color.x;
-        color[i*3+1] = l.color.y;
-        color[i*3+2] = l.color.z;
-        intensity[i] = l.intensity;
-        range[i]     = l.range;
-        innerCos[i]  = l.innerCos;
-        outerCos[i]  = l.outerCos;
+        const int first = m_shadows.FirstTile(i);
+        if (first == m_shadowTile[i]) continue;
+        m_shadowTile[i] = first;
+        m_changed.set(i);
     }
+}
+
+void LightingSystem::UploadUniforms(Camera camera)
+{
+    UploadUniforms(camera, GetRenderWidth(), GetRenderHeight());
+}
 
-    SetShaderValueV(m_shader, m_locs.lightEnabled,   enabled,   SHADER_UNIFORM_INT,   MAX_LIGHTS);
-    SetShaderValueV(m_shader, m_locs.lightType,      type,      SHADER_UNIFORM_INT,   MAX_LIGHTS);
-    SetShaderValueV(m_shader, m_locs.lightPos,       pos,       SHADER_UNIFORM_VEC3,  MAX_LIGHTS);
-    SetShaderValueV(m_shader, m_locs.lightDir,       dir,       SHADER_UNIFORM_VEC3,  MAX_LIGHTS);
-    SetShaderValueV(m_shader, m_locs.lightColor,     color,     SHADER_UNIFORM_VEC3,  MAX_LIGHTS);
-    SetShaderValueV(m_shader, m_locs.lightIntensity, intensity, SHADER_UNIFORM_FLOAT, MAX_LIGHTS);
-    SetShaderValueV(m_shader, m_locs.lightRange,     range,     SHADER_UNIFORM_FLOAT, MAX_LIGHTS);
-    SetShaderValueV(m_shader, m_locs.lightInnerCos,  innerCos,  SHADER_UNIFORM_FLOAT, MAX_LIGHTS);
-    SetShaderValueV(m_shader, m_locs.lightOuterCos,  outerCos,  SHADER_UNIFORM_FLOAT, MAX_LIGHTS);
+void LightingSystem::UploadUniforms(Camera camera, int targetWidth, int targetHeight)
+{
+    if (!m_ready || targetWidth <= 0 || targetHeight <= 0) return;
+    if (!m_manualPublish) Publish();
+    m_stats.uploaded = 0;
+    m_stats.rebinned = false;
+
+    // ── Lights: changed rows only, one update per run of them ────────────────
+    const bool lightsChanged = m_changed.any();
+    for (int i = 0; i < MAX_LIGHTS; ) {
+        if (!m_changed.test(i)) { i++; continue; }
+        const int first = i;
+        for (; i < MAX_LIGHTS && m_changed.test(i); i++) {
+            const LightDesc& l = m_lights[i];
+            float* t = &m_lightData[(size_t)i * 16];
+            t[0]  = l.position.x;  t[1]  = l.position.y;  t[2]  = l.position.z;  t[3]  = (float)l.type;
+            t[4]  = l.direction.x; t[5]  = l.direction.y; t[6]  = l.direction.z; t[7]  = l.range;
+            t[8]  = l.color.x * l.intensity;
+            t[9]  = l.color.y * l.intensity;
+            t[10] = l.color.z * l.intensity;
+            t[11] = l.innerCos;
+            t[12] = l.outerCos;
+            t[13] = (float)m_shadowTile[i];
+        }
+        rlUpdateTexture(m_lightDataTex, 0, first, 4, i - first, RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32,
+                        &m_lightData[(size_t)first * 16]);
+        m_stats.uploaded += i - first;
+    }
+    m_changed.reset();
+
+    // ── Clusters: rebuilt when a light or the view changed ────────────────────
+    const bool viewChanged = !m_binned || targetWidth != m_binnedWidth || targetHeight != m_binnedHeight
+                          || std::memcmp(&camera, &m_binnedCamera, sizeof(Camera)) != 0;
+    if (lightsChanged || viewChanged) {
+        m_stats.lights  = 0;
+        m_stats.binned  = 0;
+        m_stats.dropped = 0;
+        const float aspect = (float)targetWidth / (float)targetHeight;
+        m_dirCount = BinLights(camera, aspect);
+        const int indices   = m_dirCount + m_stats.binned;
+        const int indexRows = std::max(1, (indices + LIGHT_INDEX_WIDTH - 1) / LIGHT_INDEX_WIDTH);
+        rlUpdateTexture(m_lightGridTex, 0, 0, CLUSTER_X * CLUSTER_Y, CLUSTER_Z,
+                        RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, m_gridData.data());
+        rlUpdateTexture(m_lightIndexTex, 0, 0, LIGHT_INDEX_WIDTH, indexRows,
+                        RL_PIXELFORMAT_UNCOMPRESSED_R32, m_indexData.data());
+        m_binned       = true;
+        m_binnedCamera = camera;
+        m_binnedWidth  = targetWidth;
+        m_binnedHeight = targetHeight;
+        m_stats.rebinned = true;
+    }
+    BindLightTextures();
+
+    // ── Uniforms, the same for both variants of the shader ───────────────────
+    // The view ones are cheap and change with the camera; ambient only when set
+    const Vector3 forward  = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    const bool    ortho    = camera.projection == CAMERA_ORTHOGRAPHIC;
+    const float   size[2]  = { (float)targetWidth, (float)targetHeight };
+    const float   depth[4] = { CLUSTER_NEAR, (float)(CLUSTER_Z - 1) / logf(CULL_FAR / CLUSTER_NEAR),
+                               ortho ? 1.f : 0.f, (float)CLUSTER_Z / CULL_FAR };
+    const auto upload = [&](const Shader& shader, const Locs& locs) {
+        SetShaderValue(shader, locs.viewPos,          &camera.position,    SHADER_UNIFORM_VEC3);
+        SetShaderValue(shader, locs.viewForward,      &forward,            SHADER_UNIFORM_VEC3);
+        SetShaderValue(shader, locs.screenSize,       size,                SHADER_UNIFORM_VEC2);
+        SetShaderValue(shader, locs.clusterDepth,     depth,               SHADER_UNIFORM_VEC4);
+        SetShaderValue(shader, locs.dirLightCount,    &m_dirCount,         SHADER_UNIFORM_INT);
+        if (m_shadows.IsReady()) {
+            SetShaderValue(shader, locs.cascadeSplits, m_shadows.CascadeSplits(), SHADER_UNIFORM_VEC3);
+            for (int i = 0; i < SHADOW_TILES; i++)
+                SetShaderValueMatrix(shader, locs.shadowMatrix[i], m_shadows.TileMatrix(i));
+        }
+        if (m_probesChanged) {
+            SetShaderValue(shader, locs.probeOrigin,  &m_probeOrigin,  SHADER_UNIFORM_VEC3);
+            SetShaderValue(shader, locs.probeSpacing, &m_probeSpacing, SHADER_UNIFORM_FLOAT);
+            SetShaderValue(shader, locs.probeCount,   m_probeCount.data(), SHADER_UNIFORM_IVEC3);
+        }
+        if (!m_ambientChanged) return;
+        SetShaderValue(shader, locs.ambientColor,     &m_ambientColor,     SHADER_UNIFORM_VEC3);
+        SetShaderValue(shader, locs.ambientIntensity, &m_ambientIntensity, SHADER_UNIFORM_FLOAT);
+    };
+    upload(m_shader, m_locs);
+    if (m_instancedShader.id != 0)   upload(m_instancedShader, m_instancedLocs);
+    if (m_skinnedShader.id != 0)     upload(m_skinnedShader, m_skinnedLocs);
+    if (m_lightmappedShader.id != 0) upload(m_lightmappedShader, m_lightmappedLocs);
+    m_ambientChanged = false;
+    m_probesChanged  = false;
+}
+
+void LightingSystem::SetLightProbes(const LightProbeGrid& probes)
+{
+    if (!m_ready) return;
+    if (m_probeTex != 0) rlUnloadTexture(m_probeTex);
+    m_probeTex     = 0;
+    m_probeCount   = {};
+    m_probesChanged = true;
+    if (probes.Empty() || probes.Count() > MAX_LIGHT_PROBES || probes.faces.size() != (size_t)probes.Count() * 6)
+        return;
+
+    // Whole rows of PROBES_PER_ROW probes, the last padded
+    const int rows = (probes.Count() + PROBES_PER_ROW - 1) / PROBES_PER_ROW;
+    std::vector<float> texels((size_t)rows * PROBES_PER_ROW * 6 * 4, 0.f);
+    for (size_t i = 0; i < probes.faces.size(); ++i) {
+        texels[i * 4 + 0] = probes.faces[i].x;
+        texels[i * 4 + 1] = probes.faces[i].y;
+        texels[i * 4 + 2] = probes.faces[i].z;
+    }
+    m_probeTex = rlLoadTexture(texels.data(), PROBES_PER_ROW * 6, rows, RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, 1);
+    if (m_probeTex == 0) {
+        TraceLog(LOG_WARNING, "LightingSystem: failed to create the light probe texture");
+        return;
+    }
+    m_probeOrigin  = probes.origin;
+    m_probeSpacing = probes.spacing;
+    m_probeCount   = { probes.countX, probes.countY, probes.countZ };
 }
 
 void LightingSystem::ApplyToModel(Model& model)
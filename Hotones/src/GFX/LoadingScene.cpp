@@ -1,4 +1,6 @@
 #include <GFX/LoadingScene.hpp>
+#include <GFX/SceneImporter.hpp>
+#include <Time/FrameClock.hpp>
 #include <raymath.h>
 
 namespace Hotones {
@@ -8,6 +10,12 @@ LoadingScene::LoadingScene(float durationSeconds, std::function<float()> progres
 {
 }
 
+void LoadingScene::Track(std::shared_ptr<SceneLoad> load, float budgetMs)
+{
+    m_load = std::move(load);
+    m_loadBudgetMs = budgetMs;
+}
+
 void LoadingScene::Init()
 {
     int screenWidth = GetScreenWidth();
@@ -23,9 +31,11 @@ void LoadingScene::Init()
 
 void LoadingScene::Update()
 {
-    float dt = GetFrameTime();
+    float dt = Time::FrameClock::Get().Delta();
     elapsed += dt;
 
+    if (m_load) m_load->Pump(m_loadBudgetMs);
+
     // Update speed via mouse wheel (optional)
     // float mouseMove = GetMouseWheelMove();
     // if ((int)mouseMove != 0) speed += 2.0f*mouseMove/9.0f;
@@ -56,8 +66,8 @@ void LoadingScene::Update()
     // // Toggle mode
     // if (IsKeyPressed(KEY_SPACE)) drawLines = !drawLines;
 
-    // Finish scene after duration
-    if (elapsed >= duration) MarkFinished();
+    // Finish scene after duration, and once a tracked load is over
+    if (elapsed >= duration && (!m_load || m_load->IsDone())) MarkFinished();
 }
 
 void LoadingScene::Draw()
@@ -89,9 +99,11 @@ void LoadingScene::Draw()
     // DrawText("", 10, 70, 20, RAYWHITE);
     DrawFPS(10, 10);
 
-    // Draw a simple progress indicator — prefer external progressCb if set
+    // Draw a simple progress indicator — prefer a tracked load, then progressCb
     float t = 0.0f;
-    if (m_progressCb) {
+    if (m_load) {
+        t = m_load->Progress();
+    } else if (m_progressCb) {
         t = m_progressCb();
     } else {
         t = elapsed / duration;
@@ -100,9 +112,9 @@ void LoadingScene::Draw()
     DrawRectangle(10, GetScreenHeight() - 30, (int)((GetScreenWidth()-20)*t), 16, GREEN);
     DrawRectangleLines(10, GetScreenHeight() - 30, GetScreenWidth()-20, 16, WHITE);
 
-    // If an error callback is provided and returns non-empty, show it here
-    if (m_errorCb) {
-        std::string err = m_errorCb();
+    // If a tracked load or the error callback reports an error, show it here
+    if (m_load || m_errorCb) {
+        std::string err = m_load ? m_load->Error() : m_errorCb();
         if (!err.empty()) {
             DrawTextEx(GetFontDefault(), "Error:", {10, 70}, 18, 0, RED);
             DrawText(err.c_str(), 10, 90, 16, RAYWHITE);
@@ -112,7 +124,8 @@ void LoadingScene::Draw()
 
 void LoadingScene::Unload()
 {
-    // nothing to free for now
+    // the load is the tracker's; just let go of it
+    m_load.reset();
 }
 
 } // namespace Hotones
@@ -1,5 +1,7 @@
 #include <GFX/MainMenuScene.hpp>
 #include <GFX/UIManager.hpp>
+#include <GFX/TextCache.hpp>
+#include <Input/Input.hpp>
 #include <PakRegistry.hpp>
 #include <raylib.h>
 #include <cstring>
@@ -10,6 +12,18 @@
 
 namespace Hotones {
 
+namespace {
+
+// The menus draw the same strings every frame: through the text run cache
+void DrawMenuText(const char* text, int x, int y, int fontSize, Color color) {
+    GFX::TextCache::Get().DrawText(text, x, y, fontSize, color);
+}
+int MeasureMenuText(const char* text, int fontSize) {
+    return GFX::TextCache::Get().MeasureText(text, fontSize);
+}
+
+} // namespace
+
 // ─── Constructor ──────────────────────────────────────────────────────────────
 MainMenuScene::MainMenuScene(Net::NetworkManager* net)
     : m_net(net)
@@ -33,7 +47,7 @@ void MainMenuScene::Init() {
 
     if (m_net) {
         m_net->OnServerInfo = [this](const std::string& host, uint16_t port,
-                                     uint8_t players, uint8_t maxPlayers,
+                                     uint16_t players, uint16_t maxPlayers,
                                      const char* pakName, const char* gameVersion,
                                      const char* pakVersion) {
             for (auto& s : m_servers) {
@@ -48,6 +62,17 @@ void MainMenuScene::Init() {
                     return;
                 }
             }
+            // Not listed yet: a server the master told us about
+            ServerEntry e;
+            e.host        = host;
+            e.port        = port;
+            e.playerCount = players;
+            e.maxPlayers  = maxPlayers;
+            std::memcpy(e.pakName, pakName, 32);
+            std::memcpy(e.gameVersion, gameVersion, 16);
+            std::memcpy(e.pakVersion, pakVersion, 16);
+            e.responded   = true;
+            m_servers.push_back(e);
         };
     }
 }
@@ -58,12 +83,23 @@ void MainMenuScene::Unload() {
 
 // ─── Pack helpers ─────────────────────────────────────────────────────────────
 void MainMenuScene::RefreshPacks() {
-    m_packs           = Assets::ScanPacksDir("./paks");
+    // Listed and probed in the background; PollPacks() picks them up
+    m_packScan        = std::make_unique<Assets::PackScan>("./paks");
+    m_packs.clear();
     m_selectedPack    = -1;
     m_selectedPakPath = "";
     m_packScroll      = 0;
 }
 
+void MainMenuScene::PollPacks() {
+    if (!m_packScan || !m_packScan->Poll(m_packs)) return;
+    // Entries keep their order as they fill in; find the selection again anyway
+    m_selectedPack = -1;
+    for (int i = 0; i < (int)m_packs.size(); ++i)
+        if (m_packs[i].fullPath == m_selectedPakPath) m_selectedPack = i;
+    if (m_packScan->Done()) m_packScan.reset();
+}
+
 bool MainMenuScene::MatchLocalPak(const char* pakName) {
     if (!pakName || !pakName[0]) return false;
     auto toLo = [](std::string s) {
@@ -74,7 +110,8 @@ bool MainMenuScene::MatchLocalPak(const char* pakName) {
     for (int i = 0; i < (int)m_packs.size(); ++i) {
         std::filesystem::path fp(m_packs[i].displayName);
         if (toLo(fp.stem().string()) == needle ||
-            toLo(m_packs[i].displayName) == needle) {
+            toLo(m_packs[i].displayName) == needle ||
+            (!m_packs[i].name.empty() && toLo(m_packs[i].name) == needle)) {
             m_selectedPakPath = m_packs[i].fullPath;
             return true;
         }
@@ -85,11 +122,15 @@ bool MainMenuScene::MatchLocalPak(const char* pakName) {
 // ─── Server helpers ───────────────────────────────────────────────────────────
 void MainMenuScene::PingAllServers() {
     if (!m_net) return;
+    std::vector<Net::ServerEndpoint> endpoints;
+    endpoints.reserve(m_servers.size());
     for (auto& s : m_servers) {
         s.responded = false;
         s.pinging   = true;
-        m_net->PingServer(s.host, s.port);
+        endpoints.push_back({ s.host, s.port });
     }
+    m_net->PingServers(endpoints);
+    if (!m_master.host.empty()) m_net->QueryMasterServer(m_master.host, m_master.port);
 }
 
 void MainMenuScene::AddServer(const char* host, uint16_t port) {
@@ -112,8 +153,9 @@ void MainMenuScene::RemoveSelectedServer() {
 // ─── Update ───────────────────────────────────────────────────────────────────
 void MainMenuScene::Update() {
     if (m_net) m_net->Update(); // drain ping results → OnServerInfo
+    PollPacks();
 
-    if (IsKeyPressed(KEY_ESCAPE) && m_state != State::Main) {
+    if (Input::IsKeyPressed(KEY_ESCAPE) && m_state != State::Main) {
         m_state          = State::Main;
         m_activeField    = -1;
         m_addActiveField = -1;
@@ -144,7 +186,7 @@ void MainMenuScene::Draw() {
     UI.GridBackground(sw, sh);
     UI.Title("Habenero", sw);
     UI.Label("alpha v0.1",
-             (sw - MeasureText("alpha v0.1", 16)) / 2,
+             (sw - MeasureMenuText("alpha v0.1", 16)) / 2,
              50 + UI.theme.fontSizeTitle + 4,
              16, UI.theme.textDim);
 
@@ -176,7 +218,7 @@ void MainMenuScene::DrawMain() {
     }
 
     const char* hint = "Tip: place .cup packs in ./paks/   |   --server flag for headless mode";
-    DrawText(hint, (sw - MeasureText(hint, 14)) / 2, sh - 28, 14, UI.theme.textDim);
+    DrawMenuText(hint, (sw - MeasureMenuText(hint, 14)) / 2, sh - 28, 14, UI.theme.textDim);
 }
 
 /// ─── Built-in games sub-screen ───────────────────────────────────────────────
@@ -229,7 +271,7 @@ void MainMenuScene::DrawServerBrowser() {
     auto& UI = GFX::UIManager::Get();
     UI.Panel(panel);
 
-    DrawText("SERVER BROWSER", (int)(panel.x + 16), (int)(panel.y + 12), 22, WHITE);
+    DrawMenuText("SERVER BROWSER", (int)(panel.x + 16), (int)(panel.y + 12), 22, WHITE);
 
     int hy = (int)(panel.y + 46);
     DrawLine((int)panel.x, hy + 20, (int)(panel.x + pw), hy + 20, {55, 45, 75, 255});
@@ -248,36 +290,36 @@ void MainMenuScene::DrawServerBrowser() {
         Rectangle rr = {panel.x + 4, (float)rowY, pw - 8, (float)(ROW_H - 2)};
         DrawRectangleRec(rr, sel ? UI.theme.selBg : (i % 2 == 0 ? UI.theme.rowAlt : UI.theme.bgPanel));
 
-        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) &&
-            CheckCollisionPointRec(GetMousePosition(), rr))
+        if (Input::IsMousePressed(MOUSE_BUTTON_LEFT) &&
+            CheckCollisionPointRec(Input::GetMousePos(), rr))
             m_selectedServer = i;
 
         char addr[80];
         snprintf(addr, sizeof(addr), "%s : %d", s.host.c_str(), (int)s.port);
-        DrawText(addr, (int)(panel.x + 10), rowY + 8, 15, sel ? WHITE : UI.theme.textBright);
+        DrawMenuText(addr, (int)(panel.x + 10), rowY + 8, 15, sel ? WHITE : UI.theme.textBright);
 
         if (s.pinging && !s.responded) {
-            DrawText("...", (int)(panel.x + 300), rowY + 8, 15, UI.theme.textDim);
+            DrawMenuText("...", (int)(panel.x + 300), rowY + 8, 15, UI.theme.textDim);
         } else if (s.responded) {
             char pl[16];
             snprintf(pl, sizeof(pl), "%d / %d", s.playerCount, s.maxPlayers);
-            DrawText(pl, (int)(panel.x + 300), rowY + 8, 15,
+            DrawMenuText(pl, (int)(panel.x + 300), rowY + 8, 15,
                      sel ? WHITE : UI.theme.textBright);
-            DrawText(s.pakName[0] ? s.pakName : "\xe2\x80\x94",
+            DrawMenuText(s.pakName[0] ? s.pakName : "\xe2\x80\x94",
                      (int)(panel.x + 400), rowY + 8, 15, UI.theme.accent);
         } else {
-            DrawText("?", (int)(panel.x + 300), rowY + 8, 15, UI.theme.textDim);
+            DrawMenuText("?", (int)(panel.x + 300), rowY + 8, 15, UI.theme.textDim);
         }
         rowY += ROW_H;
     }
 
     if (m_serverScroll > 0)
-        DrawText("^", (int)(panel.x + pw - 18), (int)(panel.y + 50), 14, UI.theme.textDim);
+        DrawMenuText("^", (int)(panel.x + pw - 18), (int)(panel.y + 50), 14, UI.theme.textDim);
     if ((int)m_servers.size() > m_serverScroll + MAX_VIS)
-        DrawText("v", (int)(panel.x + pw - 18), (int)(panel.y + ph - 110), 14, UI.theme.textDim);
+        DrawMenuText("v", (int)(panel.x + pw - 18), (int)(panel.y + ph - 110), 14, UI.theme.textDim);
 
-    float wheel = GetMouseWheelMove();
-    if (wheel != 0.f && CheckCollisionPointRec(GetMousePosition(), panel)) {
+    float wheel = Input::GetMouseWheel();
+    if (wheel != 0.f && CheckCollisionPointRec(Input::GetMousePos(), panel)) {
         m_serverScroll -= (int)wheel;
         int maxScroll = (int)m_servers.size() - MAX_VIS;
         m_serverScroll = std::max(0, m_serverScroll);
@@ -346,16 +388,16 @@ void MainMenuScene::DrawServerBrowser() {
             m_showAddServer  = false;
             m_addActiveField = -1;
         }
-        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) &&
-            !CheckCollisionPointRec(GetMousePosition(), ap) &&
-            !CheckCollisionPointRec(GetMousePosition(),
+        if (Input::IsMousePressed(MOUSE_BUTTON_LEFT) &&
+            !CheckCollisionPointRec(Input::GetMousePos(), ap) &&
+            !CheckCollisionPointRec(Input::GetMousePos(),
                                     {panel.x + 244, by, bw, bh}))
             m_showAddServer = false;
     }
 
     // Status message (temporary)
     if (!m_statusMessage.empty()) {
-        DrawText(m_statusMessage.c_str(), (int)(panel.x + 8), (int)(panel.y + ph - 60), 16, UI.theme.accent);
+        DrawMenuText(m_statusMessage.c_str(), (int)(panel.x + 8), (int)(panel.y + ph - 60), 16, UI.theme.accent);
     }
 }
 
@@ -366,7 +408,7 @@ void MainMenuScene::DrawHost() {
     Rectangle panel = {(sw - pw) * 0.5f, (sh - ph) * 0.5f + 20.f, pw, ph};
     auto& UI = GFX::UIManager::Get();
     UI.Panel(panel);
-    DrawText("HOST GAME", (int)(panel.x + 16), (int)(panel.y + 12), 22, WHITE);
+    DrawMenuText("HOST GAME", (int)(panel.x + 16), (int)(panel.y + 12), 22, WHITE);
 
     float fx = panel.x + 24, fw = pw - 48, fh = 38;
     float fy = panel.y + 54;
@@ -379,11 +421,11 @@ void MainMenuScene::DrawHost() {
     if (m_portField.Draw({fx + fw * 0.62f, fy, fw * 0.36f, fh}, m_activeField == 1))
         m_activeField = 1;
 
-    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+    if (Input::IsMousePressed(MOUSE_BUTTON_LEFT)) {
         Rectangle nr = {fx, fy, fw * 0.57f, fh};
         Rectangle pr = {fx + fw * 0.62f, fy, fw * 0.36f, fh};
-        if (!CheckCollisionPointRec(GetMousePosition(), nr) &&
-            !CheckCollisionPointRec(GetMousePosition(), pr))
+        if (!CheckCollisionPointRec(Input::GetMousePos(), nr) &&
+            !CheckCollisionPointRec(Input::GetMousePos(), pr))
             m_activeField = -1;
     }
 
@@ -397,8 +439,11 @@ void MainMenuScene::DrawHost() {
     DrawRectangleRec(listBg, {18, 15, 28, 255});
     DrawRectangleLinesEx(listBg, 1.f, {55, 45, 80, 255});
 
-    if (m_packs.empty()) {
-        DrawText("No packs found  \xe2\x80\x94  place .cup files or pack folders in  ./paks/",
+    if (m_packs.empty() && m_packScan) {
+        DrawMenuText("Scanning  ./paks/ ...",
+                 (int)(fx + 8), (int)(fy + listH * 0.5f - 8), 12, UI.theme.textDim);
+    } else if (m_packs.empty()) {
+        DrawMenuText("No packs found  \xe2\x80\x94  place .cup files or pack folders in  ./paks/",
                  (int)(fx + 8), (int)(fy + listH * 0.5f - 8), 12, UI.theme.textDim);
     } else {
         int rowY = (int)fy;
@@ -407,20 +452,25 @@ void MainMenuScene::DrawHost() {
             bool sel = (i == m_selectedPack);
             Rectangle rr = {fx + 2, (float)rowY, fw - 4, (float)(PACK_ROW_H - 2)};
             DrawRectangleRec(rr, sel ? UI.theme.selBg : (i % 2 == 0 ? UI.theme.rowAlt : UI.theme.bgPanel));
-            if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) &&
-                CheckCollisionPointRec(GetMousePosition(), rr)) {
+            if (Input::IsMousePressed(MOUSE_BUTTON_LEFT) &&
+                CheckCollisionPointRec(Input::GetMousePos(), rr)) {
                 m_selectedPack    = i;
                 m_selectedPakPath = m_packs[i].fullPath;
             }
             const char* icon = (m_packs[i].type == Assets::PackEntry::Type::ZipFile)
                                 ? "[zip] " : "[dir] ";
-            char buf[96];
-            snprintf(buf, sizeof(buf), "%s%s", icon, m_packs[i].displayName.c_str());
-            DrawText(buf, (int)(fx + 8), rowY + 7, 15, sel ? WHITE : UI.theme.textBright);
+            char buf[160];
+            const Assets::PackEntry& pe = m_packs[i];
+            if (pe.name.empty())
+                snprintf(buf, sizeof(buf), "%s%s", icon, pe.displayName.c_str());
+            else
+                snprintf(buf, sizeof(buf), "%s%s %s  (%s)", icon, pe.name.c_str(), pe.version.c_str(),
+                         pe.displayName.c_str());
+            DrawMenuText(buf, (int)(fx + 8), rowY + 7, 15, sel ? WHITE : UI.theme.textBright);
             rowY += PACK_ROW_H;
         }
-        float wheel = GetMouseWheelMove();
-        if (wheel != 0.f && CheckCollisionPointRec(GetMousePosition(), listBg)) {
+        float wheel = Input::GetMouseWheel();
+        if (wheel != 0.f && CheckCollisionPointRec(Input::GetMousePos(), listBg)) {
             m_packScroll -= (int)wheel;
             int maxScroll = (int)m_packs.size() - PACK_MAX_V;
             m_packScroll = std::max(0, m_packScroll);
@@ -0,0 +1,378 @@
+// MeshSimplify.cpp — quadric edge collapse and the on-disk LOD cache
+//
+// Collapses run in passes.  A pass ranks every half-edge u → w (u folds into
+// w and takes its position) by the error quadric of both ends evaluated at
+// w, then takes the cheapest that pass the manifold and flip checks, each
+// claiming u, w and u's neighbours so no two collapses in a pass touch the
+// same triangles.  The index list is rewritten between passes.
+//
+// LOD cache file (native byte order, checked on load):
+//
+//   LODCacheHeader                              32 bytes
+//   LODCacheLevel  levels[levelCount]           index count, error
+//   uint16_t       indices[...]                 every level's, in order
+
+#include <GFX/MeshSimplify.hpp>
+#include <Physics/BVHCache.hpp>
+#include <raymath.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+
+namespace Hotones::GFX {
+
+namespace {
+
+// Sum of squared distances to a set of planes, area weighted:
+// Q(p) = pᵀAp + 2b·p + c with A symmetric
+struct Quadric {
+    double aa = 0, ab = 0, ac = 0, bb = 0, bc = 0, cc = 0;   // A
+    double ad = 0, bd = 0, cd = 0;                           // b
+    double dd = 0;                                           // c
+    double w  = 0;                                           // total area
+
+    void AddPlane(Vector3 n, float d, double area) {
+        aa += area * n.x * n.x; ab += area * n.x * n.y; ac += area * n.x * n.z;
+        bb += area * n.y * n.y; bc += area * n.y * n.z; cc += area * n.z * n.z;
+        ad += area * n.x * d;   bd += area * n.y * d;   cd += area * n.z * d;
+        dd += area * d * d;
+        w  += area;
+    }
+    void Add(const Quadric& q) {
+        aa += q.aa; ab += q.ab; ac += q.ac; bb += q.bb; bc += q.bc; cc += q.cc;
+        ad += q.ad; bd += q.bd; cd += q.cd; dd += q.dd; w += q.w;
+    }
+    // Mean squared distance of `p` from the planes
+    double Error(Vector3 p) const {
+        const double x = p.x, y = p.y, z = p.z;
+        const double e = aa * x * x + bb * y * y + cc * z * z
+                       + 2.0 * (ab * x * y + ac * x * z + bc * y * z)
+                       + 2.0 * (ad * x + bd * y + cd * z) + dd;
+        return w > 0.0 ? std::max(e, 0.0) / w : 0.0;
+    }
+};
+
+struct Collapse {
+    int    from, to;
+    double cost;
+};
+
+inline Vector3 Position(const float* positions, int v) {
+    return { positions[v * 3], positions[v * 3 + 1], positions[v * 3 + 2] };
+}
+
+inline uint64_t EdgeKey(int a, int b) {
+    if (a > b) std::swap(a, b);
+    return ((uint64_t)(uint32_t)a << 32) | (uint32_t)b;
+}
+
+// See SimplifyMesh; `indices` is the starting mesh, rewritten in place.
+// Returns the largest error accepted (mesh units).
+float Simplify(const float* positions, int vertexCount, std::vector<unsigned short>& indices,
+               size_t targetIndexCount, float maxError)
+{
+    std::vector<Quadric> quadrics(vertexCount);
+    std::unordered_map<uint64_t, int> edgeUses;
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        const int     v[3] = { indices[t], indices[t + 1], indices[t + 2] };
+        const Vector3 p0 = Position(positions, v[0]);
+        const Vector3 n  = Vector3CrossProduct(Vector3Subtract(Position(positions, v[1]), p0),
+                                               Vector3Subtract(Position(positions, v[2]), p0));
+        const float len = Vector3Length(n);
+        if (len > 0.f) {
+            const Vector3 unit = Vector3Scale(n, 1.f / len);
+            for (int k = 0; k < 3; ++k)
+                quadrics[v[k]].AddPlane(unit, -Vector3DotProduct(unit, p0), 0.5 * len);
+        }
+        for (int k = 0; k < 3; ++k) ++edgeUses[EdgeKey(v[k], v[(k + 1) % 3])];
+    }
+    // Border and seam vertices stay where they are
+    std::vector<char> locked(vertexCount, 0);
+    for (const auto& [key, uses] : edgeUses) {
+        if (uses == 2) continue;
+        locked[key >> 32]          = 1;
+        locked[key & 0xffffffffu]  = 1;
+    }
+
+    const double maxCost = (double)maxError * maxError;
+    float        error   = 0.f;
+    std::vector<int>      offsets, fans, remap(vertexCount);
+    std::vector<char>     claimed(vertexCount);
+    std::vector<Collapse> candidates;
+    std::vector<int>      around, aroundTarget;
+
+    while (indices.size() > targetIndexCount) {
+        const int triCount = (int)indices.size() / 3;
+
+        // Triangles around each vertex
+        offsets.assign(vertexCount + 1, 0);
+        for (unsigned short v : indices) ++offsets[v + 1];
+        for (int v = 0; v < vertexCount; ++v) offsets[v + 1] += offsets[v];
+        fans.resize(indices.size());
+        {
+            std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < indices.size(); ++i) fans[fill[indices[i]]++] = (int)(i / 3);
+        }
+
+        candidates.clear();
+        for (int t = 0; t < triCount; ++t)
+            for (int k = 0; k < 3; ++k) {
+                const int a = indices[t * 3 + k], b = indices[t * 3 + (k + 1) % 3];
+                for (const auto& [u, w] : { std::pair{ a, b }, std::pair{ b, a } }) {
+                    if (locked[u]) continue;
+                    Quadric q = quadrics[u];
+                    q.Add(quadrics[w]);
+                    candidates.push_back({ u, w, q.Error(Position(positions, w)) });
+                }
+            }
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+        // The other vertices of `v`'s triangles
+        const auto neighbours = [&](int v, std::vector<int>& out) {
+            out.clear();
+            for (int i = offsets[v]; i < offsets[v + 1]; ++i)
+                for (int k = 0; k < 3; ++k) {
+                    const int n = indices[fans[i] * 3 + k];
+                    if (n != v && std::find(out.begin(), out.end(), n) == out.end()) out.push_back(n);
+                }
+        };
+        const auto allowed = [&](int u, int w) {
+            // Exactly two triangles on the edge, and only their far corners
+            // shared by both ends, or the collapse pinches the surface
+            neighbours(u, around);
+            neighbours(w, aroundTarget);
+            int shared = 0;
+            for (int n : around)
+                if (std::find(aroundTarget.begin(), aroundTarget.end(), n) != aroundTarget.end()) ++shared;
+            if (shared != 2) return false;
+
+            // No remaining triangle may turn over
+            const Vector3 to = Position(positions, w);
+            int onEdge = 0;
+            for (int i = offsets[u]; i < offsets[u + 1]; ++i) {
+                const unsigned short* tri = &indices[fans[i] * 3];
+                if (tri[0] == w || tri[1] == w || tri[2] == w) { ++onEdge; continue; }
+                Vector3 p[3], q[3];
+                for (int k = 0; k < 3; ++k) {
+                    p[k] = Position(positions, tri[k]);
+                    q[k] = tri[k] == u ? to : p[k];
+                }
+                const Vector3 before = Vector3CrossProduct(Vector3Subtract(p[1], p[0]), Vector3Subtract(p[2], p[0]));
+                const Vector3 after  = Vector3CrossProduct(Vector3Subtract(q[1], q[0]), Vector3Subtract(q[2], q[0]));
+                if (Vector3DotProduct(before, after) <= 0.25f * Vector3Length(before) * Vector3Length(after)) return false;
+            }
+            return onEdge == 2;
+        };
+
+        // Each collapse removes two triangles
+        const size_t wanted = (indices.size() - targetIndexCount + 5) / 6;
+        size_t       done   = 0;
+        for (int v = 0; v < vertexCount; ++v) remap[v] = v;
+        std::fill(claimed.begin(), claimed.end(), 0);
+        for (const Collapse& c : candidates) {
+            if (c.cost > maxCost || done == wanted) break;
+            if (claimed[c.from] || claimed[c.to] || !allowed(c.from, c.to)) continue;
+            remap[c.from] = c.to;
+            quadrics[c.to].Add(quadrics[c.from]);
+            claimed[c.from] = claimed[c.to] = 1;
+            neighbours(c.from, around);
+            for (int n : around) claimed[n] = 1;
+            error = std::max(error, (float)std::sqrt(c.cost));
+            ++done;
+        }
+        if (done == 0) break;
+
+        size_t out = 0;
+        for (size_t t = 0; t < indices.size(); t += 3) {
+            const unsigned short a = (unsigned short)remap[indices[t]];
+            const unsigned short b = (unsigned short)remap[indices[t + 1]];
+            const unsigned short c = (unsigned short)remap[indices[t + 2]];
+            if (a == b || b == c || a == c) continue;
+            indices[out++] = a;
+            indices[out++] = b;
+            indices[out++] = c;
+        }
+        indices.resize(out);
+    }
+    return error;
+}
+
+// ── Cache ───────────────────────────────────────────────────────────────────
+
+// Bump whenever Simplify() changes what it produces
+constexpr uint32_t LOD_CACHE_VERSION    = 1;
+constexpr uint32_t LOD_CACHE_BYTE_ORDER = 0x01020304u;
+constexpr char     LOD_CACHE_MAGIC[8]   = { 'H', 'O', 'L', 'O', 'D', '\0', '\0', '\0' };
+
+struct LODCacheHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t key;
+    uint32_t levelCount;
+    uint32_t vertexCount;   // of the source, bounding every index
+};
+static_assert(sizeof(LODCacheHeader) == 32, "LOD cache header layout");
+
+struct LODCacheLevel {
+    uint32_t indexCount;
+    float    error;
+};
+
+std::string CachePath(const std::string& dir, uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.lod", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(dir) / name).string();
+}
+
+uint64_t CacheKey(const Mesh& mesh, int levels, float reduction) {
+    uint64_t h = 14695981039346656037ull;
+    auto mix = [&](uint32_t w) { h = (h ^ w) * 1099511628211ull; };
+    auto mixFloat = [&](float f) {
+        uint32_t w;
+        std::memcpy(&w, &f, sizeof(w));
+        mix(w);
+    };
+    mix(LOD_CACHE_VERSION);
+    mix((uint32_t)levels);
+    mixFloat(reduction);
+    mix((uint32_t)mesh.vertexCount);
+    mix((uint32_t)mesh.triangleCount);
+    for (int i = 0; i < mesh.vertexCount * 3; ++i) mixFloat(mesh.vertices[i]);
+    for (int i = 0; i < mesh.triangleCount * 3; ++i) mix(mesh.indices[i]);
+    return h;
+}
+
+bool LoadLODCache(const std::string& dir, uint64_t key, const Mesh& mesh, std::vector<MeshLOD>& out) {
+    out.clear();
+    Physics::MappedFile file;
+    if (!file.Open(CachePath(dir, key)) || file.Size() < sizeof(LODCacheHeader)) return false;
+
+    LODCacheHeader hdr;
+    std::memcpy(&hdr, file.Data(), sizeof(hdr));
+    if (std::memcmp(hdr.magic, LOD_CACHE_MAGIC, sizeof(hdr.magic)) != 0 ||
+        hdr.version != LOD_CACHE_VERSION || hdr.byteOrder != LOD_CACHE_BYTE_ORDER ||
+        hdr.key != key || hdr.vertexCount != (uint32_t)mesh.vertexCount) return false;
+
+    const size_t sourceIndices = (size_t)mesh.triangleCount * 3;
+    size_t       offset        = sizeof(hdr) + (size_t)hdr.levelCount * sizeof(LODCacheLevel);
+    if (hdr.levelCount > 64 || offset > file.Size()) return false;
+    out.resize(hdr.levelCount);
+    for (uint32_t l = 0; l < hdr.levelCount; ++l) {
+        LODCacheLevel level;
+        std::memcpy(&level, file.Data() + sizeof(hdr) + l * sizeof(LODCacheLevel), sizeof(level));
+        const size_t bytes = (size_t)level.indexCount * sizeof(uint16_t);
+        if (level.indexCount % 3 != 0 || level.indexCount > sourceIndices || offset + bytes > file.Size()) {
+            out.clear();
+            return false;
+        }
+        out[l].indices.resize(level.indexCount);
+        out[l].error = level.error;
+        std::memcpy(out[l].indices.data(), file.Data() + offset, bytes);
+        offset += bytes;
+        for (unsigned short v : out[l].indices)
+            if (v >= mesh.vertexCount) {
+                out.clear();
+                return false;
+            }
+    }
+    if (offset != file.Size()) {
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
+bool StoreLODCache(const std::string& dir, uint64_t key, const Mesh& mesh, const std::vector<MeshLOD>& lods) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if (ec) return false;
+
+    LODCacheHeader hdr{};
+    std::memcpy(hdr.magic, LOD_CACHE_MAGIC, sizeof(hdr.magic));
+    hdr.version     = LOD_CACHE_VERSION;
+    hdr.byteOrder   = LOD_CACHE_BYTE_ORDER;
+    hdr.key         = key;
+    hdr.levelCount  = (uint32_t)lods.size();
+    hdr.vertexCount = (uint32_t)mesh.vertexCount;
+
+    // Unique per writer; see StoreBVHCache
+    const std::string finalPath = CachePath(dir, key);
+    const size_t salt = std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+                        static_cast<size_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    const std::string tmpPath = finalPath + "." + std::to_string(salt) + ".tmp";
+    {
+        std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!ofs) return false;
+        ofs.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        for (const MeshLOD& lod : lods) {
+            const LODCacheLevel level{ (uint32_t)lod.indices.size(), lod.error };
+            ofs.write(reinterpret_cast<const char*>(&level), sizeof(level));
+        }
+        for (const MeshLOD& lod : lods)
+            ofs.write(reinterpret_cast<const char*>(lod.indices.data()),
+                      static_cast<std::streamsize>(lod.indices.size() * sizeof(uint16_t)));
+        if (!ofs) {
+            ofs.close();
+            fs::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    fs::rename(tmpPath, finalPath, ec);
+    if (ec) {
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+std::vector<unsigned short> SimplifyMesh(const Mesh& mesh, int targetIndexCount,
+                                         float maxError, float* error)
+{
+    if (error) *error = 0.f;
+    if (mesh.indices == nullptr || mesh.vertices == nullptr || mesh.triangleCount <= 0) return {};
+    std::vector<unsigned short> indices(mesh.indices, mesh.indices + (size_t)mesh.triangleCount * 3);
+    const float e = Simplify(mesh.vertices, mesh.vertexCount, indices,
+                             (size_t)std::max(targetIndexCount, 0), maxError);
+    if (error) *error = e;
+    return indices;
+}
+
+std::vector<MeshLOD> BuildLODChain(const Mesh& mesh, int levels, float reduction,
+                                   const std::string& cacheDir)
+{
+    std::vector<MeshLOD> lods;
+    if (levels <= 0 || mesh.indices == nullptr || mesh.vertices == nullptr || mesh.triangleCount <= 0) return lods;
+    reduction = Clamp(reduction, 0.05f, 0.95f);
+
+    const uint64_t key = cacheDir.empty() ? 0 : CacheKey(mesh, levels, reduction);
+    if (!cacheDir.empty() && LoadLODCache(cacheDir, key, mesh, lods)) return lods;
+
+    // Each level starts from the one before; its error adds to theirs
+    std::vector<unsigned short> indices(mesh.indices, mesh.indices + (size_t)mesh.triangleCount * 3);
+    float error = 0.f;
+    for (int l = 0; l < levels; ++l) {
+        const size_t before = indices.size();
+        const size_t target = (size_t)(before / 3 * reduction) * 3;
+        error += Simplify(mesh.vertices, mesh.vertexCount, indices, target, INFINITY);
+        if (indices.empty() || indices.size() * 10 > before * 9) break;
+        lods.push_back({ indices, error });
+    }
+
+    if (!cacheDir.empty() && !StoreLODCache(cacheDir, key, mesh, lods))
+        TraceLog(LOG_WARNING, "MeshSimplify: could not write LOD cache to %s", cacheDir.c_str());
+    return lods;
+}
+
+} // namespace Hotones::GFX
@@ -0,0 +1,89 @@
+// MeshView.cpp — drawing some of an indexed mesh's triangles
+
+#include <GFX/MeshView.hpp>
+#include <raylib.h>
+#include <rlgl.h>
+#include <cstring>
+
+namespace Hotones::GFX {
+
+bool MeshView::Init(const Mesh& source)
+{
+    Unload();
+    if (source.indices == nullptr || source.vboId == nullptr || source.triangleCount <= 0) return false;
+
+    m_source = source.indices;
+    m_indices.assign((size_t)source.triangleCount * 3, 0);
+    m_mesh               = source;
+    m_mesh.indices       = m_indices.data();
+    m_mesh.triangleCount = 0;
+    m_mesh.vaoId         = rlLoadVertexArray();
+    if (m_mesh.vaoId == 0) return false;
+
+    // The attributes UploadMesh() gave the source, from the same buffers
+    rlEnableVertexArray(m_mesh.vaoId);
+    const auto attribute = [&](const void* data, unsigned int vbo, unsigned int location,
+                               int size, int type, bool normalized) {
+        if (data == nullptr || vbo == 0) return;
+        rlEnableVertexBuffer(vbo);
+        rlSetVertexAttribute(location, size, type, normalized, 0, 0);
+        rlEnableVertexAttribute(location);
+    };
+    attribute(source.vertices,   source.vboId[0], RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION,  3, RL_FLOAT, false);
+    attribute(source.texcoords,  source.vboId[1], RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD,  2, RL_FLOAT, false);
+    attribute(source.normals,    source.vboId[2], RL_DEFAULT_SHADER_ATTRIB_LOCATION_NORMAL,    3, RL_FLOAT, false);
+    attribute(source.colors,     source.vboId[3], RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR,     4, RL_UNSIGNED_BYTE, true);
+    attribute(source.tangents,   source.vboId[4], RL_DEFAULT_SHADER_ATTRIB_LOCATION_TANGENT,   4, RL_FLOAT, false);
+    attribute(source.texcoords2, source.vboId[5], RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD2, 2, RL_FLOAT, false);
+#if defined(RL_DEFAULT_SHADER_ATTRIB_NAME_BONEIDS)
+    attribute(source.boneIds,     source.vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_BONEIDS],
+              RL_DEFAULT_SHADER_ATTRIB_LOCATION_BONEIDS,     4, RL_UNSIGNED_BYTE, false);
+    attribute(source.boneWeights, source.vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_BONEWEIGHTS],
+              RL_DEFAULT_SHADER_ATTRIB_LOCATION_BONEWEIGHTS, 4, RL_FLOAT, false);
+#endif
+    m_ebo = rlLoadVertexBufferElement(m_indices.data(), (int)(m_indices.size() * sizeof(unsigned short)), true);
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+    return true;
+}
+
+void MeshView::Unload()
+{
+    if (m_mesh.vaoId != 0) rlUnloadVertexArray(m_mesh.vaoId);
+    if (m_ebo != 0) rlUnloadVertexBuffer(m_ebo);
+    m_mesh   = {};
+    m_ebo    = 0;
+    m_source = nullptr;
+    m_indices.clear();
+    m_count  = 0;
+}
+
+void MeshView::Add(int firstIndex, int count)
+{
+    if (firstIndex < 0 || count <= 0 || (size_t)firstIndex + count > m_indices.size()
+        || (size_t)m_count + count > m_indices.size())
+        return;
+    memcpy(m_indices.data() + m_count, m_source + firstIndex, (size_t)count * sizeof(unsigned short));
+    m_count += count;
+}
+
+void MeshView::Set(const unsigned short* indices, int count)
+{
+    m_count = 0;
+    if (indices == nullptr || count <= 0 || (size_t)count > m_indices.size()) return;
+    for (int i = 0; i < count; ++i)
+        if (indices[i] >= m_mesh.vertexCount) return;
+    memcpy(m_indices.data(), indices, (size_t)count * sizeof(unsigned short));
+    m_count = count;
+}
+
+void MeshView::Upload()
+{
+    m_mesh.triangleCount = m_count / 3;
+    if (m_ebo == 0 || m_count == 0) return;
+    // Not while some VAO is bound, or its element buffer would be replaced
+    rlDisableVertexArray();
+    rlUpdateVertexBufferElements(m_ebo, m_indices.data(), m_count * (int)sizeof(unsigned short), 0);
+}
+
+} // namespace Hotones::GFX
@@ -0,0 +1,147 @@
+// ModelRenderSystem.cpp — instanced drawing of RenderModelComponent entities
+
+#include <GFX/ModelRenderSystem.hpp>
+#include <GFX/LightingSystem.hpp>
+#include <GFX/OcclusionCulling.hpp>
+#include <ECS/Components.hpp>
+#include <raylib.h>
+#include <raymath.h>
+
+namespace Hotones::GFX {
+
+void ModelRenderSystem::Draw(ECS::Registry& reg)
+{
+    m_queue.Begin({ 0.f, 0.f, 0.f });
+    DrawCulled(reg, nullptr, nullptr, m_queue);
+    m_queue.Flush();
+}
+
+void ModelRenderSystem::Draw(ECS::Registry& reg, const Frustum& frustum)
+{
+    m_queue.Begin({ 0.f, 0.f, 0.f });
+    DrawCulled(reg, &frustum, nullptr, m_queue);
+    m_queue.Flush();
+}
+
+void ModelRenderSystem::Draw(ECS::Registry& reg, const Frustum& frustum, RenderQueue& queue,
+                             const OcclusionCuller* occlusion)
+{
+    DrawCulled(reg, &frustum, occlusion, queue);
+}
+
+const BoundingBox& ModelRenderSystem::LocalBounds(const Model& model)
+{
+    ModelBounds& b = m_bounds[model.meshes];
+    // The same address may since hold another model's meshes
+    if (b.vertices != model.meshes[0].vertices || b.meshCount != model.meshCount) {
+        b.vertices  = model.meshes[0].vertices;
+        b.meshCount = model.meshCount;
+        b.box       = GetMeshBoundingBox(model.meshes[0]);
+        for (int i = 1; i < model.meshCount; i++) {
+            const BoundingBox mb = GetMeshBoundingBox(model.meshes[i]);
+            b.box.min = Vector3Min(b.box.min, mb.min);
+            b.box.max = Vector3Max(b.box.max, mb.max);
+        }
+    }
+    return b.box;
+}
+
+void ModelRenderSystem::Capture(ECS::Registry& reg, std::vector<Instance>& out)
+{
+    reg.View<ECS::RenderModelComponent, ECS::TransformComponent>(
+        [&](ECS::EntityId, ECS::RenderModelComponent& rm, auto&& transform) {
+            if (!rm.visible || !rm.model || rm.model->meshCount <= 0) return;
+            // DrawModelEx order: the model's own transform first
+            out.push_back({ rm.model, MatrixMultiply(rm.model->transform, transform.ToMatrix()), rm.tint });
+        });
+}
+
+void ModelRenderSystem::Draw(const std::vector<Instance>& instances, const Frustum& frustum, RenderQueue& queue,
+                             const OcclusionCuller* occlusion)
+{
+    DrawEach([&](auto&& fn) {
+        for (const Instance& in : instances) fn(*in.model, in.world, in.tint);
+    }, &frustum, occlusion, queue);
+}
+
+void ModelRenderSystem::DrawCulled(ECS::Registry& reg, const Frustum* frustum, const OcclusionCuller* occlusion,
+                                   RenderQueue& queue)
+{
+    DrawEach([&](auto&& fn) {
+        reg.View<ECS::RenderModelComponent, ECS::TransformComponent>(
+            [&](ECS::EntityId, ECS::RenderModelComponent& rm, auto&& transform) {
+                if (!rm.visible || !rm.model || rm.model->meshCount <= 0) return;
+                // DrawModelEx order: the model's own transform first
+                fn(*rm.model, MatrixMultiply(rm.model->transform, transform.ToMatrix()), rm.tint);
+            });
+    }, frustum, occlusion, queue);
+}
+
+template<typename ForEach>
+void ModelRenderSystem::DrawEach(ForEach&& forEach, const Frustum* frustum, const OcclusionCuller* occlusion,
+                                 RenderQueue& queue)
+{
+    m_stats = {};
+    for (auto& [key, batch] : m_batches) batch.transforms.clear();
+
+    // ── Group this frame's meshes ─────────────────────────────────────────────
+    forEach([&](const Model& model, const Matrix& world, Color color) {
+        if (frustum || occlusion) {
+            const BoundingBox box = TransformBox(LocalBounds(model), world);
+            if (frustum && !frustum->Intersects(box)) {
+                m_stats.culled++;
+                return;
+            }
+            if (occlusion && !occlusion->IsVisible(box)) {
+                m_stats.occluded++;
+                return;
+            }
+        }
+        const uint32_t tint = (uint32_t)color.r << 24 | (uint32_t)color.g << 16
+                            | (uint32_t)color.b << 8  | (uint32_t)color.a;
+        for (int i = 0; i < model.meshCount; i++) {
+            const BatchKey key{ &model.meshes[i], &model.materials[model.meshMaterial[i]], tint };
+            Batch& batch = m_batches[key];
+            batch.tint = color;
+            batch.transforms.push_back(world);
+        }
+        m_stats.entities++;
+    });
+
+    // ── Submit ────────────────────────────────────────────────────────────────
+    for (auto it = m_batches.begin(); it != m_batches.end(); ) {
+        // A group nobody used this frame may point at an unloaded model
+        if (it->second.transforms.empty()) { it = m_batches.erase(it); continue; }
+        Submit(it->first, it->second, queue);
+        ++it;
+    }
+}
+
+void ModelRenderSystem::Submit(const BatchKey& key, Batch& batch, RenderQueue& queue)
+{
+    Material material = *key.material;
+
+    // Tint the diffuse colour as DrawModelEx does; the queue sets it per draw
+    const Color base = material.maps[MATERIAL_MAP_DIFFUSE].color;
+    const Color diffuse = {
+        (unsigned char)(((int)base.r * (int)batch.tint.r) / 255),
+        (unsigned char)(((int)base.g * (int)batch.tint.g) / 255),
+        (unsigned char)(((int)base.b * (int)batch.tint.b) / 255),
+        (unsigned char)(((int)base.a * (int)batch.tint.a) / 255),
+    };
+
+    const auto&  ls        = LightingSystem::Get();
+    const Shader instanced = ls.GetInstancedShader();
+    const int    count     = (int)batch.transforms.size();
+    if (count > 1 && instanced.id != 0 && material.shader.id == ls.GetShader().id) {
+        material.shader = instanced;
+        queue.SubmitInstanced(*key.mesh, material, diffuse, batch.transforms.data(), count);
+        m_stats.drawCalls++;
+        m_stats.instanced++;
+    } else {
+        for (const Matrix& m : batch.transforms) queue.Submit(*key.mesh, material, diffuse, m);
+        m_stats.drawCalls += count;
+    }
+}
+
+} // namespace Hotones::GFX
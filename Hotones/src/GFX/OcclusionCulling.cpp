@@ -0,0 +1,295 @@
+// OcclusionCulling.cpp — hierarchical-Z occlusion culling against last frame's occluders
+
+#include <GFX/OcclusionCulling.hpp>
+#include <GFX/ShaderCache.hpp>
+#include <raylib.h>
+#include <raymath.h>
+#include <rlgl.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// ─── Embedded GLSL ───────────────────────────────────────────────────────────
+
+static const char* kDepthVS = R"(
+#version 330
+in vec3 vertexPosition;
+uniform mat4 mvp;
+void main() { gl_Position = mvp * vec4(vertexPosition, 1.0); }
+)";
+
+static const char* kDepthInstancedVS = R"(
+#version 330
+in vec3 vertexPosition;
+in mat4 instanceTransform;
+uniform mat4 mvp;
+void main() { gl_Position = mvp * instanceTransform * vec4(vertexPosition, 1.0); }
+)";
+
+static const char* kDepthFS = R"(
+#version 330
+out vec4 finalColor;
+void main() { finalColor = vec4(1.0); }
+)";
+
+// One level down: each texel the farthest of the 2×2 under it
+static const char* kReduceFS = R"(
+#version 330
+uniform sampler2D texture0;
+out vec4 finalColor;
+void main() {
+    ivec2 p = ivec2(gl_FragCoord.xy) * 2;
+    float d = max(max(texelFetch(texture0, p, 0).r,               texelFetch(texture0, p + ivec2(1, 0), 0).r),
+                  max(texelFetch(texture0, p + ivec2(0, 1), 0).r, texelFetch(texture0, p + ivec2(1, 1), 0).r));
+    finalColor = vec4(d, 0.0, 0.0, 1.0);
+}
+)";
+
+namespace Hotones::GFX {
+
+namespace {
+    constexpr float DEPTH_BIAS = 0.01f;   // relative; covers depth-buffer precision far out
+
+    // The projection BeginMode3D(camera) uses (as Frustum::FromCamera)
+    Matrix ProjectionFor(const Camera& camera, float aspect) {
+        if (camera.projection == CAMERA_ORTHOGRAPHIC) {
+            const double top   = camera.fovy / 2.0;
+            const double right = top * aspect;
+            return MatrixOrtho(-right, right, -top, top, CULL_NEAR, CULL_FAR);
+        }
+        return MatrixPerspective(camera.fovy * DEG2RAD, aspect, CULL_NEAR, CULL_FAR);
+    }
+
+    // Window depth (0–1) → view depth
+    float Linearize(float d, bool ortho) {
+        if (ortho) return CULL_NEAR + d * (CULL_FAR - CULL_NEAR);
+        const float z = d * 2.f - 1.f;
+        return 2.f * CULL_NEAR * CULL_FAR / (CULL_FAR + CULL_NEAR - z * (CULL_FAR - CULL_NEAR));
+    }
+}
+
+bool OcclusionCuller::Init()
+{
+    if (m_ready) return true;
+
+    m_depthShader          = ShaderCache::Get().Load(kDepthVS, kDepthFS);
+    m_depthInstancedShader = ShaderCache::Get().Load(kDepthInstancedVS, kDepthFS);
+    m_reduceShader         = ShaderCache::Get().Load(nullptr, kReduceFS);
+
+    bool ok = m_depthShader.id != 0 && m_depthInstancedShader.id != 0 && m_reduceShader.id != 0;
+    if (ok) {
+        m_depthFbo     = rlLoadFramebuffer();
+        m_depthTexture = rlLoadTextureDepth(HIZ_WIDTH, HIZ_HEIGHT, false);
+        ok = m_depthFbo != 0 && m_depthTexture != 0;
+        if (ok) {
+            rlFramebufferAttach(m_depthFbo, m_depthTexture, RL_ATTACHMENT_DEPTH, RL_ATTACHMENT_TEXTURE2D, 0);
+            ok = rlFramebufferComplete(m_depthFbo);
+        }
+    }
+    for (int i = 0; ok && i < HIZ_GPU_LEVELS; i++) {
+        m_levelFbo[i]     = rlLoadFramebuffer();
+        m_levelTexture[i] = rlLoadTexture(nullptr, HIZ_WIDTH >> (i + 1), HIZ_HEIGHT >> (i + 1),
+                                          RL_PIXELFORMAT_UNCOMPRESSED_R32, 1);
+        ok = m_levelFbo[i] != 0 && m_levelTexture[i] != 0;
+        if (ok) {
+            rlFramebufferAttach(m_levelFbo[i], m_levelTexture[i], RL_ATTACHMENT_COLOR_CHANNEL0, RL_ATTACHMENT_TEXTURE2D, 0);
+            ok = rlFramebufferComplete(m_levelFbo[i]);
+        }
+    }
+    if (!ok) {
+        TraceLog(LOG_WARNING, "OcclusionCuller: failed to create Hi-Z targets; occlusion culling disabled");
+        m_ready = true;   // so Unload() releases what did load
+        Unload();
+        return false;
+    }
+    m_depthInstancedShader.locs[SHADER_LOC_MATRIX_MODEL] =
+        GetShaderLocationAttrib(m_depthInstancedShader, "instanceTransform");
+
+    // CPU levels, from the read-back one down to 1×1
+    m_levels.clear();
+    for (int w = HIZ_READBACK_WIDTH, h = HIZ_READBACK_HEIGHT; ; w = std::max(1, w / 2), h = std::max(1, h / 2)) {
+        m_levels.push_back({ w, h, std::vector<float>((size_t)w * h, 0.f) });
+        if (w == 1 && h == 1) break;
+    }
+
+    m_pending = m_valid = false;
+    m_ready   = true;
+    TraceLog(LOG_INFO, "OcclusionCuller: ready (%dx%d occluder depth, %d levels)",
+             HIZ_WIDTH, HIZ_HEIGHT, HIZ_GPU_LEVELS + (int)m_levels.size());
+    return true;
+}
+
+void OcclusionCuller::Unload()
+{
+    if (!m_ready) return;
+    if (m_depthShader.id != 0)          UnloadShader(m_depthShader);
+    if (m_depthInstancedShader.id != 0) UnloadShader(m_depthInstancedShader);
+    if (m_reduceShader.id != 0)         UnloadShader(m_reduceShader);
+    // Also deletes the attached depth texture, but not colour ones
+    if (m_depthFbo != 0) rlUnloadFramebuffer(m_depthFbo);
+    else if (m_depthTexture != 0) rlUnloadTexture(m_depthTexture);
+    for (int i = 0; i < HIZ_GPU_LEVELS; i++) {
+        if (m_levelFbo[i] != 0)     rlUnloadFramebuffer(m_levelFbo[i]);
+        if (m_levelTexture[i] != 0) rlUnloadTexture(m_levelTexture[i]);
+        m_levelFbo[i] = m_levelTexture[i] = 0;
+    }
+    m_depthShader = m_depthInstancedShader = m_reduceShader = {};
+    m_depthFbo = m_depthTexture = 0;
+    m_levels.clear();
+    m_pending = m_valid = false;
+    m_stats = {};
+    m_ready = false;
+}
+
+// ── Pyramid ──────────────────────────────────────────────────────────────────
+
+void OcclusionCuller::ReadBack()
+{
+    m_valid = false;
+    if (!m_pending) return;
+    m_pending = false;
+
+    float* pixels = (float*)rlReadTexturePixels(m_levelTexture[HIZ_GPU_LEVELS - 1],
+                                                HIZ_READBACK_WIDTH, HIZ_READBACK_HEIGHT,
+                                                RL_PIXELFORMAT_UNCOMPRESSED_R32);
+    if (!pixels) return;
+    Level& top = m_levels[0];
+    for (size_t i = 0; i < top.depth.size(); i++) top.depth[i] = Linearize(pixels[i], m_pendingOrtho);
+    RL_FREE(pixels);
+
+    for (size_t l = 1; l < m_levels.size(); l++) {
+        const Level& src = m_levels[l - 1];
+        Level&       dst = m_levels[l];
+        for (int y = 0; y < dst.height; y++) {
+            const int y0 = std::min(y * 2, src.height - 1), y1 = std::min(y * 2 + 1, src.height - 1);
+            for (int x = 0; x < dst.width; x++) {
+                const int x0 = std::min(x * 2, src.width - 1), x1 = std::min(x * 2 + 1, src.width - 1);
+                dst.depth[(size_t)y * dst.width + x] =
+                    std::max(std::max(src.depth[(size_t)y0 * src.width + x0], src.depth[(size_t)y0 * src.width + x1]),
+                             std::max(src.depth[(size_t)y1 * src.width + x0], src.depth[(size_t)y1 * src.width + x1]));
+            }
+        }
+    }
+    m_view  = m_pendingView;
+    m_proj  = m_pendingProj;
+    m_valid = true;
+}
+
+void OcclusionCuller::Reduce(unsigned int source, unsigned int fbo, int width, int height)
+{
+    const float w = (float)width, h = (float)height;
+    rlEnableFramebuffer(fbo);
+    rlViewport(0, 0, width, height);
+    rlSetMatrixProjection(MatrixOrtho(0.0, w, h, 0.0, -1.0, 1.0));
+    rlSetMatrixModelview(MatrixIdentity());
+    BeginShaderMode(m_reduceShader);
+    rlSetTexture(source);
+    rlBegin(RL_QUADS);
+        rlColor4ub(255, 255, 255, 255);
+        rlTexCoord2f(0.f, 0.f); rlVertex2f(0.f, 0.f);
+        rlTexCoord2f(0.f, 1.f); rlVertex2f(0.f, h);
+        rlTexCoord2f(1.f, 1.f); rlVertex2f(w, h);
+        rlTexCoord2f(1.f, 0.f); rlVertex2f(w, 0.f);
+    rlEnd();
+    rlSetTexture(0);
+    EndShaderMode();
+    rlDrawRenderBatchActive();
+}
+
+void OcclusionCuller::Render(const Camera& camera, float aspect, const DrawOccluders& occluders)
+{
+    if (!m_ready) return;
+    m_stats = {};
+    ReadBack();
+
+    const Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+    const Matrix proj = ProjectionFor(camera, aspect);
+    m_queue.Begin(camera.position);
+    if (occluders) occluders(Frustum::FromMatrix(MatrixMultiply(view, proj)), m_queue);
+    m_stats.occluders = (int)m_queue.Size();
+    if (m_queue.Size() == 0) return;   // nothing to hide behind next frame
+
+    const unsigned int target    = rlGetActiveFramebuffer();
+    const Matrix       savedProj = rlGetMatrixProjection();
+    const Matrix       savedView = rlGetMatrixModelview();
+    rlDrawRenderBatchActive();
+
+    // ── Occluder depth ───────────────────────────────────────────────────────
+    rlEnableFramebuffer(m_depthFbo);
+    rlViewport(0, 0, HIZ_WIDTH, HIZ_HEIGHT);
+    rlEnableDepthTest();
+    rlClearScreenBuffers();
+    rlSetMatrixModelview(view);
+    rlSetMatrixProjection(proj);
+    m_queue.Flush(m_depthShader, m_depthInstancedShader);
+    rlDrawRenderBatchActive();
+    rlDisableDepthTest();
+
+    // ── Max reductions, read back next frame ─────────────────────────────────
+    unsigned int source = m_depthTexture;
+    for (int i = 0; i < HIZ_GPU_LEVELS; i++) {
+        Reduce(source, m_levelFbo[i], HIZ_WIDTH >> (i + 1), HIZ_HEIGHT >> (i + 1));
+        source = m_levelTexture[i];
+    }
+
+    if (target != 0) rlEnableFramebuffer(target);
+    else             rlDisableFramebuffer();
+    rlViewport(0, 0, rlGetFramebufferWidth(), rlGetFramebufferHeight());
+    rlSetMatrixProjection(savedProj);
+    rlSetMatrixModelview(savedView);
+
+    m_pendingView  = view;
+    m_pendingProj  = proj;
+    m_pendingOrtho = camera.projection == CAMERA_ORTHOGRAPHIC;
+    m_pending      = true;
+}
+
+// ── Tests ────────────────────────────────────────────────────────────────────
+
+bool OcclusionCuller::IsVisible(const BoundingBox& box) const
+{
+    if (!m_valid) return true;
+    m_stats.tested++;
+
+    // The box's corners through last frame's camera: nearest view depth, and
+    // the rectangle they cover in read-back texels
+    const Level& top = m_levels[0];
+    float nearest = FLT_MAX;
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (int i = 0; i < 8; i++) {
+        const Vector3 p = { (i & 1) ? box.max.x : box.min.x,
+                            (i & 2) ? box.max.y : box.min.y,
+                            (i & 4) ? box.max.z : box.min.z };
+        const Vector3 v = Vector3Transform(p, m_view);
+        if (-v.z < CULL_NEAR) return true;   // reaches behind the near plane
+        nearest = std::min(nearest, -v.z);
+        const Matrix& m = m_proj;
+        const float cw = m.m3 * v.x + m.m7 * v.y + m.m11 * v.z + m.m15;
+        const float sx = ((m.m0 * v.x + m.m4 * v.y + m.m8 * v.z + m.m12) / cw * 0.5f + 0.5f) * top.width;
+        const float sy = ((m.m1 * v.x + m.m5 * v.y + m.m9 * v.z + m.m13) / cw * 0.5f + 0.5f) * top.height;
+        minX = std::min(minX, sx); maxX = std::max(maxX, sx);
+        minY = std::min(minY, sy); maxY = std::max(maxY, sy);
+    }
+
+    // Grown by an occluder-depth pixel: the pre-pass only covers pixels
+    // whose centres an occluder reaches
+    constexpr float pad = 1.f / (1 << HIZ_GPU_LEVELS);
+    const int x0 = std::max(0, (int)floorf(minX - pad)), x1 = std::min(top.width - 1,  (int)floorf(maxX + pad));
+    const int y0 = std::max(0, (int)floorf(minY - pad)), y1 = std::min(top.height - 1, (int)floorf(maxY + pad));
+    if (x0 > x1 || y0 > y1) return true;   // off last frame's screen
+
+    // The finest level where the rectangle spans at most 2×2 texels
+    size_t l = 0;
+    while (l + 1 < m_levels.size() && ((x1 >> l) - (x0 >> l) > 1 || (y1 >> l) - (y0 >> l) > 1)) l++;
+    const Level& level = m_levels[l];
+    float farthest = 0.f;
+    for (int y = std::min(y0 >> l, level.height - 1); y <= std::min(y1 >> l, level.height - 1); y++)
+        for (int x = std::min(x0 >> l, level.width - 1); x <= std::min(x1 >> l, level.width - 1); x++)
+            farthest = std::max(farthest, level.depth[(size_t)y * level.width + x]);
+
+    if (nearest <= farthest * (1.f + DEPTH_BIAS)) return true;
+    m_stats.occluded++;
+    return false;
+}
+
+} // namespace Hotones::GFX
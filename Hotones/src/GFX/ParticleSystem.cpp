@@ -0,0 +1,277 @@
+// ParticleSystem.cpp — SoA particle simulation, drawn as one quad batch per texture
+
+#include <GFX/ParticleSystem.hpp>
+#include <ECS/SimdKernels.hpp>
+#include <Jobs/JobSystem.hpp>
+#include <raymath.h>
+#include <rlgl.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Hotones::GFX {
+
+namespace {
+
+constexpr int QUADS_PER_BATCH = 256;  // checked against rlgl's batch at a time
+
+// splitmix64: seeds each emitter's stream
+uint64_t Mix(uint64_t v)
+{
+    v += 0x9e3779b97f4a7c15ull;
+    v = (v ^ (v >> 30)) * 0xbf58476d1ce4e5b9ull;
+    v = (v ^ (v >> 27)) * 0x94d049bb133111ebull;
+    return v ^ (v >> 31);
+}
+
+// xorshift64*, uniform in [0, 1)
+float Next(uint64_t& s)
+{
+    s ^= s >> 12; s ^= s << 25; s ^= s >> 27;
+    return (float)((s * 0x2545f4914f6cdd1dull) >> 40) * (1.0f / 16777216.0f);
+}
+
+unsigned char LerpByte(unsigned char a, unsigned char b, float t)
+{
+    return (unsigned char)((float)a + ((float)b - (float)a) * t + 0.5f);
+}
+
+unsigned int TextureId(const ECS::ParticleEmitterComponent& p)
+{
+    return p.texture && p.texture->id != 0 ? p.texture->id : rlGetTextureIdDefault();
+}
+
+} // namespace
+
+// ── Simulation ────────────────────────────────────────────────────────────────
+
+void ParticleSystem::Update(ECS::Registry& reg, float dt)
+{
+    ++m_tick;
+
+    // ── Gather ────────────────────────────────────────────────────────────────
+    m_active.clear();
+    reg.View<ECS::ParticleEmitterComponent, ECS::TransformComponent>(
+        [&](ECS::EntityId id, ECS::ParticleEmitterComponent& pe, auto&& tr) {
+            auto [it, added] = m_emitters.try_emplace(id);
+            Emitter& e = it->second;
+            if (added) e.rng = Mix(Mix((uint64_t)id) ^ m_tick) | 1;
+            e.seenTick = m_tick;
+            e.params   = pe;
+            e.origin   = tr.position;
+
+            float owed = pe.emitting && pe.rate > 0.0f ? e.carry + pe.rate * dt : 0.0f;
+            const float whole = std::floor(owed);
+            e.carry = owed - whole;
+            e.spawn = (uint32_t)whole + pe.burst;
+            pe.burst = 0;
+
+            if (e.spawn > 0 || e.Size() > 0) m_active.push_back(&e);
+        });
+
+    // Emitters removed, or whose entity is gone; their particles go with them
+    for (auto it = m_emitters.begin(); it != m_emitters.end();) {
+        if (it->second.seenTick == m_tick) { ++it; continue; }
+        it = m_emitters.erase(it);
+    }
+    if (m_active.empty()) return;
+
+    Jobs::JobSystem::Get().ParallelFor(m_active.size(), GRAIN,
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) Simulate(*m_active[i], dt);
+        });
+}
+
+void ParticleSystem::Simulate(Emitter& e, float dt)
+{
+    const size_t n = e.Size();
+    if (n > 0) {
+        const Vector3 g = e.params.gravity;
+        ECS::Simd::AddScalar(e.vx.data(), g.x * dt, n);
+        ECS::Simd::AddScalar(e.vy.data(), g.y * dt, n);
+        ECS::Simd::AddScalar(e.vz.data(), g.z * dt, n);
+        ECS::Simd::MulAdd(e.x.data(), e.vx.data(), dt, n);
+        ECS::Simd::MulAdd(e.y.data(), e.vy.data(), dt, n);
+        ECS::Simd::MulAdd(e.z.data(), e.vz.data(), dt, n);
+        ECS::Simd::AddScalar(e.remaining.data(), -dt, n);
+        Kill(e);
+    }
+    Spawn(e, dt);
+    Bound(e);
+}
+
+void ParticleSystem::Kill(Emitter& e)
+{
+    thread_local std::vector<uint32_t> dead;
+    dead.clear();
+    ECS::Simd::ForEachAtMost(e.remaining.data(), 0.0f, e.Size(), [&](size_t i) {
+        dead.push_back((uint32_t)i);
+    });
+    // Highest first, so the last particle swapped in is always a live one
+    for (auto it = dead.rbegin(); it != dead.rend(); ++it) {
+        const size_t i = *it, last = e.Size() - 1;
+        for (std::vector<float>* a : { &e.x, &e.y, &e.z, &e.vx, &e.vy, &e.vz, &e.remaining, &e.life }) {
+            (*a)[i] = (*a)[last];
+            a->pop_back();
+        }
+    }
+}
+
+void ParticleSystem::Spawn(Emitter& e, float dt)
+{
+    const ECS::ParticleEmitterComponent& p = e.params;
+    const size_t room  = p.maxParticles > e.Size() ? p.maxParticles - e.Size() : 0;
+    const size_t count = std::min<size_t>(e.spawn, room);
+    if (count == 0) return;
+
+    // Basis around the emission direction
+    Vector3 dir = Vector3Normalize(p.direction);
+    if (Vector3LengthSqr(dir) == 0.0f) dir = { 0.0f, 1.0f, 0.0f };
+    const Vector3 ref = fabsf(dir.y) < 0.99f ? Vector3{ 0.0f, 1.0f, 0.0f } : Vector3{ 1.0f, 0.0f, 0.0f };
+    const Vector3 t0  = Vector3Normalize(Vector3CrossProduct(ref, dir));
+    const Vector3 t1  = Vector3CrossProduct(dir, t0);
+    const float cosSpread = cosf(std::clamp(p.spread, 0.0f, PI));
+
+    for (size_t k = 0; k < count; ++k) {
+        // Uniform over the cone's cap
+        const float cosT = 1.0f - Next(e.rng) * (1.0f - cosSpread);
+        const float sinT = sqrtf(std::max(0.0f, 1.0f - cosT * cosT));
+        const float phi  = 2.0f * PI * Next(e.rng);
+        const Vector3 d  = Vector3Add(Vector3Scale(dir, cosT),
+                           Vector3Add(Vector3Scale(t0, sinT * cosf(phi)), Vector3Scale(t1, sinT * sinf(phi))));
+        const float speed = std::max(0.0f, p.speed + p.speedJitter * (2.0f * Next(e.rng) - 1.0f));
+        const float life  = std::max(1e-3f, p.lifetime + p.lifetimeJitter * (2.0f * Next(e.rng) - 1.0f));
+        const Vector3 v   = Vector3Scale(d, speed);
+
+        // Born at a random moment of this tick, so a stream doesn't clump
+        // into one puff per tick
+        const float age = dt * Next(e.rng);
+        e.x.push_back(e.origin.x + v.x * age);
+        e.y.push_back(e.origin.y + v.y * age);
+        e.z.push_back(e.origin.z + v.z * age);
+        e.vx.push_back(v.x);
+        e.vy.push_back(v.y);
+        e.vz.push_back(v.z);
+        e.remaining.push_back(life - age);
+        e.life.push_back(life);
+    }
+}
+
+void ParticleSystem::Bound(Emitter& e)
+{
+    const size_t n = e.Size();
+    if (n == 0) { e.bounds = { e.origin, e.origin }; return; }
+    Vector3 lo = { e.x[0], e.y[0], e.z[0] }, hi = lo;
+    for (size_t i = 1; i < n; ++i) {
+        lo.x = std::min(lo.x, e.x[i]); hi.x = std::max(hi.x, e.x[i]);
+        lo.y = std::min(lo.y, e.y[i]); hi.y = std::max(hi.y, e.y[i]);
+        lo.z = std::min(lo.z, e.z[i]); hi.z = std::max(hi.z, e.z[i]);
+    }
+    const float r = 0.5f * std::max(e.params.startSize, e.params.endSize);
+    e.bounds = { { lo.x - r, lo.y - r, lo.z - r }, { hi.x + r, hi.y + r, hi.z + r } };
+}
+
+size_t ParticleSystem::ParticleCount() const
+{
+    size_t n = 0;
+    for (const auto& [id, e] : m_emitters) n += e.Size();
+    return n;
+}
+
+// ── Drawing ───────────────────────────────────────────────────────────────────
+
+void ParticleSystem::Capture(Frame& out) const
+{
+    out.Clear();
+    for (const auto& [id, e] : m_emitters) {
+        const size_t n = e.Size();
+        if (n == 0) continue;
+        out.emitters.push_back({ e.params, e.bounds, out.x.size(), n });
+        out.x.insert(out.x.end(), e.x.begin(), e.x.end());
+        out.y.insert(out.y.end(), e.y.begin(), e.y.end());
+        out.z.insert(out.z.end(), e.z.begin(), e.z.end());
+        for (size_t i = 0; i < n; ++i)
+            out.t.push_back(std::clamp(1.0f - e.remaining[i] / e.life[i], 0.0f, 1.0f));
+    }
+}
+
+void ParticleSystem::Draw(const Camera& camera, const Frustum& frustum)
+{
+    Capture(m_frame);
+    Draw(m_frame, camera, frustum);
+}
+
+void ParticleSystem::Draw(const Frame& frame, const Camera& camera, const Frustum& frustum)
+{
+    m_stats = {};
+    m_draw.clear();
+    for (const Frame::Emitter& e : frame.emitters) {
+        if (!frustum.Intersects(e.bounds)) { m_stats.culled++; continue; }
+        m_draw.push_back(&e);
+    }
+    if (m_draw.empty()) return;
+
+    // One run per (texture, blend mode)
+    std::sort(m_draw.begin(), m_draw.end(), [](const Frame::Emitter* a, const Frame::Emitter* b) {
+        const unsigned int ta = TextureId(a->params), tb = TextureId(b->params);
+        return ta != tb ? ta < tb : a->params.additive < b->params.additive;
+    });
+
+    // Camera right and up, as DrawBillboard takes them from the view matrix
+    const Matrix  view  = MatrixLookAt(camera.position, camera.target, camera.up);
+    const Vector3 right = { view.m0, view.m4, view.m8 };
+    const Vector3 up    = { view.m1, view.m5, view.m9 };
+
+    rlDrawRenderBatchActive();
+    rlDisableDepthMask();
+
+    for (size_t k = 0; k < m_draw.size(); ) {
+        const unsigned int texture  = TextureId(m_draw[k]->params);
+        const bool         additive = m_draw[k]->params.additive;
+        size_t end = k + 1;
+        while (end < m_draw.size() && TextureId(m_draw[end]->params) == texture
+                                   && m_draw[end]->params.additive == additive) ++end;
+
+        if (additive) BeginBlendMode(BLEND_ADDITIVE);
+        bool begun = false;
+        int  room  = 0;   // quads left before the next batch-limit check
+        for (; k < end; ++k) {
+            const Frame::Emitter& e = *m_draw[k];
+            const ECS::ParticleEmitterComponent& p = e.params;
+            for (size_t i = e.first, last = e.first + e.count; i < last; ++i) {
+                if (room == 0) {
+                    if (begun) rlEnd();
+                    rlCheckRenderBatchLimit(4 * QUADS_PER_BATCH);
+                    rlSetTexture(texture);
+                    rlBegin(RL_QUADS);
+                    room  = QUADS_PER_BATCH;
+                    begun = true;
+                }
+                --room;
+
+                const float t    = frame.t[i];
+                const float half = 0.5f * (p.startSize + (p.endSize - p.startSize) * t);
+                const Vector3 r  = Vector3Scale(right, half), u = Vector3Scale(up, half);
+                const Vector3 o  = { frame.x[i], frame.y[i], frame.z[i] };
+
+                // Corners in DrawBillboardPro()'s order
+                rlColor4ub(LerpByte(p.startColor.r, p.endColor.r, t), LerpByte(p.startColor.g, p.endColor.g, t),
+                           LerpByte(p.startColor.b, p.endColor.b, t), LerpByte(p.startColor.a, p.endColor.a, t));
+                rlTexCoord2f(0.0f, 0.0f); rlVertex3f(o.x - r.x + u.x, o.y - r.y + u.y, o.z - r.z + u.z);
+                rlTexCoord2f(0.0f, 1.0f); rlVertex3f(o.x - r.x - u.x, o.y - r.y - u.y, o.z - r.z - u.z);
+                rlTexCoord2f(1.0f, 1.0f); rlVertex3f(o.x + r.x - u.x, o.y + r.y - u.y, o.z + r.z - u.z);
+                rlTexCoord2f(1.0f, 0.0f); rlVertex3f(o.x + r.x + u.x, o.y + r.y + u.y, o.z + r.z + u.z);
+            }
+            m_stats.emitters++;
+            m_stats.particles += (int)e.count;
+        }
+        if (begun) rlEnd();
+        if (additive) EndBlendMode();   // flushes the run with additive blending
+        m_stats.batches++;
+    }
+
+    rlDrawRenderBatchActive();
+    rlSetTexture(0);
+    rlEnableDepthMask();
+}
+
+} // namespace Hotones::GFX
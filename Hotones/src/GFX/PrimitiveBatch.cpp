@@ -0,0 +1,257 @@
+// PrimitiveBatch.cpp — cached unit primitives, instanced by shape and colour
+
+#include <GFX/PrimitiveBatch.hpp>
+#include <GFX/ShaderCache.hpp>
+#include <raylib.h>
+#include <raymath.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Hotones::GFX {
+
+// ─── Embedded GLSL — unlit instancing shader ─────────────────────────────────
+//
+// raylib's default shader for DrawMeshInstanced(): the model matrix arrives
+// per instance in instanceTransform, mvp holds view × projection only.
+
+static const char* kUnlitInstancedVS = R"(
+#version 330
+
+in vec3 vertexPosition;
+in vec4 vertexColor;
+in mat4 instanceTransform;
+
+uniform mat4 mvp;
+
+out vec4 fragColor;
+
+void main()
+{
+    fragColor   = vertexColor;
+    gl_Position = mvp * instanceTransform * vec4(vertexPosition, 1.0);
+}
+)";
+
+static const char* kUnlitInstancedFS = R"(
+#version 330
+
+in vec4 fragColor;
+
+uniform vec4 colDiffuse;
+
+out vec4 finalColor;
+
+void main()
+{
+    finalColor = fragColor * colDiffuse;
+}
+)";
+
+namespace {
+
+enum Shape : uint64_t { kBox = 1, kPlane = 2, kSphere = 3, kCylinder = 4 };
+
+constexpr int MIN_DETAIL = 3;     // below this par_shapes makes no sphere
+constexpr int MAX_DETAIL = 128;   // bounds how many unit meshes there can be
+constexpr int RADIUS_STEPS = 64;  // cylinder radius ratios kept
+
+inline uint64_t UnitKey(Shape shape, uint32_t a = 0, uint32_t b = 0) {
+    return ((uint64_t)shape << 48) | ((uint64_t)a << 24) | b;
+}
+
+// Scale by `s`, then move to `t`
+inline Matrix Place(Vector3 t, Vector3 s) {
+    return { s.x, 0.f, 0.f, t.x,
+             0.f, s.y, 0.f, t.y,
+             0.f, 0.f, s.z, t.z,
+             0.f, 0.f, 0.f, 1.f };
+}
+
+// Cylinder from y = 0 (radius `bottom`) to y = 1 (radius `top`), capped
+// where the radius is not 0, counter-clockwise from outside
+Mesh GenFrustum(float bottom, float top, int slices) {
+    const bool bottomCap = bottom > 0.f, topCap = top > 0.f;
+    const int  ring      = slices + 1;
+    Mesh m = {};
+    m.vertexCount   = ring * 2 + (bottomCap ? ring + 1 : 0) + (topCap ? ring + 1 : 0);
+    m.triangleCount = slices * 2 + (bottomCap ? slices : 0) + (topCap ? slices : 0);
+    m.vertices  = (float*)MemAlloc(m.vertexCount * 3 * sizeof(float));
+    m.normals   = (float*)MemAlloc(m.vertexCount * 3 * sizeof(float));
+    m.texcoords = (float*)MemAlloc(m.vertexCount * 2 * sizeof(float));
+    m.indices   = (unsigned short*)MemAlloc(m.triangleCount * 3 * sizeof(unsigned short));
+
+    int v = 0, ix = 0;
+    const auto vertex = [&](Vector3 p, Vector3 n, float u, float w) {
+        m.vertices[v*3+0]  = p.x; m.vertices[v*3+1] = p.y; m.vertices[v*3+2] = p.z;
+        m.normals[v*3+0]   = n.x; m.normals[v*3+1]  = n.y; m.normals[v*3+2]  = n.z;
+        m.texcoords[v*2+0] = u;   m.texcoords[v*2+1] = w;
+        return v++;
+    };
+    const auto triangle = [&](int a, int b, int c) {
+        m.indices[ix++] = (unsigned short)a;
+        m.indices[ix++] = (unsigned short)b;
+        m.indices[ix++] = (unsigned short)c;
+    };
+
+    // Side: the normal leans by the radius lost per unit of height
+    for (int i = 0; i <= slices; ++i) {
+        const float   a = 2.f * PI * i / slices, c = cosf(a), s = sinf(a);
+        const Vector3 n = Vector3Normalize({ c, bottom - top, s });
+        vertex({ bottom * c, 0.f, bottom * s }, n, (float)i / slices, 0.f);
+        vertex({ top * c,    1.f, top * s },    n, (float)i / slices, 1.f);
+    }
+    for (int i = 0; i < slices; ++i) {
+        const int b0 = i * 2, t0 = b0 + 1, b1 = b0 + 2, t1 = b0 + 3;
+        triangle(b0, t0, b1);
+        triangle(t0, t1, b1);
+    }
+
+    const auto cap = [&](float radius, float y, bool up) {
+        const int centre = vertex({ 0.f, y, 0.f }, { 0.f, up ? 1.f : -1.f, 0.f }, 0.5f, 0.5f);
+        for (int i = 0; i <= slices; ++i) {
+            const float a = 2.f * PI * i / slices, c = cosf(a), s = sinf(a);
+            vertex({ radius * c, y, radius * s }, { 0.f, up ? 1.f : -1.f, 0.f }, 0.5f + 0.5f * c, 0.5f + 0.5f * s);
+        }
+        for (int i = 0; i < slices; ++i) {
+            if (up) triangle(centre, centre + 2 + i, centre + 1 + i);
+            else    triangle(centre, centre + 1 + i, centre + 2 + i);
+        }
+    };
+    if (bottomCap) cap(bottom, 0.f, false);
+    if (topCap)    cap(top, 1.f, true);
+
+    UploadMesh(&m, false);
+    return m;
+}
+
+} // namespace
+
+bool PrimitiveBatch::Init()
+{
+    if (m_ready) return true;
+    m_material = LoadMaterialDefault();
+
+    // Instancing is optional: without it every primitive is its own call
+    m_instancedShader = ShaderCache::Get().Load(kUnlitInstancedVS, kUnlitInstancedFS);
+    if (m_instancedShader.id != 0) {
+        m_instancedShader.locs[SHADER_LOC_MATRIX_MODEL] =
+            GetShaderLocationAttrib(m_instancedShader, "instanceTransform");
+    } else {
+        TraceLog(LOG_WARNING, "PrimitiveBatch: failed to compile instancing shader");
+    }
+    m_instancedMaterial        = m_material;
+    m_instancedMaterial.shader = m_instancedShader;
+
+    m_ready = true;
+    return true;
+}
+
+void PrimitiveBatch::Unload()
+{
+    if (!m_ready) return;
+    for (Mesh& mesh : m_units) UnloadMesh(mesh);
+    m_units.clear();
+    m_unitIndex.clear();
+    m_batches.clear();
+    if (m_instancedShader.id != 0) UnloadShader(m_instancedShader);
+    UnloadMaterial(m_material);   // shares its maps with m_instancedMaterial
+    m_material = m_instancedMaterial = {};
+    m_instancedShader = {};
+    m_queue.Begin({ 0.f, 0.f, 0.f });
+    m_ready = false;
+}
+
+uint32_t PrimitiveBatch::Unit(uint64_t key)
+{
+    const auto it = m_unitIndex.find(key);
+    if (it != m_unitIndex.end()) return it->second;
+
+    const uint32_t a = (uint32_t)(key >> 24) & 0xFFFFFFu, b = (uint32_t)key & 0xFFFFFFu;
+    Mesh mesh = {};
+    switch ((Shape)(key >> 48)) {
+        case kBox:      mesh = GenMeshCube(1.f, 1.f, 1.f);            break;
+        case kPlane:    mesh = GenMeshPlane(1.f, 1.f, 1, 1);          break;
+        case kSphere:   mesh = GenMeshSphere(1.f, (int)a, (int)b);    break;
+        case kCylinder: mesh = GenFrustum((float)(b >> 8) / RADIUS_STEPS,
+                                          (float)(b & 0xFF) / RADIUS_STEPS, (int)a);
+                        break;
+    }
+    const uint32_t index = (uint32_t)m_units.size();
+    m_units.push_back(mesh);
+    m_unitIndex.emplace(key, index);
+    return index;
+}
+
+void PrimitiveBatch::Add(uint64_t unitKey, const Matrix& transform, Color color)
+{
+    if (!m_ready) return;
+    const uint32_t unit = Unit(unitKey);
+    const uint64_t key  = ((uint64_t)unit << 32) | ((uint64_t)color.r << 24) | ((uint64_t)color.g << 16)
+                        | ((uint64_t)color.b << 8) | color.a;
+    Batch& batch = m_batches[key];
+    batch.unit  = unit;
+    batch.color = color;
+    batch.transforms.push_back(transform);
+}
+
+void PrimitiveBatch::Box(Vector3 centre, Vector3 size, Color color)
+{
+    Add(UnitKey(kBox), Place(centre, size), color);
+}
+
+void PrimitiveBatch::Plane(Vector3 centre, Vector2 size, Color color)
+{
+    Add(UnitKey(kPlane), Place(centre, { size.x, 1.f, size.y }), color);
+}
+
+void PrimitiveBatch::Sphere(Vector3 centre, float radius, int rings, int slices, Color color)
+{
+    rings  = std::clamp(rings,  MIN_DETAIL, MAX_DETAIL);
+    slices = std::clamp(slices, MIN_DETAIL, MAX_DETAIL);
+    Add(UnitKey(kSphere, (uint32_t)rings, (uint32_t)slices), Place(centre, { radius, radius, radius }), color);
+}
+
+void PrimitiveBatch::Cylinder(Vector3 base, float radiusTop, float radiusBottom, float height,
+                              int slices, Color color)
+{
+    const float widest = std::max(radiusTop, radiusBottom);
+    if (widest <= 0.f) return;
+    slices = std::clamp(slices, MIN_DETAIL, MAX_DETAIL);
+    const uint32_t bottom = (uint32_t)lroundf(std::max(radiusBottom, 0.f) / widest * RADIUS_STEPS);
+    const uint32_t top    = (uint32_t)lroundf(std::max(radiusTop,    0.f) / widest * RADIUS_STEPS);
+    Add(UnitKey(kCylinder, (uint32_t)slices, (bottom << 8) | top), Place(base, { widest, height, widest }), color);
+}
+
+void PrimitiveBatch::Flush(Vector3 viewPos)
+{
+    m_stats = {};
+    if (!m_ready) return;
+
+    m_queue.Begin(viewPos);
+    for (auto it = m_batches.begin(); it != m_batches.end();) {
+        Batch& batch = it->second;
+        // Not drawn since the last Flush(): forget it, so changing colours
+        // don't pile up batches
+        if (batch.transforms.empty()) {
+            it = m_batches.erase(it);
+            continue;
+        }
+        const Mesh& mesh  = m_units[batch.unit];
+        const int   count = (int)batch.transforms.size();
+        m_stats.primitives += count;
+        if (count > 1 && batch.color.a == 255 && m_instancedShader.id != 0) {
+            m_queue.SubmitInstanced(mesh, m_instancedMaterial, batch.color,
+                                    batch.transforms.data(), count, RenderPass::Opaque);
+            m_stats.instanced++;
+        } else {
+            for (const Matrix& transform : batch.transforms)
+                m_queue.Submit(mesh, m_material, batch.color, transform);
+        }
+        batch.transforms.clear();
+        ++it;
+    }
+    m_queue.Flush();
+    m_stats.draws = m_queue.GetStats().draws;
+}
+
+} // namespace Hotones::GFX
@@ -0,0 +1,175 @@
+// RenderQueue.cpp — sorted submission of a frame's mesh draws
+
+#include <GFX/RenderQueue.hpp>
+#include <raylib.h>
+#include <raymath.h>
+#include <cstring>
+
+namespace Hotones::GFX {
+
+namespace {
+    constexpr uint32_t SHADER_BITS   = 10;
+    constexpr uint32_t MATERIAL_BITS = 14;
+    constexpr uint32_t TEXTURE_BITS  = 12;
+    constexpr uint32_t DEPTH_BITS    = 26;
+    constexpr uint32_t STATE_BITS    = SHADER_BITS + MATERIAL_BITS + TEXTURE_BITS;
+    static_assert(2 + STATE_BITS + DEPTH_BITS == 64, "RenderQueue key must fill 64 bits");
+
+    // A non-negative float's bits order like the float; keep the top ones
+    uint32_t DepthBits(float distSq) {
+        uint32_t bits;
+        std::memcpy(&bits, &distSq, sizeof(bits));
+        return bits >> (32 - DEPTH_BITS);
+    }
+}
+
+void RenderQueue::Begin(Vector3 viewPos)
+{
+    m_viewPos = viewPos;
+    m_items.clear();
+    m_matrices.clear();
+    m_keys.clear();
+    m_shaderRanks.clear();
+    m_materialRanks.clear();
+    m_textureRanks.clear();
+}
+
+void RenderQueue::Submit(const Mesh& mesh, const Material& material, const Matrix& transform, RenderPass pass)
+{
+    Push(mesh, material, material.maps[MATERIAL_MAP_DIFFUSE].color, &transform, 1, false, pass);
+}
+
+void RenderQueue::Submit(const Mesh& mesh, const Material& material, Color diffuse,
+                         const Matrix& transform, RenderPass pass)
+{
+    Push(mesh, material, diffuse, &transform, 1, false, pass);
+}
+
+void RenderQueue::SubmitInstanced(const Mesh& mesh, const Material& material, Color diffuse,
+                                  const Matrix* transforms, int count, RenderPass pass)
+{
+    if (count <= 0) return;
+    Push(mesh, material, diffuse, transforms, count, true, pass);
+}
+
+void RenderQueue::Push(const Mesh& mesh, const Material& material, Color diffuse,
+                       const Matrix* transforms, int count, bool instanced, RenderPass pass)
+{
+    if (pass == RenderPass::Auto)
+        pass = diffuse.a < 255 ? RenderPass::Transparent : RenderPass::Opaque;
+
+    Item item;
+    item.mesh      = &mesh;
+    item.material  = material;
+    item.diffuse   = diffuse;
+    item.first     = (uint32_t)m_matrices.size();
+    item.count     = count;
+    item.instanced = instanced;
+    m_matrices.insert(m_matrices.end(), transforms, transforms + count);
+    m_items.push_back(item);
+    m_keys.push_back(MakeKey(material, pass, transforms[0]));
+}
+
+uint32_t RenderQueue::Rank(std::unordered_map<uintptr_t, uint32_t>& ranks, uintptr_t id, uint32_t bits)
+{
+    const uint32_t max = (1u << bits) - 1;
+    auto [it, added] = ranks.try_emplace(id, (uint32_t)ranks.size());
+    // Past the field's range everything shares the last rank
+    return it->second < max ? it->second : max;
+}
+
+uint64_t RenderQueue::MakeKey(const Material& material, RenderPass pass, const Matrix& transform)
+{
+    const uint64_t shader   = Rank(m_shaderRanks,   material.shader.id, SHADER_BITS);
+    const uint64_t mat      = Rank(m_materialRanks, (uintptr_t)material.maps, MATERIAL_BITS);
+    const uint64_t texture  = Rank(m_textureRanks,  material.maps ? material.maps[MATERIAL_MAP_DIFFUSE].texture.id : 0,
+                                   TEXTURE_BITS);
+    const uint64_t state    = shader << (MATERIAL_BITS + TEXTURE_BITS) | mat << TEXTURE_BITS | texture;
+
+    const Vector3  pos      = { transform.m12, transform.m13, transform.m14 };
+    const uint64_t depth    = DepthBits(Vector3DistanceSqr(pos, m_viewPos));
+
+    if (pass == RenderPass::Transparent) {
+        const uint64_t farFirst = ((1ull << DEPTH_BITS) - 1) - depth;
+        return 1ull << 62 | farFirst << STATE_BITS | state;
+    }
+    return (uint64_t)pass << 62 | state << DEPTH_BITS | depth;
+}
+
+void RenderQueue::SortKeys()
+{
+    const size_t n = m_keys.size();
+    m_order.resize(n);
+    for (size_t i = 0; i < n; i++) m_order[i] = (uint32_t)i;
+    m_keyScratch.resize(n);
+    m_orderScratch.resize(n);
+
+    // Bits that differ between any two keys; digits outside them are skipped
+    uint64_t varying = 0;
+    for (size_t i = 1; i < n; i++) varying |= m_keys[i] ^ m_keys[0];
+
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (((varying >> shift) & 0xFF) == 0) continue;
+        size_t count[257] = {};
+        for (size_t i = 0; i < n; i++) count[((m_keys[i] >> shift) & 0xFF) + 1]++;
+        for (int d = 0; d < 256; d++) count[d + 1] += count[d];
+        for (size_t i = 0; i < n; i++) {
+            const size_t at = count[(m_keys[i] >> shift) & 0xFF]++;
+            m_keyScratch[at]   = m_keys[i];
+            m_orderScratch[at] = m_order[i];
+        }
+        m_keys.swap(m_keyScratch);
+        m_order.swap(m_orderScratch);
+    }
+}
+
+void RenderQueue::Flush()
+{
+    Draw(nullptr, nullptr);
+}
+
+void RenderQueue::Flush(const Shader& shader, const Shader& instancedShader)
+{
+    Draw(&shader, &instancedShader);
+}
+
+void RenderQueue::Draw(const Shader* shader, const Shader* instancedShader)
+{
+    m_stats = {};
+    if (m_items.empty()) return;
+    SortKeys();
+
+    unsigned int bound   = 0;
+    unsigned int texture = 0;
+    bool         first   = true;
+    for (uint32_t index : m_order) {
+        Item& item = m_items[index];
+        if (shader) item.material.shader = item.instanced ? *instancedShader : *shader;
+        const unsigned int tex = item.material.maps ? item.material.maps[MATERIAL_MAP_DIFFUSE].texture.id : 0;
+        if (first || item.material.shader.id != bound) m_stats.shaderChanges++;
+        if (first || tex != texture)                    m_stats.textureChanges++;
+        bound   = item.material.shader.id;
+        texture = tex;
+        first   = false;
+
+        // The colour lives in the shared maps array: set it for this draw only
+        Color& diffuse = item.material.maps[MATERIAL_MAP_DIFFUSE].color;
+        const Color saved = diffuse;
+        diffuse = item.diffuse;
+        if (item.instanced) {
+            DrawMeshInstanced(*item.mesh, item.material, &m_matrices[item.first], item.count);
+            m_stats.draws++;
+        } else {
+            for (int i = 0; i < item.count; i++)
+                DrawMesh(*item.mesh, item.material, m_matrices[item.first + i]);
+            m_stats.draws += item.count;
+        }
+        diffuse = saved;
+    }
+
+    m_items.clear();
+    m_matrices.clear();
+    m_keys.clear();
+}
+
+} // namespace Hotones::GFX
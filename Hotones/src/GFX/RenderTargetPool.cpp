@@ -0,0 +1,124 @@
+// RenderTargetPool.cpp — reusable offscreen framebuffers
+
+#include <GFX/RenderTargetPool.hpp>
+#include <rlgl.h>
+#include <algorithm>
+
+namespace Hotones::GFX {
+
+namespace {
+
+// LoadRenderTexture() with a chosen colour format
+RenderTexture2D LoadTarget(int width, int height, PixelFormat format)
+{
+    RenderTexture2D target = {};
+    target.id = rlLoadFramebuffer();
+    if (target.id == 0) return target;
+
+    rlEnableFramebuffer(target.id);
+    target.texture.id      = rlLoadTexture(nullptr, width, height, format, 1);
+    target.texture.width   = width;
+    target.texture.height  = height;
+    target.texture.format  = format;
+    target.texture.mipmaps = 1;
+    target.depth.id        = rlLoadTextureDepth(width, height, true);
+    target.depth.width     = width;
+    target.depth.height    = height;
+    target.depth.format    = 19;   // what raylib records for depth renderbuffers
+    target.depth.mipmaps   = 1;
+    rlFramebufferAttach(target.id, target.texture.id, RL_ATTACHMENT_COLOR_CHANNEL0, RL_ATTACHMENT_TEXTURE2D, 0);
+    rlFramebufferAttach(target.id, target.depth.id, RL_ATTACHMENT_DEPTH, RL_ATTACHMENT_RENDERBUFFER, 0);
+    const bool complete = rlFramebufferComplete(target.id);
+    rlDisableFramebuffer();
+
+    if (!complete) {
+        TraceLog(LOG_WARNING, "RenderTargetPool: %dx%d target (format %d) is incomplete", width, height, (int)format);
+        UnloadRenderTexture(target);
+        return {};
+    }
+    return target;
+}
+
+bool Matches(const RenderTexture2D& target, int width, int height, PixelFormat format)
+{
+    return target.texture.width == width && target.texture.height == height && target.texture.format == format;
+}
+
+} // namespace
+
+RenderTargetPool& RenderTargetPool::Get()
+{
+    static RenderTargetPool s_instance;
+    return s_instance;
+}
+
+RenderTexture2D RenderTargetPool::Acquire(int width, int height, PixelFormat format)
+{
+    if (width <= 0 || height <= 0) return {};
+
+    // Most recently released first: likeliest to still be resident
+    for (auto it = m_free.rbegin(); it != m_free.rend(); ++it) {
+        if (!Matches(*it, width, height, format)) continue;
+        const RenderTexture2D target = *it;
+        m_free.erase(std::next(it).base());
+        m_live.insert(target.id);
+        m_stats.reused++;
+        return target;
+    }
+
+    const RenderTexture2D target = LoadTarget(width, height, format);
+    if (target.id != 0) {
+        m_live.insert(target.id);
+        m_stats.created++;
+    }
+    return target;
+}
+
+void RenderTargetPool::Release(RenderTexture2D& target)
+{
+    if (target.id == 0) return;
+    const RenderTexture2D released = target;
+    target = {};
+    if (!IsWindowReady()) return;   // the context, and with it the target, is gone
+
+    if (m_live.erase(released.id) == 0) {
+        UnloadRenderTexture(released);
+        return;
+    }
+    m_free.push_back(released);
+    if ((int)m_free.size() > MAX_FREE_TARGETS) {
+        UnloadRenderTexture(m_free.front());
+        m_free.erase(m_free.begin());
+    }
+}
+
+void RenderTargetPool::Reserve(int width, int height, int count, PixelFormat format)
+{
+    count = std::min(count, MAX_FREE_TARGETS);
+    int have = 0;
+    for (const RenderTexture2D& target : m_free)
+        if (Matches(target, width, height, format)) have++;
+    for (; have < count; ++have) {
+        RenderTexture2D target = LoadTarget(width, height, format);
+        if (target.id == 0) break;
+        m_live.insert(target.id);
+        m_stats.created++;
+        Release(target);
+    }
+}
+
+void RenderTargetPool::Clear()
+{
+    for (const RenderTexture2D& target : m_free) UnloadRenderTexture(target);
+    m_free.clear();
+}
+
+RenderTargetPool::Stats RenderTargetPool::GetStats() const
+{
+    Stats stats = m_stats;
+    stats.live  = (int)m_live.size();
+    stats.free  = (int)m_free.size();
+    return stats;
+}
+
+} // namespace Hotones::GFX
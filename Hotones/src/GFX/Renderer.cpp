@@ -1,21 +1,29 @@
 #include "../include/GFX/Renderer.hpp"
+#include "../include/GFX/TextCache.hpp"
+#include "../include/GFX/DrawList.hpp"
 #include <raylib.h>
 
 namespace Hotones::GFX {
 
 void Renderer::ClearScreen(int r, int g, int b, int a)
 {
-    ClearBackground(Color{(unsigned char)r, (unsigned char)g, (unsigned char)b, (unsigned char)a});
+    const Color color{(unsigned char)r, (unsigned char)g, (unsigned char)b, (unsigned char)a};
+    if (DrawList* list = DrawList::Recording()) { list->ClearScreen(color); return; }
+    ClearBackground(color);
 }
 
 void Renderer::DrawText(const std::string &text, int x, int y, int fontSize, int r, int g, int b, int a)
 {
-    DrawTextEx(GetFontDefault(), text.c_str(), Vector2{(float)x, (float)y}, (float)fontSize, 0.0f, Color{(unsigned char)r, (unsigned char)g, (unsigned char)b, (unsigned char)a});
+    const Color color{(unsigned char)r, (unsigned char)g, (unsigned char)b, (unsigned char)a};
+    if (DrawList* list = DrawList::Recording()) { list->Text(text, x, y, fontSize, color); return; }
+    TextCache::Get().DrawTextEx(GetFontDefault(), text, Vector2{(float)x, (float)y}, (float)fontSize, 0.0f, color);
 }
 
 void Renderer::DrawRect(int x, int y, int w, int h, int r, int g, int b, int a)
 {
-    DrawRectangle(x, y, w, h, Color{(unsigned char)r, (unsigned char)g, (unsigned char)b, (unsigned char)a});
+    const Color color{(unsigned char)r, (unsigned char)g, (unsigned char)b, (unsigned char)a};
+    if (DrawList* list = DrawList::Recording()) { list->Rect(x, y, w, h, color); return; }
+    DrawRectangle(x, y, w, h, color);
 }
 
 } // namespace Hotones::GFX
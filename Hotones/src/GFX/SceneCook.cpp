@@ -0,0 +1,544 @@
+// SceneCook.cpp — binary form of an imported scene
+//
+// Cooked scene file (native byte order, checked on load).  Arrays start on
+// 8-byte boundaries from the start of the file, so a mapping of it can be
+// read from in place:
+//
+//   SceneCookHeader                          32 bytes
+//   materials   u32 count, then per material: name, diffuse, emissive,
+//               metallic, roughness, textures (u32 count, map + path)
+//   meshes      u32 count, then per mesh: name, transform, material,
+//               vertex / triangle counts, attribute mask, attribute arrays,
+//               skin bones (u32 count, name + node + offset)
+//   nodes       u32 count, then per node: name, transform, local, parent,
+//               meshNames, properties, children
+//   lights      u32 count, then every SceneLight field and its properties
+//   rootNodes   u32 count, i32 each
+//   animations  u32 count, then per clip: name, duration, channels (u32
+//               count, node + position / rotation / scale key arrays)
+//
+// Strings are a u32 length and the bytes; arrays a u64 byte count, padding
+// to 8 bytes, then the data.
+
+#include "SceneCook.hpp"
+#include <Assets/Vfs.hpp>
+#include <Physics/BVHCache.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <type_traits>
+#include <variant>
+
+namespace Hotones {
+
+namespace {
+
+// Bump whenever the layout or what SceneImporter writes into it changes
+constexpr uint32_t SCENE_COOK_VERSION    = 3;
+constexpr uint32_t SCENE_COOK_BYTE_ORDER = 0x01020304u;
+constexpr char     SCENE_COOK_MAGIC[8]   = { 'H', 'O', 'S', 'C', 'E', 'N', 'E', '\0' };
+
+struct SceneCookHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t key;
+    uint64_t size;   // of the whole file
+};
+static_assert(sizeof(SceneCookHeader) == 32, "scene cook header layout");
+
+// Which of a mesh's attribute arrays follow
+constexpr uint32_t ATTRIB_NORMALS   = 1u << 0;
+constexpr uint32_t ATTRIB_TEXCOORDS = 1u << 1;
+constexpr uint32_t ATTRIB_TANGENTS  = 1u << 2;
+constexpr uint32_t ATTRIB_COLORS    = 1u << 3;
+constexpr uint32_t ATTRIB_INDICES   = 1u << 4;
+constexpr uint32_t ATTRIB_BONES     = 1u << 5;   // boneIds and boneWeights
+constexpr uint32_t ATTRIB_TEXCOORDS2 = 1u << 6;  // lightmap UVs
+
+class CookWriter {
+public:
+    std::string buf;
+
+    template<typename T> void Pod(const T& v) { buf.append(reinterpret_cast<const char*>(&v), sizeof(T)); }
+    void Str(const std::string& s) {
+        Pod((uint32_t)s.size());
+        buf.append(s);
+    }
+    void Array(const void* data, size_t bytes) {
+        Pod((uint64_t)bytes);
+        buf.resize((buf.size() + 7) & ~size_t(7), '\0');
+        buf.append(static_cast<const char*>(data), bytes);
+    }
+    template<typename T> void Opt(const std::optional<T>& v) {
+        Pod((uint8_t)v.has_value());
+        if (v) Pod(*v);
+    }
+    void Props(const PropertyBag& bag) {
+        Pod((uint32_t)bag.Size());
+        for (const auto& [key, value] : bag) {
+            Str(*key);
+            Pod((uint8_t)value.index());
+            std::visit([&](const auto& v) {
+                if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::string>) Str(v);
+                else Pod(v);
+            }, value);
+        }
+    }
+};
+
+// Reads from a mapped file; once anything is out of bounds every read
+// returns zeroes and ok turns false
+class CookReader {
+public:
+    CookReader(const unsigned char* data, size_t size) : m_base(data), m_pos(data), m_end(data + size) {}
+
+    bool ok = true;
+
+    template<typename T> T Pod() {
+        T v{};
+        if (!Has(sizeof(T))) return v;
+        std::memcpy(&v, m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return v;
+    }
+    std::string Str() {
+        const uint32_t n = Pod<uint32_t>();
+        if (!Has(n)) return {};
+        std::string s(reinterpret_cast<const char*>(m_pos), n);
+        m_pos += n;
+        return s;
+    }
+    // The array's bytes in place; nullptr unless it is `bytes` long
+    const unsigned char* Array(size_t bytes) {
+        if (Pod<uint64_t>() != bytes) ok = false;
+        const size_t pad = (size_t)(-(m_pos - m_base)) & 7;
+        if (!Has(pad)) return nullptr;
+        m_pos += pad;
+        if (!Has(bytes)) return nullptr;
+        const unsigned char* data = m_pos;
+        m_pos += bytes;
+        return data;
+    }
+    template<typename T> std::optional<T> Opt() {
+        if (!Pod<uint8_t>()) return std::nullopt;
+        return Pod<T>();
+    }
+    // An element count, refused when even one byte each wouldn't fit
+    uint32_t Count() {
+        const uint32_t n = Pod<uint32_t>();
+        if (!Has(n)) return 0;
+        return n;
+    }
+    PropertyBag Props() {
+        PropertyBag bag;
+        const uint32_t n = Count();
+        for (uint32_t i = 0; i < n && ok; ++i) {
+            std::string key = Str();
+            switch (Pod<uint8_t>()) {
+                case 0:  bag.Set(key, PropValue{ Pod<bool>() });    break;
+                case 1:  bag.Set(key, PropValue{ Pod<int64_t>() }); break;
+                case 2:  bag.Set(key, PropValue{ Pod<double>() });  break;
+                case 3:  bag.Set(key, PropValue{ Str() });          break;
+                case 4:  bag.Set(key, PropValue{ Pod<Vector3>() }); break;
+                case 5:  bag.Set(key, PropValue{ Pod<Vector4>() }); break;
+                default: ok = false;                                break;
+            }
+        }
+        return bag;
+    }
+
+    bool AtEnd() const { return ok && m_pos == m_end; }
+
+private:
+    bool Has(size_t n) {
+        if (ok && (size_t)(m_end - m_pos) >= n) return true;
+        ok = false;
+        return false;
+    }
+
+    const unsigned char* m_base;
+    const unsigned char* m_pos;
+    const unsigned char* m_end;
+};
+
+static_assert(std::variant_size_v<PropValue> == 6, "CookReader::Props() reads PropValue by index");
+
+template<typename T>
+T* CopyArray(CookReader& in, size_t count) {
+    const unsigned char* src = in.Array(count * sizeof(T));
+    if (!src || count == 0) return nullptr;
+    T* out = (T*)MemAlloc((unsigned int)(count * sizeof(T)));
+    std::memcpy(out, src, count * sizeof(T));
+    return out;
+}
+
+// A key array: a u32 count, then the keys as one array
+template<typename Key>
+void WriteKeys(CookWriter& out, const std::vector<Key>& keys) {
+    out.Pod((uint32_t)keys.size());
+    out.Array(keys.data(), keys.size() * sizeof(Key));
+}
+template<typename Key>
+std::vector<Key> ReadKeys(CookReader& in) {
+    std::vector<Key> keys(in.Count());
+    const unsigned char* src = in.Array(keys.size() * sizeof(Key));
+    if (src && !keys.empty()) std::memcpy(keys.data(), src, keys.size() * sizeof(Key));
+    return keys;
+}
+
+} // namespace
+
+uint64_t SceneCookKey(const std::string& sourcePath, const SceneImportOptions& opts) {
+    namespace fs = std::filesystem;
+    // Inside a mounted archive the entry's CRC stands in for the mtime
+    uint64_t size = 0, stamp = 0;
+    uint32_t crc;
+    if (Assets::Vfs::Get().Stat(sourcePath, size, crc)) {
+        stamp = crc;
+    } else {
+        std::error_code ec;
+        size = (uint64_t)fs::file_size(sourcePath, ec);
+        if (ec) return 0;
+        const auto mtime = fs::last_write_time(sourcePath, ec);
+        if (ec) return 0;
+        stamp = (uint64_t)mtime.time_since_epoch().count();
+    }
+
+    uint64_t h = 14695981039346656037ull;
+    auto mix = [&](uint64_t w) { h = (h ^ w) * 1099511628211ull; };
+    mix(SCENE_COOK_VERSION);
+    for (const char c : sourcePath) mix((unsigned char)c);
+    mix(size);
+    mix(stamp);
+    uint32_t scale;
+    std::memcpy(&scale, &opts.scale, sizeof(scale));
+    mix(scale);
+    mix(opts.geometryOnly);
+    if (!opts.geometryOnly) {   // don't matter without normals and UVs
+        mix(opts.flipUVs);
+        mix(opts.generateNormals);
+    }
+    return h != 0 ? h : 1;
+}
+
+std::string SceneCookPath(const std::string& dir, uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.scene", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(dir) / name).string();
+}
+
+bool LoadCookedScene(const std::string& path, uint64_t key, CookedScene& out, bool geometryOnly) {
+    Physics::MappedFile file;
+    if (!file.Open(path) || file.Size() < sizeof(SceneCookHeader)) return false;
+
+    SceneCookHeader hdr;
+    std::memcpy(&hdr, file.Data(), sizeof(hdr));
+    if (std::memcmp(hdr.magic, SCENE_COOK_MAGIC, sizeof(hdr.magic)) != 0 ||
+        hdr.version != SCENE_COOK_VERSION || hdr.byteOrder != SCENE_COOK_BYTE_ORDER ||
+        hdr.key != key || hdr.size != file.Size()) return false;
+
+    CookReader in(file.Data(), file.Size());
+    in.Pod<SceneCookHeader>();
+
+    CookedScene cooked;
+    cooked.scene = std::make_unique<ImportedScene>();
+    ImportedScene& scene = *cooked.scene;
+
+    cooked.materials.resize(in.Count());
+    for (CookedMaterial& mat : cooked.materials) {
+        mat.name      = in.Str();
+        mat.diffuse   = in.Opt<Color>();
+        mat.emissive  = in.Opt<Color>();
+        mat.metallic  = in.Pod<float>();
+        mat.roughness = in.Pod<float>();
+        mat.textures.resize(in.Count());
+        for (auto& [map, texPath] : mat.textures) {
+            map     = in.Pod<int32_t>();
+            texPath = in.Str();
+            if (map < 0 || map > MATERIAL_MAP_BRDF) in.ok = false;
+        }
+        if (!in.ok) break;
+    }
+
+    // Meshes go in as they are read, so whatever was allocated is freed below
+    // when a later one turns out broken
+    const uint32_t meshCount = in.Count();
+    for (uint32_t i = 0; i < meshCount && in.ok; ++i) {
+        SceneMesh& sm = scene.meshes.emplace_back();
+        sm.name      = in.Str();
+        sm.transform = in.Pod<Matrix>();
+        cooked.materialOf.push_back(in.Pod<uint32_t>());
+        if (cooked.materialOf.back() > cooked.materials.size()) in.ok = false;
+
+        const int32_t  vertices  = in.Pod<int32_t>();
+        const int32_t  triangles = in.Pod<int32_t>();
+        const uint32_t attribs   = in.Pod<uint32_t>();
+        if (vertices < 0 || triangles < 0 || !in.ok) {
+            in.ok = false;
+            break;
+        }
+        const size_t n = (size_t)vertices;
+        Mesh& m = sm.mesh;
+        m.vertexCount   = vertices;
+        m.triangleCount = triangles;
+        m.vertices = CopyArray<float>(in, n * 3);
+        if (geometryOnly) {
+            // Stepped over in place
+            if (attribs & ATTRIB_NORMALS)   in.Array(n * 3 * sizeof(float));
+            if (attribs & ATTRIB_TEXCOORDS) in.Array(n * 2 * sizeof(float));
+            if (attribs & ATTRIB_TEXCOORDS2) in.Array(n * 2 * sizeof(float));
+            if (attribs & ATTRIB_TANGENTS)  in.Array(n * 4 * sizeof(float));
+            if (attribs & ATTRIB_COLORS)    in.Array(n * 4);
+            if (attribs & ATTRIB_BONES) {
+                in.Array(n * 4);
+                in.Array(n * 4 * sizeof(float));
+            }
+        } else {
+            if (attribs & ATTRIB_NORMALS)   m.normals   = CopyArray<float>(in, n * 3);
+            if (attribs & ATTRIB_TEXCOORDS) m.texcoords = CopyArray<float>(in, n * 2);
+            if (attribs & ATTRIB_TEXCOORDS2) m.texcoords2 = CopyArray<float>(in, n * 2);
+            if (attribs & ATTRIB_TANGENTS)  m.tangents  = CopyArray<float>(in, n * 4);
+            if (attribs & ATTRIB_COLORS)    m.colors    = CopyArray<unsigned char>(in, n * 4);
+            if (attribs & ATTRIB_BONES) {
+                m.boneIds     = CopyArray<unsigned char>(in, n * 4);
+                m.boneWeights = CopyArray<float>(in, n * 4);
+            }
+        }
+        if (attribs & ATTRIB_INDICES) {
+            m.indices = CopyArray<unsigned short>(in, (size_t)triangles * 3);
+            for (int t = 0; m.indices && t < triangles * 3; ++t)
+                if (m.indices[t] >= vertices) in.ok = false;
+        }
+
+        sm.skin.bones.resize(in.Count());
+        if (sm.skin.bones.size() > (size_t)MAX_SKIN_BONES) in.ok = false;
+        for (SceneBone& bone : sm.skin.bones) {
+            bone.name   = in.Str();
+            bone.node   = in.Pod<int32_t>();
+            bone.offset = in.Pod<Matrix>();
+        }
+        for (int v = 0; m.boneIds && v < vertices * 4; ++v)
+            if (m.boneIds[v] >= sm.skin.bones.size() && m.boneWeights[v] > 0.f) in.ok = false;
+        if (geometryOnly) sm.skin = {};
+    }
+
+    scene.nodes.resize(in.Count());
+    for (SceneNode& node : scene.nodes) {
+        node.name      = in.Str();
+        node.transform = in.Pod<Matrix>();
+        node.local     = in.Pod<Matrix>();
+        node.parent    = in.Pod<int32_t>();
+        node.meshNames.resize(in.Count());
+        for (std::string& name : node.meshNames) name = in.Str();
+        node.properties = in.Props();
+        node.children.resize(in.Count());
+        for (int& child : node.children) {
+            child = in.Pod<int32_t>();
+            if (child < 0 || child >= (int)scene.nodes.size()) in.ok = false;
+        }
+        if (!in.ok) break;
+    }
+
+    scene.lights.resize(in.Count());
+    for (SceneLight& light : scene.lights) {
+        light.name       = in.Str();
+        light.type       = (SceneLightType)in.Pod<int32_t>();
+        light.position   = in.Pod<Vector3>();
+        light.direction  = in.Pod<Vector3>();
+        light.color      = in.Pod<Color>();
+        light.intensity  = in.Pod<float>();
+        light.range      = in.Pod<float>();
+        light.innerAngle = in.Pod<float>();
+        light.outerAngle = in.Pod<float>();
+        light.properties = in.Props();
+        if (!in.ok) break;
+    }
+
+    scene.rootNodes.resize(in.Count());
+    for (int& root : scene.rootNodes) {
+        root = in.Pod<int32_t>();
+        if (root < 0 || root >= (int)scene.nodes.size()) in.ok = false;
+    }
+
+    for (const SceneMesh& sm : scene.meshes)
+        for (const SceneBone& bone : sm.skin.bones)
+            if (bone.node < -1 || bone.node >= (int)scene.nodes.size()) in.ok = false;
+
+    scene.animations.resize(in.Count());
+    for (SceneAnimation& anim : scene.animations) {
+        anim.name     = in.Str();
+        anim.duration = in.Pod<float>();
+        anim.channels.resize(in.Count());
+        for (SceneAnimChannel& ch : anim.channels) {
+            ch.node      = in.Pod<int32_t>();
+            ch.positions = ReadKeys<SceneVectorKey>(in);
+            ch.rotations = ReadKeys<SceneRotationKey>(in);
+            ch.scales    = ReadKeys<SceneVectorKey>(in);
+            if (ch.node < 0 || ch.node >= (int)scene.nodes.size()) in.ok = false;
+            if (!in.ok) break;
+        }
+        if (!in.ok) break;
+    }
+
+    if (!in.AtEnd()) {
+        for (SceneMesh& sm : scene.meshes) {
+            MemFree(sm.mesh.vertices);
+            MemFree(sm.mesh.normals);
+            MemFree(sm.mesh.texcoords);
+            MemFree(sm.mesh.tangents);
+            MemFree(sm.mesh.colors);
+            MemFree(sm.mesh.indices);
+            MemFree(sm.mesh.boneIds);
+            MemFree(sm.mesh.boneWeights);
+        }
+        return false;
+    }
+    if (geometryOnly) {
+        scene.animations.clear();
+        cooked.materials.clear();
+        std::fill(cooked.materialOf.begin(), cooked.materialOf.end(), 0u);   // all the default one
+    }
+    out = std::move(cooked);
+    return true;
+}
+
+bool StoreCookedScene(const std::string& path, uint64_t key, const ImportedScene& scene,
+                      const std::vector<CookedMaterial>& materials, const std::vector<unsigned int>& materialOf) {
+    namespace fs = std::filesystem;
+
+    CookWriter out;
+    out.Pod(SceneCookHeader{});
+
+    out.Pod((uint32_t)materials.size());
+    for (const CookedMaterial& mat : materials) {
+        out.Str(mat.name);
+        out.Opt(mat.diffuse);
+        out.Opt(mat.emissive);
+        out.Pod(mat.metallic);
+        out.Pod(mat.roughness);
+        out.Pod((uint32_t)mat.textures.size());
+        for (const auto& [map, texPath] : mat.textures) {
+            out.Pod((int32_t)map);
+            out.Str(texPath);
+        }
+    }
+
+    out.Pod((uint32_t)scene.meshes.size());
+    for (size_t i = 0; i < scene.meshes.size(); ++i) {
+        const SceneMesh& sm = scene.meshes[i];
+        const Mesh&      m  = sm.mesh;
+        const size_t     n  = (size_t)m.vertexCount;
+        out.Str(sm.name);
+        out.Pod(sm.transform);
+        out.Pod((uint32_t)materialOf[i]);
+        out.Pod((int32_t)m.vertexCount);
+        out.Pod((int32_t)m.triangleCount);
+        const uint32_t attribs = (m.normals   ? ATTRIB_NORMALS   : 0) | (m.texcoords ? ATTRIB_TEXCOORDS : 0) |
+                                 (m.tangents  ? ATTRIB_TANGENTS  : 0) | (m.colors    ? ATTRIB_COLORS    : 0) |
+                                 (m.indices   ? ATTRIB_INDICES   : 0) | (m.texcoords2 ? ATTRIB_TEXCOORDS2 : 0) |
+                                 (m.boneIds && m.boneWeights ? ATTRIB_BONES : 0);
+        out.Pod(attribs);
+        out.Array(m.vertices, n * 3 * sizeof(float));
+        if (m.normals)   out.Array(m.normals,   n * 3 * sizeof(float));
+        if (m.texcoords) out.Array(m.texcoords, n * 2 * sizeof(float));
+        if (m.texcoords2) out.Array(m.texcoords2, n * 2 * sizeof(float));
+        if (m.tangents)  out.Array(m.tangents,  n * 4 * sizeof(float));
+        if (m.colors)    out.Array(m.colors,    n * 4);
+        if (attribs & ATTRIB_BONES) {
+            out.Array(m.boneIds,     n * 4);
+            out.Array(m.boneWeights, n * 4 * sizeof(float));
+        }
+        if (m.indices)   out.Array(m.indices,   (size_t)m.triangleCount * 3 * sizeof(unsigned short));
+        out.Pod((uint32_t)sm.skin.bones.size());
+        for (const SceneBone& bone : sm.skin.bones) {
+            out.Str(bone.name);
+            out.Pod((int32_t)bone.node);
+            out.Pod(bone.offset);
+        }
+    }
+
+    out.Pod((uint32_t)scene.nodes.size());
+    for (const SceneNode& node : scene.nodes) {
+        out.Str(node.name);
+        out.Pod(node.transform);
+        out.Pod(node.local);
+        out.Pod((int32_t)node.parent);
+        out.Pod((uint32_t)node.meshNames.size());
+        for (const std::string& name : node.meshNames) out.Str(name);
+        out.Props(node.properties);
+        out.Pod((uint32_t)node.children.size());
+        for (const int child : node.children) out.Pod((int32_t)child);
+    }
+
+    out.Pod((uint32_t)scene.lights.size());
+    for (const SceneLight& light : scene.lights) {
+        out.Str(light.name);
+        out.Pod((int32_t)light.type);
+        out.Pod(light.position);
+        out.Pod(light.direction);
+        out.Pod(light.color);
+        out.Pod(light.intensity);
+        out.Pod(light.range);
+        out.Pod(light.innerAngle);
+        out.Pod(light.outerAngle);
+        out.Props(light.properties);
+    }
+
+    out.Pod((uint32_t)scene.rootNodes.size());
+    for (const int root : scene.rootNodes) out.Pod((int32_t)root);
+
+    out.Pod((uint32_t)scene.animations.size());
+    for (const SceneAnimation& anim : scene.animations) {
+        out.Str(anim.name);
+        out.Pod(anim.duration);
+        out.Pod((uint32_t)anim.channels.size());
+        for (const SceneAnimChannel& ch : anim.channels) {
+            out.Pod((int32_t)ch.node);
+            WriteKeys(out, ch.positions);
+            WriteKeys(out, ch.rotations);
+            WriteKeys(out, ch.scales);
+        }
+    }
+
+    SceneCookHeader hdr{};
+    std::memcpy(hdr.magic, SCENE_COOK_MAGIC, sizeof(hdr.magic));
+    hdr.version   = SCENE_COOK_VERSION;
+    hdr.byteOrder = SCENE_COOK_BYTE_ORDER;
+    hdr.key       = key;
+    hdr.size      = out.buf.size();
+    std::memcpy(out.buf.data(), &hdr, sizeof(hdr));
+
+    std::error_code ec;
+    const fs::path dir = fs::path(path).parent_path();
+    if (!dir.empty()) fs::create_directories(dir, ec);
+    if (ec) return false;
+
+    // Unique per writer; see StoreBVHCache
+    const size_t salt = std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+                        static_cast<size_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    const std::string tmpPath = path + "." + std::to_string(salt) + ".tmp";
+    {
+        std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!ofs) return false;
+        ofs.write(out.buf.data(), static_cast<std::streamsize>(out.buf.size()));
+        if (!ofs) {
+            ofs.close();
+            fs::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    fs::rename(tmpPath, path, ec);
+    if (ec) {
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace Hotones
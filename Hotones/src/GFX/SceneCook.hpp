@@ -0,0 +1,49 @@
+#pragma once
+
+// Cooked scenes: what SceneImporter gets out of Assimp, saved as a binary
+// file that loads without Assimp.  See SceneImportOptions::cookDir.
+
+#include <GFX/SceneImporter.hpp>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Hotones {
+
+// A material as read from the source file; textures are looked up (and
+// decoded) at load time
+struct CookedMaterial {
+    std::string          name;
+    std::optional<Color> diffuse, emissive;
+    float                metallic = 0.f, roughness = 1.f;
+    std::vector<std::pair<int, std::string>> textures;   // material map index, path relative to the scene file
+};
+
+// A scene before merging, LODs and upload: meshes hold CPU data only
+struct CookedScene {
+    std::unique_ptr<ImportedScene> scene;
+    std::vector<CookedMaterial>    materials;    // the file's; materialOf may be one past them (default)
+    std::vector<unsigned int>      materialOf;   // per scene mesh
+};
+
+// Identifies `sourcePath` as it is now (size and modification time, or CRC
+// inside a mounted archive) with the options that change what Assimp makes
+// of it; 0 if it can't be read
+uint64_t SceneCookKey(const std::string& sourcePath, const SceneImportOptions& opts);
+
+// <dir>/<key as 16 hex digits>.scene
+std::string SceneCookPath(const std::string& dir, uint64_t key);
+
+// False on a miss, or if the file is truncated, from another format version
+// or for another key.  `out.scene->path` is left for the caller.  With
+// `geometryOnly` meshes get positions and indices only, and no materials.
+bool LoadCookedScene(const std::string& path, uint64_t key, CookedScene& out, bool geometryOnly = false);
+
+// Written to a temporary name and renamed into place, like the LOD cache
+bool StoreCookedScene(const std::string& path, uint64_t key, const ImportedScene& scene,
+                      const std::vector<CookedMaterial>& materials, const std::vector<unsigned int>& materialOf);
+
+} // namespace Hotones
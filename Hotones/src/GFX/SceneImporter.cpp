@@ -5,6 +5,8 @@
 //   • A flat node list with names, world transforms, GLTF extras  (gameplay)
 //   • SceneLight list  (lighting)
 //   • Per-mesh BVH handles registered with PhysicsSystem  (collision)
+//   • Optional per-mesh LOD chains (MeshSimplify)  (distant geometry)
+//   • Skins (bones and vertex weights) and animation clips  (characters)
 //
 // Assimp post-process flags used:
 //   aiProcess_Triangulate           — ensure every face is a triangle
@@ -13,14 +15,27 @@
 //   aiProcess_JoinIdenticalVertices — reduce vertex count
 //   aiProcess_FlipUVs               — match OpenGL (0,0 = bottom-left)
 //   aiProcess_GlobalScale           — applies AI_CONFIG_GLOBAL_SCALE_FACTOR
-//   aiProcess_PopulateArmatureData  — bone data (unused for now, benign)
+//   aiProcess_LimitBoneWeights      — at most four bones per vertex
+//   aiProcess_SplitByBoneCount      — at most MAX_SKIN_BONES bones per mesh
+// Bones find their nodes by name.
 
 #include <GFX/SceneImporter.hpp>
+#include <GFX/LightingSystem.hpp>
+#include <GFX/MeshSimplify.hpp>
+#include <Jobs/JobSystem.hpp>
 #include <Physics/PhysicsSystem.hpp>
+#include <Profile/Profiler.hpp>
+#include <Assets/AssetCache.hpp>
+#include <Assets/TextureCook.hpp>
+#include <Assets/Vfs.hpp>
 #include "AssetPath.hpp"
+#include "SceneCook.hpp"
 
 // Assimp
 #include <assimp/Importer.hpp>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/config.h>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <assimp/material.h>
@@ -28,13 +43,19 @@
 
 #include <raylib.h>
 #include <raymath.h>
+#include <rlgl.h>
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstring>
 #include <iostream>
+#include <limits>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 
 // ─── Internal helpers ─────────────────────────────────────────────────────────
 
@@ -50,13 +71,15 @@ static inline Color   Ai2Clr(const aiColor3D& c, float intensity = 1.f) {
 
 // Convert Assimp row-major 4×4 matrix to raylib column-major Matrix.
 // Assimp stores matrices row-major (a[row][col]); raylib/OpenGL is column-major.
+// raylib's initialiser runs m0, m4, m8, m12 (row 0) first, so rows map to
+// rows and the translation (a4, b4, c4) lands in m12..m14.
 static Matrix Ai2Matrix(const aiMatrix4x4& m) {
     // Assimp: m.a1..a4 = row 0 cols 0..3
     return {
-        m.a1, m.b1, m.c1, m.d1,
-        m.a2, m.b2, m.c2, m.d2,
-        m.a3, m.b3, m.c3, m.d3,
-        m.a4, m.b4, m.c4, m.d4
+        m.a1, m.a2, m.a3, m.a4,
+        m.b1, m.b2, m.b3, m.b4,
+        m.c1, m.c2, m.c3, m.c4,
+        m.d1, m.d2, m.d3, m.d4
     };
 }
 
@@ -64,44 +87,64 @@ static Matrix Ai2Matrix(const aiMatrix4x4& m) {
 
 namespace Hotones {
 
-bool PropertyBag::Has(const std::string& key) const {
-    return data.count(key) > 0;
+// The process-wide key table.  Bags are filled on the loader threads, so
+// interning locks; lookups compare the text and never touch the table.
+static const std::string* InternPropertyKey(const std::string& key) {
+    static std::mutex                      mutex;
+    static std::unordered_set<std::string> keys;   // nodes never move, nor are they erased
+    std::lock_guard<std::mutex> lock(mutex);
+    return &*keys.insert(key).first;
+}
+
+static bool EntryKeyLess(const PropertyBag::Entry& e, const std::string& key) {
+    return *e.key < key;
+}
+
+void PropertyBag::Set(const std::string& key, PropValue value) {
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), key, EntryKeyLess);
+    if (it != m_entries.end() && *it->key == key) { it->value = std::move(value); return; }
+    m_entries.insert(it, Entry{ InternPropertyKey(key), std::move(value) });
+}
+const PropValue* PropertyBag::Find(const std::string& key) const {
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), key, EntryKeyLess);
+    if (it == m_entries.end() || *it->key != key) return nullptr;
+    return &it->value;
 }
 std::string PropertyBag::GetString(const std::string& key, const std::string& def) const {
-    auto it = data.find(key);
-    if (it == data.end()) return def;
-    if (auto* p = std::get_if<std::string>(&it->second)) return *p;
+    const PropValue* v = Find(key);
+    if (!v) return def;
+    if (auto* p = std::get_if<std::string>(v)) return *p;
     return def;
 }
 double PropertyBag::GetFloat(const std::string& key, double def) const {
-    auto it = data.find(key);
-    if (it == data.end()) return def;
-    if (auto* p = std::get_if<double>(&it->second))  return *p;
-    if (auto* p = std::get_if<int64_t>(&it->second)) return (double)*p;
-    if (auto* p = std::get_if<bool>(&it->second))    return *p ? 1.0 : 0.0;
+    const PropValue* v = Find(key);
+    if (!v) return def;
+    if (auto* p = std::get_if<double>(v))  return *p;
+    if (auto* p = std::get_if<int64_t>(v)) return (double)*p;
+    if (auto* p = std::get_if<bool>(v))    return *p ? 1.0 : 0.0;
     return def;
 }
 int64_t PropertyBag::GetInt(const std::string& key, int64_t def) const {
-    auto it = data.find(key);
-    if (it == data.end()) return def;
-    if (auto* p = std::get_if<int64_t>(&it->second)) return *p;
-    if (auto* p = std::get_if<double>(&it->second))  return (int64_t)*p;
-    if (auto* p = std::get_if<bool>(&it->second))    return *p ? 1 : 0;
+    const PropValue* v = Find(key);
+    if (!v) return def;
+    if (auto* p = std::get_if<int64_t>(v)) return *p;
+    if (auto* p = std::get_if<double>(v))  return (int64_t)*p;
+    if (auto* p = std::get_if<bool>(v))    return *p ? 1 : 0;
     return def;
 }
 bool PropertyBag::GetBool(const std::string& key, bool def) const {
-    auto it = data.find(key);
-    if (it == data.end()) return def;
-    if (auto* p = std::get_if<bool>(&it->second))    return *p;
-    if (auto* p = std::get_if<int64_t>(&it->second)) return *p != 0;
-    if (auto* p = std::get_if<double>(&it->second))  return *p != 0.0;
+    const PropValue* v = Find(key);
+    if (!v) return def;
+    if (auto* p = std::get_if<bool>(v))    return *p;
+    if (auto* p = std::get_if<int64_t>(v)) return *p != 0;
+    if (auto* p = std::get_if<double>(v))  return *p != 0.0;
     return def;
 }
 std::optional<Vector3> PropertyBag::GetVec3(const std::string& key) const {
-    auto it = data.find(key);
-    if (it == data.end()) return std::nullopt;
-    if (auto* p = std::get_if<Vector3>(&it->second)) return *p;
-    if (auto* p = std::get_if<Vector4>(&it->second)) return Vector3{p->x, p->y, p->z};
+    const PropValue* v = Find(key);
+    if (!v) return std::nullopt;
+    if (auto* p = std::get_if<Vector3>(v)) return *p;
+    if (auto* p = std::get_if<Vector4>(v)) return Vector3{p->x, p->y, p->z};
     return std::nullopt;
 }
 
@@ -112,6 +155,92 @@ void ImportedScene::Draw() const {
         DrawMesh(sm.mesh, sm.mat, sm.transform);
 }
 
+void ImportedScene::SetLODView(const Camera& camera, float screenHeight) {
+    lodEye         = camera.position;
+    lodPerspective = camera.projection != CAMERA_ORTHOGRAPHIC;
+    // Pixels one unit spans: at distance 1 in perspective, anywhere in ortho
+    lodPixelsPerUnit = lodPerspective
+                     ? screenHeight / (2.f * tanf(camera.fovy * 0.5f * DEG2RAD))
+                     : screenHeight / camera.fovy;
+}
+
+// The coarsest of `sm`'s LODs whose error stays within lodPixelError on
+// screen, measured at the nearest point of its bounds
+static const Mesh& PickLOD(const ImportedScene& scene, const SceneMesh& sm) {
+    if (sm.lods.empty() || scene.lodPixelsPerUnit <= 0.f) return sm.mesh;
+    const Matrix& t = sm.transform;
+    const float scale = sqrtf(std::max({ t.m0 * t.m0 + t.m1 * t.m1 + t.m2 * t.m2,
+                                         t.m4 * t.m4 + t.m5 * t.m5 + t.m6 * t.m6,
+                                         t.m8 * t.m8 + t.m9 * t.m9 + t.m10 * t.m10 }));
+    float pixels = scene.lodPixelsPerUnit * scale;
+    if (scene.lodPerspective) {
+        const Vector3 nearest = Vector3Max(sm.bounds.min, Vector3Min(scene.lodEye, sm.bounds.max));
+        pixels /= std::max(Vector3Distance(scene.lodEye, nearest), GFX::CULL_NEAR);
+    }
+    const Mesh* pick = &sm.mesh;
+    for (const SceneLOD& lod : sm.lods) {
+        if (lod.error * pixels > scene.lodPixelError) break;
+        pick = &lod.view.GetMesh();
+    }
+    return *pick;
+}
+
+// fn(mesh, material, transform) for what of the scene is in `frustum`: whole
+// meshes (at their LOD) as the tree finds them, then one call per merged mesh with parts in
+// view (its MeshView, refilled when the set of visible parts changed).
+template<typename Fn>
+static void DrawInView(const ImportedScene& scene, const GFX::Frustum& frustum, Fn&& fn) {
+    scene.visibleParts.clear();
+    scene.cullTree.Query(frustum, [&](uint32_t i) {
+        const ImportedScene::CullItem& item = scene.cullItems[i];
+        if (item.part < 0) {
+            const SceneMesh& sm = scene.meshes[item.mesh];
+            fn(PickLOD(scene, sm), sm.mat, sm.transform);
+        } else {
+            scene.visibleParts.push_back(i);
+        }
+    });
+    if (scene.visibleParts.empty()) return;
+
+    // Sorted, they run mesh by mesh (BuildCullTree adds a mesh's parts together)
+    std::sort(scene.visibleParts.begin(), scene.visibleParts.end());
+    if (scene.visibleParts != scene.drawnParts) {
+        for (const auto& sm : scene.meshes) sm.view.Clear();
+        for (const uint32_t i : scene.visibleParts) {
+            const ImportedScene::CullItem& item = scene.cullItems[i];
+            const SceneMesh&               sm   = scene.meshes[item.mesh];
+            sm.view.Add(sm.parts[item.part].firstIndex, sm.parts[item.part].indexCount);
+        }
+        for (const auto& sm : scene.meshes)
+            if (sm.view.IsReady()) sm.view.Upload();
+        scene.drawnParts = scene.visibleParts;
+    }
+
+    int last = -1;
+    for (const uint32_t i : scene.visibleParts) {
+        const int m = scene.cullItems[i].mesh;
+        if (m == last) continue;
+        last = m;
+        const SceneMesh& sm = scene.meshes[m];
+        if (!sm.view.IsReady() || sm.view.IsWhole())
+            fn(sm.mesh, sm.mat, sm.transform);
+        else
+            fn(sm.view.GetMesh(), sm.mat, sm.transform);
+    }
+}
+
+void ImportedScene::Draw(const GFX::Frustum& frustum) const {
+    DrawInView(*this, frustum, [](const Mesh& mesh, const Material& mat, const Matrix& transform) {
+        DrawMesh(mesh, mat, transform);
+    });
+}
+
+void ImportedScene::Draw(const GFX::Frustum& frustum, GFX::RenderQueue& queue) const {
+    DrawInView(*this, frustum, [&](const Mesh& mesh, const Material& mat, const Matrix& transform) {
+        queue.Submit(mesh, mat, transform);
+    });
+}
+
 void ImportedScene::DrawTinted(Color tint) const {
     for (const auto& sm : meshes) {
         Material mat = sm.mat;
@@ -120,41 +249,180 @@ void ImportedScene::DrawTinted(Color tint) const {
     }
 }
 
+void ImportedScene::DrawTinted(Color tint, const GFX::Frustum& frustum) const {
+    DrawInView(*this, frustum, [&](const Mesh& mesh, const Material& mat, const Matrix& transform) {
+        Material tinted = mat;
+        tinted.maps[MATERIAL_MAP_DIFFUSE].color = tint;
+        DrawMesh(mesh, tinted, transform);
+    });
+}
+
+void ImportedScene::BuildCullTree() {
+    std::vector<BoundingBox> boxes;
+    boxes.reserve(meshes.size());
+    cullItems.clear();
+    for (int m = 0; m < (int)meshes.size(); ++m) {
+        auto& sm = meshes[m];
+        if (sm.parts.empty()) {
+            sm.bounds = sm.mesh.vertexCount > 0
+                      ? GFX::TransformBox(GetMeshBoundingBox(sm.mesh), sm.transform)
+                      : BoundingBox{ { sm.transform.m12, sm.transform.m13, sm.transform.m14 },
+                                     { sm.transform.m12, sm.transform.m13, sm.transform.m14 } };
+            cullItems.push_back({ m, -1 });
+            boxes.push_back(sm.bounds);
+            continue;
+        }
+        // Merged: every part on its own, the mesh's bounds around them all
+        for (int p = 0; p < (int)sm.parts.size(); ++p) {
+            const BoundingBox box = GFX::TransformBox(sm.parts[p].box, sm.transform);
+            if (p == 0) {
+                sm.bounds = box;
+            } else {
+                sm.bounds.min = Vector3Min(sm.bounds.min, box.min);
+                sm.bounds.max = Vector3Max(sm.bounds.max, box.max);
+            }
+            cullItems.push_back({ m, p });
+            boxes.push_back(box);
+        }
+    }
+    cullTree.Build(boxes);
+    // cullItems indices changed meaning: refill the views on the next draw
+    visibleParts.clear();
+    drawnParts.clear();
+}
+
+void ImportedScene::BuildNodeIndex() {
+    nodeIndex = {};
+    nodeIndex.byName.reserve(nodes.size());
+    nodeIndex.nameStart.reserve(nodes.size());
+    for (int i = 0; i < (int)nodes.size(); ++i) {
+        const SceneNode& n = nodes[i];
+        nodeIndex.byName.try_emplace(n.name, i);
+        // Keys are interned, so a view of one outlives the scene
+        for (const auto& entry : n.properties)
+            nodeIndex.byProperty[std::string_view(entry.Key())].push_back(i);
+        nodeIndex.nameStart.push_back((int)nodeIndex.names.size());
+        nodeIndex.names += n.name;
+        nodeIndex.names += '\0';
+    }
+}
+
 const SceneNode* ImportedScene::GetNode(const std::string& name) const {
-    for (const auto& n : nodes)
-        if (n.name == name) return &n;
-    return nullptr;
+    auto it = nodeIndex.byName.find(name);
+    return it == nodeIndex.byName.end() ? nullptr : &nodes[it->second];
 }
 SceneNode* ImportedScene::GetNode(const std::string& name) {
-    for (auto& n : nodes)
-        if (n.name == name) return &n;
-    return nullptr;
+    auto it = nodeIndex.byName.find(name);
+    return it == nodeIndex.byName.end() ? nullptr : &nodes[it->second];
 }
 std::vector<const SceneNode*> ImportedScene::FindNodesByProperty(const std::string& key) const {
     std::vector<const SceneNode*> out;
-    for (const auto& n : nodes)
-        if (n.properties.Has(key)) out.push_back(&n);
+    auto it = nodeIndex.byProperty.find(std::string_view(key));
+    if (it == nodeIndex.byProperty.end()) return out;
+    out.reserve(it->second.size());
+    for (const int i : it->second) out.push_back(&nodes[i]);
     return out;
 }
 std::vector<const SceneNode*> ImportedScene::FindNodesByName(const std::string& substr) const {
     std::vector<const SceneNode*> out;
-    for (const auto& n : nodes)
-        if (n.name.find(substr) != std::string::npos) out.push_back(&n);
+    if (substr.empty()) {
+        for (const auto& n : nodes) out.push_back(&n);
+        return out;
+    }
+    // One pass over the packed names: a match can't span two of them (the
+    // '\0' between), and after one the search resumes at the next name
+    const std::string_view names = nodeIndex.names;
+    const auto& starts = nodeIndex.nameStart;
+    size_t pos = 0;
+    while ((pos = names.find(substr, pos)) != std::string_view::npos) {
+        const int i = (int)(std::upper_bound(starts.begin(), starts.end(), (int)pos) - starts.begin()) - 1;
+        out.push_back(&nodes[i]);
+        pos = (size_t)(i + 1 < (int)starts.size() ? starts[i + 1] : (int)names.size());
+    }
     return out;
 }
 
+bool ImportedScene::IsSkinned() const {
+    for (const auto& sm : meshes)
+        if (!sm.skin.Empty()) return true;
+    return false;
+}
+int ImportedScene::FindAnimation(const std::string& name) const {
+    for (int i = 0; i < (int)animations.size(); ++i)
+        if (animations[i].name == name) return i;
+    return -1;
+}
+
+bool ImportedScene::WaitForPhysics(float timeoutSeconds) const {
+    std::vector<int> handles;
+    if (physicsHandle != -1) handles.push_back(physicsHandle);
+    for (const auto& sm : meshes)
+        if (sm.physicsHandle != -1) handles.push_back(sm.physicsHandle);
+    return Physics::WaitForMeshes(handles, timeoutSeconds);
+}
+
+// Free a mesh that was never uploaded (UnloadMesh() would make GL calls)
+static void FreeMeshData(Mesh& m) {
+    MemFree(m.vertices);
+    MemFree(m.normals);
+    MemFree(m.texcoords);
+    MemFree(m.texcoords2);
+    MemFree(m.tangents);
+    MemFree(m.colors);
+    MemFree(m.indices);
+    MemFree(m.boneIds);
+    MemFree(m.boneWeights);
+    m = {0};
+}
+
+// What of `sm` lives on the GPU or in PhysicsSystem: its buffers, views and
+// collision mesh.  The material is left to the caller; meshes share them.
+static void UnloadSceneMesh(SceneMesh& sm) {
+    sm.view.Unload();
+    for (auto& lod : sm.lods) lod.view.Unload();
+    sm.lods.clear();
+    if (sm.mesh.vaoId == 0 && sm.mesh.vboId == nullptr) FreeMeshData(sm.mesh);   // never uploaded
+    else UnloadMesh(sm.mesh);
+    sm.mesh = {0};
+    if (sm.physicsHandle != -1) {
+        Physics::UnregisterStaticMesh(sm.physicsHandle);
+        sm.physicsHandle = -1;
+    }
+}
+
+// UnloadMaterial() leaving the textures, which are the AssetCache's (or the
+// scene's lightmaps), and the shader, which is the LightingSystem's
+static void UnloadSceneMaterial(Material& mat) {
+    for (int i = 0; i <= MATERIAL_MAP_BRDF; ++i) mat.maps[i].texture.id = rlGetTextureIdDefault();
+    mat.shader.id = rlGetShaderIdDefault();
+    UnloadMaterial(mat);
+    mat.maps = nullptr;
+}
+
 void ImportedScene::Unload() {
+    // Meshes of one material share it; unload it once
+    std::unordered_set<const MaterialMap*> unloaded;
     for (auto& sm : meshes) {
-        UnloadMesh(sm.mesh);
-        UnloadMaterial(sm.mat);
-        if (sm.physicsHandle != -1) {
-            Physics::UnregisterStaticMesh(sm.physicsHandle);
-            sm.physicsHandle = -1;
-        }
+        UnloadSceneMesh(sm);
+        if (sm.mat.maps && unloaded.insert(sm.mat.maps).second) UnloadSceneMaterial(sm.mat);
+    }
+    if (physicsHandle != -1) {
+        Physics::UnregisterStaticMesh(physicsHandle);
+        physicsHandle = -1;
     }
     meshes.clear();
+    textures.clear();
+    for (Texture2D& lightmap : lightmaps) UnloadTexture(lightmap);
+    lightmaps.clear();
+    probes = {};
     nodes.clear();
     lights.clear();
+    animations.clear();
+    poseNodes.clear();
+    cullItems.clear();
+    cullTree.Clear();
+    visibleParts.clear();
+    drawnParts.clear();
 }
 
 // ─── Assimp → PropertyBag conversion ─────────────────────────────────────────
@@ -167,26 +435,26 @@ static PropertyBag MetadataToPropertyBag(const aiMetadata* meta) {
         const aiMetadataEntry& entry = meta->mValues[i];
         switch (entry.mType) {
             case AI_BOOL:
-                bag.data[key] = PropValue{ *static_cast<bool*>(entry.mData) };
+                bag.Set(key, PropValue{ *static_cast<bool*>(entry.mData) });
                 break;
             case AI_INT32:
-                bag.data[key] = PropValue{ (int64_t)*static_cast<int32_t*>(entry.mData) };
+                bag.Set(key, PropValue{ (int64_t)*static_cast<int32_t*>(entry.mData) });
                 break;
             case AI_UINT64:
-                bag.data[key] = PropValue{ (int64_t)*static_cast<uint64_t*>(entry.mData) };
+                bag.Set(key, PropValue{ (int64_t)*static_cast<uint64_t*>(entry.mData) });
                 break;
             case AI_FLOAT:
-                bag.data[key] = PropValue{ (double)*static_cast<float*>(entry.mData) };
+                bag.Set(key, PropValue{ (double)*static_cast<float*>(entry.mData) });
                 break;
             case AI_DOUBLE:
-                bag.data[key] = PropValue{ *static_cast<double*>(entry.mData) };
+                bag.Set(key, PropValue{ *static_cast<double*>(entry.mData) });
                 break;
             case AI_AISTRING:
-                bag.data[key] = PropValue{ std::string(static_cast<aiString*>(entry.mData)->C_Str()) };
+                bag.Set(key, PropValue{ std::string(static_cast<aiString*>(entry.mData)->C_Str()) });
                 break;
             case AI_AIVECTOR3D: {
                 const aiVector3D* v = static_cast<aiVector3D*>(entry.mData);
-                bag.data[key] = PropValue{ Vector3{v->x, v->y, v->z} };
+                bag.Set(key, PropValue{ Vector3{v->x, v->y, v->z} });
                 break;
             }
             default:
@@ -198,6 +466,8 @@ static PropertyBag MetadataToPropertyBag(const aiMetadata* meta) {
 
 // ─── Assimp mesh → raylib Mesh ────────────────────────────────────────────────
 
+// CPU side only; uploaded later, on the main thread
+
 static Mesh AiMeshToRaylibMesh(const aiMesh* aim) {
     Mesh m = {0};
     if (!aim || aim->mNumVertices == 0) return m;
@@ -232,6 +502,15 @@ static Mesh AiMeshToRaylibMesh(const aiMesh* aim) {
         }
     }
 
+    // UV channel 1: lightmap coordinates, when authored (see GFX::BakeLighting)
+    if (aim->HasTextureCoords(1)) {
+        m.texcoords2 = (float*)MemAlloc(m.vertexCount * 2 * sizeof(float));
+        for (int i = 0; i < m.vertexCount; ++i) {
+            m.texcoords2[i*2+0] = aim->mTextureCoords[1][i].x;
+            m.texcoords2[i*2+1] = aim->mTextureCoords[1][i].y;
+        }
+    }
+
     // Tangents (for normal mapping)
     if (aim->HasTangentsAndBitangents()) {
         m.tangents = (float*)MemAlloc(m.vertexCount * 4 * sizeof(float));
@@ -263,20 +542,177 @@ static Mesh AiMeshToRaylibMesh(const aiMesh* aim) {
         m.indices[f*3+2] = (unsigned short)aim->mFaces[f].mIndices[2];
     }
 
-    UploadMesh(&m, false);
     return m;
 }
 
+// ─── Skins and animations ─────────────────────────────────────────────────────
+
+// The bones of `aim` (nodes looked up by name), and each vertex's four
+// strongest weights into m.boneIds / boneWeights, normalised.  Vertices
+// weighted to no bone stay where the mesh puts them.
+static SceneSkin AiBonesToSkin(const aiMesh* aim, Mesh& m,
+                               const std::unordered_map<std::string, int>& nodeByName) {
+    SceneSkin skin;
+    if (!aim || !aim->HasBones() || m.vertexCount == 0) return skin;
+
+    const unsigned int bones = std::min(aim->mNumBones, (unsigned int)MAX_SKIN_BONES);
+    m.boneIds     = (unsigned char*)MemAlloc(m.vertexCount * 4 * sizeof(unsigned char));   // zeroed
+    m.boneWeights = (float*)MemAlloc(m.vertexCount * 4 * sizeof(float));
+    for (unsigned int b = 0; b < bones; ++b) {
+        const aiBone* bone = aim->mBones[b];
+        const auto    node = nodeByName.find(bone->mName.C_Str());
+        skin.bones.push_back({ bone->mName.C_Str(), node != nodeByName.end() ? node->second : -1,
+                               Ai2Matrix(bone->mOffsetMatrix) });
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            const aiVertexWeight& vw = bone->mWeights[w];
+            if (vw.mVertexId >= (unsigned int)m.vertexCount || vw.mWeight <= 0.f) continue;
+            // Into the vertex's weakest slot, if stronger
+            float*    weights = m.boneWeights + (size_t)vw.mVertexId * 4;
+            const int slot    = (int)(std::min_element(weights, weights + 4) - weights);
+            if (vw.mWeight <= weights[slot]) continue;
+            weights[slot] = vw.mWeight;
+            m.boneIds[(size_t)vw.mVertexId * 4 + slot] = (unsigned char)b;
+        }
+    }
+    for (int v = 0; v < m.vertexCount; ++v) {
+        float* weights = m.boneWeights + (size_t)v * 4;
+        const float total = weights[0] + weights[1] + weights[2] + weights[3];
+        if (total > 0.f)
+            for (int i = 0; i < 4; ++i) weights[i] /= total;
+    }
+    return skin;
+}
+
+static SceneAnimation ReadAnimation(const aiAnimation* aia,
+                                    const std::unordered_map<std::string, int>& nodeByName) {
+    SceneAnimation anim;
+    anim.name = aia->mName.C_Str();
+    const double ticksPerSecond = aia->mTicksPerSecond > 0.0 ? aia->mTicksPerSecond : 25.0;
+    const auto   seconds        = [&](double ticks) { return (float)(ticks / ticksPerSecond); };
+    anim.duration = seconds(aia->mDuration);
+
+    for (unsigned int c = 0; c < aia->mNumChannels; ++c) {
+        const aiNodeAnim* ch   = aia->mChannels[c];
+        const auto        node = nodeByName.find(ch->mNodeName.C_Str());
+        if (node == nodeByName.end()) continue;
+        SceneAnimChannel out;
+        out.node = node->second;
+        for (unsigned int k = 0; k < ch->mNumPositionKeys; ++k)
+            out.positions.push_back({ seconds(ch->mPositionKeys[k].mTime), Ai2Rl(ch->mPositionKeys[k].mValue) });
+        for (unsigned int k = 0; k < ch->mNumRotationKeys; ++k) {
+            const aiQuaternion& q = ch->mRotationKeys[k].mValue;
+            out.rotations.push_back({ seconds(ch->mRotationKeys[k].mTime), Quaternion{ q.x, q.y, q.z, q.w } });
+        }
+        for (unsigned int k = 0; k < ch->mNumScalingKeys; ++k)
+            out.scales.push_back({ seconds(ch->mScalingKeys[k].mTime), Ai2Rl(ch->mScalingKeys[k].mValue) });
+        anim.channels.push_back(std::move(out));
+    }
+    return anim;
+}
+
+// What is derived rather than read (or cooked): each clip's channel per
+// node, each skin's bone count and LOD levels, and the nodes a pose needs
+// per level.
+// Bones are dropped by how little of their mesh they carry; one dropped is
+// posed as its nearest kept ancestor, so its vertices follow that rigidly.
+static void PrepareSkins(ImportedScene& scene) {
+    const int nodeCount = (int)scene.nodes.size();
+    for (SceneAnimation& anim : scene.animations) {
+        anim.nodeChannel.assign(nodeCount, -1);
+        for (int c = 0; c < (int)anim.channels.size(); ++c) {
+            const int node = anim.channels[c].node;
+            if (node >= 0 && node < nodeCount) anim.nodeChannel[node] = c;
+        }
+    }
+
+    std::vector<std::vector<uint8_t>> needed(SKIN_LOD_LEVELS, std::vector<uint8_t>(nodeCount, 0));
+    std::vector<int> boneOfNode(nodeCount, -1);
+    for (SceneMesh& sm : scene.meshes) {
+        SceneSkin& skin  = sm.skin;
+        const int  bones = (int)skin.bones.size();
+        if (bones == 0) continue;
+#if defined(RL_DEFAULT_SHADER_ATTRIB_NAME_BONEIDS)
+        sm.mesh.boneCount = bones;
+#endif
+
+        // How much of the mesh each bone carries
+        std::vector<float> carried(bones, 0.f);
+        const Mesh& m = sm.mesh;
+        if (m.boneIds && m.boneWeights)
+            for (int i = 0; i < m.vertexCount * 4; ++i)
+                if (m.boneIds[i] < bones) carried[m.boneIds[i]] += m.boneWeights[i];
+
+        // Each bone's nearest ancestor among the skin's own
+        for (int b = 0; b < bones; ++b)
+            if (skin.bones[b].node >= 0 && skin.bones[b].node < nodeCount) boneOfNode[skin.bones[b].node] = b;
+        std::vector<int> parentBone(bones, -1);
+        for (int b = 0; b < bones; ++b) {
+            if (skin.bones[b].node < 0 || skin.bones[b].node >= nodeCount) continue;
+            for (int n = scene.nodes[skin.bones[b].node].parent; n >= 0; n = scene.nodes[n].parent)
+                if (boneOfNode[n] >= 0) { parentBone[b] = boneOfNode[n]; break; }
+        }
+        for (const SceneBone& bone : skin.bones)
+            if (bone.node >= 0 && bone.node < nodeCount) boneOfNode[bone.node] = -1;
+
+        // Parents before children (nodes are numbered so), and heaviest first
+        std::vector<int> order(bones), heaviest(bones);
+        for (int b = 0; b < bones; ++b) order[b] = heaviest[b] = b;
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return skin.bones[a].node < skin.bones[b].node; });
+        std::stable_sort(heaviest.begin(), heaviest.end(), [&](int a, int b) { return carried[a] > carried[b]; });
+
+        skin.lodBones.assign(SKIN_LOD_LEVELS, std::vector<uint8_t>(bones));
+        std::vector<uint8_t> keep(bones);
+        for (int level = 0; level < SKIN_LOD_LEVELS; ++level) {
+            const int kept = std::max(1, (bones + (1 << level) - 1) >> level);
+            std::fill(keep.begin(), keep.end(), 0);
+            for (int i = 0; i < kept; ++i) keep[heaviest[i]] = 1;
+            std::vector<uint8_t>& posedAs = skin.lodBones[level];
+            for (const int b : order) {
+                const int parent = parentBone[b];
+                posedAs[b] = keep[b] || parent < 0 ? (uint8_t)b : posedAs[parent];
+                if (posedAs[b] != b) continue;
+                // A posed bone needs its node's ancestors too
+                for (int n = skin.bones[b].node; n >= 0 && n < nodeCount && !needed[level][n]; n = scene.nodes[n].parent)
+                    needed[level][n] = 1;
+            }
+        }
+    }
+
+    scene.poseNodes.assign(SKIN_LOD_LEVELS, {});
+    for (int level = 0; level < SKIN_LOD_LEVELS; ++level)
+        for (int n = 0; n < nodeCount; ++n)
+            if (needed[level][n]) scene.poseNodes[level].push_back(n);
+}
+
 // ─── Assimp material → raylib Material ───────────────────────────────────────
+//
+// In three steps: ReadMaterial() takes the values and texture paths from
+// Assimp (what a cooked scene keeps), DecodeTextures() loads the texture
+// files (both on any thread), UploadMaterial() makes the raylib Material
+// and its textures (main thread).  Textures go through the AssetCache, so
+// scenes sharing a texture file upload it once, and a texture still loaded
+// isn't decoded again.
+
+struct MaterialDesc {
+    struct MapTexture {
+        int                   map;       // material map index
+        std::string           path;
+        Image                 image;     // decoded, until uploaded
+        Assets::TextureHandle texture;   // instead, when the cache had it
+    };
+    CookedMaterial          info;
+    bool                    used = false;   // by a mesh that is kept
+    std::vector<MapTexture> textures;
+};
 
-static Material AiMaterialToRaylibMaterial(const aiMaterial* aim,
-                                            const std::string& basePath) {
-    Material mat = LoadMaterialDefault();
+static CookedMaterial ReadMaterial(const aiMaterial* aim) {
+    CookedMaterial desc;
+    desc.name = aim->GetName().C_Str();
 
     // Diffuse / base color
     aiColor4D diffuse(1,1,1,1);
     if (AI_SUCCESS == aim->Get(AI_MATKEY_COLOR_DIFFUSE, diffuse)) {
-        mat.maps[MATERIAL_MAP_DIFFUSE].color = {
+        desc.diffuse = Color{
             (unsigned char)(diffuse.r * 255),
             (unsigned char)(diffuse.g * 255),
             (unsigned char)(diffuse.b * 255),
@@ -286,7 +722,7 @@ static Material AiMaterialToRaylibMaterial(const aiMaterial* aim,
     // PBR base color (GLTF)
     aiColor4D base(1,1,1,1);
     if (AI_SUCCESS == aim->Get(AI_MATKEY_BASE_COLOR, base)) {
-        mat.maps[MATERIAL_MAP_DIFFUSE].color = {
+        desc.diffuse = Color{
             (unsigned char)(base.r * 255),
             (unsigned char)(base.g * 255),
             (unsigned char)(base.b * 255),
@@ -295,16 +731,13 @@ static Material AiMaterialToRaylibMaterial(const aiMaterial* aim,
     }
 
     // Metallic / roughness
-    float metallic = 0.f, roughness = 1.f;
-    aim->Get(AI_MATKEY_METALLIC_FACTOR,  metallic);
-    aim->Get(AI_MATKEY_ROUGHNESS_FACTOR, roughness);
-    mat.maps[MATERIAL_MAP_ROUGHNESS].value = roughness;
-    mat.maps[MATERIAL_MAP_METALNESS].value = metallic;
+    aim->Get(AI_MATKEY_METALLIC_FACTOR,  desc.metallic);
+    aim->Get(AI_MATKEY_ROUGHNESS_FACTOR, desc.roughness);
 
     // Emissive
     aiColor3D emissive(0,0,0);
     if (AI_SUCCESS == aim->Get(AI_MATKEY_COLOR_EMISSIVE, emissive)) {
-        mat.maps[MATERIAL_MAP_EMISSION].color = {
+        desc.emissive = Color{
             (unsigned char)(emissive.r * 255),
             (unsigned char)(emissive.g * 255),
             (unsigned char)(emissive.b * 255),
@@ -312,28 +745,60 @@ static Material AiMaterialToRaylibMaterial(const aiMaterial* aim,
         };
     }
 
-    auto loadTex = [&](aiTextureType type, int mapIndex) {
+    auto addTex = [&](aiTextureType type, int mapIndex) {
         aiString texPath;
-        if (AI_SUCCESS == aim->GetTexture(type, 0, &texPath)) {
-            std::string tp(texPath.C_Str());
-            // Assimp embedded textures start with '*'
-            if (!tp.empty() && tp[0] != '*') {
-                std::string full = basePath + "/" + tp;
-                if (FileExists(full.c_str())) {
-                    mat.maps[mapIndex].texture = LoadTexture(full.c_str());
-                }
-            }
-        }
+        if (AI_SUCCESS != aim->GetTexture(type, 0, &texPath)) return;
+        std::string tp(texPath.C_Str());
+        // Assimp embedded textures start with '*'
+        if (!tp.empty() && tp[0] != '*') desc.textures.push_back({ mapIndex, tp });
     };
 
-    loadTex(aiTextureType_DIFFUSE,     MATERIAL_MAP_DIFFUSE);
-    loadTex(aiTextureType_BASE_COLOR,  MATERIAL_MAP_DIFFUSE);
-    loadTex(aiTextureType_NORMALS,     MATERIAL_MAP_NORMAL);
-    loadTex(aiTextureType_EMISSIVE,    MATERIAL_MAP_EMISSION);
-    loadTex(aiTextureType_METALNESS,   MATERIAL_MAP_METALNESS);
-    loadTex(aiTextureType_DIFFUSE_ROUGHNESS, MATERIAL_MAP_ROUGHNESS);
-    loadTex(aiTextureType_AMBIENT_OCCLUSION, MATERIAL_MAP_OCCLUSION);
+    addTex(aiTextureType_DIFFUSE,     MATERIAL_MAP_DIFFUSE);
+    addTex(aiTextureType_BASE_COLOR,  MATERIAL_MAP_DIFFUSE);
+    addTex(aiTextureType_NORMALS,     MATERIAL_MAP_NORMAL);
+    addTex(aiTextureType_EMISSIVE,    MATERIAL_MAP_EMISSION);
+    addTex(aiTextureType_METALNESS,   MATERIAL_MAP_METALNESS);
+    addTex(aiTextureType_DIFFUSE_ROUGHNESS, MATERIAL_MAP_ROUGHNESS);
+    addTex(aiTextureType_AMBIENT_OCCLUSION, MATERIAL_MAP_OCCLUSION);
+    return desc;
+}
+
+// The textures that exist next to the scene; of two for one map, the later
+static void DecodeTextures(MaterialDesc& desc, const std::string& basePath, const std::string& cookDir) {
+    for (const auto& [mapIndex, tp] : desc.info.textures) {
+        std::string full = basePath + "/" + tp;
+        if (!Assets::FileExists(full)) continue;
+        MaterialDesc::MapTexture tex{ mapIndex, full, {}, Assets::AssetCache::Get().FindTexture(full) };
+        if (!tex.texture) {
+            tex.image = Assets::LoadTextureImage(full, cookDir);   // raylib reads through the Vfs
+            if (!tex.image.data) continue;
+        }
+        auto it = std::find_if(desc.textures.begin(), desc.textures.end(),
+                               [&](const auto& entry) { return entry.map == mapIndex; });
+        if (it == desc.textures.end()) {
+            desc.textures.push_back(std::move(tex));
+        } else {
+            UnloadImage(it->image);
+            *it = std::move(tex);
+        }
+    }
+}
 
+// `desc`'s images are handed to the AssetCache (which uploads and frees
+// them); the textures' handles are added to `textures`
+static Material UploadMaterial(MaterialDesc& desc, std::vector<Assets::TextureHandle>& textures) {
+    Material mat = LoadMaterialDefault();
+    if (desc.info.diffuse)  mat.maps[MATERIAL_MAP_DIFFUSE].color  = *desc.info.diffuse;
+    if (desc.info.emissive) mat.maps[MATERIAL_MAP_EMISSION].color = *desc.info.emissive;
+    mat.maps[MATERIAL_MAP_ROUGHNESS].value = desc.info.roughness;
+    mat.maps[MATERIAL_MAP_METALNESS].value = desc.info.metallic;
+    for (auto& tex : desc.textures) {
+        if (!tex.texture) tex.texture = Assets::AssetCache::Get().AddTexture(tex.path, tex.image);
+        if (!tex.texture) continue;
+        mat.maps[tex.map].texture = *tex.texture;
+        textures.push_back(std::move(tex.texture));
+    }
+    desc.textures.clear();
     return mat;
 }
 
@@ -397,17 +862,58 @@ static SceneLight ExtractLight(const aiLight* alight, const aiScene* scene) {
     return sl;
 }
 
+// ─── Baked lighting (SceneImportOptions::bakeLighting) ────────────────────────
+
+// `map` on the GPU, in a copy of `sm`'s material of its own, drawn with the
+// lightmapped shader; the texels are freed
+static void UploadLightmap(ImportedScene& scene, SceneMesh& sm, GFX::Lightmap& map) {
+    Image image = { map.texels.data(), map.width, map.height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    Texture2D lightmap = LoadTextureFromImage(image);
+    map.texels = {};
+    if (lightmap.id == 0) return;
+    SetTextureFilter(lightmap, TEXTURE_FILTER_BILINEAR);
+    SetTextureWrap(lightmap, TEXTURE_WRAP_CLAMP);
+
+    Material mat = LoadMaterialDefault();
+    for (int i = 0; i <= MATERIAL_MAP_BRDF; ++i) mat.maps[i] = sm.mat.maps[i];
+    std::memcpy(mat.params, sm.mat.params, sizeof(mat.params));
+    mat.maps[GFX::LIGHTMAP_MATERIAL_MAP].texture = lightmap;
+    const Shader& shader = GFX::LightingSystem::Get().GetLightmappedShader();
+    if (shader.id != 0) mat.shader = shader;
+
+    sm.mat      = mat;
+    sm.lightmap = (int)scene.lightmaps.size();
+    scene.lightmaps.push_back(lightmap);
+}
+
+// ─── Levels of detail (SceneImportOptions::lodLevels) ─────────────────────────
+
+// A MeshView per level built by GFX::BuildLODChain; `sm.mesh` is uploaded
+static void UploadLODs(SceneMesh& sm, const std::vector<GFX::MeshLOD>& chain) {
+    for (const GFX::MeshLOD& lod : chain) {
+        SceneLOD out;
+        if (!out.view.Init(sm.mesh)) break;
+        out.view.Set(lod.indices.data(), (int)lod.indices.size());
+        out.view.Upload();
+        out.error = lod.error;
+        sm.lods.push_back(std::move(out));
+    }
+}
+
 // ─── Node tree walk ───────────────────────────────────────────────────────────
 
 struct BuildContext {
     const aiScene*        ai_scene;
     ImportedScene*        out;
-    const std::string&    basePath;
-    const SceneImportOptions& opts;
     // Map from Assimp mesh index → index in out->meshes
     std::unordered_map<unsigned int, int> meshIndexMap;
+    // The Assimp mesh and material index of each of out->meshes
+    std::vector<const aiMesh*> sources;
+    std::vector<unsigned int>  materialOf;
 };
 
+// Builds the node list and a SceneMesh (name and transform; converted
+// afterwards) per Assimp mesh
 static int WalkNode(const aiNode* node, int parentIdx,
                     const aiMatrix4x4& parentTm, BuildContext& ctx) {
     // Compute world transform
@@ -417,6 +923,7 @@ static int WalkNode(const aiNode* node, int parentIdx,
     SceneNode sn;
     sn.name      = node->mName.C_Str();
     sn.transform = rlTm;
+    sn.local     = Ai2Matrix(node->mTransformation);
     sn.parent    = parentIdx;
     sn.properties = MetadataToPropertyBag(node->mMetaData);
 
@@ -428,32 +935,17 @@ static int WalkNode(const aiNode* node, int parentIdx,
         unsigned int aimIdx = node->mMeshes[mi];
         auto it = ctx.meshIndexMap.find(aimIdx);
         if (it == ctx.meshIndexMap.end()) {
-            // First time we see this Assimp mesh — convert it
+            // First time we see this Assimp mesh
             const aiMesh* aim = ctx.ai_scene->mMeshes[aimIdx];
 
             SceneMesh sm;
             sm.name      = aim->mName.C_Str();
-            sm.mesh      = AiMeshToRaylibMesh(aim);
             sm.transform = rlTm;
-            if (ctx.ai_scene->mNumMaterials > aim->mMaterialIndex)
-                sm.mat = AiMaterialToRaylibMaterial(
-                    ctx.ai_scene->mMaterials[aim->mMaterialIndex], ctx.basePath);
-            else
-                sm.mat = LoadMaterialDefault();
-
-            // Register physics (uses raylib mesh data we just built)
-            if (ctx.opts.registerPhysics && sm.mesh.vertexCount > 0) {
-                // Build a temporary single-mesh Model to pass into RegisterStaticMeshFromModel
-                Model tmp = {0};
-                tmp.meshCount = 1;
-                tmp.meshes    = &sm.mesh;
-                // Extract world position from matrix for the physics offset
-                Vector3 pos = { rlTm.m12, rlTm.m13, rlTm.m14 };
-                sm.physicsHandle = Physics::RegisterStaticMeshFromModel(tmp, pos);
-            }
 
             int smIdx = (int)ctx.out->meshes.size();
             ctx.meshIndexMap[aimIdx] = smIdx;
+            ctx.sources.push_back(aim);
+            ctx.materialOf.push_back(std::min(aim->mMaterialIndex, ctx.ai_scene->mNumMaterials));
             ctx.out->meshes.push_back(std::move(sm));
             ctx.out->nodes[nodeIdx].meshNames.push_back(
                 ctx.out->meshes[smIdx].name.empty()
@@ -474,22 +966,278 @@ static int WalkNode(const aiNode* node, int parentIdx,
     return nodeIdx;
 }
 
-// ─── SceneImporter::Load ──────────────────────────────────────────────────────
+// ─── Static batching (SceneImportOptions::mergeByMaterial) ───────────────────
+
+// `members` baked into world space as one mesh, vertices in member order; a
+// SceneSubMesh per member goes to `parts`.  Attributes any member has are
+// given to all, with defaults where a member lacks them — but lightmap UVs
+// only when every member has them, each member's squeezed into a cell of
+// a square grid over the merged mesh's lightmap.
+static Mesh BakeMerged(const ImportedScene& scene, const std::vector<int>& members,
+                       std::vector<SceneSubMesh>& parts) {
+    bool hasNormals = false, hasTexcoords = false, hasTangents = false, hasColors = false;
+    bool hasTexcoords2 = !members.empty();
+    int  vertexCount = 0, indexCount = 0;
+    for (int m : members) {
+        const Mesh& src = scene.meshes[m].mesh;
+        hasNormals    |= src.normals    != nullptr;
+        hasTexcoords  |= src.texcoords  != nullptr;
+        hasTexcoords2 &= src.texcoords2 != nullptr;
+        hasTangents   |= src.tangents   != nullptr;
+        hasColors     |= src.colors     != nullptr;
+        vertexCount   += src.vertexCount;
+        indexCount    += src.indices ? src.triangleCount * 3 : src.vertexCount;
+    }
+    // Lightmap cells, and the margin kept inside each against bleeding
+    const int   cells  = (int)ceilf(sqrtf((float)members.size()));
+    const float margin = 0.02f;
+
+    Mesh out = {0};
+    out.vertexCount   = vertexCount;
+    out.triangleCount = indexCount / 3;
+    out.vertices = (float*)MemAlloc(vertexCount * 3 * sizeof(float));
+    out.indices  = (unsigned short*)MemAlloc(indexCount * sizeof(unsigned short));
+    if (hasNormals)   out.normals   = (float*)MemAlloc(vertexCount * 3 * sizeof(float));
+    if (hasTexcoords) out.texcoords = (float*)MemAlloc(vertexCount * 2 * sizeof(float));
+    if (hasTexcoords2) out.texcoords2 = (float*)MemAlloc(vertexCount * 2 * sizeof(float));
+    if (hasTangents)  out.tangents  = (float*)MemAlloc(vertexCount * 4 * sizeof(float));
+    if (hasColors)    out.colors    = (unsigned char*)MemAlloc(vertexCount * 4 * sizeof(unsigned char));
+
+    int v = 0, ix = 0;
+    for (int m : members) {
+        const int cell = (int)parts.size();
+        const Vector2 cellMin = { (float)(cell % cells) + margin, (float)(cell / cells) + margin };
+        const SceneMesh& sm  = scene.meshes[m];
+        const Mesh&      src = sm.mesh;
+        // Directions take the linear part; normals its inverse transpose.  A
+        // mirroring transform flips the winding as well.
+        Matrix linear = sm.transform;
+        linear.m12 = linear.m13 = linear.m14 = 0.f;
+        const Matrix normalTm = MatrixTranspose(MatrixInvert(linear));
+        const bool   mirrored = MatrixDeterminant(linear) < 0.f;
+
+        for (int i = 0; i < src.vertexCount; ++i, ++v) {
+            const Vector3 p = Vector3Transform({ src.vertices[i*3], src.vertices[i*3+1], src.vertices[i*3+2] },
+                                               sm.transform);
+            out.vertices[v*3+0] = p.x; out.vertices[v*3+1] = p.y; out.vertices[v*3+2] = p.z;
+            if (hasNormals) {
+                Vector3 n = { 0.f, 1.f, 0.f };
+                if (src.normals)
+                    n = Vector3Normalize(Vector3Transform({ src.normals[i*3], src.normals[i*3+1], src.normals[i*3+2] },
+                                                          normalTm));
+                out.normals[v*3+0] = n.x; out.normals[v*3+1] = n.y; out.normals[v*3+2] = n.z;
+            }
+            if (hasTexcoords) {
+                out.texcoords[v*2+0] = src.texcoords ? src.texcoords[i*2+0] : 0.f;
+                out.texcoords[v*2+1] = src.texcoords ? src.texcoords[i*2+1] : 0.f;
+            }
+            if (hasTexcoords2) {
+                const float u = Clamp(src.texcoords2[i*2+0], 0.f, 1.f), w = Clamp(src.texcoords2[i*2+1], 0.f, 1.f);
+                out.texcoords2[v*2+0] = (cellMin.x + u * (1.f - 2.f * margin)) / (float)cells;
+                out.texcoords2[v*2+1] = (cellMin.y + w * (1.f - 2.f * margin)) / (float)cells;
+            }
+            if (hasTangents) {
+                Vector3 t = { 1.f, 0.f, 0.f };
+                float   w = 1.f;
+                if (src.tangents) {
+                    t = Vector3Normalize(Vector3Transform({ src.tangents[i*4], src.tangents[i*4+1], src.tangents[i*4+2] },
+                                                          linear));
+                    w = src.tangents[i*4+3];
+                }
+                out.tangents[v*4+0] = t.x; out.tangents[v*4+1] = t.y; out.tangents[v*4+2] = t.z;
+                out.tangents[v*4+3] = w;
+            }
+            if (hasColors) {
+                for (int c = 0; c < 4; ++c)
+                    out.colors[v*4+c] = src.colors ? src.colors[i*4+c] : 255;
+            }
+        }
 
-std::unique_ptr<ImportedScene> SceneImporter::Load(
-        const std::string& path,
-        const SceneImportOptions& opts)
-{
-    // Resolve asset path (handles build/ prefix search, etc.)
-    std::string resolved = ResolveAssetPath(path);
-    const std::string& loadPath = resolved.empty() ? path : resolved;
+        SceneSubMesh part;
+        part.name       = sm.name;
+        part.firstIndex = ix;
+        const int base  = v - src.vertexCount;
+        const int tris  = src.indices ? src.triangleCount : src.vertexCount / 3;
+        for (int t = 0; t < tris; ++t) {
+            int a = t*3, b = t*3+1, c = t*3+2;
+            if (src.indices) { a = src.indices[a]; b = src.indices[b]; c = src.indices[c]; }
+            if (mirrored) std::swap(b, c);
+            out.indices[ix++] = (unsigned short)(base + a);
+            out.indices[ix++] = (unsigned short)(base + b);
+            out.indices[ix++] = (unsigned short)(base + c);
+        }
+        part.indexCount = ix - part.firstIndex;
+        part.box        = GFX::TransformBox(GetMeshBoundingBox(src), sm.transform);
+        parts.push_back(std::move(part));
+    }
+    out.triangleCount = ix / 3;
+    return out;
+}
 
-    if (!FileExists(loadPath.c_str())) {
-        TraceLog(LOG_ERROR, "SceneImporter: file not found: %s", loadPath.c_str());
-        return nullptr;
+// Replace scene.meshes with one world-space mesh per material (more past
+// 65535 vertices), the source meshes kept as parts.  materialOf[i] is
+// meshes[i]'s material, and afterwards the merged mesh's.  CPU only.
+static void MergeByMaterial(ImportedScene& scene, std::vector<unsigned int>& materialOf,
+                            const std::vector<CookedMaterial>& materials) {
+    std::vector<unsigned int>                              order;
+    std::unordered_map<unsigned int, std::vector<int>>     groups;
+    for (int i = 0; i < (int)scene.meshes.size(); ++i) {
+        if (scene.meshes[i].mesh.vertexCount == 0 || !scene.meshes[i].skin.Empty()) continue;
+        auto& group = groups[materialOf[i]];
+        if (group.empty()) order.push_back(materialOf[i]);
+        group.push_back(i);
     }
 
+    std::vector<SceneMesh>    merged;
+    std::vector<unsigned int> mergedMaterial;
+    for (unsigned int material : order) {
+        const std::vector<int>& members = groups[material];
+
+        std::vector<std::vector<int>> chunks(1);
+        int vertices = 0;
+        for (int m : members) {
+            const int n = scene.meshes[m].mesh.vertexCount;
+            if (vertices + n > 65535 && !chunks.back().empty()) {
+                chunks.emplace_back();
+                vertices = 0;
+            }
+            chunks.back().push_back(m);
+            vertices += n;
+        }
+
+        std::string name = material < materials.size() ? materials[material].name : "";
+        if (name.empty()) name = "material_" + std::to_string(material);
+
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            SceneMesh sm;
+            sm.name = c == 0 ? name : name + "#" + std::to_string(c);
+            sm.mesh = BakeMerged(scene, chunks[c], sm.parts);
+            merged.push_back(std::move(sm));
+            mergedMaterial.push_back(material);
+        }
+    }
+
+    const int batches = (int)merged.size();
+
+    // Skinned meshes move with their bones: kept whole, after the batches
+    for (int i = 0; i < (int)scene.meshes.size(); ++i) {
+        SceneMesh& sm = scene.meshes[i];
+        if (sm.mesh.vertexCount == 0 || sm.skin.Empty()) continue;
+        merged.push_back(std::move(sm));
+        mergedMaterial.push_back(materialOf[i]);
+        sm.mesh = {0};   // now merged's
+    }
+
+    for (auto& sm : scene.meshes) FreeMeshData(sm.mesh);
+    TraceLog(LOG_INFO, "SceneImporter: merged %d meshes into %d by material",
+             (int)scene.meshes.size(), batches);
+    scene.meshes = std::move(merged);
+    materialOf   = std::move(mergedMaterial);
+}
+
+// ─── Background loading ───────────────────────────────────────────────────────
+//
+// Everything up to the GPU runs on a private pool (kept apart from
+// JobSystem::Get() so a long parse never lands on a thread that is waiting
+// on frame work): Assimp's parse, mesh conversion, texture decoding, the
+// merge, LOD chains and the cull tree.  Then SceneLoad::Pump() hands the
+// result to the GPU a piece at a time on the main thread: each material,
+// then each mesh with its views and collision mesh.
+
+enum class LoadPhase { Decoding, Uploading, Done, Failed };
+
+struct SceneLoad::State {
+    std::string        path;
+    SceneImportOptions opts;
+
+    std::atomic<LoadPhase> phase{LoadPhase::Decoding};
+    std::atomic<bool>      cancelled{false};
+    std::atomic<int>       decodeDone{0}, decodeTotal{1};   // steps, for Progress()
+    std::string            error;   // set before phase turns Failed
+
+    // Written by the decode until phase turns Uploading, then main thread only
+    std::unique_ptr<ImportedScene>         scene;      // meshes not uploaded yet
+    std::vector<MaterialDesc>              materials;  // Assimp's, then the default one
+    std::vector<unsigned int>              materialOf; // per mesh, into materials
+    std::vector<std::vector<GFX::MeshLOD>> lods;       // per mesh
+    GFX::BakedLighting                     baked;      // lightmaps until uploaded
+    std::vector<int>                       lightmapOf; // per mesh, into baked.lightmaps or -1
+
+    // Upload progress, main thread
+    std::vector<Material> uploaded;   // per materials entry; maps null until uploaded
+    size_t                nextMaterial = 0, nextMesh = 0;
+
+    // Whatever is left on the CPU; the GPU side is ~SceneLoad()'s
+    ~State() {
+        for (auto& desc : materials)
+            for (auto& tex : desc.textures) UnloadImage(tex.image);
+        if (scene)
+            for (auto& sm : scene->meshes) FreeMeshData(sm.mesh);
+    }
+};
+
+static Jobs::JobSystem& LoaderJobs() {
+    static Jobs::JobSystem s_jobs(std::max(1u, std::thread::hardware_concurrency() / 2));
+    return s_jobs;
+}
+
+static void Fail(SceneLoad::State& s, std::string error) {
+    TraceLog(LOG_ERROR, "SceneImporter: %s", error.c_str());
+    s.error = std::move(error);
+    s.phase.store(LoadPhase::Failed, std::memory_order_release);
+}
+
+// Assimp's file access for scenes inside mounted .cup archives; the
+// scene's own side files (an .obj's .mtl, a .gltf's .bin) come along
+class VfsIOStream : public Assimp::IOStream {
+public:
+    explicit VfsIOStream(Assets::FileView file) : m_file(std::move(file)) {}
+
+    size_t Read(void* buffer, size_t size, size_t count) override {
+        if (size == 0) return 0;
+        const size_t n = std::min(count, (m_file.size - m_pos) / size);
+        std::memcpy(buffer, m_file.data + m_pos, n * size);
+        m_pos += n * size;
+        return n;
+    }
+    size_t Write(const void*, size_t, size_t) override { return 0; }
+    aiReturn Seek(size_t offset, aiOrigin origin) override {
+        // Offsets back from the current position or the end arrive wrapped
+        const size_t base = origin == aiOrigin_SET ? 0 : origin == aiOrigin_CUR ? m_pos : m_file.size;
+        const size_t pos  = base + offset;
+        if (pos > m_file.size) return aiReturn_FAILURE;
+        m_pos = pos;
+        return aiReturn_SUCCESS;
+    }
+    size_t Tell() const override { return m_pos; }
+    size_t FileSize() const override { return m_file.size; }
+    void   Flush() override {}
+
+private:
+    Assets::FileView m_file;
+    size_t           m_pos = 0;
+};
+
+class VfsIOSystem : public Assimp::IOSystem {
+public:
+    bool Exists(const char* file) const override { return Assets::FileExists(file); }
+    char getOsSeparator() const override { return '/'; }
+    Assimp::IOStream* Open(const char* file, const char* mode) override {
+        if (std::strchr(mode, 'w') || std::strchr(mode, 'a')) return nullptr;
+        Assets::FileView f = Assets::ReadFile(file);
+        return f ? new VfsIOStream(std::move(f)) : nullptr;
+    }
+    void Close(Assimp::IOStream* stream) override { delete stream; }
+};
+
+// Assimp's reading of `loadPath`, as far as a cooked scene keeps it.  False
+// when it failed (and s is marked so) or the load was cancelled.
+static bool ImportWithAssimp(SceneLoad::State& s, const std::string& loadPath, CookedScene& out) {
+    HOTONES_ZONE("SceneImporter::Assimp");
+    const SceneImportOptions& opts = s.opts;
     Assimp::Importer importer;
+    if (Assets::Vfs::Get().Exists(loadPath))
+        importer.SetIOHandler(new VfsIOSystem);   // the importer owns it
 
     // Scale
     if (opts.scale != 1.0f)
@@ -501,42 +1249,382 @@ std::unique_ptr<ImportedScene> SceneImporter::Load(
         aiProcess_SortByPType            |
         aiProcess_GlobalScale;
 
-    if (opts.generateNormals)
-        flags |= aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace;
-    if (opts.flipUVs)
-        flags |= aiProcess_FlipUVs;
+    if (opts.geometryOnly) {
+        // Positions and faces only; the rest is dropped before Assimp works
+        // on it, and vertices that differed only in it are joined
+        importer.SetPropertyInteger(AI_CONFIG_PP_RC_FLAGS,
+            aiComponent_NORMALS | aiComponent_TANGENTS_AND_BITANGENTS | aiComponent_COLORS |
+            aiComponent_TEXCOORDS | aiComponent_BONEWEIGHTS | aiComponent_ANIMATIONS |
+            aiComponent_TEXTURES | aiComponent_MATERIALS);
+        flags |= aiProcess_RemoveComponent;
+    } else {
+        if (opts.generateNormals)
+            flags |= aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace;
+        if (opts.flipUVs)
+            flags |= aiProcess_FlipUVs;
+        // Skins within what the skinned shader takes
+        importer.SetPropertyInteger(AI_CONFIG_PP_SBBC_MAX_BONES, MAX_SKIN_BONES);
+        flags |= aiProcess_LimitBoneWeights | aiProcess_SplitByBoneCount;
+    }
 
     const aiScene* aisc = importer.ReadFile(loadPath, flags);
     if (!aisc || (aisc->mFlags & AI_SCENE_FLAGS_INCOMPLETE) || !aisc->mRootNode) {
-        TraceLog(LOG_ERROR, "SceneImporter: Assimp error: %s", importer.GetErrorString());
-        return nullptr;
+        Fail(s, std::string("Assimp error: ") + importer.GetErrorString());
+        return false;
     }
+    if (s.cancelled.load(std::memory_order_relaxed)) return false;
 
-    auto scene = std::make_unique<ImportedScene>();
-    scene->path = loadPath;
+    out.scene = std::make_unique<ImportedScene>();
+    ImportedScene& scene = *out.scene;
+
+    // ── Lights ───────────────────────────────────────────────────────────────
+    for (unsigned int i = 0; i < aisc->mNumLights; ++i)
+        scene.lights.push_back(ExtractLight(aisc->mLights[i], aisc));
+
+    // ── Node tree ─────────────────────────────────────────────────────────────
+    aiMatrix4x4 identity;
+    BuildContext ctx{ aisc, &scene, {}, {}, {} };
+    int rootIdx = WalkNode(aisc->mRootNode, -1, identity, ctx);
+    scene.rootNodes.push_back(rootIdx);
+    out.materialOf = std::move(ctx.materialOf);
+
+    std::unordered_map<std::string, int> nodeByName;   // the first of a name
+    for (int n = 0; n < (int)scene.nodes.size(); ++n) nodeByName.emplace(scene.nodes[n].name, n);
+
+    // ── Animations ────────────────────────────────────────────────────────────
+    for (unsigned int a = 0; a < aisc->mNumAnimations; ++a)
+        scene.animations.push_back(ReadAnimation(aisc->mAnimations[a], nodeByName));
+
+    // ── Materials ─────────────────────────────────────────────────────────────
+    if (opts.geometryOnly)
+        std::fill(out.materialOf.begin(), out.materialOf.end(), 0u);   // all the default one
+    else
+        for (unsigned int m = 0; m < aisc->mNumMaterials; ++m)
+            out.materials.push_back(ReadMaterial(aisc->mMaterials[m]));
+
+    // ── Meshes ────────────────────────────────────────────────────────────────
+    LoaderJobs().ParallelFor(scene.meshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end && !s.cancelled.load(std::memory_order_relaxed); ++i) {
+            scene.meshes[i].mesh = AiMeshToRaylibMesh(ctx.sources[i]);
+            scene.meshes[i].skin = AiBonesToSkin(ctx.sources[i], scene.meshes[i].mesh, nodeByName);
+        }
+    });
+    return true;
+}
+
+// Runs on the loader pool (or the caller, for Load())
+static void Decode(SceneLoad::State& s) {
+    HOTONES_ZONE("SceneImporter::Decode");
+    const SceneImportOptions& opts = s.opts;
+
+    // Resolve asset path (handles build/ prefix search, etc.)
+    std::string resolved = ResolveAssetPath(s.path);
+    const std::string& loadPath = resolved.empty() ? s.path : resolved;
+
+    if (!Assets::FileExists(loadPath)) {
+        Fail(s, "file not found: " + loadPath);
+        return;
+    }
+
+    // The cooked scene when it is up to date, else Assimp's (cooked for next
+    // time).  Geometry-only loads take a full cooked copy as well, leaving
+    // out what they don't keep.
+    CookedScene       cooked;
+    bool              fromCook = false;
+    const uint64_t    cookKey  = opts.cookDir.empty() ? 0 : SceneCookKey(loadPath, opts);
+    const std::string cookPath = cookKey ? SceneCookPath(opts.cookDir, cookKey) : std::string();
+    if (cookKey && opts.geometryOnly) {
+        SceneImportOptions full = opts;
+        full.geometryOnly = false;
+        const uint64_t fullKey = SceneCookKey(loadPath, full);
+        fromCook = LoadCookedScene(SceneCookPath(opts.cookDir, fullKey), fullKey, cooked, true);
+    }
+    if (cookKey && !fromCook) fromCook = LoadCookedScene(cookPath, cookKey, cooked, opts.geometryOnly);
+    const bool        imported = fromCook || ImportWithAssimp(s, loadPath, cooked);
+    s.scene = std::move(cooked.scene);   // freed with the State if the load stops early
+    if (!imported || s.cancelled.load(std::memory_order_relaxed)) return;
+    if (cookKey && !fromCook && !StoreCookedScene(cookPath, cookKey, *s.scene, cooked.materials, cooked.materialOf))
+        TraceLog(LOG_WARNING, "SceneImporter: could not write cooked scene to %s", opts.cookDir.c_str());
+
+    ImportedScene& scene = *s.scene;
+    scene.path          = loadPath;
+    scene.lodPixelError = opts.lodPixelError;
 
     // Base path for texture resolution
     std::string basePath;
     size_t sep = loadPath.find_last_of("/\\");
     if (sep != std::string::npos) basePath = loadPath.substr(0, sep);
 
-    // ── Lights ───────────────────────────────────────────────────────────────
-    for (unsigned int i = 0; i < aisc->mNumLights; ++i)
-        scene->lights.push_back(ExtractLight(aisc->mLights[i], aisc));
+    // Steps: the read, then a material each, the merge or a LOD chain each,
+    // and the bake
+    const bool buildLODs = opts.lodLevels > 0 && !opts.mergeByMaterial && !opts.geometryOnly;
+    const bool bake      = opts.bakeLighting && !opts.geometryOnly;
+    s.decodeTotal.store(1 + (int)cooked.materials.size() +
+                        (opts.mergeByMaterial ? 1 : buildLODs ? (int)scene.meshes.size() : 0) + (bake ? 1 : 0));
+    s.decodeDone.store(1);
 
-    // ── Node tree + meshes ────────────────────────────────────────────────────
-    aiMatrix4x4 identity;
-    BuildContext ctx{ aisc, scene.get(), basePath, opts, {} };
-    int rootIdx = WalkNode(aisc->mRootNode, -1, identity, ctx);
-    scene->rootNodes.push_back(rootIdx);
+    Jobs::JobSystem& jobs = LoaderJobs();
+    const auto cancelled = [&s] { return s.cancelled.load(std::memory_order_relaxed); };
 
-    TraceLog(LOG_INFO, "SceneImporter: loaded '%s' — %d meshes, %d nodes, %d lights",
-             loadPath.c_str(),
-             (int)scene->meshes.size(),
-             (int)scene->nodes.size(),
-             (int)scene->lights.size());
+    PrepareSkins(scene);
 
-    return scene;
+    // ── Static batching ───────────────────────────────────────────────────────
+    if (opts.mergeByMaterial) {
+        MergeByMaterial(scene, cooked.materialOf, cooked.materials);
+        s.decodeDone.fetch_add(1, std::memory_order_relaxed);
+    }
+    s.materialOf = std::move(cooked.materialOf);
+
+    // ── Materials (those still in use), the default one last ──────────────────
+    s.materials.resize(cooked.materials.size() + 1);
+    for (size_t m = 0; m < cooked.materials.size(); ++m) s.materials[m].info = std::move(cooked.materials[m]);
+    for (unsigned int m : s.materialOf) s.materials[m].used = true;
+    jobs.ParallelFor(s.materials.size() - 1, 1, [&](size_t begin, size_t end) {
+        for (size_t m = begin; m < end && !cancelled(); ++m) {
+            if (s.materials[m].used && !opts.geometryOnly) DecodeTextures(s.materials[m], basePath, opts.textureCookDir);
+            s.decodeDone.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    if (cancelled()) return;
+
+    // ── Levels of detail ──────────────────────────────────────────────────────
+    s.lods.resize(scene.meshes.size());
+    if (buildLODs) {
+        jobs.ParallelFor(scene.meshes.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end && !cancelled(); ++i) {
+                // Skinned meshes keep their weights by skipping the simplifier
+                if (scene.meshes[i].mesh.vertexCount > 0 && scene.meshes[i].skin.Empty())
+                    s.lods[i] = GFX::BuildLODChain(scene.meshes[i].mesh, opts.lodLevels, opts.lodReduction,
+                                                   opts.lodCacheDir);
+                s.decodeDone.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        if (cancelled()) return;
+    }
+
+    // ── Baked lighting ────────────────────────────────────────────────────────
+    s.lightmapOf.assign(scene.meshes.size(), -1);
+    if (bake) {
+        s.baked = GFX::BakeLighting(scene, opts.lightBake, &jobs);
+        for (int l = 0; l < (int)s.baked.lightmaps.size(); ++l) s.lightmapOf[s.baked.lightmaps[l].mesh] = l;
+        scene.probes = std::move(s.baked.probes);
+        s.decodeDone.fetch_add(1, std::memory_order_relaxed);
+        if (cancelled()) return;
+    }
+
+    scene.BuildCullTree();
+    scene.BuildNodeIndex();
+    TraceLog(LOG_INFO, "SceneImporter: read '%s' %s", loadPath.c_str(),
+             fromCook ? "from its cooked copy" : "with Assimp");
+    s.phase.store(LoadPhase::Uploading, std::memory_order_release);
+}
+
+// One piece of the upload; false once there is nothing left
+static bool UploadStep(SceneLoad::State& s) {
+    ImportedScene& scene = *s.scene;
+    const SceneImportOptions& opts = s.opts;
+
+    if (!!opts.geometryOnly) s.nextMaterial = s.materials.size();
+    if (s.nextMaterial < s.materials.size()) {
+        MaterialDesc& desc = s.materials[s.nextMaterial];
+        if (s.uploaded.empty()) s.uploaded.resize(s.materials.size(), Material{});
+        if (desc.used) s.uploaded[s.nextMaterial] = UploadMaterial(desc, scene.textures);
+        s.nextMaterial++;
+        return true;
+    }
+
+    if (s.nextMesh < scene.meshes.size()) {
+        const size_t i  = s.nextMesh++;
+        SceneMesh&   sm = scene.meshes[i];
+        if (!opts.geometryOnly) {
+            if (sm.mesh.vertexCount > 0) UploadMesh(&sm.mesh, false);
+            sm.mat = s.uploaded[s.materialOf[i]];
+            if (s.lightmapOf[i] >= 0) UploadLightmap(scene, sm, s.baked.lightmaps[s.lightmapOf[i]]);
+            if (sm.parts.size() > 1) sm.view.Init(sm.mesh);
+            UploadLODs(sm, s.lods[i]);
+            s.lods[i] = {};
+        }
+
+        // Merged scenes register once, when every mesh is up; skinned meshes
+        // move, and never collide
+        if (opts.registerPhysics && !opts.mergeByMaterial && sm.mesh.vertexCount > 0 && sm.skin.Empty()) {
+            // Build a temporary single-mesh Model to pass into RegisterStaticMeshFromModel
+            Model tmp = {0};
+            tmp.meshCount = 1;
+            tmp.meshes    = &sm.mesh;
+            // Extract world position from matrix for the physics offset
+            Vector3 pos = { sm.transform.m12, sm.transform.m13, sm.transform.m14 };
+            sm.physicsHandle = Physics::RegisterStaticMeshFromModel(tmp, pos);
+        }
+        return true;
+    }
+
+    // Merged meshes are already in world space: one collision mesh over all
+    if (opts.mergeByMaterial && opts.registerPhysics && !scene.meshes.empty()) {
+        std::vector<Mesh> all;
+        for (const auto& sm : scene.meshes)
+            if (sm.skin.Empty()) all.push_back(sm.mesh);
+        Model tmp = {0};
+        tmp.meshCount = (int)all.size();
+        tmp.meshes    = all.data();
+        scene.physicsHandle = Physics::RegisterStaticMeshFromModel(tmp, Vector3{ 0.f, 0.f, 0.f });
+    }
+
+    TraceLog(LOG_INFO, "SceneImporter: loaded '%s' — %d meshes, %d nodes, %d lights, %d animations",
+             scene.path.c_str(),
+             (int)scene.meshes.size(),
+             (int)scene.nodes.size(),
+             (int)scene.lights.size(),
+             (int)scene.animations.size());
+    return false;
+}
+
+SceneLoad::SceneLoad(std::shared_ptr<State> state) : m_state(std::move(state)) {}
+
+SceneLoad::~SceneLoad() {
+    State& s = *m_state;
+    s.cancelled.store(true, std::memory_order_relaxed);
+    const LoadPhase phase = s.phase.load(std::memory_order_acquire);
+    if ((phase != LoadPhase::Uploading && phase != LoadPhase::Done) || !s.scene) return;
+
+    // Undo what was uploaded; the decode's CPU leftovers go with the State
+    for (size_t i = 0; i < s.nextMesh; ++i) UnloadSceneMesh(s.scene->meshes[i]);
+    for (Material& mat : s.uploaded)
+        if (mat.maps) UnloadSceneMaterial(mat);
+    s.uploaded.clear();
+    if (s.scene->physicsHandle != -1) Physics::UnregisterStaticMesh(s.scene->physicsHandle);
+    s.scene.reset();
+}
+
+bool SceneLoad::Pump(float budgetMs) {
+    State& s = *m_state;
+    const LoadPhase phase = s.phase.load(std::memory_order_acquire);
+    if (phase != LoadPhase::Uploading) return phase != LoadPhase::Decoding;
+
+    HOTONES_ZONE("SceneLoad::Pump");
+    const auto start = std::chrono::steady_clock::now();
+    do {
+        if (!UploadStep(s)) {
+            s.phase.store(LoadPhase::Done, std::memory_order_release);
+            return true;
+        }
+    } while (std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() < budgetMs);
+    return false;
+}
+
+bool SceneLoad::IsDone() const {
+    const LoadPhase phase = m_state->phase.load(std::memory_order_acquire);
+    return phase == LoadPhase::Done || phase == LoadPhase::Failed;
+}
+
+bool SceneLoad::Failed() const {
+    return m_state->phase.load(std::memory_order_acquire) == LoadPhase::Failed;
+}
+
+float SceneLoad::Progress() const {
+    const State& s = *m_state;
+    switch (s.phase.load(std::memory_order_acquire)) {
+        case LoadPhase::Decoding:
+            return 0.5f * (float)s.decodeDone.load(std::memory_order_relaxed) /
+                   (float)std::max(1, s.decodeTotal.load(std::memory_order_relaxed));
+        case LoadPhase::Uploading: {
+            const size_t total = s.materials.size() + s.scene->meshes.size();
+            return 0.5f + 0.5f * (float)(s.nextMaterial + s.nextMesh) / (float)std::max<size_t>(total, 1);
+        }
+        case LoadPhase::Done:   return 1.f;
+        case LoadPhase::Failed: return 0.f;
+    }
+    return 0.f;
+}
+
+std::string SceneLoad::Error() const {
+    return Failed() ? m_state->error : std::string();
+}
+
+std::unique_ptr<ImportedScene> SceneLoad::Take() {
+    if (m_state->phase.load(std::memory_order_acquire) != LoadPhase::Done) return nullptr;
+    m_state->uploaded.clear();   // the scene's meshes own them now
+    return std::move(m_state->scene);
+}
+
+// ─── SceneImporter::Load / LoadAsync / Cook ───────────────────────────────────
+
+std::shared_ptr<SceneLoad> SceneImporter::LoadAsync(
+        const std::string& path,
+        const SceneImportOptions& opts)
+{
+    auto state  = std::make_shared<SceneLoad::State>();
+    state->path = path;
+    state->opts = opts;
+    LoaderJobs().Submit([state] { Decode(*state); });
+    return std::make_shared<SceneLoad>(state);
+}
+
+std::unique_ptr<ImportedScene> SceneImporter::Load(
+        const std::string& path,
+        const SceneImportOptions& opts)
+{
+    auto state  = std::make_shared<SceneLoad::State>();
+    state->path = path;
+    state->opts = opts;
+    Decode(*state);
+    SceneLoad load(state);
+    load.Pump(std::numeric_limits<float>::infinity());
+    return load.Take();
+}
+
+std::shared_ptr<const ImportedScene> SceneImporter::Share(std::unique_ptr<ImportedScene> scene)
+{
+    if (!scene) return nullptr;
+    return std::shared_ptr<const ImportedScene>(scene.release(), [](const ImportedScene* s) {
+        const_cast<ImportedScene*>(s)->Unload();
+        delete s;
+    });
+}
+
+bool SceneImporter::Cook(
+        const std::string& path,
+        const SceneImportOptions& opts)
+{
+    std::string resolved = ResolveAssetPath(path);
+    const std::string& loadPath = resolved.empty() ? path : resolved;
+    const uint64_t key = opts.cookDir.empty() ? 0 : SceneCookKey(loadPath, opts);
+    if (key == 0) {
+        TraceLog(LOG_ERROR, "SceneImporter: can't cook %s (no such file, or no cookDir)", loadPath.c_str());
+        return false;
+    }
+
+    SceneLoad::State state;
+    state.path = path;
+    state.opts = opts;
+    CookedScene cooked;
+    const bool imported = ImportWithAssimp(state, loadPath, cooked);
+    state.scene = std::move(cooked.scene);   // its meshes are freed with the State
+    if (!imported) return false;
+    if (!StoreCookedScene(SceneCookPath(opts.cookDir, key), key, *state.scene, cooked.materials, cooked.materialOf)) {
+        TraceLog(LOG_ERROR, "SceneImporter: could not write cooked scene to %s", opts.cookDir.c_str());
+        return false;
+    }
+
+    // Its lighting, baked over the meshes a load makes of it
+    if (opts.bakeLighting && !opts.geometryOnly && !opts.lightBake.cacheDir.empty()) {
+        std::vector<unsigned int> materialOf = cooked.materialOf;
+        if (opts.mergeByMaterial) MergeByMaterial(*state.scene, materialOf, cooked.materials);
+        GFX::BakeLighting(*state.scene, opts.lightBake, &LoaderJobs());
+    }
+
+    // Its textures too, so the first load decodes no PNGs either
+    if (opts.geometryOnly || opts.textureCookDir.empty()) return true;
+    const size_t sep = loadPath.find_last_of("/\\");
+    const std::string basePath = sep != std::string::npos ? loadPath.substr(0, sep) : std::string();
+    for (const CookedMaterial& material : cooked.materials) {
+        for (const auto& [mapIndex, tp] : material.textures) {
+            const std::string full = basePath + "/" + tp;
+            if (Assets::FileExists(full) && !Assets::CookTexture(full, opts.textureCookDir))
+                TraceLog(LOG_WARNING, "SceneImporter: could not cook texture %s", full.c_str());
+        }
+    }
+    return true;
 }
 
 } // namespace Hotones
@@ -1,13 +1,20 @@
 #include <GFX/ScriptedScene.hpp>
 #include <GFX/CollidableModel.hpp>
+#include <GFX/DynamicResolution.hpp>
 #include <GFX/LightingSystem.hpp>
 #include <GFX/Player.hpp>
+#include <Profile/Profiler.hpp>
 #include <ECS/Components.hpp>
+#include <ECS/BuiltinSystems.hpp>
+#include <SFX/SpatialAudioSystem.hpp>
 #include <Scripting/CupLoader.hpp>
 #include <Scripting/LuaLoader/ECS.hpp>
+#include <Scripting/LuaLoader/MeshGen.hpp>
+#include <Scripting/ScriptSystem.hpp>
 #include <server/NetworkManager.hpp>
 #include <raylib.h>
 #include <raymath.h>
+#include <rlgl.h>
 
 namespace Hotones {
 
@@ -45,6 +52,27 @@ void ScriptedScene::Init()
     Hotones::Scripting::LuaLoader::setECSRegistry(&m_registry);
     Hotones::Scripting::LuaLoader::setECSLocalPlayer(&m_player);
 
+    // Lua mesh.* solids are collected and drawn instanced after draw3D()
+    m_primitives.Init();
+    Hotones::Scripting::LuaLoader::setMeshBatch(&m_primitives);
+
+    // Built-in ECS systems; the scheduler runs non-conflicting ones in parallel.
+    m_systems.Clear();
+    if (m_script) {   // first: scripts set this tick's velocities
+        m_scripts = &m_systems.Add<Scripting::ScriptSystem>(*m_script);
+        Hotones::Scripting::LuaLoader::setECSScriptSystem(m_scripts);
+    }
+    m_systems.Add<ECS::MovementSystem>();
+    m_systems.Add<ECS::PhysicsSystem>();   // after MovementSystem: collides this frame's step
+    m_systems.Add<ECS::LifetimeSystem>();
+    m_systems.Add<ECS::HierarchySystem>();   // after the movers: children follow this tick's parents
+    m_animation = &m_systems.Add<GFX::AnimationSystem>();   // after the hierarchy: characters posed where they stand
+    m_particles = &m_systems.Add<GFX::ParticleSystem>();   // after the movers: emitters follow this tick
+    m_audio = &m_systems.Add<Ho_tones::SpatialAudioSystem>();   // after the movers: this tick's positions
+    m_spatial = &m_systems.Add<ECS::SpatialIndex>();   // after the movers: files this tick's positions
+    Hotones::Scripting::LuaLoader::setECSSpatialIndex(m_spatial);
+    m_systems.Init(m_registry);
+
     // Initialise lighting (idempotent; safe if already done).
     auto& ls = GFX::LightingSystem::Get();
     if (!ls.IsReady()) ls.Init();
@@ -57,67 +85,199 @@ void ScriptedScene::Init()
         // Patch every material in the world model to use the lighting shader.
         if (ls.IsReady()) m_world->SetShader(ls.GetShader());
     }
+    // The world casts cached shadows, ECS models are redrawn every frame
+    m_shadowCasters.drawStatic = [this](const GFX::Frustum& f, GFX::RenderQueue& q) {
+        if (m_world) m_world->Draw(f, q);
+    };
+    m_shadowCasters.drawDynamic = [this](const GFX::Frustum& f, GFX::RenderQueue& q) {
+        m_models.Draw(m_states[m_front].models, f, q);
+    };
+    ls.GetShadowAtlas().InvalidateStatic();
+    m_occlusion.Init();
     // If no world model, the player will fall through.  The fallback ground
     // plane drawn in DrawFallbackGround() is purely visual — pack authors who
     // want solid ground should either provide a MainScene or add collision via
     // scripted physics (future).
 }
 
-void ScriptedScene::Update()
+void ScriptedScene::FixedUpdate(float dt)
 {
-    m_player.Update();
+    m_player.FixedUpdate(dt);
 
     // ── ECS tick ──────────────────────────────────────────────────────────────
-    const float dt = GetFrameTime();
+    // Transforms written since the last scheduler run (update(), draw3D(),
+    // replication) are only known until the tick advances
+    if (m_spatial) m_spatial->Sync(m_registry);
+    m_registry.AdvanceTick(); // Changed<T> queries see this tick's writes only
 
     // Keep TransformComponent in sync with the engine player's live position
     // so Lua can read ecs.getPos(playerEntityId) and get an up-to-date value.
+    // Only marked changed when the player actually moved.
     m_registry.Each<ECS::PlayerComponent>(
         [&](ECS::EntityId id, ECS::PlayerComponent& pc) {
             if (!pc.player) return;
-            if (m_registry.HasComponent<ECS::TransformComponent>(id))
-                m_registry.GetComponent<ECS::TransformComponent>(id).position =
-                    pc.player->body.position;
+            if (!m_registry.HasComponent<ECS::TransformComponent>(id)) return;
+            const Vector3 pos = pc.player->body.position;
+            const Vector3 cur = m_registry.GetComponent<ECS::TransformComponent>(id).position;
+            if (pos.x != cur.x || pos.y != cur.y || pos.z != cur.z)
+                m_registry.GetMut<ECS::TransformComponent>(id).position = pos;
         });
 
-    // Tick lifetime components and collect expired entities.
-    std::vector<ECS::EntityId> toDestroy;
-    m_registry.Each<ECS::LifetimeComponent>(
-        [&](ECS::EntityId id, ECS::LifetimeComponent& lt) {
-            lt.remaining -= dt;
-            if (lt.remaining <= 0.0f) toDestroy.push_back(id);
-        });
-    for (auto id : toDestroy) m_registry.DestroyEntity(id);
+    // Emitters are heard from the camera, moving with the player
+    if (m_audio)
+        m_audio->SetListener(m_camera.position, Vector3Subtract(m_camera.target, m_camera.position),
+                             m_camera.up, m_player.body.velocity);
+
+    // Far entity scripts are throttled by their distance to the player
+    if (m_scripts) m_scripts->SetFocus(m_player.body.position);
+
+    // Far and unseen characters are posed less often, with fewer bones
+    if (m_animation)
+        m_animation->SetView(m_camera, (float)GetScreenWidth() / (float)GetScreenHeight());
+
+    // Entity scripts, velocity integration, lifetime countdown, emitter audio etc.;
+    // structural changes are flushed per stage.
+    m_systems.Update(m_registry, dt);
+    m_registryBytes.Set(m_registry.MemoryStats().TotalBytes());
+}
+
+void ScriptedScene::Update()
+{
+    m_player.Update();
 
     if (m_script) m_script->update();
+
+    // Hosting: send this frame's entity changes; they leave with the next
+    // snapshot tick
+    if (m_netMgr && m_netMgr->GetMode() == Net::NetworkManager::Mode::Server)
+        m_replicator.Replicate(m_registry, *m_netMgr);
+
+    // Pipelined: the state the next frame draws, while this one is drawn
+    if (m_pipelined) CaptureRenderState(m_states[1 - m_front]);
+}
+
+void ScriptedScene::CaptureRenderState(RenderState& state)
+{
+    // On the simulation thread when pipelined: nothing here may touch GL
+    HOTONES_ZONE("Capture render state");
+    state.camera = m_camera;
+    state.models.clear();
+    GFX::ModelRenderSystem::Capture(m_registry, state.models);
+    if (m_particles) m_particles->Capture(state.particles);
+    else             state.particles.Clear();
+    if (m_animation) m_animation->Capture(state.characters);
+    else             state.characters.Clear();
+
+    state.scene3D.Clear();
+    state.hud.Clear();
+    if (m_script) {
+        {
+            GFX::DrawList::Scope record(state.scene3D);
+            m_script->draw3D();
+        }
+        GFX::DrawList::Scope record(state.hud);
+        m_script->draw();
+    }
+}
+
+void ScriptedScene::SetPipelined(bool on)
+{
+    m_pipelined = on;
+    // Lights follow the snapshot: published with it, not when drawn
+    GFX::LightingSystem::Get().SetManualPublish(on);
+    if (on) {
+        CaptureRenderState(m_states[m_front]);
+        GFX::LightingSystem::Get().Publish();
+    }
+}
+
+void ScriptedScene::PublishRenderState()
+{
+    if (!m_pipelined) return;
+    m_front = 1 - m_front;
+    GFX::LightingSystem::Get().Publish();
 }
 
 void ScriptedScene::Draw()
 {
+    if (!m_pipelined) CaptureRenderState(m_states[m_front]);
+    const RenderState& state  = m_states[m_front];
+    const Camera&      camera = state.camera;
+
+    // The 3-D pass, into a scaled target when dynamic resolution has one;
+    // the shadow and occlusion passes come back to it, and the lights'
+    // clusters are laid over it
+    GFX::DynamicResolution& resolution = GFX::DynamicResolution::Get();
+    resolution.Begin3D();
     ClearBackground(BLACK);
 
-    // Upload light uniforms so the world model's shader has fresh data this frame.
+    // Shadow maps, then light uniforms, so the world model's shader has
+    // fresh data this frame.
     {
+        HOTONES_ZONE("Shadows");
+        HOTONES_GPU_ZONE("Shadows");
         auto& ls = GFX::LightingSystem::Get();
-        if (ls.IsReady()) ls.UploadUniforms(m_camera);
+        if (ls.IsReady()) {
+            ls.RenderShadows(camera, m_shadowCasters);
+            ls.UploadUniforms(camera, rlGetFramebufferWidth(), rlGetFramebufferHeight());
+        }
+    }
+
+    // What the camera can see; meshes and entities outside it are skipped
+    const float        aspect  = (float)GetScreenWidth() / (float)GetScreenHeight();
+    const GFX::Frustum frustum = GFX::Frustum::FromCamera(camera, aspect);
+
+    // Last frame's occluders become this frame's Hi-Z; this frame's are
+    // drawn for the next
+    {
+        HOTONES_ZONE("Occlusion");
+        HOTONES_GPU_ZONE("Occlusion");
+        m_occlusion.Render(camera, aspect, [this](const GFX::Frustum& f, GFX::RenderQueue& q) {
+            if (m_world) m_world->DrawOccluders(f, q);
+        });
     }
 
-    BeginMode3D(m_camera);
+    BeginMode3D(camera);
 
-        // World model (loaded from Init.MainScene)
-        if (m_world) {
-            m_world->Draw();
+        // World model (loaded from Init.MainScene; a ".bsp" one is also PVS
+        // culled from the camera), ECS models and characters, less what the
+        // occlusion pass hid, one draw call per shared mesh, sorted together
+        // by shader / material / depth
+        {
+            HOTONES_ZONE("World");
+            HOTONES_GPU_ZONE("World");
+            m_queue.Begin(camera.position);
+            if (m_world) {
+                m_world->Draw(camera.position, frustum, m_queue, &m_occlusion);
+            }
+            m_models.Draw(state.models, frustum, m_queue, &m_occlusion);
+            if (m_animation) m_animation->Draw(state.characters, frustum, m_queue, &m_occlusion);
+            m_queue.Flush();
+            HOTONES_COUNTER("Occluded", (double)m_occlusion.GetStats().occluded);
         }
 
         // ── Lua 3D pass ───────────────────────────────────────────────────────
-        // draw3D() is called HERE, inside BeginMode3D. mesh.* calls go directly
-        // to raylib 3D primitives so they render into the 3D scene correctly.
-        if (m_script) m_script->draw3D();
+        // What draw3D() drew when the state was captured, replayed HERE,
+        // inside BeginMode3D. mesh.* solids are batched and drawn together;
+        // lines and wires go directly to raylib 3D primitives.
+        {
+            HOTONES_ZONE("Lua 3D");
+            HOTONES_GPU_ZONE("Lua 3D");
+            state.scene3D.Replay(&m_primitives);
+            m_primitives.Flush(camera.position);
+        }
+
+        // Particles last: translucent, over everything opaque
+        {
+            HOTONES_ZONE("Particles");
+            HOTONES_GPU_ZONE("Particles");
+            if (m_particles) m_particles->Draw(state.particles, camera, frustum);
+        }
 
         //TODO: make devs handle ghosts instead.
         // // Remote player ghosts
         // if (m_netMgr) {
-        //     for (auto& [id, rp] : m_netMgr->GetRemotePlayers()) {
+        //     for (const auto& rp : m_netMgr->GetRemotePlayers()) {
         //         if (!rp.active) continue;
         //         DrawCube({ rp.posX, rp.posY + 1.0f, rp.posZ },
         //                  0.6f, 2.0f, 0.6f, { 255, 80, 80, 200 });
@@ -129,26 +289,55 @@ void ScriptedScene::Draw()
         // }
 
     EndMode3D();
+    resolution.End3D();   // stretched over the screen, under the HUD
 
     // ── Lua 2D / HUD pass ─────────────────────────────────────────────────────
-    // draw() is called AFTER EndMode3D. render.* calls work correctly here and
-    // will appear on top of the 3D scene.
-    if (m_script) m_script->draw();
+    // draw()'s render.* calls are replayed AFTER EndMode3D, so they appear on
+    // top of the 3D scene.
+    state.hud.Replay(nullptr);
 }
 
 void ScriptedScene::Unload()
 {
     if (m_world) m_world.reset();
+    m_shadowCasters = {};
+    GFX::LightingSystem::Get().GetShadowAtlas().InvalidateStatic();
+    m_occlusion.Unload();
+    if (m_netMgr) m_replicator.Detach(*m_netMgr);
+    m_netMgr = nullptr;
+    m_replicator.Clear();
+    m_models.Clear();
+    for (RenderState& state : m_states) state = {};   // their model and texture handles
+    if (m_pipelined) SetPipelined(false);
+    m_systems.Shutdown(m_registry);
+    m_systems.Clear();
+    m_audio     = nullptr;
+    m_scripts   = nullptr;
+    m_particles = nullptr;
+    m_animation = nullptr;
+    m_spatial   = nullptr;
     m_registry.Clear();
+    m_registryBytes.Set(m_registry.MemoryStats().TotalBytes());
     // Null out the static pointer so stale Lua calls after scene teardown
     // are silently ignored rather than crashing.
     Hotones::Scripting::LuaLoader::setECSRegistry(nullptr);
     Hotones::Scripting::LuaLoader::setECSLocalPlayer(nullptr);
+    Hotones::Scripting::LuaLoader::setECSScriptSystem(nullptr);
+    Hotones::Scripting::LuaLoader::setECSSpatialIndex(nullptr);
+    Hotones::Scripting::LuaLoader::setMeshBatch(nullptr);
+    m_primitives.Unload();
 }
 
 void ScriptedScene::SetNetworkManager(Net::NetworkManager* nm)
 {
+    // Called when the scene becomes current; connected clients mirror the
+    // server's entities
+    if (nm != m_netMgr) {
+        if (m_netMgr) m_replicator.Detach(*m_netMgr);
+        if (nm) m_replicator.Attach(*nm, m_registry);
+    }
     m_netMgr = nm;
+    m_player.AttachNetwork(nm);
     if (m_script) m_script->setNetworkManager(nm);
 }
 
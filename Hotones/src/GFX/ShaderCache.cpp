@@ -0,0 +1,302 @@
+// ShaderCache.cpp — linked shader programs kept on disk.  File layout
+// (native byte order, checked on load):
+//
+//   ShaderCacheHeader                   32 bytes
+//   uint8_t binary[length]              glGetProgramBinary() output
+
+#include <GFX/ShaderCache.hpp>
+#include <rlgl.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+extern "C" __declspec(dllimport) void* __stdcall GetModuleHandleA(const char* name);
+extern "C" __declspec(dllimport) void* __stdcall GetProcAddress(void* module, const char* name);
+#define HOTONES_GLAPI __stdcall
+#else
+#include <dlfcn.h>
+#define HOTONES_GLAPI
+#endif
+
+namespace Hotones::GFX {
+
+namespace {
+
+// Bump when the layout below or the locations Load() fills in change
+constexpr uint32_t SHADER_CACHE_VERSION    = 1;
+constexpr uint32_t SHADER_CACHE_BYTE_ORDER = 0x01020304u;
+constexpr char     SHADER_CACHE_MAGIC[8]   = { 'H', 'O', 'S', 'H', 'B', 'I', 'N', '\0' };
+
+struct ShaderCacheHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t key;
+    uint32_t format;   // binaryFormat from glGetProgramBinary
+    uint32_t length;
+};
+static_assert(sizeof(ShaderCacheHeader) == 32, "shader cache header layout");
+
+// GL_ARB_get_program_binary (core in 4.1) and the GL 1.1/2.0 calls around
+// it; raylib doesn't expose its loader, so they're looked up like the
+// profiler's timer queries
+constexpr unsigned GL_VENDOR_                      = 0x1F00;
+constexpr unsigned GL_RENDERER_                    = 0x1F01;
+constexpr unsigned GL_VERSION_                     = 0x1F02;
+constexpr unsigned GL_PROGRAM_BINARY_LENGTH_       = 0x8741;
+constexpr unsigned GL_NUM_PROGRAM_BINARY_FORMATS_  = 0x87FE;
+constexpr unsigned GL_LINK_STATUS_                 = 0x8B82;
+
+using GetStringFn        = const unsigned char* (HOTONES_GLAPI*)(unsigned name);
+using GetIntegervFn      = void (HOTONES_GLAPI*)(unsigned pname, int* data);
+using CreateProgramFn    = unsigned (HOTONES_GLAPI*)();
+using GetProgramivFn     = void (HOTONES_GLAPI*)(unsigned program, unsigned pname, int* params);
+using GetProgramBinaryFn = void (HOTONES_GLAPI*)(unsigned program, int bufSize, int* length,
+                                                 unsigned* binaryFormat, void* binary);
+using ProgramBinaryFn    = void (HOTONES_GLAPI*)(unsigned program, unsigned binaryFormat,
+                                                 const void* binary, int length);
+
+struct GL {
+    GetStringFn        GetString        = nullptr;
+    GetIntegervFn      GetIntegerv      = nullptr;
+    CreateProgramFn    CreateProgram    = nullptr;
+    GetProgramivFn     GetProgramiv     = nullptr;
+    GetProgramBinaryFn GetProgramBinary = nullptr;
+    ProgramBinaryFn    ProgramBinary    = nullptr;
+};
+GL g_gl;
+
+void* GetGLProc(const char* name)
+{
+#if defined(_WIN32)
+    // Entry points past GL 1.1 only come from wglGetProcAddress, the 1.1
+    // ones only from opengl32.dll itself
+    using WglGetProcAddressFn = void* (__stdcall*)(const char*);
+    void* gl = GetModuleHandleA("opengl32.dll");
+    if (!gl) return nullptr;
+    const auto wglGetProc = reinterpret_cast<WglGetProcAddressFn>(GetProcAddress(gl, "wglGetProcAddress"));
+    void* proc = wglGetProc ? wglGetProc(name) : nullptr;
+    return proc ? proc : GetProcAddress(gl, name);
+#else
+    return dlsym(RTLD_DEFAULT, name);
+#endif
+}
+
+template<typename Fn>
+bool LoadProc(Fn& fn, const char* name)
+{
+    fn = reinterpret_cast<Fn>(GetGLProc(name));
+    return fn != nullptr;
+}
+
+// What LoadShaderFromMemory() does after linking: look up raylib's
+// default attribute and uniform names
+void SetDefaultLocations(Shader& shader)
+{
+    shader.locs = static_cast<int*>(RL_CALLOC(RL_MAX_SHADER_LOCATIONS, sizeof(int)));
+    for (int i = 0; i < RL_MAX_SHADER_LOCATIONS; ++i) shader.locs[i] = -1;
+
+    const unsigned id = shader.id;
+    shader.locs[SHADER_LOC_VERTEX_POSITION]   = rlGetLocationAttrib(id, RL_DEFAULT_SHADER_ATTRIB_NAME_POSITION);
+    shader.locs[SHADER_LOC_VERTEX_TEXCOORD01] = rlGetLocationAttrib(id, RL_DEFAULT_SHADER_ATTRIB_NAME_TEXCOORD);
+    shader.locs[SHADER_LOC_VERTEX_TEXCOORD02] = rlGetLocationAttrib(id, RL_DEFAULT_SHADER_ATTRIB_NAME_TEXCOORD2);
+    shader.locs[SHADER_LOC_VERTEX_NORMAL]     = rlGetLocationAttrib(id, RL_DEFAULT_SHADER_ATTRIB_NAME_NORMAL);
+    shader.locs[SHADER_LOC_VERTEX_TANGENT]    = rlGetLocationAttrib(id, RL_DEFAULT_SHADER_ATTRIB_NAME_TANGENT);
+    shader.locs[SHADER_LOC_VERTEX_COLOR]      = rlGetLocationAttrib(id, RL_DEFAULT_SHADER_ATTRIB_NAME_COLOR);
+#if defined(RL_DEFAULT_SHADER_ATTRIB_NAME_BONEIDS)
+    shader.locs[SHADER_LOC_VERTEX_BONEIDS]     = rlGetLocationAttrib(id, RL_DEFAULT_SHADER_ATTRIB_NAME_BONEIDS);
+    shader.locs[SHADER_LOC_VERTEX_BONEWEIGHTS] = rlGetLocationAttrib(id, RL_DEFAULT_SHADER_ATTRIB_NAME_BONEWEIGHTS);
+    shader.locs[SHADER_LOC_BONE_MATRICES]      = rlGetLocationUniform(id, RL_DEFAULT_SHADER_UNIFORM_NAME_BONE_MATRICES);
+#endif
+    shader.locs[SHADER_LOC_MATRIX_MVP]        = rlGetLocationUniform(id, RL_DEFAULT_SHADER_UNIFORM_NAME_MVP);
+    shader.locs[SHADER_LOC_MATRIX_VIEW]       = rlGetLocationUniform(id, RL_DEFAULT_SHADER_UNIFORM_NAME_VIEW);
+    shader.locs[SHADER_LOC_MATRIX_PROJECTION] = rlGetLocationUniform(id, RL_DEFAULT_SHADER_UNIFORM_NAME_PROJECTION);
+    shader.locs[SHADER_LOC_MATRIX_MODEL]      = rlGetLocationUniform(id, RL_DEFAULT_SHADER_UNIFORM_NAME_MODEL);
+    shader.locs[SHADER_LOC_MATRIX_NORMAL]     = rlGetLocationUniform(id, RL_DEFAULT_SHADER_UNIFORM_NAME_NORMAL);
+    shader.locs[SHADER_LOC_COLOR_DIFFUSE]     = rlGetLocationUniform(id, RL_DEFAULT_SHADER_UNIFORM_NAME_COLOR);
+    shader.locs[SHADER_LOC_MAP_DIFFUSE]       = rlGetLocationUniform(id, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE0);
+    shader.locs[SHADER_LOC_MAP_SPECULAR]      = rlGetLocationUniform(id, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE1);
+    shader.locs[SHADER_LOC_MAP_NORMAL]        = rlGetLocationUniform(id, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE2);
+}
+
+} // namespace
+
+ShaderCache& ShaderCache::Get()
+{
+    static ShaderCache s_instance;
+    return s_instance;
+}
+
+bool ShaderCache::Available()
+{
+    if (m_checked) return m_usable;
+    m_checked = true;
+
+    const int version = rlGetVersion();
+    if (version != RL_OPENGL_33 && version != RL_OPENGL_43) return false;
+    if (!LoadProc(g_gl.GetString, "glGetString") || !LoadProc(g_gl.GetIntegerv, "glGetIntegerv") ||
+        !LoadProc(g_gl.CreateProgram, "glCreateProgram") || !LoadProc(g_gl.GetProgramiv, "glGetProgramiv") ||
+        !LoadProc(g_gl.GetProgramBinary, "glGetProgramBinary") || !LoadProc(g_gl.ProgramBinary, "glProgramBinary")) {
+        g_gl = {};
+        return false;
+    }
+    int formats = 0;
+    g_gl.GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS_, &formats);
+    if (formats <= 0) {
+        TraceLog(LOG_INFO, "ShaderCache: driver offers no program binary formats, compiling every shader");
+        return false;
+    }
+
+    for (unsigned name : { GL_VENDOR_, GL_RENDERER_, GL_VERSION_ }) {
+        const unsigned char* s = g_gl.GetString(name);
+        if (s) m_driver += reinterpret_cast<const char*>(s);
+        m_driver += '\n';
+    }
+    m_usable = true;
+    return true;
+}
+
+// FNV-1a over the driver strings and both sources, with the terminators
+// so ("ab", "c") and ("a", "bc") differ
+uint64_t ShaderCache::Key(const char* vsCode, const char* fsCode) const
+{
+    uint64_t h = 14695981039346656037ull;
+    auto mix = [&](const char* s, size_t n) {
+        for (size_t i = 0; i < n; ++i) h = (h ^ static_cast<unsigned char>(s[i])) * 1099511628211ull;
+    };
+    mix(reinterpret_cast<const char*>(&SHADER_CACHE_VERSION), sizeof(SHADER_CACHE_VERSION));
+    mix(m_driver.c_str(), m_driver.size() + 1);
+    mix(vsCode ? vsCode : "", vsCode ? std::strlen(vsCode) + 1 : 1);
+    mix(fsCode ? fsCode : "", fsCode ? std::strlen(fsCode) + 1 : 1);
+    return h;
+}
+
+std::string ShaderCache::PathFor(uint64_t key) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.glbin", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(m_dir) / name).string();
+}
+
+Shader ShaderCache::Load(const char* vsCode, const char* fsCode)
+{
+    if (m_dir.empty() || !Available()) {
+        ++m_stats.compiled;
+        return LoadShaderFromMemory(vsCode, fsCode);
+    }
+
+    const uint64_t    key  = Key(vsCode, fsCode);
+    const std::string path = PathFor(key);
+    Shader shader = FromBinary(path, key);
+    if (shader.id != 0) {
+        ++m_stats.hits;
+        return shader;
+    }
+
+    ++m_stats.compiled;
+    shader = LoadShaderFromMemory(vsCode, fsCode);
+    // A failed compile hands back raylib's default shader; never cache that
+    if (shader.id != 0 && shader.id != rlGetShaderIdDefault()) {
+        if (Store(shader.id, path, key)) ++m_stats.stored;
+        else TraceLog(LOG_WARNING, "ShaderCache: could not write %s", path.c_str());
+    }
+    return shader;
+}
+
+Shader ShaderCache::FromBinary(const std::string& path, uint64_t key)
+{
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs) return {};
+    std::vector<char> file((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    ifs.close();
+
+    auto reject = [&] {
+        ++m_stats.rejected;
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        return Shader{};
+    };
+
+    ShaderCacheHeader hdr;
+    if (file.size() < sizeof(hdr)) return reject();
+    std::memcpy(&hdr, file.data(), sizeof(hdr));
+    if (std::memcmp(hdr.magic, SHADER_CACHE_MAGIC, sizeof(hdr.magic)) != 0 ||
+        hdr.version != SHADER_CACHE_VERSION || hdr.byteOrder != SHADER_CACHE_BYTE_ORDER ||
+        hdr.key != key || hdr.length == 0 || file.size() != sizeof(hdr) + hdr.length) return reject();
+
+    Shader shader = {};
+    shader.id = g_gl.CreateProgram();
+    if (shader.id == 0) return {};
+    g_gl.ProgramBinary(shader.id, hdr.format, file.data() + sizeof(hdr), static_cast<int>(hdr.length));
+    int linked = 0;
+    g_gl.GetProgramiv(shader.id, GL_LINK_STATUS_, &linked);
+    if (!linked) {
+        // Drivers may refuse their own binaries after an update the
+        // version string doesn't show
+        rlUnloadShaderProgram(shader.id);
+        TraceLog(LOG_INFO, "ShaderCache: driver rejected %s, compiling from source", path.c_str());
+        return reject();
+    }
+    SetDefaultLocations(shader);
+    return shader;
+}
+
+bool ShaderCache::Store(unsigned int program, const std::string& path, uint64_t key)
+{
+    // raylib links without GL_PROGRAM_BINARY_RETRIEVABLE_HINT; drivers
+    // return a binary anyway, and a length of 0 just leaves it uncached
+    int length = 0;
+    g_gl.GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH_, &length);
+    if (length <= 0) return false;
+    std::vector<char> binary(static_cast<size_t>(length));
+    unsigned format = 0;
+    int      written = 0;
+    g_gl.GetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) return false;
+
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::create_directories(m_dir, ec);
+    if (ec) return false;
+
+    ShaderCacheHeader hdr{};
+    std::memcpy(hdr.magic, SHADER_CACHE_MAGIC, sizeof(hdr.magic));
+    hdr.version   = SHADER_CACHE_VERSION;
+    hdr.byteOrder = SHADER_CACHE_BYTE_ORDER;
+    hdr.key       = key;
+    hdr.format    = format;
+    hdr.length    = static_cast<uint32_t>(written);
+
+    // Unique per writer, so two running clients don't interleave; the last
+    // rename wins with identical contents
+    const size_t salt = std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+                        static_cast<size_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    const std::string tmpPath = path + "." + std::to_string(salt) + ".tmp";
+    {
+        std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!ofs) return false;
+        ofs.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        ofs.write(binary.data(), written);
+        if (!ofs) {
+            ofs.close();
+            fs::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    fs::rename(tmpPath, path, ec);
+    if (ec) {
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace Hotones::GFX
@@ -0,0 +1,361 @@
+// ShadowAtlas.cpp — cached shadow-map tiles for LightingSystem
+
+#include <GFX/ShadowAtlas.hpp>
+#include <GFX/LightingSystem.hpp>
+#include <GFX/ShaderCache.hpp>
+#include <raylib.h>
+#include <raymath.h>
+#include <rlgl.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// ─── Embedded GLSL — depth-only shaders ──────────────────────────────────────
+
+static const char* kDepthVS = R"(
+#version 330
+in vec3 vertexPosition;
+uniform mat4 mvp;
+void main() { gl_Position = mvp * vec4(vertexPosition, 1.0); }
+)";
+
+static const char* kDepthInstancedVS = R"(
+#version 330
+in vec3 vertexPosition;
+in mat4 instanceTransform;
+uniform mat4 mvp;
+void main() { gl_Position = mvp * instanceTransform * vec4(vertexPosition, 1.0); }
+)";
+
+static const char* kDepthFS = R"(
+#version 330
+out vec4 finalColor;
+void main() { finalColor = vec4(1.0); }
+)";
+
+namespace Hotones::GFX {
+
+namespace {
+    constexpr float SHADOW_NEAR        = 0.05f;   // spot / point near plane
+    constexpr float CASTER_RANGE       = 50.0f;   // casters behind a cascade still caught
+    constexpr float CASCADE_VIEW_NEAR  = 0.5f;    // start of the log split scheme
+    constexpr float CASCADE_LAMBDA     = 0.75f;   // log / linear split blend
+    constexpr float CUBE_FACE_FOV      = 95.0f;   // a little over 90° so faces overlap for PCF
+    constexpr int   GL_DEPTH_BIT       = 0x00000100;   // GL_DEPTH_BUFFER_BIT
+
+    const Vector3 kCubeDirs[6] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+    const Vector3 kCubeUps[6]  = { { 0, -1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }, { 0, -1, 0 }, { 0, -1, 0 } };
+
+    int TilesFor(LightType type) {
+        switch (type) {
+        case LightType::Directional: return SHADOW_CASCADES;
+        case LightType::Spot:        return 1;
+        case LightType::Point:       return 6;
+        }
+        return 0;
+    }
+
+    Vector3 UpFor(Vector3 dir) {
+        return fabsf(dir.y) > 0.99f ? Vector3{ 1.f, 0.f, 0.f } : Vector3{ 0.f, 1.f, 0.f };
+    }
+
+    // NDC → the tile's corner of the atlas, depth → 0–1
+    Matrix TileBias(int tile) {
+        const float s  = 0.5f / SHADOW_GRID;
+        const float ox = (float)(tile % SHADOW_GRID) / SHADOW_GRID + s;
+        const float oy = (float)(tile / SHADOW_GRID) / SHADOW_GRID + s;
+        return { s,   0.f, 0.f,  ox,
+                 0.f, s,   0.f,  oy,
+                 0.f, 0.f, 0.5f, 0.5f,
+                 0.f, 0.f, 0.f,  1.f };
+    }
+
+    bool SameMatrix(const Matrix& a, const Matrix& b) {
+        return std::memcmp(&a, &b, sizeof(Matrix)) == 0;
+    }
+
+    bool LoadDepthTarget(unsigned int& fbo, unsigned int& depth) {
+        fbo   = rlLoadFramebuffer();
+        depth = rlLoadTextureDepth(SHADOW_ATLAS_SIZE, SHADOW_ATLAS_SIZE, false);
+        if (fbo == 0 || depth == 0) return false;
+        rlFramebufferAttach(fbo, depth, RL_ATTACHMENT_DEPTH, RL_ATTACHMENT_TEXTURE2D, 0);
+        return rlFramebufferComplete(fbo);
+    }
+}
+
+bool ShadowAtlas::Init()
+{
+    if (m_ready) return true;
+
+    m_depthShader          = ShaderCache::Get().Load(kDepthVS, kDepthFS);
+    m_depthInstancedShader = ShaderCache::Get().Load(kDepthInstancedVS, kDepthFS);
+    if (m_depthShader.id == 0 || m_depthInstancedShader.id == 0
+        || !LoadDepthTarget(m_staticFbo, m_staticDepth) || !LoadDepthTarget(m_liveFbo, m_liveDepth)) {
+        TraceLog(LOG_WARNING, "ShadowAtlas: failed to create shadow targets; shadows disabled");
+        m_ready = true;   // so Unload() releases what did load
+        Unload();
+        return false;
+    }
+    m_depthInstancedShader.locs[SHADER_LOC_MATRIX_MODEL] =
+        GetShaderLocationAttrib(m_depthInstancedShader, "instanceTransform");
+
+    // Practical split scheme: log and linear blended
+    for (int i = 0; i < SHADOW_CASCADES; i++) {
+        const float t   = (float)(i + 1) / SHADOW_CASCADES;
+        const float lg  = CASCADE_VIEW_NEAR * powf(SHADOW_DISTANCE / CASCADE_VIEW_NEAR, t);
+        const float lin = CASCADE_VIEW_NEAR + (SHADOW_DISTANCE - CASCADE_VIEW_NEAR) * t;
+        m_splits[i] = CASCADE_LAMBDA * lg + (1.f - CASCADE_LAMBDA) * lin;
+    }
+
+    m_tiles.fill(Tile{});
+    m_first.clear();
+    m_ready = true;
+    TraceLog(LOG_INFO, "ShadowAtlas: ready (%dx%d atlas, %d tiles)", SHADOW_ATLAS_SIZE, SHADOW_ATLAS_SIZE, SHADOW_TILES);
+    return true;
+}
+
+void ShadowAtlas::Unload()
+{
+    if (!m_ready) return;
+    if (m_depthShader.id != 0)          UnloadShader(m_depthShader);
+    if (m_depthInstancedShader.id != 0) UnloadShader(m_depthInstancedShader);
+    // Also deletes the attached depth textures
+    if (m_staticFbo != 0) rlUnloadFramebuffer(m_staticFbo);
+    else if (m_staticDepth != 0) rlUnloadTexture(m_staticDepth);
+    if (m_liveFbo != 0) rlUnloadFramebuffer(m_liveFbo);
+    else if (m_liveDepth != 0) rlUnloadTexture(m_liveDepth);
+    m_depthShader = m_depthInstancedShader = {};
+    m_staticFbo = m_staticDepth = m_liveFbo = m_liveDepth = 0;
+    m_tiles.fill(Tile{});
+    m_first.clear();
+    m_ready = false;
+}
+
+void ShadowAtlas::InvalidateStatic()
+{
+    for (Tile& t : m_tiles)
+        if (t.owner >= 0) t.stale = true;
+}
+
+int ShadowAtlas::FirstTile(int slot) const
+{
+    return slot >= 0 && slot < (int)m_first.size() ? m_first[slot] : -1;
+}
+
+// ── Tile allocation ──────────────────────────────────────────────────────────
+
+void ShadowAtlas::Assign(const Camera& camera, const LightDesc* lights, int count)
+{
+    // Only the first shadow-casting directional light gets cascades
+    int sun = -1;
+    for (int i = 0; i < count && sun < 0; i++)
+        if (lights[i].enabled && lights[i].castsShadows && lights[i].type == LightType::Directional) sun = i;
+
+    const auto wants = [&](int i) {
+        const LightDesc& l = lights[i];
+        if (!l.enabled || !l.castsShadows) return 0;
+        if (l.type == LightType::Directional && i != sun) return 0;
+        return TilesFor(l.type);
+    };
+
+    // Release tiles whose light stopped casting or now needs a different set
+    std::vector<int> owned(count, 0);
+    for (const Tile& t : m_tiles)
+        if (t.owner >= 0 && t.owner < count) owned[t.owner]++;
+    for (Tile& t : m_tiles)
+        if (t.owner >= 0 && (t.owner >= count || owned[t.owner] != wants(t.owner))) t = Tile{};
+
+    // New casters, nearest first, into the first free run long enough
+    m_order.clear();
+    for (int i = 0; i < count; i++)
+        if (wants(i) > 0 && owned[i] != wants(i)) m_order.push_back(i);
+    std::sort(m_order.begin(), m_order.end(), [&](int a, int b) {
+        const auto key = [&](int i) {
+            return i == sun ? -1.f : Vector3DistanceSqr(lights[i].position, camera.position);
+        };
+        return key(a) < key(b);
+    });
+    for (int i : m_order) {
+        const int need = wants(i);
+        for (int start = 0; start + need <= SHADOW_TILES; start++) {
+            bool free = true;
+            for (int k = 0; k < need && free; k++) free = m_tiles[start + k].owner < 0;
+            if (!free) continue;
+            for (int k = 0; k < need; k++) {
+                m_tiles[start + k]       = Tile{};
+                m_tiles[start + k].owner = i;
+                m_tiles[start + k].face  = k;
+            }
+            break;
+        }
+    }
+}
+
+// ── Light-space views ────────────────────────────────────────────────────────
+
+void ShadowAtlas::Want(const Camera& camera, const LightDesc& light, Tile& tile) const
+{
+    if (light.type == LightType::Directional) {
+        // Sphere around the cascade's slice of the view, centre snapped to a
+        // coarse light-space grid so the cached tile survives small moves
+        const int     c      = tile.face;
+        const Vector3 fwd    = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+        const Vector3 centre = Vector3Add(camera.position, Vector3Scale(fwd, m_centre[c]));
+        const Vector3 lf     = Vector3Normalize(light.direction);
+        const Vector3 lr     = Vector3Normalize(Vector3CrossProduct(lf, UpFor(lf)));
+        const Vector3 lu     = Vector3CrossProduct(lr, lf);
+        const float   step   = m_radii[c] * 0.25f;
+        const float   extent = m_radii[c] + step;
+        const auto snap = [step](float v) { return floorf(v / step + 0.5f) * step; };
+        const Vector3 at = Vector3Add(Vector3Add(Vector3Scale(lr, snap(Vector3DotProduct(centre, lr))),
+                                                 Vector3Scale(lu, snap(Vector3DotProduct(centre, lu)))),
+                                      Vector3Scale(lf, snap(Vector3DotProduct(centre, lf))));
+        const Vector3 eye = Vector3Subtract(at, Vector3Scale(lf, extent + CASTER_RANGE));
+        tile.wantView = MatrixLookAt(eye, at, lu);
+        tile.wantProj = MatrixOrtho(-extent, extent, -extent, extent, 0.0, 2.0 * extent + CASTER_RANGE);
+        return;
+    }
+
+    const float farZ = std::max(light.range, SHADOW_NEAR * 2.f);
+    if (light.type == LightType::Spot) {
+        const Vector3 dir = Vector3Normalize(light.direction);
+        const float   fov = std::min(2.f * acosf(std::clamp(light.outerCos, -1.f, 1.f)) * RAD2DEG + 5.f, 170.f);
+        tile.wantView = MatrixLookAt(light.position, Vector3Add(light.position, dir), UpFor(dir));
+        tile.wantProj = MatrixPerspective(fov * DEG2RAD, 1.0, SHADOW_NEAR, farZ);
+        return;
+    }
+
+    tile.wantView = MatrixLookAt(light.position, Vector3Add(light.position, kCubeDirs[tile.face]), kCubeUps[tile.face]);
+    tile.wantProj = MatrixPerspective(CUBE_FACE_FOV * DEG2RAD, 1.0, SHADOW_NEAR, farZ);
+}
+
+// ── Rendering ────────────────────────────────────────────────────────────────
+
+void ShadowAtlas::DrawTile(int tile, const Matrix& view, const Matrix& proj, bool clear)
+{
+    const int x = (tile % SHADOW_GRID) * SHADOW_TILE_SIZE;
+    const int y = (tile / SHADOW_GRID) * SHADOW_TILE_SIZE;
+    rlViewport(x, y, SHADOW_TILE_SIZE, SHADOW_TILE_SIZE);
+    rlEnableScissorTest();
+    rlScissor(x, y, SHADOW_TILE_SIZE, SHADOW_TILE_SIZE);
+    if (clear) rlClearScreenBuffers();
+    rlSetMatrixModelview(view);
+    rlSetMatrixProjection(proj);
+    m_queue.Flush(m_depthShader, m_depthInstancedShader);
+    rlDrawRenderBatchActive();
+    rlDisableScissorTest();
+}
+
+void ShadowAtlas::Render(const Camera& camera, float aspect, const LightDesc* lights, int count,
+                         const ShadowCasters& casters)
+{
+    if (!m_ready) return;
+    m_stats = {};
+
+    // Cascade spheres: smallest around each slice of the view, centred on
+    // its axis; radii rounded up so they do not jitter between frames
+    const bool  ortho = camera.projection == CAMERA_ORTHOGRAPHIC;
+    const float halfH = ortho ? camera.fovy * 0.5f : tanf(camera.fovy * 0.5f * DEG2RAD);
+    const float halfW = halfH * aspect;
+    float a = 0.f;
+    for (int c = 0; c < SHADOW_CASCADES; c++) {
+        const float b  = m_splits[c];
+        const float wa = ortho ? halfW * halfW + halfH * halfH : (halfW * halfW + halfH * halfH) * a * a;
+        const float wb = ortho ? wa : (halfW * halfW + halfH * halfH) * b * b;
+        const float z  = std::clamp((wb - wa + b * b - a * a) / (2.f * (b - a)), a, b);
+        const float r  = sqrtf(std::max(wa + (z - a) * (z - a), wb + (z - b) * (z - b)));
+        m_centre[c] = z;
+        m_radii[c]  = ceilf(r * 2.f) * 0.5f;
+        a = b;
+    }
+
+    Assign(camera, lights, count);
+
+    // Out-of-date static tiles: never rendered first, then cascades near to
+    // far, then lights near to far
+    m_order.clear();
+    for (int i = 0; i < SHADOW_TILES; i++) {
+        Tile& t = m_tiles[i];
+        if (t.owner < 0) continue;
+        m_stats.tiles++;
+        const LightDesc& l = lights[t.owner];
+        Want(camera, l, t);
+        if (!t.ready || !SameMatrix(t.wantView, t.view) || !SameMatrix(t.wantProj, t.proj)) t.stale = true;
+        if (!t.stale) continue;
+        t.priority = l.type == LightType::Directional
+                   ? (float)t.face
+                   : SHADOW_CASCADES + Vector3Distance(l.position, camera.position);
+        if (!t.ready) t.priority -= 1e9f;
+        m_order.push_back(i);
+    }
+    std::sort(m_order.begin(), m_order.end(),
+              [&](int x, int y) { return m_tiles[x].priority < m_tiles[y].priority; });
+
+    const unsigned int target    = rlGetActiveFramebuffer();
+    const Matrix       savedProj = rlGetMatrixProjection();
+    const Matrix       savedView = rlGetMatrixModelview();
+    rlDrawRenderBatchActive();
+    rlEnableDepthTest();
+
+    // ── Static casters into the cached atlas, within budget ──────────────────
+    rlEnableFramebuffer(m_staticFbo);
+    for (int i : m_order) {
+        if (m_stats.renders >= m_budget) { m_stats.pending++; continue; }
+        Tile& t = m_tiles[i];
+        t.view   = t.wantView;
+        t.proj   = t.wantProj;
+        t.sample = MatrixMultiply(MatrixMultiply(t.view, t.proj), TileBias(i));
+        m_queue.Begin(lights[t.owner].position);
+        if (casters.drawStatic) casters.drawStatic(Frustum::FromMatrix(MatrixMultiply(t.view, t.proj)), m_queue);
+        DrawTile(i, t.view, t.proj, true);
+        t.ready  = true;
+        t.stale  = false;
+        t.copied = false;
+        m_stats.renders++;
+    }
+
+    // ── Live atlas: the cached tile, plus whatever dynamic casters reach it ──
+    for (int i = 0; i < SHADOW_TILES; i++) {
+        Tile& t = m_tiles[i];
+        if (t.owner < 0 || !t.ready) continue;
+        m_queue.Begin(lights[t.owner].position);
+        if (casters.drawDynamic) casters.drawDynamic(Frustum::FromMatrix(MatrixMultiply(t.view, t.proj)), m_queue);
+        const bool dynamic = m_queue.Size() > 0;
+        if (!dynamic && t.copied) continue;   // live copy already matches the cache
+
+        const int x = (i % SHADOW_GRID) * SHADOW_TILE_SIZE;
+        const int y = (i / SHADOW_GRID) * SHADOW_TILE_SIZE;
+        rlBindFramebuffer(RL_READ_FRAMEBUFFER, m_staticFbo);
+        rlBindFramebuffer(RL_DRAW_FRAMEBUFFER, m_liveFbo);
+        // glBlitFramebuffer corners, whatever rlgl calls the parameters
+        rlBlitFramebuffer(x, y, x + SHADOW_TILE_SIZE, y + SHADOW_TILE_SIZE,
+                          x, y, x + SHADOW_TILE_SIZE, y + SHADOW_TILE_SIZE, GL_DEPTH_BIT);
+        if (dynamic) {
+            rlEnableFramebuffer(m_liveFbo);
+            DrawTile(i, t.view, t.proj, false);
+            m_stats.dynamic++;
+        }
+        t.copied = !dynamic;
+    }
+
+    if (target != 0) rlEnableFramebuffer(target);
+    else             rlDisableFramebuffer();
+    rlViewport(0, 0, rlGetFramebufferWidth(), rlGetFramebufferHeight());
+    rlSetMatrixProjection(savedProj);
+    rlSetMatrixModelview(savedView);
+    rlDisableDepthTest();
+
+    // A light's shadow is usable once all its tiles have been rendered
+    m_first.assign(count, -1);
+    std::vector<char> incomplete(count, 0);
+    for (int i = 0; i < SHADOW_TILES; i++) {
+        const Tile& t = m_tiles[i];
+        if (t.owner < 0) continue;
+        if (!t.ready) incomplete[t.owner] = 1;
+        if (m_first[t.owner] < 0) m_first[t.owner] = i;
+    }
+    for (int i = 0; i < count; i++)
+        if (incomplete[i]) m_first[i] = -1;
+}
+
+} // namespace Hotones::GFX
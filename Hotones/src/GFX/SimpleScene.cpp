@@ -1,4 +1,5 @@
 #include <GFX/SimpleScene.hpp>
+#include <Time/FrameClock.hpp>
 
 namespace Hotones {
 
@@ -11,7 +12,7 @@ void SimpleScene::Init() {}
 
 void SimpleScene::Update()
 {
-    elapsed += GetFrameTime();
+    elapsed += Time::FrameClock::Get().Delta();
     if (elapsed >= duration) MarkFinished();
 }
 
@@ -145,8 +145,8 @@ bool StbTextField::Draw(Rectangle r, bool focused,
 
     // Click: place cursor
     bool clicked = false;
-    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-        Vector2 mp = GetMousePosition();
+    if (Hotones::Input::IsMousePressed(MOUSE_BUTTON_LEFT)) {
+        Vector2 mp = Hotones::Input::GetMousePos();
         if (CheckCollisionPointRec(mp, r)) {
             clicked = true;
             float relX = mp.x - r.x - 8.f;
@@ -155,8 +155,8 @@ bool StbTextField::Draw(Rectangle r, bool focused,
     }
 
     // Drag: extend selection
-    if (focused && IsMouseButtonDown(MOUSE_BUTTON_LEFT)) {
-        Vector2 mp = GetMousePosition();
+    if (focused && Hotones::Input::IsMouseDown(MOUSE_BUTTON_LEFT)) {
+        Vector2 mp = Hotones::Input::GetMousePos();
         float relX = mp.x - r.x - 8.f;
         stb_textedit_drag(&buf, &state, relX / cw, 0.5f);
     }
@@ -0,0 +1,194 @@
+// TextCache.cpp — laid-out text runs, drawn as one quad batch per run
+
+#include <GFX/TextCache.hpp>
+#include <Time/FrameClock.hpp>
+#include <rlgl.h>
+#include <algorithm>
+#include <bit>
+
+namespace Hotones::GFX {
+
+namespace {
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME  = 1099511628211ull;
+
+constexpr int DEFAULT_FONT_SIZE = 10;   // raylib's: smallest size and spacing divisor
+constexpr int QUADS_PER_BATCH   = 256;  // checked against rlgl's batch at a time
+
+uint64_t Mix(uint64_t h, uint64_t v)
+{
+    for (int i = 0; i < 8; ++i, v >>= 8) h = (h ^ (v & 0xff)) * FNV_PRIME;
+    return h;
+}
+
+uint64_t RunKey(const Font& font, std::string_view text, float fontSize, float spacing)
+{
+    uint64_t h = FNV_OFFSET;
+    for (char c : text) h = (h ^ (unsigned char)c) * FNV_PRIME;
+    h = Mix(h, (uint64_t)(uintptr_t)font.glyphs);
+    h = Mix(h, font.texture.id);
+    return Mix(h, (uint64_t)std::bit_cast<uint32_t>(fontSize) << 32 | std::bit_cast<uint32_t>(spacing));
+}
+
+} // namespace
+
+TextCache& TextCache::Get()
+{
+    static TextCache s_instance;
+    return s_instance;
+}
+
+int TextCache::MeasureText(std::string_view text, int fontSize)
+{
+    const Font font = GetFontDefault();
+    if (font.texture.id == 0) return 0;
+    fontSize = std::max(fontSize, DEFAULT_FONT_SIZE);
+    return (int)Lookup(font, text, (float)fontSize, (float)(fontSize / DEFAULT_FONT_SIZE)).extents.x;
+}
+
+void TextCache::DrawText(std::string_view text, int x, int y, int fontSize, Color color)
+{
+    const Font font = GetFontDefault();
+    if (font.texture.id == 0) return;
+    fontSize = std::max(fontSize, DEFAULT_FONT_SIZE);
+    DrawTextEx(font, text, { (float)x, (float)y }, (float)fontSize, (float)(fontSize / DEFAULT_FONT_SIZE), color);
+}
+
+Vector2 TextCache::MeasureTextEx(const Font& font, std::string_view text, float fontSize, float spacing)
+{
+    if (font.texture.id == 0 || text.empty()) return { 0.f, 0.f };
+    return Lookup(font, text, fontSize, spacing).extents;
+}
+
+void TextCache::DrawTextEx(const Font& fontIn, std::string_view text, Vector2 position, float fontSize,
+                           float spacing, Color tint)
+{
+    const Font font = fontIn.texture.id != 0 ? fontIn : GetFontDefault();
+    if (text.empty()) return;
+    const Run& run = Lookup(font, text, fontSize, spacing);
+    if (run.quads.empty()) return;
+
+    const float tw = (float)font.texture.width, th = (float)font.texture.height;
+    for (size_t start = 0; start < run.quads.size(); start += QUADS_PER_BATCH) {
+        const size_t end = std::min(run.quads.size(), start + QUADS_PER_BATCH);
+        rlCheckRenderBatchLimit(4 * (int)(end - start));
+        rlSetTexture(font.texture.id);
+        rlBegin(RL_QUADS);
+        rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+        rlNormal3f(0.f, 0.f, 1.f);
+        for (size_t i = start; i < end; ++i) {
+            const Quad& q  = run.quads[i];
+            const float x0 = position.x + q.dst.x, y0 = position.y + q.dst.y;
+            const float x1 = x0 + q.dst.width,     y1 = y0 + q.dst.height;
+            const float u0 = q.src.x / tw, v0 = q.src.y / th;
+            const float u1 = (q.src.x + q.src.width) / tw, v1 = (q.src.y + q.src.height) / th;
+            // Corners in DrawTexturePro()'s order
+            rlTexCoord2f(u0, v0); rlVertex2f(x0, y0);
+            rlTexCoord2f(u0, v1); rlVertex2f(x0, y1);
+            rlTexCoord2f(u1, v1); rlVertex2f(x1, y1);
+            rlTexCoord2f(u1, v0); rlVertex2f(x1, y0);
+        }
+        rlEnd();
+    }
+    rlSetTexture(0);
+}
+
+const TextCache::Run& TextCache::Lookup(const Font& font, std::string_view text, float fontSize, float spacing)
+{
+    const uint64_t frame = Time::FrameClock::Get().Frame();
+    if (frame >= m_nextSweep) Sweep(frame);
+
+    const uint64_t key = RunKey(font, text, fontSize, spacing);
+    auto it = m_runs.find(key);
+    if (it != m_runs.end() && it->second.text == text && it->second.glyphs == font.glyphs &&
+        it->second.texture == font.texture.id && it->second.size == fontSize && it->second.spacing == spacing) {
+        it->second.lastUse = frame;
+        m_stats.hits++;
+        return it->second;
+    }
+
+    if (it == m_runs.end() && m_runs.size() >= MAX_RUNS) {
+        Sweep(frame);
+        if (m_runs.size() >= MAX_RUNS) {
+            auto oldest = std::min_element(m_runs.begin(), m_runs.end(), [](const auto& a, const auto& b) {
+                return a.second.lastUse < b.second.lastUse;
+            });
+            m_runs.erase(oldest);
+        }
+    }
+    Run& run    = m_runs[key];   // a colliding key is laid out afresh
+    run.text.assign(text);
+    run.glyphs  = font.glyphs;
+    run.texture = font.texture.id;
+    run.size    = fontSize;
+    run.spacing = spacing;
+    run.lastUse = frame;
+    Build(run, font);
+    m_stats.builds++;
+    return run;
+}
+
+// DrawTextEx() and MeasureTextEx(), once
+void TextCache::Build(Run& run, const Font& font)
+{
+    run.quads.clear();
+    const float scale = run.size / (float)font.baseSize;
+    const float pad   = (float)font.glyphPadding;
+
+    float x = 0.f, y = 0.f;                               // pen, for the quads
+    float lineWidth = 0.f, widest = 0.f;                  // unscaled glyph widths, for the extents
+    int   lineGlyphs = 0, mostGlyphs = 0;
+    float height = run.size;
+    const char* s   = run.text.c_str();
+    const char* end = s + run.text.size();
+    while (s < end) {
+        int bytes = 0;
+        const int codepoint = GetCodepointNext(s, &bytes);
+        s += std::max(bytes, 1);
+        const int        index = GetGlyphIndex(font, codepoint);
+        const GlyphInfo& glyph = font.glyphs[index];
+        const Rectangle& rec   = font.recs[index];
+
+        ++lineGlyphs;
+        if (codepoint == '\n') {
+            x = 0.f;
+            y += run.size + LINE_SPACING;
+            widest     = std::max(widest, lineWidth);
+            lineWidth  = 0.f;
+            lineGlyphs = 0;
+            height    += run.size + LINE_SPACING;
+        } else {
+            if (codepoint != ' ' && codepoint != '\t') {
+                Quad q;
+                q.src = { rec.x - pad, rec.y - pad, rec.width + 2.f * pad, rec.height + 2.f * pad };
+                q.dst = { x + (glyph.offsetX - pad) * scale, y + (glyph.offsetY - pad) * scale,
+                          (rec.width + 2.f * pad) * scale, (rec.height + 2.f * pad) * scale };
+                run.quads.push_back(q);
+            }
+            x         += (glyph.advanceX == 0 ? rec.width : (float)glyph.advanceX) * scale + run.spacing;
+            lineWidth += glyph.advanceX > 0 ? (float)glyph.advanceX : rec.width + (float)glyph.offsetX;
+        }
+        mostGlyphs = std::max(mostGlyphs, lineGlyphs);
+    }
+    widest      = std::max(widest, lineWidth);
+    run.extents = { widest * scale + (float)(mostGlyphs - 1) * run.spacing, height };
+}
+
+void TextCache::Sweep(uint64_t frame)
+{
+    m_nextSweep = frame + 60;
+    for (auto it = m_runs.begin(); it != m_runs.end();) {
+        if (it->second.lastUse + EVICT_FRAMES < frame) it = m_runs.erase(it);
+        else ++it;
+    }
+}
+
+TextCache::Stats TextCache::GetStats() const
+{
+    Stats stats = m_stats;
+    stats.runs  = m_runs.size();
+    return stats;
+}
+
+} // namespace Hotones::GFX
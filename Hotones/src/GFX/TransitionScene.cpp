@@ -1,4 +1,6 @@
 #include <GFX/TransitionScene.hpp>
+#include <GFX/RenderTargetPool.hpp>
+#include <Time/FrameClock.hpp>
 #include <raymath.h>
 
 namespace Hotones {
@@ -10,9 +12,9 @@ TransitionScene::TransitionScene(RenderTexture2D outTex, std::unique_ptr<Scene>
 
 TransitionScene::~TransitionScene()
 {
-    // Ensure textures are unloaded if still present
-    if (outTexture.id) UnloadRenderTexture(outTexture);
-    if (inTexture.id) UnloadRenderTexture(inTexture);
+    // Ensure textures go back to the pool if still held
+    GFX::RenderTargetPool::Get().Release(outTexture);
+    GFX::RenderTargetPool::Get().Release(inTexture);
 }
 
 void TransitionScene::Init()
@@ -29,16 +31,22 @@ void TransitionScene::Init()
     inTextureReady = false;
 }
 
+void TransitionScene::FixedUpdate(float dt)
+{
+    // The incoming scene simulates while the transition plays, as in Update()
+    if (incomingInstance) incomingInstance->FixedUpdate(dt);
+}
+
 void TransitionScene::Update()
 {
-    float dt = GetFrameTime();
+    float dt = Time::FrameClock::Get().Delta();
     elapsed += dt;
 
     // If incoming scene exists, let it progress while transition runs
     if (incomingInstance) {
         incomingInstance->Update();
         if (!inTextureReady) {
-            inTexture = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
+            inTexture = GFX::RenderTargetPool::Get().Acquire(GetScreenWidth(), GetScreenHeight());
             inTextureReady = true;
         }
     }
@@ -135,8 +143,8 @@ void TransitionScene::Draw()
 
 void TransitionScene::Unload()
 {
-    if (outTexture.id) { UnloadRenderTexture(outTexture); outTexture.id = 0; }
-    if (inTexture.id) { UnloadRenderTexture(inTexture); inTexture.id = 0; }
+    GFX::RenderTargetPool::Get().Release(outTexture);
+    GFX::RenderTargetPool::Get().Release(inTexture);
     // incomingInstance intentionally not unloaded here; it will be released by ReleaseIncoming()
 }
 
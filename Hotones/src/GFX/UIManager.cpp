@@ -1,7 +1,9 @@
 #include <GFX/UIManager.hpp>
+#include <Input/Input.hpp>
 #include <raylib.h>
 #include <memory>
 #include "GFX/LayoutEngine.hpp"
+#include "GFX/TextCache.hpp"
 
 namespace Hotones::GFX {
 
@@ -47,10 +49,10 @@ void UIManager::RenderLayout(int x, int y, int w, int h) const {
 
 // ── Button ────────────────────────────────────────────────────────────────────
 bool UIManager::Button(const char* text, Rectangle rect, Color bg, Color fg) const {
-    Vector2 mp  = GetMousePosition();
+    Vector2 mp  = Hotones::Input::GetMousePos();
     bool over   = CheckCollisionPointRec(mp, rect);
-    bool press  = over && IsMouseButtonDown(MOUSE_BUTTON_LEFT);
-    bool click  = over && IsMouseButtonReleased(MOUSE_BUTTON_LEFT);
+    bool press  = over && Hotones::Input::IsMouseDown(MOUSE_BUTTON_LEFT);
+    bool click  = over && Hotones::Input::IsMouseReleased(MOUSE_BUTTON_LEFT);
 
     Color col  = press ? theme.btnPress : (over ? theme.btnHover : bg);
     Color bord = over  ? theme.accent   : theme.btnBorder;
@@ -59,8 +61,9 @@ bool UIManager::Button(const char* text, Rectangle rect, Color bg, Color fg) con
     DrawRectangleLinesEx(rect, 2.f, bord);
 
     int fs = theme.fontSizeButton;
-    int tw = MeasureText(text, fs);
-    DrawText(text,
+    TextCache& texts = TextCache::Get();
+    int tw = texts.MeasureText(text, fs);
+    texts.DrawText(text,
              (int)(rect.x + (rect.width  - tw) * 0.5f),
              (int)(rect.y + (rect.height - fs) * 0.5f),
              fs, over ? WHITE : fg);
@@ -76,7 +79,7 @@ void UIManager::Label(const char* text, int x, int y, int fs, Color col) const {
     if (fs  == 0)                     fs  = theme.fontSizeLabel;
     if (col.a == 0 && col.r == 0 &&
         col.g == 0 && col.b == 0)     col = theme.textDim;
-    DrawText(text, x, y, fs, col);
+    TextCache::Get().DrawText(text, x, y, fs, col);
 }
 
 // ── Panel ─────────────────────────────────────────────────────────────────────
@@ -101,7 +104,8 @@ void UIManager::Title(const char* text, int sw, int y, int fs, Color col) const
     if (fs  == 0)                     fs  = theme.fontSizeTitle;
     if (col.a == 0 && col.r == 0 &&
         col.g == 0 && col.b == 0)     col = theme.accent;
-    DrawText(text, (sw - MeasureText(text, fs)) / 2, y, fs, col);
+    TextCache& texts = TextCache::Get();
+    texts.DrawText(text, (sw - texts.MeasureText(text, fs)) / 2, y, fs, col);
 }
 
 } // namespace Hotones::GFX
@@ -1,815 +1,633 @@
-// // #include <config.h>
-// #include <raylib.h>
-// #include <raymath.h>
-// #include <rlgl.h>
-
-// #include <GFX/bsp.hpp>
-
-// #include <algorithm>
-// #include <filesystem>
-// #include <fstream>
-// #include <iomanip>
-// #include <set>
-// #include <span>
-// #include <unordered_map>
-// #include <vector>
-
-// #include <assert.h>
-
-// template<typename T>
-// T
-// ReadT(std::istream& stream)
-// {
-// 	T data{};
-// 	stream.read((char*)&data, sizeof(T));
-// 	return data;
-// }
-
-// template<typename T>
-// T
-// ReadT(std::istream& stream, size_t idx)
-// {
-// 	stream.seekg(idx * sizeof(T), std::ios::cur);
-// 	return ReadT<T>(stream);
-// }
-
-// #pragma pack(push, 1)
-
-// struct Color_RGB8
-// {
-// 	uint8_t r, g, b;
-// };
-
-// Color_RGB8
-// palette(uint8_t id);
-
-// struct Vector3S
-// {
-// 	int16_t x, y, z;
-// };
-
-// struct BoundingBoxS // Bounding Box, Short values
-// {
-// 	Vector3S min, max;
-// };
-
-// struct Dir_Entry // A Directory entry
-// {
-// 	int32_t offset; // Offset to entry, in bytes, from start of file
-// 	int32_t size;   // Size of entry in file, in bytes
-// };
-
-// struct Header // The BSP file header
-// {
-// 	int32_t version; // Model version, must be 0x17 (23).
-
-// 	Dir_Entry entities;   // List of Entities.
-// 	Dir_Entry planes;     // Map Planes.
-// 						  // numplanes = size/sizeof(plane_t)
-// 	Dir_Entry miptex;     // Wall Textures.
-// 	Dir_Entry vertices;   // Map Vertices.
-// 						  // numvertices = size/sizeof(vertex_t)
-// 	Dir_Entry visibility; // Leaves Visibility lists.
-// 	Dir_Entry nodes;      // BSP Nodes.
-// 						  // numnodes = size/sizeof(node_t)
-// 	Dir_Entry texinfos;   // Texture Info for faces.
-// 						  // numtexinfo = size/sizeof(texinfo_t)
-// 	Dir_Entry faces;      // Faces of each surface.
-// 						  // numfaces = size/sizeof(face_t)
-// 	Dir_Entry lightmaps;  // Wall Light Maps.
-// 	Dir_Entry clipnodes;  // clip nodes, for Models.
-// 						  // numclips = size/sizeof(clipnode_t)
-// 	Dir_Entry leaves;     // BSP Leaves.
-// 						  // numleaves = size/sizeof(leaf_t)
-// 	Dir_Entry listfaces;  // List of Faces.
-// 	Dir_Entry edges;      // Edges of faces.
-// 						  // numedges = size/sizeof(edge_t)
-// 	Dir_Entry listedges;  // List of Edges.
-// 	Dir_Entry models;     // List of Models.
-// 						  // nummodels = Size/sizeof(model_t)
-// };
-
-// struct Entity
-// {
-// 	std::unordered_map<std::string, std::string> tags;
-// };
-
-// struct BSP_Model
-// {
-// 	BoundingBox bound;    // The bounding box of the Model
-// 	Vector3 origin;       // origin of model, usually (0,0,0)
-// 	int32_t bsp_node_id;  // index of first BSP node
-// 	int32_t clipnode1_id; // index of the first Clip node
-// 	int32_t clipnode2_id; // index of the second Clip node
-// 	int32_t _dummy_id;    // usually zero
-// 	int32_t numleafs;     // number of BSP leaves
-// 	int32_t face_id;      // index of Faces
-// 	int32_t face_num;     // number of Faces
-// };
-
-// struct Edge
-// {
-// 	uint16_t vs; // index of the start vertex
-// 		//  must be in [0,numvertices[
-// 	uint16_t ve; // index of the end vertex
-// 				 //  must be in [0,numvertices[
-// };
-
-// struct Plane
-// {
-// 	Vector3 normal; // Vector orthogonal to plane (Nx,Ny,Nz)
-// 	float dist;     // Offset to plane, along the normal vector.
-// 	int32_t type;   // Type of plane, depending on normal vector.
-// };
-
-// struct TexInfo
-// {
-// 	Vector3 u_axis;     // U vector, horizontal in texture space)
-// 	float u_offset;     // horizontal offset in texture space
-// 	Vector3 v_axis;     // V vector, vertical in texture space
-// 	float v_offset;     // vertical offset in texture space
-// 	uint32_t miptex_id; // Index of Mip Texture
-// 						//           must be in [0,numtex[
-// 	uint32_t animated;  // 0 for ordinary textures, 1 for water
-// };
-
-// struct Face
-// {
-// 	uint16_t plane_id;   // The plane in which the face lies
-// 						 //           must be in [0,numplanes[
-// 	uint16_t side;       // 0 if in front of the plane, 1 if behind the plane
-// 	int32_t ledge_id;    // first edge in the List of edges
-// 						 //           must be in [0,numledges[
-// 	uint16_t ledge_num;  // number of edges in the List of edges
-// 	uint16_t texinfo_id; // index of the Texture info the face is part of
-// 						 //           must be in [0,numtexinfos[
-// 	uint8_t typelight;   // type of lighting, for the face
-// 	uint8_t baselight;   // from 0xFF (dark) to 0 (bright)
-// 	uint8_t light[2];    // two additional light models
-// 	uint32_t lightmap;   // Pointer inside the general light map, or -1
-// 						 // this define the start of the face light map
-// };
-
-// struct Miptex // Mip Texture
-// {
-// 	char name[16];      // Name of the texture.
-// 	uint32_t width;     // width of picture, must be a multiple of 8
-// 	uint32_t height;    // height of picture, must be a multiple of 8
-// 	uint32_t offset[4]; // offsets to uint8_t Pix[width * height], relative to start of Miptex
-// };
-
-// /**
-// * typedef struct                 // Mip texture list header
-// * { int32_t numtex;                 // Number of textures in Mip Texture list
-// *   int32_t offset[numtex];         // Offset to each of the individual texture from the beginning of mipheader_t
-// * } mipheader_t;
-// */
-
-// struct Node
-// {
-// 	uint32_t plane_id; // The plane that splits the node
-// 					   //           must be in [0,numplanes[
-// 	int16_t front;     // If > 0,  front = index of Front child node
-// 					   // else,   ~front = index of child leaf
-// 	int16_t back;      // If > 0,   back = index of Back child node
-// 					   // else,    ~back = index of child leaf
-// 	BoundingBoxS box;  // Bounding box of node and all childs
-// 	uint16_t face_id;  // Index of first Polygons in the node
-// 	uint16_t face_num; // Number of faces in the node
-// };
-
-// struct Leaf
-// {
-// 	int32_t type;          // Special type of leaf
-// 	int32_t visibility_id; // Beginning of visibility lists
-// 						   //     must be -1 or in [0,numvislist[
-// 	BoundingBoxS bound;    // Bounding box of the leaf
-// 	uint16_t listface_id;  // First item of the list of faces
-// 						   //     must be in [0,numlfaces[
-// 	uint16_t listface_num; // Number of faces in the leaf
-// 	uint8_t sndwater;      // level of the four ambient sounds:
-// 	uint8_t sndsky;        //   0    is no sound
-// 	uint8_t sndslime;      //   0xFF is maximum volume
-// 	uint8_t sndlava;       //
-// };
-
-// // uint16_t listface[numlface];   // each uint16_t is the index of a Face
-
-// // int32_t listedge[numlstedge];
-
-// // uint8_t vislist[numvislist];    // RLE encoded bit array
-
-// struct Clipnode
-// {
-// 	uint32_t planenum; // The plane which splits the node
-// 	int16_t front;     // If positive, id of Front child node
-// 					   // If -2, the Front part is inside the model
-// 					   // If -1, the Front part is outside the model
-// 	int16_t back;      // If positive, id of Back child node
-// 					   // If -2, the Back part is inside the model
-// 					   // If -1, the Back part is outside the model
-// };
-
-// // uint8_t lightmap[numlightmap]; // value 0:dark 255:bright
-
-// // uint8_t light[width*height];
-// #pragma pack(pop)
-
-// static Entity
-// ReadEntity(std::istream& stream)
-// {
-// 	Entity entity{};
-
-// 	char token;
-// 	stream >> token;
-// 	if (token != '{')
-// 		throw TextFormat("Expected ')', found %c", token);
-
-// 	while (stream >> std::ws)
-// 	{
-// 		token = stream.peek();
-// 		if (token == '"')
-// 		{
-// 			std::string tag, tagValue;
-// 			stream >> std::quoted(tag) >> std::quoted(tagValue);
-// 			entity.tags[tag] = tagValue;
-// 		}
-// 		else if (token == '}')
-// 		{
-// 			stream >> token;
-// 			break;
-// 		}
-// 		else
-// 			throw TextFormat("Expected ')', found %c", token);
-// 	}
-
-// 	return entity;
-// }
-
-// Vector3
-// FromQuake(Vector3 quakeVec)
-// {
-// 	return Vector3Scale({quakeVec.y, quakeVec.z, quakeVec.x}, 0.05f);
-// }
-
-// struct BSP_File
-// {
-// 	std::istream& bsp_file;
-// 	Header header;
-
-// 	BSP_File(std::ifstream& _file) : bsp_file(_file)
-// 	{
-// 		if (bsp_file.good() == false)
-// 			throw std::runtime_error("Failed to open file");
-
-// 		header = ReadT<Header>(bsp_file);
-// 	}
-
-// 	template<typename T>
-// 	T
-// 	_read(Dir_Entry dir, size_t idx)
-// 	{
-// 		// Compute number of elements in this directory entry
-// 		size_t elementSize = sizeof(T);
-// 		if (elementSize == 0) throw std::runtime_error("Invalid element size 0");
-// 		size_t count = (size_t)dir.size / elementSize;
-// 		if (idx >= count) {
-// 			std::ostringstream ss;
-// 			ss << "BSP read out of range: dir.offset=" << dir.offset
-// 			   << " dir.size=" << dir.size << " elementSize=" << elementSize
-// 			   << " count=" << count << " idx=" << idx;
-// 			throw std::out_of_range(ss.str());
-// 		}
-
-// 		// Seek directly to the absolute position of the requested element
-// 		bsp_file.clear();
-// 		bsp_file.seekg((std::streamoff)dir.offset + (std::streamoff)(idx * elementSize), std::ios::beg);
-// 		return ReadT<T>(bsp_file);
-// 	}
-
-// 	std::vector<Entity>
-// 	entities()
-// 	{
-// 		bsp_file.clear();
-// 		bsp_file.seekg(header.entities.offset);
-
-// 		std::vector<Entity> entities{};
-// 		while (bsp_file.tellg() < header.entities.offset + header.entities.size)
-// 			entities.push_back(ReadEntity(bsp_file));
-
-// 		return entities;
-// 	}
-
-// 	Plane
-// 	plane(size_t idx)
-// 	{
-// 		return _read<Plane>(header.planes, idx);
-// 	}
-
-// 	int32_t
-// 	miptex_count()
-// 	{
-// 		bsp_file.clear();
-// 		bsp_file.seekg(header.miptex.offset);
-// 		return ReadT<int32_t>(bsp_file);
-// 	}
-
-// 	Miptex
-// 	miptex(size_t idx)
-// 	{
-// 		int32_t count = miptex_count();
-// 		int32_t offset = ReadT<int32_t>(bsp_file, idx);
-
-// 		bsp_file.seekg(header.miptex.offset + offset);
-// 		return ReadT<Miptex>(bsp_file);
-// 	}
-
-// 	Vector3
-// 	vertex(size_t idx)
-// 	{
-// 		return _read<Vector3>(header.vertices, idx);
-// 	}
-
-// 	Node
-// 	node(size_t idx)
-// 	{
-// 		return _read<Node>(header.nodes, idx);
-// 	}
-
-// 	TexInfo
-// 	texinfo(size_t idx)
-// 	{
-// 		return _read<TexInfo>(header.texinfos, idx);
-// 	}
-
-// 	Face
-// 	face(size_t idx)
-// 	{
-// 		return _read<Face>(header.faces, idx);
-// 	}
-
-// 	Leaf
-// 	leaf(size_t idx)
-// 	{
-// 		return _read<Leaf>(header.leaves, idx);
-// 	}
-
-// 	uint16_t
-// 	listface(size_t idx)
-// 	{
-// 		return _read<uint16_t>(header.listfaces, idx);
-// 	}
-
-// 	Edge
-// 	edge(size_t idx)
-// 	{
-// 		return _read<Edge>(header.edges, idx);
-// 	}
-
-// 	int32_t
-// 	listedge(size_t idx)
-// 	{
-// 		return _read<int32_t>(header.listedges, idx);
-// 	}
-
-// 	BSP_Model
-// 	model(size_t idx)
-// 	{
-// 		return _read<BSP_Model>(header.models, idx);
-// 	}
-
-// 	std::vector<Color_RGB8>
-// 	miptex_data(size_t idx, uint8_t miplevel)
-// 	{
-// 		Miptex mptx = miptex(idx);
-
-// 		uint32_t width = mptx.width >> miplevel;
-// 		uint32_t height = mptx.height >> miplevel;
-
-// 		bsp_file.seekg(-sizeof(Miptex) + mptx.offset[miplevel], std::ios::cur);
-
-// 		std::vector<uint8_t> palette_indices(width * height);
-// 		bsp_file.read((char*)palette_indices.data(), width * height);
-
-// 		std::vector<Color_RGB8> color_data;
-// 		std::transform(palette_indices.begin(), palette_indices.end(), std::back_inserter(color_data), palette);
-// 		return color_data;
-// 	}
-// };
-
-// Vector3
-// VerticesNormal(Vector3 a, Vector3 b, Vector3 c)
-// {
-// 	Vector3 ba = Vector3Subtract(b, a);
-// 	Vector3 ca = Vector3Subtract(c, a);
-// 	return Vector3Normalize(Vector3CrossProduct(ba, ca));
-// }
-
-// Mesh
-// GenMeshFaces(BSP_File& map, std::span<const Face> faces)
-// {
-// 	static_assert(sizeof(Vector3) == 3 * sizeof(float));
-// 	static_assert(sizeof(Vector2) == 2 * sizeof(float));
-// 	std::vector<Vector3> vertices{};
-// 	std::vector<Vector2> texcoords{};
-// 	std::vector<Vector3> normals{};
-
-// 	for (const Face& face : faces)
-// 	{
-// 		TexInfo texinfo = map.texinfo(face.texinfo_id);
-// 		Miptex miptex = map.miptex(texinfo.miptex_id);
-
-// 		std::vector<Vector3> face_vertices{};
-// 		std::vector<Vector2> face_texcoords{};
-
-// 		for (size_t i = 0; i < face.ledge_num; ++i)
-// 		{
-// 			int16_t ledge = map.listedge(face.ledge_id + i);
-// 			Edge edge = map.edge(labs(ledge));
-
-// 			Vector3 vertex = map.vertex(ledge >= 0 ? edge.vs : edge.ve);
-// 			face_vertices.push_back(vertex);
-
-// 			Vector2 uv{
-// 				.x = (Vector3DotProduct(vertex, texinfo.u_axis) + texinfo.u_offset) / miptex.width,
-// 				.y = (Vector3DotProduct(vertex, texinfo.v_axis) + texinfo.v_offset) / miptex.height,
-// 			};
-// 			face_texcoords.push_back(uv);
-// 		}
-// 		assert(face_vertices.empty() == false);
-
-// 		for (size_t i = face_vertices.size() - 2; i > 0; --i)
-// 		{
-// 			Vector3 v[3] = {
-// 				FromQuake(face_vertices.back()),
-// 				FromQuake(face_vertices[i]),
-// 				FromQuake(face_vertices[i - 1]),
-// 			};
-// 			vertices.insert(vertices.end(), std::begin(v), std::end(v));
-
-// 			texcoords.push_back(face_texcoords.back());
-// 			texcoords.push_back(face_texcoords[i]);
-// 			texcoords.push_back(face_texcoords[i - 1]);
-
-// 			Vector3 normal = VerticesNormal(v[0], v[1], v[2]);
-// 			for (size_t v = 0; v < 3; ++v)
-// 				normals.push_back(normal);
-// 		}
-// 	}
-
-// 	Mesh mesh{};
-// 	mesh.vertexCount = vertices.size();
-// 	mesh.vertices = (float*)vertices.data();
-// 	mesh.texcoords = (float*)texcoords.data();
-// 	mesh.normals = (float*)normals.data();
-// 	UploadMesh(&mesh, false);
-
-// 	// So the free functions don't complain later on
-// 	mesh.vertices = (float*)malloc(1);
-// 	mesh.texcoords = (float*)malloc(1);
-// 	mesh.normals = (float*)malloc(1);
-// 	return mesh;
-// }
-
-// std::vector<Model>
-// Hotones::LoadModelsFromBSPFile(const std::filesystem::path& path)
-// {
-// 	std::ifstream bsp_file{path, std::ios::binary};
-// 	BSP_File map{bsp_file};
-
-// 	// Protect against BSP files with zero models (dir.size == 0)
-// 	size_t modelCount = 0;
-// 	if (map.header.models.size > 0) modelCount = (size_t)map.header.models.size / sizeof(BSP_Model);
-// 	if (modelCount == 0) {
-// 		TraceLog(LOG_WARNING, "LoadModelsFromBSPFile: BSP has no models: %s", path.string().c_str());
-// 		return {};
-// 	}
-
-// 	Node bsp_root = map.node(map.model(0).bsp_node_id);
-// 	std::vector<Node> nodes{bsp_root};
-// 	std::set<size_t> leaves{};
-
-// 	while (nodes.empty() == false)
-// 	{
-// 		Node node = nodes.back();
-// 		nodes.pop_back();
-
-// 		for (int16_t n : {node.front, node.back})
-// 		{
-// 			if (n > 0)
-// 				nodes.push_back(map.node(n));
-// 			else
-// 			{
-// 				size_t leaf_id = ~n;
-// 				leaves.insert(leaf_id);
-// 			}
-// 		}
-// 	}
-
-// 	std::unordered_map<std::string, Texture> texture_name_to_object{};
-// 	std::unordered_map<std::string, std::vector<Face>> texture_name_to_face_list{}; // Group faces by texture to reduce draw calls
-
-// 	for (size_t leaf_id : leaves)
-// 	{
-// 		Leaf leaf = map.leaf(leaf_id);
-// 		for (size_t i = 0; i < leaf.listface_num; i++)
-// 		{
-// 			uint16_t face_id = map.listface(leaf.listface_id + i);
-// 			Face face = map.face(face_id);
-
-// 			TexInfo texinfo = map.texinfo(face.texinfo_id);
-// 			Miptex miptex = map.miptex(texinfo.miptex_id);
-
-// 			std::string texname = miptex.name;
-// 			texture_name_to_face_list[texname].push_back(face);
-
-// 			if (texture_name_to_object.contains(texname) == false)
-// 			{
-// 				std::vector<Color_RGB8> color_data = map.miptex_data(texinfo.miptex_id, 0);
-// 				Image texture_image = {
-// 					.data = color_data.data(),
-// 					.width = (int)miptex.width,
-// 					.height = (int)miptex.height,
-// 					.mipmaps = 1,
-// 					.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8,
-// 				};
-
-// 				texture_name_to_object[texname] = LoadTextureFromImage(texture_image);
-// 			}
-// 		}
-// 	}
-
-// 	std::vector<Model> models{};
-// 	for (auto& [texname, faces] : texture_name_to_face_list)
-// 	{
-// 		Mesh mesh = GenMeshFaces(map, faces);
-// 		Model model = LoadModelFromMesh(mesh);
-// 		model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texture_name_to_object.at(texname);
-// 		models.push_back(model);
-// 	}
-// 	return models;
-// }
-
-// Color_RGB8
-// palette(uint8_t id)
-// {
-// 	static const Color_RGB8 _PALETTE[] = {
-// 		{0, 0, 0},
-// 		{15, 15, 15},
-// 		{31, 31, 31},
-// 		{47, 47, 47},
-// 		{63, 63, 63},
-// 		{75, 75, 75},
-// 		{91, 91, 91},
-// 		{107, 107, 107},
-// 		{123, 123, 123},
-// 		{139, 139, 139},
-// 		{155, 155, 155},
-// 		{171, 171, 171},
-// 		{187, 187, 187},
-// 		{203, 203, 203},
-// 		{219, 219, 219},
-// 		{235, 235, 235},
-// 		{15, 11, 7},
-// 		{23, 15, 11},
-// 		{31, 23, 11},
-// 		{39, 27, 15},
-// 		{47, 35, 19},
-// 		{55, 43, 23},
-// 		{63, 47, 23},
-// 		{75, 55, 27},
-// 		{83, 59, 27},
-// 		{91, 67, 31},
-// 		{99, 75, 31},
-// 		{107, 83, 31},
-// 		{115, 87, 31},
-// 		{123, 95, 35},
-// 		{131, 103, 35},
-// 		{143, 111, 35},
-// 		{11, 11, 15},
-// 		{19, 19, 27},
-// 		{27, 27, 39},
-// 		{39, 39, 51},
-// 		{47, 47, 63},
-// 		{55, 55, 75},
-// 		{63, 63, 87},
-// 		{71, 71, 103},
-// 		{79, 79, 115},
-// 		{91, 91, 127},
-// 		{99, 99, 139},
-// 		{107, 107, 151},
-// 		{115, 115, 163},
-// 		{123, 123, 175},
-// 		{131, 131, 187},
-// 		{139, 139, 203},
-// 		{0, 0, 0},
-// 		{7, 7, 0},
-// 		{11, 11, 0},
-// 		{19, 19, 0},
-// 		{27, 27, 0},
-// 		{35, 35, 0},
-// 		{43, 43, 7},
-// 		{47, 47, 7},
-// 		{55, 55, 7},
-// 		{63, 63, 7},
-// 		{71, 71, 7},
-// 		{75, 75, 11},
-// 		{83, 83, 11},
-// 		{91, 91, 11},
-// 		{99, 99, 11},
-// 		{107, 107, 15},
-// 		{7, 0, 0},
-// 		{15, 0, 0},
-// 		{23, 0, 0},
-// 		{31, 0, 0},
-// 		{39, 0, 0},
-// 		{47, 0, 0},
-// 		{55, 0, 0},
-// 		{63, 0, 0},
-// 		{71, 0, 0},
-// 		{79, 0, 0},
-// 		{87, 0, 0},
-// 		{95, 0, 0},
-// 		{103, 0, 0},
-// 		{111, 0, 0},
-// 		{119, 0, 0},
-// 		{127, 0, 0},
-// 		{19, 19, 0},
-// 		{27, 27, 0},
-// 		{35, 35, 0},
-// 		{47, 43, 0},
-// 		{55, 47, 0},
-// 		{67, 55, 0},
-// 		{75, 59, 7},
-// 		{87, 67, 7},
-// 		{95, 71, 7},
-// 		{107, 75, 11},
-// 		{119, 83, 15},
-// 		{131, 87, 19},
-// 		{139, 91, 19},
-// 		{151, 95, 27},
-// 		{163, 99, 31},
-// 		{175, 103, 35},
-// 		{35, 19, 7},
-// 		{47, 23, 11},
-// 		{59, 31, 15},
-// 		{75, 35, 19},
-// 		{87, 43, 23},
-// 		{99, 47, 31},
-// 		{115, 55, 35},
-// 		{127, 59, 43},
-// 		{143, 67, 51},
-// 		{159, 79, 51},
-// 		{175, 99, 47},
-// 		{191, 119, 47},
-// 		{207, 143, 43},
-// 		{223, 171, 39},
-// 		{239, 203, 31},
-// 		{255, 243, 27},
-// 		{11, 7, 0},
-// 		{27, 19, 0},
-// 		{43, 35, 15},
-// 		{55, 43, 19},
-// 		{71, 51, 27},
-// 		{83, 55, 35},
-// 		{99, 63, 43},
-// 		{111, 71, 51},
-// 		{127, 83, 63},
-// 		{139, 95, 71},
-// 		{155, 107, 83},
-// 		{167, 123, 95},
-// 		{183, 135, 107},
-// 		{195, 147, 123},
-// 		{211, 163, 139},
-// 		{227, 179, 151},
-// 		{171, 139, 163},
-// 		{159, 127, 151},
-// 		{147, 115, 135},
-// 		{139, 103, 123},
-// 		{127, 91, 111},
-// 		{119, 83, 99},
-// 		{107, 75, 87},
-// 		{95, 63, 75},
-// 		{87, 55, 67},
-// 		{75, 47, 55},
-// 		{67, 39, 47},
-// 		{55, 31, 35},
-// 		{43, 23, 27},
-// 		{35, 19, 19},
-// 		{23, 11, 11},
-// 		{15, 7, 7},
-// 		{187, 115, 159},
-// 		{175, 107, 143},
-// 		{163, 95, 131},
-// 		{151, 87, 119},
-// 		{139, 79, 107},
-// 		{127, 75, 95},
-// 		{115, 67, 83},
-// 		{107, 59, 75},
-// 		{95, 51, 63},
-// 		{83, 43, 55},
-// 		{71, 35, 43},
-// 		{59, 31, 35},
-// 		{47, 23, 27},
-// 		{35, 19, 19},
-// 		{23, 11, 11},
-// 		{15, 7, 7},
-// 		{219, 195, 187},
-// 		{203, 179, 167},
-// 		{191, 163, 155},
-// 		{175, 151, 139},
-// 		{163, 135, 123},
-// 		{151, 123, 111},
-// 		{135, 111, 95},
-// 		{123, 99, 83},
-// 		{107, 87, 71},
-// 		{95, 75, 59},
-// 		{83, 63, 51},
-// 		{67, 51, 39},
-// 		{55, 43, 31},
-// 		{39, 31, 23},
-// 		{27, 19, 15},
-// 		{15, 11, 7},
-// 		{111, 131, 123},
-// 		{103, 123, 111},
-// 		{95, 115, 103},
-// 		{87, 107, 95},
-// 		{79, 99, 87},
-// 		{71, 91, 79},
-// 		{63, 83, 71},
-// 		{55, 75, 63},
-// 		{47, 67, 55},
-// 		{43, 59, 47},
-// 		{35, 51, 39},
-// 		{31, 43, 31},
-// 		{23, 35, 23},
-// 		{15, 27, 19},
-// 		{11, 19, 11},
-// 		{7, 11, 7},
-// 		{255, 243, 27},
-// 		{239, 223, 23},
-// 		{219, 203, 19},
-// 		{203, 183, 15},
-// 		{187, 167, 15},
-// 		{171, 151, 11},
-// 		{155, 131, 7},
-// 		{139, 115, 7},
-// 		{123, 99, 7},
-// 		{107, 83, 0},
-// 		{91, 71, 0},
-// 		{75, 55, 0},
-// 		{59, 43, 0},
-// 		{43, 31, 0},
-// 		{27, 15, 0},
-// 		{11, 7, 0},
-// 		{0, 0, 255},
-// 		{11, 11, 239},
-// 		{19, 19, 223},
-// 		{27, 27, 207},
-// 		{35, 35, 191},
-// 		{43, 43, 175},
-// 		{47, 47, 159},
-// 		{47, 47, 143},
-// 		{47, 47, 127},
-// 		{47, 47, 111},
-// 		{47, 47, 95},
-// 		{43, 43, 79},
-// 		{35, 35, 63},
-// 		{27, 27, 47},
-// 		{19, 19, 31},
-// 		{11, 11, 15},
-// 		{43, 0, 0},
-// 		{59, 0, 0},
-// 		{75, 7, 0},
-// 		{95, 7, 0},
-// 		{111, 15, 0},
-// 		{127, 23, 7},
-// 		{147, 31, 7},
-// 		{163, 39, 11},
-// 		{183, 51, 15},
-// 		{195, 75, 27},
-// 		{207, 99, 43},
-// 		{219, 127, 59},
-// 		{227, 151, 79},
-// 		{231, 171, 95},
-// 		{239, 191, 119},
-// 		{247, 211, 139},
-// 		{167, 123, 59},
-// 		{183, 155, 55},
-// 		{199, 195, 55},
-// 		{231, 227, 87},
-// 		{127, 191, 255},
-// 		{171, 231, 255},
-// 		{215, 255, 255},
-// 		{103, 0, 0},
-// 		{139, 0, 0},
-// 		{179, 0, 0},
-// 		{215, 0, 0},
-// 		{255, 0, 0},
-// 		{255, 243, 147},
-// 		{255, 247, 199},
-// 		{255, 255, 255},
-// 		{159, 91, 83},
-// 	};
-// 	return _PALETTE[id];
-// }
\ No newline at end of file
+// bsp.cpp — Quake (version 29) BSP loader
+//
+// Reads the whole file, then builds:
+//   • the world's faces as raylib meshes, one per wall texture  (rendering)
+//   • the BSP tree, leaves and compressed PVS  (BSPWorld visibility culling)
+//
+// Lightmaps, clip nodes and the entity lump are not used.
+
+#include <GFX/bsp.hpp>
+#include <Assets/Vfs.hpp>
+
+#include <raylib.h>
+#include <raymath.h>
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+
+using Hotones::BSP_SCALE;
+
+// ─── File layout ──────────────────────────────────────────────────────────────
+
+#pragma pack(push, 1)
+
+struct DirEntry {
+    int32_t offset;   // from the start of the file, in bytes
+    int32_t size;
+};
+
+struct Header {
+    int32_t  version;   // 29
+    DirEntry entities, planes, miptex, vertices, visibility, nodes, texinfos, faces,
+             lightmaps, clipnodes, leaves, listfaces, edges, listedges, models;
+};
+
+struct Plane {
+    Vector3 normal;
+    float   dist;
+    int32_t type;
+};
+
+struct BoundingBoxS {
+    int16_t min[3], max[3];
+};
+
+struct BSPNode {
+    uint32_t     plane_id;
+    int16_t      front;      // >= 0 node, else ~leaf
+    int16_t      back;
+    BoundingBoxS box;
+    uint16_t     face_id;
+    uint16_t     face_num;
+};
+
+struct BSPLeaf {
+    int32_t      type;            // contents
+    int32_t      visibility_id;   // into the visibility lump, -1 if none
+    BoundingBoxS bound;
+    uint16_t     listface_id;     // into the face list
+    uint16_t     listface_num;
+    uint8_t      ambient[4];
+};
+
+struct TexInfo {
+    Vector3  u_axis;
+    float    u_offset;
+    Vector3  v_axis;
+    float    v_offset;
+    uint32_t miptex_id;
+    uint32_t animated;
+};
+
+struct Face {
+    uint16_t plane_id;
+    uint16_t side;        // 1 → facing against the plane normal
+    int32_t  ledge_id;    // first edge in the edge list
+    uint16_t ledge_num;
+    uint16_t texinfo_id;
+    uint8_t  typelight;
+    uint8_t  baselight;
+    uint8_t  light[2];
+    int32_t  lightmap;
+};
+
+struct Edge {
+    uint16_t vs, ve;
+};
+
+struct Miptex {
+    char     name[16];
+    uint32_t width, height;
+    uint32_t offset[4];   // to each mip level's palette indices, from the Miptex
+};
+
+struct BSPModel {
+    float   mins[3], maxs[3];
+    float   origin[3];
+    int32_t headnode[4];   // [0] is the render tree
+    int32_t numleafs;      // leaves with PVS bits, not counting leaf 0
+    int32_t face_id;
+    int32_t face_num;
+};
+
+#pragma pack(pop)
+
+constexpr int32_t BSP_VERSION = 29;
+
+// Every lump, copied out of the file
+struct BSPFile {
+    std::vector<uint8_t>  data;
+    Header                header = {};
+    std::vector<Plane>    planes;
+    std::vector<Vector3>  vertices;
+    std::vector<BSPNode>  nodes;
+    std::vector<TexInfo>  texinfos;
+    std::vector<Face>     faces;
+    std::vector<BSPLeaf>  leaves;
+    std::vector<uint16_t> listfaces;
+    std::vector<Edge>     edges;
+    std::vector<int32_t>  listedges;
+    std::vector<BSPModel> models;
+    std::vector<uint8_t>  visibility;
+};
+
+template<typename T>
+bool ReadLump(const std::vector<uint8_t>& data, const DirEntry& dir, std::vector<T>& out) {
+    if (dir.offset < 0 || dir.size < 0 || (size_t)dir.offset + (size_t)dir.size > data.size()
+        || dir.size % sizeof(T) != 0)
+        return false;
+    out.resize(dir.size / sizeof(T));
+    if (!out.empty()) memcpy(out.data(), data.data() + dir.offset, dir.size);
+    return true;
+}
+
+bool ReadBSP(const std::filesystem::path& path, BSPFile& bsp) {
+    const Hotones::Assets::FileView file = Hotones::Assets::ReadFile(path.string());   // may be inside a .cup
+    if (!file) {
+        TraceLog(LOG_ERROR, "BSP: cannot open %s", path.string().c_str());
+        return false;
+    }
+    bsp.data.assign(file.data, file.data + file.size);
+    if (bsp.data.size() < sizeof(Header)) {
+        TraceLog(LOG_ERROR, "BSP: %s is too short", path.string().c_str());
+        return false;
+    }
+    memcpy(&bsp.header, bsp.data.data(), sizeof(Header));
+    const Header& h = bsp.header;
+    if (h.version != BSP_VERSION) {
+        TraceLog(LOG_ERROR, "BSP: %s is version %d, only %d is supported",
+                 path.string().c_str(), h.version, BSP_VERSION);
+        return false;
+    }
+    const bool ok = ReadLump(bsp.data, h.planes, bsp.planes)
+                 && ReadLump(bsp.data, h.vertices, bsp.vertices)
+                 && ReadLump(bsp.data, h.nodes, bsp.nodes)
+                 && ReadLump(bsp.data, h.texinfos, bsp.texinfos)
+                 && ReadLump(bsp.data, h.faces, bsp.faces)
+                 && ReadLump(bsp.data, h.leaves, bsp.leaves)
+                 && ReadLump(bsp.data, h.listfaces, bsp.listfaces)
+                 && ReadLump(bsp.data, h.edges, bsp.edges)
+                 && ReadLump(bsp.data, h.listedges, bsp.listedges)
+                 && ReadLump(bsp.data, h.models, bsp.models)
+                 && ReadLump(bsp.data, h.visibility, bsp.visibility);
+    if (!ok) {
+        TraceLog(LOG_ERROR, "BSP: %s has a malformed lump", path.string().c_str());
+        return false;
+    }
+    if (bsp.models.empty()) {
+        TraceLog(LOG_WARNING, "BSP: %s has no models", path.string().c_str());
+        return false;
+    }
+    return true;
+}
+
+// Quake is Z-up and in inches, more or less; the engine is Y-up in metres.
+Vector3 FromQuake(Vector3 v) { return { v.y * BSP_SCALE, v.z * BSP_SCALE, v.x * BSP_SCALE }; }
+Vector3 ToQuake(Vector3 v)   { return { v.z / BSP_SCALE, v.x / BSP_SCALE, v.y / BSP_SCALE }; }
+
+BoundingBox FromQuake(const BoundingBoxS& b) {
+    return { FromQuake(Vector3{ (float)b.min[0], (float)b.min[1], (float)b.min[2] }),
+             FromQuake(Vector3{ (float)b.max[0], (float)b.max[1], (float)b.max[2] }) };
+}
+
+const uint8_t kPalette[256][3] = {
+    {0,0,0}, {15,15,15}, {31,31,31}, {47,47,47}, {63,63,63}, {75,75,75}, {91,91,91}, {107,107,107},
+    {123,123,123}, {139,139,139}, {155,155,155}, {171,171,171}, {187,187,187}, {203,203,203}, {219,219,219}, {235,235,235},
+    {15,11,7}, {23,15,11}, {31,23,11}, {39,27,15}, {47,35,19}, {55,43,23}, {63,47,23}, {75,55,27},
+    {83,59,27}, {91,67,31}, {99,75,31}, {107,83,31}, {115,87,31}, {123,95,35}, {131,103,35}, {143,111,35},
+    {11,11,15}, {19,19,27}, {27,27,39}, {39,39,51}, {47,47,63}, {55,55,75}, {63,63,87}, {71,71,103},
+    {79,79,115}, {91,91,127}, {99,99,139}, {107,107,151}, {115,115,163}, {123,123,175}, {131,131,187}, {139,139,203},
+    {0,0,0}, {7,7,0}, {11,11,0}, {19,19,0}, {27,27,0}, {35,35,0}, {43,43,7}, {47,47,7},
+    {55,55,7}, {63,63,7}, {71,71,7}, {75,75,11}, {83,83,11}, {91,91,11}, {99,99,11}, {107,107,15},
+    {7,0,0}, {15,0,0}, {23,0,0}, {31,0,0}, {39,0,0}, {47,0,0}, {55,0,0}, {63,0,0},
+    {71,0,0}, {79,0,0}, {87,0,0}, {95,0,0}, {103,0,0}, {111,0,0}, {119,0,0}, {127,0,0},
+    {19,19,0}, {27,27,0}, {35,35,0}, {47,43,0}, {55,47,0}, {67,55,0}, {75,59,7}, {87,67,7},
+    {95,71,7}, {107,75,11}, {119,83,15}, {131,87,19}, {139,91,19}, {151,95,27}, {163,99,31}, {175,103,35},
+    {35,19,7}, {47,23,11}, {59,31,15}, {75,35,19}, {87,43,23}, {99,47,31}, {115,55,35}, {127,59,43},
+    {143,67,51}, {159,79,51}, {175,99,47}, {191,119,47}, {207,143,43}, {223,171,39}, {239,203,31}, {255,243,27},
+    {11,7,0}, {27,19,0}, {43,35,15}, {55,43,19}, {71,51,27}, {83,55,35}, {99,63,43}, {111,71,51},
+    {127,83,63}, {139,95,71}, {155,107,83}, {167,123,95}, {183,135,107}, {195,147,123}, {211,163,139}, {227,179,151},
+    {171,139,163}, {159,127,151}, {147,115,135}, {139,103,123}, {127,91,111}, {119,83,99}, {107,75,87}, {95,63,75},
+    {87,55,67}, {75,47,55}, {67,39,47}, {55,31,35}, {43,23,27}, {35,19,19}, {23,11,11}, {15,7,7},
+    {187,115,159}, {175,107,143}, {163,95,131}, {151,87,119}, {139,79,107}, {127,75,95}, {115,67,83}, {107,59,75},
+    {95,51,63}, {83,43,55}, {71,35,43}, {59,31,35}, {47,23,27}, {35,19,19}, {23,11,11}, {15,7,7},
+    {219,195,187}, {203,179,167}, {191,163,155}, {175,151,139}, {163,135,123}, {151,123,111}, {135,111,95}, {123,99,83},
+    {107,87,71}, {95,75,59}, {83,63,51}, {67,51,39}, {55,43,31}, {39,31,23}, {27,19,15}, {15,11,7},
+    {111,131,123}, {103,123,111}, {95,115,103}, {87,107,95}, {79,99,87}, {71,91,79}, {63,83,71}, {55,75,63},
+    {47,67,55}, {43,59,47}, {35,51,39}, {31,43,31}, {23,35,23}, {15,27,19}, {11,19,11}, {7,11,7},
+    {255,243,27}, {239,223,23}, {219,203,19}, {203,183,15}, {187,167,15}, {171,151,11}, {155,131,7}, {139,115,7},
+    {123,99,7}, {107,83,0}, {91,71,0}, {75,55,0}, {59,43,0}, {43,31,0}, {27,15,0}, {11,7,0},
+    {0,0,255}, {11,11,239}, {19,19,223}, {27,27,207}, {35,35,191}, {43,43,175}, {47,47,159}, {47,47,143},
+    {47,47,127}, {47,47,111}, {47,47,95}, {43,43,79}, {35,35,63}, {27,27,47}, {19,19,31}, {11,11,15},
+    {43,0,0}, {59,0,0}, {75,7,0}, {95,7,0}, {111,15,0}, {127,23,7}, {147,31,7}, {163,39,11},
+    {183,51,15}, {195,75,27}, {207,99,43}, {219,127,59}, {227,151,79}, {231,171,95}, {239,191,119}, {247,211,139},
+    {167,123,59}, {183,155,55}, {199,195,55}, {231,227,87}, {127,191,255}, {171,231,255}, {215,255,255}, {103,0,0},
+    {139,0,0}, {179,0,0}, {215,0,0}, {255,0,0}, {255,243,147}, {255,247,199}, {255,255,255}, {159,91,83},
+};
+
+// A wall texture's size, and its full-size mip level as a texture (id 0
+// when the file does not carry its pixels)
+struct WallTexture {
+    int       width   = 64;
+    int       height  = 64;
+    Texture2D texture = {};
+};
+
+WallTexture LoadWallTexture(const BSPFile& bsp, uint32_t id) {
+    WallTexture wt;
+    const DirEntry& dir  = bsp.header.miptex;
+    const uint8_t*  lump = bsp.data.data() + dir.offset;
+    const auto inLump = [&](size_t offset, size_t size) { return offset + size <= (size_t)dir.size; };
+
+    int32_t count = 0, offset = -1;
+    if (!inLump(0, sizeof(count))) return wt;
+    memcpy(&count, lump, sizeof(count));
+    if (count < 0 || id >= (uint32_t)count || !inLump(4 + 4 * (size_t)id, sizeof(offset))) return wt;
+    memcpy(&offset, lump + 4 + 4 * (size_t)id, sizeof(offset));
+    if (offset < 0 || !inLump((size_t)offset, sizeof(Miptex))) return wt;
+
+    Miptex mt;
+    memcpy(&mt, lump + offset, sizeof(mt));
+    if (mt.width == 0 || mt.height == 0 || mt.width > 4096 || mt.height > 4096) return wt;
+    wt.width  = (int)mt.width;
+    wt.height = (int)mt.height;
+
+    const size_t pixels = (size_t)mt.width * mt.height;
+    if (!inLump((size_t)offset + mt.offset[0], pixels)) return wt;
+    const uint8_t* src = lump + offset + mt.offset[0];
+    std::vector<uint8_t> rgb(pixels * 3);
+    for (size_t i = 0; i < pixels; ++i) memcpy(&rgb[i * 3], kPalette[src[i]], 3);
+
+    Image image = {};
+    image.data    = rgb.data();
+    image.width   = wt.width;
+    image.height  = wt.height;
+    image.mipmaps = 1;
+    image.format  = PIXELFORMAT_UNCOMPRESSED_R8G8B8;
+    wt.texture = LoadTextureFromImage(image);
+    return wt;
+}
+
+// Where a face's fan landed in the model
+struct FacePlacement {
+    int32_t mesh       = -1;
+    int32_t firstIndex = 0;
+    int32_t indexCount = 0;
+};
+
+// The world's faces as `model`: one indexed mesh per wall texture, split
+// every 65535 vertices, each face a fan of its own vertices with the face's
+// flat normal.  `placed` gets every face's spot (mesh -1 if skipped),
+// `textures` one entry per material.
+bool BuildModel(const BSPFile& bsp, Model& model, std::vector<FacePlacement>& placed,
+                std::vector<Texture2D>& textures) {
+    const BSPModel& world = bsp.models[0];
+    placed.assign(bsp.faces.size(), {});
+
+    // World faces grouped by wall texture, in order of first use
+    std::unordered_map<uint32_t, int> groupOf;
+    std::vector<uint32_t>             groupTexture;
+    std::vector<std::vector<int32_t>> groups;
+    for (int32_t f = world.face_id; f < world.face_id + world.face_num; ++f) {
+        if (f < 0 || f >= (int32_t)bsp.faces.size()) return false;
+        const Face& face = bsp.faces[f];
+        if (face.ledge_num < 3 || face.texinfo_id >= bsp.texinfos.size()
+            || face.plane_id >= bsp.planes.size() || face.ledge_id < 0
+            || (size_t)face.ledge_id + face.ledge_num > bsp.listedges.size())
+            continue;
+        const uint32_t texture = bsp.texinfos[face.texinfo_id].miptex_id;
+        const auto [it, added] = groupOf.try_emplace(texture, (int)groups.size());
+        if (added) {
+            groups.emplace_back();
+            groupTexture.push_back(texture);
+        }
+        groups[it->second].push_back(f);
+    }
+    if (groups.empty()) return false;
+
+    std::vector<Mesh>           meshes;
+    std::vector<int>            meshMaterial;
+    std::vector<Vector3>        positions, normals, facePositions;
+    std::vector<Vector2>        texcoords, faceTexcoords;
+    std::vector<unsigned short> indices;
+
+    const auto flush = [&](int material) {
+        if (positions.empty()) return;
+        Mesh mesh = {};
+        mesh.vertexCount   = (int)positions.size();
+        mesh.triangleCount = (int)indices.size() / 3;
+        mesh.vertices  = (float*)MemAlloc(mesh.vertexCount * 3 * sizeof(float));
+        mesh.normals   = (float*)MemAlloc(mesh.vertexCount * 3 * sizeof(float));
+        mesh.texcoords = (float*)MemAlloc(mesh.vertexCount * 2 * sizeof(float));
+        mesh.indices   = (unsigned short*)MemAlloc(indices.size() * sizeof(unsigned short));
+        memcpy(mesh.vertices,  positions.data(), positions.size() * sizeof(Vector3));
+        memcpy(mesh.normals,   normals.data(),   normals.size()   * sizeof(Vector3));
+        memcpy(mesh.texcoords, texcoords.data(), texcoords.size() * sizeof(Vector2));
+        memcpy(mesh.indices,   indices.data(),   indices.size()   * sizeof(unsigned short));
+        UploadMesh(&mesh, false);
+        meshes.push_back(mesh);
+        meshMaterial.push_back(material);
+        positions.clear(); normals.clear(); texcoords.clear(); indices.clear();
+    };
+
+    textures.clear();
+    for (size_t g = 0; g < groups.size(); ++g) {
+        const WallTexture wt = LoadWallTexture(bsp, groupTexture[g]);
+        textures.push_back(wt.texture);
+
+        for (const int32_t f : groups[g]) {
+            const Face&    face = bsp.faces[f];
+            const TexInfo& ti   = bsp.texinfos[face.texinfo_id];
+
+            facePositions.clear();
+            faceTexcoords.clear();
+            for (int k = 0; k < face.ledge_num; ++k) {
+                const int32_t edge  = bsp.listedges[face.ledge_id + k];
+                const size_t  index = edge >= 0 ? (size_t)edge : (size_t)(-(int64_t)edge);
+                if (index >= bsp.edges.size()) break;
+                const uint16_t vertex = edge >= 0 ? bsp.edges[index].vs : bsp.edges[index].ve;
+                if (vertex >= bsp.vertices.size()) break;
+                const Vector3 q = bsp.vertices[vertex];
+                facePositions.push_back(FromQuake(q));
+                faceTexcoords.push_back({ (Vector3DotProduct(q, ti.u_axis) + ti.u_offset) / wt.width,
+                                          (Vector3DotProduct(q, ti.v_axis) + ti.v_offset) / wt.height });
+            }
+            if (facePositions.size() != face.ledge_num) continue;
+
+            const Vector3 qn = bsp.planes[face.plane_id].normal;
+            Vector3 normal = { qn.y, qn.z, qn.x };
+            if (face.side) normal = Vector3Negate(normal);
+
+            // The fan (0, j, j + 1) has to wind counter-clockwise seen from the front
+            Vector3 winding = { 0.f, 0.f, 0.f };
+            for (size_t j = 1; j + 1 < facePositions.size(); ++j)
+                winding = Vector3Add(winding, Vector3CrossProduct(
+                    Vector3Subtract(facePositions[j],     facePositions[0]),
+                    Vector3Subtract(facePositions[j + 1], facePositions[0])));
+            if (Vector3DotProduct(winding, normal) < 0.f) {
+                std::reverse(facePositions.begin(), facePositions.end());
+                std::reverse(faceTexcoords.begin(), faceTexcoords.end());
+            }
+
+            if (positions.size() + facePositions.size() > 65535) flush((int)g);
+            const unsigned short base = (unsigned short)positions.size();
+            placed[f] = { (int32_t)meshes.size(), (int32_t)indices.size(),
+                          (int32_t)(facePositions.size() - 2) * 3 };
+            for (size_t j = 1; j + 1 < facePositions.size(); ++j) {
+                indices.push_back(base);
+                indices.push_back((unsigned short)(base + j));
+                indices.push_back((unsigned short)(base + j + 1));
+            }
+            positions.insert(positions.end(), facePositions.begin(), facePositions.end());
+            texcoords.insert(texcoords.end(), faceTexcoords.begin(), faceTexcoords.end());
+            normals.insert(normals.end(), facePositions.size(), normal);
+        }
+        flush((int)g);
+    }
+
+    model = {};
+    model.transform     = MatrixIdentity();
+    model.meshCount     = (int)meshes.size();
+    model.meshes        = (Mesh*)MemAlloc(meshes.size() * sizeof(Mesh));
+    model.meshMaterial  = (int*)MemAlloc(meshes.size() * sizeof(int));
+    memcpy(model.meshes,       meshes.data(),       meshes.size() * sizeof(Mesh));
+    memcpy(model.meshMaterial, meshMaterial.data(), meshes.size() * sizeof(int));
+    model.materialCount = (int)groups.size();
+    model.materials     = (Material*)MemAlloc(groups.size() * sizeof(Material));
+    for (size_t g = 0; g < groups.size(); ++g) {
+        model.materials[g] = LoadMaterialDefault();
+        if (textures[g].id != 0) model.materials[g].maps[MATERIAL_MAP_DIFFUSE].texture = textures[g];
+    }
+    return true;
+}
+
+} // namespace
+
+namespace Hotones {
+
+// ─── LoadModelsFromBSPFile ────────────────────────────────────────────────────
+
+std::vector<Model>
+LoadModelsFromBSPFile(const std::filesystem::path& path)
+{
+    BSPFile bsp;
+    if (!ReadBSP(path, bsp)) return {};
+
+    Model world = {};
+    std::vector<FacePlacement> placed;
+    std::vector<Texture2D>     textures;
+    if (!BuildModel(bsp, world, placed, textures)) {
+        TraceLog(LOG_ERROR, "BSP: %s has no world faces", path.string().c_str());
+        return {};
+    }
+
+    // Hand each mesh to a model of its own, then free the shell around them
+    std::vector<Model> models;
+    for (int i = 0; i < world.meshCount; ++i) {
+        Model m = LoadModelFromMesh(world.meshes[i]);
+        m.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture =
+            world.materials[world.meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE].texture;
+        models.push_back(m);
+    }
+    for (int i = 0; i < world.materialCount; ++i) MemFree(world.materials[i].maps);
+    MemFree(world.materials);
+    MemFree(world.meshes);
+    MemFree(world.meshMaterial);
+    return models;
+}
+
+// ─── BSPWorld ─────────────────────────────────────────────────────────────────
+
+bool BSPWorld::Load(const std::filesystem::path& path, Model& model) {
+    Unload();
+    model = {};
+
+    BSPFile bsp;
+    if (!ReadBSP(path, bsp)) return false;
+
+    // The tree has to hold together before FindLeaf() walks it.  Compilers
+    // write nodes in pre-order, so an inner child always comes after its
+    // parent; one that doesn't could close a cycle the walk never leaves.
+    const BSPModel& world = bsp.models[0];
+    const auto validChild = [&](int32_t parent, int32_t child) {
+        return child >= 0 ? child > parent && child < (int32_t)bsp.nodes.size()
+                          : ~child < (int32_t)bsp.leaves.size();
+    };
+    bool valid = !bsp.leaves.empty() && world.headnode[0] >= 0 && world.headnode[0] < (int32_t)bsp.nodes.size();
+    for (size_t i = 0; i < bsp.nodes.size(); ++i) {
+        const BSPNode& n = bsp.nodes[i];
+        valid = valid && n.plane_id < bsp.planes.size()
+                      && validChild((int32_t)i, n.front) && validChild((int32_t)i, n.back);
+    }
+    for (const BSPLeaf& l : bsp.leaves)
+        valid = valid && (size_t)l.listface_id + l.listface_num <= bsp.listfaces.size()
+                      && (l.visibility_id < 0 || (size_t)l.visibility_id < bsp.visibility.size());
+    for (const uint16_t f : bsp.listfaces)
+        valid = valid && f < bsp.faces.size();
+    if (!valid) {
+        TraceLog(LOG_ERROR, "BSP: %s has a malformed tree", path.string().c_str());
+        return false;
+    }
+
+    std::vector<FacePlacement> placed;
+    if (!BuildModel(bsp, model, placed, m_textures)) {
+        TraceLog(LOG_ERROR, "BSP: %s has no world faces", path.string().c_str());
+        model = {};
+        return false;
+    }
+
+    m_planes.reserve(bsp.planes.size());
+    for (const Plane& p : bsp.planes) m_planes.push_back({ p.normal.x, p.normal.y, p.normal.z, p.dist });
+    m_nodes.reserve(bsp.nodes.size());
+    for (const BSPNode& n : bsp.nodes) m_nodes.push_back({ (int32_t)n.plane_id, { n.front, n.back } });
+    m_leaves.reserve(bsp.leaves.size());
+    for (const BSPLeaf& l : bsp.leaves)
+        m_leaves.push_back({ l.visibility_id, l.listface_id, l.listface_num, FromQuake(l.bound) });
+    m_leafFaces = std::move(bsp.listfaces);
+    m_vis       = std::move(bsp.visibility);
+    m_headNode  = world.headnode[0];
+    m_visLeaves = std::clamp(world.numleafs, 0, (int32_t)m_leaves.size() - 1);
+
+    m_stats = {};
+    m_faces.resize(placed.size());
+    for (size_t f = 0; f < placed.size(); ++f) {
+        m_faces[f] = { placed[f].mesh, placed[f].firstIndex, placed[f].indexCount };
+        if (placed[f].mesh >= 0) ++m_stats.totalFaces;
+    }
+    m_faceMark.assign(m_faces.size(), 0);
+
+    // Without VAOs the views fail and Draw() falls back to the full meshes
+    m_views.resize(model.meshCount);
+    for (int i = 0; i < model.meshCount; ++i) m_views[i].Init(model.meshes[i]);
+
+    m_ready = true;
+    TraceLog(LOG_INFO, "BSP: loaded %s (%d faces in %d meshes, %d leaves, %s)",
+             path.string().c_str(), m_stats.totalFaces, model.meshCount, (int)m_leaves.size(),
+             m_vis.empty() ? "no vis" : "vis");
+    return true;
+}
+
+void BSPWorld::Unload() {
+    for (GFX::MeshView& view : m_views) view.Unload();
+    for (const Texture2D& t : m_textures)
+        if (t.id != 0) UnloadTexture(t);
+    m_views.clear();
+    m_textures.clear();
+    m_planes.clear();
+    m_nodes.clear();
+    m_leaves.clear();
+    m_leafFaces.clear();
+    m_vis.clear();
+    m_faces.clear();
+    m_faceMark.clear();
+    m_visRow.clear();
+    m_visible.clear();
+    m_lastVisible.clear();
+    m_headNode  = 0;
+    m_visLeaves = 0;
+    m_viewLeaf  = -2;
+    m_mark      = 0;
+    m_stats     = {};
+    m_ready     = false;
+}
+
+int BSPWorld::FindLeaf(Vector3 pos) const {
+    if (m_nodes.empty()) return 0;
+    const Vector3 q = ToQuake(pos);
+    int32_t n = m_headNode;
+    while (n >= 0) {
+        const Node&    node  = m_nodes[n];
+        const Vector4& plane = m_planes[node.plane];
+        const float    d     = plane.x * q.x + plane.y * q.y + plane.z * q.z - plane.w;
+        n = node.children[d >= 0.f ? 0 : 1];
+    }
+    return ~n;
+}
+
+void BSPWorld::DecompressVis(int leaf, std::vector<uint8_t>& row) const {
+    const size_t rowBytes = ((size_t)m_visLeaves + 7) >> 3;
+    // Solid space, or a leaf the compiler gave no row, sees everything
+    if (leaf <= 0 || leaf >= (int)m_leaves.size() || m_leaves[leaf].visOffset < 0) {
+        row.assign(rowBytes, 0xFF);
+        return;
+    }
+    row.assign(rowBytes, 0);
+    // Zero bytes are run-length coded: 0, count
+    size_t in = (size_t)m_leaves[leaf].visOffset, out = 0;
+    while (out < rowBytes && in < m_vis.size()) {
+        const uint8_t b = m_vis[in++];
+        if (b != 0) {
+            row[out++] = b;
+        } else if (in < m_vis.size()) {
+            out += m_vis[in++];
+        } else {
+            break;
+        }
+    }
+}
+
+bool BSPWorld::IsVisible(int from, int to) const {
+    if (to < 1 || to > m_visLeaves) return false;
+    std::vector<uint8_t> scratch;
+    const std::vector<uint8_t>* row = &m_visRow;
+    if (from != m_viewLeaf) {
+        DecompressVis(from, scratch);
+        row = &scratch;
+    }
+    return ((*row)[(to - 1) >> 3] >> ((to - 1) & 7)) & 1;
+}
+
+void BSPWorld::Draw(const Model& model, const Matrix& transform, Vector3 viewPos,
+                    const GFX::Frustum& frustum, GFX::RenderQueue& queue) {
+    if (!m_ready || model.meshCount != (int)m_views.size()) return;
+
+    const int leaf = FindLeaf(Vector3Transform(viewPos, MatrixInvert(transform)));
+    if (leaf != m_viewLeaf) {
+        DecompressVis(leaf, m_visRow);
+        m_viewLeaf = leaf;
+    }
+
+    // PVS leaves with faces, and bounds in view
+    m_visible.clear();
+    for (int i = 1; i <= m_visLeaves; ++i) {
+        if (!((m_visRow[(i - 1) >> 3] >> ((i - 1) & 7)) & 1)) continue;
+        const Leaf& l = m_leaves[i];
+        if (l.faceCount == 0 || !frustum.Intersects(GFX::TransformBox(l.box, transform))) continue;
+        m_visible.push_back(i);
+    }
+    if (m_visible != m_lastVisible) {
+        Rebuild();
+        m_lastVisible = m_visible;
+    }
+    m_stats.leaf          = leaf;
+    m_stats.visibleLeaves = (int)m_visible.size();
+
+    for (int i = 0; i < model.meshCount; ++i) {
+        const Material&      material = model.materials[model.meshMaterial[i]];
+        const GFX::MeshView& view     = m_views[i];
+        if (!view.IsReady() || view.IsWhole())
+            queue.Submit(model.meshes[i], material, transform);
+        else if (view.IndexCount() > 0)
+            queue.Submit(view.GetMesh(), material, transform);
+    }
+}
+
+void BSPWorld::Rebuild() {
+    if (++m_mark == 0) {
+        std::fill(m_faceMark.begin(), m_faceMark.end(), 0);
+        m_mark = 1;
+    }
+    for (GFX::MeshView& view : m_views) view.Clear();
+
+    // A face can sit in several leaves; m_faceMark keeps it from going in twice
+    m_stats.faces = 0;
+    for (const int leaf : m_visible) {
+        const Leaf& l = m_leaves[leaf];
+        for (int k = 0; k < l.faceCount; ++k) {
+            const uint16_t f = m_leafFaces[l.firstFace + k];
+            if (m_faceMark[f] == m_mark) continue;
+            m_faceMark[f] = m_mark;
+            const FaceRange& r = m_faces[f];
+            if (r.mesh < 0) continue;
+            m_views[r.mesh].Add(r.firstIndex, r.indexCount);
+            ++m_stats.faces;
+        }
+    }
+    for (GFX::MeshView& view : m_views) view.Upload();
+    ++m_stats.rebuilds;
+}
+
+} // namespace Hotones
@@ -0,0 +1,125 @@
+#include <server/BotSwarm.hpp>
+#include <server/NetworkManager.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+namespace Hotones::Net {
+
+// One bot: its connection and the circle it walks
+struct BotSwarm::Bot {
+    std::unique_ptr<NetworkManager> net;
+    float centreX = 0.f, centreZ = 0.f;
+    float radius  = 10.f;
+    float speed   = 5.f;   // metres per second along the circle
+    float phase   = 0.f;   // radians
+    bool  started = false;
+};
+
+// Bots connecting per swarm frame, so a large swarm does not flood the
+// server's receive ring with CONNECTs at once
+static constexpr int CONNECTS_PER_FRAME = 8;
+static constexpr int FRAME_MS           = 5;
+
+BotSwarm::BotSwarm()  = default;
+BotSwarm::~BotSwarm() { Stop(); }
+
+bool BotSwarm::Start(const std::string& host, uint16_t port, const BotOptions& options) {
+    if (m_running.load() || options.count <= 0) return false;
+    m_options = options;
+    m_options.sendHz = std::max(1, options.sendHz);
+    m_host = host;
+    m_port = port;
+
+    std::mt19937 rng(options.seed);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    m_bots.clear();
+    m_bots.resize(static_cast<size_t>(options.count));
+    for (Bot& bot : m_bots) {
+        // Uniform over the disc
+        const float r = options.areaRadius * std::sqrt(unit(rng));
+        const float a = unit(rng) * 6.2831853f;
+        bot.centreX = r * std::cos(a);
+        bot.centreZ = r * std::sin(a);
+        bot.radius  = 5.f + unit(rng) * 25.f;
+        bot.speed   = 4.f + unit(rng) * 3.f;
+        bot.phase   = unit(rng) * 6.2831853f;
+        bot.net     = std::make_unique<NetworkManager>();
+        bot.net->SetLinkConditions(options.link);
+    }
+    m_running = true;
+    m_thread  = std::thread([this] { Run(); });
+    std::cout << "[Bots] Starting " << options.count << " bots against " << host << ":" << port << "\n";
+    return true;
+}
+
+void BotSwarm::Stop() {
+    if (!m_running.exchange(false)) return;
+    if (m_thread.joinable()) m_thread.join();
+    for (Bot& bot : m_bots) bot.net->Disconnect();
+    m_bots.clear();
+}
+
+BotSwarm::Report BotSwarm::GetReport() const {
+    std::lock_guard<std::mutex> lk(m_reportMutex);
+    return m_report;
+}
+
+void BotSwarm::Run() {
+    using Clock = std::chrono::steady_clock;
+    const auto start      = Clock::now();
+    const auto sendPeriod = std::chrono::duration<double>(1.0 / m_options.sendHz);
+    auto nextSend   = start;
+    auto nextReport = start + std::chrono::seconds(1);
+    size_t toStart  = 0;
+
+    while (m_running.load()) {
+        for (int i = 0; i < CONNECTS_PER_FRAME && toStart < m_bots.size(); ++i, ++toStart) {
+            Bot& bot = m_bots[toStart];
+            bot.started = bot.net->Connect(m_host, m_port, "bot" + std::to_string(toStart));
+        }
+
+        for (Bot& bot : m_bots) if (bot.started) bot.net->Update();
+
+        const auto now = Clock::now();
+        if (now >= nextSend) {
+            nextSend += std::chrono::duration_cast<Clock::duration>(sendPeriod);
+            if (nextSend < now) nextSend = now;   // fell behind: don't burst
+            const float t = std::chrono::duration<float>(now - start).count();
+            for (Bot& bot : m_bots) {
+                if (!bot.net->IsConnected()) continue;
+                const float angle = bot.phase + t * bot.speed / bot.radius;
+                const float x     = bot.centreX + bot.radius * std::cos(angle);
+                const float z     = bot.centreZ + bot.radius * std::sin(angle);
+                // Facing along the circle: forward is (sin yaw, cos yaw)
+                bot.net->SendPlayerUpdate(x, 0.f, z, -angle, 0.f);
+            }
+        }
+
+        if (now >= nextReport) {
+            nextReport += std::chrono::seconds(1);
+            Report r;
+            r.total = static_cast<int>(m_bots.size());
+            for (const Bot& bot : m_bots) {
+                if (!bot.net->IsConnected()) continue;
+                const NetStats s = bot.net->GetStats();
+                ++r.connected;
+                r.packetsInPerSec  += s.total.packetsInPerSec;
+                r.packetsOutPerSec += s.total.packetsOutPerSec;
+                r.bytesInPerSec    += s.total.bytesInPerSec;
+                r.bytesOutPerSec   += s.total.bytesOutPerSec;
+                r.rttMs            += s.total.rttMs;
+            }
+            if (r.connected > 0) r.rttMs /= static_cast<float>(r.connected);
+            std::lock_guard<std::mutex> lk(m_reportMutex);
+            m_report = r;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(FRAME_MS));
+    }
+}
+
+} // namespace Hotones::Net
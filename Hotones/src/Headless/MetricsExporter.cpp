@@ -0,0 +1,147 @@
+// Platform socket headers MUST come first in this TU and nowhere else,
+// so that winsock2.h / windows.h never contaminates raylib-using TUs.
+#ifdef _WIN32
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <winsock2.h>
+  #include <ws2tcpip.h>
+  using SocketHandle = SOCKET;
+  static constexpr SocketHandle INVALID_SOCK_VAL = INVALID_SOCKET;
+  #if defined(_MSC_VER)
+    #pragma comment(lib, "ws2_32.lib")
+  #endif
+#else
+  #include <sys/socket.h>
+  #include <netinet/in.h>
+  #include <netdb.h>
+  #include <unistd.h>
+  #include <fcntl.h>
+  using SocketHandle = int;
+  static constexpr SocketHandle INVALID_SOCK_VAL = -1;
+#endif
+
+#include <server/MetricsExporter.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace Hotones::Net {
+
+// Payload per datagram; under a 1500-byte MTU with headers to spare
+static constexpr size_t MAX_DATAGRAM = 1400;
+
+struct MetricsExporter::Impl {
+    SocketHandle socket = INVALID_SOCK_VAL;
+    sockaddr_in  collector{};
+    std::string  prefix;
+    std::string  pending;   // lines not sent yet
+#ifdef _WIN32
+    bool         wsaStarted = false;
+#endif
+
+    void Send() {
+        if (pending.empty()) return;
+        // A full buffer or an unreachable collector drops the datagram
+#ifdef _WIN32
+        sendto(socket, pending.data(), static_cast<int>(pending.size()), 0,
+               reinterpret_cast<const sockaddr*>(&collector), sizeof(collector));
+#else
+        sendto(socket, pending.data(), pending.size(), MSG_DONTWAIT,
+               reinterpret_cast<const sockaddr*>(&collector), sizeof(collector));
+#endif
+        pending.clear();
+    }
+
+    void Close() {
+        if (socket == INVALID_SOCK_VAL) return;
+#ifdef _WIN32
+        closesocket(socket);
+#else
+        close(socket);
+#endif
+        socket = INVALID_SOCK_VAL;
+    }
+};
+
+MetricsExporter::MetricsExporter() : m_impl(std::make_unique<Impl>()) {}
+
+MetricsExporter::~MetricsExporter() {
+    Flush();
+    m_impl->Close();
+#ifdef _WIN32
+    if (m_impl->wsaStarted) WSACleanup();
+#endif
+}
+
+bool MetricsExporter::Open(const MetricsOptions& options) {
+    Impl& d = *m_impl;
+    d.Close();
+#ifdef _WIN32
+    if (!d.wsaStarted) {
+        WSADATA wsa{};
+        if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+            std::cerr << "[Metrics] WSAStartup failed\n";
+            return false;
+        }
+        d.wsaStarted = true;
+    }
+#endif
+    addrinfo hints{};
+    hints.ai_family   = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    hints.ai_protocol = IPPROTO_UDP;
+    addrinfo* res     = nullptr;
+    const std::string portStr = std::to_string(options.port);
+    if (getaddrinfo(options.host.c_str(), portStr.c_str(), &hints, &res) != 0 || !res) {
+        std::cerr << "[Metrics] Cannot resolve " << options.host << "\n";
+        return false;
+    }
+    std::memcpy(&d.collector, res->ai_addr, sizeof(sockaddr_in));
+    freeaddrinfo(res);
+
+    d.socket = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (d.socket == INVALID_SOCK_VAL) {
+        std::cerr << "[Metrics] socket() failed\n";
+        return false;
+    }
+#ifdef _WIN32
+    u_long on = 1;
+    ioctlsocket(d.socket, FIONBIO, &on);
+#else
+    const int flags = fcntl(d.socket, F_GETFL, 0);
+    if (flags >= 0) fcntl(d.socket, F_SETFL, flags | O_NONBLOCK);
+#endif
+    d.prefix = options.prefix;
+    if (!d.prefix.empty() && d.prefix.back() != '.') d.prefix += '.';
+    d.pending.reserve(MAX_DATAGRAM);
+    std::cout << "[Metrics] Sending statsd gauges to " << options.host << ":" << options.port
+              << " as " << d.prefix << "*\n";
+    return true;
+}
+
+bool MetricsExporter::IsOpen() const {
+    return m_impl->socket != INVALID_SOCK_VAL;
+}
+
+void MetricsExporter::Gauge(const std::string& name, double value) {
+    Impl& d = *m_impl;
+    if (d.socket == INVALID_SOCK_VAL) return;
+    char number[32];
+    std::snprintf(number, sizeof(number), ":%.6g|g\n", value);
+    const size_t length = d.prefix.size() + name.size() + std::strlen(number);
+    if (d.pending.size() + length > MAX_DATAGRAM) d.Send();
+    d.pending += d.prefix;
+    d.pending += name;
+    d.pending += number;
+}
+
+void MetricsExporter::Flush() {
+    if (m_impl->socket != INVALID_SOCK_VAL) m_impl->Send();
+}
+
+} // namespace Hotones::Net
@@ -10,6 +10,7 @@
   #include <winsock2.h>
   #include <ws2tcpip.h>
   #include <mswsock.h>   // SIO_UDP_CONNRESET
+  using PollFd = WSAPOLLFD;
   using SocketHandle = SOCKET;
   static constexpr SocketHandle INVALID_SOCK_VAL = INVALID_SOCKET;
   using SockLen = int;
@@ -22,6 +23,13 @@
   #include <arpa/inet.h>
   #include <netdb.h>       // getaddrinfo, freeaddrinfo, gai_strerror
   #include <unistd.h>
+  #include <sys/uio.h>     // iovec for recvmmsg / sendmmsg
+  #include <poll.h>
+  #include <fcntl.h>
+  #if defined(__linux__)
+    #include <sys/eventfd.h>
+  #endif
+  using PollFd = pollfd;
   using SocketHandle = int;
   static constexpr SocketHandle INVALID_SOCK_VAL = -1;
   using SockLen = socklen_t;
@@ -29,82 +37,724 @@
 
 // Now include our own header (it no longer pulls windows.h)
 #include <server/NetworkManager.hpp>
-
+#include <server/InterestGrid.hpp>
+#include <server/PacketView.hpp>
+#include <server/PlayerIds.hpp>
+#include <server/PoseBuffer.hpp>
+#include <server/ReliableChannel.hpp>
+#include <server/SendBudget.hpp>
+#include <server/Snapshot.hpp>
+#include <server/SpscRing.hpp>
+#include <server/TimerWheel.hpp>
+#include <Profile/Profiler.hpp>
+#include <Memory/FrameArena.hpp>
+#include <Memory/MemoryTracker.hpp>
+#include <Time/FrameClock.hpp>
+
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstddef>
 #include <cstring>
 #include <iostream>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <vector>
 
 namespace Hotones::Net {
 
 // ─── Internal types (invisible to all other TUs) ─────────────────────────────
 
+// Datagrams and bytes one way, with the rate over the last stats window
+struct TrafficCounter {
+    uint64_t packets = 0, bytes = 0;
+    uint64_t markPackets = 0, markBytes = 0;   // counts when the window opened
+    float    packetsPerSec = 0.f, bytesPerSec = 0.f;
+
+    void Add(size_t len) { ++packets; bytes += len; }
+
+    void Roll(double seconds) {
+        packetsPerSec = static_cast<float>((packets - markPackets) / seconds);
+        bytesPerSec   = static_cast<float>((bytes   - markBytes)   / seconds);
+        markPackets   = packets;
+        markBytes     = bytes;
+    }
+};
+
+// Traffic on one connection and the round trip of the PINGs sent over it.
+// A PING is counted lost once a later one is answered first.
+struct LinkStats {
+    static constexpr float RTT_SMOOTHING  = 0.125f;
+    static constexpr float LOSS_SMOOTHING = 0.1f;
+
+    TrafficCounter in, out;
+    float    rttMs    = 0.f;
+    float    loss     = 0.f;   // 0..1
+    uint32_t lastPong = 0;
+    bool     hasPong  = false;
+
+    // PINGs found lost by this answer; -1 for a repeat or a reordered one
+    int Pong(uint32_t seq, double rttSeconds) {
+        if (hasPong && static_cast<int32_t>(seq - lastPong) <= 0) return -1;
+        const uint32_t missed = hasPong ? std::min<uint32_t>(seq - lastPong - 1, 32) : 0;
+        for (uint32_t i = 0; i < missed; ++i) loss += (1.f - loss) * LOSS_SMOOTHING;
+        loss -= loss * LOSS_SMOOTHING;
+        const float sample = static_cast<float>(rttSeconds * 1000.0);
+        rttMs    = hasPong ? rttMs + (sample - rttMs) * RTT_SMOOTHING : sample;
+        lastPong = seq;
+        hasPong  = true;
+        return static_cast<int>(missed);
+    }
+};
+
+// Send times of the last few PINGs, by sequence number
+static constexpr uint32_t PING_HISTORY = 8;
+
+// Another player's PLAYER_STATE stream to one client, and whether that
+// player is inside the client's area of interest
+struct OutboundStream {
+    StateSender tx;
+    uint32_t    seenTick = 0;   // last snapshot tick it was in range
+    // Grows each tick by how much the client cares (nearer, faster); a
+    // state owed goes out once it reaches 1, most overdue first, budget
+    // allowing.  Starts at 1 so a player coming into view is sent at once.
+    float       priority = 1.f;
+    bool        inView   = false;
+    uint8_t     goneLeft = 0;   // out-of-view notices still to send
+};
+
+// One replicated entity as one client has it
+struct EntityProgress {
+    uint32_t acked    = 0;     // newest version acknowledged
+    float    priority = 0.f;   // ticks owed an unacknowledged state
+};
+
 struct ClientSlot {
     sockaddr_in addr     = {};
-    uint8_t     id       = 0;
+    PlayerId    id       = 0;
     char        name[16] = {};
     bool        active   = false;
+    std::chrono::steady_clock::time_point lastHeard {};   // connect, PING or player state
+
+    // Latest pose, from PLAYER_STATE or a legacy PLAYER_UPDATE
+    QuantizedState state;
+    bool           hasState = false;
+
+    // Server movement: newest input command applied, the body it produced
+    // (sent back at the next snapshot tick), and whether the server now
+    // owns this player's position
+    uint16_t       lastInput     = 0;
+    bool           hasInput      = false;
+    BodyCorrection correction;
+    bool           correctionDue = false;
+    bool           serverMoved   = false;
+
+    // PLAYER_STATE streams: this client's own, and every other player's to it
+    StateReceiver                                 inbound;
+    std::unordered_map<PlayerId, OutboundStream>  outbound;
+    std::vector<PlayerId> visible;   // in range as of the last snapshot tick
+    std::vector<PlayerId> leaving;   // went out of range, notices still owed
+
+    ReliableChannel reliable;
+
+    // Replicated entities: the newest version of each this client has
+    // acknowledged with its send priority, and despawns it has not
+    // acknowledged yet
+    std::unordered_map<NetEntityId, EntityProgress> entityAcks;
+    std::vector<NetEntityId>                        entitiesGone;
+
+    // The server PINGs every client too, for its round trip and loss,
+    // which also steer how fast it may send to it
+    LinkStats  link;
+    SendBudget budget;
+    uint32_t  pingSeq = 0;
+    std::chrono::steady_clock::time_point nextPing {};
+    std::array<std::chrono::steady_clock::time_point, PING_HISTORY> pingSent {};
 };
 
 struct RawPacket {
     uint8_t     data[512] = {};
     int         len       = 0;
     sockaddr_in from      = {};
+    std::chrono::steady_clock::time_point at {};   // when the receive thread read it
+};
+
+// A queued send: `len` bytes at `offset` in Impl::sendBytes, to `addr`.
+// Broadcast entries share one copy of the payload.
+struct OutDatagram {
+    sockaddr_in addr   = {};
+    uint32_t    offset = 0;
+    uint32_t    len    = 0;
+};
+
+// Datagrams moved per syscall where the platform can batch: Linux takes
+// them with recvmmsg / sendmmsg.  Windows and other POSIX systems have no
+// multi-datagram call for unconnected UDP sockets (short of Registered
+// I/O), so they fall back to one recvfrom / sendto each.
+static constexpr int RECV_BATCH = 32;
+static constexpr int SEND_BATCH = 64;
+// Datagrams that may wait for the send thread before further batches are
+// dropped; only reached if it is starved for several frames
+static constexpr size_t SEND_BACKLOG_MAX = 8192;
+
+// PLAYER_STATE building blocks, collected before the packet is written
+struct StateAck { PlayerId subject; uint8_t seq; };
+struct StateOut {
+    PlayerId subject; const QuantizedState* state; StateSender* sender;
+    float distSq = 0.f; float* priority = nullptr;
+};
+
+// A snapshot too big for one PlayerStatePacket is split into pages, each
+// sized for the worst case so it can never overflow; at 483 bytes a page
+// fits RawPacket and stays under any path MTU.
+static constexpr int STATE_PAGE_BITS  = static_cast<int>(sizeof(PlayerStatePacket::bits)) * 8;
+static constexpr int STATE_ACK_BITS   = 16 + 8;
+static constexpr int STATE_ENTRY_BITS = 16 + STATE_MAX_BITS;
+static constexpr int STATE_GONE_BITS  = 16;
+// What SendBudget charges a state before it is encoded: the worst case
+static constexpr float STATE_ENTRY_BYTES = STATE_ENTRY_BITS / 8.f;
+static_assert(3 * 8 + STATE_ENTRY_BITS <= STATE_PAGE_BITS);
+static_assert(16 + 4 + INPUT_REDUNDANCY * INPUT_COMMAND_BITS <= static_cast<int>(sizeof(InputPacket::bits)) * 8);
+static_assert(ReliableChannel::HEADER_BITS + ReliableChannel::MESSAGE_BITS + RELIABLE_MAX_MESSAGE * 8
+              <= sizeof(ReliablePacket::bits) * 8);
+static_assert(sizeof(MasterListRespPacket) <= sizeof(RawPacket::data));
+
+// ENTITY_STATE pages are filled with as many entities as fit; the largest
+// possible state still fits an empty one.
+static constexpr int ENTITY_PAGE_BITS = static_cast<int>(sizeof(EntityStatePacket::bits)) * 8;
+static_assert(2 * 8 + 16 + ENTITY_STATE_MAX_BITS <= ENTITY_PAGE_BITS);
+
+// How long a client ignores states for an entity after its despawn, so a
+// late datagram cannot bring it back
+static constexpr double ENTITY_RETIRE_SECONDS = 1.0;
+
+// An ENTITY_STATE entry to write: `acked` is the receiver's baseline
+struct EntityOut { NetEntityId id; const EntityHistory* history; uint32_t acked; float* priority = nullptr; };
+struct EntityAck { NetEntityId id; uint8_t seq; };
+
+// A player that leaves a client's area of interest is announced this many
+// ticks running; the notice has no ack, and losing all of them only leaves
+// a stale ghost on that client for a while.
+static constexpr uint8_t GONE_REPEATS = 4;
+
+// Remote players packed densely for per-frame iteration, plus a table by
+// PlayerId slot index for lookup.  Removal swaps the last entry down.
+// poses[i] holds the received poses dense[i] is drawn from.
+struct RemotePlayerTable {
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    std::vector<RemotePlayer> dense;
+    std::vector<PoseBuffer>   poses;
+    std::vector<uint32_t>     where = std::vector<uint32_t>(PlayerIdAllocator::INDEX_MASK + 1u, NONE);
+
+    const RemotePlayer* Find(PlayerId id) const {
+        const uint32_t w = where[PlayerIdAllocator::Index(id)];
+        return w != NONE && dense[w].id == id ? &dense[w] : nullptr;
+    }
+
+    // The entry for id, created if needed.  An older generation in the
+    // same slot is replaced.
+    RemotePlayer& Upsert(PlayerId id) {
+        uint32_t& w = where[PlayerIdAllocator::Index(id)];
+        if (w == NONE) {
+            w = static_cast<uint32_t>(dense.size());
+            dense.emplace_back();
+            poses.emplace_back();
+        } else if (dense[w].id != id) {
+            dense[w] = RemotePlayer{};
+            poses[w].Clear();
+        }
+        dense[w].id = id;
+        return dense[w];
+    }
+
+    void Erase(PlayerId id) {
+        const uint16_t index = PlayerIdAllocator::Index(id);
+        const uint32_t w     = where[index];
+        if (w == NONE || dense[w].id != id) return;
+        where[index] = NONE;
+        if (w + 1 != dense.size()) {
+            dense[w] = dense.back();
+            poses[w] = poses.back();
+            where[PlayerIdAllocator::Index(dense[w].id)] = w;
+        }
+        dense.pop_back();
+        poses.pop_back();
+    }
+
+    void Clear() {
+        for (const RemotePlayer& rp : dense) where[PlayerIdAllocator::Index(rp.id)] = NONE;
+        dense.clear();
+        poses.clear();
+    }
+
+    // A pose received at time t.  With no render delay it is drawn as is;
+    // otherwise Resample() picks it up.
+    void Push(PlayerId id, double t, const Pose& p, double renderDelay) {
+        RemotePlayer& rp = Upsert(id);
+        PoseBuffer&   pb = poses[where[PlayerIdAllocator::Index(id)]];
+        const bool first = !rp.active;
+        pb.Push(t, p, renderDelay);
+        rp.active = true;
+        if (first || renderDelay <= 0.0) SetPose(rp, p);
+    }
+
+    // Move every player to where its buffer puts it at renderTime.
+    void Resample(double renderTime, double maxExtrapolate) {
+        Pose p;
+        for (size_t i = 0; i < dense.size(); ++i)
+            if (poses[i].Sample(renderTime, maxExtrapolate, p)) SetPose(dense[i], p);
+    }
+
+    static void SetPose(RemotePlayer& rp, const Pose& p) {
+        rp.posX = p.posX; rp.posY = p.posY; rp.posZ = p.posZ;
+        rp.rotX = p.rotX; rp.rotY = p.rotY;
+    }
 };
 
+// Seconds on the frame clock, the time base of PoseBuffer samples: the
+// client's frame time, so a replayed session interpolates as it did when
+// recorded; steady time on a server, which has no frames
+static double NowSeconds() {
+    return Time::FrameClock::Get().Now();
+}
+
+// How far a remote player may be drawn past its newest pose before it
+// eases back (see PoseBuffer)
+static constexpr double MAX_EXTRAPOLATION = 0.05;
+
+// Received datagrams waiting for Update(); about 540 KB of RawPackets.
+// Sized for a few hundred clients each sending once per server frame.
+static constexpr size_t RECV_RING = 1024;
+
+// Block the receive thread until the socket or the wake handle is readable,
+// or timeoutMs passes (-1 = no timeout).
+static int PollSockets(PollFd* fds, int count, int timeoutMs) {
+#ifdef _WIN32
+    return WSAPoll(fds, static_cast<ULONG>(count), timeoutMs);
+#else
+    return poll(fds, static_cast<nfds_t>(count), timeoutMs);
+#endif
+}
+
+static bool SetNonBlocking(SocketHandle s) {
+#ifdef _WIN32
+    u_long on = 1;
+    return ioctlsocket(s, FIONBIO, &on) == 0;
+#else
+    const int flags = fcntl(s, F_GETFL, 0);
+    return flags >= 0 && fcntl(s, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+static void CloseSocketHandle(SocketHandle s) {
+#ifdef _WIN32
+    closesocket(s);
+#else
+    close(s);
+#endif
+}
+
+// Resolve an IP string ("192.168.1.5") or a hostname ("myserver") to an
+// IPv4 address; inet_pton alone would only take the former.  Blocks on DNS.
+static bool ResolveHost(const std::string& host, uint16_t port, sockaddr_in& out, int* error = nullptr) {
+    addrinfo hints{};
+    hints.ai_family   = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    hints.ai_protocol = IPPROTO_UDP;
+    addrinfo* res     = nullptr;
+    const std::string portStr = std::to_string(port);
+    const int err = getaddrinfo(host.c_str(), portStr.c_str(), &hints, &res);
+    if (error) *error = err;
+    if (err != 0 || !res) return false;
+    std::memcpy(&out, res->ai_addr, sizeof(sockaddr_in));
+    freeaddrinfo(res);
+    return true;
+}
+
 // ─── Impl ─────────────────────────────────────────────────────────────────────
 
 struct NetworkManager::Impl {
     // Socket
     SocketHandle      socket  = INVALID_SOCK_VAL;
 
+    // Wakes RecvLoop out of its poll when stopping: an eventfd on Linux,
+    // elsewhere a loopback UDP socket that sends itself a byte.
+    SocketHandle      wake    = INVALID_SOCK_VAL;
+    sockaddr_in       wakeAddr = {};
+
+    // Retry and keepalive timers; touched only by the receive thread
+    TimerWheel        timers;
+
+    // Simulated bad network on the receive path (SetLinkConditions); the
+    // conditioner belongs to the receive thread, which configures it from
+    // linkConditions when it starts
+    LinkConditions              linkConditions;
+    LinkConditioner<RawPacket>  conditioner;
+
     // Mode / run state
     NetworkManager::Mode  mode    = NetworkManager::Mode::None;
     std::atomic<bool>     running { false };
     std::thread           recvThread;
 
-    // Thread-safe receive queue
-    std::mutex           queueMutex;
-    std::queue<RawPacket> recvQueue;
+    // RecvLoop → Update() hand-off; full means datagrams are dropped and counted
+    SpscRing<RawPacket, RECV_RING> recvRing;
+
+    // Outgoing datagrams queued on the main thread, handed to the send
+    // thread by FlushSends()
+    std::vector<uint8_t>     sendBytes;
+    std::vector<OutDatagram> sendQueue;
+
+    // FlushSends() → SendLoop() hand-off, guarded by sendMutex.  The three
+    // pairs of buffers are swapped between the threads, never reallocated
+    // once warm.
+    std::mutex               sendMutex;
+    std::condition_variable  sendWake;
+    std::vector<uint8_t>     sendPendingBytes;
+    std::vector<OutDatagram> sendPending;
+    std::thread              sendThread;
+    bool                     sendStop      = false;
+    uint64_t                 sendOverflows = 0;   // dropped at SEND_BACKLOG_MAX (main thread)
 
     // Server state
-    ClientSlot clients[MAX_PLAYERS];
-    uint8_t    nextId = 1;
+    // Indexed by PlayerIdAllocator::Index(id); [0] is the host and unused
+    std::vector<ClientSlot> clients;
+    PlayerIdAllocator       ids;
+    // Active slots keyed by AddrKey(addr), so per-packet lookup stays O(1)
+    // however many slots there are
+    std::unordered_map<uint64_t, uint16_t> slotByAddr;
+    // Scratch reused by every snapshot tick and broadcast
+    std::vector<StateOut>    stateScratch;
+    std::vector<StateAck>    ackScratch;
+    std::vector<PlayerId>    goneScratch;
+    std::vector<sockaddr_in> addrScratch;
 
     // Client state
     sockaddr_in serverAddr  = {};
-    uint8_t     localId     = 0;
-    bool        connected   = false;
+    std::atomic<PlayerId> localId  { 0 };       // written by Update(), read by RecvLoop
+    std::atomic<bool>    connected { false };
     char        localName[16] = "Player";
 
-    // Remote player snapshots
-    std::unordered_map<uint8_t, RemotePlayer> remotePlayers;
-
-    // Connection retry (client mode)
-    std::chrono::steady_clock::time_point lastConnectAttempt {};
-    int connectAttempts = 0;
+    // Remote player snapshots, drawn renderDelayMs behind the newest so
+    // there is usually a received pose on either side to interpolate
+    RemotePlayerTable remotePlayers;
+    int               renderDelayMs = 100;
+
+    // Compressed PLAYER_STATE streams (server/Snapshot.hpp)
+    float positionGrid = DEFAULT_POSITION_GRID;   // server's choice, sent in CONNECT_ACK
+    // Client: own pose to the server; every other player's pose from it
+    StateSender                                ownStream;
+    std::unordered_map<PlayerId, StateReceiver> remoteStreams;
+    // Server: the host's pose (subject 0) and the snapshot tick.  Every
+    // snapshotIntervalMs each client gets one aggregated PLAYER_STATE.
+    QuantizedState hostState;
+    bool           hasHostState    = false;
+    bool           snapshotDirty   = false;   // states arrived or acks owed since the last tick
+    bool           snapshotPending = false;   // the last tick sent states not yet acked
+    int            snapshotIntervalMs = 50;
+    uint32_t       snapshotTick       = 0;
+    std::chrono::steady_clock::time_point lastSnapshot {};
+    // Area of interest: a client only hears about players within
+    // interestRadius metres (0 = everyone), found through interestGrid.
+    float          interestRadius = 150.f;
+    InterestGrid   interestGrid;
+    // Each client's send rate is estimated within these (SetSendBudget)
+    SendBudget::Limits budgetLimits;
+
+    // Replicated entities.  Server: each entity's state history, the ids
+    // still despawning (clients yet to acknowledge, by id, so they are not
+    // reused meanwhile) and the next id to try.  Client: one receiver per
+    // entity, the despawns to acknowledge, and recently despawned ids.
+    std::unordered_map<NetEntityId, EntityHistory> netEntities;
+    std::unordered_map<NetEntityId, uint16_t>      entitiesRetiring;
+    NetEntityId                                    nextNetEntity = 1;
+    std::vector<EntityOut>                         entityScratch;
+    std::unordered_map<NetEntityId, EntityReceiver> entityStreams;
+    std::vector<NetEntityId>                       entityGoneAcks;
+    std::unordered_map<NetEntityId, double>        entitiesRetired;
+    bool                                           entityAcksOwed = false;
+
+    // Server movement.  Server: offered in CONNECT_ACK.  Client: accepted
+    // from it, the inputs sent but not yet covered by a correction, and the
+    // newest correction for TakeCorrection().
+    bool                      serverMovement = false;
+    std::vector<InputCommand> sentInputs;
+    BodyCorrection            correction;
+    bool                      correctionReady = false;
+    bool                      everCorrected   = false;
+    static constexpr size_t   MAX_SENT_INPUTS = 64;
+
+    // Client: reliable messages to and from the server (the server keeps
+    // one per ClientSlot)
+    ReliableChannel reliable;
+
+    // Connection retry and keepalive (client mode, receive thread)
+    int      connectAttempts = 0;
+    std::atomic<uint32_t> pingSeq { 0 };   // read by Update() for PONGs
+    // Keepalive PING send times, steady-clock ns, for the round trip
+    std::array<std::atomic<int64_t>, PING_HISTORY> pingSentNs {};
     static constexpr int    MAX_CONNECT_ATTEMPTS  = 15;
     static constexpr int    CONNECT_RETRY_MS      = 500;
+    static constexpr int    KEEPALIVE_MS          = 1000;
+    // Server drops a client it has not heard from for this long
+    static constexpr int    CLIENT_TIMEOUT_MS     = 10000;
+
+    // Statistics (GetStats).  Datagrams the receive thread sends itself
+    // (connect retries, keepalives) are counted in rawSent* and folded in
+    // by Update().
+    TrafficCounter totalIn, totalOut;
+    LinkStats      serverLink;   // client: the connection to the server
+    size_t         recvQueuePeak   = 0;   // over the last window
+    size_t         recvQueueWindow = 0;   // over the current one
+    std::atomic<uint64_t> rawSentPackets { 0 }, rawSentBytes { 0 };
+    std::chrono::steady_clock::time_point statsMark = std::chrono::steady_clock::now();
+    static constexpr int STATS_WINDOW_MS = 1000;
 
     // Server advertisement
     char     hostedPakName[32]  = {};
     uint16_t boundPort          = 0;
 
-    // Ping results (written by detached PingServer threads, drained by Update())
+    // SERVER_INFO_RESP as last built by PublishServerInfo() on the main
+    // thread; the receive thread answers queries and sends heartbeats from it
+    std::mutex           infoMutex;
+    ServerInfoRespPacket info{};
+
+    // Master list this server announces itself to (SetMasterServer)
+    bool        hasMaster  = false;
+    sockaddr_in masterAddr = {};
+
+    // Mode::Master: registered servers by address
+    struct MasterRecord {
+        MasterListEntry                       entry{};
+        std::chrono::steady_clock::time_point lastHeard;
+    };
+    std::unordered_map<uint64_t, MasterRecord> masterList;
+    static constexpr size_t MASTER_MAX_SERVERS = 255 * MASTER_LIST_PAGE;
+
+    // Mode::Master: datagrams (heartbeats and list requests) taken from each
+    // source IP, as a token bucket; ports are no use as a key, they cost a
+    // forger nothing.  Full buckets are forgotten once too many are kept.
+    struct MasterQuota {
+        float                                 tokens = 0.f;
+        std::chrono::steady_clock::time_point refilled;
+    };
+    std::unordered_map<uint32_t, MasterQuota> masterQuota;
+    static constexpr float  MASTER_QUOTA_RATE    = 32.f;   // per second
+    static constexpr float  MASTER_QUOTA_BURST   = 64.f;
+    static constexpr size_t MASTER_QUOTA_SOURCES = 4096;
+
+    // ── Server-browser pinging ────────────────────────────────────────────────
+    // PingServers() queues requests for the ping thread, which is started on
+    // first use and owns one socket for every query.  Results are drained by
+    // Update().  All of it is guarded by pingMutex.
+    struct PingRequest {
+        ServerEndpoint endpoint;
+        int            timeoutMs = 0;
+        bool           master    = false;   // MASTER_LIST_REQ pages instead of SERVER_INFO_REQ
+    };
     struct PingResult {
         std::string host;
         uint16_t    port        = 0;
-        uint8_t     playerCount = 0;
-        uint8_t     maxPlayers  = 0;
+        uint16_t    playerCount = 0;
+        uint16_t    maxPlayers  = 0;
         char        pakName[32]    = {};
         char        gameVersion[16] = {};
         char        pakVersion[16]  = {};
     };
-    std::mutex              pingMutex;
-    std::vector<PingResult> pingResults;
+    std::mutex               pingMutex;
+    std::condition_variable  pingWake;
+    std::vector<PingRequest> pingQueue;
+    std::vector<PingResult>  pingResults;
+    std::thread              pingThread;
+    bool                     pingStop = false;
+
+    // How often a busy ping thread looks for new requests
+    static constexpr int PING_POLL_MS = 20;
+
+    void PingLoop() {
+        SocketHandle sock = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (sock == INVALID_SOCK_VAL || !SetNonBlocking(sock)) {
+            std::cerr << "[Net] Cannot open a socket for server queries\n";
+            if (sock != INVALID_SOCK_VAL) CloseSocketHandle(sock);
+            return;
+        }
+#ifdef _WIN32
+        {
+            // A server that is down answers with ICMP Port Unreachable; keep
+            // that from failing the next recvfrom (see InitSocket)
+            DWORD dwBytes = 0; BOOL bDisable = FALSE;
+            WSAIoctl(sock, SIO_UDP_CONNRESET, &bDisable, sizeof(bDisable),
+                     nullptr, 0, &dwBytes, nullptr, nullptr);
+        }
+#endif
+        using Clock = std::chrono::steady_clock;
+        struct InFlight {
+            ServerEndpoint    endpoint;
+            sockaddr_in       addr{};
+            Clock::time_point deadline;
+            int               timeoutMs = 0;   // master: from the last page
+            bool              master = false;
+            std::vector<bool> pagesSeen;   // master: sized by the first page
+        };
+        std::vector<InFlight>    inFlight;
+        std::vector<PingRequest> fresh;
+
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lk(pingMutex);
+                if (inFlight.empty())
+                    pingWake.wait(lk, [this] { return pingStop || !pingQueue.empty(); });
+                if (pingStop) break;
+                fresh.clear();
+                std::swap(fresh, pingQueue);
+            }
+
+            for (const PingRequest& req : fresh) {
+                InFlight f;
+                if (!ResolveHost(req.endpoint.host, req.endpoint.port, f.addr)) continue;
+                if (req.master) {
+                    SendMasterListReq(sock, f.addr, 0);
+                } else {
+                    ServerInfoReqPacket pkt{};
+                    pkt.header.type     = PacketType::SERVER_INFO_REQ;
+                    pkt.header.playerId = 0;
+                    PingSend(sock, f.addr, &pkt, sizeof(pkt));
+                }
+                f.endpoint  = req.endpoint;
+                f.master    = req.master;
+                f.timeoutMs = req.timeoutMs;
+                f.deadline  = Clock::now() + std::chrono::milliseconds(req.timeoutMs);
+                inFlight.push_back(std::move(f));
+            }
+            if (inFlight.empty()) continue;
+
+            // Until the nearest deadline, but wake now and then for new requests
+            auto nearest = inFlight.front().deadline;
+            for (const InFlight& f : inFlight) nearest = std::min(nearest, f.deadline);
+            const auto wait = std::chrono::ceil<std::chrono::milliseconds>(nearest - Clock::now()).count();
+            PollFd fd{};
+            fd.fd     = sock;
+            fd.events = POLLIN;
+            PollSockets(&fd, 1, static_cast<int>(std::clamp<long long>(wait, 0, PING_POLL_MS)));
+
+            for (;;) {
+                uint8_t     buf[512];
+                sockaddr_in from{};
+                SockLen     fromLen = sizeof(from);
+#ifdef _WIN32
+                const int n = recvfrom(sock, reinterpret_cast<char*>(buf), static_cast<int>(sizeof(buf)), 0,
+                                       reinterpret_cast<sockaddr*>(&from), &fromLen);
+#else
+                const int n = static_cast<int>(recvfrom(sock, buf, sizeof(buf), 0,
+                                                        reinterpret_cast<sockaddr*>(&from), &fromLen));
+#endif
+                if (n < 0) break;   // drained
+                const auto sameAddr = [&from](const InFlight& f) {
+                    return f.addr.sin_addr.s_addr == from.sin_addr.s_addr && f.addr.sin_port == from.sin_port;
+                };
+                PacketView pkt;
+                if (!PacketView::Parse(buf, static_cast<size_t>(n), pkt)) continue;
+                if (pkt.Type() == PacketType::MASTER_LIST_RESP) {
+                    HandleMasterPage(pkt, inFlight, sameAddr, sock);
+                    continue;
+                }
+                if (pkt.Type() != PacketType::SERVER_INFO_RESP) continue;
+                const ServerInfoRespPacket& resp = pkt.As<ServerInfoRespPacket>();
+
+                // Every query out to that address is answered
+                std::lock_guard<std::mutex> lk(pingMutex);
+                std::erase_if(inFlight, [&](const InFlight& f) {
+                    if (f.master || !sameAddr(f)) return false;
+                    PingResult pr;
+                    pr.host        = f.endpoint.host;
+                    pr.port        = f.endpoint.port;
+                    pr.playerCount = resp.playerCount;
+                    pr.maxPlayers  = resp.maxPlayers;
+                    std::memcpy(pr.pakName,     resp.pakName,     sizeof(pr.pakName));
+                    std::memcpy(pr.gameVersion, resp.gameVersion, sizeof(pr.gameVersion));
+                    std::memcpy(pr.pakVersion,  resp.pakVersion,  sizeof(pr.pakVersion));
+                    pingResults.push_back(std::move(pr));
+                    return true;
+                });
+            }
+
+            const auto now = Clock::now();
+            std::erase_if(inFlight, [now](const InFlight& f) { return f.deadline <= now; });
+        }
+        CloseSocketHandle(sock);
+    }
+
+    static void PingSend(SocketHandle sock, const sockaddr_in& addr, const void* data, size_t len) {
+#ifdef _WIN32
+        sendto(sock, reinterpret_cast<const char*>(data), static_cast<int>(len), 0,
+               reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+#else
+        sendto(sock, data, len, 0, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+#endif
+    }
+
+    static void SendMasterListReq(SocketHandle sock, const sockaddr_in& addr, uint8_t page) {
+        MasterListReqPacket req{};
+        req.header.type     = PacketType::MASTER_LIST_REQ;
+        req.header.playerId = 0;
+        req.page            = page;
+        PingSend(sock, addr, &req, sizeof(req));
+    }
+
+    // A MASTER_LIST_RESP page: a result for every entry, then the next page
+    // is asked for, and the query is done once every page has come.  Each
+    // page restarts the timeout.  Duplicate pages are ignored; the list may
+    // change between pages, so a server can show up twice or not at all.
+    template <typename InFlightList, typename Match>
+    void HandleMasterPage(const PacketView& pkt, InFlightList& inFlight, const Match& sameAddr,
+                          SocketHandle sock) {
+        // Only the page header and `count` entries are on the wire; the
+        // struct is read in place no further than that
+        const auto& page = *reinterpret_cast<const MasterListRespPacket*>(pkt.Data());
+        if (page.count > MASTER_LIST_PAGE
+            || pkt.Size() < offsetof(MasterListRespPacket, entries) + page.count * sizeof(MasterListEntry)) return;
+
+        std::lock_guard<std::mutex> lk(pingMutex);
+        for (auto it = inFlight.begin(); it != inFlight.end(); ) {
+            if (!it->master || !sameAddr(*it)) { ++it; continue; }
+            if (it->pagesSeen.empty()) it->pagesSeen.assign(std::max<size_t>(1, page.pageCount), false);
+            if (page.page < it->pagesSeen.size() && !it->pagesSeen[page.page]) {
+                it->pagesSeen[page.page] = true;
+                for (int i = 0; i < page.count; ++i) {
+                    const MasterListEntry& e = page.entries[i];
+                    char ip[INET_ADDRSTRLEN] = {};
+                    in_addr addr{};
+                    addr.s_addr = e.ipv4;
+                    inet_ntop(AF_INET, &addr, ip, sizeof(ip));
+                    PingResult pr;
+                    pr.host        = ip;
+                    pr.port        = e.port;
+                    pr.playerCount = e.playerCount;
+                    pr.maxPlayers  = e.maxPlayers;
+                    std::memcpy(pr.pakName,     e.pakName,     sizeof(pr.pakName));
+                    std::memcpy(pr.gameVersion, e.gameVersion, sizeof(pr.gameVersion));
+                    std::memcpy(pr.pakVersion,  e.pakVersion,  sizeof(pr.pakVersion));
+                    pingResults.push_back(std::move(pr));
+                }
+            }
+            const auto missing = std::find(it->pagesSeen.begin(), it->pagesSeen.end(), false);
+            if (missing == it->pagesSeen.end()) { it = inFlight.erase(it); continue; }
+            SendMasterListReq(sock, it->addr, static_cast<uint8_t>(missing - it->pagesSeen.begin()));
+            it->deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(it->timeoutMs);
+            ++it;
+        }
+    }
+
+    void StopPinging() {
+        {
+            std::lock_guard<std::mutex> lk(pingMutex);
+            pingStop = true;
+        }
+        pingWake.notify_one();
+        if (pingThread.joinable()) pingThread.join();
+    }
 
     // ── Socket helpers ────────────────────────────────────────────────────────
     bool InitSocket(uint16_t bindPort) {
@@ -113,9 +763,14 @@ struct NetworkManager::Impl {
             std::cerr << "[Net] socket() failed\n";
             return false;
         }
-        int opt = 1;
-        setsockopt(socket, SOL_SOCKET, SO_REUSEADDR,
-                   reinterpret_cast<const char*>(&opt), sizeof(opt));
+        // Only for a fixed port: with SO_REUSEADDR, Linux may hand two
+        // ephemeral (port 0) sockets the same port, and the clients behind
+        // them would then share one server slot
+        if (bindPort != 0) {
+            int opt = 1;
+            setsockopt(socket, SOL_SOCKET, SO_REUSEADDR,
+                       reinterpret_cast<const char*>(&opt), sizeof(opt));
+        }
 
 #ifdef _WIN32
         // Disable ICMP Port Unreachable from causing recvfrom to return WSAECONNRESET.
@@ -142,29 +797,69 @@ struct NetworkManager::Impl {
             return false;
         }
         boundPort = bindPort;
-        // 200 ms recv timeout so RecvLoop can check `running` periodically
-#ifdef _WIN32
-        DWORD tv = 200;
-        setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO,
-                   reinterpret_cast<const char*>(&tv), sizeof(tv));
-#else
-        timeval tv{ 0, 200000 };
-        setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-#endif
+        // RecvLoop waits in poll(), so reads must never block
+        if (!SetNonBlocking(socket) || !OpenWake()) {
+            std::cerr << "[Net] Cannot set up socket polling\n";
+            CloseSocket();
+            return false;
+        }
         return true;
     }
 
     void CloseSocket() {
+        if (wake != INVALID_SOCK_VAL) { CloseSocketHandle(wake); wake = INVALID_SOCK_VAL; }
         if (socket == INVALID_SOCK_VAL) return;
-#ifdef _WIN32
-        closesocket(socket);
+        CloseSocketHandle(socket);
+        socket = INVALID_SOCK_VAL;
+    }
+
+    // ── Wake handle ───────────────────────────────────────────────────────────
+    bool OpenWake() {
+#if defined(__linux__)
+        wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        return wake != INVALID_SOCK_VAL;
 #else
-        close(socket);
+        wake = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (wake == INVALID_SOCK_VAL) return false;
+        wakeAddr = {};
+        wakeAddr.sin_family      = AF_INET;
+        wakeAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        SockLen len = sizeof(wakeAddr);
+        return bind(wake, reinterpret_cast<sockaddr*>(&wakeAddr), sizeof(wakeAddr)) == 0
+            && getsockname(wake, reinterpret_cast<sockaddr*>(&wakeAddr), &len) == 0
+            && SetNonBlocking(wake);
+#endif
+    }
+
+    // Any thread: make RecvLoop's poll return now.
+    void Wake() {
+#if defined(__linux__)
+        const uint64_t one = 1;
+        [[maybe_unused]] auto n = write(wake, &one, sizeof(one));
+#else
+        const char byte = 0;
+        sendto(wake, &byte, 1, 0, reinterpret_cast<const sockaddr*>(&wakeAddr), sizeof(wakeAddr));
 #endif
-        socket = INVALID_SOCK_VAL;
     }
 
+    void DrainWake() {
+#if defined(__linux__)
+        uint64_t count;
+        [[maybe_unused]] auto n = read(wake, &count, sizeof(count));
+#else
+        char buf[16];
+        while (recv(wake, buf, sizeof(buf), 0) > 0) {}
+#endif
+    }
+
+    // Unbatched send from any thread, counted for GetStats()
     void SendRaw(const sockaddr_in& addr, const void* data, int len) {
+        SendTo(addr, data, len);
+        rawSentPackets.fetch_add(1, std::memory_order_relaxed);
+        rawSentBytes.fetch_add(static_cast<uint64_t>(len), std::memory_order_relaxed);
+    }
+
+    void SendTo(const sockaddr_in& addr, const void* data, int len) {
 #ifdef _WIN32
         sendto(socket, reinterpret_cast<const char*>(data), len, 0,
                reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
@@ -175,103 +870,519 @@ struct NetworkManager::Impl {
     }
 
     // ── Background receive thread ─────────────────────────────────────────────
+    // Sleeps in poll() until a datagram arrives, the next timer is due or
+    // Wake() is called; there is no periodic wake-up.
     void RecvLoop() {
-        uint8_t buf[512];
+        HOTONES_THREAD("Net receive");
+        RawPacket spill[RECV_BATCH];   // datagrams past the ring's free room
+        timers.Clear();
+        conditioner.Configure(linkConditions);
+        if (mode == NetworkManager::Mode::Client)
+            timers.Schedule(std::chrono::milliseconds(0), [this] { ClientTick(); });
+        if (mode == NetworkManager::Mode::Server && hasMaster)
+            timers.Schedule(std::chrono::milliseconds(0), [this] { MasterHeartbeat(); });
+
         while (running.load()) {
-            // Client: resend ConnectPacket every CONNECT_RETRY_MS until acknowledged.
-            if (mode == NetworkManager::Mode::Client && !connected
-                    && connectAttempts < MAX_CONNECT_ATTEMPTS) {
-                auto now = std::chrono::steady_clock::now();
-                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-                                    now - lastConnectAttempt).count();
-                if (elapsed >= CONNECT_RETRY_MS) {
-                    ConnectPacket pkt{};
-                    pkt.header.type     = PacketType::CONNECT;
-                    pkt.header.playerId = 0;
-                    std::strncpy(pkt.name, localName, 15);
-                    pkt.name[15] = '\0';
-                    SendRaw(serverAddr, &pkt, sizeof(pkt));
-                    lastConnectAttempt = now;
-                    ++connectAttempts;
-                    std::cout << "[Net] ConnectPacket attempt "
-                              << connectAttempts << "/" << MAX_CONNECT_ATTEMPTS << "\n";
+            PollFd fds[2] = {};
+            fds[0].fd     = socket;
+            fds[0].events = POLLIN;
+            fds[1].fd     = wake;
+            fds[1].events = POLLIN;
+            int timeoutMs = timers.MsUntilNext();
+            const int heldMs = conditioner.MsUntilNext(std::chrono::steady_clock::now());
+            if (heldMs >= 0 && (timeoutMs < 0 || heldMs < timeoutMs)) timeoutMs = heldMs;
+            if (PollSockets(fds, 2, timeoutMs) > 0) {
+                if (fds[1].revents & POLLIN) DrainWake();
+                if (!running.load()) break;
+                if (fds[0].revents & (POLLIN | POLLERR)) {
+                    HOTONES_ZONE("Net receive");
+                    while (ReceiveBatch(spill) == RECV_BATCH) {}
                 }
             }
+            // Held datagrams arrive now, stamped with their release time
+            conditioner.Release(std::chrono::steady_clock::now(), [this](RawPacket& rp, auto due) {
+                rp.at = due;
+                Deliver(rp);
+            });
+            timers.Advance();
+        }
+        conditioner.Clear();
+    }
 
-            sockaddr_in from{};
-            SockLen fromLen = sizeof(from);
-#ifdef _WIN32
+    // Client timer chain: resend ConnectPacket every CONNECT_RETRY_MS until
+    // acknowledged, then PING every KEEPALIVE_MS so the server keeps the slot.
+    void ClientTick() {
+        if (!connected.load()) {
+            if (connectAttempts >= MAX_CONNECT_ATTEMPTS) return;
+            ConnectPacket pkt{};
+            pkt.header.type     = PacketType::CONNECT;
+            pkt.header.playerId = 0;
+            std::strncpy(pkt.name, localName, 15);
+            pkt.name[15] = '\0';
+            SendRaw(serverAddr, &pkt, sizeof(pkt));
+            ++connectAttempts;
+            std::cout << "[Net] ConnectPacket attempt "
+                      << connectAttempts << "/" << MAX_CONNECT_ATTEMPTS << "\n";
+            timers.Schedule(std::chrono::milliseconds(CONNECT_RETRY_MS), [this] { ClientTick(); });
+        } else {
+            PingPacket ping{};
+            ping.header.type     = PacketType::PING;
+            ping.header.playerId = localId.load();
+            ping.seq             = ++pingSeq;
+            pingSentNs[ping.seq % PING_HISTORY] = std::chrono::steady_clock::now().time_since_epoch().count();
+            SendRaw(serverAddr, &ping, sizeof(ping));
+            timers.Schedule(std::chrono::milliseconds(KEEPALIVE_MS), [this] { ClientTick(); });
+        }
+    }
+
+    // Whether a datagram goes on to Update().  Runts and unknown types are
+    // dropped here, and a server answers info queries itself, from the
+    // published reply, so scanners never cost the game loop.
+    bool Screen(const RawPacket& rp) {
+        PacketView pkt;
+        if (!PacketView::Parse(rp.data, static_cast<size_t>(rp.len), pkt)) return false;
+        if (mode == NetworkManager::Mode::Server && pkt.Type() == PacketType::SERVER_INFO_REQ) {
+            const ServerInfoRespPacket resp = PublishedInfo();
+            SendRaw(rp.from, &resp, sizeof(resp));
+            return false;
+        }
+        return true;
+    }
+
+    // A datagram released by the link conditioner
+    void Deliver(const RawPacket& rp) {
+        if (Screen(rp)) recvRing.TryPush(rp);
+    }
+
+    // Read every datagram already waiting on the socket, up to RECV_BATCH,
+    // straight into free ring slots; returns how many were read.  Those that
+    // Update() will not see are squeezed out before the slots are published,
+    // so the usual datagram is never copied.  Past the room left in the ring
+    // they land in `spill` and are dropped as overflows (info queries are
+    // still answered), so the socket keeps draining.
+    int ReceiveBatch(RawPacket* spill) {
+        const int room = static_cast<int>(recvRing.Claimable(RECV_BATCH));
+        RawPacket* slots[RECV_BATCH];
+        for (int i = 0; i < RECV_BATCH; ++i) slots[i] = i < room ? &recvRing.Claim(i) : &spill[i];
+        int got = 0;
+#if defined(__linux__)
+        mmsghdr msgs[RECV_BATCH];
+        iovec   iov[RECV_BATCH];
+        for (int i = 0; i < RECV_BATCH; ++i) {
+            iov[i]  = { slots[i]->data, sizeof(slots[i]->data) };
+            msgs[i] = {};
+            msgs[i].msg_hdr.msg_name    = &slots[i]->from;
+            msgs[i].msg_hdr.msg_namelen = sizeof(slots[i]->from);
+            msgs[i].msg_hdr.msg_iov     = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen  = 1;
+        }
+        got = recvmmsg(socket, msgs, RECV_BATCH, MSG_DONTWAIT, nullptr);
+        if (got <= 0) return 0; // EAGAIN — drained
+        for (int i = 0; i < got; ++i) slots[i]->len = static_cast<int>(msgs[i].msg_len);
+#else
+        for (; got < RECV_BATCH; ++got) {
+            RawPacket& rp = *slots[got];
+            SockLen fromLen = sizeof(rp.from);
+  #ifdef _WIN32
             int n = recvfrom(socket,
-                             reinterpret_cast<char*>(buf),
-                             static_cast<int>(sizeof(buf)),
+                             reinterpret_cast<char*>(rp.data),
+                             static_cast<int>(sizeof(rp.data)),
                              0,
-                             reinterpret_cast<sockaddr*>(&from), &fromLen);
+                             reinterpret_cast<sockaddr*>(&rp.from), &fromLen);
+  #else
+            ssize_t n = recvfrom(socket, rp.data, sizeof(rp.data), 0,
+                                 reinterpret_cast<sockaddr*>(&rp.from), &fromLen);
+  #endif
+            if (n <= 0) break; // WSAEWOULDBLOCK / EAGAIN — drained
+            rp.len = static_cast<int>(n);
+        }
+#endif
+        const auto at = std::chrono::steady_clock::now();
+        const bool conditioned = conditioner.Active();
+        int kept = 0;
+        for (int i = 0; i < got; ++i) {
+            RawPacket& rp = *slots[i];
+            rp.at = at;
+            if (conditioned) {
+                if (rp.len >= static_cast<int>(sizeof(PacketHeader))) conditioner.Accept(rp, at);
+                continue;
+            }
+            if (!Screen(rp)) continue;
+            if (i >= room) { recvRing.CountOverflow(); continue; }
+            // Close the gap left by the ones screened out
+            if (kept != i) *slots[kept] = rp;
+            ++kept;
+        }
+        recvRing.Publish(static_cast<size_t>(kept));
+        return got;
+    }
+
+    // ── Batched sends ─────────────────────────────────────────────────────────
+    // The main thread builds datagrams into sendQueue / sendBytes and
+    // FlushSends() passes the lot to the send thread, which makes the
+    // syscalls.  Without a send thread (replay) FlushSends() sends itself.
+
+    // Queue `data` for every address in addrs; the payload is stored once.
+    void QueueSend(const sockaddr_in* addrs, int count, const void* data, int len) {
+        if (count <= 0) return;
+        const uint32_t offset = static_cast<uint32_t>(sendBytes.size());
+        const uint8_t* bytes  = static_cast<const uint8_t*>(data);
+        sendBytes.insert(sendBytes.end(), bytes, bytes + len);
+        for (int i = 0; i < count; ++i)
+            sendQueue.push_back({ addrs[i], offset, static_cast<uint32_t>(len) });
+    }
+
+    // Hand everything queued since the last flush to the send thread.
+    // Counted as sent here, where the per-connection stats live.
+    void FlushSends() {
+        if (sendQueue.empty()) return;
+        if (!sendThread.joinable()) {
+            for (const OutDatagram& d : sendQueue) CountSent(d.addr, d.len);
+            SendBatch(sendQueue, sendBytes);
+        } else {
+            std::unique_lock<std::mutex> lk(sendMutex);
+            if (!sendPending.empty() && sendPending.size() + sendQueue.size() > SEND_BACKLOG_MAX) {
+                // The send thread is far behind; UDP may lose these anyway
+                sendOverflows += sendQueue.size();
+            } else {
+                for (const OutDatagram& d : sendQueue) CountSent(d.addr, d.len);
+                if (sendPending.empty()) {
+                    std::swap(sendPending, sendQueue);
+                    std::swap(sendPendingBytes, sendBytes);
+                } else {
+                    // Still sending an earlier batch: append, rebasing offsets
+                    const uint32_t base = static_cast<uint32_t>(sendPendingBytes.size());
+                    sendPendingBytes.insert(sendPendingBytes.end(), sendBytes.begin(), sendBytes.end());
+                    for (OutDatagram d : sendQueue) {
+                        d.offset += base;
+                        sendPending.push_back(d);
+                    }
+                }
+                lk.unlock();
+                sendWake.notify_one();
+            }
+        }
+        sendQueue.clear();
+        sendBytes.clear();
+    }
+
+    // Send thread: wait for batches and send them until StopSending()
+    // with nothing left pending.
+    void SendLoop() {
+        HOTONES_THREAD("Net send");
+        std::vector<uint8_t>     bytes;
+        std::vector<OutDatagram> queue;
+        std::unique_lock<std::mutex> lk(sendMutex);
+        for (;;) {
+            sendWake.wait(lk, [this] { return sendStop || !sendPending.empty(); });
+            if (sendPending.empty()) break;   // stopping, and drained
+            std::swap(queue, sendPending);
+            std::swap(bytes, sendPendingBytes);
+            lk.unlock();
+            {
+                HOTONES_ZONE("Net send");
+                SendBatch(queue, bytes);
+            }
+            queue.clear();
+            bytes.clear();
+            lk.lock();
+        }
+    }
+
+    void StartSending() {
+        sendStop = false;
+        sendThread = std::thread([this] { SendLoop(); });
+    }
+
+    // Send what is pending and stop the send thread; before CloseSocket()
+    void StopSending() {
+        if (!sendThread.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lk(sendMutex);
+            sendStop = true;
+        }
+        sendWake.notify_one();
+        sendThread.join();
+    }
+
+    // The syscalls: sendmmsg in SEND_BATCH runs where there is one
+    void SendBatch(std::vector<OutDatagram>& queue, const std::vector<uint8_t>& bytes) {
+#if defined(__linux__)
+        mmsghdr msgs[SEND_BATCH];
+        iovec   iov[SEND_BATCH];
+        for (size_t first = 0; first < queue.size();) {
+            const int count = static_cast<int>(std::min<size_t>(SEND_BATCH, queue.size() - first));
+            for (int i = 0; i < count; ++i) {
+                OutDatagram& d = queue[first + i];
+                iov[i]  = { const_cast<uint8_t*>(bytes.data()) + d.offset, d.len };
+                msgs[i] = {};
+                msgs[i].msg_hdr.msg_name    = &d.addr;
+                msgs[i].msg_hdr.msg_namelen = sizeof(d.addr);
+                msgs[i].msg_hdr.msg_iov     = &iov[i];
+                msgs[i].msg_hdr.msg_iovlen  = 1;
+            }
+            const int sent = sendmmsg(socket, msgs, static_cast<unsigned>(count), 0);
+            // UDP is best-effort: a datagram the kernel refused is dropped
+            // rather than retried, as a failed sendto would be
+            first += static_cast<size_t>(sent > 0 ? sent : 1);
+        }
 #else
-            ssize_t n = recvfrom(socket, buf, sizeof(buf), 0,
-                                 reinterpret_cast<sockaddr*>(&from), &fromLen);
+        for (const OutDatagram& d : queue)
+            SendTo(d.addr, bytes.data() + d.offset, static_cast<int>(d.len));
 #endif
-            if (n <= 0) continue; // timeout / EAGAIN — loop and check running
-            if (n < static_cast<int>(sizeof(PacketHeader))) continue;
+    }
+
+    // ── Statistics ────────────────────────────────────────────────────────────
+    LinkStats* FindLink(const sockaddr_in& addr) {
+        if (mode == NetworkManager::Mode::Client) return &serverLink;
+        ClientSlot* slot = Server_FindSlot(addr);
+        return slot ? &slot->link : nullptr;
+    }
 
-            RawPacket rp;
-            rp.len  = (n < static_cast<int>(sizeof(rp.data)))
-                      ? n : static_cast<int>(sizeof(rp.data));
-            std::memcpy(rp.data, buf, rp.len);
-            rp.from = from;
+    void CountSent(const sockaddr_in& to, size_t len) {
+        totalOut.Add(len);
+        if (mode == NetworkManager::Mode::Client) {
+            serverLink.out.Add(len);
+        } else if (ClientSlot* slot = Server_FindSlot(to)) {
+            slot->link.out.Add(len);
+            slot->budget.Spend(len);
+        }
+    }
+
+    void CountReceived(const RawPacket& rp) {
+        totalIn.Add(static_cast<size_t>(rp.len));
+        if (LinkStats* link = FindLink(rp.from)) link->in.Add(static_cast<size_t>(rp.len));
+    }
 
-            std::lock_guard<std::mutex> lk(queueMutex);
-            recvQueue.push(rp);
+    // Once per Update(): fold in the receive thread's sends, and close the
+    // rate window once a second.
+    // Heap held by the Impl and its containers, roughly: capacities, and
+    // hash maps as their buckets plus one node per element
+    template<typename Map>
+    static size_t MapBytes(const Map& m) {
+        return m.bucket_count() * sizeof(void*) + m.size() * (sizeof(typename Map::value_type) + 2 * sizeof(void*));
+    }
+    template<typename T>
+    static size_t VecBytes(const std::vector<T>& v) { return v.capacity() * sizeof(T); }
+
+    size_t BufferBytes() const {
+        size_t bytes = sizeof(Impl) + VecBytes(sendBytes) + VecBytes(sendQueue) + VecBytes(clients) +
+                       MapBytes(slotByAddr) + VecBytes(stateScratch) + VecBytes(ackScratch) +
+                       VecBytes(goneScratch) + VecBytes(addrScratch) + VecBytes(remotePlayers.dense) +
+                       VecBytes(remotePlayers.poses) + VecBytes(remotePlayers.where) + MapBytes(remoteStreams) +
+                       MapBytes(netEntities) + MapBytes(entitiesRetiring) + VecBytes(entityScratch) +
+                       MapBytes(entityStreams) + VecBytes(entityGoneAcks) + MapBytes(entitiesRetired) +
+                       VecBytes(sentInputs);
+        for (const ClientSlot& c : clients) {
+            if (!c.active) continue;
+            bytes += MapBytes(c.outbound) + VecBytes(c.visible) + VecBytes(c.leaving) +
+                     MapBytes(c.entityAcks) + VecBytes(c.entitiesGone);
+        }
+        return bytes;
+    }
+    Memory::TaggedBytes bufferBytes{ Memory::Tag::Network };   // BufferBytes(), as of the last Update()
+
+    void UpdateStats() {
+        const uint64_t rawPackets = rawSentPackets.exchange(0, std::memory_order_relaxed);
+        const uint64_t rawBytes   = rawSentBytes.exchange(0, std::memory_order_relaxed);
+        totalOut.packets += rawPackets;
+        totalOut.bytes   += rawBytes;
+        if (mode == NetworkManager::Mode::Client) {
+            serverLink.out.packets += rawPackets;
+            serverLink.out.bytes   += rawBytes;
         }
+
+        const auto   now     = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(now - statsMark).count();
+        if (seconds * 1000.0 < STATS_WINDOW_MS) return;
+        statsMark = now;
+        totalIn.Roll(seconds);
+        totalOut.Roll(seconds);
+        serverLink.in.Roll(seconds);
+        serverLink.out.Roll(seconds);
+        for (auto& slot : clients)
+            if (slot.active) { slot.link.in.Roll(seconds); slot.link.out.Roll(seconds); }
+        recvQueuePeak   = recvQueueWindow;
+        recvQueueWindow = 0;
+    }
+
+    void ResetStats() {
+        totalIn    = {};
+        totalOut   = {};
+        serverLink = {};
+        recvQueuePeak = recvQueueWindow = 0;
+        rawSentPackets = 0;
+        rawSentBytes   = 0;
+        statsMark  = std::chrono::steady_clock::now();
+    }
+
+    static ConnectionStats ToConnectionStats(PlayerId id, const LinkStats& link, size_t reliablePending,
+                                             float sendRate = 0.f) {
+        ConnectionStats s;
+        s.id               = id;
+        s.packetsIn        = link.in.packets;
+        s.packetsOut       = link.out.packets;
+        s.bytesIn          = link.in.bytes;
+        s.bytesOut         = link.out.bytes;
+        s.packetsInPerSec  = link.in.packetsPerSec;
+        s.packetsOutPerSec = link.out.packetsPerSec;
+        s.bytesInPerSec    = link.in.bytesPerSec;
+        s.bytesOutPerSec   = link.out.bytesPerSec;
+        s.rttMs            = link.rttMs;
+        s.lossPercent      = link.loss * 100.f;
+        s.reliablePending  = reliablePending;
+        s.sendRate         = sendRate;
+        return s;
     }
 
     // ── Server broadcast ──────────────────────────────────────────────────────
-    void Server_Broadcast(const uint8_t* data, int len, uint8_t excludeId = 0xFF) {
+    // Queued, not sent: the fan-out of a whole Update() leaves in one
+    // FlushSends().
+    void Server_Broadcast(const uint8_t* data, int len, PlayerId excludeId = 0) {
+        addrScratch.clear();
         for (auto& slot : clients)
             if (slot.active && slot.id != excludeId)
-                SendRaw(slot.addr, data, len);
+                addrScratch.push_back(slot.addr);
+        QueueSend(addrScratch.data(), static_cast<int>(addrScratch.size()), data, len);
     }
 
     // ── Server packet handlers ────────────────────────────────────────────────
-    void Server_HandleServerInfoReq(const sockaddr_in& from) {
-        uint8_t count = 0;
-        for (const auto& s : clients) if (s.active) ++count;
-
+    // Rebuild the SERVER_INFO_RESP the receive thread hands out.  Main
+    // thread, whenever a field in it changes.
+    void PublishServerInfo() {
         ServerInfoRespPacket resp{};
         resp.header.type     = PacketType::SERVER_INFO_RESP;
         resp.header.playerId = 0;
-        resp.playerCount     = count;
-        resp.maxPlayers      = MAX_PLAYERS;
+        resp.playerCount     = ids.InUse();
+        resp.maxPlayers      = ids.Capacity();
         resp.port            = boundPort;
         std::memcpy(resp.pakName, hostedPakName, 32);
         // serverName left empty for now
         std::memcpy(resp.gameVersion, GAME_VERSION, sizeof(resp.gameVersion));
         // pakVersion left empty unless set elsewhere
-        SendRaw(from, &resp, sizeof(resp));
+        std::lock_guard<std::mutex> lk(infoMutex);
+        info = resp;
+    }
+
+    ServerInfoRespPacket PublishedInfo() {
+        std::lock_guard<std::mutex> lk(infoMutex);
+        return info;
+    }
+
+    // Receive thread: announce ourselves to the master list, then again
+    // every MASTER_HEARTBEAT_MS.
+    void MasterHeartbeat() {
+        MasterHeartbeatPacket beat = PublishedInfo();
+        beat.header.type = PacketType::MASTER_HEARTBEAT;
+        SendRaw(masterAddr, &beat, sizeof(beat));
+        timers.Schedule(std::chrono::milliseconds(NetworkManager::MASTER_HEARTBEAT_MS), [this] { MasterHeartbeat(); });
+    }
+
+    // ── Master list (Mode::Master) ────────────────────────────────────────────
+    void Master_Expire() {
+        const auto now = std::chrono::steady_clock::now();
+        std::erase_if(masterList, [now](const auto& kv) {
+            return now - kv.second.lastHeard > std::chrono::milliseconds(NetworkManager::MASTER_EXPIRY_MS);
+        });
+    }
+
+    // Whether `from` may have one more datagram taken in or answered now
+    bool Master_Admit(const sockaddr_in& from, std::chrono::steady_clock::time_point now) {
+        auto it = masterQuota.find(from.sin_addr.s_addr);
+        if (it == masterQuota.end()) {
+            if (masterQuota.size() >= MASTER_QUOTA_SOURCES) {
+                const auto idle = std::chrono::duration<float>(MASTER_QUOTA_BURST / MASTER_QUOTA_RATE);
+                std::erase_if(masterQuota, [&](const auto& kv) { return now - kv.second.refilled >= idle; });
+                if (masterQuota.size() >= MASTER_QUOTA_SOURCES) return false;
+            }
+            it = masterQuota.emplace(from.sin_addr.s_addr, MasterQuota{ MASTER_QUOTA_BURST, now }).first;
+        }
+        MasterQuota& q = it->second;
+        const float elapsed = std::chrono::duration<float>(now - q.refilled).count();
+        q.tokens   = std::min(MASTER_QUOTA_BURST, q.tokens + std::max(elapsed, 0.f) * MASTER_QUOTA_RATE);
+        q.refilled = now;
+        if (q.tokens < 1.f) return false;
+        q.tokens -= 1.f;
+        return true;
+    }
+
+    void Master_HandleHeartbeat(const MasterHeartbeatPacket& beat, const sockaddr_in& from) {
+        const uint64_t key = AddrKey(from);
+        auto it = masterList.find(key);
+        if (beat.maxPlayers == 0) {
+            if (it != masterList.end()) {
+                masterList.erase(it);
+                std::cout << "[Master] Server withdrawn, " << masterList.size() << " listed\n";
+            }
+            return;
+        }
+        if (it == masterList.end()) {
+            if (masterList.size() >= MASTER_MAX_SERVERS) return;
+            it = masterList.emplace(key, MasterRecord{}).first;
+            std::cout << "[Master] Server registered, " << masterList.size() << " listed\n";
+        }
+        MasterListEntry& e = it->second.entry;
+        e.ipv4        = from.sin_addr.s_addr;
+        e.port        = ntohs(from.sin_port);
+        e.playerCount = beat.playerCount;
+        e.maxPlayers  = beat.maxPlayers;
+        std::memcpy(e.pakName,     beat.pakName,     sizeof(e.pakName));
+        std::memcpy(e.serverName,  beat.serverName,  sizeof(e.serverName));
+        std::memcpy(e.gameVersion, beat.gameVersion, sizeof(e.gameVersion));
+        std::memcpy(e.pakVersion,  beat.pakVersion,  sizeof(e.pakVersion));
+        for (char* s : { e.pakName, e.serverName }) s[31] = '\0';
+        for (char* s : { e.gameVersion, e.pakVersion }) s[15] = '\0';
+        it->second.lastHeard = std::chrono::steady_clock::now();
+    }
+
+    // The page asked for, MASTER_LIST_PAGE servers; one past the end (or of
+    // an empty list) goes back empty, with the current page count.
+    void Master_HandleListReq(const MasterListReqPacket& req, const sockaddr_in& from) {
+        Master_Expire();
+        const size_t total = masterList.size();
+        MasterListRespPacket page{};
+        page.header.type     = PacketType::MASTER_LIST_RESP;
+        page.header.playerId = 0;
+        page.page            = req.page;
+        page.pageCount       = static_cast<uint8_t>((total + MASTER_LIST_PAGE - 1) / MASTER_LIST_PAGE);
+        size_t skip = static_cast<size_t>(req.page) * MASTER_LIST_PAGE;
+        for (const auto& kv : masterList) {
+            if (skip > 0) { --skip; continue; }
+            page.entries[page.count++] = kv.second.entry;
+            if (page.count == MASTER_LIST_PAGE) break;
+        }
+        const size_t len = offsetof(MasterListRespPacket, entries) + page.count * sizeof(MasterListEntry);
+        QueueSend(&from, 1, &page, static_cast<int>(len));
     }
 
     void Server_HandleConnect(const ConnectPacket& pkt, const sockaddr_in& from,
                                NetworkManager& nm) {
         // Re-send ACK if already registered (idempotent connect)
-        for (auto& slot : clients) {
-            if (slot.active &&
-                slot.addr.sin_addr.s_addr == from.sin_addr.s_addr &&
-                slot.addr.sin_port        == from.sin_port) {
-                ConnectAckPacket ack{};
-                ack.header.type     = PacketType::CONNECT_ACK;
-                ack.header.playerId = slot.id;
-                ack.assignedId      = slot.id;
-                SendRaw(from, &ack, sizeof(ack));
-                return;
-            }
+        if (ClientSlot* known = Server_FindSlot(from)) {
+            ConnectAckPacket ack{};
+            ack.header.type     = PacketType::CONNECT_ACK;
+            ack.header.playerId = known->id;
+            ack.assignedId      = known->id;
+            ack.positionGrid    = positionGrid;
+            ack.serverMovement  = serverMovement ? 1 : 0;
+            QueueSend(&from, 1, &ack, sizeof(ack));
+            known->lastHeard = std::chrono::steady_clock::now();
+            return;
         }
-        // Find a free slot
-        ClientSlot* slot = nullptr;
-        for (auto& s : clients) { if (!s.active) { slot = &s; break; } }
-        if (!slot) { std::cerr << "[Net] Server full\n"; return; }
+        // Take a free slot; its id carries a fresh generation
+        PlayerId id;
+        if (!ids.Allocate(id)) { std::cerr << "[Net] Server full\n"; return; }
+        const uint16_t index = PlayerIdAllocator::Index(id);
+        ClientSlot*    slot  = &clients[index];
 
+        *slot        = ClientSlot{};
         slot->active = true;
         slot->addr   = from;
-        slot->id     = nextId++;
+        slot->id     = id;
+        slot->lastHeard = std::chrono::steady_clock::now();
+        slot->budget.Reset(budgetLimits, slot->lastHeard);
+        slotByAddr[AddrKey(from)] = index;
+        PublishServerInfo();
         std::strncpy(slot->name, pkt.name, 15);
         slot->name[15] = '\0';
 
@@ -279,125 +1390,761 @@ struct NetworkManager::Impl {
         ack.header.type     = PacketType::CONNECT_ACK;
         ack.header.playerId = slot->id;
         ack.assignedId      = slot->id;
-        SendRaw(from, &ack, sizeof(ack));
+        ack.positionGrid    = positionGrid;
+        ack.serverMovement  = serverMovement ? 1 : 0;
+        QueueSend(&from, 1, &ack, sizeof(ack));
+
+        // No intro broadcast: other clients meet the player in the first
+        // snapshot that has it in their area of interest
 
-        // Notify other clients (zeroed position intro)
-        PlayerUpdatePacket intro{};
-        intro.header.type     = PacketType::PLAYER_UPDATE;
-        intro.header.playerId = slot->id;
-        Server_Broadcast(reinterpret_cast<uint8_t*>(&intro), sizeof(intro), slot->id);
+        // Its first snapshot tick brings it every replicated entity
+        if (!netEntities.empty()) snapshotDirty = true;
 
         std::cout << "[Net] Player " << static_cast<int>(slot->id)
                   << " (\"" << slot->name << "\") joined\n";
         if (nm.OnPlayerJoined) nm.OnPlayerJoined(slot->id, slot->name);
     }
 
+    static uint64_t AddrKey(const sockaddr_in& addr) {
+        return (static_cast<uint64_t>(addr.sin_addr.s_addr) << 16) | addr.sin_port;
+    }
+
+    ClientSlot* Server_FindSlot(const sockaddr_in& from) {
+        auto it = slotByAddr.find(AddrKey(from));
+        return it != slotByAddr.end() ? &clients[it->second] : nullptr;
+    }
+
+    // Free a slot and tell everyone else the player is gone.
+    void Server_DropSlot(ClientSlot& slot, const char* why, NetworkManager& nm) {
+        std::cout << "[Net] Player " << static_cast<int>(slot.id)
+                  << " (\"" << slot.name << "\") " << why << "\n";
+        DisconnectPacket dc{};
+        dc.header.type     = PacketType::DISCONNECT;
+        dc.header.playerId = slot.id;
+        Server_Broadcast(reinterpret_cast<uint8_t*>(&dc), sizeof(dc), slot.id);
+        remotePlayers.Erase(slot.id);
+        for (auto& other : clients) other.outbound.erase(slot.id);   // visible/leaving skip it
+        for (NetEntityId gone : slot.entitiesGone) Server_EntityRetired(gone);
+        if (nm.OnPlayerLeft) nm.OnPlayerLeft(slot.id);
+        slotByAddr.erase(AddrKey(slot.addr));
+        ids.Release(slot.id);
+        slot = ClientSlot{};
+        PublishServerInfo();
+    }
+
     void Server_HandleDisconnect(const DisconnectPacket& /*pkt*/,
                                   const sockaddr_in& from, NetworkManager& nm) {
+        if (ClientSlot* slot = Server_FindSlot(from)) Server_DropSlot(*slot, "left", nm);
+    }
+
+    void Server_HandlePing(const PingPacket& pkt, const sockaddr_in& from) {
+        ClientSlot* slot = Server_FindSlot(from);
+        if (!slot) return;
+        slot->lastHeard = std::chrono::steady_clock::now();
+        PingPacket pong{};
+        pong.header.type     = PacketType::PONG;
+        pong.header.playerId = 0;
+        pong.seq             = pkt.seq;
+        QueueSend(&from, 1, &pong, sizeof(pong));
+    }
+
+    void Server_HandlePong(const PingPacket& pkt, const sockaddr_in& from, std::chrono::steady_clock::time_point at) {
+        ClientSlot* slot = Server_FindSlot(from);
+        if (!slot) return;
+        slot->lastHeard = std::chrono::steady_clock::now();
+        // Only the last PING_HISTORY sends are remembered
+        if (slot->pingSeq - pkt.seq >= PING_HISTORY) return;
+        const double rtt    = std::chrono::duration<double>(at - slot->pingSent[pkt.seq % PING_HISTORY]).count();
+        const int    missed = slot->link.Pong(pkt.seq, rtt);
+        if (missed >= 0) slot->budget.OnRoundTrip(static_cast<float>(rtt * 1000.0), static_cast<uint32_t>(missed), at);
+    }
+
+    // PING each client once per KEEPALIVE_MS; its PONG gives the round trip.
+    void Server_PingClients() {
+        const auto now = std::chrono::steady_clock::now();
         for (auto& slot : clients) {
-            if (slot.active &&
-                slot.addr.sin_addr.s_addr == from.sin_addr.s_addr &&
-                slot.addr.sin_port        == from.sin_port) {
-                std::cout << "[Net] Player " << static_cast<int>(slot.id)
-                          << " (\"" << slot.name << "\") left\n";
-                DisconnectPacket dc{};
-                dc.header.type     = PacketType::DISCONNECT;
-                dc.header.playerId = slot.id;
-                Server_Broadcast(reinterpret_cast<uint8_t*>(&dc), sizeof(dc), slot.id);
-                if (nm.OnPlayerLeft) nm.OnPlayerLeft(slot.id);
-                slot.active = false;
-                return;
-            }
+            if (!slot.active || now < slot.nextPing) continue;
+            slot.nextPing = now + std::chrono::milliseconds(KEEPALIVE_MS);
+            PingPacket ping{};
+            ping.header.type     = PacketType::PING;
+            ping.header.playerId = 0;
+            ping.seq             = ++slot.pingSeq;
+            slot.pingSent[ping.seq % PING_HISTORY] = now;
+            QueueSend(&slot.addr, 1, &ping, sizeof(ping));
         }
     }
 
+    // Drop clients that have sent nothing for CLIENT_TIMEOUT_MS.
+    void Server_ExpireSilentClients(NetworkManager& nm) {
+        const auto cutoff = std::chrono::steady_clock::now()
+                          - std::chrono::milliseconds(CLIENT_TIMEOUT_MS);
+        for (auto& slot : clients)
+            if (slot.active && slot.lastHeard < cutoff) Server_DropSlot(slot, "timed out", nm);
+    }
+
     void Server_HandlePlayerUpdate(const PlayerUpdatePacket& pkt,
                                     const sockaddr_in& from) {
+        ClientSlot* slot = Server_FindSlot(from);
+        if (!slot || slot->id != pkt.header.playerId) return;
+        slot->lastHeard = std::chrono::steady_clock::now();
+        if (slot->serverMoved) return;   // its position is ours to decide
+        // Older clients: fold the pose into the next snapshot tick like a
+        // PLAYER_STATE; the host renders it via GetRemotePlayers().
+        slot->state     = Quantize(pkt.posX, pkt.posY, pkt.posZ, pkt.rotX, pkt.rotY, positionGrid);
+        slot->hasState  = true;
+        ApplyState(slot->id, slot->state);
+        snapshotDirty   = true;
+    }
+
+    // ── Compressed player state ───────────────────────────────────────────────
+    void ApplyState(PlayerId id, const QuantizedState& q) {
+        const Pose p{ GridToPosition(q.x, positionGrid), GridToPosition(q.y, positionGrid),
+                      GridToPosition(q.z, positionGrid), TurnToRadians(q.yaw), TurnToRadians(q.pitch) };
+        remotePlayers.Push(id, NowSeconds(), p, renderDelayMs / 1000.0);
+    }
+
+    // Queue PLAYER_STATE pages to `to`; nothing goes out when there is
+    // nothing to say.  Acks and out-of-view notices ride in the first page.
+    // Encoding advances each sender's sequence number.
+    void QueueStatePacket(const sockaddr_in& to, PlayerId senderId,
+                          const StateAck* acks, int ackCount,
+                          const StateOut* states, int stateCount,
+                          const PlayerId* gone = nullptr, int goneCount = 0) {
+        int nextAck = 0, nextState = 0, nextGone = 0;
+        while (nextAck < ackCount || nextState < stateCount || nextGone < goneCount) {
+            int room = STATE_PAGE_BITS - 3 * 8;
+            const int pageAcks = std::min({ ackCount - nextAck, room / STATE_ACK_BITS, 255 });
+            room -= pageAcks * STATE_ACK_BITS;
+            const int pageGone = std::min({ goneCount - nextGone, room / STATE_GONE_BITS, 255 });
+            room -= pageGone * STATE_GONE_BITS;
+            const int pageStates = std::min({ stateCount - nextState, room / STATE_ENTRY_BITS, 255 });
+
+            PlayerStatePacket pkt;
+            pkt.header.type     = PacketType::PLAYER_STATE;
+            pkt.header.playerId = senderId;
+            BitWriter w(pkt.bits, sizeof(pkt.bits));
+            w.Write(static_cast<uint32_t>(pageAcks), 8);
+            for (const StateAck* a = acks + nextAck; a != acks + nextAck + pageAcks; ++a) {
+                w.Write(a->subject, 16);
+                w.Write(a->seq, 8);
+            }
+            w.Write(static_cast<uint32_t>(pageStates), 8);
+            for (const StateOut* o = states + nextState; o != states + nextState + pageStates; ++o) {
+                w.Write(o->subject, 16);
+                o->sender->Encode(w, *o->state);
+            }
+            w.Write(static_cast<uint32_t>(pageGone), 8);
+            for (const PlayerId* g = gone + nextGone; g != gone + nextGone + pageGone; ++g)
+                w.Write(*g, 16);
+            QueueSend(&to, 1, &pkt, static_cast<int>(sizeof(PacketHeader) + w.Bytes()));
+            nextAck   += pageAcks;
+            nextState += pageStates;
+            nextGone  += pageGone;
+        }
+    }
+
+    float DistanceSq(const QuantizedState& a, const QuantizedState& b) const {
+        const float dx = GridToPosition(a.x - b.x, positionGrid);
+        const float dy = GridToPosition(a.y - b.y, positionGrid);
+        const float dz = GridToPosition(a.z - b.z, positionGrid);
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    void Server_BuildInterestGrid() {
+        interestGrid.Clear(interestRadius);
+        if (hasHostState)
+            interestGrid.Insert(0, GridToPosition(hostState.x, positionGrid),
+                                   GridToPosition(hostState.z, positionGrid));
+        for (size_t i = 1; i < clients.size(); ++i)
+            if (clients[i].active && clients[i].hasState)
+                interestGrid.Insert(static_cast<uint16_t>(i),
+                                    GridToPosition(clients[i].state.x, positionGrid),
+                                    GridToPosition(clients[i].state.z, positionGrid));
+    }
+
+    // Players in slot.visible that were not in range this tick start their
+    // out-of-view notices; returns the notices due now in goneScratch.  A
+    // stream whose last notice has gone is dropped, and the client drops its
+    // end on receipt, so coming back into range starts from a keyframe.
+    void Server_CollectGone(ClientSlot& slot) {
+        goneScratch.clear();
+        size_t keep = 0;
+        for (PlayerId subject : slot.visible) {
+            auto it = slot.outbound.find(subject);
+            if (it == slot.outbound.end()) continue;   // left the server
+            OutboundStream& out = it->second;
+            if (out.seenTick == snapshotTick) { slot.visible[keep++] = subject; continue; }
+            out.inView   = false;
+            out.goneLeft = GONE_REPEATS;
+            out.tx.ForceKeyframe();
+            slot.leaving.push_back(subject);
+        }
+        slot.visible.resize(keep);
+
+        keep = 0;
+        for (PlayerId subject : slot.leaving) {
+            auto it = slot.outbound.find(subject);
+            // Gone from the server, or back in range
+            if (it == slot.outbound.end() || it->second.inView) continue;
+            goneScratch.push_back(subject);
+            if (--it->second.goneLeft > 0) slot.leaving[keep++] = subject;
+            else slot.outbound.erase(it);
+        }
+        slot.leaving.resize(keep);
+        if (keep > 0) snapshotPending = true;   // repeats need further ticks
+    }
+
+    // Snapshot tick: one PLAYER_STATE per client (more pages only if it
+    // overflows) with the ack for its own stream and every player in its
+    // area of interest whose current state it has not acknowledged.
+    // Replaces relaying each update to everyone on arrival, so outbound
+    // datagrams grow with N, not N².
+    //
+    // Candidates come from the 3×3 interest-grid cells around the client,
+    // so the work per client follows how crowded its surroundings are, not
+    // the server.  Within the radius, farther players are sent less often:
+    // their priority grows by 1 a tick inside a quarter of it, by ½ inside
+    // half and by ¼ beyond, so with bandwidth to spare they go every tick,
+    // every 2nd and every 4th.  A client that has not reported a pose yet
+    // hears about everyone.
+    //
+    // Each client's SendBudget caps the states (then entities) a tick
+    // carries: the most overdue go first, the rest keep accumulating
+    // priority and lead a later tick.  Acks, out-of-view notices, despawns
+    // and corrections always go.
+    void Server_SendSnapshots() {
+        snapshotDirty   = false;
+        snapshotPending = false;
+        lastSnapshot    = std::chrono::steady_clock::now();
+        ++snapshotTick;
+        const bool  aoi      = interestRadius > 0.f;
+        const float radiusSq = interestRadius * interestRadius;
+        if (aoi) Server_BuildInterestGrid();
+
         for (auto& slot : clients) {
-            if (slot.active && slot.id == pkt.header.playerId &&
-                slot.addr.sin_addr.s_addr == from.sin_addr.s_addr) {
-                // Keep a server-side snapshot so the hosting player can
-                // render remote clients via GetRemotePlayers().
-                auto& rp  = remotePlayers[pkt.header.playerId];
-                rp.id     = pkt.header.playerId;
-                rp.posX   = pkt.posX; rp.posY = pkt.posY; rp.posZ = pkt.posZ;
-                rp.rotX   = pkt.rotX; rp.rotY = pkt.rotY;
-                rp.active = true;
-                Server_Broadcast(reinterpret_cast<const uint8_t*>(&pkt),
-                                 sizeof(pkt), pkt.header.playerId);
-                return;
+            if (!slot.active) continue;
+            slot.budget.Refill(lastSnapshot);
+            if (slot.correctionDue) Server_QueueCorrection(slot);
+            StateAck ack;
+            const int ackCount = slot.inbound.TakeAck(ack.seq) ? 1 : 0;
+            ack.subject = slot.id;
+
+            const bool filter = aoi && slot.hasState;
+            stateScratch.clear();
+            auto offer = [&](PlayerId subject, const QuantizedState& s) {
+                const float distSq = filter ? DistanceSq(slot.state, s) : 0.f;
+                if (filter && distSq > radiusSq) return;
+                OutboundStream& out = slot.outbound[subject];
+                out.seenTick = snapshotTick;
+                if (!out.inView) {
+                    out.inView = true;
+                    slot.visible.push_back(subject);
+                }
+                const float weight = distSq * 16.f <= radiusSq ? 1.f : distSq * 4.f <= radiusSq ? 0.5f : 0.25f;
+                if (!out.tx.NeedsSend(s)) {   // ready, but no further
+                    out.priority = std::min(out.priority + weight, 1.f);
+                    return;
+                }
+                snapshotPending = true;
+                out.priority += weight;
+                if (out.priority < 1.f) return;
+                stateScratch.push_back({ subject, &s, &out.tx, distSq, &out.priority });
+            };
+            if (filter) {
+                interestGrid.ForEachNear(GridToPosition(slot.state.x, positionGrid),
+                                         GridToPosition(slot.state.z, positionGrid),
+                                         [&](uint16_t index) {
+                    if (index == 0) offer(0, hostState);
+                    else if (clients[index].id != slot.id) offer(clients[index].id, clients[index].state);
+                });
+            } else {
+                if (hasHostState) offer(0, hostState);
+                for (const auto& other : clients)
+                    if (other.active && other.id != slot.id && other.hasState)
+                        offer(other.id, other.state);
+            }
+            Server_CollectGone(slot);
+
+            // As many of the most overdue as the budget allows, nearest
+            // first among equals
+            float left = slot.budget.Available()
+                       - (sizeof(PacketHeader) + (3 * 8 + ackCount * STATE_ACK_BITS
+                                                  + static_cast<int>(goneScratch.size()) * STATE_GONE_BITS) / 8);
+            std::sort(stateScratch.begin(), stateScratch.end(), [](const StateOut& a, const StateOut& b) {
+                return *a.priority != *b.priority ? *a.priority > *b.priority : a.distSq < b.distSq;
+            });
+            size_t fits = 0;
+            for (; fits < stateScratch.size() && left >= STATE_ENTRY_BYTES; ++fits) {
+                left -= STATE_ENTRY_BYTES;
+                *stateScratch[fits].priority = 0.f;
+            }
+            QueueStatePacket(slot.addr, 0, &ack, ackCount,
+                             stateScratch.data(), static_cast<int>(fits),
+                             goneScratch.data(), static_cast<int>(goneScratch.size()));
+            Server_SendEntities(slot, left);
+        }
+    }
+
+    // ── Replicated entities ───────────────────────────────────────────────────
+    // Queue ENTITY_STATE pages: despawns, then states (server) or acks
+    // (client), packed until a page is full.  Nothing goes out when there is
+    // nothing to say.
+    void QueueEntityPacket(const sockaddr_in& to, PlayerId senderId,
+                           const NetEntityId* gone, int goneCount,
+                           const EntityOut* states, int stateCount,
+                           const EntityAck* acks = nullptr, int ackCount = 0) {
+        int nextGone = 0, nextState = 0, nextAck = 0;
+        while (nextGone < goneCount || nextState < stateCount || nextAck < ackCount) {
+            EntityStatePacket pkt;
+            pkt.header.type     = PacketType::ENTITY_STATE;
+            pkt.header.playerId = senderId;
+            BitWriter w(pkt.bits, sizeof(pkt.bits));
+            int room = ENTITY_PAGE_BITS - 2 * 8;
+
+            // A client's page is acks then despawns, a server's despawns
+            // then states
+            auto writeGone = [&] {
+                const int n = std::min({ goneCount - nextGone, room / 16, 255 });
+                room -= n * 16;
+                w.Write(static_cast<uint32_t>(n), 8);
+                for (int i = 0; i < n; ++i) w.Write(gone[nextGone++], 16);
+            };
+            if (mode == NetworkManager::Mode::Client) {
+                const int n = std::min({ ackCount - nextAck, room / 24, 255 });
+                room -= n * 24;
+                w.Write(static_cast<uint32_t>(n), 8);
+                for (int i = 0; i < n; ++i, ++nextAck) {
+                    w.Write(acks[nextAck].id, 16);
+                    w.Write(acks[nextAck].seq, 8);
+                }
+                writeGone();
+            } else {
+                writeGone();
+                int n = 0;
+                while (nextState + n < stateCount && n < 255) {
+                    const EntityOut& o = states[nextState + n];
+                    const int bits = 16 + o.history->EncodedBits(o.acked);
+                    if (bits > room) break;
+                    room -= bits;
+                    ++n;
+                }
+                w.Write(static_cast<uint32_t>(n), 8);
+                for (int i = 0; i < n; ++i, ++nextState) {
+                    const EntityOut& o = states[nextState];
+                    w.Write(o.id, 16);
+                    o.history->Encode(w, o.acked);
+                }
+            }
+            QueueSend(&to, 1, &pkt, static_cast<int>(sizeof(PacketHeader) + w.Bytes()));
+        }
+    }
+
+    // Entity states this client has not acknowledged, the longest owed
+    // first, as many as `budget` bytes allow; and all its pending despawns.
+    // Repeated each tick until acknowledged.
+    void Server_SendEntities(ClientSlot& slot, float budget) {
+        entityScratch.clear();
+        for (const auto& [id, history] : netEntities) {
+            if (history.Version() == 0) continue;   // no state yet
+            EntityProgress& progress = slot.entityAcks[id];
+            if (progress.acked == history.Version()) continue;
+            progress.priority += 1.f;
+            entityScratch.push_back({ id, &history, progress.acked, &progress.priority });
+        }
+        if (entityScratch.empty() && slot.entitiesGone.empty()) return;
+        snapshotPending = true;
+        budget -= static_cast<float>(sizeof(PacketHeader) + 2 + slot.entitiesGone.size() * 2);
+        std::sort(entityScratch.begin(), entityScratch.end(), [](const EntityOut& a, const EntityOut& b) {
+            return *a.priority > *b.priority;
+        });
+        size_t fits = 0;
+        for (; fits < entityScratch.size(); ++fits) {
+            const float bytes = (16 + entityScratch[fits].history->EncodedBits(entityScratch[fits].acked)) / 8.f;
+            if (bytes > budget) break;
+            budget -= bytes;
+            *entityScratch[fits].priority = 0.f;
+        }
+        QueueEntityPacket(slot.addr, 0, slot.entitiesGone.data(), static_cast<int>(slot.entitiesGone.size()),
+                          entityScratch.data(), static_cast<int>(fits));
+    }
+
+    // One client acknowledged (or can no longer acknowledge) a despawn.
+    void Server_EntityRetired(NetEntityId id) {
+        auto it = entitiesRetiring.find(id);
+        if (it != entitiesRetiring.end() && --it->second == 0) entitiesRetiring.erase(it);
+    }
+
+    void Server_HandleEntityState(const PacketView& pkt, const sockaddr_in& from) {
+        ClientSlot* slot = Server_FindSlot(from);
+        if (!slot) return;
+        slot->lastHeard = std::chrono::steady_clock::now();
+        BitReader r = pkt.Bits();
+        for (uint32_t n = r.Read(8); n > 0 && !r.Overflowed(); --n) {
+            const NetEntityId id  = static_cast<NetEntityId>(r.Read(16));
+            const uint8_t     seq = static_cast<uint8_t>(r.Read(8));
+            auto it = netEntities.find(id);
+            if (r.Overflowed() || it == netEntities.end()) continue;
+            const uint32_t version = it->second.Resolve(seq);
+            uint32_t&      acked   = slot->entityAcks[id].acked;
+            if (version > acked) acked = version;
+        }
+        for (uint32_t n = r.Read(8); n > 0 && !r.Overflowed(); --n) {
+            const NetEntityId id = static_cast<NetEntityId>(r.Read(16));
+            auto it = std::find(slot->entitiesGone.begin(), slot->entitiesGone.end(), id);
+            if (r.Overflowed() || it == slot->entitiesGone.end()) continue;
+            slot->entitiesGone.erase(it);
+            Server_EntityRetired(id);
+        }
+    }
+
+    void Client_HandleEntityState(const PacketView& pkt, NetworkManager& nm) {
+        if (!connected) return;
+        const double now = NowSeconds();
+        BitReader r = pkt.Bits();
+        for (uint32_t n = r.Read(8); n > 0 && !r.Overflowed(); --n) {
+            const NetEntityId id = static_cast<NetEntityId>(r.Read(16));
+            if (r.Overflowed()) break;
+            entityGoneAcks.push_back(id);
+            entityAcksOwed = true;
+            if (entityStreams.erase(id) == 0) continue;   // a repeat, or never seen
+            entitiesRetired[id] = now;
+            if (nm.OnEntityDespawned) nm.OnEntityDespawned(id);
+        }
+        std::erase_if(entitiesRetired, [now](const auto& kv) { return now - kv.second > ENTITY_RETIRE_SECONDS; });
+        for (uint32_t n = r.Read(8); n > 0 && !r.Overflowed(); --n) {
+            const NetEntityId id = static_cast<NetEntityId>(r.Read(16));
+            // Decoded into a scratch receiver when it must be ignored, so
+            // the entries after it still line up
+            EntityReceiver  scratch;
+            const bool      retired = entitiesRetired.contains(id);
+            EntityReceiver& rx      = retired ? scratch : entityStreams[id];
+            const bool      known   = rx.HasLatest();
+            const bool      fresh   = rx.Decode(r);
+            if (retired) continue;
+            entityAcksOwed = true;
+            if (!rx.HasLatest()) { entityStreams.erase(id); continue; }   // a delta we cannot use
+            if (!fresh) continue;
+            const EntityState& s = rx.Latest();
+            if (!known) { if (nm.OnEntitySpawned) nm.OnEntitySpawned(id, s.bytes.data(), s.len); }
+            else if (nm.OnEntityUpdated) nm.OnEntityUpdated(id, s.bytes.data(), s.len);
+        }
+    }
+
+    // Once per Update() on a client: acknowledge what arrived.
+    void Client_FlushEntityAcks() {
+        if (!entityAcksOwed || !connected) return;
+        entityAcksOwed = false;
+        Memory::FrameVector<EntityAck> acks;
+        for (auto& [id, rx] : entityStreams) {
+            EntityAck ack{ id, 0 };
+            if (rx.TakeAck(ack.seq)) acks.push_back(ack);
+        }
+        QueueEntityPacket(serverAddr, localId, entityGoneAcks.data(), static_cast<int>(entityGoneAcks.size()),
+                          nullptr, 0, acks.data(), static_cast<int>(acks.size()));
+        entityGoneAcks.clear();
+    }
+
+    // Client: forget every entity, telling the owner.
+    void Client_DespawnEntities(NetworkManager& nm) {
+        auto streams = std::move(entityStreams);
+        entityStreams.clear();
+        entityGoneAcks.clear();
+        entitiesRetired.clear();
+        entityAcksOwed = false;
+        if (nm.OnEntityDespawned)
+            for (const auto& kv : streams) nm.OnEntityDespawned(kv.first);
+    }
+
+    // ── Server movement ───────────────────────────────────────────────────────
+    void Server_QueueCorrection(ClientSlot& slot) {
+        const BodyCorrection& c = slot.correction;
+        CorrectionPacket pkt{};
+        pkt.header.type = PacketType::PLAYER_CORRECTION;
+        pkt.seq         = c.seq;
+        std::memcpy(pkt.position, c.position, sizeof(pkt.position));
+        std::memcpy(pkt.velocity, c.velocity, sizeof(pkt.velocity));
+        std::memcpy(pkt.dir,      c.dir,      sizeof(pkt.dir));
+        pkt.grounded = c.grounded ? 1 : 0;
+        QueueSend(&slot.addr, 1, &pkt, sizeof(pkt));
+        slot.correctionDue = false;
+    }
+
+    // Hand each command newer than the last one applied to OnPlayerInput,
+    // oldest first; repeats from the redundancy window are skipped.
+    void Server_HandleInput(const PacketView& pkt, const sockaddr_in& from, NetworkManager& nm) {
+        ClientSlot* slot = Server_FindSlot(from);
+        if (!slot || !serverMovement) return;
+        slot->lastHeard = std::chrono::steady_clock::now();
+        BitReader r = pkt.Bits();
+        const uint16_t first = static_cast<uint16_t>(r.Read(16));
+        const uint32_t count = r.Read(4);
+        for (uint32_t i = 0; i < count; ++i) {
+            InputCommand cmd = ReadInputCommand(r, static_cast<uint16_t>(first + i));
+            if (r.Overflowed()) break;
+            if (slot->hasInput && SeqStale(cmd.seq, slot->lastInput)) continue;
+            cmd.dtUs        = std::min(cmd.dtUs, INPUT_MAX_DT_US);
+            slot->lastInput = cmd.seq;
+            slot->hasInput  = true;
+            if (nm.OnPlayerInput) nm.OnPlayerInput(slot->id, cmd);
+        }
+    }
+
+    void Client_HandleCorrection(const CorrectionPacket& pkt) {
+        if (!serverMovement) return;
+        // Datagrams can reorder; only a newer correction replaces the last
+        if (everCorrected && SeqStale(pkt.seq, correction.seq)) return;
+        correction.seq = pkt.seq;
+        std::memcpy(correction.position, pkt.position, sizeof(pkt.position));
+        std::memcpy(correction.velocity, pkt.velocity, sizeof(pkt.velocity));
+        std::memcpy(correction.dir,      pkt.dir,      sizeof(pkt.dir));
+        correction.grounded = pkt.grounded != 0;
+        correctionReady = true;
+        everCorrected   = true;
+        std::erase_if(sentInputs, [&](const InputCommand& c) { return SeqStale(c.seq, pkt.seq); });
+    }
+
+    // A fresh server with room for `maxPlayers` (already clamped)
+    void Server_Reset(uint16_t maxPlayers) {
+        ids.Reset(maxPlayers);
+        clients.assign(maxPlayers + 1u, ClientSlot{});
+        slotByAddr.clear();
+        slotByAddr.reserve(maxPlayers);
+        remotePlayers.Clear();
+        hasHostState    = false;
+        snapshotDirty   = false;
+        snapshotPending = false;
+        netEntities.clear();
+        entitiesRetiring.clear();
+        ResetStats();
+        PublishServerInfo();
+    }
+
+    void ResetServerMovement() {
+        serverMovement  = false;
+        sentInputs.clear();
+        correctionReady = false;
+        everCorrected   = false;
+    }
+
+    void Server_HandlePlayerState(const PacketView& pkt, const sockaddr_in& from) {
+        ClientSlot* slot = Server_FindSlot(from);
+        if (!slot) return;
+        slot->lastHeard = std::chrono::steady_clock::now();
+        BitReader r = pkt.Bits();
+        for (uint32_t n = r.Read(8); n > 0 && !r.Overflowed(); --n) {
+            const PlayerId subject = static_cast<PlayerId>(r.Read(16));
+            const uint8_t  seq     = static_cast<uint8_t>(r.Read(8));
+            auto it = slot->outbound.find(subject);
+            if (it != slot->outbound.end()) it->second.tx.Ack(seq);
+        }
+        // A client the server moves only reports acks
+        if (slot->serverMoved) return;
+        for (uint32_t n = r.Read(8); n > 0 && !r.Overflowed(); --n) {
+            // A client only speaks for itself
+            if (r.Read(16) != slot->id) break;
+            if (slot->inbound.Decode(r)) {
+                slot->state    = slot->inbound.Latest();
+                slot->hasState = true;
+                ApplyState(slot->id, slot->state);
             }
+            // New state or not, an ack is owed
+            snapshotDirty = true;
+        }
+    }
+
+    void Client_HandlePlayerState(const PacketView& pkt) {
+        BitReader r = pkt.Bits();
+        for (uint32_t n = r.Read(8); n > 0 && !r.Overflowed(); --n) {
+            const PlayerId subject = static_cast<PlayerId>(r.Read(16));
+            const uint8_t  seq     = static_cast<uint8_t>(r.Read(8));
+            if (subject == localId) ownStream.Ack(seq);
+        }
+        for (uint32_t n = r.Read(8); n > 0 && !r.Overflowed(); --n) {
+            const PlayerId subject = static_cast<PlayerId>(r.Read(16));
+            StateReceiver& rx      = remoteStreams[subject];
+            if (rx.Decode(r) && subject != localId) ApplyState(subject, rx.Latest());
+        }
+        // Out of our area of interest: forget it until it comes back
+        for (uint32_t n = r.Read(8); n > 0 && !r.Overflowed(); --n) {
+            const PlayerId subject = static_cast<PlayerId>(r.Read(16));
+            if (subject == localId) continue;
+            remotePlayers.Erase(subject);
+            remoteStreams.erase(subject);
         }
     }
 
     // ── Client packet handlers ────────────────────────────────────────────────
     void Client_HandleConnectAck(const ConnectAckPacket& pkt, NetworkManager& nm) {
+        if (pkt.positionGrid > 0.f) positionGrid = pkt.positionGrid;
+        serverMovement = pkt.serverMovement != 0;
         localId   = pkt.assignedId;
         connected = true;
         std::cout << "[Net] Connected! Assigned player ID "
-                  << static_cast<int>(localId) << "\n";
+                  << static_cast<int>(localId.load()) << "\n";
         if (nm.OnPlayerJoined) nm.OnPlayerJoined(localId, localName);
     }
 
     void Client_HandleDisconnect(const DisconnectPacket& pkt, NetworkManager& nm) {
-        uint8_t id = pkt.header.playerId;
+        const PlayerId id = pkt.header.playerId;
         if (id == localId) {
             connected = false;
-            remotePlayers.clear();
+            remotePlayers.Clear();
+            remoteStreams.clear();
+            ownStream.Reset();
+            reliable.Reset();
+            Client_DespawnEntities(nm);
             std::cout << "[Net] Kicked by server\n";
             if (nm.OnPlayerLeft) nm.OnPlayerLeft(localId);
         } else {
-            remotePlayers.erase(id);
+            remotePlayers.Erase(id);
+            remoteStreams.erase(id);
             std::cout << "[Net] Player " << static_cast<int>(id) << " left\n";
             if (nm.OnPlayerLeft) nm.OnPlayerLeft(id);
         }
     }
 
     void Client_HandlePlayerUpdate(const PlayerUpdatePacket& pkt) {
-        uint8_t id = pkt.header.playerId;
+        const PlayerId id = pkt.header.playerId;
         if (id == localId) return;
-        auto& rp  = remotePlayers[id];
-        rp.id     = id;
-        rp.posX   = pkt.posX; rp.posY = pkt.posY; rp.posZ = pkt.posZ;
-        rp.rotX   = pkt.rotX; rp.rotY = pkt.rotY;
-        rp.active = true;
+        const Pose p{ pkt.posX, pkt.posY, pkt.posZ, pkt.rotX, pkt.rotY };
+        remotePlayers.Push(id, NowSeconds(), p, renderDelayMs / 1000.0);
+    }
+
+    // ── Reliable messages ─────────────────────────────────────────────────────
+    void QueueReliable(const sockaddr_in& to, PlayerId senderId, ReliableChannel& channel, double now) {
+        ReliablePacket pkt;
+        pkt.header.type     = PacketType::RELIABLE;
+        pkt.header.playerId = senderId;
+        BitWriter w(pkt.bits, sizeof(pkt.bits));
+        channel.Write(w, now);
+        QueueSend(&to, 1, &pkt, static_cast<int>(sizeof(PacketHeader) + w.Bytes()));
+    }
+
+    // Once per Update(): a datagram to every peer with messages due or acks
+    // owed, after the handlers and callbacks have queued theirs.
+    void FlushReliable() {
+        const double now = NowSeconds();
+        if (mode == NetworkManager::Mode::Server) {
+            for (auto& slot : clients)
+                if (slot.active && slot.reliable.NeedsSend(now)) QueueReliable(slot.addr, 0, slot.reliable, now);
+        } else if (connected && reliable.NeedsSend(now)) {
+            QueueReliable(serverAddr, localId, reliable, now);
+        }
+    }
+
+    void Server_HandleReliable(const PacketView& pkt, const sockaddr_in& from, NetworkManager& nm) {
+        ClientSlot* slot = Server_FindSlot(from);
+        if (!slot) return;
+        slot->lastHeard = std::chrono::steady_clock::now();
+        const PlayerId sender = slot->id;
+        BitReader r = pkt.Bits();
+        slot->reliable.Read(r, NowSeconds(), [&](const uint8_t* data, size_t len) {
+            if (nm.OnReliableMessage) nm.OnReliableMessage(sender, data, len);
+        });
+    }
+
+    void Client_HandleReliable(const PacketView& pkt, NetworkManager& nm) {
+        // Before CONNECT_ACK there is no channel yet; the server resends
+        if (!connected) return;
+        BitReader r = pkt.Bits();
+        reliable.Read(r, NowSeconds(), [&](const uint8_t* data, size_t len) {
+            if (nm.OnReliableMessage) nm.OnReliableMessage(0, data, len);
+        });
+    }
+
+    // ── Client round trip ─────────────────────────────────────────────────────
+    void Client_HandlePing(const PingPacket& pkt) {
+        PingPacket pong{};
+        pong.header.type     = PacketType::PONG;
+        pong.header.playerId = localId;
+        pong.seq             = pkt.seq;
+        QueueSend(&serverAddr, 1, &pong, sizeof(pong));
+    }
+
+    void Client_HandlePong(const PingPacket& pkt, std::chrono::steady_clock::time_point at) {
+        if (pingSeq.load() - pkt.seq >= PING_HISTORY) return;
+        const auto sent = std::chrono::steady_clock::time_point(
+            std::chrono::steady_clock::duration(pingSentNs[pkt.seq % PING_HISTORY].load()));
+        serverLink.Pong(pkt.seq, std::chrono::duration<double>(at - sent).count());
     }
 
     // ── Main-thread packet dispatch ───────────────────────────────────────────
+    // Handlers read the packet in its ring slot.  Screen() already refused
+    // anything short for its type, so each gets a whole fixed struct or a
+    // bit stream that is bounds-checked as it is read.
     void DispatchPacket(const RawPacket& rp, NetworkManager& nm) {
-        const auto& hdr = *reinterpret_cast<const PacketHeader*>(rp.data);
+        PacketView pkt;
+        if (!PacketView::Parse(rp.data, static_cast<size_t>(rp.len), pkt)) return;
+        CountReceived(rp);
         if (mode == NetworkManager::Mode::Server) {
-            switch (hdr.type) {
-            case PacketType::SERVER_INFO_REQ:
-                Server_HandleServerInfoReq(rp.from);
-                break;
+            switch (pkt.Type()) {
             case PacketType::CONNECT:
-                if (rp.len >= static_cast<int>(sizeof(ConnectPacket)))
-                    Server_HandleConnect(*reinterpret_cast<const ConnectPacket*>(rp.data), rp.from, nm);
+                Server_HandleConnect(pkt.As<ConnectPacket>(), rp.from, nm);
                 break;
             case PacketType::DISCONNECT:
-                if (rp.len >= static_cast<int>(sizeof(DisconnectPacket)))
-                    Server_HandleDisconnect(*reinterpret_cast<const DisconnectPacket*>(rp.data), rp.from, nm);
+                Server_HandleDisconnect(pkt.As<DisconnectPacket>(), rp.from, nm);
                 break;
             case PacketType::PLAYER_UPDATE:
-                if (rp.len >= static_cast<int>(sizeof(PlayerUpdatePacket)))
-                    Server_HandlePlayerUpdate(*reinterpret_cast<const PlayerUpdatePacket*>(rp.data), rp.from);
+                Server_HandlePlayerUpdate(pkt.As<PlayerUpdatePacket>(), rp.from);
+                break;
+            case PacketType::PLAYER_STATE:
+                Server_HandlePlayerState(pkt, rp.from);
+                break;
+            case PacketType::INPUT_CMD:
+                Server_HandleInput(pkt, rp.from, nm);
+                break;
+            case PacketType::RELIABLE:
+                Server_HandleReliable(pkt, rp.from, nm);
+                break;
+            case PacketType::ENTITY_STATE:
+                Server_HandleEntityState(pkt, rp.from);
+                break;
+            case PacketType::PING:
+                Server_HandlePing(pkt.As<PingPacket>(), rp.from);
+                break;
+            case PacketType::PONG:
+                Server_HandlePong(pkt.As<PingPacket>(), rp.from, rp.at);
                 break;
             default: break;
             }
         } else if (mode == NetworkManager::Mode::Client) {
-            switch (hdr.type) {
+            switch (pkt.Type()) {
             case PacketType::CONNECT_ACK:
-                if (rp.len >= static_cast<int>(sizeof(ConnectAckPacket)))
-                    Client_HandleConnectAck(*reinterpret_cast<const ConnectAckPacket*>(rp.data), nm);
+                Client_HandleConnectAck(pkt.As<ConnectAckPacket>(), nm);
                 break;
             case PacketType::DISCONNECT:
-                if (rp.len >= static_cast<int>(sizeof(DisconnectPacket)))
-                    Client_HandleDisconnect(*reinterpret_cast<const DisconnectPacket*>(rp.data), nm);
+                Client_HandleDisconnect(pkt.As<DisconnectPacket>(), nm);
                 break;
             case PacketType::PLAYER_UPDATE:
-                if (rp.len >= static_cast<int>(sizeof(PlayerUpdatePacket)))
-                    Client_HandlePlayerUpdate(*reinterpret_cast<const PlayerUpdatePacket*>(rp.data));
+                Client_HandlePlayerUpdate(pkt.As<PlayerUpdatePacket>());
+                break;
+            case PacketType::PLAYER_STATE:
+                Client_HandlePlayerState(pkt);
+                break;
+            case PacketType::PLAYER_CORRECTION:
+                Client_HandleCorrection(pkt.As<CorrectionPacket>());
+                break;
+            case PacketType::RELIABLE:
+                Client_HandleReliable(pkt, nm);
+                break;
+            case PacketType::ENTITY_STATE:
+                Client_HandleEntityState(pkt, nm);
+                break;
+            case PacketType::PING:
+                if (connected) Client_HandlePing(pkt.As<PingPacket>());
+                break;
+            case PacketType::PONG:
+                Client_HandlePong(pkt.As<PingPacket>(), rp.at);
+                break;
+            default: break;
+            }
+        } else if (mode == NetworkManager::Mode::Master) {
+            switch (pkt.Type()) {
+            case PacketType::MASTER_HEARTBEAT:
+                if (Master_Admit(rp.from, rp.at)) Master_HandleHeartbeat(pkt.As<MasterHeartbeatPacket>(), rp.from);
+                break;
+            case PacketType::MASTER_LIST_REQ:
+                if (Master_Admit(rp.from, rp.at)) Master_HandleListReq(pkt.As<MasterListReqPacket>(), rp.from);
                 break;
             default: break;
             }
@@ -416,8 +2163,9 @@ NetworkManager::NetworkManager() : m_impl(std::make_unique<Impl>()) {
 }
 
 NetworkManager::~NetworkManager() {
-    if (m_impl->mode == Mode::Server) StopServer();
+    if (m_impl->mode == Mode::Server || m_impl->mode == Mode::Master) StopServer();
     else if (m_impl->mode == Mode::Client) Disconnect();
+    m_impl->StopPinging();
 #ifdef _WIN32
     WSACleanup();
 #endif
@@ -425,22 +2173,45 @@ NetworkManager::~NetworkManager() {
 
 // ── Server ────────────────────────────────────────────────────────────────────
 
-bool NetworkManager::StartServer(uint16_t port) {
+bool NetworkManager::StartServer(uint16_t port, uint16_t maxPlayers) {
     if (m_impl->running.load()) return false;
     if (!m_impl->InitSocket(port)) return false;
-    m_impl->mode    = Mode::Server;
-    m_impl->nextId  = 1;
-    std::memset(m_impl->clients, 0, sizeof(m_impl->clients));
+    m_impl->mode = Mode::Server;
+    m_impl->Server_Reset(std::clamp<uint16_t>(maxPlayers, 1, PlayerIdAllocator::MAX_CAPACITY));
     m_impl->running = true;
+    m_impl->StartSending();
     m_impl->recvThread = std::thread([this]{ m_impl->RecvLoop(); });
     std::cout << "[Net] Server started on port " << port << "\n";
     return true;
 }
 
+bool NetworkManager::StartMaster(uint16_t port) {
+    if (m_impl->running.load()) return false;
+    if (!m_impl->InitSocket(port)) return false;
+    m_impl->mode = Mode::Master;
+    m_impl->masterList.clear();
+    m_impl->masterQuota.clear();
+    m_impl->ResetStats();
+    m_impl->running = true;
+    m_impl->StartSending();
+    m_impl->recvThread = std::thread([this]{ m_impl->RecvLoop(); });
+    std::cout << "[Net] Master list started on port " << port << "\n";
+    return true;
+}
+
 void NetworkManager::StopServer() {
     if (!m_impl->running.load()) return;
     m_impl->running = false;
+    m_impl->Wake();
     if (m_impl->recvThread.joinable()) m_impl->recvThread.join();
+    if (m_impl->mode == Mode::Server && m_impl->hasMaster) {
+        // Withdraw from the master list rather than wait to expire
+        MasterHeartbeatPacket bye = m_impl->PublishedInfo();
+        bye.header.type = PacketType::MASTER_HEARTBEAT;
+        bye.maxPlayers  = 0;
+        m_impl->SendRaw(m_impl->masterAddr, &bye, sizeof(bye));
+    }
+    m_impl->StopSending();
     m_impl->CloseSocket();
     m_impl->mode = Mode::None;
     std::cout << "[Net] Server stopped\n";
@@ -457,41 +2228,28 @@ bool NetworkManager::Connect(const std::string& host, uint16_t port,
     if (m_impl->running.load()) return false;
     if (!m_impl->InitSocket(0)) return false;  // ephemeral local port
 
-    // Resolve host — handles both IP strings ("192.168.1.5") and hostnames ("myserver").
-    // inet_pton only handles IP strings, which is why cross-machine hostname connects failed.
-    {
-        addrinfo hints{};
-        hints.ai_family   = AF_INET;
-        hints.ai_socktype = SOCK_DGRAM;
-        hints.ai_protocol = IPPROTO_UDP;
-        addrinfo* res     = nullptr;
-        std::string portStr = std::to_string(port);
-        int err = getaddrinfo(host.c_str(), portStr.c_str(), &hints, &res);
-        if (err != 0 || !res) {
-            std::cerr << "[Net] Cannot resolve host '" << host << "': error " << err << "\n";
-            m_impl->CloseSocket();
-            return false;
-        }
-        std::memcpy(&m_impl->serverAddr, res->ai_addr, sizeof(sockaddr_in));
-        freeaddrinfo(res);
+    int err = 0;
+    if (!ResolveHost(host, port, m_impl->serverAddr, &err)) {
+        std::cerr << "[Net] Cannot resolve host '" << host << "': error " << err << "\n";
+        m_impl->CloseSocket();
+        return false;
     }
     std::strncpy(m_impl->localName, playerName.c_str(), 15);
     m_impl->localName[15] = '\0';
 
-    m_impl->mode    = Mode::Client;
-    m_impl->running = true;
+    // RecvLoop sends the first ConnectPacket straight away and retries every
+    // 500ms until ACKed.
+    m_impl->mode            = Mode::Client;
+    m_impl->connectAttempts = 0;
+    m_impl->ownStream.Reset();
+    m_impl->remoteStreams.clear();
+    m_impl->ResetServerMovement();
+    m_impl->reliable.Reset();
+    m_impl->ResetStats();
+    m_impl->running         = true;
+    m_impl->StartSending();
     m_impl->recvThread = std::thread([this]{ m_impl->RecvLoop(); });
 
-    // Send the initial ConnectPacket; RecvLoop will retry every 500ms until ACKed.
-    ConnectPacket pkt{};
-    pkt.header.type     = PacketType::CONNECT;
-    pkt.header.playerId = 0;
-    std::strncpy(pkt.name, m_impl->localName, 15);
-    pkt.name[15] = '\0';
-    m_impl->SendRaw(m_impl->serverAddr, &pkt, sizeof(pkt));
-    m_impl->lastConnectAttempt = std::chrono::steady_clock::now();
-    m_impl->connectAttempts    = 1;
-
     std::cout << "[Net] Connecting to " << host << ":" << port
               << " as \"" << m_impl->localName << "\"...\n";
     return true;
@@ -506,12 +2264,18 @@ void NetworkManager::Disconnect() {
         m_impl->SendRaw(m_impl->serverAddr, &pkt, sizeof(pkt));
     }
     m_impl->running          = false;
+    m_impl->Wake();
+    if (m_impl->recvThread.joinable()) m_impl->recvThread.join();
     m_impl->connected        = false;
     m_impl->localId          = 0;
     m_impl->connectAttempts  = 0;
-    if (m_impl->recvThread.joinable()) m_impl->recvThread.join();
+    m_impl->StopSending();
     m_impl->CloseSocket();
-    m_impl->remotePlayers.clear();
+    m_impl->remotePlayers.Clear();
+    m_impl->remoteStreams.clear();
+    m_impl->ResetServerMovement();
+    m_impl->reliable.Reset();
+    m_impl->Client_DespawnEntities(*this);
     m_impl->mode = Mode::None;
     std::cout << "[Net] Disconnected\n";
 }
@@ -520,36 +2284,104 @@ bool NetworkManager::IsConnected() const { return m_impl->connected; }
 
 void NetworkManager::SendPlayerUpdate(float px, float py, float pz,
                                        float rotX, float rotY) {
-    PlayerUpdatePacket pkt{};
-    pkt.header.type = PacketType::PLAYER_UPDATE;
-    pkt.posX = px; pkt.posY = py; pkt.posZ = pz;
-    pkt.rotX = rotX; pkt.rotY = rotY;
+    const QuantizedState q = Quantize(px, py, pz, rotX, rotY, m_impl->positionGrid);
 
     if (m_impl->mode == Mode::Client && m_impl->connected) {
-        pkt.header.playerId = m_impl->localId;
-        m_impl->SendRaw(m_impl->serverAddr, &pkt, sizeof(pkt));
+        // Own state if the server lacks it, plus acks for what we received
+        auto& acks = m_impl->ackScratch;
+        acks.clear();
+        for (auto& [subject, rx] : m_impl->remoteStreams) {
+            StateAck ack{ subject, 0 };
+            if (rx.TakeAck(ack.seq)) acks.push_back(ack);
+        }
+        const PlayerId id = m_impl->localId;
+        StateOut own{ id, &q, &m_impl->ownStream };
+        // Once the server moves us our position is its business
+        const bool report    = !m_impl->serverMovement || !m_impl->everCorrected;
+        const int stateCount = report && m_impl->ownStream.NeedsSend(q) ? 1 : 0;
+        m_impl->QueueStatePacket(m_impl->serverAddr, id, acks.data(), static_cast<int>(acks.size()),
+                                 &own, stateCount);
+        m_impl->FlushSends();
     } else if (m_impl->mode == Mode::Server) {
-        // Broadcast the host's position to all connected clients.
-        // Player ID 0 is reserved for the server/host; clients treat it
-        // as any other remote player and render it normally.
-        pkt.header.playerId = 0;
-        m_impl->Server_Broadcast(reinterpret_cast<const uint8_t*>(&pkt), sizeof(pkt));
+        // The host's pose goes out as player ID 0, reserved for the
+        // server/host; clients treat it as any other remote player.
+        // It leaves with the next snapshot tick in Update().
+        if (!m_impl->hasHostState || !(m_impl->hostState == q)) m_impl->snapshotDirty = true;
+        m_impl->hostState    = q;
+        m_impl->hasHostState = true;
     }
 }
 
+// ── Replay ────────────────────────────────────────────────────────────────────
+
+bool NetworkManager::StartReplay(Mode mode, uint16_t maxPlayers) {
+    if (m_impl->running.load()) return false;
+    if (mode == Mode::Server) {
+        m_impl->Server_Reset(std::clamp<uint16_t>(maxPlayers, 1, PlayerIdAllocator::MAX_CAPACITY));
+    } else if (mode == Mode::Client) {
+        m_impl->connectAttempts = 0;
+        m_impl->ownStream.Reset();
+        m_impl->remoteStreams.clear();
+        m_impl->ResetServerMovement();
+        m_impl->reliable.Reset();
+        m_impl->ResetStats();
+    } else {
+        return false;
+    }
+    // No socket: sends fail quietly, and there is no receive thread to stop
+    m_impl->mode    = mode;
+    m_impl->running = true;
+    std::cout << "[Net] Replaying as " << (mode == Mode::Server ? "server" : "client") << "\n";
+    return true;
+}
+
+bool NetworkManager::InjectDatagram(uint32_t ip, uint16_t port, const uint8_t* data, size_t len) {
+    // The ring has one producer, the receive thread when there is one
+    if (!m_impl->running.load() || m_impl->recvThread.joinable()) return false;
+    if (len == 0 || len > sizeof(RawPacket::data)) return false;
+    RawPacket rp;
+    std::memcpy(rp.data, data, len);
+    rp.len                  = static_cast<int>(len);
+    rp.from.sin_family      = AF_INET;
+    rp.from.sin_addr.s_addr = htonl(ip);
+    rp.from.sin_port        = htons(port);
+    rp.at                   = std::chrono::steady_clock::now();
+    return m_impl->recvRing.TryPush(rp);
+}
+
 // ── Shared ────────────────────────────────────────────────────────────────────
 
 void NetworkManager::Update() {
-    std::queue<RawPacket> local;
-    {
-        std::lock_guard<std::mutex> lk(m_impl->queueMutex);
-        std::swap(local, m_impl->recvQueue);
+    HOTONES_ZONE("NetworkManager::Update");
+    m_impl->recvQueueWindow = std::max(m_impl->recvQueueWindow, m_impl->recvRing.Size());
+    // At most one ring's worth per call, so a flood can't stall the frame
+    for (size_t i = 0; i < RECV_RING; ++i) {
+        RawPacket* rp = m_impl->recvRing.Front();
+        if (!rp) break;
+        if (OnDatagram)
+            OnDatagram(ntohl(rp->from.sin_addr.s_addr), ntohs(rp->from.sin_port),
+                       rp->data, static_cast<size_t>(rp->len));
+        m_impl->DispatchPacket(*rp, *this);
+        m_impl->recvRing.Pop();
     }
-    while (!local.empty()) {
-        m_impl->DispatchPacket(local.front(), *this);
-        local.pop();
+    if (m_impl->mode == Mode::Server) {
+        m_impl->Server_ExpireSilentClients(*this);
+        m_impl->Server_PingClients();
+        // Snapshot tick: fresh states, owed acks and unacked resends
+        const auto sinceLast = std::chrono::steady_clock::now() - m_impl->lastSnapshot;
+        if ((m_impl->snapshotDirty || m_impl->snapshotPending)
+                && sinceLast >= std::chrono::milliseconds(m_impl->snapshotIntervalMs))
+            m_impl->Server_SendSnapshots();
     }
-    // Drain ping results from PingServer() detached threads
+    if (m_impl->mode == Mode::Client) m_impl->Client_FlushEntityAcks();
+    m_impl->FlushReliable();
+    // Relays and notifications queued by the handlers go out together
+    m_impl->FlushSends();
+    m_impl->UpdateStats();
+    m_impl->bufferBytes.Set(m_impl->BufferBytes());
+    if (m_impl->renderDelayMs > 0)
+        m_impl->remotePlayers.Resample(NowSeconds() - m_impl->renderDelayMs / 1000.0, MAX_EXTRAPOLATION);
+    // Drain server-browser replies gathered by the ping thread
     if (OnServerInfo) {
         std::vector<Impl::PingResult> results;
         {
@@ -563,101 +2395,233 @@ void NetworkManager::Update() {
 }
 
 NetworkManager::Mode NetworkManager::GetMode() const { return m_impl->mode; }
-uint8_t NetworkManager::GetLocalId()             const { return m_impl->localId; }
+uint64_t NetworkManager::GetRecvOverflowCount() const { return m_impl->recvRing.Overflows(); }
+
+NetStats NetworkManager::GetStats() const {
+    NetStats s;
+    s.total = Impl::ToConnectionStats(0, { m_impl->totalIn, m_impl->totalOut }, 0);
+    s.recvQueuePeak = m_impl->recvQueuePeak;
+    s.recvOverflows = m_impl->recvRing.Overflows();
+    s.sendOverflows = m_impl->sendOverflows;
+    if (m_impl->mode == Mode::Client && m_impl->connected) {
+        s.connections.push_back(Impl::ToConnectionStats(0, m_impl->serverLink, m_impl->reliable.Unacked()));
+    } else if (m_impl->mode == Mode::Server) {
+        for (const auto& slot : m_impl->clients)
+            if (slot.active)
+                s.connections.push_back(Impl::ToConnectionStats(slot.id, slot.link, slot.reliable.Unacked(),
+                                                                slot.budget.Rate()));
+    }
+    // Overall round trip and loss: the mean over connections that have one
+    int measured = 0;
+    for (const ConnectionStats& c : s.connections) {
+        s.total.reliablePending += c.reliablePending;
+        s.total.sendRate        += c.sendRate;
+        if (c.rttMs <= 0.f) continue;
+        s.total.rttMs       += c.rttMs;
+        s.total.lossPercent += c.lossPercent;
+        ++measured;
+    }
+    if (measured > 0) {
+        s.total.rttMs       /= static_cast<float>(measured);
+        s.total.lossPercent /= static_cast<float>(measured);
+    }
+    return s;
+}
+PlayerId NetworkManager::GetLocalId()            const { return m_impl->localId; }
+
+void NetworkManager::SetPositionGrid(float metres) {
+    if (metres > 0.f) m_impl->positionGrid = metres;
+}
+
+void NetworkManager::SetSnapshotRate(int hz) {
+    if (hz > 0) m_impl->snapshotIntervalMs = std::max(1, 1000 / hz);
+}
+
+void NetworkManager::SetServerMovement(bool enabled) {
+    m_impl->serverMovement = enabled;
+}
+
+void NetworkManager::SetPlayerBody(PlayerId id, const BodyCorrection& body, float rotX, float rotY) {
+    if (m_impl->mode != Mode::Server) return;
+    const uint16_t index = PlayerIdAllocator::Index(id);
+    if (index == 0 || index >= m_impl->clients.size()) return;
+    ClientSlot& slot = m_impl->clients[index];
+    if (!slot.active || slot.id != id) return;
+    slot.correction    = body;
+    slot.correctionDue = true;
+    slot.serverMoved   = true;
+    slot.state    = Quantize(body.position[0], body.position[1], body.position[2], rotX, rotY,
+                             m_impl->positionGrid);
+    slot.hasState = true;
+    m_impl->ApplyState(id, slot.state);
+    m_impl->snapshotDirty = true;
+}
+
+bool NetworkManager::IsServerMovement() const {
+    return m_impl->mode == Mode::Client && m_impl->connected && m_impl->serverMovement;
+}
+
+// Each INPUT_CMD carries the newest INPUT_REDUNDANCY commands the server
+// has not confirmed, so losing one datagram costs nothing.
+void NetworkManager::SendInput(const InputCommand& cmd) {
+    if (!IsServerMovement()) return;
+    auto& sent = m_impl->sentInputs;
+    // The window's seqs are implied from the first, so keep them consecutive
+    if (!sent.empty() && cmd.seq != static_cast<uint16_t>(sent.back().seq + 1)) sent.clear();
+    sent.push_back(cmd);
+    if (sent.size() > Impl::MAX_SENT_INPUTS) sent.erase(sent.begin());
+
+    const size_t count = std::min(sent.size(), static_cast<size_t>(INPUT_REDUNDANCY));
+    const InputCommand* window = sent.data() + sent.size() - count;
+    InputPacket pkt;
+    pkt.header.type     = PacketType::INPUT_CMD;
+    pkt.header.playerId = m_impl->localId;
+    BitWriter w(pkt.bits, sizeof(pkt.bits));
+    w.Write(window[0].seq, 16);
+    w.Write(static_cast<uint32_t>(count), 4);
+    for (size_t i = 0; i < count; ++i) WriteInputCommand(w, window[i]);
+    m_impl->QueueSend(&m_impl->serverAddr, 1, &pkt, static_cast<int>(sizeof(PacketHeader) + w.Bytes()));
+    m_impl->FlushSends();
+}
+
+bool NetworkManager::TakeCorrection(BodyCorrection& out) {
+    if (!m_impl->correctionReady) return false;
+    out = m_impl->correction;
+    m_impl->correctionReady = false;
+    return true;
+}
+
+bool NetworkManager::SendReliable(PlayerId to, const void* data, size_t len) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    if (m_impl->mode == Mode::Client)
+        return m_impl->connected && m_impl->reliable.Send(bytes, len);
+    if (m_impl->mode != Mode::Server) return false;
+    if (to == 0) {
+        bool any = false;
+        for (auto& slot : m_impl->clients)
+            if (slot.active) any |= slot.reliable.Send(bytes, len);
+        return any;
+    }
+    const uint16_t index = PlayerIdAllocator::Index(to);
+    if (index == 0 || index >= m_impl->clients.size()) return false;
+    ClientSlot& slot = m_impl->clients[index];
+    return slot.active && slot.id == to && slot.reliable.Send(bytes, len);
+}
 
-const std::unordered_map<uint8_t, RemotePlayer>&
-NetworkManager::GetRemotePlayers() const { return m_impl->remotePlayers; }
+NetEntityId NetworkManager::CreateNetEntity() {
+    if (m_impl->mode != Mode::Server) return 0;
+    // Ids go round all 65535 before one is reused, and never while a
+    // client may still hold the entity that had it
+    for (uint32_t tries = 0; tries < 0xFFFFu; ++tries) {
+        const NetEntityId id = m_impl->nextNetEntity;
+        m_impl->nextNetEntity = static_cast<NetEntityId>(id == 0xFFFFu ? 1 : id + 1);
+        if (m_impl->netEntities.contains(id) || m_impl->entitiesRetiring.contains(id)) continue;
+        m_impl->netEntities.try_emplace(id);
+        return id;
+    }
+    return 0;
+}
+
+bool NetworkManager::SetNetEntityState(NetEntityId id, const void* data, size_t len) {
+    auto it = m_impl->netEntities.find(id);
+    if (it == m_impl->netEntities.end() || len > ENTITY_MAX_STATE) return false;
+    if (it->second.Set(static_cast<const uint8_t*>(data), len)) m_impl->snapshotDirty = true;
+    return true;
+}
+
+void NetworkManager::DestroyNetEntity(NetEntityId id) {
+    if (m_impl->netEntities.erase(id) == 0) return;
+    // Every client may have heard of it, from a state it has not acked yet
+    uint16_t owed = 0;
+    for (auto& slot : m_impl->clients) {
+        if (!slot.active) continue;
+        slot.entityAcks.erase(id);
+        slot.entitiesGone.push_back(id);
+        ++owed;
+    }
+    if (owed > 0) {
+        m_impl->entitiesRetiring[id] = owed;
+        m_impl->snapshotDirty = true;
+    }
+}
+
+void NetworkManager::SetLinkConditions(const LinkConditions& conditions) {
+    m_impl->linkConditions = conditions;
+    if (conditions.Active())
+        std::cout << "[Net] Simulating " << conditions.latencyMs << " ms latency, "
+                  << conditions.jitterMs << " ms jitter, " << conditions.lossPercent << "% loss, "
+                  << conditions.duplicatePercent << "% duplicates\n";
+}
+
+void NetworkManager::SetRenderDelay(int ms) {
+    if (ms >= 0) m_impl->renderDelayMs = ms;
+}
+
+int NetworkManager::GetRenderDelay() const { return m_impl->renderDelayMs; }
+
+void NetworkManager::SetSendBudget(uint32_t minBytesPerSec, uint32_t maxBytesPerSec) {
+    SendBudget::Limits& limits = m_impl->budgetLimits;
+    limits.minRate   = static_cast<float>(std::max<uint32_t>(minBytesPerSec, 1024));
+    limits.maxRate   = maxBytesPerSec == 0 ? 0.f : std::max(static_cast<float>(maxBytesPerSec), limits.minRate);
+    limits.startRate = std::max(limits.minRate, std::min(SendBudget::Limits{}.startRate, limits.maxRate));
+}
+
+void NetworkManager::SetInterestRadius(float metres) {
+    if (metres >= 0.f) m_impl->interestRadius = metres;
+}
+
+std::span<const RemotePlayer>
+NetworkManager::GetRemotePlayers() const { return m_impl->remotePlayers.dense; }
+
+const RemotePlayer* NetworkManager::FindRemotePlayer(PlayerId id) const {
+    return m_impl->remotePlayers.Find(id);
+}
 
 // ── Server-browser helpers ────────────────────────────────────────────────────
 
 void NetworkManager::SetHostedPakName(const char* name) {
-    if (!name) { m_impl->hostedPakName[0] = '\0'; return; }
+    if (!name) name = "";
     std::strncpy(m_impl->hostedPakName, name, 31);
     m_impl->hostedPakName[31] = '\0';
+    if (m_impl->mode == Mode::Server) m_impl->PublishServerInfo();
 }
 
-void NetworkManager::PingServer(const std::string& host, uint16_t port) {
-    // Fire-and-forget: open a temp UDP socket, send SERVER_INFO_REQ, wait up to
-    // 600 ms for a reply, then push the result into pingResults for Update() to drain.
-    std::thread([this, host, port]() {
-        SocketHandle sock = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-        if (sock == INVALID_SOCK_VAL) return;
-
-        addrinfo hints{};
-        hints.ai_family   = AF_INET;
-        hints.ai_socktype = SOCK_DGRAM;
-        hints.ai_protocol = IPPROTO_UDP;
-        addrinfo* res     = nullptr;
-        const std::string portStr = std::to_string(port);
-        if (getaddrinfo(host.c_str(), portStr.c_str(), &hints, &res) != 0 || !res) {
-#ifdef _WIN32
-            closesocket(sock);
-#else
-            close(sock);
-#endif
-            return;
-        }
-        sockaddr_in dest{};
-        std::memcpy(&dest, res->ai_addr, sizeof(sockaddr_in));
-        freeaddrinfo(res);
-
-#ifdef _WIN32
-        DWORD tv = 600;
-        setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO,
-                   reinterpret_cast<const char*>(&tv), sizeof(tv));
-        // Disable ICMP Port Unreachable reset on temp socket too
-        {
-            DWORD dwBytes = 0; BOOL bDisable = FALSE;
-            WSAIoctl(sock, SIO_UDP_CONNRESET, &bDisable, sizeof(bDisable),
-                     nullptr, 0, &dwBytes, nullptr, nullptr);
-        }
-#else
-        timeval tv{ 0, 600000 };
-        setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-#endif
+void NetworkManager::SetMasterServer(const std::string& host, uint16_t port) {
+    m_impl->hasMaster = false;
+    if (host.empty()) return;
+    int err = 0;
+    if (!ResolveHost(host, port, m_impl->masterAddr, &err)) {
+        std::cerr << "[Net] Cannot resolve master server '" << host << "': error " << err << "\n";
+        return;
+    }
+    m_impl->hasMaster = true;
+}
 
-        ServerInfoReqPacket req{};
-        req.header.type     = PacketType::SERVER_INFO_REQ;
-        req.header.playerId = 0;
-#ifdef _WIN32
-        sendto(sock, reinterpret_cast<const char*>(&req), sizeof(req), 0,
-               reinterpret_cast<const sockaddr*>(&dest), sizeof(dest));
-#else
-        sendto(sock, &req, sizeof(req), 0,
-               reinterpret_cast<const sockaddr*>(&dest), sizeof(dest));
-#endif
+void NetworkManager::PingServers(std::span<const ServerEndpoint> servers, int timeoutMs) {
+    if (servers.empty()) return;
+    {
+        std::lock_guard<std::mutex> lk(m_impl->pingMutex);
+        for (const ServerEndpoint& e : servers)
+            m_impl->pingQueue.push_back({ e, std::max(1, timeoutMs) });
+        if (!m_impl->pingThread.joinable())
+            m_impl->pingThread = std::thread([this] { m_impl->PingLoop(); });
+    }
+    m_impl->pingWake.notify_one();
+}
 
-        uint8_t     buf[512];
-        sockaddr_in from{};
-        SockLen     fromLen = sizeof(from);
-#ifdef _WIN32
-        int n = recvfrom(sock, reinterpret_cast<char*>(buf),
-                         static_cast<int>(sizeof(buf)), 0,
-                         reinterpret_cast<sockaddr*>(&from), &fromLen);
-        closesocket(sock);
-#else
-        int n = static_cast<int>(
-            recvfrom(sock, buf, sizeof(buf), 0,
-                     reinterpret_cast<sockaddr*>(&from), &fromLen));
-        close(sock);
-#endif
+void NetworkManager::PingServer(const std::string& host, uint16_t port) {
+    const ServerEndpoint e{ host, port };
+    PingServers(std::span<const ServerEndpoint>(&e, 1));
+}
 
-        if (n >= static_cast<int>(sizeof(ServerInfoRespPacket))) {
-            const auto& resp = *reinterpret_cast<const ServerInfoRespPacket*>(buf);
-            if (resp.header.type == PacketType::SERVER_INFO_RESP) {
-                Impl::PingResult pr;
-                pr.host        = host;
-                pr.port        = port;
-                pr.playerCount = resp.playerCount;
-                pr.maxPlayers  = resp.maxPlayers;
-                std::memcpy(pr.pakName, resp.pakName, 32);
-                std::memcpy(pr.gameVersion, resp.gameVersion, sizeof(pr.gameVersion));
-                std::memcpy(pr.pakVersion,  resp.pakVersion,  sizeof(pr.pakVersion));
-                std::lock_guard<std::mutex> lk(m_impl->pingMutex);
-                m_impl->pingResults.push_back(std::move(pr));
-            }
-        }
-    }).detach();
+void NetworkManager::QueryMasterServer(const std::string& host, uint16_t port, int timeoutMs) {
+    {
+        std::lock_guard<std::mutex> lk(m_impl->pingMutex);
+        m_impl->pingQueue.push_back({ { host, port }, std::max(1, timeoutMs), true });
+        if (!m_impl->pingThread.joinable())
+            m_impl->pingThread = std::thread([this] { m_impl->PingLoop(); });
+    }
+    m_impl->pingWake.notify_one();
 }
 
 } // namespace Hotones::Net
\ No newline at end of file
@@ -1,28 +1,219 @@
 #include <server/Server.hpp>
 #include <server/NetworkManager.hpp>
+#include <server/TickScheduler.hpp>
+#include <server/MetricsExporter.hpp>
 #include <Scripting/CupLoader.hpp>
 #include <Scripting/CupPackage.hpp>
+#include <Scripting/LuaAllocator.hpp>
+#include <Memory/FrameArena.hpp>
+#include <Memory/MemoryTracker.hpp>
+#include <Physics/PhysicsSystem.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <cctype>
 #include <chrono>
 #include <csignal>
+#include <cstdio>
 #include <filesystem>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace {
     std::atomic<bool> g_serverRunning{ true };
+    std::atomic<int>  g_luaProfileToggles{ 0 };   // SIGUSR1s received
+    std::atomic<int>  g_memoryDumps{ 0 };         // SIGUSR2s received
 }
 
 static void SignalHandler(int /*sig*/) {
     g_serverRunning = false;
 }
 
+static void ProfileSignalHandler(int /*sig*/) {
+    g_luaProfileToggles.fetch_add(1);
+}
+
+static void MemorySignalHandler(int /*sig*/) {
+    g_memoryDumps.fetch_add(1);
+}
+
+// SIGUSR1 toggles the Lua profiler of every pack on the server; SIGUSR2
+// prints the memory tracker's table
+static void InstallProfileSignal() {
+#ifdef SIGUSR1
+    std::signal(SIGUSR1, ProfileSignalHandler);
+#endif
+#ifdef SIGUSR2
+    std::signal(SIGUSR2, MemorySignalHandler);
+#endif
+}
+
 namespace Hotones {
 
-void RunHeadlessServer(uint16_t port, const std::string& pakPath) {
+// Log joins and leaves under `tag` and, with a pack, forward player events
+// and messages into its Lua state
+static void WireServerEvents(Net::NetworkManager& server, Scripting::CupLoader* script,
+                             const std::string& tag) {
+    server.OnPlayerJoined = [script, tag](Net::PlayerId id, const char* name) {
+        std::cout << tag << " ++ Player " << static_cast<int>(id)
+                  << " \"" << name << "\" joined\n";
+        if (script) script->firePlayerJoined(id, name);
+    };
+    server.OnPlayerLeft = [script, tag](Net::PlayerId id) {
+        std::cout << tag << " -- Player " << static_cast<int>(id) << " left\n";
+        if (script) script->firePlayerLeft(id);
+    };
+    if (script) {
+        server.OnReliableMessage = [script](Net::PlayerId from, const uint8_t* data, size_t len) {
+            script->fireMessage(from, data, len);
+        };
+        // Give the Lua pack access to live player data via network.*
+        script->setNetworkManager(&server);
+    }
+}
+
+// Act on SIGUSR1s since the last call (`seen` counts those handled): an odd
+// number starts sampling `script` afresh, or stops it and writes the stacks
+// to lua_profile_<port>.folded for a flame graph
+static void PollLuaProfiler(Scripting::CupLoader& script, int& seen, uint16_t port,
+                            const std::string& tag) {
+    const int toggles = g_luaProfileToggles.load();
+    const bool flip = (toggles - seen) % 2 != 0;
+    seen = toggles;
+    if (!flip) return;
+
+    Scripting::LuaProfiler& profiler = script.profiler();
+    if (!profiler.Running()) {
+        profiler.Reset();
+        profiler.Start();
+        std::cout << tag << " Lua profiler started (SIGUSR1 again to stop)\n";
+        return;
+    }
+    profiler.Stop();
+    const std::string path = "lua_profile_" + std::to_string(port) + ".folded";
+    if (profiler.WriteCollapsed(path))
+        std::cout << tag << " Lua profiler stopped: " << profiler.Samples() << " samples written to "
+                  << path << "\n";
+    else
+        std::cerr << tag << " Lua profiler stopped: could not write " << path << "\n";
+}
+
+// End the tick for the memory tracker and, after a SIGUSR2 since the last
+// call (`seen` counts those handled), print its table.  One thread only.
+static void PollMemoryTracker(int& seen, const std::string& tag) {
+    Memory::MemoryTracker& tracker = Memory::MemoryTracker::Get();
+    tracker.NextFrame();
+    const int dumps = g_memoryDumps.load();
+    if (dumps == seen) return;
+    seen = dumps;
+    std::printf("%s ", tag.c_str());
+    tracker.Print(stdout);
+}
+
+// ─── Metrics ──────────────────────────────────────────────────────────────────
+// Sampled once a second into a statsd collector (--metrics).  Counters that
+// only grow are sent as rates over the time since the previous sample.
+
+// What the previous sample saw of one match's Lua state
+struct LuaMetricsBase {
+    Scripting::CupLoader::GcStats gc;
+    uint64_t                      allocs = 0;
+};
+
+// ...and of the process
+struct ProcessMetricsBase {
+    Physics::PhysicsQueryStats queries;
+};
+
+static Net::MetricsOptions MetricsWithPrefix(Net::MetricsOptions options, uint16_t port) {
+    if (options.prefix.empty()) options.prefix = "habenero." + std::to_string(port);
+    return options;
+}
+
+static double PerSecond(double now, double before, double seconds) {
+    return now > before && seconds > 0.0 ? (now - before) / seconds : 0.0;
+}
+
+// `scope` is "" or "worker<n>." and so on, ahead of each name
+static void ExportTicks(Net::MetricsExporter& out, const std::string& scope,
+                        const Net::TickScheduler::Window& w) {
+    out.Gauge(scope + "tick.count",    w.ticks);
+    out.Gauge(scope + "tick.avg_ms",   w.avgMs);
+    out.Gauge(scope + "tick.p50_ms",   w.p50Ms);
+    out.Gauge(scope + "tick.p95_ms",   w.p95Ms);
+    out.Gauge(scope + "tick.p99_ms",   w.p99Ms);
+    out.Gauge(scope + "tick.max_ms",   w.maxMs);
+    out.Gauge(scope + "tick.late_ms",  w.maxLateMs);
+    out.Gauge(scope + "tick.overruns", w.overruns);
+    out.Gauge(scope + "tick.skipped",  w.skipped);
+}
+
+// Players and traffic of `server`, and the Lua state of `script` if any
+static void ExportMatch(Net::MetricsExporter& out, const std::string& scope, const Net::NetworkManager& server,
+                        const Scripting::CupLoader* script, LuaMetricsBase& base, double seconds) {
+    const Net::NetStats s = server.GetStats();
+    out.Gauge(scope + "players",             static_cast<double>(s.connections.size()));
+    out.Gauge(scope + "net.packets_in",      s.total.packetsInPerSec);
+    out.Gauge(scope + "net.packets_out",     s.total.packetsOutPerSec);
+    out.Gauge(scope + "net.bytes_in",        s.total.bytesInPerSec);
+    out.Gauge(scope + "net.bytes_out",       s.total.bytesOutPerSec);
+    out.Gauge(scope + "net.rtt_ms",          s.total.rttMs);
+    out.Gauge(scope + "net.loss_pct",        s.total.lossPercent);
+    out.Gauge(scope + "net.send_rate",       s.total.sendRate);
+    out.Gauge(scope + "net.recv_queue_peak", static_cast<double>(s.recvQueuePeak));
+    out.Gauge(scope + "net.recv_overflows",  static_cast<double>(s.recvOverflows));
+    out.Gauge(scope + "net.send_overflows",  static_cast<double>(s.sendOverflows));
+    if (!script) return;
+
+    // A reload starts a new allocator, so its count can go backwards
+    const Scripting::CupLoader::GcStats& gc = script->gcStats();
+    const uint64_t allocs = script->allocator() ? script->allocator()->TotalAllocs() : 0;
+    out.Gauge(scope + "lua.memory_kb", gc.memoryKB);
+    out.Gauge(scope + "lua.gc_ms",     PerSecond(gc.totalMs, base.gc.totalMs, seconds));
+    out.Gauge(scope + "lua.gc_steps",  PerSecond((double)gc.steps, (double)base.gc.steps, seconds));
+    out.Gauge(scope + "lua.allocs",    PerSecond((double)allocs, (double)base.allocs, seconds));
+    base.gc     = gc;
+    base.allocs = allocs;
+}
+
+// Tracked memory and physics queries; on the thread that runs
+// PollMemoryTracker()
+static void ExportProcess(Net::MetricsExporter& out, ProcessMetricsBase& base, double seconds) {
+    const Memory::MemoryTracker::Stats& mem = Memory::MemoryTracker::Get().GetStats();
+    out.Gauge("memory.live_kb",         static_cast<double>(mem.total.bytes) / 1024.0);
+    out.Gauge("memory.peak_kb",         static_cast<double>(mem.total.peakBytes) / 1024.0);
+    out.Gauge("memory.allocs_per_tick", static_cast<double>(mem.total.frameAllocs));
+    for (size_t t = 0; t < Memory::TAG_COUNT; ++t) {
+        std::string name = Memory::TagName(static_cast<Memory::Tag>(t));
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+        out.Gauge("memory." + name + "_kb", static_cast<double>(mem.tags[t].bytes) / 1024.0);
+    }
+
+    const Physics::PhysicsQueryStats q = Physics::GetPhysicsQueryStats();
+    out.Gauge("physics.raycasts", PerSecond((double)q.raycasts, (double)base.queries.raycasts, seconds));
+    out.Gauge("physics.sweeps",   PerSecond((double)q.sweeps,   (double)base.queries.sweeps,   seconds));
+    out.Gauge("physics.resolves", PerSecond((double)q.resolves, (double)base.queries.resolves, seconds));
+    out.Gauge("physics.overlaps", PerSecond((double)q.overlaps, (double)base.queries.overlaps, seconds));
+    out.Gauge("physics.slides",   PerSecond((double)q.slides,   (double)base.queries.slides,   seconds));
+    base.queries = q;
+}
+
+// Load-test line: what the bots see
+static void PrintBotReport(const Net::BotSwarm::Report& r) {
+    std::printf("[Bots] %d/%d connected  in %.0f pkt/s %.1f KB/s  out %.0f pkt/s %.1f KB/s  rtt %.1f ms\n",
+                r.connected, r.total, r.packetsInPerSec, r.bytesInPerSec / 1024.f,
+                r.packetsOutPerSec, r.bytesOutPerSec / 1024.f, r.rttMs);
+}
+
+void RunHeadlessServer(uint16_t port, const std::string& pakPath, uint16_t maxPlayers, int tickRate,
+                       const Net::LinkConditions& link, const Net::BotOptions& bots,
+                       const Net::ServerEndpoint& master, const Net::MetricsOptions& metricsOptions) {
     std::signal(SIGINT,  SignalHandler);
     std::signal(SIGTERM, SignalHandler);
+    InstallProfileSignal();
 
     // -- Optional game pack ---------------------------------------------------
     Hotones::Scripting::CupPackage pak;
@@ -47,36 +238,22 @@ void RunHeadlessServer(uint16_t port, const std::string& pakPath) {
 
     // -- Network --------------------------------------------------------------
     Net::NetworkManager server;
+    server.SetLinkConditions(link);
+    server.SetMasterServer(master.host, master.port);
 
     if (hasPak) {
         // Advertise the pack's display name in SERVER_INFO_RESP replies
         server.SetHostedPakName(std::filesystem::path(pakPath).stem().string().c_str());
     }
 
-    if (hasPak) {
-        // Forward network player events into the Lua pack
-        server.OnPlayerJoined = [&script](uint8_t id, const char* name) {
-            std::cout << "[Server] ++ Player " << static_cast<int>(id)
-                      << " \"" << name << "\" joined\n";
-            script.firePlayerJoined(id, name);
-        };
-        server.OnPlayerLeft = [&script](uint8_t id) {
-            std::cout << "[Server] -- Player " << static_cast<int>(id) << " left\n";
-            script.firePlayerLeft(id);
-        };
-        // Give the Lua pack access to live player data via network.*
-        script.setNetworkManager(&server);
-    } else {
-        server.OnPlayerJoined = [](uint8_t id, const char* name) {
-            std::cout << "[Server] ++ Player " << static_cast<int>(id)
-                      << " \"" << name << "\" joined\n";
-        };
-        server.OnPlayerLeft = [](uint8_t id) {
-            std::cout << "[Server] -- Player " << static_cast<int>(id) << " left\n";
-        };
-    }
+    WireServerEvents(server, hasPak ? &script : nullptr, "[Server]");
 
-    if (!server.StartServer(port)) {
+    // The bots need slots of their own
+    if (bots.count > maxPlayers) {
+        maxPlayers = static_cast<uint16_t>(std::min(bots.count, 1023));
+        std::cout << "[Server] Raising max players to " << maxPlayers << " for the bots\n";
+    }
+    if (!server.StartServer(port, maxPlayers)) {
         std::cerr << "[Server] Failed to start on port " << port << "\n";
         return;
     }
@@ -84,16 +261,257 @@ void RunHeadlessServer(uint16_t port, const std::string& pakPath) {
     std::cout << "[Server] Dedicated server running on UDP port " << port << "\n";
     std::cout << "[Server] Press Ctrl+C to shut down.\n";
 
+    Net::BotSwarm swarm;
+    if (bots.count > 0) swarm.Start("127.0.0.1", port, bots);
+
+    Net::MetricsExporter metrics;
+    if (!metricsOptions.host.empty()) metrics.Open(MetricsWithPrefix(metricsOptions, port));
+    LuaMetricsBase     luaBase;
+    ProcessMetricsBase processBase;
+
     // -- Main loop ------------------------------------------------------------
+    // Fixed-rate ticks.  A tick that overruns its period is logged with the
+    // time each phase took, at most once a second; with bots, every second's
+    // tick times are printed alongside the server's traffic, and with
+    // --metrics sent to the collector.
+    enum { PHASE_NET, PHASE_LUA };
+    Net::TickScheduler ticker(tickRate, { "net", "lua" });
+    std::cout << "[Server] Ticking at " << ticker.Rate() << " Hz\n";
+
+    using Clock = std::chrono::steady_clock;
+    auto lastReport     = Clock::now();
+    auto nextReport     = lastReport + std::chrono::seconds(1);
+    auto nextOverrunLog = Clock::now();
+    int  overrunsSinceLog = 0;
+    char phases[96];
+    int  profileToggles = 0;
+    int  memoryDumps    = 0;
     while (g_serverRunning.load()) {
+        ticker.BeginTick();
         server.Update();
-        if (hasPak) script.update();
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ticker.Mark(PHASE_NET);
+        if (hasPak) {
+            PollLuaProfiler(script, profileToggles, port, "[Server]");
+            script.update();
+        }
+        ticker.Mark(PHASE_LUA);
+        Memory::FrameArena::Get().NextFrame();
+        PollMemoryTracker(memoryDumps, "[Server]");
+
+        if (ticker.EndTick()) {
+            ++overrunsSinceLog;
+            if (Clock::now() >= nextOverrunLog) {
+                nextOverrunLog = Clock::now() + std::chrono::seconds(1);
+                ticker.FormatPhases(ticker.Last().phaseMs, phases, sizeof(phases));
+                std::printf("[Server] Tick overran: %.2f ms of %.2f (%s), %d overrun(s) since last report\n",
+                            ticker.Last().workMs, ticker.PeriodMs(), phases, overrunsSinceLog);
+                overrunsSinceLog = 0;
+            }
+        }
+
+        if ((bots.count > 0 || metrics.IsOpen()) && Clock::now() >= nextReport) {
+            nextReport += std::chrono::seconds(1);
+            const auto   now     = Clock::now();
+            const double seconds = std::chrono::duration<double>(now - lastReport).count();
+            lastReport = now;
+            const Net::TickScheduler::Window w = ticker.TakeWindow();
+            if (metrics.IsOpen()) {
+                ExportTicks(metrics, "", w);
+                ExportMatch(metrics, "", server, hasPak ? &script : nullptr, luaBase, seconds);
+                ExportProcess(metrics, processBase, seconds);
+                metrics.Flush();
+            }
+            if (bots.count == 0) continue;
+            const Net::NetStats s = server.GetStats();
+            ticker.FormatPhases(w.phaseAvgMs, phases, sizeof(phases));
+            std::printf("[Server] %zu players  %d ticks  avg %.3f ms (%s) p99 %.3f max %.3f ms  "
+                        "late <= %.3f ms  %d overrun(s) %d skipped\n",
+                        s.connections.size(), w.ticks, w.avgMs, phases, w.p99Ms, w.maxMs, w.maxLateMs,
+                        w.overruns, w.skipped);
+            std::printf("[Server] in %.0f pkt/s %.1f KB/s  out %.0f pkt/s %.1f KB/s  recv queue peak %zu\n",
+                        s.total.packetsInPerSec, s.total.bytesInPerSec / 1024.f,
+                        s.total.packetsOutPerSec, s.total.bytesOutPerSec / 1024.f, s.recvQueuePeak);
+            PrintBotReport(swarm.GetReport());
+        }
     }
 
     std::cout << "\n[Server] Shutting down...\n";
+    swarm.Stop();
     server.StopServer();
     std::cout << "[Server] Goodbye!\n";
 }
 
+// One hosted match: its own socket and its own Lua state
+struct HostedMatch {
+    int                    index = 0;
+    uint16_t               port  = 0;
+    std::string            tag;
+    Net::NetworkManager    server;
+    Scripting::CupLoader   script;
+    bool                   hasPak = false;
+    int                    profileToggles = 0;   ///< see PollLuaProfiler()
+    LuaMetricsBase         metricsBase;          ///< the worker's last sample
+};
+
+// Tick every match in `matches` at the fixed rate until shutdown.  One
+// worker's matches are only ever touched by that worker, so their Lua
+// states need no locking.  With metrics, each worker sends its own ticks
+// and matches, and worker 0 the process's memory and physics counters.
+static void RunMatchWorker(int worker, const std::vector<HostedMatch*>& matches, int tickRate,
+                           const Net::MetricsOptions& metricsOptions) {
+    enum { PHASE_NET, PHASE_LUA };
+    Net::TickScheduler ticker(tickRate, { "net", "lua" });
+    Net::MetricsExporter metrics;
+    if (!metricsOptions.host.empty()) metrics.Open(metricsOptions);
+    ProcessMetricsBase processBase;
+    const std::string  workerScope = "worker" + std::to_string(worker) + ".";
+    auto lastReport = std::chrono::steady_clock::now();
+    auto nextReport = lastReport + std::chrono::seconds(1);
+    auto nextOverrunLog   = std::chrono::steady_clock::now();
+    int  overrunsSinceLog = 0;
+    char phases[96];
+    int  memoryDumps = 0;
+    while (g_serverRunning.load()) {
+        ticker.BeginTick();
+        for (HostedMatch* m : matches) {
+            m->server.Update();
+            ticker.Mark(PHASE_NET);
+            if (m->hasPak) {
+                PollLuaProfiler(m->script, m->profileToggles, m->port, m->tag);
+                m->script.update();
+            }
+            ticker.Mark(PHASE_LUA);
+        }
+        Memory::FrameArena::Get().NextFrame();   // this worker's, shared by its matches
+        if (worker == 0) PollMemoryTracker(memoryDumps, "[Server]");   // the process's, on one worker
+        if (ticker.EndTick()) {
+            ++overrunsSinceLog;
+            if (std::chrono::steady_clock::now() >= nextOverrunLog) {
+                nextOverrunLog = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+                ticker.FormatPhases(ticker.Last().phaseMs, phases, sizeof(phases));
+                std::printf("[Worker %d] Tick of %zu matches overran: %.2f ms of %.2f (%s), "
+                            "%d overrun(s) since last report\n",
+                            worker, matches.size(), ticker.Last().workMs, ticker.PeriodMs(),
+                            phases, overrunsSinceLog);
+                overrunsSinceLog = 0;
+            }
+        }
+
+        if (metrics.IsOpen() && std::chrono::steady_clock::now() >= nextReport) {
+            nextReport += std::chrono::seconds(1);
+            const auto   now     = std::chrono::steady_clock::now();
+            const double seconds = std::chrono::duration<double>(now - lastReport).count();
+            lastReport = now;
+            ExportTicks(metrics, workerScope, ticker.TakeWindow());
+            for (HostedMatch* m : matches)
+                ExportMatch(metrics, "match" + std::to_string(m->index) + ".", m->server,
+                            m->hasPak ? &m->script : nullptr, m->metricsBase, seconds);
+            if (worker == 0) ExportProcess(metrics, processBase, seconds);
+            metrics.Flush();
+        }
+    }
+}
+
+void RunMatchServer(uint16_t basePort, const std::string& pakPath, uint16_t maxPlayers, int tickRate,
+                    int matchCount, int threads, const Net::LinkConditions& link,
+                    const Net::ServerEndpoint& master, const Net::MetricsOptions& metricsOptions) {
+    std::signal(SIGINT,  SignalHandler);
+    std::signal(SIGTERM, SignalHandler);
+    InstallProfileSignal();
+
+    matchCount = std::clamp(matchCount, 1, 65535 - static_cast<int>(basePort) + 1);
+    if (threads <= 0) threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    threads = std::min(threads, matchCount);
+
+    // -- Pack: opened (and mounted) once for every match --------------------
+    Hotones::Scripting::CupPackage pak;
+    const bool hasPak = !pakPath.empty();
+    if (hasPak && !pak.open(pakPath)) {
+        std::cerr << "[Server] Failed to open pack: " << pakPath << "\n";
+        return;
+    }
+    const std::string pakName = std::filesystem::path(pakPath).stem().string();
+
+    // -- Matches --------------------------------------------------------------
+    std::vector<std::unique_ptr<HostedMatch>> matches;
+    matches.reserve(static_cast<size_t>(matchCount));
+    for (int i = 0; i < matchCount; ++i) {
+        auto m   = std::make_unique<HostedMatch>();
+        m->index = i;
+        m->port  = static_cast<uint16_t>(basePort + i);
+        m->tag   = "[Match " + std::to_string(i) + "]";
+        if (hasPak) {
+            if (!m->script.init() || !m->script.loadPak(pak)) {
+                std::cerr << m->tag << " Failed to initialise pack.\n";
+                return;
+            }
+            m->hasPak = true;
+            m->server.SetHostedPakName(pakName.c_str());
+        }
+        m->server.SetLinkConditions(link);
+        m->server.SetMasterServer(master.host, master.port);
+        WireServerEvents(m->server, m->hasPak ? &m->script : nullptr, m->tag);
+        if (!m->server.StartServer(m->port, maxPlayers)) {
+            std::cerr << m->tag << " Failed to start on port " << m->port << "\n";
+            for (auto& started : matches) started->server.StopServer();
+            return;
+        }
+        matches.push_back(std::move(m));
+    }
+    if (hasPak) std::cout << "[Server] Game pack loaded: " << pakPath << "\n";
+    std::cout << "[Server] " << matchCount << " matches on UDP ports " << basePort << "-"
+              << (basePort + matchCount - 1) << ", " << threads << " worker thread(s) at "
+              << tickRate << " Hz\n";
+    std::cout << "[Server] Press Ctrl+C to shut down.\n";
+
+    // -- Workers: match i runs on worker i % threads ---------------------------
+    std::vector<std::vector<HostedMatch*>> shares(static_cast<size_t>(threads));
+    for (auto& m : matches) shares[static_cast<size_t>(m->index % threads)].push_back(m.get());
+    const Net::MetricsOptions metrics = MetricsWithPrefix(metricsOptions, basePort);
+    std::vector<std::thread> workers;
+    for (int w = 0; w < threads; ++w)
+        workers.emplace_back(RunMatchWorker, w, std::cref(shares[static_cast<size_t>(w)]), tickRate,
+                             std::cref(metrics));
+    for (std::thread& t : workers) t.join();
+
+    std::cout << "\n[Server] Shutting down...\n";
+    for (auto& m : matches) m->server.StopServer();
+    std::cout << "[Server] Goodbye!\n";
+}
+
+void RunMasterServer(uint16_t port) {
+    std::signal(SIGINT,  SignalHandler);
+    std::signal(SIGTERM, SignalHandler);
+
+    Net::NetworkManager master;
+    if (!master.StartMaster(port)) {
+        std::cerr << "[Master] Failed to start on port " << port << "\n";
+        return;
+    }
+    std::cout << "[Master] Press Ctrl+C to shut down.\n";
+    while (g_serverRunning.load()) {
+        master.Update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::cout << "\n[Master] Shutting down...\n";
+    master.StopServer();
+}
+
+void RunBotClients(const std::string& host, uint16_t port, const Net::BotOptions& bots) {
+    std::signal(SIGINT,  SignalHandler);
+    std::signal(SIGTERM, SignalHandler);
+
+    Net::BotSwarm swarm;
+    if (!swarm.Start(host, port, bots)) {
+        std::cerr << "[Bots] Nothing to run (--bots must be at least 1)\n";
+        return;
+    }
+    while (g_serverRunning.load()) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        PrintBotReport(swarm.GetReport());
+    }
+    std::cout << "\n[Bots] Stopping...\n";
+    swarm.Stop();
+}
+
 } // namespace Hotones
@@ -0,0 +1,43 @@
+#include <server/ServerMovement.hpp>
+#include <GFX/CollidableModel.hpp>
+
+namespace Hotones {
+
+void ServerMovement::Attach(Net::NetworkManager& nm) {
+    nm.SetServerMovement(true);
+    nm.OnPlayerInput = [this, &nm](Net::PlayerId id, const Net::InputCommand& cmd) { Step(nm, id, cmd); };
+}
+
+void ServerMovement::Step(Net::NetworkManager& nm, Net::PlayerId id, const Net::InputCommand& cmd) {
+    if (!m_enabled) return;
+
+    auto it = m_bodies.find(id);
+    if (it == m_bodies.end()) {
+        // A new player: forget the ones that have left, then start from
+        // the position this one reported before we took over
+        std::erase_if(m_bodies, [&nm](const auto& kv) { return !nm.FindRemotePlayer(kv.first); });
+        Player::Body body = {};
+        if (const Net::RemotePlayer* rp = nm.FindRemotePlayer(id))
+            body.position = { rp->posX, rp->posY, rp->posZ };
+        it = m_bodies.emplace(id, body).first;
+    }
+
+    Player::Body& body = it->second;
+    Player::StepBody(body, cmd.side, cmd.forward, cmd.jump, cmd.crouch, cmd.Yaw(), cmd.Dt(),
+                     m_world.get(), m_sourceBhop);
+
+    Net::BodyCorrection result;
+    result.seq         = cmd.seq;
+    result.position[0] = body.position.x;
+    result.position[1] = body.position.y;
+    result.position[2] = body.position.z;
+    result.velocity[0] = body.velocity.x;
+    result.velocity[1] = body.velocity.y;
+    result.velocity[2] = body.velocity.z;
+    result.dir[0]      = body.dir.x;
+    result.dir[1]      = body.dir.z;
+    result.grounded    = body.isGrounded;
+    nm.SetPlayerBody(id, result, cmd.Yaw(), cmd.Pitch());
+}
+
+} // namespace Hotones
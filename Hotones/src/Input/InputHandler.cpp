@@ -1,5 +1,6 @@
 #include <Input/InputHandler.hpp>
 #include <raylib.h>
+#include <chrono>
 
 namespace Hotones::Input {
 
@@ -9,30 +10,160 @@ InputHandler& InputHandler::Get()
     return instance;
 }
 
-void InputHandler::Update()
+double InputHandler::Clock()
+{
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+void InputHandler::Push(InputEvent::Type type, int code, Vector2 value, double time)
+{
+    InputEvent e;
+    e.type  = type;
+    e.code  = code;
+    e.value = value;
+    e.time  = time;
+    pending_.push_back(e);
+}
+
+void InputHandler::Poll()
 {
+    using Type = InputEvent::Type;
+    const double now = Clock();
+
+    for (int key = 0; key < FrameInput::KEY_COUNT; ++key) {
+        const bool down = ::IsKeyDown(key);
+        if (down != polledKeys_[key]) {
+            Push(down ? Type::KeyDown : Type::KeyUp, key, { 0, 0 }, now);
+            polledKeys_[key] = down;
+        }
+        if (::IsKeyPressedRepeat(key)) pendingRepeat_.set(key);
+    }
+    for (int btn = MOUSE_BUTTON_LEFT; btn <= MOUSE_BUTTON_BACK; ++btn) {
+        const bool down = ::IsMouseButtonDown(btn);
+        if (down != (bool)(polledMouse_ >> btn & 1)) {
+            Push(down ? Type::MouseDown : Type::MouseUp, btn, { 0, 0 }, now);
+            polledMouse_ ^= (uint8_t)(1u << btn);
+        }
+    }
+
+    const Vector2 delta = ::GetMouseDelta();
+    if (delta.x != 0.f || delta.y != 0.f) Push(Type::MouseMove, 0, delta, now);
+    const float wheel = ::GetMouseWheelMove();
+    if (wheel != 0.f) Push(Type::Wheel, 0, { wheel, 0 }, now);
+
     // Collect typed characters into our queue
     int ch;
     while ((ch = ::GetCharPressed()) != 0) {
-        chars_.push_back(ch);
+        Push(Type::Char, ch, { 0, 0 }, now);
+    }
+}
+
+void InputHandler::Update()
+{
+    using Type = InputEvent::Type;
+
+    // Whatever the last frame's ticks didn't reach still moves the tick
+    // state on; its taps wait for the next tick, its motion was the frame's
+    ConsumeTo(frameEnd_, false);
+    frameEvents_.swap(pending_);
+    pending_.clear();
+    const double now = Clock();
+    frameStart_ = frameEnd_ > 0.0 ? frameEnd_ : now;
+    frameEnd_   = now;
+    tickNext_   = 0;
+    tickLive_   = tickSampling_;
+
+    FrameInput frame;
+    frame.keysDown   = polledKeys_;
+    frame.mouseDown  = polledMouse_;
+    frame.keysRepeat = pendingRepeat_;
+    pendingRepeat_.reset();
+    for (const InputEvent& e : frameEvents_) {
+        switch (e.type) {
+        case Type::KeyDown:   frame.keysDown.set(e.code); break;   // held for the frame, however short
+        case Type::MouseDown: frame.mouseDown |= (uint8_t)(1u << e.code); break;
+        case Type::MouseMove: frame.mouseDelta.x += e.value.x; frame.mouseDelta.y += e.value.y; break;
+        case Type::Wheel:     frame.mouseWheel += e.value.x; break;
+        case Type::Char:      frame.chars.push_back(e.code); break;
+        default: break;
+        }
+    }
+    frame.mousePos = ::GetMousePosition();
+    Advance(frame);
+}
+
+void InputHandler::Replay(const FrameInput& frame)
+{
+    // The devices may still be polled; nothing of theirs is used
+    pending_.clear();
+    pendingRepeat_.reset();
+    frameEvents_.clear();
+    tickLive_ = false;
+    Advance(frame);
+}
+
+void InputHandler::Advance(const FrameInput& frame)
+{
+    prev_ = std::move(cur_);
+    cur_  = frame;
+    chars_.insert(chars_.end(), cur_.chars.begin(), cur_.chars.end());
+}
+
+void InputHandler::ConsumeTo(double until, bool motion)
+{
+    using Type = InputEvent::Type;
+    if (tickStarted_) {
+        // The tick that read them is over
+        tickTaps_.reset();
+        tickMouseTaps_ = 0;
+        tickDelta_     = { 0, 0 };
+        tickStarted_   = false;
     }
+    for (; tickNext_ < frameEvents_.size() && frameEvents_[tickNext_].time <= until; ++tickNext_) {
+        const InputEvent& e = frameEvents_[tickNext_];
+        switch (e.type) {
+        case Type::KeyDown:   tickKeys_.set(e.code); tickTaps_.set(e.code); break;
+        case Type::KeyUp:     tickKeys_.reset(e.code); break;
+        case Type::MouseDown: tickMouse_ |= (uint8_t)(1u << e.code); tickMouseTaps_ |= (uint8_t)(1u << e.code); break;
+        case Type::MouseUp:   tickMouse_ &= (uint8_t)~(1u << e.code); break;
+        case Type::MouseMove:
+            if (motion) { tickDelta_.x += e.value.x; tickDelta_.y += e.value.y; }
+            break;
+        default: break;
+        }
+    }
+}
 
-    mouseDelta_ = ::GetMouseDelta();
-    mousePos_ = ::GetMousePosition();
-    mouseWheel_ = ::GetMouseWheelMove();
+void InputHandler::BeginTick(float frameFraction)
+{
+    if (!tickLive_) return;
+    const double f = frameFraction < 0.f ? 0.0 : frameFraction > 1.f ? 1.0 : (double)frameFraction;
+    ConsumeTo(f >= 1.0 ? frameEnd_ : frameStart_ + f * (frameEnd_ - frameStart_), true);
+    tickStarted_ = true;
 }
 
-bool InputHandler::IsKeyDown(int key) const { return ::IsKeyDown(key); }
-bool InputHandler::IsKeyPressed(int key) const { return ::IsKeyPressed(key); }
-bool InputHandler::IsKeyReleased(int key) const { return ::IsKeyReleased(key); }
-bool InputHandler::IsKeyPressedRepeat(int key) const { return ::IsKeyPressedRepeat(key); }
+static bool InRange(int key) { return key >= 0 && key < FrameInput::KEY_COUNT; }
+static bool InButtons(int btn) { return btn >= 0 && btn < 8; }
 
-bool InputHandler::IsMouseDown(int btn) const { return ::IsMouseButtonDown(btn); }
-bool InputHandler::IsMousePressed(int btn) const { return ::IsMouseButtonPressed(btn); }
+bool InputHandler::IsKeyDown(int key) const { return InRange(key) && cur_.keysDown[key]; }
+bool InputHandler::IsKeyPressed(int key) const { return InRange(key) && cur_.keysDown[key] && !prev_.keysDown[key]; }
+bool InputHandler::IsKeyReleased(int key) const { return InRange(key) && !cur_.keysDown[key] && prev_.keysDown[key]; }
+bool InputHandler::IsKeyPressedRepeat(int key) const { return InRange(key) && cur_.keysRepeat[key]; }
 
-Vector2 InputHandler::GetMousePos() const { return mousePos_; }
-Vector2 InputHandler::GetMouseDelta() const { return mouseDelta_; }
-float   InputHandler::GetMouseWheel() const { return mouseWheel_; }
+bool InputHandler::IsMouseDown(int btn) const { return InButtons(btn) && (cur_.mouseDown >> btn & 1); }
+bool InputHandler::IsMousePressed(int btn) const
+{
+    return InButtons(btn) && (cur_.mouseDown >> btn & 1) && !(prev_.mouseDown >> btn & 1);
+}
+bool InputHandler::IsMouseReleased(int btn) const
+{
+    return InButtons(btn) && !(cur_.mouseDown >> btn & 1) && (prev_.mouseDown >> btn & 1);
+}
+
+Vector2 InputHandler::GetMousePos() const { return cur_.mousePos; }
+Vector2 InputHandler::GetMouseDelta() const { return cur_.mouseDelta; }
+float   InputHandler::GetMouseWheel() const { return cur_.mouseWheel; }
 
 int InputHandler::GetCharPressed()
 {
@@ -42,4 +173,21 @@ int InputHandler::GetCharPressed()
     return c;
 }
 
+bool InputHandler::IsTickKeyDown(int key) const
+{
+    if (!tickLive_) return IsKeyDown(key);
+    return InRange(key) && (tickKeys_[key] || tickTaps_[key]);
+}
+
+bool InputHandler::IsTickMouseDown(int btn) const
+{
+    if (!tickLive_) return IsMouseDown(btn);
+    return InButtons(btn) && ((tickMouse_ | tickMouseTaps_) >> btn & 1);
+}
+
+Vector2 InputHandler::GetTickMouseDelta() const
+{
+    return tickLive_ ? tickDelta_ : Vector2{ 0, 0 };
+}
+
 } // namespace Hotones::Input
@@ -0,0 +1,193 @@
+// Log.cpp — lock-free message queue and the thread that writes it out
+//
+// The queue is a bounded multi-producer ring: each slot carries a sequence
+// number saying whose turn it is.  A producer claims position `pos` by
+// moving the head on, formats into the slot and publishes it by setting its
+// sequence to pos + 1; the sink writes it and hands the slot to the next lap
+// (pos + QUEUE_MESSAGES).
+
+#include "../include/Logging/Log.hpp"
+#include <Profile/Profiler.hpp>
+#include <cstdarg>
+#include <cstdio>
+#include <thread>
+
+namespace Hotones::Log {
+
+namespace Detail { std::atomic<int> g_level{ LOG_INFO }; }   // raylib's default
+
+namespace {
+
+const char* Prefix(int level)
+{
+    switch (level) {
+    case LOG_TRACE:   return "TRACE: ";
+    case LOG_DEBUG:   return "DEBUG: ";
+    case LOG_INFO:    return "INFO: ";
+    case LOG_WARNING: return "WARNING: ";
+    case LOG_ERROR:   return "ERROR: ";
+    case LOG_FATAL:   return "FATAL: ";
+    default:          return "";
+    }
+}
+
+class Sink {
+public:
+    static Sink& Get()
+    {
+        static Sink s_sink;
+        return s_sink;
+    }
+
+    Sink()
+    {
+        for (size_t i = 0; i < QUEUE_MESSAGES; ++i) m_slots[i].seq.store(i, std::memory_order_relaxed);
+        m_thread = std::thread([this] { Run(); });
+    }
+
+    ~Sink()
+    {
+        m_stop.store(true, std::memory_order_release);
+        Wake();
+        m_thread.join();
+    }
+
+    void Push(int level, const char* fmt, va_list args)
+    {
+        uint64_t pos = m_head.load(std::memory_order_relaxed);
+        Slot*    slot;
+        for (;;) {
+            slot = &m_slots[pos % QUEUE_MESSAGES];
+            const uint64_t seq = slot->seq.load(std::memory_order_acquire);
+            if (seq == pos) {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (seq < pos) {   // the sink hasn't freed this slot from the last lap: full
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            } else {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+        slot->level = level;
+        const int n = std::vsnprintf(slot->text, MESSAGE_BYTES, fmt, args);
+        slot->len   = n < 0 ? 0 : (n < (int)MESSAGE_BYTES ? (size_t)n : MESSAGE_BYTES - 1);
+        slot->seq.store(pos + 1, std::memory_order_release);
+        Wake();
+    }
+
+    void Flush()
+    {
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+        while (m_written.load(std::memory_order_acquire) < head) std::this_thread::yield();
+    }
+
+    uint64_t Dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq{ 0 };
+        int    level = 0;
+        size_t len   = 0;
+        char   text[MESSAGE_BYTES];
+    };
+
+    void Wake()
+    {
+        m_signal.fetch_add(1, std::memory_order_release);
+        m_signal.notify_one();
+    }
+
+    void Run()
+    {
+        HOTONES_THREAD("Log sink");
+        uint64_t tail     = 0;
+        uint64_t reported = 0;   // drops already owned up to
+        for (;;) {
+            const uint32_t signal = m_signal.load(std::memory_order_acquire);
+            bool wrote = false;
+            for (;;) {
+                Slot& slot = m_slots[tail % QUEUE_MESSAGES];
+                if (slot.seq.load(std::memory_order_acquire) != tail + 1) break;
+                std::fputs(Prefix(slot.level), stdout);
+                std::fwrite(slot.text, 1, slot.len, stdout);
+                std::fputc('\n', stdout);
+                slot.seq.store(tail + QUEUE_MESSAGES, std::memory_order_release);
+                m_written.store(++tail, std::memory_order_release);
+                wrote = true;
+            }
+            const uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+            if (dropped != reported) {
+                std::fprintf(stdout, "WARNING: log queue full, %llu message(s) dropped\n",
+                             (unsigned long long)(dropped - reported));
+                reported = dropped;
+                wrote    = true;
+            }
+            if (wrote) std::fflush(stdout);
+            // A message claimed but not yet published is waited for too
+            if (m_stop.load(std::memory_order_acquire) && tail == m_head.load(std::memory_order_acquire)) return;
+            m_signal.wait(signal, std::memory_order_acquire);
+        }
+    }
+
+    Slot                  m_slots[QUEUE_MESSAGES];
+    std::atomic<uint64_t> m_head{ 0 };      // next position to claim
+    std::atomic<uint64_t> m_written{ 0 };   // positions written out
+    std::atomic<uint64_t> m_dropped{ 0 };
+    std::atomic<uint32_t> m_signal{ 0 };    // bumped by every publish
+    std::atomic<bool>     m_stop{ false };
+    std::thread           m_thread;
+};
+
+// Every message, HOTONES_LOG's and (as raylib's TraceLog callback, after
+// raylib has applied its level) TraceLog()'s
+void Emit(int level, const char* fmt, va_list args)
+{
+    if (level >= LOG_FATAL) {
+        Sink::Get().Flush();
+        std::fputs(Prefix(level), stderr);
+        std::vfprintf(stderr, fmt, args);
+        std::fputc('\n', stderr);
+        std::fflush(stderr);
+        return;
+    }
+    Sink::Get().Push(level, fmt, args);
+}
+
+} // namespace
+
+void Install()
+{
+    Sink::Get();
+    SetTraceLogCallback(Emit);
+}
+
+void SetLevel(int level)
+{
+    Detail::g_level.store(level, std::memory_order_relaxed);
+    SetTraceLogLevel(level);
+}
+
+int GetLevel()
+{
+    return Detail::g_level.load(std::memory_order_relaxed);
+}
+
+void Write(int level, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    Emit(level, fmt, args);
+    va_end(args);
+}
+
+void Flush()
+{
+    Sink::Get().Flush();
+}
+
+uint64_t Dropped()
+{
+    return Sink::Get().Dropped();
+}
+
+} // namespace Hotones::Log
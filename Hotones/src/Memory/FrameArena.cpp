@@ -0,0 +1,93 @@
+// FrameArena.cpp — per-thread, double-buffered bump allocator
+
+#include "../include/Memory/FrameArena.hpp"
+#include "../include/Memory/MemoryTracker.hpp"
+#include <algorithm>
+
+namespace Hotones::Memory {
+
+FrameArena& FrameArena::Get()
+{
+    static thread_local FrameArena s_arena;
+    return s_arena;
+}
+
+FrameArena::~FrameArena()
+{
+    for (const Buffer& buffer : m_buffers)
+        for (const Block& block : buffer.blocks) Freed(Tag::FrameArena, block.size);
+}
+
+void* FrameArena::Allocate(size_t bytes, size_t align)
+{
+    if (!m_active) return nullptr;
+    if (bytes == 0) bytes = 1;
+    Buffer& buffer = m_buffers[m_current];
+
+    if (!buffer.blocks.empty()) {
+        Block&          block = buffer.blocks.back();
+        const uintptr_t base  = reinterpret_cast<uintptr_t>(block.data.get());
+        const uintptr_t start = (base + block.used + align - 1) & ~(uintptr_t)(align - 1);
+        const size_t    end   = (size_t)(start - base) + bytes;
+        if (end <= block.size) {
+            buffer.used += end - block.used;
+            block.used   = end;
+            m_stats.used = buffer.used;
+            return reinterpret_cast<void*>(start);
+        }
+    }
+
+    // Doubling, so a frame that outgrows its block needs few more
+    const size_t previous = buffer.blocks.empty() ? BLOCK_BYTES / 2 : buffer.blocks.back().size;
+    Block block;
+    block.size = std::max(previous * 2, bytes + align);
+    block.data.reset(new std::byte[block.size]);   // uninitialised
+    Allocated(Tag::FrameArena, block.size);
+    buffer.blocks.push_back(std::move(block));
+    return Allocate(bytes, align);
+}
+
+bool FrameArena::Owns(const void* p) const
+{
+    const std::byte* b = static_cast<const std::byte*>(p);
+    for (const Buffer& buffer : m_buffers)
+        for (const Block& block : buffer.blocks)
+            if (b >= block.data.get() && b < block.data.get() + block.size) return true;
+    return false;
+}
+
+void FrameArena::Reset(Buffer& buffer)
+{
+    if (buffer.blocks.size() > 1) {
+        size_t total = 0;
+        for (const Block& block : buffer.blocks) {
+            total += block.size;
+            Freed(Tag::FrameArena, block.size);
+        }
+        buffer.blocks.clear();
+        Block block;
+        block.size = total;
+        block.data.reset(new std::byte[total]);
+        Allocated(Tag::FrameArena, total);
+        buffer.blocks.push_back(std::move(block));
+    } else if (!buffer.blocks.empty()) {
+        buffer.blocks.back().used = 0;
+    }
+    buffer.used = 0;
+}
+
+void FrameArena::NextFrame()
+{
+    m_stats.lastFrame = m_buffers[m_current].used;
+    m_stats.peak      = std::max(m_stats.peak, m_stats.lastFrame);
+    m_current ^= 1;
+    Reset(m_buffers[m_current]);
+    m_active = true;
+    m_stats.frames++;
+    m_stats.used     = 0;
+    m_stats.reserved = 0;
+    for (const Buffer& buffer : m_buffers)
+        for (const Block& block : buffer.blocks) m_stats.reserved += block.size;
+}
+
+} // namespace Hotones::Memory
@@ -0,0 +1,86 @@
+// MemoryPanel.cpp — ImGui view of the memory tracker
+
+#include <Memory/MemoryTracker.hpp>
+#include <imgui/imgui.h>
+#include <algorithm>
+#include <array>
+#include <cfloat>
+
+namespace Hotones::Memory {
+
+namespace {
+
+constexpr size_t HISTORY_FRAMES = 240;
+constexpr float  GRAPH_HEIGHT   = 50.f;
+
+// Panel state, main thread only: per-frame totals, oldest first once full
+std::array<float, HISTORY_FRAMES> s_liveMB{};
+std::array<float, HISTORY_FRAMES> s_allocs{};
+size_t   s_next      = 0;
+size_t   s_count     = 0;
+uint64_t s_lastFrame = 0;
+
+double KB(int64_t bytes)  { return (double)bytes / 1024.0; }
+double KB(uint64_t bytes) { return (double)bytes / 1024.0; }
+
+void Record(const MemoryTracker::Stats& stats)
+{
+    if (stats.frames == s_lastFrame) return;   // drawn twice in a frame, or no NextFrame() yet
+    s_lastFrame      = stats.frames;
+    s_liveMB[s_next] = (float)(KB(stats.total.bytes) / 1024.0);
+    s_allocs[s_next] = (float)stats.total.frameAllocs;
+    s_next           = (s_next + 1) % HISTORY_FRAMES;
+    s_count          = std::min(s_count + 1, HISTORY_FRAMES);
+}
+
+void Row(const char* name, const MemoryTracker::TagStats& s)
+{
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn(); ImGui::TextUnformatted(name);
+    ImGui::TableNextColumn(); ImGui::Text("%.1f", KB(s.bytes));
+    ImGui::TableNextColumn(); ImGui::Text("%.1f", KB(s.peakBytes));
+    ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)s.frameAllocs);
+    ImGui::TableNextColumn(); ImGui::Text("%.1f", KB(s.frameBytes));
+    ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)s.peakFrameAllocs);
+    ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)s.allocs);
+}
+
+} // namespace
+
+void DrawPanel()
+{
+    MemoryTracker& tracker = MemoryTracker::Get();
+    const MemoryTracker::Stats& stats = tracker.GetStats();
+    Record(stats);
+
+    ImGui::Text("%.2f MB tracked, peak %.2f MB", KB(stats.total.bytes) / 1024.0, KB(stats.total.peakBytes) / 1024.0);
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Reset peaks")) tracker.ResetPeaks();
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Print")) tracker.Print(stdout);
+
+    if (s_count > 0) {
+        // Oldest first: from s_next when the ring has wrapped
+        const int offset = s_count == HISTORY_FRAMES ? (int)s_next : 0;
+        const float width = ImGui::GetContentRegionAvail().x;
+        ImGui::PlotLines("##live", s_liveMB.data(), (int)s_count, offset, "live MB", 0.f, FLT_MAX,
+                         { width, GRAPH_HEIGHT });
+        ImGui::PlotHistogram("##allocs", s_allocs.data(), (int)s_count, offset, "allocations per frame", 0.f,
+                             FLT_MAX, { width, GRAPH_HEIGHT });
+    }
+
+    if (!ImGui::BeginTable("##memtags", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) return;
+    ImGui::TableSetupColumn("Tag");
+    ImGui::TableSetupColumn("Live KB");
+    ImGui::TableSetupColumn("Peak KB");
+    ImGui::TableSetupColumn("Allocs/frame");
+    ImGui::TableSetupColumn("KB/frame");
+    ImGui::TableSetupColumn("Peak allocs/frame");
+    ImGui::TableSetupColumn("Allocs");
+    ImGui::TableHeadersRow();
+    for (size_t t = 0; t < TAG_COUNT; ++t) Row(TagName((Tag)t), stats.tags[t]);
+    Row("Total", stats.total);
+    ImGui::EndTable();
+}
+
+} // namespace Hotones::Memory
@@ -0,0 +1,166 @@
+// MemoryTracker.cpp — per-thread tagged allocation counters, sampled once a frame
+
+#include "../include/Memory/MemoryTracker.hpp"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace Hotones::Memory {
+
+namespace {
+
+constexpr const char* TAG_NAMES[TAG_COUNT] = {
+    "Lua", "ECS", "Physics", "Audio", "Meshes", "Textures", "Network", "FrameArena",
+};
+
+// Every thread's counters.  Blocks are never freed: a thread that exits
+// leaves its counts (they are still part of the sums) and its block to the
+// next new thread.  Leaked, so threads and statics torn down after main()
+// can still count.
+struct CounterRegistry {
+    std::mutex                           mutex;
+    std::vector<detail::ThreadCounters*> blocks;   // all, for the sums
+    std::vector<detail::ThreadCounters*> spare;    // of exited threads
+    detail::ThreadCounters*              exited = nullptr;   // counted into by exited threads
+};
+
+CounterRegistry& Registry()
+{
+    static CounterRegistry* s_registry = [] {
+        auto* r   = new CounterRegistry;
+        r->exited = new detail::ThreadCounters;
+        r->exited->shared = true;
+        r->blocks.push_back(r->exited);
+        return r;
+    }();
+    return *s_registry;
+}
+
+// Hands the thread's block back when the thread exits; what it frees after
+// that (other thread_locals' destructors) goes to the shared block
+struct ThreadDetach {
+    ~ThreadDetach()
+    {
+        CounterRegistry& r = Registry();
+        std::lock_guard<std::mutex> lk(r.mutex);
+        if (detail::t_counters && !detail::t_counters->shared) r.spare.push_back(detail::t_counters);
+        detail::t_counters = r.exited;
+    }
+};
+
+} // namespace
+
+const char* TagName(Tag tag)
+{
+    return (size_t)tag < TAG_COUNT ? TAG_NAMES[(size_t)tag] : "?";
+}
+
+detail::ThreadCounters& detail::AttachThread()
+{
+    CounterRegistry& r = Registry();
+    {
+        std::lock_guard<std::mutex> lk(r.mutex);
+        if (!r.spare.empty()) {
+            t_counters = r.spare.back();
+            r.spare.pop_back();
+        } else {
+            t_counters = new ThreadCounters;
+            r.blocks.push_back(t_counters);
+        }
+    }
+    static thread_local ThreadDetach s_detach;   // constructed here, so destroyed on exit
+    (void)s_detach;
+    return *t_counters;
+}
+
+MemoryTracker& MemoryTracker::Get()
+{
+    static MemoryTracker s_tracker;
+    return s_tracker;
+}
+
+void MemoryTracker::NextFrame()
+{
+    int64_t  live[TAG_COUNT]      = {};
+    uint64_t allocated[TAG_COUNT] = {};
+    uint64_t allocs[TAG_COUNT]    = {};
+    uint64_t frees[TAG_COUNT]     = {};
+    {
+        CounterRegistry& r = Registry();
+        std::lock_guard<std::mutex> lk(r.mutex);
+        for (const detail::ThreadCounters* c : r.blocks)
+            for (size_t t = 0; t < TAG_COUNT; ++t) {
+                live[t]      += c->live[t].load(std::memory_order_relaxed);
+                allocated[t] += c->allocated[t].load(std::memory_order_relaxed);
+                allocs[t]    += c->allocs[t].load(std::memory_order_relaxed);
+                frees[t]     += c->frees[t].load(std::memory_order_relaxed);
+            }
+    }
+
+    TagStats total;
+    total.peakBytes       = m_stats.total.peakBytes;
+    total.peakFrameAllocs = m_stats.total.peakFrameAllocs;
+    total.peakFrameBytes  = m_stats.total.peakFrameBytes;
+    for (size_t t = 0; t < TAG_COUNT; ++t) {
+        TagStats& s = m_stats.tags[t];
+        s.bytes           = std::max<int64_t>(live[t], 0);   // frees counted before their allocations
+        s.allocs          = allocs[t];
+        s.frees           = frees[t];
+        s.frameAllocs     = allocs[t] - m_lastAllocs[t];
+        s.frameBytes      = allocated[t] - m_lastAllocated[t];
+        s.peakBytes       = std::max(s.peakBytes, s.bytes);
+        s.peakFrameAllocs = std::max(s.peakFrameAllocs, s.frameAllocs);
+        s.peakFrameBytes  = std::max(s.peakFrameBytes, s.frameBytes);
+        m_lastAllocs[t]    = allocs[t];
+        m_lastAllocated[t] = allocated[t];
+
+        total.bytes       += s.bytes;
+        total.allocs      += s.allocs;
+        total.frees       += s.frees;
+        total.frameAllocs += s.frameAllocs;
+        total.frameBytes  += s.frameBytes;
+    }
+    // The first frame's "allocations during it" are everything since startup
+    if (m_stats.frames == 0) {
+        for (TagStats& s : m_stats.tags) s.peakFrameAllocs = s.peakFrameBytes = 0;
+        total.peakFrameAllocs = total.peakFrameBytes = 0;
+    } else {
+        total.peakFrameAllocs = std::max(total.peakFrameAllocs, total.frameAllocs);
+        total.peakFrameBytes  = std::max(total.peakFrameBytes, total.frameBytes);
+    }
+    total.peakBytes = std::max(total.peakBytes, total.bytes);
+    m_stats.total   = total;
+    m_stats.frames++;
+}
+
+void MemoryTracker::ResetPeaks()
+{
+    for (TagStats& s : m_stats.tags) {
+        s.peakBytes       = s.bytes;
+        s.peakFrameAllocs = s.frameAllocs;
+        s.peakFrameBytes  = s.frameBytes;
+    }
+    TagStats& t       = m_stats.total;
+    t.peakBytes       = t.bytes;
+    t.peakFrameAllocs = t.frameAllocs;
+    t.peakFrameBytes  = t.frameBytes;
+}
+
+void MemoryTracker::Print(std::FILE* out) const
+{
+    auto row = [out](const char* name, const TagStats& s) {
+        std::fprintf(out, "  %-10s %10.1f %10.1f %10llu %10.1f %10llu %10.1f\n", name,
+                     (double)s.bytes / 1024.0, (double)s.peakBytes / 1024.0,
+                     (unsigned long long)s.frameAllocs, (double)s.frameBytes / 1024.0,
+                     (unsigned long long)s.peakFrameAllocs, (double)s.peakFrameBytes / 1024.0);
+    };
+    std::fprintf(out, "Memory after %llu frames (KB; allocations per frame)\n",
+                 (unsigned long long)m_stats.frames);
+    std::fprintf(out, "  %-10s %10s %10s %10s %10s %10s %10s\n", "tag", "live", "peak", "allocs/f", "KB/f",
+                 "peak #/f", "peak KB/f");
+    for (size_t t = 0; t < TAG_COUNT; ++t) row(TAG_NAMES[t], m_stats.tags[t]);
+    row("total", m_stats.total);
+    std::fflush(out);
+}
+
+} // namespace Hotones::Memory
@@ -1,4 +1,5 @@
 #include <PakRegistry.hpp>
+#include <Assets/PackScanner.hpp>
 #include <filesystem>
 #include <algorithm>
 #include <cctype>
@@ -38,19 +39,12 @@ std::vector<std::string> PakRegistry::GetBuiltInNames() const {
 }
 
 void PakRegistry::ScanPaksDir() {
+    // Same listing as the main menu's, so both agree on what a pack is; a
+    // stat per pack, nothing opened
     m_filePaks.clear();
-    std::filesystem::path p("./paks");
-    if (!std::filesystem::exists(p) || !std::filesystem::is_directory(p)) return;
-    for (auto& e : std::filesystem::directory_iterator(p)) {
-        try {
-            if (e.is_regular_file() && e.path().extension() == ".cup") {
-                std::string name = toLo(e.path().stem().string());
-                m_filePaks[name] = e.path().string();
-            } else if (e.is_directory()) {
-                std::string name = toLo(e.path().stem().string());
-                m_filePaks[name] = e.path().string();
-            }
-        } catch (...) {}
+    for (const auto& pe : Assets::ScanPacksDir("./paks")) {
+        std::string name = toLo(std::filesystem::path(pe.fullPath).stem().string());
+        m_filePaks[name] = pe.fullPath;
     }
 }
 
@@ -0,0 +1,201 @@
+// On-disk BVH cache.  File layout (native byte order, checked on load):
+//
+//   BVHCacheHeader                      64 bytes
+//   QBVHNode  nodes[nodeCount]          16-byte aligned
+//   TriPacket packets[packetCount]
+//   uint32_t  nodeLanes[nodeCount * 4]       } only for meshes with
+//   uint32_t  packetLanes[packetCount * 4]   } mixed layers
+//
+// The payload is the QBVH's own arrays, so storing is a few writes and
+// loading is a size check, a few copies and an index validation pass.
+
+#include "../include/Physics/BVHCache.hpp"
+#include "../include/Physics/BVH.hpp"
+#include "../include/Physics/QBVH.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace Hotones { namespace Physics {
+
+// Bump whenever the builders or QBVHNode / TriPacket change, so stale
+// files miss instead of loading a tree from an older layout.
+static constexpr uint32_t BVH_CACHE_VERSION    = 2;
+static constexpr uint32_t BVH_CACHE_BYTE_ORDER = 0x01020304u;
+static constexpr char     BVH_CACHE_MAGIC[8]   = { 'H', 'O', 'Q', 'B', 'V', 'H', '\0', '\0' };
+
+struct BVHCacheHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t nodeSize;
+    uint32_t packetSize;
+    uint64_t key;
+    uint64_t nodeCount;
+    uint64_t packetCount;
+    uint32_t layers;        // LayerTable::all
+    uint32_t mixedLayers;   // 1 when the lane tables follow the packets
+    uint64_t reserved;
+};
+static_assert(sizeof(BVHCacheHeader) == 64, "cache header must keep the payload 16-byte aligned");
+
+static std::string CachePath(const std::string& dir, uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.qbvh", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(dir) / name).string();
+}
+
+// FNV-1a over 32-bit words: one multiply per float keeps hashing far
+// cheaper than the build it stands in for.
+uint64_t BVHCacheKey(const std::vector<Tri>& tris, BVHBuildQuality quality) {
+    uint64_t h = 14695981039346656037ull;
+    auto mix = [&](uint32_t w) { h = (h ^ w) * 1099511628211ull; };
+    mix(BVH_CACHE_VERSION);
+    mix(static_cast<uint32_t>(quality));
+    mix(static_cast<uint32_t>(tris.size()));
+    for (const Tri& t : tris) {
+        mix(t.layers);
+        const float v[9] = { t.a.x, t.a.y, t.a.z, t.b.x, t.b.y, t.b.z, t.c.x, t.c.y, t.c.z };
+        for (float f : v) {
+            uint32_t w;
+            std::memcpy(&w, &f, sizeof(w));
+            mix(w);
+        }
+    }
+    return h;
+}
+
+// Every child index must land inside the arrays, or a damaged file could
+// send a traversal out of bounds.  Inner children always follow their
+// parent (the collapse emits nodes in pre-order), which also rules out
+// cycles, and lets one forward pass find each node's depth: the
+// traversals' fixed stacks hold a tree of at most BVH::MAX_DEPTH levels.
+static bool ValidTopology(const QBVH& q) {
+    std::vector<uint8_t> depth(q.nodes.size(), 0);
+    depth[0] = 1;
+    for (size_t ni = 0; ni < q.nodes.size(); ++ni) {
+        const QBVHNode& n = q.nodes[ni];
+        for (int i = 0; i < 4; ++i) {
+            const int child = n.child[i], count = n.packetCount[i];
+            if (child == -1) continue;
+            if (child < 0 || count < 0) return false;
+            if (count > 0 ? (size_t)child + (size_t)count > q.packets.size()
+                          : (size_t)child >= q.nodes.size() || (size_t)child <= ni) return false;
+            if (count == 0) {
+                if (depth[ni] >= BVH::MAX_DEPTH) return false;
+                depth[child] = std::max<uint8_t>(depth[child], depth[ni] + 1);
+            }
+        }
+    }
+    for (const TriPacket& p : q.packets)
+        if (p.count < 1 || p.count > 4) return false;
+    return true;
+}
+
+bool LoadBVHCache(const std::string& dir, uint64_t key, QBVH& out) {
+    out.nodes.clear();
+    out.packets.clear();
+    out.layers.Clear();
+
+    MappedFile file;
+    if (!file.Open(CachePath(dir, key)) || file.Size() < sizeof(BVHCacheHeader)) return false;
+
+    BVHCacheHeader hdr;
+    std::memcpy(&hdr, file.Data(), sizeof(hdr));
+    if (std::memcmp(hdr.magic, BVH_CACHE_MAGIC, sizeof(hdr.magic)) != 0 ||
+        hdr.version != BVH_CACHE_VERSION || hdr.byteOrder != BVH_CACHE_BYTE_ORDER ||
+        hdr.nodeSize != sizeof(QBVHNode) || hdr.packetSize != sizeof(TriPacket) ||
+        hdr.key != key || hdr.nodeCount == 0 || hdr.mixedLayers > 1) return false;
+
+    const size_t maxCount = (file.Size() - sizeof(hdr)) / sizeof(TriPacket);
+    if (hdr.nodeCount > maxCount || hdr.packetCount > maxCount) return false;
+    const size_t nodeBytes   = static_cast<size_t>(hdr.nodeCount)   * sizeof(QBVHNode);
+    const size_t packetBytes = static_cast<size_t>(hdr.packetCount) * sizeof(TriPacket);
+    const size_t laneBytes   = hdr.mixedLayers
+        ? static_cast<size_t>(hdr.nodeCount + hdr.packetCount) * 4 * sizeof(uint32_t) : 0;
+    if (file.Size() != sizeof(hdr) + nodeBytes + packetBytes + laneBytes) return false;
+
+    const unsigned char* data = file.Data() + sizeof(hdr);
+    out.nodes.resize(static_cast<size_t>(hdr.nodeCount));
+    out.packets.resize(static_cast<size_t>(hdr.packetCount));
+    std::memcpy(out.nodes.data(),   data,             nodeBytes);
+    std::memcpy(out.packets.data(), data + nodeBytes, packetBytes);
+    out.layers.all = hdr.layers;
+    if (hdr.mixedLayers) {
+        data += nodeBytes + packetBytes;
+        out.layers.nodeLanes.resize(static_cast<size_t>(hdr.nodeCount) * 4);
+        out.layers.packetLanes.resize(static_cast<size_t>(hdr.packetCount) * 4);
+        std::memcpy(out.layers.nodeLanes.data(), data, out.layers.nodeLanes.size() * sizeof(uint32_t));
+        std::memcpy(out.layers.packetLanes.data(), data + out.layers.nodeLanes.size() * sizeof(uint32_t),
+                    out.layers.packetLanes.size() * sizeof(uint32_t));
+    }
+
+    if (!ValidTopology(out)) {
+        out.nodes.clear();
+        out.packets.clear();
+        out.layers.Clear();
+        return false;
+    }
+    return true;
+}
+
+bool StoreBVHCache(const std::string& dir, uint64_t key, const QBVH& bvh) {
+    if (bvh.nodes.empty()) return false;
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if (ec) return false;
+
+    BVHCacheHeader hdr{};
+    std::memcpy(hdr.magic, BVH_CACHE_MAGIC, sizeof(hdr.magic));
+    hdr.version     = BVH_CACHE_VERSION;
+    hdr.byteOrder   = BVH_CACHE_BYTE_ORDER;
+    hdr.nodeSize    = sizeof(QBVHNode);
+    hdr.packetSize  = sizeof(TriPacket);
+    hdr.key         = key;
+    hdr.nodeCount   = bvh.nodes.size();
+    hdr.packetCount = bvh.packets.size();
+    hdr.layers      = bvh.layers.all;
+    hdr.mixedLayers = bvh.layers.Mixed() ? 1u : 0u;
+
+    // Unique per writer, so two processes caching the same mesh don't
+    // interleave; the last rename wins with identical contents.
+    const std::string finalPath = CachePath(dir, key);
+    const size_t salt = std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+                        static_cast<size_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    const std::string tmpPath = finalPath + "." + std::to_string(salt) + ".tmp";
+    {
+        std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!ofs) return false;
+        ofs.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        ofs.write(reinterpret_cast<const char*>(bvh.nodes.data()),
+                  static_cast<std::streamsize>(bvh.nodes.size() * sizeof(QBVHNode)));
+        ofs.write(reinterpret_cast<const char*>(bvh.packets.data()),
+                  static_cast<std::streamsize>(bvh.packets.size() * sizeof(TriPacket)));
+        if (bvh.layers.Mixed()) {
+            ofs.write(reinterpret_cast<const char*>(bvh.layers.nodeLanes.data()),
+                      static_cast<std::streamsize>(bvh.layers.nodeLanes.size() * sizeof(uint32_t)));
+            ofs.write(reinterpret_cast<const char*>(bvh.layers.packetLanes.data()),
+                      static_cast<std::streamsize>(bvh.layers.packetLanes.size() * sizeof(uint32_t)));
+        }
+        if (!ofs) {
+            ofs.close();
+            fs::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    fs::rename(tmpPath, finalPath, ec);
+    if (ec) {
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+}} // namespace Hotones::Physics
@@ -0,0 +1,632 @@
+// Navigation mesh: walkable triangles of the static geometry, A* over them
+// and the funnel algorithm to straighten the result.
+//
+//   BuildNavMesh()   — gather, filter by slope and headroom, weld, link
+//                      neighbours across shared edges, grid for snapping
+//   Locate()         — the polygon under a point, through the grid
+//   SearchPolys()    — A* from polygon to polygon; a node is entered where
+//                      the line on to the target crosses its portal, and
+//                      the cost is the length of that polyline
+//   StringPull()     — funnel over the portals between those polygons
+//
+// Cache file (native byte order, checked on load):
+//
+//   NavCacheHeader              32 bytes
+//   Vector3 verts[vertCount]
+//   NavPoly polys[polyCount]
+
+#include "../include/Physics/NavMesh.hpp"
+#include "../include/Physics/BVH.hpp"
+#include "../include/Physics/BVHCache.hpp"
+#include "../include/Profile/Profiler.hpp"
+#include "../include/Memory/MemoryTracker.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <raylib.h>
+
+namespace Hotones { namespace Physics {
+
+// ─── Mesh ─────────────────────────────────────────────────────────────────────
+
+// nb[i] is the polygon across edge v[i] → v[(i + 1) % 3], -1 for a border
+struct NavPoly {
+    uint32_t v[3];
+    int32_t  nb[3];
+};
+
+struct NavMesh {
+    std::vector<Vector3> verts;
+    std::vector<NavPoly> polys;
+
+    // Uniform grid over the polygons' XZ bounds; cell c lists
+    // cellPolys[cellStart[c], cellStart[c + 1])
+    Vector3               bmin = { 0, 0, 0 }, bmax = { 0, 0, 0 };
+    float                 cellSize = 1.f;
+    int                   cols = 0, rows = 0;
+    std::vector<uint32_t> cellStart;
+    std::vector<uint32_t> cellPolys;
+
+    NavMeshStats stats;
+
+    Vector3 Corner(int poly, int i) const { return verts[polys[poly].v[i]]; }
+    Vector3 Centre(int poly) const {
+        return v3scale(v3add(v3add(Corner(poly, 0), Corner(poly, 1)), Corner(poly, 2)), 1.f / 3.f);
+    }
+    size_t Bytes() const {
+        return verts.size() * sizeof(Vector3) + polys.size() * sizeof(NavPoly) +
+               (cellStart.size() + cellPolys.size()) * sizeof(uint32_t);
+    }
+};
+
+using NavMeshPtr = std::shared_ptr<const NavMesh>;
+
+static std::atomic<NavMeshPtr>      g_navMesh{ nullptr };
+static std::mutex                   g_navWriteMutex;   // one build at a time
+static Hotones::Memory::TaggedBytes g_navMeshBytes{ Hotones::Memory::Tag::Physics };   // guarded by g_navWriteMutex
+
+// How far a path's ends may be from the mesh
+static constexpr float SNAP_STEP_UP   = 0.5f;   // surface above the point: a step
+static constexpr float SNAP_STEP_DOWN = 2.f;    // surface below: standing or falling onto it
+static constexpr float SNAP_RADIUS    = 2.f;    // off the mesh: nearest polygon this close
+
+static constexpr size_t PATH_GRAIN = 8;     // paths per job in a batch
+static constexpr int    GRID_TARGET = 4;    // polygons per grid cell, on average
+
+// ─── Building ─────────────────────────────────────────────────────────────────
+
+// XZ signed area ×2 of (a, b, c); positive when c is left of a→b seen from above
+static float TriArea2(Vector3 a, Vector3 b, Vector3 c) {
+    return (c.x - a.x) * (b.z - a.z) - (b.x - a.x) * (c.z - a.z);
+}
+
+static void BuildGrid(NavMesh& m) {
+    m.bmin = {  FLT_MAX,  FLT_MAX,  FLT_MAX };
+    m.bmax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (const Vector3& v : m.verts) {
+        m.bmin = Vector3Min(m.bmin, v);
+        m.bmax = Vector3Max(m.bmax, v);
+    }
+    const float width = std::max(m.bmax.x - m.bmin.x, 1e-3f), depth = std::max(m.bmax.z - m.bmin.z, 1e-3f);
+    m.cellSize = std::max(std::sqrt(width * depth * GRID_TARGET / (float)std::max<size_t>(m.polys.size(), 1)),
+                          0.25f);
+    m.cols = std::max(1, (int)std::ceil(width / m.cellSize));
+    m.rows = std::max(1, (int)std::ceil(depth / m.cellSize));
+
+    auto cellRange = [&](int poly, int& x0, int& z0, int& x1, int& z1) {
+        Vector3 lo = m.Corner(poly, 0), hi = lo;
+        for (int i = 1; i < 3; ++i) {
+            lo = Vector3Min(lo, m.Corner(poly, i));
+            hi = Vector3Max(hi, m.Corner(poly, i));
+        }
+        x0 = std::clamp((int)((lo.x - m.bmin.x) / m.cellSize), 0, m.cols - 1);
+        z0 = std::clamp((int)((lo.z - m.bmin.z) / m.cellSize), 0, m.rows - 1);
+        x1 = std::clamp((int)((hi.x - m.bmin.x) / m.cellSize), 0, m.cols - 1);
+        z1 = std::clamp((int)((hi.z - m.bmin.z) / m.cellSize), 0, m.rows - 1);
+    };
+
+    // Count, prefix sum, fill
+    m.cellStart.assign((size_t)m.cols * m.rows + 1, 0);
+    for (int p = 0; p < (int)m.polys.size(); ++p) {
+        int x0, z0, x1, z1;
+        cellRange(p, x0, z0, x1, z1);
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x) m.cellStart[(size_t)z * m.cols + x + 1]++;
+    }
+    for (size_t c = 1; c < m.cellStart.size(); ++c) m.cellStart[c] += m.cellStart[c - 1];
+    m.cellPolys.resize(m.cellStart.back());
+    std::vector<uint32_t> fill(m.cellStart.begin(), m.cellStart.end() - 1);
+    for (int p = 0; p < (int)m.polys.size(); ++p) {
+        int x0, z0, x1, z1;
+        cellRange(p, x0, z0, x1, z1);
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x) m.cellPolys[fill[(size_t)z * m.cols + x]++] = (uint32_t)p;
+    }
+}
+
+// The walkable triangles of `tris`, welded and linked across shared edges
+static void BuildPolys(NavMesh& m, const std::vector<Vector3>& tris, const NavMeshSettings& settings) {
+    const size_t count    = tris.size() / 3;
+    const float  minUp    = std::cos(settings.maxSlopeDegrees * DEG2RAD);
+    const float  weld     = std::max(settings.weldDistance, 1e-5f);
+
+    // Slope and headroom, in parallel: the headroom check is a ray per triangle
+    std::vector<uint8_t> walkable(count, 0);
+    Jobs::JobSystem::Get().ParallelFor(count, 256, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const Vector3 a = tris[3 * i], b = tris[3 * i + 1], c = tris[3 * i + 2];
+            const Vector3 n = v3cross(v3sub(b, a), v3sub(c, a));
+            const float   len = v3len(n);
+            if (len < 1e-12f || n.y / len < minUp) continue;
+            if (settings.agentHeight > 0.f) {
+                const Vector3 centre = v3scale(v3add(v3add(a, b), c), 1.f / 3.f);
+                Vector3 hitPos, hitNormal;
+                float   t;
+                if (RaycastWorld({ centre.x, centre.y + 0.05f, centre.z }, { 0.f, 1.f, 0.f },
+                                 settings.agentHeight, hitPos, hitNormal, t, nullptr, settings.mask)) continue;
+            }
+            walkable[i] = 1;
+        }
+    });
+
+    struct Cell {
+        int32_t x, y, z;
+        bool operator==(const Cell&) const = default;
+    };
+    struct CellHash {
+        size_t operator()(const Cell& c) const {
+            return (size_t)((uint64_t)(uint32_t)c.x * 73856093u ^ (uint64_t)(uint32_t)c.y * 19349663u ^
+                            (uint64_t)(uint32_t)c.z * 83492791u);
+        }
+    };
+    std::unordered_map<Cell, uint32_t, CellHash> welded;
+    auto vertexOf = [&](Vector3 v) {
+        const Cell cell = { (int32_t)std::lround(v.x / weld), (int32_t)std::lround(v.y / weld),
+                            (int32_t)std::lround(v.z / weld) };
+        auto [it, added] = welded.try_emplace(cell, (uint32_t)m.verts.size());
+        if (added) m.verts.push_back(v);
+        return it->second;
+    };
+
+    for (size_t i = 0; i < count; ++i) {
+        if (!walkable[i]) continue;
+        NavPoly p;
+        for (int k = 0; k < 3; ++k) {
+            p.v[k]  = vertexOf(tris[3 * i + k]);
+            p.nb[k] = -1;
+        }
+        if (p.v[0] == p.v[1] || p.v[1] == p.v[2] || p.v[2] == p.v[0]) continue;   // welded away
+        m.polys.push_back(p);
+    }
+
+    // Two polygons sharing an edge are neighbours; an edge shared by more
+    // (stacked or overlapping geometry) links its first two only
+    std::unordered_map<uint64_t, std::pair<int, int>> open;   // edge → (poly, edge index)
+    open.reserve(m.polys.size() * 2);
+    for (int p = 0; p < (int)m.polys.size(); ++p) {
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t a = m.polys[p].v[k], b = m.polys[p].v[(k + 1) % 3];
+            const uint64_t key = (uint64_t)std::min(a, b) << 32 | std::max(a, b);
+            auto [it, added] = open.try_emplace(key, p, k);
+            if (added || it->second.first < 0) continue;
+            m.polys[p].nb[k] = it->second.first;
+            m.polys[it->second.first].nb[it->second.second] = p;
+            it->second.first = -1;
+        }
+    }
+}
+
+// ─── Cache ────────────────────────────────────────────────────────────────────
+
+// Bump whenever the build or NavPoly changes
+static constexpr uint32_t NAV_CACHE_VERSION    = 1;
+static constexpr uint32_t NAV_CACHE_BYTE_ORDER = 0x01020304u;
+static constexpr char     NAV_CACHE_MAGIC[8]   = { 'H', 'O', 'N', 'A', 'V', 'M', '\0', '\0' };
+
+struct NavCacheHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t key;
+    uint32_t vertCount;
+    uint32_t polyCount;
+};
+static_assert(sizeof(NavCacheHeader) == 32, "nav cache header layout");
+
+static std::string NavCachePath(const std::string& dir, uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.nav", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(dir) / name).string();
+}
+
+// FNV-1a over the input triangles and the settings, like BVHCacheKey
+static uint64_t NavCacheKey(const std::vector<Vector3>& tris, const NavMeshSettings& settings) {
+    uint64_t h = 14695981039346656037ull;
+    auto mix = [&](uint32_t w) { h = (h ^ w) * 1099511628211ull; };
+    auto mixFloat = [&](float f) {
+        uint32_t w;
+        std::memcpy(&w, &f, sizeof(w));
+        mix(w);
+    };
+    mix(NAV_CACHE_VERSION);
+    mixFloat(settings.maxSlopeDegrees);
+    mixFloat(settings.agentHeight);
+    mixFloat(settings.weldDistance);
+    mix(settings.mask);
+    mix(static_cast<uint32_t>(tris.size()));
+    for (const Vector3& v : tris) {
+        mixFloat(v.x);
+        mixFloat(v.y);
+        mixFloat(v.z);
+    }
+    return h;
+}
+
+static bool LoadNavCache(const std::string& dir, uint64_t key, NavMesh& out) {
+    MappedFile file;
+    if (!file.Open(NavCachePath(dir, key)) || file.Size() < sizeof(NavCacheHeader)) return false;
+
+    NavCacheHeader hdr;
+    std::memcpy(&hdr, file.Data(), sizeof(hdr));
+    if (std::memcmp(hdr.magic, NAV_CACHE_MAGIC, sizeof(hdr.magic)) != 0 || hdr.version != NAV_CACHE_VERSION ||
+        hdr.byteOrder != NAV_CACHE_BYTE_ORDER || hdr.key != key || hdr.polyCount == 0) return false;
+    const size_t vertBytes = (size_t)hdr.vertCount * sizeof(Vector3);
+    const size_t polyBytes = (size_t)hdr.polyCount * sizeof(NavPoly);
+    if (file.Size() != sizeof(hdr) + vertBytes + polyBytes) return false;
+
+    out.verts.resize(hdr.vertCount);
+    out.polys.resize(hdr.polyCount);
+    std::memcpy(out.verts.data(), file.Data() + sizeof(hdr), vertBytes);
+    std::memcpy(out.polys.data(), file.Data() + sizeof(hdr) + vertBytes, polyBytes);
+
+    // A damaged file must not send a search out of bounds
+    for (const NavPoly& p : out.polys) {
+        for (int k = 0; k < 3; ++k) {
+            if (p.v[k] >= hdr.vertCount || p.nb[k] < -1 || p.nb[k] >= (int32_t)hdr.polyCount) {
+                out.verts.clear();
+                out.polys.clear();
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool StoreNavCache(const std::string& dir, uint64_t key, const NavMesh& m) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if (ec) return false;
+
+    NavCacheHeader hdr{};
+    std::memcpy(hdr.magic, NAV_CACHE_MAGIC, sizeof(hdr.magic));
+    hdr.version   = NAV_CACHE_VERSION;
+    hdr.byteOrder = NAV_CACHE_BYTE_ORDER;
+    hdr.key       = key;
+    hdr.vertCount = (uint32_t)m.verts.size();
+    hdr.polyCount = (uint32_t)m.polys.size();
+
+    // Written aside and renamed into place, as StoreBVHCache does
+    const std::string finalPath = NavCachePath(dir, key);
+    const size_t salt = std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+                        static_cast<size_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    const std::string tmpPath = finalPath + "." + std::to_string(salt) + ".tmp";
+    {
+        std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!ofs) return false;
+        ofs.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        ofs.write(reinterpret_cast<const char*>(m.verts.data()),
+                  static_cast<std::streamsize>(m.verts.size() * sizeof(Vector3)));
+        ofs.write(reinterpret_cast<const char*>(m.polys.data()),
+                  static_cast<std::streamsize>(m.polys.size() * sizeof(NavPoly)));
+        if (!ofs) {
+            ofs.close();
+            fs::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    fs::rename(tmpPath, finalPath, ec);
+    if (ec) {
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+size_t BuildNavMesh(const NavMeshSettings& settings) {
+    HOTONES_ZONE("Build navmesh");
+    std::lock_guard<std::mutex> lk(g_navWriteMutex);
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<Vector3> tris;
+    GatherStaticTriangles(tris, settings.mask);
+
+    auto mesh = std::make_shared<NavMesh>();
+    const std::string cacheDir = GetBVHCacheDirectory();
+    const uint64_t    key      = NavCacheKey(tris, settings);
+    mesh->stats.fromCache = !cacheDir.empty() && LoadNavCache(cacheDir, key, *mesh);
+    if (!mesh->stats.fromCache) {
+        BuildPolys(*mesh, tris, settings);
+        if (!cacheDir.empty() && !mesh->polys.empty() && !StoreNavCache(cacheDir, key, *mesh))
+            TraceLog(LOG_WARNING, "[NavMesh] Could not write %s", NavCachePath(cacheDir, key).c_str());
+    }
+    if (mesh->polys.empty()) {
+        g_navMesh.store(nullptr, std::memory_order_release);
+        g_navMeshBytes.Set(0);
+        TraceLog(LOG_WARNING, "[NavMesh] No walkable triangles among %zu", tris.size() / 3);
+        return 0;
+    }
+    BuildGrid(*mesh);
+
+    mesh->stats.polygons = mesh->polys.size();
+    mesh->stats.vertices = mesh->verts.size();
+    mesh->stats.bytes    = mesh->Bytes();
+    mesh->stats.buildMs  = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    g_navMeshBytes.Set(mesh->stats.bytes);
+    TraceLog(LOG_INFO, "[NavMesh] %zu polygons from %zu triangles in %.1f ms%s", mesh->stats.polygons,
+             tris.size() / 3, mesh->stats.buildMs, mesh->stats.fromCache ? " (cached)" : "");
+    const size_t polygons = mesh->stats.polygons;
+    g_navMesh.store(std::move(mesh), std::memory_order_release);
+    return polygons;
+}
+
+void ClearNavMesh() {
+    std::lock_guard<std::mutex> lk(g_navWriteMutex);
+    g_navMesh.store(nullptr, std::memory_order_release);
+    g_navMeshBytes.Set(0);
+}
+
+bool HasNavMesh() {
+    return g_navMesh.load(std::memory_order_acquire) != nullptr;
+}
+
+NavMeshStats GetNavMeshStats() {
+    const NavMeshPtr mesh = g_navMesh.load(std::memory_order_acquire);
+    return mesh ? mesh->stats : NavMeshStats{};
+}
+
+// ─── Queries ──────────────────────────────────────────────────────────────────
+
+// Height of poly's plane at p's XZ, if p's XZ lies within it
+static bool HeightInPoly(const NavMesh& m, int poly, Vector3 p, float& y) {
+    const Vector3 a = m.Corner(poly, 0), b = m.Corner(poly, 1), c = m.Corner(poly, 2);
+    const float d = TriArea2(a, b, c);
+    if (std::fabs(d) < 1e-12f) return false;
+    const float u = TriArea2(b, c, p) / d, v = TriArea2(c, a, p) / d, w = 1.f - u - v;
+    const float eps = -1e-5f;
+    if (u < eps || v < eps || w < eps) return false;
+    y = u * a.y + v * b.y + w * c.y;
+    return true;
+}
+
+// The polygon for p and the point on it: the one under p within a step,
+// else the nearest within SNAP_RADIUS; -1 if none
+static int Locate(const NavMesh& m, Vector3 p, Vector3& onMesh) {
+    auto cellOf = [&](float v, float lo, int n) { return std::clamp((int)((v - lo) / m.cellSize), 0, n - 1); };
+    if (p.x >= m.bmin.x && p.x <= m.bmax.x && p.z >= m.bmin.z && p.z <= m.bmax.z) {
+        const size_t cell = (size_t)cellOf(p.z, m.bmin.z, m.rows) * m.cols + cellOf(p.x, m.bmin.x, m.cols);
+        int   best  = -1;
+        float bestD = FLT_MAX;
+        for (uint32_t i = m.cellStart[cell]; i < m.cellStart[cell + 1]; ++i) {
+            float y;
+            const int poly = (int)m.cellPolys[i];
+            if (!HeightInPoly(m, poly, p, y) || y > p.y + SNAP_STEP_UP || y < p.y - SNAP_STEP_DOWN) continue;
+            if (std::fabs(y - p.y) < bestD) {
+                bestD  = std::fabs(y - p.y);
+                best   = poly;
+                onMesh = { p.x, y, p.z };
+            }
+        }
+        if (best >= 0) return best;
+    }
+
+    const int x0 = cellOf(p.x - SNAP_RADIUS, m.bmin.x, m.cols), x1 = cellOf(p.x + SNAP_RADIUS, m.bmin.x, m.cols);
+    const int z0 = cellOf(p.z - SNAP_RADIUS, m.bmin.z, m.rows), z1 = cellOf(p.z + SNAP_RADIUS, m.bmin.z, m.rows);
+    int   best  = -1;
+    float bestD = SNAP_RADIUS * SNAP_RADIUS;
+    for (int z = z0; z <= z1; ++z) {
+        for (int x = x0; x <= x1; ++x) {
+            const size_t cell = (size_t)z * m.cols + x;
+            for (uint32_t i = m.cellStart[cell]; i < m.cellStart[cell + 1]; ++i) {
+                const int     poly = (int)m.cellPolys[i];
+                const Vector3 q    = ClosestPtTriangle(p, m.Corner(poly, 0), m.Corner(poly, 1), m.Corner(poly, 2));
+                const Vector3 d    = v3sub(q, p);
+                if (v3dot(d, d) <= bestD) {
+                    bestD  = v3dot(d, d);
+                    best   = poly;
+                    onMesh = q;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+// Where the path from `from` enters portal ab on its way to `target`: the
+// crossing of the straight line, kept a little inside the portal.  Entering
+// at midpoints instead makes open floors come out as staircases of
+// polygons, which the funnel can only follow.
+static Vector3 PortalCrossing(Vector3 a, Vector3 b, Vector3 from, Vector3 target) {
+    const float ex = b.x - a.x, ez = b.z - a.z;        // portal
+    const float dx = target.x - from.x, dz = target.z - from.z;
+    const float denom = dx * ez - dz * ex;
+    float t = 0.5f;
+    if (std::fabs(denom) > 1e-9f) t = (dx * (from.z - a.z) - dz * (from.x - a.x)) / denom;
+    return Vector3Lerp(a, b, std::clamp(t, 0.05f, 0.95f));
+}
+
+// Per-thread A* state, sized to the mesh and reused; `stamp` marks the
+// entries a search has touched, so starting one clears nothing
+struct PathSearch {
+    std::vector<uint32_t> stamp;
+    std::vector<float>    cost;
+    std::vector<int>      parent;
+    std::vector<Vector3>  entry;   // where the path enters the polygon
+    std::vector<std::pair<float, int>> open;   // (estimate, poly), a min-heap
+    uint32_t              current = 0;
+
+    void Reset(size_t polys) {
+        if (stamp.size() != polys) {
+            stamp.assign(polys, 0);
+            cost.resize(polys);
+            parent.resize(polys);
+            entry.resize(polys);
+            current = 0;
+        }
+        if (++current == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            current = 1;
+        }
+        open.clear();
+    }
+};
+
+// Polygons from `from` to `to`, or towards the polygon nearest `target`
+// if `to` can't be reached (partial = true)
+static void SearchPolys(const NavMesh& m, int from, Vector3 start, int to, Vector3 target,
+                        std::vector<int>& out, bool& partial) {
+    thread_local PathSearch s;
+    s.Reset(m.polys.size());
+    auto later = [](const std::pair<float, int>& a, const std::pair<float, int>& b) { return a.first > b.first; };
+
+    s.stamp[from]  = s.current;
+    s.cost[from]   = 0.f;
+    s.parent[from] = -1;
+    s.entry[from]  = start;
+    s.open.push_back({ Vector3Distance(start, target), from });
+    int   nearest  = from;
+    float nearestH = Vector3Distance(start, target);
+
+    while (!s.open.empty()) {
+        std::pop_heap(s.open.begin(), s.open.end(), later);
+        const auto [estimate, poly] = s.open.back();
+        s.open.pop_back();
+        if (poly == to) break;
+        if (estimate > s.cost[poly] + Vector3Distance(s.entry[poly], target) + 1e-4f) continue;   // stale
+
+        const NavPoly& p = m.polys[poly];
+        for (int k = 0; k < 3; ++k) {
+            const int next = p.nb[k];
+            if (next < 0) continue;
+            const Vector3 at = next == to ? target
+                                          : PortalCrossing(m.verts[p.v[k]], m.verts[p.v[(k + 1) % 3]],
+                                                           s.entry[poly], target);
+            const float   g      = s.cost[poly] + Vector3Distance(s.entry[poly], at);
+            if (s.stamp[next] == s.current && g >= s.cost[next]) continue;
+            s.stamp[next]  = s.current;
+            s.cost[next]   = g;
+            s.parent[next] = poly;
+            s.entry[next]  = at;
+            const float h = Vector3Distance(at, target);
+            if (h < nearestH) {
+                nearestH = h;
+                nearest  = next;
+            }
+            s.open.push_back({ g + h, next });
+            std::push_heap(s.open.begin(), s.open.end(), later);
+        }
+    }
+
+    partial = to < 0 || s.stamp[to] != s.current;
+    out.clear();
+    for (int poly = partial ? nearest : to; poly >= 0; poly = s.parent[poly]) out.push_back(poly);
+    std::reverse(out.begin(), out.end());
+}
+
+// p lies on segment ab, seen from above
+static bool OnSegmentXZ(Vector3 p, Vector3 a, Vector3 b) {
+    const float len2 = (b.x - a.x) * (b.x - a.x) + (b.z - a.z) * (b.z - a.z);
+    return std::fabs(TriArea2(a, b, p)) <= 1e-4f * std::max(len2, 1e-6f) &&
+           (a.x - p.x) * (b.x - p.x) + (a.z - p.z) * (b.z - p.z) <= 0.f;
+}
+
+// The corners of the shortest path from start to end through the portals
+// between `polys` (the simple stupid funnel algorithm)
+static void StringPull(const NavMesh& m, const std::vector<int>& polys, Vector3 start, Vector3 end,
+                       std::vector<Vector3>& out) {
+    thread_local std::vector<std::pair<Vector3, Vector3>> portals;   // (left, right)
+    portals.clear();
+    portals.push_back({ start, start });
+    for (size_t i = 0; i + 1 < polys.size(); ++i) {
+        const NavPoly& p = m.polys[polys[i]];
+        for (int k = 0; k < 3; ++k) {
+            if (p.nb[k] != polys[i + 1]) continue;
+            Vector3 left = m.verts[p.v[k]], right = m.verts[p.v[(k + 1) % 3]];
+            // A portal through either end constrains nothing, and its zero
+            // area would read as the funnel crossing over
+            if (OnSegmentXZ(start, left, right) || OnSegmentXZ(end, left, right)) break;
+            // Left and right as seen from inside polys[i], whichever way it winds
+            if (TriArea2(m.Centre(polys[i]), left, right) < 0.f) std::swap(left, right);
+            portals.push_back({ left, right });
+            break;
+        }
+    }
+    portals.push_back({ end, end });
+
+    out.push_back(start);
+    Vector3 apex = start, left = portals[0].first, right = portals[0].second;
+    size_t  apexIndex = 0, leftIndex = 0, rightIndex = 0;
+    auto same = [](Vector3 a, Vector3 b) { return Vector3DistanceSqr(a, b) < 1e-12f; };
+    for (size_t i = 1; i < portals.size(); ++i) {
+        const Vector3 l = portals[i].first, r = portals[i].second;
+        // Tighten the right side, or turn at the left corner if it crosses over
+        if (TriArea2(apex, right, r) <= 0.f) {
+            if (same(apex, right) || TriArea2(apex, left, r) > 0.f) {
+                right      = r;
+                rightIndex = i;
+            } else {
+                if (!same(out.back(), left)) out.push_back(left);
+                apex = right = left;
+                apexIndex = rightIndex = leftIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+        // Tighten the left side, or turn at the right corner
+        if (TriArea2(apex, left, l) >= 0.f) {
+            if (same(apex, left) || TriArea2(apex, right, l) < 0.f) {
+                left      = l;
+                leftIndex = i;
+            } else {
+                if (!same(out.back(), right)) out.push_back(right);
+                apex = left = right;
+                apexIndex = leftIndex = rightIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+    }
+    if (!same(out.back(), end)) out.push_back(end);
+}
+
+static PathResult FindPathIn(const NavMesh& m, Vector3 start, Vector3 end) {
+    PathResult result;
+    Vector3 from, to;
+    const int startPoly = Locate(m, start, from);
+    const int endPoly   = Locate(m, end, to);
+    if (startPoly < 0) return result;
+
+    thread_local std::vector<int> polys;
+    SearchPolys(m, startPoly, from, endPoly, endPoly >= 0 ? to : end, polys, result.partial);
+    result.partial = result.partial || endPoly < 0;
+    if (result.partial) {
+        // As near to the end as the last polygon reached gets
+        const int last = polys.back();
+        to = ClosestPtTriangle(end, m.Corner(last, 0), m.Corner(last, 1), m.Corner(last, 2));
+    }
+    StringPull(m, polys, from, to, result.points);
+    result.found = true;
+    return result;
+}
+
+PathResult FindPath(const Vector3& start, const Vector3& end) {
+    const NavMeshPtr mesh = g_navMesh.load(std::memory_order_acquire);
+    return mesh ? FindPathIn(*mesh, start, end) : PathResult{};
+}
+
+Jobs::JobFuture<std::vector<PathResult>> FindPathsAsync(std::vector<PathRequest> requests) {
+    Jobs::JobSystem& jobs = Jobs::JobSystem::Get();
+    return jobs.Async([mesh = g_navMesh.load(std::memory_order_acquire), requests = std::move(requests), &jobs] {
+        HOTONES_ZONE("Find paths");
+        std::vector<PathResult> results(requests.size());
+        if (!mesh) return results;
+        jobs.ParallelFor(requests.size(), PATH_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                results[i] = FindPathIn(*mesh, requests[i].start, requests[i].end);
+        });
+        return results;
+    });
+}
+
+}} // namespace Hotones::Physics
@@ -1,9 +1,13 @@
 // Physics backend: triangle-accurate sphere sweeps via a mid-phase BVH.
 //
 // Design:
-//   BuildBVH()              — recursive median-split BVH over triangles
-//   SweepSphereNode()       — traverse BVH, run analytic sphere-vs-tri test per leaf
-//   PenetrationSphereNode() — traverse BVH, resolve sphere-vs-tri overlap
+//   BVH::Build()            — binned-SAH (default) or centroid-mean split BVH
+//   QBVH::Build()           — collapse it into a 4-wide BVH with SoA triangle packets
+//   SweepNodeBVH()          — traverse QBVH, run analytic sphere-vs-tri test per leaf
+//   PenetrationNodeBVH()    — traverse QBVH, resolve sphere-vs-tri overlap
+//   CompactQBVH::Build()    — optional quantized re-encoding (BVHMemoryLayout::Compact)
+//   Load/StoreBVHCache()    — skip rebuilding meshes already built on an earlier run
+// The trees and the per-leaf kernels live in Physics/BVH.hpp and Physics/QBVH.hpp.
 //
 // Sphere-vs-triangle sweep:
 //   We cast a ray from (start) to (end) against the "inflated" geometry of each
@@ -15,415 +19,622 @@
 //   We return the earliest parametric hit t ∈ [0,1].
 
 #include "../include/Physics/PhysicsSystem.hpp"
+#include "../include/Physics/BVH.hpp"
+#include "../include/Physics/QBVH.hpp"
+#include "../include/Physics/BVHCache.hpp"
+#include "../include/Jobs/JobSystem.hpp"
+#include "../include/Profile/Profiler.hpp"
+#include "../include/Memory/MemoryTracker.hpp"
 #include <algorithm>
+#include <bit>
 #include <cfloat>
+#include <chrono>
 #include <cstring>
 #include <iostream>
 #include <raylib.h>
 #include <memory>
 #include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <condition_variable>
 #include <atomic>
 #include <deque>
 #include <mutex>
+#include <string>
+#include <variant>
 #include <vector>
 #include <raymath.h>
 
-// ─── Geometry helpers (file-internal) ────────────────────────────────────────
-
-static inline float v3dot(Vector3 a, Vector3 b) { return Vector3DotProduct(a, b); }
-static inline float v3len(Vector3 a)             { return Vector3Length(a); }
-static inline Vector3 v3norm(Vector3 a)           { return Vector3Normalize(a); }
-static inline Vector3 v3sub(Vector3 a, Vector3 b) { return Vector3Subtract(a, b); }
-static inline Vector3 v3add(Vector3 a, Vector3 b) { return Vector3Add(a, b); }
-static inline Vector3 v3scale(Vector3 a, float s) { return Vector3Scale(a, s); }
-static inline Vector3 v3cross(Vector3 a, Vector3 b){ return Vector3CrossProduct(a, b); }
-
-// Closest point on triangle (abc) to point p — Ericson §5.1.5
-static Vector3 ClosestPtTriangle(Vector3 p, Vector3 a, Vector3 b, Vector3 c) {
-    Vector3 ab = v3sub(b,a), ac = v3sub(c,a), ap = v3sub(p,a);
-    float d1 = v3dot(ab,ap), d2 = v3dot(ac,ap);
-    if (d1 <= 0.f && d2 <= 0.f) return a;
-
-    Vector3 bp = v3sub(p,b);
-    float d3 = v3dot(ab,bp), d4 = v3dot(ac,bp);
-    if (d3 >= 0.f && d4 <= d3) return b;
-
-    float vc = d1*d4 - d3*d2;
-    if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f) {
-        float v = d1 / (d1 - d3);
-        return v3add(a, v3scale(ab, v));
-    }
-
-    Vector3 cp = v3sub(p,c);
-    float d5 = v3dot(ab,cp), d6 = v3dot(ac,cp);
-    if (d6 >= 0.f && d5 <= d6) return c;
-
-    float vb = d5*d2 - d1*d6;
-    if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f) {
-        float w = d2 / (d2 - d6);
-        return v3add(a, v3scale(ac, w));
-    }
-
-    float va = d3*d6 - d5*d4;
-    float denom = d4 - d3 + d5 - d6;
-    if (va <= 0.f && denom > 0.f) {
-        float w = (d4 - d3) / denom;
-        return v3add(b, v3scale(v3sub(c,b), w));
-    }
-
-    float dv = 1.f / (va + vb + vc);
-    float vv = vb * dv, wv = vc * dv;
-    return v3add(a, v3add(v3scale(ab,vv), v3scale(ac,wv)));
-}
-
-// Analytic ray-vs-sphere: ray o+t*d, sphere center c radius r.
-// Returns t of first intersection, or FLT_MAX if none in [tMin,tMax].
-static float RaySphere(Vector3 o, Vector3 d, Vector3 c, float r, float tMin, float tMax) {
-    Vector3 oc = v3sub(o, c);
-    float A = v3dot(d,d);
-    float B = 2.f * v3dot(oc, d);
-    float C = v3dot(oc, oc) - r*r;
-    float disc = B*B - 4.f*A*C;
-    if (disc < 0.f) return FLT_MAX;
-    float sqrtD = sqrtf(disc);
-    float t = (-B - sqrtD) / (2.f*A);
-    if (t >= tMin && t <= tMax) return t;
-    t = (-B + sqrtD) / (2.f*A);
-    if (t >= tMin && t <= tMax) return t;
-    return FLT_MAX;
-}
-
-// Analytic ray-vs-infinite-cylinder (axis a→b, radius r).
-// Returns t of first lateral intersection, or FLT_MAX if none.
-static float RayCylinder(Vector3 ro, Vector3 rd, Vector3 a, Vector3 b, float r, float tMin, float tMax) {
-    Vector3 ab  = v3sub(b, a);
-    Vector3 ao  = v3sub(ro, a);
-    float abLen2 = v3dot(ab, ab);
-    if (abLen2 < 1e-10f) return FLT_MAX;
-
-    // Project rd and ao onto plane perpendicular to ab
-    float rdDotAb = v3dot(rd, ab) / abLen2;
-    float aoDotAb = v3dot(ao, ab) / abLen2;
-    Vector3 d_perp = v3sub(rd, v3scale(ab, rdDotAb));
-    Vector3 o_perp = v3sub(ao, v3scale(ab, aoDotAb));
-
-    float A = v3dot(d_perp, d_perp);
-    float B = 2.f * v3dot(o_perp, d_perp);
-    float C = v3dot(o_perp, o_perp) - r*r;
-    float disc = B*B - 4.f*A*C;
-    if (disc < 0.f || A < 1e-10f) return FLT_MAX;
-    float sqrtD = sqrtf(disc);
-    float t = (-B - sqrtD) / (2.f*A);
-    if (t < tMin || t > tMax) {
-        t = (-B + sqrtD) / (2.f*A);
-        if (t < tMin || t > tMax) return FLT_MAX;
-    }
-    // Check that the hit lies between a and b along the cylinder axis
-    Vector3 hitPt = v3add(ro, v3scale(rd, t));
-    float proj = v3dot(v3sub(hitPt, a), ab) / abLen2;
-    if (proj < 0.f || proj > 1.f) return FLT_MAX;
-    return t;
-}
-
-// Continuous sphere vs triangle sweep.
-// Returns t ∈ [0, segLen/segLen=1] of first contact, FLT_MAX if no hit.
-// outNormal filled with the contact normal at impact.
-static float SweepSphereTriangle(Vector3 start, Vector3 end, float radius,
-                                  Vector3 ta, Vector3 tb, Vector3 tc,
-                                  Vector3& outNormal) {
-    Vector3 d    = v3sub(end, start);
-    float segLen = v3len(d);
-    if (segLen < 1e-10f) return FLT_MAX;
-
-    Vector3 triNorm = v3norm(v3cross(v3sub(tb,ta), v3sub(tc,ta)));
-    float bestT = FLT_MAX;
-    Vector3 bestN = triNorm;
+using namespace Hotones::Physics;
 
-    // ── 1. Ray vs face (inflated by radius along normal) ─────────────────────
-    {
-        float nDotD = v3dot(triNorm, d);
-        if (fabsf(nDotD) > 1e-8f) {
-            // Inflate plane by radius toward sphere origin
-            for (int sign = -1; sign <= 1; sign += 2) {
-                Vector3 planePoint = v3add(ta, v3scale(triNorm, sign * radius));
-                float nDotOs = v3dot(triNorm, v3sub(planePoint, start));
-                float t = nDotOs / nDotD;
-                if (t >= 0.f && t < bestT) {
-                    // Check if hit point (back-projected onto triangle plane) is inside triangle
-                    Vector3 hitPt    = v3add(start, v3scale(d, t));
-                    Vector3 onPlane  = v3sub(hitPt, v3scale(triNorm, sign * radius));
-                    Vector3 closest  = ClosestPtTriangle(onPlane, ta, tb, tc);
-                    if (v3len(v3sub(onPlane, closest)) < 1e-4f) {
-                        bestT = t;
-                        bestN = v3scale(triNorm, (float)sign);
-                    }
-                }
-            }
-        }
+// ─── Static mesh registry ─────────────────────────────────────────────────────
+
+// Handles index a slot map: handle = generation << MESH_INDEX_BITS | (slot + 1).
+// The generation is bumped whenever a slot is freed, so a stale handle to a
+// reused slot is rejected; the +1 keeps every valid handle positive.
+//
+// Queries never lock.  The whole slot table is an immutable snapshot
+// published through an atomic shared_ptr: writers (register, unregister,
+// the BVH worker installing a build) copy the current table under
+// g_meshWriteMutex, edit the copy and swap it in.  A query loads the current
+// snapshot once and keeps it alive until it returns, so the BVHs it
+// traverses can neither change nor be freed underneath it, and any number
+// of threads can query concurrently.  Writes are rare (level load) and cost
+// a copy of the slot array plus a rebuild of the top-level tree.
+// A mesh's tree in whichever layout it was built with; queries visit it
+// with the same templated kernels either way.
+using MeshBvh = std::variant<QBVH, CompactQBVH>;
+
+struct StaticMeshSlot {
+    std::shared_ptr<const MeshBvh> bvh;  // null until the background build lands
+    Vector3                    bmin = { 0, 0, 0 }, bmax = { 0, 0, 0 };   // of bvh, world space
+    LayerMask                  layers     = 0;   // bvh's LayerTable::all
+    uint32_t                   generation = 0;
+    bool                       live       = false;
+
+    // Kinematic meshes and instances keep their BVH in model space;
+    // queries are moved into it through toLocal and results back out
+    // through toWorld.
+    bool    kinematic = false;
+    bool    instance  = false;                                // bvh is a shape's, shared: never refit
+    Matrix  toWorld   = MatrixIdentity();
+    Matrix  toLocal   = MatrixIdentity();
+    float   scale     = 1.f;                                  // uniform scale of toWorld
+    Vector3 localMin  = { 0, 0, 0 }, localMax = { 0, 0, 0 };  // of bvh, model space
+};
+
+// Top-level structure: a small BVH over the bounds of every built mesh,
+// so world queries reach the candidate meshes in O(log n) instead of
+// testing each handle.  Rebuilt with every published table.
+struct TlasNode {
+    Vector3   bmin, bmax;
+    LayerMask layers = 0;             // union over the meshes below
+    int       first = 0, count = 0;   // leaf: slots[first, first+count) of MeshTlas
+    int       rightChild = -1;        // -1 → leaf; left child = index+1
+};
+
+struct MeshTlas {
+    std::vector<TlasNode> nodes;
+    std::vector<uint32_t> slots;
+};
+
+struct StaticMeshTable {
+    std::vector<StaticMeshSlot> slots;
+    std::vector<uint32_t>       freeSlots;
+    MeshTlas                    tlas;
+};
+
+using MeshTablePtr = std::shared_ptr<const StaticMeshTable>;
+
+static constexpr int      MESH_INDEX_BITS = 20;
+static constexpr uint32_t MESH_INDEX_MASK = (1u << MESH_INDEX_BITS) - 1u;
+static constexpr uint32_t MESH_GEN_MASK   = (1u << (31 - MESH_INDEX_BITS)) - 1u;
+
+static std::atomic<MeshTablePtr> g_meshTable{ std::make_shared<const StaticMeshTable>() };
+static std::mutex                g_meshWriteMutex;
+static Hotones::Memory::TaggedBytes g_meshTableBytes{ Hotones::Memory::Tag::Physics };   // guarded by g_meshWriteMutex
+
+static int MakeMeshHandle(uint32_t slot, uint32_t generation) {
+    return static_cast<int>(((generation & MESH_GEN_MASK) << MESH_INDEX_BITS) | (slot + 1u));
+}
+
+// O(1) handle → live slot index in table, or -1.
+static int FindMeshSlot(const StaticMeshTable& table, int handle) {
+    if (handle <= 0) return -1;
+    const uint32_t h = static_cast<uint32_t>(handle);
+    if ((h & MESH_INDEX_MASK) == 0u) return -1;
+    const uint32_t slot = (h & MESH_INDEX_MASK) - 1u;
+    if (slot >= table.slots.size()) return -1;
+    const StaticMeshSlot& s = table.slots[slot];
+    if (!s.live || (s.generation & MESH_GEN_MASK) != (h >> MESH_INDEX_BITS)) return -1;
+    return static_cast<int>(slot);
+}
+
+static Vector3 TransformDir(const Matrix& m, Vector3 v) {
+    return { m.m0 * v.x + m.m4 * v.y + m.m8 * v.z,
+             m.m1 * v.x + m.m5 * v.y + m.m9 * v.z,
+             m.m2 * v.x + m.m6 * v.y + m.m10 * v.z };
+}
+
+// The box around the 8 corners of [bmin, bmax] moved by m.
+static void TransformBounds(const Matrix& m, Vector3 bmin, Vector3 bmax, Vector3& outMin, Vector3& outMax) {
+    outMin = {  FLT_MAX,  FLT_MAX,  FLT_MAX };
+    outMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (int i = 0; i < 8; ++i) {
+        const Vector3 corner = { (i & 1) ? bmax.x : bmin.x,
+                                 (i & 2) ? bmax.y : bmin.y,
+                                 (i & 4) ? bmax.z : bmin.z };
+        const Vector3 w = Vector3Transform(corner, m);
+        outMin = { fminf(outMin.x, w.x), fminf(outMin.y, w.y), fminf(outMin.z, w.z) };
+        outMax = { fmaxf(outMax.x, w.x), fmaxf(outMax.y, w.y), fmaxf(outMax.z, w.z) };
     }
+}
 
-    // ── 2. Ray vs edge capsules ───────────────────────────────────────────────
-    Vector3 edges[3][2] = { {ta,tb}, {tb,tc}, {tc,ta} };
-    for (auto& e : edges) {
-        float t = RayCylinder(start, d, e[0], e[1], radius, 0.f, bestT);
-        if (t < bestT) {
-            // Compute normal = (hitPoint - closestPointOnEdge) normalised
-            Vector3 hitPt   = v3add(start, v3scale(d, t));
-            Vector3 ab      = v3sub(e[1], e[0]);
-            float abL2      = v3dot(ab,ab);
-            float proj      = abL2 > 1e-10f ? v3dot(v3sub(hitPt, e[0]), ab) / abL2 : 0.f;
-            proj             = proj < 0.f ? 0.f : (proj > 1.f ? 1.f : proj);
-            Vector3 closest = v3add(e[0], v3scale(ab, proj));
-            Vector3 n       = v3sub(hitPt, closest);
-            float nlen      = v3len(n);
-            if (nlen > 1e-6f) {
-                bestT = t;
-                bestN = v3scale(n, 1.f/nlen);
-            }
-        }
+// World bounds from the model-space ones.
+static void UpdateWorldBounds(StaticMeshSlot& s) {
+    if (!s.kinematic) { s.bmin = s.localMin; s.bmax = s.localMax; return; }
+    TransformBounds(s.toWorld, s.localMin, s.localMax, s.bmin, s.bmax);
+}
+
+static void SetSlotTransform(StaticMeshSlot& s, const Matrix& transform) {
+    s.toWorld = transform;
+    s.toLocal = MatrixInvert(transform);
+    s.scale   = v3len({ transform.m0, transform.m1, transform.m2 });
+    UpdateWorldBounds(s);
+}
+
+static constexpr int TLAS_MAX_LEAF = 2;
+
+// Median split on the longest axis of the mesh centres; the tree is small
+// and rebuilt often, so it favours build speed over SAH quality.
+static int BuildTlasNode(MeshTlas& tlas, const StaticMeshTable& table, int start, int end) {
+    const int nodeIdx = (int)tlas.nodes.size();
+    tlas.nodes.push_back({});
+
+    auto center = [&](uint32_t slot, int axis) {
+        const StaticMeshSlot& s = table.slots[slot];
+        return (&s.bmin.x)[axis] + (&s.bmax.x)[axis];
+    };
+    Vector3 bmin = table.slots[tlas.slots[start]].bmin, bmax = table.slots[tlas.slots[start]].bmax;
+    Vector3 cmin = { center(tlas.slots[start], 0), center(tlas.slots[start], 1), center(tlas.slots[start], 2) };
+    Vector3 cmax = cmin;
+    LayerMask layers = table.slots[tlas.slots[start]].layers;
+    for (int i = start + 1; i < end; ++i) {
+        const StaticMeshSlot& s = table.slots[tlas.slots[i]];
+        layers |= s.layers;
+        bmin = { fminf(bmin.x, s.bmin.x), fminf(bmin.y, s.bmin.y), fminf(bmin.z, s.bmin.z) };
+        bmax = { fmaxf(bmax.x, s.bmax.x), fmaxf(bmax.y, s.bmax.y), fmaxf(bmax.z, s.bmax.z) };
+        const Vector3 c = { center(tlas.slots[i], 0), center(tlas.slots[i], 1), center(tlas.slots[i], 2) };
+        cmin = { fminf(cmin.x, c.x), fminf(cmin.y, c.y), fminf(cmin.z, c.z) };
+        cmax = { fmaxf(cmax.x, c.x), fmaxf(cmax.y, c.y), fmaxf(cmax.z, c.z) };
     }
+    tlas.nodes[nodeIdx].bmin = bmin;
+    tlas.nodes[nodeIdx].bmax = bmax;
+    tlas.nodes[nodeIdx].layers = layers;
 
-    // ── 3. Ray vs vertex spheres ──────────────────────────────────────────────
-    Vector3 verts[3] = { ta, tb, tc };
-    for (auto& v : verts) {
-        float t = RaySphere(start, d, v, radius, 0.f, bestT);
-        if (t < bestT) {
-            Vector3 hitPt = v3add(start, v3scale(d, t));
-            Vector3 n     = v3sub(hitPt, v);
-            float nlen    = v3len(n);
-            if (nlen > 1e-6f) {
-                bestT = t;
-                bestN = v3scale(n, 1.f/nlen);
-            }
-        }
+    if (end - start <= TLAS_MAX_LEAF) {
+        tlas.nodes[nodeIdx].first = start;
+        tlas.nodes[nodeIdx].count = end - start;
+        return nodeIdx;
     }
 
-    if (bestT > 1.f + 1e-6f) return FLT_MAX; // no hit within segment
-    outNormal = bestN;
-    return bestT;
+    const Vector3 ext = v3sub(cmax, cmin);
+    const int axis = (ext.x > ext.y && ext.x > ext.z) ? 0 : (ext.y > ext.z ? 1 : 2);
+    const int mid  = start + (end - start) / 2;
+    std::nth_element(tlas.slots.begin() + start, tlas.slots.begin() + mid, tlas.slots.begin() + end,
+                     [&](uint32_t a, uint32_t b) { return center(a, axis) < center(b, axis); });
+
+    BuildTlasNode(tlas, table, start, mid);                     // left child (always nodeIdx+1)
+    const int right = BuildTlasNode(tlas, table, mid, end);
+    tlas.nodes[nodeIdx].rightChild = right;
+    return nodeIdx;
 }
 
-// ─── BVH ─────────────────────────────────────────────────────────────────────
+static void RebuildTlas(StaticMeshTable& table) {
+    MeshTlas& tlas = table.tlas;
+    tlas.nodes.clear();
+    tlas.slots.clear();
+    for (uint32_t i = 0; i < table.slots.size(); ++i)
+        if (table.slots[i].live && table.slots[i].bvh) tlas.slots.push_back(i);
+    if (tlas.slots.empty()) return;
+    tlas.nodes.reserve(tlas.slots.size() * 2);
+    BuildTlasNode(tlas, table, 0, (int)tlas.slots.size());
+}
 
-struct Tri {
-    Vector3 a, b, c;
-    Vector3 centroid;
-};
+static PhysicsMemoryStats TableMemoryStats(const StaticMeshTable& table) {
+    PhysicsMemoryStats stats;
+    std::unordered_set<const MeshBvh*> counted;   // shared trees once
+    for (const StaticMeshSlot& s : table.slots) {
+        if (!s.live || !s.bvh) continue;
+        ++stats.meshes;
+        if (!counted.insert(s.bvh.get()).second) continue;
+        std::visit([&](const auto& tree) {
+            stats.triangles += tree.TriangleCount();
+            stats.bvhBytes  += tree.MemoryBytes();
+            if constexpr (std::is_same_v<std::decay_t<decltype(tree)>, CompactQBVH>) ++stats.compactMeshes;
+        }, *s.bvh);
+    }
+    stats.tableBytes = table.slots.capacity() * sizeof(StaticMeshSlot) +
+                       table.freeSlots.capacity() * sizeof(uint32_t) +
+                       table.tlas.nodes.capacity() * sizeof(TlasNode) +
+                       table.tlas.slots.capacity() * sizeof(uint32_t);
+    return stats;
+}
+
+// Copy the current table, let edit() change the copy, publish it.
+template<typename Fn>
+static void UpdateMeshTable(Fn&& edit) {
+    std::lock_guard<std::mutex> lk(g_meshWriteMutex);
+    auto next = std::make_shared<StaticMeshTable>(*g_meshTable.load(std::memory_order_acquire));
+    edit(*next);
+    RebuildTlas(*next);
+    g_meshTableBytes.Set(TableMemoryStats(*next).TotalBytes());
+    g_meshTable.store(std::move(next), std::memory_order_release);
+}
+
+// Slot of handle if its BVH is built, else nullptr.  `pin` keeps the
+// snapshot (and so the BVH) alive; hold it for the whole traversal.
+static const StaticMeshSlot* FindBuiltSlot(int handle, MeshTablePtr& pin) {
+    pin = g_meshTable.load(std::memory_order_acquire);
+    const int slot = FindMeshSlot(*pin, handle);
+    if (slot < 0) return nullptr;
+    const StaticMeshSlot& s = pin->slots[slot];
+    if (!s.bvh || std::visit([](const auto& tree) { return tree.Empty(); }, *s.bvh)) return nullptr;
+    return &s;
+}
 
-struct BVHNode {
-    // AABB enclosing all triangles in this subtree
-    Vector3 bmin, bmax;
-    // If leaf: [triStart, triStart+triCount)  in the reordered triangle array
-    // If internal: left child = index+1, right child = rightChild
-    int triStart = 0, triCount = 0;
-    int rightChild = -1; // -1 → leaf
+// Claim a slot in `table` for a new mesh and return its handle, or -1 when
+// the table is full.  Transformed slots (kinematic meshes, instances) start
+// at `transform`.
+static int ClaimSlot(StaticMeshTable& table, bool transformed, const Matrix& transform) {
+    uint32_t slot;
+    if (!table.freeSlots.empty()) {
+        slot = table.freeSlots.back();
+        table.freeSlots.pop_back();
+    } else {
+        if (table.slots.size() >= MESH_INDEX_MASK) return -1;
+        slot = static_cast<uint32_t>(table.slots.size());
+        table.slots.emplace_back();
+    }
+    StaticMeshSlot& s = table.slots[slot];
+    s.live      = true;
+    s.kinematic = transformed;
+    s.instance  = false;
+    SetSlotTransform(s, transformed ? transform : MatrixIdentity());
+    return MakeMeshHandle(slot, s.generation);
+}
+
+static void InstallBvh(StaticMeshSlot& s, std::shared_ptr<const MeshBvh> bvh) {
+    s.bvh = std::move(bvh);
+    std::visit([&](const auto& tree) {
+        tree.Bounds(s.localMin, s.localMax);
+        s.layers = tree.layers.all;
+    }, *s.bvh);
+    UpdateWorldBounds(s);
+}
+
+// ─── Per-mesh kernels ─────────────────────────────────────────────────────────
+
+// The BVH kernels, run in the mesh's own space.  Static meshes are built
+// in world space; a kinematic mesh's query is moved into model space (the
+// ray parameter t is unchanged by the move, a sphere's radius divides by
+// the scale) and its normal or push moved back.  Only triangles whose
+// layers meet `mask` are seen.
+
+template<typename Tree>
+static void RaycastMesh(const Tree& bvh, const StaticMeshSlot& s, Vector3 ro, Vector3 rd,
+                        float& bestT, Vector3& bestN, LayerMask mask) {
+    if (!s.kinematic) { RaycastNodeBVH(bvh, ro, rd, bestT, bestN, nullptr, mask); return; }
+    const float before = bestT;
+    Vector3     n      = bestN;
+    RaycastNodeBVH(bvh, Vector3Transform(ro, s.toLocal), TransformDir(s.toLocal, rd), bestT, n,
+                   nullptr, mask);
+    if (bestT < before) bestN = v3norm(TransformDir(s.toWorld, n));
+}
+
+template<typename Tree>
+static void SweepMesh(const Tree& bvh, const StaticMeshSlot& s, Vector3 start, Vector3 end, float radius,
+                      float& bestT, Vector3& bestN, LayerMask mask) {
+    if (!s.kinematic) { SweepNodeBVH(bvh, start, end, radius, bestT, bestN, nullptr, mask); return; }
+    const float before = bestT;
+    Vector3     n      = bestN;
+    SweepNodeBVH(bvh, Vector3Transform(start, s.toLocal), Vector3Transform(end, s.toLocal),
+                 radius / s.scale, bestT, n, nullptr, mask);
+    if (bestT < before) bestN = v3norm(TransformDir(s.toWorld, n));
+}
+
+template<typename Tree>
+static void PenetrationMesh(const Tree& bvh, const StaticMeshSlot& s, Vector3 center, float radius,
+                            Vector3& totalPush, bool& pushed, LayerMask mask) {
+    if (!s.kinematic) { PenetrationNodeBVH(bvh, center, radius, totalPush, pushed, nullptr, mask); return; }
+    Vector3 push = { 0, 0, 0 };
+    bool    any  = false;
+    PenetrationNodeBVH(bvh, Vector3Transform(center, s.toLocal), radius / s.scale, push, any, nullptr, mask);
+    if (!any) return;
+    totalPush = v3add(totalPush, TransformDir(s.toWorld, push));
+    pushed    = true;
+}
+
+// Background BVH builds.  Each registered mesh is one job on a private
+// pool (kept apart from JobSystem::Get() so a multi-second build never
+// lands on a thread that is waiting on frame work); large meshes split
+// their top-level subtrees into further jobs on the same pool.
+struct BuildTask {
+    int handle = -1;          // the mesh, or the shape when `shape` is set
+    std::vector<Tri> tris;
+    StaticMeshBuiltCallback onBuilt;
+    bool kinematic = false;   // keep lane sources for refits; full layout, no cache
+    bool shape     = false;   // a MeshShape's tree, installed into its instances
 };
+static std::unique_ptr<Hotones::Jobs::JobSystem> g_buildJobs;     // guarded by g_buildMutex
+static Hotones::Jobs::JobCounter                 g_buildsInFlight;
+static std::mutex                   g_buildMutex;
+static std::atomic<bool>            g_buildRunning{false};
+static std::atomic<BVHBuildQuality> g_bvhBuildQuality{BVHBuildQuality::SAH};
+static std::atomic<BVHMemoryLayout> g_bvhMemoryLayout{BVHMemoryLayout::Full};
+static std::string                  g_bvhCacheDir;   // guarded by g_buildMutex
+
+// Trees still in use, by content: a mesh whose triangles, build settings
+// and layout match one of them installs that tree instead of building its
+// own.  Kinematic meshes are local space, so every instance of one model
+// shares a tree; static meshes are world space and share only when their
+// triangles really coincide.  Trees are immutable once published (a refit
+// swaps in a copy), so sharing is safe.
+static std::mutex                                                  g_sharedBvhMutex;
+static std::unordered_map<uint64_t, std::weak_ptr<const MeshBvh>>  g_sharedBvhs;   // guarded by g_sharedBvhMutex
+
+// Shapes for instancing (RegisterMeshShape).  Instances created while the
+// tree is building wait on the shape and get it when the build lands.
+// Lock order: g_shapeMutex, then g_meshWriteMutex.
+struct MeshShape {
+    std::shared_ptr<const MeshBvh> bvh;       // null until built
+    std::vector<int>               waiting;   // instance handles, until then
+    bool                           building = true;
+    bool                           released = false;   // UnregisterMeshShape() while building
+};
+static std::mutex                          g_shapeMutex;
+static std::unordered_map<int, MeshShape>  g_shapes;          // guarded by g_shapeMutex
+static int                                 g_nextShape = 1;   // guarded by g_shapeMutex
 
-struct BVH {
-    std::vector<BVHNode> nodes;
-    std::vector<Tri>     tris;   // reordered
-
-    // Build from a flat triangle list
-    void Build(std::vector<Tri>&& inTris) {
-        tris = std::move(inTris);
-        if (tris.empty()) return;
-        nodes.clear();
-        nodes.reserve(tris.size() * 2);
-        BuildNode(0, (int)tris.size(), 0);
-    }
-
-private:
-    static Vector3 TriAabbMin(const Tri& t) {
-        return { fminf(t.a.x, fminf(t.b.x, t.c.x)),
-                 fminf(t.a.y, fminf(t.b.y, t.c.y)),
-                 fminf(t.a.z, fminf(t.b.z, t.c.z)) };
-    }
-    static Vector3 TriAabbMax(const Tri& t) {
-        return { fmaxf(t.a.x, fmaxf(t.b.x, t.c.x)),
-                 fmaxf(t.a.y, fmaxf(t.b.y, t.c.y)),
-                 fmaxf(t.a.z, fmaxf(t.b.z, t.c.z)) };
-    }
-
-    int BuildNode(int start, int end, int /*depth*/) {
-        int nodeIdx = (int)nodes.size();
-        nodes.push_back({});
-        BVHNode& node = nodes[nodeIdx];
-
-        // Compute AABB
-        node.bmin = TriAabbMin(tris[start]);
-        node.bmax = TriAabbMax(tris[start]);
-        for (int i = start+1; i < end; ++i) {
-            Vector3 mn = TriAabbMin(tris[i]);
-            Vector3 mx = TriAabbMax(tris[i]);
-            node.bmin = { fminf(node.bmin.x, mn.x), fminf(node.bmin.y, mn.y), fminf(node.bmin.z, mn.z) };
-            node.bmax = { fmaxf(node.bmax.x, mx.x), fmaxf(node.bmax.y, mx.y), fmaxf(node.bmax.z, mx.z) };
-        }
+// Progress since the queue last drained; guarded by g_progressMutex
+static std::mutex       g_progressMutex;
+static BVHBuildProgress g_buildProgress;
 
-        int count = end - start;
-        if (count <= 4) {
-            // Leaf
-            node.triStart = start;
-            node.triCount = count;
-            node.rightChild = -1;
-            return nodeIdx;
-        }
+// WaitForMeshes sleeps on g_readyCv; every finished build, unregister and
+// shutdown wakes it to re-check.
+static std::mutex              g_readyMutex;
+static std::condition_variable g_readyCv;
+static StaticMeshReadyHook     g_readyHook;     // guarded by g_readyMutex
+
+static void NotifyReadyWaiters() {
+    {
+        // Taking the lock orders this notify after a waiter's predicate check
+        std::lock_guard<std::mutex> lk(g_readyMutex);
+    }
+    g_readyCv.notify_all();
+}
 
-        // Split on longest axis at centroid median
-        Vector3 ext = v3sub(node.bmax, node.bmin);
-        int axis = (ext.x > ext.y && ext.x > ext.z) ? 0 : (ext.y > ext.z ? 1 : 2);
-        float mid = 0.f;
-        for (int i = start; i < end; ++i) {
-            float* c = &tris[i].centroid.x;
-            mid += c[axis];
+// `ready`: the mesh handles that became queryable (a shape's instances)
+static void FinishBuild(const BuildTask& task, bool installed, std::span<const int> ready) {
+    if (task.onBuilt) task.onBuilt(task.handle, installed);
+    if (!ready.empty()) {
+        StaticMeshReadyHook hook;
+        {
+            std::lock_guard<std::mutex> lk(g_readyMutex);
+            hook = g_readyHook;
         }
-        mid /= (float)count;
-
-        auto midIt = std::partition(tris.begin() + start, tris.begin() + end,
-                                    [axis, mid](const Tri& t){
-                                        const float* c = &t.centroid.x;
-                                        return c[axis] < mid;
-                                    });
-        int split = (int)(midIt - tris.begin());
-        if (split == start || split == end) split = start + count / 2;
-
-        node.triStart = -1; node.triCount = 0;
-        BuildNode(start, split, 0);                    // left child (always nodeIdx+1)
-        node.rightChild = BuildNode(split, end, 0);    // right child
-        // Re-fetch reference after possible vector reallocation
-        nodes[nodeIdx].rightChild = node.rightChild;
-        return nodeIdx;
+        if (hook) for (int handle : ready) hook(handle);
     }
-};
+    {
+        std::lock_guard<std::mutex> lk(g_progressMutex);
+        ++g_buildProgress.completed;
+    }
+    NotifyReadyWaiters();
+}
 
-// AABB vs expanded AABB (expand box by radius) overlap check
-static bool AabbOverlap(Vector3 bmin, Vector3 bmax, Vector3 qmin, Vector3 qmax) {
-    return (bmin.x <= qmax.x && bmax.x >= qmin.x) &&
-           (bmin.y <= qmax.y && bmax.y >= qmin.y) &&
-           (bmin.z <= qmax.z && bmax.z >= qmin.z);
-}
-
-// Traverse BVH for sweep; returns earliest t.
-static void SweepNodeBVH(const BVH& bvh, int nodeIdx,
-                          Vector3 start, Vector3 end, float radius,
-                          float& bestT, Vector3& bestN) {
-    if (nodeIdx < 0 || nodeIdx >= (int)bvh.nodes.size()) return;
-    const BVHNode& node = bvh.nodes[nodeIdx];
-
-    // Expand node AABB by radius and do a quick overlap test with the swept AABB of the sphere
-    Vector3 swMin = { fminf(start.x, end.x) - radius,
-                      fminf(start.y, end.y) - radius,
-                      fminf(start.z, end.z) - radius };
-    Vector3 swMax = { fmaxf(start.x, end.x) + radius,
-                      fmaxf(start.y, end.y) + radius,
-                      fmaxf(start.z, end.z) + radius };
-    if (!AabbOverlap(node.bmin, node.bmax, swMin, swMax)) return;
-
-    if (node.rightChild == -1) {
-        // Leaf — test each triangle
-        for (int i = node.triStart; i < node.triStart + node.triCount; ++i) {
-            const Tri& tri = bvh.tris[i];
-            Vector3 n;
-            float t = SweepSphereTriangle(start, end, radius, tri.a, tri.b, tri.c, n);
-            if (t < bestT) { bestT = t; bestN = n; }
+static void RunBuildTask(BuildTask& task, const std::string& cacheDir, Hotones::Jobs::JobSystem& pool) {
+    HOTONES_ZONE("Physics BVH build");
+    if (!g_buildRunning.load()) { FinishBuild(task, false, {}); return; }
+
+    // Build BVH (potentially expensive) before touching the table, then
+    // collapse it to the wide layout the queries run on.  A cache hit
+    // skips both.  The cache always holds the full layout; compacting is
+    // a cheap linear pass done after either path.
+    QBVH wide;
+    const BVHBuildQuality quality = g_bvhBuildQuality.load();
+    const bool compactLayout = !task.kinematic && g_bvhMemoryLayout.load() == BVHMemoryLayout::Compact;
+    const uint64_t cacheKey  = BVHCacheKey(task.tris, quality);
+    const uint64_t sharedKey = (cacheKey ^ (task.kinematic ? 1u : 0u) ^ (compactLayout ? 2u : 0u)) * 1099511628211ull;
+    bool fromCache = false;
+
+    std::shared_ptr<const MeshBvh> builtBvh;
+    {
+        std::lock_guard<std::mutex> lk(g_sharedBvhMutex);
+        auto it = g_sharedBvhs.find(sharedKey);
+        if (it != g_sharedBvhs.end()) builtBvh = it->second.lock();
+    }
+    const bool shared = builtBvh != nullptr;
+    if (!shared) {
+        if (!cacheDir.empty()) fromCache = LoadBVHCache(cacheDir, cacheKey, wide);
+        if (!fromCache) {
+            BVH binary;
+            binary.Build(std::move(task.tris), quality, &pool);
+            wide.Build(binary, task.kinematic);
+            if (!cacheDir.empty() && !StoreBVHCache(cacheDir, cacheKey, wide))
+                TraceLog(LOG_WARNING, "[Physics] Could not write BVH cache to %s", cacheDir.c_str());
         }
-        return;
+
+        if (compactLayout) {
+            CompactQBVH compact;
+            if (compact.Build(wide))
+                builtBvh = std::make_shared<const MeshBvh>(std::move(compact));
+            else
+                TraceLog(LOG_WARNING, "[Physics] Mesh handle=%d cannot be compacted; keeping full layout", task.handle);
+        }
+        if (!builtBvh) builtBvh = std::make_shared<const MeshBvh>(std::move(wide));
+
+        std::lock_guard<std::mutex> lk(g_sharedBvhMutex);
+        std::erase_if(g_sharedBvhs, [](const auto& entry) { return entry.second.expired(); });
+        g_sharedBvhs[sharedKey] = builtBvh;
     }
-    // Internal — recurse both children
-    SweepNodeBVH(bvh, nodeIdx + 1,        start, end, radius, bestT, bestN);
-    SweepNodeBVH(bvh, node.rightChild,    start, end, radius, bestT, bestN);
-}
-
-// Traverse BVH for penetration resolution — collect all triangles whose closest
-// point to `center` is within `radius`.
-static void PenetrationNodeBVH(const BVH& bvh, int nodeIdx,
-                                Vector3 center, float radius,
-                                Vector3& outPush, bool& didPush) {
-    if (nodeIdx < 0 || nodeIdx >= (int)bvh.nodes.size()) return;
-    const BVHNode& node = bvh.nodes[nodeIdx];
-
-    // Quick AABB cull (expand by radius)
-    if (center.x + radius < node.bmin.x || center.x - radius > node.bmax.x ||
-        center.y + radius < node.bmin.y || center.y - radius > node.bmax.y ||
-        center.z + radius < node.bmin.z || center.z - radius > node.bmax.z) return;
-
-    if (node.rightChild == -1) {
-        for (int i = node.triStart; i < node.triStart + node.triCount; ++i) {
-            const Tri& tri = bvh.tris[i];
-            Vector3 closest = ClosestPtTriangle(center, tri.a, tri.b, tri.c);
-            Vector3 diff    = v3sub(center, closest);
-            float dist2     = v3dot(diff, diff);
-            if (dist2 < radius * radius) {
-                float dist = sqrtf(dist2);
-                Vector3 n;
-                if (dist > 1e-6f) {
-                    n = v3scale(diff, 1.f / dist);
-                } else {
-                    // Center is on the triangle — push out along face normal
-                    n = v3norm(v3cross(v3sub(tri.b, tri.a), v3sub(tri.c, tri.a)));
-                }
-                float depth = radius - dist;
-                outPush  = v3add(outPush, v3scale(n, depth));
-                didPush  = true;
+
+    const char* how = shared ? "Shared" : fromCache ? "Loaded cached" : "Built";
+    if (task.shape) {
+        // Give the shape its tree and install it into the instances waiting for it
+        std::vector<int> ready;
+        bool known = false;   // not dropped by ShutdownPhysics() meanwhile
+        {
+            std::lock_guard<std::mutex> lk(g_shapeMutex);
+            auto it = g_shapes.find(task.handle);
+            if (it != g_shapes.end()) {
+                known = true;
+                MeshShape& shape = it->second;
+                UpdateMeshTable([&](StaticMeshTable& table) {
+                    for (int handle : shape.waiting) {
+                        const int slot = FindMeshSlot(table, handle);
+                        if (slot < 0) continue;
+                        InstallBvh(table.slots[slot], builtBvh);
+                        ready.push_back(handle);
+                    }
+                });
+                shape.bvh      = builtBvh;
+                shape.building = false;
+                shape.waiting  = {};
+                if (shape.released) g_shapes.erase(it);
             }
         }
+        std::visit([&](const auto& tree) {
+            TraceLog(LOG_INFO, "[Physics] %s shape=%d tris=%zu qbvh_nodes=%zu bytes=%zu instances=%zu",
+                     how, task.handle, tree.TriangleCount(), tree.nodes.size(), tree.MemoryBytes(), ready.size());
+        }, *builtBvh);
+        FinishBuild(task, known, ready);
         return;
     }
-    PenetrationNodeBVH(bvh, nodeIdx + 1,     center, radius, outPush, didPush);
-    PenetrationNodeBVH(bvh, node.rightChild, center, radius, outPush, didPush);
-}
 
-// ─── Static mesh registry ─────────────────────────────────────────────────────
-
-struct StaticMeshEntry {
-    int  handle = 0;
-    BVH  bvh;
-};
+    // Publish the built BVH if the mesh is still registered
+    bool installed = false;
+    UpdateMeshTable([&](StaticMeshTable& table) {
+        const int slot = FindMeshSlot(table, task.handle);
+        if (slot < 0) return;
+        InstallBvh(table.slots[slot], builtBvh);
+        installed = true;
+    });
+    if (installed)
+        std::visit([&](const auto& tree) {
+            TraceLog(LOG_INFO, "[Physics] %s mesh handle=%d tris=%zu qbvh_nodes=%zu bytes=%zu",
+                     how, task.handle, tree.TriangleCount(), tree.nodes.size(), tree.MemoryBytes());
+        }, *builtBvh);
+    const int handle = task.handle;
+    FinishBuild(task, installed, installed ? std::span<const int>(&handle, 1) : std::span<const int>());
+}
 
-static std::vector<StaticMeshEntry> g_staticMeshes;
-static int                          g_nextHandle = 1;
-static std::mutex                   g_meshMutex;
-// Background BVH build queue and worker
-struct BuildTask {
-    int handle = -1;
-    std::vector<Tri> tris;
-};
-static std::deque<BuildTask>        g_buildQueue;
-static std::mutex                   g_buildMutex;
-static std::condition_variable      g_buildCv;
-static std::thread                  g_buildWorker;
-static std::atomic<bool>            g_buildRunning{false};
-// Forward-declare worker function so InitPhysics can start the thread
-namespace Hotones { namespace Physics { void BuildWorkerThread(); } }
+// Queue `task` on the build pool; false if InitPhysics() has not run
+static bool QueueBuild(std::shared_ptr<BuildTask> task) {
+    std::lock_guard<std::mutex> lk(g_buildMutex);
+    if (!g_buildJobs) return false;
+    {
+        std::lock_guard<std::mutex> plk(g_progressMutex);
+        if (g_buildProgress.completed == g_buildProgress.queued) g_buildProgress = {};
+        ++g_buildProgress.queued;
+    }
+    Hotones::Jobs::JobSystem* pool = g_buildJobs.get();
+    // Kinematic trees are refit in place, which a cached file can't follow
+    std::string cacheDir = task->kinematic ? std::string() : g_bvhCacheDir;
+    pool->Submit([task, pool, cacheDir] { RunBuildTask(*task, cacheDir, *pool); }, &g_buildsInFlight);
+    return true;
+}
 
 namespace Hotones { namespace Physics {
 
-bool InitPhysics() {
-    if (!g_buildRunning.load()) {
+bool InitPhysics(unsigned buildThreads) {
+    std::lock_guard<std::mutex> lk(g_buildMutex);
+    if (!g_buildJobs) {
         g_buildRunning.store(true);
-        g_buildWorker = std::thread(BuildWorkerThread);
-        TraceLog(LOG_INFO, "[Physics] BVH worker thread started");
+        g_buildJobs = std::make_unique<Hotones::Jobs::JobSystem>(buildThreads);
+        TraceLog(LOG_INFO, "[Physics] BVH build pool started (%u threads)", g_buildJobs->WorkerCount());
     }
     return true;
 }
 
 void ShutdownPhysics() {
+    // Queued builds see the flag and drop out; the ones already running
+    // finish.  Waiting here also helps drain the pool.
     g_buildRunning.store(false);
-    g_buildCv.notify_all();
-    if (g_buildWorker.joinable()) g_buildWorker.join();
-    g_staticMeshes.clear();
+    std::unique_ptr<Hotones::Jobs::JobSystem> pool;
+    {
+        std::lock_guard<std::mutex> lk(g_buildMutex);
+        pool = std::move(g_buildJobs);
+    }
+    if (pool) {
+        pool->Wait(g_buildsInFlight);
+        pool.reset();
+    }
+    NotifyReadyWaiters();
+    {
+        std::lock_guard<std::mutex> lk(g_shapeMutex);
+        g_shapes.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lk(g_meshWriteMutex);
+        g_meshTable.store(std::make_shared<const StaticMeshTable>(), std::memory_order_release);
+        g_meshTableBytes.Set(0);
+    }
     TraceLog(LOG_INFO, "[Physics] Shutdown complete");
 }
 
-int RegisterStaticMeshFromModel(const Model& model, const Vector3& position) {
-    if (model.meshCount <= 0 || model.meshes == nullptr) return -1;
+void SetBVHBuildQuality(BVHBuildQuality quality) {
+    g_bvhBuildQuality.store(quality);
+}
+
+BVHBuildQuality GetBVHBuildQuality() {
+    return g_bvhBuildQuality.load();
+}
+
+void SetBVHMemoryLayout(BVHMemoryLayout layout) {
+    g_bvhMemoryLayout.store(layout);
+}
+
+BVHMemoryLayout GetBVHMemoryLayout() {
+    return g_bvhMemoryLayout.load();
+}
+
+PhysicsMemoryStats GetPhysicsMemoryStats() {
+    return TableMemoryStats(*g_meshTable.load(std::memory_order_acquire));
+}
+
+void SetBVHCacheDirectory(const std::string& dir) {
+    std::lock_guard<std::mutex> lk(g_buildMutex);
+    g_bvhCacheDir = dir;
+}
+
+std::string GetBVHCacheDirectory() {
+    std::lock_guard<std::mutex> lk(g_buildMutex);
+    return g_bvhCacheDir;
+}
+
+BVHBuildProgress GetBVHBuildProgress() {
+    std::lock_guard<std::mutex> lk(g_progressMutex);
+    return g_buildProgress;
+}
+
+// ─── Query counters ───────────────────────────────────────────────────────────
+
+enum QueryKind { QUERY_RAYCAST, QUERY_SWEEP, QUERY_RESOLVE, QUERY_OVERLAP, QUERY_SLIDE, QUERY_KIND_COUNT };
 
+// A line each, so threads querying different kinds don't share one
+struct alignas(64) QueryCounter { std::atomic<uint64_t> n{ 0 }; };
+static QueryCounter g_queryCounts[QUERY_KIND_COUNT];
+
+static void CountQueries(QueryKind kind, uint64_t n = 1) {
+    g_queryCounts[kind].n.fetch_add(n, std::memory_order_relaxed);
+}
+
+PhysicsQueryStats GetPhysicsQueryStats() {
+    auto count = [](QueryKind kind) { return g_queryCounts[kind].n.load(std::memory_order_relaxed); };
+    PhysicsQueryStats stats;
+    stats.raycasts = count(QUERY_RAYCAST);
+    stats.sweeps   = count(QUERY_SWEEP);
+    stats.resolves = count(QUERY_RESOLVE);
+    stats.overlaps = count(QUERY_OVERLAP);
+    stats.slides   = count(QUERY_SLIDE);
+    return stats;
+}
+
+}} // namespace Hotones::Physics
+
+// Every triangle of the model, offset by `position`, in mesh order.
+// model.meshes[i] gets meshLayers[i], or `layers` past the span's end.
+static std::vector<Tri> GatherTriangles(const Model& model, const Vector3& position, LayerMask layers,
+                                        std::span<const LayerMask> meshLayers = {}) {
     std::vector<Tri> tris;
+    if (model.meshCount <= 0 || model.meshes == nullptr) return tris;
     tris.reserve(4096);
 
     for (int mi = 0; mi < model.meshCount; ++mi) {
         const Mesh& m = model.meshes[mi];
         if (m.vertices == nullptr) continue;
+        const LayerMask meshMask = (size_t)mi < meshLayers.size() ? meshLayers[mi] : layers;
 
         auto addTri = [&](int i0, int i1, int i2) {
             auto vAt = [&](int idx) -> Vector3 {
@@ -432,6 +643,8 @@ int RegisterStaticMeshFromModel(const Model& model, const Vector3& position) {
             Tri t;
             t.a = vAt(i0); t.b = vAt(i1); t.c = vAt(i2);
             t.centroid = v3scale(v3add(t.a, v3add(t.b, t.c)), 1.f/3.f);
+            t.source   = static_cast<uint32_t>(tris.size());
+            t.layers   = meshMask;
             tris.push_back(t);
         };
 
@@ -444,206 +657,818 @@ int RegisterStaticMeshFromModel(const Model& model, const Vector3& position) {
                 addTri(t*3, t*3+1, t*3+2);
         }
     }
+    return tris;
+}
 
+// Claim a slot and queue the build.  Kinematic meshes start at `transform`.
+static int RegisterMesh(std::vector<Tri>&& tris, bool kinematic, const Matrix& transform,
+                        StaticMeshBuiltCallback onBuilt) {
     if (tris.empty()) return -1;
 
-    // Create a placeholder entry immediately so callers get a handle
-    StaticMeshEntry entry;
-    entry.handle = g_nextHandle++;
-    {
-        std::lock_guard<std::mutex> lk(g_meshMutex);
-        g_staticMeshes.push_back(std::move(entry));
+    // Claim a slot immediately so callers get a handle; the BVH follows later
+    int handle = -1;
+    UpdateMeshTable([&](StaticMeshTable& table) { handle = ClaimSlot(table, kinematic, transform); });
+    if (handle < 0) {
+        TraceLog(LOG_WARNING, "[Physics] Static mesh table full");
+        return -1;
     }
 
     // Queue building the BVH in the background to avoid stalls during loading
-    BuildTask task;
-    task.handle = g_nextHandle - 1;
-    task.tris = std::move(tris);
-    {
-        std::lock_guard<std::mutex> lk(g_buildMutex);
-        g_buildQueue.push_back(std::move(task));
+    const size_t triCount = tris.size();
+    auto task = std::make_shared<BuildTask>();
+    task->handle    = handle;
+    task->tris      = std::move(tris);
+    task->onBuilt   = std::move(onBuilt);
+    task->kinematic = kinematic;
+    if (!QueueBuild(std::move(task))) {
+        TraceLog(LOG_WARNING, "[Physics] InitPhysics not called; mesh handle=%d will not be built", handle);
+        return handle;
     }
-    g_buildCv.notify_one();
 
-    TraceLog(LOG_INFO, "[Physics] Queued mesh build handle=%d tris=%zu", (g_nextHandle - 1), task.tris.size());
-    return (g_nextHandle - 1);
+    TraceLog(LOG_INFO, "[Physics] Queued %s mesh build handle=%d tris=%zu",
+             kinematic ? "kinematic" : "static", handle, triCount);
+    return handle;
 }
 
-void UnregisterStaticMesh(int handle) {
-    std::lock_guard<std::mutex> lk(g_meshMutex);
-    for (auto it = g_staticMeshes.begin(); it != g_staticMeshes.end(); ++it) {
-        if (it->handle == handle) { g_staticMeshes.erase(it); return; }
+namespace Hotones { namespace Physics {
+
+int RegisterStaticMeshFromModel(const Model& model, const Vector3& position,
+                                StaticMeshBuiltCallback onBuilt, LayerMask layers) {
+    return RegisterMesh(GatherTriangles(model, position, layers), false, MatrixIdentity(), std::move(onBuilt));
+}
+
+int RegisterStaticMeshWithLayers(const Model& model, const Vector3& position,
+                                 std::span<const LayerMask> meshLayers, StaticMeshBuiltCallback onBuilt) {
+    return RegisterMesh(GatherTriangles(model, position, LAYER_DEFAULT, meshLayers), false, MatrixIdentity(),
+                        std::move(onBuilt));
+}
+
+int RegisterKinematicMesh(const Model& model, const Matrix& transform, StaticMeshBuiltCallback onBuilt,
+                          LayerMask layers) {
+    return RegisterMesh(GatherTriangles(model, { 0, 0, 0 }, layers), true, transform, std::move(onBuilt));
+}
+
+bool SetMeshTransform(int handle, const Matrix& transform) {
+    bool moved = false;
+    UpdateMeshTable([&](StaticMeshTable& table) {
+        const int slot = FindMeshSlot(table, handle);
+        if (slot < 0 || !table.slots[slot].kinematic) return;
+        SetSlotTransform(table.slots[slot], transform);
+        moved = true;
+    });
+    return moved;
+}
+
+bool RefitKinematicMesh(int handle, const Model& model) {
+    MeshTablePtr pin;
+    const StaticMeshSlot* s = FindBuiltSlot(handle, pin);
+    if (!s || !s->kinematic || s->instance) return false;
+    const QBVH* current = std::get_if<QBVH>(s->bvh.get());
+    if (!current) return false;
+
+    // Published trees are immutable: refit a copy and swap it in
+    auto refit = std::make_shared<MeshBvh>(*current);
+    QBVH& tree = std::get<QBVH>(*refit);
+    if (!tree.Refit(GatherTriangles(model, { 0, 0, 0 }, LAYER_DEFAULT))) {
+        TraceLog(LOG_WARNING, "[Physics] Refit of mesh handle=%d failed: triangle count changed", handle);
+        return false;
     }
+
+    bool installed = false;
+    UpdateMeshTable([&](StaticMeshTable& table) {
+        const int slot = FindMeshSlot(table, handle);
+        if (slot < 0 || !table.slots[slot].bvh) return;
+        StaticMeshSlot& dst = table.slots[slot];
+        dst.bvh = std::move(refit);
+        tree.Bounds(dst.localMin, dst.localMax);
+        UpdateWorldBounds(dst);
+        installed = true;
+    });
+    return installed;
 }
 
-// Background builder thread function
-void BuildWorkerThread() {
-    while (g_buildRunning.load()) {
-        BuildTask task;
-        {
-            std::unique_lock<std::mutex> lk(g_buildMutex);
-            g_buildCv.wait(lk, []{ return !g_buildQueue.empty() || !g_buildRunning.load(); });
-            if (!g_buildRunning.load() && g_buildQueue.empty()) return;
-            task = std::move(g_buildQueue.front());
-            g_buildQueue.pop_front();
+int RegisterMeshShape(const Model& model, LayerMask layers, StaticMeshBuiltCallback onBuilt) {
+    std::vector<Tri> tris = GatherTriangles(model, { 0, 0, 0 }, layers);
+    if (tris.empty()) return -1;
+    const size_t triCount = tris.size();
+
+    auto task = std::make_shared<BuildTask>();
+    task->tris    = std::move(tris);
+    task->onBuilt = std::move(onBuilt);
+    task->shape   = true;
+    {
+        std::lock_guard<std::mutex> lk(g_shapeMutex);
+        task->handle = g_nextShape++;
+        g_shapes[task->handle];
+    }
+    const int shape = task->handle;
+    if (!QueueBuild(std::move(task))) {
+        TraceLog(LOG_WARNING, "[Physics] InitPhysics not called; shape=%d will not be built", shape);
+        return shape;
+    }
+    TraceLog(LOG_INFO, "[Physics] Queued shape build shape=%d tris=%zu", shape, triCount);
+    return shape;
+}
+
+void UnregisterMeshShape(int shape) {
+    std::lock_guard<std::mutex> lk(g_shapeMutex);
+    auto it = g_shapes.find(shape);
+    if (it == g_shapes.end()) return;
+    if (it->second.building) it->second.released = true;   // erased when the build lands
+    else g_shapes.erase(it);
+}
+
+size_t CreateMeshInstances(int shape, std::span<const Matrix> transforms, std::span<int> handles) {
+    const size_t count = std::min(transforms.size(), handles.size());
+    std::lock_guard<std::mutex> lk(g_shapeMutex);
+    auto it = g_shapes.find(shape);
+    if (it == g_shapes.end() || it->second.released || count == 0) return 0;
+    MeshShape& s = it->second;
+
+    size_t created = 0;
+    UpdateMeshTable([&](StaticMeshTable& table) {
+        for (; created < count; ++created) {
+            const int handle = ClaimSlot(table, true, transforms[created]);
+            if (handle < 0) break;
+            StaticMeshSlot& slot = table.slots[FindMeshSlot(table, handle)];
+            slot.instance = true;
+            if (s.bvh) InstallBvh(slot, s.bvh);
+            else       s.waiting.push_back(handle);
+            handles[created] = handle;
         }
+    });
+    if (created < count) TraceLog(LOG_WARNING, "[Physics] Static mesh table full");
+    if (created > 0 && s.bvh) NotifyReadyWaiters();
+    return created;
+}
 
-        // Build BVH (potentially expensive) outside mesh lock
-        BVH builtBvh;
-        builtBvh.Build(std::move(task.tris));
+int CreateMeshInstance(int shape, const Matrix& transform) {
+    int handle = -1;
+    return CreateMeshInstances(shape, std::span<const Matrix>(&transform, 1), std::span<int>(&handle, 1)) ? handle
+                                                                                                           : -1;
+}
 
-        // Assign the built BVH back to the registered mesh if it still exists
-        {
-            std::lock_guard<std::mutex> lk(g_meshMutex);
-            for (auto &e : g_staticMeshes) {
-                if (e.handle == task.handle) {
-                    e.bvh = std::move(builtBvh);
-                    TraceLog(LOG_INFO, "[Physics] Built mesh handle=%d tris=%zu bvh_nodes=%zu",
-                             e.handle, e.bvh.tris.size(), e.bvh.nodes.size());
-                    break;
-                }
-            }
+void UnregisterStaticMesh(int handle) {
+    // In-flight queries keep their snapshot, so the BVH is freed once the
+    // last of them returns.
+    UpdateMeshTable([&](StaticMeshTable& table) {
+        const int slot = FindMeshSlot(table, handle);
+        if (slot < 0) return;
+        StaticMeshSlot& s = table.slots[slot];
+        s.bvh.reset();
+        s.live = false;
+        ++s.generation;
+        table.freeSlots.push_back(static_cast<uint32_t>(slot));
+    });
+    NotifyReadyWaiters();
+}
+
+bool IsMeshReady(int handle) {
+    MeshTablePtr pin;
+    return FindBuiltSlot(handle, pin) != nullptr;
+}
+
+bool WaitForMeshes(std::span<const int> handles, float timeoutSeconds) {
+    // 1 = all ready, 0 = some can never become ready, -1 = keep waiting
+    auto state = [&]() -> int {
+        const MeshTablePtr table = g_meshTable.load(std::memory_order_acquire);
+        const bool building = g_buildRunning.load();
+        int result = 1;
+        for (int handle : handles) {
+            const int slot = FindMeshSlot(*table, handle);
+            if (slot >= 0 && table->slots[slot].bvh) continue;
+            if (slot < 0 || !building) result = 0;
+            else return -1;
         }
+        return result;
+    };
+
+    std::unique_lock<std::mutex> lk(g_readyMutex);
+    if (timeoutSeconds < 0.f) {
+        g_readyCv.wait(lk, [&] { return state() >= 0; });
+    } else {
+        const auto timeout = std::chrono::duration<float>(timeoutSeconds);
+        g_readyCv.wait_for(lk, timeout, [&] { return state() >= 0; });
     }
+    return state() == 1;
+}
+
+void SetMeshReadyHook(StaticMeshReadyHook hook) {
+    std::lock_guard<std::mutex> lk(g_readyMutex);
+    g_readyHook = std::move(hook);
+}
+
+// The build pool is started by InitPhysics() and stopped by ShutdownPhysics().
+
+// Single-query bodies shared by the one-shot and batched entry points.
+// Published BVHs are immutable, so traversal needs no lock.
+template<typename Tree>
+static bool SweepOne(const Tree& bvh, const StaticMeshSlot& s, Vector3 start, Vector3 end, float radius,
+                     LayerMask mask, QueryHit& out) {
+    float bestT = FLT_MAX;
+    Vector3 bestN = { 0,1,0 };
+    SweepMesh(bvh, s, start, end, radius, bestT, bestN, mask);
+
+    out.hit = bestT <= 1.f + 1e-6f;
+    if (!out.hit) return false;
+    out.t      = bestT;
+    out.normal = bestN;
+    out.pos    = v3add(start, v3scale(v3sub(end, start), bestT));
+    return true;
 }
 
-// BVH worker is started by InitPhysics() and stopped by ShutdownPhysics().
+template<typename Tree>
+static bool RaycastOne(const Tree& bvh, const StaticMeshSlot& s, Vector3 origin, Vector3 dir, float maxDist,
+                       LayerMask mask, QueryHit& out) {
+    float   bestT = maxDist;
+    Vector3 bestN = { 0, 1, 0 };
+    RaycastMesh(bvh, s, origin, dir, bestT, bestN, mask);
+
+    out.hit = bestT < maxDist;
+    if (!out.hit) return false;
+    out.t      = bestT;
+    out.normal = bestN;
+    out.pos    = v3add(origin, v3scale(dir, bestT));
+    return true;
+}
 
 bool SweepSphereAgainstStatic(int handle,
                                const Vector3& start, const Vector3& end,
                                float radius,
-                               Vector3& hitPos, Vector3& hitNormal, float& t) {
-    // Grab a reference to the entry under lock, then release before traversal
-    const BVH* bvhPtr = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(g_meshMutex);
-        for (const auto& e : g_staticMeshes)
-            if (e.handle == handle) { bvhPtr = &e.bvh; break; }
-        if (!bvhPtr || bvhPtr->nodes.empty()) return false;
+                               Vector3& hitPos, Vector3& hitNormal, float& t, LayerMask mask) {
+    CountQueries(QUERY_SWEEP);
+    // Lock-free lookup; `pin` keeps the BVH alive until we return
+    MeshTablePtr pin;
+    const StaticMeshSlot* s = FindBuiltSlot(handle, pin);
+    if (!s) return false;
+
+    QueryHit hit;
+    if (!std::visit([&](const auto& bvh) { return SweepOne(bvh, *s, start, end, radius, mask, hit); }, *s->bvh))
+        return false;
+    t         = hit.t;
+    hitNormal = hit.normal;
+    hitPos    = hit.pos;
+    return true;
+}
+
+// New: resolve sphere penetration against a registered static mesh.
+// Pushes `center` out of all overlapping triangles. Returns true if any push occurred.
+bool ResolveSphereAgainstStatic(int handle, Vector3& center, float radius, LayerMask mask) {
+    CountQueries(QUERY_RESOLVE);
+    MeshTablePtr pin;
+    const StaticMeshSlot* s = FindBuiltSlot(handle, pin);
+    if (!s) return false;
+
+    Vector3 totalPush = {0,0,0};
+    bool    pushed    = false;
+    std::visit([&](const auto& bvh) { PenetrationMesh(bvh, *s, center, radius, totalPush, pushed, mask); },
+               *s->bvh);
+    if (pushed) center = v3add(center, totalPush);
+    return pushed;
+}
+
+bool RaycastAgainstStatic(int handle, const Vector3& origin, const Vector3& dir,
+                           float maxDist, Vector3& hitPos, Vector3& hitNormal, float& t, LayerMask mask) {
+    CountQueries(QUERY_RAYCAST);
+    MeshTablePtr pin;
+    const StaticMeshSlot* s = FindBuiltSlot(handle, pin);
+    if (!s) return false;
+
+    QueryHit hit;
+    if (!std::visit([&](const auto& bvh) { return RaycastOne(bvh, *s, origin, dir, maxDist, mask, hit); },
+                    *s->bvh))
+        return false;
+    t         = hit.t;
+    hitNormal = hit.normal;
+    hitPos    = hit.pos;
+    return true;
+}
+
+// ─── Batched queries ──────────────────────────────────────────────────────────
+
+// Below this many queries sorting costs more than the coherence it buys.
+static constexpr size_t BATCH_SORT_MIN = 32;
+// Queries per job when a batch fans out across the job system.
+static constexpr size_t BATCH_GRAIN    = 64;
+
+// Spread the low 10 bits of v so there are two zero bits between each.
+static uint32_t MortonSpread(uint32_t v) {
+    v &= 0x3FFu;
+    v = (v | (v << 16)) & 0x030000FFu;
+    v = (v | (v <<  8)) & 0x0300F00Fu;
+    v = (v | (v <<  4)) & 0x030C30C3u;
+    v = (v | (v <<  2)) & 0x09249249u;
+    return v;
+}
+
+// Visit order for a batch: queries grouped by direction octant, then by the
+// Morton code of their origin within the batch bounds.  Neighbours in this
+// order start in the same region heading the same way, so they walk mostly
+// the same nodes while those are still in cache.  originAt(i) / dirAt(i)
+// give query i's origin and direction.
+template<typename OriginAt, typename DirAt>
+static std::vector<uint32_t> CoherentOrder(size_t count, OriginAt&& originAt, DirAt&& dirAt) {
+    std::vector<uint32_t> order(count);
+    for (size_t i = 0; i < count; ++i) order[i] = static_cast<uint32_t>(i);
+    if (count < BATCH_SORT_MIN) return order;
+
+    Vector3 bmin = originAt(0), bmax = bmin;
+    for (size_t i = 1; i < count; ++i) {
+        const Vector3 o = originAt(i);
+        bmin = { fminf(bmin.x, o.x), fminf(bmin.y, o.y), fminf(bmin.z, o.z) };
+        bmax = { fmaxf(bmax.x, o.x), fmaxf(bmax.y, o.y), fmaxf(bmax.z, o.z) };
+    }
+    const Vector3 ext   = v3sub(bmax, bmin);
+    const Vector3 scale = { ext.x > 0.f ? 1023.f / ext.x : 0.f,
+                            ext.y > 0.f ? 1023.f / ext.y : 0.f,
+                            ext.z > 0.f ? 1023.f / ext.z : 0.f };
+
+    std::vector<uint64_t> keys(count);
+    for (size_t i = 0; i < count; ++i) {
+        const Vector3 o = originAt(i), d = dirAt(i);
+        const uint32_t octant = (d.x < 0.f ? 1u : 0u) | (d.y < 0.f ? 2u : 0u) | (d.z < 0.f ? 4u : 0u);
+        const uint32_t morton = MortonSpread(static_cast<uint32_t>((o.x - bmin.x) * scale.x))
+                              | MortonSpread(static_cast<uint32_t>((o.y - bmin.y) * scale.y)) << 1
+                              | MortonSpread(static_cast<uint32_t>((o.z - bmin.z) * scale.z)) << 2;
+        keys[i] = (uint64_t(octant << 30 | morton) << 32) | i;
     }
+    std::sort(keys.begin(), keys.end());
+    for (size_t i = 0; i < count; ++i) order[i] = static_cast<uint32_t>(keys[i]);
+    return order;
+}
 
-    // Safe to read without lock since meshes are immutable once registered
-    float bestT = FLT_MAX;
-    Vector3 bestN = { 0,1,0 };
-    SweepNodeBVH(*bvhPtr, 0, start, end, radius, bestT, bestN);
+// Run body(i) for every query index in `order`, optionally on the job system.
+template<typename Fn>
+static void RunBatch(const std::vector<uint32_t>& order, bool parallel, Fn&& body) {
+    HOTONES_ZONE("Physics query batch");
+    if (parallel && order.size() > BATCH_GRAIN) {
+        Jobs::JobSystem::Get().ParallelFor(order.size(), BATCH_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) body(order[i]);
+        });
+    } else {
+        for (uint32_t i : order) body(i);
+    }
+}
+
+size_t RaycastBatch(int handle, std::span<const RayQuery> rays, std::span<QueryHit> hits, bool parallel) {
+    const size_t count = std::min(rays.size(), hits.size());
+    CountQueries(QUERY_RAYCAST, count);
+    for (size_t i = 0; i < count; ++i) hits[i].hit = false;
+
+    MeshTablePtr pin;
+    const StaticMeshSlot* s = FindBuiltSlot(handle, pin);
+    if (!s || count == 0) return 0;
+
+    const auto order = CoherentOrder(count, [&](size_t i) { return rays[i].origin; },
+                                            [&](size_t i) { return rays[i].dir; });
+    std::visit([&](const auto& bvh) {
+        RunBatch(order, parallel, [&](size_t i) {
+            RaycastOne(bvh, *s, rays[i].origin, rays[i].dir, rays[i].maxDist, rays[i].mask, hits[i]);
+        });
+    }, *s->bvh);
+
+    size_t hitCount = 0;
+    for (size_t i = 0; i < count; ++i) hitCount += hits[i].hit;
+    return hitCount;
+}
 
-    if (bestT > 1.f + 1e-6f) return false;
+size_t SweepBatch(int handle, std::span<const SweepQuery> sweeps, std::span<QueryHit> hits, bool parallel) {
+    const size_t count = std::min(sweeps.size(), hits.size());
+    CountQueries(QUERY_SWEEP, count);
+    for (size_t i = 0; i < count; ++i) hits[i].hit = false;
+
+    MeshTablePtr pin;
+    const StaticMeshSlot* s = FindBuiltSlot(handle, pin);
+    if (!s || count == 0) return 0;
+
+    const auto order = CoherentOrder(count, [&](size_t i) { return sweeps[i].start; },
+                                            [&](size_t i) { return v3sub(sweeps[i].end, sweeps[i].start); });
+    std::visit([&](const auto& bvh) {
+        RunBatch(order, parallel, [&](size_t i) {
+            SweepOne(bvh, *s, sweeps[i].start, sweeps[i].end, sweeps[i].radius, sweeps[i].mask, hits[i]);
+        });
+    }, *s->bvh);
+
+    size_t hitCount = 0;
+    for (size_t i = 0; i < count; ++i) hitCount += hits[i].hit;
+    return hitCount;
+}
+
+// ─── World queries ────────────────────────────────────────────────────────────
+
+// Front-to-back walk of the TLAS along ro + t·rd with boxes grown by
+// `inflate`; mesh(slot) runs for each reached mesh with a layer in mask and
+// may lower bestT.
+template<typename MeshFn>
+static void TraverseTlas(const StaticMeshTable& table, Vector3 ro, Vector3 rd, float inflate,
+                         LayerMask mask, float& bestT, MeshFn&& mesh) {
+    const MeshTlas& tlas = table.tlas;
+    if (tlas.nodes.empty()) return;
+    const Vector3 invD = { 1.f / rd.x, 1.f / rd.y, 1.f / rd.z };
+    const Vector3 pad  = { inflate, inflate, inflate };
+    auto entry = [&](const TlasNode& n) {
+        if (!(n.layers & mask)) return FLT_MAX;
+        return RayAabbEntry(ro, invD, v3sub(n.bmin, pad), v3add(n.bmax, pad), bestT);
+    };
+
+    struct Pending { int node; float t; };
+    Pending stack[64];
+    int     top = 0;
+    const float rootT = entry(tlas.nodes[0]);
+    if (rootT == FLT_MAX) return;
+    stack[top++] = { 0, rootT };
+
+    while (top > 0) {
+        const Pending cur = stack[--top];
+        if (cur.t > bestT) continue;
+        const TlasNode& node = tlas.nodes[cur.node];
+        if (node.rightChild == -1) {
+            for (int i = node.first; i < node.first + node.count; ++i)
+                if (table.slots[tlas.slots[i]].layers & mask) mesh(tlas.slots[i]);
+            continue;
+        }
+        int   nearIdx = cur.node + 1,              farIdx = node.rightChild;
+        float nearT   = entry(tlas.nodes[nearIdx]), farT  = entry(tlas.nodes[farIdx]);
+        if (farT < nearT) { std::swap(nearIdx, farIdx); std::swap(nearT, farT); }
+        if (farT  != FLT_MAX) stack[top++] = { farIdx,  farT  };
+        if (nearT != FLT_MAX) stack[top++] = { nearIdx, nearT };
+    }
+}
+
+bool RaycastWorld(const Vector3& origin, const Vector3& dir, float maxDist,
+                  Vector3& hitPos, Vector3& hitNormal, float& t, int* hitHandle, LayerMask mask) {
+    CountQueries(QUERY_RAYCAST);
+    const MeshTablePtr table = g_meshTable.load(std::memory_order_acquire);
+
+    float   bestT    = maxDist;
+    Vector3 bestN    = { 0, 1, 0 };
+    int     bestSlot = -1;
+    TraverseTlas(*table, origin, dir, 0.f, mask, bestT, [&](uint32_t slot) {
+        const float before = bestT;
+        const StaticMeshSlot& s = table->slots[slot];
+        std::visit([&](const auto& bvh) { RaycastMesh(bvh, s, origin, dir, bestT, bestN, mask); }, *s.bvh);
+        if (bestT < before) bestSlot = (int)slot;
+    });
+    if (bestSlot < 0) return false;
+
+    t         = bestT;
+    hitNormal = bestN;
+    hitPos    = v3add(origin, v3scale(dir, bestT));
+    if (hitHandle) *hitHandle = MakeMeshHandle((uint32_t)bestSlot, table->slots[bestSlot].generation);
+    return true;
+}
+
+bool SweepSphereWorld(const Vector3& start, const Vector3& end, float radius,
+                      Vector3& hitPos, Vector3& hitNormal, float& t, int* hitHandle, LayerMask mask) {
+    CountQueries(QUERY_SWEEP);
+    const MeshTablePtr table = g_meshTable.load(std::memory_order_acquire);
+
+    float   bestT    = 1.f + 1e-6f;
+    Vector3 bestN    = { 0, 1, 0 };
+    int     bestSlot = -1;
+    TraverseTlas(*table, start, v3sub(end, start), radius, mask, bestT, [&](uint32_t slot) {
+        float meshT = bestT;
+        const StaticMeshSlot& s = table->slots[slot];
+        std::visit([&](const auto& bvh) { SweepMesh(bvh, s, start, end, radius, meshT, bestN, mask); }, *s.bvh);
+        if (meshT < bestT) { bestT = meshT; bestSlot = (int)slot; }
+    });
+    if (bestSlot < 0) return false;
 
     t         = bestT;
     hitNormal = bestN;
     hitPos    = v3add(start, v3scale(v3sub(end, start), bestT));
+    if (hitHandle) *hitHandle = MakeMeshHandle((uint32_t)bestSlot, table->slots[bestSlot].generation);
     return true;
 }
 
-// New: resolve sphere penetration against a registered static mesh.
-// Pushes `center` out of all overlapping triangles. Returns true if any push occurred.
-bool ResolveSphereAgainstStatic(int handle, Vector3& center, float radius) {
-    const BVH* bvhPtr = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(g_meshMutex);
-        for (const auto& e : g_staticMeshes)
-            if (e.handle == handle) { bvhPtr = &e.bvh; break; }
-        if (!bvhPtr || bvhPtr->nodes.empty()) return false;
+// mesh(slot) for every built mesh whose bounds overlap [qmin, qmax] and
+// whose layers meet mask.
+template<typename MeshFn>
+static void ForEachMeshInBox(const StaticMeshTable& table, Vector3 qmin, Vector3 qmax, LayerMask mask,
+                             MeshFn&& mesh) {
+    const MeshTlas& tlas = table.tlas;
+    if (tlas.nodes.empty()) return;
+
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const TlasNode& node = tlas.nodes[stack[--top]];
+        if (!(node.layers & mask)) continue;
+        if (qmax.x < node.bmin.x || qmin.x > node.bmax.x ||
+            qmax.y < node.bmin.y || qmin.y > node.bmax.y ||
+            qmax.z < node.bmin.z || qmin.z > node.bmax.z) continue;
+        if (node.rightChild != -1) {
+            stack[top++] = node.rightChild;
+            stack[top++] = static_cast<int>(&node - tlas.nodes.data()) + 1;
+            continue;
+        }
+        for (int i = node.first; i < node.first + node.count; ++i)
+            if (table.slots[tlas.slots[i]].layers & mask) mesh(tlas.slots[i]);
     }
+}
 
-    Vector3 totalPush = {0,0,0};
+bool ResolveSphereWorld(Vector3& center, float radius, LayerMask mask) {
+    CountQueries(QUERY_RESOLVE);
+    const MeshTablePtr table = g_meshTable.load(std::memory_order_acquire);
+
+    // Every mesh sees the same centre, as if each were resolved alone
+    Vector3 totalPush = { 0, 0, 0 };
     bool    pushed    = false;
-    PenetrationNodeBVH(*bvhPtr, 0, center, radius, totalPush, pushed);
+    ForEachMeshInBox(*table, v3sub(center, { radius, radius, radius }), v3add(center, { radius, radius, radius }),
+                     mask, [&](uint32_t slot) {
+        const StaticMeshSlot& s = table->slots[slot];
+        std::visit([&](const auto& bvh) { PenetrationMesh(bvh, s, center, radius, totalPush, pushed, mask); },
+                   *s.bvh);
+    });
     if (pushed) center = v3add(center, totalPush);
     return pushed;
 }
 
-// ─── Raycasting ───────────────────────────────────────────────────────────────
+// ─── Overlap queries ──────────────────────────────────────────────────────────
+
+// Every triangle of every mesh in [qmin, qmax] (world space) that
+// touches(a, b, c) accepts goes into out.  A kinematic mesh is walked with
+// the query box moved into its model space and its triangles moved back
+// out, so touches() always sees world space.  Returns the full count.
+template<typename TouchFn>
+static size_t OverlapWorld(Vector3 qmin, Vector3 qmax, LayerMask mask, std::span<OverlapHit> out,
+                           TouchFn&& touches) {
+    CountQueries(QUERY_OVERLAP);
+    const MeshTablePtr table = g_meshTable.load(std::memory_order_acquire);
+
+    size_t found = 0;
+    ForEachMeshInBox(*table, qmin, qmax, mask, [&](uint32_t slot) {
+        const StaticMeshSlot& s = table->slots[slot];
+        const int handle = MakeMeshHandle(slot, s.generation);
+        Vector3 lmin = qmin, lmax = qmax;
+        if (s.kinematic) TransformBounds(s.toLocal, qmin, qmax, lmin, lmax);
+        std::visit([&](const auto& bvh) {
+            GatherNodeBVH(bvh, lmin, lmax, mask, [&](uint32_t id, Vector3 a, Vector3 b, Vector3 c) {
+                if (s.kinematic) {
+                    a = Vector3Transform(a, s.toWorld);
+                    b = Vector3Transform(b, s.toWorld);
+                    c = Vector3Transform(c, s.toWorld);
+                }
+                if (!touches(a, b, c)) return;
+                if (found < out.size()) out[found] = { handle, id };
+                ++found;
+            });
+        }, *s.bvh);
+    });
+    return found;
+}
 
-// Slab-based ray vs AABB. Returns true if the ray [0, tMax] hits the box.
-static bool RayAabb(Vector3 ro, Vector3 rd, Vector3 bmin, Vector3 bmax, float tMax) {
-    float tEnter = 0.f;
-    for (int i = 0; i < 3; ++i) {
-        float o  = (&ro.x)[i];
-        float d  = (&rd.x)[i];
-        float mn = (&bmin.x)[i];
-        float mx = (&bmax.x)[i];
-        if (fabsf(d) < 1e-10f) {
-            if (o < mn || o > mx) return false;
-        } else {
-            float t1 = (mn - o) / d;
-            float t2 = (mx - o) / d;
-            if (t1 > t2) { float tmp = t1; t1 = t2; t2 = tmp; }
-            tEnter = fmaxf(tEnter, t1);
-            tMax   = fminf(tMax,   t2);
-            if (tEnter > tMax) return false;
-        }
+size_t OverlapSphere(const Vector3& center, float radius, std::span<OverlapHit> out, LayerMask mask) {
+    const Vector3 r = { radius, radius, radius };
+    return OverlapWorld(v3sub(center, r), v3add(center, r), mask, out, [&](Vector3 a, Vector3 b, Vector3 c) {
+        const Vector3 diff = v3sub(center, ClosestPtTriangle(center, a, b, c));
+        return v3dot(diff, diff) <= radius * radius;
+    });
+}
+
+size_t OverlapAABB(const Vector3& bmin, const Vector3& bmax, std::span<OverlapHit> out, LayerMask mask) {
+    const Vector3 center = v3scale(v3add(bmin, bmax), 0.5f);
+    const Vector3 half   = v3scale(v3sub(bmax, bmin), 0.5f);
+    return OverlapWorld(bmin, bmax, mask, out, [&](Vector3 a, Vector3 b, Vector3 c) {
+        return TriangleAabbOverlap(a, b, c, center, half);
+    });
+}
+
+size_t OverlapCapsule(const Vector3& a, const Vector3& b, float radius, std::span<OverlapHit> out,
+                      LayerMask mask) {
+    const Vector3 r    = { radius, radius, radius };
+    const Vector3 qmin = v3sub({ fminf(a.x, b.x), fminf(a.y, b.y), fminf(a.z, b.z) }, r);
+    const Vector3 qmax = v3add({ fmaxf(a.x, b.x), fmaxf(a.y, b.y), fmaxf(a.z, b.z) }, r);
+    return OverlapWorld(qmin, qmax, mask, out, [&](Vector3 ta, Vector3 tb, Vector3 tc) {
+        return SegmentTriangleDist2(a, b, ta, tb, tc) <= radius * radius;
+    });
+}
+
+bool GetMeshTriangle(int handle, uint32_t tri, Vector3& a, Vector3& b, Vector3& c) {
+    MeshTablePtr pin;
+    const StaticMeshSlot* s = FindBuiltSlot(handle, pin);
+    if (!s) return false;
+    if (!std::visit([&](const auto& bvh) { return TriangleById(bvh, tri, a, b, c); }, *s->bvh)) return false;
+    if (s->kinematic) {
+        a = Vector3Transform(a, s->toWorld);
+        b = Vector3Transform(b, s->toWorld);
+        c = Vector3Transform(c, s->toWorld);
     }
     return true;
 }
 
-// Möller-Trumbore ray-vs-triangle. Returns t > 0 on hit, FLT_MAX otherwise.
-// Fills outNormal with the face normal flipped toward the ray origin.
-static float RayTriangleMT(Vector3 ro, Vector3 rd,
-                             Vector3 ta, Vector3 tb, Vector3 tc,
-                             Vector3& outNormal) {
-    const float EPS = 1e-8f;
-    Vector3 e1  = v3sub(tb, ta);
-    Vector3 e2  = v3sub(tc, ta);
-    Vector3 h   = v3cross(rd, e2);
-    float   a   = v3dot(e1, h);
-    if (fabsf(a) < EPS) return FLT_MAX;   // Ray parallel to triangle
-    float   f   = 1.f / a;
-    Vector3 s   = v3sub(ro, ta);
-    float   u   = f * v3dot(s, h);
-    if (u < 0.f || u > 1.f) return FLT_MAX;
-    Vector3 q   = v3cross(s, e1);
-    float   v   = f * v3dot(rd, q);
-    if (v < 0.f || u + v > 1.f) return FLT_MAX;
-    float   t   = f * v3dot(e2, q);
-    if (t < 1e-6f) return FLT_MAX;        // Behind ray origin
-    Vector3 n = v3norm(v3cross(e1, e2));
-    // Flip so the normal faces the incoming ray
-    if (v3dot(n, rd) > 0.f) n = v3scale(n, -1.f);
-    outNormal = n;
-    return t;
-}
-
-// BVH traversal for raycasting — records the nearest hit.
-static void RaycastNodeBVH(const BVH& bvh, int nodeIdx,
-                             Vector3 ro, Vector3 rd, float& bestT, Vector3& bestN) {
-    if (nodeIdx < 0 || nodeIdx >= (int)bvh.nodes.size()) return;
-    const BVHNode& node = bvh.nodes[nodeIdx];
-    if (!RayAabb(ro, rd, node.bmin, node.bmax, bestT)) return;
-    if (node.rightChild == -1) {
-        // Leaf — test each triangle
-        for (int i = node.triStart; i < node.triStart + node.triCount; ++i) {
-            const Tri& tri = bvh.tris[i];
-            Vector3 n;
-            float t = RayTriangleMT(ro, rd, tri.a, tri.b, tri.c, n);
-            if (t < bestT) { bestT = t; bestN = n; }
-        }
-        return;
+size_t GatherStaticTriangles(std::vector<Vector3>& out, LayerMask mask) {
+    const MeshTablePtr pin = g_meshTable.load(std::memory_order_acquire);
+    const size_t before = out.size();
+    const Vector3 lo = { -FLT_MAX, -FLT_MAX, -FLT_MAX }, hi = { FLT_MAX, FLT_MAX, FLT_MAX };
+    for (const StaticMeshSlot& s : pin->slots) {
+        if (!s.live || !s.bvh || (s.kinematic && !s.instance) || !(s.layers & mask)) continue;
+        std::visit([&](const auto& bvh) {
+            GatherNodeBVH(bvh, lo, hi, mask, [&](uint32_t, Vector3 a, Vector3 b, Vector3 c) {
+                if (s.instance) {
+                    a = Vector3Transform(a, s.toWorld);
+                    b = Vector3Transform(b, s.toWorld);
+                    c = Vector3Transform(c, s.toWorld);
+                }
+                out.push_back(a);
+                out.push_back(b);
+                out.push_back(c);
+            });
+        }, *s.bvh);
     }
-    RaycastNodeBVH(bvh, nodeIdx + 1,       ro, rd, bestT, bestN);
-    RaycastNodeBVH(bvh, node.rightChild,   ro, rd, bestT, bestN);
+    return (out.size() - before) / 3;
 }
 
-bool RaycastAgainstStatic(int handle, const Vector3& origin, const Vector3& dir,
-                           float maxDist, Vector3& hitPos, Vector3& hitNormal, float& t) {
-    const BVH* bvhPtr = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(g_meshMutex);
-        for (const auto& e : g_staticMeshes)
-            if (e.handle == handle) { bvhPtr = &e.bvh; break; }
-        if (!bvhPtr || bvhPtr->nodes.empty()) return false;
+// ─── Collide and slide ────────────────────────────────────────────────────────
+
+// Past this many gathered triangles the linear scans cost more than tree
+// walks, and the slide falls back to one query per iteration.
+static constexpr size_t SLIDE_MAX_CANDIDATES = 256;
+
+// The triangles one slide can reach, in world space, packed four to a
+// TriPacket so the scans reuse the wide prefilters of the tree kernels.
+struct SlideSet {
+    std::vector<TriPacket> packets;
+    size_t                 count    = 0;
+    bool                   overflow = false;
+
+    void Clear() { packets.clear(); count = 0; overflow = false; }
+
+    void Add(Vector3 a, Vector3 b, Vector3 c) {
+        if (count >= SLIDE_MAX_CANDIDATES) { overflow = true; return; }
+        const int lane = (int)(count++ % 4);
+        if (lane == 0) packets.emplace_back();
+        TriPacket& p = packets.back();
+        // Fill the lanes past this one too, so they repeat a real triangle
+        for (int k = lane; k < 4; ++k) {
+            p.ax[k] = a.x; p.ay[k] = a.y; p.az[k] = a.z;
+            p.bx[k] = b.x; p.by[k] = b.y; p.bz[k] = b.z;
+            p.cx[k] = c.x; p.cy[k] = c.y; p.cz[k] = c.z;
+        }
+        p.count = lane + 1;
     }
 
-    float   bestT = maxDist;
-    Vector3 bestN = { 0, 1, 0 };
-    RaycastNodeBVH(*bvhPtr, 0, origin, dir, bestT, bestN);
+    // Gather slot's triangles within `reach` of center.  Kinematic meshes
+    // are gathered in model space and moved out to world space.
+    void Gather(const StaticMeshSlot& s, Vector3 center, float reach, LayerMask mask) {
+        const Vector3 c = s.kinematic ? Vector3Transform(center, s.toLocal) : center;
+        const float   r = s.kinematic ? reach / s.scale : reach;
+        std::visit([&](const auto& bvh) {
+            GatherNodeBVH(bvh, v3sub(c, { r, r, r }), v3add(c, { r, r, r }), mask,
+                          [&](uint32_t, Vector3 a, Vector3 b, Vector3 cc) {
+                if (s.kinematic) {
+                    a  = Vector3Transform(a,  s.toWorld);
+                    b  = Vector3Transform(b,  s.toWorld);
+                    cc = Vector3Transform(cc, s.toWorld);
+                }
+                Add(a, b, cc);
+            });
+        }, *s.bvh);
+    }
 
-    if (bestT >= maxDist) return false;
+    // Same contract and per-triangle tests as SweepSphereAgainstStatic.
+    bool Sweep(Vector3 start, Vector3 end, float radius, float& t, Vector3& n) const {
+        const float   slack = radius * QBVH_PREFILTER_SLACK;
+        const Vector3 pad   = { slack, slack, slack };
+        const Vector3 smin  = v3sub({ fminf(start.x, end.x), fminf(start.y, end.y), fminf(start.z, end.z) }, pad);
+        const Vector3 smax  = v3add({ fmaxf(start.x, end.x), fmaxf(start.y, end.y), fmaxf(start.z, end.z) }, pad);
+        float bestT = FLT_MAX;
+        for (const TriPacket& pk : packets) {
+            const Packet4 p(pk);
+            int lanes = PacketLanes(pk) & TriBoundsOverlap4(p, smin, smax) & PlaneWithin4(p, start, end, slack);
+            for (; lanes; lanes &= lanes - 1) {
+                const int i = std::countr_zero(static_cast<unsigned>(lanes));
+                Vector3 tn;
+                const float tt = SweepSphereTriangle(start, end, radius, pk.A(i), pk.B(i), pk.C(i), tn);
+                if (tt <= 1.f && tt < bestT) { bestT = tt; n = tn; }
+            }
+        }
+        if (bestT == FLT_MAX) return false;
+        t = bestT;
+        return true;
+    }
 
-    t         = bestT;
-    hitNormal = bestN;
-    hitPos    = v3add(origin, v3scale(dir, bestT));
-    return true;
+    // Same contract and per-triangle push as ResolveSphereAgainstStatic.
+    bool Resolve(Vector3& center, float radius) const {
+        const float   slack = radius * QBVH_PREFILTER_SLACK;
+        const Vector3 qmin  = { center.x - slack, center.y - slack, center.z - slack };
+        const Vector3 qmax  = { center.x + slack, center.y + slack, center.z + slack };
+        Vector3 totalPush = { 0, 0, 0 };
+        bool    pushed    = false;
+        for (const TriPacket& pk : packets) {
+            const Packet4 p(pk);
+            int lanes = PacketLanes(pk) & TriBoundsOverlap4(p, qmin, qmax) & PlaneWithin4(p, center, center, slack);
+            for (; lanes; lanes &= lanes - 1) {
+                const int     i     = std::countr_zero(static_cast<unsigned>(lanes));
+                const Vector3 a     = pk.A(i), b = pk.B(i), c = pk.C(i);
+                const Vector3 diff  = v3sub(center, ClosestPtTriangle(center, a, b, c));
+                const float   dist2 = v3dot(diff, diff);
+                if (dist2 >= radius * radius) continue;
+                const float dist = sqrtf(dist2);
+                // Center on the triangle: push out along the face normal
+                const Vector3 n = dist > 1e-6f ? v3scale(diff, 1.f / dist) : v3norm(v3cross(v3sub(b, a), v3sub(c, a)));
+                totalPush = v3add(totalPush, v3scale(n, radius - dist));
+                pushed    = true;
+            }
+        }
+        if (pushed) center = v3add(center, totalPush);
+        return pushed;
+    }
+};
+
+// Reused per thread, so a character moving every frame allocates nothing.
+static thread_local SlideSet t_slideSet;
+
+// The sliding path stays within |motion| of start, plus a skin per contact.
+static float SlideReach(Vector3 motion, float radius, const SlideParams& p) {
+    return (v3len(motion) + radius + (float)(p.maxIters + 1) * p.skin) * 1.001f + 1e-4f;
 }
 
-}} // namespace Hotones::Physics
+// The slide itself over sweep(from, to, t, n) / resolve(center) queries.
+template<typename SweepFn, typename ResolveFn>
+static SlideResult RunSlide(Vector3 start, Vector3 motion, const SlideParams& p, Vector3* velocity,
+                            SweepFn&& sweep, ResolveFn&& resolve) {
+    SlideResult r;
+    Vector3 pos  = start;
+    Vector3 rest = motion;
+    for (int iter = 0; iter < p.maxIters && v3dot(rest, rest) > p.skin * p.skin; ++iter) {
+        const Vector3 target = v3add(pos, rest);
+        float   t;
+        Vector3 n;
+        if (!sweep(pos, target, t, n)) { pos = target; break; }
+
+        ++r.contacts;
+        if (n.y > p.groundMinY) { r.grounded = true; r.groundNormal = n; }
+        pos = v3add(v3add(pos, v3scale(rest, t)), v3scale(n, p.skin));
+        const Vector3 left = v3scale(rest, 1.f - t);
+        rest = v3sub(left, v3scale(n, v3dot(left, n)));
+        if (velocity) {
+            const float into = v3dot(*velocity, n);
+            if (into < 0.f) *velocity = v3sub(*velocity, v3scale(n, into));
+        }
+    }
+    // Motion still left after maxIters contacts is dropped
+
+    if (p.resolve) {
+        const Vector3 before = pos;
+        r.pushed = resolve(pos);
+        if (r.pushed) {
+            const Vector3 n = v3norm(v3sub(pos, before));
+            if (n.y > p.groundMinY) { r.grounded = true; r.groundNormal = n; }
+        }
+    }
+    r.position = pos;
+    return r;
+}
+
+SlideResult SlideSphereAgainstStatic(int handle, const Vector3& start, const Vector3& motion, float radius,
+                                     const SlideParams& params, Vector3* velocity) {
+    CountQueries(QUERY_SLIDE);
+    SlideSet& set = t_slideSet;
+    set.Clear();
+    {
+        MeshTablePtr pin;
+        const StaticMeshSlot* s = FindBuiltSlot(handle, pin);
+        if (s) set.Gather(*s, start, SlideReach(motion, radius, params), params.mask);
+    }
+    if (set.overflow) {
+        return RunSlide(start, motion, params, velocity,
+            [&](Vector3 from, Vector3 to, float& t, Vector3& n) {
+                Vector3 pos;
+                return SweepSphereAgainstStatic(handle, from, to, radius, pos, n, t, params.mask);
+            },
+            [&](Vector3& center) { return ResolveSphereAgainstStatic(handle, center, radius, params.mask); });
+    }
+    return RunSlide(start, motion, params, velocity,
+        [&](Vector3 from, Vector3 to, float& t, Vector3& n) { return set.Sweep(from, to, radius, t, n); },
+        [&](Vector3& center) { return set.Resolve(center, radius); });
+}
+
+SlideResult SlideSphereWorld(const Vector3& start, const Vector3& motion, float radius,
+                             const SlideParams& params, Vector3* velocity) {
+    CountQueries(QUERY_SLIDE);
+    SlideSet& set = t_slideSet;
+    set.Clear();
+    {
+        const MeshTablePtr table = g_meshTable.load(std::memory_order_acquire);
+        const float reach = SlideReach(motion, radius, params);
+        ForEachMeshInBox(*table, v3sub(start, { reach, reach, reach }), v3add(start, { reach, reach, reach }),
+                         params.mask, [&](uint32_t slot) {
+            if (!set.overflow) set.Gather(table->slots[slot], start, reach, params.mask);
+        });
+    }
+    if (set.overflow) {
+        return RunSlide(start, motion, params, velocity,
+            [&](Vector3 from, Vector3 to, float& t, Vector3& n) {
+                Vector3 pos;
+                return SweepSphereWorld(from, to, radius, pos, n, t, nullptr, params.mask);
+            },
+            [&](Vector3& center) { return ResolveSphereWorld(center, radius, params.mask); });
+    }
+    return RunSlide(start, motion, params, velocity,
+        [&](Vector3 from, Vector3 to, float& t, Vector3& n) { return set.Sweep(from, to, radius, t, n); },
+        [&](Vector3& center) { return set.Resolve(center, radius); });
+}
+
+}} // namespace Hotones::Physics
\ No newline at end of file
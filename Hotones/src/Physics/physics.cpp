@@ -1,5 +1,10 @@
 #include <Physics/physics.h>
+#include <Jobs/JobSystem.hpp>
+#include <Memory/FrameArena.hpp>
+#include <Profile/Profiler.hpp>
+#include <algorithm>
 #include <iostream>
+#include <numeric>
 
 Vector3 Body::GetCenterOfMassWorldSpace() const
 {
@@ -37,6 +42,15 @@ void Body::ApplyLinearImpulse(const Vector3 &impulse)
   linearVelocity = Vector3Add(linearVelocity, Vector3Scale(impulse, invertedMass));
 }
 
+void Body::GetSweptBounds(float deltaTime, Vector3 &boundsMin, Vector3 &boundsMax) const
+{
+  Vector3 endMin, endMax;
+  shape->GetBounds(position, rotation, boundsMin, boundsMax);
+  shape->GetBounds(Vector3Add(position, Vector3Scale(linearVelocity, deltaTime)), rotation, endMin, endMax);
+  boundsMin = Vector3Min(boundsMin, endMin);
+  boundsMax = Vector3Max(boundsMax, endMax);
+}
+
 // Body::~Body() { delete shape; }
 
 void Scene::Initialize()
@@ -59,13 +73,185 @@ void Scene::Initialize()
   bodies.push_back(body);
 }
 
-void Scene::Update(const float deltaTime)
+void Broadphase::Reset(const std::vector<int> &members)
+{
+  entries.resize(members.size());
+  for (size_t i = 0; i < members.size(); i++)
+    entries[i].body = members[i];
+}
+
+void Broadphase::FindPairs(const std::vector<Body> &bodies, float deltaTime, std::vector<BodyPair> &pairs)
 {
-  // Substepped update loop for continuous collision detection.
+  for (Entry &entry : entries)
+    bodies[entry.body].GetSweptBounds(deltaTime, entry.bounds.min, entry.bounds.max);
+  Sweep(bodies, pairs);
+}
+
+void Broadphase::FindOverlaps(const std::vector<Body> &bodies, const std::vector<AABB> &bounds,
+                              std::vector<BodyPair> &pairs)
+{
+  for (Entry &entry : entries)
+    entry.bounds = bounds[entry.body];
+  Sweep(bodies, pairs);
+}
+
+void Broadphase::Sweep(const std::vector<Body> &bodies, std::vector<BodyPair> &pairs)
+{
+  const int count = (int)entries.size();
+  // Slack for rounding between the box test and Intersect's distance test
+  const float margin = 1e-4f;
+
+  // Insertion sort: almost no work when the order from last time still holds
+  for (int i = 1; i < count; i++)
+  {
+    const Entry entry = entries[i];
+    int j = i - 1;
+    while (j >= 0 && entries[j].bounds.min.x > entry.bounds.min.x)
+    {
+      entries[j + 1] = entries[j];
+      j--;
+    }
+    entries[j + 1] = entry;
+  }
+
+  pairs.clear();
+  for (int i = 0; i < count; i++)
+  {
+    const Entry &entryA = entries[i];
+    const AABB &boundsA = entryA.bounds;
+    for (int j = i + 1; j < count; j++)
+    {
+      const Entry &entryB = entries[j];
+      const AABB &boundsB = entryB.bounds;
+      if (boundsB.min.x > boundsA.max.x + 2.0f * margin)
+        break; // everything after starts further along x
+
+      if (boundsB.min.y > boundsA.max.y + 2.0f * margin || boundsB.max.y < boundsA.min.y - 2.0f * margin ||
+          boundsB.min.z > boundsA.max.z + 2.0f * margin || boundsB.max.z < boundsA.min.z - 2.0f * margin)
+        continue;
+
+      const int a = entryA.body, b = entryB.body;
+      if (bodies[a].invertedMass == 0.0f && bodies[b].invertedMass == 0.0f)
+        continue;
+
+      pairs.push_back(a < b ? BodyPair{a, b} : BodyPair{b, a});
+    }
+  }
+
+  // Same visiting order as a plain i < j loop, so ties between equal TOIs
+  // resolve the same way regardless of how the sweep found them
+  std::sort(pairs.begin(), pairs.end(), [](const BodyPair &l, const BodyPair &r)
+            { return l.a != r.a ? l.a < r.a : l.b < r.b; });
+}
+
+void Scene::UpdateBroadphase(const float deltaTime)
+{
+  // Bodies added or removed: start over from index order
+  if (broadphase.MemberCount() != (int)bodies.size())
+  {
+    std::vector<int> all(bodies.size());
+    std::iota(all.begin(), all.end(), 0);
+    broadphase.Reset(all);
+  }
+  broadphase.FindPairs(bodies, deltaTime, candidatePairs);
+}
+
+static int FindIslandRoot(std::vector<int> &parent, int body)
+{
+  while (parent[body] != body)
+  {
+    parent[body] = parent[parent[body]]; // path halving
+    body = parent[body];
+  }
+  return body;
+}
+
+static bool IsFixed(const Body &body)
+{
+  return body.invertedMass == 0.0f && body.linearVelocity.x == 0.0f &&
+         body.linearVelocity.y == 0.0f && body.linearVelocity.z == 0.0f;
+}
+
+void Scene::BuildIslands(const float deltaTime)
+{
+  const int count = (int)bodies.size();
+  UpdateBroadphase(deltaTime);
+
+  islandParent.resize(count);
+  std::iota(islandParent.begin(), islandParent.end(), 0);
+  for (const BodyPair &pair : candidatePairs)
+  {
+    // Fixed bodies never change, so touching one joins nothing
+    if (IsFixed(bodies[pair.a]) || IsFixed(bodies[pair.b]))
+      continue;
+    islandParent[FindIslandRoot(islandParent, pair.a)] = FindIslandRoot(islandParent, pair.b);
+  }
+
+  islands.clear();
+  fixedBodies.clear();
+  std::vector<int> islandOfRoot(count, -1);
+  for (int i = 0; i < count; i++)
+  {
+    if (IsFixed(bodies[i]))
+    {
+      fixedBodies.push_back(i);
+      continue;
+    }
+    const int root = FindIslandRoot(islandParent, i);
+    if (islandOfRoot[root] < 0)
+    {
+      islandOfRoot[root] = (int)islands.size();
+      islands.emplace_back();
+    }
+    islands[islandOfRoot[root]].members.push_back(i);
+  }
+
+  // Largest first, so the big piles start while the small ones fill in
+  std::stable_sort(islands.begin(), islands.end(), [](const Island &l, const Island &r)
+                   { return l.members.size() > r.members.size(); });
+}
+
+void Scene::SolveIsland(const Island &island, const float deltaTime)
+{
+  // Substepped update loop for continuous collision detection, over this
+  // island's bodies plus the shared fixed ones.
   float remainingTime = deltaTime;
   const float eps = 1e-8f;
   const float minNudge = 1e-4f; // small advance to escape persistent overlap
 
+  std::vector<int> candidates = island.members;
+  candidates.insert(candidates.end(), fixedBodies.begin(), fixedBodies.end());
+  Broadphase local;
+  local.Reset(candidates);
+  std::vector<BodyPair> pairs;
+
+  auto recordTravel = [&](int index)
+  {
+    const Body &body = bodies[index];
+    Vector3 boundsMin, boundsMax;
+    body.shape->GetBounds(body.position, body.rotation, boundsMin, boundsMax);
+    travelBounds[index].min = Vector3Min(travelBounds[index].min, boundsMin);
+    travelBounds[index].max = Vector3Max(travelBounds[index].max, boundsMax);
+  };
+
+  // Apply gravity impulse for `step` and integrate positions
+  auto advance = [&](float step)
+  {
+    for (int index : island.members)
+    {
+      Body &body = bodies[index];
+      if (body.invertedMass != 0.0f)
+      {
+        float mass = 1.0f / body.invertedMass;
+        Vector3 impulseGravity = Vector3Scale(gravity, mass * step);
+        body.ApplyLinearImpulse(impulseGravity);
+      }
+      Vector3 deltaPosition = Vector3Scale(body.linearVelocity, step);
+      body.position = Vector3Add(body.position, deltaPosition);
+      recordTravel(index);
+    }
+  };
+
   while (remainingTime > eps)
   {
     // Find earliest time-of-impact (TOI) within remainingTime
@@ -73,25 +259,20 @@ void Scene::Update(const float deltaTime)
     CollisionPoint earliestCP;
     bool foundCollision = false;
 
-    for (int i = 0; i < bodies.size(); i++)
+    local.FindPairs(bodies, remainingTime, pairs);
+    for (const BodyPair &pair : pairs)
     {
-      for (int j = i + 1; j < bodies.size(); j++)
-      {
-        Body *bodyA = &bodies[i];
-        Body *bodyB = &bodies[j];
-
-        if (bodyA->invertedMass == 0.0f && bodyB->invertedMass == 0.0f)
-          continue;
+      Body *bodyA = &bodies[pair.a];
+      Body *bodyB = &bodies[pair.b];
 
-        CollisionPoint cp;
-        if (Intersect(bodyA, bodyB, cp, remainingTime))
+      CollisionPoint cp;
+      if (Intersect(bodyA, bodyB, cp, remainingTime))
+      {
+        if (cp.impactTime < earliestTOI)
         {
-          if (cp.impactTime < earliestTOI)
-          {
-            earliestTOI = cp.impactTime;
-            earliestCP = cp;
-            foundCollision = true;
-          }
+          earliestTOI = cp.impactTime;
+          earliestCP = cp;
+          foundCollision = true;
         }
       }
     }
@@ -99,22 +280,7 @@ void Scene::Update(const float deltaTime)
     if (!foundCollision)
     {
       // No collision in the remaining time: advance whole interval and finish
-      // Apply gravity impulse for the full remaining time and integrate positions.
-      for (auto &body : bodies)
-      {
-        if (body.invertedMass == 0.0f)
-          continue;
-        float mass = 1.0f / body.invertedMass;
-        Vector3 impulseGravity = Vector3Scale(gravity, mass * remainingTime);
-        body.ApplyLinearImpulse(impulseGravity);
-      }
-
-      for (auto &body : bodies)
-      {
-        Vector3 deltaPosition = Vector3Scale(body.linearVelocity, remainingTime);
-        body.position = Vector3Add(body.position, deltaPosition);
-      }
-
+      advance(remainingTime);
       break;
     }
 
@@ -122,22 +288,7 @@ void Scene::Update(const float deltaTime)
     float toi = earliestTOI;
     if (toi > 0.0f)
     {
-      // Apply gravity impulse for toi and advance bodies
-      for (auto &body : bodies)
-      {
-        if (body.invertedMass == 0.0f)
-          continue;
-        float mass = 1.0f / body.invertedMass;
-        Vector3 impulseGravity = Vector3Scale(gravity, mass * toi);
-        body.ApplyLinearImpulse(impulseGravity);
-      }
-
-      for (auto &body : bodies)
-      {
-        Vector3 deltaPosition = Vector3Scale(body.linearVelocity, toi);
-        body.position = Vector3Add(body.position, deltaPosition);
-      }
-
+      advance(toi);
       remainingTime -= toi;
     }
     else
@@ -149,6 +300,9 @@ void Scene::Update(const float deltaTime)
 
     // Resolve the earliest collision at its contact state
     ResolveContact(earliestCP);
+    for (Body *body : {earliestCP.bodyA, earliestCP.bodyB})
+      if (body->invertedMass != 0.0f)
+        recordTravel((int)(body - bodies.data()));
 
     // If TOI was zero, nudge forward a tiny bit to avoid repeated zero-time collisions
     if (toi <= 0.0f)
@@ -156,21 +310,7 @@ void Scene::Update(const float deltaTime)
       float nudge = fminf(minNudge, remainingTime);
       if (nudge > 0.0f)
       {
-        for (auto &body : bodies)
-        {
-          if (body.invertedMass == 0.0f)
-            continue;
-          float mass = 1.0f / body.invertedMass;
-          Vector3 impulseGravity = Vector3Scale(gravity, mass * nudge);
-          body.ApplyLinearImpulse(impulseGravity);
-        }
-
-        for (auto &body : bodies)
-        {
-          Vector3 deltaPosition = Vector3Scale(body.linearVelocity, nudge);
-          body.position = Vector3Add(body.position, deltaPosition);
-        }
-
+        advance(nudge);
         remainingTime -= nudge;
       }
       else
@@ -182,6 +322,87 @@ void Scene::Update(const float deltaTime)
   }
 }
 
+void Scene::Update(const float deltaTime)
+{
+  HOTONES_ZONE("phys::Scene::Update");
+  const int count = (int)bodies.size();
+  BuildIslands(deltaTime);
+
+  // Islands are grouped by where their bodies can get at their current
+  // velocities, but a bounce can send a body further. So each island is
+  // solved optimistically, then the space every body actually covered is
+  // checked: islands that came near each other are merged, rewound to the
+  // start of the frame and solved again together.
+  const Hotones::Memory::FrameVector<Body> frameStart(bodies.begin(), bodies.end());
+  travelBounds.resize(count);
+  for (int i = 0; i < count; i++)
+    bodies[i].shape->GetBounds(bodies[i].position, bodies[i].rotation, travelBounds[i].min, travelBounds[i].max);
+
+  Hotones::Memory::FrameVector<int> pending(islands.size());
+  std::iota(pending.begin(), pending.end(), 0);
+  std::vector<int> moving;
+  for (const Island &island : islands)
+    moving.insert(moving.end(), island.members.begin(), island.members.end());
+  Broadphase overlapCheck;
+  overlapCheck.Reset(moving);
+  std::vector<BodyPair> overlaps;
+
+  while (!pending.empty())
+  {
+    Hotones::Jobs::JobSystem::Get().ParallelFor(pending.size(), 1, [&](size_t begin, size_t end)
+                                                 {
+      for (size_t i = begin; i < end; i++)
+        SolveIsland(islands[pending[i]], deltaTime); });
+
+    bool merged = false;
+    overlapCheck.FindOverlaps(bodies, travelBounds, overlaps);
+    for (const BodyPair &pair : overlaps)
+    {
+      const int rootA = FindIslandRoot(islandParent, pair.a);
+      const int rootB = FindIslandRoot(islandParent, pair.b);
+      if (rootA == rootB)
+        continue;
+      islandParent[rootA] = rootB;
+      merged = true;
+    }
+    if (!merged)
+      break;
+
+    // Regroup; every island that absorbed another is rewound and re-solved
+    std::vector<Island> previous = std::move(islands);
+    islands.clear();
+    pending.clear();
+    Hotones::Memory::FrameVector<int> islandOfRoot(count, -1);
+    Hotones::Memory::FrameVector<int> piecesOfIsland;
+    for (Island &island : previous)
+    {
+      const int root = FindIslandRoot(islandParent, island.members[0]);
+      if (islandOfRoot[root] < 0)
+      {
+        islandOfRoot[root] = (int)islands.size();
+        islands.emplace_back();
+        piecesOfIsland.push_back(0);
+      }
+      Island &target = islands[islandOfRoot[root]];
+      target.members.insert(target.members.end(), island.members.begin(), island.members.end());
+      piecesOfIsland[islandOfRoot[root]]++;
+    }
+    for (int k = 0; k < (int)islands.size(); k++)
+    {
+      if (piecesOfIsland[k] == 1)
+        continue;
+      Island &island = islands[k];
+      std::sort(island.members.begin(), island.members.end());
+      for (int index : island.members)
+      {
+        bodies[index] = frameStart[index];
+        bodies[index].shape->GetBounds(bodies[index].position, bodies[index].rotation,
+                                       travelBounds[index].min, travelBounds[index].max);
+      }
+      pending.push_back(k);
+    }
+  }
+}
 
 bool Intersect(Body *bodyA, Body *bodyB, CollisionPoint &collisionPoint, float deltaTime)
 {
@@ -277,6 +498,9 @@ void ResolveContact(CollisionPoint &collisionPoint)
   Vector3 AtoBWorldSpace = Vector3Subtract(collisionPoint.B_WorldSpace, collisionPoint.A_WorldSpace);
   Vector3 BtoAWorldSpace = Vector3Negate(AtoBWorldSpace);
 
-  bodyA->position = Vector3Add(bodyA->position, Vector3Scale(AtoBWorldSpace, aFractionOfTotalMass));
-  bodyB->position = Vector3Add(bodyB->position, Vector3Scale(BtoAWorldSpace, bFractionOfTotalMass));
+  // Immovable bodies are left untouched: other islands may be reading them
+  if (aFractionOfTotalMass > 0.0f)
+    bodyA->position = Vector3Add(bodyA->position, Vector3Scale(AtoBWorldSpace, aFractionOfTotalMass));
+  if (bFractionOfTotalMass > 0.0f)
+    bodyB->position = Vector3Add(bodyB->position, Vector3Scale(BtoAWorldSpace, bFractionOfTotalMass));
 }
\ No newline at end of file
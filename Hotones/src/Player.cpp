@@ -1,9 +1,14 @@
 #include <GFX/Player.hpp>
 #include <GFX/CollidableModel.hpp>
 #include <Input/Input.hpp>
+#include <Time/FixedTimestep.hpp>
+#include <Time/FrameClock.hpp>
+#include <Profile/Profiler.hpp>
+#include <Logging/Log.hpp>
 #include <iostream>
 #include <cmath>
 #include <SFX/AudioSystem.hpp>
+#include <server/NetworkManager.hpp>
 
 namespace Hotones {
 
@@ -27,31 +32,32 @@ void Player::AttachWorld(std::shared_ptr<CollidableModel> world) {
 }
 
 void Player::Update() {
+    HOTONES_ZONE("Player::Update");
     if (!m_attachedCamera) return;
 
+    // The ticks turned by the motion before them; the rest is the frame's
     Vector2 mouseDelta = Hotones::Input::GetMouseDelta();
+    mouseDelta.x -= m_tickLook.x;
+    mouseDelta.y -= m_tickLook.y;
+    m_tickLook = { 0 };
     lookRotation.x -= mouseDelta.x * sensitivity.x;
     lookRotation.y += mouseDelta.y * sensitivity.y;
 
     char sideway = (char)(Hotones::Input::IsKeyDown(KEY_D) - Hotones::Input::IsKeyDown(KEY_A));
     char forward = (char)(Hotones::Input::IsKeyDown(KEY_W) - Hotones::Input::IsKeyDown(KEY_S));
     bool crouching = Hotones::Input::IsKeyDown(KEY_LEFT_CONTROL);
-    bool jumpPressed = Hotones::Input::IsKeyDown(KEY_SPACE);
 
-    TraceLog(LOG_INFO, "Player::UpdateBody input side=%d forward=%d jumpPressed=%d grounded=%d pos=(%f,%f,%f) vel=(%f,%f,%f)",
-             sideway, forward, jumpPressed ? 1 : 0, body.isGrounded ? 1 : 0,
-             body.position.x, body.position.y, body.position.z,
-             body.velocity.x, body.velocity.y, body.velocity.z);
+    float delta = Hotones::Time::FrameClock::Get().Delta();
+    headLerp = Lerp(headLerp, (crouching ? CROUCH_HEIGHT : STAND_HEIGHT), 20.0f * delta);
 
-    UpdateBody(sideway, forward, jumpPressed, crouching);
+    // Movement runs at the fixed tick rate; draw the body between the last
+    // two ticks so the camera stays smooth at any frame rate.
+    const Vector3 drawPos = Vector3Lerp(m_prevPosition, body.position, Time::FixedTimestep::Get().Alpha());
 
-    float delta = GetFrameTime();
-    headLerp = Lerp(headLerp, (crouching ? CROUCH_HEIGHT : STAND_HEIGHT), 20.0f * delta);
-    
     m_attachedCamera->position = (Vector3){
-        body.position.x,
-        body.position.y + (BOTTOM_HEIGHT + headLerp),
-        body.position.z,
+        drawPos.x,
+        drawPos.y + (BOTTOM_HEIGHT + headLerp),
+        drawPos.z,
     };
 
     if (body.isGrounded && ((forward != 0) || (sideway != 0))) {
@@ -78,10 +84,97 @@ void Player::Update() {
     UpdateCamera();
 }
 
-void Player::UpdateBody(char side, char forward, bool jumpPressed, bool crouchHold) {
-    Vector2 input = (Vector2){ (float)side, (float)-forward };
+void Player::FixedUpdate(float dt) {
+    HOTONES_ZONE("Player::FixedUpdate");
+    if (!m_attachedCamera) return;
+
+    // Input as of this tick's time in the frame, and the look it had then,
+    // so each command carries what the player did when it was simulated
+    auto& input = Hotones::Input::InputHandler::Get();
+    const Vector2 look = input.GetTickMouseDelta();
+    lookRotation.x -= look.x * sensitivity.x;
+    lookRotation.y += look.y * sensitivity.y;
+    m_tickLook.x += look.x;
+    m_tickLook.y += look.y;
+
+    char sideway = (char)(input.IsTickKeyDown(KEY_D) - input.IsTickKeyDown(KEY_A));
+    char forward = (char)(input.IsTickKeyDown(KEY_W) - input.IsTickKeyDown(KEY_S));
+    bool crouching = input.IsTickKeyDown(KEY_LEFT_CONTROL);
+    bool jumpPressed = input.IsTickKeyDown(KEY_SPACE);
+
+    HOTONES_LOG(LOG_TRACE, "Player::UpdateBody input side=%d forward=%d jumpPressed=%d grounded=%d pos=(%f,%f,%f) vel=(%f,%f,%f)",
+             sideway, forward, jumpPressed ? 1 : 0, body.isGrounded ? 1 : 0,
+             body.position.x, body.position.y, body.position.z,
+             body.velocity.x, body.velocity.y, body.velocity.z);
+
+    m_prevPosition = body.position;
+    if (m_net && m_net->IsServerMovement()) {
+        PredictMove(sideway, forward, jumpPressed, crouching, dt);
+        return;
+    }
+    UpdateBody(sideway, forward, jumpPressed, crouching, dt);
+}
+
+void Player::UpdateBody(char side, char forward, bool jumpPressed, bool crouchHold, float delta) {
+    StepBody(body, side, forward, jumpPressed, crouchHold, lookRotation.x, delta, m_worldModel.get(), enableSourceBhop);
+}
+
+// Move on the command straight away and send it; the server's answer for
+// it arrives a round trip later and is checked in Reconcile().
+void Player::PredictMove(char side, char forward, bool jumpPressed, bool crouchHold, float delta) {
+    Net::BodyCorrection correction;
+    if (m_net->TakeCorrection(correction)) Reconcile(correction);
+
+    // Simulate from the quantized command, exactly as the server will
+    const Net::InputCommand cmd = Net::MakeInputCommand(m_inputSeq++, side, forward, jumpPressed, crouchHold,
+                                                        lookRotation.x, lookRotation.y, delta);
+    StepBody(body, cmd.side, cmd.forward, cmd.jump, cmd.crouch, cmd.Yaw(), cmd.Dt(),
+             m_worldModel.get(), enableSourceBhop);
+    m_predicted.push_back({ cmd, body });
+    if (m_predicted.size() > MAX_PREDICTED) m_predicted.pop_front();
+    m_net->SendInput(cmd);
+}
 
-    float delta = GetFrameTime();
+// The server applied every command up to correction.seq and ended up with
+// the given body.  If that matches what we predicted for the same command
+// nothing changes; otherwise restart from the server's body and replay the
+// commands it has not seen yet.
+void Player::Reconcile(const Net::BodyCorrection& correction) {
+    bool havePredicted = false;
+    Body predicted     = body;
+    while (!m_predicted.empty() && Net::SeqStale(m_predicted.front().cmd.seq, correction.seq)) {
+        if (m_predicted.front().cmd.seq == correction.seq) {
+            predicted     = m_predicted.front().after;
+            havePredicted = true;
+        }
+        m_predicted.pop_front();
+    }
+
+    Body server       = body;
+    server.position   = { correction.position[0], correction.position[1], correction.position[2] };
+    server.velocity   = { correction.velocity[0], correction.velocity[1], correction.velocity[2] };
+    server.dir        = { correction.dir[0], 0.f, correction.dir[1] };
+    server.isGrounded = correction.grounded;
+
+    // Within float noise of the prediction: keep going
+    constexpr float POS_TOLERANCE = 0.01f, VEL_TOLERANCE = 0.05f;
+    if (havePredicted
+        && Vector3Distance(predicted.position, server.position) < POS_TOLERANCE
+        && Vector3Distance(predicted.velocity, server.velocity) < VEL_TOLERANCE
+        && predicted.isGrounded == server.isGrounded)
+        return;
+
+    body = server;
+    for (PredictedMove& move : m_predicted) {
+        StepBody(body, move.cmd.side, move.cmd.forward, move.cmd.jump, move.cmd.crouch,
+                 move.cmd.Yaw(), move.cmd.Dt(), m_worldModel.get(), enableSourceBhop);
+        move.after = body;
+    }
+}
+
+void Player::StepBody(Body& body, char side, char forward, bool jumpPressed, bool crouchHold,
+                      float yaw, float delta, CollidableModel* world, bool enableSourceBhop) {
+    Vector2 input = (Vector2){ (float)side, (float)-forward };
 
     if (!body.isGrounded) body.velocity.y -= GRAVITY * delta;
 
@@ -99,16 +192,16 @@ void Player::UpdateBody(char side, char forward, bool jumpPressed, bool crouchHo
     //     wasJumpHeld = IsKeyDown(KEY_SPACE);
     // } else {
         if (body.isGrounded && jumpPressed) {
-            TraceLog(LOG_INFO, "Player::UpdateBody jump triggered: setting velocity.y from %f to %f", body.velocity.y, JUMP_FORCE);
+            HOTONES_LOG(LOG_DEBUG, "Player::UpdateBody jump triggered: setting velocity.y from %f to %f", body.velocity.y, JUMP_FORCE);
             body.velocity.y = JUMP_FORCE;
             body.isGrounded = false;
         } else if (jumpPressed && !body.isGrounded) {
-            TraceLog(LOG_INFO, "Player::UpdateBody jump pressed but not grounded (ignored)");
+            HOTONES_LOG(LOG_TRACE, "Player::UpdateBody jump pressed but not grounded (ignored)");
         }
     // }
 
-    Vector3 front = (Vector3){ sinf(lookRotation.x), 0.f, cosf(lookRotation.x) };
-    Vector3 right = (Vector3){ cosf(-lookRotation.x), 0.f, sinf(-lookRotation.x) };
+    Vector3 front = (Vector3){ sinf(yaw), 0.f, cosf(yaw) };
+    Vector3 right = (Vector3){ cosf(-yaw), 0.f, sinf(-yaw) };
 
     Vector3 desiredDir = (Vector3){ input.x * right.x + input.y * front.x, 0.0f, input.x * right.z + input.y * front.z, };
     body.dir = Vector3Lerp(body.dir, desiredDir, CONTROL * delta);
@@ -138,89 +231,32 @@ void Player::UpdateBody(char side, char forward, bool jumpPressed, bool crouchHo
     Vector3 remaining = Vector3{ body.velocity.x * delta, body.velocity.y * delta, body.velocity.z * delta };
     const float playerRadius = 0.5f;
 
-    if (m_worldModel) {
-        const int maxIters = 3;
-        Vector3 curr = startPos;
-
-        // Subdivide the total remaining travel into smaller steps to avoid tunneling
-        float remLen = Vector3Length(remaining);
-        float stepMax = fmaxf(playerRadius * 0.5f, 0.25f); // maximum allowed step length
-        int steps = (int)ceilf(remLen / stepMax);
-        steps = fmax(1, steps);
-        // clamp to avoid excessive loops
-        steps = (steps > 16) ? 16 : steps;
-
-        Vector3 stepVec = Vector3Scale(remaining, 1.0f / (float)steps);
-
-        for (int s = 0; s < steps; ++s) {
-            Vector3 target = Vector3Add(curr, stepVec);
-            Vector3 hitPos, hitNormal; float tHit;
-            if (!m_worldModel->SweepSphere(curr, target, playerRadius, hitPos, hitNormal, tHit)) {
-                // no hit: move to target and continue
-                curr = target;
-                continue;
-            }
-
-            // move to impact point
-            curr = hitPos;
-
-            // compute remaining after impact within this step
-            Vector3 travel = Vector3Subtract(target, hitPos);
-            float vn = Vector3DotProduct(travel, hitNormal);
-            Vector3 proj = Vector3Scale(hitNormal, vn);
-            Vector3 slide = Vector3Subtract(travel, proj);
-
-            // small epsilon to avoid sticking
-            curr = Vector3Add(curr, Vector3Scale(hitNormal, 0.001f));
-
-            // apply slide as the remaining motion for the rest of this update
-            remaining = Vector3Add(Vector3Scale(stepVec, (float)(steps - s - 1)), slide);
-
-            // If hit normal is mostly up, consider grounded and zero vertical velocity
-            if (hitNormal.y > 0.5f) {
-                body.isGrounded = true;
-                body.velocity.y = 0.0f;
-                TraceLog(LOG_INFO, "Player::UpdateBody grounded via sweep hit (y=%f) at pos=(%f,%f,%f)", hitNormal.y, curr.x, curr.y, curr.z);
-            }
-
-            // attempt a few iterations of sliding resolution
-            // similar to previous loop but limited
-            for (int iter = 0; iter < maxIters; ++iter) {
-                Vector3 nextTarget = Vector3Add(curr, remaining);
-                if (!m_worldModel->SweepSphere(curr, nextTarget, playerRadius, hitPos, hitNormal, tHit)) {
-                    curr = nextTarget;
-                    break;
-                }
-                curr = hitPos;
-                travel = Vector3Subtract(nextTarget, hitPos);
-                vn = Vector3DotProduct(travel, hitNormal);
-                proj = Vector3Scale(hitNormal, vn);
-                slide = Vector3Subtract(travel, proj);
-                curr = Vector3Add(curr, Vector3Scale(hitNormal, 0.001f));
-                remaining = slide;
-                if (hitNormal.y > 0.5f) {
-                    body.isGrounded = true;
-                    body.velocity.y = 0.0f;
-                    break;
-                }
-            }
-            // after resolving this impact, continue from current position with updated remaining
+    if (world) {
+        // One collide-and-slide over the whole tick's travel: the triangles
+        // within reach are gathered once and every slide iteration plus the
+        // final overlap resolve run against that set.  Sweeps are
+        // continuous, so the move needs no substeps against tunnelling.
+        Physics::SlideParams slide;
+        slide.maxIters = 4;
+        const Physics::SlideResult moved = world->SlideSphere(startPos, remaining, playerRadius, slide);
+
+        // If a contact faced mostly up, consider grounded and zero vertical velocity
+        if (moved.grounded) {
+            body.isGrounded = true;
+            body.velocity.y = 0.0f;
+            HOTONES_LOG(LOG_TRACE, "Player::UpdateBody grounded via sweep hit (y=%f) at pos=(%f,%f,%f)",
+                     moved.groundNormal.y, moved.position.x, moved.position.y, moved.position.z);
         }
 
-        // final position is the swept result `curr`
-        body.position = curr;
+        body.position = moved.position;
         // update velocity to match actual movement
         body.velocity = Vector3Scale(Vector3Subtract(body.position, startPos), 1.0f / delta);
 
-        // Ensure we are not left overlapping geometry due to numeric issues by
-        // resolving any residual sphere collisions against the world meshes.
-        // This pushes the player out of intersecting AABBs and marks grounded
-        // when appropriate to avoid walking through thin or missed collisions.
-        bool pushed = m_worldModel->ResolveSphereCollision(body.position, playerRadius);
-        if (pushed) {
-            // If ResolveSphereCollision pushed us upwards, consider grounded.
+        // The slide ends by resolving residual overlap, so numeric issues
+        // never leave the player inside thin or missed geometry.
+        if (moved.pushed) {
             // Conservative: zero vertical velocity to avoid tunneling.
-            TraceLog(LOG_INFO, "Player::UpdateBody ResolveSphereCollision pushed player to pos=(%f,%f,%f)", body.position.x, body.position.y, body.position.z);
+            HOTONES_LOG(LOG_TRACE, "Player::UpdateBody ResolveSphereCollision pushed player to pos=(%f,%f,%f)", body.position.x, body.position.y, body.position.z);
             body.velocity.y = 0.0f;
             body.isGrounded = true;
         }
@@ -0,0 +1,435 @@
+// Profiler.cpp — per-thread zone buffers, frame history, GL timestamp queries
+
+#include <Profile/Profiler.hpp>
+#include <rlgl.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+#if defined(_WIN32)
+extern "C" __declspec(dllimport) void* __stdcall GetModuleHandleA(const char* name);
+extern "C" __declspec(dllimport) void* __stdcall GetProcAddress(void* module, const char* name);
+#define HOTONES_GLAPI __stdcall
+#else
+#include <dlfcn.h>
+#define HOTONES_GLAPI
+#endif
+
+namespace Hotones::Profile {
+
+namespace {
+
+constexpr size_t MAX_THREAD_ZONES = 1 << 16;   // per thread and frame; the rest are dropped
+
+struct ThreadBuffer {
+    std::mutex             mutex;
+    uint32_t               id = 0;
+    std::string            name;
+    std::vector<ZoneEvent> zones;
+    size_t                 dropped = 0;
+};
+
+std::mutex                                 g_threadsMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> g_threads;
+uint32_t                                   g_nextThreadId = 1;
+
+std::atomic<bool> g_active{ false };     // the open frame is being recorded
+std::atomic<bool> g_recording{ true };   // whether the next frame will be
+
+std::vector<Frame> g_frames;
+uint64_t           g_frameIndex = 0;
+int64_t            g_frameStart = -1;    // -1 → no frame open yet
+
+std::mutex                 g_countersMutex;
+std::vector<CounterSample> g_counters;   // the open frame's
+
+thread_local std::shared_ptr<ThreadBuffer> t_buffer;
+thread_local uint32_t                      t_depth = 0;
+
+ThreadBuffer& LocalBuffer()
+{
+    if (!t_buffer) {
+        t_buffer = std::make_shared<ThreadBuffer>();
+        std::lock_guard<std::mutex> lk(g_threadsMutex);
+        t_buffer->id   = g_nextThreadId++;
+        t_buffer->name = "Thread " + std::to_string(t_buffer->id);
+        g_threads.push_back(t_buffer);
+    }
+    return *t_buffer;
+}
+
+// ── GPU timestamp queries ────────────────────────────────────────────────────
+//
+// rlgl exposes no queries, so the few entry points needed are looked up by
+// name in the GL library raylib loaded.  Each frame in flight owns a set of
+// query pairs; a set is read back once its last query is available, and
+// reused GPU_FRAMES frames later (dropped if the GPU is further behind).
+
+constexpr unsigned GL_TIMESTAMP_             = 0x8E28;
+constexpr unsigned GL_QUERY_RESULT_          = 0x8866;
+constexpr unsigned GL_QUERY_RESULT_AVAILABLE_ = 0x8867;
+
+constexpr int GPU_FRAMES = 4;    // frames of latency tolerated
+constexpr int GPU_ZONES  = 64;   // per frame
+
+using GenQueriesFn         = void (HOTONES_GLAPI*)(int, unsigned*);
+using DeleteQueriesFn      = void (HOTONES_GLAPI*)(int, const unsigned*);
+using QueryCounterFn       = void (HOTONES_GLAPI*)(unsigned, unsigned);
+using GetQueryObjectivFn   = void (HOTONES_GLAPI*)(unsigned, unsigned, int*);
+using GetQueryObjectui64Fn = void (HOTONES_GLAPI*)(unsigned, unsigned, uint64_t*);
+using GetInteger64vFn      = void (HOTONES_GLAPI*)(unsigned, int64_t*);
+
+struct GpuFrame {
+    uint64_t    frame   = 0;
+    bool        pending = false;   // has zones not read back yet
+    int         used    = 0;
+    const char* names[GPU_ZONES]  = {};
+    uint32_t    depths[GPU_ZONES] = {};
+    unsigned    queries[GPU_ZONES * 2] = {};   // start, end per zone
+};
+
+struct GpuTimers {
+    bool ready = false;
+    GenQueriesFn         GenQueries         = nullptr;
+    DeleteQueriesFn      DeleteQueries      = nullptr;
+    QueryCounterFn       QueryCounter       = nullptr;
+    GetQueryObjectivFn   GetQueryObjectiv   = nullptr;
+    GetQueryObjectui64Fn GetQueryObjectui64 = nullptr;
+    GetInteger64vFn      GetInteger64v      = nullptr;
+
+    GpuFrame frames[GPU_FRAMES];
+    int      current   = -1;   // into frames, -1 → outside a frame
+    uint32_t depth     = 0;
+    int64_t  offset    = 0;    // CPU ns - GPU ns
+    int64_t  calibrated = -1;  // Now() of the last offset update
+};
+
+GpuTimers g_gpu;
+
+void* GetGLProc(const char* name)
+{
+#if defined(_WIN32)
+    // Entry points past GL 1.1 only come from wglGetProcAddress
+    using WglGetProcAddressFn = void* (__stdcall*)(const char*);
+    void* gl = GetModuleHandleA("opengl32.dll");
+    if (!gl) return nullptr;
+    const auto wglGetProc = reinterpret_cast<WglGetProcAddressFn>(GetProcAddress(gl, "wglGetProcAddress"));
+    return wglGetProc ? wglGetProc(name) : nullptr;
+#else
+    return dlsym(RTLD_DEFAULT, name);
+#endif
+}
+
+template<typename Fn>
+bool Load(Fn& fn, const char* name)
+{
+    fn = reinterpret_cast<Fn>(GetGLProc(name));
+    return fn != nullptr;
+}
+
+void Calibrate(int64_t now)
+{
+    int64_t gpuNow = 0;
+    g_gpu.GetInteger64v(GL_TIMESTAMP_, &gpuNow);
+    g_gpu.offset     = now - gpuNow;
+    g_gpu.calibrated = now;
+}
+
+Frame* FindFrame(uint64_t index)
+{
+    for (auto it = g_frames.rbegin(); it != g_frames.rend(); ++it)
+        if (it->index == index) return &*it;
+    return nullptr;
+}
+
+// Read back every frame whose queries have all landed
+void CollectGpu()
+{
+    for (GpuFrame& f : g_gpu.frames) {
+        if (!f.pending) continue;
+        int available = 0;
+        g_gpu.GetQueryObjectiv(f.queries[f.used * 2 - 1], GL_QUERY_RESULT_AVAILABLE_, &available);
+        if (!available) continue;
+
+        f.pending = false;
+        Frame* frame = FindFrame(f.frame);
+        if (!frame) continue;
+        frame->gpuPending = false;
+        for (int i = 0; i < f.used; ++i) {
+            uint64_t start = 0, end = 0;
+            g_gpu.GetQueryObjectui64(f.queries[i * 2],     GL_QUERY_RESULT_, &start);
+            g_gpu.GetQueryObjectui64(f.queries[i * 2 + 1], GL_QUERY_RESULT_, &end);
+            frame->gpu.push_back({ f.names[i], (int64_t)start + g_gpu.offset,
+                                   (int64_t)end + g_gpu.offset, f.depths[i] });
+        }
+    }
+}
+
+// Hand the frame being recorded its query set
+void BeginGpuFrame(uint64_t index, int64_t now)
+{
+    if (g_gpu.calibrated < 0 || now - g_gpu.calibrated > 1'000'000'000) Calibrate(now);
+
+    g_gpu.current = (int)(index % GPU_FRAMES);
+    GpuFrame& f = g_gpu.frames[g_gpu.current];
+    if (f.pending)
+        if (Frame* old = FindFrame(f.frame)) old->gpuPending = false;   // GPU too far behind
+    f.frame   = index;
+    f.pending = false;
+    f.used    = 0;
+    g_gpu.depth = 0;
+}
+
+void WriteJsonString(std::FILE* file, const std::string& s)
+{
+    std::fputc('"', file);
+    for (char c : s) {
+        if (c == '"' || c == '\\')      std::fprintf(file, "\\%c", c);
+        else if ((unsigned char)c < 32) std::fprintf(file, "\\u%04x", c);
+        else                            std::fputc(c, file);
+    }
+    std::fputc('"', file);
+}
+
+} // namespace
+
+int64_t Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void BeginFrame()
+{
+    const int64_t now = Now();
+
+    if (g_active.load(std::memory_order_relaxed)) {
+        Frame frame;
+        frame.index = g_frameIndex;
+        frame.start = g_frameStart;
+        frame.end   = now;
+        {
+            std::lock_guard<std::mutex> lk(g_threadsMutex);
+            for (const auto& buffer : g_threads) {
+                std::lock_guard<std::mutex> blk(buffer->mutex);
+                if (buffer->zones.empty() && buffer->dropped == 0) continue;
+                // Copied rather than moved so the buffer keeps its capacity
+                frame.threads.push_back({ buffer->id, buffer->name, buffer->zones });
+                frame.dropped += buffer->dropped;
+                buffer->zones.clear();
+                buffer->dropped = 0;
+            }
+            // Threads that have exited and have nothing left to report
+            std::erase_if(g_threads, [](const std::shared_ptr<ThreadBuffer>& b) {
+                return b.use_count() == 1;
+            });
+        }
+        std::sort(frame.threads.begin(), frame.threads.end(),
+                  [](const ThreadTrack& a, const ThreadTrack& b) { return a.id < b.id; });
+        {
+            std::lock_guard<std::mutex> lk(g_countersMutex);
+            frame.counters = g_counters;   // copied: keeps the capacity
+            g_counters.clear();
+        }
+        if (g_gpu.ready && g_gpu.current >= 0) {
+            GpuFrame& f = g_gpu.frames[g_gpu.current];
+            f.pending = frame.gpuPending = f.used > 0;
+        }
+
+        if (g_frames.size() >= HISTORY_FRAMES) g_frames.erase(g_frames.begin());
+        g_frames.push_back(std::move(frame));
+    } else {
+        std::lock_guard<std::mutex> lk(g_threadsMutex);
+        for (const auto& buffer : g_threads) {
+            std::lock_guard<std::mutex> blk(buffer->mutex);
+            buffer->zones.clear();
+            buffer->dropped = 0;
+        }
+        std::lock_guard<std::mutex> clk(g_countersMutex);
+        g_counters.clear();
+    }
+
+    ++g_frameIndex;
+    g_frameStart = now;
+    g_active.store(g_recording.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    if (g_gpu.ready) {
+        CollectGpu();
+        BeginGpuFrame(g_frameIndex, now);
+    }
+}
+
+void SetCounter(const char* name, double value)
+{
+    if (!g_active.load(std::memory_order_relaxed)) return;
+    std::lock_guard<std::mutex> lk(g_countersMutex);
+    for (CounterSample& c : g_counters)
+        if (c.name == name || std::strcmp(c.name, name) == 0) { c.value = value; return; }
+    g_counters.push_back({ name, value });
+}
+
+void SetThreadName(const char* name)
+{
+    ThreadBuffer& buffer = LocalBuffer();
+    std::lock_guard<std::mutex> lk(buffer.mutex);
+    buffer.name = name;
+}
+
+// Takes effect at the next frame, so no frame is recorded in part
+void SetRecording(bool on)
+{
+    g_recording.store(on, std::memory_order_relaxed);
+}
+
+bool IsRecording()
+{
+    return g_recording.load(std::memory_order_relaxed);
+}
+
+const std::vector<Frame>& Frames()
+{
+    return g_frames;
+}
+
+void ClearFrames()
+{
+    g_frames.clear();
+}
+
+bool InitGpuTimers()
+{
+    if (g_gpu.ready) return true;
+    const int version = rlGetVersion();
+    if (version != RL_OPENGL_33 && version != RL_OPENGL_43) return false;
+
+    GpuTimers& g = g_gpu;
+    if (!Load(g.GenQueries, "glGenQueries") || !Load(g.DeleteQueries, "glDeleteQueries") ||
+        !Load(g.QueryCounter, "glQueryCounter") || !Load(g.GetQueryObjectiv, "glGetQueryObjectiv") ||
+        !Load(g.GetQueryObjectui64, "glGetQueryObjectui64v") || !Load(g.GetInteger64v, "glGetInteger64v")) {
+        g = {};
+        return false;
+    }
+    for (GpuFrame& f : g.frames) {
+        f = {};
+        g.GenQueries(GPU_ZONES * 2, f.queries);
+    }
+    g.current = -1;
+    g.ready   = true;
+    return true;
+}
+
+void ShutdownGpuTimers()
+{
+    if (!g_gpu.ready) return;
+    for (GpuFrame& f : g_gpu.frames) g_gpu.DeleteQueries(GPU_ZONES * 2, f.queries);
+    for (Frame& frame : g_frames) frame.gpuPending = false;
+    g_gpu = {};
+}
+
+bool HasGpuTimers()
+{
+    return g_gpu.ready;
+}
+
+bool ExportChromeTrace(const std::string& path)
+{
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) return false;
+
+    // Microseconds from the first frame; the CPU threads are process 1
+    // (frames on tid 0), the GPU is process 2
+    const int64_t origin = g_frames.empty() ? 0 : g_frames.front().start;
+    const auto us = [origin](int64_t ns) { return (double)(ns - origin) / 1000.0; };
+    bool first = true;
+    const auto next = [&] { std::fputs(first ? "\n" : ",\n", file); first = false; };
+    const auto event = [&](const char* name, int pid, uint32_t tid, int64_t start, int64_t end) {
+        next();
+        std::fputs("{\"ph\":\"X\",\"name\":", file);
+        WriteJsonString(file, name);
+        std::fprintf(file, ",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                     pid, tid, us(start), (double)(end - start) / 1000.0);
+    };
+    const auto meta = [&](const char* kind, int pid, uint32_t tid, const std::string& name) {
+        next();
+        std::fprintf(file, "{\"ph\":\"M\",\"name\":\"%s\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":", kind, pid, tid);
+        WriteJsonString(file, name);
+        std::fputs("}}", file);
+    };
+
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+    meta("process_name", 1, 0, "CPU");
+    meta("process_name", 2, 0, "GPU");
+    meta("thread_name",  1, 0, "Frames");
+    meta("thread_name",  2, 0, "GPU");
+
+    std::vector<uint32_t> named;
+    for (const Frame& frame : g_frames) {
+        event("Frame", 1, 0, frame.start, frame.end);
+        for (const ThreadTrack& track : frame.threads) {
+            if (std::find(named.begin(), named.end(), track.id) == named.end()) {
+                named.push_back(track.id);
+                meta("thread_name", 1, track.id, track.name);
+            }
+            for (const ZoneEvent& zone : track.zones) event(zone.name, 1, track.id, zone.start, zone.end);
+        }
+        for (const ZoneEvent& zone : frame.gpu) event(zone.name, 2, 0, zone.start, zone.end);
+        for (const CounterSample& c : frame.counters) {
+            next();
+            std::fputs("{\"ph\":\"C\",\"name\":", file);
+            WriteJsonString(file, c.name);
+            std::fprintf(file, ",\"pid\":1,\"ts\":%.3f,\"args\":{\"value\":%.6g}}", us(frame.end), c.value);
+        }
+    }
+    std::fputs("\n]}\n", file);
+    return std::fclose(file) == 0;
+}
+
+// ─── Zones ────────────────────────────────────────────────────────────────────
+
+Zone::Zone(const char* name) noexcept
+    : m_name(name)
+{
+    if (!g_active.load(std::memory_order_relaxed)) return;
+    m_start = Now();
+    ++t_depth;
+}
+
+Zone::~Zone()
+{
+    if (m_start < 0) return;
+    const int64_t end = Now();
+    --t_depth;
+    ThreadBuffer& buffer = LocalBuffer();
+    std::lock_guard<std::mutex> lk(buffer.mutex);
+    if (buffer.zones.size() < MAX_THREAD_ZONES)
+        buffer.zones.push_back({ m_name, m_start, end, t_depth });
+    else
+        ++buffer.dropped;
+}
+
+GpuZone::GpuZone(const char* name) noexcept
+{
+    if (!g_gpu.ready || g_gpu.current < 0 || !g_active.load(std::memory_order_relaxed)) return;
+    GpuFrame& f = g_gpu.frames[g_gpu.current];
+    if (f.used >= GPU_ZONES) return;
+
+    rlDrawRenderBatchActive();   // what was drawn before belongs outside
+    const int zone = f.used++;
+    f.names[zone]  = name;
+    f.depths[zone] = g_gpu.depth++;
+    g_gpu.QueryCounter(f.queries[zone * 2], GL_TIMESTAMP_);
+    m_slot = g_gpu.current * GPU_ZONES + zone;
+}
+
+GpuZone::~GpuZone()
+{
+    if (m_slot < 0 || !g_gpu.ready) return;
+    rlDrawRenderBatchActive();
+    --g_gpu.depth;
+    g_gpu.QueryCounter(g_gpu.frames[m_slot / GPU_ZONES].queries[(m_slot % GPU_ZONES) * 2 + 1], GL_TIMESTAMP_);
+}
+
+} // namespace Hotones::Profile
@@ -0,0 +1,264 @@
+// ProfilerPanel.cpp — ImGui view of the profiler's frame history
+
+#include <Profile/Profiler.hpp>
+#include <imgui/imgui.h>
+#include <algorithm>
+#include <functional>
+#include <string_view>
+
+namespace Hotones::Profile {
+
+namespace {
+
+constexpr float GRAPH_HEIGHT = 60.f;
+constexpr float ROW_HEIGHT   = 18.f;
+constexpr float LABEL_WIDTH  = 90.f;
+
+// Panel state, main thread only
+uint64_t    s_selected = 0;      // Frame::index shown below the graph
+bool        s_follow   = true;   // keep showing the newest frame
+std::string s_status;
+
+ImU32 ZoneColor(const char* name)
+{
+    const size_t h = std::hash<std::string_view>{}(name);
+    float r, g, b;
+    ImGui::ColorConvertHSVtoRGB((float)(h % 360) / 360.f, 0.45f, 0.85f, r, g, b);
+    return ImGui::GetColorU32({ r, g, b, 1.f });
+}
+
+double Ms(int64_t ns) { return (double)ns / 1e6; }
+
+// Bar per recorded frame, click to select
+void DrawFrameGraph(const std::vector<Frame>& frames)
+{
+    const float  width = ImGui::GetContentRegionAvail().x;
+    const ImVec2 p0    = ImGui::GetCursorScreenPos();
+    ImGui::InvisibleButton("##frames", { std::max(width, 1.f), GRAPH_HEIGHT });
+    ImDrawList* dl = ImGui::GetWindowDrawList();
+    dl->AddRectFilled(p0, { p0.x + width, p0.y + GRAPH_HEIGHT }, IM_COL32(20, 20, 24, 255));
+
+    // Scaled so 33 ms fills the graph; the 16.7 ms line marks 60 fps
+    const double scale = GRAPH_HEIGHT / 33.3;
+    const float  bar   = width / (float)HISTORY_FRAMES;
+    const float  x0    = p0.x + width - bar * (float)frames.size();
+    for (size_t i = 0; i < frames.size(); ++i) {
+        const double ms = Ms(frames[i].end - frames[i].start);
+        const float  h  = (float)std::min(ms * scale, (double)GRAPH_HEIGHT);
+        const ImU32  c  = frames[i].index == s_selected ? IM_COL32(255, 255, 255, 255)
+                        : ms > 33.3 ? IM_COL32(220, 70, 60, 255)
+                        : ms > 16.7 ? IM_COL32(220, 180, 60, 255)
+                        : IM_COL32(80, 180, 90, 255);
+        const float x = x0 + bar * (float)i;
+        dl->AddRectFilled({ x, p0.y + GRAPH_HEIGHT - h }, { x + std::max(bar - 1.f, 1.f), p0.y + GRAPH_HEIGHT }, c);
+    }
+    const float y60 = p0.y + GRAPH_HEIGHT - (float)(16.7 * scale);
+    dl->AddLine({ p0.x, y60 }, { p0.x + width, y60 }, IM_COL32(255, 255, 255, 60));
+
+    if (ImGui::IsItemHovered() && !frames.empty()) {
+        const float  mx = ImGui::GetIO().MousePos.x;
+        const long   i  = (long)((mx - x0) / bar);
+        if (i >= 0 && i < (long)frames.size()) {
+            const Frame& f = frames[(size_t)i];
+            ImGui::SetTooltip("Frame %llu: %.2f ms", (unsigned long long)f.index, Ms(f.end - f.start));
+            if (ImGui::IsMouseClicked(ImGuiMouseButton_Left)) {
+                s_selected = f.index;
+                s_follow   = false;
+            }
+        }
+    }
+}
+
+// One lane of nested zones; returns its height
+float DrawLane(ImDrawList* dl, ImVec2 origin, float width, int64_t t0, int64_t t1,
+               const char* label, const std::vector<ZoneEvent>& zones)
+{
+    uint32_t maxDepth = 0;
+    for (const ZoneEvent& z : zones) maxDepth = std::max(maxDepth, z.depth);
+    const float height = (float)(maxDepth + 1) * ROW_HEIGHT;
+    const float span   = width - LABEL_WIDTH;
+    const double perNs = span / (double)std::max<int64_t>(t1 - t0, 1);
+
+    dl->AddText({ origin.x, origin.y + 2.f }, IM_COL32(200, 200, 200, 255), label);
+    const ImVec2 mouse = ImGui::GetIO().MousePos;
+    for (const ZoneEvent& z : zones) {
+        const float x0 = origin.x + LABEL_WIDTH + (float)((double)(z.start - t0) * perNs);
+        const float x1 = std::max(origin.x + LABEL_WIDTH + (float)((double)(z.end - t0) * perNs), x0 + 1.f);
+        const float y0 = origin.y + (float)z.depth * ROW_HEIGHT, y1 = y0 + ROW_HEIGHT - 1.f;
+        dl->AddRectFilled({ x0, y0 }, { x1, y1 }, ZoneColor(z.name));
+        if (x1 - x0 > ImGui::CalcTextSize(z.name).x + 6.f)
+            dl->AddText({ x0 + 3.f, y0 + 2.f }, IM_COL32(0, 0, 0, 255), z.name);
+        if (ImGui::IsWindowHovered() && mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y1)
+            ImGui::SetTooltip("%s\n%.3f ms (%s)", z.name, Ms(z.end - z.start), label);
+    }
+    return height;
+}
+
+void DrawTimeline(const Frame& frame)
+{
+    int64_t t1 = frame.end;
+    for (const ZoneEvent& z : frame.gpu) t1 = std::max(t1, z.end);
+
+    ImGui::BeginChild("##timeline", { 0, 200 }, ImGuiChildFlags_Borders);
+    ImDrawList*  dl     = ImGui::GetWindowDrawList();
+    const float  width  = ImGui::GetContentRegionAvail().x;
+    ImVec2       cursor = ImGui::GetCursorScreenPos();
+
+    // Frame end, when GPU work runs past it
+    if (t1 > frame.end) {
+        const float x = cursor.x + LABEL_WIDTH +
+                        (float)((double)(frame.end - frame.start) * (width - LABEL_WIDTH) / (double)(t1 - frame.start));
+        dl->AddLine({ x, cursor.y }, { x, cursor.y + ImGui::GetContentRegionAvail().y }, IM_COL32(255, 255, 255, 80));
+    }
+
+    float total = 0.f;
+    for (const ThreadTrack& track : frame.threads) {
+        const float h = DrawLane(dl, cursor, width, frame.start, t1, track.name.c_str(), track.zones) + 4.f;
+        cursor.y += h;
+        total    += h;
+    }
+    if (!frame.gpu.empty()) total += DrawLane(dl, cursor, width, frame.start, t1, "GPU", frame.gpu);
+    else if (frame.gpuPending) dl->AddText(cursor, IM_COL32(160, 160, 160, 255), "GPU: waiting for results");
+    ImGui::Dummy({ width, total });
+    ImGui::EndChild();
+}
+
+struct ZoneTotal {
+    const char* name  = nullptr;
+    bool        gpu   = false;
+    int         calls = 0;
+    int64_t     total = 0, self = 0, max = 0;
+};
+
+// Adds `zones` (one thread's, or the GPU's) to `totals`; self time leaves
+// out the direct children
+void Accumulate(std::vector<ZoneTotal>& totals, std::vector<ZoneEvent> zones, bool gpu)
+{
+    std::sort(zones.begin(), zones.end(), [](const ZoneEvent& a, const ZoneEvent& b) {
+        return a.start != b.start ? a.start < b.start : a.depth < b.depth;
+    });
+    std::vector<int64_t> self(zones.size());
+    std::vector<size_t>  open;
+    for (size_t i = 0; i < zones.size(); ++i) {
+        const ZoneEvent& z = zones[i];
+        self[i] = z.end - z.start;
+        while (!open.empty() && zones[open.back()].end <= z.start) open.pop_back();
+        if (!open.empty() && zones[open.back()].depth + 1 == z.depth) self[open.back()] -= self[i];
+        open.push_back(i);
+    }
+    for (size_t i = 0; i < zones.size(); ++i) {
+        const ZoneEvent& z = zones[i];
+        auto it = std::find_if(totals.begin(), totals.end(), [&](const ZoneTotal& t) {
+            return t.gpu == gpu && std::string_view(t.name) == z.name;
+        });
+        if (it == totals.end()) it = totals.insert(totals.end(), { z.name, gpu });
+        it->calls++;
+        it->total += z.end - z.start;
+        it->self  += self[i];
+        it->max    = std::max(it->max, z.end - z.start);
+    }
+}
+
+void DrawTotals(const Frame& frame)
+{
+    std::vector<ZoneTotal> totals;
+    for (const ThreadTrack& track : frame.threads) Accumulate(totals, track.zones, false);
+    Accumulate(totals, frame.gpu, true);
+    std::sort(totals.begin(), totals.end(), [](const ZoneTotal& a, const ZoneTotal& b) { return a.total > b.total; });
+
+    if (!ImGui::BeginTable("##zonetotals", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY,
+                           { 0, 160 }))
+        return;
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Zone");
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableSetupColumn("Total ms");
+    ImGui::TableSetupColumn("Self ms");
+    ImGui::TableSetupColumn("Max ms");
+    ImGui::TableHeadersRow();
+    for (const ZoneTotal& t : totals) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn(); ImGui::Text("%s%s", t.gpu ? "GPU: " : "", t.name);
+        ImGui::TableNextColumn(); ImGui::Text("%d", t.calls);
+        ImGui::TableNextColumn(); ImGui::Text("%.3f", Ms(t.total));
+        ImGui::TableNextColumn(); ImGui::Text("%.3f", Ms(t.self));
+        ImGui::TableNextColumn(); ImGui::Text("%.3f", Ms(t.max));
+    }
+    ImGui::EndTable();
+}
+
+void DrawCounters(const Frame& frame)
+{
+    if (frame.counters.empty()) return;
+    if (!ImGui::BeginTable("##counters", 2, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) return;
+    ImGui::TableSetupColumn("Counter");
+    ImGui::TableSetupColumn("Value");
+    ImGui::TableHeadersRow();
+    for (const CounterSample& c : frame.counters) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn(); ImGui::TextUnformatted(c.name);
+        ImGui::TableNextColumn(); ImGui::Text("%.6g", c.value);
+    }
+    ImGui::EndTable();
+}
+
+} // namespace
+
+void DrawPanel()
+{
+    const std::vector<Frame>& frames = Frames();
+
+    bool recording = IsRecording();
+    if (ImGui::Checkbox("Record", &recording)) SetRecording(recording);
+    ImGui::SameLine();
+    if (ImGui::Button("Clear")) {
+        ClearFrames();
+        s_follow = true;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Export trace")) {
+        const char* path = "profile_trace.json";
+        s_status = ExportChromeTrace(path)
+            ? "Wrote " + std::to_string(frames.size()) + " frames to " + path
+            : std::string("Could not write ") + path;
+    }
+    ImGui::SameLine();
+    ImGui::TextDisabled(HasGpuTimers() ? "GPU timers on" : "GPU timers unavailable");
+    if (!s_status.empty()) ImGui::TextUnformatted(s_status.c_str());
+
+    DrawFrameGraph(frames);
+    if (frames.empty()) {
+        ImGui::TextDisabled(HOTONES_PROFILE ? "No frames recorded." : "Built with HOTONES_PROFILE=0.");
+        return;
+    }
+
+    const Frame* frame = nullptr;
+    if (!s_follow)
+        for (const Frame& f : frames)
+            if (f.index == s_selected) frame = &f;
+    if (!frame) {   // following, or the selected frame has scrolled out
+        frame      = &frames.back();
+        s_selected = frame->index;
+        s_follow   = true;
+    }
+
+    int64_t gpu = 0;
+    for (const ZoneEvent& z : frame->gpu)
+        if (z.depth == 0) gpu += z.end - z.start;
+    ImGui::Text("Frame %llu: %.2f ms CPU, %.2f ms GPU", (unsigned long long)frame->index,
+                Ms(frame->end - frame->start), Ms(gpu));
+    if (frame->dropped) {
+        ImGui::SameLine();
+        ImGui::TextColored({ 1, 0.6f, 0.2f, 1 }, "(%zu zones dropped)", frame->dropped);
+    }
+    if (!s_follow) {
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Latest")) s_follow = true;
+    }
+
+    DrawTimeline(*frame);
+    DrawTotals(*frame);
+    DrawCounters(*frame);
+}
+
+} // namespace Hotones::Profile
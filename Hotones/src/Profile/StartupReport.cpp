@@ -0,0 +1,80 @@
+// StartupReport.cpp — per-stage startup timings and their table
+
+#include <Profile/StartupReport.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace Hotones::Profile {
+
+namespace {
+
+std::mutex                g_mutex;
+std::vector<StartupStage> g_stages;
+std::thread::id           g_mainThread;
+int64_t                   g_begin      = 0;
+int64_t                   g_firstFrame = 0;   // 0 → not reached yet
+
+double Ms(int64_t ns) { return (double)ns / 1.0e6; }
+
+} // namespace
+
+void BeginStartup()
+{
+    std::lock_guard<std::mutex> lk(g_mutex);
+    g_stages.clear();
+    g_mainThread = std::this_thread::get_id();
+    g_begin      = Now();
+    g_firstFrame = 0;
+}
+
+void RecordStage(const char* name, int64_t start, int64_t end)
+{
+    std::lock_guard<std::mutex> lk(g_mutex);
+    g_stages.push_back({ name, start, end, std::this_thread::get_id() == g_mainThread });
+}
+
+void EndStartup()
+{
+    std::lock_guard<std::mutex> lk(g_mutex);
+    if (g_firstFrame == 0) g_firstFrame = Now();
+}
+
+std::vector<StartupStage> StartupStages()
+{
+    std::vector<StartupStage> stages;
+    {
+        std::lock_guard<std::mutex> lk(g_mutex);
+        stages = g_stages;
+    }
+    std::stable_sort(stages.begin(), stages.end(),
+                     [](const StartupStage& a, const StartupStage& b) { return a.start < b.start; });
+    return stages;
+}
+
+void PrintStartupReport()
+{
+    const std::vector<StartupStage> stages = StartupStages();
+    int64_t begin, firstFrame;
+    {
+        std::lock_guard<std::mutex> lk(g_mutex);
+        begin      = g_begin;
+        firstFrame = g_firstFrame;
+    }
+
+    int64_t serial = 0;
+    std::printf("Startup stages            start ms    took ms  thread\n");
+    for (const StartupStage& s : stages) {
+        std::printf("  %-22s %10.1f %10.1f  %s\n", s.name, Ms(s.start - begin), Ms(s.end - s.start),
+                    s.main ? "main" : "job");
+        serial += s.end - s.start;
+    }
+    if (firstFrame != 0)
+        std::printf("First frame after %.1f ms (stages add up to %.1f ms)\n", Ms(firstFrame - begin), Ms(serial));
+    else
+        std::printf("No frame drawn yet (stages add up to %.1f ms)\n", Ms(serial));
+    std::fflush(stdout);
+}
+
+} // namespace Hotones::Profile
@@ -0,0 +1,382 @@
+// SessionLog.cpp — session recording and replay.  File layout (native byte
+// order, checked on load; counts and lengths are LEB128 varints):
+//
+//   char magic[8] "HOREPLAY", uint32 version, uint32 byte order
+//   header:  pakPath (length, bytes), uint8 netMode, uint64 seed, double clock,
+//            input, prelude packets
+//   frames:  float dt, input, packets (when the input's fields say so),
+//            one after another up to the end of the file
+//
+// An input is a fields byte, then the fields it names, each against the
+// input before it (the header's against an empty one): toggled keys,
+// OS-repeated keys, mouse buttons and position when they changed, delta
+// and wheel when non-zero, typed codepoints.  A packet list is a count,
+// then ip (uint32), port (uint16), length and bytes for each.
+
+#include "../include/Replay/SessionLog.hpp"
+#include <Time/FixedTimestep.hpp>
+#include <Time/FrameClock.hpp>
+#include <raylib.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace Hotones::Replay {
+
+namespace {
+
+constexpr char     REPLAY_MAGIC[8]   = { 'H', 'O', 'R', 'E', 'P', 'L', 'A', 'Y' };
+constexpr uint32_t REPLAY_VERSION    = 1;
+constexpr uint32_t REPLAY_BYTE_ORDER = 0x01020304u;
+
+// Sanity limits on a record's counts, so a damaged file fails to read
+// rather than allocating without bound
+constexpr uint64_t MAX_CHARS       = 4096;
+constexpr uint64_t MAX_PACKETS     = 1u << 20;
+constexpr uint64_t MAX_PACKET_SIZE = 64 * 1024;
+constexpr uint64_t MAX_PAK_PATH    = 4096;
+
+// Which of an input's fields follow its fields byte
+enum : uint8_t {
+    FIELD_KEYS    = 1 << 0,   // keys toggled since the last input
+    FIELD_REPEAT  = 1 << 1,   // keys repeating this frame
+    FIELD_BUTTONS = 1 << 2,
+    FIELD_POS     = 1 << 3,
+    FIELD_DELTA   = 1 << 4,
+    FIELD_WHEEL   = 1 << 5,
+    FIELD_CHARS   = 1 << 6,
+    FIELD_PACKETS = 1 << 7,   // a frame's packet list follows the input
+};
+
+// ── Writing ──────────────────────────────────────────────────────────────────
+template<typename T>
+void PutRaw(std::vector<uint8_t>& b, const T& v)
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&v);
+    b.insert(b.end(), p, p + sizeof(T));
+}
+
+void PutVar(std::vector<uint8_t>& b, uint64_t v)
+{
+    while (v >= 0x80) {
+        b.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    b.push_back(static_cast<uint8_t>(v));
+}
+
+void PutKeys(std::vector<uint8_t>& b, const std::bitset<Input::FrameInput::KEY_COUNT>& keys)
+{
+    PutVar(b, keys.count());
+    for (int k = 0; k < Input::FrameInput::KEY_COUNT; ++k)
+        if (keys[k]) PutVar(b, (uint64_t)k);
+}
+
+bool SameVec(Vector2 a, Vector2 b) { return a.x == b.x && a.y == b.y; }
+
+uint8_t InputFields(const Input::FrameInput& prev, const Input::FrameInput& cur)
+{
+    uint8_t f = 0;
+    if (cur.keysDown != prev.keysDown)                    f |= FIELD_KEYS;
+    if (cur.keysRepeat.any())                             f |= FIELD_REPEAT;
+    if (cur.mouseDown != prev.mouseDown)                  f |= FIELD_BUTTONS;
+    if (!SameVec(cur.mousePos, prev.mousePos))            f |= FIELD_POS;
+    if (cur.mouseDelta.x != 0.f || cur.mouseDelta.y != 0.f) f |= FIELD_DELTA;
+    if (cur.mouseWheel != 0.f)                            f |= FIELD_WHEEL;
+    if (!cur.chars.empty())                               f |= FIELD_CHARS;
+    return f;
+}
+
+void PutInput(std::vector<uint8_t>& b, const Input::FrameInput& prev, const Input::FrameInput& cur,
+              uint8_t fields)
+{
+    b.push_back(fields);
+    if (fields & FIELD_KEYS)    PutKeys(b, cur.keysDown ^ prev.keysDown);
+    if (fields & FIELD_REPEAT)  PutKeys(b, cur.keysRepeat);
+    if (fields & FIELD_BUTTONS) b.push_back(cur.mouseDown);
+    if (fields & FIELD_POS)     { PutRaw(b, cur.mousePos.x);   PutRaw(b, cur.mousePos.y); }
+    if (fields & FIELD_DELTA)   { PutRaw(b, cur.mouseDelta.x); PutRaw(b, cur.mouseDelta.y); }
+    if (fields & FIELD_WHEEL)   PutRaw(b, cur.mouseWheel);
+    if (fields & FIELD_CHARS) {
+        PutVar(b, cur.chars.size());
+        for (int c : cur.chars) PutVar(b, (uint32_t)c);
+    }
+}
+
+void PutPackets(std::vector<uint8_t>& b, const std::vector<SessionPacket>& packets)
+{
+    PutVar(b, packets.size());
+    for (const SessionPacket& p : packets) {
+        PutRaw(b, p.ip);
+        PutRaw(b, p.port);
+        PutVar(b, p.data.size());
+        b.insert(b.end(), p.data.begin(), p.data.end());
+    }
+}
+
+// ── Reading ──────────────────────────────────────────────────────────────────
+// Reads from a stream; any short read or bad value clears `ok`, and later
+// reads return zeros
+struct Reader {
+    std::istream& in;
+    bool          ok = true;
+
+    bool Bytes(void* p, size_t n) {
+        if (ok && !in.read(static_cast<char*>(p), (std::streamsize)n)) ok = false;
+        return ok;
+    }
+    template<typename T>
+    T Raw() {
+        T v{};
+        Bytes(&v, sizeof(T));
+        return v;
+    }
+    uint64_t Var() {
+        uint64_t v = 0;
+        for (int shift = 0; ok && shift < 64; shift += 7) {
+            const int c = in.get();
+            if (c == std::char_traits<char>::eof()) break;
+            v |= (uint64_t)(c & 0x7f) << shift;
+            if (!(c & 0x80)) return v;
+        }
+        ok = false;
+        return 0;
+    }
+    // A count no larger than `max`
+    uint64_t Count(uint64_t max) {
+        const uint64_t n = Var();
+        if (n > max) ok = false;
+        return ok ? n : 0;
+    }
+};
+
+void GetKeys(Reader& r, std::bitset<Input::FrameInput::KEY_COUNT>& keys)
+{
+    for (uint64_t n = r.Count(Input::FrameInput::KEY_COUNT); n > 0; --n) {
+        const uint64_t k = r.Count(Input::FrameInput::KEY_COUNT - 1);
+        if (r.ok) keys.flip((size_t)k);
+    }
+}
+
+// The input after `prev`; returns its fields byte
+uint8_t GetInput(Reader& r, const Input::FrameInput& prev, Input::FrameInput& cur)
+{
+    const uint8_t fields = r.Raw<uint8_t>();
+    cur.keysDown   = prev.keysDown;
+    cur.keysRepeat.reset();
+    cur.mouseDown  = prev.mouseDown;
+    cur.mousePos   = prev.mousePos;
+    cur.mouseDelta = { 0, 0 };
+    cur.mouseWheel = 0.f;
+    cur.chars.clear();
+    if (fields & FIELD_KEYS)    GetKeys(r, cur.keysDown);
+    if (fields & FIELD_REPEAT)  GetKeys(r, cur.keysRepeat);
+    if (fields & FIELD_BUTTONS) cur.mouseDown = r.Raw<uint8_t>();
+    if (fields & FIELD_POS)     { cur.mousePos.x   = r.Raw<float>(); cur.mousePos.y   = r.Raw<float>(); }
+    if (fields & FIELD_DELTA)   { cur.mouseDelta.x = r.Raw<float>(); cur.mouseDelta.y = r.Raw<float>(); }
+    if (fields & FIELD_WHEEL)   cur.mouseWheel = r.Raw<float>();
+    if (fields & FIELD_CHARS)
+        for (uint64_t n = r.Count(MAX_CHARS); n > 0; --n) cur.chars.push_back((int)r.Var());
+    return fields;
+}
+
+void GetPackets(Reader& r, std::vector<SessionPacket>& packets)
+{
+    packets.clear();
+    for (uint64_t n = r.Count(MAX_PACKETS); n > 0 && r.ok; --n) {
+        SessionPacket p;
+        p.ip   = r.Raw<uint32_t>();
+        p.port = r.Raw<uint16_t>();
+        p.data.resize((size_t)r.Count(MAX_PACKET_SIZE));
+        r.Bytes(p.data.data(), p.data.size());
+        packets.push_back(std::move(p));
+    }
+}
+
+} // namespace
+
+// ─── SessionRecorder ──────────────────────────────────────────────────────────
+
+bool SessionRecorder::Open(const std::string& path)
+{
+    m_out.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_out) {
+        TraceLog(LOG_ERROR, "[Replay] Cannot write session log %s", path.c_str());
+        return false;
+    }
+    m_path = path;
+    return true;
+}
+
+void SessionRecorder::Attach(Net::NetworkManager& nm)
+{
+    nm.OnDatagram = [this](uint32_t ip, uint16_t port, const uint8_t* data, size_t len) {
+        if (m_out.is_open()) m_packets.push_back({ ip, port, std::vector<uint8_t>(data, data + len) });
+    };
+}
+
+void SessionRecorder::Anchor(const std::string& pakPath, Net::NetworkManager::Mode netMode, uint64_t seed)
+{
+    if (!m_out.is_open() || m_anchored) return;
+    Time::FixedTimestep::Get().Reset();
+    m_header.pakPath = pakPath;
+    m_header.netMode = netMode;
+    m_header.seed    = seed;
+    m_header.clock   = Time::FrameClock::Get().Now();
+    m_anchored       = true;
+}
+
+void SessionRecorder::EndFrame(float dt, const Input::FrameInput& input)
+{
+    if (!m_out.is_open() || !m_anchored) return;
+    m_buf.clear();
+    if (!m_headerWritten) {
+        // The anchor frame: its input and everything received so far
+        m_header.input       = input;
+        m_header.input.chars.clear();
+        m_header.prelude     = std::move(m_packets);
+        m_buf.insert(m_buf.end(), REPLAY_MAGIC, REPLAY_MAGIC + sizeof(REPLAY_MAGIC));
+        PutRaw(m_buf, REPLAY_VERSION);
+        PutRaw(m_buf, REPLAY_BYTE_ORDER);
+        PutVar(m_buf, m_header.pakPath.size());
+        m_buf.insert(m_buf.end(), m_header.pakPath.begin(), m_header.pakPath.end());
+        PutRaw(m_buf, (uint8_t)m_header.netMode);
+        PutRaw(m_buf, m_header.seed);
+        PutRaw(m_buf, m_header.clock);
+        const Input::FrameInput none;
+        PutInput(m_buf, none, m_header.input, InputFields(none, m_header.input));
+        PutPackets(m_buf, m_header.prelude);
+        m_header.prelude.clear();
+        m_prev          = m_header.input;
+        m_headerWritten = true;
+    } else {
+        uint8_t fields = InputFields(m_prev, input);
+        if (!m_packets.empty()) fields |= FIELD_PACKETS;
+        PutRaw(m_buf, dt);
+        PutInput(m_buf, m_prev, input, fields);
+        if (fields & FIELD_PACKETS) PutPackets(m_buf, m_packets);
+        m_prev = input;
+        ++m_frames;
+    }
+    m_packets.clear();
+    m_out.write(reinterpret_cast<const char*>(m_buf.data()), (std::streamsize)m_buf.size());
+    m_bytes += m_buf.size();
+}
+
+void SessionRecorder::Close()
+{
+    if (!m_out.is_open()) return;
+    m_out.close();
+    if (!m_headerWritten)
+        TraceLog(LOG_WARNING, "[Replay] Gameplay never started; %s holds no session", m_path.c_str());
+    else
+        TraceLog(LOG_INFO, "[Replay] Recorded %llu frames (%.1f KB) to %s",
+                 (unsigned long long)m_frames, (double)m_bytes / 1024.0, m_path.c_str());
+    m_packets.clear();
+}
+
+// ─── SessionPlayer ────────────────────────────────────────────────────────────
+
+bool SessionPlayer::Open(const std::string& path)
+{
+    m_in.open(path, std::ios::binary);
+    if (!m_in) {
+        TraceLog(LOG_ERROR, "[Replay] Cannot open session log %s", path.c_str());
+        return false;
+    }
+    Reader r{ m_in };
+    char magic[sizeof(REPLAY_MAGIC)];
+    r.Bytes(magic, sizeof(magic));
+    const uint32_t version   = r.Raw<uint32_t>();
+    const uint32_t byteOrder = r.Raw<uint32_t>();
+    if (!r.ok || std::memcmp(magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0) {
+        TraceLog(LOG_ERROR, "[Replay] %s is not a session log", path.c_str());
+        return false;
+    }
+    if (version != REPLAY_VERSION || byteOrder != REPLAY_BYTE_ORDER) {
+        TraceLog(LOG_ERROR, "[Replay] %s: version %u log, or from another byte order", path.c_str(), version);
+        return false;
+    }
+
+    m_header.pakPath.resize((size_t)r.Count(MAX_PAK_PATH));
+    r.Bytes(m_header.pakPath.data(), m_header.pakPath.size());
+    const uint8_t mode = r.Raw<uint8_t>();
+    if (mode > (uint8_t)Net::NetworkManager::Mode::Master) r.ok = false;
+    m_header.netMode = (Net::NetworkManager::Mode)mode;
+    m_header.seed    = r.Raw<uint64_t>();
+    m_header.clock   = r.Raw<double>();
+    GetInput(r, Input::FrameInput{}, m_header.input);
+    GetPackets(r, m_header.prelude);
+    if (!r.ok) {
+        TraceLog(LOG_ERROR, "[Replay] %s: damaged header", path.c_str());
+        return false;
+    }
+    m_prev = m_header.input;
+    return true;
+}
+
+void SessionPlayer::Start(Net::NetworkManager& nm)
+{
+    Time::FrameClock::Get().SetNow(m_header.clock);
+    Time::FixedTimestep::Get().Reset();
+    Input::InputHandler::Get().Replay(m_header.input);
+    Inject(nm, m_header.prelude);
+    m_header.prelude.clear();
+    m_header.prelude.shrink_to_fit();
+}
+
+bool SessionPlayer::Next(SessionFrame& frame)
+{
+    if (!m_in.is_open() || m_in.peek() == std::char_traits<char>::eof()) return false;
+    Reader r{ m_in };
+    frame.dt = r.Raw<float>();
+    const uint8_t fields = GetInput(r, m_prev, frame.input);
+    if (fields & FIELD_PACKETS) GetPackets(r, frame.packets);
+    else                        frame.packets.clear();
+    if (!r.ok || !std::isfinite(frame.dt)) {
+        TraceLog(LOG_WARNING, "[Replay] Damaged record after frame %llu; stopping there",
+                 (unsigned long long)m_frames);
+        m_in.close();
+        return false;
+    }
+    m_prev = frame.input;
+    ++m_frames;
+    return true;
+}
+
+void SessionPlayer::Inject(Net::NetworkManager& nm, const std::vector<SessionPacket>& packets)
+{
+    if (nm.GetMode() == Net::NetworkManager::Mode::None) return;
+    for (const SessionPacket& p : packets) {
+        if (nm.InjectDatagram(p.ip, p.port, p.data.data(), p.data.size())) continue;
+        // The ring is full (a long prelude): let Update() take what is queued
+        nm.Update();
+        nm.InjectDatagram(p.ip, p.port, p.data.data(), p.data.size());
+    }
+}
+
+// ─── Report ───────────────────────────────────────────────────────────────────
+
+void PrintFrameTimes(std::vector<double> frameMs)
+{
+    if (frameMs.empty()) {
+        std::printf("Replay: no frames replayed\n");
+        std::fflush(stdout);
+        return;
+    }
+    std::sort(frameMs.begin(), frameMs.end());
+    double total = 0.0;
+    for (double ms : frameMs) total += ms;
+    // Nearest rank
+    auto pct = [&](double p) {
+        const size_t rank = (size_t)std::ceil(p * (double)frameMs.size());
+        return frameMs[std::clamp<size_t>(rank, 1, frameMs.size()) - 1];
+    };
+    std::printf("Replay: %zu frames in %.1f ms\n", frameMs.size(), total);
+    std::printf("  frame ms    mean %7.3f   p50 %7.3f   p90 %7.3f   p99 %7.3f   max %7.3f\n",
+                total / (double)frameMs.size(), pct(0.50), pct(0.90), pct(0.99), frameMs.back());
+    std::fflush(stdout);
+}
+
+} // namespace Hotones::Replay
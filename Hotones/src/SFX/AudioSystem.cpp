@@ -6,6 +6,13 @@ namespace Ho_tones {
 static int g_sampleRate = 44100;
 static int g_channels = 2;
 
+// Mixes SoundBus's voices; raylib pulls it from its audio thread
+static AudioStream g_mixStream{};
+
+static void MixCallback(void* buffer, unsigned int frames) {
+    GetSoundBus().MixInto(static_cast<float*>(buffer), frames, g_sampleRate, g_channels);
+}
+
 bool InitAudioSystem(int sampleRate, int channels) {
     g_sampleRate = sampleRate > 0 ? sampleRate : 44100;
     g_channels = channels > 0 ? channels : 2;
@@ -15,11 +22,25 @@ bool InitAudioSystem(int sampleRate, int channels) {
     }
 
     SetMasterVolume(1.0f);
-    return IsAudioDeviceReady();
+    if (!IsAudioDeviceReady()) return false;
+
+    GetSoundBus();   // constructed before the callback can reach it
+    if (!IsAudioStreamValid(g_mixStream)) {
+        g_mixStream = LoadAudioStream((unsigned)g_sampleRate, 32, (unsigned)g_channels);
+        SetAudioStreamCallback(g_mixStream, MixCallback);
+        PlayAudioStream(g_mixStream);
+    }
+    return true;
 }
 
 void ShutdownAudioSystem() {
-    // Stop any queued sounds via the global SoundBus before closing audio device.
+    // Nothing mixes once the stream is gone; then stop any queued sounds via
+    // the global SoundBus before closing audio device.
+    if (IsAudioStreamValid(g_mixStream)) {
+        StopAudioStream(g_mixStream);
+        UnloadAudioStream(g_mixStream);
+        g_mixStream = {};
+    }
     GetSoundBus().StopAll();
     if (IsAudioDeviceReady()) CloseAudioDevice();
 }
@@ -8,41 +8,242 @@
 #include <cstdint>
 #include <thread>
 #include <chrono>
+#include <atomic>
+#include <condition_variable>
 #include <filesystem>
-#include <fstream>
-#include <sstream>
 #include <system_error>
 #include <SoundBus.hpp>
+#include <ECS/SimdKernels.hpp>
 #include <raylib.h>
+#include <Assets/AssetCache.hpp>
 #include <Assets/AssetLoader.hpp>
+#include <Assets/Vfs.hpp>
+#include <Memory/MemoryTracker.hpp>
 #include <random>
 
 namespace Ho_tones {
 
-    // Keep track of raylib-created Sounds and their temp filenames so we can stop/unload them from StopAll().
+    // Keep track of raylib-created Sounds so we can stop/unload them from StopAll().
     static std::vector<Sound> raylibSounds;
-    static std::vector<std::string> raylibTempFiles;
-    // Loaded named sounds (from disk assets).
-    // Store the original Sound plus its Wave so we can create fresh Sound
-    // instances from the in-memory Wave for overlapping playback without
-    // reading from disk repeatedly.
-    struct LoadedEntry { Sound sound; Wave wave; std::string path; };
-    static std::unordered_map<std::string, std::vector<LoadedEntry>> loadedSounds;
-    // Round-robin index for sequential playback per-name
-    static std::unordered_map<std::string, size_t> sequentialIndex;
+    // Samples shared by every voice playing them.  A 16-bit wave's are its
+    // own samples, read in place; other formats get a 16-bit copy.
+    struct SoundBus::PcmBuffer {
+        Hotones::Assets::WaveHandle wave;   // keeps `samples` alive when they are the wave's
+        std::vector<int16_t> converted;     // or they live here
+        Hotones::Memory::TaggedBytes convertedBytes{ Hotones::Memory::Tag::Audio };
+        const int16_t* samples = nullptr;   // interleaved
+        size_t frames = 0;
+        int sampleRate = 0;
+        int channels = 0;
+    };
+    using SharedPcm = std::shared_ptr<const SoundBus::PcmBuffer>;
+
+    // Loaded named sounds (from disk assets).  Waves come from the
+    // AssetCache, so names using the same file share one copy.
+    struct LoadedEntry {
+        SharedPcm pcm;
+        std::string path;
+        uint32_t lastVoice = 0;   // PlayRandom/PlaySequential restart it
+    };
+    struct SoundGroup {
+        std::vector<LoadedEntry> variants;
+        size_t next = 0;          // round-robin index for sequential playback
+        int priority = 0;
+        int maxInstances = 0;     // 0: no limit but the pool's
+        uint64_t key = 0;         // the voices' group; never 0
+    };
+    static std::unordered_map<std::string, SoundGroup> loadedSounds;
+    static uint64_t lastGroupKey = 0;
     static std::mt19937 rng((unsigned)std::chrono::high_resolution_clock::now().time_since_epoch().count());
 
+    // PlayPCM buffers by content, so a procedural sound played again reuses
+    // its samples instead of copying them; least recently played go first
+    struct CachedPcm {
+        SharedPcm pcm;
+        uint64_t lastUse = 0;
+    };
+    static std::unordered_map<uint64_t, CachedPcm> pcmCache;
+    static uint64_t pcmCacheClock = 0;
+    static constexpr size_t PCM_CACHE_ENTRIES = 32;
+
+    static SoundGroup& GroupFor(const std::string& name) {
+        SoundGroup& g = loadedSounds[name];
+        if (g.key == 0) g.key = ++lastGroupKey;
+        return g;
+    }
+
+    // Streamed files (LoadStreamFile).  raylib's Music decodes a chunk into
+    // the stream's buffers each time one has been played; the pump thread
+    // asks for that every STREAM_PUMP_INTERVAL, well within the time a
+    // buffer lasts, so the main thread never decodes and frame hitches
+    // don't starve the device.  Every call on a stream's Music holds
+    // streamsMutex, as its decoder isn't thread-safe.
+    struct StreamEntry {
+        Music music{};
+        Hotones::Assets::FileView bytes;   // a mounted file, which the decoder reads in place
+        std::string path;
+        float gain = 1.0f;
+        bool loop = true;
+        bool playing = false;
+    };
+    static std::unordered_map<std::string, std::unique_ptr<StreamEntry>> streams;
+    static std::mutex streamsMutex;
+    static std::condition_variable streamsWake;
+    static std::thread streamPump;
+    static bool streamPumpStop = false;   // guarded by streamsMutex
+    static constexpr std::chrono::milliseconds STREAM_PUMP_INTERVAL{ 10 };
+
+    // Open `path` for streaming into `e`.  Files on disk are read as they
+    // play; one inside a mounted .cup is decoded from its (compressed)
+    // bytes, which `e` keeps.
+    static bool OpenStream(StreamEntry& e, const std::string& path) {
+        e.bytes = {};
+        if (Hotones::Assets::Vfs::Get().Exists(path)) {
+            e.bytes = Hotones::Assets::ReadFile(path);
+            if (!e.bytes) return false;
+            const std::string ext = std::filesystem::path(path).extension().string();
+            e.music = LoadMusicStreamFromMemory(ext.c_str(), e.bytes.data, (int)e.bytes.size);
+        } else {
+            e.music = LoadMusicStream(path.c_str());
+        }
+        if (!IsMusicValid(e.music)) {
+            e.bytes = {};
+            return false;
+        }
+        e.music.looping = e.loop;
+        e.path = path;
+        return true;
+    }
+
+    static void PumpStreams() {
+        std::unique_lock<std::mutex> lk(streamsMutex);
+        while (!streamPumpStop) {
+            for (auto& [name, e] : streams) {
+                if (!e->playing) continue;
+                UpdateMusicStream(e->music);
+                if (!IsMusicStreamPlaying(e->music)) e->playing = false;   // a one-shot ran out
+            }
+            streamsWake.wait_for(lk, STREAM_PUMP_INTERVAL);
+        }
+    }
+
+    // Mixing in blocks: stack buffers, in samples
+    static constexpr size_t MIX_BLOCK_SAMPLES  = 1024;   // resampled, output layout
+    static constexpr size_t MIX_SOURCE_SAMPLES = 2048;   // converted source frames
+    static constexpr int    MAX_MIX_CHANNELS   = 8;
+
+    // `wave` as voices play it; nullptr if it has no samples or too many channels
+    static SharedPcm MakePcm(Hotones::Assets::WaveHandle wave) {
+        if (!wave || !wave->data || wave->frameCount == 0 ||
+            wave->channels <= 0 || wave->channels > MAX_MIX_CHANNELS) return nullptr;
+        auto pcm = std::make_shared<SoundBus::PcmBuffer>();
+        pcm->frames     = wave->frameCount;
+        pcm->sampleRate = (int)wave->sampleRate;
+        pcm->channels   = (int)wave->channels;
+        if (wave->sampleSize == 16) {
+            pcm->samples = static_cast<const int16_t*>(wave->data);
+        } else {
+            Wave copy = WaveCopy(*wave);
+            WaveFormat(&copy, (int)copy.sampleRate, 16, (int)copy.channels);
+            const int16_t* data = static_cast<const int16_t*>(copy.data);
+            if (data) pcm->converted.assign(data, data + (size_t)copy.frameCount * copy.channels);
+            UnloadWave(copy);
+            if (pcm->converted.size() != pcm->frames * (size_t)pcm->channels) return nullptr;
+            pcm->samples = pcm->converted.data();
+            pcm->convertedBytes.Set(pcm->converted.capacity() * sizeof(int16_t));
+        }
+        pcm->wave = std::move(wave);
+        return pcm;
+    }
+
+    // `data` as voices play it, from pcmCache when the same samples were played before
+    static SharedPcm PcmFor(const std::vector<int16_t>& data, int sampleRate, int channels) {
+        const size_t bytes = data.size() * sizeof(int16_t);
+        uint64_t key = 14695981039346656037ull;   // FNV-1a
+        const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+        for (size_t i = 0; i < bytes; ++i) key = (key ^ p[i]) * 1099511628211ull;
+        key = (key ^ ((uint64_t)sampleRate << 8 | (uint64_t)channels)) * 1099511628211ull;
+
+        auto it = pcmCache.find(key);
+        if (it != pcmCache.end()) {
+            const SoundBus::PcmBuffer& c = *it->second.pcm;
+            if (c.sampleRate == sampleRate && c.channels == channels && c.converted == data) {
+                it->second.lastUse = ++pcmCacheClock;
+                return it->second.pcm;
+            }
+        }
+
+        auto pcm = std::make_shared<SoundBus::PcmBuffer>();
+        pcm->converted  = data;
+        pcm->samples    = pcm->converted.data();
+        pcm->convertedBytes.Set(pcm->converted.capacity() * sizeof(int16_t));
+        pcm->frames     = data.size() / (size_t)channels;
+        pcm->sampleRate = sampleRate;
+        pcm->channels   = channels;
+        if (pcmCache.size() >= PCM_CACHE_ENTRIES && it == pcmCache.end()) {
+            auto oldest = std::min_element(pcmCache.begin(), pcmCache.end(), [](const auto& a, const auto& b) {
+                return a.second.lastUse < b.second.lastUse;
+            });
+            pcmCache.erase(oldest);   // voices still playing it keep their reference
+        }
+        pcmCache[key] = { pcm, ++pcmCacheClock };
+        return pcm;
+    }
+
+    // dst[i] = src[i] / 32768 for i in [0, n)
+    static void Int16ToFloat(float* dst, const int16_t* src, size_t n) {
+        constexpr float scale = 1.0f / 32768.0f;
+        size_t i = 0;
+#if defined(HOTONES_SIMD_AVX2)
+        const __m256 s = _mm256_set1_ps(scale);
+        for (; i + 8 <= n; i += 8) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v)), s));
+        }
+#elif defined(HOTONES_SIMD_SSE2)
+        const __m128 s = _mm_set1_ps(scale);
+        for (; i + 8 <= n; i += 8) {
+            const __m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            // Each int16 into the top half of a lane, shifted down with its sign
+            const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+            const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+            _mm_storeu_ps(dst + i,     _mm_mul_ps(_mm_cvtepi32_ps(lo), s));
+            _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), s));
+        }
+#elif defined(HOTONES_SIMD_NEON)
+        for (; i + 8 <= n; i += 8) {
+            const int16x8_t v = vld1q_s16(src + i);
+            vst1q_f32(dst + i,     vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), scale));
+            vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), scale));
+        }
+#endif
+        for (; i < n; ++i) dst[i] = (float)src[i] * scale;
+    }
+
+    // A pool entry as the audio thread sees it.  The samples belong to the
+    // PcmBuffer in the matching Slot, which outlives the audio thread's use.
     struct SoundBus::Voice {
-        std::vector<int16_t> samples; // interleaved
+        uint32_t id = 0;                    // 0: silent
+        const int16_t* samples = nullptr;   // interleaved
+        size_t frames = 0;
         int sampleRate = 44100;
         int channels = 1;
         float gain = 1.0f; // per-voice
-        float playbackPos = 0.0f; // in frames
-        size_t frameCount() const { return samples.empty() ? 0 : samples.size() / channels; }
+        float pan = 0.0f;
+        float rate = 1.0f;
+        bool loop = false;
+        uint64_t startFrame = 0;  // output frame to start on
+        double playbackPos = 0.0; // in frames
     };
 
+    // The rates SetVoiceParams / PlaySpatial accept
+    static constexpr float MIN_VOICE_RATE = 0.125f;
+    static constexpr float MAX_VOICE_RATE = 8.0f;
+
     int SoundBus::SetVolume(int newVolume) {
         volume = std::max(0, std::min(100, newVolume));
+        std::lock_guard<std::mutex> lk(streamsMutex);
+        for (auto& [name, e] : streams) SetMusicVolume(e->music, e->gain * volume / 100.0f);
         return volume;
     }
 
@@ -50,13 +251,145 @@ namespace Ho_tones {
         return volume;
     }
 
-    SoundBus::SoundBus() : volume(100) {
+    SoundBus::SoundBus()
+        : voices(new Voice[MAX_VOICES]), slots(new Slot[MAX_VOICES]), volume(100) {
+        released.reserve(VOICE_COMMANDS + MAX_VOICES);
     }
 
     SoundBus::~SoundBus() {
         StopAll();
     }
 
+    bool SoundBus::PushCommand(const VoiceCommand& cmd) {
+        if (!commands.TryPush(cmd)) return false;
+        pushedCommands++;
+        return true;
+    }
+
+    void SoundBus::CollectFinished() {
+        while (FinishedVoice* f = finished.Front()) {
+            Slot& s = slots[f->slot];
+            if (s.id == f->id) {   // not restarted since
+                s.id = 0;
+                s.pcm.reset();
+            }
+            finished.Pop();
+        }
+        const uint64_t applied = appliedCommands.load(std::memory_order_acquire);
+        std::erase_if(released, [applied](const ReleasedPcm& r) { return r.seq <= applied; });
+    }
+
+    int SoundBus::PickSlot(uint64_t group, int priority, int maxInstances, float distance) const {
+        // Whether `a` matters less than `b`
+        auto lesser = [](const Slot& a, const Slot& b) {
+            if (a.priority != b.priority) return a.priority < b.priority;
+            if (a.distance != b.distance) return a.distance > b.distance;
+            return a.started < b.started;
+        };
+        int freeSlot = -1, worst = -1, worstInGroup = -1, inGroup = 0;
+        for (int i = 0; i < (int)MAX_VOICES; ++i) {
+            const Slot& s = slots[i];
+            if (s.id == 0) {
+                if (freeSlot < 0) freeSlot = i;
+                continue;
+            }
+            if (worst < 0 || lesser(s, slots[worst])) worst = i;
+            if (group != 0 && s.group == group) {
+                inGroup++;
+                if (worstInGroup < 0 || lesser(s, slots[worstInGroup])) worstInGroup = i;
+            }
+        }
+
+        int victim = worst;
+        if (maxInstances > 0 && inGroup >= maxInstances) victim = worstInGroup;
+        else if (freeSlot >= 0) return freeSlot;
+
+        // The newest of equals wins
+        const Slot& v = slots[victim];
+        if (priority < v.priority || (priority == v.priority && distance > v.distance)) return -1;
+        return victim;
+    }
+
+    uint32_t SoundBus::StartVoice(PcmHandle pcm, uint64_t group, int priority, int maxInstances,
+                                  const VoiceParams& params, bool loop, uint64_t startFrame) {
+        CollectFinished();
+        const int i = PickSlot(group, priority, maxInstances, params.distance);
+        if (i < 0) return 0;
+
+        uint32_t id = nextVoiceId++;
+        if (id == 0) id = nextVoiceId++;   // wrapped: 0 means "none"
+        VoiceCommand cmd;
+        cmd.type       = VoiceCommand::Type::Play;
+        cmd.slot       = (uint32_t)i;
+        cmd.id         = id;
+        cmd.loop       = loop;
+        cmd.gain       = params.gain;
+        cmd.pan        = std::clamp(params.pan, -1.0f, 1.0f);
+        cmd.rate       = std::clamp(params.rate, MIN_VOICE_RATE, MAX_VOICE_RATE);
+        cmd.samples    = pcm->samples;
+        cmd.frames     = pcm->frames;
+        cmd.sampleRate = pcm->sampleRate;
+        cmd.channels   = pcm->channels;
+        cmd.startFrame = startFrame;
+        if (!PushCommand(cmd)) return 0;
+
+        Slot& s = slots[i];
+        if (s.id != 0) released.push_back({ std::move(s.pcm), pushedCommands });   // stolen
+        s.id       = id;
+        s.group    = group;
+        s.priority = priority;
+        s.distance = params.distance;
+        s.started  = ++startCounter;
+        s.pcm      = std::move(pcm);
+        return id;
+    }
+
+    void SoundBus::ApplyCommands() {
+        uint64_t applied = 0;
+        while (VoiceCommand* c = commands.Front()) {
+            switch (c->type) {
+            case VoiceCommand::Type::Play: {
+                Voice& v = voices[c->slot];
+                v.id          = c->id;
+                v.samples     = c->samples;
+                v.frames      = c->frames;
+                v.sampleRate  = c->sampleRate;
+                v.channels    = c->channels;
+                v.gain        = c->gain;
+                v.pan         = c->pan;
+                v.rate        = c->rate;
+                v.loop        = c->loop;
+                v.startFrame  = c->startFrame;
+                v.playbackPos = 0.0;
+                break;
+            }
+            case VoiceCommand::Type::Stop:
+            case VoiceCommand::Type::SetGain:
+            case VoiceCommand::Type::SetParams: {
+                Voice& v = voices[c->slot];
+                if (v.id != c->id) break;   // ended meanwhile
+                if (c->type == VoiceCommand::Type::Stop) {
+                    v.id = 0;
+                    break;
+                }
+                v.gain = c->gain;
+                if (c->type == VoiceCommand::Type::SetParams) {
+                    v.pan  = c->pan;
+                    v.rate = c->rate;
+                }
+                break;
+            }
+            case VoiceCommand::Type::StopAll:
+                for (size_t i = 0; i < MAX_VOICES; ++i) voices[i].id = 0;
+                break;
+            }
+            commands.Pop();
+            applied++;
+        }
+        // Everything the applied commands replaced is no longer read
+        if (applied) appliedCommands.fetch_add(applied, std::memory_order_release);
+    }
+
     void SoundBus::PlaySound(const std::string& soundName) {
         // Load and play a sound by path
         if (!IsAudioDeviceReady()) return;
@@ -80,149 +413,263 @@ namespace Ho_tones {
         try {
             // Resolve the path via the asset system so callers can pass
             // relative asset paths (e.g. "assets/foo.wav"). Fall back to the
-            // provided path if resolution fails.
+            // provided path if resolution fails.  Files inside a mounted
+            // .cup are taken as given; LoadWave reads them through the Vfs.
             std::string resolved = filePath;
             std::string found;
-            if (Ho_tones::Assets::FindAsset(filePath, found)) {
+            if (!Hotones::Assets::Vfs::Get().Exists(filePath) &&
+                Ho_tones::Assets::FindAsset(filePath, found)) {
                 resolved = found;
             }
 
-            // Load the wave into memory once and create a Sound from it. Keep
-            // both so we can spawn fresh Sound instances from the Wave later.
-            Wave w = LoadWave(resolved.c_str());
-            Sound s = LoadSoundFromWave(w);
-            LoadedEntry e; e.sound = s; e.wave = w; e.path = resolved;
-            loadedSounds[name].push_back(std::move(e));
+            // Decoded once; every voice playing it reads the same samples
+            SharedPcm pcm = MakePcm(Hotones::Assets::AssetCache::Get().LoadWave(resolved));
+            if (!pcm) return false;
+            LoadedEntry e; e.pcm = std::move(pcm); e.path = resolved;
+            GroupFor(name).variants.push_back(std::move(e));
             return true;
         } catch (...) {
             return false;
         }
     }
 
-    bool SoundBus::PlayLoaded(const std::string& name, float gain) {
-        // Play first variant (if any)
-        return PlayRandom(name, gain);
+    void SoundBus::SetSoundLimits(const std::string& name, int priority, int maxInstances) {
+        SoundGroup& g = GroupFor(name);
+        g.priority     = priority;
+        g.maxInstances = std::max(0, maxInstances);
     }
 
-    bool SoundBus::PlayRandom(const std::string& name, float gain) {
+    int SoundBus::ReloadFile(const std::string& filePath) {
+        if (!IsAudioDeviceReady()) return 0;
+        const std::string changed = Hotones::Assets::NormalisePath(filePath);
+        int reloaded = 0;
+        for (auto& [name, group] : loadedSounds) {
+            for (LoadedEntry& e : group.variants) {
+                if (Hotones::Assets::NormalisePath(e.path) != changed) continue;
+                // The cache sees the file changed and imports it anew; voices
+                // already playing finish on the old samples
+                SharedPcm pcm = MakePcm(Hotones::Assets::AssetCache::Get().LoadWave(e.path));
+                if (!pcm) continue;
+                e.pcm = std::move(pcm);
+                reloaded++;
+            }
+        }
+
+        std::lock_guard<std::mutex> lk(streamsMutex);
+        for (auto& [name, e] : streams) {
+            if (Hotones::Assets::NormalisePath(e->path) != changed) continue;
+            StreamEntry fresh;
+            fresh.loop = e->loop;
+            fresh.gain = e->gain;
+            if (!OpenStream(fresh, e->path)) continue;   // keep the old one playing
+            UnloadMusicStream(e->music);
+            fresh.playing = e->playing;
+            *e = std::move(fresh);
+            if (e->playing) {
+                SetMusicVolume(e->music, e->gain * volume / 100.0f);
+                PlayMusicStream(e->music);
+            }
+            reloaded++;
+        }
+        return reloaded;
+    }
+
+    bool SoundBus::LoadStreamFile(const std::string& name, const std::string& filePath, bool loop) {
         if (!IsAudioDeviceReady()) return false;
-        auto it = loadedSounds.find(name);
-        if (it == loadedSounds.end() || it->second.empty()) return false;
-        auto &vec = it->second;
-        std::uniform_int_distribution<size_t> dist(0, vec.size() - 1);
-        size_t idx = dist(rng);
-        Sound s = vec[idx].sound;
-        SetSoundVolume(s, gain);
-        ::PlaySound(s);
+        std::string resolved = filePath;
+        std::string found;
+        if (!Hotones::Assets::Vfs::Get().Exists(filePath) &&
+            Ho_tones::Assets::FindAsset(filePath, found)) {
+            resolved = found;
+        }
+
+        auto e = std::make_unique<StreamEntry>();
+        e->loop = loop;
+        if (!OpenStream(*e, resolved)) return false;
+
+        std::lock_guard<std::mutex> lk(streamsMutex);
+        auto& slot = streams[name];
+        if (slot) UnloadMusicStream(slot->music);
+        slot = std::move(e);
+        if (!streamPump.joinable()) {
+            streamPumpStop = false;
+            streamPump = std::thread(PumpStreams);
+        }
         return true;
     }
 
-    bool SoundBus::PlaySequential(const std::string& name, float gain) {
+    bool SoundBus::PlayStream(const std::string& name, float gain) {
+        if (!IsAudioDeviceReady()) return false;
+        std::lock_guard<std::mutex> lk(streamsMutex);
+        auto it = streams.find(name);
+        if (it == streams.end()) return false;
+        StreamEntry& e = *it->second;
+        e.gain = gain;
+        SetMusicVolume(e.music, gain * volume / 100.0f);
+        if (e.playing) StopMusicStream(e.music);   // rewinds it
+        PlayMusicStream(e.music);
+        UpdateMusicStream(e.music);   // the first buffers now, not a pump interval later
+        e.playing = true;
+        return true;
+    }
+
+    void SoundBus::StopStream(const std::string& name) {
+        std::lock_guard<std::mutex> lk(streamsMutex);
+        auto it = streams.find(name);
+        if (it == streams.end() || !it->second->playing) return;
+        StopMusicStream(it->second->music);
+        it->second->playing = false;
+    }
+
+    bool SoundBus::IsStreamPlaying(const std::string& name) {
+        std::lock_guard<std::mutex> lk(streamsMutex);
+        auto it = streams.find(name);
+        return it != streams.end() && it->second->playing;
+    }
+
+    bool SoundBus::PlayLoaded(const std::string& name, float gain, float distance) {
+        return PlayRandom(name, gain, distance);
+    }
+
+    bool SoundBus::PlayRandom(const std::string& name, float gain, float distance) {
+        if (!IsAudioDeviceReady()) return false;
+        auto it = loadedSounds.find(name);
+        if (it == loadedSounds.end() || it->second.variants.empty()) return false;
+        SoundGroup& g = it->second;
+        std::uniform_int_distribution<size_t> dist(0, g.variants.size() - 1);
+        LoadedEntry& e = g.variants[dist(rng)];
+        StopVoice(e.lastVoice);
+        e.lastVoice = StartVoice(e.pcm, g.key, g.priority, g.maxInstances, { 0, gain, 0.0f, 1.0f, distance });
+        return e.lastVoice != 0;
+    }
+
+    bool SoundBus::PlaySequential(const std::string& name, float gain, float distance) {
         if (!IsAudioDeviceReady()) return false;
         auto it = loadedSounds.find(name);
-        if (it == loadedSounds.end() || it->second.empty()) return false;
-        auto &vec = it->second;
-        size_t &idxRef = sequentialIndex[name];
-        if (idxRef >= vec.size()) idxRef = 0;
-        Sound s = vec[idxRef].sound;
+        if (it == loadedSounds.end() || it->second.variants.empty()) return false;
+        SoundGroup& g = it->second;
+        if (g.next >= g.variants.size()) g.next = 0;
+        LoadedEntry& e = g.variants[g.next];
         // advance for next call
-        idxRef = (idxRef + 1) % vec.size();
-        SetSoundVolume(s, gain);
-        ::PlaySound(s);
-        return true;
+        g.next = (g.next + 1) % g.variants.size();
+        StopVoice(e.lastVoice);
+        e.lastVoice = StartVoice(e.pcm, g.key, g.priority, g.maxInstances, { 0, gain, 0.0f, 1.0f, distance });
+        return e.lastVoice != 0;
     }
 
-    bool SoundBus::PlaySequentialAsync(const std::string& name, float gain) {
+    bool SoundBus::PlaySequentialAsync(const std::string& name, float gain, float distance) {
         if (!IsAudioDeviceReady()) return false;
         auto it = loadedSounds.find(name);
-        if (it == loadedSounds.end() || it->second.empty()) return false;
-        auto &vec = it->second;
-        size_t &idxRef = sequentialIndex[name];
-        if (idxRef >= vec.size()) idxRef = 0;
-        // Create a fresh Sound instance from the stored Wave so we can play
-        // overlapping copies without touching disk.
-        const LoadedEntry &entry = vec[idxRef];
-        idxRef = (idxRef + 1) % vec.size();
-
-        // Create a fresh Sound from the stored Wave so the same asset can be
-        // played multiple times overlapping without requiring PlaySoundMulti.
-        Sound s = LoadSoundFromWave(entry.wave);
-        SetSoundVolume(s, gain);
-        ::PlaySound(s);
-        raylibSounds.push_back(s);
-        return true;
+        if (it == loadedSounds.end() || it->second.variants.empty()) return false;
+        SoundGroup& g = it->second;
+        if (g.next >= g.variants.size()) g.next = 0;
+        const LoadedEntry& e = g.variants[g.next];
+        g.next = (g.next + 1) % g.variants.size();
+        // Another voice on the same samples: overlaps whatever plays already
+        return StartVoice(e.pcm, g.key, g.priority, g.maxInstances, { 0, gain, 0.0f, 1.0f, distance }) != 0;
     }
 
-    void SoundBus::PlayPCM(const std::vector<int16_t>& data, int sampleRate, int channels, float gain) {
-        if (data.empty() || sampleRate <= 0 || channels <= 0) return;
-        auto v = std::make_unique<Voice>();
-        v->samples = data;
-        v->sampleRate = sampleRate;
-        v->channels = channels;
-        v->gain = gain;
-        v->playbackPos = 0.0f;
+    int SoundBus::PlaySequence(const std::string& name, int count, float interval, float gain, float distance) {
+        if (!IsAudioDeviceReady() || count <= 0) return 0;
+        auto it = loadedSounds.find(name);
+        if (it == loadedSounds.end() || it->second.variants.empty()) return 0;
+        SoundGroup& g = it->second;
+
+        // On the mixer's timeline: the first voice in the next block it mixes
+        const int rate = mixSampleRate.load(std::memory_order_relaxed);
+        const double spacing = (double)std::max(interval, 0.0f) * (rate > 0 ? rate : 44100);
+        const uint64_t now = mixedFrames.load(std::memory_order_relaxed);
+        int scheduled = 0;
+        for (int k = 0; k < count; ++k) {
+            if (g.next >= g.variants.size()) g.next = 0;
+            const LoadedEntry& e = g.variants[g.next];
+            g.next = (g.next + 1) % g.variants.size();
+            const uint64_t at = now + (uint64_t)std::llround(spacing * k);
+            if (StartVoice(e.pcm, g.key, g.priority, g.maxInstances, { 0, gain, 0.0f, 1.0f, distance }, false, at))
+                scheduled++;
+        }
+        return scheduled;
+    }
 
-        std::lock_guard<std::mutex> lk(voicesMutex);
-        voices.push_back(std::move(v));
+    uint32_t SoundBus::PlayPCM(const std::vector<int16_t>& data, int sampleRate, int channels, float gain,
+                               int priority, float distance) {
+        if (data.empty() || sampleRate <= 0 || channels <= 0 || channels > MAX_MIX_CHANNELS) return 0;
+        if (data.size() < (size_t)channels) return 0;
+        return StartVoice(PcmFor(data, sampleRate, channels), 0, priority, 0, { 0, gain, 0.0f, 1.0f, distance });
     }
 
-    void SoundBus::PlayPCMViaRaylib(const std::vector<int16_t>& data, int sampleRate, int channels, float gain) {
-        if (data.empty() || sampleRate <= 0 || channels <= 0) return;
-        if (!IsAudioDeviceReady()) return;
+    uint32_t SoundBus::PlaySpatial(const std::string& name, const VoiceParams& params, bool loop) {
+        if (!IsAudioDeviceReady()) return 0;
+        auto it = loadedSounds.find(name);
+        if (it == loadedSounds.end() || it->second.variants.empty()) return 0;
+        SoundGroup& g = it->second;
+        std::uniform_int_distribution<size_t> dist(0, g.variants.size() - 1);
+        return StartVoice(g.variants[dist(rng)].pcm, g.key, g.priority, g.maxInstances, params, loop);
+    }
 
-        // Write a temporary WAV file and use raylib's LoadSound to load/play it.
-        try {
-            namespace fs = std::filesystem;
-            fs::path tmpdir = fs::temp_directory_path();
-            auto now = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-            std::ostringstream name;
-            name << "hotones_sound_" << now << ".wav";
-            fs::path tmpfile = tmpdir / name.str();
-
-            // WAV header fields
-            uint32_t sampleCount = (uint32_t)data.size(); // samples (frames * channels)
-            uint16_t bitsPerSample = 16;
-            uint16_t numChannels = (uint16_t)channels;
-            uint32_t byteRate = sampleRate * numChannels * bitsPerSample / 8;
-            uint16_t blockAlign = numChannels * bitsPerSample / 8;
-            uint32_t dataBytes = sampleCount * sizeof(int16_t);
-
-            std::ofstream ofs(tmpfile, std::ios::binary);
-            if (!ofs) return;
-
-            // RIFF header
-            ofs.write("RIFF", 4);
-            uint32_t chunkSize = 36 + dataBytes;
-            ofs.write(reinterpret_cast<const char*>(&chunkSize), 4);
-            ofs.write("WAVE", 4);
-
-            // fmt subchunk
-            ofs.write("fmt ", 4);
-            uint32_t subchunk1Size = 16;
-            ofs.write(reinterpret_cast<const char*>(&subchunk1Size), 4);
-            uint16_t audioFormat = 1; // PCM
-            ofs.write(reinterpret_cast<const char*>(&audioFormat), 2);
-            ofs.write(reinterpret_cast<const char*>(&numChannels), 2);
-            ofs.write(reinterpret_cast<const char*>(&sampleRate), 4);
-            ofs.write(reinterpret_cast<const char*>(&byteRate), 4);
-            ofs.write(reinterpret_cast<const char*>(&blockAlign), 2);
-            ofs.write(reinterpret_cast<const char*>(&bitsPerSample), 2);
-
-            // data subchunk
-            ofs.write("data", 4);
-            ofs.write(reinterpret_cast<const char*>(&dataBytes), 4);
-            ofs.write(reinterpret_cast<const char*>(data.data()), dataBytes);
-            ofs.close();
-
-            Sound s = LoadSound(tmpfile.string().c_str());
-            SetSoundVolume(s, gain);
-            ::PlaySound(s);
-
-            raylibSounds.push_back(s);
-            raylibTempFiles.push_back(tmpfile.string());
-        } catch (...) {
-            return;
+    int SoundBus::FindSlot(uint32_t id) const {
+        if (id == 0) return -1;
+        for (int i = 0; i < (int)MAX_VOICES; ++i)
+            if (slots[i].id == id) return i;
+        return -1;
+    }
+
+    bool SoundBus::IsVoicePlaying(uint32_t id) {
+        CollectFinished();
+        return FindSlot(id) >= 0;
+    }
+
+    void SoundBus::StopVoice(uint32_t id) {
+        const int i = FindSlot(id);
+        if (i < 0) return;
+        VoiceCommand cmd;
+        cmd.type = VoiceCommand::Type::Stop;
+        cmd.slot = (uint32_t)i;
+        cmd.id   = id;
+        if (!PushCommand(cmd)) return;   // plays on; freed when it ends
+        released.push_back({ std::move(slots[i].pcm), pushedCommands });
+        slots[i].id = 0;
+    }
+
+    void SoundBus::SetVoiceGain(uint32_t id, float gain) {
+        const int i = FindSlot(id);
+        if (i < 0) return;
+        VoiceCommand cmd;
+        cmd.type = VoiceCommand::Type::SetGain;
+        cmd.slot = (uint32_t)i;
+        cmd.id   = id;
+        cmd.gain = gain;
+        PushCommand(cmd);
+    }
+
+    size_t SoundBus::SetVoiceParams(const VoiceParams* params, size_t count) {
+        CollectFinished();
+        // Written in place and published once, so the audio thread applies
+        // the whole batch in the same mix
+        const size_t room = commands.Claimable(count);
+        size_t queued = 0;
+        for (size_t k = 0; k < count && queued < room; ++k) {
+            const VoiceParams& p = params[k];
+            const int i = FindSlot(p.id);
+            if (i < 0) continue;
+            VoiceCommand& cmd = commands.Claim(queued++);
+            cmd = {};
+            cmd.type = VoiceCommand::Type::SetParams;
+            cmd.slot = (uint32_t)i;
+            cmd.id   = p.id;
+            cmd.gain = p.gain;
+            cmd.pan  = std::clamp(p.pan, -1.0f, 1.0f);
+            cmd.rate = std::clamp(p.rate, MIN_VOICE_RATE, MAX_VOICE_RATE);
+            slots[i].distance = p.distance;
         }
+        if (queued < count && room < count) commands.CountOverflow();
+        commands.Publish(queued);
+        pushedCommands += queued;
+        return queued;
+    }
+
+    void SoundBus::PlayPCMViaRaylib(const std::vector<int16_t>& data, int sampleRate, int channels, float gain) {
+        PlayPCM(data, sampleRate, channels, gain);
     }
 
     void SoundBus::MixInto(float* output, size_t frames, int outSampleRate, int outChannels) {
@@ -230,57 +677,177 @@ namespace Ho_tones {
 
         // zero the output
         size_t outSamples = frames * (size_t)outChannels;
-        for (size_t i = 0; i < outSamples; ++i) output[i] = 0.0f;
+        std::fill(output, output + outSamples, 0.0f);
+        if (outChannels > MAX_MIX_CHANNELS) return;
+
+        const auto mixStart = std::chrono::steady_clock::now();
+        ApplyCommands();
 
-        std::lock_guard<std::mutex> lk(voicesMutex);
-        if (voices.empty()) return;
+        // This block's frames on the timeline PlaySequence schedules against
+        const uint64_t blockStart = mixedFrames.load(std::memory_order_relaxed);
+        mixedFrames.store(blockStart + frames, std::memory_order_relaxed);
+        mixSampleRate.store(outSampleRate, std::memory_order_relaxed);
 
         float busGain = volume / 100.0f;
 
-        // Mix each voice
-        for (auto it = voices.begin(); it != voices.end();) {
-            Voice* voice = it->get();
-            size_t vFrames = voice->frameCount();
-            if (vFrames == 0) {
-                it = voices.erase(it);
-                continue;
+        // Each voice is mixed a block at a time: its source frames for the
+        // block converted to float in one pass, resampled (or, at the
+        // output rate, just channel-mapped) into `block`, then added to the
+        // output with one vectorised multiply-add.
+        alignas(16) float source[MIX_SOURCE_SAMPLES];
+        alignas(16) float block[MIX_BLOCK_SAMPLES];
+        const size_t blockFrames = MIX_BLOCK_SAMPLES / (size_t)outChannels;
+
+        int playing = 0;
+        for (uint32_t slot = 0; slot < MAX_VOICES; ++slot) {
+            Voice* voice = &voices[slot];
+            if (voice->id == 0) continue;
+            ++playing;
+            const size_t vFrames = voice->frames;
+            const int srcChannels = voice->channels;
+            const double step = (double)voice->sampleRate * voice->rate / (double)outSampleRate;
+            const size_t sourceFrames = MIX_SOURCE_SAMPLES / (size_t)srcChannels;
+            const float gain = voice->gain * busGain;
+
+            // pick appropriate source channel (if fewer channels, duplicate last channel)
+            int channelOf[MAX_MIX_CHANNELS];
+            for (int c = 0; c < outChannels; ++c) channelOf[c] = std::min(c, srcChannels - 1);
+            const bool sameLayout = srcChannels == outChannels;
+
+            // Pan as a balance: the far side fades, the near one stays whole
+            float chanGain[MAX_MIX_CHANNELS];
+            std::fill(chanGain, chanGain + outChannels, 1.0f);
+            const bool panned = outChannels >= 2 && voice->pan != 0.0f;
+            if (panned) {
+                chanGain[0] = std::min(1.0f, 1.0f - voice->pan);
+                chanGain[1] = std::min(1.0f, 1.0f + voice->pan);
             }
 
-            float rateRatio = (float)voice->sampleRate / (float)outSampleRate;
-
-            bool finished = false;
-
-            for (size_t f = 0; f < frames; ++f) {
-                size_t outBase = f * outChannels;
-                size_t srcFrame = static_cast<size_t>(voice->playbackPos);
-                if (srcFrame >= vFrames) { finished = true; break; }
+            // Scheduled for later: from its frame in this block, if it's in it
+            size_t f = 0;
+            if (voice->startFrame > blockStart) {
+                if (voice->startFrame - blockStart >= frames) continue;
+                f = (size_t)(voice->startFrame - blockStart);
+            }
 
-                for (int c = 0; c < outChannels; ++c) {
-                    // pick appropriate source channel (if fewer channels, duplicate last channel)
-                    int srcChan = c < voice->channels ? c : (voice->channels - 1);
-                    size_t srcIdx = srcFrame * voice->channels + srcChan;
-                    int16_t s = voice->samples[srcIdx];
-                    float fs = (float)s / 32768.0f;
-                    output[outBase + c] += fs * voice->gain * busGain;
+            for (; f < frames;) {
+                double pos = voice->playbackPos;
+                if (pos >= (double)vFrames) {
+                    if (!voice->loop) break;
+                    pos = std::fmod(pos, (double)vFrames);
                 }
+                const size_t first = static_cast<size_t>(pos);
+
+                // Output frames this block: bounded by the block, by the
+                // source frames it may read, and by the end of the voice
+                size_t n = std::min(frames - f, blockFrames);
+                n = std::min(n, std::max<size_t>(1, (size_t)((double)(sourceFrames - 2) / step)));
+                n = std::min(n, (size_t)std::ceil(((double)vFrames - pos) / step));
+                const size_t last = std::min(vFrames - 1, static_cast<size_t>(pos + (double)(n - 1) * step) + 1);
+                const size_t srcCount = last - first + 1;
+                Int16ToFloat(source, &voice->samples[first * srcChannels], srcCount * srcChannels);
+
+                const float* mixed = block;
+                if (step == 1.0 && pos == (double)first) {
+                    if (sameLayout && !panned) {
+                        mixed = source;
+                    } else {
+                        for (size_t i = 0; i < n; ++i)
+                            for (int c = 0; c < outChannels; ++c)
+                                block[i * outChannels + c] = source[i * srcChannels + channelOf[c]] * chanGain[c];
+                    }
+                } else {
+                    // Linear interpolation between the two source frames around each output frame
+                    for (size_t i = 0; i < n; ++i) {
+                        const double p = pos + (double)i * step;
+                        const size_t j0 = static_cast<size_t>(p) - first;
+                        const size_t j1 = std::min(j0 + 1, srcCount - 1);
+                        const float t = (float)(p - std::floor(p));
+                        const float* a = &source[j0 * srcChannels];
+                        const float* b = &source[j1 * srcChannels];
+                        for (int c = 0; c < outChannels; ++c)
+                            block[i * outChannels + c] =
+                                (a[channelOf[c]] + (b[channelOf[c]] - a[channelOf[c]]) * t) * chanGain[c];
+                    }
+                }
+                Hotones::ECS::Simd::MulAdd(output + f * outChannels, mixed, gain, n * (size_t)outChannels);
 
-                voice->playbackPos += rateRatio;
+                voice->playbackPos = pos + (double)n * step;
+                f += n;
             }
 
-            if (finished || static_cast<size_t>(voice->playbackPos) >= vFrames) {
-                it = voices.erase(it);
-            } else {
-                ++it;
+            if (!voice->loop && voice->playbackPos >= (double)vFrames) {
+                // Ran out: the game thread frees its slot when it hears of it
+                finished.TryPush({ slot, voice->id });
+                voice->id = 0;
             }
         }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - mixStart).count();
+        const uint32_t tookNs   = (uint32_t)std::min<int64_t>(elapsed, UINT32_MAX);
+        const uint32_t budgetNs = (uint32_t)std::min<uint64_t>(frames * 1000000000ull / (uint64_t)outSampleRate, UINT32_MAX);
+        statMixes.fetch_add(1, std::memory_order_relaxed);
+        if (tookNs > budgetNs) statUnderruns.fetch_add(1, std::memory_order_relaxed);
+        statLastNs.store(tookNs, std::memory_order_relaxed);
+        statBudgetNs.store(budgetNs, std::memory_order_relaxed);
+        if (tookNs > statPeakNs.load(std::memory_order_relaxed)) statPeakNs.store(tookNs, std::memory_order_relaxed);
+        statVoices.store(playing, std::memory_order_relaxed);
+        if (playing > statPeakVoices.load(std::memory_order_relaxed))
+            statPeakVoices.store(playing, std::memory_order_relaxed);
+    }
+
+    SoundBus::MixStats SoundBus::GetMixStats() const {
+        MixStats stats;
+        stats.mixes        = statMixes.load(std::memory_order_relaxed);
+        stats.underruns    = statUnderruns.load(std::memory_order_relaxed);
+        stats.lastMs       = statLastNs.load(std::memory_order_relaxed) / 1e6f;
+        stats.peakMs       = statPeakNs.load(std::memory_order_relaxed) / 1e6f;
+        stats.budgetMs     = statBudgetNs.load(std::memory_order_relaxed) / 1e6f;
+        stats.activeVoices = statVoices.load(std::memory_order_relaxed);
+        stats.peakVoices   = statPeakVoices.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void SoundBus::ResetMixStats() {
+        statMixes.store(0, std::memory_order_relaxed);
+        statUnderruns.store(0, std::memory_order_relaxed);
+        statPeakNs.store(0, std::memory_order_relaxed);
+        statPeakVoices.store(0, std::memory_order_relaxed);
     }
 
     void SoundBus::StopAll() {
-        std::lock_guard<std::mutex> lk(voicesMutex);
-        voices.clear();
+        // The pump goes first, so nothing decodes into a stream being unloaded
+        {
+            std::lock_guard<std::mutex> slk(streamsMutex);
+            streamPumpStop = true;
+        }
+        streamsWake.notify_all();
+        if (streamPump.joinable()) streamPump.join();
+
+        VoiceCommand stopVoices;
+        stopVoices.type = VoiceCommand::Type::StopAll;
+        if (PushCommand(stopVoices)) {
+            for (size_t i = 0; i < MAX_VOICES; ++i) {
+                if (slots[i].id == 0) continue;
+                released.push_back({ std::move(slots[i].pcm), pushedCommands });
+                slots[i].id = 0;
+            }
+        }
 
         bool audioReady = IsAudioDeviceReady();
 
+        {
+            std::lock_guard<std::mutex> slk(streamsMutex);
+            if (audioReady) {
+                for (auto& [name, e] : streams) {
+                    StopMusicStream(e->music);
+                    UnloadMusicStream(e->music);
+                }
+            }
+            streams.clear();
+        }
+
         // Stop and unload any raylib Sounds we created (temporary sounds)
         if (audioReady) {
             for (auto &s : raylibSounds) {
@@ -288,35 +855,12 @@ namespace Ho_tones {
                 UnloadSound(s);
             }
         }
-        // Stop any multi-playback instances (raylib may not provide StopSoundMulti in all versions)
-        if (audioReady) {
-            // Stop any instances that were started with PlaySoundMulti by stopping
-            // each known loaded Sound; loadedSounds are iterated later for unloading.
-            for (auto &kv : loadedSounds) {
-                for (auto &e : kv.second) {
-                    StopSound(e.sound);
-                }
-            }
-        }
         raylibSounds.clear();
 
-        // Unload any named sounds we loaded from disk
-        if (audioReady) {
-            for (auto &kv : loadedSounds) {
-                for (auto &e : kv.second) {
-                    UnloadSound(e.sound);
-                    UnloadWave(e.wave);
-                }
-            }
-        }
+        // Forget the named sounds; their waves go back to the AssetCache
+        // once the voices playing them are released
         loadedSounds.clear();
-
-        for (auto &p : raylibTempFiles) {
-            // best-effort remove
-            std::error_code ec;
-            std::filesystem::remove(p, ec);
-        }
-        raylibTempFiles.clear();
+        pcmCache.clear();
     }
 
 }
@@ -0,0 +1,135 @@
+#include <SFX/SpatialAudioSystem.hpp>
+#include <raymath.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Ho_tones {
+
+using namespace Hotones::ECS;
+
+void SpatialAudioSystem::SetListener(Vector3 position, Vector3 forward, Vector3 up, Vector3 velocity) {
+    m_listenerPos = position;
+    m_listenerVel = velocity;
+    const Vector3 right = Vector3CrossProduct(forward, up);
+    if (Vector3Length(right) > 0.0f) m_listenerRight = Vector3Normalize(right);
+}
+
+void SpatialAudioSystem::Spatialise() {
+    const size_t n = m_sources.size();
+    m_gain.resize(n);
+    m_pan.resize(n);
+    m_rate.resize(n);
+    m_dist.resize(n);
+
+    const float rx = m_listenerRight.x, ry = m_listenerRight.y, rz = m_listenerRight.z;
+    const float lx = m_listenerVel.x,   ly = m_listenerVel.y,   lz = m_listenerVel.z;
+    const float c        = SPEED_OF_SOUND;
+    const float maxSpeed = 0.5f * SPEED_OF_SOUND;   // keeps the shift within an octave
+    const float doppler  = m_doppler;
+
+    // Straight-line float code over the arrays, so the compiler vectorises it
+    for (size_t i = 0; i < n; ++i) {
+        const float dx = m_dx[i], dy = m_dy[i], dz = m_dz[i];
+        const float d   = std::sqrt(dx * dx + dy * dy + dz * dz);
+        const float inv = d > 1e-4f ? 1.0f / d : 0.0f;   // on the listener: centred, no shift
+
+        const float fall = std::max(0.0f, 1.0f - d / std::max(m_maxDist[i], 1e-4f));
+        m_gain[i] = m_volume[i] * fall * fall;
+        m_pan[i]  = (dx * rx + dy * ry + dz * rz) * inv;
+        m_dist[i] = d;
+
+        // Speeds along the line between them, positive when closing in
+        const float vl = std::clamp((lx * dx + ly * dy + lz * dz) * inv * doppler, -maxSpeed, maxSpeed);
+        const float vs = std::clamp(-(m_vx[i] * dx + m_vy[i] * dy + m_vz[i] * dz) * inv * doppler, -maxSpeed, maxSpeed);
+        m_rate[i] = m_pitch[i] * (c + vl) / (c - vs);
+    }
+}
+
+void SpatialAudioSystem::Update(Registry& reg, float dt) {
+    if (!IsAudioDeviceReady()) return;
+    ++m_tick;
+    const float invDt = dt > 0.0f ? 1.0f / dt : 0.0f;
+
+    // ── Gather ────────────────────────────────────────────────────────────────
+    m_sources.clear();
+    m_dx.clear(); m_dy.clear(); m_dz.clear();
+    m_vx.clear(); m_vy.clear(); m_vz.clear();
+    m_volume.clear(); m_maxDist.clear(); m_pitch.clear();
+    reg.View<AudioEmitterComponent, TransformComponent>(
+        [&](EntityId id, AudioEmitterComponent& em, auto&& tr) {
+            const Vector3 pos = tr.position;
+            auto [it, added] = m_states.try_emplace(id);
+            EmitterState& st = it->second;
+            if (added) {
+                st.lastPos = pos;
+                if (em.autoPlay) em.playing = true;
+            }
+            const Vector3 vel = Vector3Scale(Vector3Subtract(pos, st.lastPos), invDt);
+            st.lastPos  = pos;
+            st.seenTick = m_tick;
+            if (!em.playing && st.voice == 0) return;
+
+            m_sources.push_back({ id, &em, &st });
+            m_dx.push_back(pos.x - m_listenerPos.x);
+            m_dy.push_back(pos.y - m_listenerPos.y);
+            m_dz.push_back(pos.z - m_listenerPos.z);
+            m_vx.push_back(vel.x);
+            m_vy.push_back(vel.y);
+            m_vz.push_back(vel.z);
+            m_volume.push_back(em.volume);
+            m_maxDist.push_back(em.maxDist);
+            m_pitch.push_back(em.pitch);
+        });
+
+    // Emitters removed, or whose entity is gone
+    for (auto it = m_states.begin(); it != m_states.end();) {
+        if (it->second.seenTick == m_tick) { ++it; continue; }
+        m_bus.StopVoice(it->second.voice);
+        it = m_states.erase(it);
+    }
+    if (m_sources.empty()) return;
+
+    Spatialise();
+
+    // ── Voices ────────────────────────────────────────────────────────────────
+    m_params.clear();
+    for (size_t i = 0; i < m_sources.size(); ++i) {
+        AudioEmitterComponent& em = *m_sources[i].emitter;
+        EmitterState&          st = *m_sources[i].state;
+        const SoundBus::VoiceParams params{ st.voice, m_gain[i], m_pan[i], m_rate[i], m_dist[i] };
+
+        if (!em.playing) {
+            m_bus.StopVoice(st.voice);
+            st.voice = 0;
+            continue;
+        }
+        if (st.voice != 0 && !m_bus.IsVoicePlaying(st.voice)) {   // ended, or stolen
+            st.voice = 0;
+            if (!em.loop) {
+                em.playing = false;
+                continue;
+            }
+        }
+        if (params.gain <= AUDIBLE_GAIN) {
+            m_bus.StopVoice(st.voice);
+            st.voice = 0;
+            if (!em.loop) em.playing = false;
+            continue;
+        }
+
+        if (st.voice != 0) {
+            m_params.push_back(params);
+            continue;
+        }
+        st.voice = m_bus.PlaySpatial(em.soundKey, params, em.loop);
+        if (st.voice == 0 && !em.loop) em.playing = false;   // lost to louder sounds
+    }
+    if (!m_params.empty()) m_bus.SetVoiceParams(m_params.data(), m_params.size());
+}
+
+void SpatialAudioSystem::Shutdown(Registry& /*reg*/) {
+    for (auto& [id, st] : m_states) m_bus.StopVoice(st.voice);
+    m_states.clear();
+}
+
+} // namespace Ho_tones
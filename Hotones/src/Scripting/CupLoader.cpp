@@ -1,61 +1,188 @@
 ﻿// Minimal Lua runtime integration for the project.
-#include <chrono>
+#include <algorithm>
+#include <cctype>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <new>
+#include <vector>
 #include <raylib.h>
 #include "../include/Scripting/CupLoader.hpp"
 #include "../include/Scripting/CupPackage.hpp"
+#include "../include/Scripting/LuaAllocator.hpp"
+#include "../include/Scripting/LuaWorkers.hpp"
+#include "../include/Scripting/PackScripts.hpp"
+#include "../include/Scripting/LuaLoader/ServerLib.hpp"
+#include "../include/Scripting/LuaLoader/Players.hpp"
+#include "../include/Scripting/LuaLoader/Physics.hpp"
+#include "../include/Scripting/LuaLoader/Nav.hpp"
+#include "../include/Scripting/LuaLoader/ECS.hpp"
+#include "../include/Scripting/LuaLoader/Task.hpp"
+#include "../include/Scripting/LuaLoader/Input.hpp"
+#if !HOTONES_HEADLESS
 #include "../include/Scripting/LuaLoader/Rendering.hpp"
 #include "../include/Scripting/LuaLoader/Audio.hpp"
-#include "../include/Scripting/LuaLoader/Input.hpp"
-#include "../include/Scripting/LuaLoader/ServerLib.hpp"
 #include "../include/Scripting/LuaLoader/MeshGen.hpp"
 #include "../include/Scripting/LuaLoader/Lighting.hpp"
-#include "../include/Scripting/LuaLoader/Players.hpp"
-#include "../include/Scripting/LuaLoader/Physics.hpp"
 #include "../include/Scripting/LuaLoader/LocalPlayer.hpp"
-#include "../include/Scripting/LuaLoader/ECS.hpp"
+#include <SFX/AudioSystem.hpp>
+#include <Assets/AssetCache.hpp>
+#endif
 #include <server/NetworkManager.hpp>
+#include <Profile/Profiler.hpp>
+#include <Assets/AssetLoader.hpp>
+#include <Assets/FileWatcher.hpp>
+#include <Assets/Vfs.hpp>
+#include <Time/FrameClock.hpp>
 
-#include <lua.hpp>
+#include <Scripting/LuaCompat.hpp>
 
 // ── Timing globals (work in both headless and windowed Lua contexts) ──────────
 namespace {
-    static std::chrono::steady_clock::time_point g_luaLastFrame;
-    static std::chrono::steady_clock::time_point g_luaStartTime;
-    static bool g_luaTimingInit = false;
+    // Per Lua state, shared by both functions as a userdata upvalue.  Times
+    // come from the frame clock, so a replayed session reads what it read
+    // when it was recorded.
+    struct LuaTiming {
+        double lastFrame = 0.0;
+        double start     = 0.0;
+        bool   init      = false;
+    };
 
     // GetFrameTime() — seconds elapsed since the last call (or 0 on first call)
     static int l_GetFrameTime(lua_State* L) {
-        auto now = std::chrono::steady_clock::now();
+        auto* t = static_cast<LuaTiming*>(lua_touserdata(L, lua_upvalueindex(1)));
+        const double now = Hotones::Time::FrameClock::Get().Now();
         float dt = 0.0f;
-        if (g_luaTimingInit) {
-            dt = std::chrono::duration<float>(now - g_luaLastFrame).count();
+        if (t->init) {
+            dt = (float)(now - t->lastFrame);
         } else {
-            g_luaStartTime  = now;
-            g_luaTimingInit = true;
+            t->start = now;
+            t->init  = true;
         }
-        g_luaLastFrame = now;
+        t->lastFrame = now;
         lua_pushnumber(L, (lua_Number)dt);
         return 1;
     }
 
     // GetTime() — seconds since the Lua state was initialised
     static int l_GetTime(lua_State* L) {
-        if (!g_luaTimingInit) {
+        auto* t = static_cast<LuaTiming*>(lua_touserdata(L, lua_upvalueindex(1)));
+        if (!t->init) {
             lua_pushnumber(L, 0.0);
             return 1;
         }
-        auto now = std::chrono::steady_clock::now();
-        double secs = std::chrono::duration<double>(now - g_luaStartTime).count();
+        const double secs = Hotones::Time::FrameClock::Get().Now() - t->start;
         lua_pushnumber(L, (lua_Number)secs);
         return 1;
     }
-} // anonymous namespace
 
-// Internal reload request flag (global for the single CupLoader instance).
-static std::atomic<bool> g_reloadRequested { false };
+    static void registerTiming(lua_State* L) {
+        new (lua_newuserdata(L, sizeof(LuaTiming))) LuaTiming{};
+        lua_pushvalue(L, -1);
+        lua_pushcclosure(L, l_GetFrameTime, 1);
+        lua_setglobal(L, "GetFrameTime");
+        lua_pushcclosure(L, l_GetTime, 1);
+        lua_setglobal(L, "GetTime");
+    }
+
+    // The engine's libraries, into a new state.  A headless build has no
+    // window or audio device behind the client ones.
+    static void registerLibraries(lua_State* L, Hotones::Net::NetworkManager* netMgr,
+                                  Hotones::Scripting::LuaWorkers& workers) {
+        using namespace Hotones::Scripting;
+#if !HOTONES_HEADLESS
+        LuaLoader::registerRendering(L);
+        LuaLoader::registerAudio(L);
+        LuaLoader::registerMeshGen(L);
+        LuaLoader::registerLighting(L);
+        LuaLoader::registerLocalPlayer(L);
+#endif
+        LuaLoader::registerInput(L);   // reads nothing without a window
+        LuaLoader::registerServer(L);
+        LuaLoader::registerPlayers(L, netMgr);
+        LuaLoader::registerPhysics(L);
+        LuaLoader::registerNav(L);
+        LuaLoader::registerECS(L);
+        LuaLoader::registerTask(L);
+        LuaWorkers::Register(L, workers);
+    }
+
+    // math.randomseed(seed), so math.random() repeats from run to run
+    static void seedRandom(lua_State* L, uint64_t seed) {
+        lua_getglobal(L, "math");
+        lua_getfield(L, -1, "randomseed");
+        lua_pushinteger(L, (lua_Integer)seed);
+        if (lua_pcall(L, 1, 0, 0) != LUA_OK) {
+            TraceLog(LOG_WARNING, "[CupLoader] math.randomseed: %s", lua_tostring(L, -1));
+            lua_pop(L, 1);
+        }
+        lua_pop(L, 1);
+    }
+
+    // pcall message handler: the error with the stack it was raised from
+    static int l_traceback(lua_State* L) {
+        const char* msg = lua_tostring(L, 1);
+        if (!msg) msg = lua_pushfstring(L, "(error object is a %s value)", luaL_typename(L, 1));
+        luaL_traceback(L, L, msg, 1);
+        return 1;
+    }
+
+    // Collector mode for a new state: generational where there is one,
+    // since most script garbage is short-lived temporaries
+    static void configureGc(lua_State* L) {
+#if defined(LUA_GCGEN)
+        lua_gc(L, LUA_GCGEN, 0, 0);
+#else
+        (void)L;
+#endif
+    }
+
+    // An error outside any pcall; luaL_newstate() installs the same
+    static int l_panic(lua_State* L) {
+        const char* msg = lua_tostring(L, -1);
+        TraceLog(LOG_ERROR, "[CupLoader] unprotected Lua error: %s", msg ? msg : "(not a string)");
+        return 0;   // Lua aborts
+    }
+
+    // A state that allocates from `alloc`, which must outlive it.  LuaJIT
+    // without GC64 refuses custom allocators; it then uses its own, and
+    // `alloc` counts nothing.
+    static lua_State* newState(Hotones::Scripting::LuaAllocator& alloc) {
+        lua_State* L = lua_newstate(Hotones::Scripting::LuaAllocator::Alloc, &alloc);
+#if defined(HOTONES_LUAJIT)
+        if (!L) L = luaL_newstate();
+#endif
+        if (L) lua_atpanic(L, l_panic);
+        return L;
+    }
+
+    // CupLoader's Hook order
+    constexpr const char* HOOK_NAMES[] = {
+        "Init", "Update", "draw3D", "Draw", "onPlayerJoined", "onPlayerLeft", "onMessage", "onFileChanged",
+        "onWorkerMessage",
+    };
+
+    // Init.Workers = { name = "scripts/x.lua", ... }; Init at the top of L
+    static std::vector<Hotones::Scripting::LuaWorkers::Spec> readWorkerSpecs(lua_State* L, const std::string& root)
+    {
+        std::vector<Hotones::Scripting::LuaWorkers::Spec> specs;
+        lua_getfield(L, -1, "Workers");
+        if (lua_istable(L, -1)) {
+            lua_pushnil(L);
+            while (lua_next(L, -2) != 0) {
+                if (lua_type(L, -2) == LUA_TSTRING && lua_type(L, -1) == LUA_TSTRING)
+                    specs.push_back({ lua_tostring(L, -2), (std::filesystem::path(root) / lua_tostring(L, -1)).string() });
+                else
+                    TraceLog(LOG_WARNING, "[CupLoader] Init.Workers entries must be name = \"path\"; skipping one");
+                lua_pop(L, 1);
+            }
+        }
+        lua_pop(L, 1);
+        // lua_next's order isn't the declaration's; start them in a stable one
+        std::sort(specs.begin(), specs.end(), [](const auto& a, const auto& b) { return a.name < b.name; });
+        return specs;
+    }
+} // anonymous namespace
 
 // Lua binding: reload the currently-loaded pack. Upvalue 1 = CupLoader* (lightuserdata)
 static int l_reload(lua_State* L)
@@ -68,7 +195,7 @@ static int l_reload(lua_State* L)
     Hotones::Scripting::CupLoader* loader = static_cast<Hotones::Scripting::CupLoader*>(p);
     // Defer actual reload to avoid closing the active Lua state while this
     // C function is still executing.  Mark a request and return true.
-    g_reloadRequested.store(true);
+    loader->requestReload();
     lua_pushboolean(L, 1);
     return 1;
 }
@@ -76,13 +203,14 @@ static int l_reload(lua_State* L)
 namespace Hotones::Scripting {
 
 CupLoader::CupLoader()
-    : L(nullptr), m_classRef(LUA_NOREF)
+    : L(nullptr), m_classRef(LUA_NOREF), m_tracebackRef(LUA_NOREF)
 {
+    std::fill(std::begin(m_hookRefs), std::end(m_hookRefs), LUA_NOREF);
 }
 
 void CupLoader::requestReload()
 {
-    g_reloadRequested.store(true);
+    m_reloadRequested.store(true);
 }
 
 void CupLoader::setNetworkManager(Net::NetworkManager* nm)
@@ -90,15 +218,24 @@ void CupLoader::setNetworkManager(Net::NetworkManager* nm)
     m_netMgr = nm;
     // Update the Players library immediately so Lua can query live player data
     // even when init() was already called before the connection was established.
-    Hotones::Scripting::LuaLoader::setPlayersNetworkManager(nm);
+    if (L) Hotones::Scripting::LuaLoader::setPlayersNetworkManager(L, nm);
+}
+
+void CupLoader::setRandomSeed(uint64_t seed)
+{
+    m_randomSeed    = seed;
+    m_hasRandomSeed = true;
+    if (L) seedRandom(L, seed);
 }
 
 void CupLoader::setLocalPlayer(Hotones::Player* player)
 {
     m_localPlayer = player;
+#if !HOTONES_HEADLESS
     // Update the LocalPlayer library immediately; the binding reads through a
     // static pointer so existing Lua states pick up the new player at once.
     Hotones::Scripting::LuaLoader::setLocalPlayer(player);
+#endif
     // Keep the ECS library's player pointer in sync as well.
     Hotones::Scripting::LuaLoader::setECSLocalPlayer(player);
 }
@@ -106,35 +243,29 @@ void CupLoader::setLocalPlayer(Hotones::Player* player)
 CupLoader::~CupLoader()
 {
     if (L) {
+        dropHooks();
         if (m_classRef != LUA_NOREF)
             luaL_unref(L, LUA_REGISTRYINDEX, m_classRef);
+        m_profiler.Detach();
         lua_close(L);
     }
 }
 
 bool CupLoader::init()
 {
-    L = luaL_newstate();
+    m_alloc = std::make_unique<LuaAllocator>();
+    m_allocsSeen = 0;
+    L = newState(*m_alloc);
     if (!L) return false;
+    m_profiler.Attach(L);
     luaL_openlibs(L);
+    configureGc(L);
 
-    Hotones::Scripting::LuaLoader::registerRendering(L);
-    Hotones::Scripting::LuaLoader::registerAudio(L);
-    Hotones::Scripting::LuaLoader::registerInput(L);
-    Hotones::Scripting::LuaLoader::registerServer(L);
-    Hotones::Scripting::LuaLoader::registerMeshGen(L);
-    Hotones::Scripting::LuaLoader::registerLighting(L);
-    Hotones::Scripting::LuaLoader::registerPlayers(L, m_netMgr);
-    Hotones::Scripting::LuaLoader::registerPhysics(L);
-    Hotones::Scripting::LuaLoader::registerLocalPlayer(L);
-    Hotones::Scripting::LuaLoader::registerECS(L);
+    registerLibraries(L, m_netMgr, m_workers);
 
     // Register timing globals so Lua scripts work in both headless and windowed modes
-    g_luaTimingInit = false; // reset on each new Lua state
-    lua_pushcfunction(L, l_GetFrameTime);
-    lua_setglobal(L, "GetFrameTime");
-    lua_pushcfunction(L, l_GetTime);
-    lua_setglobal(L, "GetTime");
+    registerTiming(L);
+    if (m_hasRandomSeed) seedRandom(L, m_randomSeed);
 
     // Expose reloadPack() to Lua so scripts can request reloading the current pack.
     // The closure carries a lightuserdata upvalue pointing to this CupLoader instance.
@@ -148,11 +279,11 @@ bool CupLoader::init()
 bool CupLoader::loadScript(const std::string& path)
 {
     if (!L) return false;
-    if (!std::filesystem::exists(path)) {
+    if (!Hotones::Assets::FileExists(path)) {
         TraceLog(LOG_ERROR, "[CupLoader] Script not found: %s", path.c_str());
         return false;
     }
-    int status = luaL_loadfile(L, path.c_str());
+    int status = LoadPackChunk(L, path);
     if (status != LUA_OK) {
         const char* msg = lua_tostring(L, -1);
         std::string err = msg ? msg : "<unknown>";
@@ -191,16 +322,25 @@ bool CupLoader::loadPak(CupPackage& pkg)
     }
 
     const std::string initPath = pkg.initScript();
-    if (!std::filesystem::exists(initPath)) {
+    if (!Hotones::Assets::FileExists(initPath)) {
         TraceLog(LOG_ERROR, "[CupLoader] Pack is missing init.lua: %s", initPath.c_str());
         return false;
     }
+    RegisterPackSearcher(L, pkg.rootPath());
     if (!loadScript(initPath) || !run())
         return false;
 
     // Remember package root and init path so we can reload later
     m_initPath = initPath;
     m_packageRoot = pkg.rootPath();
+    m_watcher.reset();
+    if (!pkg.isMounted()) {
+        m_watcher = std::make_unique<Hotones::Assets::FileWatcher>();
+        if (m_watcher->Watch(m_packageRoot))
+            TraceLog(LOG_INFO, "[CupLoader] Watching %s for changes", m_packageRoot.c_str());
+        else
+            m_watcher.reset();
+    }
 
     lua_getglobal(L, "Init");
     if (!lua_istable(L, -1)) {
@@ -228,9 +368,13 @@ bool CupLoader::loadPak(CupPackage& pkg)
         lua_pop(L, 1);
         TraceLog(LOG_WARNING, "[CupLoader] Warning: Init.MainClass is not a table.");
     }
+    const std::vector<LuaWorkers::Spec> workers = readWorkerSpecs(L, m_packageRoot);
     lua_pop(L, 1);
 
-    callMethod("Init");
+    startWorkers(workers);
+    resolveHooks();
+    callHook(HookInit);
+    resolveHooks();
     return true;
 }
 
@@ -241,34 +385,27 @@ bool CupLoader::reload()
         return false;
     }
 
+    // The pack's files may have been added or removed since they were found
+    Ho_tones::Assets::InvalidateAssetPaths();
+
     // Create a fresh Lua state and fully initialise it.  We build the new
     // state first so that failures leave the existing state untouched.
-    lua_State* newL = luaL_newstate();
+    auto newAlloc = std::make_unique<LuaAllocator>();
+    lua_State* newL = newState(*newAlloc);
     if (!newL) {
         TraceLog(LOG_ERROR, "[CupLoader] reload(): failed to create new Lua state");
         return false;
     }
     luaL_openlibs(newL);
+    configureGc(newL);
 
-    // Register engine libraries into the new state
-    Hotones::Scripting::LuaLoader::registerRendering(newL);
-    Hotones::Scripting::LuaLoader::registerAudio(newL);
-    Hotones::Scripting::LuaLoader::registerInput(newL);
-    Hotones::Scripting::LuaLoader::registerServer(newL);
-    Hotones::Scripting::LuaLoader::registerMeshGen(newL);
-    Hotones::Scripting::LuaLoader::registerLighting(newL);
-    // NOTE: registerPlayers, registerPhysics, and registerLocalPlayer must be
-    // included here so they remain available after a reloadPack() call.
-    Hotones::Scripting::LuaLoader::registerPlayers(newL, m_netMgr);
-    Hotones::Scripting::LuaLoader::registerPhysics(newL);
-    Hotones::Scripting::LuaLoader::registerLocalPlayer(newL);
+    // Register engine libraries into the new state, the same as init() so
+    // they all remain available after a reloadPack() call
+    registerLibraries(newL, m_netMgr, m_workers);
 
     // Timing globals
-    g_luaTimingInit = false;
-    lua_pushcfunction(newL, l_GetFrameTime);
-    lua_setglobal(newL, "GetFrameTime");
-    lua_pushcfunction(newL, l_GetTime);
-    lua_setglobal(newL, "GetTime");
+    registerTiming(newL);
+    if (m_hasRandomSeed) seedRandom(newL, m_randomSeed);
 
     // reloadPack closure in the new state (upvalue = this)
     lua_pushlightuserdata(newL, this);
@@ -276,7 +413,8 @@ bool CupLoader::reload()
     lua_setglobal(newL, "reloadPack");
 
     // Load and run init.lua inside the new state
-    int status = luaL_loadfile(newL, m_initPath.c_str());
+    RegisterPackSearcher(newL, m_packageRoot);
+    int status = LoadPackChunk(newL, m_initPath);
     if (status != LUA_OK) {
         const char* msg = lua_tostring(newL, -1);
         std::string err = msg ? msg : "<unknown>";
@@ -322,20 +460,29 @@ bool CupLoader::reload()
         lua_pop(newL, 1);
         TraceLog(LOG_WARNING, "[CupLoader] reload(): Init.MainClass is not a table.");
     }
+    const std::vector<LuaWorkers::Spec> workers = readWorkerSpecs(newL, m_packageRoot);
     lua_pop(newL, 1); // pop Init table
 
     // Swap in the new state (close old state after extracting anything we need)
     if (L) {
+        dropHooks();
         if (m_classRef != LUA_NOREF)
             luaL_unref(L, LUA_REGISTRYINDEX, m_classRef);
+        m_profiler.Detach();
         lua_close(L);
     }
     L = newL;
+    m_profiler.Attach(L);
+    m_alloc = std::move(newAlloc);
+    m_allocsSeen = 0;
     m_classRef = newClassRef;
     if (!newMainScene.empty()) m_mainScene = newMainScene;
+    startWorkers(workers);   // fresh worker states too; they keep nothing across
 
     // Call Init() on the new MainClass (if one existed)
-    if (m_classRef != LUA_NOREF) callMethod("Init");
+    resolveHooks();
+    callHook(HookInit);
+    resolveHooks();
 
     TraceLog(LOG_INFO, "[CupLoader] reload(): successfully reloaded %s", m_initPath.c_str());
     return true;
@@ -346,73 +493,300 @@ void CupLoader::update()
     // Call the scripted Update() first.  If the script requested a reload
     // via reloadPack(), perform the reload AFTER the call returns to avoid
     // closing the active Lua state while a C function is on the stack.
-    callMethod("Update");
-    if (g_reloadRequested.exchange(false)) {
+    HOTONES_ZONE("Lua Update");
+    resumeTasks();
+    deliverPaths();
+    deliverWorkerMessages();
+    callHook(HookUpdate);
+    if (m_reloadRequested.exchange(false)) {
         // perform the actual reload now
         reload();
     }
+    applyFileChanges();
+    m_workers.Dispatch();   // runs while the frame goes on
+    if (L) Hotones::Scripting::LuaLoader::dispatchPaths(L);   // so do these
+    stepGc();
 }
 
-void CupLoader::draw3D()  { callMethod("draw3D");  }
-void CupLoader::draw()    { callMethod("Draw");    }
+void CupLoader::startWorkers(const std::vector<LuaWorkers::Spec>& specs)
+{
+    if (specs.empty()) {
+        m_workers.Stop();
+        return;
+    }
+    std::string error;
+    const int started = m_workers.Start(m_packageRoot, specs, error);
+    if (!error.empty()) m_lastLuaError = error;
+    TraceLog(LOG_INFO, "[CupLoader] %d of %zu workers started", started, specs.size());
+}
 
-void CupLoader::firePlayerJoined(uint8_t id, const char* name)
+void CupLoader::deliverWorkerMessages()
 {
-    if (!L || m_classRef == LUA_NOREF) return;
-    lua_rawgeti(L, LUA_REGISTRYINDEX, m_classRef);
-    lua_getfield(L, -1, "onPlayerJoined");
-    if (!lua_isfunction(L, -1)) { lua_pop(L, 2); return; }
-    lua_pushvalue(L, -2);
-    lua_pushinteger(L, id);
-    lua_pushstring(L, name ? name : "");
-    if (lua_pcall(L, 3, 0, 0) != LUA_OK) {
-        const char* err = lua_tostring(L, -1);
-        TraceLog(LOG_ERROR, "[CupLoader] onPlayerJoined() error: %s", (err ? err : "<unknown>"));
-        lua_pop(L, 1);
+    if (!L || m_workers.Count() == 0) return;
+    HOTONES_ZONE("Lua worker messages");
+    std::string error;
+    if (!m_workers.Collect(m_workerMail, error)) m_lastLuaError = error;   // logged by the worker
+    for (const LuaWorkers::Message& message : m_workerMail) {
+        if (!beginHook(HookWorkerMessage)) break;
+        lua_pushstring(L, message.worker.c_str());
+        LuaWorkers::Decode(L, message.data);
+        callHook(HookWorkerMessage, 2);
     }
-    lua_pop(L, 1);
+    m_workerMail.clear();
 }
 
-void CupLoader::firePlayerLeft(uint8_t id)
+void CupLoader::resumeTasks()
 {
-    if (!L || m_classRef == LUA_NOREF) return;
-    lua_rawgeti(L, LUA_REGISTRYINDEX, m_classRef);
-    lua_getfield(L, -1, "onPlayerLeft");
-    if (!lua_isfunction(L, -1)) { lua_pop(L, 2); return; }
-    lua_pushvalue(L, -2);
-    lua_pushinteger(L, id);
-    if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
-        const char* err = lua_tostring(L, -1);
-        TraceLog(LOG_ERROR, "[CupLoader] onPlayerLeft() error: %s", (err ? err : "<unknown>"));
-        lua_pop(L, 1);
+    if (!L) return;
+    HOTONES_ZONE("Lua tasks");
+    std::string error;
+    m_profiler.BeginCallback("tasks");
+    const bool ok = Hotones::Scripting::LuaLoader::updateTasks(L, error);
+    m_profiler.EndCallback();
+    if (!ok) m_lastLuaError = error;   // each failure is logged as it happens
+}
+
+void CupLoader::deliverPaths()
+{
+    if (!L) return;
+    HOTONES_ZONE("Lua paths");
+    std::string error;
+    m_profiler.BeginCallback("paths");
+    const bool ok = Hotones::Scripting::LuaLoader::deliverPaths(L, error);
+    m_profiler.EndCallback();
+    if (!ok) m_lastLuaError = error;   // each failure is logged as it happens
+}
+
+void CupLoader::stepGc()
+{
+    if (!L) return;
+    HOTONES_ZONE("Lua GC");
+    const int64_t start = Hotones::Profile::Now();
+    int steps = 0;
+    if (m_gcBudgetMs > 0.0) {
+        const int64_t deadline = start + (int64_t)(m_gcBudgetMs * 1e6);
+#if defined(LUA_GCGEN)
+        const bool oneStep = true;   // a step is a whole minor collection
+#else
+        const bool oneStep = false;
+#endif
+        do {
+            ++steps;
+            if (lua_gc(L, LUA_GCSTEP, 0)) break;   // finished a cycle
+        } while (!oneStep && Hotones::Profile::Now() < deadline);
     }
-    lua_pop(L, 1);
+    const double kb = lua_gc(L, LUA_GCCOUNT, 0) + lua_gc(L, LUA_GCCOUNTB, 0) / 1024.0;
+    const double ms = (double)(Hotones::Profile::Now() - start) / 1e6;
+    HOTONES_COUNTER("Lua GC ms", ms);
+    HOTONES_COUNTER("Lua GC steps", steps);
+    HOTONES_COUNTER("Lua memory KB", kb);
+    m_gcStats.memoryKB = kb;
+    m_gcStats.totalMs += ms;
+    m_gcStats.steps   += (uint64_t)steps;
+    const uint64_t allocs = m_alloc->TotalAllocs();
+    HOTONES_COUNTER("Lua allocs", (double)(allocs - m_allocsSeen));
+    m_allocsSeen = allocs;
 }
 
-bool CupLoader::callMethod(const char* method, int /*nargs*/)
+void CupLoader::applyFileChanges()
 {
-    if (!L || m_classRef == LUA_NOREF) return false;
+    if (!m_watcher || !L) return;
+    const std::vector<std::string> changed = m_watcher->Poll();
+    if (changed.empty()) return;
+    HOTONES_ZONE("Lua hot reload");
+    Ho_tones::Assets::InvalidateAssetPaths();
+
+    const std::string root     = Hotones::Assets::NormalisePath(m_packageRoot);
+    const std::string initPath = Hotones::Assets::NormalisePath(m_initPath);
+    // An edited init.lua reloads everything, modules included
+    const bool reloadAll = std::find(changed.begin(), changed.end(), initPath) != changed.end();
+    std::vector<std::string> relPaths;
+    bool modulesReloaded = false;
+    for (const std::string& path : changed) {
+        if (path.compare(0, root.size() + 1, root + "/") != 0) continue;
+        const std::string rel = path.substr(root.size() + 1);
+        relPaths.push_back(rel);
+
+        std::string ext = std::filesystem::path(rel).extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+        if (ext == ".lua") {
+            if (reloadAll) continue;
+            // "a/b.lua" and "a/b/init.lua" are both module "a.b"
+            std::string name = rel.substr(0, rel.size() - ext.size());
+            if (name.size() > 5 && name.compare(name.size() - 5, 5, "/init") == 0) name.resize(name.size() - 5);
+            std::replace(name.begin(), name.end(), '/', '.');
+            modulesReloaded |= reloadModule(name, path);
+        } else {
+#if !HOTONES_HEADLESS
+            const int cached = Hotones::Assets::AssetCache::Get().Reload(path);
+            const int sounds = Ho_tones::GetSoundBus().ReloadFile(path);
+            if (cached + sounds > 0)
+                TraceLog(LOG_INFO, "[CupLoader] Re-imported %s (%d cached, %d sounds)", rel.c_str(), cached, sounds);
+#endif
+        }
+    }
 
-    lua_rawgeti(L, LUA_REGISTRYINDEX, m_classRef);
-    if (!lua_istable(L, -1)) { lua_pop(L, 1); return false; }
+    if (reloadAll) {
+        TraceLog(LOG_INFO, "[CupLoader] init.lua changed; reloading the pack");
+        reload();
+    } else if (modulesReloaded) {
+        ++m_codeVersion;
+        resolveHooks();   // MainClass may take its methods from a module
+    }
 
-    lua_getfield(L, -1, method);
-    if (!lua_isfunction(L, -1)) { lua_pop(L, 2); return false; }
+    // Let the pack react to the rest (re-create what it built from them)
+    for (const std::string& rel : relPaths) {
+        if (!beginHook(HookFileChanged)) break;
+        lua_pushstring(L, rel.c_str());
+        callHook(HookFileChanged, 1);
+    }
+}
 
-    lua_pushvalue(L, -2);
-    if (lua_pcall(L, 1, 0, 0) != LUA_OK) {
-        const char* err = lua_tostring(L, -1);
-        std::string serr = err ? err : "<unknown>";
-        TraceLog(LOG_ERROR, "[CupLoader] %s() error: %s", method, serr.c_str());
-        m_lastLuaError = serr;
-        lua_pop(L, 2);
+bool CupLoader::reloadModule(const std::string& name, const std::string& path)
+{
+    const int top = lua_gettop(L);
+    lua_getglobal(L, "package");
+    lua_getfield(L, -1, "loaded");
+    const int loaded = lua_gettop(L);
+    lua_getfield(L, loaded, name.c_str());
+    const int oldMod = lua_gettop(L);
+    if (lua_isnil(L, oldMod)) {   // not required yet: it loads fresh when it is
+        lua_settop(L, top);
+        return true;
+    }
+
+    // Executed as require() would: with the module name and file path
+    int status = LoadPackChunk(L, path);
+    if (status == LUA_OK) {
+        lua_pushstring(L, name.c_str());
+        lua_pushstring(L, path.c_str());
+        status = lua_pcall(L, 2, 1, 0);
+    }
+    if (status != LUA_OK) {
+        const char* msg = lua_tostring(L, -1);
+        m_lastLuaError = msg ? msg : "<unknown>";
+        TraceLog(LOG_ERROR, "[CupLoader] Reloading module '%s' failed, keeping the old one: %s",
+                 name.c_str(), m_lastLuaError.c_str());
+        lua_settop(L, top);
         return false;
     }
+    const int newMod = lua_gettop(L);
+
+    if (lua_istable(L, oldMod) && lua_istable(L, newMod)) {
+        // Let the new module carry state over from the old one
+        lua_getfield(L, newMod, "OnReload");
+        if (lua_isfunction(L, -1)) {
+            lua_pushvalue(L, oldMod);
+            if (lua_pcall(L, 1, 0, 0) != LUA_OK) {
+                const char* msg = lua_tostring(L, -1);
+                m_lastLuaError = msg ? msg : "<unknown>";
+                TraceLog(LOG_ERROR, "[CupLoader] %s.OnReload() error: %s", name.c_str(), m_lastLuaError.c_str());
+                lua_pop(L, 1);
+            }
+        } else {
+            lua_pop(L, 1);
+        }
+        // Copy the new fields into the old table, which stays the module:
+        // whoever required it, and objects using it as a metatable, get the
+        // new functions
+        lua_pushnil(L);
+        while (lua_next(L, newMod) != 0) {
+            lua_pushvalue(L, -2);
+            lua_insert(L, -2);
+            lua_rawset(L, oldMod);
+        }
+    } else if (!lua_isnil(L, newMod)) {
+        lua_pushvalue(L, newMod);
+        lua_setfield(L, loaded, name.c_str());
+    }
+    lua_settop(L, top);
+    TraceLog(LOG_INFO, "[CupLoader] Reloaded module '%s'", name.c_str());
+    return true;
+}
 
+void CupLoader::draw3D()  { HOTONES_ZONE("Lua draw3D"); callHook(HookDraw3D); }
+void CupLoader::draw()    { HOTONES_ZONE("Lua Draw");   callHook(HookDraw);   }
+
+void CupLoader::firePlayerJoined(uint16_t id, const char* name)
+{
+    if (!beginHook(HookPlayerJoined)) return;
+    lua_pushinteger(L, id);
+    lua_pushstring(L, name ? name : "");
+    callHook(HookPlayerJoined, 2);
+}
+
+void CupLoader::firePlayerLeft(uint16_t id)
+{
+    if (!beginHook(HookPlayerLeft)) return;
+    lua_pushinteger(L, id);
+    callHook(HookPlayerLeft, 1);
+}
+
+void CupLoader::fireMessage(uint16_t from, const uint8_t* data, size_t len)
+{
+    HOTONES_ZONE("Lua onMessage");
+    if (!beginHook(HookMessage)) return;
+    lua_pushinteger(L, from);
+    lua_pushlstring(L, reinterpret_cast<const char*>(data), len);
+    callHook(HookMessage, 2);
+}
+
+void CupLoader::resolveHooks()
+{
+    if (!L) return;
+    if (m_tracebackRef == LUA_NOREF) {
+        lua_pushcfunction(L, l_traceback);
+        m_tracebackRef = luaL_ref(L, LUA_REGISTRYINDEX);
+    }
+    for (int& ref : m_hookRefs) {
+        luaL_unref(L, LUA_REGISTRYINDEX, ref);
+        ref = LUA_NOREF;
+    }
+    if (m_classRef == LUA_NOREF) return;
+
+    lua_rawgeti(L, LUA_REGISTRYINDEX, m_classRef);
+    for (int h = 0; h < HookCount; ++h) {
+        lua_getfield(L, -1, HOOK_NAMES[h]);   // may come from a metatable's __index
+        if (lua_isfunction(L, -1)) m_hookRefs[h] = luaL_ref(L, LUA_REGISTRYINDEX);
+        else                       lua_pop(L, 1);
+    }
     lua_pop(L, 1);
+}
+
+void CupLoader::dropHooks()
+{
+    for (int& ref : m_hookRefs) {
+        luaL_unref(L, LUA_REGISTRYINDEX, ref);
+        ref = LUA_NOREF;
+    }
+    luaL_unref(L, LUA_REGISTRYINDEX, m_tracebackRef);
+    m_tracebackRef = LUA_NOREF;
+}
+
+bool CupLoader::beginHook(Hook hook)
+{
+    if (!L || m_hookRefs[hook] == LUA_NOREF) return false;
+    lua_rawgeti(L, LUA_REGISTRYINDEX, m_tracebackRef);
+    lua_rawgeti(L, LUA_REGISTRYINDEX, m_hookRefs[hook]);
+    lua_rawgeti(L, LUA_REGISTRYINDEX, m_classRef);
     return true;
 }
 
+bool CupLoader::callHook(Hook hook, int nargs)
+{
+    const int handler = lua_gettop(L) - nargs - 2;
+    m_profiler.BeginCallback(HOOK_NAMES[hook]);
+    const bool ok = lua_pcall(L, nargs + 1, 0, handler) == LUA_OK;
+    m_profiler.EndCallback();
+    if (!ok) {
+        const char* err = lua_tostring(L, -1);
+        m_lastLuaError = err ? err : "<unknown>";
+        TraceLog(LOG_ERROR, "[CupLoader] %s() error: %s", HOOK_NAMES[hook], m_lastLuaError.c_str());
+    }
+    lua_settop(L, handler - 1);
+    return ok;
+}
+
 lua_State* CupLoader::state()
 {
     return L;
@@ -0,0 +1,113 @@
+// LuaAllocator.cpp — size-class pools for a Lua state's small objects
+
+#include "../include/Scripting/LuaAllocator.hpp"
+#include "../include/Memory/MemoryTracker.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace Hotones::Scripting {
+
+LuaAllocator::~LuaAllocator()
+{
+    for (void* chunk : m_chunks) ::operator delete(chunk, std::align_val_t(GRANULE));
+}
+
+void* LuaAllocator::Alloc(void* ud, void* ptr, size_t osize, size_t nsize)
+{
+    LuaAllocator& a = *static_cast<LuaAllocator*>(ud);
+    if (!ptr) return nsize ? a.Allocate(nsize) : nullptr;   // osize is the object's type then
+    if (nsize == 0) {
+        a.Free(ptr, osize);
+        return nullptr;
+    }
+    return a.Reallocate(ptr, osize, nsize);
+}
+
+uint64_t LuaAllocator::TotalAllocs() const
+{
+    uint64_t n = m_stats.large.allocs;
+    for (const ClassStats& c : m_stats.classes) n += c.allocs;
+    return n;
+}
+
+bool LuaAllocator::Refill(size_t c)
+{
+    void* chunk = ::operator new(CHUNK_BYTES, std::align_val_t(GRANULE), std::nothrow);
+    if (!chunk) return false;
+    m_chunks.push_back(chunk);
+    m_stats.chunkBytes += CHUNK_BYTES;
+
+    // Threaded back to front, so blocks go out in address order
+    const size_t size  = (c + 1) * GRANULE;
+    char*        base  = static_cast<char*>(chunk);
+    for (size_t i = CHUNK_BYTES / size; i-- > 0;) {
+        auto* block = reinterpret_cast<FreeBlock*>(base + i * size);
+        block->next = m_free[c];
+        m_free[c]   = block;
+    }
+    return true;
+}
+
+void* LuaAllocator::Allocate(size_t size)
+{
+    if (size > MAX_SMALL) {
+        void* p = std::malloc(size);
+        if (!p) return nullptr;
+        m_stats.large.allocs++;
+        m_stats.large.live++;
+        m_stats.largeBytes += size;
+        Memory::Allocated(Memory::Tag::Lua, size);
+        return p;
+    }
+    const size_t c = ClassOf(size);
+    if (!m_free[c] && !Refill(c)) return nullptr;   // Lua collects and retries, or raises
+    FreeBlock* block = m_free[c];
+    m_free[c] = block->next;
+    m_stats.classes[c].allocs++;
+    m_stats.classes[c].live++;
+    Memory::Allocated(Memory::Tag::Lua, (c + 1) * GRANULE);
+    return block;
+}
+
+void LuaAllocator::Free(void* ptr, size_t size)
+{
+    if (size > MAX_SMALL) {
+        std::free(ptr);
+        m_stats.large.frees++;
+        m_stats.large.live--;
+        m_stats.largeBytes -= size;
+        Memory::Freed(Memory::Tag::Lua, size);
+        return;
+    }
+    const size_t c = ClassOf(size);
+    auto* block = static_cast<FreeBlock*>(ptr);
+    block->next = m_free[c];
+    m_free[c]   = block;
+    m_stats.classes[c].frees++;
+    m_stats.classes[c].live--;
+    Memory::Freed(Memory::Tag::Lua, (c + 1) * GRANULE);
+}
+
+void* LuaAllocator::Reallocate(void* ptr, size_t osize, size_t nsize)
+{
+    const bool oldSmall = osize <= MAX_SMALL, newSmall = nsize <= MAX_SMALL;
+    if (oldSmall && newSmall && ClassOf(osize) == ClassOf(nsize)) return ptr;   // fits where it is
+    if (!oldSmall && !newSmall) {
+        void* p = std::realloc(ptr, nsize);
+        if (!p) return nullptr;   // the old block stays valid, as Lua expects
+        m_stats.largeBytes += nsize;
+        m_stats.largeBytes -= osize;
+        Memory::Freed(Memory::Tag::Lua, osize);
+        Memory::Allocated(Memory::Tag::Lua, nsize);
+        return p;
+    }
+    void* p = Allocate(nsize);
+    if (!p) return nullptr;
+    std::memcpy(p, ptr, std::min(osize, nsize));
+    Free(ptr, osize);
+    return p;
+}
+
+} // namespace Hotones::Scripting
@@ -0,0 +1,173 @@
+// LuaBytecode.cpp — compiled copies of pack scripts, and loading them
+//
+// .luac file (native byte order):
+//
+//   BytecodeHeader  32 bytes: marker, format version, Lua release, source
+//                   hash (FNV-1a) and source size
+//   chunk           lua_dump() output
+
+#include "../include/Scripting/LuaBytecode.hpp"
+#include <Assets/Vfs.hpp>
+#include <raylib.h>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include <Scripting/LuaCompat.hpp>
+
+namespace fs = std::filesystem;
+
+namespace Hotones::Scripting {
+
+namespace {
+
+// Bump whenever the header changes
+constexpr uint32_t BYTECODE_VERSION = 1;
+constexpr uint32_t BYTECODE_MARKER  = 0x43554C48u;   // "HLUC"
+
+// Bytecode is only guaranteed to load into the release that wrote it
+#if defined(HOTONES_LUAJIT)
+constexpr uint32_t LUA_RELEASE = 0x4A000000u | LUAJIT_VERSION_NUM;   // 'J': never a PUC-Lua number
+#elif defined(LUA_VERSION_RELEASE_NUM)
+constexpr uint32_t LUA_RELEASE = LUA_VERSION_RELEASE_NUM;
+#else
+constexpr uint32_t LUA_RELEASE = LUA_VERSION_NUM;
+#endif
+
+struct BytecodeHeader {
+    uint32_t marker, version, luaRelease, reserved;
+    uint64_t sourceHash, sourceSize;
+};
+static_assert(sizeof(BytecodeHeader) == 32, "bytecode header layout");
+
+uint64_t SourceHash(const unsigned char* data, size_t size)
+{
+    uint64_t h = 14695981039346656037ull;   // FNV-1a
+    for (size_t i = 0; i < size; ++i) h = (h ^ data[i]) * 1099511628211ull;
+    return h;
+}
+
+int WriteChunk(lua_State*, const void* p, size_t size, void* ud)
+{
+    auto* out = static_cast<std::vector<char>*>(ud);
+    out->insert(out->end(), static_cast<const char*>(p), static_cast<const char*>(p) + size);
+    return 0;
+}
+
+} // namespace
+
+std::string BytecodePath(const std::string& sourcePath)
+{
+    return sourcePath + "c";
+}
+
+bool LoadBytecode(lua_State* L, const std::string& path, const unsigned char* source, size_t size)
+{
+    const std::string compiledPath = BytecodePath(path);
+    if (!Assets::FileExists(compiledPath)) return false;
+    const Assets::FileView f = Assets::ReadFile(compiledPath);
+    if (!f || f.size <= sizeof(BytecodeHeader)) return false;
+
+    BytecodeHeader hdr;
+    std::memcpy(&hdr, f.data, sizeof(hdr));
+    if (hdr.marker != BYTECODE_MARKER || hdr.version != BYTECODE_VERSION || hdr.luaRelease != LUA_RELEASE ||
+        hdr.sourceSize != size || hdr.sourceHash != SourceHash(source, size))
+        return false;
+
+    // Lua checks the chunk's own header (number sizes, format) as it loads
+    const std::string chunkName = "@" + path;
+    if (luaL_loadbufferx(L, reinterpret_cast<const char*>(f.data) + sizeof(hdr), f.size - sizeof(hdr),
+                         chunkName.c_str(), "b") != LUA_OK) {
+        TraceLog(LOG_WARNING, "[LuaBytecode] ignoring %s: %s", compiledPath.c_str(), lua_tostring(L, -1));
+        lua_pop(L, 1);
+        return false;
+    }
+    return true;
+}
+
+bool CompileScript(const std::string& sourcePath, const std::string& chunkName, std::string& error)
+{
+    std::ifstream in(sourcePath, std::ios::binary);
+    if (!in) {
+        error = "cannot open " + sourcePath;
+        return false;
+    }
+    const std::vector<char> source((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    std::vector<char> chunk;
+    lua_State* L = luaL_newstate();
+    if (!L) {
+        error = "cannot create a Lua state";
+        return false;
+    }
+    const std::string name = "@" + chunkName;
+    const bool compiled = luaL_loadbufferx(L, source.data(), source.size(), name.c_str(), "t") == LUA_OK;
+    if (compiled) lua_dump(L, WriteChunk, &chunk, 0);
+    else          error = lua_tostring(L, -1);
+    lua_close(L);
+    if (!compiled) return false;
+
+    BytecodeHeader hdr{};
+    hdr.marker     = BYTECODE_MARKER;
+    hdr.version    = BYTECODE_VERSION;
+    hdr.luaRelease = LUA_RELEASE;
+    hdr.sourceHash = SourceHash(reinterpret_cast<const unsigned char*>(source.data()), source.size());
+    hdr.sourceSize = source.size();
+
+    // Unique per writer; see StoreBVHCache
+    const std::string path = BytecodePath(sourcePath);
+    const size_t salt = std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+                        static_cast<size_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    const std::string tmpPath = path + "." + std::to_string(salt) + ".tmp";
+    std::error_code ec;
+    {
+        std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+        if (ofs) {
+            ofs.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+            ofs.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        }
+        if (!ofs) {
+            ofs.close();
+            fs::remove(tmpPath, ec);
+            error = "cannot write " + path;
+            return false;
+        }
+    }
+    fs::rename(tmpPath, path, ec);
+    if (ec) {
+        fs::remove(tmpPath, ec);
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+int CompilePackScripts(const std::string& root)
+{
+    std::error_code ec;
+    if (!fs::is_directory(root, ec)) {
+        TraceLog(LOG_ERROR, "[LuaBytecode] %s is not a pack directory", root.c_str());
+        return -1;
+    }
+    int compiled = 0, failed = 0;
+    for (fs::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_regular_file(ec) || it->path().extension() != ".lua") continue;
+        std::string error;
+        const std::string rel = it->path().lexically_relative(root).generic_string();
+        if (CompileScript(it->path().string(), rel, error)) {
+            ++compiled;
+        } else {
+            TraceLog(LOG_ERROR, "[LuaBytecode] %s", error.c_str());
+            ++failed;
+        }
+    }
+    TraceLog(LOG_INFO, "[LuaBytecode] compiled %d script(s) in %s, %d failed", compiled, root.c_str(), failed);
+    return failed;
+}
+
+} // namespace Hotones::Scripting
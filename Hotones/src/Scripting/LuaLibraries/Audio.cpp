@@ -1,4 +1,4 @@
-#include <lua.hpp>
+#include <Scripting/LuaCompat.hpp>
 #include "../../include/Scripting/LuaLoader/Audio.hpp"
 #include "../../include/SFX/AudioSystem.hpp"
 
@@ -14,36 +14,96 @@ static int l_loadSound(lua_State* L)
     return 1;
 }
 
-// audio.play(name [, gain]) -> bool
+// audio.play(name [, gain [, distance]]) -> bool
 static int l_play(lua_State* L)
 {
     const char* name = luaL_checkstring(L, 1);
     float gain = (float)luaL_optnumber(L, 2, 1.0);
-    bool ok = Ho_tones::GetSoundBus().PlayLoaded(name, gain);
+    float distance = (float)luaL_optnumber(L, 3, 0.0);
+    bool ok = Ho_tones::GetSoundBus().PlayLoaded(name, gain, distance);
     lua_pushboolean(L, ok ? 1 : 0);
     return 1;
 }
 
-// audio.playRandom(name [, gain]) -> bool
+// audio.playRandom(name [, gain [, distance]]) -> bool
 static int l_playRandom(lua_State* L)
 {
     const char* name = luaL_checkstring(L, 1);
     float gain = (float)luaL_optnumber(L, 2, 1.0);
-    bool ok = Ho_tones::GetSoundBus().PlayRandom(name, gain);
+    float distance = (float)luaL_optnumber(L, 3, 0.0);
+    bool ok = Ho_tones::GetSoundBus().PlayRandom(name, gain, distance);
     lua_pushboolean(L, ok ? 1 : 0);
     return 1;
 }
 
-// audio.playSequential(name [, gain]) -> bool
+// audio.playSequential(name [, gain [, distance]]) -> bool
 static int l_playSequential(lua_State* L)
 {
     const char* name = luaL_checkstring(L, 1);
     float gain = (float)luaL_optnumber(L, 2, 1.0);
-    bool ok = Ho_tones::GetSoundBus().PlaySequential(name, gain);
+    float distance = (float)luaL_optnumber(L, 3, 0.0);
+    bool ok = Ho_tones::GetSoundBus().PlaySequential(name, gain, distance);
     lua_pushboolean(L, ok ? 1 : 0);
     return 1;
 }
 
+// audio.playSequence(name, count, interval [, gain [, distance]]) -> scheduled count
+static int l_playSequence(lua_State* L)
+{
+    const char* name = luaL_checkstring(L, 1);
+    int count = (int)luaL_checkinteger(L, 2);
+    float interval = (float)luaL_checknumber(L, 3);
+    float gain = (float)luaL_optnumber(L, 4, 1.0);
+    float distance = (float)luaL_optnumber(L, 5, 0.0);
+    lua_pushinteger(L, Ho_tones::GetSoundBus().PlaySequence(name, count, interval, gain, distance));
+    return 1;
+}
+
+// audio.setLimits(name, priority [, maxInstances])
+static int l_setLimits(lua_State* L)
+{
+    const char* name = luaL_checkstring(L, 1);
+    int priority = (int)luaL_checkinteger(L, 2);
+    int maxInstances = (int)luaL_optinteger(L, 3, 0);
+    Ho_tones::GetSoundBus().SetSoundLimits(name, priority, maxInstances);
+    return 0;
+}
+
+// audio.loadStream(name, path [, loop]) -> bool
+static int l_loadStream(lua_State* L)
+{
+    const char* name = luaL_checkstring(L, 1);
+    const char* path = luaL_checkstring(L, 2);
+    bool loop = lua_isnoneornil(L, 3) ? true : lua_toboolean(L, 3) != 0;
+    bool ok = Ho_tones::GetSoundBus().LoadStreamFile(name, path, loop);
+    lua_pushboolean(L, ok ? 1 : 0);
+    return 1;
+}
+
+// audio.playStream(name [, gain]) -> bool
+static int l_playStream(lua_State* L)
+{
+    const char* name = luaL_checkstring(L, 1);
+    float gain = (float)luaL_optnumber(L, 2, 1.0);
+    bool ok = Ho_tones::GetSoundBus().PlayStream(name, gain);
+    lua_pushboolean(L, ok ? 1 : 0);
+    return 1;
+}
+
+// audio.stopStream(name)
+static int l_stopStream(lua_State* L)
+{
+    Ho_tones::GetSoundBus().StopStream(luaL_checkstring(L, 1));
+    return 0;
+}
+
+// audio.isStreamPlaying(name) -> bool
+static int l_isStreamPlaying(lua_State* L)
+{
+    lua_pushboolean(L, Ho_tones::GetSoundBus().IsStreamPlaying(luaL_checkstring(L, 1)) ? 1 : 0);
+    return 1;
+}
+
 // audio.setVolume(vol)  -- 0-100
 static int l_setVolume(lua_State* L)
 {
@@ -66,6 +126,29 @@ static int l_stopAll(lua_State* L)
     return 0;
 }
 
+// audio.getMixStats() -> { mixes, underruns, lastMs, peakMs, budgetMs, voices, peakVoices }
+static int l_getMixStats(lua_State* L)
+{
+    const Ho_tones::SoundBus::MixStats st = Ho_tones::GetSoundBus().GetMixStats();
+    lua_createtable(L, 0, 7);
+    lua_pushinteger(L, (lua_Integer)st.mixes);     lua_setfield(L, -2, "mixes");
+    lua_pushinteger(L, (lua_Integer)st.underruns); lua_setfield(L, -2, "underruns");
+    lua_pushnumber(L, st.lastMs);                  lua_setfield(L, -2, "lastMs");
+    lua_pushnumber(L, st.peakMs);                  lua_setfield(L, -2, "peakMs");
+    lua_pushnumber(L, st.budgetMs);                lua_setfield(L, -2, "budgetMs");
+    lua_pushinteger(L, st.activeVoices);           lua_setfield(L, -2, "voices");
+    lua_pushinteger(L, st.peakVoices);             lua_setfield(L, -2, "peakVoices");
+    return 1;
+}
+
+// audio.resetMixStats()
+static int l_resetMixStats(lua_State* L)
+{
+    (void)L;
+    Ho_tones::GetSoundBus().ResetMixStats();
+    return 0;
+}
+
 void registerAudio(lua_State* L)
 {
     static const luaL_Reg funcs[] = {
@@ -73,9 +156,17 @@ void registerAudio(lua_State* L)
         {"play",           l_play},
         {"playRandom",     l_playRandom},
         {"playSequential", l_playSequential},
+        {"playSequence",   l_playSequence},
+        {"setLimits",      l_setLimits},
+        {"loadStream",     l_loadStream},
+        {"playStream",     l_playStream},
+        {"stopStream",     l_stopStream},
+        {"isStreamPlaying", l_isStreamPlaying},
         {"setVolume",      l_setVolume},
         {"getVolume",      l_getVolume},
         {"stopAll",        l_stopAll},
+        {"getMixStats",    l_getMixStats},
+        {"resetMixStats",  l_resetMixStats},
         {nullptr, nullptr}
     };
 
@@ -1,7 +1,17 @@
-#include <lua.hpp>
+#include <Scripting/LuaCompat.hpp>
 #include <ECS/ECS.hpp>
+#if !HOTONES_HEADLESS
+#include <Assets/AssetCache.hpp>
+#endif
 #include <GFX/Player.hpp>
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <vector>
 #include "../../include/Scripting/LuaLoader/ECS.hpp"
+#include "../../include/Scripting/ScriptSystem.hpp"
+#include <atomic>
 
 // ── Module-level state ────────────────────────────────────────────────────────
 // These pointers are set by the scene before registering / every time the
@@ -12,10 +22,27 @@ namespace Hotones::Scripting::LuaLoader {
 namespace {
     static ECS::Registry* g_registry    = nullptr;
     static Hotones::Player* g_ecsPlayer = nullptr;
+    static ScriptSystem*  g_scripts     = nullptr;
+    static ECS::SpatialIndex* g_spatial = nullptr;
+
+    // Numbers every state registerECS() runs in (packs on several server
+    // threads included), kept in its registry under STATE_STAMP_KEY
+    static std::atomic<uint32_t> g_stateStamps { 0 };
+    static const char STATE_STAMP_KEY = 0;
 } // anonymous namespace
 
 void setECSRegistry(ECS::Registry* reg)      { g_registry  = reg; }
 void setECSLocalPlayer(Hotones::Player* p)   { g_ecsPlayer = p;   }
+void setECSScriptSystem(ScriptSystem* s)     { g_scripts   = s;   }
+void setECSSpatialIndex(ECS::SpatialIndex* s) { g_spatial  = s;   }
+
+uint32_t ecsStateStamp(lua_State* L)
+{
+    lua_rawgetp(L, LUA_REGISTRYINDEX, &STATE_STAMP_KEY);
+    const auto stamp = static_cast<uint32_t>(lua_tointeger(L, -1));
+    lua_pop(L, 1);
+    return stamp;
+}
 
 // ── Helpers ───────────────────────────────────────────────────────────────────
 
@@ -43,7 +70,7 @@ static inline int push3zeros(lua_State* L)
 // ecs.create() → id
 static int l_create(lua_State* L)
 {
-    if (!registryReady(L)) { lua_pushinteger(L, ECS::INVALID_ENTITY); return 1; }
+    if (!registryReady(L)) { lua_pushinteger(L, static_cast<lua_Integer>(ECS::INVALID_ENTITY)); return 1; }
     lua_pushinteger(L, static_cast<lua_Integer>(g_registry->CreateEntity()));
     return 1;
 }
@@ -83,6 +110,7 @@ static int l_setPos(lua_State* L)
     }
 
     g_registry->GetOrAdd<ECS::TransformComponent>(id).position = {x, y, z};
+    g_registry->MarkChanged<ECS::TransformComponent>(id);
     return 0;
 }
 
@@ -106,7 +134,7 @@ static int l_getPos(lua_State* L)
     }
 
     if (g_registry->HasComponent<ECS::TransformComponent>(id)) {
-        auto& t = g_registry->GetComponent<ECS::TransformComponent>(id);
+        auto&& t = g_registry->GetComponent<ECS::TransformComponent>(id);
         lua_pushnumber(L, t.position.x);
         lua_pushnumber(L, t.position.y);
         lua_pushnumber(L, t.position.z);
@@ -125,6 +153,7 @@ static int l_setScale(lua_State* L)
     float sz = static_cast<float>(luaL_checknumber(L, 4));
     if (!g_registry->IsAlive(id)) return 0;
     g_registry->GetOrAdd<ECS::TransformComponent>(id).scale = {sx, sy, sz};
+    g_registry->MarkChanged<ECS::TransformComponent>(id);
     return 0;
 }
 
@@ -156,6 +185,401 @@ static int l_getVelocity(lua_State* L)
     return push3zeros(L);
 }
 
+// ── Hierarchy ────────────────────────────────────────────────────────────────
+// A child's world transform follows its parent's (HierarchySystem); move it
+// with setLocalPos, not setPos.
+
+// ecs.setParent(id, parent [, keepWorld=true]) — parent nil detaches.
+// keepWorld keeps the child where it is; otherwise its current transform
+// becomes its offset from the parent.
+static int l_setParent(lua_State* L)
+{
+    if (!registryReady(L)) return 0;
+    auto id = toEntityId(L, 1);
+    if (!g_registry->IsAlive(id)) return 0;
+    if (lua_isnoneornil(L, 2)) {
+        g_registry->RemoveComponent<ECS::ParentComponent>(id);
+        g_registry->RemoveComponent<ECS::LocalTransformComponent>(id);
+        return 0;
+    }
+    auto parent    = toEntityId(L, 2);
+    bool keepWorld = lua_isnoneornil(L, 3) || lua_toboolean(L, 3);
+    if (!g_registry->IsAlive(parent)) return 0;
+
+    // Refuse to close a loop: id may not be above its new parent
+    for (ECS::EntityId up = parent; g_registry->IsAlive(up);) {
+        if (up == id) {
+            TraceLog(LOG_WARNING, "[ecs] setParent: entity is an ancestor of its new parent — ignored");
+            return 0;
+        }
+        if (!g_registry->HasComponent<ECS::ParentComponent>(up)) break;
+        up = g_registry->GetComponent<ECS::ParentComponent>(up).parent;
+    }
+
+    const ECS::TransformComponent world = g_registry->GetOrAdd<ECS::TransformComponent>(id);
+    const ECS::TransformComponent frame = g_registry->GetOrAdd<ECS::TransformComponent>(parent);
+    ECS::LocalTransformComponent local;
+    if (keepWorld) local = ECS::RelativeTransform(frame, world);
+    else           local = { world.position, world.rotation, world.scale };
+
+    g_registry->GetOrAdd<ECS::ParentComponent>(id);
+    g_registry->GetMut<ECS::ParentComponent>(id).parent = parent;
+    g_registry->GetOrAdd<ECS::LocalTransformComponent>(id);
+    g_registry->GetMut<ECS::LocalTransformComponent>(id) = local;
+    return 0;
+}
+
+// ecs.getParent(id) → parent id, or nil
+static int l_getParent(lua_State* L)
+{
+    auto id = toEntityId(L, 1);
+    if (!g_registry || !g_registry->IsAlive(id) || !g_registry->HasComponent<ECS::ParentComponent>(id)) {
+        lua_pushnil(L);
+        return 1;
+    }
+    lua_pushinteger(L, static_cast<lua_Integer>(g_registry->GetComponent<ECS::ParentComponent>(id).parent));
+    return 1;
+}
+
+// ecs.setLocalPos(id, x, y, z) — offset from the parent, in its space
+static int l_setLocalPos(lua_State* L)
+{
+    if (!registryReady(L)) return 0;
+    auto  id = toEntityId(L, 1);
+    float x  = static_cast<float>(luaL_checknumber(L, 2));
+    float y  = static_cast<float>(luaL_checknumber(L, 3));
+    float z  = static_cast<float>(luaL_checknumber(L, 4));
+    if (!g_registry->IsAlive(id)) return 0;
+    g_registry->GetOrAdd<ECS::LocalTransformComponent>(id);
+    g_registry->GetMut<ECS::LocalTransformComponent>(id).position = {x, y, z};
+    return 0;
+}
+
+// ecs.getLocalPos(id) → x, y, z
+static int l_getLocalPos(lua_State* L)
+{
+    if (!g_registry) return push3zeros(L);
+    auto id = toEntityId(L, 1);
+    if (!g_registry->IsAlive(id) || !g_registry->HasComponent<ECS::LocalTransformComponent>(id))
+        return push3zeros(L);
+    const Vector3 p = g_registry->GetComponent<ECS::LocalTransformComponent>(id).position;
+    lua_pushnumber(L, p.x);
+    lua_pushnumber(L, p.y);
+    lua_pushnumber(L, p.z);
+    return 3;
+}
+
+// ── Bulk queries ──────────────────────────────────────────────────────────────
+// One C call for a whole set of entities instead of one (or several) per
+// entity: ids come back as arrays, vectors as flat x, y, z arrays.
+
+// Component type named `name` in a query; raises a Lua error if unknown
+static ECS::ComponentTypeId componentTypeByName(lua_State* L, const char* name)
+{
+    struct Named { const char* name; ECS::ComponentTypeId id; };
+    static const Named kinds[] = {
+        { "Transform", ECS::ComponentType<ECS::TransformComponent>()      },
+        { "Velocity",  ECS::ComponentType<ECS::VelocityComponent>()       },
+        { "Tag",       ECS::ComponentType<ECS::TagComponent>()            },
+        { "Health",    ECS::ComponentType<ECS::HealthComponent>()         },
+        { "Lifetime",  ECS::ComponentType<ECS::LifetimeComponent>()       },
+        { "Collider",  ECS::ComponentType<ECS::ColliderSphereComponent>() },
+        { "Emitter",   ECS::ComponentType<ECS::AudioEmitterComponent>()   },
+        { "Particles", ECS::ComponentType<ECS::ParticleEmitterComponent>() },
+        { "Network",   ECS::ComponentType<ECS::NetworkComponent>()        },
+        { "Player",    ECS::ComponentType<ECS::PlayerComponent>()         },
+        { "Parent",    ECS::ComponentType<ECS::ParentComponent>()         },
+    };
+    for (const Named& k : kinds)
+        if (std::strcmp(k.name, name) == 0) return k.id;
+    luaL_error(L, "ecs: unknown component '%s'", name);
+    return 0;
+}
+
+// Ids of the entities owning every component named in the array at `idx`
+static void queryIds(lua_State* L, int idx, std::vector<ECS::EntityId>& out)
+{
+    luaL_checktype(L, idx, LUA_TTABLE);
+    ECS::ComponentTypeId types[ECS::MAX_COMPONENT_TYPES];
+    const size_t count = std::min<size_t>(lua_rawlen(L, idx), ECS::MAX_COMPONENT_TYPES);
+    for (size_t i = 0; i < count; ++i) {
+        lua_rawgeti(L, idx, (lua_Integer)i + 1);
+        types[i] = componentTypeByName(L, luaL_checkstring(L, -1));
+        lua_pop(L, 1);
+    }
+    out.clear();
+    if (count == 0) return;
+    g_registry->ViewTypes(types, count, [&](ECS::EntityId id) { out.push_back(id); });
+}
+
+// The table at `idx` if there is one (emptied past `size`), else a new one;
+// left on top of the stack
+static void pushOutTable(lua_State* L, int idx, size_t size)
+{
+    if (lua_istable(L, idx)) {
+        lua_pushvalue(L, idx);
+        for (lua_Integer i = (lua_Integer)lua_rawlen(L, -1); i > (lua_Integer)size; --i) {
+            lua_pushnil(L);
+            lua_rawseti(L, -2, i);
+        }
+    } else {
+        lua_createtable(L, (int)std::min<size_t>(size, INT_MAX), 0);
+    }
+}
+
+// Ids of the last query; no Lua code runs while it is filled and copied out
+static std::vector<ECS::EntityId> s_queryIds;
+
+// s_queryIds as a table of ids (the one at `outIdx` when given)
+static int pushQueryIds(lua_State* L, int outIdx)
+{
+    pushOutTable(L, outIdx, s_queryIds.size());
+    for (size_t i = 0; i < s_queryIds.size(); ++i) {
+        lua_pushinteger(L, static_cast<lua_Integer>(s_queryIds[i]));
+        lua_rawseti(L, -2, (lua_Integer)i + 1);
+    }
+    return 1;
+}
+
+// ecs.query(components [, out]) → ids  (e.g. ecs.query({"Transform", "Velocity"}))
+// Fills `out` when given, so a per-frame query allocates nothing
+static int l_query(lua_State* L)
+{
+    if (!g_registry) { pushOutTable(L, 2, 0); return 1; }
+    queryIds(L, 1, s_queryIds);
+    return pushQueryIds(L, 2);
+}
+
+// ecs.view(components, fn) → count  — fn(id) for each matching entity.
+// The matches are collected first, so fn may add, remove and destroy freely
+// (and run queries of its own).
+static int l_view(lua_State* L)
+{
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+    if (!g_registry) { lua_pushinteger(L, 0); return 1; }
+    lua_settop(L, 2);
+    l_query(L);   // the ids, in a table of their own at 3
+    const lua_Integer n = (lua_Integer)lua_rawlen(L, 3);
+    for (lua_Integer i = 1; i <= n; ++i) {
+        lua_pushvalue(L, 2);
+        lua_rawgeti(L, 3, i);
+        lua_call(L, 1, 0);
+    }
+    lua_pushinteger(L, n);
+    return 1;
+}
+
+// Flat array of three floats per id in the table at 1, from read(id, v);
+// zeros for ids it returns false for
+template<typename Read>
+static int getVectors(lua_State* L, Read&& read)
+{
+    luaL_checktype(L, 1, LUA_TTABLE);
+    const size_t n = lua_rawlen(L, 1);
+    pushOutTable(L, 2, n * 3);
+    for (size_t i = 0; i < n; ++i) {
+        lua_rawgeti(L, 1, (lua_Integer)i + 1);
+        const auto id = static_cast<ECS::EntityId>(lua_tointeger(L, -1));
+        lua_pop(L, 1);
+        Vector3 v = { 0.0f, 0.0f, 0.0f };
+        if (g_registry && g_registry->IsAlive(id) && !read(id, v)) v = { 0.0f, 0.0f, 0.0f };
+        const lua_Integer base = (lua_Integer)i * 3;
+        lua_pushnumber(L, v.x); lua_rawseti(L, -2, base + 1);
+        lua_pushnumber(L, v.y); lua_rawseti(L, -2, base + 2);
+        lua_pushnumber(L, v.z); lua_rawseti(L, -2, base + 3);
+    }
+    return 1;
+}
+
+// write(id, v) for each live id in the table at 1, v from the flat array at 2
+template<typename Write>
+static int setVectors(lua_State* L, Write&& write)
+{
+    luaL_checktype(L, 1, LUA_TTABLE);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    if (!registryReady(L)) return 0;
+    const size_t n = std::min<size_t>(lua_rawlen(L, 1), lua_rawlen(L, 2) / 3);
+    for (size_t i = 0; i < n; ++i) {
+        lua_rawgeti(L, 1, (lua_Integer)i + 1);
+        const auto id = static_cast<ECS::EntityId>(lua_tointeger(L, -1));
+        const lua_Integer base = (lua_Integer)i * 3;
+        lua_rawgeti(L, 2, base + 1);
+        lua_rawgeti(L, 2, base + 2);
+        lua_rawgeti(L, 2, base + 3);
+        const Vector3 v = { static_cast<float>(lua_tonumber(L, -3)),
+                            static_cast<float>(lua_tonumber(L, -2)),
+                            static_cast<float>(lua_tonumber(L, -1)) };
+        lua_pop(L, 4);
+        if (g_registry->IsAlive(id)) write(id, v);
+    }
+    return 0;
+}
+
+// ecs.getPositions(ids [, out]) → { x1, y1, z1, x2, ... }  (as getPos, per id)
+static int l_getPositions(lua_State* L)
+{
+    return getVectors(L, [](ECS::EntityId id, Vector3& v) {
+        if (g_registry->HasComponent<ECS::PlayerComponent>(id)) {
+            auto& pc = g_registry->GetComponent<ECS::PlayerComponent>(id);
+            if (pc.player) { v = pc.player->body.position; return true; }
+        }
+        if (!g_registry->HasComponent<ECS::TransformComponent>(id)) return false;
+        v = g_registry->GetComponent<ECS::TransformComponent>(id).position;
+        return true;
+    });
+}
+
+// ecs.setPositions(ids, xyz)  (as setPos, per id)
+static int l_setPositions(lua_State* L)
+{
+    return setVectors(L, [](ECS::EntityId id, const Vector3& v) {
+        if (g_registry->HasComponent<ECS::PlayerComponent>(id)) {
+            auto& pc = g_registry->GetComponent<ECS::PlayerComponent>(id);
+            if (pc.player) pc.player->body.position = v;
+        }
+        g_registry->GetOrAdd<ECS::TransformComponent>(id).position = v;
+        g_registry->MarkChanged<ECS::TransformComponent>(id);
+    });
+}
+
+// ecs.getVelocities(ids [, out]) → { vx1, vy1, vz1, ... }
+static int l_getVelocities(lua_State* L)
+{
+    return getVectors(L, [](ECS::EntityId id, Vector3& v) {
+        if (!g_registry->HasComponent<ECS::VelocityComponent>(id)) return false;
+        v = g_registry->GetComponent<ECS::VelocityComponent>(id).linear;
+        return true;
+    });
+}
+
+// ecs.setVelocities(ids, xyz)
+static int l_setVelocities(lua_State* L)
+{
+    return setVectors(L, [](ECS::EntityId id, const Vector3& v) {
+        g_registry->GetOrAdd<ECS::VelocityComponent>(id).linear = v;
+    });
+}
+
+// Entities with a transform passing inside(position), by the scene's
+// SpatialIndex when it has one; otherwise (the headless server) a scan
+template<typename Inside>
+static void scanTransforms(Inside&& inside)
+{
+    g_registry->Each<ECS::TransformComponent>([&](ECS::EntityId id, auto&& t) {
+        if (inside(t.position)) s_queryIds.push_back(id);
+    });
+}
+
+// ecs.queryRadius(x, y, z, radius [, out]) → ids  — entities whose position
+// is within `radius` of (x, y, z), in no particular order
+static int l_queryRadius(lua_State* L)
+{
+    const Vector3 c = { (float)luaL_checknumber(L, 1), (float)luaL_checknumber(L, 2),
+                        (float)luaL_checknumber(L, 3) };
+    const float   r = std::max((float)luaL_checknumber(L, 4), 0.0f);
+    s_queryIds.clear();
+    if (g_registry && g_spatial) {
+        g_spatial->QueryRadius(*g_registry, c, r, s_queryIds);
+    } else if (g_registry) {
+        scanTransforms([&](const Vector3& p) {
+            const float dx = p.x - c.x, dy = p.y - c.y, dz = p.z - c.z;
+            return dx * dx + dy * dy + dz * dz <= r * r;
+        });
+    }
+    return pushQueryIds(L, 5);
+}
+
+// ecs.queryBox(minX, minY, minZ, maxX, maxY, maxZ [, out]) → ids  — entities
+// whose position is inside the box
+static int l_queryBox(lua_State* L)
+{
+    BoundingBox box;
+    box.min = { (float)luaL_checknumber(L, 1), (float)luaL_checknumber(L, 2), (float)luaL_checknumber(L, 3) };
+    box.max = { (float)luaL_checknumber(L, 4), (float)luaL_checknumber(L, 5), (float)luaL_checknumber(L, 6) };
+    s_queryIds.clear();
+    if (g_registry && g_spatial) {
+        g_spatial->QueryAABB(*g_registry, box, s_queryIds);
+    } else if (g_registry) {
+        scanTransforms([&](const Vector3& p) {
+            return p.x >= box.min.x && p.x <= box.max.x && p.y >= box.min.y && p.y <= box.max.y &&
+                   p.z >= box.min.z && p.z <= box.max.z;
+        });
+    }
+    return pushQueryIds(L, 7);
+}
+
+#if defined(HOTONES_LUAJIT)
+// ── FFI column access (LuaJIT builds) ─────────────────────────────────────────
+// ffi.cdef(ecs.CDEF) declares the POD components' layouts; ecs.columns()
+// hands out a pool's dense arrays as lightuserdata for ffi.cast.
+
+static const char ECS_CDEF[] = R"(
+typedef struct { float x, y, z; }    hotones_vec3;
+typedef struct { float x, y, z, w; } hotones_quat;
+typedef struct { float current, max; } hotones_health;
+typedef struct { float remaining; }    hotones_lifetime;
+typedef struct { uint8_t peerId; bool isLocal; uint16_t netId; } hotones_network;
+)";
+
+// The cdef above has to match the C++ layouts
+static_assert(sizeof(Vector3) == 12 && sizeof(Quaternion) == 16);
+static_assert(sizeof(ECS::HealthComponent) == 8 && offsetof(ECS::HealthComponent, max) == 4);
+static_assert(sizeof(ECS::LifetimeComponent) == 4);
+static_assert(sizeof(ECS::NetworkComponent) == 4 && offsetof(ECS::NetworkComponent, isLocal) == 1 &&
+              offsetof(ECS::NetworkComponent, netId) == 2);
+
+// The pool of T, or null; with `write`, every entity in it counts as changed
+// this tick, as if each had been written through GetMut
+template<typename T>
+static ECS::ComponentPool<T>* columnPool(bool write)
+{
+    ECS::ComponentPool<T>* pool = g_registry ? g_registry->PoolPtr<T>() : nullptr;
+    if (pool && write && ECS::ComponentTraits<T>::trackChanges)
+        for (uint32_t idx : pool->EntityIndices()) pool->MarkChanged(idx, g_registry->Tick());
+    return pool;
+}
+
+// ecs.columns(component [, write]) → n, array[, array...]
+//   "Transform" → n, position (hotones_vec3*), rotation (hotones_quat*), scale (hotones_vec3*)
+//   "Velocity"  → n, linear, angular (hotones_vec3*)
+//   "Health"    → n, hotones_health*;  "Lifetime" → n, hotones_lifetime*
+//   "Network"   → n, hotones_network*
+// Element i belongs to the i-th id of ecs.query({component}).  The pointers
+// are good until an entity or component is added or removed; pass `write`
+// when writing through them, so change tracking (replication) sees it.
+static int l_columns(lua_State* L)
+{
+    const char* name  = luaL_checkstring(L, 1);
+    const bool  write = lua_toboolean(L, 2) != 0;
+    auto pushArrays = [L](size_t n, auto*... arrays) {
+        lua_pushinteger(L, static_cast<lua_Integer>(n));
+        (lua_pushlightuserdata(L, n ? static_cast<void*>(arrays) : nullptr), ...);
+        return 1 + static_cast<int>(sizeof...(arrays));
+    };
+    if (std::strcmp(name, "Transform") == 0) {
+        auto* pool = columnPool<ECS::TransformComponent>(write);
+        if (!pool) return pushArrays(0, (Vector3*)nullptr, (Quaternion*)nullptr, (Vector3*)nullptr);
+        return pushArrays(pool->Size(), pool->Field<&ECS::TransformComponent::position>(),
+                          pool->Field<&ECS::TransformComponent::rotation>(),
+                          pool->Field<&ECS::TransformComponent::scale>());
+    }
+    if (std::strcmp(name, "Velocity") == 0) {
+        auto* pool = columnPool<ECS::VelocityComponent>(write);
+        if (!pool) return pushArrays(0, (Vector3*)nullptr, (Vector3*)nullptr);
+        return pushArrays(pool->Size(), pool->Field<&ECS::VelocityComponent::linear>(),
+                          pool->Field<&ECS::VelocityComponent::angular>());
+    }
+    auto contiguous = [&](auto* pool) {
+        return pool ? pushArrays(pool->Size(), pool->Components().data())
+                    : pushArrays(0, (void*)nullptr);
+    };
+    if (std::strcmp(name, "Health") == 0)   return contiguous(columnPool<ECS::HealthComponent>(write));
+    if (std::strcmp(name, "Lifetime") == 0) return contiguous(columnPool<ECS::LifetimeComponent>(write));
+    if (std::strcmp(name, "Network") == 0)  return contiguous(columnPool<ECS::NetworkComponent>(write));
+    return luaL_error(L, "ecs.columns: no FFI layout for '%s'", name);
+}
+#endif
+
 // ── Tag ───────────────────────────────────────────────────────────────────────
 
 // ecs.setTag(id, name)
@@ -275,6 +699,234 @@ static int l_getLifetime(lua_State* L)
     return 1;
 }
 
+// ── Collider ──────────────────────────────────────────────────────────────────
+
+// ecs.setCollider(id, radius [, meshHandle [, mask]])  — collide with static meshes
+static int l_setCollider(lua_State* L)
+{
+    if (!registryReady(L)) return 0;
+    auto  id     = toEntityId(L, 1);
+    float radius = static_cast<float>(luaL_checknumber(L, 2));
+    int   handle = static_cast<int>(luaL_optinteger(L, 3, -1));
+    auto  mask   = static_cast<uint32_t>(luaL_optinteger(L, 4, 0xFFFFFFFF));
+    if (!g_registry->IsAlive(id)) return 0;
+    auto& col = g_registry->GetOrAdd<ECS::ColliderSphereComponent>(id);
+    col.radius        = radius;
+    col.physicsHandle = handle;
+    col.collisionMask = mask;
+    (void)g_registry->GetOrAdd<ECS::TransformComponent>(id);
+    (void)g_registry->GetOrAdd<ECS::VelocityComponent>(id);
+    return 0;
+}
+
+// ecs.removeCollider(id)
+static int l_removeCollider(lua_State* L)
+{
+    if (!registryReady(L)) return 0;
+    auto id = toEntityId(L, 1);
+    if (g_registry->IsAlive(id)) g_registry->RemoveComponent<ECS::ColliderSphereComponent>(id);
+    return 0;
+}
+
+// ── Audio emitter ─────────────────────────────────────────────────────────────
+
+// ecs.setEmitter(id, soundKey [, volume [, maxDist [, loop [, pitch]]]])
+// Attach (or replace) an emitter; it plays once ecs.playEmitter() is called.
+static int l_setEmitter(lua_State* L)
+{
+    if (!registryReady(L)) return 0;
+    auto id = toEntityId(L, 1);
+    const char* key = luaL_checkstring(L, 2);
+    if (!g_registry->IsAlive(id)) return 0;
+    auto& em   = g_registry->GetOrAdd<ECS::AudioEmitterComponent>(id);
+    em.soundKey = key;
+    em.volume   = static_cast<float>(luaL_optnumber(L, 3, 1.0));
+    em.maxDist  = static_cast<float>(luaL_optnumber(L, 4, 50.0));
+    em.loop     = lua_toboolean(L, 5) != 0;
+    em.pitch    = static_cast<float>(luaL_optnumber(L, 6, 1.0));
+    (void)g_registry->GetOrAdd<ECS::TransformComponent>(id);
+    return 0;
+}
+
+// Set the emitter's `playing` flag; SpatialAudioSystem starts / stops its voice
+static int setEmitterPlaying(lua_State* L, bool playing)
+{
+    if (!registryReady(L)) return 0;
+    auto id = toEntityId(L, 1);
+    if (g_registry->IsAlive(id) && g_registry->HasComponent<ECS::AudioEmitterComponent>(id))
+        g_registry->GetComponent<ECS::AudioEmitterComponent>(id).playing = playing;
+    return 0;
+}
+
+// ecs.playEmitter(id) / ecs.stopEmitter(id)
+static int l_playEmitter(lua_State* L) { return setEmitterPlaying(L, true);  }
+static int l_stopEmitter(lua_State* L) { return setEmitterPlaying(L, false); }
+
+// ecs.isEmitterPlaying(id) → bool  (a one-shot turns false when it ends)
+static int l_isEmitterPlaying(lua_State* L)
+{
+    if (!g_registry) { lua_pushboolean(L, 0); return 1; }
+    auto id = toEntityId(L, 1);
+    lua_pushboolean(L, g_registry->IsAlive(id) && g_registry->HasComponent<ECS::AudioEmitterComponent>(id)
+                           && g_registry->GetComponent<ECS::AudioEmitterComponent>(id).playing ? 1 : 0);
+    return 1;
+}
+
+// ecs.removeEmitter(id)
+static int l_removeEmitter(lua_State* L)
+{
+    if (!registryReady(L)) return 0;
+    auto id = toEntityId(L, 1);
+    if (g_registry->IsAlive(id)) g_registry->RemoveComponent<ECS::AudioEmitterComponent>(id);
+    return 0;
+}
+
+// ── Particles ─────────────────────────────────────────────────────────────────
+
+// Optional number field `name` of the table at `idx`
+static float optNumberField(lua_State* L, int idx, const char* name, float fallback)
+{
+    lua_getfield(L, idx, name);
+    const float v = lua_isnil(L, -1) ? fallback : static_cast<float>(luaL_checknumber(L, -1));
+    lua_pop(L, 1);
+    return v;
+}
+
+// Optional { x, y, z } field `name` of the table at `idx`
+static Vector3 optVectorField(lua_State* L, int idx, const char* name, Vector3 fallback)
+{
+    lua_getfield(L, idx, name);
+    if (!lua_isnil(L, -1)) {
+        luaL_checktype(L, -1, LUA_TTABLE);
+        const int t = lua_gettop(L);
+        fallback = { optNumberField(L, t, "x", fallback.x),
+                     optNumberField(L, t, "y", fallback.y),
+                     optNumberField(L, t, "z", fallback.z) };
+    }
+    lua_pop(L, 1);
+    return fallback;
+}
+
+// Optional { r, g, b, a } field `name` of the table at `idx` (0 – 255)
+static Color optColorField(lua_State* L, int idx, const char* name, Color fallback)
+{
+    lua_getfield(L, idx, name);
+    if (!lua_isnil(L, -1)) {
+        luaL_checktype(L, -1, LUA_TTABLE);
+        const int t = lua_gettop(L);
+        fallback = { static_cast<unsigned char>(optNumberField(L, t, "r", fallback.r)),
+                     static_cast<unsigned char>(optNumberField(L, t, "g", fallback.g)),
+                     static_cast<unsigned char>(optNumberField(L, t, "b", fallback.b)),
+                     static_cast<unsigned char>(optNumberField(L, t, "a", fallback.a)) };
+    }
+    lua_pop(L, 1);
+    return fallback;
+}
+
+// ecs.setParticles(id, texturePath|nil [, options])
+// Attach (or replace) a particle emitter; options as ParticleEmitterComponent
+// (rate, max, lifetime, lifetimeJitter, direction, spread, speed,
+// speedJitter, gravity, startSize, endSize, startColor, endColor, additive,
+// emitting).
+static int l_setParticles(lua_State* L)
+{
+    if (!registryReady(L)) return 0;
+    auto id = toEntityId(L, 1);
+    const char* path = luaL_optstring(L, 2, nullptr);
+    if (!lua_isnoneornil(L, 3)) luaL_checktype(L, 3, LUA_TTABLE);
+    if (!g_registry->IsAlive(id)) return 0;
+
+    ECS::ParticleEmitterComponent pe;
+#if !HOTONES_HEADLESS
+    if (path && *path) {
+        pe.texture = Assets::AssetCache::Get().LoadTexture(path);
+        if (!pe.texture) TraceLog(LOG_WARNING, "[ecs] setParticles: could not load '%s'", path);
+    }
+#else
+    (void)path;   // nothing draws particles on a server
+#endif
+    if (!lua_isnoneornil(L, 3)) {
+        pe.rate           = optNumberField(L, 3, "rate", pe.rate);
+        pe.maxParticles   = static_cast<uint32_t>(std::max(0.0f, optNumberField(L, 3, "max", (float)pe.maxParticles)));
+        pe.lifetime       = optNumberField(L, 3, "lifetime", pe.lifetime);
+        pe.lifetimeJitter = optNumberField(L, 3, "lifetimeJitter", pe.lifetimeJitter);
+        pe.direction      = optVectorField(L, 3, "direction", pe.direction);
+        pe.spread         = optNumberField(L, 3, "spread", pe.spread);
+        pe.speed          = optNumberField(L, 3, "speed", pe.speed);
+        pe.speedJitter    = optNumberField(L, 3, "speedJitter", pe.speedJitter);
+        pe.gravity        = optVectorField(L, 3, "gravity", pe.gravity);
+        pe.startSize      = optNumberField(L, 3, "startSize", pe.startSize);
+        pe.endSize        = optNumberField(L, 3, "endSize", pe.endSize);
+        pe.startColor     = optColorField(L, 3, "startColor", pe.startColor);
+        pe.endColor       = optColorField(L, 3, "endColor", pe.endColor);
+        lua_getfield(L, 3, "additive");
+        pe.additive = lua_toboolean(L, -1) != 0;
+        lua_getfield(L, 3, "emitting");
+        pe.emitting = lua_isnil(L, -1) || lua_toboolean(L, -1) != 0;
+        lua_pop(L, 2);
+    }
+    g_registry->GetOrAdd<ECS::ParticleEmitterComponent>(id) = std::move(pe);
+    (void)g_registry->GetOrAdd<ECS::TransformComponent>(id);
+    return 0;
+}
+
+// ecs.burstParticles(id, count)  — spawned on the next tick
+static int l_burstParticles(lua_State* L)
+{
+    if (!registryReady(L)) return 0;
+    auto id = toEntityId(L, 1);
+    const lua_Integer count = luaL_checkinteger(L, 2);
+    if (count > 0 && g_registry->IsAlive(id) && g_registry->HasComponent<ECS::ParticleEmitterComponent>(id))
+        g_registry->GetComponent<ECS::ParticleEmitterComponent>(id).burst += static_cast<uint32_t>(count);
+    return 0;
+}
+
+// ecs.setParticlesEmitting(id, enabled)  — particles already out live on
+static int l_setParticlesEmitting(lua_State* L)
+{
+    if (!registryReady(L)) return 0;
+    auto id = toEntityId(L, 1);
+    if (g_registry->IsAlive(id) && g_registry->HasComponent<ECS::ParticleEmitterComponent>(id))
+        g_registry->GetComponent<ECS::ParticleEmitterComponent>(id).emitting = lua_toboolean(L, 2) != 0;
+    return 0;
+}
+
+// ecs.removeParticles(id)
+static int l_removeParticles(lua_State* L)
+{
+    if (!registryReady(L)) return 0;
+    auto id = toEntityId(L, 1);
+    if (g_registry->IsAlive(id)) g_registry->RemoveComponent<ECS::ParticleEmitterComponent>(id);
+    return 0;
+}
+
+// ── Replication ──────────────────────────────────────────────────────────────
+
+// ecs.replicate(id [, enabled=true])  — mirror the entity to clients while
+// hosting (attaches / removes its NetworkComponent).
+static int l_replicate(lua_State* L)
+{
+    if (!registryReady(L)) return 0;
+    auto id      = toEntityId(L, 1);
+    bool enabled = lua_isnoneornil(L, 2) || lua_toboolean(L, 2) != 0;
+    if (!g_registry->IsAlive(id)) return 0;
+    if (enabled) g_registry->GetOrAdd<ECS::NetworkComponent>(id);
+    else         g_registry->RemoveComponent<ECS::NetworkComponent>(id);
+    return 0;
+}
+
+// ecs.getNetId(id) → integer (0 = not replicated yet)
+static int l_getNetId(lua_State* L)
+{
+    if (!g_registry) { lua_pushinteger(L, 0); return 1; }
+    auto id = toEntityId(L, 1);
+    lua_Integer netId = 0;
+    if (g_registry->IsAlive(id) && g_registry->HasComponent<ECS::NetworkComponent>(id))
+        netId = g_registry->GetComponent<ECS::NetworkComponent>(id).netId;
+    lua_pushinteger(L, netId);
+    return 1;
+}
+
 // ── Player controller ─────────────────────────────────────────────────────────
 
 // ecs.addPlayer(id)  — link the entity to the engine Player controller.
@@ -328,6 +980,77 @@ static int l_setPlayerBhop(lua_State* L)
     return 0;
 }
 
+// ── Entity scripts ────────────────────────────────────────────────────────────
+
+// ecs.setScript(id, self, className)  — ScriptSystem calls
+// <className>.update(self, dt) every tick from now on
+static int l_setScript(lua_State* L)
+{
+    if (!registryReady(L)) return 0;
+    auto id = toEntityId(L, 1);
+    luaL_checkany(L, 2);
+    if (lua_isnil(L, 2)) return luaL_argerror(L, 2, "object expected");
+    const char* className = luaL_checkstring(L, 3);
+    if (!g_registry->IsAlive(id)) return 0;
+
+    lua_pushvalue(L, 2);
+    const int ref = luaL_ref(L, LUA_REGISTRYINDEX);
+    // The ref it replaces is released by the ScriptSystem
+    auto& sc     = g_registry->GetOrAdd<ECS::ScriptComponent>(id);
+    sc.className = className;
+    sc.luaRef    = ref;
+    sc.luaState  = ecsStateStamp(L);
+    sc.active    = true;
+    sc.skippedDt = 0.0f;
+    return 0;
+}
+
+// ecs.getScript(id) → self (nil if none)
+static int l_getScript(lua_State* L)
+{
+    auto id = toEntityId(L, 1);
+    if (g_registry && g_registry->IsAlive(id) && g_registry->HasComponent<ECS::ScriptComponent>(id)) {
+        const auto& sc = g_registry->GetComponent<ECS::ScriptComponent>(id);
+        if (sc.luaRef >= 0 && sc.luaState == ecsStateStamp(L)) {
+            lua_rawgeti(L, LUA_REGISTRYINDEX, sc.luaRef);
+            return 1;
+        }
+    }
+    lua_pushnil(L);
+    return 1;
+}
+
+// ecs.setScriptActive(id, active)
+static int l_setScriptActive(lua_State* L)
+{
+    if (!registryReady(L)) return 0;
+    auto id     = toEntityId(L, 1);
+    bool active = lua_toboolean(L, 2) != 0;
+    if (g_registry->IsAlive(id) && g_registry->HasComponent<ECS::ScriptComponent>(id))
+        g_registry->GetComponent<ECS::ScriptComponent>(id).active = active;
+    return 0;
+}
+
+// ecs.removeScript(id)
+static int l_removeScript(lua_State* L)
+{
+    if (!registryReady(L)) return 0;
+    auto id = toEntityId(L, 1);
+    if (g_registry->IsAlive(id)) g_registry->RemoveComponent<ECS::ScriptComponent>(id);
+    return 0;
+}
+
+// ecs.setScriptThrottle(distance [, interval=4])  — beyond `distance` from
+// the player, scripts update every `interval` ticks; 0 turns it off
+static int l_setScriptThrottle(lua_State* L)
+{
+    ScriptSystem::Throttle t;
+    t.nearDistance = std::max(static_cast<float>(luaL_checknumber(L, 1)), 0.0f);
+    t.farInterval  = static_cast<uint32_t>(std::clamp<lua_Integer>(luaL_optinteger(L, 2, 4), 1, 1000));
+    if (g_scripts) g_scripts->SetThrottle(t);
+    return 0;
+}
+
 // ── Registration ─────────────────────────────────────────────────────────────
 
 void registerECS(lua_State* L)
@@ -343,6 +1066,20 @@ void registerECS(lua_State* L)
         {"setScale",        l_setScale},
         {"setVelocity",     l_setVelocity},
         {"getVelocity",     l_getVelocity},
+        // Hierarchy
+        {"setParent",       l_setParent},
+        {"getParent",       l_getParent},
+        {"setLocalPos",     l_setLocalPos},
+        {"getLocalPos",     l_getLocalPos},
+        // Bulk queries
+        {"query",           l_query},
+        {"view",            l_view},
+        {"getPositions",    l_getPositions},
+        {"setPositions",    l_setPositions},
+        {"getVelocities",   l_getVelocities},
+        {"setVelocities",   l_setVelocities},
+        {"queryRadius",     l_queryRadius},
+        {"queryBox",        l_queryBox},
         // Tag
         {"setTag",          l_setTag},
         {"getTag",          l_getTag},
@@ -355,15 +1092,47 @@ void registerECS(lua_State* L)
         // Lifetime
         {"setLifetime",     l_setLifetime},
         {"getLifetime",     l_getLifetime},
+        // Collider
+        {"setCollider",     l_setCollider},
+        {"removeCollider",  l_removeCollider},
+
+        {"setEmitter",       l_setEmitter},
+        {"playEmitter",      l_playEmitter},
+        {"stopEmitter",      l_stopEmitter},
+        {"isEmitterPlaying", l_isEmitterPlaying},
+        {"removeEmitter",    l_removeEmitter},
+        // Particles
+        {"setParticles",         l_setParticles},
+        {"burstParticles",       l_burstParticles},
+        {"setParticlesEmitting", l_setParticlesEmitting},
+        {"removeParticles",      l_removeParticles},
+        // Replication
+        {"replicate",       l_replicate},
+        {"getNetId",        l_getNetId},
         // Player controller (opt-in)
         {"addPlayer",       l_addPlayer},
         {"hasPlayer",       l_hasPlayer},
         {"removePlayer",    l_removePlayer},
         {"setPlayerBhop",   l_setPlayerBhop},
+        // Entity scripts
+        {"setScript",         l_setScript},
+        {"getScript",         l_getScript},
+        {"setScriptActive",   l_setScriptActive},
+        {"removeScript",      l_removeScript},
+        {"setScriptThrottle", l_setScriptThrottle},
         {nullptr, nullptr}
     };
 
+    lua_pushinteger(L, static_cast<lua_Integer>(++g_stateStamps));
+    lua_rawsetp(L, LUA_REGISTRYINDEX, &STATE_STAMP_KEY);
+
     luaL_newlib(L, funcs);
+#if defined(HOTONES_LUAJIT)
+    lua_pushcfunction(L, l_columns);
+    lua_setfield(L, -2, "columns");
+    lua_pushstring(L, ECS_CDEF);
+    lua_setfield(L, -2, "CDEF");
+#endif
     lua_setglobal(L, "ecs");
 }
 
@@ -1,5 +1,5 @@
 #include <raylib.h>
-#include <lua.hpp>
+#include <Scripting/LuaCompat.hpp>
 #include "../../include/Scripting/LuaLoader/Input.hpp"
 #include <Input/InputHandler.hpp>
 
@@ -15,11 +15,13 @@
 //   lighting.setIntensity(handle, value)
 //   lighting.setRange(handle, value)
 //   lighting.setEnabled(handle, bool)
+//   lighting.setShadows(handle, bool)
+//   lighting.setShadowBudget(tilesPerFrame)
 //
 // Colour parameters (r, g, b) use the same 0-255 integer convention as the
 // rest of the engine's Lua API.  They are converted to linear 0-1 internally.
 
-#include <lua.hpp>
+#include <Scripting/LuaCompat.hpp>
 #include "../../include/Scripting/LuaLoader/Lighting.hpp"
 #include "../../include/GFX/LightingSystem.hpp"
 #include <cmath>
@@ -138,6 +140,23 @@ static int l_setEnabled(lua_State* L)
     return 0;
 }
 
+// lighting.setShadows(handle, bool)
+static int l_setShadows(lua_State* L)
+{
+    int  h = (int)luaL_checkinteger(L, 1);
+    bool v = lua_toboolean(L, 2) != 0;
+    auto* light = GFX::LightingSystem::Get().GetLight(h);
+    if (light) light->castsShadows = v;
+    return 0;
+}
+
+// lighting.setShadowBudget(tilesPerFrame)
+static int l_setShadowBudget(lua_State* L)
+{
+    GFX::LightingSystem::Get().SetShadowBudget((int)luaL_checkinteger(L, 1));
+    return 0;
+}
+
 // lighting.setSpotAngles(handle, innerDeg, outerDeg)
 // Convenience: set spot cone angles in degrees.
 static int l_setSpotAngles(lua_State* L)
@@ -166,6 +185,8 @@ void registerLighting(lua_State* L)
         {"setRange",      l_setRange},
         {"setEnabled",    l_setEnabled},
         {"setSpotAngles", l_setSpotAngles},
+        {"setShadows",    l_setShadows},
+        {"setShadowBudget", l_setShadowBudget},
         {nullptr, nullptr}
     };
 
@@ -1,4 +1,4 @@
-#include <lua.hpp>
+#include <Scripting/LuaCompat.hpp>
 #include <GFX/Player.hpp>
 #include "../../include/Scripting/LuaLoader/LocalPlayer.hpp"
 
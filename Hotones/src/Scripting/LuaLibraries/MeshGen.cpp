@@ -1,13 +1,25 @@
 #include <raylib.h>
-#include <lua.hpp>
+#include <Scripting/LuaCompat.hpp>
 #include "../../include/Scripting/LuaLoader/MeshGen.hpp"
+#include "../../include/GFX/PrimitiveBatch.hpp"
+#include "../../include/GFX/DrawList.hpp"
 
-// All functions here call raylib 3D primitives directly.
-// They must only be called from Lua's draw3D() callback, which the engine
-// invokes between BeginMode3D() / EndMode3D().
+// Solid primitives go to the scene's PrimitiveBatch when one is set, and are
+// drawn when draw3D() returns; otherwise, like lines, wires, the grid and
+// axes, they call raylib 3D primitives directly.  Either way they must only
+// be called from Lua's draw3D() callback, which the engine invokes between
+// BeginMode3D() / EndMode3D().  While the thread records into a DrawList
+// (ScriptedScene captures draw3D() that way), everything is written there
+// and drawn when the scene replays it.
 
 namespace Hotones::Scripting::LuaLoader {
 
+static GFX::PrimitiveBatch* s_batch = nullptr;
+
+void setMeshBatch(GFX::PrimitiveBatch* batch) { s_batch = batch; }
+
+static bool batching() { return s_batch && s_batch->IsReady(); }
+
 // Helper: read an optional RGBA block starting at stack index `first`.
 static Color optColor(lua_State* L, int first,
                       unsigned char dr = 255, unsigned char dg = 255,
@@ -30,7 +42,9 @@ static int l_plane(lua_State* L)
     float w = (float)luaL_checknumber(L, 4);
     float d = (float)luaL_checknumber(L, 5);
     Color c = optColor(L, 6, 100, 180, 100);
-    DrawPlane({ x, y, z }, { w, d }, c);
+    if (GFX::DrawList* list = GFX::DrawList::Recording()) list->Plane({ x, y, z }, { w, d }, c);
+    else if (batching()) s_batch->Plane({ x, y, z }, { w, d }, c);
+    else                 DrawPlane({ x, y, z }, { w, d }, c);
     return 0;
 }
 
@@ -44,7 +58,9 @@ static int l_box(lua_State* L)
     float h = (float)luaL_checknumber(L, 5);
     float d = (float)luaL_checknumber(L, 6);
     Color c = optColor(L, 7);
-    DrawCubeV({ x, y, z }, { w, h, d }, c);
+    if (GFX::DrawList* list = GFX::DrawList::Recording()) list->Box({ x, y, z }, { w, h, d }, c);
+    else if (batching()) s_batch->Box({ x, y, z }, { w, h, d }, c);
+    else                 DrawCubeV({ x, y, z }, { w, h, d }, c);
     return 0;
 }
 
@@ -58,7 +74,8 @@ static int l_boxWires(lua_State* L)
     float h = (float)luaL_checknumber(L, 5);
     float d = (float)luaL_checknumber(L, 6);
     Color c = optColor(L, 7, 200, 200, 200);
-    DrawCubeWiresV({ x, y, z }, { w, h, d }, c);
+    if (GFX::DrawList* list = GFX::DrawList::Recording()) list->CubeWires({ x, y, z }, { w, h, d }, c);
+    else DrawCubeWiresV({ x, y, z }, { w, h, d }, c);
     return 0;
 }
 
@@ -72,7 +89,9 @@ static int l_sphere(lua_State* L)
     int   rings  = (int)luaL_optinteger(L, 5, 16);
     int   slices = (int)luaL_optinteger(L, 6, 16);
     Color c      = optColor(L, 7);
-    DrawSphereEx({ x, y, z }, radius, rings, slices, c);
+    if (GFX::DrawList* list = GFX::DrawList::Recording()) list->Sphere({ x, y, z }, radius, rings, slices, c);
+    else if (batching()) s_batch->Sphere({ x, y, z }, radius, rings, slices, c);
+    else                 DrawSphereEx({ x, y, z }, radius, rings, slices, c);
     return 0;
 }
 
@@ -87,7 +106,9 @@ static int l_cylinder(lua_State* L)
     float h    = (float)luaL_checknumber(L, 6);
     int   slic = (int)luaL_optinteger(L, 7, 16);
     Color c    = optColor(L, 8);
-    DrawCylinderEx({ x, y, z }, { x, y + h, z }, rbot, rtop, slic, c);
+    if (GFX::DrawList* list = GFX::DrawList::Recording()) list->Cylinder({ x, y, z }, rtop, rbot, h, slic, c);
+    else if (batching()) s_batch->Cylinder({ x, y, z }, rtop, rbot, h, slic, c);
+    else                 DrawCylinderEx({ x, y, z }, { x, y + h, z }, rbot, rtop, slic, c);
     return 0;
 }
 
@@ -101,7 +122,8 @@ static int l_line(lua_State* L)
                   (float)luaL_checknumber(L,5),
                   (float)luaL_checknumber(L,6) };
     Color c   = optColor(L, 7);
-    DrawLine3D(a, b, c);
+    if (GFX::DrawList* list = GFX::DrawList::Recording()) list->Line3D(a, b, c);
+    else DrawLine3D(a, b, c);
     return 0;
 }
 
@@ -110,7 +132,8 @@ static int l_grid(lua_State* L)
 {
     int   slices  = (int)luaL_optinteger(L, 1, 20);
     float spacing = (float)luaL_optnumber(L,  2, 1.0);
-    DrawGrid(slices, spacing);
+    if (GFX::DrawList* list = GFX::DrawList::Recording()) list->Grid(slices, spacing);
+    else DrawGrid(slices, spacing);
     return 0;
 }
 
@@ -121,12 +144,16 @@ static int l_axes(lua_State* L)
     float y    = (float)luaL_optnumber(L, 2, 0.0);
     float z    = (float)luaL_optnumber(L, 3, 0.0);
     float size = (float)luaL_optnumber(L, 4, 1.0);
+    const auto line = [](Vector3 a, Vector3 b, Color c) {
+        if (GFX::DrawList* list = GFX::DrawList::Recording()) list->Line3D(a, b, c);
+        else DrawLine3D(a, b, c);
+    };
     // X — red
-    DrawLine3D({ x, y, z }, { x + size, y, z }, RED);
+    line({ x, y, z }, { x + size, y, z }, RED);
     // Y — green
-    DrawLine3D({ x, y, z }, { x, y + size, z }, GREEN);
+    line({ x, y, z }, { x, y + size, z }, GREEN);
     // Z — blue
-    DrawLine3D({ x, y, z }, { x, y, z + size }, BLUE);
+    line({ x, y, z }, { x, y, z + size }, BLUE);
     return 0;
 }
 
@@ -0,0 +1,228 @@
+#include <Scripting/LuaCompat.hpp>
+#include <raylib.h>
+#include <deque>
+#include <new>
+#include <vector>
+#include "../../include/Scripting/LuaLoader/Nav.hpp"
+#include "../../include/Physics/NavMesh.hpp"
+
+namespace Hotones::Scripting::LuaLoader {
+
+namespace {
+    // Registry keys of the state's PathQueue (a full userdata) and of its
+    // callbacks table: callbacks[id] = function for each pending path.  A
+    // path whose id is no longer in the table was cancelled.
+    static const char QUEUE_KEY     = 0;
+    static const char CALLBACKS_KEY = 0;
+    static const char* const QUEUE_META = "nav.queue";
+
+    struct PathQueue {
+        struct Batch {
+            Jobs::JobFuture<std::vector<Physics::PathResult>> paths;
+            std::vector<lua_Integer>                          ids;
+        };
+        std::vector<Physics::PathRequest> requests;   // asked for since the last dispatch
+        std::vector<lua_Integer>          ids;
+        std::deque<Batch>                 running;    // oldest first
+        lua_Integer                       nextId = 0;
+    };
+
+    static int l_queueGc(lua_State* L)
+    {
+        // Running batches hold their own results; they finish unobserved
+        static_cast<PathQueue*>(lua_touserdata(L, 1))->~PathQueue();
+        return 0;
+    }
+
+    static PathQueue& QueueOf(lua_State* L)
+    {
+        return *static_cast<PathQueue*>(lua_touserdata(L, lua_upvalueindex(1)));
+    }
+
+    static PathQueue* FindQueue(lua_State* L)
+    {
+        lua_rawgetp(L, LUA_REGISTRYINDEX, &QUEUE_KEY);
+        auto* q = static_cast<PathQueue*>(lua_touserdata(L, -1));
+        lua_pop(L, 1);
+        return q;
+    }
+
+    // Optional number field `name` of the table at `idx`
+    static float optField(lua_State* L, int idx, const char* name, float fallback)
+    {
+        lua_getfield(L, idx, name);
+        const float v = lua_isnil(L, -1) ? fallback : static_cast<float>(luaL_checknumber(L, -1));
+        lua_pop(L, 1);
+        return v;
+    }
+
+    // An array of {x, y, z} tables
+    static void pushPoints(lua_State* L, const std::vector<Vector3>& points)
+    {
+        lua_createtable(L, static_cast<int>(points.size()), 0);
+        for (size_t i = 0; i < points.size(); ++i) {
+            lua_createtable(L, 0, 3);
+            lua_pushnumber(L, points[i].x);
+            lua_setfield(L, -2, "x");
+            lua_pushnumber(L, points[i].y);
+            lua_setfield(L, -2, "y");
+            lua_pushnumber(L, points[i].z);
+            lua_setfield(L, -2, "z");
+            lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
+        }
+    }
+
+    // pcall message handler: the error with the stack it was raised from
+    static int l_traceback(lua_State* L)
+    {
+        const char* msg = lua_tostring(L, 1);
+        if (!msg) msg = lua_pushfstring(L, "(error object is a %s value)", luaL_typename(L, 1));
+        luaL_traceback(L, L, msg, 1);
+        return 1;
+    }
+}
+
+// nav.build([{ maxSlope, agentHeight, weldDistance, mask }]) -> polygons
+static int l_build(lua_State* L)
+{
+    Physics::NavMeshSettings settings;
+    if (!lua_isnoneornil(L, 1)) {
+        luaL_checktype(L, 1, LUA_TTABLE);
+        settings.maxSlopeDegrees = optField(L, 1, "maxSlope", settings.maxSlopeDegrees);
+        settings.agentHeight     = optField(L, 1, "agentHeight", settings.agentHeight);
+        settings.weldDistance    = optField(L, 1, "weldDistance", settings.weldDistance);
+        lua_getfield(L, 1, "mask");
+        if (!lua_isnil(L, -1)) settings.mask = static_cast<Physics::LayerMask>(luaL_checkinteger(L, -1));
+        lua_pop(L, 1);
+    }
+    lua_pushinteger(L, static_cast<lua_Integer>(Physics::BuildNavMesh(settings)));
+    return 1;
+}
+
+// nav.isReady() -> boolean
+static int l_isReady(lua_State* L)
+{
+    lua_pushboolean(L, Physics::HasNavMesh() ? 1 : 0);
+    return 1;
+}
+
+// nav.findPath(sx, sy, sz, ex, ey, ez, callback) -> id
+static int l_findPath(lua_State* L)
+{
+    const Vector3 start = { (float)luaL_checknumber(L, 1), (float)luaL_checknumber(L, 2), (float)luaL_checknumber(L, 3) };
+    const Vector3 end   = { (float)luaL_checknumber(L, 4), (float)luaL_checknumber(L, 5), (float)luaL_checknumber(L, 6) };
+    luaL_checktype(L, 7, LUA_TFUNCTION);
+
+    PathQueue& q = QueueOf(L);
+    const lua_Integer id = ++q.nextId;
+    q.requests.push_back({ start, end });
+    q.ids.push_back(id);
+
+    lua_pushinteger(L, id);
+    lua_pushvalue(L, 7);
+    lua_rawset(L, lua_upvalueindex(2));
+    lua_pushinteger(L, id);
+    return 1;
+}
+
+// nav.cancel(id) -> boolean
+static int l_cancel(lua_State* L)
+{
+    const lua_Integer id = luaL_checkinteger(L, 1);
+    const int callbacks = lua_upvalueindex(2);
+    lua_pushinteger(L, id);
+    lua_rawget(L, callbacks);
+    const bool pending = !lua_isnil(L, -1);
+    lua_pop(L, 1);
+    if (pending) {
+        lua_pushinteger(L, id);
+        lua_pushnil(L);
+        lua_rawset(L, callbacks);
+    }
+    lua_pushboolean(L, pending ? 1 : 0);
+    return 1;
+}
+
+void registerNav(lua_State* L)
+{
+    static const luaL_Reg funcs[] = {
+        {"build",    l_build},
+        {"isReady",  l_isReady},
+        {"findPath", l_findPath},
+        {"cancel",   l_cancel},
+        {nullptr, nullptr}
+    };
+
+    luaL_newlibtable(L, funcs);
+
+    new (lua_newuserdata(L, sizeof(PathQueue))) PathQueue();
+    if (luaL_newmetatable(L, QUEUE_META)) {
+        lua_pushcfunction(L, l_queueGc);
+        lua_setfield(L, -2, "__gc");
+    }
+    lua_setmetatable(L, -2);
+    lua_pushvalue(L, -1);
+    lua_rawsetp(L, LUA_REGISTRYINDEX, &QUEUE_KEY);
+
+    lua_newtable(L);
+    lua_pushvalue(L, -1);
+    lua_rawsetp(L, LUA_REGISTRYINDEX, &CALLBACKS_KEY);
+
+    luaL_setfuncs(L, funcs, 2);
+    lua_setglobal(L, "nav");
+}
+
+void dispatchPaths(lua_State* L)
+{
+    PathQueue* q = FindQueue(L);
+    if (!q || q->requests.empty()) return;
+    q->running.push_back({ Physics::FindPathsAsync(std::move(q->requests)), std::move(q->ids) });
+    q->requests.clear();
+    q->ids.clear();
+}
+
+bool deliverPaths(lua_State* L, std::string& error)
+{
+    PathQueue* q = FindQueue(L);
+    if (!q || q->running.empty() || !q->running.front().paths.Ready()) return true;
+
+    const int top = lua_gettop(L);
+    lua_pushcfunction(L, l_traceback);
+    const int handler = lua_gettop(L);
+    lua_rawgetp(L, LUA_REGISTRYINDEX, &CALLBACKS_KEY);
+    const int callbacks = lua_gettop(L);
+    int failures = 0;
+    while (!q->running.empty() && q->running.front().paths.Ready()) {
+        // Callbacks may ask for more paths, but those only start at the
+        // next dispatch, so the deque is not touched while this batch is read
+        PathQueue::Batch batch = std::move(q->running.front());
+        q->running.pop_front();
+        const std::vector<Physics::PathResult>& paths = batch.paths.Get();
+        for (size_t i = 0; i < batch.ids.size() && i < paths.size(); ++i) {
+            lua_pushinteger(L, batch.ids[i]);
+            lua_rawget(L, callbacks);
+            if (lua_isnil(L, -1)) {   // cancelled
+                lua_pop(L, 1);
+                continue;
+            }
+            lua_pushinteger(L, batch.ids[i]);
+            lua_pushnil(L);
+            lua_rawset(L, callbacks);
+
+            if (paths[i].found) pushPoints(L, paths[i].points);
+            else                lua_pushnil(L);
+            lua_pushboolean(L, paths[i].partial ? 1 : 0);
+            lua_pushinteger(L, batch.ids[i]);
+            if (lua_pcall(L, 3, 0, handler) != LUA_OK) {
+                error = lua_tostring(L, -1);
+                failures++;
+                TraceLog(LOG_ERROR, "[nav] %s", error.c_str());
+                lua_pop(L, 1);
+            }
+        }
+    }
+    lua_settop(L, top);
+    return failures == 0;
+}
+
+} // namespace Hotones::Scripting::LuaLoader
@@ -1,15 +1,21 @@
-#include <lua.hpp>
+#include <Scripting/LuaCompat.hpp>
 #include <raylib.h>
 #include "../../include/Scripting/LuaLoader/Physics.hpp"
 #include "../../include/Physics/PhysicsSystem.hpp"
 
 namespace Hotones::Scripting::LuaLoader {
 
-// physics.raycast(handle, ox, oy, oz, dx, dy, dz [, maxDist])
+// Optional collision layer mask at `idx`; every layer when absent.
+static Hotones::Physics::LayerMask optLayerMask(lua_State* L, int idx) {
+    return static_cast<Hotones::Physics::LayerMask>(luaL_optinteger(L, idx, Hotones::Physics::LAYER_ALL));
+}
+
+// physics.raycast(handle, ox, oy, oz, dx, dy, dz [, maxDist [, mask]])
 //
 // Cast a ray from (ox,oy,oz) in direction (dx,dy,dz).
 // dir does NOT need to be normalised; the returned t is in the same units
-// as the direction vector's length.  maxDist defaults to 1000.
+// as the direction vector's length.  maxDist defaults to 1000.  Only
+// triangles whose layers meet `mask` are hit.
 //
 // Returns (on hit):   true, hitX, hitY, hitZ, normX, normY, normZ, t
 // Returns (on miss):  false
@@ -22,6 +28,7 @@ static int l_raycast(lua_State* L) {
     float dy      = (float)luaL_checknumber(L, 6);
     float dz      = (float)luaL_checknumber(L, 7);
     float maxDist = (float)luaL_optnumber(L, 8, 1000.0);
+    auto  mask    = optLayerMask(L, 9);
 
     Vector3 origin  = { ox, oy, oz };
     Vector3 dir     = { dx, dy, dz };
@@ -30,7 +37,7 @@ static int l_raycast(lua_State* L) {
     float   t       = 0.f;
 
     bool hit = Hotones::Physics::RaycastAgainstStatic(
-        handle, origin, dir, maxDist, hitPos, hitNorm, t);
+        handle, origin, dir, maxDist, hitPos, hitNorm, t, mask);
 
     lua_pushboolean(L, hit ? 1 : 0);
     if (hit) {
@@ -46,7 +53,7 @@ static int l_raycast(lua_State* L) {
     return 1;
 }
 
-// physics.sweepSphere(handle, sx, sy, sz, ex, ey, ez, radius)
+// physics.sweepSphere(handle, sx, sy, sz, ex, ey, ez, radius [, mask])
 //
 // Sweep a sphere of the given radius from (sx,sy,sz) to (ex,ey,ez).
 // t ∈ [0,1] is the fraction along the segment where contact occurs.
@@ -62,6 +69,7 @@ static int l_sweepSphere(lua_State* L) {
     float ey     = (float)luaL_checknumber(L, 6);
     float ez     = (float)luaL_checknumber(L, 7);
     float radius = (float)luaL_checknumber(L, 8);
+    auto  mask   = optLayerMask(L, 9);
 
     Vector3 start   = { sx, sy, sz };
     Vector3 end     = { ex, ey, ez };
@@ -70,7 +78,7 @@ static int l_sweepSphere(lua_State* L) {
     float   t       = 0.f;
 
     bool hit = Hotones::Physics::SweepSphereAgainstStatic(
-        handle, start, end, radius, hitPos, hitNorm, t);
+        handle, start, end, radius, hitPos, hitNorm, t, mask);
 
     lua_pushboolean(L, hit ? 1 : 0);
     if (hit) {
@@ -86,10 +94,78 @@ static int l_sweepSphere(lua_State* L) {
     return 1;
 }
 
+// physics.raycastWorld(ox, oy, oz, dx, dy, dz [, maxDist [, mask]])
+//
+// physics.raycast against every registered static mesh at once.
+//
+// Returns (on hit):   true, hitX, hitY, hitZ, normX, normY, normZ, t, handle
+// Returns (on miss):  false
+static int l_raycastWorld(lua_State* L) {
+    Vector3 origin  = { (float)luaL_checknumber(L, 1), (float)luaL_checknumber(L, 2), (float)luaL_checknumber(L, 3) };
+    Vector3 dir     = { (float)luaL_checknumber(L, 4), (float)luaL_checknumber(L, 5), (float)luaL_checknumber(L, 6) };
+    float   maxDist = (float)luaL_optnumber(L, 7, 1000.0);
+    auto    mask    = optLayerMask(L, 8);
+    Vector3 hitPos  = { 0, 0, 0 };
+    Vector3 hitNorm = { 0, 1, 0 };
+    float   t       = 0.f;
+    int     handle  = -1;
+
+    bool hit = Hotones::Physics::RaycastWorld(origin, dir, maxDist, hitPos, hitNorm, t, &handle, mask);
+
+    lua_pushboolean(L, hit ? 1 : 0);
+    if (hit) {
+        lua_pushnumber(L, hitPos.x);
+        lua_pushnumber(L, hitPos.y);
+        lua_pushnumber(L, hitPos.z);
+        lua_pushnumber(L, hitNorm.x);
+        lua_pushnumber(L, hitNorm.y);
+        lua_pushnumber(L, hitNorm.z);
+        lua_pushnumber(L, t);
+        lua_pushinteger(L, handle);
+        return 9;
+    }
+    return 1;
+}
+
+// physics.sweepSphereWorld(sx, sy, sz, ex, ey, ez, radius [, mask])
+//
+// physics.sweepSphere against every registered static mesh at once.
+//
+// Returns (on hit):   true, hitX, hitY, hitZ, normX, normY, normZ, t, handle
+// Returns (on miss):  false
+static int l_sweepSphereWorld(lua_State* L) {
+    Vector3 start   = { (float)luaL_checknumber(L, 1), (float)luaL_checknumber(L, 2), (float)luaL_checknumber(L, 3) };
+    Vector3 end     = { (float)luaL_checknumber(L, 4), (float)luaL_checknumber(L, 5), (float)luaL_checknumber(L, 6) };
+    float   radius  = (float)luaL_checknumber(L, 7);
+    auto    mask    = optLayerMask(L, 8);
+    Vector3 hitPos  = { 0, 0, 0 };
+    Vector3 hitNorm = { 0, 1, 0 };
+    float   t       = 0.f;
+    int     handle  = -1;
+
+    bool hit = Hotones::Physics::SweepSphereWorld(start, end, radius, hitPos, hitNorm, t, &handle, mask);
+
+    lua_pushboolean(L, hit ? 1 : 0);
+    if (hit) {
+        lua_pushnumber(L, hitPos.x);
+        lua_pushnumber(L, hitPos.y);
+        lua_pushnumber(L, hitPos.z);
+        lua_pushnumber(L, hitNorm.x);
+        lua_pushnumber(L, hitNorm.y);
+        lua_pushnumber(L, hitNorm.z);
+        lua_pushnumber(L, t);
+        lua_pushinteger(L, handle);
+        return 9;
+    }
+    return 1;
+}
+
 void registerPhysics(lua_State* L) {
     static const luaL_Reg funcs[] = {
-        { "raycast",     l_raycast     },
-        { "sweepSphere", l_sweepSphere },
+        { "raycast",          l_raycast          },
+        { "sweepSphere",      l_sweepSphere      },
+        { "raycastWorld",     l_raycastWorld     },
+        { "sweepSphereWorld", l_sweepSphereWorld },
         { NULL, NULL }
     };
     luaL_newlib(L, funcs);
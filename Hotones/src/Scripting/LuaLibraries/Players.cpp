@@ -1,71 +1,259 @@
-#include <lua.hpp>
+#include <Scripting/LuaCompat.hpp>
+#include <cstring>
 #include <server/NetworkManager.hpp>
 #include "../../include/Scripting/LuaLoader/Players.hpp"
 
 namespace Hotones::Scripting::LuaLoader {
 
 namespace {
-    static Net::NetworkManager* g_netMgr = nullptr;
+    // Each Lua state keeps its own NetworkManager in its registry, so
+    // several packs (one per hosted match) can run side by side
+    static const char NET_MGR_KEY = 0;
 
-    // Build and push a Lua table for a RemotePlayer snapshot.
-    // Leaves the table on top of the stack.
-    static void pushPlayerTable(lua_State* L, const Net::RemotePlayer& rp)
+    static Net::NetworkManager* NetMgr(lua_State* L)
     {
-        lua_newtable(L);
+        lua_rawgetp(L, LUA_REGISTRYINDEX, &NET_MGR_KEY);
+        auto* nm = static_cast<Net::NetworkManager*>(lua_touserdata(L, -1));
+        lua_pop(L, 1);
+        return nm;
+    }
+
+    // Registry key of the table of player proxies by id (see pushProxy)
+    static const char PROXY_CACHE_KEY = 0;
+    static const char* const PROXY_META = "network.player";
+
+    struct PlayerProxy { Net::PlayerId id; };
+
+    // Write a RemotePlayer snapshot's fields into the table at `idx`.
+    static void setPlayerFields(lua_State* L, int idx, const Net::RemotePlayer& rp)
+    {
+        idx = lua_absindex(L, idx);
 
         lua_pushinteger(L, static_cast<lua_Integer>(rp.id));
-        lua_setfield(L, -2, "id");
+        lua_setfield(L, idx, "id");
 
         lua_pushstring(L, rp.name);
-        lua_setfield(L, -2, "name");
+        lua_setfield(L, idx, "name");
 
         lua_pushnumber(L, static_cast<lua_Number>(rp.posX));
-        lua_setfield(L, -2, "x");
+        lua_setfield(L, idx, "x");
 
         lua_pushnumber(L, static_cast<lua_Number>(rp.posY));
-        lua_setfield(L, -2, "y");
+        lua_setfield(L, idx, "y");
 
         lua_pushnumber(L, static_cast<lua_Number>(rp.posZ));
-        lua_setfield(L, -2, "z");
+        lua_setfield(L, idx, "z");
 
         lua_pushnumber(L, static_cast<lua_Number>(rp.rotX));
-        lua_setfield(L, -2, "rotX");
+        lua_setfield(L, idx, "rotX");
 
         lua_pushnumber(L, static_cast<lua_Number>(rp.rotY));
-        lua_setfield(L, -2, "rotY");
+        lua_setfield(L, idx, "rotY");
+    }
+
+    // Build and push a Lua table for a RemotePlayer snapshot.
+    // Leaves the table on top of the stack.
+    static void pushPlayerTable(lua_State* L, const Net::RemotePlayer& rp)
+    {
+        lua_createtable(L, 0, 7);
+        setPlayerFields(L, -1, rp);
+    }
+
+    // Push the proxy for player `id`.  There is one per id per state, made
+    // on first use and kept, so handing them out every frame allocates
+    // nothing.
+    static void pushProxy(lua_State* L, Net::PlayerId id)
+    {
+        lua_rawgetp(L, LUA_REGISTRYINDEX, &PROXY_CACHE_KEY);
+        if (lua_rawgeti(L, -1, id) == LUA_TNIL) {
+            lua_pop(L, 1);
+            static_cast<PlayerProxy*>(lua_newuserdata(L, sizeof(PlayerProxy)))->id = id;
+            luaL_setmetatable(L, PROXY_META);
+            lua_pushvalue(L, -1);
+            lua_rawseti(L, -3, id);
+        }
+        lua_remove(L, -2);
+    }
+
+    // Truncate the array at `idx` to `size` entries
+    static void truncateArray(lua_State* L, int idx, lua_Integer size)
+    {
+        for (lua_Integer i = (lua_Integer)lua_rawlen(L, idx); i > size; --i) {
+            lua_pushnil(L);
+            lua_rawseti(L, idx, i);
+        }
+    }
+
+    // Push a table of one connection's (or the total) traffic figures.
+    static void pushConnectionStats(lua_State* L, const Net::ConnectionStats& c)
+    {
+        lua_newtable(L);
+
+        lua_pushinteger(L, static_cast<lua_Integer>(c.id));
+        lua_setfield(L, -2, "id");
+
+        lua_pushinteger(L, static_cast<lua_Integer>(c.packetsIn));
+        lua_setfield(L, -2, "packetsIn");
+
+        lua_pushinteger(L, static_cast<lua_Integer>(c.packetsOut));
+        lua_setfield(L, -2, "packetsOut");
+
+        lua_pushinteger(L, static_cast<lua_Integer>(c.bytesIn));
+        lua_setfield(L, -2, "bytesIn");
+
+        lua_pushinteger(L, static_cast<lua_Integer>(c.bytesOut));
+        lua_setfield(L, -2, "bytesOut");
+
+        lua_pushnumber(L, static_cast<lua_Number>(c.packetsInPerSec));
+        lua_setfield(L, -2, "packetsInPerSec");
+
+        lua_pushnumber(L, static_cast<lua_Number>(c.packetsOutPerSec));
+        lua_setfield(L, -2, "packetsOutPerSec");
+
+        lua_pushnumber(L, static_cast<lua_Number>(c.bytesInPerSec));
+        lua_setfield(L, -2, "bytesInPerSec");
+
+        lua_pushnumber(L, static_cast<lua_Number>(c.bytesOutPerSec));
+        lua_setfield(L, -2, "bytesOutPerSec");
+
+        lua_pushnumber(L, static_cast<lua_Number>(c.rttMs));
+        lua_setfield(L, -2, "rtt");
+
+        lua_pushnumber(L, static_cast<lua_Number>(c.lossPercent));
+        lua_setfield(L, -2, "loss");
+
+        lua_pushinteger(L, static_cast<lua_Integer>(c.reliablePending));
+        lua_setfield(L, -2, "reliablePending");
+
+        lua_pushnumber(L, static_cast<lua_Number>(c.sendRate));
+        lua_setfield(L, -2, "sendRate");
     }
 } // anonymous namespace
 
-// ── network.getPlayers() -> table[] ─────────────────────────────────────────
-// Returns an array of player tables, one per active remote player.
+// ── network.getPlayers([out]) -> table[] ────────────────────────────────────
+// Returns an array of player tables, one per active remote player.  Given
+// last call's result as `out`, refills it and the player tables already in
+// it instead of building new ones.
 static int l_getPlayers(lua_State* L)
 {
-    lua_newtable(L);
-    if (!g_netMgr) return 1;
+    Net::NetworkManager* nm = NetMgr(L);
+    const bool reuse = lua_istable(L, 1);
+    if (reuse) lua_pushvalue(L, 1);
+    else       lua_newtable(L);
+    const int out = lua_gettop(L);
 
-    int idx = 1;
-    for (const auto& [id, rp] : g_netMgr->GetRemotePlayers()) {
-        if (!rp.active) continue;
-        pushPlayerTable(L, rp);
-        lua_rawseti(L, -2, idx++);
+    lua_Integer n = 0;
+    if (nm) {
+        for (const auto& rp : nm->GetRemotePlayers()) {
+            if (!rp.active) continue;
+            ++n;
+            if (reuse && lua_rawgeti(L, out, n) == LUA_TTABLE) {
+                setPlayerFields(L, -1, rp);
+                lua_pop(L, 1);
+                continue;
+            }
+            if (reuse) lua_pop(L, 1);
+            pushPlayerTable(L, rp);
+            lua_rawseti(L, out, n);
+        }
     }
+    if (reuse) truncateArray(L, out, n);
     return 1;
 }
 
-// ── network.getPlayer(id) -> table | nil ─────────────────────────────────────
+// ── network.getPlayer(id [, out]) -> table | nil ────────────────────────────
 // Returns a single player table for the given ID, or nil if not found.
+// Fills and returns `out` when given.
 static int l_getPlayer(lua_State* L)
 {
+    Net::NetworkManager* nm = NetMgr(L);
     lua_Integer id = luaL_checkinteger(L, 1);
-    if (!g_netMgr) { lua_pushnil(L); return 1; }
+    const Net::RemotePlayer* rp = nm ? nm->FindRemotePlayer(static_cast<Net::PlayerId>(id)) : nullptr;
+    if (!rp || !rp->active) {
+        lua_pushnil(L);
+        return 1;
+    }
+    if (lua_istable(L, 2)) {
+        setPlayerFields(L, 2, *rp);
+        lua_pushvalue(L, 2);
+    } else {
+        pushPlayerTable(L, *rp);
+    }
+    return 1;
+}
 
-    const auto& players = g_netMgr->GetRemotePlayers();
-    auto it = players.find(static_cast<uint8_t>(id));
-    if (it == players.end() || !it->second.active) {
+// ── network.players([out]) -> proxy[] ───────────────────────────────────────
+// Like getPlayers(), with a proxy per player in place of a table.
+static int l_players(lua_State* L)
+{
+    Net::NetworkManager* nm = NetMgr(L);
+    const bool reuse = lua_istable(L, 1);
+    if (reuse) lua_pushvalue(L, 1);
+    else       lua_newtable(L);
+    const int out = lua_gettop(L);
+
+    lua_Integer n = 0;
+    if (nm) {
+        for (const auto& rp : nm->GetRemotePlayers()) {
+            if (!rp.active) continue;
+            pushProxy(L, rp.id);
+            lua_rawseti(L, out, ++n);
+        }
+    }
+    if (reuse) truncateArray(L, out, n);
+    return 1;
+}
+
+// ── network.player(id) -> proxy | nil ───────────────────────────────────────
+static int l_player(lua_State* L)
+{
+    Net::NetworkManager* nm = NetMgr(L);
+    lua_Integer id = luaL_checkinteger(L, 1);
+    const Net::RemotePlayer* rp = nm ? nm->FindRemotePlayer(static_cast<Net::PlayerId>(id)) : nullptr;
+    if (!rp || !rp->active) {
         lua_pushnil(L);
         return 1;
     }
-    pushPlayerTable(L, it->second);
+    pushProxy(L, rp->id);
+    return 1;
+}
+
+// ── proxy.<field> ────────────────────────────────────────────────────────────
+// Reads the player table's fields from the current snapshot, plus `active`.
+// Once the player has left only `id` and `active` (false) remain.
+static int l_proxyIndex(lua_State* L)
+{
+    const auto* proxy = static_cast<const PlayerProxy*>(luaL_checkudata(L, 1, PROXY_META));
+    const char* key   = lua_type(L, 2) == LUA_TSTRING ? lua_tostring(L, 2) : "";
+    if (std::strcmp(key, "id") == 0) {
+        lua_pushinteger(L, static_cast<lua_Integer>(proxy->id));
+        return 1;
+    }
+    Net::NetworkManager* nm = NetMgr(L);
+    const Net::RemotePlayer* rp = nm ? nm->FindRemotePlayer(proxy->id) : nullptr;
+    if (rp && !rp->active) rp = nullptr;
+    if (std::strcmp(key, "active") == 0) {
+        lua_pushboolean(L, rp ? 1 : 0);
+        return 1;
+    }
+    if (!rp) {
+        lua_pushnil(L);
+        return 1;
+    }
+    if      (std::strcmp(key, "name") == 0) lua_pushstring(L, rp->name);
+    else if (std::strcmp(key, "x")    == 0) lua_pushnumber(L, static_cast<lua_Number>(rp->posX));
+    else if (std::strcmp(key, "y")    == 0) lua_pushnumber(L, static_cast<lua_Number>(rp->posY));
+    else if (std::strcmp(key, "z")    == 0) lua_pushnumber(L, static_cast<lua_Number>(rp->posZ));
+    else if (std::strcmp(key, "rotX") == 0) lua_pushnumber(L, static_cast<lua_Number>(rp->rotX));
+    else if (std::strcmp(key, "rotY") == 0) lua_pushnumber(L, static_cast<lua_Number>(rp->rotY));
+    else                                    lua_pushnil(L);
+    return 1;
+}
+
+static int l_proxyToString(lua_State* L)
+{
+    const auto* proxy = static_cast<const PlayerProxy*>(luaL_checkudata(L, 1, PROXY_META));
+    lua_pushfstring(L, "player %d", static_cast<int>(proxy->id));
     return 1;
 }
 
@@ -73,9 +261,10 @@ static int l_getPlayer(lua_State* L)
 // Returns the number of currently active remote players.
 static int l_getPlayerCount(lua_State* L)
 {
-    if (!g_netMgr) { lua_pushinteger(L, 0); return 1; }
+    Net::NetworkManager* nm = NetMgr(L);
+    if (!nm) { lua_pushinteger(L, 0); return 1; }
     int count = 0;
-    for (const auto& [id, rp] : g_netMgr->GetRemotePlayers())
+    for (const auto& rp : nm->GetRemotePlayers())
         if (rp.active) ++count;
     lua_pushinteger(L, static_cast<lua_Integer>(count));
     return 1;
@@ -85,8 +274,9 @@ static int l_getPlayerCount(lua_State* L)
 // Returns our own assigned player ID. Returns 0 if not connected.
 static int l_getLocalId(lua_State* L)
 {
-    if (!g_netMgr) { lua_pushinteger(L, 0); return 1; }
-    lua_pushinteger(L, static_cast<lua_Integer>(g_netMgr->GetLocalId()));
+    Net::NetworkManager* nm = NetMgr(L);
+    if (!nm) { lua_pushinteger(L, 0); return 1; }
+    lua_pushinteger(L, static_cast<lua_Integer>(nm->GetLocalId()));
     return 1;
 }
 
@@ -94,8 +284,9 @@ static int l_getLocalId(lua_State* L)
 // Returns "server", "client", or "none".
 static int l_getMode(lua_State* L)
 {
-    if (!g_netMgr) { lua_pushstring(L, "none"); return 1; }
-    switch (g_netMgr->GetMode()) {
+    Net::NetworkManager* nm = NetMgr(L);
+    if (!nm) { lua_pushstring(L, "none"); return 1; }
+    switch (nm->GetMode()) {
         case Net::NetworkManager::Mode::Server: lua_pushstring(L, "server"); break;
         case Net::NetworkManager::Mode::Client: lua_pushstring(L, "client"); break;
         default:                                lua_pushstring(L, "none");   break;
@@ -107,28 +298,107 @@ static int l_getMode(lua_State* L)
 // Returns true when connected as a client.
 static int l_isConnected(lua_State* L)
 {
-    lua_pushboolean(L, (g_netMgr && g_netMgr->IsConnected()) ? 1 : 0);
+    Net::NetworkManager* nm = NetMgr(L);
+    lua_pushboolean(L, (nm && nm->IsConnected()) ? 1 : 0);
+    return 1;
+}
+
+// ── network.setRenderDelay(ms) ──────────────────────────────────────────────
+// How far behind the newest received state remote players are drawn.
+static int l_setRenderDelay(lua_State* L)
+{
+    Net::NetworkManager* nm = NetMgr(L);
+    lua_Integer ms = luaL_checkinteger(L, 1);
+    if (nm && ms >= 0) nm->SetRenderDelay(static_cast<int>(ms));
+    return 0;
+}
+
+// ── network.getRenderDelay() -> integer ─────────────────────────────────────
+static int l_getRenderDelay(lua_State* L)
+{
+    Net::NetworkManager* nm = NetMgr(L);
+    lua_pushinteger(L, nm ? static_cast<lua_Integer>(nm->GetRenderDelay()) : 0);
+    return 1;
+}
+
+// ── network.send(data [, to]) -> boolean ────────────────────────────────────
+// Reliable, ordered message; arrives as MainClass:onMessage(from, data).
+static int l_send(lua_State* L)
+{
+    Net::NetworkManager* nm = NetMgr(L);
+    size_t len = 0;
+    const char* data = luaL_checklstring(L, 1, &len);
+    lua_Integer to   = luaL_optinteger(L, 2, 0);
+    const bool ok = nm && to >= 0 && to <= 0xFFFF
+                 && nm->SendReliable(static_cast<Net::PlayerId>(to), data, len);
+    lua_pushboolean(L, ok ? 1 : 0);
+    return 1;
+}
+
+// ── network.stats() -> table ────────────────────────────────────────────────
+// Totals plus recvQueuePeak, recvOverflows, sendOverflows and a
+// `connections` array.
+static int l_stats(lua_State* L)
+{
+    Net::NetworkManager* nm = NetMgr(L);
+    const Net::NetStats s = nm ? nm->GetStats() : Net::NetStats{};
+    pushConnectionStats(L, s.total);
+
+    lua_pushinteger(L, static_cast<lua_Integer>(s.recvQueuePeak));
+    lua_setfield(L, -2, "recvQueuePeak");
+
+    lua_pushinteger(L, static_cast<lua_Integer>(s.recvOverflows));
+    lua_setfield(L, -2, "recvOverflows");
+
+    lua_pushinteger(L, static_cast<lua_Integer>(s.sendOverflows));
+    lua_setfield(L, -2, "sendOverflows");
+
+    lua_newtable(L);
+    int idx = 1;
+    for (const auto& c : s.connections) {
+        pushConnectionStats(L, c);
+        lua_rawseti(L, -2, idx++);
+    }
+    lua_setfield(L, -2, "connections");
     return 1;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
 
-void setPlayersNetworkManager(Net::NetworkManager* nm)
+void setPlayersNetworkManager(lua_State* L, Net::NetworkManager* nm)
 {
-    g_netMgr = nm;
+    lua_pushlightuserdata(L, nm);
+    lua_rawsetp(L, LUA_REGISTRYINDEX, &NET_MGR_KEY);
 }
 
 void registerPlayers(lua_State* L, Net::NetworkManager* nm)
 {
-    g_netMgr = nm;
+    setPlayersNetworkManager(L, nm);
+
+    static const luaL_Reg proxyMeta[] = {
+        {"__index",    l_proxyIndex},
+        {"__tostring", l_proxyToString},
+        {nullptr, nullptr}
+    };
+    luaL_newmetatable(L, PROXY_META);
+    luaL_setfuncs(L, proxyMeta, 0);
+    lua_pop(L, 1);
+    lua_newtable(L);
+    lua_rawsetp(L, LUA_REGISTRYINDEX, &PROXY_CACHE_KEY);
 
     static const luaL_Reg funcs[] = {
         {"getPlayers",      l_getPlayers},
         {"getPlayer",       l_getPlayer},
+        {"players",         l_players},
+        {"player",          l_player},
         {"getPlayerCount",  l_getPlayerCount},
         {"getLocalId",      l_getLocalId},
         {"getMode",         l_getMode},
         {"isConnected",     l_isConnected},
+        {"setRenderDelay",  l_setRenderDelay},
+        {"getRenderDelay",  l_getRenderDelay},
+        {"send",            l_send},
+        {"stats",           l_stats},
         {nullptr, nullptr}
     };
 
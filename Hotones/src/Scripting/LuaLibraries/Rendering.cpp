@@ -1,5 +1,5 @@
 #include <iostream>
-#include <lua.hpp>
+#include <Scripting/LuaCompat.hpp>
 #include "../../include/Scripting/LuaLoader/Rendering.hpp"
 #include "../../include/GFX/Renderer.hpp"
 
@@ -1,14 +1,17 @@
-#include <chrono>
 #include <cstdio>
 #include <iostream>
-#include <lua.hpp>
+#include <Scripting/LuaCompat.hpp>
+#include <Time/FrameClock.hpp>
 #include "../../include/Scripting/LuaLoader/ServerLib.hpp"
 
 namespace Hotones::Scripting::LuaLoader {
 
 namespace {
-    // Set once when registerServer() is first called (i.e. when the pack loads).
-    static std::chrono::steady_clock::time_point g_startTime;
+    // Frame time on a client, wall time on a server (Time/FrameClock.hpp)
+    static double SteadySeconds()
+    {
+        return Time::FrameClock::Get().Now();
+    }
 }
 
 // server.log(msg)
@@ -19,26 +22,26 @@ static int l_log(lua_State* L)
     return 0;
 }
 
-// server.getTime() -> seconds (float)
+// server.getTime() -> seconds (float) since this state registered the library.
+// Upvalue 1 = that moment, so each Lua state keeps its own clock.
 static int l_getTime(lua_State* L)
 {
-    using namespace std::chrono;
-    double secs = duration<double>(steady_clock::now() - g_startTime).count();
+    double secs = SteadySeconds() - lua_tonumber(L, lua_upvalueindex(1));
     lua_pushnumber(L, (lua_Number)secs);
     return 1;
 }
 
 void registerServer(lua_State* L)
 {
-    g_startTime = std::chrono::steady_clock::now();
-
     static const luaL_Reg funcs[] = {
         {"log",     l_log},
         {"getTime", l_getTime},
         {nullptr, nullptr}
     };
 
-    luaL_newlib(L, funcs);
+    luaL_newlibtable(L, funcs);
+    lua_pushnumber(L, (lua_Number)SteadySeconds());
+    luaL_setfuncs(L, funcs, 1);
     lua_setglobal(L, "server");
 }
 
@@ -0,0 +1,296 @@
+#include <Scripting/LuaCompat.hpp>
+#include <Time/FrameClock.hpp>
+#include <raylib.h>
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <vector>
+#include "../../include/Scripting/LuaLoader/Task.hpp"
+
+namespace Hotones::Scripting::LuaLoader {
+
+namespace {
+    // Registry keys of the state's Scheduler (a full userdata) and of its
+    // tasks table, which keeps every live task reachable:
+    //   tasks[thread] = timer id while waiting, 0 while running
+    //   tasks[id]     = thread, for each pending timer
+    // A timer whose id is no longer in the table was cancelled.
+    static const char SCHEDULER_KEY = 0;
+    static const char TASKS_KEY     = 0;
+    static const char* const SCHEDULER_META = "task.scheduler";
+
+    // The frame clock on a client, so a replayed session's timers fire on
+    // the frames they did when it was recorded; wall time on a server
+    static double SteadySeconds()
+    {
+        return Time::FrameClock::Get().Now();
+    }
+
+    struct Timer {
+        double      due;     // seconds, or update count
+        double      since;   // SteadySeconds() when it started waiting
+        uint64_t    seq;     // ties go to the earlier wait
+        lua_Integer id;
+    };
+
+    // Min-heap order for std::push_heap / pop_heap
+    static bool Later(const Timer& a, const Timer& b)
+    {
+        return a.due != b.due ? a.due > b.due : a.seq > b.seq;
+    }
+
+    struct Scheduler {
+        std::vector<Timer> byTime, byTick;
+        uint64_t    tick      = 0;       // updateTasks() calls so far
+        uint64_t    seq       = 0;
+        lua_Integer nextId    = 0;
+        bool        scheduled = false;   // the running task called wait*()
+        int         failures  = 0;       // since the last updateTasks()
+        std::string lastError;
+    };
+
+    static int l_schedulerGc(lua_State* L)
+    {
+        static_cast<Scheduler*>(lua_touserdata(L, 1))->~Scheduler();
+        return 0;
+    }
+
+    static Scheduler& SchedulerOf(lua_State* L)
+    {
+        return *static_cast<Scheduler*>(lua_touserdata(L, lua_upvalueindex(1)));
+    }
+
+    // Error unless L is a running task; anything else yielding here would
+    // hand control to whoever resumed it instead of to the scheduler
+    static void checkTask(lua_State* L, const char* fname)
+    {
+        bool isTask = false;
+        if (!lua_pushthread(L)) {
+            lua_rawget(L, lua_upvalueindex(2));
+            isTask = !lua_isnil(L, -1);
+        }
+        lua_pop(L, 1);
+        if (!isTask) luaL_error(L, "task.%s: call it from a function started by task.spawn", fname);
+    }
+
+    // Make the task at `coIdx` wait on `heap` until `due`
+    static void addTimer(lua_State* L, int coIdx, int tasksIdx, Scheduler& s, std::vector<Timer>& heap,
+                         double due, double since)
+    {
+        const lua_Integer id = ++s.nextId;
+        lua_pushinteger(L, id);
+        lua_pushvalue(L, coIdx);
+        lua_rawset(L, tasksIdx);
+        lua_pushvalue(L, coIdx);
+        lua_pushinteger(L, id);
+        lua_rawset(L, tasksIdx);
+
+        heap.push_back({ due, since, s.seq++, id });
+        std::push_heap(heap.begin(), heap.end(), Later);
+    }
+
+    // wait*() from the running task (L); the caller yields
+    static void scheduleSelf(lua_State* L, Scheduler& s, std::vector<Timer>& heap, double due, double since)
+    {
+        lua_pushthread(L);
+        addTimer(L, lua_gettop(L), lua_upvalueindex(2), s, heap, due, since);
+        lua_pop(L, 1);
+        s.scheduled = true;
+    }
+
+    // Resume the task at `coIdx` with `nargs` values already on its stack,
+    // until it waits, returns or fails.  `tasksIdx` is the tasks table.
+    static void run(lua_State* L, int coIdx, int nargs, Scheduler& s, int tasksIdx)
+    {
+        lua_State* co = lua_tothread(L, coIdx);
+        const bool outer = s.scheduled;   // a task may spawn another
+        s.scheduled = false;
+        int nres = 0;
+        const int status = lua_resume(co, L, nargs, &nres);
+        const bool waiting = s.scheduled;
+        s.scheduled = outer;
+
+        if (status == LUA_YIELD) {
+            lua_pop(co, nres);
+            if (!waiting)   // bare coroutine.yield(): try again next update
+                addTimer(L, coIdx, tasksIdx, s, s.byTick, static_cast<double>(s.tick + 1), SteadySeconds());
+            return;
+        }
+        if (status != LUA_OK) {
+            const char* msg = lua_tostring(co, -1);
+            luaL_traceback(L, co, msg ? msg : "(error object is not a string)", 0);
+            s.lastError = lua_tostring(L, -1);
+            s.failures++;
+            TraceLog(LOG_ERROR, "[task] %s", s.lastError.c_str());
+            lua_pop(L, 1);
+        }
+        // Finished or failed: let it be collected, dropping any timer it set
+        // before failing to yield (say, across a C call)
+        lua_pushvalue(L, coIdx);
+        lua_rawget(L, tasksIdx);
+        const lua_Integer id = lua_tointeger(L, -1);
+        lua_pop(L, 1);
+        if (id != 0) {
+            lua_pushinteger(L, id);
+            lua_pushnil(L);
+            lua_rawset(L, tasksIdx);
+        }
+        lua_pushvalue(L, coIdx);
+        lua_pushnil(L);
+        lua_rawset(L, tasksIdx);
+    }
+
+    // Resume the tasks on `heap` due by `now`, except those that started
+    // waiting during this pass (`seqLimit` on)
+    static void resumeDue(lua_State* L, Scheduler& s, std::vector<Timer>& heap, double now, uint64_t seqLimit,
+                          bool timed, int tasksIdx)
+    {
+        while (!heap.empty() && heap.front().due <= now && heap.front().seq < seqLimit) {
+            std::pop_heap(heap.begin(), heap.end(), Later);
+            const Timer t = heap.back();
+            heap.pop_back();
+
+            lua_pushinteger(L, t.id);
+            lua_rawget(L, tasksIdx);
+            if (lua_isnil(L, -1)) {   // cancelled
+                lua_pop(L, 1);
+                continue;
+            }
+            const int coIdx = lua_gettop(L);
+            lua_pushinteger(L, t.id);
+            lua_pushnil(L);
+            lua_rawset(L, tasksIdx);
+            lua_pushvalue(L, coIdx);
+            lua_pushinteger(L, 0);
+            lua_rawset(L, tasksIdx);
+
+            int nargs = 0;
+            if (timed) {
+                lua_pushnumber(lua_tothread(L, coIdx), static_cast<lua_Number>(SteadySeconds() - t.since));
+                nargs = 1;
+            }
+            run(L, coIdx, nargs, s, tasksIdx);
+            lua_settop(L, coIdx - 1);
+        }
+    }
+}
+
+// task.spawn(fn, ...) -> thread
+static int l_spawn(lua_State* L)
+{
+    luaL_checktype(L, 1, LUA_TFUNCTION);
+    const int nargs = lua_gettop(L) - 1;
+    lua_State* co = lua_newthread(L);
+    lua_insert(L, 1);
+    lua_xmove(L, co, nargs + 1);   // fn and its arguments; leaves the thread
+
+    lua_pushvalue(L, 1);
+    lua_pushinteger(L, 0);
+    lua_rawset(L, lua_upvalueindex(2));
+    run(L, 1, nargs, SchedulerOf(L), lua_upvalueindex(2));
+    lua_settop(L, 1);
+    return 1;
+}
+
+// task.wait([seconds]) -> seconds waited
+static int l_wait(lua_State* L)
+{
+    const double seconds = std::max(static_cast<double>(luaL_optnumber(L, 1, 0)), 0.0);
+    checkTask(L, "wait");
+    Scheduler& s = SchedulerOf(L);
+    const double now = SteadySeconds();
+    scheduleSelf(L, s, s.byTime, now + seconds, now);
+    return lua_yield(L, 0);
+}
+
+// task.waitTicks([n])
+static int l_waitTicks(lua_State* L)
+{
+    const lua_Integer n = std::max<lua_Integer>(luaL_optinteger(L, 1, 1), 1);
+    checkTask(L, "waitTicks");
+    Scheduler& s = SchedulerOf(L);
+    scheduleSelf(L, s, s.byTick, static_cast<double>(s.tick + static_cast<uint64_t>(n)), SteadySeconds());
+    return lua_yield(L, 0);
+}
+
+// task.cancel(thread) -> boolean
+static int l_cancel(lua_State* L)
+{
+    luaL_checktype(L, 1, LUA_TTHREAD);
+    const int tasks = lua_upvalueindex(2);
+    lua_pushvalue(L, 1);
+    lua_rawget(L, tasks);
+    const lua_Integer id = lua_tointeger(L, -1);
+    lua_pop(L, 1);
+    if (id == 0) {   // not a task, finished, or running
+        lua_pushboolean(L, 0);
+        return 1;
+    }
+    lua_pushinteger(L, id);
+    lua_pushnil(L);
+    lua_rawset(L, tasks);
+    lua_pushvalue(L, 1);
+    lua_pushnil(L);
+    lua_rawset(L, tasks);
+    lua_pushboolean(L, 1);
+    return 1;
+}
+
+void registerTask(lua_State* L)
+{
+    static const luaL_Reg funcs[] = {
+        {"spawn",     l_spawn},
+        {"wait",      l_wait},
+        {"waitTicks", l_waitTicks},
+        {"cancel",    l_cancel},
+        {nullptr, nullptr}
+    };
+
+    luaL_newlibtable(L, funcs);
+
+    new (lua_newuserdata(L, sizeof(Scheduler))) Scheduler();
+    if (luaL_newmetatable(L, SCHEDULER_META)) {
+        lua_pushcfunction(L, l_schedulerGc);
+        lua_setfield(L, -2, "__gc");
+    }
+    lua_setmetatable(L, -2);
+    lua_pushvalue(L, -1);
+    lua_rawsetp(L, LUA_REGISTRYINDEX, &SCHEDULER_KEY);
+
+    lua_newtable(L);
+    lua_pushvalue(L, -1);
+    lua_rawsetp(L, LUA_REGISTRYINDEX, &TASKS_KEY);
+
+    luaL_setfuncs(L, funcs, 2);
+    lua_setglobal(L, "task");
+}
+
+bool updateTasks(lua_State* L, std::string& error)
+{
+    lua_rawgetp(L, LUA_REGISTRYINDEX, &SCHEDULER_KEY);
+    auto* s = static_cast<Scheduler*>(lua_touserdata(L, -1));
+    lua_pop(L, 1);
+    if (!s) return true;
+
+    s->tick++;
+    const double now = SteadySeconds();
+    const bool tickDue = !s->byTick.empty() && s->byTick.front().due <= static_cast<double>(s->tick);
+    const bool timeDue = !s->byTime.empty() && s->byTime.front().due <= now;
+    if (tickDue || timeDue) {
+        const int top = lua_gettop(L);
+        lua_rawgetp(L, LUA_REGISTRYINDEX, &TASKS_KEY);
+        const int tasksIdx = lua_gettop(L);
+        const uint64_t seqLimit = s->seq;
+        resumeDue(L, *s, s->byTick, static_cast<double>(s->tick), seqLimit, false, tasksIdx);
+        resumeDue(L, *s, s->byTime, now, seqLimit, true, tasksIdx);
+        lua_settop(L, top);
+    }
+
+    if (s->failures == 0) return true;
+    error = std::move(s->lastError);
+    s->lastError.clear();
+    s->failures = 0;
+    return false;
+}
+
+} // namespace Hotones::Scripting::LuaLoader
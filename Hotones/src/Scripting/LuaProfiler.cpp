@@ -0,0 +1,206 @@
+// LuaProfiler.cpp — stack sampling and callback timers for a Lua state
+
+#include "../include/Scripting/LuaProfiler.hpp"
+#include <Profile/Profiler.hpp>
+#include <algorithm>
+#include <fstream>
+#include <string_view>
+
+#include <Scripting/LuaCompat.hpp>
+
+namespace Hotones::Scripting {
+
+namespace {
+
+constexpr int MAX_DEPTH = 64;   // frames sampled per stack, innermost first
+
+// Registry key for the profiler hooked into a state
+const char PROFILER_KEY = 0;
+
+const char* const NO_CALLBACK = "(outside callbacks)";
+
+// "update (scripts/ai.lua:12)", reusing `out`'s storage
+void FrameLabel(const lua_Debug& ar, std::string& out)
+{
+    const std::string_view what = ar.what ? ar.what : "";
+    if (what == "main") {
+        out.assign("main chunk (");
+        out.append(ar.short_src);
+        out.push_back(')');
+        return;
+    }
+    out.assign(ar.name ? ar.name : "?");
+    if (what == "C") {
+        out.append(" [C]");
+        return;
+    }
+    out.append(" (");
+    out.append(ar.short_src);
+    out.push_back(':');
+    out.append(std::to_string(ar.linedefined));
+    out.push_back(')');
+}
+
+} // namespace
+
+void LuaProfiler::Attach(lua_State* L)
+{
+    Detach();
+    m_L = L;
+    if (m_running) Install();
+}
+
+void LuaProfiler::Detach()
+{
+    if (!m_L) return;
+    if (m_running) Uninstall();
+    m_L = nullptr;
+}
+
+void LuaProfiler::Start(const Options& options)
+{
+    if (m_running && m_L) Uninstall();
+    m_options    = options;
+    m_running    = true;
+    m_nextSample = 0;
+    m_open.clear();
+    if (m_L) Install();
+}
+
+void LuaProfiler::Stop()
+{
+    if (!m_running) return;
+    if (m_L) Uninstall();
+    m_running = false;
+    m_open.clear();
+}
+
+void LuaProfiler::Install()
+{
+    lua_pushlightuserdata(m_L, this);
+    lua_rawsetp(m_L, LUA_REGISTRYINDEX, &PROFILER_KEY);
+    lua_sethook(m_L, Hook, LUA_MASKCOUNT, std::max(m_options.instructions, 1));
+}
+
+void LuaProfiler::Uninstall()
+{
+    lua_sethook(m_L, nullptr, 0, 0);
+    lua_pushnil(m_L);
+    lua_rawsetp(m_L, LUA_REGISTRYINDEX, &PROFILER_KEY);
+}
+
+void LuaProfiler::Reset()
+{
+    m_samples = 0;
+    m_functions.clear();
+    m_lines.clear();
+    m_stacks.clear();
+    m_callbacks.clear();
+}
+
+void LuaProfiler::BeginCallback(const char* name)
+{
+    if (!m_running) return;
+    auto it = std::find_if(m_callbacks.begin(), m_callbacks.end(),
+                           [&](const CallbackStats& c) { return c.name == name; });
+    if (it == m_callbacks.end()) it = m_callbacks.insert(m_callbacks.end(), CallbackStats{ name });
+    m_open.push_back({ static_cast<size_t>(it - m_callbacks.begin()), Profile::Now() });
+}
+
+void LuaProfiler::EndCallback()
+{
+    if (!m_running || m_open.empty()) return;
+    const Open open = m_open.back();
+    m_open.pop_back();
+    CallbackStats& c = m_callbacks[open.callback];
+    const int64_t ns = Profile::Now() - open.start;
+    c.calls++;
+    c.totalNs += ns;
+    c.maxNs    = std::max(c.maxNs, ns);
+    c.lastNs   = ns;
+}
+
+void LuaProfiler::Hook(lua_State* L, lua_Debug*)
+{
+    lua_rawgetp(L, LUA_REGISTRYINDEX, &PROFILER_KEY);
+    auto* self = static_cast<LuaProfiler*>(lua_touserdata(L, -1));
+    lua_pop(L, 1);
+    if (!self) return;
+
+    if (self->m_options.trigger == Trigger::Time) {
+        const int64_t now = Profile::Now();
+        if (now < self->m_nextSample) return;
+        self->m_nextSample = now + static_cast<int64_t>(self->m_options.intervalMs * 1e6);
+    }
+    self->Sample(L);
+}
+
+void LuaProfiler::Sample(lua_State* L)
+{
+    lua_Debug ar;
+    int depth = 0;
+    for (; depth < MAX_DEPTH && lua_getstack(L, depth, &ar); ++depth) {
+        lua_getinfo(L, "Sln", &ar);
+        if (static_cast<size_t>(depth) == m_frames.size()) m_frames.emplace_back();
+        FrameLabel(ar, m_frames[depth]);
+
+        // The hook only runs in Lua code, so level 0 always has a line
+        if (depth == 0 && ar.currentline > 0) {
+            m_key.assign(ar.short_src);
+            m_key.push_back(':');
+            m_key.append(std::to_string(ar.currentline));
+            m_lines[m_key]++;
+        }
+    }
+    if (depth == 0) return;
+    m_samples++;
+
+    m_functions[m_frames[0]].self++;
+    for (int i = 0; i < depth; ++i) {
+        // Once per sample, however deep a function recurses
+        bool seen = false;
+        for (int j = 0; j < i && !seen; ++j) seen = m_frames[j] == m_frames[i];
+        if (!seen) m_functions[m_frames[i]].total++;
+    }
+
+    m_key.assign(m_open.empty() ? NO_CALLBACK : m_callbacks[m_open.back().callback].name);
+    for (int i = depth; i-- > 0;) {
+        m_key.push_back(';');
+        m_key.append(m_frames[i]);
+    }
+    m_stacks[m_key]++;
+}
+
+std::vector<LuaProfiler::FunctionStats> LuaProfiler::Functions() const
+{
+    std::vector<FunctionStats> out;
+    out.reserve(m_functions.size());
+    for (const auto& [name, counts] : m_functions) out.push_back({ name, counts.self, counts.total });
+    std::sort(out.begin(), out.end(), [](const FunctionStats& a, const FunctionStats& b) {
+        return a.self != b.self ? a.self > b.self : a.total > b.total;
+    });
+    return out;
+}
+
+std::vector<LuaProfiler::LineStats> LuaProfiler::Lines() const
+{
+    std::vector<LineStats> out;
+    out.reserve(m_lines.size());
+    for (const auto& [where, samples] : m_lines) out.push_back({ where, samples });
+    std::sort(out.begin(), out.end(), [](const LineStats& a, const LineStats& b) { return a.samples > b.samples; });
+    return out;
+}
+
+bool LuaProfiler::WriteCollapsed(const std::string& path) const
+{
+    // Sorted, so dumps of the same run diff cleanly
+    std::vector<std::pair<std::string_view, uint64_t>> stacks(m_stacks.begin(), m_stacks.end());
+    std::sort(stacks.begin(), stacks.end());
+
+    std::ofstream ofs(path, std::ios::trunc);
+    if (!ofs) return false;
+    for (const auto& [stack, samples] : stacks) ofs << stack << ' ' << samples << '\n';
+    return static_cast<bool>(ofs);
+}
+
+} // namespace Hotones::Scripting
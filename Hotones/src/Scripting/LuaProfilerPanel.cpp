@@ -0,0 +1,124 @@
+// LuaProfilerPanel.cpp — ImGui view of a LuaProfiler
+
+#include "../include/Scripting/LuaProfiler.hpp"
+#include <imgui/imgui.h>
+#include <algorithm>
+
+namespace Hotones::Scripting {
+
+namespace {
+
+constexpr size_t MAX_ROWS = 200;   // per table; the dump has everything
+
+double Ms(int64_t ns) { return (double)ns / 1e6; }
+
+double Percent(uint64_t n, uint64_t of) { return of ? 100.0 * (double)n / (double)of : 0.0; }
+
+void DrawCallbacks(const std::vector<LuaProfiler::CallbackStats>& callbacks)
+{
+    if (!ImGui::BeginTable("##luacallbacks", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) return;
+    ImGui::TableSetupColumn("Callback");
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableSetupColumn("Avg ms");
+    ImGui::TableSetupColumn("Last ms");
+    ImGui::TableSetupColumn("Max ms");
+    ImGui::TableHeadersRow();
+    for (const LuaProfiler::CallbackStats& c : callbacks) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn(); ImGui::TextUnformatted(c.name);
+        ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)c.calls);
+        ImGui::TableNextColumn(); ImGui::Text("%.3f", c.calls ? Ms(c.totalNs) / (double)c.calls : 0.0);
+        ImGui::TableNextColumn(); ImGui::Text("%.3f", Ms(c.lastNs));
+        ImGui::TableNextColumn(); ImGui::Text("%.3f", Ms(c.maxNs));
+    }
+    ImGui::EndTable();
+}
+
+void DrawFunctions(const std::vector<LuaProfiler::FunctionStats>& functions, uint64_t samples)
+{
+    if (!ImGui::BeginTable("##luafunctions", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY,
+                           { 0, 200 }))
+        return;
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Function", ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableSetupColumn("Self %");
+    ImGui::TableSetupColumn("Total %");
+    ImGui::TableHeadersRow();
+    for (size_t i = 0; i < std::min(functions.size(), MAX_ROWS); ++i) {
+        const LuaProfiler::FunctionStats& f = functions[i];
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn(); ImGui::TextUnformatted(f.name.c_str());
+        ImGui::TableNextColumn(); ImGui::Text("%.1f", Percent(f.self, samples));
+        ImGui::TableNextColumn(); ImGui::Text("%.1f", Percent(f.total, samples));
+    }
+    ImGui::EndTable();
+}
+
+void DrawLines(const std::vector<LuaProfiler::LineStats>& lines, uint64_t samples)
+{
+    if (!ImGui::BeginTable("##lualines", 2, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY,
+                           { 0, 160 }))
+        return;
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Line", ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableSetupColumn("Samples %");
+    ImGui::TableHeadersRow();
+    for (size_t i = 0; i < std::min(lines.size(), MAX_ROWS); ++i) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn(); ImGui::TextUnformatted(lines[i].where.c_str());
+        ImGui::TableNextColumn(); ImGui::Text("%.1f", Percent(lines[i].samples, samples));
+    }
+    ImGui::EndTable();
+}
+
+} // namespace
+
+void LuaProfiler::DrawPanel()
+{
+    Options options = m_options;
+    bool    changed = false;
+    int trigger = options.trigger == Trigger::Time ? 0 : 1;
+    ImGui::SetNextItemWidth(120);
+    changed |= ImGui::Combo("Trigger", &trigger, "Time\0Instructions\0");
+    options.trigger = trigger == 0 ? Trigger::Time : Trigger::Count;
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(100);
+    if (options.trigger == Trigger::Time) {
+        float ms = (float)options.intervalMs;
+        changed |= ImGui::DragFloat("ms", &ms, 0.05f, 0.1f, 50.f, "%.2f");
+        options.intervalMs = ms;
+    } else {
+        changed |= ImGui::DragInt("instructions", &options.instructions, 100.f, 100, 1000000);
+    }
+    if (changed) {
+        m_options = options;
+        if (m_running) Start(options);
+    }
+
+    bool running = m_running;
+    if (ImGui::Checkbox("Sample", &running)) {
+        if (running) Start(options);
+        else         Stop();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset")) Reset();
+    ImGui::SameLine();
+    if (ImGui::Button("Write flame graph stacks")) {
+        m_status = WriteCollapsed(m_dumpPath)
+            ? "Wrote " + std::to_string(m_stacks.size()) + " stacks to " + m_dumpPath
+            : "Could not write " + m_dumpPath;
+    }
+    ImGui::SameLine();
+    ImGui::Text("%llu samples", (unsigned long long)m_samples);
+    if (!m_status.empty()) ImGui::TextUnformatted(m_status.c_str());
+
+    if (m_callbacks.empty() && m_samples == 0) {
+        ImGui::TextDisabled(m_running ? "Waiting for samples." : "Not sampling.");
+        return;
+    }
+    DrawCallbacks(m_callbacks);
+    DrawFunctions(Functions(), m_samples);
+    DrawLines(Lines(), m_samples);
+}
+
+} // namespace Hotones::Scripting
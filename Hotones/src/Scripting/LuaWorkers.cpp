@@ -0,0 +1,412 @@
+// LuaWorkers.cpp — pack worker scripts in states of their own
+//
+// Message encoding (native byte order; it never leaves the process):
+//
+//   value  = tag, then for INT an int64, NUM a double, STR a uint32 length
+//            and the bytes, TABLE any number of key value pairs and END
+
+#include "../include/Scripting/LuaWorkers.hpp"
+#include "../include/Scripting/LuaAllocator.hpp"
+#include "../include/Scripting/PackScripts.hpp"
+#include "../include/Scripting/LuaLoader/ServerLib.hpp"
+#include "../include/Scripting/LuaLoader/Task.hpp"
+#include <raylib.h>
+#include <cstring>
+
+#include <Scripting/LuaCompat.hpp>
+
+namespace Hotones::Scripting {
+
+struct LuaWorkers::Worker {
+    std::string name;
+    std::unique_ptr<LuaAllocator> alloc;   // outlives L
+    lua_State* L       = nullptr;
+    int        selfRef = LUA_NOREF;        // the table the script returned
+    std::vector<std::string> inbox;        // posted since the last step; main thread between steps
+    std::vector<std::string> outbox;       // sent during the step; the step's thread
+    std::string error;                     // last callback error of the step
+
+    ~Worker() { if (L) lua_close(L); }
+};
+
+namespace {
+
+enum Tag : unsigned char { TAG_NIL, TAG_FALSE, TAG_TRUE, TAG_INT, TAG_NUM, TAG_STR, TAG_TABLE, TAG_END };
+
+// Deeper than any sensible message; also where a cycle gives up
+constexpr int MAX_DEPTH = 64;
+
+template <typename T>
+void Put(std::string& out, T v)
+{
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &v, sizeof(T));
+    out.append(bytes, sizeof(T));
+}
+
+template <typename T>
+T Take(const char*& p)
+{
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    p += sizeof(T);
+    return v;
+}
+
+bool EncodeValue(lua_State* L, int idx, std::string& out, std::string& error, int depth)
+{
+    switch (lua_type(L, idx)) {
+    case LUA_TNIL:
+        out.push_back(static_cast<char>(TAG_NIL));
+        return true;
+    case LUA_TBOOLEAN:
+        out.push_back(static_cast<char>(lua_toboolean(L, idx) ? TAG_TRUE : TAG_FALSE));
+        return true;
+    case LUA_TNUMBER:
+#if !defined(HOTONES_LUAJIT)
+        if (lua_isinteger(L, idx)) {
+            out.push_back(static_cast<char>(TAG_INT));
+            Put<int64_t>(out, static_cast<int64_t>(lua_tointeger(L, idx)));
+            return true;
+        }
+#endif
+        out.push_back(static_cast<char>(TAG_NUM));
+        Put<double>(out, static_cast<double>(lua_tonumber(L, idx)));
+        return true;
+    case LUA_TSTRING: {
+        size_t len = 0;
+        const char* s = lua_tolstring(L, idx, &len);
+        out.push_back(static_cast<char>(TAG_STR));
+        Put<uint32_t>(out, static_cast<uint32_t>(len));
+        out.append(s, len);
+        return true;
+    }
+    case LUA_TTABLE: {
+        if (depth >= MAX_DEPTH) {
+            error = "table nested too deeply (or it contains itself)";
+            return false;
+        }
+        if (!lua_checkstack(L, 3)) {
+            error = "out of stack space";
+            return false;
+        }
+        idx = lua_absindex(L, idx);
+        out.push_back(static_cast<char>(TAG_TABLE));
+        lua_pushnil(L);
+        while (lua_next(L, idx) != 0) {
+            // Keys are copied as they are; no tostring() on them, which
+            // would confuse lua_next
+            if (!EncodeValue(L, -2, out, error, depth + 1) || !EncodeValue(L, -1, out, error, depth + 1))
+                return false;   // Encode() restores the stack
+            lua_pop(L, 1);
+        }
+        out.push_back(static_cast<char>(TAG_END));
+        return true;
+    }
+    default:
+        error = std::string("can't send a ") + luaL_typename(L, idx) + " value";
+        return false;
+    }
+}
+
+void DecodeValue(lua_State* L, const char*& p)
+{
+    switch (static_cast<unsigned char>(*p++)) {
+    case TAG_FALSE: lua_pushboolean(L, 0); break;
+    case TAG_TRUE:  lua_pushboolean(L, 1); break;
+    case TAG_INT:   lua_pushinteger(L, static_cast<lua_Integer>(Take<int64_t>(p))); break;
+    case TAG_NUM:   lua_pushnumber(L, static_cast<lua_Number>(Take<double>(p))); break;
+    case TAG_STR: {
+        const uint32_t len = Take<uint32_t>(p);
+        lua_pushlstring(L, p, len);
+        p += len;
+        break;
+    }
+    case TAG_TABLE:
+        lua_newtable(L);
+        while (static_cast<unsigned char>(*p) != TAG_END) {
+            DecodeValue(L, p);
+            DecodeValue(L, p);
+            lua_rawset(L, -3);
+        }
+        ++p;
+        break;
+    default:        lua_pushnil(L); break;
+    }
+}
+
+int l_traceback(lua_State* L)
+{
+    const char* msg = lua_tostring(L, 1);
+    luaL_traceback(L, L, msg ? msg : "(error object is not a string)", 1);
+    return 1;
+}
+
+int l_panic(lua_State* L)
+{
+    const char* msg = lua_tostring(L, -1);
+    TraceLog(LOG_ERROR, "[LuaWorkers] unprotected Lua error: %s", msg ? msg : "(not a string)");
+    return 0;   // Lua aborts
+}
+
+// ─── Worker side ─────────────────────────────────────────────────────────────
+
+// worker.send(value)   Upvalue 1 = Worker*
+int l_workerSend(lua_State* L)
+{
+    luaL_checkany(L, 1);
+    {
+        auto* w = static_cast<LuaWorkers::Worker*>(lua_touserdata(L, lua_upvalueindex(1)));
+        std::string data, error;
+        if (LuaWorkers::Encode(L, 1, data, error)) {
+            w->outbox.push_back(std::move(data));
+            return 0;
+        }
+        lua_pushfstring(L, "worker.send: %s", error.c_str());
+    }
+    return lua_error(L);   // raised once the strings are gone
+}
+
+// Call self:<method>(...) with the values pushed by `pushArgs`, if the
+// worker defines it; errors go to w.error
+template <typename PushArgs>
+void CallMethod(LuaWorkers::Worker& w, int handler, const char* method, PushArgs&& pushArgs)
+{
+    lua_State* L = w.L;
+    lua_rawgeti(L, LUA_REGISTRYINDEX, w.selfRef);
+    lua_getfield(L, -1, method);
+    if (!lua_isfunction(L, -1)) {
+        lua_settop(L, handler);
+        return;
+    }
+    lua_insert(L, -2);
+    const int nargs = pushArgs(L);
+    if (lua_pcall(L, nargs + 1, 0, handler) != LUA_OK) {
+        const char* msg = lua_tostring(L, -1);
+        w.error = std::string("worker '") + w.name + "' " + method + "(): " + (msg ? msg : "<unknown>");
+        TraceLog(LOG_ERROR, "[LuaWorkers] %s", w.error.c_str());
+    }
+    lua_settop(L, handler);
+}
+
+// ─── Main side ───────────────────────────────────────────────────────────────
+
+LuaWorkers& WorkersOf(lua_State* L)
+{
+    return *static_cast<LuaWorkers*>(lua_touserdata(L, lua_upvalueindex(1)));
+}
+
+// workers.send(name, value) -> boolean
+int l_send(lua_State* L)
+{
+    const char* name = luaL_checkstring(L, 1);
+    luaL_checkany(L, 2);
+    {
+        std::string data, error;
+        if (LuaWorkers::Encode(L, 2, data, error)) {
+            lua_pushboolean(L, WorkersOf(L).Post(name, std::move(data)));
+            return 1;
+        }
+        lua_pushfstring(L, "workers.send: %s", error.c_str());
+    }
+    return lua_error(L);   // raised once the strings are gone
+}
+
+// workers.list() -> { name, ... }
+int l_list(lua_State* L)
+{
+    const std::vector<std::string> names = WorkersOf(L).Names();
+    lua_createtable(L, static_cast<int>(names.size()), 0);
+    for (size_t i = 0; i < names.size(); ++i) {
+        lua_pushstring(L, names[i].c_str());
+        lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
+    }
+    return 1;
+}
+
+} // namespace
+
+LuaWorkers::LuaWorkers() = default;
+
+LuaWorkers::~LuaWorkers()
+{
+    Stop();
+}
+
+int LuaWorkers::Start(const std::string& packRoot, const std::vector<Spec>& specs, std::string& error)
+{
+    Stop();
+    for (const Spec& spec : specs) {
+        auto w   = std::make_unique<Worker>();
+        w->name  = spec.name;
+        w->alloc = std::make_unique<LuaAllocator>();
+        w->L     = lua_newstate(LuaAllocator::Alloc, w->alloc.get());
+#if defined(HOTONES_LUAJIT)
+        if (!w->L) w->L = luaL_newstate();   // see CupLoader's newState()
+#endif
+        if (!w->L) {
+            error = "worker '" + spec.name + "': could not create a Lua state";
+            TraceLog(LOG_ERROR, "[LuaWorkers] %s", error.c_str());
+            continue;
+        }
+        lua_State* L = w->L;
+        lua_atpanic(L, l_panic);
+        luaL_openlibs(L);
+#if defined(LUA_GCGEN)
+        lua_gc(L, LUA_GCGEN, 0, 0);
+#endif
+        LuaLoader::registerServer(L);
+        LuaLoader::registerTask(L);
+        RegisterPackSearcher(L, packRoot);
+
+        lua_newtable(L);
+        lua_pushstring(L, spec.name.c_str());
+        lua_setfield(L, -2, "name");
+        lua_pushlightuserdata(L, w.get());
+        lua_pushcclosure(L, l_workerSend, 1);
+        lua_setfield(L, -2, "send");
+        lua_setglobal(L, "worker");
+
+        lua_pushcfunction(L, l_traceback);
+        int status = LoadPackChunk(L, spec.path);
+        if (status == LUA_OK) status = lua_pcall(L, 0, 1, 1);
+        if (status == LUA_OK && !lua_istable(L, -1)) {
+            lua_pushfstring(L, "%s must return a table", spec.path.c_str());
+            status = LUA_ERRRUN;
+        }
+        if (status != LUA_OK) {
+            const char* msg = lua_tostring(L, -1);
+            error = "worker '" + spec.name + "': " + (msg ? msg : "<unknown>");
+            TraceLog(LOG_ERROR, "[LuaWorkers] %s", error.c_str());
+            continue;
+        }
+        w->selfRef = luaL_ref(L, LUA_REGISTRYINDEX);
+        lua_settop(L, 0);
+        // Anything the script sent while loading arrives with the next update
+        TraceLog(LOG_INFO, "[LuaWorkers] Started worker '%s' (%s)", spec.name.c_str(), spec.path.c_str());
+        m_workers.push_back(std::move(w));
+    }
+    return static_cast<int>(m_workers.size());
+}
+
+void LuaWorkers::Stop()
+{
+    Jobs::JobSystem::Get().Wait(m_step);
+    m_workers.clear();
+    m_lastStep = 0;
+}
+
+bool LuaWorkers::Collect(std::vector<Message>& out, std::string& error)
+{
+    if (m_workers.empty()) return true;
+    {
+        HOTONES_ZONE("Lua workers wait");
+        Jobs::JobSystem::Get().Wait(m_step);
+    }
+    bool ok = true;
+    for (auto& w : m_workers) {
+        for (std::string& data : w->outbox) out.push_back({ w->name, std::move(data) });
+        w->outbox.clear();
+        if (!w->error.empty()) {
+            error = std::move(w->error);
+            w->error.clear();
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+bool LuaWorkers::Post(const std::string& name, std::string data)
+{
+    for (auto& w : m_workers) {
+        if (w->name != name) continue;
+        w->inbox.push_back(std::move(data));
+        return true;
+    }
+    return false;
+}
+
+void LuaWorkers::Dispatch()
+{
+    if (m_workers.empty()) return;
+    Jobs::JobSystem& jobs = Jobs::JobSystem::Get();
+    jobs.Wait(m_step);   // Collect() normally has; a worker never steps twice at once
+
+    const int64_t now = Profile::Now();
+    const double  dt  = m_lastStep ? (double)(now - m_lastStep) / 1e9 : 0.0;
+    m_lastStep = now;
+    for (auto& w : m_workers) {
+        Worker* worker = w.get();
+        jobs.Submit([worker, dt] { Step(*worker, dt); }, &m_step);
+    }
+}
+
+void LuaWorkers::Step(Worker& w, double dt)
+{
+    HOTONES_ZONE("Lua worker step");
+    lua_State* L = w.L;
+    lua_settop(L, 0);
+    lua_pushcfunction(L, l_traceback);
+    const int handler = lua_gettop(L);
+
+    std::string error;
+    if (!LuaLoader::updateTasks(L, error)) w.error = "worker '" + w.name + "' task: " + error;
+    for (const std::string& data : w.inbox) {
+        CallMethod(w, handler, "onMessage", [&data](lua_State* S) {
+            LuaWorkers::Decode(S, data);
+            return 1;
+        });
+    }
+    w.inbox.clear();
+    CallMethod(w, handler, "update", [dt](lua_State* S) {
+        lua_pushnumber(S, static_cast<lua_Number>(dt));
+        return 1;
+    });
+    lua_settop(L, 0);
+}
+
+bool LuaWorkers::Encode(lua_State* L, int idx, std::string& out, std::string& error)
+{
+    const int top = lua_gettop(L);
+    out.clear();
+    const bool ok = EncodeValue(L, lua_absindex(L, idx), out, error, 0);
+    lua_settop(L, top);
+    return ok;
+}
+
+void LuaWorkers::Decode(lua_State* L, const std::string& data)
+{
+    if (data.empty()) {
+        lua_pushnil(L);
+        return;
+    }
+    // Room for the deepest message Encode() writes, so decoding never
+    // raises; a message is decoded outside any pcall
+    if (!lua_checkstack(L, 2 * MAX_DEPTH + 4)) {
+        lua_pushnil(L);
+        return;
+    }
+    const char* p = data.data();
+    DecodeValue(L, p);
+}
+
+std::vector<std::string> LuaWorkers::Names() const
+{
+    std::vector<std::string> names;
+    for (const auto& w : m_workers) names.push_back(w->name);
+    return names;
+}
+
+void LuaWorkers::Register(lua_State* L, LuaWorkers& workers)
+{
+    lua_newtable(L);
+    lua_pushlightuserdata(L, &workers);
+    lua_pushcclosure(L, l_send, 1);
+    lua_setfield(L, -2, "send");
+    lua_pushlightuserdata(L, &workers);
+    lua_pushcclosure(L, l_list, 1);
+    lua_setfield(L, -2, "list");
+    lua_setglobal(L, "workers");
+}
+
+} // namespace Hotones::Scripting
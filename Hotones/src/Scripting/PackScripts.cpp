@@ -0,0 +1,77 @@
+// PackScripts.cpp — loading pack scripts and modules into a Lua state
+
+#include "../include/Scripting/PackScripts.hpp"
+#include "../include/Scripting/LuaBytecode.hpp"
+#include <Assets/Vfs.hpp>
+#include <algorithm>
+
+#include <Scripting/LuaCompat.hpp>
+
+namespace Hotones::Scripting {
+
+namespace {
+
+// package.searchers entry: require("a.b") loads <pack>/a/b.lua or
+// <pack>/a/b/init.lua.  Upvalue 1 = pack root.
+int l_packSearcher(lua_State* L)
+{
+    bool failed = false;
+    {
+        std::string name = luaL_checkstring(L, 1);
+        std::replace(name.begin(), name.end(), '.', '/');
+        const std::string root = lua_tostring(L, lua_upvalueindex(1));
+        std::string tried;
+        for (const char* suffix : { ".lua", "/init.lua" }) {
+            const std::string path = root + "/" + name + suffix;
+            if (!Assets::FileExists(path)) {
+                tried += "\n\tno file '" + path + "'";
+                continue;
+            }
+            if (LoadPackChunk(L, path) != LUA_OK) {
+                lua_pushfstring(L, "error loading module '%s' from file '%s':\n\t%s",
+                                lua_tostring(L, 1), path.c_str(), lua_tostring(L, -1));
+                failed = true;   // raised below, once the strings are gone
+                break;
+            }
+            lua_pushstring(L, path.c_str());
+            return 2;
+        }
+        if (!failed) {
+            lua_pushstring(L, tried.c_str());
+            return 1;
+        }
+    }
+    return lua_error(L);
+}
+
+} // namespace
+
+int LoadPackChunk(lua_State* L, const std::string& path)
+{
+    const Assets::FileView f = Assets::ReadFile(path);
+    if (!f) {
+        lua_pushfstring(L, "cannot open %s", path.c_str());
+        return LUA_ERRFILE;
+    }
+    if (LoadBytecode(L, path, f.data, f.size)) return LUA_OK;
+    const std::string chunkName = "@" + path;
+    return luaL_loadbufferx(L, reinterpret_cast<const char*>(f.data), f.size, chunkName.c_str(), nullptr);
+}
+
+// Put l_packSearcher right after package.preload's searcher, so the pack's
+// modules win over anything on package.path
+void RegisterPackSearcher(lua_State* L, const std::string& root)
+{
+    lua_getglobal(L, "package");
+    lua_getfield(L, -1, HOTONES_LUA_SEARCHERS);
+    lua_pushstring(L, root.c_str());
+    lua_pushcclosure(L, l_packSearcher, 1);
+    for (lua_Integer i = (lua_Integer)lua_rawlen(L, -2); i >= 2; --i) {
+        lua_rawgeti(L, -2, i);
+        lua_rawseti(L, -3, i + 1);
+    }
+    lua_rawseti(L, -2, 2);
+    lua_pop(L, 2);
+}
+
+} // namespace Hotones::Scripting
@@ -0,0 +1,159 @@
+// ScriptSystem.cpp — per-entity Lua update() dispatch
+
+#include "../include/Scripting/ScriptSystem.hpp"
+#include "../include/Scripting/CupLoader.hpp"
+#include "../include/Scripting/LuaLoader/ECS.hpp"
+#include <ECS/Components.hpp>
+#include <Profile/Profiler.hpp>
+#include <algorithm>
+
+#include <Scripting/LuaCompat.hpp>
+
+namespace Hotones::Scripting {
+
+namespace {
+
+int l_traceback(lua_State* L)
+{
+    const char* msg = lua_tostring(L, 1);
+    luaL_traceback(L, L, msg ? msg : "(error object is not a string)", 1);
+    return 1;
+}
+
+} // namespace
+
+int ScriptSystem::methodFor(lua_State* L, const std::string& className)
+{
+    auto it = m_methods.find(className);
+    if (it != m_methods.end()) return it->second;
+
+    // "Enemies.Grunt": the global Enemies, then its field Grunt
+    const int top = lua_gettop(L);
+    size_t dot = className.find('.');
+    lua_getglobal(L, className.substr(0, dot).c_str());
+    while (dot != std::string::npos && lua_istable(L, -1)) {
+        const size_t next = className.find('.', dot + 1);
+        lua_getfield(L, -1, className.substr(dot + 1, next - dot - 1).c_str());
+        lua_remove(L, -2);
+        dot = next;
+    }
+    int ref = LUA_REFNIL;
+    if (dot == std::string::npos && lua_istable(L, -1)) {
+        lua_getfield(L, -1, "update");
+        if (lua_isfunction(L, -1)) ref = luaL_ref(L, LUA_REGISTRYINDEX);
+    }
+    lua_settop(L, top);
+    if (ref == LUA_REFNIL)
+        TraceLog(LOG_WARNING, "[ScriptSystem] '%s' is not a class with an update method", className.c_str());
+    m_methods.emplace(className, ref);
+    return ref;
+}
+
+void ScriptSystem::dropMethods(lua_State* L)
+{
+    for (const auto& [name, ref] : m_methods) luaL_unref(L, LUA_REGISTRYINDEX, ref);
+    m_methods.clear();
+}
+
+void ScriptSystem::Update(ECS::Registry& reg, float dt)
+{
+    lua_State* L = m_script.state();
+    if (!L) return;
+    HOTONES_ZONE("Lua entity scripts");
+
+    const uint32_t stamp = LuaLoader::ecsStateStamp(L);
+    if (stamp != m_stateStamp) {
+        // A new state: whatever was held belonged to the closed one
+        m_stateStamp  = stamp;
+        m_codeVersion = m_script.codeVersion();
+        m_methods.clear();
+        m_held.clear();
+    } else if (m_codeVersion != m_script.codeVersion()) {
+        m_codeVersion = m_script.codeVersion();
+        dropMethods(L);
+    }
+
+    ++m_tick;
+    m_stats = {};
+    m_seen.clear();
+    m_calls.clear();
+    const bool  throttling = m_throttle.nearDistance > 0.0f && m_throttle.farInterval > 1;
+    const float nearSq     = m_throttle.nearDistance * m_throttle.nearDistance;
+
+    reg.Each<ECS::ScriptComponent>([&](ECS::EntityId id, ECS::ScriptComponent& sc) {
+        if (sc.luaRef < 0) return;
+        if (sc.luaState != stamp) {   // bound in a state since closed
+            sc.luaRef = -1;
+            return;
+        }
+        m_seen.push_back(sc.luaRef);
+        m_stats.scripts++;
+        if (!sc.active) return;
+
+        const float stepDt = dt + sc.skippedDt;
+        if (throttling && reg.HasComponent<ECS::TransformComponent>(id)) {
+            auto&&        t = reg.GetComponent<ECS::TransformComponent>(id);
+            const Vector3 p = t.position;
+            const float   dx = p.x - m_focus.x, dy = p.y - m_focus.y, dz = p.z - m_focus.z;
+            // Staggered by entity, so far scripts spread over the interval
+            if (dx * dx + dy * dy + dz * dz > nearSq &&
+                (ECS::EntityIndex(id) + m_tick) % m_throttle.farInterval != 0) {
+                sc.skippedDt = stepDt;
+                m_stats.throttled++;
+                return;
+            }
+        }
+        sc.skippedDt = 0.0f;
+        const int fn = methodFor(L, sc.className);
+        if (fn != LUA_REFNIL) m_calls.push_back({ id, sc.luaRef, fn, stepDt });
+    });
+
+    // Release the objects no component refers to any more
+    std::sort(m_seen.begin(), m_seen.end());
+    for (int ref : m_held)
+        if (!std::binary_search(m_seen.begin(), m_seen.end(), ref)) luaL_unref(L, LUA_REGISTRYINDEX, ref);
+    m_held.swap(m_seen);
+
+    if (m_calls.empty()) return;
+    LuaProfiler& profiler = m_script.profiler();
+    profiler.BeginCallback("entity update");
+    lua_pushcfunction(L, l_traceback);
+    const int handler = lua_gettop(L);
+    for (const Call& call : m_calls) {
+        // An earlier update() may have destroyed, rebound or paused it
+        if (!reg.IsAlive(call.id) || !reg.HasComponent<ECS::ScriptComponent>(call.id)) continue;
+        const auto& sc = reg.GetComponent<ECS::ScriptComponent>(call.id);
+        if (!sc.active || sc.luaRef != call.self) continue;
+
+        lua_rawgeti(L, LUA_REGISTRYINDEX, call.fn);
+        lua_rawgeti(L, LUA_REGISTRYINDEX, call.self);
+        lua_pushnumber(L, static_cast<lua_Number>(call.dt));
+        m_stats.called++;
+        if (lua_pcall(L, 2, 0, handler) != LUA_OK) {
+            const char* msg = lua_tostring(L, -1);
+            const std::string error = msg ? msg : "<unknown>";
+            lua_pop(L, 1);
+            TraceLog(LOG_ERROR, "[ScriptSystem] update() of entity %llu failed, switching it off: %s",
+                     (unsigned long long)call.id, error.c_str());
+            m_script.SetLastError(error);
+            if (reg.IsAlive(call.id) && reg.HasComponent<ECS::ScriptComponent>(call.id))
+                reg.GetComponent<ECS::ScriptComponent>(call.id).active = false;
+        }
+    }
+    lua_settop(L, handler - 1);
+    profiler.EndCallback();
+}
+
+void ScriptSystem::Shutdown(ECS::Registry& /*reg*/)
+{
+    lua_State* L = m_script.state();
+    if (L && LuaLoader::ecsStateStamp(L) == m_stateStamp) {
+        for (int ref : m_held) luaL_unref(L, LUA_REGISTRYINDEX, ref);
+        dropMethods(L);
+    }
+    m_held.clear();
+    m_methods.clear();
+    m_stateStamp = 0;
+}
+
+} // namespace Hotones::Scripting
@@ -0,0 +1,139 @@
+#pragma once
+#include <raylib.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// ─── AssetCache ───────────────────────────────────────────────────────────────
+//
+// Singleton that loads models, textures and waves once and hands out shared,
+// refcounted handles to them, so every user of "crate.obj" draws the same
+// GPU buffers instead of loading its own copy.  Repeat loads are a lookup.
+//
+// Entries are keyed by content: a hash of the file's bytes (for models also
+// of its directory, since .mtl/.bin/texture side files resolve against it).
+// Two paths to identical files share one entry.  The path → key mapping is
+// remembered along with the file's size and modification time (CRC inside a
+// mounted .cup), so a known unchanged file isn't read again, and an edited
+// one is.
+//
+// An entry nobody holds a handle to stays loaded, for the next load of it,
+// until more than MAX_UNUSED_ASSETS such entries wait; then the least
+// recently used are unloaded.  Trim() unloads them now.
+//
+// Models and textures go to the GPU: load them on the main thread after
+// InitWindow(), and Clear() before CloseWindow().  Waves and the lookups
+// (FindTexture) are fine from any thread.  Called from another thread while
+// Jobs::MainThread serves (the pipelined simulation thread), the GPU part
+// is handed to the main thread and the call waits for it.  Handles are
+// shared: changing a model's materials (CollidableModel::SetShader)
+// changes every holder's.
+//
+// Typical use:
+//   Assets::ModelHandle crate = Assets::AssetCache::Get().LoadModel("models/crate.obj");
+//   if (crate) DrawModel(*crate, pos, 1.f, WHITE);
+//   crate.reset();   // unloaded later, if not loaded again first
+
+namespace Hotones::Assets {
+
+using ModelHandle   = std::shared_ptr<Model>;
+using TextureHandle = std::shared_ptr<Texture2D>;
+using WaveHandle    = std::shared_ptr<Wave>;
+
+constexpr int MAX_UNUSED_ASSETS = 32;   // unreferenced entries kept for reuse
+
+class AssetCache {
+public:
+    struct Stats {
+        int    loads     = 0;   // files loaded
+        int    hits      = 0;   // loads served from the cache
+        int    evictions = 0;   // unreferenced entries unloaded
+        int    live      = 0;   // entries someone holds a handle to
+        int    unused    = 0;   // entries waiting for reuse
+        size_t bytes     = 0;   // CPU/GPU bytes of all entries, roughly
+    };
+
+    // ── Singleton ─────────────────────────────────────────────────────────────
+    static AssetCache& Get();
+
+    AssetCache(const AssetCache&)            = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    // Null when the file is missing or doesn't load.  Main thread.
+    // Textures come from their cooked copy (see TextureCook.hpp).
+    ModelHandle   LoadModel(const std::string& path);
+    TextureHandle LoadTexture(const std::string& path);
+
+    // Null when the file is missing or doesn't load.  Any thread.
+    WaveHandle LoadWave(const std::string& path);
+
+    // The texture for `path` if it is loaded already, else null; loads
+    // nothing.  Any thread: lets a loader thread skip decoding.
+    TextureHandle FindTexture(const std::string& path);
+
+    // Upload `image`, decoded or cooked from `path`, and cache it as
+    // `path`'s texture.  Takes the image (it is unloaded).  If the texture
+    // got loaded meanwhile that one is returned.  A compressed image the GPU
+    // can't take is replaced by `path` itself, uncompressed.  Main thread.
+    TextureHandle AddTexture(const std::string& path, Image image);
+
+    // Re-import what was loaded from `path`, after the file changed (hot
+    // reload).  An uncompressed texture keeping its size is updated in
+    // place (its mips regenerated), so every holder, and every copy of it
+    // (a scene's materials), shows the new pixels.  Other entries are dropped from the cache: holders keep
+    // the old asset and the next load imports the new one.  Returns how many
+    // entries were affected.  Main thread.
+    int Reload(const std::string& path);
+
+    // Unload every unreferenced entry beyond the `keepUnused` most recently used
+    void Trim(int keepUnused = 0);
+
+    // Unload every unreferenced entry.  Handles still held stay valid.
+    void Clear() { Trim(0); }
+
+    Stats GetStats() const;
+
+private:
+    enum class Kind : uint8_t { Model, Texture, Wave };
+
+    struct Entry {
+        Kind                  kind;
+        std::shared_ptr<void> asset;   // the cache's reference
+        size_t                bytes   = 0;
+        uint64_t              lastUse = 0;
+        std::string           path;    // the first path it was loaded from
+    };
+    struct PathInfo {
+        uint64_t size = 0, stamp = 0;   // the file as it was when hashed
+        uint64_t key  = 0;
+    };
+
+    AssetCache() = default;
+
+    // Content key of `path` as `kind`: from m_paths while the file is
+    // unchanged, else by reading it.  0 if it can't be read.
+    uint64_t Identify(const std::string& path, Kind kind);
+
+    // The entry's asset, marked used; null on a miss.  m_mutex held.
+    std::shared_ptr<void> Touch(uint64_t key);
+
+    // Add `asset` under `key` (or return the entry that beat it there) and
+    // trim the unused entries.  m_mutex held.
+    std::shared_ptr<void> Insert(uint64_t key, Kind kind, std::shared_ptr<void> asset, size_t bytes,
+                                 const std::string& path);
+
+    // Unload unreferenced entries beyond `keepUnused`; waves only unless
+    // `gpu` (we're on the main thread).  m_mutex held.
+    void TrimLocked(int keepUnused, bool gpu);
+
+    mutable std::mutex                         m_mutex;
+    std::unordered_map<uint64_t, Entry>        m_entries;   // by content key
+    std::unordered_map<std::string, PathInfo>  m_paths;     // by normalised path
+    uint64_t                                   m_clock = 0;
+    Stats                                      m_stats;
+};
+
+} // namespace Hotones::Assets
@@ -5,13 +5,19 @@ namespace Ho_tones {
 namespace Assets {
 
 // Try to find an asset by `relativePath`. Returns true and places
-// the resolved absolute path in `outPath` when found.
+// the resolved absolute path in `outPath` when found.  Answers (misses
+// too) are remembered, so only the first lookup of a path touches the
+// disk; call InvalidateAssetPaths() when files may have come or gone.
 bool FindAsset(const std::string& relativePath, std::string& outPath);
 
+// Forget what FindAsset() resolved.  Pack mounts, unmounts and reloads do
+// this.
+void InvalidateAssetPaths();
+
 // Resolve path relative to the running executable directory.
 std::string ResolveRelativeToExe(const std::string& relativePath);
 
-// Return the directory containing the running executable.
+// Return the directory containing the running executable (looked up once).
 std::string GetExecutableDir();
 
 } // namespace Assets
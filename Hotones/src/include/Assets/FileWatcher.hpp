@@ -0,0 +1,51 @@
+#pragma once
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ─── FileWatcher ──────────────────────────────────────────────────────────────
+//
+// Reports the files written under a directory tree, so a hot-reload can
+// re-import just those instead of everything.  Uses inotify on Linux and
+// ReadDirectoryChangesW on Windows; Watch() fails elsewhere.
+//
+// Nothing runs in the background: Poll() drains what the OS queued since the
+// last call without blocking, so call it once a frame.  A file is reported
+// once it has gone SETTLE_TIME without further writes, so an editor saving
+// in several writes (or through a temp file and a rename) yields one report
+// of the finished file.  Deletions aren't reported.
+//
+// Typical use (CupLoader does this for directory packs):
+//   Assets::FileWatcher watcher;
+//   watcher.Watch("/games/demo");
+//   for (const std::string& path : watcher.Poll()) Reimport(path);
+
+namespace Hotones::Assets {
+
+class FileWatcher {
+public:
+    static constexpr std::chrono::milliseconds SETTLE_TIME{ 150 };
+
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&)            = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // Watch `root` and everything below it, replacing any previous watch.
+    // False if it isn't a directory or the platform can't watch.
+    bool Watch(const std::string& root);
+    void Stop();
+    bool IsWatching() const;
+
+    // Files created, modified or renamed into place and since settled, each
+    // once, as normalised absolute paths (see NormalisePath)
+    std::vector<std::string> Poll();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace Hotones::Assets
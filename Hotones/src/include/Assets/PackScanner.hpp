@@ -1,20 +1,74 @@
 #pragma once
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace Hotones::Assets {
 
+/// Where scans remember what they learned about each pack
+inline constexpr const char* PACK_INDEX_PATH = "cache/packs.idx";
+
 struct PackEntry {
     enum class Type { Directory, ZipFile };
     std::string displayName; ///< filename/dirname shown in UI
     std::string fullPath;    ///< path passed to CupPackage::open()
     Type        type = Type::Directory;
+
+    // From the pack's Init table (Init.Name / Init.Version); empty if it
+    // declares none or hasn't been probed yet
+    std::string name;
+    std::string version;
+    bool        probed = false;
+
+    // What the index revalidates against: the .cup's (or a directory's
+    // init.lua's) size and modification time
+    uint64_t    size  = 0;
+    int64_t     mtime = 0;
 };
 
 /// Scan basePath for:
 ///   - Sub-directories that contain an "init.lua"  (unzipped packs)
 ///   - Regular files with extension ".cup" or ".zip"  (zipped packs)
-/// Returns entries sorted ascending by displayName.
-std::vector<PackEntry> ScanPacksDir(const std::string& basePath);
+/// Returns entries sorted ascending by displayName.  Costs a stat per pack:
+/// name/version come from the index at `indexPath` where it is current, and
+/// are left unprobed otherwise (PackScan probes them).
+std::vector<PackEntry> ScanPacksDir(const std::string& basePath,
+                                    const std::string& indexPath = PACK_INDEX_PATH);
+
+// ─── PackScan ─────────────────────────────────────────────────────────────────
+//
+// ScanPacksDir() in the background, probing the packs the index doesn't know
+// (new, or changed since) for their name and version.  Probes read init.lua
+// out of the pack, without running it, on a private worker pool; the index is
+// rewritten once they are all done.  Poll() from the UI each frame: entries
+// appear as soon as the directory is listed and fill in as probes finish, so
+// nothing waits on hundreds of packs being opened.
+//
+// Dropping the PackScan abandons outstanding probes.
+//
+//   auto scan = std::make_unique<Assets::PackScan>("./paks");
+//   ...every frame:  if (scan->Poll(packs)) RebuildList(packs);
+
+class PackScan {
+public:
+    explicit PackScan(const std::string& basePath, const std::string& indexPath = PACK_INDEX_PATH);
+    ~PackScan();
+
+    PackScan(const PackScan&)            = delete;
+    PackScan& operator=(const PackScan&) = delete;
+
+    /// Copy the entries into `out` if they changed since the last call
+    bool Poll(std::vector<PackEntry>& out);
+
+    /// Whether the listing and every probe have finished
+    bool Done() const;
+
+    struct State;
+
+private:
+    std::shared_ptr<State> m_state;
+    uint64_t               m_seen = 0;   // State::revision last handed out
+};
 
 } // namespace Hotones::Assets
@@ -0,0 +1,59 @@
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+#include <string>
+
+// ─── TextureCook ──────────────────────────────────────────────────────────────
+//
+// GPU-ready copies of texture files.  The first load of a PNG (or anything
+// LoadImage reads) decodes it, builds its mip chain and compresses it, then
+// writes the result to a .dds under the cook directory; later loads read
+// that back and hand it to the GPU as it is, with no decode and no mip
+// generation at runtime.
+//
+// Square power-of-two textures become BC1 (DXT1) when fully opaque and BC3
+// (DXT5) otherwise: a quarter / half the VRAM of RGBA8.  Any other size
+// keeps RGBA8 with its mip chain (raylib only sizes DXT mip levels right
+// for square power-of-two ones).  Mips are 2x2 box-filtered down to 1x1.
+//
+// Cooked files are keyed like cooked scenes: by the source's path, size and
+// modification time (CRC inside a mounted .cup) and the cook version, so an
+// edited texture is cooked again.  Everything here is CPU-side and safe from
+// any thread; AssetCache::AddTexture uploads the result, and falls back to
+// the source file when the GPU can't take DXT.
+//
+// Typical use (SceneImporter and AssetCache::LoadTexture do this):
+//   Image image = Assets::LoadTextureImage("textures/crate.png");
+//   Assets::TextureHandle tex = Assets::AssetCache::Get().AddTexture("textures/crate.png", image);
+
+namespace Hotones::Assets {
+
+/// Where cooked textures go unless told otherwise
+inline constexpr const char* TEXTURE_COOK_DIR = "cache/textures";
+
+/// Identifies `sourcePath` as it is now; 0 if it can't be stat'ed
+uint64_t TextureCookKey(const std::string& sourcePath);
+
+/// <dir>/<key as 16 hex digits>.dds
+std::string TextureCookPath(const std::string& dir, uint64_t key);
+
+/// `image` (any uncompressed format) with its mip chain, compressed where
+/// its size allows.  The result's data is MemAlloc'd: UnloadImage() it.
+Image CookImage(const Image& image);
+
+/// False on a miss, or if the file is truncated, another cook version or
+/// cooked for another key; `out` is untouched then
+bool LoadCookedTexture(const std::string& path, uint64_t key, Image& out);
+
+/// Write a CookImage() result under `key`, to a temporary file renamed into place
+bool StoreCookedTexture(const std::string& path, uint64_t key, const Image& image);
+
+/// The image to upload for `sourcePath`: its cooked copy from `cookDir` if
+/// current, else decoded, cooked and stored there.  `cookDir` empty: just
+/// LoadImage().  Data null if the file doesn't load.
+Image LoadTextureImage(const std::string& sourcePath, const std::string& cookDir = TEXTURE_COOK_DIR);
+
+/// Cook `sourcePath` into `cookDir` now, unless it is current (packaging)
+bool CookTexture(const std::string& sourcePath, const std::string& cookDir = TEXTURE_COOK_DIR);
+
+} // namespace Hotones::Assets
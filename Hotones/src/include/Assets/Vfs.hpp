@@ -0,0 +1,125 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ─── Vfs ──────────────────────────────────────────────────────────────────────
+//
+// Read-only virtual file system over zip archives (.cup packs).  Mount()
+// memory-maps an archive and indexes its central directory; the archive's
+// files then appear under `root` as if it were a directory, and are read
+// in place instead of being extracted first.
+//
+// Stored (uncompressed) entries are handed out as views straight into the
+// mapping.  Deflated entries are inflated on first read and kept in a small
+// LRU cache (CACHE_BUDGET bytes), so a texture read twice in one load is
+// inflated once.
+//
+// Paths are matched after making them absolute and lexically normal with
+// forward slashes, so "packs/a.cup/scripts/../init.lua" finds init.lua in
+// an archive mounted at "packs/a.cup".  Everything is thread-safe: scene
+// decoding reads from loader threads.
+//
+// Mount() also routes raylib's LoadFileData()/LoadFileText() through
+// ReadFile(), so LoadImage(), LoadTexture(), LoadWave(), LoadSound() and
+// LoadModel() read mounted paths too.  Anything that opens files itself
+// (fopen, std::ifstream, LoadMusicStream) still sees only the disk.
+//
+// Typical use (CupPackage does this):
+//   Assets::Vfs::Get().Mount("/games/demo.cup", "/games/demo.cup");
+//   Assets::FileView f = Assets::ReadFile("/games/demo.cup/init.lua");
+//   if (f) luaL_loadbufferx(L, (const char*)f.data, f.size, "@init.lua", "t");
+
+namespace Hotones::Assets {
+
+constexpr size_t CACHE_BUDGET = 32u << 20;   // inflated bytes kept for reuse
+
+// The bytes of one file.  `owner` keeps them alive (the mapped archive or
+// an inflated copy), so a view stays valid after Unmount() or eviction.
+struct FileView {
+    const unsigned char*  data = nullptr;
+    size_t                size = 0;
+    std::shared_ptr<const void> owner;
+
+    explicit operator bool() const { return owner != nullptr; }
+};
+
+class Vfs {
+public:
+    struct Stats {
+        int    mounts      = 0;
+        size_t mappedBytes = 0;   // archive bytes mapped
+        size_t cacheBytes  = 0;   // inflated bytes held by the cache
+        int    hits        = 0;   // deflated reads served from the cache
+        int    inflates    = 0;   // deflated reads that had to inflate
+    };
+
+    // ── Singleton ─────────────────────────────────────────────────────────────
+    static Vfs& Get();
+
+    Vfs(const Vfs&)            = delete;
+    Vfs& operator=(const Vfs&) = delete;
+
+    // Map the zip at `archivePath` and serve its files under `root`.  A
+    // previous mount at the same root is replaced.  False if the file can't
+    // be mapped or isn't a zip.
+    bool Mount(const std::string& root, const std::string& archivePath);
+
+    // Drop the mount at `root` and its cached files.  Views already handed
+    // out stay valid.
+    void Unmount(const std::string& root);
+
+    // Whether `path` is a file (not a directory) inside a mounted archive
+    bool Exists(const std::string& path) const;
+
+    // The file's bytes; empty if it isn't in a mounted archive or can't be
+    // decompressed
+    FileView Read(const std::string& path);
+
+    // Uncompressed size and CRC-32 from the central directory, without
+    // reading the file.  False if it isn't in a mounted archive.
+    bool Stat(const std::string& path, uint64_t& size, uint32_t& crc) const;
+
+    Stats GetStats() const;
+
+private:
+    struct Archive;
+    struct Mounted {
+        std::string              root;   // normalised, no trailing slash
+        std::shared_ptr<Archive> archive;
+    };
+    struct CacheEntry {
+        const Archive* archive;
+        uint32_t       index;
+        std::shared_ptr<const std::vector<unsigned char>> bytes;
+    };
+
+    Vfs() = default;
+
+    // Remove the mount at normalised `root` and its cache entries; m_mutex held
+    void Drop(const std::string& root);
+
+    // The mount holding `path` and the entry name within it; m_mutex held
+    const Mounted* Find(const std::string& path, std::string& name) const;
+
+    mutable std::mutex    m_mutex;
+    std::vector<Mounted>  m_mounts;
+    std::list<CacheEntry> m_cache;   // most recently read first
+    size_t                m_cacheBytes = 0;
+    int                   m_hits = 0, m_inflates = 0;
+};
+
+// ── Free helpers: the mounted archives first, then the disk ──────────────────
+
+// Absolute, lexically normal, forward slashes, no trailing slash: how the
+// Vfs (and the AssetCache) match paths
+std::string NormalisePath(const std::string& path);
+
+bool     FileExists(const std::string& path);
+FileView ReadFile(const std::string& path);
+
+} // namespace Hotones::Assets
@@ -24,29 +24,61 @@ inline bool LoadSound(const std::string& name, const std::string& path)
 }
 
 /// Play the first loaded variant for `name`.
-inline bool Play(const std::string& name, float gain = 1.0f)
+inline bool Play(const std::string& name, float gain = 1.0f, float distance = 0.0f)
 {
-    return Ho_tones::GetSoundBus().PlayLoaded(name, gain);
+    return Ho_tones::GetSoundBus().PlayLoaded(name, gain, distance);
 }
 
 /// Play a random variant from the group for `name`.
-inline bool PlayRandom(const std::string& name, float gain = 1.0f)
+inline bool PlayRandom(const std::string& name, float gain = 1.0f, float distance = 0.0f)
 {
-    return Ho_tones::GetSoundBus().PlayRandom(name, gain);
+    return Ho_tones::GetSoundBus().PlayRandom(name, gain, distance);
 }
 
 /// Play variants in round-robin order (good for footsteps, impacts etc.).
-inline bool PlaySequential(const std::string& name, float gain = 1.0f)
+inline bool PlaySequential(const std::string& name, float gain = 1.0f, float distance = 0.0f)
 {
-    return Ho_tones::GetSoundBus().PlaySequential(name, gain);
+    return Ho_tones::GetSoundBus().PlaySequential(name, gain, distance);
 }
 
 /// Like PlaySequential but each call starts an independent overlapping voice.
-inline bool PlaySequentialAsync(const std::string& name, float gain = 1.0f)
+inline bool PlaySequentialAsync(const std::string& name, float gain = 1.0f, float distance = 0.0f)
 {
-    return Ho_tones::GetSoundBus().PlaySequentialAsync(name, gain);
+    return Ho_tones::GetSoundBus().PlaySequentialAsync(name, gain, distance);
 }
 
+/// `count` variants in round-robin order, `interval` seconds apart, timed
+/// to the sample by the mixer.  Returns how many were scheduled.
+inline int PlaySequence(const std::string& name, int count, float interval, float gain = 1.0f,
+                        float distance = 0.0f)
+{
+    return Ho_tones::GetSoundBus().PlaySequence(name, count, interval, gain, distance);
+}
+
+/// Priority and instance limit for the sounds under `name`.  When voices
+/// run out, the lowest priority, then the farthest, then the oldest voice
+/// gives way; maxInstances 0 = no per-sound limit.
+inline void SetLimits(const std::string& name, int priority, int maxInstances = 0)
+{
+    Ho_tones::GetSoundBus().SetSoundLimits(name, priority, maxInstances);
+}
+
+/// Register a long file (music, ambience) under `name` for streaming: it is
+/// decoded in small chunks as it plays instead of all at once.
+inline bool LoadStream(const std::string& name, const std::string& path, bool loop = true)
+{
+    return Ho_tones::GetSoundBus().LoadStreamFile(name, path, loop);
+}
+
+/// Start a loaded stream from its beginning.
+inline bool PlayStream(const std::string& name, float gain = 1.0f)
+{
+    return Ho_tones::GetSoundBus().PlayStream(name, gain);
+}
+
+inline void StopStream(const std::string& name)      { Ho_tones::GetSoundBus().StopStream(name); }
+inline bool IsStreamPlaying(const std::string& name) { return Ho_tones::GetSoundBus().IsStreamPlaying(name); }
+
 /// Master volume, range 0–100.
 inline void SetVolume(int vol)  { Ho_tones::GetSoundBus().SetVolume(vol); }
 inline int  GetVolume()         { return Ho_tones::GetSoundBus().GetVolume(); }
@@ -54,4 +86,10 @@ inline int  GetVolume()         { return Ho_tones::GetSoundBus().GetVolume(); }
 /// Stop every currently playing voice immediately.
 inline void StopAll()           { Ho_tones::GetSoundBus().StopAll(); }
 
+/// How the mixer keeps up on the audio thread: mix durations against their
+/// budget, underruns (mixes over budget) and voice counts, with peaks since
+/// the last ResetMixStats.
+inline Ho_tones::SoundBus::MixStats GetMixStats() { return Ho_tones::GetSoundBus().GetMixStats(); }
+inline void ResetMixStats()                       { Ho_tones::GetSoundBus().ResetMixStats(); }
+
 } // namespace Hotones::Audio
@@ -0,0 +1,402 @@
+#pragma once
+
+#include <ECS/Entity.hpp>
+#include <ECS/TypeId.hpp>
+
+#include <unordered_map>
+#include <map>
+#include <memory>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <cstddef>
+#include <cassert>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// IColumn — type-erased column of one component type inside an Archetype.
+//
+// Lets an Archetype move rows between tables and compact itself without
+// knowing the concrete component types at compile time.
+// ---------------------------------------------------------------------------
+struct IColumn {
+    virtual ~IColumn() = default;
+
+    // New, empty column of the same component type.
+    [[nodiscard]] virtual std::unique_ptr<IColumn> CloneEmpty() const = 0;
+
+    // Move-append row into dst (which must hold the same component type).
+    virtual void MoveRowTo(size_t row, IColumn& dst) = 0;
+
+    // Remove row by swapping the last element into its place.
+    virtual void SwapRemove(size_t row) = 0;
+
+    virtual void Clear() = 0;
+
+    [[nodiscard]] virtual size_t Size() const = 0;
+};
+
+template<typename T>
+struct Column final : IColumn {
+    std::vector<T> data;
+
+    [[nodiscard]] std::unique_ptr<IColumn> CloneEmpty() const override {
+        return std::make_unique<Column<T>>();
+    }
+
+    void MoveRowTo(size_t row, IColumn& dst) override {
+        static_cast<Column<T>&>(dst).data.push_back(std::move(data[row]));
+    }
+
+    void SwapRemove(size_t row) override {
+        if (row + 1 != data.size()) data[row] = std::move(data.back());
+        data.pop_back();
+    }
+
+    void Clear() override { data.clear(); }
+
+    [[nodiscard]] size_t Size() const override { return data.size(); }
+};
+
+// ---------------------------------------------------------------------------
+// Archetype — a table holding every entity with one exact component set.
+//
+// Each component type has its own contiguous column (SoA), and row r of every
+// column belongs to entities[r].  Add / remove edges cache the neighbouring
+// archetype so repeated structural changes skip the signature lookup.
+// ---------------------------------------------------------------------------
+struct Archetype {
+    std::vector<ComponentTypeId>          types;    // sorted signature
+    std::vector<std::unique_ptr<IColumn>> columns;  // parallel to types
+    std::vector<EntityId>                 entities; // row → entity
+
+    std::unordered_map<ComponentTypeId, Archetype*> addEdges;
+    std::unordered_map<ComponentTypeId, Archetype*> removeEdges;
+
+    // Column position for type key, or -1 if this archetype does not hold it.
+    [[nodiscard]] int ColumnIndex(ComponentTypeId key) const {
+        const auto it = std::lower_bound(types.begin(), types.end(), key);
+        return (it != types.end() && *it == key)
+            ? static_cast<int>(it - types.begin())
+            : -1;
+    }
+
+    template<typename T>
+    [[nodiscard]] std::vector<T>& Data(int column) {
+        return static_cast<Column<T>*>(columns[column].get())->data;
+    }
+
+    [[nodiscard]] size_t Size() const noexcept { return entities.size(); }
+};
+
+// ---------------------------------------------------------------------------
+// ArchetypeRegistry — optional archetype-based alternative to Registry.
+//
+// Entities are grouped by their exact component set.  A View<Ts...> walks
+// only the archetypes whose signature contains every Ts and streams their
+// columns linearly — there is no per-entity membership test at all, which
+// makes wide multi-component queries (Transform + Velocity + RenderModel on
+// tens of thousands of entities) much cheaper than the sparse-set Registry.
+//
+// The trade-off is structural change cost: AddComponent / RemoveComponent
+// move the entity's whole row to another archetype.  Prefer Registry for
+// entities whose component set changes every frame, ArchetypeRegistry for
+// large, stable populations.
+//
+// The API mirrors Registry so a scene can switch backends with few edits:
+//
+//   ArchetypeRegistry reg;
+//   auto e = reg.CreateEntity();
+//   reg.AddComponent<TransformComponent>(e, Vector3{0,1,0});
+//   reg.AddComponent<VelocityComponent>(e);
+//   reg.View<TransformComponent, VelocityComponent>(
+//       [dt](EntityId, TransformComponent& t, VelocityComponent& v) {
+//           t.position = Vector3Add(t.position, Vector3Scale(v.linear, dt));
+//       });
+//
+// Thread safety and mutation-during-view rules are the same as Registry.
+// Component references are invalidated by ANY structural change to the
+// entity that owns them (its row moves to another archetype).
+// ---------------------------------------------------------------------------
+
+class ArchetypeRegistry {
+public:
+    ArchetypeRegistry() { m_root = CreateArchetype({}, {}); }
+    ~ArchetypeRegistry() = default;
+
+    // Non-copyable; move is fine (archetypes are heap-allocated, so the
+    // Archetype* held in records and edges stay valid).
+    ArchetypeRegistry(const ArchetypeRegistry&)            = delete;
+    ArchetypeRegistry& operator=(const ArchetypeRegistry&) = delete;
+    ArchetypeRegistry(ArchetypeRegistry&&)                 = default;
+    ArchetypeRegistry& operator=(ArchetypeRegistry&&)      = default;
+
+    // -----------------------------------------------------------------------
+    // Entity lifecycle
+    // -----------------------------------------------------------------------
+
+    // Create a new entity in the empty archetype. Reuses freed slots.
+    [[nodiscard]] EntityId CreateEntity() {
+        uint32_t idx;
+        if (!m_freeList.empty()) {
+            idx = m_freeList.front();
+            m_freeList.pop();
+        } else {
+            idx = static_cast<uint32_t>(m_generations.size());
+            m_generations.push_back(0u);
+            m_records.push_back({});
+        }
+        const EntityId id = MakeEntity(idx, m_generations[idx]);
+        m_records[idx] = { m_root, static_cast<uint32_t>(m_root->entities.size()) };
+        m_root->entities.push_back(id);
+        ++m_aliveCount;
+        return id;
+    }
+
+    // Destroy an entity: drops its row (all components) and invalidates the id.
+    void DestroyEntity(EntityId id) {
+        if (!IsAlive(id)) return;
+        const uint32_t idx = EntityIndex(id);
+        const Record   rec = m_records[idx];
+        RemoveRow(*rec.archetype, rec.row);
+        m_records[idx] = {};
+        m_generations[idx] = NextGeneration(m_generations[idx]);
+        m_freeList.push(idx);
+        --m_aliveCount;
+    }
+
+    [[nodiscard]] bool IsAlive(EntityId id) const noexcept {
+        const uint32_t idx = EntityIndex(id);
+        return idx < m_generations.size()
+            && EntityGeneration(id) == m_generations[idx]
+            && m_records[idx].archetype != nullptr;
+    }
+
+    [[nodiscard]] size_t EntityCount() const noexcept { return m_aliveCount; }
+
+    // Destroy every entity. Archetypes (and their cached edges) are kept so
+    // a repopulated world does not pay the archetype creation cost again.
+    void Clear() {
+        for (auto& arch : m_archetypes) {
+            for (auto& col : arch->columns) col->Clear();
+            arch->entities.clear();
+        }
+        m_generations.clear();
+        m_records.clear();
+        while (!m_freeList.empty()) m_freeList.pop();
+        m_aliveCount = 0;
+    }
+
+    // -----------------------------------------------------------------------
+    // Component API
+    // -----------------------------------------------------------------------
+
+    // Construct a T in-place on entity id, moving it to the archetype that
+    // has its current components plus T.
+    template<typename T, typename... Args>
+    T& AddComponent(EntityId id, Args&&... args) {
+        assert(IsAlive(id) && "ArchetypeRegistry::AddComponent — entity is not alive");
+        assert(!HasComponent<T>(id) && "ArchetypeRegistry::AddComponent — entity already owns this component");
+
+        const ComponentTypeId key = ComponentType<T>();
+        Record&    rec = m_records[EntityIndex(id)];
+        Archetype& src = *rec.archetype;
+        Archetype& dst = AddEdge<T>(src);
+
+        const uint32_t newRow = static_cast<uint32_t>(dst.entities.size());
+        const int      tCol   = dst.ColumnIndex(key);
+        MoveRow(src, rec.row, dst);
+        dst.Data<T>(tCol).emplace_back(std::forward<Args>(args)...);
+
+        rec = { &dst, newRow };
+        return dst.Data<T>(tCol).back();
+    }
+
+    template<typename T>
+    [[nodiscard]] bool HasComponent(EntityId id) const {
+        if (!IsAlive(id)) return false;
+        return m_records[EntityIndex(id)].archetype->ColumnIndex(ComponentType<T>()) >= 0;
+    }
+
+    template<typename T>
+    [[nodiscard]] T& GetComponent(EntityId id) {
+        assert(IsAlive(id)         && "ArchetypeRegistry::GetComponent — entity is not alive");
+        assert(HasComponent<T>(id) && "ArchetypeRegistry::GetComponent — entity does not own component");
+        const Record& rec = m_records[EntityIndex(id)];
+        return rec.archetype->Data<T>(rec.archetype->ColumnIndex(ComponentType<T>()))[rec.row];
+    }
+
+    // Remove T from entity id (no-op if it doesn't own one).
+    template<typename T>
+    void RemoveComponent(EntityId id) {
+        if (!HasComponent<T>(id)) return;
+        const ComponentTypeId key = ComponentType<T>();
+        Record&    rec = m_records[EntityIndex(id)];
+        Archetype& src = *rec.archetype;
+        Archetype& dst = RemoveEdge(src, key);
+
+        const uint32_t newRow = static_cast<uint32_t>(dst.entities.size());
+        MoveRow(src, rec.row, dst);
+        rec = { &dst, newRow };
+    }
+
+    template<typename T>
+    T& GetOrAdd(EntityId id) {
+        if (!HasComponent<T>(id)) return AddComponent<T>(id);
+        return GetComponent<T>(id);
+    }
+
+    // -----------------------------------------------------------------------
+    // Querying
+    // -----------------------------------------------------------------------
+
+    // View<Ts...>(fn) — calls fn(EntityId, Ts&...) for every entity that owns
+    // ALL of the listed component types.  Matching archetypes are walked in
+    // creation order, rows in storage order.
+    //
+    // Structural changes (create / destroy / add / remove) inside fn are NOT
+    // safe — defer them until the view returns.
+    template<typename... Ts, typename Fn>
+    void View(Fn&& fn) {
+        static_assert(sizeof...(Ts) > 0, "View requires at least one component type");
+
+        for (auto& archPtr : m_archetypes) {
+            Archetype& arch = *archPtr;
+            if (arch.entities.empty()) continue;
+
+            const int cols[] = { arch.ColumnIndex(ComponentType<Ts>())... };
+            if (std::any_of(std::begin(cols), std::end(cols), [](int c) { return c < 0; }))
+                continue;
+
+            ViewArchetype<Ts...>(arch, cols, fn, std::index_sequence_for<Ts...>{});
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    // Introspection
+    // -----------------------------------------------------------------------
+
+    [[nodiscard]] size_t ArchetypeCount() const noexcept { return m_archetypes.size(); }
+
+    [[nodiscard]] const std::vector<std::unique_ptr<Archetype>>& Archetypes() const noexcept {
+        return m_archetypes;
+    }
+
+private:
+    struct Record {
+        Archetype* archetype = nullptr; // nullptr while the slot is free
+        uint32_t   row       = 0;
+    };
+
+    // ---- Internal helpers -------------------------------------------------
+
+    template<typename... Ts, typename Fn, size_t... I>
+    void ViewArchetype(Archetype& arch, const int (&cols)[sizeof...(Ts)], Fn& fn,
+                       std::index_sequence<I...>) {
+        // Resolve every column once; the row loop is a straight array walk.
+        std::tuple<std::vector<Ts>*...> data{ &arch.Data<Ts>(cols[I])... };
+        const size_t n = arch.entities.size();
+        for (size_t row = 0; row < n; ++row)
+            fn(arch.entities[row], (*std::get<I>(data))[row]...);
+    }
+
+    Archetype* CreateArchetype(std::vector<ComponentTypeId> types,
+                               std::vector<std::unique_ptr<IColumn>> columns) {
+        auto arch     = std::make_unique<Archetype>();
+        arch->types   = std::move(types);
+        arch->columns = std::move(columns);
+        Archetype* raw = arch.get();
+        m_lookup.emplace(raw->types, raw);
+        m_archetypes.push_back(std::move(arch));
+        return raw;
+    }
+
+    // Archetype = src + T, creating it on first use.
+    template<typename T>
+    Archetype& AddEdge(Archetype& src) {
+        const ComponentTypeId key = ComponentType<T>();
+        if (auto it = src.addEdges.find(key); it != src.addEdges.end())
+            return *it->second;
+
+        std::vector<ComponentTypeId> types = src.types;
+        types.insert(std::lower_bound(types.begin(), types.end(), key), key);
+
+        Archetype* dst;
+        if (auto it = m_lookup.find(types); it != m_lookup.end()) {
+            dst = it->second;
+        } else {
+            std::vector<std::unique_ptr<IColumn>> columns;
+            columns.reserve(types.size());
+            for (const auto& t : types) {
+                if (t == key) columns.push_back(std::make_unique<Column<T>>());
+                else          columns.push_back(src.columns[src.ColumnIndex(t)]->CloneEmpty());
+            }
+            dst = CreateArchetype(std::move(types), std::move(columns));
+        }
+        src.addEdges.emplace(key, dst);
+        dst->removeEdges.emplace(key, &src);
+        return *dst;
+    }
+
+    // Archetype = src − key, creating it on first use.
+    Archetype& RemoveEdge(Archetype& src, ComponentTypeId key) {
+        if (auto it = src.removeEdges.find(key); it != src.removeEdges.end())
+            return *it->second;
+
+        std::vector<ComponentTypeId> types;
+        std::vector<std::unique_ptr<IColumn>> columns;
+        for (size_t i = 0; i < src.types.size(); ++i) {
+            if (src.types[i] == key) continue;
+            types.push_back(src.types[i]);
+            columns.push_back(src.columns[i]->CloneEmpty());
+        }
+
+        Archetype* dst;
+        if (auto it = m_lookup.find(types); it != m_lookup.end()) dst = it->second;
+        else dst = CreateArchetype(std::move(types), std::move(columns));
+
+        src.removeEdges.emplace(key, dst);
+        dst->addEdges.emplace(key, &src);
+        return *dst;
+    }
+
+    // Move src[row] into a new row of dst: every column dst shares with src
+    // is transferred, columns only src has are dropped.  Any column only dst
+    // has is left for the caller to append (AddComponent).
+    void MoveRow(Archetype& src, uint32_t row, Archetype& dst) {
+        for (size_t i = 0; i < src.types.size(); ++i) {
+            const int d = dst.ColumnIndex(src.types[i]);
+            if (d >= 0) src.columns[i]->MoveRowTo(row, *dst.columns[d]);
+        }
+        dst.entities.push_back(src.entities[row]);
+        RemoveRow(src, row);
+    }
+
+    // Swap-remove src[row] and patch the record of the entity moved into it.
+    void RemoveRow(Archetype& arch, uint32_t row) {
+        for (auto& col : arch.columns) col->SwapRemove(row);
+        const uint32_t last = static_cast<uint32_t>(arch.entities.size()) - 1u;
+        if (row != last) {
+            arch.entities[row] = arch.entities[last];
+            m_records[EntityIndex(arch.entities[row])].row = row;
+        }
+        arch.entities.pop_back();
+    }
+
+    // ---- Storage ----------------------------------------------------------
+
+    std::vector<uint32_t> m_generations; // generations[entityIndex]
+    std::vector<Record>   m_records;     // records[entityIndex] → archetype + row
+    std::queue<uint32_t>  m_freeList;    // recycled entity indices
+    size_t                m_aliveCount = 0;
+
+    std::vector<std::unique_ptr<Archetype>>               m_archetypes;
+    std::map<std::vector<ComponentTypeId>, Archetype*>    m_lookup; // signature → archetype
+    Archetype*                                            m_root = nullptr; // empty set
+};
+
+} // namespace Hotones::ECS
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// ArchiveWriter / ArchiveReader — flat binary streams used by
+// Registry::Serialize / Deserialize and by custom component serializers.
+//
+// Values are written in native byte order with no per-field tagging: an
+// archive is meant to be reloaded by the same build on the same platform
+// (scene reloads, save games, join-in-progress between identical builds).
+// Align() pads to a boundary so bulk arrays inside a memory-mapped archive
+// are suitably aligned for their element type.
+// ---------------------------------------------------------------------------
+
+class ArchiveWriter {
+public:
+    explicit ArchiveWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+    void Write(const void* data, size_t size) {
+        const auto* p = static_cast<const uint8_t*>(data);
+        m_out.insert(m_out.end(), p, p + size);
+    }
+
+    template<typename T>
+    void Pod(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "ArchiveWriter::Pod requires a trivially copyable type");
+        Write(&value, sizeof(T));
+    }
+
+    // Length-prefixed (uint32) string.
+    void String(const std::string& s) {
+        Pod(static_cast<uint32_t>(s.size()));
+        Write(s.data(), s.size());
+    }
+
+    // Zero-pad to a multiple of `alignment` bytes from the archive start.
+    void Align(size_t alignment) {
+        while (m_out.size() % alignment) m_out.push_back(0);
+    }
+
+    [[nodiscard]] size_t Offset() const noexcept { return m_out.size(); }
+
+    // Overwrite a previously written POD at `offset` (for back-patched sizes).
+    template<typename T>
+    void PatchPod(size_t offset, const T& value) {
+        std::memcpy(m_out.data() + offset, &value, sizeof(T));
+    }
+
+private:
+    std::vector<uint8_t>& m_out;
+};
+
+class ArchiveReader {
+public:
+    ArchiveReader(const uint8_t* data, size_t size)
+        : m_begin(data), m_cur(data), m_end(data + size) {}
+
+    // Copy size bytes out; false (and nothing read) if the archive is short.
+    bool Read(void* dst, size_t size) {
+        if (Remaining() < size) { m_ok = false; return false; }
+        std::memcpy(dst, m_cur, size);
+        m_cur += size;
+        return true;
+    }
+
+    template<typename T>
+    bool Pod(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "ArchiveReader::Pod requires a trivially copyable type");
+        return Read(&value, sizeof(T));
+    }
+
+    bool String(std::string& s) {
+        uint32_t len = 0;
+        if (!Pod(len) || Remaining() < len) { m_ok = false; return false; }
+        s.assign(reinterpret_cast<const char*>(m_cur), len);
+        m_cur += len;
+        return true;
+    }
+
+    // Pointer to the next size bytes (no copy) and advance past them, or
+    // nullptr if the archive is short.
+    const uint8_t* Take(size_t size) {
+        if (Remaining() < size) { m_ok = false; return nullptr; }
+        const uint8_t* p = m_cur;
+        m_cur += size;
+        return p;
+    }
+
+    bool Skip(size_t size) { return Take(size) != nullptr; }
+
+    bool Align(size_t alignment) {
+        const size_t off = static_cast<size_t>(m_cur - m_begin);
+        return Skip((alignment - off % alignment) % alignment);
+    }
+
+    [[nodiscard]] size_t Remaining() const noexcept { return static_cast<size_t>(m_end - m_cur); }
+
+    // False once any read ran past the end.
+    [[nodiscard]] bool Ok() const noexcept { return m_ok; }
+
+private:
+    const uint8_t* m_begin;
+    const uint8_t* m_cur;
+    const uint8_t* m_end;
+    bool           m_ok = true;
+};
+
+} // namespace Hotones::ECS
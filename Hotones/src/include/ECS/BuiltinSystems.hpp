@@ -0,0 +1,336 @@
+#pragma once
+
+#include <ECS/System.hpp>
+#include <ECS/Components.hpp>
+#include <ECS/SimdKernels.hpp>
+#include <Jobs/JobSystem.hpp>
+#include <Physics/PhysicsSystem.hpp>
+
+#include <raymath.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// BuiltinSystems.hpp — engine-provided Systems, ready for a SystemScheduler.
+// ---------------------------------------------------------------------------
+
+// Integrates VelocityComponent into TransformComponent:
+//   position += linear · dt        (SIMD, over the packed SoA arrays)
+//   rotation  = rotation ⊗ euler(angular · dt)   (scalar, only when spinning)
+//
+// Owns the Group<TransformComponent, VelocityComponent> (created in Init),
+// so every mover's position and linear velocity sit at the same slot of two
+// packed Vector3 arrays and the integration is one MulAdd over 3·n floats.
+// No other group may own Transform or Velocity while this system is used.
+// Transforms of entities with a non-zero velocity are marked changed.
+class MovementSystem : public System {
+public:
+    void DeclareAccess(SystemAccess& access) const override {
+        access.Read<VelocityComponent>().Write<TransformComponent>();
+    }
+
+    void Init(Registry& reg) override {
+        (void)reg.Group<TransformComponent, VelocityComponent>();
+    }
+
+    void Update(Registry& reg, float dt) override {
+        static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must be three packed floats");
+
+        auto movers = reg.Group<TransformComponent, VelocityComponent>();
+        Vector3*                   pos  = movers.Field<&TransformComponent::position>();
+        Quaternion*                rot  = movers.Field<&TransformComponent::rotation>();
+        const Vector3*             lin  = movers.Field<&VelocityComponent::linear>();
+        const Vector3*             ang  = movers.Field<&VelocityComponent::angular>();
+        const uint32_t*            ents = movers.EntityIndices();
+        ComponentPool<TransformComponent>& transforms = reg.Pool<TransformComponent>();
+        const uint32_t tick = reg.Tick();
+
+        Jobs::JobSystem::Get().ParallelFor(movers.Size(), GRAIN,
+            [&](size_t begin, size_t end) {
+                Simd::MulAdd(&pos[begin].x, &lin[begin].x, dt, (end - begin) * 3);
+                for (size_t i = begin; i < end; ++i) {
+                    const Vector3 w = ang[i];
+                    if (w.x != 0.0f || w.y != 0.0f || w.z != 0.0f)
+                        rot[i] = QuaternionNormalize(QuaternionMultiply(
+                            rot[i], QuaternionFromEuler(w.x * dt, w.y * dt, w.z * dt)));
+                }
+            });
+
+        // Change marks push onto one list, so they stay on this thread.
+        if constexpr (ComponentTraits<TransformComponent>::trackChanges) {
+            for (size_t i = 0, n = movers.Size(); i < n; ++i) {
+                const Vector3 v = lin[i], w = ang[i];
+                if (v.x != 0.0f || v.y != 0.0f || v.z != 0.0f ||
+                    w.x != 0.0f || w.y != 0.0f || w.z != 0.0f)
+                    transforms.MarkChanged(ents[i], tick);
+            }
+        }
+    }
+
+private:
+    static constexpr size_t GRAIN = 4096;
+};
+
+// Counts LifetimeComponent::remaining down and despawns the entity once it
+// reaches zero.  The countdown is a SIMD subtract over the dense pool and
+// expired entries are found with a vector compare; the despawn is recorded
+// into Commands(), so it lands when the scheduler flushes the stage.
+class LifetimeSystem : public System {
+public:
+    void DeclareAccess(SystemAccess& access) const override {
+        access.Write<LifetimeComponent>();
+    }
+
+    void Update(Registry& reg, float dt) override {
+        static_assert(sizeof(LifetimeComponent) == sizeof(float),
+                      "LifetimeSystem treats the dense pool as a float array");
+
+        ComponentPool<LifetimeComponent>& pool = reg.Pool<LifetimeComponent>();
+        if (pool.Size() == 0) return;
+        float*          remaining = &pool.Components().data()->remaining;
+        const uint32_t* ents      = pool.EntityIndices().data();
+        CommandBuffer&  cmds      = Commands();
+
+        Jobs::JobSystem::Get().ParallelFor(pool.Size(), GRAIN,
+            [&](size_t begin, size_t end) {
+                Simd::AddScalar(remaining + begin, -dt, end - begin);
+                Simd::ForEachAtMost(remaining + begin, 0.0f, end - begin, [&](size_t i) {
+                    cmds.Destroy(reg.EntityAt(ents[begin + i]));
+                });
+            });
+    }
+
+private:
+    static constexpr size_t GRAIN = 4096;
+};
+
+// Collides every entity with Transform + Velocity + ColliderSphere against
+// the static meshes registered with Physics: sphere sweeps with sliding
+// along what they hit, then a penetration resolve, written back into
+// TransformComponent::position.  Velocity loses the part going into each
+// surface that was hit, so resting bodies stop instead of pushing on.
+//
+// Add it after MovementSystem: this frame's motion is taken to be the
+// segment from position − linear·dt to position, i.e. the step
+// MovementSystem just integrated.  Colliders with physicsHandle < 0 collide
+// with every registered mesh (through the world queries); others only with
+// that mesh, and only with triangles in their collisionMask.  Static and
+// trigger colliders are left alone.
+//
+// Movers are gathered into flat arrays, their slides run in parallel on
+// the JobSystem (the physics queries are lock-free), and the results are
+// written back on this thread.
+class PhysicsSystem : public System {
+public:
+    void DeclareAccess(SystemAccess& access) const override {
+        access.Read<ColliderSphereComponent>().Write<TransformComponent, VelocityComponent>();
+    }
+
+    void Update(Registry& reg, float dt) override {
+        m_movers.clear();
+        reg.View<ColliderSphereComponent, TransformComponent, VelocityComponent>(
+            [&](EntityId id, const ColliderSphereComponent& col, auto&& tr, auto&& vel) {
+                if (col.isStatic || col.isTrigger) return;
+                Mover m;
+                m.id       = id;
+                m.end      = tr.position;
+                m.start    = Vector3Subtract(tr.position, Vector3Scale(vel.linear, dt));
+                m.velocity = vel.linear;
+                m.radius   = col.radius;
+                m.handle   = col.physicsHandle;
+                m.mask     = col.collisionMask;
+                m_movers.push_back(m);
+            });
+        if (m_movers.empty()) return;
+
+        Jobs::JobSystem::Get().ParallelFor(m_movers.size(), GRAIN,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) Collide(m_movers[i]);
+            });
+
+        for (const Mover& m : m_movers) {
+            if (!m.moved) continue;
+            reg.GetMut<TransformComponent>(m.id).position = m.end;
+            reg.GetComponent<VelocityComponent>(m.id).linear = m.velocity;
+        }
+    }
+
+private:
+    struct Mover {
+        EntityId id;
+        Vector3  start, end, velocity;
+        float    radius;
+        int      handle;
+        uint32_t mask;
+        bool     moved = false;   // end or velocity changed by a collision
+    };
+
+    static constexpr size_t GRAIN = 64;
+
+    // One collide-and-slide per mover: the triangles in reach are gathered
+    // once, so the slides and the resolve don't walk the trees again.
+    static void Collide(Mover& m) {
+        Physics::SlideParams params;
+        params.mask = m.mask;
+        const Vector3 motion = Vector3Subtract(m.end, m.start);
+        const Physics::SlideResult r = m.handle >= 0
+            ? Physics::SlideSphereAgainstStatic(m.handle, m.start, motion, m.radius, params, &m.velocity)
+            : Physics::SlideSphereWorld(m.start, motion, m.radius, params, &m.velocity);
+        if (r.contacts > 0 || r.pushed) {
+            m.end   = r.position;
+            m.moved = true;
+        }
+    }
+
+    std::vector<Mover> m_movers;
+};
+
+// Derives the world TransformComponent of every entity with a
+// ParentComponent and a LocalTransformComponent from its parent's:
+// world = parent ∘ local (ComposeTransform).
+//
+// The children are kept in one flat array sorted by depth (a child of a
+// root at depth 1, its children at 2, ...), so a level only reads
+// transforms the level before it finished.  Each tick a child is
+// recomputed only if its local transform, its parent's world transform or
+// its own world transform (something else moved it) changed this tick;
+// writing it marks it changed in turn, so a moving parent drags exactly its
+// subtree along and a still hierarchy costs one compare per child.  Levels
+// run in parallel on the JobSystem; change marks are set between levels,
+// on this thread.
+//
+// The order is rebuilt when parents change (ParentComponent is tracked) or
+// a hierarchy component is added or removed.  A child of a destroyed
+// entity, or of one without a transform, keeps its last world transform;
+// entities in a parent cycle are left alone.
+//
+// Add it after everything that moves entities and before anything that
+// reads where they are (particles, audio, the spatial index):
+//   m_systems.Add<ECS::MovementSystem>();
+//   m_systems.Add<ECS::HierarchySystem>();
+class HierarchySystem : public System {
+public:
+    void DeclareAccess(SystemAccess& access) const override {
+        access.Read<ParentComponent, LocalTransformComponent>().Write<TransformComponent>();
+    }
+
+    void Update(Registry& reg, float) override {
+        ComponentPool<ParentComponent>&         parents    = reg.Pool<ParentComponent>();
+        ComponentPool<LocalTransformComponent>& locals     = reg.Pool<LocalTransformComponent>();
+        ComponentPool<TransformComponent>&      transforms = reg.Pool<TransformComponent>();
+        const uint32_t tick = reg.Tick();
+
+        const bool rebuild = !parents.ChangedEntities().empty()
+            || parents.Version() != m_parentsVersion || parents.Size() != m_parentsSize
+            || locals.Version()  != m_localsVersion  || locals.Size()  != m_localsSize;
+        if (rebuild) Rebuild(reg);
+        if (m_nodes.empty()) return;
+
+        m_dirty.assign(m_nodes.size(), 0);
+        for (size_t level = 0; level + 1 < m_levels.size(); ++level) {
+            const size_t first = m_levels[level], last = m_levels[level + 1];
+            Jobs::JobSystem::Get().ParallelFor(last - first, GRAIN, [&](size_t begin, size_t end) {
+                for (size_t i = first + begin; i < first + end; ++i) {
+                    const Node& n = m_nodes[i];
+                    if (!reg.IsAlive(n.parentId) || !transforms.Has(n.parent)) continue;
+                    if (!rebuild && locals.ChangeTick(n.entity) != tick
+                            && transforms.ChangeTick(n.parent) != tick
+                            && transforms.ChangeTick(n.entity) != tick)
+                        continue;
+                    transforms.Get(n.entity) = ComposeTransform(transforms.Get(n.parent), locals.Get(n.entity));
+                    m_dirty[i] = 1;
+                }
+            });
+            // Marks push onto one list, so they stay on this thread; the
+            // next level reads them
+            for (size_t i = first; i < last; ++i)
+                if (m_dirty[i]) transforms.MarkChanged(m_nodes[i].entity, tick);
+        }
+    }
+
+    // Children in the hierarchy (as of the last Update), and its depth
+    [[nodiscard]] size_t NodeCount() const noexcept { return m_nodes.size(); }
+    [[nodiscard]] size_t Depth()     const noexcept { return m_levels.empty() ? 0 : m_levels.size() - 1; }
+
+private:
+    struct Node {
+        uint32_t entity;     // index of the child
+        uint32_t parent;     // index of its parent
+        EntityId parentId;   // to notice the parent's destruction
+    };
+
+    static constexpr uint32_t UNSEEN  = 0;
+    static constexpr uint32_t VISITING = ~0u;
+    static constexpr uint32_t CYCLE   = ~0u - 1;
+    static constexpr size_t   GRAIN   = 256;
+
+    // Depth of every child (roots are 0), by walking up; counting-sort the
+    // children into m_nodes by it
+    void Rebuild(Registry& reg) {
+        ComponentPool<ParentComponent>&         parents = reg.Pool<ParentComponent>();
+        ComponentPool<LocalTransformComponent>& locals  = reg.Pool<LocalTransformComponent>();
+        m_parentsVersion = parents.Version();
+        m_parentsSize    = parents.Size();
+        m_localsVersion  = locals.Version();
+        m_localsSize     = locals.Size();
+        m_nodes.clear();
+        m_levels.clear();
+
+        auto isChild = [&](uint32_t idx) {
+            return parents.Has(idx) && locals.Has(idx) && reg.IsAlive(parents.Get(idx).parent);
+        };
+        const std::vector<uint32_t>& children = parents.EntityIndices();
+        uint32_t bound = 0;
+        for (uint32_t idx : children)
+            bound = std::max({ bound, idx + 1, EntityIndex(parents.Get(idx).parent) + 1 });
+        m_depth.assign(bound, UNSEEN);   // depth + 1 once known; a root's is 1
+        size_t maxDepth = 0;
+        for (uint32_t start : children) {
+            if (!isChild(start) || m_depth[start] != UNSEEN) continue;
+            // Walk up to a root or a known depth, then number the way back
+            m_path.clear();
+            uint32_t idx = start;
+            while (isChild(idx) && m_depth[idx] == UNSEEN) {
+                m_depth[idx] = VISITING;
+                m_path.push_back(idx);
+                idx = EntityIndex(parents.Get(idx).parent);
+            }
+            uint32_t depth;
+            if (!isChild(idx))                  depth = 1;   // idx is a root
+            else if (m_depth[idx] == VISITING
+                  || m_depth[idx] == CYCLE)     depth = CYCLE;
+            else                                depth = m_depth[idx];   // already numbered
+            for (size_t i = m_path.size(); i-- > 0;) {
+                if (depth != CYCLE) ++depth;
+                m_depth[m_path[i]] = depth;
+                if (depth != CYCLE) maxDepth = std::max<size_t>(maxDepth, depth - 1);
+            }
+        }
+
+        // Counting sort by depth: m_levels[d - 1] is where depth d starts
+        m_levels.assign(maxDepth + 1, 0);
+        for (uint32_t idx : children)
+            if (isChild(idx) && m_depth[idx] != CYCLE) ++m_levels[m_depth[idx] - 1];
+        for (size_t d = 1; d < m_levels.size(); ++d) m_levels[d] += m_levels[d - 1];
+        m_nodes.resize(m_levels.back());
+        std::vector<size_t> fill(m_levels.begin(), m_levels.end() - 1);
+        for (uint32_t idx : children) {
+            if (!isChild(idx) || m_depth[idx] == CYCLE) continue;
+            const EntityId parent = parents.Get(idx).parent;
+            m_nodes[fill[m_depth[idx] - 2]++] = { idx, EntityIndex(parent), parent };
+        }
+    }
+
+    std::vector<Node>     m_nodes;    // by depth
+    std::vector<size_t>   m_levels;   // level d is [m_levels[d], m_levels[d + 1])
+    std::vector<uint8_t>  m_dirty;    // by node, this tick
+    std::vector<uint32_t> m_depth;    // by entity index, Rebuild() scratch
+    std::vector<uint32_t> m_path;
+    uint32_t m_parentsVersion = 0, m_localsVersion = 0;
+    size_t   m_parentsSize    = 0, m_localsSize    = 0;
+};
+
+} // namespace Hotones::ECS
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <ECS/Entity.hpp>
+#include <ECS/Registry.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// PendingEntity — placeholder for an entity recorded with
+// CommandBuffer::Create().  It only becomes a real EntityId when the buffer
+// is flushed, but Add / Remove / Destroy can target it in the meantime.
+// ---------------------------------------------------------------------------
+struct PendingEntity {
+    uint32_t index = 0; // position in the buffer's create list
+};
+
+// ---------------------------------------------------------------------------
+// CommandBuffer — deferred structural changes for a Registry.
+//
+// Create / Destroy / Add / Remove calls are recorded into a linear arena and
+// replayed, in recording order, by one Flush(Registry&).  Use it whenever a
+// structural change has to happen while a View / Each / ParallelView is
+// iterating, e.g. despawning expired entities from inside the query:
+//
+//   CommandBuffer cmds;
+//   reg.ParallelEach<LifetimeComponent>([&](EntityId id, LifetimeComponent& lt) {
+//       lt.remaining -= dt;
+//       if (lt.remaining <= 0.0f) cmds.Destroy(id);
+//   });
+//   cmds.Flush(reg);
+//
+// Recording is thread-safe (a short mutex per call), so one buffer can be
+// shared by every chunk of a ParallelView.  Flush must run on the thread
+// that owns the Registry, with no query in progress.
+//
+// Replay rules
+// ------------
+//   • commands targeting a dead entity are skipped;
+//   • Add on an entity that already owns T replaces the component;
+//   • Remove of an absent component is a no-op.
+//
+// Component payloads are moved (not copied) into the Registry on Flush.
+// Arena blocks are never reallocated, so non-trivial payloads (std::string
+// in TagComponent, ...) are safe.  Memory is kept across flushes.
+// ---------------------------------------------------------------------------
+
+class CommandBuffer {
+public:
+    CommandBuffer() = default;
+    ~CommandBuffer() { Reset(); }
+
+    CommandBuffer(const CommandBuffer&)            = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    // -----------------------------------------------------------------------
+    // Recording
+    // -----------------------------------------------------------------------
+
+    // Record creation of a new entity.
+    PendingEntity Create() {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        PendingEntity p{ m_pendingCount++ };
+        Record(Op::Create, p.index, true, nullptr, nullptr);
+        return p;
+    }
+
+    void Destroy(EntityId id) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        Record(Op::Destroy, id, false, nullptr, nullptr);
+    }
+    void Destroy(PendingEntity p) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        Record(Op::Destroy, p.index, true, nullptr, nullptr);
+    }
+
+    // Record construction of a T from args (constructed now, moved on Flush).
+    template<typename T, typename... Args>
+    void Add(EntityId id, Args&&... args) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        RecordAdd<T>(id, false, std::forward<Args>(args)...);
+    }
+    template<typename T, typename... Args>
+    void Add(PendingEntity p, Args&&... args) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        RecordAdd<T>(p.index, true, std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    void Remove(EntityId id) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        Record(Op::Remove, id, false, &ApplyRemove<T>, nullptr);
+    }
+    template<typename T>
+    void Remove(PendingEntity p) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        Record(Op::Remove, p.index, true, &ApplyRemove<T>, nullptr);
+    }
+
+    // -----------------------------------------------------------------------
+    // Replay
+    // -----------------------------------------------------------------------
+
+    // Apply every recorded command to reg in order, then clear the buffer.
+    void Flush(Registry& reg) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        std::vector<EntityId> created(m_pendingCount, INVALID_ENTITY);
+
+        for (Command* cmd : m_commands) {
+            if (cmd->op == Op::Create) {
+                created[cmd->target] = reg.CreateEntity();
+                continue;
+            }
+            const EntityId id = cmd->pending ? created[cmd->target] : cmd->target;
+            if (id == INVALID_ENTITY || !reg.IsAlive(id)) continue;
+
+            switch (cmd->op) {
+                case Op::Destroy: reg.DestroyEntity(id);                  break;
+                case Op::Add:
+                case Op::Remove:  cmd->apply(reg, id, cmd->payload);      break;
+                case Op::Create:                                          break;
+            }
+        }
+        ResetLocked();
+    }
+
+    // Discard every recorded command without applying it.
+    void Reset() {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        ResetLocked();
+    }
+
+    [[nodiscard]] bool Empty() const {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        return m_commands.empty();
+    }
+
+    [[nodiscard]] size_t CommandCount() const {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        return m_commands.size();
+    }
+
+private:
+    enum class Op : uint8_t { Create, Destroy, Add, Remove };
+
+    using ApplyFn   = void (*)(Registry&, EntityId, void* payload);
+    using DestroyFn = void (*)(void* payload);
+
+    struct Command {
+        ApplyFn   apply   = nullptr; // Add / Remove replay
+        DestroyFn destroy = nullptr; // payload destructor (Add only)
+        void*     payload = nullptr; // T constructed in the arena (Add only)
+        EntityId  target  = 0;       // EntityId, or PendingEntity::index
+        Op        op      = Op::Create;
+        bool      pending = false;   // target is a PendingEntity index
+    };
+
+    static constexpr size_t BLOCK_SIZE = 16 * 1024;
+
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t                       size = 0;
+        size_t                       used = 0;
+    };
+
+    template<typename T>
+    static void ApplyAdd(Registry& reg, EntityId id, void* payload) {
+        T& value = *static_cast<T*>(payload);
+        if (reg.HasComponent<T>(id)) reg.GetMut<T>(id) = std::move(value);   // a replace counts as a change
+        else                         reg.AddComponent<T>(id, std::move(value));
+    }
+
+    template<typename T>
+    static void ApplyRemove(Registry& reg, EntityId id, void*) {
+        reg.RemoveComponent<T>(id);
+    }
+
+    template<typename T>
+    static void DestroyPayload(void* payload) {
+        static_cast<T*>(payload)->~T();
+    }
+
+    // Bump-allocate size bytes aligned to align, moving on to the next
+    // retained block (or a new, possibly oversized one) when it does not fit.
+    void* Allocate(size_t size, size_t align) {
+        for (; m_blockIdx < m_blocks.size(); ++m_blockIdx)
+            if (void* p = TryAllocate(m_blocks[m_blockIdx], size, align)) return p;
+
+        const size_t blockSize = size + align > BLOCK_SIZE ? size + align : BLOCK_SIZE;
+        m_blocks.push_back({ std::unique_ptr<std::byte[]>(new std::byte[blockSize]), blockSize, 0 });
+        return TryAllocate(m_blocks.back(), size, align);
+    }
+
+    static void* TryAllocate(Block& b, size_t size, size_t align) {
+        const auto      base  = reinterpret_cast<uintptr_t>(b.data.get());
+        const uintptr_t start = (base + b.used + align - 1) & ~(uintptr_t(align) - 1);
+        if (start + size > base + b.size) return nullptr;
+        b.used = start + size - base;
+        return reinterpret_cast<void*>(start);
+    }
+
+    Command* Record(Op op, EntityId target, bool pending, ApplyFn apply, DestroyFn destroy) {
+        void* mem = Allocate(sizeof(Command), alignof(Command));
+        auto* cmd = new (mem) Command{ apply, destroy, nullptr, target, op, pending };
+        m_commands.push_back(cmd);
+        return cmd;
+    }
+
+    template<typename T, typename... Args>
+    void RecordAdd(EntityId target, bool pending, Args&&... args) {
+        Command* cmd = Record(Op::Add, target, pending, &ApplyAdd<T>, &DestroyPayload<T>);
+        void*    mem = Allocate(sizeof(T), alignof(T));
+        cmd->payload = new (mem) T(std::forward<Args>(args)...);
+    }
+
+    void ResetLocked() {
+        for (Command* cmd : m_commands)
+            if (cmd->destroy) cmd->destroy(cmd->payload);
+        m_commands.clear();
+        for (auto& b : m_blocks) b.used = 0;
+        m_blockIdx     = 0;
+        m_pendingCount = 0;
+    }
+
+    mutable std::mutex    m_mutex;
+    std::vector<Block>    m_blocks;    // arena; blocks are never reallocated
+    size_t                m_blockIdx = 0;
+    std::vector<Command*> m_commands;  // recording order, points into m_blocks
+    uint32_t              m_pendingCount = 0;
+};
+
+} // namespace Hotones::ECS
@@ -1,11 +1,99 @@
 #pragma once
 
 #include <ECS/Entity.hpp>
+#include <ECS/ComponentTraits.hpp>
+#include <ECS/Archive.hpp>
+#include <ECS/ComponentStorage.hpp>
+#include <algorithm>
+#include <memory>
+#include <type_traits>
 #include <vector>
+#include <utility>
+#include <cstddef>
 #include <cassert>
 
 namespace Hotones::ECS {
 
+namespace detail {
+
+// ---------------------------------------------------------------------------
+// PagedTable<FILL> — uint32_t array indexed by entity index, stored in
+// 4 KB pages allocated on first write.  Unwritten slots read as FILL.
+// ---------------------------------------------------------------------------
+template<uint32_t FILL>
+class PagedTable {
+public:
+    static constexpr uint32_t PAGE_SIZE  = 1024u; // entries (4 KB of uint32_t)
+    static constexpr uint32_t PAGE_SHIFT = 10u;
+    static_assert((1u << PAGE_SHIFT) == PAGE_SIZE);
+
+    // Value at idx, or FILL.  Never allocates.
+    [[nodiscard]] uint32_t At(uint32_t idx) const {
+        const uint32_t page = idx >> PAGE_SHIFT;
+        return page < m_pages.size() && m_pages[page]
+            ? m_pages[page][idx & (PAGE_SIZE - 1u)]
+            : FILL;
+    }
+
+    // Writable slot for idx, allocating its page if needed.
+    uint32_t& Ref(uint32_t idx) {
+        const uint32_t page = idx >> PAGE_SHIFT;
+        if (page >= m_pages.size()) m_pages.resize(page + 1);
+        auto& p = m_pages[page];
+        if (!p) {
+            p.reset(new uint32_t[PAGE_SIZE]);
+            std::fill_n(p.get(), PAGE_SIZE, FILL);
+        }
+        return p[idx & (PAGE_SIZE - 1u)];
+    }
+
+    void Clear() { m_pages.clear(); }
+
+    [[nodiscard]] size_t PageCount() const {
+        size_t n = 0;
+        for (const auto& p : m_pages)
+            if (p) ++n;
+        return n;
+    }
+
+    // Allocated pages plus the page table itself.
+    [[nodiscard]] size_t Bytes() const {
+        return PageCount() * PAGE_SIZE * sizeof(uint32_t)
+             + m_pages.capacity() * sizeof(m_pages[0]);
+    }
+
+private:
+    std::vector<std::unique_ptr<uint32_t[]>> m_pages;
+};
+
+} // namespace detail
+
+// ---------------------------------------------------------------------------
+// PoolMemoryStats — heap bytes held by one pool (or a sum of pools).
+//
+// Counts reserved capacity, not just live entries, so it matches what the
+// allocator actually handed out.  Memory owned *by* the components (the
+// std::string inside TagComponent, ...) is not included.
+// ---------------------------------------------------------------------------
+struct PoolMemoryStats {
+    size_t sparsePages = 0; // allocated sparse pages
+    size_t sparseBytes = 0; // sparse pages + page table
+    size_t denseBytes  = 0; // dense entity-index array
+    size_t dataBytes   = 0; // dense component array
+
+    [[nodiscard]] size_t TotalBytes() const noexcept {
+        return sparseBytes + denseBytes + dataBytes;
+    }
+
+    PoolMemoryStats& operator+=(const PoolMemoryStats& o) noexcept {
+        sparsePages += o.sparsePages;
+        sparseBytes += o.sparseBytes;
+        denseBytes  += o.denseBytes;
+        dataBytes   += o.dataBytes;
+        return *this;
+    }
+};
+
 // ---------------------------------------------------------------------------
 // IPool — type-erased base for ComponentPool<T>.
 //
@@ -27,6 +115,38 @@ struct IPool {
     // Dense array of entity indices that own a component in this pool.
     // Returned by const reference — do NOT hold across mutations.
     virtual const std::vector<uint32_t>& EntityIndices() const = 0;
+
+    // Dense slot of entityIdx.  The entity must own a component here.
+    virtual uint32_t DenseIndex(uint32_t entityIdx) const = 0;
+
+    // Exchange dense slots a and b (entity and component), keeping the
+    // sparse side in sync.  Used by owning groups to keep pools sorted.
+    virtual void SwapDense(uint32_t a, uint32_t b) = 0;
+
+    // Heap usage of this pool.
+    virtual PoolMemoryStats MemoryStats() const = 0;
+
+    // Forget the changed-entity list (Registry::AdvanceTick).
+    virtual void ResetChanges() = 0;
+
+    // ComponentTraits<T>::serialName, or nullptr if the pool is not saved.
+    virtual const char* SerialName() const = 0;
+
+    // Write / restore the pool (dense entity indices and components).
+    // Load replaces the current contents and marks every restored component
+    // changed at `tick`; it returns false on a malformed or mismatched
+    // section, or one naming an entity index at or past `entityCount` (the
+    // archive's).  Only called when SerialName() is non-null.
+    virtual void Save(ArchiveWriter& w) const = 0;
+    virtual bool Load(ArchiveReader& r, uint32_t tick, uint32_t entityCount) = 0;
+
+    // Structural version: bumped whenever existing dense entries move or
+    // disappear (Remove / Clear / SwapDense).  Appends do not bump it, so a loop over
+    // [0, size-at-start) stays valid while components are added.
+    [[nodiscard]] uint32_t Version() const noexcept { return m_version; }
+
+protected:
+    uint32_t m_version = 0;
 };
 
 // ---------------------------------------------------------------------------
@@ -34,9 +154,26 @@ struct IPool {
 //
 // Internals
 // ---------
-//   m_sparse  — indexed by entity index; stores the dense position or EMPTY.
+//   m_sparse  — paged table indexed by entity index; stores the dense
+//               position or EMPTY.  4 KB pages are allocated on first
+//               write, so a rare component on a high entity index costs
+//               one page instead of a table up to it.
 //   m_dense   — packed array of entity indices (parallel to m_data).
-//   m_data    — packed array of T (parallel to m_dense).
+//   m_data    — packed components (parallel to m_dense): one std::vector<T>,
+//               or one array per field when ComponentTraits<T>::soaLayout is
+//               set.  In the SoA case Get() returns ComponentTraits<T>::Ref
+//               rather than T&, so callers bind with auto&& (or the Ref
+//               type) instead of T&.  With ComponentTraits<T>::stableStorage
+//               the components sit in fixed chunks that never move and
+//               m_data's dense side holds slot numbers instead.
+//
+// Change tracking (only when ComponentTraits<T>::trackChanges)
+// -------------------------------------------------------------
+//   m_changeTicks — paged per-entity tick of the last MarkChanged.  Kept by
+//                   entity index rather than dense slot so it survives
+//                   remove / re-add and dense swaps untouched.
+//   m_changed     — entities marked since the last ResetChanges, deduped by
+//                   tick; Changed<T> queries walk this instead of the pool.
 //
 // Complexity
 // ----------
@@ -51,27 +188,30 @@ public:
 
     void Remove(uint32_t entityIdx) override {
         if (!Has(entityIdx)) return;
+        ++m_version;
 
-        const uint32_t denseIdx = m_sparse[entityIdx];
+        const uint32_t denseIdx = m_sparse.At(entityIdx);
         const uint32_t last     = static_cast<uint32_t>(m_dense.size()) - 1u;
 
         if (denseIdx != last) {
             // Swap the target with the last element so we keep the array packed.
             const uint32_t lastEntityIdx = m_dense[last];
             m_dense[denseIdx]            = lastEntityIdx;
-            m_data [denseIdx]            = std::move(m_data[last]);
-            m_sparse[lastEntityIdx]      = denseIdx;
+            m_sparse.Ref(lastEntityIdx)     = denseIdx;
         }
 
         m_dense.pop_back();
-        m_data .pop_back();
-        m_sparse[entityIdx] = EMPTY;
+        m_data .EraseSwapLast(denseIdx);
+        m_sparse.Ref(entityIdx) = EMPTY;
     }
 
     void Clear() override {
-        m_sparse.clear();
-        m_dense .clear();
-        m_data  .clear();
+        ++m_version;
+        m_sparse     .Clear();
+        m_changeTicks.Clear();
+        m_changed    .clear();
+        m_dense      .clear();
+        m_data       .Clear();
     }
 
     [[nodiscard]] size_t Size() const override { return m_dense.size(); }
@@ -80,49 +220,197 @@ public:
         return m_dense;
     }
 
+    [[nodiscard]] uint32_t DenseIndex(uint32_t entityIdx) const override {
+        assert(Has(entityIdx) && "ComponentPool::DenseIndex — entity does not own this component");
+        return m_sparse.At(entityIdx);
+    }
+
+    void SwapDense(uint32_t a, uint32_t b) override {
+        if (a == b) return;
+        ++m_version;
+        std::swap(m_dense[a], m_dense[b]);
+        m_data.Swap(a, b);
+        m_sparse.Ref(m_dense[a]) = a;
+        m_sparse.Ref(m_dense[b]) = b;
+    }
+
+    [[nodiscard]] PoolMemoryStats MemoryStats() const override {
+        PoolMemoryStats s;
+        s.sparsePages = m_sparse.PageCount() + m_changeTicks.PageCount();
+        s.sparseBytes = m_sparse.Bytes() + m_changeTicks.Bytes();
+        s.denseBytes  = (m_dense.capacity() + m_changed.capacity()) * sizeof(uint32_t);
+        s.dataBytes   = m_data.Bytes();
+        return s;
+    }
+
+    void ResetChanges() override { m_changed.clear(); }
+
+    [[nodiscard]] const char* SerialName() const override { return ComponentTraits<T>::serialName; }
+
+    void Save(ArchiveWriter& w) const override {
+        if constexpr (IsSerializableComponent<T>) {
+            const auto count = static_cast<uint32_t>(m_dense.size());
+            w.Pod(count);
+            w.Pod(static_cast<uint32_t>(RAW_SERIALIZE ? Storage::RAW_TAG : 0));
+            w.Write(m_dense.data(), count * sizeof(uint32_t));
+            w.Align(16);
+            if constexpr (RAW_SERIALIZE) {
+                m_data.SaveRaw(w);
+            } else {
+                for (size_t i = 0; i < count; ++i) ComponentTraits<T>::Save(w, m_data.Value(i));
+            }
+        } else {
+            (void)w;
+        }
+    }
+
+    bool Load(ArchiveReader& r, uint32_t tick, uint32_t entityCount) override {
+        if constexpr (IsSerializableComponent<T>) {
+            uint32_t count = 0, elemSize = 0;
+            if (!r.Pod(count) || !r.Pod(elemSize)) return false;
+            if (elemSize != (RAW_SERIALIZE ? Storage::RAW_TAG : 0)) return false; // layout changed
+            // Sized from the archive only once it is known to hold them
+            if (count > entityCount || uint64_t(count) * sizeof(uint32_t) > r.Remaining()) return false;
+
+            Clear();
+            m_dense.resize(count);
+            if (!r.Read(m_dense.data(), count * sizeof(uint32_t)) || !r.Align(16)) return false;
+            for (uint32_t i = 0; i < count; ++i) {
+                if (m_dense[i] >= entityCount) return false;
+                uint32_t& slot = m_sparse.Ref(m_dense[i]);
+                if (slot != EMPTY) return false; // duplicate entity
+                slot = i;
+            }
+
+            if constexpr (RAW_SERIALIZE) {
+                if (!m_data.LoadRaw(r, count)) return false;
+            } else {
+                m_data.Reserve(count);
+                for (uint32_t i = 0; i < count; ++i) {
+                    T c{};
+                    if (!ComponentTraits<T>::Load(r, c)) return false;
+                    m_data.PushBack(std::move(c));
+                }
+            }
+            for (uint32_t idx : m_dense) MarkChanged(idx, tick);
+            return true;
+        } else {
+            (void)r; (void)tick; (void)entityCount;
+            return false;
+        }
+    }
+
     // ---- Typed interface ------------------------------------------------
 
+    using Storage        = typename detail::StorageFor<T>::type;
+    using Reference      = typename Storage::Reference;      // T&, or the SoA proxy
+    using ConstReference = typename Storage::ConstReference;
+    using Columns        = typename Storage::Columns;
+
+    // True when ComponentTraits<T>::soaLayout splits T into field arrays.
+    static constexpr bool SOA = Storage::SOA;
+    // True when the components are one std::vector<T> (Components()).
+    static constexpr bool CONTIGUOUS = Storage::CONTIGUOUS;
+
     [[nodiscard]] bool Has(uint32_t entityIdx) const {
-        return entityIdx < m_sparse.size() && m_sparse[entityIdx] != EMPTY;
+        return m_sparse.At(entityIdx) != EMPTY;
     }
 
     // Emplace-construct a T from args directly into the pool.
     // Asserts that the entity does not already own a T.
     template<typename... Args>
-    T& Emplace(uint32_t entityIdx, Args&&... args) {
-        if (entityIdx >= m_sparse.size())
-            m_sparse.resize(entityIdx + 1, EMPTY);
-
-        assert(!Has(entityIdx) && "ComponentPool::Emplace — entity already owns this component");
+    Reference Emplace(uint32_t entityIdx, Args&&... args) {
+        uint32_t& slot = m_sparse.Ref(entityIdx);
+        assert(slot == EMPTY && "ComponentPool::Emplace — entity already owns this component");
 
         const uint32_t denseIdx = static_cast<uint32_t>(m_dense.size());
-        m_sparse[entityIdx]     = denseIdx;
+        slot                    = denseIdx;
         m_dense.push_back(entityIdx);
-        m_data .emplace_back(std::forward<Args>(args)...);
-        return m_data.back();
+        m_data .Emplace(std::forward<Args>(args)...);
+        return m_data.At(denseIdx);
     }
 
     // Get a reference to the component owned by entityIdx.
     // Behaviour is undefined if Has(entityIdx) is false.
-    [[nodiscard]] T& Get(uint32_t entityIdx) {
+    [[nodiscard]] Reference Get(uint32_t entityIdx) {
         assert(Has(entityIdx) && "ComponentPool::Get — entity does not own this component");
-        return m_data[m_sparse[entityIdx]];
+        return m_data.At(m_sparse.At(entityIdx));
     }
-    [[nodiscard]] const T& Get(uint32_t entityIdx) const {
+    [[nodiscard]] ConstReference Get(uint32_t entityIdx) const {
         assert(Has(entityIdx) && "ComponentPool::Get — entity does not own this component");
-        return m_data[m_sparse[entityIdx]];
+        return m_data.At(m_sparse.At(entityIdx));
     }
 
+    // Component in dense slot i (parallel to EntityIndices()).
+    [[nodiscard]] Reference      AtDense(size_t i)       { return m_data.At(i); }
+    [[nodiscard]] ConstReference AtDense(size_t i) const { return m_data.At(i); }
+
+    // Cached dense array pointers: Cols()[i] is AtDense(i) without going
+    // back through the pool.  Invalidated by any add / remove.
+    [[nodiscard]] Columns Cols() { return m_data.Cols(); }
+
     // Access the dense component array directly (for raw iteration).
-    [[nodiscard]] std::vector<T>&       Components()       { return m_data; }
-    [[nodiscard]] const std::vector<T>& Components() const { return m_data; }
+    // Contiguous pools only; SoA pools expose one array per field via
+    // Field(), stable pools iterate through Cols().
+    [[nodiscard]] std::vector<T>&       Components()       requires CONTIGUOUS { return m_data.Vector(); }
+    [[nodiscard]] const std::vector<T>& Components() const requires CONTIGUOUS { return m_data.Vector(); }
+
+    // Dense array of one SoA field, e.g. Field<&TransformComponent::position>().
+    template<auto Member>
+    [[nodiscard]] auto* Field() requires SOA { return m_data.template Field<Member>(); }
+    template<auto Member>
+    [[nodiscard]] const auto* Field() const requires SOA { return m_data.template Field<Member>(); }
+
+    // ---- Change tracking (ComponentTraits<T>::trackChanges) -------------
+
+    // Record that entityIdx's T was written during `tick`.  The first mark
+    // per tick also appends to ChangedEntities().  No-op for untracked types.
+    void MarkChanged(uint32_t entityIdx, uint32_t tick) {
+        if constexpr (TRACK_CHANGES) {
+            uint32_t& t = m_changeTicks.Ref(entityIdx);
+            if (t == tick) return;
+            t = tick;
+            m_changed.push_back(entityIdx);
+        } else {
+            (void)entityIdx; (void)tick;
+        }
+    }
+
+    // Tick at which entityIdx's T last changed (0 = never, or untracked).
+    [[nodiscard]] uint32_t ChangeTick(uint32_t entityIdx) const {
+        return m_changeTicks.At(entityIdx);
+    }
+
+    // Entity indices marked since the last ResetChanges(), each listed once.
+    // May include entities that have since lost the component — filter with
+    // Has().
+    [[nodiscard]] const std::vector<uint32_t>& ChangedEntities() const { return m_changed; }
 
 private:
     static constexpr uint32_t EMPTY = ~0u;
 
-    std::vector<uint32_t> m_sparse; // sparse[entityIdx] → denseIdx or EMPTY
-    std::vector<uint32_t> m_dense;  // dense[i] → entityIdx
-    std::vector<T>        m_data;   // data[i]  → component for dense[i]
+    static constexpr bool TRACK_CHANGES = ComponentTraits<T>::trackChanges;
+
+    // Saved as one memcpy per array unless the type brings its own serializer.
+    static constexpr bool RAW_SERIALIZE =
+        std::is_trivially_copyable_v<T> && !HasComponentSerializer<T>;
+    static_assert(!IsSerializableComponent<T> || RAW_SERIALIZE || HasComponentSerializer<T>,
+                  "ComponentTraits<T>::serialName is set but T is not trivially copyable "
+                  "and has no Save / Load");
+
+    detail::PagedTable<EMPTY> m_sparse;      // sparse[entityIdx] → denseIdx or EMPTY
+    detail::PagedTable<0u>    m_changeTicks; // tick of last change per entityIdx (tracked only)
+    std::vector<uint32_t>     m_changed;     // entity indices changed since ResetChanges
+    std::vector<uint32_t>     m_dense;       // dense[i] → entityIdx
+    Storage                   m_data;        // data[i]  → component for dense[i]
 };
 
+// What Registry::GetComponent & co. return for T: T& for ordinary pools,
+// ComponentTraits<T>::Ref for SoA pools.
+template<typename T>
+using ComponentRef = typename ComponentPool<T>::Reference;
+
+template<typename T>
+using ComponentConstRef = typename ComponentPool<T>::ConstReference;
+
 } // namespace Hotones::ECS
@@ -0,0 +1,358 @@
+#pragma once
+
+#include <ECS/ComponentTraits.hpp>
+#include <ECS/Archive.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Hotones::ECS::detail {
+
+// ---------------------------------------------------------------------------
+// Dense component storage used by ComponentPool<T>.
+//
+// AosStorage<T> is the default: one std::vector<T>.  SoaStorage<T, Layout>
+// is selected by ComponentTraits<T>::soaLayout and keeps every listed field
+// in its own array, handing out ComponentTraits<T>::Ref proxies in place of
+// T&.  StableStorage<T> (ComponentTraits<T>::stableStorage) keeps components
+// in fixed-size chunks that never move.  All three expose the same small
+// interface, so the pool does not care which one it holds:
+//
+//   Reference / ConstReference   what Get() returns
+//   CONTIGUOUS                   dense slot i is element i of one T array
+//   Columns                      cached array pointers, columns[i] → Reference
+//   Emplace / PushBack / EraseSwapLast / Swap / Clear / Reserve
+//   Value(i)                     component i as const T& or a T copy
+//   RAW_TAG / SaveRaw / LoadRaw  bulk snapshot path (trivially copyable T)
+// ---------------------------------------------------------------------------
+
+template<auto Member>
+struct MemberPointer;
+
+template<typename C, typename F, F C::*M>
+struct MemberPointer<M> {
+    using Class = C;
+    using Field = F;
+};
+
+template<auto A, auto B>
+constexpr bool SameMember() {
+    if constexpr (std::is_same_v<decltype(A), decltype(B)>) return A == B;
+    else                                                    return false;
+}
+
+template<typename T>
+class AosStorage {
+public:
+    using Reference      = T&;
+    using ConstReference = const T&;
+
+    static constexpr bool SOA        = false;
+    static constexpr bool CONTIGUOUS = true;
+
+    // Written in the archive's elemSize slot; a mismatch rejects the load.
+    static constexpr uint32_t RAW_TAG = sizeof(T);
+
+    struct Columns {
+        T* data;
+        T& operator[](size_t i) const { return data[i]; }
+    };
+
+    [[nodiscard]] size_t Size() const noexcept { return m_data.size(); }
+
+    template<typename... Args>
+    void Emplace(Args&&... args) { m_data.emplace_back(std::forward<Args>(args)...); }
+    void PushBack(T&& value)     { m_data.push_back(std::move(value)); }
+
+    [[nodiscard]] Reference      At(size_t i)       { return m_data[i]; }
+    [[nodiscard]] ConstReference At(size_t i) const { return m_data[i]; }
+    [[nodiscard]] ConstReference Value(size_t i) const { return m_data[i]; }
+
+    [[nodiscard]] Columns Cols() { return { m_data.data() }; }
+
+    // Destroy slot i, moving the last element into it.
+    void EraseSwapLast(size_t i) {
+        if (i + 1 != m_data.size()) m_data[i] = std::move(m_data.back());
+        m_data.pop_back();
+    }
+    void Swap(size_t a, size_t b) { std::swap(m_data[a], m_data[b]); }
+    void Clear()              { m_data.clear(); }
+    void Reserve(size_t n)    { m_data.reserve(n); }
+
+    [[nodiscard]] size_t Bytes() const { return m_data.capacity() * sizeof(T); }
+
+    void SaveRaw(ArchiveWriter& w) const { w.Write(m_data.data(), m_data.size() * sizeof(T)); }
+    bool LoadRaw(ArchiveReader& r, size_t count) {
+        m_data.resize(count);
+        return r.Read(m_data.data(), count * sizeof(T));
+    }
+
+    [[nodiscard]] std::vector<T>&       Vector()       { return m_data; }
+    [[nodiscard]] const std::vector<T>& Vector() const { return m_data; }
+
+private:
+    std::vector<T> m_data;
+};
+
+template<typename T, typename Layout>
+class SoaStorage;
+
+template<typename T, auto... Ms>
+class SoaStorage<T, SoaLayout<Ms...>> {
+    static_assert(sizeof...(Ms) > 0, "SoaLayout needs at least one field");
+    static_assert((std::is_same_v<typename MemberPointer<Ms>::Class, T> && ...),
+                  "SoaLayout fields must be data members of the component");
+    static_assert((sizeof(typename MemberPointer<Ms>::Field) + ...) <= sizeof(T),
+                  "SoaLayout lists a field more than once");
+
+    using Indices = std::index_sequence_for<decltype(Ms)...>;
+
+public:
+    using Reference      = typename ComponentTraits<T>::Ref;
+    using ConstReference = typename ComponentTraits<T>::ConstRef;
+
+    static constexpr bool SOA        = true;
+    static constexpr bool CONTIGUOUS = false;
+
+    // High bit keeps an SoA archive from loading into an AoS pool (or back).
+    static constexpr uint32_t RAW_TAG =
+        0x80000000u | static_cast<uint32_t>((sizeof(typename MemberPointer<Ms>::Field) + ...));
+
+    struct Columns {
+        std::tuple<typename MemberPointer<Ms>::Field*...> fields;
+        Reference operator[](size_t i) const {
+            return std::apply([i](auto*... f) { return Reference{ f[i]... }; }, fields);
+        }
+    };
+
+    [[nodiscard]] size_t Size() const noexcept { return std::get<0>(m_fields).size(); }
+
+    template<typename... Args>
+    void Emplace(Args&&... args) { PushBack(T(std::forward<Args>(args)...)); }
+
+    void PushBack(T&& value) {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (std::get<I>(m_fields).push_back(std::move(value.*Ms)), ...);
+        }(Indices{});
+    }
+
+    [[nodiscard]] Reference At(size_t i) {
+        return std::apply([i](auto&... f) { return Reference{ f[i]... }; }, m_fields);
+    }
+    [[nodiscard]] ConstReference At(size_t i) const {
+        return std::apply([i](const auto&... f) { return ConstReference{ f[i]... }; }, m_fields);
+    }
+
+    // Reassembled copy of component i (custom serializers take a const T&).
+    [[nodiscard]] T Value(size_t i) const {
+        T value{};
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((value.*Ms = std::get<I>(m_fields)[i]), ...);
+        }(Indices{});
+        return value;
+    }
+
+    [[nodiscard]] Columns Cols() {
+        return std::apply([](auto&... f) { return Columns{ { f.data()... } }; }, m_fields);
+    }
+
+    void EraseSwapLast(size_t i) {
+        const bool last = i + 1 == Size();
+        std::apply([i, last](auto&... f) {
+            if (!last) ((f[i] = std::move(f.back())), ...);
+            (f.pop_back(), ...);
+        }, m_fields);
+    }
+    void Swap(size_t a, size_t b) { std::apply([a, b](auto&... f) { (std::swap(f[a], f[b]), ...); }, m_fields); }
+    void Clear()                  { std::apply([](auto&... f) { (f.clear(), ...); }, m_fields); }
+    void Reserve(size_t n)        { std::apply([n](auto&... f) { (f.reserve(n), ...); }, m_fields); }
+
+    [[nodiscard]] size_t Bytes() const {
+        return std::apply([](const auto&... f) {
+            return ((f.capacity() * sizeof(f[0])) + ...);
+        }, m_fields);
+    }
+
+    // One 16-byte-aligned block per field.
+    void SaveRaw(ArchiveWriter& w) const {
+        std::apply([&w](const auto&... f) {
+            ((w.Align(16), w.Write(f.data(), f.size() * sizeof(f[0]))), ...);
+        }, m_fields);
+    }
+    bool LoadRaw(ArchiveReader& r, size_t count) {
+        return std::apply([&r, count](auto&... f) {
+            return ((r.Align(16) && (f.resize(count), r.Read(f.data(), count * sizeof(f[0])))) && ...);
+        }, m_fields);
+    }
+
+    // Contiguous array of the Member field, one entry per dense slot.
+    template<auto Member>
+    [[nodiscard]] auto* Field() { return std::get<FieldIndex<Member>()>(m_fields).data(); }
+    template<auto Member>
+    [[nodiscard]] const auto* Field() const { return std::get<FieldIndex<Member>()>(m_fields).data(); }
+
+private:
+    template<auto Member>
+    static constexpr size_t FieldIndex() {
+        constexpr bool same[] = { SameMember<Member, Ms>()... };
+        size_t i = 0;
+        while (i < sizeof...(Ms) && !same[i]) ++i;
+        static_assert(((SameMember<Member, Ms>() ? 1 : 0) + ...) == 1,
+                      "SoaStorage::Field — member is not part of the SoaLayout");
+        return i;
+    }
+
+    std::tuple<std::vector<typename MemberPointer<Ms>::Field>...> m_fields;
+};
+
+// ---------------------------------------------------------------------------
+// StableStorage<T> — components live in fixed-size chunks of CHUNK_SIZE and
+// are never moved once constructed.
+//
+// The dense side is an array of slot numbers (m_slots[i] → chunk slot), so
+// removal and group re-sorting shuffle uint32_t slot numbers instead of
+// components.  Freed slots go onto a free list and are reused by the next
+// Emplace; chunks are only ever added (Clear keeps them for reuse), so a
+// growing pool never copies existing components and a T& stays valid until
+// that component is removed.  Iteration pays one extra indirection.
+// ---------------------------------------------------------------------------
+template<typename T>
+class StableStorage {
+public:
+    using Reference      = T&;
+    using ConstReference = const T&;
+
+    static constexpr bool SOA        = false;
+    static constexpr bool CONTIGUOUS = false;
+
+    static constexpr uint32_t CHUNK_SHIFT = 8u;
+    static constexpr uint32_t CHUNK_SIZE  = 1u << CHUNK_SHIFT; // components per chunk
+
+    // Same archive layout as AosStorage: the components back to back.
+    static constexpr uint32_t RAW_TAG = sizeof(T);
+
+    struct Columns {
+        const uint32_t* slots;
+        T* const*       chunks;
+        T& operator[](size_t i) const {
+            const uint32_t s = slots[i];
+            return chunks[s >> CHUNK_SHIFT][s & (CHUNK_SIZE - 1u)];
+        }
+    };
+
+    StableStorage() = default;
+    StableStorage(const StableStorage&)            = delete;
+    StableStorage& operator=(const StableStorage&) = delete;
+    ~StableStorage() {
+        Clear();
+        for (T* chunk : m_chunks) ::operator delete(chunk, std::align_val_t(alignof(T)));
+    }
+
+    [[nodiscard]] size_t Size() const noexcept { return m_slots.size(); }
+
+    template<typename... Args>
+    void Emplace(Args&&... args) {
+        const uint32_t slot = AcquireSlot();
+        try {
+            ::new (static_cast<void*>(Ptr(slot))) T(std::forward<Args>(args)...);
+        } catch (...) {
+            m_free.push_back(slot);
+            throw;
+        }
+        m_slots.push_back(slot);
+    }
+    void PushBack(T&& value) { Emplace(std::move(value)); }
+
+    [[nodiscard]] Reference      At(size_t i)          { return *Ptr(m_slots[i]); }
+    [[nodiscard]] ConstReference At(size_t i) const    { return *Ptr(m_slots[i]); }
+    [[nodiscard]] ConstReference Value(size_t i) const { return *Ptr(m_slots[i]); }
+
+    [[nodiscard]] Columns Cols() { return { m_slots.data(), m_chunks.data() }; }
+
+    void EraseSwapLast(size_t i) {
+        const uint32_t slot = m_slots[i];
+        Ptr(slot)->~T();
+        m_free.push_back(slot);
+        m_slots[i] = m_slots.back();
+        m_slots.pop_back();
+    }
+    void Swap(size_t a, size_t b) { std::swap(m_slots[a], m_slots[b]); }
+
+    // Destroys every component; the chunks stay allocated.
+    void Clear() {
+        for (uint32_t slot : m_slots) Ptr(slot)->~T();
+        m_slots.clear();
+        m_free.clear();
+        m_next = 0;
+    }
+
+    void Reserve(size_t n) {
+        m_slots.reserve(n);
+        while (m_chunks.size() * CHUNK_SIZE < n) AddChunk();
+    }
+
+    [[nodiscard]] size_t Bytes() const {
+        return m_chunks.size() * CHUNK_SIZE * sizeof(T)
+             + m_chunks.capacity() * sizeof(T*)
+             + (m_slots.capacity() + m_free.capacity()) * sizeof(uint32_t);
+    }
+
+    void SaveRaw(ArchiveWriter& w) const {
+        for (uint32_t slot : m_slots) w.Write(Ptr(slot), sizeof(T));
+    }
+    bool LoadRaw(ArchiveReader& r, size_t count) {
+        Reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            Emplace();
+            if (!r.Read(&At(i), sizeof(T))) return false;
+        }
+        return true;
+    }
+
+private:
+    [[nodiscard]] T* Ptr(uint32_t slot) const {
+        return m_chunks[slot >> CHUNK_SHIFT] + (slot & (CHUNK_SIZE - 1u));
+    }
+
+    uint32_t AcquireSlot() {
+        if (!m_free.empty()) {
+            const uint32_t slot = m_free.back();
+            m_free.pop_back();
+            return slot;
+        }
+        if ((m_next >> CHUNK_SHIFT) >= m_chunks.size()) AddChunk();
+        return m_next++;
+    }
+
+    void AddChunk() {
+        m_chunks.push_back(static_cast<T*>(
+            ::operator new(CHUNK_SIZE * sizeof(T), std::align_val_t(alignof(T)))));
+    }
+
+    std::vector<T*>       m_chunks; // raw storage for CHUNK_SIZE components each
+    std::vector<uint32_t> m_slots;  // dense[i] → slot; slot = chunk << CHUNK_SHIFT | offset
+    std::vector<uint32_t> m_free;   // slots below m_next that hold no component
+    uint32_t              m_next = 0; // first never-used slot
+};
+
+// Storage ComponentPool<T> uses for T, chosen by ComponentTraits<T>.
+template<typename T,
+         bool Stable   = ComponentTraits<T>::stableStorage,
+         typename Layout = typename ComponentTraits<T>::soaLayout>
+struct StorageFor {
+    static_assert(!Stable, "ComponentTraits: stableStorage and soaLayout are mutually exclusive");
+    using type = SoaStorage<T, Layout>;
+};
+
+template<typename T>
+struct StorageFor<T, false, void> { using type = AosStorage<T>; };
+
+template<typename T>
+struct StorageFor<T, true, void> { using type = StableStorage<T>; };
+
+} // namespace Hotones::ECS::detail
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <ECS/Archive.hpp>
+
+#include <concepts>
+#include <type_traits>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// SoaLayout<&T::a, &T::b, ...> — field list for ComponentTraits<T>::soaLayout.
+// ---------------------------------------------------------------------------
+template<auto... Members>
+struct SoaLayout {};
+
+// ---------------------------------------------------------------------------
+// ComponentTraits<T> — per-type storage options for ComponentPool<T>.
+//
+// Every option defaults to off.  Opt a component in by specialising the
+// trait next to its definition and deriving from DefaultComponentTraits,
+// so options added later keep their defaults:
+//
+//   template<> struct ComponentTraits<TransformComponent> : DefaultComponentTraits {
+//       static constexpr bool trackChanges = true;
+//   };
+// ---------------------------------------------------------------------------
+
+struct DefaultComponentTraits {
+    // Keep a per-entity change tick and a changed-entity list, enabling
+    // Registry::GetMut / MarkChanged and View<Changed<T>, ...>.
+    static constexpr bool trackChanges = false;
+
+    // Stable key for the type in Registry::Serialize archives (nullptr = the
+    // pool is not saved).  Never reuse or rename a shipped key.  Trivially
+    // copyable types are stored as raw dense arrays; anything else must also
+    // provide
+    //   static void Save(ArchiveWriter&, const T&);
+    //   static bool Load(ArchiveReader&, T&);
+    static constexpr const char* serialName = nullptr;
+
+    // Store the pool structure-of-arrays: SoaLayout<&T::a, &T::b, ...> names
+    // every data member of T, in declaration order, and each gets its own
+    // contiguous array (void = one array of T).  The traits must then also
+    // provide the reference types the pool hands out instead of T& / const T&:
+    //   using Ref      = ...;  // aggregate of the members' references, same order
+    //   using ConstRef = ...;  // same, with const references
+    // A kernel that only touches one field then streams through one packed
+    // array (ComponentPool::Field<&T::a>(), OwningGroup::Field<&T::a>()).
+    using soaLayout = void;
+
+    // Keep components in fixed-size chunks with a free list instead of a
+    // std::vector<T>: adding never reallocates or moves existing components,
+    // so a T& / T* from GetComponent stays valid until that component is
+    // removed (or the pool cleared).  Costs one indirection per access and
+    // gives up ComponentPool::Components().  Not combinable with soaLayout.
+    static constexpr bool stableStorage = false;
+
+    // Mirror the component from a server's Registry to its clients' on
+    // entities that carry a NetworkComponent (ECS/Replication.hpp).  Sent as
+    // raw bytes, so T must be trivially copyable and free of padding, and
+    // matched up by serialName, which must be set.  Register the type with
+    // ReplicatedComponents on both ends.  Tracked types are only re-sent
+    // when marked changed.
+    static constexpr bool replicate = false;
+};
+
+template<typename T>
+struct ComponentTraits : DefaultComponentTraits {};
+
+// True when ComponentTraits<T> supplies Save / Load for T.
+template<typename T>
+concept HasComponentSerializer = requires(ArchiveWriter& w, ArchiveReader& r, const T& c, T& m) {
+    ComponentTraits<T>::Save(w, c);
+    { ComponentTraits<T>::Load(r, m) } -> std::convertible_to<bool>;
+};
+
+// True when Registry::Serialize writes T's pool.
+template<typename T>
+inline constexpr bool IsSerializableComponent = ComponentTraits<T>::serialName != nullptr;
+
+// ---------------------------------------------------------------------------
+// Changed<T> — query filter: View<Changed<T>, Us...> visits only entities
+// whose T was marked changed in the current Registry tick.  T is still
+// passed to the callback as T&.
+// ---------------------------------------------------------------------------
+template<typename T>
+struct Changed {
+    using Component = T;
+};
+
+namespace detail {
+
+template<typename T>
+struct QueryTerm {
+    using Component = T;
+    static constexpr bool changed = false;
+};
+
+template<typename T>
+struct QueryTerm<Changed<T>> {
+    using Component = T;
+    static constexpr bool changed = true;
+};
+
+// First Changed<> term's component type among Ts (void if none).
+template<typename... Ts>
+struct FirstChanged { using type = void; };
+
+template<typename T, typename... Rest>
+struct FirstChanged<T, Rest...> {
+    using type = std::conditional_t<QueryTerm<T>::changed,
+                                    typename QueryTerm<T>::Component,
+                                    typename FirstChanged<Rest...>::type>;
+};
+
+} // namespace detail
+
+// Component type named by a query term (strips Changed<>).
+template<typename T>
+using QueryComponent = typename detail::QueryTerm<T>::Component;
+
+} // namespace Hotones::ECS
@@ -2,11 +2,16 @@
 
 #include <raylib.h>
 #include <raymath.h>
+#include <Assets/AssetCache.hpp>
+#include <ECS/ComponentTraits.hpp>
+#include <ECS/Registry.hpp>
+#include <memory>
 #include <string>
 #include <cstdint>
+#include <type_traits>
 
 // Forward-declare the heavy Player class so this header stays light.
-namespace Hotones { class Player; }
+namespace Hotones { class Player; struct ImportedScene; }
 
 // ---------------------------------------------------------------------------
 // Components.hpp — built-in ECS components for the Hotones engine.
@@ -15,8 +20,8 @@ namespace Hotones { class Player; }
 // so they can live directly in the dense component arrays without indirection.
 //
 // Add new game-specific components freely in your own headers; you do NOT
-// need to register them anywhere — the Registry discovers them at first use
-// via std::type_index.
+// need to register them anywhere — the Registry assigns each type a dense
+// ComponentTypeId at first use.
 // ---------------------------------------------------------------------------
 
 namespace Hotones::ECS {
@@ -40,40 +45,222 @@ struct TransformComponent {
     }
 };
 
+/// Reference to a TransformComponent stored in the Registry.  The pool keeps
+/// position, rotation and scale in separate arrays (see the traits below), so
+/// GetComponent / View hand out this proxy instead of TransformComponent&.
+/// Its fields are references into those arrays and read / write exactly like
+/// the component's; assigning a TransformComponent writes all three through.
+template<bool Const>
+struct BasicTransformRef {
+    template<typename U>
+    using Field = std::conditional_t<Const, const U, U>;
+
+    Field<Vector3>&    position;
+    Field<Quaternion>& rotation;
+    Field<Vector3>&    scale;
+
+    BasicTransformRef(Field<Vector3>& p, Field<Quaternion>& r, Field<Vector3>& s)
+        : position(p), rotation(r), scale(s) {}
+    // Copies refer to the same component; assignment (below) writes through
+    BasicTransformRef(const BasicTransformRef&) = default;
+
+    BasicTransformRef& operator=(const TransformComponent& t) requires (!Const) {
+        position = t.position;
+        rotation = t.rotation;
+        scale    = t.scale;
+        return *this;
+    }
+    BasicTransformRef& operator=(const BasicTransformRef& o) requires (!Const) {
+        return *this = TransformComponent(o);
+    }
+
+    operator TransformComponent() const { return { position, rotation, scale }; }
+
+    [[nodiscard]] Matrix ToMatrix() const { return TransformComponent(*this).ToMatrix(); }
+};
+
+using TransformRef      = BasicTransformRef<false>;
+using ConstTransformRef = BasicTransformRef<true>;
+
+/// Transform writes are change-tracked so replication and render upload can
+/// query View<Changed<TransformComponent>> instead of scanning every entity.
+/// Write through Registry::GetMut, or call MarkChanged after writing.
+///
+/// Movement only touches position, so the pool is stored SoA: integration
+/// kernels stream through OwningGroup::Field<&TransformComponent::position>()
+/// instead of loading rotation and scale alongside it.
+template<> struct ComponentTraits<TransformComponent> : DefaultComponentTraits {
+    static constexpr bool        trackChanges = true;
+    static constexpr bool        replicate    = true;
+    static constexpr const char* serialName   = "Transform";
+
+    using soaLayout = SoaLayout<&TransformComponent::position,
+                                &TransformComponent::rotation,
+                                &TransformComponent::scale>;
+    using Ref       = TransformRef;
+    using ConstRef  = ConstTransformRef;
+};
+
 /// Linear and angular velocity (units per second).
 struct VelocityComponent {
     Vector3 linear  = { 0.0f, 0.0f, 0.0f };
     Vector3 angular = { 0.0f, 0.0f, 0.0f }; // Euler rates, radians/s
 };
 
-/// Sphere collider — wraps a handle to the PhysicsSystem static mesh.
-/// Attach a TransformComponent on the same entity; the physics system reads
-/// and writes back TransformComponent::position after collision resolution.
+/// Reference to a VelocityComponent in the Registry (SoA, like Transform).
+template<bool Const>
+struct BasicVelocityRef {
+    template<typename U>
+    using Field = std::conditional_t<Const, const U, U>;
+
+    Field<Vector3>& linear;
+    Field<Vector3>& angular;
+
+    BasicVelocityRef(Field<Vector3>& l, Field<Vector3>& a) : linear(l), angular(a) {}
+    BasicVelocityRef(const BasicVelocityRef&) = default;
+
+    BasicVelocityRef& operator=(const VelocityComponent& v) requires (!Const) {
+        linear  = v.linear;
+        angular = v.angular;
+        return *this;
+    }
+    BasicVelocityRef& operator=(const BasicVelocityRef& o) requires (!Const) {
+        return *this = VelocityComponent(o);
+    }
+
+    operator VelocityComponent() const { return { linear, angular }; }
+};
+
+using VelocityRef      = BasicVelocityRef<false>;
+using ConstVelocityRef = BasicVelocityRef<true>;
+
+/// Stored SoA so MovementSystem integrates the packed linear array straight
+/// into the packed Transform position array.  Replicated, so clients carry
+/// moving entities forward between updates.
+template<> struct ComponentTraits<VelocityComponent> : DefaultComponentTraits {
+    static constexpr const char* serialName = "Velocity";
+    static constexpr bool        replicate  = true;
+
+    using soaLayout = SoaLayout<&VelocityComponent::linear, &VelocityComponent::angular>;
+    using Ref       = VelocityRef;
+    using ConstRef  = ConstVelocityRef;
+};
+
+/// Attaches an entity to another: HierarchySystem (BuiltinSystems.hpp) then
+/// derives its TransformComponent from the parent's and its own
+/// LocalTransformComponent every tick, so weapons, riders and doors follow
+/// what carries them.  Both components are needed; write the child's
+/// LocalTransformComponent rather than its TransformComponent, which is
+/// overwritten.  A child whose parent is gone keeps its last world transform.
+struct ParentComponent {
+    EntityId parent = INVALID_ENTITY;
+};
+
+/// Tracked, so re-parenting is noticed without scanning.  Not replicated:
+/// entity ids differ between server and clients.
+template<> struct ComponentTraits<ParentComponent> : DefaultComponentTraits {
+    static constexpr bool        trackChanges = true;
+    static constexpr const char* serialName   = "Parent";
+};
+
+/// Position, orientation and scale relative to the ParentComponent's
+/// entity (the same fields as TransformComponent, in the parent's space).
+struct LocalTransformComponent {
+    Vector3    position = { 0.0f, 0.0f, 0.0f };
+    Quaternion rotation = { 0.0f, 0.0f, 0.0f, 1.0f };
+    Vector3    scale    = { 1.0f, 1.0f, 1.0f };
+};
+
+/// Tracked, so HierarchySystem recomputes only the children that moved
+/// (and their subtrees).  Write through Registry::GetMut.
+template<> struct ComponentTraits<LocalTransformComponent> : DefaultComponentTraits {
+    static constexpr bool        trackChanges = true;
+    static constexpr const char* serialName   = "LocalTransform";
+};
+
+/// `local` in `parent`'s space, as a world transform.  Scale is carried per
+/// axis without shear, as TransformComponent stores it: exact for uniform
+/// scales, an approximation under a rotated non-uniform one.
+[[nodiscard]] inline TransformComponent ComposeTransform(const TransformComponent& parent,
+                                                         const LocalTransformComponent& local) {
+    TransformComponent world;
+    const Vector3 scaled = Vector3Multiply(local.position, parent.scale);
+    world.position = Vector3Add(parent.position, Vector3RotateByQuaternion(scaled, parent.rotation));
+    world.rotation = QuaternionNormalize(QuaternionMultiply(parent.rotation, local.rotation));
+    world.scale    = Vector3Multiply(parent.scale, local.scale);
+    return world;
+}
+
+/// The inverse: the LocalTransformComponent that puts a child at `world`
+/// under `parent` (used to re-parent without moving it).
+[[nodiscard]] inline LocalTransformComponent RelativeTransform(const TransformComponent& parent,
+                                                               const TransformComponent& world) {
+    auto safeDiv = [](float a, float b) { return b != 0.0f ? a / b : 0.0f; };
+    const Quaternion inv = QuaternionInvert(parent.rotation);
+    const Vector3 offset = Vector3RotateByQuaternion(Vector3Subtract(world.position, parent.position), inv);
+    LocalTransformComponent local;
+    local.position = { safeDiv(offset.x, parent.scale.x), safeDiv(offset.y, parent.scale.y),
+                       safeDiv(offset.z, parent.scale.z) };
+    local.rotation = QuaternionNormalize(QuaternionMultiply(inv, world.rotation));
+    local.scale    = { safeDiv(world.scale.x, parent.scale.x), safeDiv(world.scale.y, parent.scale.y),
+                       safeDiv(world.scale.z, parent.scale.z) };
+    return local;
+}
+
+/// Sphere collider against the static meshes registered with Physics.
+/// Attach TransformComponent and VelocityComponent on the same entity; the
+/// ECS PhysicsSystem (BuiltinSystems.hpp) reads and writes back
+/// TransformComponent::position after collision resolution.
 struct ColliderSphereComponent {
-    float   radius        = 0.5f;
-    int     physicsHandle = -1;   // handle returned by PhysicsSystem::RegisterStaticMeshFromModel
-    bool    isTrigger     = false; // if true, report overlaps but don't resolve
-    bool    isStatic      = false; // if true, the physics system won't move it
+    float    radius        = 0.5f;
+    int      physicsHandle = -1;   // collide only with this mesh (from RegisterStaticMeshFromModel); -1 = all
+    uint32_t collisionMask = 0xFFFFFFFFu; // Physics::LayerMask of the triangles it collides with
+    bool     isTrigger     = false; // if true, report overlaps but don't resolve
+    bool     isStatic      = false; // if true, the physics system won't move it
+};
+
+/// Stable storage: the physics bridge may keep a ColliderSphereComponent*
+/// across frames; it stays valid until the component is removed.
+template<> struct ComponentTraits<ColliderSphereComponent> : DefaultComponentTraits {
+    static constexpr bool stableStorage = true;
 };
 
 // ---- Rendering ------------------------------------------------------------
 
-/// Holds a loaded raylib Model handle and render parameters.
+/// Holds a shared model handle and render parameters.
 ///
 /// Ownership
 /// ---------
-///   If ownsModel is true the entity "owns" the GPU resources; you are
-///   responsible for calling UnloadModel on the model when the entity is
-///   destroyed (e.g. in a LifetimeSystem or explicit cleanup).
-///   If ownsModel is false the model is shared / managed elsewhere.
+///   The model comes from Assets::AssetCache (LoadModel); every entity
+///   showing the same file holds the same handle, and the model is unloaded
+///   once none does (and the cache has evicted it).  Nothing to clean up.
 struct RenderModelComponent {
-    Model model    = {};
-    Color tint     = WHITE;
-    bool  visible  = true;
-    bool  ownsModel = false; // set true if this component loaded the model
+    Assets::ModelHandle model;            // null draws nothing
+    Color               tint    = WHITE;
+    bool                visible = true;
 };
 
-/// Billboarded sprite drawn with DrawBillboard (for particles, icons, etc.).
+/// An animated character: the skinned meshes of an imported scene, posed
+/// by one of its clips and drawn at the entity's TransformComponent.
+///
+/// GFX::AnimationSystem advances `time` by `speed` each tick (wrapping when
+/// `loop`, else holding the last frame) and re-poses the skeleton on an
+/// interval that grows with distance from the camera, dropping the
+/// smallest bones far away (see SceneSkin::lodBones).  The rig is shared:
+/// load it once (SceneImporter::Share) for every entity showing it.
+struct SkinnedModelComponent {
+    std::shared_ptr<const Hotones::ImportedScene> rig;   // null draws nothing
+    int   clip    = 0;       // into rig->animations; out of range → bind pose
+    float time    = 0.0f;    // seconds into the clip
+    float speed   = 1.0f;
+    bool  loop    = true;
+    Color tint    = WHITE;
+    bool  visible = true;
+};
+
+/// Billboarded sprite drawn with DrawBillboard (icons, markers, etc.).
+/// For effects made of many sprites use ParticleEmitterComponent instead of
+/// one entity per sprite.
 struct BillboardComponent {
     Texture2D texture  = {};
     Color     tint     = WHITE;
@@ -81,6 +268,35 @@ struct BillboardComponent {
     bool      visible  = true;
 };
 
+/// Spawns camera-facing particles from the entity's TransformComponent.
+/// GFX::ParticleSystem keeps the particles themselves (not entities) and
+/// draws every emitter sharing a texture as one batch.
+///
+/// Each particle leaves along `direction`, within `spread` radians of it,
+/// at `speed` (± speedJitter), lives `lifetime` (± lifetimeJitter) seconds
+/// under `gravity`, and fades from startColor / startSize to endColor /
+/// endSize over its life.  `burst` particles are added on the next tick,
+/// then cleared; `rate` more per second while `emitting`.
+struct ParticleEmitterComponent {
+    Assets::TextureHandle texture;                 // null draws plain squares
+    float    rate           = 20.0f;               // particles per second while emitting
+    uint32_t burst          = 0;                   // one-off particles, spawned next tick
+    uint32_t maxParticles   = 1024;                // alive at once; spawns beyond are dropped
+    float    lifetime       = 1.0f;                // seconds
+    float    lifetimeJitter = 0.0f;
+    Vector3  direction      = { 0.0f, 1.0f, 0.0f };
+    float    spread         = 0.5f;                // cone half-angle, radians
+    float    speed          = 2.0f;
+    float    speedJitter    = 0.0f;
+    Vector3  gravity        = { 0.0f, -9.8f, 0.0f };
+    float    startSize      = 0.25f;
+    float    endSize        = 0.0f;
+    Color    startColor     = WHITE;
+    Color    endColor       = { 255, 255, 255, 0 };
+    bool     additive       = false;               // add light instead of alpha-blending
+    bool     emitting       = true;
+};
+
 // ---- Identity / tagging ---------------------------------------------------
 
 /// Human-readable name for the entity (useful for debug UIs / Lua lookups).
@@ -118,16 +334,20 @@ struct LifetimeComponent {
 // ---- Networking -----------------------------------------------------------
 
 /// Marks an entity as a network-replicated peer (player or object).
+/// On a server, entities carrying one are mirrored to every client along
+/// with their replicated components (ECS/Replication.hpp).
 struct NetworkComponent {
-    uint8_t peerId  = 0;
-    bool    isLocal = false; // true for the locally controlled entity
+    uint8_t  peerId  = 0;
+    bool     isLocal = false; // true for the locally controlled entity
+    uint16_t netId   = 0;     // replication id, assigned by EntityReplicator (0 = none yet)
 };
 
 // ---- Audio ----------------------------------------------------------------
 
 /// Point-source audio emitter attached to an entity's world position.
-/// An AudioSystem should read TransformComponent::position each frame to
-/// update the 3-D source position via AudioSystem / SoundBus.
+/// Ho_tones::SpatialAudioSystem (SFX/SpatialAudioSystem.hpp) plays it from
+/// TransformComponent::position each tick, attenuated, panned and
+/// doppler-shifted for the listener.
 struct AudioEmitterComponent {
     std::string soundKey;             // key registered with SoundBus::LoadSoundFile
     float       volume    = 1.0f;
@@ -143,12 +363,14 @@ struct AudioEmitterComponent {
 /// Lua-driven behaviour — stores the name of the Lua class that drives this
 /// entity and an integer reference into the Lua registry (LUA_NOREF = -1).
 ///
-/// The CupLoader / script system is responsible for calling the Lua methods
-/// on this component each frame.
+/// Scripting::ScriptSystem calls the class's update(self, dt) on the
+/// referenced object each tick while `active` (bound with ecs.setScript).
 struct ScriptComponent {
     std::string className;      // e.g. "Enemies.Grunt"
     int         luaRef  = -1;   // lua_ref into the Lua registry (LUA_NOREF = -1)
     bool        active  = true;
+    uint32_t    luaState  = 0;      // LuaLoader::ecsStateStamp() of the state luaRef is in
+    float       skippedDt = 0.0f;   // time not yet passed to update() while throttled
 };
 
 // ---- Player controller ----------------------------------------------------
@@ -169,4 +391,78 @@ struct PlayerComponent {
     float jumpMultiplier    = 1.0f;    ///< scales JUMP_FORCE (1.0 = default)
 };
 
+// ---- Snapshot serialization -----------------------------------------------
+//
+// serialName keys for Registry::Serialize (Transform and Velocity carry
+// theirs with their traits above).  Plain-data components are saved as raw
+// arrays; the string-holding ones below get a field-wise Save / Load.
+// Components holding runtime handles (Player*, GPU models / textures,
+// physics handles, network peer ids) are deliberately not saved.
+
+template<> struct ComponentTraits<GroupComponent> : DefaultComponentTraits {
+    static constexpr const char* serialName = "Group";
+    static constexpr bool        replicate  = true;
+};
+template<> struct ComponentTraits<HealthComponent> : DefaultComponentTraits {
+    static constexpr const char* serialName = "Health";
+    static constexpr bool        replicate  = true;
+};
+template<> struct ComponentTraits<LifetimeComponent> : DefaultComponentTraits {
+    static constexpr const char* serialName = "Lifetime";
+};
+
+template<> struct ComponentTraits<TagComponent> : DefaultComponentTraits {
+    static constexpr const char* serialName = "Tag";
+    static void Save(ArchiveWriter& w, const TagComponent& c) { w.String(c.name); }
+    static bool Load(ArchiveReader& r, TagComponent& c)       { return r.String(c.name); }
+};
+
+/// Also stable storage, so the audio bridge can cache emitter pointers.
+template<> struct ComponentTraits<AudioEmitterComponent> : DefaultComponentTraits {
+    static constexpr const char* serialName    = "AudioEmitter";
+    static constexpr bool        stableStorage = true;
+    static void Save(ArchiveWriter& w, const AudioEmitterComponent& c) {
+        w.String(c.soundKey);
+        w.Pod(c.volume); w.Pod(c.pitch); w.Pod(c.maxDist);
+        w.Pod(c.loop);   w.Pod(c.playing); w.Pod(c.autoPlay);
+    }
+    static bool Load(ArchiveReader& r, AudioEmitterComponent& c) {
+        return r.String(c.soundKey)
+            && r.Pod(c.volume) && r.Pod(c.pitch) && r.Pod(c.maxDist)
+            && r.Pod(c.loop)   && r.Pod(c.playing) && r.Pod(c.autoPlay);
+    }
+};
+
+/// The Lua registry reference is process-local, so it is not saved; a
+/// restored ScriptComponent comes back with luaRef = -1 and must be rebound.
+template<> struct ComponentTraits<ScriptComponent> : DefaultComponentTraits {
+    static constexpr const char* serialName = "Script";
+    static void Save(ArchiveWriter& w, const ScriptComponent& c) {
+        w.String(c.className);
+        w.Pod(c.active);
+    }
+    static bool Load(ArchiveReader& r, ScriptComponent& c) {
+        c.luaRef = -1;
+        return r.String(c.className) && r.Pod(c.active);
+    }
+};
+
+namespace detail {
+// Registers the built-in serializable components at static-init time.
+inline const bool g_builtinComponentsRegistered = [] {
+    auto& types = SerializableComponents::Get();
+    types.Register<TransformComponent>();
+    types.Register<VelocityComponent>();
+    types.Register<ParentComponent>();
+    types.Register<LocalTransformComponent>();
+    types.Register<GroupComponent>();
+    types.Register<HealthComponent>();
+    types.Register<LifetimeComponent>();
+    types.Register<TagComponent>();
+    types.Register<AudioEmitterComponent>();
+    types.Register<ScriptComponent>();
+    return true;
+}();
+} // namespace detail
+
 } // namespace Hotones::ECS
@@ -12,11 +12,29 @@
 // Overview
 // --------
 //
-//   Entity        — uint32_t handle (index + generation)
+//   Entity        — uint32_t handle (index + generation); uint64_t with
+//                   HOTONES_WIDE_ENTITY_IDS
+//   ComponentType — dense per-type integer id used to index pool tables
 //   ComponentPool — sparse-set per-component storage  O(1) add/remove/get
 //   Registry      — owns all pools; entity + component lifecycle + queries
-//   System        — virtual base class for per-frame logic
-//   Components    — built-in engine component structs
+//   OwningGroup   — Registry::Group<Ts...>(): pools kept sorted so hot
+//                   component pairs iterate as packed parallel arrays
+//   ArchetypeRegistry — optional archetype/SoA-table backend with the same
+//                   API; faster wide queries, slower structural changes
+//   CommandBuffer — deferred create / destroy / add / remove, flushed in one batch
+//   ComponentTraits — per-type storage options (trackChanges → Changed<T>
+//                   views, serialName → Registry::Serialize snapshots,
+//                   soaLayout → one array per field, Transform uses it,
+//                   stableStorage → chunked, pointer-stable components)
+//   System        — virtual base class for per-frame logic; declares its
+//                   component reads / writes through SystemAccess
+//   SystemScheduler — runs Systems in dependency-ordered parallel stages
+//   SpatialIndex  — spatial hash over transforms, kept current from change
+//                   tracking; QueryRadius / QueryAABB proximity queries
+//   Components    — built-in engine component structs; ParentComponent +
+//                   LocalTransformComponent attach one entity to another
+//   HierarchySystem — derives children's world transforms from their
+//                   parents', by depth level, only for subtrees that moved
 //
 // Quick-start
 // -----------
@@ -32,7 +50,7 @@
 //
 //   // 3. Query from a System::Update (or inline in Scene::Update)
 //   reg.View<TransformComponent, VelocityComponent>(
-//       [dt](EntityId id, TransformComponent& t, VelocityComponent& v) {
+//       [dt](EntityId id, TransformRef t, VelocityRef v) {
 //           t.position = Vector3Add(t.position, Vector3Scale(v.linear, dt));
 //       });
 //
@@ -42,7 +60,17 @@
 // ---------------------------------------------------------------------------
 
 #include <ECS/Entity.hpp>
+#include <ECS/TypeId.hpp>
+#include <ECS/Archive.hpp>
+#include <ECS/ComponentTraits.hpp>
+#include <ECS/ComponentStorage.hpp>
 #include <ECS/ComponentPool.hpp>
+#include <ECS/Group.hpp>
 #include <ECS/Registry.hpp>
+#include <ECS/Archetype.hpp>
+#include <ECS/CommandBuffer.hpp>
 #include <ECS/System.hpp>
+#include <ECS/SystemScheduler.hpp>
+#include <ECS/BuiltinSystems.hpp>
+#include <ECS/SpatialIndex.hpp>
 #include <ECS/Components.hpp>
@@ -3,41 +3,72 @@
 #include <cstdint>
 #include <limits>
 
-namespace Hotones::ECS {
-
 // ---------------------------------------------------------------------------
-// EntityId — a 32-bit handle that packs an index and a generation counter.
+// EntityId — a handle that packs an index and a generation counter.
 //
+// Default (32-bit):
 //   bits  0-19  (20 bits)  →  entity index  (up to 1,048,576 live entities)
 //   bits 20-31  (12 bits)  →  generation    (wraps at 4,096 recycles/slot)
 //
+// Built with -DHOTONES_WIDE_ENTITY_IDS=1 (64-bit), for very large worlds or
+// heavy churn (projectiles recycling the same slots every few frames):
+//   bits  0-31  (32 bits)  →  entity index  (pools index with uint32_t too)
+//   bits 32-63  (32 bits)  →  generation    (wraps at ~4.3 billion recycles)
+//
 // When a slot is recycled the generation is bumped, so old EntityIds become
-// stale and IsAlive() returns false — no use-after-free bugs.
+// stale and IsAlive() returns false — no use-after-free bugs.  Once a slot's
+// generation wraps, a handle that old would match again; the wide layout
+// makes that practically unreachable.
+//
+// Lua sees either kind as an integer (Lua 5.4 integers are 64-bit; a wide
+// id with the top generation bit set reads as negative, and still round-
+// trips).  Registry snapshots record the width and refuse the other one.
 // ---------------------------------------------------------------------------
 
+#ifndef HOTONES_WIDE_ENTITY_IDS
+#define HOTONES_WIDE_ENTITY_IDS 0
+#endif
+
+namespace Hotones::ECS {
+
+#if HOTONES_WIDE_ENTITY_IDS
+using EntityId = uint64_t;
+
+inline constexpr uint32_t INDEX_BITS = 32u;
+inline constexpr uint32_t GEN_BITS   = 32u;
+#else
 using EntityId = uint32_t;
 
 inline constexpr uint32_t INDEX_BITS = 20u;
 inline constexpr uint32_t GEN_BITS   = 12u;
-inline constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1u;
-inline constexpr uint32_t GEN_MASK   = ((1u << GEN_BITS)  - 1u);
+#endif
+
+static_assert(INDEX_BITS + GEN_BITS == sizeof(EntityId) * 8, "EntityId bits must add up");
+
+inline constexpr uint32_t INDEX_MASK = static_cast<uint32_t>((uint64_t(1) << INDEX_BITS) - 1u);
+inline constexpr uint32_t GEN_MASK   = static_cast<uint32_t>((uint64_t(1) << GEN_BITS)   - 1u);
 
 // Sentinel value representing a null / invalid entity.
 inline constexpr EntityId INVALID_ENTITY = std::numeric_limits<EntityId>::max();
 
 // Extract the raw index from an EntityId.
 [[nodiscard]] inline constexpr uint32_t EntityIndex(EntityId id) noexcept {
-    return id & INDEX_MASK;
+    return static_cast<uint32_t>(id & INDEX_MASK);
 }
 
 // Extract the generation counter from an EntityId.
 [[nodiscard]] inline constexpr uint32_t EntityGeneration(EntityId id) noexcept {
-    return (id >> INDEX_BITS) & GEN_MASK;
+    return static_cast<uint32_t>((id >> INDEX_BITS) & GEN_MASK);
 }
 
 // Compose an EntityId from a raw index and a generation counter.
 [[nodiscard]] inline constexpr EntityId MakeEntity(uint32_t idx, uint32_t gen) noexcept {
-    return ((gen & GEN_MASK) << INDEX_BITS) | (idx & INDEX_MASK);
+    return (static_cast<EntityId>(gen & GEN_MASK) << INDEX_BITS) | (idx & INDEX_MASK);
+}
+
+// The generation a slot takes when its entity is destroyed (wraps at GEN_MASK)
+[[nodiscard]] inline constexpr uint32_t NextGeneration(uint32_t gen) noexcept {
+    return (gen + 1u) & GEN_MASK;
 }
 
 } // namespace Hotones::ECS
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <ECS/Entity.hpp>
+#include <ECS/ComponentPool.hpp>
+#include <ECS/TypeId.hpp>
+#include <Jobs/JobSystem.hpp>
+
+#include <cassert>
+#include <tuple>
+#include <vector>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// GroupData — bookkeeping for one owning group (kept by the Registry).
+//
+// Every pool in `pools` keeps the entities that own ALL of the group's
+// component types packed in dense slots [0, size), in the same order.
+// ---------------------------------------------------------------------------
+struct GroupData {
+    ComponentMask       mask = 0;
+    std::vector<IPool*> pools;
+    size_t              size = 0;
+};
+
+// ---------------------------------------------------------------------------
+// OwningGroup<Ts...> — handle to an owning group, from Registry::Group<Ts...>().
+//
+// Because the owned pools are kept sorted, slot i of every Ts array belongs
+// to the same entity, so iteration is a plain parallel-array walk with no
+// sparse lookups and no membership tests:
+//
+//   auto movers = reg.Group<TransformComponent, VelocityComponent>();
+//   movers.Each([dt](EntityId, TransformRef t, VelocityRef v) {
+//       t.position = Vector3Add(t.position, Vector3Scale(v.linear, dt));
+//   });
+//
+//   // or raw: Data<T>()[i] for i in [0, Size()), and for SoA types
+//   // Field<&TransformComponent::position>()[i]
+//
+// The handle is cheap to copy and stays valid as entities join / leave the
+// group; it is invalidated by moving or destroying the Registry.  Adding or
+// removing an owned component re-sorts the pools, so the usual rule applies:
+// no structural changes to Ts during Each — use a CommandBuffer.
+// ---------------------------------------------------------------------------
+template<typename... Ts>
+class OwningGroup {
+public:
+    OwningGroup(GroupData& group, ComponentPool<Ts>&... pools,
+                const std::vector<uint32_t>& generations)
+        : m_group(&group), m_pools(&pools...), m_generations(&generations) {}
+
+    // Number of entities that own every Ts.
+    [[nodiscard]] size_t Size() const noexcept { return m_group->size; }
+
+    // Entity indices of the members, packed in [0, Size()).
+    [[nodiscard]] const uint32_t* EntityIndices() const {
+        return std::get<0>(m_pools)->EntityIndices().data();
+    }
+
+    // Dense T array of the members, packed in [0, Size()).  AoS types only.
+    template<typename T>
+    [[nodiscard]] T* Data() {
+        return std::get<ComponentPool<T>*>(m_pools)->Components().data();
+    }
+
+    // Dense array of one field of an SoA type, packed in [0, Size()):
+    // Field<&TransformComponent::position>() is a plain Vector3*.
+    template<auto Member>
+    [[nodiscard]] auto* Field() {
+        using C = typename detail::MemberPointer<Member>::Class;
+        return std::get<ComponentPool<C>*>(m_pools)->template Field<Member>();
+    }
+
+    // Calls fn(EntityId, ComponentRef<Ts>...) for every member.
+    template<typename Fn>
+    void Each(Fn&& fn) {
+        const size_t    n    = m_group->size;
+        const uint32_t* ents = EntityIndices();
+        std::tuple<typename ComponentPool<Ts>::Columns...> data{ std::get<ComponentPool<Ts>*>(m_pools)->Cols()... };
+        [[maybe_unused]] const uint32_t version = std::get<0>(m_pools)->Version();
+
+        for (size_t i = 0; i < n; ++i) {
+            assert(std::get<0>(m_pools)->Version() == version
+                   && "OwningGroup::Each — group was modified during iteration; use a CommandBuffer");
+            const uint32_t idx = ents[i];
+            fn(MakeEntity(idx, (*m_generations)[idx]), std::get<typename ComponentPool<Ts>::Columns>(data)[i]...);
+        }
+    }
+
+    // Each() split across the shared JobSystem; same contract as
+    // Registry::ParallelView.
+    template<typename Fn>
+    void ParallelEach(Fn&& fn, size_t grainSize = 1024) {
+        const uint32_t* ents = EntityIndices();
+        std::tuple<typename ComponentPool<Ts>::Columns...> data{ std::get<ComponentPool<Ts>*>(m_pools)->Cols()... };
+        const std::vector<uint32_t>& gens = *m_generations;
+
+        Jobs::JobSystem::Get().ParallelFor(m_group->size, grainSize,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    const uint32_t idx = ents[i];
+                    fn(MakeEntity(idx, gens[idx]), std::get<typename ComponentPool<Ts>::Columns>(data)[i]...);
+                }
+            });
+    }
+
+private:
+    GroupData*                        m_group;
+    std::tuple<ComponentPool<Ts>*...> m_pools;
+    const std::vector<uint32_t>*      m_generations;
+};
+
+} // namespace Hotones::ECS
@@ -2,12 +2,18 @@
 
 #include <ECS/Entity.hpp>
 #include <ECS/ComponentPool.hpp>
+#include <ECS/Group.hpp>
+#include <ECS/Archive.hpp>
+#include <ECS/TypeId.hpp>
+#include <Jobs/JobSystem.hpp>
 
-#include <typeindex>
-#include <typeinfo>
-#include <unordered_map>
+#include <bit>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
+#include <tuple>
 #include <queue>
 #include <algorithm>
 #include <cassert>
@@ -24,6 +30,9 @@ namespace Hotones::ECS {
 //                        RemoveComponent / GetOrAdd
 //  • Querying          : View<Ts...>  iterate entities with ALL of Ts
 //                        Each<T>      iterate every entity with a single T
+//                        ParallelView / ParallelEach  — same, on the JobSystem
+//                        Group<Ts...> owning group: pools kept sorted so
+//                                     members are a packed parallel array
 //
 // Usage example
 // -------------
@@ -34,23 +43,65 @@ namespace Hotones::ECS {
 //   reg.AddComponent<VelocityComponent>(e);
 //
 //   reg.View<TransformComponent, VelocityComponent>(
-//       [](EntityId id, TransformComponent& t, VelocityComponent& v) {
+//       [](EntityId id, TransformRef t, VelocityRef v) {
 //           t.position = Vector3Add(t.position, v.linear);
 //       });
 //
 // Thread safety
 // -------------
 //   The Registry is NOT thread-safe. Wrap external access in a mutex if you
-//   call it from multiple threads.
+//   call it from multiple threads.  ParallelView / ParallelEach are the one
+//   exception: they fan a query out over the JobSystem under a strict
+//   "touch only your own components" contract (see below).
 //
 // Mutation during View / Each
 // ---------------------------
 //   AddComponent / RemoveComponent / DestroyEntity inside a View callback
 //   for one of the iterated component types is NOT safe and may cause missed
-//   or double-processed entities. Defer such mutations with a command queue
-//   and flush them after the view completes.
+//   or double-processed entities. Record such mutations into an
+//   ECS::CommandBuffer (<ECS/CommandBuffer.hpp>) and Flush it after the view
+//   completes.
 // ---------------------------------------------------------------------------
 
+class Registry;
+
+// ---------------------------------------------------------------------------
+// SerializableComponents — process-wide name → type table used by
+// Registry::Deserialize to find the pool for an archived section.
+//
+// Call Register<T>() once per serializable component type (one whose
+// ComponentTraits<T>::serialName is set) before loading an archive.  The
+// built-in components in Components.hpp register themselves.
+// ---------------------------------------------------------------------------
+struct SerializableComponent {
+    const char*      name = nullptr;
+    ComponentTypeId  id   = 0;
+    IPool&         (*ensure)(Registry&) = nullptr; // creates the pool if needed
+};
+
+class SerializableComponents {
+public:
+    static SerializableComponents& Get() {
+        static SerializableComponents s_instance;
+        return s_instance;
+    }
+
+    // Idempotent.  Returns true so it can initialise a static.
+    template<typename T>
+    bool Register();
+
+    [[nodiscard]] const SerializableComponent* Find(const std::string& name) const {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        for (const auto& e : m_types)
+            if (name == e.name) return &e;
+        return nullptr;
+    }
+
+private:
+    mutable std::mutex                 m_mutex;
+    std::deque<SerializableComponent>  m_types; // deque: Find() pointers stay valid
+};
+
 class Registry {
 public:
     Registry()  = default;
@@ -75,25 +126,34 @@ public:
         } else {
             idx = static_cast<uint32_t>(m_generations.size());
             m_generations.push_back(0u);
+            m_alivePos.push_back(0u);
+            m_signatures.push_back(0u);
         }
         const EntityId id = MakeEntity(idx, m_generations[idx]);
+        m_alivePos[idx] = static_cast<uint32_t>(m_alive.size());
         m_alive.push_back(id);
         return id;
     }
 
     // Destroy an entity: removes all its components and invalidates the id.
+    // O(number of components the entity owns).
     void DestroyEntity(EntityId id) {
         if (!IsAlive(id)) return;
         const uint32_t idx = EntityIndex(id);
-        // Strip every component pool
-        for (auto& [ti, pool] : m_pools)
-            pool->Remove(idx);
+        if (m_ownedMask & m_signatures[idx]) LeaveGroups(idx, m_signatures[idx]);
+        // Strip only the pools named in the entity's signature
+        for (ComponentMask sig = m_signatures[idx]; sig; sig &= sig - 1)
+            m_pools[std::countr_zero(sig)]->Remove(idx);
+        m_signatures[idx] = 0u;
         // Bump generation so the old EntityId becomes stale
-        ++m_generations[idx];
+        m_generations[idx] = NextGeneration(m_generations[idx]);
         m_freeList.push(idx);
-        // Remove from alive list
-        auto it = std::find(m_alive.begin(), m_alive.end(), id);
-        if (it != m_alive.end()) m_alive.erase(it);
+        // Swap-and-pop out of the alive list
+        const uint32_t pos  = m_alivePos[idx];
+        const EntityId last = m_alive.back();
+        m_alive[pos] = last;
+        m_alivePos[EntityIndex(last)] = pos;
+        m_alive.pop_back();
     }
 
     // Returns true if the entity has not been destroyed (generation matches).
@@ -110,12 +170,22 @@ public:
 
     [[nodiscard]] size_t EntityCount() const noexcept { return m_alive.size(); }
 
+    // Current EntityId of a live entity index, e.g. one read from a pool's
+    // EntityIndices() inside a system.
+    [[nodiscard]] EntityId EntityAt(uint32_t idx) const {
+        assert(idx < m_generations.size() && "Registry::EntityAt — index out of range");
+        return MakeEntity(idx, m_generations[idx]);
+    }
+
     // Destroy every entity and clear every component pool.
     void Clear() {
         m_alive.clear();
+        m_alivePos.clear();
         m_generations.clear();
+        m_signatures.clear();
         while (!m_freeList.empty()) m_freeList.pop();
-        for (auto& [ti, pool] : m_pools) pool->Clear();
+        for (auto& pool : m_pools) if (pool) pool->Clear();
+        for (auto& group : m_groups) group->size = 0;
     }
 
     // -----------------------------------------------------------------------
@@ -125,46 +195,98 @@ public:
     // Construct a T in-place on entity id from args.
     // Asserts the entity is alive and does not already own a T.
     template<typename T, typename... Args>
-    T& AddComponent(EntityId id, Args&&... args) {
+    ComponentRef<T> AddComponent(EntityId id, Args&&... args) {
         assert(IsAlive(id) && "Registry::AddComponent — entity is not alive");
-        return Pool<T>().Emplace(EntityIndex(id), std::forward<Args>(args)...);
+        const uint32_t idx = EntityIndex(id);
+        auto& pool = Pool<T>();
+        pool.Emplace(idx, std::forward<Args>(args)...);
+        pool.MarkChanged(idx, m_tick); // an added component counts as changed
+        const ComponentMask bit = ComponentBit(ComponentType<T>());
+        m_signatures[idx] |= bit;
+        if (m_ownedMask & bit) EnterGroups(idx, bit);
+        return pool.Get(idx);
     }
 
     // Returns true if entity id owns a component of type T.
     template<typename T>
     [[nodiscard]] bool HasComponent(EntityId id) const {
-        const auto* p = PoolPtr<T>();
-        return p && p->Has(EntityIndex(id));
+        const uint32_t idx = EntityIndex(id);
+        return idx < m_signatures.size()
+            && (m_signatures[idx] & ComponentBit(ComponentType<T>())) != 0;
     }
 
-    // Returns a reference to the T owned by entity id.
+    // Returns a reference to the T owned by entity id (a
+    // ComponentTraits<T>::Ref proxy for SoA types — bind it with auto&&).
     // Asserts the entity is alive and owns a T.
     template<typename T>
-    [[nodiscard]] T& GetComponent(EntityId id) {
+    [[nodiscard]] ComponentRef<T> GetComponent(EntityId id) {
         assert(IsAlive(id)        && "Registry::GetComponent — entity is not alive");
         assert(HasComponent<T>(id) && "Registry::GetComponent — entity does not own component");
         return Pool<T>().Get(EntityIndex(id));
     }
     template<typename T>
-    [[nodiscard]] const T& GetComponent(EntityId id) const {
+    [[nodiscard]] ComponentConstRef<T> GetComponent(EntityId id) const {
         assert(IsAlive(id)        && "Registry::GetComponent — entity is not alive");
         assert(HasComponent<T>(id) && "Registry::GetComponent — entity does not own component");
         return PoolConst<T>().Get(EntityIndex(id));
     }
 
+    // Mutable access that also marks T changed this tick (see Change
+    // tracking below).  Identical to GetComponent for untracked types.
+    template<typename T>
+    [[nodiscard]] ComponentRef<T> GetMut(EntityId id) {
+        ComponentRef<T> c = GetComponent<T>(id);
+        Pool<T>().MarkChanged(EntityIndex(id), m_tick);
+        return c;
+    }
+
+    // Flag entity id's T as changed this tick (after writing it through
+    // GetComponent, a View callback or a raw pool array).
+    template<typename T>
+    void MarkChanged(EntityId id) {
+        assert(HasComponent<T>(id) && "Registry::MarkChanged — entity does not own component");
+        Pool<T>().MarkChanged(EntityIndex(id), m_tick);
+    }
+
     // Remove T from entity id (no-op if it doesn't own one).
     template<typename T>
     void RemoveComponent(EntityId id) {
-        if (auto* p = PoolPtr<T>()) p->Remove(EntityIndex(id));
+        const uint32_t idx = EntityIndex(id);
+        auto* p = PoolPtr<T>();
+        if (!p || !p->Has(idx)) return;
+        const ComponentMask bit = ComponentBit(ComponentType<T>());
+        if (m_ownedMask & bit) LeaveGroups(idx, bit);
+        p->Remove(idx);
+        m_signatures[idx] &= ~bit;
     }
 
     // If entity id already owns a T, return it; otherwise default-construct one.
     template<typename T>
-    T& GetOrAdd(EntityId id) {
+    ComponentRef<T> GetOrAdd(EntityId id) {
         if (!HasComponent<T>(id)) AddComponent<T>(id);
         return GetComponent<T>(id);
     }
 
+    // -----------------------------------------------------------------------
+    // Change tracking
+    // -----------------------------------------------------------------------
+    //
+    // Component types opted in with ComponentTraits<T>::trackChanges record
+    // which entities were written during the current tick: AddComponent,
+    // GetMut and MarkChanged mark them.  View<Changed<T>, Us...> then walks
+    // only those entities, so consumers (replication, render upload) scale
+    // with the number of changes instead of the entity count.
+    //
+    // Call AdvanceTick() once per frame, before anything writes components;
+    // it starts a new tick and forgets the previous tick's changes.
+
+    [[nodiscard]] uint32_t Tick() const noexcept { return m_tick; }
+
+    void AdvanceTick() {
+        if (++m_tick == 0) m_tick = 1; // 0 means "never changed"
+        for (IPool* pool : m_trackedPools) pool->ResetChanges();
+    }
+
     // -----------------------------------------------------------------------
     // Querying
     // -----------------------------------------------------------------------
@@ -172,79 +294,289 @@ public:
     // View<Ts...>(fn) — calls fn(EntityId, Ts&...) for every entity that
     // owns ALL of the listed component types.
     //
-    // The iteration order is determined by the smallest component pool.
-    // A snapshot of entity indices is taken before the loop starts, so
-    // adding entities during iteration is safe; removing the *iterated*
-    // component types mid-loop is NOT.
+    // The iteration order is determined by the smallest component pool,
+    // which is walked in place (no copy of its index list is made).  Each
+    // candidate is filtered with one AND / compare of its component
+    // signature against the query mask — no per-pool sparse lookups.
+    //   • Adding components / entities during iteration is safe; anything
+    //     appended after the view started is not visited.  (Exception:
+    //     adding a type owned by a Group reorders that pool — see Group.)
+    //   • Removing a component of the *driving* (smallest) pool mid-loop is
+    //     NOT safe: it reorders the array being walked.  Debug builds assert
+    //     on it via the pool's structural version.  Record removals in a
+    //     CommandBuffer instead.
+    //
+    // Wrapping a term in Changed<T> restricts the view to entities whose T
+    // changed this tick; the changed list of the first such T drives the
+    // loop instead of the smallest pool.
     template<typename... Ts, typename Fn>
     void View(Fn&& fn) {
         static_assert(sizeof...(Ts) > 0, "View requires at least one component type");
-
-        IPool* smallest = FindSmallestPool<Ts...>();
-        if (!smallest || smallest->Size() == 0) return;
-
-        // Snapshot the dense index list to avoid iterator invalidation.
-        const auto idxList = smallest->EntityIndices();
-
-        for (const uint32_t idx : idxList) {
-            if (!HasAllAt<Ts...>(idx)) continue;
-            // Rebuild the live EntityId for this slot.
-            if (idx >= m_generations.size()) continue;
-            const EntityId id = MakeEntity(idx, m_generations[idx]);
-            fn(id, Pool<Ts>().Get(idx)...);
+        if constexpr ((detail::QueryTerm<Ts>::changed || ...)) {
+            ViewChanged<Ts...>(std::forward<Fn>(fn));
+        } else {
+            ViewAll<Ts...>(std::forward<Fn>(fn));
         }
     }
 
     // Each<T>(fn) — calls fn(EntityId, T&) for every entity that owns T.
     // Slightly cheaper than View<T> because there is no intersection test.
+    // Same mutation rules as View.
     template<typename T, typename Fn>
     void Each(Fn&& fn) {
         auto* p = PoolPtr<T>();
         if (!p || p->Size() == 0) return;
-        const auto idxList = p->EntityIndices(); // snapshot
-        for (const uint32_t idx : idxList) {
-            if (idx >= m_generations.size()) continue;
-            const EntityId id = MakeEntity(idx, m_generations[idx]);
-            fn(id, p->Get(idx));
+        const std::vector<uint32_t>& idxList = p->EntityIndices();
+        const size_t count = idxList.size();
+        [[maybe_unused]] const uint32_t version = p->Version();
+
+        for (size_t i = 0; i < count && i < idxList.size(); ++i) {
+            assert(p->Version() == version
+                   && "Registry::Each — pool was modified during iteration; use a CommandBuffer");
+            const uint32_t idx = idxList[i];
+            fn(MakeEntity(idx, m_generations[idx]), p->Get(idx));
+        }
+    }
+
+    // ViewTypes(types, count, fn) — View over component types named at run
+    // time (script bindings): calls fn(EntityId) for every entity that owns
+    // all `count` types.  Same iteration order and mutation rules as View.
+    template<typename Fn>
+    void ViewTypes(const ComponentTypeId* types, size_t count, Fn&& fn) {
+        IPool*        smallest = nullptr;
+        ComponentMask mask     = 0;
+        for (size_t t = 0; t < count; ++t) {
+            IPool* p = types[t] < m_pools.size() ? m_pools[types[t]].get() : nullptr;
+            if (!p) return; // a missing pool means no entities match
+            if (!smallest || p->Size() < smallest->Size()) smallest = p;
+            mask |= ComponentBit(types[t]);
+        }
+        if (!smallest || smallest->Size() == 0) return;
+
+        const std::vector<uint32_t>& idxList = smallest->EntityIndices();
+        const size_t n = idxList.size();
+        [[maybe_unused]] const uint32_t version = smallest->Version();
+        for (size_t i = 0; i < n && i < idxList.size(); ++i) {
+            assert(smallest->Version() == version
+                   && "Registry::ViewTypes — driving pool was modified during iteration; use a CommandBuffer");
+            const uint32_t idx = idxList[i];
+            if ((m_signatures[idx] & mask) != mask) continue;
+            fn(MakeEntity(idx, m_generations[idx]));
         }
     }
 
+    // ParallelView<Ts...>(fn, grainSize) — View<Ts...> split across the
+    // shared Jobs::JobSystem.  The smallest pool's dense range is cut into
+    // chunks of at least grainSize entries; fn(EntityId, Ts&...) may run on
+    // any worker, in any order, concurrently with other chunks.
+    //
+    // Contract for fn:
+    //   • it may only read / write the components it is handed (and other
+    //     data it synchronises itself);
+    //   • it must NOT create / destroy entities or add / remove components —
+    //     the pools are iterated in place, without a snapshot.  Record such
+    //     changes into a CommandBuffer and Flush it after the call returns.
+    // Returns after every chunk has finished.
+    template<typename... Ts, typename Fn>
+    void ParallelView(Fn&& fn, size_t grainSize = 1024) {
+        static_assert(sizeof...(Ts) > 0, "ParallelView requires at least one component type");
+        static_assert(!(detail::QueryTerm<Ts>::changed || ...), "ParallelView does not support Changed<T>; use View");
+
+        IPool* smallest = FindSmallestPool<Ts...>();
+        if (!smallest || smallest->Size() == 0) return;
+
+        // Resolve every pool up front so workers never touch m_pools.
+        std::tuple<ComponentPool<Ts>*...> pools{ PoolPtr<Ts>()... };
+        const ComponentMask mask = QueryMask<Ts...>();
+        const std::vector<uint32_t>& idxList = smallest->EntityIndices();
+
+        Jobs::JobSystem::Get().ParallelFor(idxList.size(), grainSize,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    const uint32_t idx = idxList[i];
+                    if ((m_signatures[idx] & mask) != mask) continue;
+                    const EntityId id = MakeEntity(idx, m_generations[idx]);
+                    fn(id, std::get<ComponentPool<Ts>*>(pools)->Get(idx)...);
+                }
+            });
+    }
+
+    // ParallelEach<T>(fn, grainSize) — Each<T> split across the JobSystem.
+    // Same contract as ParallelView.
+    template<typename T, typename Fn>
+    void ParallelEach(Fn&& fn, size_t grainSize = 1024) {
+        auto* p = PoolPtr<T>();
+        if (!p || p->Size() == 0) return;
+        const std::vector<uint32_t>& idxList = p->EntityIndices();
+
+        Jobs::JobSystem::Get().ParallelFor(idxList.size(), grainSize,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    const uint32_t idx = idxList[i];
+                    fn(MakeEntity(idx, m_generations[idx]), p->Get(idx));
+                }
+            });
+    }
+
+    // Group<Ts...>() — owning group over two or more component types.
+    //
+    // The first call takes ownership of the Ts pools and sorts them so that
+    // dense slots [0, Size()) of every pool hold the same entities, in the
+    // same order; the Registry keeps them that way on every add / remove /
+    // destroy.  Later calls with the same Ts return a handle to the same
+    // group.  A component type can be owned by only one group, so pick the
+    // hottest combination (e.g. Transform + Velocity).
+    //
+    // Owning a pool makes AddComponent / RemoveComponent of that type move
+    // dense entries, so View / Each over an owned type must not add or
+    // remove it mid-loop (asserts in debug builds) — use a CommandBuffer.
+    template<typename... Ts>
+    [[nodiscard]] OwningGroup<Ts...> Group() {
+        static_assert(sizeof...(Ts) > 1, "Group requires at least two component types");
+        const ComponentMask mask = QueryMask<Ts...>();
+
+        GroupData* group = nullptr;
+        for (auto& g : m_groups)
+            if (g->mask == mask) group = g.get();
+
+        if (!group) {
+            assert(!(m_ownedMask & mask) && "Registry::Group — component type is already owned by another group");
+            auto created   = std::make_unique<GroupData>();
+            created->mask  = mask;
+            created->pools = { static_cast<IPool*>(&Pool<Ts>())... };
+            group = created.get();
+            m_groups.push_back(std::move(created));
+            m_ownedMask |= mask;
+            Repack(*group);
+        }
+        return OwningGroup<Ts...>(*group, Pool<Ts>()..., m_generations);
+    }
+
     // -----------------------------------------------------------------------
     // Direct pool access (advanced / systems use)
     // -----------------------------------------------------------------------
 
     // Returns the typed ComponentPool<T>, creating it if it does not exist yet.
+    // Read / write components through it freely, but add or remove them via
+    // the Registry: it keeps each entity's component signature in sync.
     template<typename T>
     [[nodiscard]] ComponentPool<T>& Pool() {
-        const auto key = std::type_index(typeid(T));
-        auto it = m_pools.find(key);
-        if (it == m_pools.end()) {
-            auto pool = std::make_unique<ComponentPool<T>>();
-            auto* raw = pool.get();
-            m_pools.emplace(key, std::move(pool));
-            return *raw;
+        const ComponentTypeId id = ComponentType<T>();
+        if (id >= m_pools.size()) m_pools.resize(id + 1);
+        auto& slot = m_pools[id];
+        if (!slot) {
+            slot = std::make_unique<ComponentPool<T>>();
+            if constexpr (ComponentTraits<T>::trackChanges) m_trackedPools.push_back(slot.get());
         }
-        return *static_cast<ComponentPool<T>*>(it->second.get());
+        return *static_cast<ComponentPool<T>*>(slot.get());
     }
 
     template<typename T>
     [[nodiscard]] ComponentPool<T>* PoolPtr() {
-        const auto key = std::type_index(typeid(T));
-        const auto it  = m_pools.find(key);
-        return it != m_pools.end()
-            ? static_cast<ComponentPool<T>*>(it->second.get())
+        const ComponentTypeId id = ComponentType<T>();
+        return id < m_pools.size()
+            ? static_cast<ComponentPool<T>*>(m_pools[id].get())
             : nullptr;
     }
 
     template<typename T>
     [[nodiscard]] const ComponentPool<T>* PoolPtr() const {
-        const auto key = std::type_index(typeid(T));
-        const auto it  = m_pools.find(key);
-        return it != m_pools.end()
-            ? static_cast<const ComponentPool<T>*>(it->second.get())
+        const ComponentTypeId id = ComponentType<T>();
+        return id < m_pools.size()
+            ? static_cast<const ComponentPool<T>*>(m_pools[id].get())
             : nullptr;
     }
 
+    // -----------------------------------------------------------------------
+    // Snapshot / restore
+    // -----------------------------------------------------------------------
+    //
+    // Serialize() writes every live entity (index + generation) and every
+    // pool whose type has a ComponentTraits<T>::serialName.  Trivially
+    // copyable components are stored as their raw dense array next to the
+    // dense entity-index array, 16-byte aligned, so a memory-mapped archive
+    // restores with one memcpy per array; other types use their trait's
+    // Save / Load.  Pools without a serialName (PlayerComponent's Player*,
+    // GPU handles, ...) are skipped.
+    //
+    // Deserialize() replaces the whole world with the archive's.  Pool
+    // sections are matched by name, so component type ids may differ
+    // between the writing and reading process; sections for unknown names
+    // are skipped.  Owning groups are re-packed and every restored tracked
+    // component counts as changed.  On a malformed archive it returns false
+    // and leaves the Registry empty.  Archives are native-endian and tied to
+    // the component layouts and EntityId width of the build that wrote them.
+
+    static constexpr uint32_t SNAPSHOT_MAGIC   = 0x53434548u; // "HECS"
+    // 1: 32-bit EntityIds, 2: 64-bit (HOTONES_WIDE_ENTITY_IDS)
+    static constexpr uint32_t SNAPSHOT_VERSION = sizeof(EntityId) == 8 ? 2u : 1u;
+
+    [[nodiscard]] std::vector<uint8_t> Serialize() const {
+        std::vector<uint8_t> out;
+        ArchiveWriter w(out);
+        w.Pod(SNAPSHOT_MAGIC);
+        w.Pod(SNAPSHOT_VERSION);
+        w.Pod(static_cast<uint32_t>(m_generations.size()));
+        w.Pod(static_cast<uint32_t>(m_alive.size()));
+        w.Write(m_generations.data(), m_generations.size() * sizeof(uint32_t));
+        w.Write(m_alive.data(),       m_alive.size()       * sizeof(EntityId));
+
+        uint32_t poolCount = 0;
+        for (const auto& pool : m_pools)
+            if (pool && pool->SerialName()) ++poolCount;
+        w.Pod(poolCount);
+
+        for (const auto& pool : m_pools) {
+            if (!pool || !pool->SerialName()) continue;
+            w.String(pool->SerialName());
+            w.Align(8);
+            const size_t sizeAt = w.Offset();
+            w.Pod(uint64_t(0));            // section size, patched below
+            w.Align(16);
+            const size_t start = w.Offset();
+            pool->Save(w);
+            w.PatchPod(sizeAt, static_cast<uint64_t>(w.Offset() - start));
+        }
+        return out;
+    }
+
+    bool Deserialize(const uint8_t* data, size_t size) {
+        Clear();
+        if (!DeserializeInto(data, size)) {
+            Clear();
+            return false;
+        }
+        return true;
+    }
+    bool Deserialize(const std::vector<uint8_t>& archive) {
+        return Deserialize(archive.data(), archive.size());
+    }
+
+    // -----------------------------------------------------------------------
+    // Memory statistics
+    // -----------------------------------------------------------------------
+
+    // Heap usage of the pool for component type id (zeroes if it has no pool).
+    [[nodiscard]] PoolMemoryStats PoolMemory(ComponentTypeId id) const {
+        return id < m_pools.size() && m_pools[id] ? m_pools[id]->MemoryStats()
+                                                  : PoolMemoryStats{};
+    }
+
+    template<typename T>
+    [[nodiscard]] PoolMemoryStats PoolMemory() const { return PoolMemory(ComponentType<T>()); }
+
+    // Sum over every component pool.
+    [[nodiscard]] PoolMemoryStats MemoryStats() const {
+        PoolMemoryStats total;
+        for (const auto& pool : m_pools)
+            if (pool) total += pool->MemoryStats();
+        return total;
+    }
+
+    // Number of pool slots (one past the highest ComponentTypeId in use);
+    // iterate [0, PoolCount()) with PoolMemory(id) for a per-type breakdown.
+    [[nodiscard]] size_t PoolCount() const noexcept { return m_pools.size(); }
+
 private:
     // ---- Internal helpers -------------------------------------------------
 
@@ -255,16 +587,164 @@ private:
         return *p;
     }
 
-    // True if entity index idx has every component type in Ts.
+    // ---- Query bodies ------------------------------------------------------
+
+    template<typename... Ts, typename Fn>
+    void ViewAll(Fn&& fn) {
+        IPool* smallest = FindSmallestPool<Ts...>();
+        if (!smallest || smallest->Size() == 0) return;
+
+        std::tuple<ComponentPool<Ts>*...> pools{ PoolPtr<Ts>()... };
+        const ComponentMask mask = QueryMask<Ts...>();
+        const std::vector<uint32_t>& idxList = smallest->EntityIndices();
+        const size_t count = idxList.size();
+        [[maybe_unused]] const uint32_t version = smallest->Version();
+
+        for (size_t i = 0; i < count && i < idxList.size(); ++i) {
+            assert(smallest->Version() == version
+                   && "Registry::View — driving pool was modified during iteration; use a CommandBuffer");
+            const uint32_t idx = idxList[i];
+            if ((m_signatures[idx] & mask) != mask) continue;
+            const EntityId id = MakeEntity(idx, m_generations[idx]);
+            fn(id, std::get<ComponentPool<Ts>*>(pools)->Get(idx)...);
+        }
+    }
+
+    template<typename... Ts, typename Fn>
+    void ViewChanged(Fn&& fn) {
+        using Driver = typename detail::FirstChanged<Ts...>::type;
+        static_assert(ComponentTraits<Driver>::trackChanges,
+                      "View<Changed<T>> requires ComponentTraits<T>::trackChanges");
+
+        std::tuple<ComponentPool<QueryComponent<Ts>>*...> pools{ PoolPtr<QueryComponent<Ts>>()... };
+        if ((!std::get<ComponentPool<QueryComponent<Ts>>*>(pools) || ...)) return;
+        const ComponentMask mask = QueryMask<QueryComponent<Ts>...>();
+        const std::vector<uint32_t>& changed =
+            std::get<ComponentPool<Driver>*>(pools)->ChangedEntities();
+        const size_t count = changed.size();
+
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t idx = changed[i];
+            if ((m_signatures[idx] & mask) != mask) continue;
+            if (!(ChangedNow<Ts>(*std::get<ComponentPool<QueryComponent<Ts>>*>(pools), idx) && ...))
+                continue;
+            fn(MakeEntity(idx, m_generations[idx]),
+               std::get<ComponentPool<QueryComponent<Ts>>*>(pools)->Get(idx)...);
+        }
+    }
+
+    // True unless Term is Changed<T> and idx's T was not marked this tick.
+    template<typename Term, typename T>
+    [[nodiscard]] bool ChangedNow(const ComponentPool<T>& pool, uint32_t idx) const {
+        if constexpr (detail::QueryTerm<Term>::changed) return pool.ChangeTick(idx) == m_tick;
+        else return true;
+    }
+
+    // Signature bits an entity must have to match a query over Ts.
     template<typename... Ts>
-    [[nodiscard]] bool HasAllAt(uint32_t idx) const {
-        return (HasAt<Ts>(idx) && ...);
+    [[nodiscard]] static ComponentMask QueryMask() noexcept {
+        return (ComponentBit(ComponentType<Ts>()) | ...);
     }
 
-    template<typename T>
-    [[nodiscard]] bool HasAt(uint32_t idx) const {
-        const auto* p = PoolPtr<T>();
-        return p && p->Has(idx);
+    // ---- Snapshot restore ---------------------------------------------------
+
+    bool DeserializeInto(const uint8_t* data, size_t size) {
+        ArchiveReader r(data, size);
+        uint32_t magic = 0, version = 0, slotCount = 0, aliveCount = 0;
+        if (!r.Pod(magic) || magic != SNAPSHOT_MAGIC)     return false;
+        if (!r.Pod(version) || version != SNAPSHOT_VERSION) return false;
+        if (!r.Pod(slotCount) || !r.Pod(aliveCount))      return false;
+        if (slotCount > uint64_t(INDEX_MASK) + 1u || aliveCount > slotCount) return false;
+        if (uint64_t(slotCount) * sizeof(uint32_t) + uint64_t(aliveCount) * sizeof(EntityId) > r.Remaining())
+            return false;
+
+        // Entities: generations, alive list, and a free list of the rest.
+        constexpr uint32_t NOT_ALIVE = ~0u;
+        m_generations.resize(slotCount);
+        m_alive.resize(aliveCount);
+        if (!r.Read(m_generations.data(), slotCount * sizeof(uint32_t))) return false;
+        if (!r.Read(m_alive.data(), aliveCount * sizeof(EntityId)))      return false;
+        m_alivePos.assign(slotCount, NOT_ALIVE);
+        m_signatures.assign(slotCount, 0u);
+        for (uint32_t pos = 0; pos < aliveCount; ++pos) {
+            const EntityId id  = m_alive[pos];
+            const uint32_t idx = EntityIndex(id);
+            if (idx >= slotCount || m_alivePos[idx] != NOT_ALIVE || !IsAlive(id)) return false;
+            m_alivePos[idx] = pos;
+        }
+        for (uint32_t idx = 0; idx < slotCount; ++idx)
+            if (m_alivePos[idx] == NOT_ALIVE) m_freeList.push(idx);
+
+        // Pools, matched by serial name.
+        uint32_t poolCount = 0;
+        if (!r.Pod(poolCount)) return false;
+        for (uint32_t i = 0; i < poolCount; ++i) {
+            std::string name;
+            uint64_t    sectionSize = 0;
+            if (!r.String(name) || !r.Align(8) || !r.Pod(sectionSize) || !r.Align(16)) return false;
+            const uint8_t* section = r.Take(static_cast<size_t>(sectionSize));
+            if (!section) return false;
+
+            const SerializableComponent* type = SerializableComponents::Get().Find(name);
+            if (!type) continue; // component not known to this build
+
+            IPool& pool = type->ensure(*this);
+            ArchiveReader sr(section, static_cast<size_t>(sectionSize));
+            if (!pool.Load(sr, m_tick, slotCount)) return false;
+
+            const ComponentMask bit = ComponentBit(type->id);
+            for (uint32_t idx : pool.EntityIndices()) {
+                if (idx >= slotCount || m_alivePos[idx] == NOT_ALIVE) return false;
+                m_signatures[idx] |= bit;
+            }
+        }
+
+        for (auto& group : m_groups) Repack(*group);
+        return true;
+    }
+
+    // ---- Owning groups -----------------------------------------------------
+
+    // Move entity idx into slot group.size of every owned pool and grow the group.
+    static void Pack(GroupData& group, uint32_t idx) {
+        const auto pos = static_cast<uint32_t>(group.size++);
+        for (IPool* p : group.pools) p->SwapDense(p->DenseIndex(idx), pos);
+    }
+
+    // Shrink the group and move entity idx to the slot just past its end.
+    static void Unpack(GroupData& group, uint32_t idx) {
+        const auto pos = static_cast<uint32_t>(--group.size);
+        for (IPool* p : group.pools) p->SwapDense(p->DenseIndex(idx), pos);
+    }
+
+    // Rebuild a group from scratch by pulling every member to the front.
+    // Walking the smallest pool forward is safe: each swap only touches
+    // slots already visited.
+    void Repack(GroupData& group) {
+        group.size = 0;
+        IPool* driver = group.pools.front();
+        for (IPool* p : group.pools)
+            if (p->Size() < driver->Size()) driver = p;
+        const std::vector<uint32_t>& idxList = driver->EntityIndices();
+        for (size_t i = 0; i < idxList.size(); ++i) {
+            const uint32_t idx = idxList[i];
+            if ((m_signatures[idx] & group.mask) == group.mask) Pack(group, idx);
+        }
+    }
+
+    // idx just gained the `added` types: join every group it now completes.
+    void EnterGroups(uint32_t idx, ComponentMask added) {
+        const ComponentMask sig = m_signatures[idx];
+        for (auto& g : m_groups)
+            if ((g->mask & added) && (sig & g->mask) == g->mask) Pack(*g, idx);
+    }
+
+    // idx is about to lose the `removed` types (signature not yet updated):
+    // leave every group that depends on one of them.
+    void LeaveGroups(uint32_t idx, ComponentMask removed) {
+        const ComponentMask sig = m_signatures[idx];
+        for (auto& g : m_groups)
+            if ((g->mask & removed) && (sig & g->mask) == g->mask) Unpack(*g, idx);
     }
 
     // Return the pool (among those for Ts) with the fewest live components.
@@ -283,12 +763,35 @@ private:
 
     // ---- Storage ----------------------------------------------------------
 
-    std::vector<EntityId>  m_alive;       // all live EntityIds
-    std::vector<uint32_t>  m_generations; // generations[entityIndex]
-    std::queue<uint32_t>   m_freeList;    // recycled entity indices
+    std::vector<EntityId>      m_alive;       // all live EntityIds
+    std::vector<uint32_t>      m_alivePos;    // alivePos[entityIndex] = slot in m_alive
+    std::vector<uint32_t>      m_generations; // generations[entityIndex]
+    std::vector<ComponentMask> m_signatures;  // signatures[entityIndex] = owned types
+    std::queue<uint32_t>       m_freeList;    // recycled entity indices
+
+    // One pool slot per ComponentTypeId (nullptr until the type is first used).
+    std::vector<std::unique_ptr<IPool>> m_pools;
 
-    // One pool per component type, keyed by std::type_index.
-    std::unordered_map<std::type_index, std::unique_ptr<IPool>> m_pools;
+    std::vector<std::unique_ptr<GroupData>> m_groups;
+    ComponentMask                            m_ownedMask = 0; // types owned by any group
+
+    std::vector<IPool*> m_trackedPools; // pools with trackChanges, reset by AdvanceTick
+    uint32_t            m_tick = 1;
 };
 
+template<typename T>
+bool SerializableComponents::Register() {
+    static_assert(IsSerializableComponent<T>, "Register<T> requires ComponentTraits<T>::serialName");
+    std::lock_guard<std::mutex> lk(m_mutex);
+    const ComponentTypeId id = ComponentType<T>();
+    for (const auto& e : m_types) {
+        if (e.id == id) return true;
+        assert(std::string(e.name) != ComponentTraits<T>::serialName
+               && "SerializableComponents — two component types share a serialName");
+    }
+    m_types.push_back({ ComponentTraits<T>::serialName, id,
+                        [](Registry& reg) -> IPool& { return reg.Pool<T>(); } });
+    return true;
+}
+
 } // namespace Hotones::ECS
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <ECS/Components.hpp>
+#include <ECS/Registry.hpp>
+#include <server/NetworkManager.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// Replication.hpp — mirror tagged entities from a server's Registry into its
+// clients' over NetworkManager's replicated entities.
+//
+// An entity is replicated while it carries a NetworkComponent, and with it
+// every component whose ComponentTraits<T>::replicate is set (Transform,
+// Velocity, Health and Group among the built-ins).  Its state on the wire
+// is a 32-bit mask of the replicated types it has, then each one's raw
+// bytes, in ReplicatedComponents order; NetworkManager delta-compresses it
+// per client, so an entity that only moved costs its position words.
+//
+// Server: call Replicate() once per frame after the simulation.  A newly
+// tagged entity is given a netId and spawned on every client; an entity
+// that dies or loses its tag is despawned.  Entities whose replicated
+// components are all tracked are only re-packed when one was marked
+// changed since the last call (or a component was added or removed).
+//
+// Client: Attach() takes over nm.OnEntitySpawned / Updated / Despawned and
+// creates, writes and destroys local entities to match.  Each carries a
+// NetworkComponent with the server's netId and isLocal = false; writes go
+// through GetMut, so Changed<T> views see replicated updates.
+// ---------------------------------------------------------------------------
+
+struct ReplicatedComponent {
+    const char*     name = nullptr;
+    ComponentTypeId id   = 0;
+    uint32_t        size = 0;
+    bool            tracked = false;
+    bool     (*has)(const Registry&, EntityId)               = nullptr;
+    uint32_t (*changeTick)(Registry&, EntityId)              = nullptr;
+    void     (*write)(const Registry&, EntityId, uint8_t* out) = nullptr;
+    void     (*read)(Registry&, EntityId, const uint8_t* in)   = nullptr; // adds or overwrites
+    void     (*remove)(Registry&, EntityId)                    = nullptr;
+};
+
+// ---------------------------------------------------------------------------
+// ReplicatedComponents — process-wide table of the replicated types, kept
+// sorted by serialName so a server and its clients number them alike.
+// Register a pack's own types on both ends before connecting; the
+// built-ins register themselves.
+// ---------------------------------------------------------------------------
+class ReplicatedComponents {
+public:
+    static constexpr size_t MAX_TYPES = 32;   // one bit each in the mask
+
+    static ReplicatedComponents& Get() {
+        static ReplicatedComponents s_instance;
+        return s_instance;
+    }
+
+    // Idempotent.  Returns true so it can initialise a static.
+    template<typename T>
+    bool Register();
+
+    // Not locked: registration happens at startup, before any replication.
+    [[nodiscard]] const std::vector<ReplicatedComponent>& Types() const { return m_types; }
+
+private:
+    std::mutex                       m_mutex;
+    std::vector<ReplicatedComponent> m_types;
+};
+
+template<typename T>
+bool ReplicatedComponents::Register() {
+    static_assert(ComponentTraits<T>::replicate, "Register<T> requires ComponentTraits<T>::replicate");
+    static_assert(IsSerializableComponent<T>, "replicated components need a serialName");
+    static_assert(std::is_trivially_copyable_v<T>, "replicated components are sent as raw bytes");
+    std::lock_guard<std::mutex> lk(m_mutex);
+    const ComponentTypeId id = ComponentType<T>();
+    for (const auto& e : m_types)
+        if (e.id == id) return true;
+    assert(m_types.size() < MAX_TYPES && "ReplicatedComponents — too many replicated types");
+
+    ReplicatedComponent c;
+    c.name    = ComponentTraits<T>::serialName;
+    c.id      = id;
+    c.size    = sizeof(T);
+    c.tracked = ComponentTraits<T>::trackChanges;
+    c.has     = [](const Registry& reg, EntityId e) { return reg.HasComponent<T>(e); };
+    c.changeTick = [](Registry& reg, EntityId e) { return reg.Pool<T>().ChangeTick(EntityIndex(e)); };
+    c.write   = [](const Registry& reg, EntityId e, uint8_t* out) {
+        const T value = reg.GetComponent<T>(e);
+        std::memcpy(out, &value, sizeof(T));
+    };
+    c.read    = [](Registry& reg, EntityId e, const uint8_t* in) {
+        T value;
+        std::memcpy(&value, in, sizeof(T));
+        if (reg.HasComponent<T>(e)) reg.GetMut<T>(e) = value;
+        else reg.AddComponent<T>(e, value);
+    };
+    c.remove  = [](Registry& reg, EntityId e) { reg.RemoveComponent<T>(e); };
+
+    auto at = std::find_if(m_types.begin(), m_types.end(),
+                           [&](const ReplicatedComponent& o) { return std::strcmp(o.name, c.name) > 0; });
+    m_types.insert(at, c);
+    return true;
+}
+
+namespace detail {
+inline const bool g_builtinReplicatedRegistered = [] {
+    auto& types = ReplicatedComponents::Get();
+    types.Register<TransformComponent>();
+    types.Register<VelocityComponent>();
+    types.Register<GroupComponent>();
+    types.Register<HealthComponent>();
+    return true;
+}();
+} // namespace detail
+
+class EntityReplicator {
+public:
+    // ── Server ──────────────────────────────────────────────────────────────
+    // Spawn, update and despawn tagged entities through nm.
+    void Replicate(Registry& reg, Net::NetworkManager& nm) {
+        const auto& types = ReplicatedComponents::Get().Types();
+        ++m_pass;
+        reg.Each<NetworkComponent>([&](EntityId id, NetworkComponent& nc) {
+            auto it = m_sent.find(nc.netId);
+            // New, or a copy of another entity's component
+            if (nc.netId == 0 || it == m_sent.end() || it->second.entity != id) {
+                nc.netId = nm.CreateNetEntity();
+                if (nc.netId == 0) return;
+                it = m_sent.emplace(nc.netId, Sent{ id }).first;
+            }
+            Sent& sent = it->second;
+            sent.pass  = m_pass;
+
+            uint32_t mask  = 0;
+            bool     dirty = !sent.packed;
+            for (size_t i = 0; i < types.size(); ++i) {
+                if (!types[i].has(reg, id)) continue;
+                mask |= 1u << i;
+                if (!types[i].tracked || types[i].changeTick(reg, id) >= m_since) dirty = true;
+            }
+            if (!dirty && mask == sent.mask) return;
+
+            size_t len = sizeof(mask);
+            std::memcpy(m_scratch, &mask, sizeof(mask));
+            for (size_t i = 0; i < types.size(); ++i) {
+                if (!(mask & (1u << i))) continue;
+                if (len + types[i].size > Net::ENTITY_MAX_STATE) { mask &= ~(1u << i); continue; }
+                types[i].write(reg, id, m_scratch + len);
+                len += types[i].size;
+            }
+            std::memcpy(m_scratch, &mask, sizeof(mask));   // less anything that did not fit
+            nm.SetNetEntityState(nc.netId, m_scratch, len);
+            sent.mask   = mask;
+            sent.packed = true;
+        });
+        // Not seen this pass: destroyed, or untagged
+        std::erase_if(m_sent, [&](const auto& kv) {
+            if (kv.second.pass == m_pass) return false;
+            nm.DestroyNetEntity(kv.first);
+            return true;
+        });
+        // Changes marked later in this tick are caught next call
+        m_since = reg.Tick();
+    }
+
+    // ── Client ──────────────────────────────────────────────────────────────
+    // Mirror nm's replicated entities into reg until Detach().
+    void Attach(Net::NetworkManager& nm, Registry& reg) {
+        m_registry = &reg;
+        nm.OnEntitySpawned = [this](Net::NetEntityId id, const uint8_t* state, size_t len) {
+            const EntityId e = m_registry->CreateEntity();
+            m_registry->AddComponent<NetworkComponent>(e, NetworkComponent{ 0, false, id });
+            m_mirrors[id] = e;
+            Apply(e, state, len);
+        };
+        nm.OnEntityUpdated = [this](Net::NetEntityId id, const uint8_t* state, size_t len) {
+            auto it = m_mirrors.find(id);
+            if (it == m_mirrors.end()) return;
+            // A script may have destroyed it
+            if (!m_registry->IsAlive(it->second)) { m_mirrors.erase(it); return; }
+            Apply(it->second, state, len);
+        };
+        nm.OnEntityDespawned = [this](Net::NetEntityId id) {
+            auto it = m_mirrors.find(id);
+            if (it == m_mirrors.end()) return;
+            m_registry->DestroyEntity(it->second);
+            m_mirrors.erase(it);
+        };
+    }
+
+    void Detach(Net::NetworkManager& nm) {
+        nm.OnEntitySpawned   = nullptr;
+        nm.OnEntityUpdated   = nullptr;
+        nm.OnEntityDespawned = nullptr;
+        m_registry = nullptr;
+        m_mirrors.clear();
+    }
+
+    // Client: the local entity mirroring server entity `id`.
+    [[nodiscard]] EntityId Find(Net::NetEntityId id) const {
+        auto it = m_mirrors.find(id);
+        return it != m_mirrors.end() ? it->second : INVALID_ENTITY;
+    }
+
+    // Forget every entity without despawning anything (the Registry was
+    // cleared).
+    void Clear() {
+        m_sent.clear();
+        m_mirrors.clear();
+    }
+
+private:
+    // Apply a state: replicated types in its mask are written, those not in
+    // it removed.  A truncated state is ignored.
+    void Apply(EntityId e, const uint8_t* state, size_t len) {
+        const auto& types = ReplicatedComponents::Get().Types();
+        uint32_t mask;
+        if (len < sizeof(mask)) return;
+        std::memcpy(&mask, state, sizeof(mask));
+        size_t need = sizeof(mask);
+        for (size_t i = 0; i < types.size(); ++i)
+            if (mask & (1u << i)) need += types[i].size;
+        if (need != len) return;
+
+        size_t at = sizeof(mask);
+        for (size_t i = 0; i < types.size(); ++i) {
+            if (mask & (1u << i)) {
+                types[i].read(*m_registry, e, state + at);
+                at += types[i].size;
+            } else if (types[i].has(*m_registry, e)) {
+                types[i].remove(*m_registry, e);
+            }
+        }
+    }
+
+    // Server: entities handed to NetworkManager, by netId
+    struct Sent {
+        EntityId entity = INVALID_ENTITY;
+        uint32_t mask   = 0;
+        uint32_t pass   = 0;
+        bool     packed = false;
+    };
+    std::unordered_map<Net::NetEntityId, Sent> m_sent;
+    uint32_t m_pass  = 0;
+    uint32_t m_since = 0;
+    uint8_t  m_scratch[Net::ENTITY_MAX_STATE] = {};
+
+    // Client: local mirrors, by netId
+    Registry*                                      m_registry = nullptr;
+    std::unordered_map<Net::NetEntityId, EntityId> m_mirrors;
+};
+
+} // namespace Hotones::ECS
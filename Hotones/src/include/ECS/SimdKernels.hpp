@@ -0,0 +1,120 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define HOTONES_SIMD_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define HOTONES_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define HOTONES_SIMD_NEON 1
+#endif
+
+namespace Hotones::ECS::Simd {
+
+// ---------------------------------------------------------------------------
+// SimdKernels.hpp — float-array kernels for the built-in systems.
+//
+// Each kernel walks a packed float array (an SoA field such as
+// TransformComponent::position viewed as 3·n floats) in vector-width steps
+// plus a scalar tail.  The widest instruction set the translation unit is
+// compiled for is used: AVX2 (+FMA if enabled), SSE2 (x86-64 baseline),
+// NEON, or plain scalar code.  No alignment is required.
+// ---------------------------------------------------------------------------
+
+// Name of the instruction set the kernels were compiled for.
+[[nodiscard]] constexpr const char* InstructionSet() noexcept {
+#if defined(HOTONES_SIMD_AVX2)
+    return "avx2";
+#elif defined(HOTONES_SIMD_SSE2)
+    return "sse2";
+#elif defined(HOTONES_SIMD_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+// dst[i] += src[i] * scale for i in [0, n).
+inline void MulAdd(float* dst, const float* src, float scale, size_t n) {
+    size_t i = 0;
+#if defined(HOTONES_SIMD_AVX2)
+    const __m256 s = _mm256_set1_ps(scale);
+    for (; i + 8 <= n; i += 8) {
+    #if defined(__FMA__)
+        const __m256 r = _mm256_fmadd_ps(_mm256_loadu_ps(src + i), s, _mm256_loadu_ps(dst + i));
+    #else
+        const __m256 r = _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), s));
+    #endif
+        _mm256_storeu_ps(dst + i, r);
+    }
+#elif defined(HOTONES_SIMD_SSE2)
+    const __m128 s = _mm_set1_ps(scale);
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), s)));
+#elif defined(HOTONES_SIMD_NEON)
+    const float32x4_t s = vdupq_n_f32(scale);
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), s));
+#endif
+    for (; i < n; ++i) dst[i] += src[i] * scale;
+}
+
+// dst[i] += value for i in [0, n).
+inline void AddScalar(float* dst, float value, size_t n) {
+    size_t i = 0;
+#if defined(HOTONES_SIMD_AVX2)
+    const __m256 v = _mm256_set1_ps(value);
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), v));
+#elif defined(HOTONES_SIMD_SSE2)
+    const __m128 v = _mm_set1_ps(value);
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), v));
+#elif defined(HOTONES_SIMD_NEON)
+    const float32x4_t v = vdupq_n_f32(value);
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), v));
+#endif
+    for (; i < n; ++i) dst[i] += value;
+}
+
+// Calls fn(i) for every i in [0, n) with v[i] <= limit, in increasing order.
+// Whole vectors with no match are skipped with one compare.
+template<typename Fn>
+inline void ForEachAtMost(const float* v, float limit, size_t n, Fn&& fn) {
+    size_t i = 0;
+#if defined(HOTONES_SIMD_AVX2)
+    const __m256 l = _mm256_set1_ps(limit);
+    for (; i + 8 <= n; i += 8) {
+        for (auto m = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(v + i), l, _CMP_LE_OQ)));
+             m; m &= m - 1)
+            fn(i + static_cast<size_t>(std::countr_zero(m)));
+    }
+#elif defined(HOTONES_SIMD_SSE2)
+    const __m128 l = _mm_set1_ps(limit);
+    for (; i + 4 <= n; i += 4) {
+        for (auto m = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(v + i), l)));
+             m; m &= m - 1)
+            fn(i + static_cast<size_t>(std::countr_zero(m)));
+    }
+#elif defined(HOTONES_SIMD_NEON)
+    const float32x4_t l = vdupq_n_f32(limit);
+    for (; i + 4 <= n; i += 4) {
+        const uint32x4_t le = vcleq_f32(vld1q_f32(v + i), l);
+        const uint32x2_t any = vorr_u32(vget_low_u32(le), vget_high_u32(le));
+        if ((vget_lane_u32(any, 0) | vget_lane_u32(any, 1)) == 0) continue;
+        for (size_t k = 0; k < 4; ++k)
+            if (v[i + k] <= limit) fn(i + k);
+    }
+#endif
+    for (; i < n; ++i)
+        if (v[i] <= limit) fn(i);
+}
+
+} // namespace Hotones::ECS::Simd
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <ECS/System.hpp>
+#include <ECS/Components.hpp>
+
+#include <raylib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// SpatialIndex — "which entities are near here" without scanning every
+// TransformComponent.
+//
+// A spatial hash: world space is cut into cubes CellSize() units on a side
+// and each entity with a TransformComponent is filed under the cube holding
+// its position.  QueryRadius / QueryAABB visit only the cubes their shape
+// overlaps, so they cost in proportion to how crowded that neighbourhood
+// is, not to the size of the world.
+//
+// The index is kept up to date from change tracking: Sync() re-files only
+// the entities whose transform was marked this tick (AddComponent, GetMut,
+// MarkChanged, MovementSystem), so a still world costs nothing per tick.
+// Destroyed entities and removed transforms are not tracked; their entries
+// stay until the slot is reused (and re-filed) or the index compacts
+// itself, and queries skip them.
+//
+// As a System it syncs once per tick, after whatever writes transforms
+// (it declares a read, so the scheduler places it after the writers).
+// Writes made outside the scheduler are only seen if Sync() runs before
+// the next Registry::AdvanceTick() forgets them; ScriptedScene does that at
+// the top of each tick.  Queries see the index as of the last Sync() and
+// test each candidate's position as of then too.
+//
+// Usage
+//   auto& spatial = systems.Add<ECS::SpatialIndex>();
+//   ...
+//   std::vector<EntityId> near;
+//   spatial.QueryRadius(reg, playerPos, 12.0f, near);   // alive, with a transform
+//
+// Queries are read-only and may run from several systems at once; Sync()
+// may not run alongside them.
+// ---------------------------------------------------------------------------
+class SpatialIndex : public System {
+public:
+    struct Stats {
+        size_t entities = 0;   // filed, live or not yet swept
+        size_t cells    = 0;   // cubes holding at least one entry
+        size_t moved    = 0;   // re-filed by the last Sync()
+    };
+
+    explicit SpatialIndex(float cellSize = 8.0f) { SetCellSize(cellSize); }
+
+    void DeclareAccess(SystemAccess& access) const override {
+        access.Read<TransformComponent>();
+    }
+
+    void Init(Registry& reg) override     { Rebuild(reg); }
+    void Update(Registry& reg, float) override { Sync(reg); }
+    void Shutdown(Registry&) override     { Clear(); }
+
+    // Cube edge, in world units.  About the radius of the usual query
+    // works best.  Changing it re-files everything at the next Rebuild().
+    void SetCellSize(float size) {
+        m_cellSize = size > 0.01f ? size : 0.01f;
+        m_invCell  = 1.0f / m_cellSize;
+        m_stale    = true;
+    }
+    [[nodiscard]] float CellSize() const noexcept { return m_cellSize; }
+
+    // File every transform whose change mark this tick the index has not
+    // seen yet.  Cheap to call more than once per tick.
+    void Sync(Registry& reg) {
+        if (m_stale) { Rebuild(reg); return; }
+        m_stats.moved = 0;
+        if constexpr (ComponentTraits<TransformComponent>::trackChanges) {
+            ComponentPool<TransformComponent>& pool = reg.Pool<TransformComponent>();
+            const std::vector<uint32_t>& changed = pool.ChangedEntities();
+            if (reg.Tick() != m_syncedTick || changed.size() < m_syncedCount) {
+                m_syncedTick  = reg.Tick();
+                m_syncedCount = 0;
+            }
+            for (size_t i = m_syncedCount; i < changed.size(); ++i) {
+                const uint32_t idx = changed[i];
+                if (!pool.Has(idx)) continue;
+                File(idx, reg.EntityAt(idx), pool.Get(idx).position);
+            }
+            m_syncedCount = changed.size();
+
+            // Sweep out the dead once they outnumber the living
+            if (m_filed > 2 * pool.Size() + 64) Compact(reg);
+        } else {
+            Rebuild(reg);   // no change marks to go by
+        }
+    }
+
+    // Drop everything and file every transform afresh
+    void Rebuild(Registry& reg) {
+        Clear();
+        m_stale = false;
+        reg.Each<TransformComponent>([&](EntityId id, auto&& t) {
+            File(EntityIndex(id), id, t.position);
+        });
+        m_syncedTick  = reg.Tick();
+        m_syncedCount = reg.Pool<TransformComponent>().ChangedEntities().size();
+    }
+
+    void Clear() {
+        m_entries.clear();
+        m_cells.clear();
+        m_filed = 0;
+        m_syncedCount = 0;
+        m_stats = {};
+    }
+
+    // Live entities with a transform within `radius` of `centre`, appended
+    // to `out` in no particular order.
+    void QueryRadius(const Registry& reg, Vector3 centre, float radius, std::vector<EntityId>& out) const {
+        const float r2 = radius * radius;
+        const Vector3 lo = { centre.x - radius, centre.y - radius, centre.z - radius };
+        const Vector3 hi = { centre.x + radius, centre.y + radius, centre.z + radius };
+        VisitCells(lo, hi, [&](const Entry& e) {
+            const float dx = e.position.x - centre.x, dy = e.position.y - centre.y, dz = e.position.z - centre.z;
+            if (dx * dx + dy * dy + dz * dz <= r2 && Live(reg, e)) out.push_back(e.id);
+        });
+    }
+
+    // Live entities with a transform inside `box` (bounds included)
+    void QueryAABB(const Registry& reg, const BoundingBox& box, std::vector<EntityId>& out) const {
+        VisitCells(box.min, box.max, [&](const Entry& e) {
+            const Vector3 p = e.position;
+            if (p.x >= box.min.x && p.x <= box.max.x && p.y >= box.min.y && p.y <= box.max.y &&
+                p.z >= box.min.z && p.z <= box.max.z && Live(reg, e))
+                out.push_back(e.id);
+        });
+    }
+
+    [[nodiscard]] const Stats& GetStats() noexcept {
+        m_stats.entities = m_filed;
+        m_stats.cells    = m_cells.size();
+        return m_stats;
+    }
+
+private:
+    struct Entry {
+        EntityId id       = INVALID_ENTITY;   // as filed; stale once the slot is reused
+        Vector3  position = { 0.0f, 0.0f, 0.0f };
+        uint64_t cell     = 0;
+        uint32_t slot     = 0;                // in m_cells[cell]
+        bool     filed    = false;
+    };
+
+    // Cube coordinates, 21 bits each (±1M cubes per axis), packed
+    static constexpr int64_t  COORD_BIAS = int64_t(1) << 20;
+    static constexpr uint64_t COORD_MASK = (uint64_t(1) << 21) - 1u;
+
+    [[nodiscard]] int64_t Coord(float v) const {
+        return static_cast<int64_t>(std::floor(v * m_invCell));
+    }
+    [[nodiscard]] static uint64_t Key(int64_t x, int64_t y, int64_t z) {
+        return (uint64_t(x + COORD_BIAS) & COORD_MASK)
+             | (uint64_t(y + COORD_BIAS) & COORD_MASK) << 21
+             | (uint64_t(z + COORD_BIAS) & COORD_MASK) << 42;
+    }
+
+    [[nodiscard]] static bool Live(const Registry& reg, const Entry& e) {
+        return reg.IsAlive(e.id) && reg.HasComponent<TransformComponent>(e.id);
+    }
+
+    void File(uint32_t idx, EntityId id, Vector3 position) {
+        if (idx >= m_entries.size()) m_entries.resize(idx + 1);
+        Entry& e = m_entries[idx];
+        const uint64_t cell = Key(Coord(position.x), Coord(position.y), Coord(position.z));
+        e.id       = id;
+        e.position = position;
+        if (e.filed && e.cell == cell) return;
+        if (e.filed) Unfile(idx);
+        std::vector<uint32_t>& members = m_cells[cell];
+        e.cell  = cell;
+        e.slot  = static_cast<uint32_t>(members.size());
+        e.filed = true;
+        members.push_back(idx);
+        ++m_filed;
+        ++m_stats.moved;
+    }
+
+    void Unfile(uint32_t idx) {
+        Entry& e = m_entries[idx];
+        auto it = m_cells.find(e.cell);
+        std::vector<uint32_t>& members = it->second;
+        const uint32_t last = members.back();
+        members[e.slot] = last;
+        m_entries[last].slot = e.slot;
+        members.pop_back();
+        if (members.empty()) m_cells.erase(it);
+        e.filed = false;
+        --m_filed;
+    }
+
+    // Drop entries for dead entities and removed transforms
+    void Compact(const Registry& reg) {
+        for (uint32_t idx = 0; idx < m_entries.size(); ++idx)
+            if (m_entries[idx].filed && !Live(reg, m_entries[idx])) Unfile(idx);
+    }
+
+    // fn(entry) for every entry in the cubes [lo, hi] overlaps; walks the
+    // occupied cubes instead when there are fewer of those
+    template<typename Fn>
+    void VisitCells(Vector3 lo, Vector3 hi, Fn&& fn) const {
+        const int64_t x0 = Coord(lo.x), y0 = Coord(lo.y), z0 = Coord(lo.z);
+        const int64_t x1 = Coord(hi.x), y1 = Coord(hi.y), z1 = Coord(hi.z);
+        if (x1 < x0 || y1 < y0 || z1 < z0) return;
+        const double span = double(x1 - x0 + 1) * double(y1 - y0 + 1) * double(z1 - z0 + 1);
+        if (span > double(m_cells.size())) {
+            for (const auto& [key, members] : m_cells)
+                for (uint32_t idx : members) fn(m_entries[idx]);   // the exact test filters
+            return;
+        }
+        for (int64_t z = z0; z <= z1; ++z)
+            for (int64_t y = y0; y <= y1; ++y)
+                for (int64_t x = x0; x <= x1; ++x) {
+                    const auto it = m_cells.find(Key(x, y, z));
+                    if (it == m_cells.end()) continue;
+                    for (uint32_t idx : it->second) fn(m_entries[idx]);
+                }
+    }
+
+    float m_cellSize = 8.0f;
+    float m_invCell  = 1.0f / 8.0f;
+    bool  m_stale    = true;              // Rebuild() at the next Sync()
+
+    std::vector<Entry>                                   m_entries;   // by entity index
+    std::unordered_map<uint64_t, std::vector<uint32_t>>  m_cells;     // cube → entity indices
+    size_t   m_filed       = 0;
+    uint32_t m_syncedTick  = 0;           // ChangedEntities() of this tick...
+    size_t   m_syncedCount = 0;           // ...filed up to here
+    Stats    m_stats;
+};
+
+} // namespace Hotones::ECS
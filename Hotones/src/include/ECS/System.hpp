@@ -1,8 +1,70 @@
 #pragma once
 
+#include <ECS/Registry.hpp>
+#include <ECS/CommandBuffer.hpp>
+#include <ECS/TypeId.hpp>
+
+#include <cassert>
+#include <vector>
+
 namespace Hotones::ECS {
 
-class Registry;
+// ---------------------------------------------------------------------------
+// SystemAccess — the component types a System reads and writes.
+//
+// Filled in by System::DeclareAccess and used by the SystemScheduler to
+// decide which systems may run at the same time: two systems conflict when
+// either writes a type the other reads or writes, or either is Exclusive.
+//
+//   void DeclareAccess(SystemAccess& a) const override {
+//       a.Read<VelocityComponent>().Write<TransformComponent>();
+//   }
+// ---------------------------------------------------------------------------
+class SystemAccess {
+public:
+    template<typename... Ts>
+    SystemAccess& Read() {
+        m_reads |= (ComponentBit(ComponentType<Ts>()) | ...);
+        (m_pools.push_back(&EnsurePool<Ts>), ...);
+        return *this;
+    }
+
+    template<typename... Ts>
+    SystemAccess& Write() {
+        m_writes |= (ComponentBit(ComponentType<Ts>()) | ...);
+        (m_pools.push_back(&EnsurePool<Ts>), ...);
+        return *this;
+    }
+
+    // The system touches data it cannot describe (globals, the entity set,
+    // Lua, ...) and must run alone.
+    SystemAccess& Exclusive() { m_exclusive = true; return *this; }
+
+    [[nodiscard]] bool IsExclusive() const noexcept { return m_exclusive; }
+    [[nodiscard]] ComponentMask Reads()  const noexcept { return m_reads;  }
+    [[nodiscard]] ComponentMask Writes() const noexcept { return m_writes; }
+
+    [[nodiscard]] bool ConflictsWith(const SystemAccess& o) const noexcept {
+        return m_exclusive || o.m_exclusive
+            || (m_writes & (o.m_reads | o.m_writes)) != 0
+            || (o.m_writes & m_reads) != 0;
+    }
+
+    // Create every declared pool so concurrent systems never grow the
+    // Registry's pool table (which is not thread-safe).
+    void EnsurePools(Registry& reg) const {
+        for (auto fn : m_pools) fn(reg);
+    }
+
+private:
+    template<typename T>
+    static void EnsurePool(Registry& reg) { (void)reg.Pool<T>(); }
+
+    ComponentMask                    m_reads     = 0;
+    ComponentMask                    m_writes    = 0;
+    bool                             m_exclusive = false;
+    std::vector<void (*)(Registry&)> m_pools;
+};
 
 // ---------------------------------------------------------------------------
 // System — base class for all ECS systems.
@@ -17,7 +79,7 @@ class Registry;
 //   public:
 //       void Update(Registry& reg, float dt) override {
 //           reg.View<TransformComponent, VelocityComponent>(
-//               [dt](EntityId, TransformComponent& t, VelocityComponent& v) {
+//               [dt](EntityId, TransformRef t, VelocityRef v) {
 //                   t.position = Vector3Add(t.position,
 //                       Vector3Scale(v.linear, dt));
 //               });
@@ -26,8 +88,16 @@ class Registry;
 //
 // Recommended ownership
 // ---------------------
-//   Store systems in a SystemManager or std::vector<std::unique_ptr<System>>
-//   and call Update on each one per frame from the scene's Update() method.
+//   Add systems to a SystemScheduler (<ECS/SystemScheduler.hpp>) and call its
+//   Update once per frame from the scene's Update() method.  Override
+//   DeclareAccess so the scheduler can run the system alongside others that
+//   touch different components; without it the system runs alone.
+//
+// Structural changes
+// ------------------
+//   Under the scheduler, systems of one stage run concurrently, so Update
+//   must not create / destroy entities or add / remove components directly.
+//   Record them into Commands(); the scheduler flushes after each stage.
 // ---------------------------------------------------------------------------
 
 class System {
@@ -38,6 +108,9 @@ public:
     // dt — delta time in seconds.
     virtual void Update(Registry& reg, float dt) = 0;
 
+    // Declare the components Update touches.  The default is Exclusive().
+    virtual void DeclareAccess(SystemAccess& access) const { access.Exclusive(); }
+
     // Optional: called once during scene Init to perform one-time setup.
     virtual void Init(Registry& /*reg*/) {}
 
@@ -48,8 +121,19 @@ public:
     void  SetEnabled(bool enabled) noexcept { m_enabled = enabled; }
     [[nodiscard]] bool IsEnabled() const noexcept { return m_enabled; }
 
+protected:
+    // Deferred structural changes for the current Update.  Only valid while
+    // the system is being run by a SystemScheduler.
+    [[nodiscard]] CommandBuffer& Commands() {
+        assert(m_commands && "System::Commands — only available under a SystemScheduler");
+        return *m_commands;
+    }
+
 private:
-    bool m_enabled = true;
+    friend class SystemScheduler;
+
+    bool           m_enabled  = true;
+    CommandBuffer* m_commands = nullptr;
 };
 
 } // namespace Hotones::ECS
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <ECS/System.hpp>
+#include <ECS/Registry.hpp>
+#include <ECS/CommandBuffer.hpp>
+#include <Jobs/JobSystem.hpp>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// SystemScheduler — runs a set of Systems each frame, in parallel where
+// their declared component access allows it.
+//
+// Systems are added in the order they should run.  From each system's
+// SystemAccess the scheduler builds a dependency graph: a system depends on
+// every earlier system it conflicts with (see SystemAccess::ConflictsWith).
+// Systems are then grouped into stages by their depth in that graph, so a
+// stage only ever holds mutually non-conflicting systems.  Stages run one
+// after another; the systems inside a stage run concurrently on the shared
+// Jobs::JobSystem.
+//
+// Usage
+// -----
+//   SystemScheduler systems;
+//   systems.Add<LifetimeSystem>();
+//   systems.Add<MyHealthSystem>();    // disjoint access → same stage
+//   systems.Init(reg);
+//   ...
+//   systems.Update(reg, dt);          // once per frame
+//   ...
+//   systems.Shutdown(reg);
+//
+// Structural changes recorded into System::Commands() are flushed into the
+// Registry after every stage, so the next stage sees them.
+// ---------------------------------------------------------------------------
+class SystemScheduler {
+public:
+    SystemScheduler() = default;
+
+    SystemScheduler(const SystemScheduler&)            = delete;
+    SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+    // Construct and append a system of type S.  Returns a reference that
+    // stays valid until Clear().
+    template<typename S, typename... Args>
+    S& Add(Args&&... args) {
+        auto system = std::make_unique<S>(std::forward<Args>(args)...);
+        S& ref = *system;
+        Add(std::move(system));
+        return ref;
+    }
+
+    System& Add(std::unique_ptr<System> system) {
+        system->m_commands = &m_commands;
+        m_systems.push_back({ std::move(system), {} });
+        m_dirty = true;
+        return *m_systems.back().system;
+    }
+
+    // Call System::Init on every system, in order.
+    void Init(Registry& reg) {
+        for (auto& e : m_systems) e.system->Init(reg);
+    }
+
+    // Run every enabled system once, stage by stage.
+    void Update(Registry& reg, float dt) {
+        if (m_dirty) Rebuild();
+        for (const auto& e : m_systems) e.access.EnsurePools(reg);
+
+        auto& jobs = Jobs::JobSystem::Get();
+        std::vector<System*> batch;
+        for (const auto& stage : m_stages) {
+            batch.clear();
+            for (size_t i : stage)
+                if (m_systems[i].system->IsEnabled()) batch.push_back(m_systems[i].system.get());
+            if (batch.empty()) continue;
+
+            // The calling thread runs the first system of the stage itself.
+            Jobs::JobCounter counter;
+            for (size_t i = 1; i < batch.size(); ++i) {
+                System* s = batch[i];
+                jobs.Submit([s, &reg, dt] { s->Update(reg, dt); }, &counter);
+            }
+            batch[0]->Update(reg, dt);
+            jobs.Wait(counter);
+
+            m_commands.Flush(reg);
+        }
+    }
+
+    // Call System::Shutdown on every system, in reverse order, and drop any
+    // commands that were never flushed.
+    void Shutdown(Registry& reg) {
+        for (auto it = m_systems.rbegin(); it != m_systems.rend(); ++it)
+            it->system->Shutdown(reg);
+        m_commands.Reset();
+    }
+
+    // Remove every system (does not call Shutdown).
+    void Clear() {
+        m_systems.clear();
+        m_stages.clear();
+        m_commands.Reset();
+        m_dirty = true;
+    }
+
+    [[nodiscard]] size_t SystemCount() const noexcept { return m_systems.size(); }
+
+    // Number of stages in the current schedule (rebuilt lazily by Update).
+    [[nodiscard]] size_t StageCount() {
+        if (m_dirty) Rebuild();
+        return m_stages.size();
+    }
+
+private:
+    struct Entry {
+        std::unique_ptr<System> system;
+        SystemAccess            access;
+    };
+
+    // Re-query access declarations and recompute the stages.
+    void Rebuild() {
+        std::vector<size_t> depth(m_systems.size(), 0);
+        m_stages.clear();
+        for (size_t j = 0; j < m_systems.size(); ++j) {
+            m_systems[j].access = SystemAccess{};
+            m_systems[j].system->DeclareAccess(m_systems[j].access);
+            for (size_t i = 0; i < j; ++i)
+                if (m_systems[i].access.ConflictsWith(m_systems[j].access) && depth[i] + 1 > depth[j])
+                    depth[j] = depth[i] + 1;
+            if (depth[j] >= m_stages.size()) m_stages.resize(depth[j] + 1);
+            m_stages[depth[j]].push_back(j);
+        }
+        m_dirty = false;
+    }
+
+    std::vector<Entry>               m_systems;  // registration order
+    std::vector<std::vector<size_t>> m_stages;   // indices into m_systems
+    CommandBuffer                    m_commands; // shared by every system, flushed per stage
+    bool                             m_dirty = true;
+};
+
+} // namespace Hotones::ECS
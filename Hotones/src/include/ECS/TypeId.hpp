@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// ComponentTypeId — dense, per-process integer id for a component type.
+//
+// Ids are handed out 0, 1, 2, ... the first time each type is queried and
+// never change afterwards, so they can index flat arrays (the Registry keeps
+// one IPool* slot per id).  Unlike std::type_index there is no hashing: the
+// id is a single guarded static load that the compiler hoists out of loops.
+//
+// Ids are NOT stable across runs or builds — never persist or send them over
+// the network; use a name-based key for that.
+// ---------------------------------------------------------------------------
+
+using ComponentTypeId = uint32_t;
+
+// Per-entity component signature: bit N is set when the entity owns the
+// component whose ComponentTypeId is N.  A plain 64-bit word keeps the
+// signature test a single AND, so a Registry supports at most
+// MAX_COMPONENT_TYPES distinct component types per process; querying the
+// id of one type more aborts, in every build, rather than hand out an id
+// the mask can't hold.
+using ComponentMask = uint64_t;
+inline constexpr ComponentTypeId MAX_COMPONENT_TYPES = 64;
+
+[[nodiscard]] constexpr ComponentMask ComponentBit(ComponentTypeId id) noexcept {
+    return ComponentMask(1) << id;
+}
+
+namespace detail {
+
+[[nodiscard]] inline ComponentTypeId NextComponentTypeId() noexcept {
+    static std::atomic<ComponentTypeId> s_next{0};
+    const ComponentTypeId id = s_next.fetch_add(1u, std::memory_order_relaxed);
+    if (id >= MAX_COMPONENT_TYPES) {
+        std::fprintf(stderr, "ECS: more than %u component types, ComponentMask can't hold them\n",
+                     (unsigned)MAX_COMPONENT_TYPES);
+        std::abort();
+    }
+    return id;
+}
+
+template<typename T>
+struct ComponentTypeIdHolder {
+    [[nodiscard]] static ComponentTypeId Get() noexcept {
+        static const ComponentTypeId s_id = NextComponentTypeId();
+        return s_id;
+    }
+};
+
+} // namespace detail
+
+// Id for component type T (cv-qualifiers and references are ignored, so
+// T, const T and T& share one id).
+template<typename T>
+[[nodiscard]] inline ComponentTypeId ComponentType() noexcept {
+    return detail::ComponentTypeIdHolder<std::remove_cvref_t<T>>::Get();
+}
+
+} // namespace Hotones::ECS
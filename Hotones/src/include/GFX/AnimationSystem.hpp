@@ -0,0 +1,147 @@
+#pragma once
+#include <ECS/System.hpp>
+#include <ECS/Components.hpp>
+#include <GFX/Culling.hpp>
+#include <GFX/RenderQueue.hpp>
+#include <GFX/SceneImporter.hpp>
+#include <raylib.h>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// ─── AnimationSystem ──────────────────────────────────────────────────────────
+//
+// Plays and draws every SkinnedModelComponent.  Each tick advances the
+// characters' clips; a character's pose — the bone matrices its skinned
+// meshes are drawn with, skinned on the GPU by
+// LightingSystem::GetSkinnedShader() — is only rebuilt when it is due.
+// How often, and with how many bones, follows the distance from the view
+// given to SetView() (animation level of detail; see SetBands()):
+//   near         every tick, every bone
+//   middle       20 times a second, about half the bones
+//   far          10 times a second, about a quarter
+//   beyond, or outside the view   4 times a second, a quarter
+// Dropped bones are posed as their nearest kept ancestor (see
+// SceneSkin::lodBones), so a far hand moves as one with its fingers.  A
+// character between poses is drawn in its last one, wherever it has since
+// moved.
+//
+// Due poses are evaluated in parallel on the JobSystem: the clip is sampled
+// for the nodes the level needs (ImportedScene::poseNodes), composed down
+// the node tree, and each bone's matrix is its offset, then its node, then
+// back out of the mesh's own placement.
+//
+// Capture() copies the characters' placements and poses into a Frame, so a
+// pipelined scene can snapshot them on the simulation thread and draw them
+// later (see FramePipeline).  Draw() submits every skinned mesh of each
+// character in view to a RenderQueue; each is its own draw, as its bones
+// are its own.  Bounds are the bind pose's, grown a little: poses stray.
+//
+// Add it to the scheduler after the movers (characters are drawn where this
+// tick put them), set the view before each tick, and draw with the rest of
+// the opaque geometry:
+//   m_animation = &m_systems.Add<GFX::AnimationSystem>();
+//   ...
+//   m_animation->SetView(camera, aspect);   // before m_systems.Update()
+//   m_animation->Draw(frame, frustum, queue);
+
+namespace Hotones::GFX {
+
+class OcclusionCuller;
+
+class AnimationSystem : public ECS::System {
+public:
+    // Characters nearer than `distance` are posed every `interval` seconds
+    // (0: every tick) at animation LOD `level` (< SKIN_LOD_LEVELS)
+    struct Band {
+        float distance = 0.f;
+        float interval = 0.f;
+        int   level    = 0;
+    };
+
+    struct Stats {
+        int characters = 0;   // animated by the last Update()
+        int posed      = 0;   // of which re-posed
+        int bones      = 0;   // bone matrices those poses computed
+        int drawn      = 0;   // characters drawn by the last Draw()
+        int culled     = 0;   // outside the frustum
+        int occluded   = 0;   // hidden behind occluders
+        int drawCalls  = 0;
+    };
+
+    void DeclareAccess(ECS::SystemAccess& access) const override {
+        // Write: the clip's time is advanced
+        access.Read<ECS::TransformComponent>().Write<ECS::SkinnedModelComponent>();
+    }
+
+    void Update(ECS::Registry& reg, float dt) override;
+    void Shutdown(ECS::Registry& /*reg*/) override { Clear(); }
+
+    // The camera that picks each character's band; until set, every
+    // character is posed every tick in full
+    void SetView(const Camera& camera, float aspect);
+    // Nearest first; characters past the last band, or out of view, are
+    // posed as `beyond`
+    void SetBands(std::vector<Band> bands, Band beyond);
+
+    // Characters as of one Update(), for drawing later
+    struct Frame {
+        struct Character {
+            std::shared_ptr<const ImportedScene> rig;
+            Matrix      world  = {};
+            Color       tint   = WHITE;
+            BoundingBox bounds = {};
+            size_t      first  = 0;   // into palettes: each skinned mesh's bones in turn
+        };
+        std::vector<Character> characters;
+        std::vector<Matrix>    palettes;
+
+        void Clear() { characters.clear(); palettes.clear(); }
+    };
+
+    // Replace `out` with the characters now.  Not during Update().
+    void Capture(Frame& out) const;
+    // Submit the characters in `frustum` (and not hidden, given `occlusion`)
+    void Draw(const Frame& frame, const Frustum& frustum, RenderQueue& queue,
+              const OcclusionCuller* occlusion = nullptr);
+
+    const Stats& GetStats() const { return m_stats; }
+
+    // Drop every character (and the rigs they hold)
+    void Clear() { m_characters.clear(); m_due.clear(); m_meshes.clear(); }
+
+private:
+    struct Character {
+        std::shared_ptr<const ImportedScene> rig;
+        BoundingBox         rigBounds = {};   // its skinned meshes', grown
+        std::vector<Matrix> palette;          // each skinned mesh's bones in turn
+        int         clip      = 0;
+        float       time      = 0.f;
+        int         level     = 0;            // of the pose being made
+        float       sincePose = 0.f;          // seconds
+        bool        posed     = false;
+        Matrix      world     = {};
+        Color       tint      = WHITE;
+        bool        visible   = true;
+        BoundingBox bounds    = {};
+        uint64_t    seenTick  = 0;
+    };
+
+    static void Pose(Character& c);
+
+    static constexpr size_t GRAIN = 4;   // characters per job
+
+    uint64_t m_tick = 0;
+    std::unordered_map<ECS::EntityId, Character> m_characters;
+    std::vector<Character*> m_due;      // this tick's, reused
+    std::vector<Mesh>       m_meshes;   // this frame's draws; the queue points at them
+    std::vector<Band> m_bands = { { 10.f, 0.f, 0 }, { 30.f, 1.f / 20.f, 1 }, { 80.f, 1.f / 10.f, 2 } };
+    Band     m_beyond  = { 0.f, 1.f / 4.f, 2 };
+    bool     m_hasView = false;
+    Vector3  m_viewPos = {};
+    Frustum  m_viewFrustum;
+    Stats    m_stats;
+};
+
+} // namespace Hotones::GFX
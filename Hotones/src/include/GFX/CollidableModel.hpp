@@ -1,15 +1,38 @@
 #pragma once
 #include "raylib.h"
+#include <Assets/AssetCache.hpp>
+#include <GFX/Culling.hpp>
+#include <GFX/OcclusionCulling.hpp>
+#include <GFX/RenderQueue.hpp>
+#include <Physics/PhysicsSystem.hpp>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace Hotones {
 
+class BSPWorld;
+
 class CollidableModel {
 public:
     CollidableModel(const std::string& path, Vector3 position = {0,0,0});
     ~CollidableModel();
 
     void Draw();
+    // Draw only the meshes whose bounds reach into `frustum`.
+    void Draw(const GFX::Frustum& frustum);
+    // Submit them to `queue` instead, to be drawn sorted at its Flush();
+    // with `occlusion`, only those it does not find hidden.
+    void Draw(const GFX::Frustum& frustum, GFX::RenderQueue& queue,
+              const GFX::OcclusionCuller* occlusion = nullptr);
+    // The same seen from `viewPos`: for a ".bsp" world, only the faces in the
+    // PVS of the leaf holding `viewPos` (see BSPWorld), which already leaves
+    // out what walls hide; otherwise as above.
+    void Draw(Vector3 viewPos, const GFX::Frustum& frustum, GFX::RenderQueue& queue,
+              const GFX::OcclusionCuller* occlusion = nullptr);
+    // Submit the opaque meshes in `frustum` big enough to hide others
+    // (OCCLUDER_MIN_SIZE), for OcclusionCuller's depth pre-pass.
+    void DrawOccluders(const GFX::Frustum& frustum, GFX::RenderQueue& queue);
     void SetPosition(Vector3 pos);
     Vector3 GetPosition() const;
     BoundingBox GetBoundingBox() const;
@@ -26,7 +49,21 @@ public:
     // `hitPos` (position at impact), `hitNormal` (surface normal), and `t` (0..1 param along segment).
     bool SweepSphere(const Vector3 &start, const Vector3 &end, float radius, Vector3 &hitPos, Vector3 &hitNormal, float &t);
 
+    // Move a sphere by `motion`, sliding along the mesh, then resolve any
+    // residual overlap (see Physics::SlideSphereAgainstStatic).  One BVH walk
+    // for the whole move instead of one per sweep.
+    Physics::SlideResult SlideSphere(const Vector3 &start, const Vector3 &motion, float radius,
+                                     const Physics::SlideParams &params = {}, Vector3 *velocity = nullptr);
+
+    // The collision BVH builds in the background after construction; until
+    // it is ready the two queries above report no contact.  WaitForPhysics
+    // blocks until it is (see Physics::WaitForMeshes) and returns false if
+    // the model has no collision mesh or the wait timed out.
+    bool IsPhysicsReady() const;
+    bool WaitForPhysics(float timeoutSeconds = -1.f) const;
+
     // Apply a custom shader to all materials in this model (e.g. lit shader).
+    // Models come from the AssetCache, so other loads of the file change too.
     void SetShader(Shader shader);
 
     // Debug drawing: draw per-mesh AABBs and last sweep info
@@ -38,11 +75,17 @@ public:
 
 private:
     Model model = {0};
+    Assets::ModelHandle asset;             // what `model` copies; null for BSP worlds
     Vector3 position = {0,0,0};
     BoundingBox bbox;
+    std::vector<BoundingBox> meshBounds;   // world-space, per mesh
+    GFX::CullingBVH cullTree;              // over meshBounds
+    std::unique_ptr<BSPWorld> bsp;         // leaves and PVS, for ".bsp" files
     void UpdateBoundingBox();
-    // Handle returned by the physics system when registering this model's static mesh
+    // The physics instance of this model's collision shape, and the shape's
+    // key among the shared ones (see CollidableModel.cpp)
     int physicsHandle = -1;
+    const Mesh* shapeKey = nullptr;
 
     // Debug state for last sweep
     bool debug = false;
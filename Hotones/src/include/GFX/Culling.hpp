@@ -0,0 +1,207 @@
+#pragma once
+#include <raylib.h>
+#include <raymath.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// ─── Culling ──────────────────────────────────────────────────────────────────
+//
+// View-frustum culling for draw code.
+//
+//   Frustum     — the six planes of a camera's view volume, and box tests
+//                 against them (outside / intersecting / wholly inside).
+//   TransformBox — a local AABB carried through a model matrix, still axis
+//                 aligned (so a little looser than the true box).
+//   CullingBVH  — a static AABB tree over items that do not move (imported
+//                 scene meshes, world model meshes).  Query() skips whole
+//                 subtrees outside the frustum and accepts subtrees wholly
+//                 inside it without testing their items one by one.
+//
+// Typical use, once per frame before BeginMode3D:
+//   const auto frustum = GFX::Frustum::FromCamera(camera, (float)GetScreenWidth() / GetScreenHeight());
+//   scene->Draw(frustum);
+
+namespace Hotones::GFX {
+
+// Near / far planes BeginMode3D uses (rlgl's RL_CULL_DISTANCE_NEAR / _FAR)
+constexpr float CULL_NEAR = 0.01f;
+constexpr float CULL_FAR  = 1000.0f;
+
+enum class Containment { Outside, Intersects, Inside };
+
+struct Frustum {
+    // (a, b, c, d) with the normal pointing inwards: inside when
+    // a·x + b·y + c·z + d >= 0.  Left, right, bottom, top, near, far.
+    Vector4 planes[6] = {};
+
+    // From view × projection, i.e. MatrixMultiply(view, projection) in
+    // raylib's order (Gribb–Hartmann plane extraction).
+    static Frustum FromMatrix(Matrix vp) {
+        const float r0[4] = { vp.m0, vp.m4, vp.m8,  vp.m12 };
+        const float r1[4] = { vp.m1, vp.m5, vp.m9,  vp.m13 };
+        const float r2[4] = { vp.m2, vp.m6, vp.m10, vp.m14 };
+        const float r3[4] = { vp.m3, vp.m7, vp.m11, vp.m15 };
+        Frustum f;
+        const auto set = [&](int i, const float* row, float sign) {
+            Vector4 p = { r3[0] + sign * row[0], r3[1] + sign * row[1],
+                          r3[2] + sign * row[2], r3[3] + sign * row[3] };
+            const float len = sqrtf(p.x * p.x + p.y * p.y + p.z * p.z);
+            if (len > 0.f) { p.x /= len; p.y /= len; p.z /= len; p.w /= len; }
+            f.planes[i] = p;
+        };
+        set(0, r0,  1.f); set(1, r0, -1.f);
+        set(2, r1,  1.f); set(3, r1, -1.f);
+        set(4, r2,  1.f); set(5, r2, -1.f);
+        return f;
+    }
+
+    // The volume BeginMode3D(camera) draws into, for a target of the given
+    // width / height.
+    static Frustum FromCamera(const Camera& camera, float aspect,
+                              float nearZ = CULL_NEAR, float farZ = CULL_FAR) {
+        const Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+        Matrix proj;
+        if (camera.projection == CAMERA_ORTHOGRAPHIC) {
+            const double top   = camera.fovy / 2.0;
+            const double right = top * aspect;
+            proj = MatrixOrtho(-right, right, -top, top, nearZ, farZ);
+        } else {
+            proj = MatrixPerspective(camera.fovy * DEG2RAD, aspect, nearZ, farZ);
+        }
+        return FromMatrix(MatrixMultiply(view, proj));
+    }
+
+    [[nodiscard]] Containment Classify(const BoundingBox& box) const {
+        bool inside = true;
+        for (const Vector4& p : planes) {
+            // Corner furthest along the normal, and the one furthest against it
+            const Vector3 pos = { p.x >= 0.f ? box.max.x : box.min.x,
+                                  p.y >= 0.f ? box.max.y : box.min.y,
+                                  p.z >= 0.f ? box.max.z : box.min.z };
+            const Vector3 neg = { p.x >= 0.f ? box.min.x : box.max.x,
+                                  p.y >= 0.f ? box.min.y : box.max.y,
+                                  p.z >= 0.f ? box.min.z : box.max.z };
+            if (p.x * pos.x + p.y * pos.y + p.z * pos.z + p.w < 0.f) return Containment::Outside;
+            if (p.x * neg.x + p.y * neg.y + p.z * neg.z + p.w < 0.f) inside = false;
+        }
+        return inside ? Containment::Inside : Containment::Intersects;
+    }
+
+    [[nodiscard]] bool Intersects(const BoundingBox& box) const {
+        return Classify(box) != Containment::Outside;
+    }
+};
+
+// `local` carried through `m`, as the AABB of the transformed box (Arvo).
+inline BoundingBox TransformBox(const BoundingBox& local, const Matrix& m) {
+    const Vector3 c = { (local.min.x + local.max.x) * 0.5f,
+                        (local.min.y + local.max.y) * 0.5f,
+                        (local.min.z + local.max.z) * 0.5f };
+    const Vector3 e = { (local.max.x - local.min.x) * 0.5f,
+                        (local.max.y - local.min.y) * 0.5f,
+                        (local.max.z - local.min.z) * 0.5f };
+    const Vector3 wc = Vector3Transform(c, m);
+    const Vector3 we = {
+        fabsf(m.m0) * e.x + fabsf(m.m4) * e.y + fabsf(m.m8)  * e.z,
+        fabsf(m.m1) * e.x + fabsf(m.m5) * e.y + fabsf(m.m9)  * e.z,
+        fabsf(m.m2) * e.x + fabsf(m.m6) * e.y + fabsf(m.m10) * e.z,
+    };
+    return { Vector3Subtract(wc, we), Vector3Add(wc, we) };
+}
+
+// ─── CullingBVH ───────────────────────────────────────────────────────────────
+
+class CullingBVH {
+public:
+    static constexpr int MAX_LEAF  = 4;
+    static constexpr int MAX_DEPTH = 48;
+
+    // Build over boxes[i], one item per box; Query() reports indices into
+    // `boxes`.  Rebuild when the items change.
+    void Build(const std::vector<BoundingBox>& boxes) {
+        m_nodes.clear();
+        m_items.resize(boxes.size());
+        for (size_t i = 0; i < boxes.size(); ++i) m_items[i] = { boxes[i], (uint32_t)i };
+        if (m_items.empty()) return;
+        m_nodes.reserve(m_items.size() * 2);
+        BuildNode(0, (int)m_items.size(), 0);
+    }
+
+    void Clear() { m_nodes.clear(); m_items.clear(); }
+
+    [[nodiscard]] size_t Size() const { return m_items.size(); }
+
+    // fn(index) for every item whose box is not wholly outside `frustum`,
+    // in no particular order.
+    template<typename Fn>
+    void Query(const Frustum& frustum, Fn&& fn) const {
+        if (m_nodes.empty()) return;
+        int stack[MAX_DEPTH + 1];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node& n = m_nodes[stack[--top]];
+            const Containment c = frustum.Classify(n.box);
+            if (c == Containment::Outside) continue;
+            if (c == Containment::Inside || n.right < 0) {
+                const bool test = c != Containment::Inside;
+                for (int i = n.start; i < n.start + n.count; ++i)
+                    if (!test || frustum.Intersects(m_items[i].box)) fn(m_items[i].index);
+                continue;
+            }
+            stack[top++] = n.right;
+            stack[top++] = (int)(&n - m_nodes.data()) + 1;
+        }
+    }
+
+private:
+    struct Item {
+        BoundingBox box;
+        uint32_t    index;
+    };
+    struct Node {
+        BoundingBox box;
+        int start = 0, count = 0;   // items in the whole subtree
+        int right = -1;             // -1 → leaf; the left child is this + 1
+    };
+
+    static Vector3 Center(const BoundingBox& b) {
+        return { (b.min.x + b.max.x) * 0.5f, (b.min.y + b.max.y) * 0.5f, (b.min.z + b.max.z) * 0.5f };
+    }
+
+    int BuildNode(int start, int end, int depth) {
+        const int idx = (int)m_nodes.size();
+        m_nodes.push_back({});
+        BoundingBox box = { {  FLT_MAX,  FLT_MAX,  FLT_MAX }, { -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+        for (int i = start; i < end; ++i) {
+            box.min = Vector3Min(box.min, m_items[i].box.min);
+            box.max = Vector3Max(box.max, m_items[i].box.max);
+        }
+        m_nodes[idx].box   = box;
+        m_nodes[idx].start = start;
+        m_nodes[idx].count = end - start;
+        if (end - start <= MAX_LEAF || depth >= MAX_DEPTH - 1) return idx;
+
+        // Median of the centres along the longest axis
+        const Vector3 ext  = Vector3Subtract(box.max, box.min);
+        const int     axis = (ext.x > ext.y && ext.x > ext.z) ? 0 : (ext.y > ext.z ? 1 : 2);
+        const int     mid  = start + (end - start) / 2;
+        std::nth_element(m_items.begin() + start, m_items.begin() + mid, m_items.begin() + end,
+                         [axis](const Item& a, const Item& b) {
+                             const Vector3 ca = Center(a.box), cb = Center(b.box);
+                             return (&ca.x)[axis] < (&cb.x)[axis];
+                         });
+        BuildNode(start, mid, depth + 1);   // always idx + 1
+        const int right = BuildNode(mid, end, depth + 1);
+        m_nodes[idx].right = right;
+        return idx;
+    }
+
+    std::vector<Node> m_nodes;
+    std::vector<Item> m_items;
+};
+
+} // namespace Hotones::GFX
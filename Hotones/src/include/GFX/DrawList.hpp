@@ -0,0 +1,95 @@
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ─── DrawList ─────────────────────────────────────────────────────────────────
+//
+// Immediate-mode draws written down to be issued later, possibly on another
+// thread: what a pipelined scene's Lua draw3D() / draw() produce on the
+// simulation thread, replayed by the main thread when it draws that
+// snapshot (see FramePipeline).  Recording touches no GL state.
+//
+// While a list is the calling thread's recording target (a Scope),
+// Renderer's calls and Lua's mesh.* write to it instead of drawing, so the
+// same script code works either way.  Replay() issues the commands in the
+// order given; solids go to a PrimitiveBatch when one is passed, to be
+// drawn at its Flush().
+//
+//   GFX::DrawList hud;
+//   {
+//       GFX::DrawList::Scope rec(hud);
+//       script.draw();                  // render.drawText(...) is recorded
+//   }
+//   ...
+//   hud.Replay(nullptr);                // later, on the main thread
+
+namespace Hotones::GFX {
+
+class PrimitiveBatch;
+
+class DrawList {
+public:
+    // The calling thread's recording target, null when draws go straight out
+    static DrawList* Recording();
+
+    // Records the calling thread's draws into `list` for its lifetime
+    class Scope {
+    public:
+        explicit Scope(DrawList& list);
+        ~Scope();
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        DrawList* m_previous;
+    };
+
+    // Forget every command; capacity is kept
+    void Clear() { m_commands.clear(); m_text.clear(); }
+    [[nodiscard]] bool   Empty() const { return m_commands.empty(); }
+    [[nodiscard]] size_t Size()  const { return m_commands.size(); }
+
+    // 2-D, screen space
+    void ClearScreen(Color color);
+    void Text(std::string_view text, int x, int y, int fontSize, Color color);
+    void Rect(int x, int y, int width, int height, Color color);
+
+    // 3-D, inside BeginMode3D at replay; as the raylib call of the same name
+    void Line3D(Vector3 start, Vector3 end, Color color);
+    void CubeWires(Vector3 centre, Vector3 size, Color color);
+    void Grid(int slices, float spacing);
+    // Solids, as PrimitiveBatch takes them
+    void Box(Vector3 centre, Vector3 size, Color color);
+    void Plane(Vector3 centre, Vector2 size, Color color);
+    void Sphere(Vector3 centre, float radius, int rings, int slices, Color color);
+    void Cylinder(Vector3 base, float radiusTop, float radiusBottom, float height, int slices, Color color);
+
+    // Issue every command.  Solids go to `batch` when it is ready, else to
+    // raylib's immediate primitives.  Main thread.
+    void Replay(PrimitiveBatch* batch) const;
+
+private:
+    enum class Op : uint8_t {
+        ClearScreen, Text, Rect, Line3D, CubeWires, Grid, Box, Plane, Sphere, Cylinder
+    };
+    struct Command {
+        Op       op    = Op::ClearScreen;
+        Color    color = WHITE;
+        Vector3  a     = { 0.f, 0.f, 0.f };   // start / centre; x is the font size of Text
+        Vector3  b     = { 0.f, 0.f, 0.f };   // end / size; radii and height for a cylinder
+        int      n0    = 0;                   // rings / slices / grid slices / x
+        int      n1    = 0;                   // slices / y
+        uint32_t text  = 0;                   // into m_text
+        uint32_t textLength = 0;
+    };
+
+    Command& Add(Op op, Color color);
+
+    std::vector<Command> m_commands;
+    std::string          m_text;   // every Text()'s string, back to back
+};
+
+} // namespace Hotones::GFX
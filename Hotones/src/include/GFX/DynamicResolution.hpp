@@ -0,0 +1,113 @@
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+
+// ─── DynamicResolution ────────────────────────────────────────────────────────
+//
+// Singleton that trades the 3-D pass's resolution for frame time.  While on,
+// the 3-D pass draws into a pooled render target (RenderTargetPool) of the
+// screen size times a scale, then is stretched over the screen before the
+// HUD and debug UI, which stay at native resolution.
+//
+// The scale follows the GPU's own time for each frame, read with GL
+// timestamp queries a few frames after it was drawn, against a target frame
+// time: a frame over budget drops the scale straight to what should fit
+// (time taken goes roughly with pixels drawn, so with the scale squared); a
+// frame with room to spare raises it a step at a time, after a pause, so it
+// doesn't hunt.  Scales are multiples of Settings::step, so the pool serves
+// the few target sizes used again rather than making one each change.
+//
+// The GPU time of a frame that waited on the CPU includes the wait, so a
+// CPU-bound frame lowers the scale too; the CPU's own frame time doesn't
+// change with it.
+//
+// Needs OpenGL 3.3 timestamp queries; without them (Init() false) the scale
+// stays at Settings::maxScale.  Drawing into some other target already (a
+// scene transition's) the pass isn't redirected, nor at scale 1.
+//
+// The main loop brackets each frame's drawing; scenes bracket their 3-D
+// pass, from before anything that lays out screen-sized work (clustered
+// lights, shadows) to before the HUD:
+//   auto& resolution = GFX::DynamicResolution::Get();
+//   BeginDrawing();  resolution.BeginFrame();
+//       resolution.Begin3D();   ClearBackground(BLACK);
+//       ls.UploadUniforms(camera, rlGetFramebufferWidth(), rlGetFramebufferHeight());
+//       BeginMode3D(camera); ... EndMode3D();
+//       resolution.End3D();
+//       ... HUD ...
+//   resolution.EndFrame();  EndDrawing();
+
+namespace Hotones::GFX {
+
+class DynamicResolution {
+public:
+    struct Settings {
+        bool  enabled  = false;
+        float targetMs = 1000.f / 60.f;   // GPU time a frame should take
+        float headroom = 0.9f;            // aim for this share of it
+        float minScale = 0.5f;            // of the screen's width and height
+        float maxScale = 1.f;
+        float step     = 0.05f;           // scales are multiples of this
+    };
+
+    struct Stats {
+        float scale  = 1.f;    // the 3-D pass's, now
+        int   width  = 0;      // its target's size; 0 → drawn to the screen
+        int   height = 0;
+        float gpuMs  = 0.f;    // last frame time read back, smoothed
+        int   changes = 0;     // scale changes so far
+    };
+
+    // ── Singleton ─────────────────────────────────────────────────────────────
+    static DynamicResolution& Get();
+
+    DynamicResolution(const DynamicResolution&)            = delete;
+    DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+    // Look up the timer queries; after InitWindow().  False when the GL
+    // doesn't have them.
+    bool Init();
+    // Release the target and the queries; before CloseWindow()
+    void Unload();
+    bool HasTimers() const { return m_ready; }
+
+    void            SetSettings(const Settings& settings);
+    const Settings& GetSettings() const { return m_settings; }
+    const Stats&    GetStats()    const { return m_stats; }
+
+    // Bracket a frame's drawing: after BeginDrawing(), before EndDrawing()
+    void BeginFrame();
+    void EndFrame();
+
+    // Redirect the 3-D pass into the scaled target; true if it was (its
+    // contents are last frame's: clear it).  End3D() stretches it over the
+    // screen.  Not nested.
+    bool Begin3D();
+    void End3D();
+
+private:
+    DynamicResolution() = default;
+
+    void Adjust(float gpuMs);   // a frame's time read back
+
+    static constexpr int TIMED_FRAMES = 4;   // frames in flight, each with a start and end query
+
+    struct TimedFrame {
+        unsigned queries[2] = {};
+        uint64_t frame      = 0;
+        bool     pending    = false;
+    };
+
+    Settings        m_settings;
+    Stats           m_stats;
+    bool            m_ready   = false;
+    TimedFrame      m_frames[TIMED_FRAMES];
+    int             m_current = -1;       // frame being timed, -1 → none
+    uint64_t        m_frame   = 0;
+    int             m_sinceChange = 0;    // frames read back since the scale last changed
+    float           m_scale   = 1.f;
+    RenderTexture2D m_target  = {};       // from RenderTargetPool
+    bool            m_active  = false;    // between a redirecting Begin3D() and End3D()
+};
+
+} // namespace Hotones::GFX
@@ -0,0 +1,80 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// ─── FramePipeline ────────────────────────────────────────────────────────────
+//
+// Overlaps a frame's simulation with the drawing of the one before it.  The
+// main thread keeps the window, the GL context and input; a simulation
+// thread runs the step main.cpp hands it (fixed ticks, then the scene's
+// Update()), which ends by filling the scene's back render state.  Meanwhile
+// the main thread draws the front state, the snapshot the previous step
+// published.  Finish() waits for the step, after which the scene publishes
+// its new state and everything else (transitions, networking, ImGui) runs
+// with the simulation idle, as in a serial frame.
+//
+// So a frame costs max(simulate, draw) rather than their sum, and what is
+// drawn is one step old: a frame of extra latency, the usual price.
+//
+// While a step runs, the main thread serves Jobs::MainThread from Finish():
+// GPU uploads the step asks for (AssetCache loads from Lua) run there, once
+// the frame is drawn.
+//
+// Only scenes that keep their render state apart from their simulation
+// state (Scene::SupportsPipelining()) can be pipelined; main.cpp runs the
+// others serially.
+//
+//   pipeline.Begin([&] { Simulate(); });   // on the simulation thread
+//   BeginDrawing(); scene->Draw(); ...      // the last published state
+//   pipeline.Finish();
+//   scene->PublishRenderState();
+
+namespace Hotones::GFX {
+
+class FramePipeline {
+public:
+    struct Stats {
+        double simMs  = 0.0;   // the last step, on the simulation thread
+        double waitMs = 0.0;   // the main thread waited for it in Finish()
+    };
+
+    FramePipeline() = default;
+    ~FramePipeline() { Stop(); }
+    FramePipeline(const FramePipeline&)            = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    // Start the simulation thread.  Call on the main thread, which becomes
+    // Jobs::MainThread.  Idempotent.
+    void Start();
+    // Join the thread.  Not while a step is in flight.
+    void Stop();
+    [[nodiscard]] bool IsRunning() const { return m_thread.joinable(); }
+
+    // Run `step` on the simulation thread.  One step at a time: Finish()
+    // the last before beginning another.
+    void Begin(std::function<void()> step);
+    // Wait for the step, running main-thread work it sends meanwhile
+    void Finish();
+    [[nodiscard]] bool InFlight() const { return m_inFlight; }
+
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    void Loop();
+
+    std::thread             m_thread;
+    std::mutex              m_mutex;
+    std::condition_variable m_wake;
+    std::function<void()>   m_step;            // pending, m_mutex
+    bool                    m_stop = false;    // m_mutex
+    std::atomic<bool>       m_done{ true };    // the step finished
+    std::atomic<int64_t>    m_simNs{ 0 };
+    bool                    m_inFlight = false;
+    Stats                   m_stats;
+};
+
+} // namespace Hotones::GFX
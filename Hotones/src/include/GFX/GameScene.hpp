@@ -22,13 +22,18 @@ public:
     void Unload() override;
 
     // Expose player access for debug UI
-    Player* GetPlayer() { return &player; }
+    Player* GetPlayer() override { return &player; }
     void SetWorldDebug(bool enabled) { worldDebug = enabled; if (worldModel) worldModel->SetDebug(worldDebug); }
     bool IsWorldDebug() const { return worldDebug; }
 
     // Pass a non-owning pointer to the active NetworkManager so remote
     // players are rendered inside the scene's existing 3-D pass.
-    void SetNetworkManager(Net::NetworkManager* nm) { m_netMgr = nm; }
+    // The player predicts its own movement through it when the server
+    // moves players.
+    void SetNetworkManager(Net::NetworkManager* nm) override { m_netMgr = nm; player.AttachNetwork(nm); }
+
+    // Level collision, for the host's server-side movement
+    std::shared_ptr<CollidableModel> GetWorld() const override { return worldModel; }
 
 private:
     Hotones::Player player;
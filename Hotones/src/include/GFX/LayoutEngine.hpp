@@ -9,48 +9,85 @@ namespace Hotones::GFX {
 // Simple measured size
 struct UISize { int w = 0; int h = 0; };
 
-// UIElement: minimal interface for measure/layout/draw
+class LayoutBox;
+
+// UIElement: minimal interface for measure/layout/draw.
+//
+// Layout is retained: Measure() returns the size measured last time unless
+// the element was invalidated or is offered a different space, and Layout()
+// does nothing when neither the element nor its rectangle changed, so a
+// menu that stays as it is costs only its Draw() each frame.  Setters that
+// change an element's size call Invalidate(), which marks it and every
+// container above it for measuring again; subclasses do the work in
+// OnMeasure() / OnLayout().
 class UIElement {
 public:
     virtual ~UIElement() = default;
-    virtual UISize Measure(int availW, int availH) = 0;
-    virtual void Layout(int x, int y, int w, int h) = 0;
+
+    UISize Measure(int availW, int availH);
+    void Layout(int x, int y, int w, int h);
     virtual void Draw() = 0;
+
+    // Measure and lay out again on the next pass, this and its ancestors
+    void Invalidate();
+
+    // Assigned rectangle, from the last Layout()
+    Rectangle GetRect() const { return rect; }
+
+protected:
+    virtual UISize OnMeasure(int availW, int availH) = 0;
+    // rect is already set; place any children in it
+    virtual void OnLayout() {}
+
+    Rectangle rect{0,0,0,0};
+
+private:
+    friend class LayoutBox;
+    LayoutBox* parent = nullptr;   // the box it was added to
+    bool   measureDirty = true;
+    bool   layoutDirty  = true;
+    int    measuredAvailW = -1, measuredAvailH = -1;
+    UISize measuredSize;
 };
 
 // LabelElement: draws simple text and reports measured size
 class LabelElement : public UIElement {
 public:
     LabelElement(std::string txt, int fontSize = 16, Color col = {220,210,235,255});
-    UISize Measure(int availW, int availH) override;
-    void Layout(int x, int y, int w, int h) override;
     void Draw() override;
 
-    // Expose assigned rectangle for external use
-    Rectangle GetRect() const { return rect; }
+    void SetText(std::string txt);
+    void SetFontSize(int fontSize);
+    void SetColor(Color col) { color = col; }
+    const std::string& GetText() const { return text; }
+
+protected:
+    UISize OnMeasure(int availW, int availH) override;
 
 private:
     std::string text;
     int fs;
     Color color;
-    Rectangle rect{0,0,0,0};
+    int textW = -1;   // MeasureText() of text at fs; -1 until measured
 };
 
 // SpacerElement: reserves space but doesn't draw (useful for button targets)
 class SpacerElement : public UIElement {
 public:
     explicit SpacerElement(int height = 16);
-    UISize Measure(int availW, int availH) override;
-    void Layout(int x, int y, int w, int h) override;
     void Draw() override;
-    Rectangle GetRect() const { return rect; }
+
+    void SetHeight(int height);
+
+protected:
+    UISize OnMeasure(int availW, int availH) override;
 
 private:
     int desiredH;
-    Rectangle rect{0,0,0,0};
 };
 
-// LayoutBox: vertical / horizontal stacking container
+// LayoutBox: vertical / horizontal stacking container.  An element belongs
+// to at most one box.
 class LayoutBox : public UIElement {
 public:
     enum class Direction { Vertical, Horizontal };
@@ -59,17 +96,20 @@ public:
     ~LayoutBox();
 
     void AddChild(UIElement* child);
+    void RemoveChild(UIElement* child);
+    void ClearChildren();
 
-    UISize Measure(int availW, int availH) override;
-    void Layout(int x, int y, int w, int h) override;
     void Draw() override;
 
+protected:
+    UISize OnMeasure(int availW, int availH) override;
+    void OnLayout() override;
+
 private:
     Direction dir;
     int spacing;
     int padding;
     std::vector<UIElement*> children;
-    Rectangle rect{0,0,0,0};
     std::vector<UISize> measured;
 };
 
@@ -0,0 +1,102 @@
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ─── LightBake ────────────────────────────────────────────────────────────────
+//
+// Static lighting, computed ahead of time from a scene's own lights (its
+// SceneLights) so drawing it costs a texture fetch instead of a light loop:
+//
+//   lightmaps    per static mesh with lightmap UVs (the file's second UV
+//                channel, Mesh::texcoords2), the light reaching each texel
+//                of its surface, shadowed by the rest of the scene
+//   light probes a regular grid over the static geometry, each probe the
+//                light arriving from six directions (an "ambient cube"), for
+//                whatever moves through it and for static meshes without
+//                lightmap UVs
+//
+// The lights are shaded as LightingSystem shades dynamic ones (Lambert,
+// the same range falloff and spot cones; area lights as points), so a light
+// looks the same baked or dynamic, minus its highlight.  Shadows are traced
+// against the static meshes' triangles (a Physics::BVH over them).  Light
+// is direct only: no bounces, the ambient term stays LightingSystem's.
+//
+// A light whose node has the property bake = false is left out, for the
+// game to drive as a dynamic light instead.
+//
+// SceneImporter bakes at load with SceneImportOptions::bakeLighting, and
+// keeps the result on disk under LightBakeOptions::cacheDir, keyed by a
+// hash of the static geometry, the lights and the options, so an unchanged
+// scene is baked once (SceneImporter::Cook() bakes when packaging):
+// <dir>/<key as 16 hex digits>.bake, written to a temporary name and
+// renamed into place like the LOD cache.
+//
+// At runtime the lightmapped meshes are drawn with
+// LightingSystem::GetLightmappedShader(), their lightmap in the material's
+// LIGHTMAP_MATERIAL_MAP slot; the probes go to every other lit shader
+// through LightingSystem::SetLightProbes():
+//   auto scene = SceneImporter::Load("assets/level.glb", { .bakeLighting = true });
+//   GFX::LightingSystem::Get().SetLightProbes(scene->probes);
+
+namespace Hotones { struct ImportedScene; }
+namespace Hotones::Jobs { class JobSystem; }
+
+namespace Hotones::GFX {
+
+// The material map a lightmap goes in (raylib leaves it unused)
+constexpr int LIGHTMAP_MATERIAL_MAP = MATERIAL_MAP_HEIGHT;
+// Lightmap texels are RGBM: colour × alpha × LIGHTMAP_RANGE is the light
+constexpr float LIGHTMAP_RANGE = 8.f;
+
+// Most probes a grid holds; a denser one is spread out to fit
+constexpr int MAX_LIGHT_PROBES = 64 * 1024;
+
+struct LightBakeOptions {
+    float texelsPerUnit   = 4.f;      // lightmap resolution over a mesh's surface
+    int   minLightmapSize = 16;       // texels a side, rounded up to powers of two
+    int   maxLightmapSize = 1024;
+    float probeSpacing    = 2.f;      // between grid neighbours, world units
+    float intensityScale  = 1.f;      // on every light's intensity, for files in other units
+    bool  shadows         = true;
+    float shadowBias      = 0.02f;    // shadow rays start this far off the surface
+    std::string cacheDir  = "cache/lighting";   // "" = none
+};
+
+// Ambient cubes on a regular grid, x fastest, then y, then z
+struct LightProbeGrid {
+    Vector3 origin  = {};     // probe (0, 0, 0), world space
+    float   spacing = 0.f;    // world units
+    int     countX = 0, countY = 0, countZ = 0;
+    // Per probe, the light (linear RGB) a surface facing +X, −X, +Y, −Y,
+    // +Z, −Z there receives
+    std::vector<Vector3> faces;
+
+    bool Empty() const { return faces.empty(); }
+    int  Count() const { return countX * countY * countZ; }
+    // The light reaching a surface at `pos` facing `normal`: the eight
+    // probes around it blended, each weighted over its faces by the
+    // normal's squared components
+    Vector3 Sample(Vector3 pos, Vector3 normal) const;
+};
+
+struct Lightmap {
+    int                  mesh  = -1;   // into ImportedScene::meshes
+    int                  width = 0, height = 0;
+    std::vector<uint8_t> texels;       // RGBM (see LIGHTMAP_RANGE), row-major
+};
+
+struct BakedLighting {
+    std::vector<Lightmap> lightmaps;
+    LightProbeGrid        probes;
+};
+
+// Bake `scene`'s lights over its static (unskinned) meshes, which must
+// still have their CPU arrays; in parallel on `jobs` when given.  Read
+// from and written to opts.cacheDir unless it is empty.  Empty when the
+// scene has no lights to bake.
+BakedLighting BakeLighting(const ImportedScene& scene, const LightBakeOptions& opts,
+                           Jobs::JobSystem* jobs = nullptr);
+
+} // namespace Hotones::GFX
@@ -1,6 +1,11 @@
 #pragma once
+#include <GFX/LightBake.hpp>
+#include <GFX/ShadowAtlas.hpp>
 #include <raylib.h>
 #include <array>
+#include <bitset>
+#include <cstdint>
+#include <vector>
 
 // ─── LightingSystem ───────────────────────────────────────────────────────────
 //
@@ -9,17 +14,56 @@
 // raylib Model by calling ApplyToModel(); uniforms are re-uploaded every frame
 // via UploadUniforms().
 //
+// Lighting is clustered: each frame the view volume is split into
+// CLUSTER_X × CLUSTER_Y screen tiles × CLUSTER_Z exponential depth slices,
+// and every point / spot light is binned into the clusters its range
+// reaches.  The lights, each cluster's (offset, count) and the packed index
+// lists go to the shader as float textures read with texelFetch(), so a
+// fragment shades only the lights of its own cluster (plus directional
+// lights, which reach everywhere).  Cost follows local light density rather
+// than the total.
+//
+// Uploads follow changes: only the light rows touched since the last frame
+// (AddLight / RemoveLight / GetLight mark a light changed) are re-sent, the
+// clusters are rebuilt only when a light or the view changed, and the
+// textures are shared by every lit shader rather than sent once per shader.
+//
+// Lights with castsShadows set are shadowed through a ShadowAtlas (see
+// there): call RenderShadows() with the scene's casters each frame, before
+// UploadUniforms().
+//
+// Static light is baked instead (LightBake.hpp): the dynamic lights here
+// are for what moves or changes.  Meshes with a lightmap are drawn with
+// GetLightmappedShader(); every other lit shader adds the light probe grid
+// given to SetLightProbes().
+//
 // Typical per-frame usage in ScriptedScene::Draw():
+//   GFX::LightingSystem::Get().RenderShadows(camera, casters);   // optional
 //   GFX::LightingSystem::Get().UploadUniforms(camera);
 //   BeginMode3D(camera);
 //       worldModel.Draw();   // already has the lit shader patched in
 //   EndMode3D();
 //
+// Edits (AddLight, GetLight, SetAmbient...) go to a pending copy of the
+// lights that Publish() hands to the drawing side; RenderShadows() and
+// UploadUniforms() publish first.  A pipelined frame (see FramePipeline)
+// edits on the simulation thread while the main thread draws, so it sets
+// manual publishing and publishes once the step is over: the lights drawn
+// are then always those of the snapshot being drawn.
+//
 // Lua packs control lights through the "lighting" global table.
 
 namespace Hotones::GFX {
 
-constexpr int MAX_LIGHTS = 8;
+constexpr int MAX_LIGHTS = 256;
+
+// Cluster grid, and the most (cluster, light) pairs binned per frame; past
+// that, further lights are dropped from the clusters that overflow.
+constexpr int CLUSTER_X           = 16;
+constexpr int CLUSTER_Y           = 9;
+constexpr int CLUSTER_Z           = 24;
+constexpr int CLUSTER_COUNT       = CLUSTER_X * CLUSTER_Y * CLUSTER_Z;
+constexpr int MAX_CLUSTER_INDICES = 64 * 1024;
 
 enum class LightType : int {
     Point       = 0,
@@ -37,6 +81,7 @@ struct LightDesc {
     float     range     = 20.0f;              // attenuation radius (point/spot)
     float     innerCos  = 0.9763f;            // cos(12.5°) spot inner cone
     float     outerCos  = 0.8660f;            // cos(30°)   spot outer cone
+    bool      castsShadows = false;           // gets ShadowAtlas tiles
 };
 
 class LightingSystem {
@@ -66,7 +111,10 @@ public:
     void RemoveLight(int handle);
 
     bool       IsValidHandle(int handle) const;
-    LightDesc* GetLight(int handle);        // nullptr if handle is invalid
+    // nullptr if handle is invalid.  Marks the light changed, so its new
+    // values are uploaded next frame: fetch it again for each change rather
+    // than keeping the pointer.
+    LightDesc* GetLight(int handle);
 
     // ── Ambient ───────────────────────────────────────────────────────────────
 
@@ -74,11 +122,41 @@ public:
     // intensity  : scalar multiplier applied on top of the colour.
     void SetAmbient(Vector3 colorLinear, float intensity = 0.15f);
 
+    // ── Publishing ────────────────────────────────────────────────────────────
+
+    // Hand the edits since the last Publish() to the drawing side
+    void Publish();
+    // ShadowAtlas::SetBudget(), published with the lights
+    void SetShadowBudget(int tilesPerFrame) { m_pendingShadowBudget = tilesPerFrame > 1 ? tilesPerFrame : 1; }
+    // Manual: RenderShadows() / UploadUniforms() draw what was published
+    // last instead of publishing first.  Set while frames are pipelined.
+    void SetManualPublish(bool manual) { m_manualPublish = manual; }
+
     // ── Per-frame ─────────────────────────────────────────────────────────────
 
-    // Pack all light data into shader uniforms + upload view-position.
-    // Call once per frame before drawing any lit geometry.
+    // Bring the shadow maps of shadow-casting lights up to date (see
+    // ShadowAtlas).  Call outside BeginMode3D, before UploadUniforms().
+    void RenderShadows(Camera camera, const ShadowCasters& casters);
+
+    ShadowAtlas&       GetShadowAtlas()       { return m_shadows; }
+    const ShadowAtlas& GetShadowAtlas() const { return m_shadows; }
+
+    // Bin the lights into clusters for `camera` and upload them with the
+    // view uniforms.  Call once per frame before drawing any lit geometry.
+    // Clusters are laid over a target of the given size in pixels (the
+    // framebuffer by default, i.e. GetRenderWidth() × GetRenderHeight()).
     void UploadUniforms(Camera camera);
+    void UploadUniforms(Camera camera, int targetWidth, int targetHeight);
+
+    struct Stats {
+        int  lights   = 0;       // enabled lights
+        int  binned   = 0;       // (cluster, light) pairs uploaded
+        int  dropped  = 0;       // pairs past MAX_CLUSTER_INDICES
+        int  uploaded = 0;       // light rows re-sent this frame
+        bool rebinned = false;   // clusters rebuilt this frame
+    };
+    // Counts for the last UploadUniforms()
+    const Stats& GetStats() const { return m_stats; }
 
     // ── Model integration ─────────────────────────────────────────────────────
 
@@ -88,34 +166,106 @@ public:
 
     const Shader& GetShader() const { return m_shader; }
 
+    // The same lighting for DrawMeshInstanced(): per-instance model matrices
+    // in the instanceTransform attribute.  id == 0 if it failed to compile.
+    const Shader& GetInstancedShader() const { return m_instancedShader; }
+
+    // The same for skinned meshes: vertices moved by up to MAX_SKIN_BONES
+    // bone matrices (mesh.boneMatrices).  id == 0 if it failed to compile.
+    const Shader& GetSkinnedShader() const { return m_skinnedShader; }
+
+    // The same for meshes with baked lighting: their lightmap, sampled at
+    // their second UVs, in place of the probes.  id == 0 if it failed to
+    // compile.
+    const Shader& GetLightmappedShader() const { return m_lightmappedShader; }
+
+    // ── Baked lighting ────────────────────────────────────────────────────────
+
+    // Light the other shaders' geometry with `probes` from now on (an empty
+    // grid: none).  Replaces the last grid.  Main thread, after Init().
+    void SetLightProbes(const LightProbeGrid& probes);
+
 private:
     LightingSystem() = default;
 
-    Shader  m_shader = {};
-    bool    m_ready  = false;
+    Shader  m_shader          = {};
+    Shader  m_instancedShader = {};
+    Shader  m_skinnedShader   = {};
+    Shader  m_lightmappedShader = {};
+    bool    m_ready           = false;
+
+    // Edited, until Publish()
+    std::array<LightDesc, MAX_LIGHTS> m_pending = {};
+    std::bitset<MAX_LIGHTS>           m_pendingChanged;
+    Vector3 m_pendingAmbientColor     = {1.f, 1.f, 1.f};
+    float   m_pendingAmbientIntensity = 0.15f;
+    bool    m_pendingAmbient          = false;
+    int     m_pendingShadowBudget     = 0;       // 0: unchanged
+    bool    m_manualPublish           = false;
 
+    // Published: what is drawn
     std::array<LightDesc, MAX_LIGHTS> m_lights = {};
+    std::bitset<MAX_LIGHTS>           m_changed;   // rows to re-send
+    std::array<int, MAX_LIGHTS>       m_shadowTile;   // ShadowAtlas::FirstTile, as uploaded
+    ShadowAtlas                       m_shadows;
+
+    // Light textures (rlgl ids), bound to texture units 13–15 by UploadUniforms()
+    unsigned int m_lightDataTex  = 0;   // 4 × MAX_LIGHTS RGBA32F, a row per light
+    unsigned int m_lightGridTex  = 0;   // CLUSTER_X*CLUSTER_Y × CLUSTER_Z RGBA32F: offset, count
+    unsigned int m_lightIndexTex = 0;   // R32F, light indices packed row-major
+    unsigned int m_probeTex      = 0;   // RGBA32F, six texels per light probe
+
+    Vector3            m_probeOrigin   = {};
+    float              m_probeSpacing  = 1.f;
+    std::array<int, 3> m_probeCount    = {};   // all 0: no probes
+    bool               m_probesChanged = true;
+
+    // Per-frame binning scratch, capacity kept
+    std::vector<float>    m_lightData;
+    std::vector<float>    m_gridData;
+    std::vector<float>    m_indexData;
+    std::vector<uint32_t> m_clusterFill;
+    std::vector<int>      m_active;     // enabled point / spot lights, by slot
+    Stats                 m_stats;
+
+    // What the current clusters were built for
+    bool   m_binned       = false;
+    Camera m_binnedCamera = {};
+    int    m_binnedWidth  = 0;
+    int    m_binnedHeight = 0;
+    int    m_dirCount     = 0;
+
+    bool   m_ambientChanged = true;
 
     Vector3 m_ambientColor     = {1.f, 1.f, 1.f};
     float   m_ambientIntensity = 0.15f;
 
-    // Cached uniform locations (one per array, pointing at [0])
+    // Cached uniform locations (one per array, pointing at [0]), per shader
     struct Locs {
         int viewPos          = -1;
+        int viewForward      = -1;
+        int screenSize       = -1;
+        int clusterDepth     = -1;
+        int dirLightCount    = -1;
         int ambientColor     = -1;
         int ambientIntensity = -1;
-        int lightEnabled     = -1;
-        int lightType        = -1;
-        int lightPos         = -1;
-        int lightDir         = -1;
-        int lightColor       = -1;
-        int lightIntensity   = -1;
-        int lightRange       = -1;
-        int lightInnerCos    = -1;
-        int lightOuterCos    = -1;
-    } m_locs;
-
-    void CacheLocations();
+        int probeOrigin      = -1;
+        int probeSpacing     = -1;
+        int probeCount       = -1;
+        int cascadeSplits    = -1;
+        int shadowMatrix[SHADOW_TILES] = {};
+    };
+    Locs m_locs;
+    Locs m_instancedLocs;
+    Locs m_skinnedLocs;
+    Locs m_lightmappedLocs;
+
+    static void CacheLocations(const Shader& shader, Locs& locs);
+    bool LoadLightTextures();
+    void BindLightTextures() const;
+    // Fill m_gridData / m_indexData for the view; returns the number of
+    // directional lights, which lead the index list
+    int  BinLights(const Camera& camera, float aspect);
 };
 
 } // namespace Hotones::GFX
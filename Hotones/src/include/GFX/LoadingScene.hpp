@@ -3,12 +3,15 @@
 #include <GFX/Scene.hpp>
 #include <raylib.h>
 #include <functional>
+#include <memory>
 #include <string>
 
 #define LOADING_STAR_COUNT 420
 
 namespace Hotones {
 
+class SceneLoad;
+
 class LoadingScene : public Scene {
 public:
     // Optional progress callback returns value in [0,1].  Optional error
@@ -18,6 +21,11 @@ public:
                  std::function<std::string()> errorCb = nullptr);
     virtual ~LoadingScene() override = default;
 
+    // Drive a SceneImporter::LoadAsync() load while this scene shows: it is
+    // pumped for `budgetMs` each Update(), its progress and error shown,
+    // and the scene doesn't finish before it has.  Take() the result after.
+    void Track(std::shared_ptr<SceneLoad> load, float budgetMs = 4.0f);
+
     void Init() override;
     void Update() override;
     void Draw() override;
@@ -33,6 +41,8 @@ private:
     float duration;
     std::function<float()> m_progressCb;
     std::function<std::string()> m_errorCb;
+    std::shared_ptr<SceneLoad> m_load;
+    float m_loadBudgetMs = 4.0f;
 };
 
 } // namespace Hotones
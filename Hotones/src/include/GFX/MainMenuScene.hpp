@@ -5,6 +5,7 @@
 #include <Assets/PackScanner.hpp>
 #include <server/NetworkManager.hpp>
 #include <raylib.h>
+#include <memory>
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -23,6 +24,10 @@ public:
     void Draw()   override;
     void Unload() override;
 
+    // Master list the server browser fills itself from on refresh, besides
+    // pinging the servers it already lists (empty host: none)
+    void SetMasterServer(const Net::ServerEndpoint& master) { m_master = master; }
+
     // Read by main.cpp after IsFinished()
     Action      GetAction()        const { return m_action; }
     std::string GetPlayerName()    const { return m_nameField.text(); }
@@ -41,6 +46,7 @@ private:
 
     // ── Network ───────────────────────────────────────────────────────────────
     Net::NetworkManager* m_net = nullptr;
+    Net::ServerEndpoint  m_master { {}, 0 };
 
     // ── StbTextField fields ───────────────────────────────────────────────────
     StbTextField m_nameField;
@@ -49,7 +55,8 @@ private:
     int          m_activeField = -1;   // 0=name, 1=port (Host screen)
 
     // ── Pack list (Host screen) ───────────────────────────────────────────────
-    std::vector<Assets::PackEntry> m_packs;
+    std::vector<Assets::PackEntry> m_packs;     // from m_packScan, filling in as it probes
+    std::unique_ptr<Assets::PackScan> m_packScan;
     int         m_packScroll    = 0;
     int         m_selectedPack  = -1;
     std::string m_selectedPakPath;
@@ -58,8 +65,8 @@ private:
     struct ServerEntry {
         std::string host;
         uint16_t    port        = Net::DEFAULT_PORT;
-        uint8_t     playerCount = 0;
-        uint8_t     maxPlayers  = 0;
+        uint16_t    playerCount = 0;
+        uint16_t    maxPlayers  = 0;
         char        pakName[32] = {};
         char        gameVersion[16] = {};
         char        pakVersion[16]  = {};
@@ -92,6 +99,7 @@ private:
     void DrawBuiltInGames();
     
     void RefreshPacks();
+    void PollPacks();
     void PingAllServers();
     void AddServer(const char* host, uint16_t port);
     void RemoveSelectedServer();
@@ -0,0 +1,56 @@
+#pragma once
+#include <raylib.h>
+#include <string>
+#include <vector>
+
+// ─── MeshSimplify ─────────────────────────────────────────────────────────────
+//
+// Levels of detail for indexed meshes by quadric edge collapse (Garland and
+// Heckbert): each step folds a vertex into one of its neighbours, cheapest
+// first, the cost being how far that moves it from the planes of the
+// triangles it has absorbed so far.  Only the indices change: a simplified
+// mesh reuses the source's vertices, so it is drawn over the same vertex
+// buffers through a GFX::MeshView (MeshView::Set).
+//
+// Vertices on an open border or an attribute seam (an edge without exactly
+// two triangles; seam vertices are split, which opens the edge) never move,
+// so outlines and UV / normal splits survive.  Meshes made mostly of such
+// edges stop simplifying early.
+//
+// BuildLODChain() keeps its results on disk when given a directory, keyed
+// by a hash of the mesh's positions and indices and the chain's parameters,
+// so an unchanged mesh is simplified once: <dir>/<key as 16 hex digits>.lod,
+// written to a temporary name and renamed into place like the physics BVH
+// cache.
+//
+// Typical use (SceneImporter does this with SceneImportOptions::lodLevels):
+//   for (const GFX::MeshLOD& lod : GFX::BuildLODChain(mesh, 3, 0.5f, "cache/lod")) {
+//       GFX::MeshView view;
+//       view.Init(mesh);
+//       view.Set(lod.indices.data(), (int)lod.indices.size());
+//       view.Upload();
+//       ...
+//   }
+
+namespace Hotones::GFX {
+
+struct MeshLOD {
+    std::vector<unsigned short> indices;       // triangles over the source's vertices
+    float                       error = 0.f;   // surface deviation from the source, mesh units (estimate)
+};
+
+// `mesh`'s triangles collapsed toward `targetIndexCount` indices, stopping
+// sooner when no collapse is left that moves the surface less than
+// `maxError` (mesh units).  `*error` gets the largest deviation accepted.
+// Empty for meshes without indices.
+std::vector<unsigned short> SimplifyMesh(const Mesh& mesh, int targetIndexCount,
+                                         float maxError, float* error = nullptr);
+
+// Up to `levels` successively coarser versions of `mesh`, each aiming at
+// `reduction` times the triangles of the one before.  The chain ends early
+// once a level would save less than a tenth of the previous one.  Read from
+// and written to `cacheDir` unless it is empty.
+std::vector<MeshLOD> BuildLODChain(const Mesh& mesh, int levels, float reduction,
+                                   const std::string& cacheDir = "");
+
+} // namespace Hotones::GFX
@@ -0,0 +1,61 @@
+#pragma once
+#include <raylib.h>
+#include <vector>
+
+// ─── MeshView ─────────────────────────────────────────────────────────────────
+//
+// Some of an indexed mesh's triangles, drawable like a Mesh of their own.
+// The view is a second VAO over the source mesh's vertex buffers with an
+// index buffer of its own, filled with the source index ranges Add()ed since
+// the last Clear() and sent to the GPU by Upload().  Nothing is copied but
+// the indices, so a big batched mesh can be drawn in part (the pieces that
+// survived culling) without a draw call per piece.
+//
+// Set() instead fills the view with triangles of the caller's over the same
+// vertices, e.g. a simplified level of detail (see MeshSimplify).
+//
+// Refill only when the chosen triangles change; GetMesh() keeps drawing the
+// last upload in between.  Like raylib's own handles a MeshView is a plain
+// value: copies share the GPU objects, and exactly one of them is Unload()ed.
+//
+// Typical use:
+//   view.Init(mesh);                        // once, mesh uploaded with indices
+//   view.Clear();
+//   for (auto& p : visibleParts) view.Add(p.firstIndex, p.indexCount);
+//   view.Upload();
+//   queue.Submit(view.GetMesh(), material, transform);
+
+namespace Hotones::GFX {
+
+class MeshView {
+public:
+    // `source` must be uploaded, indexed, and outlive the view (its CPU
+    // index array is read by Add()).  False when VAOs are unavailable.
+    bool Init(const Mesh& source);
+    void Unload();
+    bool IsReady() const { return m_mesh.vaoId != 0; }
+
+    void Clear() { m_count = 0; }
+    // Append the source's indices [firstIndex, firstIndex + count)
+    void Add(int firstIndex, int count);
+    // Replace them with `indices[0..count)`, each a vertex of the source;
+    // no more than the source has
+    void Set(const unsigned short* indices, int count);
+    // Send the indices added since Clear() to the GPU
+    void Upload();
+
+    // The source's vertices with the uploaded triangles
+    const Mesh& GetMesh() const { return m_mesh; }
+    int  IndexCount() const { return m_count; }
+    // Whether the view holds every triangle of its source
+    bool IsWhole() const { return m_count == (int)m_indices.size(); }
+
+private:
+    Mesh                        m_mesh   = {};
+    unsigned int                m_ebo    = 0;
+    const unsigned short*       m_source = nullptr;
+    std::vector<unsigned short> m_indices;   // sized for the whole source
+    int                         m_count  = 0;
+};
+
+} // namespace Hotones::GFX
@@ -0,0 +1,127 @@
+#pragma once
+#include <Assets/AssetCache.hpp>
+#include <ECS/Registry.hpp>
+#include <GFX/Culling.hpp>
+#include <GFX/RenderQueue.hpp>
+#include <raylib.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// ─── ModelRenderSystem ────────────────────────────────────────────────────────
+//
+// Draws every visible entity with RenderModelComponent + TransformComponent,
+// instanced.  Each frame the entities' meshes are grouped by (mesh, material,
+// tint) and every group becomes one DrawMeshInstanced() call carrying the
+// members' model matrices (the Model's own transform, then
+// TransformComponent::ToMatrix()), so a thousand copies of a prop cost one
+// draw call per mesh instead of a thousand.
+//
+// Entities share a mesh when their RenderModelComponent::model is the same
+// handle, which AssetCache::LoadModel gives every load of a file.  Materials
+// on the lighting shader are drawn with its instancing variant
+// (LightingSystem::GetInstancedShader()); a group of one, or a material on
+// any other shader, is drawn with plain DrawMesh() per entity.
+//
+// Given a Frustum, entities whose model bounds (the union of its meshes'
+// boxes, cached per Model and carried through the entity's matrix) are
+// wholly outside it are skipped.  Entities move, so this is a box test per
+// entity rather than a tree; static geometry goes through CullingBVH.
+// Given an OcclusionCuller as well, entities it finds hidden behind last
+// frame's occluders are skipped too, before they join a group.
+//
+// Draws go through a RenderQueue: the system's own, flushed before Draw()
+// returns, or the caller's so they sort together with the rest of the frame.
+//
+// Capture() takes the entities' models and matrices down as Instances
+// without touching the GPU, so a pipelined scene can snapshot them on the
+// simulation thread and draw the snapshot later (see FramePipeline); the
+// handles keep the models alive meanwhile.
+//
+// Typical per-frame usage in a scene's Draw(), inside BeginMode3D and after
+// LightingSystem::UploadUniforms():
+//   m_models.Draw(m_registry, frustum);           // or, sorted with the world:
+//   m_models.Draw(m_registry, frustum, queue);    // drawn at queue.Flush()
+
+namespace Hotones::GFX {
+
+class OcclusionCuller;
+
+class ModelRenderSystem {
+public:
+    struct Stats {
+        int entities  = 0;   // visible entities drawn
+        int culled    = 0;   // visible entities outside the frustum
+        int occluded  = 0;   // visible entities hidden behind occluders
+        int drawCalls = 0;   // DrawMesh / DrawMeshInstanced calls submitted
+        int instanced = 0;   // of which DrawMeshInstanced
+    };
+
+    // A visible entity as Draw() would place it
+    struct Instance {
+        Assets::ModelHandle model;
+        Matrix              world = {};   // the Model's own transform, then the entity's
+        Color               tint  = WHITE;
+    };
+
+    void Draw(ECS::Registry& reg);
+    void Draw(ECS::Registry& reg, const Frustum& frustum);
+    void Draw(ECS::Registry& reg, const Frustum& frustum, RenderQueue& queue,
+              const OcclusionCuller* occlusion = nullptr);
+
+    // Append every visible entity to `out`.  Any thread; no GL.
+    static void Capture(ECS::Registry& reg, std::vector<Instance>& out);
+    // Draw captured instances, as Draw(reg, frustum, queue) would
+    void Draw(const std::vector<Instance>& instances, const Frustum& frustum, RenderQueue& queue,
+              const OcclusionCuller* occlusion = nullptr);
+
+    // Counts for the last Draw()
+    const Stats& GetStats() const { return m_stats; }
+
+    // Forget every group (models were unloaded).
+    void Clear() { m_batches.clear(); m_bounds.clear(); }
+
+private:
+    struct BatchKey {
+        const Mesh*     mesh     = nullptr;
+        const Material* material = nullptr;
+        uint32_t        tint     = 0;   // RGBA packed
+
+        bool operator==(const BatchKey&) const = default;
+    };
+    struct BatchKeyHash {
+        size_t operator()(const BatchKey& k) const {
+            size_t h = std::hash<const void*>{}(k.mesh);
+            h ^= std::hash<const void*>{}(k.material) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+            h ^= std::hash<uint32_t>{}(k.tint)        + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+    struct Batch {
+        Color               tint = WHITE;
+        std::vector<Matrix> transforms;   // cleared each frame, capacity kept
+    };
+
+    // A Model's local bounds, and what they were computed from
+    struct ModelBounds {
+        const float* vertices  = nullptr;   // meshes[0].vertices
+        int          meshCount = 0;
+        BoundingBox  box       = {};
+    };
+
+    // forEach(fn) calls fn(model, world, tint) for every instance to draw
+    template<typename ForEach>
+    void DrawEach(ForEach&& forEach, const Frustum* frustum, const OcclusionCuller* occlusion, RenderQueue& queue);
+    void DrawCulled(ECS::Registry& reg, const Frustum* frustum, const OcclusionCuller* occlusion, RenderQueue& queue);
+    void Submit(const BatchKey& key, Batch& batch, RenderQueue& queue);
+    const BoundingBox& LocalBounds(const Model& model);
+
+    std::unordered_map<BatchKey, Batch, BatchKeyHash>  m_batches;
+    std::unordered_map<const Mesh*, ModelBounds>       m_bounds;   // by Model::meshes
+    RenderQueue m_queue;   // for the Draw() overloads without one
+    Stats m_stats;
+};
+
+} // namespace Hotones::GFX
@@ -0,0 +1,113 @@
+#pragma once
+#include <GFX/Culling.hpp>
+#include <GFX/RenderQueue.hpp>
+#include <raylib.h>
+#include <functional>
+#include <vector>
+
+// ─── OcclusionCuller ──────────────────────────────────────────────────────────
+//
+// Hierarchical-Z occlusion culling: skips meshes and instances hidden behind
+// large occluders (walls, floors, big props) as well as those outside the
+// frustum.
+//
+// Each frame, Render():
+//   1. reads back the pyramid the GPU built last frame and finishes it on
+//      the CPU, down to 1×1;
+//   2. draws the occluders the caller submits, depth only, into a small
+//      HIZ_WIDTH × HIZ_HEIGHT target with the camera's view;
+//   3. reduces that depth to HIZ_READBACK_WIDTH × HIZ_READBACK_HEIGHT with
+//      max-of-2×2 fragment passes, ready to read back next frame.
+// IsVisible() then tests a world box against last frame's pyramid, seen
+// from last frame's camera: the box's nearest view depth against the
+// farthest occluder depth over the few texels its screen rectangle covers,
+// on the level where that is at most 2×2.  A box is hidden only when it
+// lies wholly behind them.
+//
+// Reading the pyramid a frame late keeps the CPU from waiting on the GPU,
+// at the usual cost: something the camera turns to, or an occluder moves
+// away from, appears one frame late.  Boxes reaching behind last frame's
+// near plane, and every box before the first pyramid is read, are visible.
+//
+// raylib's GL 3.3 path has no compute shaders or indirect draws, so the
+// pyramid is built with fragment passes and the tests run on the CPU, where
+// the results feed the RenderQueue (instances join a DrawMeshInstanced()
+// group only when visible) instead of a GPU draw-argument buffer.
+//
+// Typical use in a scene's Draw(), outside BeginMode3D:
+//   m_occlusion.Render(camera, aspect, [&](const GFX::Frustum& f, GFX::RenderQueue& q) {
+//       m_world->DrawOccluders(f, q);
+//   });
+//   ...
+//   m_world->Draw(frustum, queue, &m_occlusion);
+//   m_models.Draw(instances, frustum, queue, &m_occlusion);
+
+namespace Hotones::GFX {
+
+constexpr int   HIZ_WIDTH           = 256;   // occluder depth target
+constexpr int   HIZ_HEIGHT          = 128;
+constexpr int   HIZ_GPU_LEVELS      = 2;     // max reductions on the GPU
+constexpr int   HIZ_READBACK_WIDTH  = HIZ_WIDTH  >> HIZ_GPU_LEVELS;
+constexpr int   HIZ_READBACK_HEIGHT = HIZ_HEIGHT >> HIZ_GPU_LEVELS;
+constexpr float OCCLUDER_MIN_SIZE   = 2.0f;  // bounds diagonal, in units, worth drawing as an occluder
+
+class OcclusionCuller {
+public:
+    struct Stats {
+        int occluders = 0;   // draws in this frame's depth pre-pass
+        int tested    = 0;   // IsVisible() calls against a pyramid
+        int occluded  = 0;   // of which hidden
+    };
+
+    using DrawOccluders = std::function<void(const Frustum& frustum, RenderQueue& queue)>;
+
+    // Must be called after InitWindow().  Idempotent.
+    bool Init();
+    void Unload();
+    bool IsReady() const { return m_ready; }
+
+    // Read back last frame's pyramid, then draw this frame's occluders and
+    // reduce them.  Rebinds the framebuffer, viewport and matrices, and
+    // restores them after.
+    void Render(const Camera& camera, float aspect, const DrawOccluders& occluders);
+
+    // Whether `box` (world space) may be seen; true when unsure
+    [[nodiscard]] bool IsVisible(const BoundingBox& box) const;
+
+    // Forget the pyramid, e.g. after a cut or a teleport, so nothing is
+    // culled against a view that no longer applies.
+    void Invalidate() { m_valid = false; m_pending = false; }
+
+    // Counts since the last Render()
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    struct Level {
+        int                width = 0, height = 0;
+        std::vector<float> depth;   // linear view depth, row 0 at the bottom
+    };
+
+    void ReadBack();
+    void Reduce(unsigned int source, unsigned int fbo, int width, int height);
+
+    bool         m_ready   = false;
+    bool         m_pending = false;   // a pyramid was drawn and not read back yet
+    bool         m_valid   = false;   // m_levels describe m_view / m_proj
+    Shader       m_depthShader          = {};
+    Shader       m_depthInstancedShader = {};
+    Shader       m_reduceShader         = {};
+    unsigned int m_depthFbo = 0, m_depthTexture = 0;
+    unsigned int m_levelFbo[HIZ_GPU_LEVELS]     = {};
+    unsigned int m_levelTexture[HIZ_GPU_LEVELS] = {};
+
+    // The camera the pending pyramid was drawn from, and the one m_levels were
+    Matrix m_pendingView = {}, m_pendingProj = {};
+    bool   m_pendingOrtho = false;
+    Matrix m_view = {}, m_proj = {};
+    std::vector<Level> m_levels;   // 0 is the read-back level
+
+    RenderQueue   m_queue;
+    mutable Stats m_stats;
+};
+
+} // namespace Hotones::GFX
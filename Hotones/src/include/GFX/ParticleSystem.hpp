@@ -0,0 +1,119 @@
+#pragma once
+#include <ECS/System.hpp>
+#include <ECS/Components.hpp>
+#include <GFX/Culling.hpp>
+#include <raylib.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// ─── ParticleSystem ───────────────────────────────────────────────────────────
+//
+// Simulates and draws every ParticleEmitterComponent.  Particles are not
+// entities: each emitter keeps its own in flat arrays (structure of arrays:
+// x, y, z, vx, vy, vz, remaining life), so a tick is a few SIMD passes over
+// them (ECS/SimdKernels.hpp) — gravity into velocity, velocity into
+// position, the countdown, then the expired ones found with a vector
+// compare and swapped out.  Emitters are simulated in parallel on the
+// JobSystem; spawning uses a per-emitter random stream, so that needs no
+// locking either.
+//
+// Draw() builds camera-facing quads for every emitter in the frustum and
+// hands them to rlgl sorted by (texture, blend mode), so all the particles
+// sharing a texture go out as one batch instead of one DrawBillboard call
+// each.  Particles are translucent: they are drawn without writing depth,
+// and are not sorted back to front.
+//
+// Capture() copies what drawing needs (positions, how far through its life
+// each particle is, the emitter's look) into a Frame, so a pipelined scene
+// can snapshot the particles on the simulation thread and draw them while
+// the next tick runs (see FramePipeline).
+//
+// Simulation runs on the CPU: raylib's GL 3.3 path has no compute shaders,
+// and a few thousand particles cost well under a millisecond this way.
+//
+// Add it to the scheduler after MovementSystem (emitters follow this tick's
+// transforms), and call Draw() inside BeginMode3D, after the opaque passes:
+//   m_particles = &m_systems.Add<GFX::ParticleSystem>();
+//   ...
+//   m_particles->Draw(camera, frustum);
+
+namespace Hotones::GFX {
+
+class ParticleSystem : public ECS::System {
+public:
+    struct Stats {
+        int emitters  = 0;   // drawn by the last Draw()
+        int culled    = 0;   // emitters whose particles were all outside the frustum
+        int particles = 0;   // drawn
+        int batches   = 0;   // (texture, blend) groups they went out in
+    };
+
+    void DeclareAccess(ECS::SystemAccess& access) const override {
+        // Write: a pending burst is cleared once spawned
+        access.Read<ECS::TransformComponent>().Write<ECS::ParticleEmitterComponent>();
+    }
+
+    void Update(ECS::Registry& reg, float dt) override;
+    void Shutdown(ECS::Registry& /*reg*/) override { Clear(); }
+
+    // Particles as of one Update(), for drawing later
+    struct Frame {
+        struct Emitter {
+            ECS::ParticleEmitterComponent params;
+            BoundingBox bounds = {};
+            size_t      first  = 0;   // into the arrays below
+            size_t      count  = 0;
+        };
+        std::vector<Emitter> emitters;   // with particles
+        std::vector<float>   x, y, z;
+        std::vector<float>   t;          // 0 at birth, 1 at death
+
+        void Clear() { emitters.clear(); x.clear(); y.clear(); z.clear(); t.clear(); }
+    };
+
+    // Replace `out` with the particles now.  Not during Update().
+    void Capture(Frame& out) const;
+    void Draw(const Frame& frame, const Camera& camera, const Frustum& frustum);
+    // Capture() and draw it
+    void Draw(const Camera& camera, const Frustum& frustum);
+
+    // Particles alive after the last Update()
+    [[nodiscard]] size_t ParticleCount() const;
+    const Stats& GetStats() const { return m_stats; }
+
+    // Drop every particle (and the textures they hold)
+    void Clear() { m_emitters.clear(); m_draw.clear(); m_frame.Clear(); }
+
+private:
+    struct Emitter {
+        ECS::ParticleEmitterComponent params;   // this tick's copy
+        Vector3  origin = { 0.0f, 0.0f, 0.0f };
+        uint32_t spawn  = 0;                    // particles to add this tick
+        float    carry  = 0.0f;                 // fraction of a particle owed by `rate`
+        uint64_t rng    = 0;
+        uint64_t seenTick = 0;
+
+        std::vector<float> x, y, z, vx, vy, vz;
+        std::vector<float> remaining, life;     // seconds
+        BoundingBox bounds = {};                // of the particles, grown by their size
+
+        [[nodiscard]] size_t Size() const { return x.size(); }
+    };
+
+    static void Simulate(Emitter& e, float dt);
+    static void Spawn(Emitter& e, float dt);
+    static void Kill(Emitter& e);
+    static void Bound(Emitter& e);
+
+    static constexpr size_t GRAIN = 1;   // emitters per job
+
+    uint64_t m_tick = 0;
+    std::unordered_map<ECS::EntityId, Emitter> m_emitters;
+    std::vector<Emitter*> m_active;   // this tick's, reused
+    std::vector<const Frame::Emitter*> m_draw;   // this frame's, sorted by batch
+    Frame m_frame;                    // for Draw() without one
+    Stats m_stats;
+};
+
+} // namespace Hotones::GFX
@@ -7,9 +7,12 @@
 
     #include <raymath.h>
     #include <SoundBus.hpp>
+    #include <server/InputCommand.hpp>
+    #include <deque>
     #include <memory>
     // Forward-declare the global SoundBus accessor from the audio system
     namespace Ho_tones { class SoundBus; SoundBus& GetSoundBus(); }
+    namespace Hotones::Net { class NetworkManager; }
     
     namespace Hotones {
         
@@ -39,12 +42,24 @@
     Player();
     ~Player() = default;
 
+    // Per frame: mouse look, head bob and camera.  The camera follows the body
+    // interpolated by Time::FixedTimestep::Get().Alpha().
     void Update();
+    // Per fixed tick: movement input, gravity and collision.  When the
+    // attached network's server moves us, the tick is predicted: the input
+    // goes to the server and its corrections are reconciled here.
+    void FixedUpdate(float dt);
     void AttachCamera(Camera3D* camera);
+    void AttachNetwork(Net::NetworkManager* net) { m_net = net; }
     // Attach the world model for collision checks
     void AttachWorld(std::shared_ptr<class CollidableModel> world);
     void Render();
 
+    // One movement tick of `body`: the whole of what FixedUpdate simulates,
+    // shared with the server so both ends agree (see ServerMovement).
+    static void StepBody(Body& body, char side, char forward, bool jumpPressed, bool crouchHold,
+                         float yaw, float delta, CollidableModel* world, bool enableSourceBhop);
+
     // Enable or disable Source bhop bug
     void SetSourceBhopEnabled(bool enabled) { enableSourceBhop = enabled; }
     bool IsSourceBhopEnabled() const { return enableSourceBhop; }
@@ -78,7 +93,25 @@ private:
     // Shared pointer to world model for collision resolution
     std::shared_ptr<class CollidableModel> m_worldModel = nullptr;
 
-    void UpdateBody(char side, char forward, bool jumpPressed, bool crouchHold);
+    // Body position before the latest tick, for render interpolation
+    Vector3 m_prevPosition = { 0 };
+    // Mouse motion this frame's ticks already turned the view by
+    Vector2 m_tickLook = { 0 };
+
+    // Server movement: ticks sent but not yet covered by a correction, each
+    // with the body it predicted, replayed when a correction disagrees
+    struct PredictedMove {
+        Net::InputCommand cmd;
+        Body              after;
+    };
+    static constexpr size_t MAX_PREDICTED = 128;   // ~2 s at 60 Hz
+    Net::NetworkManager*      m_net = nullptr;
+    std::deque<PredictedMove> m_predicted;
+    uint16_t                  m_inputSeq = 0;
+
+    void UpdateBody(char side, char forward, bool jumpPressed, bool crouchHold, float delta);
+    void PredictMove(char side, char forward, bool jumpPressed, bool crouchHold, float delta);
+    void Reconcile(const Net::BodyCorrection& correction);
     void UpdateCamera();
 };
 
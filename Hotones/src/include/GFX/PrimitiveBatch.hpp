@@ -0,0 +1,87 @@
+#pragma once
+#include <GFX/RenderQueue.hpp>
+#include <raylib.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// ─── PrimitiveBatch ───────────────────────────────────────────────────────────
+//
+// Solid 3-D primitives (boxes, planes, spheres, cylinders / cones) for code
+// that would otherwise call DrawCubeV / DrawSphereEx every frame, which
+// rebuild every vertex on the CPU per call.  Each shape is instead a unit
+// mesh, generated once per level of detail and kept on the GPU, drawn with
+// a transform that places and sizes it.
+//
+// Calls are collected until Flush().  Identical primitives (same shape,
+// detail and colour) are then drawn as one instanced draw call, the rest
+// one call each, all sorted together through a RenderQueue; translucent
+// ones are drawn one by one, back to front.  The look matches raylib's
+// immediate primitives: flat, unlit vertex colour.
+//
+// Cylinders take any pair of radii; the unit mesh keeps their ratio to 1/64
+// of the larger one.
+//
+// Typical use, inside BeginMode3D (ScriptedScene does this for Lua mesh.*):
+//   batch.Box({ 0, 1, 0 }, { 1, 2, 1 }, RED);
+//   batch.Sphere({ 0, 3, 0 }, 0.5f, 16, 16, WHITE);
+//   batch.Flush(camera.position);
+
+namespace Hotones::GFX {
+
+class PrimitiveBatch {
+public:
+    struct Stats {
+        int primitives = 0;   // drawn by the last Flush()
+        int draws      = 0;   // draw calls they took
+        int instanced  = 0;   // of which instanced
+    };
+
+    PrimitiveBatch() = default;
+    ~PrimitiveBatch() { Unload(); }
+    PrimitiveBatch(const PrimitiveBatch&)            = delete;
+    PrimitiveBatch& operator=(const PrimitiveBatch&) = delete;
+
+    // Must be called after InitWindow().  Idempotent.  Without an
+    // instancing shader everything is still drawn, one call per primitive.
+    bool Init();
+    void Unload();
+    bool IsReady() const { return m_ready; }
+
+    // Centred on `centre`, like DrawCubeV / DrawPlane / DrawSphereEx
+    void Box(Vector3 centre, Vector3 size, Color color);
+    void Plane(Vector3 centre, Vector2 size, Color color);
+    void Sphere(Vector3 centre, float radius, int rings, int slices, Color color);
+    // Base centred on `base`, up +Y; a radius of 0 makes a cone
+    void Cylinder(Vector3 base, float radiusTop, float radiusBottom, float height, int slices, Color color);
+
+    // Draw and forget everything added since the last Flush()
+    void Flush(Vector3 viewPos);
+
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    struct Batch {
+        uint32_t            unit  = 0;   // into m_units
+        Color               color = WHITE;
+        std::vector<Matrix> transforms;
+    };
+
+    // Index of the unit mesh for `key`, generated on first use
+    uint32_t Unit(uint64_t key);
+    void     Add(uint64_t unitKey, const Matrix& transform, Color color);
+
+    bool m_ready = false;
+
+    Material m_material          = {};   // raylib's default shader
+    Material m_instancedMaterial = {};   // the same maps, instancing shader
+    Shader   m_instancedShader   = {};
+
+    std::vector<Mesh>                      m_units;
+    std::unordered_map<uint64_t, uint32_t> m_unitIndex;   // shape and detail → m_units
+    std::unordered_map<uint64_t, Batch>    m_batches;     // unit and colour → this frame's
+    RenderQueue                            m_queue;
+    Stats                                  m_stats;
+};
+
+} // namespace Hotones::GFX
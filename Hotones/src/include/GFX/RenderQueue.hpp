@@ -0,0 +1,106 @@
+#pragma once
+#include <raylib.h>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// ─── RenderQueue ──────────────────────────────────────────────────────────────
+//
+// Collects a frame's mesh draws instead of issuing them as they come, then
+// sorts and submits them together so consecutive draws share state.
+//
+// Every draw gets a 64-bit key, most significant first:
+//   Opaque:       pass:2  shader:10  material:14  texture:12  depth:26
+//   Transparent:  pass:2  depth:26 (far first)  shader:10  material:14  texture:12
+// Shaders, materials (by their maps array) and diffuse textures are ranked
+// in order of first use each frame, so the fields stay small.  Opaque draws
+// are grouped by state, then near to far within a group to cut overdraw;
+// transparent ones are blended back to front whatever their state.  Keys
+// are LSD radix-sorted (8-bit digits; digits every key shares are skipped).
+//
+// A draw's pass defaults to Transparent when its diffuse colour has alpha
+// below 255.  Instanced draws keep their transform array in the queue.
+//
+// Typical per-frame usage, inside BeginMode3D:
+//   queue.Begin(camera.position);
+//   world->Draw(frustum, queue);            // Submit()s instead of drawing
+//   models.Draw(registry, frustum, queue);
+//   queue.Flush();                          // sort + DrawMesh / DrawMeshInstanced
+//
+// Immediate primitives (DrawCube, Lua mesh.*) are unaffected: they go into
+// rlgl's own batch and are drawn where they are called.
+
+namespace Hotones::GFX {
+
+enum class RenderPass : uint8_t {
+    Opaque      = 0,
+    Transparent = 1,
+    Auto        = 0xFF,   // Transparent if the diffuse alpha is below 255
+};
+
+class RenderQueue {
+public:
+    struct Stats {
+        int draws          = 0;   // DrawMesh / DrawMeshInstanced calls
+        int shaderChanges  = 0;   // between consecutive draws, after sorting
+        int textureChanges = 0;
+    };
+
+    // Start a frame seen from `viewPos`; drops anything not flushed.
+    void Begin(Vector3 viewPos);
+
+    // Draw `mesh` once with `material` at `transform`.  `diffuse` replaces
+    // the material's diffuse colour for this draw only.
+    void Submit(const Mesh& mesh, const Material& material, const Matrix& transform,
+                RenderPass pass = RenderPass::Auto);
+    void Submit(const Mesh& mesh, const Material& material, Color diffuse, const Matrix& transform,
+                RenderPass pass = RenderPass::Auto);
+
+    // One DrawMeshInstanced() over `count` transforms (copied), so
+    // `material` must be on an instancing shader.
+    void SubmitInstanced(const Mesh& mesh, const Material& material, Color diffuse,
+                         const Matrix* transforms, int count, RenderPass pass = RenderPass::Auto);
+
+    // Sort and draw everything submitted since Begin().
+    void Flush();
+    // The same with every draw on `shader` (`instancedShader` for instanced
+    // ones) instead of its material's, e.g. depth-only shadow passes.
+    void Flush(const Shader& shader, const Shader& instancedShader);
+
+    [[nodiscard]] size_t Size() const { return m_items.size(); }
+
+    // Counts for the last Flush()
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    struct Item {
+        const Mesh* mesh      = nullptr;
+        Material    material  = {};
+        Color       diffuse   = WHITE;
+        uint32_t    first     = 0;   // into m_matrices
+        int         count     = 1;
+        bool        instanced = false;
+    };
+
+    void     Push(const Mesh& mesh, const Material& material, Color diffuse,
+                  const Matrix* transforms, int count, bool instanced, RenderPass pass);
+    uint64_t MakeKey(const Material& material, RenderPass pass, const Matrix& transform);
+    static uint32_t Rank(std::unordered_map<uintptr_t, uint32_t>& ranks, uintptr_t id, uint32_t bits);
+    void     SortKeys();
+    void     Draw(const Shader* shader, const Shader* instancedShader);
+
+    Vector3               m_viewPos = { 0.f, 0.f, 0.f };
+    std::vector<Item>     m_items;
+    std::vector<Matrix>   m_matrices;
+    std::vector<uint64_t> m_keys;      // one per item
+    std::vector<uint32_t> m_order;     // item indices, sorted by key
+    std::vector<uint64_t> m_keyScratch;
+    std::vector<uint32_t> m_orderScratch;
+
+    std::unordered_map<uintptr_t, uint32_t> m_shaderRanks, m_materialRanks, m_textureRanks;
+
+    Stats m_stats;
+};
+
+} // namespace Hotones::GFX
@@ -0,0 +1,72 @@
+#pragma once
+#include <raylib.h>
+#include <unordered_set>
+#include <vector>
+
+// ─── RenderTargetPool ─────────────────────────────────────────────────────────
+//
+// Singleton that hands out offscreen render targets (colour texture plus a
+// depth renderbuffer, like LoadRenderTexture()) and takes them back for
+// reuse, so passes that need a target for a while — scene transitions,
+// post effects — don't create and destroy a framebuffer each time.
+// Creating one stalls the driver, and a full-screen one is several MB.
+//
+// Targets are matched on exact size and colour format.  Released targets
+// wait in a free list; past MAX_FREE_TARGETS the longest unused one is
+// unloaded, so sizes no longer asked for (an old window size) age out.
+// Reserve() creates targets ahead of time, e.g. at startup for the screen
+// size, so even the first use doesn't allocate.
+//
+// Must be used after InitWindow(); Clear() before CloseWindow().  Targets
+// released after the window has closed are simply forgotten.
+//
+// Typical use (SceneManager::SwitchWithTransition does this):
+//   RenderTexture2D rt = GFX::RenderTargetPool::Get().Acquire(w, h);
+//   BeginTextureMode(rt); ... EndTextureMode();
+//   ...
+//   GFX::RenderTargetPool::Get().Release(rt);   // rt is zeroed
+
+namespace Hotones::GFX {
+
+constexpr int MAX_FREE_TARGETS = 6;
+
+class RenderTargetPool {
+public:
+    struct Stats {
+        int created = 0;   // framebuffers made so far
+        int reused  = 0;   // Acquire()s served from the free list
+        int live    = 0;   // handed out and not released
+        int free    = 0;   // waiting for reuse
+    };
+
+    // ── Singleton ─────────────────────────────────────────────────────────────
+    static RenderTargetPool& Get();
+
+    RenderTargetPool(const RenderTargetPool&)            = delete;
+    RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+    // A free target of this size and format, or a new one.  id 0 when the
+    // framebuffer can't be created.
+    RenderTexture2D Acquire(int width, int height, PixelFormat format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    // Give `target` back and zero it.  Targets the pool didn't make are
+    // unloaded instead; id 0 is ignored.
+    void Release(RenderTexture2D& target);
+
+    // Make sure `count` targets of this size and format are free
+    void Reserve(int width, int height, int count, PixelFormat format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    // Unload every free target.  Live ones stay the holder's to release.
+    void Clear();
+
+    Stats GetStats() const;
+
+private:
+    RenderTargetPool() = default;
+
+    std::vector<RenderTexture2D> m_free;   // oldest release first
+    std::unordered_set<unsigned> m_live;   // framebuffer ids handed out
+    Stats                        m_stats;
+};
+
+} // namespace Hotones::GFX
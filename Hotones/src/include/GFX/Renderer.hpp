@@ -6,6 +6,8 @@ struct Color;
 
 namespace Hotones::GFX {
 
+// Lua's render.* draws.  While the calling thread records into a DrawList
+// (a pipelined scene capturing its HUD) they are written there instead.
 class Renderer {
 public:
     // Clear background with RGBA components (0-255)
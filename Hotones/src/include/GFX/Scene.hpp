@@ -3,13 +3,20 @@
 #include <raylib.h>
 #include <memory>
 
+namespace Hotones          { class Player; class CollidableModel; class TransitionScene; }
+namespace Hotones::Net     { class NetworkManager; }
+
 namespace Hotones {
 
 class Scene {
 public:
     virtual ~Scene() = default;
     virtual void Init() {}
-    virtual void Update() = 0;  // update logic (called before Draw)
+    // Simulation step — called 0..N times per frame, before Update(), with
+    // the fixed Time::FixedTimestep::TickDt().  Movement, physics and ECS
+    // systems belong here so they cost the same at any render rate.
+    virtual void FixedUpdate(float /*dt*/) {}
+    virtual void Update() = 0;  // per-frame logic (called before Draw)
     virtual void Draw3D() {}    // 3-D pass — called INSIDE BeginMode3D / EndMode3D
     virtual void Draw() = 0;    // 2-D / HUD pass — called OUTSIDE 3D mode
     virtual void Unload() {}
@@ -19,6 +26,33 @@ public:
     // (e.g. GameScene manages its own BeginMode3D inside Draw()).
     virtual Camera3D* GetCamera() { return nullptr; }
 
+    // ── Capabilities ──────────────────────────────────────────────────────
+    // What the main loop and SceneManager need from a scene, without probing
+    // its concrete type every frame.  The defaults mean "not supported".
+
+    // The locally controlled player, if the scene has one
+    virtual Player* GetPlayer() { return nullptr; }
+    // Level collision, for the host's server-side movement
+    virtual std::shared_ptr<CollidableModel> GetWorld() const { return nullptr; }
+    // Hand the scene a non-owning NetworkManager; SceneManager's owner calls
+    // it once whenever the current scene changes
+    virtual void SetNetworkManager(Net::NetworkManager* /*nm*/) {}
+    // Non-null for a TransitionScene, so SceneManager can install its
+    // incoming scene when it finishes
+    virtual TransitionScene* AsTransition() { return nullptr; }
+
+    // ── Pipelining (see GFX/FramePipeline.hpp) ────────────────────────────
+    // A scene that supports it keeps what Draw3D() / Draw() read in a render
+    // state of its own, filled at the end of Update().  Pipelined, Update()
+    // runs on the simulation thread and fills the back state while the main
+    // thread draws the front one; PublishRenderState() (main thread, nothing
+    // running) swaps them.
+    virtual bool SupportsPipelining() const { return false; }
+    // Entering / leaving pipelined frames; Draw() then reads the published
+    // state rather than capturing its own
+    virtual void SetPipelined(bool /*on*/) {}
+    virtual void PublishRenderState() {}
+
     bool IsFinished() const { return finished; }
 protected:
     void MarkFinished() { finished = true; }
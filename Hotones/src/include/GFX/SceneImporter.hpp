@@ -1,8 +1,14 @@
 #pragma once
 #include <raylib.h>
 #include <raymath.h>
+#include <Assets/AssetCache.hpp>
+#include <GFX/Culling.hpp>
+#include <GFX/LightBake.hpp>
+#include <GFX/MeshView.hpp>
+#include <GFX/RenderQueue.hpp>
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <variant>
@@ -18,10 +24,21 @@
 // Usage:
 //   auto scene = Hotones::SceneImporter::Load("assets/level.glb");
 //   if (scene) {
-//       scene->Draw();
+//       scene->Draw(frustum);   // or Draw() to skip culling
 //       auto* lamp = scene->GetNode("Lamp.001");
 //       if (lamp) { ... lamp->lights, lamp->properties ... }
 //   }
+//
+// Or in the background, uploading a few milliseconds' worth per frame:
+//   auto load = Hotones::SceneImporter::LoadAsync("assets/level.glb");
+//   ...every frame:  if (load->Pump(2.f)) scene = load->Take();
+//
+// Skinned meshes keep their bones and the file's animations come along
+// (see SceneSkin, SceneAnimation); GFX::AnimationSystem poses and draws
+// them for SkinnedModelComponent entities.
+//
+// The scene's lights can be baked into lightmaps and light probes at load
+// (SceneImportOptions::bakeLighting; see GFX/LightBake.hpp).
 
 namespace Hotones {
 
@@ -36,15 +53,35 @@ using PropValue = std::variant<
     Vector4
 >;
 
+// A node's properties, sorted by key.  Keys are interned: every bag in the
+// process shares one copy of each key's text (GLTF files repeat the same
+// few keys on every node), so an entry is a pointer and its value.
 struct PropertyBag {
-    std::unordered_map<std::string, PropValue> data;
+    struct Entry {
+        const std::string* key;   // interned; lives as long as the process
+        PropValue          value;
+        const std::string& Key() const { return *key; }
+    };
+
+    // Add `key`, or replace its value
+    void              Set(const std::string& key, PropValue value);
+    // The value of `key`, or nullptr
+    const PropValue*  Find(const std::string& key) const;
 
-    bool              Has(const std::string& key) const;
+    bool              Has(const std::string& key) const { return Find(key) != nullptr; }
     std::string       GetString (const std::string& key, const std::string& def = "") const;
     double            GetFloat  (const std::string& key, double def = 0.0)             const;
     int64_t           GetInt    (const std::string& key, int64_t def = 0)              const;
     bool              GetBool   (const std::string& key, bool def = false)             const;
     std::optional<Vector3>  GetVec3(const std::string& key) const;
+
+    size_t Size()  const { return m_entries.size(); }
+    bool   Empty() const { return m_entries.empty(); }
+    std::vector<Entry>::const_iterator begin() const { return m_entries.begin(); }
+    std::vector<Entry>::const_iterator end()   const { return m_entries.end(); }
+
+private:
+    std::vector<Entry> m_entries;
 };
 
 // ─── Light ───────────────────────────────────────────────────────────────────
@@ -69,6 +106,7 @@ struct SceneLight {
 struct SceneNode {
     std::string              name;
     Matrix                   transform = MatrixIdentity(); // world-space
+    Matrix                   local     = MatrixIdentity(); // relative to the parent (the bind pose)
     std::vector<std::string> meshNames;  // which render meshes belong here
     PropertyBag              properties; // GLTF extras / aiMetadata
     std::vector<int>         children;   // indices into ImportedScene::nodes
@@ -77,12 +115,84 @@ struct SceneNode {
 
 // ─── Per-mesh render info ─────────────────────────────────────────────────────
 
+// One source mesh inside a merged SceneMesh (SceneImportOptions::mergeByMaterial)
+struct SceneSubMesh {
+    std::string name;
+    int         firstIndex = 0;   // its triangles in the merged mesh's indices
+    int         indexCount = 0;
+    BoundingBox box        = {};  // in the merged mesh's space
+};
+
+// A simplified version of a SceneMesh (SceneImportOptions::lodLevels)
+struct SceneLOD {
+    GFX::MeshView view;          // fewer triangles over the mesh's own vertices
+    float         error = 0.f;   // how far it strays from the full mesh, mesh units
+};
+
+// ─── Skeletal animation ──────────────────────────────────────────────────────
+
+// Bones per skinned mesh, at most: the skinned shader's palette size
+// (LightingSystem).  Assimp splits meshes weighted to more.
+constexpr int MAX_SKIN_BONES = 128;
+
+// Animation LOD levels every skin gets: 0 poses every bone, each further
+// level about half as many (see SceneSkin::lodBones)
+constexpr int SKIN_LOD_LEVELS = 3;
+
+// A bone a skinned mesh's vertices are weighted to
+struct SceneBone {
+    std::string name;
+    int         node   = -1;                 // into ImportedScene::nodes
+    Matrix      offset = MatrixIdentity();   // mesh space → the bone's, in the bind pose
+};
+
+// What a SceneMesh's vertices are bound to: mesh.boneIds / boneWeights hold
+// up to four (bone, weight) pairs per vertex, bones counted in `bones`.
+struct SceneSkin {
+    std::vector<SceneBone> bones;   // empty for a rigid mesh
+
+    // Per animation LOD level, the bone each bone is posed as: itself, or
+    // its nearest kept ancestor.  The bones carrying least of the mesh
+    // (fingers, face) are dropped first.  Filled at load.
+    std::vector<std::vector<uint8_t>> lodBones;
+
+    bool Empty() const { return bones.empty(); }
+};
+
+// Animation keys; times in seconds
+struct SceneVectorKey   { float time; Vector3    value; };
+struct SceneRotationKey { float time; Quaternion value; };
+
+// One node's keys in a SceneAnimation; between keys values are
+// interpolated, past the ends held
+struct SceneAnimChannel {
+    int                           node = -1;   // into ImportedScene::nodes
+    std::vector<SceneVectorKey>   positions;
+    std::vector<SceneRotationKey> rotations;
+    std::vector<SceneVectorKey>   scales;
+};
+
+// A clip: nodes with a channel take their local transform from it, the
+// rest keep their bind pose
+struct SceneAnimation {
+    std::string                   name;
+    float                         duration = 0.f;   // seconds
+    std::vector<SceneAnimChannel> channels;
+    std::vector<int>              nodeChannel;      // per node, into channels or -1; filled at load
+};
+
 struct SceneMesh {
     std::string name;
     Mesh        mesh    = {0};   // raylib Mesh (uploaded to GPU)
-    Material    mat     = {0};   // raylib Material
+    Material    mat     = {0};   // raylib Material (merged chunks of one material share it)
     Matrix      transform = MatrixIdentity(); // node world transform at import time
+    BoundingBox bounds  = {};    // world-space AABB (mesh box through transform)
     int         physicsHandle = -1;          // -1 = not registered
+    std::vector<SceneSubMesh> parts;         // merged meshes only; culled one by one
+    mutable GFX::MeshView     view;          // the parts in view, when there are several
+    std::vector<SceneLOD>     lods;          // coarser and coarser; unmerged meshes only
+    SceneSkin                 skin;          // bones, when skinned (never merged or collided)
+    int                       lightmap = -1; // into ImportedScene::lightmaps, when baked
 };
 
 // ─── Imported scene ──────────────────────────────────────────────────────────
@@ -93,16 +203,63 @@ struct ImportedScene {
     std::vector<SceneNode>  nodes;
     std::vector<SceneLight> lights;
     std::vector<int>        rootNodes; // indices of top-level nodes
+    std::vector<SceneAnimation> animations;
+    // Per animation LOD level, the nodes a pose of every skin needs (kept
+    // bones and their ancestors), parents first.  Filled at load.
+    std::vector<std::vector<int>> poseNodes;
+    int                     physicsHandle = -1;  // the whole scene's, when merged
+    std::vector<Assets::TextureHandle> textures;  // its materials' textures, from the AssetCache
+
+    // Baked lighting (SceneImportOptions::bakeLighting): the lightmapped
+    // meshes' lightmaps, which their own materials hold, and the probes,
+    // for GFX::LightingSystem::SetLightProbes()
+    std::vector<Texture2D>  lightmaps;
+    GFX::LightProbeGrid     probes;
+
+    // What cullTree holds: every mesh without parts, and every part of the rest
+    struct CullItem {
+        int mesh;
+        int part;   // -1 → the whole mesh
+    };
+    std::vector<CullItem>   cullItems;
+    GFX::CullingBVH         cullTree;  // over cullItems' bounds; rebuild with BuildCullTree()
 
     // ── Rendering ──────────────────────────────────────────────────────────
 
-    // Draw all visible meshes (applies per-mesh transform).
+    // Draw all meshes (applies per-mesh transform).
     void Draw() const;
+    // Draw only the meshes whose bounds reach into `frustum`.
+    void Draw(const GFX::Frustum& frustum) const;
+    // Submit them to `queue` instead, to be drawn sorted at its Flush().
+    void Draw(const GFX::Frustum& frustum, GFX::RenderQueue& queue) const;
     // Draw with an override tint.
     void DrawTinted(Color tint) const;
+    void DrawTinted(Color tint, const GFX::Frustum& frustum) const;
+
+    // Recompute every mesh's bounds and the cull tree; Load() does this, call
+    // it again after moving meshes (changing their transform).
+    void BuildCullTree();
+
+    // Level of detail: culled draws show each mesh as its coarsest LOD whose
+    // error would cover at most lodPixelError pixels on screen, seen from
+    // the view given here.  Call it every frame before drawing; until then
+    // meshes are drawn in full.  `screenHeight` is the target's, in pixels.
+    void SetLODView(const Camera& camera, float screenHeight);
+
+    float   lodPixelError    = 1.f;    // from SceneImportOptions
+    Vector3 lodEye           = {};
+    float   lodPixelsPerUnit = 0.f;    // at distance 1; 0 → no LODs
+    bool    lodPerspective   = true;
+
+    // Parts of merged meshes the last culled draw found in view (sorted
+    // cullItems indices) and what the meshes' views were last filled with.
+    mutable std::vector<uint32_t> visibleParts, drawnParts;
 
     // ── Node queries ───────────────────────────────────────────────────────
 
+    // Answered from indexes Load() builds over the nodes (BuildNodeIndex());
+    // results are in node order.
+
     // Find first node whose name equals `name` (case-sensitive). Returns nullptr if not found.
     const SceneNode* GetNode(const std::string& name) const;
           SceneNode* GetNode(const std::string& name);
@@ -112,9 +269,36 @@ struct ImportedScene {
     // Find all nodes whose name contains `substr`.
     std::vector<const SceneNode*> FindNodesByName(const std::string& substr) const;
 
+    // Rebuild the node indexes; call it again after adding, removing or
+    // renaming nodes or changing their properties.
+    void BuildNodeIndex();
+
+    struct NodeIndex {
+        std::unordered_map<std::string, int>                   byName;       // first node of each name
+        std::unordered_map<std::string_view, std::vector<int>> byProperty;   // on interned keys
+        std::string      names;        // every name, in node order, each followed by '\0'
+        std::vector<int> nameStart;    // where each node's name begins in `names`
+    };
+    NodeIndex nodeIndex;
+
     // ── Light queries ──────────────────────────────────────────────────────
     const std::vector<SceneLight>& GetLights() const { return lights; }
 
+    // ── Animation ──────────────────────────────────────────────────────────
+
+    // True if any mesh is skinned
+    bool IsSkinned() const;
+    // Index into animations of the clip called `name`, or -1
+    int  FindAnimation(const std::string& name) const;
+
+    // ── Physics ────────────────────────────────────────────────────────────
+
+    // Block until the collision meshes registered for this scene are built
+    // (see Physics::WaitForMeshes).  True if every one is ready; true as
+    // well when none were registered.  A merged scene has a single one,
+    // `physicsHandle`, over every mesh.
+    bool WaitForPhysics(float timeoutSeconds = -1.f) const;
+
     // ── Lifecycle ──────────────────────────────────────────────────────────
     void Unload();
 };
@@ -125,17 +309,119 @@ struct SceneImportOptions {
     bool registerPhysics = true;   // register mesh triangles with PhysicsSystem
     bool flipUVs         = true;   // flip V coord (OpenGL convention)
     bool generateNormals = true;   // generate smooth normals if missing
-    bool mergeByMaterial = false;  // merge meshes that share a material
+    bool mergeByMaterial = false;  // batch meshes that share a material (see Load)
+    bool geometryOnly    = false;  // positions, indices, nodes and lights; no GPU (see Load)
     float scale          = 1.0f;   // uniform scale applied at load time
+    std::string cookDir  = "cache/scenes";   // cooked copies of source files (see Load); "" = none
+    std::string textureCookDir = "cache/textures";   // compressed, mipmapped textures (TextureCook.hpp); "" = none
+
+    int   lodLevels      = 0;      // simplified versions made per mesh (see Load)
+    float lodReduction   = 0.5f;   // share of triangles each keeps of the one before
+    float lodPixelError  = 1.0f;   // on-screen error allowed when picking one, pixels
+    std::string lodCacheDir = "cache/lod";   // simplified meshes kept here; "" = none
+
+    bool bakeLighting    = false;  // bake the scene's lights (see Load)
+    GFX::LightBakeOptions lightBake;
+};
+
+// ─── Background load ─────────────────────────────────────────────────────────
+//
+// A scene being loaded by SceneImporter::LoadAsync().  The file is parsed
+// and converted on worker threads; what needs the GL context (meshes,
+// textures, views) and PhysicsSystem registration is left for Pump(), on
+// the main thread, which does as much as fits in its time budget.
+// Everything but the constructor belongs to the main thread.  Destroying
+// it stops the load and frees whatever Take() didn't hand out.
+class SceneLoad {
+public:
+    struct State;   // SceneImporter.cpp
+    explicit SceneLoad(std::shared_ptr<State> state);
+    ~SceneLoad();
+    SceneLoad(const SceneLoad&)            = delete;
+    SceneLoad& operator=(const SceneLoad&) = delete;
+
+    // Upload for about `budgetMs` (at least one step once decoded).  True
+    // when the load is over, done or failed.
+    bool Pump(float budgetMs);
+
+    bool        IsDone()   const;   // done or failed
+    bool        Failed()   const;
+    float       Progress() const;   // [0,1]; decoding is the first half
+    std::string Error()    const;   // why it failed; "" otherwise
+
+    // The scene once done, else nullptr.  Only the first call gets it.
+    std::unique_ptr<ImportedScene> Take();
+
+private:
+    std::shared_ptr<State> m_state;   // shared with the decode job
 };
 
 class SceneImporter {
 public:
     // Load a file using Assimp.  Returns nullptr on failure.
     // Supported formats: GLTF/GLB, OBJ, FBX, DAE, 3DS, …
+    //
+    // With opts.mergeByMaterial the scene is batched for static drawing:
+    // meshes sharing a material are baked into world space and merged into
+    // one vertex / index buffer (a new one every 65535 vertices), each source
+    // mesh kept as a SceneSubMesh range that is culled on its own; the parts
+    // in view are drawn with one call per merged mesh through its MeshView.
+    // Node meshNames then name parts, and physics gets one handle for the
+    // whole scene instead of one per mesh.
+    //
+    // With opts.lodLevels every other mesh gets that many levels of detail
+    // (GFX::BuildLODChain, cached under opts.lodCacheDir so an unchanged
+    // mesh is simplified once), drawn by the culled Draw()s from the view
+    // given to ImportedScene::SetLODView.  Merged meshes get none.  Physics
+    // always uses the full meshes.
+    //
+    // With opts.cookDir the first load writes what Assimp made of the file
+    // (meshes, nodes, lights, properties, material values and texture
+    // paths) to a cooked binary there, keyed by the file's path, size and
+    // modification time and the options that change the import; later
+    // loads read that instead, without Assimp.  Cook() writes it ahead of
+    // time, e.g. when packaging, along with the scene's textures (into
+    // opts.textureCookDir, which loads read them from the same way).
+    //
+    // Skinned meshes (at most MAX_SKIN_BONES bones each; Assimp splits the
+    // rest) are never merged, simplified or given collision: they move.
+    //
+    // With opts.bakeLighting the scene's lights are baked over its static
+    // meshes (GFX::BakeLighting, cached under opts.lightBake.cacheDir).
+    // Meshes with lightmap UVs get a lightmap, in a material of their own
+    // drawn with LightingSystem::GetLightmappedShader(); the probes are
+    // left in `probes`.  Merged meshes keep lightmap UVs when all their
+    // members have them.  Cook() bakes too.
+    //
+    // With opts.geometryOnly (dedicated servers) meshes keep only positions
+    // and indices, in CPU memory, for physics and queries: no normals, UVs,
+    // tangents or colours, no materials or textures, no views, LODs or
+    // baked lighting, and nothing touches the GL context.  Nodes, their
+    // properties and lights are as usual.  Such a scene can't be drawn.  A
+    // full cooked copy serves these loads too.
+    //
+    // Blocks until the scene is on the GPU; LoadAsync() is the same load
+    // without the wait.
     static std::unique_ptr<ImportedScene> Load(
         const std::string& path,
         const SceneImportOptions& opts = {});
+
+    // Start loading on worker threads; Pump() the result every frame
+    // (LoadingScene::Track does) until it is done, then Take() the scene.
+    static std::shared_ptr<SceneLoad> LoadAsync(
+        const std::string& path,
+        const SceneImportOptions& opts = {});
+
+    // `scene` held by all who draw it, Unload()ed with the last reference;
+    // e.g. one character rig for many SkinnedModelComponents.
+    static std::shared_ptr<const ImportedScene> Share(std::unique_ptr<ImportedScene> scene);
+
+    // Write the cooked copy of `path` to opts.cookDir now (and its baked
+    // lighting, with opts.bakeLighting).  False when the file can't be
+    // imported or the copy can't be written.
+    static bool Cook(
+        const std::string& path,
+        const SceneImportOptions& opts = {});
 };
 
 } // namespace Hotones
@@ -2,7 +2,10 @@
 #pragma once
 
 #include "Scene.hpp"
+#include <GFX/RenderTargetPool.hpp>
 #include <GFX/TransitionScene.hpp>
+#include <Profile/Profiler.hpp>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <unordered_map>
@@ -35,6 +38,7 @@ public:
         inst->Init();
         currentName = name;
         stack.push_back(std::move(inst));
+        ++generation;
     }
 
     // Switch with transition: capture outgoing snapshot and push a TransitionScene that will
@@ -43,21 +47,13 @@ public:
         auto it = factories.find(name);
         if (it == factories.end()) return;
 
-        // Capture current top scene into a render texture
-        RenderTexture2D outTex = {0};
-        if (!stack.empty()) {
-            outTex = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
-            BeginTextureMode(outTex);
-            ClearBackground(BLACK);
-            stack.back()->Draw();
-            EndTextureMode();
-        } else {
-            // create a blank texture
-            outTex = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
-            BeginTextureMode(outTex);
-            ClearBackground(BLACK);
-            EndTextureMode();
-        }
+        // Capture current top scene into a pooled render texture (blank
+        // without one); the TransitionScene gives it back
+        RenderTexture2D outTex = GFX::RenderTargetPool::Get().Acquire(GetScreenWidth(), GetScreenHeight());
+        BeginTextureMode(outTex);
+        ClearBackground(BLACK);
+        if (!stack.empty()) stack.back()->Draw();
+        EndTextureMode();
 
         // Clear existing stack but keep outTex for transition to draw
         if (!stack.empty()) {
@@ -75,6 +71,7 @@ public:
             auto transition = std::make_unique<TransitionScene>(outTex, std::move(incoming), duration);
             transition->Init();
             stack.push_back(std::move(transition));
+            ++generation;
         // set pending target so we can assign the name when the incoming scene is installed
         pendingTargetName = name;
         // mark currentName as transition
@@ -89,6 +86,7 @@ public:
         inst->Init();
         stack.push_back(std::move(inst));
         currentName = name;
+        ++generation;
     }
 
     // Pop the top scene; if any remaining, it resumes as current
@@ -96,6 +94,7 @@ public:
         if (stack.empty()) return;
         stack.back()->Unload();
         stack.pop_back();
+        ++generation;
         if (!stack.empty()) {
             // currentName becomes the factory key of the resumed scene if known
             // We don't track reverse mapping here; leave currentName unchanged or empty
@@ -105,21 +104,29 @@ public:
         }
     }
 
+    // Fixed simulation tick for the top scene
+    void FixedUpdate(float dt) {
+        HOTONES_ZONE("SceneManager::FixedUpdate");
+        if (!stack.empty()) stack.back()->FixedUpdate(dt);
+    }
+
     // Update top scene
     void Update() {
+        HOTONES_ZONE("SceneManager::Update");
         if (!stack.empty()) {
             stack.back()->Update();
 
             // If the top scene finished, handle it here
             if (stack.back()->IsFinished()) {
                 // If it is a TransitionScene, extract the incoming instance and push it
-                TransitionScene *ts = dynamic_cast<TransitionScene*>(stack.back().get());
+                TransitionScene *ts = stack.back()->AsTransition();
                 if (ts) {
                     // take ownership of incoming
                     std::unique_ptr<Scene> incoming = ts->ReleaseIncoming();
                     // unload and pop transition
                     stack.back()->Unload();
                     stack.pop_back();
+                    ++generation;
 
                     if (incoming) {
                         // push the incoming scene as the active scene
@@ -140,16 +147,23 @@ public:
 
     // 3-D pass — call INSIDE BeginMode3D / EndMode3D
     void Draw3D() {
+        HOTONES_ZONE("SceneManager::Draw3D");
+        HOTONES_GPU_ZONE("Draw3D");
         if (!stack.empty()) stack.back()->Draw3D();
     }
 
     // 2-D / HUD pass — call OUTSIDE 3D mode
     void Draw() {
+        HOTONES_ZONE("SceneManager::Draw");
+        HOTONES_GPU_ZONE("Draw");
         if (!stack.empty()) stack.back()->Draw();
     }
 
     Scene *GetCurrent() { return stack.empty() ? nullptr : stack.back().get(); }
     const std::string &GetCurrentName() const { return currentName; }
+    // Bumped whenever GetCurrent() changes, so callers can redo per-scene
+    // setup (network attach, cached capabilities) only on a switch
+    uint64_t GetGeneration() const { return generation; }
 
 private:
     std::unordered_map<std::string, SceneFactory> factories;
@@ -157,6 +171,7 @@ private:
     std::string currentName;
     // Used when a SwitchWithTransition is initiated to remember the incoming target name
     std::string pendingTargetName;
+    uint64_t generation = 0;
 };
 
 } // namespace Hotones
@@ -1,15 +1,28 @@
 #pragma once
 
 #include <GFX/Scene.hpp>
+#include <GFX/AnimationSystem.hpp>
+#include <GFX/DrawList.hpp>
 #include <GFX/Player.hpp>
+#include <GFX/ModelRenderSystem.hpp>
+#include <GFX/OcclusionCulling.hpp>
+#include <GFX/ParticleSystem.hpp>
+#include <GFX/PrimitiveBatch.hpp>
+#include <GFX/ShadowAtlas.hpp>
 #include <ECS/Registry.hpp>
+#include <ECS/Replication.hpp>
+#include <ECS/SpatialIndex.hpp>
+#include <ECS/SystemScheduler.hpp>
+#include <Memory/MemoryTracker.hpp>
 #include <memory>
+#include <vector>
 #include <raylib.h>
 
 // Forward declarations
 namespace Hotones          { class CollidableModel; }
 namespace Hotones::Net     { class NetworkManager;  }
-namespace Hotones::Scripting { class CupLoader;     }
+namespace Hotones::Scripting { class CupLoader; class ScriptSystem; }
+namespace Ho_tones         { class SpatialAudioSystem; }
 
 namespace Hotones {
 
@@ -19,10 +32,21 @@ namespace Hotones {
 ///   1. ClearBackground
 ///   2. BeginMode3D
 ///       – world model (if Init.MainScene was set)
-///       – script.draw3D()   ← Lua calls mesh.* here (immediate 3D raylib calls)
+///       – ECS RenderModelComponent entities, instanced (ModelRenderSystem)
+///       – ECS SkinnedModelComponent characters, GPU skinned (AnimationSystem)
+///       (all less what the world model's large meshes hid last frame; see
+///       OcclusionCuller)
+///       – script.draw3D()'s mesh.* draws; solid primitives are batched
+///         and drawn together
+///       – ECS ParticleEmitterComponent particles, one batch per texture
 ///       – remote player ghosts
 ///   3. EndMode3D
-///   4. script.draw()        ← Lua calls render.* here (2D HUD overlay)
+///   4. script.draw()'s render.* draws (2D HUD overlay)
+///
+/// draw3D() and draw() don't run inside that pipeline: they are called when
+/// the render state is captured (see RenderState), with their mesh.* and
+/// render.* calls recorded into draw lists that the pipeline replays at
+/// their place.
 ///
 /// If Init.MainScene is empty (or not set), a procedural flat ground plane is
 /// drawn so the player has something to stand on.
@@ -33,22 +57,60 @@ public:
     ~ScriptedScene() override;
 
     void Init()   override;
+    void FixedUpdate(float dt) override;
     void Update() override;
     void Draw()   override;
     void Unload() override;
 
-    Player* GetPlayer() { return &m_player; }
+    Player* GetPlayer() override { return &m_player; }
+
+    void SetNetworkManager(Net::NetworkManager* nm) override;
 
-    void SetNetworkManager(Net::NetworkManager* nm);
+    bool SupportsPipelining() const override { return true; }
+    void SetPipelined(bool on) override;
+    void PublishRenderState() override;
+
+    /// Level collision (null without a MainScene), for server-side movement.
+    std::shared_ptr<CollidableModel> GetWorld() const override { return m_world; }
 
 private:
+    /// Everything Draw() reads that the simulation writes, as of one
+    /// Update().  Serial frames capture it just before drawing; pipelined
+    /// ones at the end of Update(), on the simulation thread, into the back
+    /// state, while the front one is drawn.
+    struct RenderState {
+        Camera                                        camera = {};
+        std::vector<GFX::ModelRenderSystem::Instance> models;      ///< RenderModelComponent entities
+        GFX::AnimationSystem::Frame                   characters;  ///< SkinnedModelComponent entities, posed
+        GFX::ParticleSystem::Frame                    particles;
+        GFX::DrawList                                 scene3D;     ///< Lua draw3D()
+        GFX::DrawList                                 hud;         ///< Lua draw()
+    };
+
     Scripting::CupLoader*            m_script   = nullptr;
     Player                           m_player;
     Camera                           m_camera   = {};
     std::shared_ptr<CollidableModel> m_world;
     Net::NetworkManager*             m_netMgr   = nullptr;
     ECS::Registry                    m_registry;   ///< ECS world for this scene
+    Memory::TaggedBytes              m_registryBytes{ Memory::Tag::ECS }; ///< its pools, as of the last tick
+    ECS::SystemScheduler             m_systems;    ///< per-frame ECS systems (parallel stages)
+    Ho_tones::SpatialAudioSystem*    m_audio    = nullptr; ///< in m_systems; hears from m_camera
+    Scripting::ScriptSystem*         m_scripts  = nullptr; ///< in m_systems with a pack; entity update()s
+    GFX::ParticleSystem*             m_particles = nullptr; ///< in m_systems; drawn after the Lua 3D pass
+    GFX::AnimationSystem*            m_animation = nullptr; ///< in m_systems; drawn with the world
+    ECS::SpatialIndex*               m_spatial  = nullptr; ///< in m_systems; ecs.queryRadius / queryBox
+    ECS::EntityReplicator            m_replicator; ///< tagged entities to clients / from the server
+    GFX::ModelRenderSystem           m_models;     ///< draws RenderModelComponent entities
+    GFX::RenderQueue                 m_queue;      ///< sorts the frame's mesh draws
+    GFX::PrimitiveBatch              m_primitives; ///< Lua mesh.* solids, instanced
+    GFX::ShadowCasters               m_shadowCasters; ///< world (static) and models (dynamic)
+    GFX::OcclusionCuller             m_occlusion;  ///< the world's large meshes hide the rest
+    RenderState                      m_states[2];
+    int                              m_front     = 0;     ///< index of the state drawn
+    bool                             m_pipelined = false;
 
+    void CaptureRenderState(RenderState& state);
     void DrawFallbackGround() const;
 };
 
@@ -0,0 +1,72 @@
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+#include <string>
+
+// ─── ShaderCache ──────────────────────────────────────────────────────────────
+//
+// Singleton that keeps linked shader programs on disk (glGetProgramBinary),
+// so a shader compiled once is loaded back, not compiled, on later runs.
+// Load() is a drop-in for LoadShaderFromMemory(): it returns the same
+// Shader, with raylib's default locations filled in, whichever way it got
+// the program.
+//
+// A cached program is keyed by both sources and the driver's vendor,
+// renderer and version strings, so an edited shader or an updated driver
+// misses and compiles from source again.  A driver may still turn a binary
+// down (glProgramBinary fails to link): that file is deleted and the
+// source is compiled instead.  Without a directory, or on a context with
+// no program binary formats (GL 2.1, ES 2), Load() only compiles.
+//
+// Main thread, after InitWindow().
+//
+//   GFX::ShaderCache::Get().SetDirectory("cache/shaders");   // at startup
+//   Shader lit = GFX::ShaderCache::Get().Load(kLitVS, fs.c_str());
+
+namespace Hotones::GFX {
+
+class ShaderCache {
+public:
+    struct Stats {
+        int hits     = 0;   // programs loaded from a binary
+        int compiled = 0;   // programs compiled from source
+        int stored   = 0;   // binaries written
+        int rejected = 0;   // binaries the driver refused, or damaged files
+    };
+
+    // ── Singleton ─────────────────────────────────────────────────────────────
+    static ShaderCache& Get();
+
+    ShaderCache(const ShaderCache&)            = delete;
+    ShaderCache& operator=(const ShaderCache&) = delete;
+
+    // Where binaries live; created on the first store.  Empty turns the
+    // cache off.
+    void SetDirectory(const std::string& dir) { m_dir = dir; }
+    const std::string& Directory() const { return m_dir; }
+
+    // LoadShaderFromMemory(vs, fs), through the cache.  Unload the result
+    // with UnloadShader() as usual.
+    Shader Load(const char* vsCode, const char* fsCode);
+
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    ShaderCache() = default;
+
+    // Looks the GL entry points up on first use; false without them
+    bool Available();
+    uint64_t    Key(const char* vsCode, const char* fsCode) const;
+    std::string PathFor(uint64_t key) const;
+    // A Shader around a program rebuilt from `path`, id 0 on a miss
+    Shader FromBinary(const std::string& path, uint64_t key);
+    bool   Store(unsigned int program, const std::string& path, uint64_t key);
+
+    std::string m_dir;
+    std::string m_driver;            // vendor, renderer and version, for the key
+    bool        m_checked = false;   // Available() has run
+    bool        m_usable  = false;
+    Stats       m_stats;
+};
+
+} // namespace Hotones::GFX
@@ -0,0 +1,131 @@
+#pragma once
+#include <GFX/Culling.hpp>
+#include <GFX/RenderQueue.hpp>
+#include <raylib.h>
+#include <array>
+#include <functional>
+#include <vector>
+
+// ─── ShadowAtlas ──────────────────────────────────────────────────────────────
+//
+// Shadow maps for LightingSystem, all in one depth atlas of SHADOW_TILES
+// square tiles:
+//   directional — SHADOW_CASCADES tiles, cascades over the first
+//                 SHADOW_DISTANCE units of the view (first such light only)
+//   spot        — one tile, a perspective view down the cone
+//   point       — six tiles, one per cube face (+X −X +Y −Y +Z −Z)
+// Tiles go to shadow-casting lights nearest the camera first and stay with
+// a light while it keeps casting; lights that do not get tiles are unshadowed.
+//
+// Casters come in two kinds, drawn through ShadowCasters into a RenderQueue
+// flushed with a depth-only shader:
+//   static  — rendered once into a second, cached atlas, and again only when
+//             the tile's light-space view changes (the light moved, or a
+//             cascade's snapped centre did) or InvalidateStatic() is called.
+//             At most GetBudget() such re-renders happen per frame, nearest
+//             first; a tile waiting its turn keeps its previous contents.
+//   dynamic — drawn every frame over a copy of the cached tile, and only for
+//             tiles whose view they reach.
+//
+// Typical use: LightingSystem::RenderShadows(camera, casters), before
+// UploadUniforms() and outside BeginMode3D.
+
+namespace Hotones::GFX {
+
+struct LightDesc;
+
+constexpr int   SHADOW_ATLAS_SIZE = 2048;
+constexpr int   SHADOW_TILE_SIZE  = 512;
+constexpr int   SHADOW_GRID       = SHADOW_ATLAS_SIZE / SHADOW_TILE_SIZE;
+constexpr int   SHADOW_TILES      = SHADOW_GRID * SHADOW_GRID;
+constexpr int   SHADOW_CASCADES   = 3;
+constexpr float SHADOW_DISTANCE   = 80.0f;   // view depth the cascades cover
+
+struct ShadowCasters {
+    // Submit what lies in `frustum` to `queue`; either may be empty
+    std::function<void(const Frustum& frustum, RenderQueue& queue)> drawStatic;
+    std::function<void(const Frustum& frustum, RenderQueue& queue)> drawDynamic;
+};
+
+class ShadowAtlas {
+public:
+    struct Stats {
+        int tiles   = 0;   // tiles in use
+        int renders = 0;   // static tiles re-rendered this frame
+        int pending = 0;   // static tiles still out of date (over budget)
+        int dynamic = 0;   // tiles that had dynamic casters drawn
+    };
+
+    // Must be called after InitWindow().  Idempotent.
+    bool Init();
+    void Unload();
+    bool IsReady() const { return m_ready; }
+
+    // Static tiles re-rendered per frame at most (at least 1)
+    void SetBudget(int tilesPerFrame) { m_budget = tilesPerFrame > 1 ? tilesPerFrame : 1; }
+    int  GetBudget() const { return m_budget; }
+
+    // Static geometry changed: re-render every cached tile (within budget).
+    void InvalidateStatic();
+
+    // Hand out tiles for lights[0..count), bring cached tiles up to date and
+    // draw the dynamic casters.  Rebinds the framebuffer, viewport and
+    // matrices, and restores them after.
+    void Render(const Camera& camera, float aspect, const LightDesc* lights, int count,
+                const ShadowCasters& casters);
+
+    // First tile of light `slot`, or -1 while it has no complete shadow
+    int FirstTile(int slot) const;
+
+    // Atlas-space transform of a tile: world → (u, v, depth), all 0–1
+    const Matrix& TileMatrix(int tile) const { return m_tiles[tile].sample; }
+
+    // View depths where each cascade ends
+    const float* CascadeSplits() const { return m_splits.data(); }
+
+    // Depth texture to sample (rlgl id)
+    unsigned int Texture() const { return m_liveDepth; }
+
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    struct Tile {
+        int    owner  = -1;      // light slot, -1 when free
+        int    face   = 0;       // cascade / cube face within the light
+        bool   ready  = false;   // static contents rendered at least once
+        bool   stale  = true;    // static contents out of date
+        bool   copied = false;   // live tile holds only the static contents
+        Matrix view   = {};      // what the static contents were rendered with
+        Matrix proj   = {};
+        Matrix sample = {};      // view × proj × tile bias, for the shader
+        Matrix wantView = {};    // this frame's
+        Matrix wantProj = {};
+        float  priority = 0.f;   // lower re-renders first
+    };
+
+    // Light-space view and projection of a tile's light, face
+    void Want(const Camera& camera, const LightDesc& light, Tile& tile) const;
+    void Assign(const Camera& camera, const LightDesc* lights, int count);
+    // Flush m_queue into `tile` of the bound atlas
+    void DrawTile(int tile, const Matrix& view, const Matrix& proj, bool clear);
+
+    bool   m_ready  = false;
+    int    m_budget = 4;
+
+    // Depth-only, as the cached and live framebuffers
+    Shader       m_depthShader          = {};
+    Shader       m_depthInstancedShader = {};
+    unsigned int m_staticFbo   = 0, m_staticDepth = 0;
+    unsigned int m_liveFbo     = 0, m_liveDepth   = 0;
+
+    std::array<Tile, SHADOW_TILES>      m_tiles;
+    std::array<float, SHADOW_CASCADES>  m_splits = {};
+    std::array<float, SHADOW_CASCADES>  m_radii  = {};   // sphere around each cascade slice
+    std::array<float, SHADOW_CASCADES>  m_centre = {};   // its view depth
+    std::vector<int>                    m_first;         // per light slot
+    std::vector<int>                    m_order;         // scratch
+    RenderQueue                         m_queue;
+    Stats                               m_stats;
+};
+
+} // namespace Hotones::GFX
@@ -0,0 +1,94 @@
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// ─── TextCache ────────────────────────────────────────────────────────────────
+//
+// Singleton that keeps laid-out text runs, so UI text drawn every frame
+// isn't decoded, looked up glyph by glyph and measured again each time.
+// A run is keyed by the string, the font and the size and spacing; it holds
+// the text's extents and one textured quad per visible glyph, positioned
+// relative to the run's origin.  Drawing a run is one batch check and one
+// texture bind for the font's atlas, then its quads straight into rlgl's
+// batch, instead of DrawTextEx()'s per-glyph DrawTexturePro().
+//
+// MeasureText() / DrawText() are drop-in replacements for raylib's with the
+// default font (spacing fontSize / 10, at least size 10); the Ex forms take
+// any font.  Runs not drawn or measured for EVICT_FRAMES frames are dropped,
+// and at most MAX_RUNS are kept, so counters that change every frame
+// (FPS, timers) don't grow it without bound.  Line breaks advance by the
+// size plus raylib's default line spacing (2); SetTextLineSpacing() is not
+// seen.
+//
+// Main thread, after InitWindow().
+//
+//   GFX::TextCache& text = GFX::TextCache::Get();
+//   const int w = text.MeasureText(label, 20);
+//   text.DrawText(label, (sw - w) / 2, y, 20, WHITE);
+
+namespace Hotones::GFX {
+
+class TextCache {
+public:
+    static constexpr int    LINE_SPACING = 2;      // raylib's default textLineSpacing
+    static constexpr size_t MAX_RUNS     = 2048;
+    static constexpr int    EVICT_FRAMES = 300;
+
+    struct Stats {
+        uint64_t hits   = 0;   // draws and measures served by a cached run
+        uint64_t builds = 0;   // runs laid out
+        size_t   runs   = 0;   // cached now
+    };
+
+    // ── Singleton ─────────────────────────────────────────────────────────────
+    static TextCache& Get();
+
+    TextCache(const TextCache&)            = delete;
+    TextCache& operator=(const TextCache&) = delete;
+
+    // As raylib's, with the default font
+    int  MeasureText(std::string_view text, int fontSize);
+    void DrawText(std::string_view text, int x, int y, int fontSize, Color color);
+
+    Vector2 MeasureTextEx(const Font& font, std::string_view text, float fontSize, float spacing);
+    void    DrawTextEx(const Font& font, std::string_view text, Vector2 position, float fontSize, float spacing,
+                       Color tint);
+
+    // Drop every run (e.g. after unloading a font)
+    void Clear() { m_runs.clear(); }
+
+    Stats GetStats() const;
+
+private:
+    struct Quad {
+        Rectangle src;   // in the atlas
+        Rectangle dst;   // relative to the run's origin
+    };
+    struct Run {
+        std::string       text;
+        const void*       glyphs = nullptr;   // the font it was laid out with
+        unsigned int      texture = 0;
+        float             size = 0.f, spacing = 0.f;
+        Vector2           extents{};          // as MeasureTextEx()
+        std::vector<Quad> quads;
+        uint64_t          lastUse = 0;        // frame
+    };
+
+    TextCache() = default;
+
+    // The run for these arguments, laid out now if not cached
+    const Run& Lookup(const Font& font, std::string_view text, float fontSize, float spacing);
+    static void Build(Run& run, const Font& font);
+    // Drop runs unused for EVICT_FRAMES, or the oldest past MAX_RUNS
+    void Sweep(uint64_t frame);
+
+    std::unordered_map<uint64_t, Run> m_runs;
+    uint64_t                          m_nextSweep = 0;
+    Stats                             m_stats;
+};
+
+} // namespace Hotones::GFX
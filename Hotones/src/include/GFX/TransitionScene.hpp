@@ -15,16 +15,18 @@ public:
     ~TransitionScene();
 
     void Init() override;
+    void FixedUpdate(float dt) override;
     void Update() override;
     void Draw() override;
     void Unload() override;
+    TransitionScene* AsTransition() override { return this; }
 
     // After the transition finishes, SceneManager can take ownership of the instantiated incoming scene
     std::unique_ptr<Scene> ReleaseIncoming();
 
 private:
-    RenderTexture2D outTexture;
-    RenderTexture2D inTexture;
+    RenderTexture2D outTexture = {};   // both from GFX::RenderTargetPool
+    RenderTexture2D inTexture  = {};
     bool inTextureReady = false;
     std::unique_ptr<Scene> incomingInstance;
 
@@ -86,7 +86,8 @@ public:
                                           int spacing = 4, int padding = 4);
     // Set the root element to render
     void SetRoot(Hotones::GFX::UIElement* root);
-    // Render the root element within the given rectangle (measure, layout, draw)
+    // Render the root element within the given rectangle (measure, layout, draw);
+    // measuring and layout are skipped while nothing in the tree changed
     void RenderLayout(int x, int y, int w, int h) const;
 
 private:
@@ -1,14 +1,125 @@
 #pragma once
-#include <vector>
-#include <filesystem>
+#include <GFX/Culling.hpp>
+#include <GFX/MeshView.hpp>
+#include <GFX/RenderQueue.hpp>
 #include <raylib.h>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
 
 namespace Hotones {
 
-// Load one or more raylib `Model` objects from a Quake BSP file.
-// Returns an empty vector on failure.
+// Load one or more raylib `Model` objects from a Quake BSP file, one per wall
+// texture (more for very large ones), without visibility data.  The caller
+// owns the models and their diffuse textures.  Returns an empty vector on
+// failure.
 
 std::vector<Model>
 LoadModelsFromBSPFile(const std::filesystem::path& path);
 
+// ─── BSPWorld ─────────────────────────────────────────────────────────────────
+//
+// A Quake (version 29) BSP level: the world's faces as one Model, plus the
+// BSP tree, leaves and potentially visible sets (PVS) the compiler stored
+// with them, so only what can be seen from the camera's leaf is drawn.
+//
+// Load() fills the caller's Model with one indexed mesh per wall texture
+// (split every 65535 vertices), in engine units: Quake (x, y, z) becomes
+// (y, z, x) scaled by BSP_SCALE.  Only the world (BSP model 0) is loaded;
+// brush entities such as doors are not.  The caller unloads the Model as
+// usual; Unload() frees what BSPWorld keeps besides it (textures, the
+// visibility index buffers).
+//
+// Draw() walks the tree to the leaf containing the eye, decompresses that
+// leaf's PVS when the leaf changes, and keeps the PVS leaves whose bounds
+// reach into the frustum.  Every mesh has a GFX::MeshView that is refilled
+// with those leaves' faces whenever the set changes, and that is what gets
+// submitted.  An eye in solid space, or a
+// map compiled without vis, sees every leaf.
+//
+// Typical use (CollidableModel does this for ".bsp" files):
+//   bsp.Load(path, model);
+//   bsp.Draw(model, transform, camera.position, frustum, queue);
+//   ...
+//   UnloadModel(model);
+//   bsp.Unload();
+
+constexpr float BSP_SCALE = 0.05f;   // engine units per Quake unit
+
+class BSPWorld {
+public:
+    struct Stats {
+        int leaf          = -1;   // leaf containing the eye
+        int visibleLeaves = 0;    // in the PVS and the frustum
+        int faces         = 0;    // faces drawn
+        int totalFaces    = 0;    // faces loaded
+        int rebuilds      = 0;    // index buffer refills so far
+    };
+
+    BSPWorld() = default;
+    ~BSPWorld() { Unload(); }
+    BSPWorld(const BSPWorld&) = delete;
+    BSPWorld& operator=(const BSPWorld&) = delete;
+
+    // Parse `path` into `model`; false (and `model` left empty) on failure.
+    // Must be called after InitWindow().
+    bool Load(const std::filesystem::path& path, Model& model);
+    void Unload();
+    bool IsReady() const { return m_ready; }
+
+    // Leaf containing `pos` (model space, engine units); 0 is solid space.
+    int FindLeaf(Vector3 pos) const;
+
+    // Whether leaf `to` is in the PVS of leaf `from`.
+    bool IsVisible(int from, int to) const;
+
+    // Submit `model`'s faces visible from `viewPos` (world space) to
+    // `queue`.  `model` must be the one Load() filled, drawn at `transform`.
+    void Draw(const Model& model, const Matrix& transform, Vector3 viewPos,
+              const GFX::Frustum& frustum, GFX::RenderQueue& queue);
+
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    struct Node {
+        int32_t plane;
+        int32_t children[2];   // >= 0 node, < 0 leaf ~child
+    };
+    struct Leaf {
+        int32_t     visOffset;   // into m_vis, -1 → sees everything
+        uint16_t    firstFace;   // into m_leafFaces
+        uint16_t    faceCount;
+        BoundingBox box;         // model space, engine units
+    };
+    struct FaceRange {
+        int32_t mesh       = -1;   // -1 → not drawn
+        int32_t firstIndex = 0;    // its triangles in the mesh's indices
+        int32_t indexCount = 0;
+    };
+
+    // Decompress leaf `leaf`'s PVS row into `row`
+    void DecompressVis(int leaf, std::vector<uint8_t>& row) const;
+    void Rebuild();
+
+    bool m_ready = false;
+
+    std::vector<Vector4>   m_planes;      // (normal, dist), Quake space
+    std::vector<Node>      m_nodes;
+    std::vector<Leaf>      m_leaves;
+    std::vector<uint16_t>  m_leafFaces;   // face indices, per leaf ranges
+    std::vector<uint8_t>   m_vis;         // run-length compressed PVS rows
+    std::vector<FaceRange> m_faces;
+    std::vector<uint32_t>  m_faceMark;    // last rebuild a face was added in
+    std::vector<GFX::MeshView> m_views;   // one per model mesh
+    std::vector<Texture2D> m_textures;
+    int32_t                m_headNode  = 0;
+    int32_t                m_visLeaves = 0;   // leaves 1..m_visLeaves have PVS bits
+
+    int                  m_viewLeaf = -2;     // whose row m_visRow holds
+    std::vector<uint8_t> m_visRow;
+    std::vector<int>     m_visible, m_lastVisible;
+    uint32_t             m_mark = 0;
+    Stats                m_stats;
+};
+
 } // namespace Hotones
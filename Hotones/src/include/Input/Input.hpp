@@ -16,6 +16,9 @@
 //
 // The underlying InputHandler::Update() is called once per frame from main.cpp
 // before any scene / script update, so all reads within a frame are consistent.
+// Read input through here rather than raylib's own calls: between frames the
+// main loop calls PollInputEvents() again (--input-hz), which clears raylib's
+// pressed flags, wheel and character queue.
 
 #include <Input/InputHandler.hpp>   // Hotones::Input::InputHandler
 
@@ -34,6 +37,7 @@ inline bool IsKeyPressedRepeat(int key)  { return InputHandler::Get().IsKeyPress
 
 inline bool    IsMouseDown(int btn)     { return InputHandler::Get().IsMouseDown(btn); }
 inline bool    IsMousePressed(int btn)  { return InputHandler::Get().IsMousePressed(btn); }
+inline bool    IsMouseReleased(int btn) { return InputHandler::Get().IsMouseReleased(btn); }
 inline Vector2 GetMousePos()            { return InputHandler::Get().GetMousePos(); }
 inline Vector2 GetMouseDelta()          { return InputHandler::Get().GetMouseDelta(); }
 inline float   GetMouseWheel()          { return InputHandler::Get().GetMouseWheel(); }
@@ -1,16 +1,89 @@
 #pragma once
 
 #include <raylib.h>
+#include <bitset>
+#include <cstdint>
 #include <deque>
+#include <vector>
 
 namespace Hotones::Input {
 
+// Everything gameplay reads from the devices in one frame.  InputHandler
+// samples it once per frame; a session recording (Replay/SessionLog.hpp)
+// stores it and hands it back on replay.
+struct FrameInput {
+    static constexpr int KEY_COUNT = 512;   // raylib's MAX_KEYBOARD_KEYS
+
+    std::bitset<KEY_COUNT> keysDown;        // down at the sample, or pressed since the last one
+    std::bitset<KEY_COUNT> keysRepeat;      // OS key repeat this frame
+    uint8_t                mouseDown = 0;   // bit per MOUSE_BUTTON_*
+    Vector2                mousePos{ 0, 0 };
+    Vector2                mouseDelta{ 0, 0 };
+    float                  mouseWheel = 0.0f;
+    std::vector<int>       chars;           // codepoints typed this frame
+};
+
+// One change of device state, as Poll() saw it
+struct InputEvent {
+    enum class Type : uint8_t { KeyDown, KeyUp, MouseDown, MouseUp, MouseMove, Wheel, Char };
+
+    Type    type  = Type::KeyDown;
+    int     code  = 0;         // key, MOUSE_BUTTON_* or codepoint
+    Vector2 value{ 0, 0 };     // MouseMove: delta; Wheel: x = wheel move
+    double  time  = 0.0;       // seconds, steady clock (InputHandler::Clock())
+};
+
+// ---------------------------------------------------------------------------
+// InputHandler — device input, sampled for the frame and for each tick.
+//
+// Poll() reads raylib's device state and queues what changed since the last
+// poll as timestamped InputEvents: key and button edges, mouse motion,
+// wheel and typed characters.  The main loop polls after every
+// PollInputEvents(): the one in EndDrawing() and, while it waits out the
+// frame, one per slice of the wait (--input-hz), so events are stamped to
+// within a slice instead of a frame.  Update() turns the events polled
+// since the last frame into Current(): a key pressed and released between
+// two frames still reads as down (and pressed) for one frame, and motion,
+// wheel and characters are the sums of every poll.
+//
+// With tick sampling on, the fixed-step ticks consume the events at their
+// own time: BeginTick() moves a cursor through the frame's events to the
+// tick's share of the frame, and the IsTick* / GetTickMouseDelta() reads
+// give the state there, so a tap shorter than a tick still reaches one tick
+// and the look direction of each input command is the one it had then.
+// Without it (one poll per frame, a replay or a recording, which store
+// Current() only) the tick reads fall back to Current() and no mouse
+// motion, and the frame applies all of it.
+//
+//   input.Update();                                   // frame start
+//   for (int i = 0; i < ticks; ++i) {
+//       input.BeginTick((float)(i + 1) / ticks);
+//       if (input.IsTickKeyDown(KEY_SPACE)) ...
+//   }
+//
+// Main thread only.
+// ---------------------------------------------------------------------------
 class InputHandler {
 public:
     static InputHandler& Get();
 
-    // Called once per frame to sample/collect input
+    // Seconds on the steady clock events are stamped with
+    static double Clock();
+
+    // Read the devices and queue what changed.  Once after each
+    // PollInputEvents(): raylib's motion and wheel stay until the next one,
+    // and it clears them and the characters there.
+    void Poll();
+    // Called once per frame to sample/collect input: the events polled
+    // since the last Update() become the frame
     void Update();
+    // Update() from a recorded frame instead of the devices
+    void Replay(const FrameInput& frame);
+
+    // This frame's sample, as Update() or Replay() left it
+    const FrameInput& Current() const { return cur_; }
+    // Events from the last frame's polls, oldest first (empty on replay)
+    const std::vector<InputEvent>& Events() const { return frameEvents_; }
 
     bool IsKeyDown(int key) const;
     bool IsKeyPressed(int key) const;
@@ -19,6 +92,7 @@ public:
 
     bool IsMouseDown(int btn) const;
     bool IsMousePressed(int btn) const;
+    bool IsMouseReleased(int btn) const;
 
     Vector2 GetMousePos() const;
     Vector2 GetMouseDelta() const;
@@ -27,13 +101,58 @@ public:
     // Typed character queue (returns 0 when empty)
     int GetCharPressed();
 
+    // ── Fixed-step ticks ──────────────────────────────────────────────────────
+    // Consume events at real time from the next Update() on; off for replays
+    // and recordings
+    void SetTickSampling(bool on) { tickSampling_ = on; }
+    bool TickSampling() const { return tickSampling_; }
+
+    // Start a tick at `frameFraction` (0..1] of the way through the frame's
+    // events: apply those up to there
+    void BeginTick(float frameFraction);
+
+    // Down at the tick, or pressed since the previous tick
+    bool    IsTickKeyDown(int key) const;
+    bool    IsTickMouseDown(int btn) const;
+    // Mouse motion since the previous tick; the frame's GetMouseDelta()
+    // includes it
+    Vector2 GetTickMouseDelta() const;
+
 private:
     InputHandler() = default;
 
+    // Make `frame` current; pressed / released come from the difference
+    // with the one before
+    void Advance(const FrameInput& frame);
+    void Push(InputEvent::Type type, int code, Vector2 value, double time);
+    // Apply frameEvents_[tickNext_ ..) up to `until` to the tick state;
+    // mouse motion only if `motion`
+    void ConsumeTo(double until, bool motion);
+
+    FrameInput      cur_;
+    FrameInput      prev_;
     std::deque<int> chars_;
-    Vector2 mousePos_{0,0};
-    Vector2 mouseDelta_{0,0};
-    float   mouseWheel_{0.0f};
+
+    // Device state as of the last Poll(), and what the polls since the
+    // last Update() added up to
+    std::bitset<FrameInput::KEY_COUNT> polledKeys_;
+    uint8_t                            polledMouse_ = 0;
+    std::bitset<FrameInput::KEY_COUNT> pendingRepeat_;
+    std::vector<InputEvent>            pending_;
+    std::vector<InputEvent>            frameEvents_;
+    double                             frameStart_ = 0.0;   // window of frameEvents_
+    double                             frameEnd_   = 0.0;
+
+    // Tick cursor: state as of the last consumed event
+    bool                               tickSampling_ = false;
+    bool                               tickLive_     = false;   // this frame samples ticks
+    size_t                             tickNext_     = 0;
+    std::bitset<FrameInput::KEY_COUNT> tickKeys_;
+    std::bitset<FrameInput::KEY_COUNT> tickTaps_;
+    uint8_t                            tickMouse_     = 0;
+    uint8_t                            tickMouseTaps_ = 0;
+    Vector2                            tickDelta_{ 0, 0 };
+    bool                               tickStarted_   = false;   // taps and motion read by a tick
 };
 
 } // namespace Hotones::Input
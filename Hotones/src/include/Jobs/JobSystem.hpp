@@ -0,0 +1,298 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <Profile/Profiler.hpp>
+
+namespace Hotones::Jobs {
+
+// ---------------------------------------------------------------------------
+// JobCounter — completion counter for a batch of jobs.
+//
+// Submit() increments it, the job's completion decrements it.  Pass it to
+// JobSystem::Wait() to block (while helping) until every job has finished.
+// ---------------------------------------------------------------------------
+class JobCounter {
+public:
+    [[nodiscard]] bool Done() const noexcept {
+        return m_pending.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> m_pending{0};
+};
+
+class JobSystem;
+
+// ---------------------------------------------------------------------------
+// JobFuture — the result of JobSystem::Async().
+//
+// Get() waits like JobSystem::Wait(), running queued jobs meanwhile, so a
+// job may wait on a future without tying up its thread.  Copies share the
+// one result.  T may be void.
+// ---------------------------------------------------------------------------
+template<typename T>
+class JobFuture {
+public:
+    JobFuture() = default;
+
+    [[nodiscard]] bool Valid() const noexcept { return m_state != nullptr; }
+    // True once the job has run; Get() then returns at once
+    [[nodiscard]] bool Ready() const noexcept { return m_state && m_state->done.Done(); }
+
+    // Wait for the job and return its result.  Requires Valid().
+    std::add_lvalue_reference_t<T> Get();
+
+private:
+    friend class JobSystem;
+    using Value = std::conditional_t<std::is_void_v<T>, char, T>;
+    struct State {
+        JobCounter           done;
+        std::optional<Value> value;
+        JobSystem*           pool = nullptr;
+    };
+    std::shared_ptr<State> m_state;
+};
+
+// ---------------------------------------------------------------------------
+// JobSystem — shared work-stealing thread pool.
+//
+// Each worker owns a deque.  A worker pushes and pops its own jobs at the
+// back (LIFO, cache-warm) and, when empty, steals from the front of another
+// worker's deque (FIFO, oldest and usually largest work first).  Jobs
+// submitted from a non-worker thread are distributed round-robin.
+//
+// Threads that Wait() on a counter run queued jobs instead of sleeping, so a
+// job may itself submit and wait on sub-jobs without deadlocking the pool.
+//
+// Usage
+// -----
+//   auto& jobs = Hotones::Jobs::JobSystem::Get();
+//   jobs.ParallelFor(items.size(), 256, [&](size_t begin, size_t end) {
+//       for (size_t i = begin; i < end; ++i) Process(items[i]);
+//   });
+//
+//   auto mesh = jobs.Async([path] { return LoadMeshData(path); });
+//   ...                                  // other work meanwhile
+//   Use(mesh.Get());
+//
+// Dependent work goes in a TaskGraph (Jobs/TaskGraph.hpp).
+//
+// Jobs must not throw.
+// ---------------------------------------------------------------------------
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    // Process-wide pool with hardware_concurrency() - 1 workers (the calling
+    // thread is expected to help via Wait / ParallelFor).  Started on first use.
+    static JobSystem& Get() {
+        static JobSystem s_instance;
+        return s_instance;
+    }
+
+    // workerCount == 0 picks hardware_concurrency() - 1 (at least 1).
+    explicit JobSystem(unsigned workerCount = 0) {
+        if (workerCount == 0) {
+            const unsigned hw = std::thread::hardware_concurrency();
+            workerCount = hw > 1 ? hw - 1 : 1;
+        }
+        m_queues.reserve(workerCount);
+        for (unsigned i = 0; i < workerCount; ++i)
+            m_queues.push_back(std::make_unique<Queue>());
+        m_workers.reserve(workerCount);
+        for (unsigned i = 0; i < workerCount; ++i)
+            m_workers.emplace_back([this, i] { WorkerLoop(i); });
+    }
+
+    ~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lk(m_sleepMutex);
+            m_stop = true;
+        }
+        m_sleepCv.notify_all();
+        for (auto& t : m_workers)
+            if (t.joinable()) t.join();
+    }
+
+    JobSystem(const JobSystem&)            = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    [[nodiscard]] unsigned WorkerCount() const noexcept {
+        return static_cast<unsigned>(m_workers.size());
+    }
+
+    // Enqueue a job.  If counter is non-null it is incremented now and
+    // decremented when the job completes.
+    void Submit(Job job, JobCounter* counter = nullptr) {
+        if (counter) counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+
+        const int self = WorkerIndex();
+        const size_t q = self >= 0
+            ? static_cast<size_t>(self)
+            : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+        {
+            std::lock_guard<std::mutex> lk(m_queues[q]->mutex);
+            m_queues[q]->tasks.push_back({ std::move(job), counter });
+        }
+        m_queued.fetch_add(1, std::memory_order_release);
+        {
+            // Taking the lock orders this notify after a sleeper's predicate check.
+            std::lock_guard<std::mutex> lk(m_sleepMutex);
+        }
+        m_sleepCv.notify_one();
+    }
+
+    // Block until counter reaches zero, running queued jobs meanwhile.
+    void Wait(JobCounter& counter) {
+        const int self = WorkerIndex();
+        while (!counter.Done()) {
+            if (!RunOne(self)) std::this_thread::yield();
+        }
+    }
+
+    // Run fn() as a job; its result comes from the returned future.  fn is
+    // copied into the job, so it must be copyable.
+    template<typename Fn>
+    auto Async(Fn&& fn) -> JobFuture<std::invoke_result_t<std::decay_t<Fn>&>> {
+        using T = std::invoke_result_t<std::decay_t<Fn>&>;
+        JobFuture<T> future;
+        future.m_state       = std::make_shared<typename JobFuture<T>::State>();
+        future.m_state->pool = this;
+        // The job holds the state, so the counter outlives its decrement
+        // even if every future is gone by then
+        Submit([state = future.m_state, fn = std::forward<Fn>(fn)]() mutable {
+            if constexpr (std::is_void_v<T>) fn();
+            else                             state->value.emplace(fn());
+        }, &future.m_state->done);
+        return future;
+    }
+
+    // Call fn(begin, end) over [0, count) split into chunks of at least
+    // `grain` items, in parallel, and return when all chunks are done.
+    // Runs inline when the range fits in a single chunk.
+    template<typename Fn>
+    void ParallelFor(size_t count, size_t grain, Fn&& fn) {
+        if (count == 0) return;
+        if (grain == 0) grain = 1;
+
+        // No more chunks than threads × 4 keeps dispatch overhead bounded
+        // while still leaving room for stealing to balance uneven chunks.
+        const size_t threads   = static_cast<size_t>(WorkerCount()) + 1;
+        const size_t maxChunks = threads * 4;
+        size_t chunk = grain;
+        if ((count + chunk - 1) / chunk > maxChunks) chunk = (count + maxChunks - 1) / maxChunks;
+
+        if (chunk >= count) { fn(size_t(0), count); return; }
+
+        JobCounter counter;
+        auto*      body = &fn;
+        // The calling thread takes the first chunk itself.
+        for (size_t begin = chunk; begin < count; begin += chunk) {
+            const size_t end = begin + chunk < count ? begin + chunk : count;
+            Submit([body, begin, end] { (*body)(begin, end); }, &counter);
+        }
+        fn(size_t(0), chunk);
+        Wait(counter);
+    }
+
+private:
+    struct Task {
+        Job         fn;
+        JobCounter* counter = nullptr;
+    };
+
+    struct Queue {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    // Index of the current thread in m_workers, or -1 for outside threads.
+    [[nodiscard]] int WorkerIndex() const noexcept {
+        return t_owner == this ? t_index : -1;
+    }
+
+    bool PopLocal(size_t q, Task& out) {
+        std::lock_guard<std::mutex> lk(m_queues[q]->mutex);
+        auto& tasks = m_queues[q]->tasks;
+        if (tasks.empty()) return false;
+        out = std::move(tasks.back());
+        tasks.pop_back();
+        return true;
+    }
+
+    bool Steal(size_t q, Task& out) {
+        std::unique_lock<std::mutex> lk(m_queues[q]->mutex, std::try_to_lock);
+        if (!lk.owns_lock()) return false;
+        auto& tasks = m_queues[q]->tasks;
+        if (tasks.empty()) return false;
+        out = std::move(tasks.front());
+        tasks.pop_front();
+        return true;
+    }
+
+    // Run one job from the own queue, else steal one.  Returns false if
+    // nothing was found.
+    bool RunOne(int self) {
+        if (m_queued.load(std::memory_order_acquire) == 0) return false;
+
+        Task task;
+        bool found = self >= 0 && PopLocal(static_cast<size_t>(self), task);
+        const size_t n = m_queues.size();
+        const size_t start = self >= 0 ? static_cast<size_t>(self) + 1 : 0;
+        for (size_t i = 0; !found && i < n; ++i)
+            found = Steal((start + i) % n, task);
+        if (!found) return false;
+
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+        task.fn();
+        if (task.counter) task.counter->m_pending.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    void WorkerLoop(unsigned index) {
+        t_owner = this;
+        t_index = static_cast<int>(index);
+        HOTONES_THREAD(("Job worker " + std::to_string(index)).c_str());
+        for (;;) {
+            if (RunOne(t_index)) continue;
+            std::unique_lock<std::mutex> lk(m_sleepMutex);
+            m_sleepCv.wait(lk, [this] {
+                return m_stop || m_queued.load(std::memory_order_acquire) > 0;
+            });
+            if (m_stop) return;
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> m_queues;  // one per worker
+    std::vector<std::thread>            m_workers;
+    std::atomic<size_t>                 m_queued{0};    // jobs in all queues
+    std::atomic<size_t>                 m_nextQueue{0}; // round-robin for outside threads
+
+    std::mutex              m_sleepMutex;
+    std::condition_variable m_sleepCv;
+    bool                    m_stop = false;
+
+    static inline thread_local const JobSystem* t_owner = nullptr;
+    static inline thread_local int              t_index = -1;
+};
+
+template<typename T>
+std::add_lvalue_reference_t<T> JobFuture<T>::Get() {
+    m_state->pool->Wait(m_state->done);
+    if constexpr (!std::is_void_v<T>) return *m_state->value;
+}
+
+} // namespace Hotones::Jobs
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Hotones::Jobs {
+
+// ---------------------------------------------------------------------------
+// MainThread — work that has to run on the thread owning the GL context.
+//
+// GPU uploads (AssetCache texture and model loads) only work on the main
+// thread.  While the main thread serves — between Serve(true) and
+// Serve(false); the frame pipeline does this around each simulation step it
+// runs on its own thread — Forwarding() is true on every other thread, and
+// Run() there queues the work and blocks until the main thread's next
+// PumpUntil() has run it.  Outside that window, or on the main thread, Run()
+// calls the work in place, as before.
+//
+// Usage
+//   // Main thread, once:
+//   Jobs::MainThread::Get().Bind();
+//
+//   // Anywhere:
+//   auto& main = Jobs::MainThread::Get();
+//   if (main.Forwarding()) { main.Run([&] { texture = LoadTexture(path); }); return texture; }
+// ---------------------------------------------------------------------------
+class MainThread {
+public:
+    static MainThread& Get() {
+        static MainThread instance;
+        return instance;
+    }
+
+    // Make the calling thread the main one.  Until this is called every
+    // thread counts as main, so code without a main loop (tools, the
+    // server) is unaffected.
+    void Bind() { m_id = std::this_thread::get_id(); }
+
+    [[nodiscard]] bool IsCurrent() const {
+        return m_id == std::thread::id{} || m_id == std::this_thread::get_id();
+    }
+
+    // Main thread: start / stop accepting work from other threads.  Stop
+    // only once nothing can still call Run() (the work it sent was pumped).
+    void Serve(bool on) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_serving = on;
+    }
+
+    // True where Run() would queue rather than call in place
+    [[nodiscard]] bool Forwarding() const {
+        if (IsCurrent()) return false;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_serving;
+    }
+
+    // Run `fn` on the main thread and return once it has
+    void Run(const std::function<void()>& fn) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (IsCurrent() || !m_serving) {
+            lock.unlock();
+            fn();
+            return;
+        }
+        Item item{ &fn };
+        m_queue.push_back(&item);
+        m_wake.notify_all();
+        m_ran.wait(lock, [&] { return item.done; });
+    }
+
+    // Main thread: run queued work until done() holds.  done() is checked
+    // under the queue's lock; whoever makes it true calls Notify() after.
+    template<typename Pred>
+    void PumpUntil(Pred done) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            while (!m_queue.empty()) {
+                Item* item = m_queue.front();
+                m_queue.pop_front();
+                lock.unlock();
+                (*item->fn)();
+                lock.lock();
+                item->done = true;
+                m_ran.notify_all();
+            }
+            if (done()) return;
+            m_wake.wait(lock);
+        }
+    }
+
+    // Wake PumpUntil() to re-check its condition
+    void Notify() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wake.notify_all();
+    }
+
+private:
+    MainThread() = default;
+
+    struct Item {
+        const std::function<void()>* fn;
+        bool                         done = false;
+    };
+
+    std::thread::id         m_id;
+    bool                    m_serving = false;
+    std::deque<Item*>       m_queue;
+    mutable std::mutex      m_mutex;
+    std::condition_variable m_wake;   // work queued, or Notify()
+    std::condition_variable m_ran;    // an item finished
+};
+
+} // namespace Hotones::Jobs
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <Jobs/JobSystem.hpp>
+
+namespace Hotones::Jobs {
+
+// ---------------------------------------------------------------------------
+// TaskGraph — jobs with dependencies, run on a JobSystem.
+//
+// Add() the tasks and Precede() each edge; Run() then submits every task as
+// soon as the tasks before it have finished, and returns once all have.
+// Independent branches run in parallel; nothing waits on a whole stage when
+// only one of its tasks is needed.  A graph can be Run() again, e.g. once
+// per frame, without being rebuilt.
+//
+// AddOnCaller() tasks run on the thread that calls Run(), in the order they
+// were added as they become ready: work tied to that thread, such as
+// anything touching the GL context, still fits in the graph, and the jobs
+// around it overlap with it.
+//
+// Usage
+// -----
+//   Jobs::TaskGraph graph;
+//   auto broad  = graph.Add([&] { BroadPhase(); });
+//   auto narrow = graph.Add([&] { NarrowPhase(); });
+//   auto audio  = graph.Add([&] { MixAudio(); });
+//   graph.Precede(broad, narrow);      // audio runs alongside both
+//   graph.Run();
+//
+// The graph must not have cycles.  Tasks must not throw (see JobSystem).
+// ---------------------------------------------------------------------------
+class TaskGraph {
+public:
+    using TaskId = size_t;
+
+    TaskGraph() = default;
+    TaskGraph(const TaskGraph&)            = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    TaskId Add(JobSystem::Job fn) {
+        m_nodes.push_back(std::make_unique<Node>());
+        m_nodes.back()->fn = std::move(fn);
+        return m_nodes.size() - 1;
+    }
+
+    // A task Run() runs itself, on the calling thread.  Run() sleeps while
+    // it waits for one to become ready, so a graph with caller tasks is run
+    // from outside the pool, not from a job.
+    TaskId AddOnCaller(JobSystem::Job fn) {
+        const TaskId id = Add(std::move(fn));
+        m_nodes[id]->onCaller = true;
+        return id;
+    }
+
+    // `before` finishes before `after` starts
+    void Precede(TaskId before, TaskId after) {
+        assert(before < m_nodes.size() && after < m_nodes.size() && before != after);
+        m_nodes[before]->successors.push_back(after);
+        m_nodes[after]->predecessors++;
+    }
+
+    [[nodiscard]] size_t Size() const noexcept { return m_nodes.size(); }
+    void Clear() { m_nodes.clear(); }
+
+    // Run every task, in dependency order, and return when all are done.
+    // The calling thread runs the AddOnCaller() tasks, then helps with the
+    // rest as in JobSystem::Wait().
+    void Run(JobSystem& jobs = JobSystem::Get()) {
+        if (m_nodes.empty()) return;
+        size_t onCaller = 0;
+        for (auto& node : m_nodes) {
+            node->pending.store(node->predecessors, std::memory_order_relaxed);
+            if (node->onCaller) ++onCaller;
+        }
+
+        JobCounter done;
+        m_ran.store(0, std::memory_order_relaxed);
+        m_callerReady.clear();
+        for (TaskId id = 0; id < m_nodes.size(); ++id)
+            if (m_nodes[id]->predecessors == 0) Launch(jobs, id, done);
+
+        // Caller tasks: the next ready one, or sleep until a job readies one
+        for (size_t left = onCaller; left > 0; --left) {
+            TaskId id;
+            {
+                std::unique_lock<std::mutex> lk(m_callerMutex);
+                m_callerCv.wait(lk, [this] { return !m_callerReady.empty(); });
+                auto first = std::min_element(m_callerReady.begin(), m_callerReady.end());
+                id = *first;
+                m_callerReady.erase(first);
+            }
+            Finish(jobs, id, done);
+        }
+        jobs.Wait(done);
+        assert(m_ran.load(std::memory_order_relaxed) == m_nodes.size() && "TaskGraph has a cycle");
+    }
+
+private:
+    struct Node {
+        JobSystem::Job      fn;
+        std::vector<TaskId> successors;
+        int                 predecessors = 0;
+        bool                onCaller     = false;
+        std::atomic<int>    pending{0};   // predecessors still running, during Run()
+    };
+
+    // A successor is submitted by whichever predecessor finishes last.
+    // That happens inside the predecessor's job, so `done` can't reach zero
+    // before the successor is counted.  A caller task is handed to Run()
+    // instead, which is still looping until every one of them has run.
+    void Launch(JobSystem& jobs, TaskId id, JobCounter& done) {
+        if (m_nodes[id]->onCaller) {
+            {
+                std::lock_guard<std::mutex> lk(m_callerMutex);
+                m_callerReady.push_back(id);
+            }
+            m_callerCv.notify_one();
+            return;
+        }
+        jobs.Submit([this, &jobs, id, &done] { Finish(jobs, id, done); }, &done);
+    }
+
+    void Finish(JobSystem& jobs, TaskId id, JobCounter& done) {
+        Node& node = *m_nodes[id];
+        node.fn();
+        m_ran.fetch_add(1, std::memory_order_relaxed);
+        for (TaskId next : node.successors)
+            if (m_nodes[next]->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                Launch(jobs, next, done);
+    }
+
+    std::vector<std::unique_ptr<Node>> m_nodes;
+    std::atomic<size_t>                m_ran{0};
+    // Caller tasks whose predecessors have all finished, during Run()
+    std::mutex                         m_callerMutex;
+    std::condition_variable            m_callerCv;
+    std::vector<TaskId>                m_callerReady;
+};
+
+} // namespace Hotones::Jobs
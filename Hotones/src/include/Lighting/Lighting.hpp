@@ -51,7 +51,8 @@ inline void Remove(int handle)
 }
 
 /// Direct access to the descriptor for fine-grained changes.
-/// Returns nullptr if the handle is invalid.
+/// Returns nullptr if the handle is invalid.  Marks the light changed, so
+/// fetch it again for each change instead of keeping the pointer.
 inline GFX::LightDesc* Get(int handle)
 {
     return GFX::LightingSystem::Get().GetLight(handle);
@@ -94,6 +95,19 @@ inline void SetEnabled(int handle, bool v)
     if (l) l->enabled = v;
 }
 
+/// Cast shadows from this light (see GFX::ShadowAtlas).
+inline void SetShadows(int handle, bool enabled)
+{
+    auto* l = GFX::LightingSystem::Get().GetLight(handle);
+    if (l) l->castsShadows = enabled;
+}
+
+/// Most static shadow tiles re-rendered per frame.
+inline void SetShadowBudget(int tilesPerFrame)
+{
+    GFX::LightingSystem::Get().GetShadowAtlas().SetBudget(tilesPerFrame);
+}
+
 /// Set spot cone angles in degrees.
 inline void SetSpotAngles(int handle, float innerDeg, float outerDeg)
 {
@@ -0,0 +1,72 @@
+#pragma once
+#include <raylib.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// ─── Log ──────────────────────────────────────────────────────────────────────
+//
+// Logging off the calling thread.  A message is formatted where it is
+// logged, into a slot of a fixed-size lock-free queue, and a sink thread
+// writes it out; the caller never waits on the console.  Install() routes
+// raylib's TraceLog() through the same queue, so the engine's existing
+// messages keep their order relative to the new ones.
+//
+// For messages on hot paths use HOTONES_LOG(level, fmt, ...) instead of
+// TraceLog().  A level below HOTONES_LOG_MIN_LEVEL compiles to nothing;
+// above it, a level below the runtime one (SetLevel()) costs one load, and
+// the arguments are only evaluated for a message that is written:
+//
+//   HOTONES_LOG(LOG_TRACE, "scene=%s", sceneMgr.GetCurrentName().c_str());
+//
+// HOTONES_LOG_MIN_LEVEL defaults to LOG_DEBUG, or LOG_INFO with NDEBUG;
+// build with -DHOTONES_LOG_MIN_LEVEL=LOG_TRACE to keep trace messages.
+//
+// When the queue is full a message is dropped (and counted) rather than
+// blocking the caller.  LOG_FATAL is written at once, after everything
+// queued before it, since raylib exits straight after.
+
+#ifndef HOTONES_LOG_MIN_LEVEL
+#if defined(NDEBUG)
+#define HOTONES_LOG_MIN_LEVEL LOG_INFO
+#else
+#define HOTONES_LOG_MIN_LEVEL LOG_DEBUG
+#endif
+#endif
+
+namespace Hotones::Log {
+
+constexpr size_t MESSAGE_BYTES  = 512;    // longer messages are cut short
+constexpr size_t QUEUE_MESSAGES = 1024;   // waiting for the sink thread
+
+/// Start the sink thread and take over raylib's TraceLog() output.  Call
+/// once, early in main().
+void Install();
+
+/// Lowest level written; also raylib's (SetTraceLogLevel())
+void SetLevel(int level);
+int  GetLevel();
+
+namespace Detail { extern std::atomic<int> g_level; }
+inline bool Enabled(int level) { return level >= Detail::g_level.load(std::memory_order_relaxed); }
+
+/// Queue a message regardless of the runtime level; HOTONES_LOG checks it
+#if defined(__GNUC__)
+__attribute__((format(printf, 2, 3)))
+#endif
+void Write(int level, const char* fmt, ...);
+
+/// Block until every message queued so far has been written
+void Flush();
+/// Messages dropped because the queue was full, ever
+uint64_t Dropped();
+
+} // namespace Hotones::Log
+
+#define HOTONES_LOG(level, ...)                                                 \
+    do {                                                                        \
+        if constexpr ((level) >= HOTONES_LOG_MIN_LEVEL) {                       \
+            if (::Hotones::Log::Enabled(level))                                 \
+                ::Hotones::Log::Write((level), __VA_ARGS__);                    \
+        }                                                                       \
+    } while (0)
@@ -0,0 +1,122 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+// ─── FrameArena ───────────────────────────────────────────────────────────────
+//
+// Memory for per-frame temporaries: lists built, walked and dropped within
+// a frame or tick.  Allocating is a pointer bump, freeing does nothing;
+// the whole frame's memory is reclaimed at once.  Double-buffered: memory
+// handed out during a frame stays valid until the end of the next one, so a
+// frame can still read what the last one left (a snapshot, a queue flushed
+// late) without copying it.
+//
+// One arena per thread, and NextFrame() on that thread marks the frame
+// boundary: the main loop calls it at the top of every frame, a server at
+// the end of every tick.  Until a thread's first NextFrame() its arena is
+// inactive and FrameAllocator falls back to the heap, so code using it is
+// also safe on threads without frames (jobs, loaders): it just allocates as
+// it always did.
+//
+// STL containers take FrameAllocator:
+//   Memory::FrameVector<int> ids;          // this thread's arena
+//   ids.reserve(count);                    // growing leaves the old buffer behind until the reset
+//
+// A container must not outlive the frame after the one it allocated in, nor
+// be used from another thread while it can still grow.
+
+namespace Hotones::Memory {
+
+class FrameArena {
+public:
+    static constexpr size_t BLOCK_BYTES = 256 * 1024;   // first block of each buffer
+
+    struct Stats {
+        size_t   used      = 0;   // bytes handed out this frame
+        size_t   lastFrame = 0;   // ... during the previous frame
+        size_t   peak      = 0;   // most in any frame
+        size_t   reserved  = 0;   // both buffers' blocks
+        uint64_t frames    = 0;   // NextFrame() calls
+    };
+
+    /// The calling thread's arena
+    static FrameArena& Get();
+
+    FrameArena() = default;
+    ~FrameArena();
+    FrameArena(const FrameArena&)            = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /// `bytes` aligned to `align` (a power of two), valid until the end of
+    /// the next frame; nullptr while the arena is inactive
+    void* Allocate(size_t bytes, size_t align = alignof(std::max_align_t));
+    /// Whether `p` came from Allocate() (either buffer)
+    bool  Owns(const void* p) const;
+    bool  Active() const { return m_active; }
+
+    /// End the frame: the buffer of the frame before it is reset and takes
+    /// this frame's allocations.  Activates the arena.
+    void NextFrame();
+
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t                       size = 0;
+        size_t                       used = 0;
+    };
+    // A frame's worth of blocks; allocation bumps through the last one
+    struct Buffer {
+        std::vector<Block> blocks;
+        size_t             used = 0;
+    };
+
+    // Empty `buffer`; a frame that needed several blocks gets one block of
+    // their combined size, so a steady frame settles on a single block
+    void Reset(Buffer& buffer);
+
+    Buffer m_buffers[2];
+    int    m_current = 0;
+    bool   m_active  = false;
+    Stats  m_stats;
+};
+
+/// STL allocator over a FrameArena (the constructing thread's by default).
+/// deallocate() is a no-op for arena memory; while the arena is inactive
+/// it allocates from, and frees to, the heap.
+template<typename T>
+class FrameAllocator {
+public:
+    using value_type = T;
+
+    FrameAllocator() noexcept : m_arena(&FrameArena::Get()) {}
+    explicit FrameAllocator(FrameArena& arena) noexcept : m_arena(&arena) {}
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept : m_arena(other.m_arena) {}
+
+    T* allocate(size_t n) {
+        if (void* p = m_arena->Allocate(n * sizeof(T), alignof(T))) return static_cast<T*>(p);
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    }
+    void deallocate(T* p, size_t) noexcept {
+        if (!m_arena->Owns(p)) ::operator delete(p, std::align_val_t(alignof(T)));
+    }
+
+    template<typename U>
+    bool operator==(const FrameAllocator<U>& other) const noexcept { return m_arena == other.m_arena; }
+    template<typename U>
+    bool operator!=(const FrameAllocator<U>& other) const noexcept { return m_arena != other.m_arena; }
+
+private:
+    template<typename U> friend class FrameAllocator;
+    FrameArena* m_arena;
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+} // namespace Hotones::Memory
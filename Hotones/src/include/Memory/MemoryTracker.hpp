@@ -0,0 +1,174 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// ─── MemoryTracker ────────────────────────────────────────────────────────────
+//
+// How much memory each subsystem holds, how fast it allocates, and the most
+// it ever held.  Subsystems report against a Tag:
+//
+//   Allocated / Freed — each allocation as it happens, from the allocators
+//                       (LuaAllocator, FrameArena blocks) and asset loads
+//   TaggedBytes       — a gauge set to what an owner holds now, for memory
+//                       that lives in containers (ECS pools, BVH tables,
+//                       network buffers); a change counts as one free and
+//                       one allocation
+//
+// Counting is per thread: each thread adds to its own counters with plain
+// relaxed stores, so a Lua state churning tables on one match worker never
+// contends with another.  NextFrame(), once per frame or tick on one thread
+// (the client's main loop, a server's tick), sums the threads and records
+// the frame: live bytes and their high-water mark, allocations and bytes
+// allocated during it, and the worst frame so far.  Peaks are as seen at
+// those samples, so a spike allocated and freed within one frame shows in
+// the frame's allocation count, not in its peak.
+//
+//   Memory::Allocated(Memory::Tag::Lua, size);             // any thread
+//   Memory::TaggedBytes m_bytes{ Memory::Tag::Network };   // as a member
+//   m_bytes.Set(ring.capacity() * sizeof(Packet));
+//   Memory::MemoryTracker::Get().NextFrame();              // once a frame
+//
+// The debug UI shows it in its Memory tab (DrawPanel()); a dedicated server
+// prints it on SIGUSR2.
+
+namespace Hotones::Memory {
+
+enum class Tag : uint8_t {
+    Lua,          // blocks held by Lua states
+    ECS,          // component pools
+    Physics,      // static-mesh BVHs and the table over them
+    Audio,        // decoded waves and their 16-bit copies
+    Meshes,       // model vertex and index data
+    Textures,     // texture pixels, all mips
+    Network,      // NetworkManager rings, queues and per-client state
+    FrameArena,   // FrameArena blocks, every thread's
+    Count
+};
+constexpr size_t TAG_COUNT = (size_t)Tag::Count;
+
+const char* TagName(Tag tag);
+
+namespace detail {
+
+// One thread's counters.  Written by that thread alone, read by NextFrame();
+// the block threads fall back to after they exit is written by several,
+// with atomic adds.
+struct ThreadCounters {
+    std::atomic<int64_t>  live[TAG_COUNT]      = {};   // bytes allocated minus freed (may go negative: freed elsewhere)
+    std::atomic<uint64_t> allocated[TAG_COUNT] = {};   // bytes allocated, ever
+    std::atomic<uint64_t> allocs[TAG_COUNT]    = {};
+    std::atomic<uint64_t> frees[TAG_COUNT]     = {};
+    bool                  shared = false;
+};
+
+inline thread_local ThreadCounters* t_counters = nullptr;
+
+// Give the calling thread its counters (first use on a thread)
+ThreadCounters& AttachThread();
+
+inline ThreadCounters& Local()
+{
+    ThreadCounters* c = t_counters;
+    return c ? *c : AttachThread();
+}
+
+template<typename T>
+inline void Bump(std::atomic<T>& counter, T by, bool shared)
+{
+    if (shared) counter.fetch_add(by, std::memory_order_relaxed);
+    else        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+inline void Allocated(Tag tag, size_t bytes)
+{
+    detail::ThreadCounters& c = detail::Local();
+    const size_t            t = (size_t)tag;
+    detail::Bump<int64_t>(c.live[t], (int64_t)bytes, c.shared);
+    detail::Bump<uint64_t>(c.allocated[t], bytes, c.shared);
+    detail::Bump<uint64_t>(c.allocs[t], 1, c.shared);
+}
+
+inline void Freed(Tag tag, size_t bytes)
+{
+    detail::ThreadCounters& c = detail::Local();
+    const size_t            t = (size_t)tag;
+    detail::Bump<int64_t>(c.live[t], -(int64_t)bytes, c.shared);
+    detail::Bump<uint64_t>(c.frees[t], 1, c.shared);
+}
+
+/// Bytes an owner holds under one tag, set as they change; released by the
+/// destructor.  Set() from one thread at a time.
+class TaggedBytes {
+public:
+    explicit TaggedBytes(Tag tag) noexcept : m_tag(tag) {}
+    ~TaggedBytes() { Set(0); }
+
+    TaggedBytes(const TaggedBytes&)            = delete;
+    TaggedBytes& operator=(const TaggedBytes&) = delete;
+
+    void Set(size_t bytes)
+    {
+        if (bytes == m_bytes) return;
+        if (m_bytes) Freed(m_tag, m_bytes);
+        if (bytes) Allocated(m_tag, bytes);
+        m_bytes = bytes;
+    }
+    size_t Bytes() const { return m_bytes; }
+
+private:
+    Tag    m_tag;
+    size_t m_bytes = 0;
+};
+
+class MemoryTracker {
+public:
+    struct TagStats {
+        int64_t  bytes           = 0;   // live at the last NextFrame()
+        int64_t  peakBytes       = 0;   // most live at any NextFrame()
+        uint64_t allocs          = 0;   // ever
+        uint64_t frees           = 0;
+        uint64_t frameAllocs     = 0;   // during the last frame
+        uint64_t frameBytes      = 0;   // bytes allocated during the last frame
+        uint64_t peakFrameAllocs = 0;   // most in any frame
+        uint64_t peakFrameBytes  = 0;
+    };
+    struct Stats {
+        TagStats tags[TAG_COUNT];
+        TagStats total;                 // every tag; its peaks are of the sum
+        uint64_t frames = 0;            // NextFrame() calls
+    };
+
+    static MemoryTracker& Get();
+
+    MemoryTracker(const MemoryTracker&)            = delete;
+    MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+    /// End the frame: sample every thread's counters.  One thread only.
+    void NextFrame();
+
+    /// As of the last NextFrame(); from the thread calling it
+    const Stats& GetStats() const { return m_stats; }
+
+    /// Forget the high-water marks (they restart from the current frame)
+    void ResetPeaks();
+
+    /// GetStats() as a table, one row per tag
+    void Print(std::FILE* out) const;
+
+private:
+    MemoryTracker() = default;
+
+    Stats    m_stats;
+    uint64_t m_lastAllocs[TAG_COUNT]    = {};
+    uint64_t m_lastAllocated[TAG_COUNT] = {};
+};
+
+/// Contents of a debug window tab: the tracker's table and the total's
+/// history.  Call between ImGui::Begin() / End(), after NextFrame().
+void DrawPanel();
+
+} // namespace Hotones::Memory
@@ -20,7 +20,8 @@ public:
     SceneFactory GetBuiltInFactory(const std::string& name) const;
     std::vector<std::string> GetBuiltInNames() const;
 
-    // Scan ./paks for .cup files or pack folders and register them as file-based packs
+    // Scan ./paks for .cup/.zip files or pack folders (with an init.lua) and
+    // register them as file-based packs
     void ScanPaksDir();
     // Get path for a file-based pack by name (returns empty if none)
     std::string GetFilePakPath(const std::string& name) const;
@@ -0,0 +1,698 @@
+#pragma once
+
+// ── Hotones::Physics — triangle BVH and query kernels ────────────────────────
+//
+// The mid-phase behind PhysicsSystem.cpp: a BVH over world-space triangles
+// plus the sphere-sweep, penetration and ray kernels that run at its leaves.
+// Not part of the gameplay API — include <Physics/PhysicsSystem.hpp> for
+// that.  It lives in a header so tools and benchmarks can build trees and
+// count node visits without a registered mesh.
+
+#include <Physics/PhysicsSystem.hpp>
+#include <Jobs/JobSystem.hpp>
+#include <raylib.h>
+#include <raymath.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Hotones { namespace Physics {
+
+// ─── Geometry helpers ────────────────────────────────────────────────────────
+
+inline float v3dot(Vector3 a, Vector3 b) { return Vector3DotProduct(a, b); }
+inline float v3len(Vector3 a)             { return Vector3Length(a); }
+inline Vector3 v3norm(Vector3 a)           { return Vector3Normalize(a); }
+inline Vector3 v3sub(Vector3 a, Vector3 b) { return Vector3Subtract(a, b); }
+inline Vector3 v3add(Vector3 a, Vector3 b) { return Vector3Add(a, b); }
+inline Vector3 v3scale(Vector3 a, float s) { return Vector3Scale(a, s); }
+inline Vector3 v3cross(Vector3 a, Vector3 b){ return Vector3CrossProduct(a, b); }
+
+// Closest point on triangle (abc) to point p — Ericson §5.1.5
+inline Vector3 ClosestPtTriangle(Vector3 p, Vector3 a, Vector3 b, Vector3 c) {
+    Vector3 ab = v3sub(b,a), ac = v3sub(c,a), ap = v3sub(p,a);
+    float d1 = v3dot(ab,ap), d2 = v3dot(ac,ap);
+    if (d1 <= 0.f && d2 <= 0.f) return a;
+
+    Vector3 bp = v3sub(p,b);
+    float d3 = v3dot(ab,bp), d4 = v3dot(ac,bp);
+    if (d3 >= 0.f && d4 <= d3) return b;
+
+    float vc = d1*d4 - d3*d2;
+    if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f) {
+        float v = d1 / (d1 - d3);
+        return v3add(a, v3scale(ab, v));
+    }
+
+    Vector3 cp = v3sub(p,c);
+    float d5 = v3dot(ab,cp), d6 = v3dot(ac,cp);
+    if (d6 >= 0.f && d5 <= d6) return c;
+
+    float vb = d5*d2 - d1*d6;
+    if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f) {
+        float w = d2 / (d2 - d6);
+        return v3add(a, v3scale(ac, w));
+    }
+
+    float va = d3*d6 - d5*d4;
+    float denom = d4 - d3 + d5 - d6;
+    if (va <= 0.f && denom > 0.f) {
+        float w = (d4 - d3) / denom;
+        return v3add(b, v3scale(v3sub(c,b), w));
+    }
+
+    float dv = 1.f / (va + vb + vc);
+    float vv = vb * dv, wv = vc * dv;
+    return v3add(a, v3add(v3scale(ab,vv), v3scale(ac,wv)));
+}
+
+// Analytic ray-vs-sphere: ray o+t*d, sphere center c radius r.
+// Returns t of first intersection, or FLT_MAX if none in [tMin,tMax].
+inline float RaySphere(Vector3 o, Vector3 d, Vector3 c, float r, float tMin, float tMax) {
+    Vector3 oc = v3sub(o, c);
+    float A = v3dot(d,d);
+    float B = 2.f * v3dot(oc, d);
+    float C = v3dot(oc, oc) - r*r;
+    float disc = B*B - 4.f*A*C;
+    if (disc < 0.f) return FLT_MAX;
+    float sqrtD = sqrtf(disc);
+    float t = (-B - sqrtD) / (2.f*A);
+    if (t >= tMin && t <= tMax) return t;
+    t = (-B + sqrtD) / (2.f*A);
+    if (t >= tMin && t <= tMax) return t;
+    return FLT_MAX;
+}
+
+// Analytic ray-vs-infinite-cylinder (axis a→b, radius r).
+// Returns t of first lateral intersection, or FLT_MAX if none.
+inline float RayCylinder(Vector3 ro, Vector3 rd, Vector3 a, Vector3 b, float r, float tMin, float tMax) {
+    Vector3 ab  = v3sub(b, a);
+    Vector3 ao  = v3sub(ro, a);
+    float abLen2 = v3dot(ab, ab);
+    if (abLen2 < 1e-10f) return FLT_MAX;
+
+    // Project rd and ao onto plane perpendicular to ab
+    float rdDotAb = v3dot(rd, ab) / abLen2;
+    float aoDotAb = v3dot(ao, ab) / abLen2;
+    Vector3 d_perp = v3sub(rd, v3scale(ab, rdDotAb));
+    Vector3 o_perp = v3sub(ao, v3scale(ab, aoDotAb));
+
+    float A = v3dot(d_perp, d_perp);
+    float B = 2.f * v3dot(o_perp, d_perp);
+    float C = v3dot(o_perp, o_perp) - r*r;
+    float disc = B*B - 4.f*A*C;
+    if (disc < 0.f || A < 1e-10f) return FLT_MAX;
+    float sqrtD = sqrtf(disc);
+    float t = (-B - sqrtD) / (2.f*A);
+    if (t < tMin || t > tMax) {
+        t = (-B + sqrtD) / (2.f*A);
+        if (t < tMin || t > tMax) return FLT_MAX;
+    }
+    // Check that the hit lies between a and b along the cylinder axis
+    Vector3 hitPt = v3add(ro, v3scale(rd, t));
+    float proj = v3dot(v3sub(hitPt, a), ab) / abLen2;
+    if (proj < 0.f || proj > 1.f) return FLT_MAX;
+    return t;
+}
+
+// Continuous sphere vs triangle sweep.
+// Returns t ∈ [0, segLen/segLen=1] of first contact, FLT_MAX if no hit.
+// outNormal filled with the contact normal at impact.
+inline float SweepSphereTriangle(Vector3 start, Vector3 end, float radius,
+                                  Vector3 ta, Vector3 tb, Vector3 tc,
+                                  Vector3& outNormal) {
+    Vector3 d    = v3sub(end, start);
+    float segLen = v3len(d);
+    if (segLen < 1e-10f) return FLT_MAX;
+
+    Vector3 triNorm = v3norm(v3cross(v3sub(tb,ta), v3sub(tc,ta)));
+    float bestT = FLT_MAX;
+    Vector3 bestN = triNorm;
+
+    // ── 1. Ray vs face (inflated by radius along normal) ─────────────────────
+    {
+        float nDotD = v3dot(triNorm, d);
+        if (fabsf(nDotD) > 1e-8f) {
+            // Inflate plane by radius toward sphere origin
+            for (int sign = -1; sign <= 1; sign += 2) {
+                Vector3 planePoint = v3add(ta, v3scale(triNorm, sign * radius));
+                float nDotOs = v3dot(triNorm, v3sub(planePoint, start));
+                float t = nDotOs / nDotD;
+                if (t >= 0.f && t < bestT) {
+                    // Check if hit point (back-projected onto triangle plane) is inside triangle
+                    Vector3 hitPt    = v3add(start, v3scale(d, t));
+                    Vector3 onPlane  = v3sub(hitPt, v3scale(triNorm, sign * radius));
+                    Vector3 closest  = ClosestPtTriangle(onPlane, ta, tb, tc);
+                    if (v3len(v3sub(onPlane, closest)) < 1e-4f) {
+                        bestT = t;
+                        bestN = v3scale(triNorm, (float)sign);
+                    }
+                }
+            }
+        }
+    }
+
+    // ── 2. Ray vs edge capsules ───────────────────────────────────────────────
+    Vector3 edges[3][2] = { {ta,tb}, {tb,tc}, {tc,ta} };
+    for (auto& e : edges) {
+        float t = RayCylinder(start, d, e[0], e[1], radius, 0.f, bestT);
+        if (t < bestT) {
+            // Compute normal = (hitPoint - closestPointOnEdge) normalised
+            Vector3 hitPt   = v3add(start, v3scale(d, t));
+            Vector3 ab      = v3sub(e[1], e[0]);
+            float abL2      = v3dot(ab,ab);
+            float proj      = abL2 > 1e-10f ? v3dot(v3sub(hitPt, e[0]), ab) / abL2 : 0.f;
+            proj             = proj < 0.f ? 0.f : (proj > 1.f ? 1.f : proj);
+            Vector3 closest = v3add(e[0], v3scale(ab, proj));
+            Vector3 n       = v3sub(hitPt, closest);
+            float nlen      = v3len(n);
+            if (nlen > 1e-6f) {
+                bestT = t;
+                bestN = v3scale(n, 1.f/nlen);
+            }
+        }
+    }
+
+    // ── 3. Ray vs vertex spheres ──────────────────────────────────────────────
+    Vector3 verts[3] = { ta, tb, tc };
+    for (auto& v : verts) {
+        float t = RaySphere(start, d, v, radius, 0.f, bestT);
+        if (t < bestT) {
+            Vector3 hitPt = v3add(start, v3scale(d, t));
+            Vector3 n     = v3sub(hitPt, v);
+            float nlen    = v3len(n);
+            if (nlen > 1e-6f) {
+                bestT = t;
+                bestN = v3scale(n, 1.f/nlen);
+            }
+        }
+    }
+
+    if (bestT > 1.f + 1e-6f) return FLT_MAX; // no hit within segment
+    outNormal = bestN;
+    return bestT;
+}
+
+// Triangle (abc) vs box center ± half — separating axis test after
+// Akenine-Möller: the 9 box-axis × edge crosses, the 3 box axes, then the
+// triangle normal.  Touching counts as overlap.
+inline bool TriangleAabbOverlap(Vector3 a, Vector3 b, Vector3 c, Vector3 center, Vector3 half) {
+    const Vector3 v[3] = { v3sub(a, center), v3sub(b, center), v3sub(c, center) };
+    const Vector3 e[3] = { v3sub(v[1], v[0]), v3sub(v[2], v[1]), v3sub(v[0], v[2]) };
+    // A degenerate (zero) axis projects everything to 0 and never separates
+    auto separated = [&](Vector3 axis) {
+        const float p0 = v3dot(v[0], axis), p1 = v3dot(v[1], axis), p2 = v3dot(v[2], axis);
+        const float r  = half.x * fabsf(axis.x) + half.y * fabsf(axis.y) + half.z * fabsf(axis.z);
+        return fminf(p0, fminf(p1, p2)) > r || fmaxf(p0, fmaxf(p1, p2)) < -r;
+    };
+    const Vector3 boxAxes[3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+    for (const Vector3& u : boxAxes)
+        for (const Vector3& edge : e)
+            if (separated(v3cross(u, edge))) return false;
+    for (const Vector3& u : boxAxes)
+        if (separated(u)) return false;
+    return !separated(v3cross(e[0], e[1]));
+}
+
+// Squared distance between segments p1q1 and p2q2 — Ericson §5.1.9
+inline float SegmentSegmentDist2(Vector3 p1, Vector3 q1, Vector3 p2, Vector3 q2) {
+    const float EPS = 1e-12f;
+    Vector3 d1 = v3sub(q1, p1), d2 = v3sub(q2, p2), r = v3sub(p1, p2);
+    float a = v3dot(d1, d1), e = v3dot(d2, d2), f = v3dot(d2, r);
+    float s, t;
+    if (a <= EPS && e <= EPS) return v3dot(r, r);
+    if (a <= EPS) {
+        s = 0.f;
+        t = Clamp(f / e, 0.f, 1.f);
+    } else {
+        float c = v3dot(d1, r);
+        if (e <= EPS) {
+            t = 0.f;
+            s = Clamp(-c / a, 0.f, 1.f);
+        } else {
+            float b = v3dot(d1, d2);
+            float denom = a * e - b * b;
+            s = denom != 0.f ? Clamp((b * f - c * e) / denom, 0.f, 1.f) : 0.f;
+            t = (b * s + f) / e;
+            if (t < 0.f)      { t = 0.f; s = Clamp(-c / a, 0.f, 1.f); }
+            else if (t > 1.f) { t = 1.f; s = Clamp((b - c) / a, 0.f, 1.f); }
+        }
+    }
+    Vector3 diff = v3sub(v3add(p1, v3scale(d1, s)), v3add(p2, v3scale(d2, t)));
+    return v3dot(diff, diff);
+}
+
+// Squared distance between segment pq and triangle (abc): zero when the
+// segment crosses the triangle, otherwise the nearest of its endpoints to
+// the triangle and of the segment to each edge.
+inline float SegmentTriangleDist2(Vector3 p, Vector3 q, Vector3 a, Vector3 b, Vector3 c) {
+    Vector3 n = v3cross(v3sub(b, a), v3sub(c, a));
+    float dp = v3dot(v3sub(p, a), n), dq = v3dot(v3sub(q, a), n);
+    if ((dp <= 0.f && dq >= 0.f) || (dp >= 0.f && dq <= 0.f)) {
+        if (dp != dq) {
+            Vector3 x = v3add(p, v3scale(v3sub(q, p), dp / (dp - dq)));
+            if (v3dot(v3cross(v3sub(b, a), v3sub(x, a)), n) >= 0.f &&
+                v3dot(v3cross(v3sub(c, b), v3sub(x, b)), n) >= 0.f &&
+                v3dot(v3cross(v3sub(a, c), v3sub(x, c)), n) >= 0.f) return 0.f;
+        }
+    }
+    Vector3 dpv = v3sub(p, ClosestPtTriangle(p, a, b, c));
+    Vector3 dqv = v3sub(q, ClosestPtTriangle(q, a, b, c));
+    float best = fminf(v3dot(dpv, dpv), v3dot(dqv, dqv));
+    best = fminf(best, SegmentSegmentDist2(p, q, a, b));
+    best = fminf(best, SegmentSegmentDist2(p, q, b, c));
+    best = fminf(best, SegmentSegmentDist2(p, q, c, a));
+    return best;
+}
+
+// ─── BVH ─────────────────────────────────────────────────────────────────────
+
+struct Tri {
+    Vector3  a, b, c;
+    Vector3  centroid;
+    uint32_t source = 0;    // index in the mesh's own triangle order (for refits)
+    uint32_t layers = 1u;   // collision LayerMask (PhysicsSystem.hpp); LAYER_DEFAULT
+};
+
+struct BVHNode {
+    // AABB enclosing all triangles in this subtree
+    Vector3 bmin, bmax;
+    // If leaf: [triStart, triStart+triCount)  in the reordered triangle array
+    // If internal: left child = index+1, right child = rightChild
+    int triStart = 0, triCount = 0;
+    int rightChild = -1; // -1 → leaf
+};
+
+// Per-query counters filled by the traversals below when passed a non-null
+// pointer (benchmarks, debug overlays).  nodesVisited counts node bounds
+// tested, trianglesTested the triangles in every leaf reached.
+struct BVHTraversalStats {
+    uint64_t nodesVisited    = 0;
+    uint64_t trianglesTested = 0;
+};
+
+struct BVH {
+    std::vector<BVHNode> nodes;
+    std::vector<Tri>     tris;   // reordered
+
+    // Binned SAH: bins per axis, relative cost of one node visit vs. one
+    // triangle test, and the size above which a leaf is always split.
+    static constexpr int   SAH_BINS           = 16;
+    static constexpr float SAH_TRAVERSAL_COST = 1.f;
+    static constexpr float SAH_TRIANGLE_COST  = 1.f;
+    static constexpr int   SAH_MAX_LEAF       = 8;
+    // Leaf size of the Fast (centroid-mean) builder.
+    static constexpr int   FAST_MAX_LEAF      = 4;
+    // Depth cap; nodes this deep become leaves whatever their size, which
+    // bounds the traversal stacks below.
+    static constexpr int   MAX_DEPTH          = 64;
+    // With a job pool, a split with at least this many triangles builds
+    // its right subtree as a separate job.  Smaller subtrees run inline.
+    static constexpr int   PARALLEL_MIN_TRIS  = 16384;
+
+    // Build from a flat triangle list.  With `jobs`, large subtrees build
+    // in parallel on that pool; the tree is identical to a serial build.
+    void Build(std::vector<Tri>&& inTris, BVHBuildQuality quality = BVHBuildQuality::SAH,
+               Jobs::JobSystem* jobs = nullptr) {
+        tris = std::move(inTris);
+        nodes.clear();
+        if (tris.empty()) return;
+        nodes.reserve(tris.size() * 2);
+        BuildNode(nodes, 0, (int)tris.size(), quality, 0, jobs);
+    }
+
+    // Expected cost of a random query under the SAH model, normalised to the
+    // root surface area.  Lower is better; used to compare build qualities.
+    [[nodiscard]] float SahCost() const {
+        if (nodes.empty()) return 0.f;
+        const float rootArea = HalfArea(nodes[0].bmin, nodes[0].bmax);
+        if (rootArea <= 0.f) return 0.f;
+        float cost = 0.f;
+        for (const BVHNode& n : nodes) {
+            const float p = HalfArea(n.bmin, n.bmax) / rootArea;
+            cost += n.rightChild == -1 ? p * SAH_TRIANGLE_COST * (float)n.triCount
+                                       : p * SAH_TRAVERSAL_COST;
+        }
+        return cost;
+    }
+
+private:
+    static Vector3 TriAabbMin(const Tri& t) {
+        return { fminf(t.a.x, fminf(t.b.x, t.c.x)),
+                 fminf(t.a.y, fminf(t.b.y, t.c.y)),
+                 fminf(t.a.z, fminf(t.b.z, t.c.z)) };
+    }
+    static Vector3 TriAabbMax(const Tri& t) {
+        return { fmaxf(t.a.x, fmaxf(t.b.x, t.c.x)),
+                 fmaxf(t.a.y, fmaxf(t.b.y, t.c.y)),
+                 fmaxf(t.a.z, fmaxf(t.b.z, t.c.z)) };
+    }
+    static void Grow(Vector3& bmin, Vector3& bmax, Vector3 mn, Vector3 mx) {
+        bmin = { fminf(bmin.x, mn.x), fminf(bmin.y, mn.y), fminf(bmin.z, mn.z) };
+        bmax = { fmaxf(bmax.x, mx.x), fmaxf(bmax.y, mx.y), fmaxf(bmax.z, mx.z) };
+    }
+    // Half the surface area of a box — the SAH only needs ratios.
+    static float HalfArea(Vector3 bmin, Vector3 bmax) {
+        const Vector3 e = v3sub(bmax, bmin);
+        return e.x * e.y + e.y * e.z + e.z * e.x;
+    }
+
+    // Builds [start, end) into `out`; child indices are relative to `out`.
+    // Subtrees only ever partition their own range of `tris`, so two of
+    // them can build at once.
+    int BuildNode(std::vector<BVHNode>& out, int start, int end, BVHBuildQuality quality,
+                  int depth, Jobs::JobSystem* jobs) {
+        const int nodeIdx = (int)out.size();
+        out.push_back({});
+
+        // Compute AABB
+        Vector3 bmin = TriAabbMin(tris[start]);
+        Vector3 bmax = TriAabbMax(tris[start]);
+        for (int i = start+1; i < end; ++i)
+            Grow(bmin, bmax, TriAabbMin(tris[i]), TriAabbMax(tris[i]));
+        out[nodeIdx].bmin = bmin;
+        out[nodeIdx].bmax = bmax;
+
+        const int split = depth >= MAX_DEPTH - 1            ? -1
+                        : quality == BVHBuildQuality::SAH ? SplitSah(start, end, bmin, bmax)
+                                                          : SplitMean(start, end, bmin, bmax);
+        if (split < 0) {
+            // Leaf
+            out[nodeIdx].triStart   = start;
+            out[nodeIdx].triCount   = end - start;
+            out[nodeIdx].rightChild = -1;
+            return nodeIdx;
+        }
+
+        // Children append to `out`, so only touch this node by index afterwards
+        int right;
+        if (jobs && end - start >= PARALLEL_MIN_TRIS) {
+            // Right subtree into its own array on the pool while this thread
+            // builds the left one, then splice it in after the left subtree
+            std::vector<BVHNode> rightNodes;
+            Jobs::JobCounter     done;
+            jobs->Submit([&] {
+                rightNodes.reserve((size_t)(end - split) * 2);
+                BuildNode(rightNodes, split, end, quality, depth + 1, jobs);
+            }, &done);
+            BuildNode(out, start, split, quality, depth + 1, jobs);   // left child (always nodeIdx+1)
+            jobs->Wait(done);
+            right = (int)out.size();
+            for (BVHNode n : rightNodes) {
+                if (n.rightChild != -1) n.rightChild += right;
+                out.push_back(n);
+            }
+        } else {
+            BuildNode(out, start, split, quality, depth + 1, jobs);   // left child (always nodeIdx+1)
+            right = BuildNode(out, split, end, quality, depth + 1, jobs);
+        }
+        out[nodeIdx].triStart   = -1;
+        out[nodeIdx].triCount   = 0;
+        out[nodeIdx].rightChild = right;
+        return nodeIdx;
+    }
+
+    // Split on longest axis at centroid mean.  Returns the partition point,
+    // or -1 to make [start, end) a leaf.
+    int SplitMean(int start, int end, Vector3 bmin, Vector3 bmax) {
+        const int count = end - start;
+        if (count <= FAST_MAX_LEAF) return -1;
+
+        Vector3 ext = v3sub(bmax, bmin);
+        int axis = (ext.x > ext.y && ext.x > ext.z) ? 0 : (ext.y > ext.z ? 1 : 2);
+        float mid = 0.f;
+        for (int i = start; i < end; ++i) {
+            float* c = &tris[i].centroid.x;
+            mid += c[axis];
+        }
+        mid /= (float)count;
+
+        auto midIt = std::partition(tris.begin() + start, tris.begin() + end,
+                                    [axis, mid](const Tri& t){
+                                        const float* c = &t.centroid.x;
+                                        return c[axis] < mid;
+                                    });
+        int split = (int)(midIt - tris.begin());
+        if (split == start || split == end) split = start + count / 2;
+        return split;
+    }
+
+    // Binned SAH split (Wald 2007): bucket centroids into SAH_BINS bins per
+    // axis, sweep the bin boundaries and take the cheapest split over all
+    // three axes.  Returns -1 when no split beats testing every triangle.
+    int SplitSah(int start, int end, Vector3 bmin, Vector3 bmax) {
+        const int count = end - start;
+        if (count <= 1) return -1;
+
+        Vector3 cmin = tris[start].centroid, cmax = cmin;
+        for (int i = start+1; i < end; ++i)
+            Grow(cmin, cmax, tris[i].centroid, tris[i].centroid);
+
+        struct Bin {
+            Vector3 bmin = {  FLT_MAX,  FLT_MAX,  FLT_MAX };
+            Vector3 bmax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            int     count = 0;
+        };
+
+        float bestCost = FLT_MAX;
+        int   bestAxis = -1, bestBin = 0;
+        for (int axis = 0; axis < 3; ++axis) {
+            const float lo = (&cmin.x)[axis], hi = (&cmax.x)[axis];
+            if (hi - lo <= 1e-12f) continue;   // all centroids coincide on this axis
+            const float scale = (float)SAH_BINS / (hi - lo);
+
+            Bin bins[SAH_BINS];
+            for (int i = start; i < end; ++i) {
+                const int b = std::min(SAH_BINS - 1, (int)(((&tris[i].centroid.x)[axis] - lo) * scale));
+                Grow(bins[b].bmin, bins[b].bmax, TriAabbMin(tris[i]), TriAabbMax(tris[i]));
+                ++bins[b].count;
+            }
+
+            // Right-to-left sweep stores the cost of everything right of
+            // each boundary; the left-to-right sweep then completes it.
+            float rightCost[SAH_BINS];
+            Bin   acc;
+            for (int b = SAH_BINS - 1; b > 0; --b) {
+                if (bins[b].count) Grow(acc.bmin, acc.bmax, bins[b].bmin, bins[b].bmax);
+                acc.count += bins[b].count;
+                rightCost[b] = acc.count ? HalfArea(acc.bmin, acc.bmax) * (float)acc.count : 0.f;
+            }
+            acc = Bin{};
+            for (int b = 0; b < SAH_BINS - 1; ++b) {
+                if (bins[b].count) Grow(acc.bmin, acc.bmax, bins[b].bmin, bins[b].bmax);
+                acc.count += bins[b].count;
+                if (acc.count == 0 || acc.count == count) continue;
+                const float cost = HalfArea(acc.bmin, acc.bmax) * (float)acc.count + rightCost[b + 1];
+                if (cost < bestCost) { bestCost = cost; bestAxis = axis; bestBin = b; }
+            }
+        }
+
+        if (bestAxis < 0) {
+            // Every centroid is the same point: nothing to separate spatially
+            return count <= SAH_MAX_LEAF ? -1 : start + count / 2;
+        }
+
+        const float nodeArea  = HalfArea(bmin, bmax);
+        const float splitCost = SAH_TRAVERSAL_COST +
+                                SAH_TRIANGLE_COST * bestCost / fmaxf(nodeArea, 1e-12f);
+        const float leafCost  = SAH_TRIANGLE_COST * (float)count;
+        if (splitCost >= leafCost && count <= SAH_MAX_LEAF) return -1;
+
+        const float lo    = (&cmin.x)[bestAxis];
+        const float scale = (float)SAH_BINS / ((&cmax.x)[bestAxis] - lo);
+        auto midIt = std::partition(tris.begin() + start, tris.begin() + end,
+                                    [&](const Tri& t) {
+                                        const int b = std::min(SAH_BINS - 1,
+                                            (int)(((&t.centroid.x)[bestAxis] - lo) * scale));
+                                        return b <= bestBin;
+                                    });
+        int split = (int)(midIt - tris.begin());
+        if (split == start || split == end) split = start + count / 2;
+        return split;
+    }
+};
+
+// ─── Traversal ───────────────────────────────────────────────────────────────
+//
+// All traversals are iterative over a fixed stack of BVH::MAX_DEPTH entries
+// (the builder caps tree depth to match).  Rays and sweeps test both child
+// boxes, descend into the nearer one first and drop any subtree whose entry
+// distance is already beyond the best hit, so once a close hit is found most
+// of the far side of the tree is never touched.
+
+// Slab test of the ray ro + t·d (invD = 1/d per axis) against [bmin, bmax].
+// Returns the entry t clamped to ≥0, or FLT_MAX if the ray misses the box
+// within [0, tMax].  Axis-parallel rays go through IEEE infinities; fminf /
+// fmaxf drop the NaN that 0·inf gives when the origin lies on a slab plane.
+inline float RayAabbEntry(Vector3 ro, Vector3 invD, Vector3 bmin, Vector3 bmax, float tMax) {
+    float t1 = (bmin.x - ro.x) * invD.x, t2 = (bmax.x - ro.x) * invD.x;
+    float tEnter = fminf(t1, t2), tExit = fmaxf(t1, t2);
+    t1 = (bmin.y - ro.y) * invD.y; t2 = (bmax.y - ro.y) * invD.y;
+    tEnter = fmaxf(tEnter, fminf(t1, t2)); tExit = fminf(tExit, fmaxf(t1, t2));
+    t1 = (bmin.z - ro.z) * invD.z; t2 = (bmax.z - ro.z) * invD.z;
+    tEnter = fmaxf(tEnter, fminf(t1, t2)); tExit = fminf(tExit, fmaxf(t1, t2));
+    tEnter = fmaxf(tEnter, 0.f);
+    tExit  = fminf(tExit, tMax);
+    return tEnter <= tExit ? tEnter : FLT_MAX;
+}
+
+// Front-to-back traversal along ro + t·rd with every box inflated by
+// `inflate`.  leaf(tri) runs for each triangle of each reached leaf and may
+// lower bestT; subtrees entered beyond bestT are skipped.
+template<typename LeafFn>
+inline void TraverseNearFirst(const BVH& bvh, Vector3 ro, Vector3 rd, float inflate,
+                              float& bestT, LeafFn&& leaf, BVHTraversalStats* stats) {
+    if (bvh.nodes.empty()) return;
+    const Vector3 invD = { 1.f / rd.x, 1.f / rd.y, 1.f / rd.z };
+    const Vector3 pad  = { inflate, inflate, inflate };
+    // Bounds of the whole segment [0, bestT]: a cheap overlap reject that
+    // catches most boxes before the slab test, especially for short sweeps
+    const Vector3 re   = v3add(ro, v3scale(rd, bestT));
+    const Vector3 qmin = v3sub({ fminf(ro.x, re.x), fminf(ro.y, re.y), fminf(ro.z, re.z) }, pad);
+    const Vector3 qmax = v3add({ fmaxf(ro.x, re.x), fmaxf(ro.y, re.y), fmaxf(ro.z, re.z) }, pad);
+    auto entry = [&](const BVHNode& n) {
+        if (n.bmin.x > qmax.x || n.bmax.x < qmin.x ||
+            n.bmin.y > qmax.y || n.bmax.y < qmin.y ||
+            n.bmin.z > qmax.z || n.bmax.z < qmin.z) return FLT_MAX;
+        return RayAabbEntry(ro, invD, v3sub(n.bmin, pad), v3add(n.bmax, pad), bestT);
+    };
+
+    struct Pending { int node; float t; };
+    Pending stack[BVH::MAX_DEPTH];
+    int     top = 0;
+
+    if (stats) ++stats->nodesVisited;
+    const float rootT = entry(bvh.nodes[0]);
+    if (rootT == FLT_MAX) return;
+    stack[top++] = { 0, rootT };
+
+    while (top > 0) {
+        const Pending cur = stack[--top];
+        if (cur.t > bestT) continue;   // a closer hit turned up after the push
+        const BVHNode& node = bvh.nodes[cur.node];
+
+        if (node.rightChild == -1) {
+            if (stats) stats->trianglesTested += node.triCount;
+            for (int i = node.triStart; i < node.triStart + node.triCount; ++i)
+                leaf(bvh.tris[i]);
+            continue;
+        }
+
+        int   nearIdx = cur.node + 1,                 farIdx = node.rightChild;
+        float nearT   = entry(bvh.nodes[nearIdx]),    farT   = entry(bvh.nodes[farIdx]);
+        if (stats) stats->nodesVisited += 2;
+        if (farT < nearT) { std::swap(nearIdx, farIdx); std::swap(nearT, farT); }
+        // Far child goes underneath so the near one is popped next
+        if (farT  != FLT_MAX) stack[top++] = { farIdx,  farT  };
+        if (nearT != FLT_MAX) stack[top++] = { nearIdx, nearT };
+    }
+}
+
+// Traverse BVH for sweep; returns earliest t.  The sphere's path is treated
+// as a ray from start to end (t ∈ [0,1]) against boxes grown by radius.
+inline void SweepNodeBVH(const BVH& bvh, Vector3 start, Vector3 end, float radius,
+                          float& bestT, Vector3& bestN,
+                          BVHTraversalStats* stats = nullptr) {
+    float tLimit = fminf(bestT, 1.f);
+    TraverseNearFirst(bvh, start, v3sub(end, start), radius, tLimit,
+                      [&](const Tri& tri) {
+                          Vector3 n;
+                          const float t = SweepSphereTriangle(start, end, radius, tri.a, tri.b, tri.c, n);
+                          if (t <= tLimit && t < bestT) { tLimit = t; bestT = t; bestN = n; }
+                      }, stats);
+}
+
+// Traverse BVH for penetration resolution — collect all triangles whose closest
+// point to `center` is within `radius`.  Every overlapping leaf matters, so
+// there is no ordering, only the box cull.
+inline void PenetrationNodeBVH(const BVH& bvh, Vector3 center, float radius,
+                                Vector3& outPush, bool& didPush,
+                                BVHTraversalStats* stats = nullptr) {
+    if (bvh.nodes.empty()) return;
+    int stack[BVH::MAX_DEPTH];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const BVHNode& node = bvh.nodes[stack[--top]];
+        if (stats) ++stats->nodesVisited;
+
+        // Quick AABB cull (expand by radius)
+        if (center.x + radius < node.bmin.x || center.x - radius > node.bmax.x ||
+            center.y + radius < node.bmin.y || center.y - radius > node.bmax.y ||
+            center.z + radius < node.bmin.z || center.z - radius > node.bmax.z) continue;
+
+        if (node.rightChild != -1) {
+            stack[top++] = node.rightChild;
+            stack[top++] = static_cast<int>(&node - bvh.nodes.data()) + 1;
+            continue;
+        }
+
+        if (stats) stats->trianglesTested += node.triCount;
+        for (int i = node.triStart; i < node.triStart + node.triCount; ++i) {
+            const Tri& tri = bvh.tris[i];
+            Vector3 closest = ClosestPtTriangle(center, tri.a, tri.b, tri.c);
+            Vector3 diff    = v3sub(center, closest);
+            float dist2     = v3dot(diff, diff);
+            if (dist2 < radius * radius) {
+                float dist = sqrtf(dist2);
+                Vector3 n;
+                if (dist > 1e-6f) {
+                    n = v3scale(diff, 1.f / dist);
+                } else {
+                    // Center is on the triangle — push out along face normal
+                    n = v3norm(v3cross(v3sub(tri.b, tri.a), v3sub(tri.c, tri.a)));
+                }
+                float depth = radius - dist;
+                outPush  = v3add(outPush, v3scale(n, depth));
+                didPush  = true;
+            }
+        }
+    }
+}
+
+// ─── Raycasting ───────────────────────────────────────────────────────────────
+
+// Möller-Trumbore ray-vs-triangle. Returns t > 0 on hit, FLT_MAX otherwise.
+// Fills outNormal with the face normal flipped toward the ray origin.
+inline float RayTriangleMT(Vector3 ro, Vector3 rd,
+                             Vector3 ta, Vector3 tb, Vector3 tc,
+                             Vector3& outNormal) {
+    const float EPS = 1e-8f;
+    Vector3 e1  = v3sub(tb, ta);
+    Vector3 e2  = v3sub(tc, ta);
+    Vector3 h   = v3cross(rd, e2);
+    float   a   = v3dot(e1, h);
+    if (fabsf(a) < EPS) return FLT_MAX;   // Ray parallel to triangle
+    float   f   = 1.f / a;
+    Vector3 s   = v3sub(ro, ta);
+    float   u   = f * v3dot(s, h);
+    if (u < 0.f || u > 1.f) return FLT_MAX;
+    Vector3 q   = v3cross(s, e1);
+    float   v   = f * v3dot(rd, q);
+    if (v < 0.f || u + v > 1.f) return FLT_MAX;
+    float   t   = f * v3dot(e2, q);
+    if (t < 1e-6f) return FLT_MAX;        // Behind ray origin
+    Vector3 n = v3norm(v3cross(e1, e2));
+    // Flip so the normal faces the incoming ray
+    if (v3dot(n, rd) > 0.f) n = v3scale(n, -1.f);
+    outNormal = n;
+    return t;
+}
+
+
+// BVH traversal for raycasting — records the nearest hit within bestT.
+inline void RaycastNodeBVH(const BVH& bvh, Vector3 ro, Vector3 rd, float& bestT, Vector3& bestN,
+                             BVHTraversalStats* stats = nullptr) {
+    TraverseNearFirst(bvh, ro, rd, 0.f, bestT,
+                      [&](const Tri& tri) {
+                          Vector3 n;
+                          const float t = RayTriangleMT(ro, rd, tri.a, tri.b, tri.c, n);
+                          if (t < bestT) { bestT = t; bestN = n; }
+                      }, stats);
+}
+
+}} // namespace Hotones::Physics
@@ -0,0 +1,54 @@
+#pragma once
+
+// ── Hotones::Physics — on-disk cache of built static-mesh BVHs ───────────────
+//
+// The build worker keys each mesh by a hash of its world-space triangles
+// (so vertex data, indices, the registration offset and the triangles'
+// layers all count) and the build quality.  A hit maps the cache file and copies the QBVH out of it;
+// a miss builds as usual and writes the result back.  One file per key:
+// <dir>/<key as 16 hex digits>.qbvh.  Files are written to a temporary
+// name and renamed into place, so a crashed or concurrent writer never
+// leaves a half file under a real key.
+
+#include <Physics/PhysicsSystem.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Hotones { namespace Physics {
+
+struct Tri;
+struct QBVH;
+
+// Read-only mapping of a whole file.  Empty files do not map.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    [[nodiscard]] const unsigned char* Data() const { return m_data; }
+    [[nodiscard]] size_t               Size() const { return m_size; }
+
+private:
+    const unsigned char* m_data = nullptr;
+    size_t               m_size = 0;
+#ifdef _WIN32
+    void*                m_file    = nullptr;
+    void*                m_mapping = nullptr;
+#endif
+};
+
+uint64_t BVHCacheKey(const std::vector<Tri>& tris, BVHBuildQuality quality);
+
+// False on a miss, or if the file is truncated, from another format
+// version or fails validation; `out` is left empty then.
+bool LoadBVHCache(const std::string& dir, uint64_t key, QBVH& out);
+bool StoreBVHCache(const std::string& dir, uint64_t key, const QBVH& bvh);
+
+}} // namespace Hotones::Physics
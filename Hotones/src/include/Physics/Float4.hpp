@@ -0,0 +1,128 @@
+#pragma once
+
+// ── Hotones::Physics — four-lane float math for the wide BVH ─────────────────
+//
+// Float4 / Mask4 wrap one 128-bit register: SSE2 on x86 (the x86-64
+// baseline), NEON on AArch64, or four plain floats elsewhere.  Only what
+// QBVH.hpp needs is here — float and uint16 loads, arithmetic, min/max,
+// compares, select and a lane bitmask.  Division is exact (no reciprocal
+// estimates) so the wide kernels return the same t as the scalar ones.
+// Min(a, b) / Max(a, b) return b in any lane where a is NaN, which the slab
+// tests rely on.
+
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define HOTONES_FLOAT4_SSE2 1
+#elif defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+    #include <arm_neon.h>
+    #define HOTONES_FLOAT4_NEON 1
+#endif
+
+namespace Hotones { namespace Physics {
+
+#if defined(HOTONES_FLOAT4_SSE2)
+
+struct Mask4 { __m128 v; };
+struct Float4 {
+    __m128 v;
+    Float4() = default;
+    explicit Float4(__m128 x) : v(x) {}
+    Float4(float s) : v(_mm_set1_ps(s)) {}
+    static Float4 Load(const float* p) { return Float4(_mm_loadu_ps(p)); }
+    // Four unsigned 16-bit integers, converted exactly.
+    static Float4 LoadU16(const uint16_t* p) {
+        const __m128i u = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+        return Float4(_mm_cvtepi32_ps(_mm_unpacklo_epi16(u, _mm_setzero_si128())));
+    }
+    void Store(float* p) const { _mm_storeu_ps(p, v); }
+};
+
+inline Float4 operator+(Float4 a, Float4 b) { return Float4(_mm_add_ps(a.v, b.v)); }
+inline Float4 operator-(Float4 a, Float4 b) { return Float4(_mm_sub_ps(a.v, b.v)); }
+inline Float4 operator*(Float4 a, Float4 b) { return Float4(_mm_mul_ps(a.v, b.v)); }
+inline Float4 operator/(Float4 a, Float4 b) { return Float4(_mm_div_ps(a.v, b.v)); }
+inline Float4 Min(Float4 a, Float4 b) { return Float4(_mm_min_ps(a.v, b.v)); }
+inline Float4 Max(Float4 a, Float4 b) { return Float4(_mm_max_ps(a.v, b.v)); }
+inline Float4 Abs(Float4 a) { return Float4(_mm_andnot_ps(_mm_set1_ps(-0.f), a.v)); }
+inline Mask4 operator< (Float4 a, Float4 b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+inline Mask4 operator<=(Float4 a, Float4 b) { return { _mm_cmple_ps(a.v, b.v) }; }
+inline Mask4 operator> (Float4 a, Float4 b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+inline Mask4 operator>=(Float4 a, Float4 b) { return { _mm_cmpge_ps(a.v, b.v) }; }
+inline Mask4 operator&(Mask4 a, Mask4 b) { return { _mm_and_ps(a.v, b.v) }; }
+inline Mask4 operator|(Mask4 a, Mask4 b) { return { _mm_or_ps(a.v, b.v) }; }
+inline Float4 Select(Mask4 m, Float4 a, Float4 b) {
+    return Float4(_mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v)));
+}
+// Bit i set when lane i is true.
+inline int Bits(Mask4 m) { return _mm_movemask_ps(m.v); }
+
+#elif defined(HOTONES_FLOAT4_NEON)
+
+struct Mask4 { uint32x4_t v; };
+struct Float4 {
+    float32x4_t v;
+    Float4() = default;
+    explicit Float4(float32x4_t x) : v(x) {}
+    Float4(float s) : v(vdupq_n_f32(s)) {}
+    static Float4 Load(const float* p) { return Float4(vld1q_f32(p)); }
+    static Float4 LoadU16(const uint16_t* p) { return Float4(vcvtq_f32_u32(vmovl_u16(vld1_u16(p)))); }
+    void Store(float* p) const { vst1q_f32(p, v); }
+};
+
+inline Float4 operator+(Float4 a, Float4 b) { return Float4(vaddq_f32(a.v, b.v)); }
+inline Float4 operator-(Float4 a, Float4 b) { return Float4(vsubq_f32(a.v, b.v)); }
+inline Float4 operator*(Float4 a, Float4 b) { return Float4(vmulq_f32(a.v, b.v)); }
+inline Float4 operator/(Float4 a, Float4 b) { return Float4(vdivq_f32(a.v, b.v)); }
+inline Float4 Min(Float4 a, Float4 b) { return Float4(vminnmq_f32(a.v, b.v)); }
+inline Float4 Max(Float4 a, Float4 b) { return Float4(vmaxnmq_f32(a.v, b.v)); }
+inline Float4 Abs(Float4 a) { return Float4(vabsq_f32(a.v)); }
+inline Mask4 operator< (Float4 a, Float4 b) { return { vcltq_f32(a.v, b.v) }; }
+inline Mask4 operator<=(Float4 a, Float4 b) { return { vcleq_f32(a.v, b.v) }; }
+inline Mask4 operator> (Float4 a, Float4 b) { return { vcgtq_f32(a.v, b.v) }; }
+inline Mask4 operator>=(Float4 a, Float4 b) { return { vcgeq_f32(a.v, b.v) }; }
+inline Mask4 operator&(Mask4 a, Mask4 b) { return { vandq_u32(a.v, b.v) }; }
+inline Mask4 operator|(Mask4 a, Mask4 b) { return { vorrq_u32(a.v, b.v) }; }
+inline Float4 Select(Mask4 m, Float4 a, Float4 b) { return Float4(vbslq_f32(m.v, a.v, b.v)); }
+inline int Bits(Mask4 m) {
+    const uint32x4_t bit = { 1u, 2u, 4u, 8u };
+    return static_cast<int>(vaddvq_u32(vandq_u32(m.v, bit)));
+}
+
+#else
+
+struct Mask4 { bool v[4]; };
+struct Float4 {
+    float v[4];
+    Float4() = default;
+    Float4(float s) : v{ s, s, s, s } {}
+    static Float4 Load(const float* p) { Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = p[i]; return r; }
+    static Float4 LoadU16(const uint16_t* p) { Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = (float)p[i]; return r; }
+    void Store(float* p) const { for (int i = 0; i < 4; ++i) p[i] = v[i]; }
+};
+
+template<typename Fn>
+inline Float4 Map(Float4 a, Float4 b, Fn fn) { Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = fn(a.v[i], b.v[i]); return r; }
+template<typename Fn>
+inline Mask4 Test(Float4 a, Float4 b, Fn fn) { Mask4 r; for (int i = 0; i < 4; ++i) r.v[i] = fn(a.v[i], b.v[i]); return r; }
+
+inline Float4 operator+(Float4 a, Float4 b) { return Map(a, b, [](float x, float y) { return x + y; }); }
+inline Float4 operator-(Float4 a, Float4 b) { return Map(a, b, [](float x, float y) { return x - y; }); }
+inline Float4 operator*(Float4 a, Float4 b) { return Map(a, b, [](float x, float y) { return x * y; }); }
+inline Float4 operator/(Float4 a, Float4 b) { return Map(a, b, [](float x, float y) { return x / y; }); }
+inline Float4 Min(Float4 a, Float4 b) { return Map(a, b, [](float x, float y) { return x < y ? x : y; }); }
+inline Float4 Max(Float4 a, Float4 b) { return Map(a, b, [](float x, float y) { return x > y ? x : y; }); }
+inline Float4 Abs(Float4 a) { return Map(a, a, [](float x, float) { return x < 0.f ? -x : x; }); }
+inline Mask4 operator< (Float4 a, Float4 b) { return Test(a, b, [](float x, float y) { return x <  y; }); }
+inline Mask4 operator<=(Float4 a, Float4 b) { return Test(a, b, [](float x, float y) { return x <= y; }); }
+inline Mask4 operator> (Float4 a, Float4 b) { return Test(a, b, [](float x, float y) { return x >  y; }); }
+inline Mask4 operator>=(Float4 a, Float4 b) { return Test(a, b, [](float x, float y) { return x >= y; }); }
+inline Mask4 operator&(Mask4 a, Mask4 b) { Mask4 r; for (int i = 0; i < 4; ++i) r.v[i] = a.v[i] && b.v[i]; return r; }
+inline Mask4 operator|(Mask4 a, Mask4 b) { Mask4 r; for (int i = 0; i < 4; ++i) r.v[i] = a.v[i] || b.v[i]; return r; }
+inline Float4 Select(Mask4 m, Float4 a, Float4 b) { Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = m.v[i] ? a.v[i] : b.v[i]; return r; }
+inline int Bits(Mask4 m) { int b = 0; for (int i = 0; i < 4; ++i) b |= m.v[i] ? 1 << i : 0; return b; }
+
+#endif
+
+}} // namespace Hotones::Physics
@@ -0,0 +1,83 @@
+#pragma once
+
+// ── Hotones::Physics — navigation mesh and pathfinding ───────────────────────
+//
+// BuildNavMesh() turns the static collision geometry into a navigation
+// mesh: the triangles (GatherStaticTriangles) flat enough to walk on and
+// with room above them for an agent, welded into polygons that know their
+// neighbours across shared edges.  Paths are A* over those polygons,
+// straightened by the funnel algorithm, so an agent gets a handful of
+// corners instead of steering with raycasts every frame.
+//
+// The mesh follows the geometry as registered: walkable surfaces are the
+// triangles themselves, so areas connect only where their triangles share
+// edges (within weldDistance), and paths run along walls rather than an
+// agent's radius away from them.
+//
+// Built meshes are cached next to the BVHs (SetBVHCacheDirectory), keyed by
+// a hash of the input triangles and the settings: <dir>/<key>.nav.
+//
+// The current mesh is an immutable snapshot, like the collision tables:
+// queries take no lock and run on any thread, and a rebuild replaces the
+// mesh for queries that start after it.
+//
+//   Physics::WaitForMeshes(levelHandles);
+//   Physics::BuildNavMesh();
+//   auto paths = Physics::FindPathsAsync(std::move(requests));   // job system
+//   ...
+//   for (const Physics::PathResult& p : paths.Get()) Follow(p.points);
+
+#include <Jobs/JobSystem.hpp>
+#include <Physics/PhysicsSystem.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Hotones { namespace Physics {
+
+struct NavMeshSettings {
+    float     maxSlopeDegrees = 45.f;            // steeper triangles are not walkable
+    float     agentHeight     = 1.8f;            // headroom needed over a triangle's centre; 0 skips the check
+    float     weldDistance    = 0.01f;           // vertices closer than this are one
+    LayerMask mask            = LAYER_DEFAULT;   // collision layers walked on, and checked for headroom
+};
+
+struct NavMeshStats {
+    size_t polygons  = 0;
+    size_t vertices  = 0;
+    size_t bytes     = 0;
+    bool   fromCache = false;
+    double buildMs   = 0.0;   // gather, build or load, and publish
+};
+
+// Build the navigation mesh from the static meshes built so far, replacing
+// the current one.  Call once the level's meshes are ready (WaitForMeshes);
+// meshes still building are left out.  Returns the polygon count; 0 leaves
+// no mesh, and every path query fails.
+size_t BuildNavMesh(const NavMeshSettings& settings = {});
+void   ClearNavMesh();
+[[nodiscard]] bool HasNavMesh();
+NavMeshStats GetNavMeshStats();
+
+struct PathRequest {
+    Vector3 start = { 0, 0, 0 };
+    Vector3 end   = { 0, 0, 0 };
+};
+
+struct PathResult {
+    bool                 found   = false;   // points is a path
+    bool                 partial = false;   // end unreachable: the path goes as near as it can
+    std::vector<Vector3> points;            // start, corners, end (or the nearest reachable point)
+};
+
+// One path on the calling thread.  start and end are snapped to the mesh:
+// the walkable polygon under them within a step (0.5) above or 2 below,
+// else the nearest one within 2 units; otherwise found is false.
+PathResult FindPath(const Vector3& start, const Vector3& end);
+
+// A batch of paths on Jobs::JobSystem, split across its workers; the
+// future's results[i] answers requests[i].  The batch keeps the mesh it
+// started with, so a rebuild meanwhile does not disturb it.
+Jobs::JobFuture<std::vector<PathResult>> FindPathsAsync(std::vector<PathRequest> requests);
+
+}} // namespace Hotones::Physics
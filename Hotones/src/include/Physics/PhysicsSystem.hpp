@@ -1,26 +1,219 @@
 #pragma once
 #include <raylib.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
 
 namespace Hotones { namespace Physics {
 
 // Initialize the physics subsystem. Returns true on success.
-bool InitPhysics();
+// Static-mesh BVHs build on a pool of `buildThreads` threads; 0 picks
+// hardware_concurrency() - 1 (at least 1).  Shutdown drops builds still
+// queued and waits for the running ones.
+bool InitPhysics(unsigned buildThreads = 0);
 void ShutdownPhysics();
 
+// ── Collision layers ─────────────────────────────────────────────────────────
+//
+// Every triangle carries a LayerMask; the bits mean whatever the game makes
+// them mean (say 1 = world, 2 = player clip, 4 = bullet clip, 8 = AI nav).
+// Every query takes a mask too and only sees triangles whose layers share
+// a bit with it, so hitscan rays can pass through player clip and the
+// player controller can ignore decals.  The trees keep the union of the
+// layers under each node and skip subtrees the mask misses; meshes whose
+// triangles all share one mask store nothing extra.
+using LayerMask = uint32_t;
+constexpr LayerMask LAYER_DEFAULT = 1u;
+constexpr LayerMask LAYER_ALL     = 0xFFFFFFFFu;
+
 // Register a static (non-moving) collision mesh built from a raylib `Model`.
 // Returns a positive handle id on success, or -1 if registration failed / not available.
-int RegisterStaticMeshFromModel(const Model& model, const Vector3& position);
+// Handles index a generation-checked slot table, so lookups are O(1) and a
+// handle passed after UnregisterStaticMesh is rejected even if its slot has
+// been reused.
+//
+// The query functions below take no lock and may be called from any number
+// of threads at once, also while meshes are being registered, built or
+// unregistered.
+//
+// onBuilt, if given, runs on a build thread once the mesh's BVH is queryable
+// (installed = true), or once its build is dropped because the handle was
+// unregistered or physics shut down first (installed = false).  It is not
+// called when registration itself fails.
+//
+// Every triangle of the model gets `layers`.
+using StaticMeshBuiltCallback = std::function<void(int handle, bool installed)>;
+int RegisterStaticMeshFromModel(const Model& model, const Vector3& position,
+                                StaticMeshBuiltCallback onBuilt = nullptr,
+                                LayerMask layers = LAYER_DEFAULT);
+// Same, with layers per sub-mesh: model.meshes[i] gets meshLayers[i]
+// (LAYER_DEFAULT past the end of the span), e.g. a level whose clip
+// brushes are their own meshes.
+int RegisterStaticMeshWithLayers(const Model& model, const Vector3& position,
+                                 std::span<const LayerMask> meshLayers,
+                                 StaticMeshBuiltCallback onBuilt = nullptr);
 void UnregisterStaticMesh(int handle);
 
+// ── Kinematic meshes ─────────────────────────────────────────────────────────
+//
+// Doors, lifts and moving platforms.  The BVH is built once in the model's
+// own space and queries are moved into that space, so moving the mesh
+// never touches its tree.  Handles work with every query and with
+// UnregisterStaticMesh; they are never cached on disk and always use the
+// full memory layout.
+
+// Like RegisterStaticMeshFromModel, with the model's vertices placed by
+// `transform`.  The transform may rotate, translate and scale uniformly;
+// shear and non-uniform scale are not supported.
+int RegisterKinematicMesh(const Model& model, const Matrix& transform,
+                          StaticMeshBuiltCallback onBuilt = nullptr,
+                          LayerMask layers = LAYER_DEFAULT);
+
+// Move a kinematic mesh.  Takes effect for queries that start after the
+// call.  Costs a copy of the mesh table, so it suits tens of movers per
+// frame, not thousands.  False if handle is not a live kinematic mesh.
+bool SetMeshTransform(int handle, const Matrix& transform);
+
+// For deforming meshes: re-read the model's vertices (same meshes and
+// triangle count as at registration) and refit the tree bottom-up in O(n)
+// instead of rebuilding it.  Queries already running keep the old shape.
+// False if the mesh is not built yet, not kinematic, or its triangle count
+// changed.  Refitting keeps the tree's topology, so queries slow down as
+// the shape drifts far from the one it was built for; re-register then.
+bool RefitKinematicMesh(int handle, const Model& model);
+
+// ── Instances ────────────────────────────────────────────────────────────────
+//
+// Props repeated across a map: crates, barrels, pillars.  A shape is one
+// model's collision tree, built once in the model's own space; an instance
+// places it with a transform and is a mesh handle like any other (every
+// query, the world queries' top-level tree, IsMeshReady, WaitForMeshes,
+// SetMeshTransform, UnregisterStaticMesh).  A map with 300 crates builds
+// and stores one tree, and adding a crate copies no triangles.  Transforms
+// are as for kinematic meshes: rotation, translation, uniform scale.
+// Shapes use the memory layout and disk cache like static meshes; their
+// instances cannot be refit, as the tree is shared.
+
+// Queue the shape's build.  Returns a positive shape id, or -1 if the
+// model has no triangles.  onBuilt runs once, with the shape id, when the
+// tree is ready; instances created before then become ready with it.
+int RegisterMeshShape(const Model& model, LayerMask layers = LAYER_DEFAULT,
+                      StaticMeshBuiltCallback onBuilt = nullptr);
+// No more instances of `shape`.  Existing ones keep the tree until they
+// are unregistered.
+void UnregisterMeshShape(int shape);
+
+// A mesh handle for `shape` placed by `transform`, or -1 if the shape is
+// unknown or the mesh table is full.
+int CreateMeshInstance(int shape, const Matrix& transform);
+// Many at once, in one update of the mesh table (each CreateMeshInstance
+// call copies the table): handles[i] is placed by transforms[i].  Returns
+// how many were created, at most min(transforms, handles).
+size_t CreateMeshInstances(int shape, std::span<const Matrix> transforms, std::span<int> handles);
+
+// ── Mesh readiness ───────────────────────────────────────────────────────────
+//
+// Until its BVH lands, a freshly registered handle answers every query with
+// "no hit".  Scene start-up can overlap the builds with other loading work
+// and call WaitForMeshes before the first physics tick.
+
+// True once handle's BVH is queryable; false while it is still building
+// and for unknown or unregistered handles.
+bool IsMeshReady(int handle);
+
+// Block until every handle is ready or can no longer become ready
+// (invalid, unregistered, or physics shut down).  timeoutSeconds < 0 waits
+// without limit.  Returns true if all handles are ready.
+bool WaitForMeshes(std::span<const int> handles, float timeoutSeconds = -1.f);
+
+// Called on a build thread each time any mesh becomes ready, after that
+// mesh's own onBuilt.  One hook at a time; pass nullptr to clear it.
+using StaticMeshReadyHook = std::function<void(int handle)>;
+void SetMeshReadyHook(StaticMeshReadyHook hook);
+
+// How the background worker builds static-mesh BVHs.
+//   SAH  — binned surface-area heuristic (default).  Slower to build, but
+//          queries visit far fewer nodes on architectural scenes.
+//   Fast — split the longest axis at the centroid mean, leaves of ≤4
+//          triangles.  Useful for meshes rebuilt often or as a baseline.
+// Applies to meshes built after the call; already built BVHs are kept.
+enum class BVHBuildQuality { Fast, SAH };
+void            SetBVHBuildQuality(BVHBuildQuality quality);
+BVHBuildQuality GetBVHBuildQuality();
+
+// How built BVHs are stored.
+//   Full    — float child bounds and triangle packets with their own vertex
+//             copies (default).  Fastest to query.
+//   Compact — child bounds as 16-bit steps within the parent's box, packets
+//             indexing one welded vertex buffer; half the memory or less
+//             when triangles share vertices.
+//             Boxes are rounded outwards, so queries return the same hits
+//             at the cost of a few extra node and triangle tests.
+// Applies to meshes built after the call.  See GetPhysicsMemoryStats().
+enum class BVHMemoryLayout { Full, Compact };
+void            SetBVHMemoryLayout(BVHMemoryLayout layout);
+BVHMemoryLayout GetBVHMemoryLayout();
+
+// Memory held by the built static meshes in the current table.  bvhBytes
+// covers nodes, triangle packets and vertex buffers; tableBytes the slot
+// table and the top-level tree over the meshes.  A tree shared by several
+// meshes (instances) counts once in triangles and bvhBytes.
+struct PhysicsMemoryStats {
+    size_t meshes        = 0;   // built meshes
+    size_t compactMeshes = 0;   // of those, stored as BVHMemoryLayout::Compact
+    size_t triangles     = 0;
+    size_t bvhBytes      = 0;
+    size_t tableBytes    = 0;
+    [[nodiscard]] size_t TotalBytes() const { return bvhBytes + tableBytes; }
+};
+PhysicsMemoryStats GetPhysicsMemoryStats();
+
+// On-disk BVH cache.  With a directory set, the worker looks each mesh up
+// by a hash of its world-space triangles before building, and writes new
+// builds back, so reloading an unchanged level maps its trees from disk
+// instead of rebuilding them.  Empty (the default) disables the cache.
+// Applies to meshes registered after the call.
+void        SetBVHCacheDirectory(const std::string& dir);
+std::string GetBVHCacheDirectory();
+
+// Builds queued since the build queue was last empty, and how many of them
+// have finished (including dropped ones).  For loading screens.
+struct BVHBuildProgress {
+    size_t queued    = 0;
+    size_t completed = 0;
+    [[nodiscard]] bool  Idle() const { return completed == queued; }
+    [[nodiscard]] float Fraction() const { return queued ? (float)completed / (float)queued : 1.f; }
+};
+BVHBuildProgress GetBVHBuildProgress();
+
+// Queries run since startup, each of a batch counted, for metrics: sample
+// it and take differences.  A slide whose gathered triangles overflow also
+// counts the sweeps and resolves it falls back to.
+struct PhysicsQueryStats {
+    uint64_t raycasts = 0;   // RaycastAgainstStatic, RaycastWorld, RaycastBatch
+    uint64_t sweeps   = 0;   // SweepSphereAgainstStatic, SweepSphereWorld, SweepBatch
+    uint64_t resolves = 0;   // ResolveSphereAgainstStatic, ResolveSphereWorld
+    uint64_t overlaps = 0;   // OverlapSphere, OverlapAABB, OverlapCapsule
+    uint64_t slides   = 0;   // SlideSphereAgainstStatic, SlideSphereWorld
+};
+PhysicsQueryStats GetPhysicsQueryStats();
+
+// Every query below sees only the triangles whose layers meet `mask`.
+
 // Continuous sphere sweep against a registered static mesh.
 // start/end are sphere center positions. Returns true if hit; t ∈ [0,1].
 bool SweepSphereAgainstStatic(int handle, const Vector3& start, const Vector3& end,
                                float radius,
-                               Vector3& hitPos, Vector3& hitNormal, float& t);
+                               Vector3& hitPos, Vector3& hitNormal, float& t,
+                               LayerMask mask = LAYER_ALL);
 
 // Discrete sphere penetration resolve: pushes `center` out of all overlapping
 // triangles in one pass. Returns true if any triangle was overlapping.
-bool ResolveSphereAgainstStatic(int handle, Vector3& center, float radius);
+bool ResolveSphereAgainstStatic(int handle, Vector3& center, float radius,
+                                LayerMask mask = LAYER_ALL);
 
 // Ray cast against a registered static mesh (Möller-Trumbore per-triangle).
 // origin + dir * t gives the hit point; dir does NOT need to be normalised
@@ -29,6 +222,131 @@ bool ResolveSphereAgainstStatic(int handle, Vector3& center, float radius);
 // Returns true if hit; t ∈ [0, maxDist].
 bool RaycastAgainstStatic(int handle, const Vector3& origin, const Vector3& dir,
                            float maxDist,
-                           Vector3& hitPos, Vector3& hitNormal, float& t);
+                           Vector3& hitPos, Vector3& hitNormal, float& t,
+                           LayerMask mask = LAYER_ALL);
+
+// ── World queries ────────────────────────────────────────────────────────────
+//
+// The same queries against every registered static mesh at once, through a
+// top-level BVH over the meshes' bounds: cost grows with log(mesh count)
+// rather than linearly, and callers need not track handles.  Meshes still
+// building are skipped, and so are meshes with no layer in `mask`.
+// hitHandle, when given, receives the mesh that was hit.
+bool RaycastWorld(const Vector3& origin, const Vector3& dir, float maxDist,
+                  Vector3& hitPos, Vector3& hitNormal, float& t, int* hitHandle = nullptr,
+                  LayerMask mask = LAYER_ALL);
+bool SweepSphereWorld(const Vector3& start, const Vector3& end, float radius,
+                      Vector3& hitPos, Vector3& hitNormal, float& t, int* hitHandle = nullptr,
+                      LayerMask mask = LAYER_ALL);
+// Pushes `center` out of every overlapping mesh in one pass; the pushes
+// from all meshes are summed as they are within one mesh.
+bool ResolveSphereWorld(Vector3& center, float radius, LayerMask mask = LAYER_ALL);
+
+// ── Overlap queries ──────────────────────────────────────────────────────────
+//
+// Which triangles a shape touches, across every built mesh, for callers
+// that want the contacts themselves rather than a push: triggers, AI
+// awareness, decal placement.  One walk of the trees fills `out` with
+// (mesh, triangle) pairs; nothing is allocated, so the same buffer can be
+// reused every tick and the result shared between systems.
+//
+// Returns how many triangles overlap.  Only the first out.size() are
+// written; a larger return value means the buffer was too small.
+// Touching counts as overlap.
+
+struct OverlapHit {
+    int      handle = 0;   // mesh the triangle belongs to
+    uint32_t tri    = 0;   // triangle id within that mesh; see GetMeshTriangle
+};
+
+size_t OverlapSphere(const Vector3& center, float radius, std::span<OverlapHit> out,
+                     LayerMask mask = LAYER_ALL);
+size_t OverlapAABB(const Vector3& bmin, const Vector3& bmax, std::span<OverlapHit> out,
+                   LayerMask mask = LAYER_ALL);
+// Capsule: the segment a→b swept by `radius`.
+size_t OverlapCapsule(const Vector3& a, const Vector3& b, float radius, std::span<OverlapHit> out,
+                      LayerMask mask = LAYER_ALL);
+
+// World-space vertices of a triangle an overlap query reported.  Ids stay
+// valid until the mesh is unregistered; kinematic meshes report their
+// current pose.  False for an unknown handle or id.
+bool GetMeshTriangle(int handle, uint32_t tri, Vector3& a, Vector3& b, Vector3& c);
+
+// Append the world-space triangles (three vertices each) of every built
+// static mesh and instance whose layers meet `mask` to `out`; kinematic
+// meshes move and are left out.  For data derived from the level, like
+// the navigation mesh (Physics/NavMesh.hpp).  Returns the triangles added.
+size_t GatherStaticTriangles(std::vector<Vector3>& out, LayerMask mask = LAYER_ALL);
+
+// ── Collide and slide ────────────────────────────────────────────────────────
+//
+// Move a sphere by `motion`, sliding along whatever it hits: each contact
+// stops it `skin` short of the surface and the rest of the motion is
+// projected onto the contact plane, up to maxIters contacts, followed by
+// one penetration resolve.  The triangles the sphere could reach are
+// gathered once up front (the sliding path never leaves a sphere of
+// |motion| around start), and every sweep and the resolve run against that
+// local set instead of walking the tree again.
+
+struct SlideParams {
+    int       maxIters   = 4;          // contacts before the rest of the motion is dropped
+    float     skin       = 1e-3f;      // gap kept from each surface hit
+    float     groundMinY = 0.5f;       // contact normals with y above this count as ground
+    bool      resolve    = true;       // push out of residual overlap at the end
+    LayerMask mask       = LAYER_ALL;
+};
+
+struct SlideResult {
+    Vector3 position     = { 0, 0, 0 };
+    Vector3 groundNormal = { 0, 1, 0 };   // of the last ground contact
+    int     contacts     = 0;
+    bool    grounded     = false;         // some contact was ground
+    bool    pushed       = false;         // the final resolve moved the sphere
+};
+
+// *velocity, when given, loses its part going into each surface hit.
+SlideResult SlideSphereAgainstStatic(int handle, const Vector3& start, const Vector3& motion, float radius,
+                                     const SlideParams& params = {}, Vector3* velocity = nullptr);
+SlideResult SlideSphereWorld(const Vector3& start, const Vector3& motion, float radius,
+                             const SlideParams& params = {}, Vector3* velocity = nullptr);
+
+// ── Batched queries ──────────────────────────────────────────────────────────
+//
+// For callers that fire many queries at one mesh per tick (hitscan, AI line
+// of sight, audio occlusion).  The handle is resolved and its BVH pinned once
+// per batch, and queries are traced in a spatially sorted order (direction
+// octant, then origin Morton code) so consecutive ones reuse the same nodes.
+// With `parallel` the batch is split across Jobs::JobSystem; that pays off
+// from a few hundred queries.
+//
+// hits[i] answers queries[i]; only the first min(queries, hits) entries are
+// processed.  Returns the number of hits.  A mesh that is unknown or still
+// building reports no hits.
+
+struct RayQuery {
+    Vector3   origin  = { 0, 0, 0 };
+    Vector3   dir     = { 0, 0, 1 };   // need not be normalised; t is in its units
+    float     maxDist = 1000.f;
+    LayerMask mask    = LAYER_ALL;
+};
+
+struct SweepQuery {
+    Vector3   start  = { 0, 0, 0 };
+    Vector3   end    = { 0, 0, 0 };
+    float     radius = 0.5f;
+    LayerMask mask   = LAYER_ALL;
+};
+
+struct QueryHit {
+    bool    hit    = false;
+    Vector3 pos    = { 0, 0, 0 };
+    Vector3 normal = { 0, 1, 0 };
+    float   t      = 0.f;            // ray: distance in dir units; sweep: fraction of the segment
+};
+
+size_t RaycastBatch(int handle, std::span<const RayQuery> rays, std::span<QueryHit> hits,
+                    bool parallel = false);
+size_t SweepBatch(int handle, std::span<const SweepQuery> sweeps, std::span<QueryHit> hits,
+                  bool parallel = false);
 
 }} // namespace Hotones::Physics
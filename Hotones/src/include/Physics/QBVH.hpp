@@ -0,0 +1,838 @@
+#pragma once
+
+// ── Hotones::Physics — 4-wide BVH with SoA triangle packets ──────────────────
+//
+// A QBVH is a binary BVH collapsed so every node holds four children, their
+// bounds stored as SoA float lanes: one Float4 slab test covers all four.
+// Leaves are runs of TriPackets, four triangles per packet in SoA order.
+// The three queries then work per packet:
+//   rays         — Möller-Trumbore on four triangles at once;
+//   sweeps       — a four-wide plane/AABB reject, then the exact scalar
+//                  SweepSphereTriangle on the lanes that survive;
+//   penetration  — the same reject around the sphere, then the scalar
+//                  ClosestPtTriangle push on survivors.
+// The exact sphere tests branch per feature (face, edges, vertices), so
+// they stay scalar; the wide reject skips most of them.
+//
+// CompactQBVH is the same tree in about half the memory: child bounds are
+// 16-bit steps within their node's box and packets index a shared vertex
+// buffer.  The traversals below are templates over both layouts, which
+// expose the same small accessor set (NodeBounds4, Child, PacketCount,
+// Packet) and the same LayerTable.
+//
+// PhysicsSystem.cpp collapses every static-mesh BVH into one of these and
+// queries only the wide tree.
+
+#include <Physics/BVH.hpp>
+#include <Physics/Float4.hpp>
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace Hotones { namespace Physics {
+
+// A node's four child boxes, one Float4 per bound.
+struct LaneBounds4 {
+    Float4 mnx, mny, mnz;
+    Float4 mxx, mxy, mxz;
+};
+
+struct alignas(16) QBVHNode {
+    float bminX[4], bminY[4], bminZ[4];
+    float bmaxX[4], bmaxY[4], bmaxZ[4];
+    // child[i] is a node index, or the first packet of a leaf
+    // (packetCount[i] > 0).  Empty lanes have child -1 and inverted bounds.
+    int   child[4];
+    int   packetCount[4];
+};
+
+// Four triangles in SoA order.  Lanes past `count` repeat lane 0 so the
+// arithmetic stays finite; the kernels mask them off.
+struct alignas(16) TriPacket {
+    float ax[4], ay[4], az[4];
+    float bx[4], by[4], bz[4];
+    float cx[4], cy[4], cz[4];
+    int   count = 0;
+
+    [[nodiscard]] Vector3 A(int i) const { return { ax[i], ay[i], az[i] }; }
+    [[nodiscard]] Vector3 B(int i) const { return { bx[i], by[i], bz[i] }; }
+    [[nodiscard]] Vector3 C(int i) const { return { cx[i], cy[i], cz[i] }; }
+};
+
+// Collision layers of a wide tree.  `all` is the union over every
+// triangle.  Meshes with mixed layers also keep the union under each node
+// lane and each triangle's own mask, so traversals can drop lanes the
+// query mask misses; for a uniform mesh both tables are empty and `all`
+// alone decides.
+struct LayerTable {
+    uint32_t              all = 1u;
+    std::vector<uint32_t> nodeLanes;     // 4 per node
+    std::vector<uint32_t> packetLanes;   // 4 per packet; lanes past count repeat lane 0
+
+    [[nodiscard]] bool Mixed() const { return !nodeLanes.empty(); }
+
+    // Bit i set when lane i of node / packet has a layer in mask.
+    [[nodiscard]] int NodeLanes(int node, uint32_t mask) const {
+        return Mixed() ? LaneBits(&nodeLanes[(size_t)node * 4], mask) : 0xF;
+    }
+    [[nodiscard]] int PacketLanes(int packet, uint32_t mask) const {
+        return Mixed() ? LaneBits(&packetLanes[(size_t)packet * 4], mask) : 0xF;
+    }
+
+    [[nodiscard]] size_t MemoryBytes() const {
+        return (nodeLanes.capacity() + packetLanes.capacity()) * sizeof(uint32_t);
+    }
+
+    void Clear() { all = 1u; nodeLanes.clear(); packetLanes.clear(); }
+
+private:
+    static int LaneBits(const uint32_t* lanes, uint32_t mask) {
+        return ((lanes[0] & mask) ? 1 : 0) | ((lanes[1] & mask) ? 2 : 0) |
+               ((lanes[2] & mask) ? 4 : 0) | ((lanes[3] & mask) ? 8 : 0);
+    }
+};
+
+struct QBVH {
+    std::vector<QBVHNode>  nodes;     // nodes[0] is the root
+    std::vector<TriPacket> packets;
+    // Tri::source of each packet lane, 4 per packet; only kept when built
+    // with keepSources, for Refit().
+    std::vector<uint32_t>  laneSource;
+    LayerTable             layers;
+
+    // Collapse a built binary BVH.  Each wide node absorbs the children of
+    // its largest-area inner children until it has four.
+    void Build(const BVH& bvh, bool keepSources = false) {
+        nodes.clear();
+        packets.clear();
+        laneSource.clear();
+        layers.Clear();
+        m_keepSources = keepSources;
+        if (bvh.nodes.empty()) return;
+        nodes.reserve(bvh.nodes.size() / 2 + 1);
+        packets.reserve(bvh.tris.size() / 2 + 1);
+        if (bvh.nodes[0].rightChild == -1) {
+            // Whole mesh is one leaf: a root with a single leaf lane
+            const int root = NewNode();
+            SetLane(root, 0, bvh, 0);
+        } else {
+            BuildNode(bvh, 0);
+        }
+        BuildLayerTable(bvh.tris);
+    }
+
+    // Bounds of the whole tree (union of the root's lanes); false if empty.
+    bool Bounds(Vector3& bmin, Vector3& bmax) const {
+        if (nodes.empty()) return false;
+        const QBVHNode& r = nodes[0];
+        bmin = {  FLT_MAX,  FLT_MAX,  FLT_MAX };
+        bmax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (int i = 0; i < 4; ++i) {
+            if (r.child[i] < 0) continue;
+            bmin = { fminf(bmin.x, r.bminX[i]), fminf(bmin.y, r.bminY[i]), fminf(bmin.z, r.bminZ[i]) };
+            bmax = { fmaxf(bmax.x, r.bmaxX[i]), fmaxf(bmax.y, r.bmaxY[i]), fmaxf(bmax.z, r.bmaxZ[i]) };
+        }
+        return true;
+    }
+
+    [[nodiscard]] size_t TriangleCount() const {
+        size_t n = 0;
+        for (const TriPacket& p : packets) n += (size_t)p.count;
+        return n;
+    }
+
+    [[nodiscard]] size_t MemoryBytes() const {
+        return nodes.capacity() * sizeof(QBVHNode) + packets.capacity() * sizeof(TriPacket) +
+               laneSource.capacity() * sizeof(uint32_t) + layers.MemoryBytes();
+    }
+
+    // Move the triangles to new positions without changing the tree: copy
+    // each lane's vertices from tris[source], then recompute every box
+    // bottom-up, O(n).  tris is in the same order the tree was built from.
+    // The tree stays valid for any deformation but its quality degrades as
+    // triangles drift from where they were built; rebuild after large
+    // changes.  Layers stay as built.  False (tree untouched) without
+    // sources or on a size mismatch.
+    bool Refit(const std::vector<Tri>& tris) {
+        if (laneSource.size() != packets.size() * 4) return false;
+        for (uint32_t source : laneSource)
+            if (source >= tris.size()) return false;
+
+        for (size_t pi = 0; pi < packets.size(); ++pi) {
+            TriPacket& p = packets[pi];
+            for (int k = 0; k < 4; ++k) {
+                const Tri& t = tris[laneSource[pi * 4 + k]];
+                p.ax[k] = t.a.x; p.ay[k] = t.a.y; p.az[k] = t.a.z;
+                p.bx[k] = t.b.x; p.by[k] = t.b.y; p.bz[k] = t.b.z;
+                p.cx[k] = t.c.x; p.cy[k] = t.c.y; p.cz[k] = t.c.z;
+            }
+        }
+
+        // Children always follow their parent, so a reverse walk sees every
+        // child box before the node that encloses it.
+        for (size_t ni = nodes.size(); ni-- > 0;) {
+            QBVHNode& n = nodes[ni];
+            for (int lane = 0; lane < 4; ++lane) {
+                if (n.child[lane] < 0) continue;
+                Vector3 bmin = {  FLT_MAX,  FLT_MAX,  FLT_MAX };
+                Vector3 bmax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+                auto grow = [&](Vector3 v) {
+                    bmin = { fminf(bmin.x, v.x), fminf(bmin.y, v.y), fminf(bmin.z, v.z) };
+                    bmax = { fmaxf(bmax.x, v.x), fmaxf(bmax.y, v.y), fmaxf(bmax.z, v.z) };
+                };
+                if (n.packetCount[lane] > 0) {
+                    for (int pi = n.child[lane]; pi < n.child[lane] + n.packetCount[lane]; ++pi) {
+                        const TriPacket& p = packets[pi];
+                        for (int k = 0; k < p.count; ++k) { grow(p.A(k)); grow(p.B(k)); grow(p.C(k)); }
+                    }
+                } else {
+                    const QBVHNode& c = nodes[n.child[lane]];
+                    for (int i = 0; i < 4; ++i) {
+                        if (c.child[i] < 0) continue;
+                        grow({ c.bminX[i], c.bminY[i], c.bminZ[i] });
+                        grow({ c.bmaxX[i], c.bmaxY[i], c.bmaxZ[i] });
+                    }
+                }
+                n.bminX[lane] = bmin.x; n.bminY[lane] = bmin.y; n.bminZ[lane] = bmin.z;
+                n.bmaxX[lane] = bmax.x; n.bmaxY[lane] = bmax.y; n.bmaxZ[lane] = bmax.z;
+            }
+        }
+        return true;
+    }
+
+    // Traversal accessors
+    [[nodiscard]] bool Empty() const { return nodes.empty(); }
+    [[nodiscard]] LaneBounds4 NodeBounds4(int node) const {
+        const QBVHNode& n = nodes[node];
+        return { Float4::Load(n.bminX), Float4::Load(n.bminY), Float4::Load(n.bminZ),
+                 Float4::Load(n.bmaxX), Float4::Load(n.bmaxY), Float4::Load(n.bmaxZ) };
+    }
+    [[nodiscard]] int Child(int node, int lane) const { return nodes[node].child[lane]; }
+    [[nodiscard]] int PacketCount(int node, int lane) const { return nodes[node].packetCount[lane]; }
+    [[nodiscard]] const TriPacket& Packet(int i, TriPacket&) const { return packets[i]; }
+
+private:
+    bool                  m_keepSources = false;   // set for the duration of Build()
+    std::vector<uint32_t> m_laneTris;              // bvh.tris index of each packet lane, during Build()
+
+    int NewNode() {
+        QBVHNode n;
+        for (int i = 0; i < 4; ++i) {
+            n.bminX[i] = n.bminY[i] = n.bminZ[i] =  FLT_MAX;
+            n.bmaxX[i] = n.bmaxY[i] = n.bmaxZ[i] = -FLT_MAX;
+            n.child[i] = -1;
+            n.packetCount[i] = 0;
+        }
+        nodes.push_back(n);
+        return (int)nodes.size() - 1;
+    }
+
+    static float HalfArea(const BVHNode& n) {
+        const Vector3 e = v3sub(n.bmax, n.bmin);
+        return e.x * e.y + e.y * e.z + e.z * e.x;
+    }
+
+    // Point lane `lane` of wide node `nodeIdx` at binary node `src`,
+    // building its subtree (or its packets) first.
+    void SetLane(int nodeIdx, int lane, const BVH& bvh, int src) {
+        const BVHNode& b = bvh.nodes[src];
+        int child, count = 0;
+        if (b.rightChild == -1) {
+            child = (int)packets.size();
+            for (int i = 0; i < b.triCount; i += 4) {
+                TriPacket p;
+                p.count = std::min(4, b.triCount - i);
+                for (int k = 0; k < 4; ++k) {
+                    const Tri& t = bvh.tris[b.triStart + i + (k < p.count ? k : 0)];
+                    p.ax[k] = t.a.x; p.ay[k] = t.a.y; p.az[k] = t.a.z;
+                    p.bx[k] = t.b.x; p.by[k] = t.b.y; p.bz[k] = t.b.z;
+                    p.cx[k] = t.c.x; p.cy[k] = t.c.y; p.cz[k] = t.c.z;
+                    if (m_keepSources) laneSource.push_back(t.source);
+                    m_laneTris.push_back((uint32_t)(b.triStart + i + (k < p.count ? k : 0)));
+                }
+                packets.push_back(p);
+            }
+            count = (int)packets.size() - child;
+        } else {
+            child = BuildNode(bvh, src);
+        }
+        // BuildNode may have grown `nodes`: index, don't hold references
+        QBVHNode& n = nodes[nodeIdx];
+        n.bminX[lane] = b.bmin.x; n.bminY[lane] = b.bmin.y; n.bminZ[lane] = b.bmin.z;
+        n.bmaxX[lane] = b.bmax.x; n.bmaxY[lane] = b.bmax.y; n.bmaxZ[lane] = b.bmax.z;
+        n.child[lane]       = child;
+        n.packetCount[lane] = count;
+    }
+
+    // Wide node for binary inner node `src`; returns its index.
+    int BuildNode(const BVH& bvh, int src) {
+        int kids[4] = { src + 1, bvh.nodes[src].rightChild, -1, -1 };
+        int count   = 2;
+        while (count < 4) {
+            int   open = -1;
+            float best = -1.f;
+            for (int i = 0; i < count; ++i) {
+                const BVHNode& k = bvh.nodes[kids[i]];
+                if (k.rightChild != -1 && HalfArea(k) > best) { best = HalfArea(k); open = i; }
+            }
+            if (open < 0) break;
+            const int inner = kids[open];
+            kids[open]    = inner + 1;
+            kids[count++] = bvh.nodes[inner].rightChild;
+        }
+
+        const int nodeIdx = NewNode();
+        for (int i = 0; i < count; ++i) SetLane(nodeIdx, i, bvh, kids[i]);
+        return nodeIdx;
+    }
+
+    // Fill `layers` from the triangles the packet lanes were copied from.
+    void BuildLayerTable(const std::vector<Tri>& tris) {
+        std::vector<uint32_t> laneTris = std::move(m_laneTris);
+        m_laneTris = {};
+        if (laneTris.empty()) return;
+
+        layers.all = 0;
+        bool mixed = false;
+        for (uint32_t ti : laneTris) {
+            mixed |= tris[ti].layers != tris[laneTris[0]].layers;
+            layers.all |= tris[ti].layers;
+        }
+        if (!mixed) return;
+
+        layers.packetLanes.resize(laneTris.size());
+        for (size_t i = 0; i < laneTris.size(); ++i) layers.packetLanes[i] = tris[laneTris[i]].layers;
+
+        // Children follow their parent: walk backwards so every child's
+        // unions are ready before the node that holds it
+        layers.nodeLanes.assign(nodes.size() * 4, 0u);
+        for (size_t ni = nodes.size(); ni-- > 0;) {
+            const QBVHNode& n = nodes[ni];
+            for (int lane = 0; lane < 4; ++lane) {
+                uint32_t& u = layers.nodeLanes[ni * 4 + lane];
+                if (n.child[lane] < 0) continue;
+                if (n.packetCount[lane] > 0) {
+                    for (int pi = n.child[lane]; pi < n.child[lane] + n.packetCount[lane]; ++pi)
+                        for (int k = 0; k < packets[pi].count; ++k) u |= layers.packetLanes[(size_t)pi * 4 + k];
+                } else {
+                    for (int i = 0; i < 4; ++i) u |= layers.nodeLanes[(size_t)n.child[lane] * 4 + i];
+                }
+            }
+        }
+    }
+};
+
+// ─── Compact layout ──────────────────────────────────────────────────────────
+//
+// Each node stores its own box as origin + 65534 steps per axis and its
+// four child boxes as uint16 step counts, rounded outwards, so a decoded
+// box always contains the exact one: queries test a few extra triangles
+// but return the same hits.  Packets index a welded vertex buffer instead
+// of carrying 36 floats.
+
+struct CompactQBVHNode {
+    float    origin[3];
+    float    step[3];
+    uint16_t qminX[4], qminY[4], qminZ[4];
+    uint16_t qmaxX[4], qmaxY[4], qmaxZ[4];
+    int32_t  child[4];         // as QBVHNode::child
+    uint16_t packetCount[4];
+};
+
+struct CompactPacket {
+    uint32_t a[4], b[4], c[4];   // into CompactQBVH::vertices; lanes past count repeat lane 0
+    int32_t  count = 0;
+};
+
+struct CompactQBVH {
+    std::vector<CompactQBVHNode> nodes;     // nodes[0] is the root
+    std::vector<CompactPacket>   packets;
+    std::vector<Vector3>         vertices;
+    LayerTable                   layers;        // as the source QBVH's
+
+    static constexpr int QUANT_MAX = 65535;
+
+    // Re-encode a built QBVH; node and packet indices carry over.  Returns
+    // false (leaving the tree empty) if a box cannot be encoded
+    // conservatively or a leaf has more packets than a uint16 counts.
+    bool Build(const QBVH& wide) {
+        nodes.assign(wide.nodes.size(), CompactQBVHNode{});
+        packets.assign(wide.packets.size(), CompactPacket{});
+        vertices.clear();
+        layers = wide.layers;
+        for (size_t i = 0; i < wide.nodes.size(); ++i) {
+            if (!EncodeNode(wide.nodes[i], nodes[i])) { Clear(); return false; }
+        }
+
+        struct Key {
+            uint32_t x, y, z;
+            bool operator==(const Key&) const = default;
+        };
+        struct KeyHash {
+            size_t operator()(const Key& k) const {
+                return (size_t)(k.x * 73856093u ^ k.y * 19349663u ^ k.z * 83492791u);
+            }
+        };
+        std::unordered_map<Key, uint32_t, KeyHash> index;
+        index.reserve(wide.packets.size() * 4);
+        auto weld = [&](const Vector3& v) {
+            Key k;
+            std::memcpy(&k.x, &v.x, 4); std::memcpy(&k.y, &v.y, 4); std::memcpy(&k.z, &v.z, 4);
+            auto [it, added] = index.try_emplace(k, (uint32_t)vertices.size());
+            if (added) vertices.push_back(v);
+            return it->second;
+        };
+        for (size_t i = 0; i < wide.packets.size(); ++i) {
+            const TriPacket& src = wide.packets[i];
+            CompactPacket&   dst = packets[i];
+            dst.count = src.count;
+            for (int k = 0; k < 4; ++k) {
+                dst.a[k] = weld(src.A(k));
+                dst.b[k] = weld(src.B(k));
+                dst.c[k] = weld(src.C(k));
+            }
+        }
+        vertices.shrink_to_fit();
+        return true;
+    }
+
+    // Bounds of the whole tree (decoded root lanes); false if empty.
+    bool Bounds(Vector3& bmin, Vector3& bmax) const {
+        if (nodes.empty()) return false;
+        const CompactQBVHNode& r = nodes[0];
+        bmin = {  FLT_MAX,  FLT_MAX,  FLT_MAX };
+        bmax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (int i = 0; i < 4; ++i) {
+            if (r.child[i] < 0) continue;
+            bmin = { fminf(bmin.x, Decode(r, 0, r.qminX[i])), fminf(bmin.y, Decode(r, 1, r.qminY[i])),
+                     fminf(bmin.z, Decode(r, 2, r.qminZ[i])) };
+            bmax = { fmaxf(bmax.x, Decode(r, 0, r.qmaxX[i])), fmaxf(bmax.y, Decode(r, 1, r.qmaxY[i])),
+                     fmaxf(bmax.z, Decode(r, 2, r.qmaxZ[i])) };
+        }
+        return true;
+    }
+
+    [[nodiscard]] size_t TriangleCount() const {
+        size_t n = 0;
+        for (const CompactPacket& p : packets) n += (size_t)p.count;
+        return n;
+    }
+
+    [[nodiscard]] size_t MemoryBytes() const {
+        return nodes.capacity() * sizeof(CompactQBVHNode) + packets.capacity() * sizeof(CompactPacket) +
+               vertices.capacity() * sizeof(Vector3) + layers.MemoryBytes();
+    }
+
+    // Traversal accessors
+    [[nodiscard]] bool Empty() const { return nodes.empty(); }
+    [[nodiscard]] LaneBounds4 NodeBounds4(int node) const {
+        const CompactQBVHNode& n = nodes[node];
+        const Float4 ox(n.origin[0]), oy(n.origin[1]), oz(n.origin[2]);
+        const Float4 sx(n.step[0]),   sy(n.step[1]),   sz(n.step[2]);
+        return { ox + Float4::LoadU16(n.qminX) * sx, oy + Float4::LoadU16(n.qminY) * sy,
+                 oz + Float4::LoadU16(n.qminZ) * sz, ox + Float4::LoadU16(n.qmaxX) * sx,
+                 oy + Float4::LoadU16(n.qmaxY) * sy, oz + Float4::LoadU16(n.qmaxZ) * sz };
+    }
+    [[nodiscard]] int Child(int node, int lane) const { return nodes[node].child[lane]; }
+    [[nodiscard]] int PacketCount(int node, int lane) const { return nodes[node].packetCount[lane]; }
+    // Gathers packet i's vertices into `scratch`.
+    [[nodiscard]] const TriPacket& Packet(int i, TriPacket& scratch) const {
+        const CompactPacket& p = packets[i];
+        for (int k = 0; k < 4; ++k) {
+            const Vector3 a = vertices[p.a[k]], b = vertices[p.b[k]], c = vertices[p.c[k]];
+            scratch.ax[k] = a.x; scratch.ay[k] = a.y; scratch.az[k] = a.z;
+            scratch.bx[k] = b.x; scratch.by[k] = b.y; scratch.bz[k] = b.z;
+            scratch.cx[k] = c.x; scratch.cy[k] = c.y; scratch.cz[k] = c.z;
+        }
+        scratch.count = p.count;
+        return scratch;
+    }
+
+private:
+    void Clear() { nodes.clear(); packets.clear(); vertices.clear(); layers.Clear(); }
+
+    // Same arithmetic as NodeBounds4, one lane at a time.
+    static float Decode(const CompactQBVHNode& n, int axis, uint16_t q) {
+        return n.origin[axis] + (float)q * n.step[axis];
+    }
+
+    // Round outwards, then one step further so a decode that differs in
+    // the last bit (e.g. a fused multiply-add) still contains the box.
+    static uint16_t QuantizeMin(const CompactQBVHNode& n, int axis, float v) {
+        const float s = n.step[axis];
+        if (s <= 0.f) return 0;
+        int q = (int)std::clamp(std::floor((v - n.origin[axis]) / s), 0.f, (float)QUANT_MAX);
+        while (q > 0 && Decode(n, axis, (uint16_t)q) > v) --q;
+        return (uint16_t)std::max(q - 1, 0);
+    }
+    static uint16_t QuantizeMax(const CompactQBVHNode& n, int axis, float v) {
+        const float s = n.step[axis];
+        if (s <= 0.f) return 0;
+        int q = (int)std::clamp(std::ceil((v - n.origin[axis]) / s), 0.f, (float)QUANT_MAX);
+        while (q < QUANT_MAX && Decode(n, axis, (uint16_t)q) < v) ++q;
+        return (uint16_t)std::min(q + 1, QUANT_MAX);
+    }
+
+    static bool EncodeNode(const QBVHNode& src, CompactQBVHNode& dst) {
+        const float* srcMin[3] = { src.bminX, src.bminY, src.bminZ };
+        const float* srcMax[3] = { src.bmaxX, src.bmaxY, src.bmaxZ };
+        uint16_t*    dstMin[3] = { dst.qminX, dst.qminY, dst.qminZ };
+        uint16_t*    dstMax[3] = { dst.qmaxX, dst.qmaxY, dst.qmaxZ };
+
+        for (int axis = 0; axis < 3; ++axis) {
+            float lo = FLT_MAX, hi = -FLT_MAX;
+            for (int i = 0; i < 4; ++i) {
+                if (src.child[i] < 0) continue;
+                lo = fminf(lo, srcMin[axis][i]);
+                hi = fmaxf(hi, srcMax[axis][i]);
+            }
+            if (lo > hi) lo = hi = 0.f;   // no children
+            dst.origin[axis] = lo;
+            dst.step[axis]   = (hi - lo) / (float)(QUANT_MAX - 1);
+        }
+        for (int i = 0; i < 4; ++i) {
+            dst.child[i] = src.child[i];
+            if (src.packetCount[i] > 0xFFFF) return false;
+            dst.packetCount[i] = (uint16_t)src.packetCount[i];
+            for (int axis = 0; axis < 3; ++axis) {
+                if (src.child[i] < 0) { dstMin[axis][i] = dstMax[axis][i] = 0; continue; }
+                const float lo = srcMin[axis][i], hi = srcMax[axis][i];
+                dstMin[axis][i] = QuantizeMin(dst, axis, lo);
+                dstMax[axis][i] = QuantizeMax(dst, axis, hi);
+                if (Decode(dst, axis, dstMin[axis][i]) > lo || Decode(dst, axis, dstMax[axis][i]) < hi)
+                    return false;
+            }
+        }
+        return true;
+    }
+};
+
+// The two wide layouts the traversals below accept.
+template<typename T>
+concept WideBVH = requires(const T& t, TriPacket& scratch) {
+    { t.NodeBounds4(0) } -> std::same_as<LaneBounds4>;
+    { t.Packet(0, scratch) } -> std::same_as<const TriPacket&>;
+    { t.layers } -> std::convertible_to<const LayerTable&>;
+};
+
+// ─── Wide kernels ────────────────────────────────────────────────────────────
+
+// Prefilters use a slightly larger radius so rounding differences against
+// the scalar tests never reject a triangle the scalar test would accept.
+constexpr float QBVH_PREFILTER_SLACK = 1.001f;
+
+// Bit i set for the lanes of p that hold a triangle.
+inline int PacketLanes(const TriPacket& p) { return (1 << p.count) - 1; }
+
+struct Packet4 {
+    Float4 ax, ay, az, bx, by, bz, cx, cy, cz;
+    explicit Packet4(const TriPacket& p)
+        : ax(Float4::Load(p.ax)), ay(Float4::Load(p.ay)), az(Float4::Load(p.az)),
+          bx(Float4::Load(p.bx)), by(Float4::Load(p.by)), bz(Float4::Load(p.bz)),
+          cx(Float4::Load(p.cx)), cy(Float4::Load(p.cy)), cz(Float4::Load(p.cz)) {}
+};
+
+// Möller-Trumbore against four triangles.  Same operations and thresholds
+// as RayTriangleMT; missed lanes hold FLT_MAX.
+inline Float4 RayTriangle4(Vector3 ro, Vector3 rd, const Packet4& p) {
+    const Float4 e1x = p.bx - p.ax, e1y = p.by - p.ay, e1z = p.bz - p.az;
+    const Float4 e2x = p.cx - p.ax, e2y = p.cy - p.ay, e2z = p.cz - p.az;
+    const Float4 dx = rd.x, dy = rd.y, dz = rd.z;
+    const Float4 hx = dy * e2z - dz * e2y;
+    const Float4 hy = dz * e2x - dx * e2z;
+    const Float4 hz = dx * e2y - dy * e2x;
+    const Float4 a  = e1x * hx + e1y * hy + e1z * hz;
+    const Float4 f  = Float4(1.f) / a;
+    const Float4 sx = Float4(ro.x) - p.ax, sy = Float4(ro.y) - p.ay, sz = Float4(ro.z) - p.az;
+    const Float4 u  = f * (sx * hx + sy * hy + sz * hz);
+    const Float4 qx = sy * e1z - sz * e1y;
+    const Float4 qy = sz * e1x - sx * e1z;
+    const Float4 qz = sx * e1y - sy * e1x;
+    const Float4 v  = f * (dx * qx + dy * qy + dz * qz);
+    const Float4 t  = f * (e2x * qx + e2y * qy + e2z * qz);
+    const Mask4 hit = (Abs(a) >= Float4(1e-8f)) &
+                      (u >= Float4(0.f)) & (u <= Float4(1.f)) &
+                      (v >= Float4(0.f)) & (u + v <= Float4(1.f)) &
+                      (t >= Float4(1e-6f));
+    return Select(hit, t, Float4(FLT_MAX));
+}
+
+// Lanes whose triangle AABB overlaps [qmin, qmax].
+inline int TriBoundsOverlap4(const Packet4& p, Vector3 qmin, Vector3 qmax) {
+    const Mask4 x = (Min(p.ax, Min(p.bx, p.cx)) <= Float4(qmax.x)) & (Max(p.ax, Max(p.bx, p.cx)) >= Float4(qmin.x));
+    const Mask4 y = (Min(p.ay, Min(p.by, p.cy)) <= Float4(qmax.y)) & (Max(p.ay, Max(p.by, p.cy)) >= Float4(qmin.y));
+    const Mask4 z = (Min(p.az, Min(p.bz, p.cz)) <= Float4(qmax.z)) & (Max(p.az, Max(p.bz, p.cz)) >= Float4(qmin.z));
+    return Bits(x & y & z);
+}
+
+// Lanes whose triangle plane comes within `radius` of the segment s→e.
+// Unnormalised normals: compare n·(p−a) squared against r²·|n|².
+// Degenerate triangles (n = 0) always pass.
+inline int PlaneWithin4(const Packet4& p, Vector3 s, Vector3 e, float radius) {
+    const Float4 e1x = p.bx - p.ax, e1y = p.by - p.ay, e1z = p.bz - p.az;
+    const Float4 e2x = p.cx - p.ax, e2y = p.cy - p.ay, e2z = p.cz - p.az;
+    const Float4 nx = e1y * e2z - e1z * e2y;
+    const Float4 ny = e1z * e2x - e1x * e2z;
+    const Float4 nz = e1x * e2y - e1y * e2x;
+    const Float4 ds = nx * (Float4(s.x) - p.ax) + ny * (Float4(s.y) - p.ay) + nz * (Float4(s.z) - p.az);
+    const Float4 de = nx * (Float4(e.x) - p.ax) + ny * (Float4(e.y) - p.ay) + nz * (Float4(e.z) - p.az);
+    const Float4 r2n = Float4(radius * radius) * (nx * nx + ny * ny + nz * nz);
+    return Bits((ds * de <= Float4(0.f)) | (ds * ds <= r2n) | (de * de <= r2n));
+}
+
+// ─── Wide traversal ──────────────────────────────────────────────────────────
+
+// Entry t of ro + t·rd into each of node's four boxes (grown by `pad`),
+// FLT_MAX for lanes missed within [0, tMax] or outside [qmin, qmax].
+inline Float4 NodeEntry4(const LaneBounds4& b, Vector3 ro, Vector3 invD, float pad,
+                         Vector3 qmin, Vector3 qmax, float tMax) {
+    const Float4 mnx = b.mnx - Float4(pad), mxx = b.mxx + Float4(pad);
+    const Float4 mny = b.mny - Float4(pad), mxy = b.mxy + Float4(pad);
+    const Float4 mnz = b.mnz - Float4(pad), mxz = b.mxz + Float4(pad);
+    const Mask4 inQuery = (mnx <= Float4(qmax.x)) & (mxx >= Float4(qmin.x)) &
+                          (mny <= Float4(qmax.y)) & (mxy >= Float4(qmin.y)) &
+                          (mnz <= Float4(qmax.z)) & (mxz >= Float4(qmin.z));
+
+    Float4 t1 = (mnx - Float4(ro.x)) * Float4(invD.x), t2 = (mxx - Float4(ro.x)) * Float4(invD.x);
+    Float4 tEnter = Max(Min(t1, t2), Float4(0.f));
+    Float4 tExit  = Min(Max(t1, t2), Float4(tMax));
+    t1 = (mny - Float4(ro.y)) * Float4(invD.y); t2 = (mxy - Float4(ro.y)) * Float4(invD.y);
+    tEnter = Max(Min(t1, t2), tEnter);
+    tExit  = Min(Max(t1, t2), tExit);
+    t1 = (mnz - Float4(ro.z)) * Float4(invD.z); t2 = (mxz - Float4(ro.z)) * Float4(invD.z);
+    tEnter = Max(Min(t1, t2), tEnter);
+    tExit  = Min(Max(t1, t2), tExit);
+    return Select(inQuery & (tEnter <= tExit), tEnter, Float4(FLT_MAX));
+}
+
+// Wide counterpart of TraverseNearFirst: leaf(packet, lanes) runs for each
+// packet of each reached leaf and may lower bestT; `lanes` holds the
+// packet's triangles whose layers meet mask.  Node lanes the mask misses
+// are never entered.
+template<WideBVH Tree, typename LeafFn>
+inline void TraverseNearFirst(const Tree& q, Vector3 ro, Vector3 rd, float inflate,
+                              float& bestT, LeafFn&& leaf, BVHTraversalStats* stats,
+                              uint32_t mask = ~0u) {
+    if (q.Empty() || !(q.layers.all & mask)) return;
+    const Vector3 invD = { 1.f / rd.x, 1.f / rd.y, 1.f / rd.z };
+    const Vector3 pad  = { inflate, inflate, inflate };
+    const Vector3 re   = v3add(ro, v3scale(rd, bestT));
+    const Vector3 qmin = v3sub({ fminf(ro.x, re.x), fminf(ro.y, re.y), fminf(ro.z, re.z) }, pad);
+    const Vector3 qmax = v3add({ fmaxf(ro.x, re.x), fmaxf(ro.y, re.y), fmaxf(ro.z, re.z) }, pad);
+
+    struct Pending { int child; int packets; float t; };
+    Pending   stack[4 * BVH::MAX_DEPTH];
+    int       top = 0;
+    TriPacket scratch;
+    stack[top++] = { 0, 0, 0.f };
+
+    while (top > 0) {
+        const Pending cur = stack[--top];
+        if (cur.t > bestT) continue;   // a closer hit turned up after the push
+
+        if (cur.packets > 0) {
+            for (int i = cur.child; i < cur.child + cur.packets; ++i) {
+                const int lanes = q.layers.PacketLanes(i, mask);
+                if (!lanes) continue;
+                const TriPacket& pk = q.Packet(i, scratch);
+                if (stats) stats->trianglesTested += pk.count;
+                leaf(pk, PacketLanes(pk) & lanes);
+            }
+            continue;
+        }
+
+        float t[4];
+        NodeEntry4(q.NodeBounds4(cur.child), ro, invD, inflate, qmin, qmax, bestT).Store(t);
+        const int inMask = q.layers.NodeLanes(cur.child, mask);
+
+        // Hit lanes sorted far → near, so the nearest is pushed last
+        Pending hits[4];
+        int     n = 0;
+        for (int i = 0; i < 4; ++i) {
+            const int child = q.Child(cur.child, i);
+            if (child < 0 || !(inMask & (1 << i))) continue;
+            if (stats) ++stats->nodesVisited;
+            if (t[i] == FLT_MAX) continue;
+            int k = n++;
+            for (; k > 0 && hits[k - 1].t < t[i]; --k) hits[k] = hits[k - 1];
+            hits[k] = { child, q.PacketCount(cur.child, i), t[i] };
+        }
+        for (int i = 0; i < n; ++i) stack[top++] = hits[i];
+    }
+}
+
+template<WideBVH Tree>
+inline void SweepNodeBVH(const Tree& q, Vector3 start, Vector3 end, float radius,
+                          float& bestT, Vector3& bestN,
+                          BVHTraversalStats* stats = nullptr, uint32_t mask = ~0u) {
+    const float   slack = radius * QBVH_PREFILTER_SLACK;
+    const Vector3 pad   = { slack, slack, slack };
+    const Vector3 smin  = v3sub({ fminf(start.x, end.x), fminf(start.y, end.y), fminf(start.z, end.z) }, pad);
+    const Vector3 smax  = v3add({ fmaxf(start.x, end.x), fmaxf(start.y, end.y), fmaxf(start.z, end.z) }, pad);
+    float tLimit = fminf(bestT, 1.f);
+    TraverseNearFirst(q, start, v3sub(end, start), radius, tLimit,
+                      [&](const TriPacket& pk, int lanes) {
+                          const Packet4 p(pk);
+                          lanes &= TriBoundsOverlap4(p, smin, smax) & PlaneWithin4(p, start, end, slack);
+                          for (; lanes; lanes &= lanes - 1) {
+                              const int i = std::countr_zero(static_cast<unsigned>(lanes));
+                              Vector3 n;
+                              const float t = SweepSphereTriangle(start, end, radius, pk.A(i), pk.B(i), pk.C(i), n);
+                              if (t <= tLimit && t < bestT) { tLimit = t; bestT = t; bestN = n; }
+                          }
+                      }, stats, mask);
+}
+
+template<WideBVH Tree>
+inline void PenetrationNodeBVH(const Tree& q, Vector3 center, float radius,
+                                Vector3& outPush, bool& didPush,
+                                BVHTraversalStats* stats = nullptr, uint32_t mask = ~0u) {
+    if (q.Empty() || !(q.layers.all & mask)) return;
+    const float   slack = radius * QBVH_PREFILTER_SLACK;
+    const Vector3 qmin  = { center.x - slack, center.y - slack, center.z - slack };
+    const Vector3 qmax  = { center.x + slack, center.y + slack, center.z + slack };
+
+    struct Pending { int child; int packets; };
+    Pending   stack[4 * BVH::MAX_DEPTH];
+    int       top = 0;
+    TriPacket scratch;
+    stack[top++] = { 0, 0 };
+
+    while (top > 0) {
+        const Pending cur = stack[--top];
+        if (cur.packets == 0) {
+            // Quick AABB cull (expand by radius), four boxes at once
+            const LaneBounds4 b = q.NodeBounds4(cur.child);
+            const Mask4 hit = (b.mnx <= Float4(qmax.x)) & (b.mxx >= Float4(qmin.x)) &
+                              (b.mny <= Float4(qmax.y)) & (b.mxy >= Float4(qmin.y)) &
+                              (b.mnz <= Float4(qmax.z)) & (b.mxz >= Float4(qmin.z));
+            int live = 0;
+            for (int i = 0; i < 4; ++i) live |= (q.Child(cur.child, i) >= 0) << i;
+            live &= q.layers.NodeLanes(cur.child, mask);
+            if (stats) stats->nodesVisited += (uint64_t)std::popcount(static_cast<unsigned>(live));
+            for (int bits = Bits(hit) & live; bits; bits &= bits - 1) {
+                const int i = std::countr_zero(static_cast<unsigned>(bits));
+                stack[top++] = { q.Child(cur.child, i), q.PacketCount(cur.child, i) };
+            }
+            continue;
+        }
+
+        for (int pi = cur.child; pi < cur.child + cur.packets; ++pi) {
+            const int inMask = q.layers.PacketLanes(pi, mask);
+            if (!inMask) continue;
+            const TriPacket& pk = q.Packet(pi, scratch);
+            if (stats) stats->trianglesTested += pk.count;
+            const Packet4 p(pk);
+            int lanes = PacketLanes(pk) & inMask & TriBoundsOverlap4(p, qmin, qmax)
+                                                 & PlaneWithin4(p, center, center, slack);
+            for (; lanes; lanes &= lanes - 1) {
+                const int i = std::countr_zero(static_cast<unsigned>(lanes));
+                const Vector3 a = pk.A(i), b = pk.B(i), c = pk.C(i);
+                Vector3 closest = ClosestPtTriangle(center, a, b, c);
+                Vector3 diff    = v3sub(center, closest);
+                float dist2     = v3dot(diff, diff);
+                if (dist2 < radius * radius) {
+                    float dist = sqrtf(dist2);
+                    Vector3 n;
+                    if (dist > 1e-6f) {
+                        n = v3scale(diff, 1.f / dist);
+                    } else {
+                        // Center is on the triangle — push out along face normal
+                        n = v3norm(v3cross(v3sub(b, a), v3sub(c, a)));
+                    }
+                    float depth = radius - dist;
+                    outPush  = v3add(outPush, v3scale(n, depth));
+                    didPush  = true;
+                }
+            }
+        }
+    }
+}
+
+// tri(id, a, b, c) for every triangle whose AABB overlaps [qmin, qmax] and
+// whose layers meet mask.  For callers that run many small queries in one
+// region: gather once, then test the local set.  id is packet * 4 + lane,
+// stable for the life of the tree (refits included); TriangleById reads
+// the triangle back.
+template<WideBVH Tree, typename TriFn>
+inline void GatherNodeBVH(const Tree& q, Vector3 qmin, Vector3 qmax, uint32_t mask, TriFn&& tri) {
+    if (q.Empty() || !(q.layers.all & mask)) return;
+
+    struct Pending { int child; int packets; };
+    Pending   stack[4 * BVH::MAX_DEPTH];
+    int       top = 0;
+    TriPacket scratch;
+    stack[top++] = { 0, 0 };
+
+    while (top > 0) {
+        const Pending cur = stack[--top];
+        if (cur.packets == 0) {
+            const LaneBounds4 b = q.NodeBounds4(cur.child);
+            const Mask4 hit = (b.mnx <= Float4(qmax.x)) & (b.mxx >= Float4(qmin.x)) &
+                              (b.mny <= Float4(qmax.y)) & (b.mxy >= Float4(qmin.y)) &
+                              (b.mnz <= Float4(qmax.z)) & (b.mxz >= Float4(qmin.z));
+            int live = 0;
+            for (int i = 0; i < 4; ++i) live |= (q.Child(cur.child, i) >= 0) << i;
+            for (int bits = Bits(hit) & live & q.layers.NodeLanes(cur.child, mask); bits; bits &= bits - 1) {
+                const int i = std::countr_zero(static_cast<unsigned>(bits));
+                stack[top++] = { q.Child(cur.child, i), q.PacketCount(cur.child, i) };
+            }
+            continue;
+        }
+
+        for (int pi = cur.child; pi < cur.child + cur.packets; ++pi) {
+            const int inMask = q.layers.PacketLanes(pi, mask);
+            if (!inMask) continue;
+            const TriPacket& pk = q.Packet(pi, scratch);
+            for (int lanes = PacketLanes(pk) & inMask & TriBoundsOverlap4(Packet4(pk), qmin, qmax);
+                 lanes; lanes &= lanes - 1) {
+                const int i = std::countr_zero(static_cast<unsigned>(lanes));
+                tri((uint32_t)pi * 4u + (uint32_t)i, pk.A(i), pk.B(i), pk.C(i));
+            }
+        }
+    }
+}
+
+// Vertices of triangle `id` as GatherNodeBVH numbers them; false if q has
+// no such triangle.
+template<WideBVH Tree>
+inline bool TriangleById(const Tree& q, uint32_t id, Vector3& a, Vector3& b, Vector3& c) {
+    const size_t pi   = id / 4u;
+    const int    lane = (int)(id % 4u);
+    if (pi >= q.packets.size()) return false;
+    TriPacket scratch;
+    const TriPacket& pk = q.Packet((int)pi, scratch);
+    if (lane >= pk.count) return false;
+    a = pk.A(lane); b = pk.B(lane); c = pk.C(lane);
+    return true;
+}
+
+template<WideBVH Tree>
+inline void RaycastNodeBVH(const Tree& q, Vector3 ro, Vector3 rd, float& bestT, Vector3& bestN,
+                             BVHTraversalStats* stats = nullptr, uint32_t mask = ~0u) {
+    TraverseNearFirst(q, ro, rd, 0.f, bestT,
+                      [&](const TriPacket& pk, int lanes) {
+                          float t[4];
+                          RayTriangle4(ro, rd, Packet4(pk)).Store(t);
+                          int best = -1;
+                          for (; lanes; lanes &= lanes - 1) {
+                              const int i = std::countr_zero(static_cast<unsigned>(lanes));
+                              if (t[i] < bestT) { bestT = t[i]; best = i; }
+                          }
+                          if (best < 0) return;
+                          const Vector3 e1 = v3sub(pk.B(best), pk.A(best));
+                          const Vector3 e2 = v3sub(pk.C(best), pk.A(best));
+                          Vector3 n = v3norm(v3cross(e1, e2));
+                          // Flip so the normal faces the incoming ray
+                          if (v3dot(n, rd) > 0.f) n = v3scale(n, -1.f);
+                          bestN = n;
+                      }, stats, mask);
+}
+
+}} // namespace Hotones::Physics
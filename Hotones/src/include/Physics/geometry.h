@@ -12,6 +12,9 @@ public:
   virtual ShapeType GetType() const = 0;
   virtual Vector3 GetCenterOfMass() const { return centerOfMass; }
   virtual Matrix GetInertiaTensor() const = 0;
+  // World-space AABB of the shape placed at position/orientation
+  virtual void GetBounds(const Vector3 &position, const Quaternion &orientation,
+                         Vector3 &boundsMin, Vector3 &boundsMax) const = 0;
 
 protected:
   Vector3 centerOfMass;
@@ -39,5 +42,12 @@ public:
     m.m15 = 1.0f;
     return m;
   }
+  void GetBounds(const Vector3 &position, const Quaternion &orientation,
+                 Vector3 &boundsMin, Vector3 &boundsMax) const override
+  {
+    const Vector3 extent = Vector3{radius, radius, radius};
+    boundsMin = Vector3Subtract(position, extent);
+    boundsMax = Vector3Add(position, extent);
+  }
   float radius;
 };
@@ -30,6 +30,50 @@ public:
   Vector3 LocalSpaceToWorldSpace(const Vector3 &point) const;
 
   void ApplyLinearImpulse(const Vector3 &impulse);
+
+  // AABB covering the body over [0, deltaTime] at its current velocity,
+  // i.e. everything Intersect() can reach in that window.
+  void GetSweptBounds(float deltaTime, Vector3 &boundsMin, Vector3 &boundsMax) const;
+};
+
+struct BodyPair
+{
+  int a; // index into Scene::bodies, a < b
+  int b;
+};
+
+struct AABB
+{
+  Vector3 min;
+  Vector3 max;
+};
+
+// Sweep-and-prune on the x axis over a set of bodies. The member order is
+// kept between calls: bodies move little per substep, so re-sorting it is
+// close to linear.
+class Broadphase
+{
+public:
+  // Start over with these body indices
+  void Reset(const std::vector<int> &members);
+  int MemberCount() const { return (int)entries.size(); }
+
+  // Every member pair whose swept bounds over deltaTime overlap and that has
+  // at least one movable body, sorted as a plain i < j loop would find them.
+  void FindPairs(const std::vector<Body> &bodies, float deltaTime, std::vector<BodyPair> &pairs);
+  // The same, with the caller's per-body bounds (indexed by body) instead
+  void FindOverlaps(const std::vector<Body> &bodies, const std::vector<AABB> &bounds,
+                    std::vector<BodyPair> &pairs);
+
+private:
+  void Sweep(const std::vector<Body> &bodies, std::vector<BodyPair> &pairs);
+
+  struct Entry
+  {
+    int body;
+    AABB bounds;
+  };
+  std::vector<Entry> entries; // sorted by bounds.min.x
 };
 
 class Scene
@@ -47,6 +91,34 @@ public:
   Vector3 gravity = Vector3{0, -9.8f, 0};
 
   std::vector<Body> bodies;
+
+  // Fills candidatePairs for the whole scene; only those pairs can hit
+  // within deltaTime.
+  void UpdateBroadphase(const float deltaTime);
+
+  std::vector<BodyPair> candidatePairs;
+
+  // Islands from the last Update: groups of bodies that could touch each
+  // other during the frame. Each island steps through its own TOI events,
+  // concurrently on Jobs::JobSystem, so a fast body only splits the steps
+  // of the bodies it can actually reach. Immovable, non-moving bodies
+  // (level geometry) belong to no island and are shared by all of them.
+  int GetIslandCount() const { return (int)islands.size(); }
+
+private:
+  struct Island
+  {
+    std::vector<int> members;
+  };
+
+  void BuildIslands(const float deltaTime);
+  void SolveIsland(const Island &island, const float deltaTime);
+
+  Broadphase broadphase;
+  std::vector<Island> islands;
+  std::vector<int> fixedBodies;   // invertedMass == 0 and at rest
+  std::vector<int> islandParent;  // union-find over body indices
+  std::vector<AABB> travelBounds; // per body: everything it covered this frame
 };
 
 struct CollisionPoint
@@ -0,0 +1,152 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ─── Profiler ─────────────────────────────────────────────────────────────────
+//
+// Frame profiler: scoped CPU zones on any thread, GPU zones timed with GL
+// timestamp queries, kept per frame for the last few seconds, shown as a
+// timeline by DrawPanel() and written out as a Chrome trace (load it in
+// chrome://tracing or ui.perfetto.dev).
+//
+// A zone lasts until the end of its scope:
+//   void Player::Update() {
+//       HOTONES_ZONE("Player::Update");
+//       ...
+//   }
+// Names must outlive the profiler: string literals.  Nested zones show up
+// below their parent.  A GPU zone (main thread, inside the frame's drawing)
+// also flushes rlgl's pending batch at both ends, so what it covers is what
+// was drawn in its scope; its times arrive a few frames later, once the GPU
+// has got that far.
+//
+// The main loop calls HOTONES_FRAME() once per frame; nothing is recorded
+// before the first call, so threads of a process that never draws a frame
+// (the dedicated server) don't collect zones.  Threads name themselves once
+// with HOTONES_THREAD("name"), otherwise they show as "Thread <n>".
+//
+// Counters track a value over time (memory, queue lengths, collector
+// steps): HOTONES_COUNTER("Lua memory KB", kb) records it for the frame in
+// progress, the last value set winning.  The panel lists the selected
+// frame's counters and the trace plots them.
+//
+// Building with -DHOTONES_PROFILE=0 turns every macro into nothing.  The
+// functions below still exist (there is just nothing to show).
+//
+// GPU timing needs OpenGL 3.3 and is off without InitGpuTimers(); the CPU
+// side works either way.  Frames, their zones and DrawPanel() belong to the
+// main thread.
+
+#ifndef HOTONES_PROFILE
+#define HOTONES_PROFILE 1
+#endif
+
+namespace Hotones::Profile {
+
+constexpr size_t HISTORY_FRAMES = 300;   // frames kept, ~5 s at 60 fps
+
+struct ZoneEvent {
+    const char* name  = nullptr;
+    int64_t     start = 0;   // Now() timestamps, ns
+    int64_t     end   = 0;
+    uint32_t    depth = 0;   // 0 → outermost on its thread
+};
+
+struct CounterSample {
+    const char* name  = nullptr;
+    double      value = 0.0;
+};
+
+struct ThreadTrack {
+    uint32_t               id = 0;   // stable per thread, in start order
+    std::string            name;
+    std::vector<ZoneEvent> zones;    // in the order they ended
+};
+
+struct Frame {
+    uint64_t                 index = 0;
+    int64_t                  start = 0, end = 0;   // between HOTONES_FRAME() calls, ns
+    std::vector<ThreadTrack> threads;              // those that recorded zones
+    std::vector<ZoneEvent>   gpu;                  // on the CPU clock; may end after `end`
+    std::vector<CounterSample> counters;           // set during the frame, in first-set order
+    bool                     gpuPending = false;   // GPU zones not read back yet
+    size_t                   dropped    = 0;       // zones over the per-thread limit
+};
+
+// Monotonic nanoseconds, the clock every timestamp above is on
+int64_t Now();
+
+// Close the frame in progress and start the next (main thread)
+void BeginFrame();
+
+// Name the calling thread's track.  `name` is copied.
+void SetThreadName(const char* name);
+
+// Record `value` for counter `name` (a string literal) in the frame in
+// progress; any thread
+void SetCounter(const char* name, double value);
+
+// While off, zones cost one atomic load and the history stays as it is
+void SetRecording(bool on);
+bool IsRecording();
+
+// Recorded frames, oldest first, at most HISTORY_FRAMES
+const std::vector<Frame>& Frames();
+void ClearFrames();
+
+// GL timestamp queries for GPU zones; after InitWindow(), before
+// CloseWindow().  False when the context lacks them.
+bool InitGpuTimers();
+void ShutdownGpuTimers();
+bool HasGpuTimers();
+
+// Frames() as Chrome trace event JSON; false when `path` can't be written
+bool ExportChromeTrace(const std::string& path);
+
+// Contents of a debug window tab: frame times, the selected frame's
+// timeline and its zone totals.  Call between ImGui::Begin() / End().
+void DrawPanel();
+
+class Zone {
+public:
+    explicit Zone(const char* name) noexcept;
+    ~Zone();
+    Zone(const Zone&)            = delete;
+    Zone& operator=(const Zone&) = delete;
+
+private:
+    const char* m_name;
+    int64_t     m_start = -1;   // -1 → not recording
+};
+
+class GpuZone {
+public:
+    explicit GpuZone(const char* name) noexcept;
+    ~GpuZone();
+    GpuZone(const GpuZone&)            = delete;
+    GpuZone& operator=(const GpuZone&) = delete;
+
+private:
+    int m_slot = -1;   // query pair this zone writes, -1 → not timed
+};
+
+} // namespace Hotones::Profile
+
+#define HOTONES_PROFILE_CAT2(a, b) a##b
+#define HOTONES_PROFILE_CAT(a, b)  HOTONES_PROFILE_CAT2(a, b)
+
+#if HOTONES_PROFILE
+#define HOTONES_ZONE(name)     ::Hotones::Profile::Zone    HOTONES_PROFILE_CAT(hotonesZone_, __LINE__)(name)
+#define HOTONES_GPU_ZONE(name) ::Hotones::Profile::GpuZone HOTONES_PROFILE_CAT(hotonesGpuZone_, __LINE__)(name)
+#define HOTONES_FRAME()        ::Hotones::Profile::BeginFrame()
+#define HOTONES_THREAD(name)   ::Hotones::Profile::SetThreadName(name)
+#define HOTONES_COUNTER(name, value) ::Hotones::Profile::SetCounter(name, value)
+#else
+#define HOTONES_ZONE(name)     ((void)0)
+#define HOTONES_GPU_ZONE(name) ((void)0)
+#define HOTONES_FRAME()        ((void)0)
+#define HOTONES_THREAD(name)   ((void)0)
+#define HOTONES_COUNTER(name, value) ((void)0)
+#endif
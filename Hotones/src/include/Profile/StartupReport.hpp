@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <Profile/Profiler.hpp>
+
+// ─── Startup report ───────────────────────────────────────────────────────────
+//
+// Wall-clock time of each startup stage, and of the whole way to the first
+// frame.  Stages may run on job threads alongside each other; the report
+// shows where each started and how long it took, so what is still serial on
+// the way to the first frame stands out.
+//
+//   Profile::BeginStartup();                        // main thread, early
+//   Profile::TimeStage("Audio device", [&] { InitAudioSystem(); });
+//   ...
+//   Profile::EndStartup();                          // first frame is up
+//   Profile::PrintStartupReport();                  // --startup-report
+//
+// Recording is always on and cheap; printing is up to the caller.
+
+namespace Hotones::Profile {
+
+struct StartupStage {
+    const char* name  = nullptr;   // a string literal
+    int64_t     start = 0;         // Now() timestamps, ns
+    int64_t     end   = 0;
+    bool        main  = false;     // ran on the thread that called BeginStartup()
+};
+
+// Start the clock the report measures from (main thread)
+void BeginStartup();
+
+// Record a finished stage; any thread
+void RecordStage(const char* name, int64_t start, int64_t end);
+
+// Run fn() as stage `name`
+template<typename Fn>
+void TimeStage(const char* name, Fn&& fn)
+{
+    const int64_t start = Now();
+    std::forward<Fn>(fn)();
+    RecordStage(name, start, Now());
+}
+
+// The first frame has been drawn; stops the clock
+void EndStartup();
+
+// Stages recorded so far, in the order they started
+std::vector<StartupStage> StartupStages();
+
+// A table of the stages and the time to first frame, on stdout
+void PrintStartupReport();
+
+} // namespace Hotones::Profile
@@ -0,0 +1,125 @@
+#pragma once
+#include <Input/InputHandler.hpp>
+#include <server/NetworkManager.hpp>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// ─── SessionLog ───────────────────────────────────────────────────────────────
+//
+// A played session as a compact binary log, and the same session driven
+// back from it.  The log keeps what a frame takes from outside the engine:
+// its duration, the input it sampled and the datagrams it received.  Fed
+// those again, Player, the scenes, the pack's scripts and physics make the
+// same decisions, with or without anything drawn, so a replay doubles as a
+// repeatable benchmark (--replay <file> --benchmark).
+//
+// A log starts at the anchor, the moment the loading screen hands over to
+// gameplay: the frame clock's time, the fixed-step accumulator, math.random's
+// seed and the input then are stored, and every datagram received up to the
+// end of that frame (the connection handshake) goes in as the prelude.  The
+// frames after it follow one record each.
+//
+//   SessionRecorder rec;                      SessionPlayer play;
+//   rec.Open(path); rec.Attach(netMgr);       play.Open(path);
+//   ... at the anchor:                        ... at the anchor:
+//   rec.Anchor(pakPath, mode, seed);          play.Start(netMgr);
+//   ... each frame, after its network tick:   ... each frame, before input:
+//   rec.EndFrame(dt, input);                  if (!play.Next(frame)) stop;
+//
+// Main thread only.
+
+namespace Hotones::Replay {
+
+struct SessionPacket {
+    uint32_t             ip   = 0;   // sender, host byte order
+    uint16_t             port = 0;
+    std::vector<uint8_t> data;
+};
+
+struct SessionHeader {
+    std::string                   pakPath;   // as given to setupPack(); empty for the built-in level
+    Net::NetworkManager::Mode     netMode = Net::NetworkManager::Mode::None;
+    uint64_t                      seed    = 0;     // math.randomseed()
+    double                        clock   = 0.0;   // FrameClock::Now() at the anchor
+    Input::FrameInput             input;           // held keys, buttons and mouse at the anchor
+    std::vector<SessionPacket>    prelude;         // datagrams received up to the anchor
+};
+
+struct SessionFrame {
+    float                      dt = 0.f;
+    Input::FrameInput          input;
+    std::vector<SessionPacket> packets;   // received during the frame, in order
+};
+
+// ── Recording ─────────────────────────────────────────────────────────────────
+class SessionRecorder {
+public:
+    ~SessionRecorder() { Close(); }
+
+    bool Open(const std::string& path);
+    bool IsOpen() const { return m_out.is_open(); }
+
+    // Keep the datagrams `nm` receives from now on (sets OnDatagram)
+    void Attach(Net::NetworkManager& nm);
+
+    // Gameplay starts: resets the fixed-step accumulator and notes the
+    // clock.  The header goes out with the next EndFrame().
+    void Anchor(const std::string& pakPath, Net::NetworkManager::Mode netMode, uint64_t seed);
+    bool IsAnchored() const { return m_anchored; }
+
+    // The frame is over: `dt` and `input` are what it ran with
+    void EndFrame(float dt, const Input::FrameInput& input);
+
+    // Flushes and closes; says how much was recorded
+    void Close();
+
+private:
+    std::ofstream              m_out;
+    std::string                m_path;
+    SessionHeader              m_header;
+    std::vector<SessionPacket> m_packets;   // received since the last EndFrame() (the prelude until then)
+    Input::FrameInput          m_prev;      // input of the last frame written
+    std::vector<uint8_t>       m_buf;       // one record, reused
+    bool                       m_anchored      = false;
+    bool                       m_headerWritten = false;
+    uint64_t                   m_frames = 0;
+    uint64_t                   m_bytes  = 0;
+};
+
+// ── Replay ────────────────────────────────────────────────────────────────────
+class SessionPlayer {
+public:
+    // Reads the header; false, with the reason logged, on a file that isn't
+    // a session log of this version
+    bool Open(const std::string& path);
+    const SessionHeader& Header() const { return m_header; }
+
+    // Gameplay starts: the frame clock, fixed-step accumulator and input
+    // take the recorded anchor's, and the prelude is handed to `nm` (which
+    // should be in StartReplay() mode of the header's netMode)
+    void Start(Net::NetworkManager& nm);
+
+    // The next frame; false at the end of the log (or at a damaged record,
+    // which is logged)
+    bool Next(SessionFrame& frame);
+
+    // Hand `packets` to `nm`'s next Update(); a full receive ring is drained
+    // with Update() first
+    static void Inject(Net::NetworkManager& nm, const std::vector<SessionPacket>& packets);
+
+    uint64_t FramesRead() const { return m_frames; }
+
+private:
+    std::ifstream     m_in;
+    SessionHeader     m_header;
+    Input::FrameInput m_prev;
+    uint64_t          m_frames = 0;
+};
+
+// Frame time percentiles (p50, p90, p99, max, mean) of a --benchmark run,
+// on stdout
+void PrintFrameTimes(std::vector<double> frameMs);
+
+} // namespace Hotones::Replay
@@ -0,0 +1,96 @@
+#pragma once
+#include <ECS/System.hpp>
+#include <ECS/Components.hpp>
+#include <SFX/AudioSystem.hpp>
+#include <raylib.h>
+#include <unordered_map>
+#include <vector>
+
+namespace Ho_tones {
+
+// ─── SpatialAudioSystem ───────────────────────────────────────────────────────
+//
+// Plays every AudioEmitterComponent from its entity's
+// TransformComponent::position, as heard by the listener (SetListener: the
+// camera).  Each tick, over flat arrays of all the emitters at once:
+//
+//   gain = volume · (1 − d / maxDist)²       silent from maxDist on
+//   pan  = how far to the listener's right the emitter is, −1 .. 1
+//   rate = pitch · doppler                   (c + v_listener) / (c − v_emitter),
+//                                            the speeds towards each other
+//
+// then the voices' new parameters go to the mixer in one SoundBus::
+// SetVoiceParams batch.  Emitter speeds come from their movement since the
+// last tick.
+//
+// An emitter with `playing` set holds a voice only while it can be heard:
+// one beyond maxDist or too quiet takes none.  A looping emitter picks its
+// voice up again (from the start) when it comes back into range or wins a
+// voice back; a one-shot that can't be heard, or loses its voice, is dropped
+// and clears `playing`, as it does when it ends.  `autoPlay` sets `playing`
+// the first time the system sees the emitter.  The distance counts for
+// voice stealing (SoundBus::SetSoundLimits).
+//
+// Add it after MovementSystem / PhysicsSystem so it hears this tick's
+// positions.  It is the only system using the SoundBus; nothing else plays
+// sounds while the scheduler runs a stage.  Does nothing without an audio
+// device (headless servers).
+
+class SpatialAudioSystem : public Hotones::ECS::System {
+public:
+    static constexpr float SPEED_OF_SOUND = 343.0f;   // world units (metres) per second
+    static constexpr float AUDIBLE_GAIN   = 0.001f;   // quieter than this takes no voice
+
+    void DeclareAccess(Hotones::ECS::SystemAccess& access) const override {
+        access.Read<Hotones::ECS::TransformComponent>().Write<Hotones::ECS::AudioEmitterComponent>();
+    }
+
+    // Where the emitters are heard from; `forward` and `up` needn't be unit length
+    void SetListener(Vector3 position, Vector3 forward, Vector3 up, Vector3 velocity = { 0.0f, 0.0f, 0.0f });
+
+    // Scales the doppler shift: 0 turns it off, 1 is physical
+    void SetDoppler(float factor) { m_doppler = factor; }
+
+    void Update(Hotones::ECS::Registry& reg, float dt) override;
+
+    // Stops every voice the system started
+    void Shutdown(Hotones::ECS::Registry& reg) override;
+
+private:
+    struct EmitterState {
+        uint32_t voice    = 0;
+        Vector3  lastPos  = { 0.0f, 0.0f, 0.0f };
+        uint64_t seenTick = 0;
+    };
+
+    // One emitter's share of the batch, gathered from the registry
+    struct Source {
+        Hotones::ECS::EntityId               id;
+        Hotones::ECS::AudioEmitterComponent* emitter;
+        EmitterState*                        state;
+    };
+
+    // Fill m_gain, m_pan, m_rate and m_dist for the m_sources.size()
+    // gathered emitters
+    void Spatialise();
+
+    SoundBus& m_bus = GetSoundBus();
+
+    Vector3 m_listenerPos   = { 0.0f, 0.0f, 0.0f };
+    Vector3 m_listenerRight = { 1.0f, 0.0f, 0.0f };
+    Vector3 m_listenerVel   = { 0.0f, 0.0f, 0.0f };
+    float   m_doppler       = 1.0f;
+    uint64_t m_tick         = 0;
+
+    std::unordered_map<Hotones::ECS::EntityId, EmitterState> m_states;
+
+    // Per-tick batch, structure of arrays; reused
+    std::vector<Source> m_sources;
+    std::vector<float>  m_dx, m_dy, m_dz;      // emitter − listener
+    std::vector<float>  m_vx, m_vy, m_vz;      // emitter velocity
+    std::vector<float>  m_volume, m_maxDist, m_pitch;
+    std::vector<float>  m_gain, m_pan, m_rate, m_dist;
+    std::vector<SoundBus::VoiceParams> m_params;
+};
+
+} // namespace Ho_tones
@@ -1,17 +1,33 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <atomic>
+#include <vector>
+
+#include <Scripting/LuaProfiler.hpp>
+#include <Scripting/LuaWorkers.hpp>
+
+// Built with -DHOTONES_HEADLESS=1 (the dedicated server target in server/),
+// a pack gets only the libraries a server can back: no rendering, audio,
+// meshgen, lighting or localPlayer tables, and a hot reload re-imports
+// scripts but no models, textures or sounds.  input stays, as on a client
+// running --server: nothing is ever down and the mouse never moves.
+#ifndef HOTONES_HEADLESS
+#define HOTONES_HEADLESS 0
+#endif
 
 struct lua_State;
 
-namespace Hotones::Net { class NetworkManager; }
+namespace Hotones::Net    { class NetworkManager; }
+namespace Hotones::Assets { class FileWatcher;    }
 namespace Hotones       { class Player;          }
 
 namespace Hotones::Scripting {
 
 class CupPackage;
+class LuaAllocator;
 
 class CupLoader {
 public:
@@ -19,7 +35,7 @@ public:
     ~CupLoader();
 
     // Initialize Lua state and register ALL engine libraries
-    // (render, audio, input, server).
+    // (render, audio, input, server; the server's only, HOTONES_HEADLESS).
     bool init();
 
     // Load a Lua file onto the stack (does not execute it yet).
@@ -36,11 +52,57 @@ public:
     //   3. Stores a reference to Init.MainClass.
     //   4. Calls MainClass:Init().
     // init() must be called before loadPak().
+    // A directory pack is then watched for edits, which update() applies
+    // (see applyFileChanges()); a mounted .cup doesn't change under us.
     bool loadPak(CupPackage& pkg);
 
     // Call MainClass:Update() — drive from the server / game tick loop.
+    // First resumes the task.* coroutines that are due and runs the
+    // callbacks of finished nav.findPath() batches; also performs a requested reload, applies pack files edited since and
+    // ends with the frame's garbage collection step (see setGcBudget()).
+    // Before Update() it hands MainClass:onWorkerMessage(name, value) what
+    // the pack's workers sent; after it, starts their next step (see
+    // workers()) and the paths asked for during it.
     void update();
 
+    // ── Garbage collection ───────────────────────────────────────────────────
+    // The collector runs in generational mode on Lua 5.4 (incremental on
+    // older versions), and update() gives it an explicit step each frame
+    // so its work stays a steady per-frame cost rather than a full cycle
+    // landing on some busy frame.  In generational mode the step is one
+    // minor collection; in incremental mode, steps until `ms` is spent or
+    // the cycle completes.  0 leaves collection to the allocator alone.
+    // The time taken, steps and Lua memory go to the profiler as the
+    // "Lua GC ms", "Lua GC steps" and "Lua memory KB" counters.
+    void setGcBudget(double ms) { m_gcBudgetMs = ms; }
+
+    // The same as running totals, for metrics exporters (take differences)
+    struct GcStats {
+        double   memoryKB = 0.0;   // after the last step
+        double   totalMs  = 0.0;   // in steps since construction
+        uint64_t steps    = 0;
+    };
+    const GcStats& gcStats() const { return m_gcStats; }
+
+    // ── Memory ───────────────────────────────────────────────────────────────
+    // Each state allocates from its own LuaAllocator (size-class pools for
+    // small objects, malloc above that).  Its per-class counters; null
+    // before init().  Blocks handed out per frame go to the profiler as the
+    // "Lua allocs" counter.
+    const LuaAllocator* allocator() const { return m_alloc.get(); }
+
+    // ── Profiling ────────────────────────────────────────────────────────────
+    // Stack sampler for the pack's scripts; also times each callback while
+    // running.  Stays with the loader across reloads.  Off until started
+    // (the Lua Profiler debug tab, or SIGUSR1 on a headless server).
+    LuaProfiler& profiler() { return m_profiler; }
+
+    // ── Workers ──────────────────────────────────────────────────────────────
+    // The scripts named in Init.Workers, each in a Lua state of its own
+    // stepped on the JobSystem (see LuaWorkers.hpp).  Started by loadPak()
+    // and restarted, from scratch, by reload().
+    const LuaWorkers& workers() const { return m_workers; }
+
     // Call MainClass:draw3D() — 3D pass; called INSIDE BeginMode3D() / EndMode3D().
     // Use mesh.* Lua functions here (they call raylib 3D primitives directly).
     void draw3D();
@@ -50,9 +112,12 @@ public:
 
     // ── Player event hooks ────────────────────────────────────────────────────
     // Call MainClass:onPlayerJoined(id, name) if the method exists.
-    void firePlayerJoined(uint8_t id, const char* name);
+    void firePlayerJoined(uint16_t id, const char* name);
     // Call MainClass:onPlayerLeft(id) if the method exists.
-    void firePlayerLeft(uint8_t id);
+    void firePlayerLeft(uint16_t id);
+    // Call MainClass:onMessage(from, data) if the method exists; `data` is
+    // a network.send() payload as a Lua string.
+    void fireMessage(uint16_t from, const uint8_t* data, size_t len);
 
     // Path declared in Init.MainScene, resolved to an absolute path.
     // Empty string if none was declared or loadPak has not been called.
@@ -65,10 +130,17 @@ public:
         // Last Lua error message (empty when none).  Useful for debug UI.
         const std::string& GetLastError() const { return m_lastLuaError; }
         void ClearLastError() { m_lastLuaError.clear(); }
+        // For errors in Lua called from outside the loader (ScriptSystem)
+        void SetLastError(const std::string& error) { m_lastLuaError = error; }
 
     // Access the raw Lua state for advanced usage.
     lua_State* state();
 
+    // Bumped by every hot reload of modules, which replaces their functions
+    // in place: whoever caches refs to script functions (ScriptSystem)
+    // looks them up again when it changes
+    uint32_t codeVersion() const { return m_codeVersion; }
+
     // Request a reload from any context (Lua binding sets this).  The actual
     // reload() is executed on the next call to update() to avoid closing the
     // active Lua state while a C function is running inside it.
@@ -82,20 +154,86 @@ public:
     // Lua library.  Safe to call before or after init().
     void setLocalPlayer(Hotones::Player* player);
 
+    // Seed math.random() with `seed` now and in every state reload() builds,
+    // so a recorded session replays the same rolls.  Unseeded, Lua seeds
+    // itself (randomly on 5.4).
+    void setRandomSeed(uint64_t seed);
+
 private:
-    // Push instance + method, call with args already on stack, handle errors.
-    // nargs = number of extra arguments above the implicit `self`.
-    bool callMethod(const char* method, int nargs = 0);
+    // MainClass methods the engine calls, in HOOK_NAMES order
+    enum Hook { HookInit, HookUpdate, HookDraw3D, HookDraw, HookPlayerJoined, HookPlayerLeft,
+                HookMessage, HookFileChanged, HookWorkerMessage, HookCount };
+
+    // Look the hooks up on MainClass and keep registry refs to them (and to
+    // the traceback message handler), so calling one costs no string
+    // lookup.  Done on load, on reload, after Init() (which may still add
+    // methods) and after a module reload (which may replace them).
+    void resolveHooks();
+    // Release the refs resolveHooks() took
+    void dropHooks();
+
+    // Push the message handler, `hook` and MainClass (its `self`); false,
+    // with nothing pushed, if the pack doesn't define it.  Push the
+    // arguments, then callHook() with their count.
+    bool beginHook(Hook hook);
+    // Call the hook begun with beginHook(); an error (with its traceback)
+    // is logged and kept as GetLastError().  Leaves the stack as it was.
+    bool callHook(Hook hook, int nargs);
+    // beginHook() + callHook() for hooks without arguments
+    bool callHook(Hook hook) { return beginHook(hook) && callHook(hook, 0); }
+
+    // Resume the task.* coroutines that are due; update() calls it first,
+    // so a task waiting one tick runs before the next Update()
+    void resumeTasks();
+
+    // Run the callbacks of the nav.findPath() batches that have finished;
+    // update() calls it after resumeTasks()
+    void deliverPaths();
+
+    // Start the pack's workers (stopping any running); errors are logged
+    // and kept as GetLastError()
+    void startWorkers(const std::vector<LuaWorkers::Spec>& specs);
+    // Wait for the workers' step and pass on what they sent; update()
+    // calls it before Update()
+    void deliverWorkerMessages();
+
+    // The frame's collection step; update() calls it last
+    void stepGc();
+
+    // Hot reload of the files the watcher reports, instead of the whole pack:
+    // an edited module is re-executed into package.loaded (patching the old
+    // table in place), an edited asset is re-imported through the
+    // AssetCache and SoundBus, and MainClass:onFileChanged(path) is told.
+    // An edited init.lua still reloads everything.
+    void applyFileChanges();
+
+    // Re-execute the module `name` from `path` if it has been required; the
+    // new module's OnReload(old) may carry state over.  False on errors,
+    // leaving the old module in place.
+    bool reloadModule(const std::string& name, const std::string& path);
 
     lua_State*             L;
     std::string            m_mainScene;
     std::string            m_initPath;    ///< absolute path to last loaded init.lua
     std::string            m_packageRoot; ///< package root directory
     int                    m_classRef;    ///< LUA_REGISTRY key of MainClass table; LUA_NOREF = none
+    int                    m_hookRefs[HookCount]; ///< LUA_REGISTRY keys of the hook functions; LUA_NOREF = none
+    int                    m_tracebackRef;        ///< LUA_REGISTRY key of the message handler
     std::string            m_lastLuaError; ///< Last Lua error message
     Net::NetworkManager*   m_netMgr = nullptr;      ///< optional network manager for network.* API
     Hotones::Player*       m_localPlayer = nullptr; ///< local player for player.* API
-    // reload request flag handled in the implementation file
+    std::atomic<bool>      m_reloadRequested { false }; ///< set by reloadPack(), acted on in update()
+    double                 m_gcBudgetMs = 1.0;          ///< see setGcBudget()
+    GcStats                m_gcStats;                   ///< see gcStats()
+    std::unique_ptr<LuaAllocator> m_alloc;              ///< L's memory; outlives L
+    uint64_t               m_allocsSeen = 0;            ///< m_alloc->TotalAllocs() at the last stepGc()
+    std::unique_ptr<Assets::FileWatcher> m_watcher;     ///< directory packs only
+    LuaProfiler            m_profiler;                  ///< attached to L
+    uint32_t               m_codeVersion = 0;           ///< see codeVersion()
+    LuaWorkers             m_workers;                   ///< see workers()
+    std::vector<LuaWorkers::Message> m_workerMail;      ///< reused by deliverWorkerMessages()
+    uint64_t               m_randomSeed = 0;            ///< see setRandomSeed()
+    bool                   m_hasRandomSeed = false;
 };
 
 } // namespace Hotones::Scripting
@@ -6,16 +6,19 @@ namespace Hotones::Scripting {
 /// Represents a loadable .cup game package.
 ///
 /// A .cup file is simply a ZIP renamed to .cup. CupPackage accepts either:
-///   – a .cup / .zip archive  → extracted to a temp directory at open()
+///   – a .cup / .zip archive  → mounted in the Assets::Vfs at open(), with the
+///                              archive's own path as the root, and read in place
 ///   – a plain directory      → used as-is (handy during development)
 ///
-/// The temp directory, if created, is automatically removed on close() / destruction.
+/// Files inside an archive pack exist only in the Vfs: read them with
+/// Assets::ReadFile() or raylib's loaders, not fopen/std::ifstream.
+/// The archive is unmounted on close() / destruction.
 class CupPackage {
 public:
     CupPackage();
     ~CupPackage();
 
-    // Non-copyable (owns a temp directory)
+    // Non-copyable (owns a mount)
     CupPackage(const CupPackage&)            = delete;
     CupPackage& operator=(const CupPackage&) = delete;
 
@@ -23,7 +26,7 @@ public:
     /// Returns true on success.
     bool open(const std::string& path);
 
-    /// Close the package and clean up any temp directory.
+    /// Close the package and unmount its archive, if any.
     /// Called automatically by the destructor.
     void close();
 
@@ -33,11 +36,12 @@ public:
     /// Full path to init.lua inside the package root.
     std::string initScript() const;
 
-private:
-    bool extractZip(const std::string& zipPath, const std::string& outDir);
+    /// True when the pack is an archive mounted in the Vfs.
+    bool               isMounted() const { return m_mounted; }
 
-    std::string m_rootPath;        ///< root directory of the package
-    std::string m_tempDir;         ///< non-empty when we created a temp dir
+private:
+    std::string m_rootPath;        ///< root directory of the package (the archive path when mounted)
+    bool        m_mounted = false;
     bool        m_open = false;
 };
 
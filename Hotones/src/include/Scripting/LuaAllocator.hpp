@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Hotones::Scripting {
+
+/// Memory allocator for one Lua state (lua_newstate(LuaAllocator::Alloc, &a)).
+///
+/// Nearly everything a script allocates is small: tables, closures, short
+/// strings, upvalues.  Blocks up to MAX_SMALL bytes come from per-size-class
+/// free lists carved out of CHUNK_BYTES chunks, so a frame that churns
+/// through temporary tables reuses the same memory instead of going to
+/// malloc for each; larger blocks (array parts, long strings) still do.
+/// Lua passes the old size of every block it frees or resizes, so blocks
+/// carry no header.
+///
+/// Chunks are kept until the allocator is destroyed, which must be after
+/// lua_close().  Not thread-safe: a Lua state is used from one thread.
+class LuaAllocator {
+public:
+    static constexpr size_t GRANULE     = 16;         // class spacing; Lua's maximum alignment
+    static constexpr size_t MAX_SMALL   = 256;        // larger blocks go to malloc
+    static constexpr size_t CLASS_COUNT = MAX_SMALL / GRANULE;
+    static constexpr size_t CHUNK_BYTES = 64 * 1024;
+
+    struct ClassStats {
+        uint64_t allocs = 0;   // blocks handed out, ever
+        uint64_t frees  = 0;
+        uint64_t live   = 0;   // handed out and not yet freed
+    };
+    struct Stats {
+        ClassStats classes[CLASS_COUNT];   // classes[i] holds blocks of (i + 1) * GRANULE bytes
+        ClassStats large;                  // blocks over MAX_SMALL
+        uint64_t   largeBytes = 0;         // live bytes of those
+        size_t     chunkBytes = 0;         // reserved for the small classes
+    };
+
+    LuaAllocator() = default;
+    ~LuaAllocator();
+
+    LuaAllocator(const LuaAllocator&)            = delete;
+    LuaAllocator& operator=(const LuaAllocator&) = delete;
+
+    /// lua_Alloc; `ud` is the LuaAllocator
+    static void* Alloc(void* ud, void* ptr, size_t osize, size_t nsize);
+
+    const Stats& GetStats() const { return m_stats; }
+    /// Blocks handed out so far, all classes and large ones together
+    uint64_t TotalAllocs() const;
+
+private:
+    struct FreeBlock { FreeBlock* next; };
+
+    static size_t ClassOf(size_t size) { return (size - 1) / GRANULE; }   // size 1..MAX_SMALL
+
+    void* Allocate(size_t size);
+    void  Free(void* ptr, size_t size);
+    void* Reallocate(void* ptr, size_t osize, size_t nsize);
+    // Put a fresh chunk's worth of blocks on class `c`'s free list
+    bool  Refill(size_t c);
+
+    FreeBlock*         m_free[CLASS_COUNT] = {};
+    std::vector<void*> m_chunks;
+    Stats              m_stats;
+};
+
+} // namespace Hotones::Scripting
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct lua_State;
+
+// ─── LuaBytecode ──────────────────────────────────────────────────────────────
+//
+// Precompiled copies of a pack's scripts.  CompilePackScripts() (run as
+// `habenero --compile-lua <pack dir>` before zipping a pack) stores next to
+// each foo.lua a foo.luac: the chunk as lua_dump() writes it, behind a
+// header naming the Lua release it was compiled by and the hash and size of
+// the source it was compiled from.  CupLoader then loads those instead of
+// parsing and compiling the source on every pack load, reload and match.
+//
+// A .luac counts only while its source is unchanged and this build runs the
+// same Lua release; anything else (an edited script, a pack compiled by an
+// older build, a truncated file) falls back to the source.  The source is
+// still read either way, to hash it.
+//
+// Compiled chunks keep their debug info, so errors still carry line numbers;
+// their chunk name is the script's path inside the pack ("@scripts/ai.lua").
+
+namespace Hotones::Scripting {
+
+/// Where the compiled copy of `sourcePath` goes: foo.lua -> foo.luac
+std::string BytecodePath(const std::string& sourcePath);
+
+/// Push the compiled copy of `path` if there is a current one for `source`
+/// (the script's bytes).  False, with nothing pushed, otherwise.
+bool LoadBytecode(lua_State* L, const std::string& path, const unsigned char* source, size_t size);
+
+/// Compile `sourcePath` under `chunkName` and write BytecodePath(sourcePath)
+/// (a temporary file renamed into place).  False with `error` set if the
+/// script doesn't compile or the file can't be written.
+bool CompileScript(const std::string& sourcePath, const std::string& chunkName, std::string& error);
+
+/// CompileScript() every .lua under the directory pack `root`, logging each
+/// failure.  The number that failed; -1 if `root` isn't a directory.
+int CompilePackScripts(const std::string& root);
+
+} // namespace Hotones::Scripting
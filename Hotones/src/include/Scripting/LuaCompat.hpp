@@ -0,0 +1,85 @@
+#pragma once
+
+#include <lua.hpp>
+
+// ─── LuaCompat ────────────────────────────────────────────────────────────────
+//
+// The scripting layer is written against the Lua 5.4 C API.  It also builds
+// against LuaJIT 2.1: put LuaJIT's headers first on the include path and
+// link it instead of Lua (see meow.yaml).  Its lua.hpp defines
+// LUAJIT_VERSION, which switches on HOTONES_LUAJIT and the shims below for
+// the 5.2+ calls LuaJIT lacks or declares differently.  Include this
+// instead of <lua.hpp> anywhere under Scripting/.
+//
+// What differs for packs under LuaJIT is the language, not the engine API:
+// Lua 5.1 plus LuaJIT's extensions (no integer subtype, // or native
+// bitwise operators; use bit.*), the ffi library, and require() running a
+// module with its name only (no file path argument).
+
+#if defined(LUAJIT_VERSION)
+
+#define HOTONES_LUAJIT 1
+
+#ifndef LUA_OK
+#define LUA_OK 0
+#endif
+
+// package.searchers is package.loaders in 5.1
+#define HOTONES_LUA_SEARCHERS "loaders"
+
+// Each shim is defined before the macro that routes calls to it, so it
+// still calls LuaJIT's own function
+
+inline int hotones_lua_absindex(lua_State* L, int idx)
+{
+    return (idx > 0 || idx <= LUA_REGISTRYINDEX) ? idx : lua_gettop(L) + idx + 1;
+}
+#define lua_absindex hotones_lua_absindex
+
+inline size_t hotones_lua_rawlen(lua_State* L, int idx) { return lua_objlen(L, idx); }
+#define lua_rawlen hotones_lua_rawlen
+
+// 5.3+ return the pushed value's type
+inline int hotones_lua_rawgeti(lua_State* L, int idx, lua_Integer n)
+{
+    lua_rawgeti(L, idx, static_cast<int>(n));
+    return lua_type(L, -1);
+}
+#define lua_rawgeti hotones_lua_rawgeti
+
+inline int hotones_lua_rawgetp(lua_State* L, int idx, const void* p)
+{
+    idx = hotones_lua_absindex(L, idx);
+    lua_pushlightuserdata(L, const_cast<void*>(p));
+    lua_rawget(L, idx);
+    return lua_type(L, -1);
+}
+#define lua_rawgetp hotones_lua_rawgetp
+
+inline void hotones_lua_rawsetp(lua_State* L, int idx, const void* p)
+{
+    idx = hotones_lua_absindex(L, idx);
+    lua_pushlightuserdata(L, const_cast<void*>(p));
+    lua_insert(L, -2);
+    lua_rawset(L, idx);
+}
+#define lua_rawsetp hotones_lua_rawsetp
+
+// 5.4 passes the resuming thread and reports how many values the coroutine
+// yielded or returned; in 5.1 that's the whole of its stack
+inline int hotones_lua_resume(lua_State* L, lua_State* /*from*/, int nargs, int* nresults)
+{
+    const int status = lua_resume(L, nargs);
+    *nresults = lua_gettop(L);
+    return status;
+}
+#define lua_resume hotones_lua_resume
+
+// No `strip` argument; LuaJIT keeps debug info in dumps unless told otherwise
+#define lua_dump(L, writer, data, strip) lua_dump(L, writer, data)
+
+#else
+
+#define HOTONES_LUA_SEARCHERS "searchers"
+
+#endif
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cstdint>
+
 struct lua_State;
 
-namespace Hotones::ECS { class Registry; }
+namespace Hotones::ECS { class Registry; class SpatialIndex; }
 namespace Hotones       { class Player;   }
+namespace Hotones::Scripting { class ScriptSystem; }
 
 namespace Hotones::Scripting::LuaLoader {
 
@@ -19,6 +22,18 @@ void setECSRegistry(ECS::Registry* reg);
 /// engine player controller.  Mirrors the LocalPlayer library's pointer.
 void setECSLocalPlayer(Player* player);
 
+/// Set the ScriptSystem ecs.setScriptThrottle() configures; nullptr when
+/// there is none.
+void setECSScriptSystem(ScriptSystem* scripts);
+
+/// Set the SpatialIndex ecs.queryRadius() / ecs.queryBox() use; without one
+/// they scan every transform.
+void setECSSpatialIndex(ECS::SpatialIndex* spatial);
+
+/// Which Lua state this is, as stored in ScriptComponent::luaState: unique
+/// per state registerECS() ran in, 0 for others.
+uint32_t ecsStateStamp(lua_State* L);
+
 // ── Registration ─────────────────────────────────────────────────────────────
 /// Register the `ecs` global table into the given Lua state.
 ///
@@ -33,9 +48,37 @@ void setECSLocalPlayer(Player* player);
 ///   ecs.setPos(id, x, y, z)
 ///   ecs.getPos(id)                  → x, y, z
 ///   ecs.setScale(id, sx, sy, sz)
-///   ecs.setVelocity(id, vx, vy, vz)
+///   ecs.setVelocity(id, vx, vy, vz)  -- integrated into the position every
+///                                    frame by the engine (MovementSystem)
 ///   ecs.getVelocity(id)             → vx, vy, vz
 ///
+/// Hierarchy  (a child's world transform follows its parent's every frame)
+/// ---------
+///   ecs.setParent(id, parent [, keepWorld=true])  -- nil detaches
+///   ecs.getParent(id)               → id or nil
+///   ecs.setLocalPos(id, x, y, z)    -- offset from the parent; setPos on a
+///   ecs.getLocalPos(id)             → x, y, z      child is overwritten
+///
+/// Bulk queries  (one call for many entities; components by name:
+/// ------------   Transform, Velocity, Tag, Health, Lifetime, Collider,
+///                Emitter, Particles, Network, Player, Parent)
+///   ecs.query(components [, out])   → { id, ... }  -- entities owning them all
+///   ecs.view(components, fn)        → count        -- fn(id) for each of those
+///   ecs.getPositions(ids [, out])   → { x1, y1, z1, x2, ... }
+///   ecs.setPositions(ids, xyz)
+///   ecs.getVelocities(ids [, out])  → { vx1, vy1, vz1, ... }
+///   ecs.setVelocities(ids, xyz)
+///
+/// Proximity queries  (by the scene's spatial index: cost grows with how
+/// -----------------   crowded the area is, not with the entity count)
+///   ecs.queryRadius(x, y, z, radius [, out])          → { id, ... }
+///   ecs.queryBox(minX, minY, minZ, maxX, maxY, maxZ [, out]) → { id, ... }
+///
+/// FFI columns  (LuaJIT builds only, see Scripting/LuaCompat.hpp)
+/// -----------
+///   ffi.cdef(ecs.CDEF)              -- hotones_vec3, hotones_quat, hotones_health, ...
+///   ecs.columns(component [, write]) → n, array, ...  -- a pool's dense arrays
+///
 /// Tag
 /// ---
 ///   ecs.setTag(id, name)
@@ -54,12 +97,35 @@ void setECSLocalPlayer(Player* player);
 ///   ecs.setLifetime(id, seconds)    -- add/replace LifetimeComponent
 ///   ecs.getLifetime(id)             → remaining  (0 if absent)
 ///
+/// Audio emitter  (played from the entity's position by SpatialAudioSystem)
+/// -------------
+///   ecs.setEmitter(id, soundKey [, volume [, maxDist [, loop [, pitch]]]])
+///   ecs.playEmitter(id)
+///   ecs.stopEmitter(id)
+///   ecs.isEmitterPlaying(id)        → bool
+///   ecs.removeEmitter(id)
+///
+/// Particles  (simulated and drawn by GFX::ParticleSystem; not on servers)
+/// ---------
+///   ecs.setParticles(id, texturePath|nil [, options])  -- add/replace ParticleEmitterComponent
+///   ecs.burstParticles(id, count)
+///   ecs.setParticlesEmitting(id, enabled)
+///   ecs.removeParticles(id)
+///
 /// Player controller  (NOT added by default — must be called explicitly)
 /// -----------------
 ///   ecs.addPlayer(id)               -- link entity to the engine Player
 ///   ecs.hasPlayer(id)               → bool
 ///   ecs.removePlayer(id)
 ///   ecs.setPlayerBhop(id, enabled)  -- toggle Source-style bhop
+///
+/// Entity scripts  (run by ScriptSystem: className.update(self, dt) per tick)
+/// --------------
+///   ecs.setScript(id, self, className)  -- className: a global, e.g. "Enemies.Grunt"
+///   ecs.getScript(id)               → self (or nil)
+///   ecs.setScriptActive(id, active)
+///   ecs.removeScript(id)
+///   ecs.setScriptThrottle(distance [, interval])  -- far scripts tick less often
 void registerECS(lua_State* L);
 
 } // namespace Hotones::Scripting::LuaLoader
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <lua.hpp>
+#include <Scripting/LuaCompat.hpp>
 
 namespace Hotones { class Player; }
 
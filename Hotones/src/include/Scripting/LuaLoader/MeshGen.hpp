@@ -2,11 +2,19 @@
 
 struct lua_State;
 
+namespace Hotones::GFX { class PrimitiveBatch; }
+
 namespace Hotones::Scripting::LuaLoader {
 
+/// Set the batch mesh.plane / box / sphere / cylinder add to; the owner
+/// Flush()es it after draw3D().  Pass nullptr to draw them immediately.
+void setMeshBatch(GFX::PrimitiveBatch* batch);
+
 // Register the `mesh` table into the Lua state.
 //
-// All mesh.* calls invoke raylib 3D draw functions DIRECTLY.
+// Solid primitives are batched (see setMeshBatch): cached unit meshes,
+// identical ones drawn together once draw3D() returns.  Lines, wires, the
+// grid and axes invoke raylib 3D draw functions DIRECTLY.
 // They MUST be called from inside your MainClass:draw3D() callback,
 // which the engine calls between BeginMode3D() and EndMode3D().
 // Calling them from draw() (2D phase) has no effect.
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+
+struct lua_State;
+
+namespace Hotones::Scripting::LuaLoader {
+
+// Register the `nav` table: the navigation mesh (Physics/NavMesh.hpp) and
+// path queries answered off the main thread.
+//
+// nav.build([settings])        -> integer  -- build from the registered static meshes; polygon count
+// nav.isReady()                -> boolean  -- a mesh has been built
+// nav.findPath(sx, sy, sz, ex, ey, ez, callback) -> id
+//                                          -- callback(points|nil, partial, id) on a later update
+// nav.cancel(id)               -> boolean  -- drop a pending path's callback
+//
+// The findPath() calls of one update go to the job system as one batch
+// when dispatchPaths() runs, and their callbacks run from deliverPaths()
+// once the batch is done.
+void registerNav(lua_State* L);
+
+// Start the paths asked for since the last call: once per update, after
+// the Update() callback.
+void dispatchPaths(lua_State* L);
+
+// Run the callbacks of the finished batches, in the order they were asked
+// for; batches still running wait for a later update.  False with `error`
+// (message and traceback) set if a callback failed.
+bool deliverPaths(lua_State* L, std::string& error);
+
+} // namespace Hotones::Scripting::LuaLoader
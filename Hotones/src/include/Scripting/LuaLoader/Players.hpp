@@ -8,12 +8,17 @@ namespace Hotones::Scripting::LuaLoader {
 
 // Register the `network` table into the Lua state.
 //
-// network.getPlayers()      -> table[]   -- list of all active remote players
-// network.getPlayer(id)     -> table|nil -- single player by ID, or nil
+// network.getPlayers([out]) -> table[]   -- list of all active remote players
+// network.getPlayer(id [, out]) -> table|nil -- single player by ID, or nil
+// network.players([out])    -> proxy[]   -- getPlayers() as player proxies
+// network.player(id)        -> proxy|nil -- getPlayer() as a player proxy
 // network.getPlayerCount()  -> integer   -- number of active remote players
 // network.getLocalId()      -> integer   -- our own player ID (0 = none)
 // network.getMode()         -> string    -- "server" | "client" | "none"
 // network.isConnected()     -> boolean   -- true when connected as a client
+// network.send(data [, to]) -> boolean   -- reliable ordered message, see
+//                                           CupLoader::fireMessage
+// network.stats()           -> table     -- traffic, round trip and loss
 //
 // Each player table contains:
 //   id    integer   unique player ID (1-254)
@@ -23,10 +28,16 @@ namespace Hotones::Scripting::LuaLoader {
 //   z     number    world position Z
 //   rotX  number    yaw   (horizontal look angle, radians)
 //   rotY  number    pitch (vertical   look angle, radians)
+//
+// Given `out` (last call's result), getPlayers/getPlayer refill it and the
+// player tables in it rather than allocating new ones each frame.  A player
+// proxy is a userdata per player id, made once per state, whose fields read
+// the current snapshot when indexed; it also has `active`.
 void registerPlayers(lua_State* L, Hotones::Net::NetworkManager* nm = nullptr);
 
-// Update the NetworkManager pointer used by this library at runtime.
+// Update the NetworkManager used by this library in state L at runtime.
 // Call whenever the active NetworkManager changes (e.g. after connecting).
-void setPlayersNetworkManager(Hotones::Net::NetworkManager* nm);
+// Each Lua state has its own.
+void setPlayersNetworkManager(lua_State* L, Hotones::Net::NetworkManager* nm);
 
 } // namespace Hotones::Scripting::LuaLoader
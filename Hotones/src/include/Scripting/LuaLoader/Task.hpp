@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+
+struct lua_State;
+
+namespace Hotones::Scripting::LuaLoader {
+
+// Register the `task` table: coroutines resumed by the engine when they're
+// due, so a waiting script costs nothing until then.
+//
+// task.spawn(fn, ...)    -> thread   -- run fn(...) as a task now, until it first waits
+// task.wait([seconds])   -> number   -- (in a task) resume after `seconds`; returns those actually waited
+// task.waitTicks([n])                -- (in a task) resume after n updates (default 1)
+// task.cancel(thread)    -> boolean  -- never resume a waiting task; false if it isn't waiting
+//
+// A bare coroutine.yield() in a task waits one update.  Errors in a task end
+// it and are reported by updateTasks().
+void registerTask(lua_State* L);
+
+// Resume every task that is due: once per update, before the Update()
+// callback.  False with `error` (message and traceback) set if a task
+// failed since the last call.
+bool updateTasks(lua_State* L, std::string& error);
+
+} // namespace Hotones::Scripting::LuaLoader
@@ -0,0 +1,122 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct lua_State;
+struct lua_Debug;
+
+namespace Hotones::Scripting {
+
+/// Sampling profiler for one Lua state, and timers around the CupLoader
+/// callbacks (Update, draw3D, Draw, the event hooks).
+///
+/// While running, a count hook (lua_sethook) fires every `instructions` VM
+/// instructions.  With Trigger::Count each firing is a sample; with
+/// Trigger::Time a firing only samples once `intervalMs` has passed since
+/// the last sample, so samples are spread over time whatever the script
+/// does.  A sample walks the Lua stack and is counted per function (self:
+/// on top of the stack; total: anywhere on it), per source line, and per
+/// whole stack under the callback it happened in.  Only Lua code runs the
+/// hook: time spent inside C functions is not sampled, though the callback
+/// timers include it.
+///
+/// WriteCollapsed() writes the stacks in the "collapsed" format that
+/// flamegraph.pl, speedscope and inferno read.  Start/Stop at any time;
+/// results accumulate across runs until Reset().  Belongs to the thread
+/// running the state.
+class LuaProfiler {
+public:
+    enum class Trigger { Count, Time };
+    struct Options {
+        Trigger trigger      = Trigger::Time;
+        int     instructions = 1000;   // VM instructions between hook calls
+        double  intervalMs   = 1.0;    // Trigger::Time: between samples
+    };
+
+    struct FunctionStats {
+        std::string name;              // "update (scripts/ai.lua:12)"
+        uint64_t    self  = 0;
+        uint64_t    total = 0;
+    };
+    struct LineStats {
+        std::string where;             // "scripts/ai.lua:40"
+        uint64_t    samples = 0;
+    };
+    struct CallbackStats {
+        const char* name    = nullptr;
+        uint64_t    calls   = 0;
+        int64_t     totalNs = 0;
+        int64_t     maxNs   = 0;
+        int64_t     lastNs  = 0;
+    };
+
+    LuaProfiler() = default;
+    LuaProfiler(const LuaProfiler&)            = delete;
+    LuaProfiler& operator=(const LuaProfiler&) = delete;
+
+    /// The state to sample (its owner's, across reloads); Detach() before
+    /// closing it.  Sampling carries over to the new state while running.
+    void Attach(lua_State* L);
+    void Detach();
+
+    /// Start sampling, or restart with new options
+    void Start(const Options& options);
+    void Start() { Start(m_options); }
+    void Stop();
+    bool Running() const { return m_running; }
+    const Options& GetOptions() const { return m_options; }
+    /// Drop everything gathered so far
+    void Reset();
+
+    /// Around each callback; nothing happens while stopped
+    void BeginCallback(const char* name);
+    void EndCallback();
+
+    uint64_t                          Samples()   const { return m_samples; }
+    /// Sorted by self samples, then total
+    std::vector<FunctionStats>        Functions() const;
+    /// Sorted by samples
+    std::vector<LineStats>            Lines()     const;
+    const std::vector<CallbackStats>& Callbacks() const { return m_callbacks; }
+
+    /// One "callback;outer;...;inner <samples>" line per stack; false if
+    /// `path` can't be written
+    bool WriteCollapsed(const std::string& path) const;
+
+    /// Contents of a debug window tab (LuaProfilerPanel.cpp)
+    void DrawPanel();
+
+private:
+    static void Hook(lua_State* L, lua_Debug* ar);
+    void Install();
+    void Uninstall();
+    void Sample(lua_State* L);
+
+    struct Counts { uint64_t self = 0, total = 0; };
+
+    lua_State*  m_L       = nullptr;
+    bool        m_running = false;
+    Options     m_options;
+    int64_t     m_nextSample = 0;
+
+    uint64_t                                  m_samples = 0;
+    std::unordered_map<std::string, Counts>   m_functions;
+    std::unordered_map<std::string, uint64_t> m_lines;
+    std::unordered_map<std::string, uint64_t> m_stacks;
+    std::vector<CallbackStats>                m_callbacks;
+
+    struct Open { size_t callback; int64_t start; };
+    std::vector<Open> m_open;                 // callbacks in progress, innermost last
+
+    // Reused by Sample() so steady-state sampling doesn't allocate
+    std::vector<std::string> m_frames;
+    std::string              m_key;
+
+    // Panel state
+    std::string m_dumpPath = "lua_profile.folded";
+    std::string m_status;
+};
+
+} // namespace Hotones::Scripting
@@ -0,0 +1,95 @@
+#pragma once
+#include <Jobs/JobSystem.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct lua_State;
+
+// ─── LuaWorkers ───────────────────────────────────────────────────────────────
+//
+// A pack's worker scripts: each runs in a Lua state of its own, stepped on
+// the JobSystem's threads, so work such as AI planning or pathfinding uses
+// the other cores instead of the main state's frame.  Declared in init.lua:
+//
+//   Init.Workers = { planner = "scripts/planner.lua" }
+//
+// A worker's state has the standard libraries, require() of the pack's
+// modules, server.* and task.*, and nothing that touches the engine, whose
+// objects belong to the main thread.  It shares nothing with the main
+// state: the two talk only through messages, each value copied as it is
+// sent (nil, booleans, numbers, strings and tables of those; no functions,
+// userdata or cycles), so neither ever sees the other's objects.
+//
+// One step per update: CupLoader::update() first Collect()s the step
+// submitted last time (waiting on it if it is still running) and delivers
+// what the workers sent, then runs the main state's Update(), then
+// Dispatch()es the next step, which runs while the frame goes on.  In a
+// step each worker gets the messages posted to it since its last step, then
+// its update(dt).  A reply therefore arrives one update after the request.
+
+namespace Hotones::Scripting {
+
+class LuaAllocator;
+
+class LuaWorkers {
+public:
+    struct Spec {
+        std::string name;
+        std::string path;   // absolute; a pack file
+    };
+    struct Message {
+        std::string worker;
+        std::string data;   // Encode()d value
+    };
+
+    LuaWorkers();
+    ~LuaWorkers();
+
+    LuaWorkers(const LuaWorkers&)            = delete;
+    LuaWorkers& operator=(const LuaWorkers&) = delete;
+
+    /// Stop the running workers and start one per spec, loading its script
+    /// with `packRoot` for require().  A worker whose script fails to load
+    /// is logged, reported in `error` and left out; the number started.
+    int  Start(const std::string& packRoot, const std::vector<Spec>& specs, std::string& error);
+    /// Wait for the step in flight and close every worker state
+    void Stop();
+    size_t Count() const { return m_workers.size(); }
+    /// The running workers' names, in Init.Workers order
+    std::vector<std::string> Names() const;
+
+    /// Main thread, before the main state's Update(): wait for the step in
+    /// flight, then move what the workers sent into `out`.  False with
+    /// `error` set if a worker's callback raised during the step.
+    bool Collect(std::vector<Message>& out, std::string& error);
+    /// Main thread: queue `data` for worker `name`'s next step.  False if
+    /// there is no such worker.
+    bool Post(const std::string& name, std::string data);
+    /// Main thread, after the main state's Update(): submit every worker's
+    /// next step to the JobSystem
+    void Dispatch();
+
+    /// Register the main state's `workers` table (workers.send, .list);
+    /// `workers` must outlive L
+    static void Register(lua_State* L, LuaWorkers& workers);
+
+    /// Copy the value at `idx` into `out`; false with `error` set if it (or
+    /// anything in it) can't be sent
+    static bool Encode(lua_State* L, int idx, std::string& out, std::string& error);
+    /// Push the value Encode() wrote into `data`
+    static void Decode(lua_State* L, const std::string& data);
+
+    struct Worker;   // defined in LuaWorkers.cpp
+
+private:
+    // One step of `w` on a JobSystem thread
+    static void Step(Worker& w, double dt);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    Jobs::JobCounter m_step;          // the step in flight
+    int64_t          m_lastStep = 0;  // Profile::Now() of the last Dispatch()
+};
+
+} // namespace Hotones::Scripting
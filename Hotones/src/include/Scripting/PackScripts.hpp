@@ -0,0 +1,23 @@
+#pragma once
+#include <string>
+
+struct lua_State;
+
+// ─── PackScripts ──────────────────────────────────────────────────────────────
+//
+// Loading a pack's scripts into a Lua state: the pack's main state
+// (CupLoader) and each of its worker states (LuaWorkers) alike.  Both read
+// through the VFS, so scripts inside a mounted .cup are found, and both take
+// the pack's compiled copy of a script when it is current (LuaBytecode.hpp).
+
+namespace Hotones::Scripting {
+
+/// luaL_loadfile() for a pack file: push the chunk at `path`, or an error
+/// message.  Same chunk name ("@path") and error message on a missing file.
+int LoadPackChunk(lua_State* L, const std::string& path);
+
+/// Make require("a.b") load <root>/a/b.lua or <root>/a/b/init.lua, ahead of
+/// anything on package.path
+void RegisterPackSearcher(lua_State* L, const std::string& root);
+
+} // namespace Hotones::Scripting
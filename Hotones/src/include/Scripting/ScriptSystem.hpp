@@ -0,0 +1,82 @@
+#pragma once
+
+#include <ECS/System.hpp>
+#include <raylib.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct lua_State;
+
+namespace Hotones::Scripting {
+
+class CupLoader;
+
+/// Drives ScriptComponent from C++: each tick, update(self, dt) is called on
+/// every active component's Lua object, with `update` looked up once per
+/// class (ScriptComponent::className, a global such as "Enemies.Grunt") and
+/// kept as a registry ref.  Components without a bound object, or whose
+/// class has no update, cost one check.  Exclusive: it runs Lua.
+///
+/// Far-away entities can tick at a lower rate: past `nearDistance` from the
+/// focus (the local player), an entity with a TransformComponent only
+/// updates every `farInterval` ticks, staggered by entity, and its dt covers
+/// the ticks it skipped.
+///
+/// The system owns the component's luaRef once set (ecs.setScript): when no
+/// component holds a ref any more (removed, replaced, entity destroyed) it
+/// is released on the next Update.  An update() that raises is logged and
+/// its component switched off (active = false).
+class ScriptSystem : public ECS::System {
+public:
+    struct Throttle {
+        float    nearDistance = 0.0f;   // 0: every entity ticks every update
+        uint32_t farInterval  = 4;      // ticks per update beyond it
+    };
+    struct Stats {
+        uint32_t scripts   = 0;   // components with an object
+        uint32_t called    = 0;   // update() calls last tick
+        uint32_t throttled = 0;   // skipped for distance last tick
+    };
+
+    /// `script` must outlive the system
+    explicit ScriptSystem(CupLoader& script) : m_script(script) {}
+
+    void            SetThrottle(const Throttle& throttle) { m_throttle = throttle; }
+    const Throttle& GetThrottle() const                   { return m_throttle; }
+    /// Where throttling measures from; set each tick before Update
+    void            SetFocus(Vector3 focus)               { m_focus = focus; }
+    const Stats&    GetStats() const                      { return m_stats; }
+
+    void Update(ECS::Registry& reg, float dt) override;
+    /// Releases every ref still held, if the state is still open
+    void Shutdown(ECS::Registry& reg) override;
+
+private:
+    struct Call {
+        ECS::EntityId id;
+        int           self;   // ScriptComponent::luaRef at collection time
+        int           fn;
+        float         dt;
+    };
+
+    // The update function's ref for `className`, LUA_REFNIL when it has none
+    int  methodFor(lua_State* L, const std::string& className);
+    void dropMethods(lua_State* L);
+
+    CupLoader& m_script;
+    uint32_t   m_stateStamp  = 0;   // LuaLoader::ecsStateStamp() of the refs below
+    uint32_t   m_codeVersion = 0;
+    uint64_t   m_tick        = 0;
+    Throttle   m_throttle;
+    Vector3    m_focus { 0.0f, 0.0f, 0.0f };
+    Stats      m_stats;
+
+    std::unordered_map<std::string, int> m_methods;   // className -> ref
+    std::vector<int>  m_held;    // object refs seen last Update, sorted
+    std::vector<int>  m_seen;    // this Update's, reused
+    std::vector<Call> m_calls;   // reused
+};
+
+} // namespace Hotones::Scripting
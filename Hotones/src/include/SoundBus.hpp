@@ -1,9 +1,11 @@
 #pragma once
 #include <vector>
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <memory>
 #include <mutex>
+#include <server/SpscRing.hpp>
 
 namespace Ho_tones {
 
@@ -27,45 +29,211 @@ public:
     // Returns true on success.
     bool LoadSoundFile(const std::string& name, const std::string& filePath);
 
-    // Play a previously loaded sound by name. Plays the first loaded variant.
-    bool PlayLoaded(const std::string& name, float gain = 1.0f);
+    // Reload every variant and stream loaded from `filePath` after the file
+    // changed (hot reload).  Returns how many were reloaded.
+    int ReloadFile(const std::string& filePath);
 
-    // Play a random variant from the loaded group for `name`.
-    bool PlayRandom(const std::string& name, float gain = 1.0f);
+    // Stream `filePath` under `name` instead of decoding it whole: for music
+    // and ambience.  A background thread decodes it (ogg/mp3/flac/wav) in
+    // small chunks just ahead of playback, so memory per track stays
+    // constant however long it runs.  `loop` restarts it at the end.
+    // Replaces an earlier stream of that name.  Returns true on success.
+    bool LoadStreamFile(const std::string& name, const std::string& filePath, bool loop = true);
+
+    // Start the stream `name` from its beginning (restarting it if playing)
+    bool PlayStream(const std::string& name, float gain = 1.0f);
+    void StopStream(const std::string& name);
+    bool IsStreamPlaying(const std::string& name);
+
+    // ── Voice pool ───────────────────────────────────────────────────────────
+    //
+    // Loaded sounds and PCM play as voices of a fixed pool of MAX_VOICES,
+    // mixed by MixInto on the audio thread (AudioSystem runs it).  A voice
+    // references its sound's samples, shared with every other voice playing
+    // them; starting one allocates nothing.  When the pool is full, or a
+    // sound already plays its maxInstances (SetSoundLimits), a new voice
+    // takes over the one that matters least: the lowest priority, then the
+    // farthest (`distance` from the listener, any unit), then the oldest;
+    // if the new voice matters even less, it doesn't play.
+    //
+    // The Play* functions, StopVoice, SetVoiceGain, SetVoiceParams and
+    // StopAll only queue a command for the audio thread, which owns the pool
+    // and applies the queue at the start of each MixInto: neither side ever
+    // waits on the other.  Call them from one thread (the game thread).
+
+    static constexpr size_t MAX_VOICES = 64;
+
+    // Priority and instance limit for the sounds loaded under `name` (which
+    // may be loaded later).  Higher priorities win; maxInstances 0 = no
+    // limit but the pool's.
+    void SetSoundLimits(const std::string& name, int priority, int maxInstances);
+
+    // Play a previously loaded sound by name. Plays a random variant.
+    bool PlayLoaded(const std::string& name, float gain = 1.0f, float distance = 0.0f);
+
+    // Play a random variant from the loaded group for `name`.  A variant
+    // still playing from an earlier call restarts.
+    bool PlayRandom(const std::string& name, float gain = 1.0f, float distance = 0.0f);
 
     // Play the next variant in the loaded group for `name` in a round-robin
     // fashion. This ensures each file in the category is played in turn.
-    bool PlaySequential(const std::string& name, float gain = 1.0f);
+    bool PlaySequential(const std::string& name, float gain = 1.0f, float distance = 0.0f);
+
+    // Overlapping version of PlaySequential: each call starts another
+    // voice, so multiple footsteps can overlap. Returns true if playback
+    // started.
+    bool PlaySequentialAsync(const std::string& name, float gain = 1.0f, float distance = 0.0f);
+
+    // Schedule `count` voices of `name`, the variants in round-robin order,
+    // `interval` seconds apart starting now (combos, UI click runs).  Start
+    // times are frames of the mixer's output, so the spacing is exact to
+    // the sample and nothing runs between the events: MixInto starts each
+    // voice at its frame within the block that reaches it.  Scheduled
+    // voices hold their pool slot from now on.  Returns how many were
+    // scheduled.
+    int PlaySequence(const std::string& name, int count, float interval, float gain = 1.0f,
+                     float distance = 0.0f);
 
-    // Async/overlapping version of PlaySequential: will load a fresh copy of
-    // the selected variant and play it immediately so multiple footsteps can
-    // overlap. Returns true if playback started.
-    bool PlaySequentialAsync(const std::string& name, float gain = 1.0f);
     // Play raw PCM interleaved 16-bit signed samples.
     // `data` is interleaved PCM (frames * channels).
     // `sampleRate` is samples per second of the data.
-    // `channels` is number of channels in `data` (1 or 2 typically).
+    // `channels` is number of channels in `data` (1 or 2 typically, 8 at most).
+    // Played at any rate: MixInto resamples it (linearly) to the output's.
+    // Buffers are cached by content: playing the same samples again
+    // shares the first copy (the 32 most recently played are kept).
     // `gain` is a per-voice multiplier (1.0 = unchanged).
-    void PlayPCM(const std::vector<int16_t>& data, int sampleRate, int channels, float gain = 1.0f);
+    // Returns the voice's id for StopVoice / SetVoiceGain; 0 if it lost to
+    // the voices playing or the command queue was full.
+    uint32_t PlayPCM(const std::vector<int16_t>& data, int sampleRate, int channels, float gain = 1.0f,
+                     int priority = 0, float distance = 0.0f);
+    void StopVoice(uint32_t id);
+    void SetVoiceGain(uint32_t id, float gain);
+    // Whether the voice still plays (false once it ended or was stopped or stolen)
+    bool IsVoicePlaying(uint32_t id);
+
+    // How a voice is mixed; for PlaySpatial and SetVoiceParams
+    struct VoiceParams {
+        uint32_t id       = 0;      // SetVoiceParams: the voice to change
+        float    gain     = 1.0f;
+        float    pan      = 0.0f;   // -1 left .. 1 right; ignored on mono output
+        float    rate     = 1.0f;   // playback speed (pitch, doppler), 1/8 .. 8
+        float    distance = 0.0f;   // for voice stealing only
+    };
 
-    // Create a raylib `Wave`/`Sound` from provided interleaved int16 PCM and play it immediately.
-    // This requires raylib audio to be initialized (InitAudioDevice()).
-    // The SoundBus will keep track of the created Sound and will unload it on StopAll()/destructor.
+    // Start a random variant of `name` mixed as `params` says (id ignored);
+    // `loop` repeats it until StopVoice.  Returns the voice's id, 0 if it
+    // didn't start.  For positional sounds (SpatialAudioSystem).
+    uint32_t PlaySpatial(const std::string& name, const VoiceParams& params, bool loop = false);
+
+    // Change many voices' gain, pan, rate and distance at once: they reach
+    // the audio thread together, in one publish of the command queue.
+    // Voices that ended are skipped.  Returns how many were queued.
+    size_t SetVoiceParams(const VoiceParams* params, size_t count);
+
+    // Older name for PlayPCM: plays `data` through the mixer, from memory.
+    // Requires the audio system to be initialized (InitAudioSystem()).
     void PlayPCMViaRaylib(const std::vector<int16_t>& data, int sampleRate, int channels, float gain = 1.0f);
 
     // Mix active voices into `output`. `output` is a float buffer
     // with `frames * outChannels` elements, in interleaved float samples
-    // with range roughly -1.0..1.0.
+    // with range roughly -1.0..1.0.  Called by the audio thread only
+    // (AudioSystem's mixing stream); takes no lock.
     void MixInto(float* output, size_t frames, int outSampleRate, int outChannels);
 
-    // Stop all currently playing voices.
+    // How MixInto keeps up, measured on the audio thread.  A mix's budget is
+    // the playing time of the frames it produced; one that takes longer
+    // counts as an underrun, since the device drains faster than it fills.
+    struct MixStats {
+        uint64_t mixes        = 0;      // MixInto calls
+        uint64_t underruns    = 0;      // of those, the ones over budget
+        float    lastMs       = 0.0f;   // the last mix's duration
+        float    peakMs       = 0.0f;   // the longest since the last reset
+        float    budgetMs     = 0.0f;   // the last mix's budget
+        int      activeVoices = 0;      // voices in the pool during the last mix
+        int      peakVoices   = 0;      // the most in one mix since the last reset
+    };
+    MixStats GetMixStats() const;
+    // Zero the counts and peaks.  Any thread.
+    void ResetMixStats();
+
+    // Stop all currently playing voices and streams.
     void StopAll();
 
+    // Samples shared by the voices playing them (defined in SoundBus.cpp)
+    struct PcmBuffer;
+
 private:
-    struct Voice;
-    std::vector<std::unique_ptr<Voice>> voices;
-    std::mutex voicesMutex;
-    int volume; // 0-100
+    using PcmHandle = std::shared_ptr<const PcmBuffer>;
+
+    struct Voice;   // the audio thread's pool entry
+    // The game thread's view of a pool entry
+    struct Slot {
+        uint32_t  id       = 0;      // 0: free
+        uint64_t  group    = 0;      // the loaded sound it plays; 0 for PlayPCM
+        int       priority = 0;
+        float     distance = 0.0f;
+        uint64_t  started  = 0;      // start order, for "oldest"
+        PcmHandle pcm;               // kept alive while the audio thread may read it
+    };
+    struct VoiceCommand {
+        enum class Type : uint8_t { Play, Stop, SetGain, SetParams, StopAll };
+        Type           type       = Type::Play;
+        bool           loop       = false;     // Play
+        uint32_t       slot       = 0;
+        uint32_t       id         = 0;
+        float          gain       = 1.0f;
+        float          pan        = 0.0f;      // Play, SetParams
+        float          rate       = 1.0f;
+        const int16_t* samples    = nullptr;   // Play: the voice's sound
+        size_t         frames     = 0;
+        int            sampleRate = 0;
+        int            channels   = 0;
+        uint64_t       startFrame = 0;         // Play: output frame it starts on; past: at once
+    };
+    struct FinishedVoice { uint32_t slot, id; };   // ran to its end
+    struct ReleasedPcm {                           // read until command `seq` is applied
+        PcmHandle pcm;
+        uint64_t  seq = 0;
+    };
+    static constexpr size_t VOICE_COMMANDS = 256;   // queued between two mixes, at most
+
+    // Start `pcm` in a pool slot, unless every candidate outranks it.
+    // Returns the voice's id, 0 if it didn't start.  Game thread.
+    uint32_t StartVoice(PcmHandle pcm, uint64_t group, int priority, int maxInstances,
+                        const VoiceParams& params, bool loop = false, uint64_t startFrame = 0);
+    // The slot playing voice `id`; -1 if none
+    int FindSlot(uint32_t id) const;
+    // The slot a new voice goes to, free or stolen; -1 if it loses
+    int PickSlot(uint64_t group, int priority, int maxInstances, float distance) const;
+    // Game thread → audio thread; counts pushed commands
+    bool PushCommand(const VoiceCommand& cmd);
+    // Game thread: free the slots whose voices ended and the samples the
+    // audio thread is done with
+    void CollectFinished();
+    // Audio thread: apply the queued commands
+    void ApplyCommands();
+
+    Hotones::Net::SpscRing<VoiceCommand, VOICE_COMMANDS>  commands;
+    Hotones::Net::SpscRing<FinishedVoice, VOICE_COMMANDS> finished;   // audio thread → game thread
+    std::unique_ptr<Voice[]>    voices;                 // MAX_VOICES; the audio thread's
+    std::unique_ptr<Slot[]>     slots;                  // MAX_VOICES; the game thread's
+    std::vector<ReleasedPcm>    released;               // capacity reserved up front
+    uint64_t                    pushedCommands = 0;
+    std::atomic<uint64_t>       appliedCommands{0};
+    uint64_t                    startCounter = 0;
+    uint32_t                    nextVoiceId = 1;
+    std::atomic<int>            volume;                 // 0-100
+    std::atomic<uint64_t>       mixedFrames{0};         // output frames mixed so far: the timeline
+    std::atomic<int>            mixSampleRate{0};       // the output's, as of the last mix
+
+    // MixStats, written by the audio thread (ResetMixStats zeroes them)
+    std::atomic<uint64_t>       statMixes{0};
+    std::atomic<uint64_t>       statUnderruns{0};
+    std::atomic<uint32_t>       statLastNs{0};
+    std::atomic<uint32_t>       statPeakNs{0};
+    std::atomic<uint32_t>       statBudgetNs{0};
+    std::atomic<int>            statVoices{0};
+    std::atomic<int>            statPeakVoices{0};
 };
 
 } // namespace Ho_tones
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Hotones::Time {
+
+// ---------------------------------------------------------------------------
+// FixedTimestep — simulation clock decoupled from the render rate.
+//
+// Each frame, Advance() adds the frame's wall time to an accumulator and
+// returns how many fixed ticks of TickDt() seconds to run.  Simulation
+// (player movement, ECS systems, phys::Scene) steps once per tick with that
+// constant dt; rendering then blends the last two tick states with Alpha(),
+// the fraction of a tick left over in the accumulator.
+//
+//   auto& clock = Time::FixedTimestep::Get();
+//   const int ticks = clock.Advance(GetFrameTime());
+//   for (int i = 0; i < ticks; ++i) sceneMgr.FixedUpdate(clock.TickDt());
+//   sceneMgr.Update();                          // per frame, reads Alpha()
+//
+// A frame never runs more than MaxTicksPerFrame() ticks.  Time beyond that
+// budget is dropped (DroppedSeconds() counts it), so a hitch slows the game
+// down for a moment instead of spiralling into ever longer catch-up frames.
+//
+// Get() is the engine clock the client main loop drives; other loops (the
+// dedicated server) may own their own instance.
+// ---------------------------------------------------------------------------
+class FixedTimestep {
+public:
+    static constexpr float DEFAULT_TICK_RATE = 60.f;
+    static constexpr int   DEFAULT_MAX_TICKS = 5;
+
+    explicit FixedTimestep(float tickRate = DEFAULT_TICK_RATE, int maxTicksPerFrame = DEFAULT_MAX_TICKS) {
+        SetTickRate(tickRate);
+        SetMaxTicksPerFrame(maxTicksPerFrame);
+    }
+
+    static FixedTimestep& Get() {
+        static FixedTimestep s_engine;
+        return s_engine;
+    }
+
+    // Ticks per second.  Changing it keeps the accumulated time, so the next
+    // Advance() simply runs the new rate.
+    void  SetTickRate(float hz) { m_tickDt = 1.f / std::max(hz, 1.f); }
+    float TickRate() const { return 1.f / m_tickDt; }
+    float TickDt()   const { return m_tickDt; }
+
+    void SetMaxTicksPerFrame(int n) { m_maxTicks = std::max(n, 1); }
+    int  MaxTicksPerFrame() const { return m_maxTicks; }
+
+    // Feed one frame's wall time; returns the number of ticks to run now.
+    int Advance(float frameSeconds) {
+        m_accum += std::max(frameSeconds, 0.f);
+        int ticks = (int)(m_accum / m_tickDt);
+        if (ticks > m_maxTicks) {
+            m_dropped += m_accum - (float)m_maxTicks * m_tickDt;
+            m_accum    = 0.f;
+            ticks      = m_maxTicks;
+        } else {
+            m_accum -= (float)ticks * m_tickDt;
+        }
+        m_tick += (uint64_t)ticks;
+        return ticks;
+    }
+
+    // Fraction [0, 1) of a tick between the last simulated state and now.
+    // Render prev + (cur - prev) * Alpha() for smooth motion.
+    float Alpha() const { return std::clamp(m_accum / m_tickDt, 0.f, 1.f); }
+
+    // Ticks simulated since construction / Reset().
+    uint64_t Tick() const { return m_tick; }
+    float    DroppedSeconds() const { return m_dropped; }
+
+    // Forget accumulated time, e.g. after a scene load so the loading hitch
+    // isn't replayed as catch-up ticks.
+    void Reset() { m_accum = 0.f; m_dropped = 0.f; m_tick = 0; }
+
+private:
+    float    m_tickDt   = 1.f / DEFAULT_TICK_RATE;
+    int      m_maxTicks = DEFAULT_MAX_TICKS;
+    float    m_accum    = 0.f;
+    float    m_dropped  = 0.f;
+    uint64_t m_tick     = 0;
+};
+
+} // namespace Hotones::Time
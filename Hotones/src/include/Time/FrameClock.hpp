@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+namespace Hotones::Time {
+
+// ---------------------------------------------------------------------------
+// FrameClock — the time game code sees, advanced once per frame.
+//
+// The client main loop calls BeginFrame() with each frame's duration; from
+// then on Delta() is that duration and Now() is the sum of them, so every
+// system in a frame agrees on the time, and a session replayed from a
+// recording (Replay/SessionLog.hpp) sees the times it was recorded with,
+// however fast it actually runs.
+//
+//   auto& clock = Time::FrameClock::Get();
+//   clock.BeginFrame(GetFrameTime());            // main loop, once per frame
+//   position += velocity * clock.Delta();        // anywhere in the frame
+//
+// Until the first BeginFrame() Now() follows the steady wall clock and
+// Delta() is 0, so processes without frames (the dedicated server, tools)
+// keep real time.  Now() may be read from any thread; BeginFrame() belongs
+// to the main thread.
+// ---------------------------------------------------------------------------
+class FrameClock {
+public:
+    static FrameClock& Get() {
+        static FrameClock s_engine;
+        return s_engine;
+    }
+
+    void BeginFrame(float seconds) {
+        if (seconds < 0.f) seconds = 0.f;
+        if (!m_driven.load(std::memory_order_relaxed)) {
+            m_now.store(WallSeconds(), std::memory_order_relaxed);
+            m_driven.store(true, std::memory_order_release);
+        }
+        m_delta = seconds;
+        m_now.store(m_now.load(std::memory_order_relaxed) + seconds, std::memory_order_release);
+        ++m_frame;
+    }
+
+    // Make Now() `now` and count on from there: a replayed session resumes
+    // the clock its recording started from
+    void SetNow(double now) {
+        m_now.store(now, std::memory_order_release);
+        m_driven.store(true, std::memory_order_release);
+    }
+
+    // Duration of the current frame, seconds
+    float Delta() const { return m_delta; }
+    // Seconds on a monotonic clock with an arbitrary origin
+    double Now() const {
+        return m_driven.load(std::memory_order_acquire) ? m_now.load(std::memory_order_acquire)
+                                                        : WallSeconds();
+    }
+    // BeginFrame() calls so far
+    unsigned long long Frame() const { return m_frame; }
+
+private:
+    static double WallSeconds() {
+        using namespace std::chrono;
+        return duration<double>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    std::atomic<bool>   m_driven{ false };
+    std::atomic<double> m_now{ 0.0 };
+    float               m_delta = 0.f;
+    unsigned long long  m_frame = 0;
+};
+
+} // namespace Hotones::Time
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace Hotones::Net {
+
+// ---------------------------------------------------------------------------
+// BitWriter / BitReader — LSB-first bit packing over a caller-owned buffer.
+//
+// Neither side throws or allocates: writing past the capacity, or reading
+// past the end, sets Overflowed() and the rest of the stream is ignored
+// (reads return 0).  Check it once after the whole packet is done.
+//
+// WriteVarInt() zigzags a signed value and stores it in the smallest of 4,
+// 8, 16 or 32 bits behind a 2-bit size class, so small deltas cost 6 bits.
+// ---------------------------------------------------------------------------
+class BitWriter {
+public:
+    BitWriter(uint8_t* data, size_t capacityBytes)
+        : m_data(data), m_capacityBits(capacityBytes * 8) {}
+
+    // Append the low `bits` bits of value (bits in 0..32).
+    void Write(uint32_t value, int bits) {
+        if (m_overflow || m_bit + (size_t)bits > m_capacityBits) { m_overflow = true; return; }
+        while (bits > 0) {
+            const size_t byte = m_bit >> 3;
+            const int    off  = (int)(m_bit & 7);
+            const int    n    = std::min(8 - off, bits);
+            if (off == 0) m_data[byte] = 0;
+            m_data[byte] |= (uint8_t)((value & ((1u << n) - 1)) << off);
+            value >>= n;
+            bits  -= n;
+            m_bit += (size_t)n;
+        }
+    }
+
+    void WriteBool(bool b) { Write(b ? 1u : 0u, 1); }
+
+    void WriteVarInt(int32_t v) {
+        const uint32_t zz = ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+        const int cls = zz < (1u << 4) ? 0 : zz < (1u << 8) ? 1 : zz < (1u << 16) ? 2 : 3;
+        Write((uint32_t)cls, 2);
+        Write(zz, VARINT_BITS[cls]);
+    }
+
+    [[nodiscard]] size_t Bytes()      const { return (m_bit + 7) >> 3; }
+    [[nodiscard]] size_t BitsLeft()   const { return m_capacityBits - m_bit; }
+    [[nodiscard]] bool   Overflowed() const { return m_overflow; }
+
+    static constexpr int VARINT_BITS[4] = { 4, 8, 16, 32 };
+
+private:
+    uint8_t* m_data;
+    size_t   m_capacityBits;
+    size_t   m_bit      = 0;
+    bool     m_overflow = false;
+};
+
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t sizeBytes)
+        : m_data(data), m_sizeBits(sizeBytes * 8) {}
+
+    uint32_t Read(int bits) {
+        if (m_overflow || m_bit + (size_t)bits > m_sizeBits) { m_overflow = true; return 0; }
+        uint32_t value = 0;
+        int      shift = 0;
+        while (bits > 0) {
+            const size_t byte = m_bit >> 3;
+            const int    off  = (int)(m_bit & 7);
+            const int    n    = std::min(8 - off, bits);
+            value |= (uint32_t)((m_data[byte] >> off) & ((1u << n) - 1)) << shift;
+            shift += n;
+            bits  -= n;
+            m_bit += (size_t)n;
+        }
+        return value;
+    }
+
+    bool ReadBool() { return Read(1) != 0; }
+
+    int32_t ReadVarInt() {
+        const uint32_t zz = Read(BitWriter::VARINT_BITS[Read(2)]);
+        return (int32_t)(zz >> 1) ^ -(int32_t)(zz & 1);
+    }
+
+    [[nodiscard]] bool Overflowed() const { return m_overflow; }
+
+private:
+    const uint8_t* m_data;
+    size_t         m_sizeBits;
+    size_t         m_bit      = 0;
+    bool           m_overflow = false;
+};
+
+} // namespace Hotones::Net
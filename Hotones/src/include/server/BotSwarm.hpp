@@ -0,0 +1,71 @@
+#pragma once
+
+#include <server/LinkConditioner.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Hotones::Net {
+
+class NetworkManager;
+
+struct BotOptions {
+    int            count      = 0;       // 0 = no bots
+    int            sendHz     = 20;      // pose updates per bot per second
+    float          areaRadius = 200.f;   // bots roam a disc this wide around the origin
+    uint32_t       seed       = 1;       // paths; same seed, same paths
+    LinkConditions link;                 // applied to every bot's receiving
+};
+
+// ---------------------------------------------------------------------------
+// BotSwarm — simulated players for load-testing a server.
+//
+// Each bot is an ordinary client NetworkManager, so the server sees exactly
+// the traffic real players produce.  The server tells clients apart by
+// source address, so every bot has its own socket (and receive thread,
+// asleep in poll() until a datagram arrives); one swarm thread drives them
+// all: connects them a few at a time, walks each around its own circle and
+// reports its pose sendHz times a second.
+//
+// Report() sums the bots' GetStats() as of the last second.
+// ---------------------------------------------------------------------------
+class BotSwarm {
+public:
+    struct Report {
+        int      connected  = 0;
+        int      total      = 0;
+        float    packetsInPerSec  = 0.f, packetsOutPerSec = 0.f;
+        float    bytesInPerSec    = 0.f, bytesOutPerSec   = 0.f;
+        float    rttMs      = 0.f;       // mean over connected bots
+    };
+
+    BotSwarm();
+    ~BotSwarm();
+
+    bool Start(const std::string& host, uint16_t port, const BotOptions& options);
+    void Stop();
+
+    [[nodiscard]] Report GetReport() const;
+
+private:
+    struct Bot;
+
+    void Run();
+
+    BotOptions        m_options;
+    std::string       m_host;
+    uint16_t          m_port = 0;
+    std::vector<Bot>  m_bots;
+    std::atomic<bool> m_running { false };
+    std::thread       m_thread;
+
+    mutable std::mutex m_reportMutex;
+    Report             m_report;
+};
+
+} // namespace Hotones::Net
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <server/BitStream.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Hotones::Net {
+
+// ---------------------------------------------------------------------------
+// Replicated entity states (PacketType::ENTITY_STATE).
+//
+// An entity's state is an opaque run of up to ENTITY_MAX_STATE bytes, laid
+// out by whoever owns the entities (ECS/Replication.hpp).  Like a player
+// pose (Snapshot.hpp) it is sent as a delta against the newest state the
+// receiver has acknowledged, or whole (a keyframe) when there is none.
+// States are compared in 32-bit words: an unchanged word costs one bit, a
+// changed one its XOR with the baseline, so an entity that only moved
+// sends its position words and nothing else.
+//
+// The history lives with the entity rather than with each receiver:
+// EntityHistory keeps the last HISTORY versions of one entity's state for
+// every client, and a client stream only records the newest version that
+// client acknowledged.  Versions count changes, 32-bit on the server and
+// 8-bit on the wire.
+// ---------------------------------------------------------------------------
+
+static constexpr size_t ENTITY_MAX_STATE = 128;
+
+struct EntityState {
+    std::array<uint8_t, ENTITY_MAX_STATE> bytes{};   // zero past len
+    uint8_t len = 0;
+
+    bool operator==(const EntityState& o) const {
+        return len == o.len && std::memcmp(bytes.data(), o.bytes.data(), len) == 0;
+    }
+};
+
+namespace Detail {
+    inline uint32_t StateWord(const EntityState& s, size_t i) {
+        uint32_t w;
+        std::memcpy(&w, s.bytes.data() + i * 4, 4);
+        return w;
+    }
+
+    // len:8, then per word changed:1 [xor:32]
+    inline void WriteEntityWords(BitWriter& w, const EntityState& s, const EntityState& base) {
+        w.Write(s.len, 8);
+        for (size_t i = 0; i < (s.len + 3u) / 4u; ++i) {
+            const uint32_t x = StateWord(s, i) ^ StateWord(base, i);
+            w.WriteBool(x != 0);
+            if (x != 0) w.Write(x, 32);
+        }
+    }
+    inline EntityState ReadEntityWords(BitReader& r, const EntityState& base) {
+        EntityState s;
+        s.len = static_cast<uint8_t>(std::min<uint32_t>(r.Read(8), ENTITY_MAX_STATE));
+        for (size_t i = 0; i < (s.len + 3u) / 4u; ++i) {
+            uint32_t word = StateWord(base, i);
+            if (r.ReadBool()) word ^= r.Read(32);
+            std::memcpy(s.bytes.data() + i * 4, &word, 4);
+        }
+        // The baseline may have been longer
+        std::memset(s.bytes.data() + s.len, 0, ENTITY_MAX_STATE - s.len);
+        return s;
+    }
+} // namespace Detail
+
+static_assert(ENTITY_MAX_STATE % 4 == 0 && ENTITY_MAX_STATE < 256);
+
+// Wire layout of one state: version:8, keyframe:1, [version - base:4], then
+// the words as above.
+static constexpr int ENTITY_STATE_MAX_BITS =
+    8 + 1 + 4 + 8 + static_cast<int>(ENTITY_MAX_STATE / 4) * (1 + 32);
+
+class EntityHistory {
+public:
+    static constexpr uint8_t HISTORY = 16;
+
+    // Make `len` bytes the entity's state; false (and no new version) if
+    // that is already its state or it is too long.
+    bool Set(const uint8_t* data, size_t len) {
+        if (len > ENTITY_MAX_STATE) return false;
+        EntityState s;
+        std::memcpy(s.bytes.data(), data, len);
+        s.len = static_cast<uint8_t>(len);
+        if (m_version != 0 && s == Current()) return false;
+        ++m_version;
+        m_history[m_version % HISTORY]  = s;
+        m_versions[m_version % HISTORY] = m_version;
+        return true;
+    }
+
+    // 0 until the first Set()
+    [[nodiscard]] uint32_t           Version() const { return m_version; }
+    [[nodiscard]] const EntityState& Current() const { return m_history[m_version % HISTORY]; }
+
+    // Write the current state for a receiver that holds version `acked`
+    // (0 = none, or too old: a keyframe).
+    void Encode(BitWriter& w, uint32_t acked) const {
+        const bool key = IsKeyframe(acked);
+        w.Write(m_version & 0xFFu, 8);
+        w.WriteBool(key);
+        if (!key) w.Write(m_version - acked, 4);
+        Detail::WriteEntityWords(w, Current(), Baseline(acked));
+    }
+
+    // Exactly what Encode(w, acked) would write, in bits.
+    [[nodiscard]] int EncodedBits(uint32_t acked) const {
+        const EntityState& s    = Current();
+        const EntityState& base = Baseline(acked);
+        int bits = 8 + 1 + (IsKeyframe(acked) ? 0 : 4) + 8;
+        for (size_t i = 0; i < (s.len + 3u) / 4u; ++i)
+            bits += Detail::StateWord(s, i) != Detail::StateWord(base, i) ? 33 : 1;
+        return bits;
+    }
+
+    // The version an 8-bit ack names, or 0 if it is not one still held.
+    [[nodiscard]] uint32_t Resolve(uint8_t seq) const {
+        const uint32_t v = m_version - static_cast<uint8_t>(m_version - seq);
+        return v != 0 && m_version - v < HISTORY && m_versions[v % HISTORY] == v ? v : 0;
+    }
+
+private:
+    bool IsKeyframe(uint32_t acked) const {
+        return acked == 0 || m_version - acked >= HISTORY || m_versions[acked % HISTORY] != acked;
+    }
+    const EntityState& Baseline(uint32_t acked) const {
+        static const EntityState ZERO{};
+        return IsKeyframe(acked) ? ZERO : m_history[acked % HISTORY];
+    }
+
+    std::array<EntityState, HISTORY> m_history{};
+    std::array<uint32_t, HISTORY>    m_versions{};
+    uint32_t m_version = 0;
+};
+
+// One entity's states on the receiving end.
+class EntityReceiver {
+public:
+    static constexpr uint8_t HISTORY = EntityHistory::HISTORY;
+
+    // Read one state.  False if its baseline is gone, it is not newer than
+    // the latest, or the stream is truncated; the bits are consumed either way
+    // so the next state in the packet still lines up.
+    bool Decode(BitReader& r) {
+        const uint8_t seq  = static_cast<uint8_t>(r.Read(8));
+        const bool    key  = r.ReadBool();
+        const uint8_t back = key ? 0 : static_cast<uint8_t>(r.Read(4));
+        const uint8_t base = static_cast<uint8_t>(seq - back);
+        const bool haveBase = key || (back != 0 && m_valid[base % HISTORY] && m_seqs[base % HISTORY] == base);
+        const EntityState s = Detail::ReadEntityWords(r, haveBase && !key ? m_history[base % HISTORY] : EntityState{});
+        if (!haveBase || r.Overflowed()) return false;
+        // A repeat or a reordered state still earns an ack, the first one
+        // may have been lost.  Anything further back is taken as newer: the
+        // 8-bit version wrapped while this client heard nothing.
+        if (m_hasLatest && static_cast<uint8_t>(m_latest - seq) < HISTORY) {
+            m_ackPending = true;
+            return false;
+        }
+
+        m_history[seq % HISTORY] = s;
+        m_seqs[seq % HISTORY]    = seq;
+        m_valid[seq % HISTORY]   = true;
+        m_latest     = seq;
+        m_hasLatest  = true;
+        m_ackPending = true;
+        return true;
+    }
+
+    [[nodiscard]] bool               HasLatest() const { return m_hasLatest; }
+    [[nodiscard]] const EntityState& Latest()    const { return m_history[m_latest % HISTORY]; }
+
+    // Version to acknowledge, once per state received.
+    bool TakeAck(uint8_t& seq) {
+        if (!m_ackPending || !m_hasLatest) return false;
+        m_ackPending = false;
+        seq = m_latest;
+        return true;
+    }
+
+private:
+    std::array<EntityState, HISTORY> m_history{};
+    std::array<uint8_t, HISTORY>     m_seqs{};
+    std::array<bool, HISTORY>        m_valid{};
+    uint8_t m_latest     = 0;
+    bool    m_hasLatest  = false;
+    bool    m_ackPending = false;
+};
+
+} // namespace Hotones::Net
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <server/BitStream.hpp>
+#include <server/Snapshot.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace Hotones::Net {
+
+// ---------------------------------------------------------------------------
+// Input commands and authoritative corrections (server-side movement).
+//
+// With server movement on (ConnectAckPacket.serverMovement), a client sends
+// the inputs of every fixed tick instead of its position.  The server runs
+// the same movement step on them and answers with the body it ended up
+// with, tagged with the last command applied.  The client has meanwhile
+// moved on by predicting those commands itself; on a correction it resets
+// to the server's body and replays the commands still in flight.
+//
+// Commands are numbered by a 16-bit tick sequence.  Each INPUT_CMD repeats
+// the newest unacknowledged commands (up to INPUT_REDUNDANCY), so a lost
+// datagram is covered by the next one.
+// ---------------------------------------------------------------------------
+
+static constexpr int INPUT_REDUNDANCY = 8;
+
+// Longest tick the server will simulate for one command, microseconds;
+// stops a client from covering ground by claiming long ticks.
+static constexpr uint16_t INPUT_MAX_DT_US = 50000;
+
+struct InputCommand {
+    uint16_t seq    = 0;
+    int8_t   side    = 0;      // -1, 0, 1
+    int8_t   forward = 0;      // -1, 0, 1
+    bool     jump    = false;
+    bool     crouch  = false;
+    uint16_t yaw     = 0;      // 65536 = one turn, as in QuantizedState
+    uint16_t pitch   = 0;
+    uint16_t dtUs    = 0;      // tick length, microseconds
+
+    // Both ends simulate from these, not the unquantized originals
+    [[nodiscard]] float Dt()    const { return (float)dtUs * 1e-6f; }
+    [[nodiscard]] float Yaw()   const { return TurnToRadians(yaw); }
+    [[nodiscard]] float Pitch() const { return TurnToRadians(pitch); }
+};
+
+inline InputCommand MakeInputCommand(uint16_t seq, int side, int forward, bool jump, bool crouch,
+                                     float yawRadians, float pitchRadians, float dt) {
+    const QuantizedState q = Quantize(0.f, 0.f, 0.f, yawRadians, pitchRadians, 1.f);
+    InputCommand c;
+    c.seq     = seq;
+    c.side    = (int8_t)(side > 0 ? 1 : side < 0 ? -1 : 0);
+    c.forward = (int8_t)(forward > 0 ? 1 : forward < 0 ? -1 : 0);
+    c.jump    = jump;
+    c.crouch  = crouch;
+    c.yaw     = q.yaw;
+    c.pitch   = q.pitch;
+    c.dtUs    = (uint16_t)std::lround(std::fmin(dt * 1e6f, 65535.f));
+    return c;
+}
+
+// True when seq is `latest` again or shortly before it: a repeat or a
+// reordered datagram.  Anything further back is a restarted stream (a new
+// Player after a scene change) and is taken as new.
+static constexpr uint16_t INPUT_STALE_WINDOW = 256;
+inline bool SeqStale(uint16_t seq, uint16_t latest) {
+    return (uint16_t)(latest - seq) < INPUT_STALE_WINDOW;
+}
+
+// Wire layout of one command: side:2, forward:2, jump:1, crouch:1,
+// yaw:16, pitch:16, dtUs:16.  Its seq is implied by its place in the packet.
+inline void WriteInputCommand(BitWriter& w, const InputCommand& c) {
+    w.Write((uint32_t)(c.side + 1), 2);
+    w.Write((uint32_t)(c.forward + 1), 2);
+    w.WriteBool(c.jump);
+    w.WriteBool(c.crouch);
+    w.Write(c.yaw, 16);
+    w.Write(c.pitch, 16);
+    w.Write(c.dtUs, 16);
+}
+
+inline InputCommand ReadInputCommand(BitReader& r, uint16_t seq) {
+    InputCommand c;
+    c.seq     = seq;
+    c.side    = (int8_t)std::min((int)r.Read(2) - 1, 1);   // 3 is not a valid axis
+    c.forward = (int8_t)std::min((int)r.Read(2) - 1, 1);
+    c.jump    = r.ReadBool();
+    c.crouch  = r.ReadBool();
+    c.yaw     = (uint16_t)r.Read(16);
+    c.pitch   = (uint16_t)r.Read(16);
+    c.dtUs    = (uint16_t)r.Read(16);
+    return c;
+}
+
+static constexpr int INPUT_COMMAND_BITS = 2 + 2 + 1 + 1 + 16 + 16 + 16;
+
+// The server's body for a player after command `seq`.  Mirrors the
+// movement state of Player::Body.
+struct BodyCorrection {
+    uint16_t seq = 0;
+    float    position[3] = {};
+    float    velocity[3] = {};
+    float    dir[2]      = {};   // x, z of the smoothed move direction
+    bool     grounded    = false;
+};
+
+} // namespace Hotones::Net
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Hotones::Net {
+
+// ---------------------------------------------------------------------------
+// InterestGrid — uniform XZ grid of players for area-of-interest queries.
+//
+// Cells are one interest radius wide, so everything within the radius of a
+// point lies in its own cell or one of the eight around it; a query touches
+// those nine cells instead of every player.  Height is ignored for the
+// bucketing (callers still measure true distance).
+//
+// Rebuilt every snapshot tick: Clear(), then Insert() each player.  Cell
+// vectors keep their capacity across rebuilds; cells left empty for a
+// whole tick are dropped so a wandering crowd doesn't grow the map forever.
+// ---------------------------------------------------------------------------
+class InterestGrid {
+public:
+    // Empty the grid for a rebuild with cells `cellSize` metres wide.
+    void Clear(float cellSize) {
+        if (cellSize != m_cellSize) {
+            m_cellSize = cellSize;
+            m_cells.clear();
+        }
+        std::erase_if(m_cells, [](const auto& kv) { return kv.second.empty(); });
+        for (auto& [key, cell] : m_cells) cell.clear();
+    }
+
+    void Insert(uint16_t index, float x, float z) {
+        m_cells[Key(Cell(x), Cell(z))].push_back(index);
+    }
+
+    // fn(index) for every entry in the 3×3 cells around (x, z)
+    template <typename Fn>
+    void ForEachNear(float x, float z, Fn&& fn) const {
+        const int32_t cx = Cell(x), cz = Cell(z);
+        for (int32_t dz = -1; dz <= 1; ++dz)
+            for (int32_t dx = -1; dx <= 1; ++dx) {
+                auto it = m_cells.find(Key(cx + dx, cz + dz));
+                if (it == m_cells.end()) continue;
+                for (uint16_t index : it->second) fn(index);
+            }
+    }
+
+private:
+    int32_t Cell(float v) const { return (int32_t)std::floor(v / m_cellSize); }
+
+    static uint64_t Key(int32_t cx, int32_t cz) {
+        return ((uint64_t)(uint32_t)cx << 32) | (uint32_t)cz;
+    }
+
+    float                                             m_cellSize = 1.f;
+    std::unordered_map<uint64_t, std::vector<uint16_t>> m_cells;
+};
+
+} // namespace Hotones::Net
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace Hotones::Net {
+
+// Simulated network conditions for received datagrams (all 0 = off).
+struct LinkConditions {
+    int      latencyMs        = 0;     // added to every datagram
+    int      jitterMs         = 0;     // plus 0..jitterMs more, at random
+    float    lossPercent      = 0.f;   // dropped outright
+    float    duplicatePercent = 0.f;   // delivered twice, each copy delayed on its own
+    uint32_t seed             = 1;     // same seed and traffic, same outcome
+
+    [[nodiscard]] bool Active() const {
+        return latencyMs > 0 || jitterMs > 0 || lossPercent > 0.f || duplicatePercent > 0.f;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// LinkConditioner — holds received datagrams back to fake a bad network.
+//
+// Accept() decides each datagram's fate: dropped, or held until now +
+// latency + a random share of the jitter (twice, independently, for a
+// duplicate).  Jitter larger than the gap between datagrams reorders them,
+// as a real path would.  Release() hands over whatever is due, in release
+// order; MsUntilNext() says when to call it again.
+//
+// Used only by NetworkManager's receive thread, so it is not thread-safe.
+// At most MAX_HELD datagrams wait at once; more are dropped like loss.
+// ---------------------------------------------------------------------------
+template <typename Packet>
+class LinkConditioner {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t MAX_HELD = 4096;
+
+    void Configure(const LinkConditions& c) {
+        m_conditions = c;
+        m_rng.seed(c.seed);
+        m_held.clear();
+    }
+
+    [[nodiscard]] bool Active() const { return m_conditions.Active(); }
+
+    // Take a datagram received at `now`.
+    void Accept(const Packet& p, Clock::time_point now) {
+        if (Roll() < m_conditions.lossPercent) return;
+        Hold(p, now);
+        if (Roll() < m_conditions.duplicatePercent) Hold(p, now);
+    }
+
+    // deliver(packet, releaseTime) for every datagram due by `now`.
+    template <typename Fn>
+    void Release(Clock::time_point now, Fn&& deliver) {
+        while (!m_held.empty() && m_held.front().due <= now) {
+            std::pop_heap(m_held.begin(), m_held.end(), Later);
+            deliver(m_held.back().packet, m_held.back().due);
+            m_held.pop_back();
+        }
+    }
+
+    // Milliseconds until the next release, -1 when nothing is held.
+    [[nodiscard]] int MsUntilNext(Clock::time_point now) const {
+        if (m_held.empty()) return -1;
+        const auto wait = std::chrono::ceil<std::chrono::milliseconds>(m_held.front().due - now);
+        return static_cast<int>(std::max<std::chrono::milliseconds::rep>(0, wait.count()));
+    }
+
+    void Clear() { m_held.clear(); }
+
+private:
+    struct Held {
+        Clock::time_point due;
+        uint64_t          order;   // FIFO among equal release times
+        Packet            packet;
+    };
+
+    // Min-heap on (due, order)
+    static bool Later(const Held& a, const Held& b) {
+        return a.due != b.due ? a.due > b.due : a.order > b.order;
+    }
+
+    float Roll() { return std::uniform_real_distribution<float>(0.f, 100.f)(m_rng); }
+
+    void Hold(const Packet& p, Clock::time_point now) {
+        if (m_held.size() >= MAX_HELD) return;
+        int delay = m_conditions.latencyMs;
+        if (m_conditions.jitterMs > 0)
+            delay += std::uniform_int_distribution<int>(0, m_conditions.jitterMs)(m_rng);
+        m_held.push_back({ now + std::chrono::milliseconds(delay), m_order++, p });
+        std::push_heap(m_held.begin(), m_held.end(), Later);
+    }
+
+    LinkConditions    m_conditions;
+    std::mt19937      m_rng;
+    std::vector<Held> m_held;
+    uint64_t          m_order = 0;
+};
+
+} // namespace Hotones::Net
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Hotones::Net {
+
+static constexpr uint16_t DEFAULT_STATSD_PORT = 8125;
+
+struct MetricsOptions {
+    std::string host;                          // statsd collector; empty = no metrics
+    uint16_t    port   = DEFAULT_STATSD_PORT;
+    std::string prefix;                        // before every name; empty = "habenero.<port>"
+};
+
+// ---------------------------------------------------------------------------
+// MetricsExporter — pushes gauges to a statsd collector over UDP.
+//
+// The dedicated server samples its tick times, players, traffic, Lua and
+// physics counters once a second and sends them here, so a fleet can be
+// watched and alerted on from one place (Graphite, Datadog, Telegraf, or
+// anything else that speaks statsd).  Gauge() appends "<prefix>.<name>:
+// <value>|g" to a datagram that goes out when it is full and at Flush().
+// Sending never blocks and never fails loudly: a collector that is down
+// or missing just loses the samples.
+//
+// One thread per exporter; the match server gives each worker its own.
+// ---------------------------------------------------------------------------
+class MetricsExporter {
+public:
+    MetricsExporter();
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&)            = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // Resolve the collector and open the socket.  Blocks on DNS.
+    bool Open(const MetricsOptions& options);
+    [[nodiscard]] bool IsOpen() const;
+
+    void Gauge(const std::string& name, double value);
+    void Flush();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace Hotones::Net
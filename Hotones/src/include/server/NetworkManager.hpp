@@ -2,46 +2,93 @@
 // NOTE: No platform socket headers here — they live exclusively in
 // NetworkManager.cpp to avoid Windows.h / raylib symbol clashes.
 
+#include <server/EntitySnapshot.hpp>
+#include <server/InputCommand.hpp>
+#include <server/LinkConditioner.hpp>
 #include <server/Packets.hpp>
+#include <server/ReliableChannel.hpp>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <span>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 namespace Hotones::Net {
 
 static constexpr uint16_t DEFAULT_PORT = 27015;
-static constexpr uint8_t  MAX_PLAYERS  = 16;
+static constexpr uint16_t DEFAULT_MASTER_PORT = 27010;
+// Server capacity unless StartServer() is given one; at most
+// PlayerIdAllocator::MAX_CAPACITY (1023).
+static constexpr uint16_t DEFAULT_MAX_PLAYERS = 16;
 
-// ─── Snapshot of a remote player (updated each received PlayerUpdatePacket) ──
+// ─── A server for the browser to query ───────────────────────────────────────
+struct ServerEndpoint {
+    std::string host;
+    uint16_t    port = DEFAULT_PORT;
+};
+
+// ─── A remote player as drawn this frame (interpolated from received states) ─
 struct RemotePlayer {
-    uint8_t id     = 0;
+    PlayerId id    = 0;
     char    name[16] = {};
     float   posX = 0.f, posY = 0.f, posZ = 0.f;
     float   rotX = 0.f, rotY = 0.f; // yaw, pitch
     bool    active = false;
 };
 
+// ─── Traffic statistics (NetworkManager::GetStats) ───────────────────────────
+// Byte counts are UDP payloads.  Rates cover the last full second.
+struct ConnectionStats {
+    PlayerId id = 0;              // the client; 0 = the server, seen from a client
+    uint64_t packetsIn  = 0, packetsOut = 0;
+    uint64_t bytesIn    = 0, bytesOut   = 0;
+    float    packetsInPerSec = 0.f, packetsOutPerSec = 0.f;
+    float    bytesInPerSec   = 0.f, bytesOutPerSec   = 0.f;
+    // Smoothed PING → PONG round trip, including the time the peer takes
+    // to get to the PING in its frame; 0 until the first PONG
+    float    rttMs       = 0.f;
+    float    lossPercent = 0.f;   // smoothed share of PINGs never answered
+    size_t   reliablePending = 0; // messages queued or sent but not yet acked
+    // Server: bytes/s it currently allows itself to this client (summed in
+    // the total); 0 on a client or without a budget
+    float    sendRate    = 0.f;
+};
+
+struct NetStats {
+    ConnectionStats total;        // every datagram; rtt/loss averaged over connections
+    size_t   recvQueuePeak = 0;   // most datagrams waiting for one Update() in the last second
+    uint64_t recvOverflows = 0;   // dropped because the receive ring was full
+    uint64_t sendOverflows = 0;   // dropped because the send thread fell too far behind
+    std::vector<ConnectionStats> connections;   // the server alone on a client
+};
+
 // ─── NetworkManager ───────────────────────────────────────────────────────────
 //
 //  Handles both server and client roles over UDP.
 //
 //  Threading model:
 //   – RecvLoop() runs on a background thread and pushes raw datagrams into
-//     m_recvQueue (mutex-protected).
+//     a fixed-size lock-free SPSC ring (server/SpscRing.hpp).  It sleeps in
+//     poll() until data arrives, a timer is due (connect retries and client
+//     keepalive PINGs, server/TimerWheel.hpp) or Stop/Disconnect wakes it.
 //   – Update() is called once per game frame (main thread) and drains the
-//     queue, dispatching packets and invoking callbacks safely.
+//     ring, dispatching packets and invoking callbacks safely.
+//   – Packets are built (delta-encoded against each peer's acks) on the
+//     main thread into an outbound queue; Update(), SendPlayerUpdate() and
+//     SendInput() hand the queue to a send thread, which makes the sendmmsg
+//     / sendto calls.  A stalled socket or a large fan-out never adds to the
+//     frame.
 //
 class NetworkManager {
 public:
-    enum class Mode { None, Server, Client };
+    enum class Mode { None, Server, Client, Master };
 
     NetworkManager();
     ~NetworkManager();
 
     // ── Server API ────────────────────────────────────────────────────────────
-    bool StartServer(uint16_t port = DEFAULT_PORT);
+    bool StartServer(uint16_t port = DEFAULT_PORT, uint16_t maxPlayers = DEFAULT_MAX_PLAYERS);
     void StopServer();
     bool IsServerRunning() const;
 
@@ -51,32 +98,175 @@ public:
     void Disconnect();
     bool IsConnected() const;
 
-    // Send local player position/rotation to the server (~20 Hz recommended)
+    // Send local player position/rotation to the server (~20 Hz recommended).
+    // Goes out as a quantized, delta-encoded PLAYER_STATE; an unchanged pose
+    // the receiver already acknowledged sends nothing.
     void SendPlayerUpdate(float px, float py, float pz, float rotX, float rotY);
 
+    // Server: how often Update() sends each client its aggregated snapshot
+    // of the other players (default 20 Hz).
+    void SetSnapshotRate(int hz);
+
+    // Server: clients only hear about players within this many metres of
+    // themselves, and about distant ones less often (default 150; 0 sends
+    // everyone to everyone).  A player leaving the radius disappears from
+    // that client's GetRemotePlayers() without an OnPlayerLeft.
+    void SetInterestRadius(float metres);
+
+    // Server: each client's send rate is estimated between these, in
+    // bytes/s (default 16 KB/s – 1 MB/s), from the round trip and loss of
+    // its PINGs; snapshots carry only what fits, the most overdue states
+    // first.  A max of 0 sends everything every tick.  Applies to clients
+    // that join from now on.
+    void SetSendBudget(uint32_t minBytesPerSec, uint32_t maxBytesPerSec);
+
+    // Server: position quantum for PLAYER_STATE, in metres (default 1/64).
+    // Clients adopt it from CONNECT_ACK; set it before StartServer().
+    void SetPositionGrid(float metres);
+
+    // ── Server movement (server/InputCommand.hpp) ─────────────────────────────
+    // Server: move the clients that join from now on from their inputs
+    // rather than taking the positions they report.  Inputs arrive through
+    // OnPlayerInput; answer each with SetPlayerBody().  Needs the level's
+    // collision to simulate against (see ServerMovement).
+    void SetServerMovement(bool enabled);
+    std::function<void(PlayerId id, const InputCommand& cmd)> OnPlayerInput;
+    // Server: where simulating `id` put it after command body.seq.  Becomes
+    // the player's replicated pose and is sent back as a correction.
+    void SetPlayerBody(PlayerId id, const BodyCorrection& body, float rotX, float rotY);
+
+    // Client: true when the server moves us; send every tick's input with
+    // SendInput() and reconcile with TakeCorrection().  SendPlayerUpdate()
+    // then only reports a position until the first correction.
+    bool IsServerMovement() const;
+    void SendInput(const InputCommand& cmd);
+    // The newest correction not yet taken, if any.
+    bool TakeCorrection(BodyCorrection& out);
+
+    // ── Reliable messages (server/ReliableChannel.hpp) ────────────────────────
+    // Up to RELIABLE_MAX_MESSAGE bytes, delivered once each and in the order
+    // sent.  Messages queued in one frame leave together from Update(); lost
+    // ones are resent on their own.  Client: `to` is ignored, messages go to
+    // the server.  Server: to client `to`, or every client when `to` is 0.
+    // False if not connected, no such client, or the message is empty, too
+    // big or the peer's backlog is full.
+    bool SendReliable(PlayerId to, const void* data, size_t len);
+    // Invoked from Update(); `from` is the sending client, or 0 (the server)
+    // on a client.
+    std::function<void(PlayerId from, const uint8_t* data, size_t len)> OnReliableMessage;
+
+    // ── Replicated entities (server/EntitySnapshot.hpp) ───────────────────────
+    // Server: entities every client mirrors.  A state is up to
+    // ENTITY_MAX_STATE opaque bytes (ECS/Replication.hpp lays them out for
+    // ECS entities).  Each snapshot tick sends every client the states it
+    // has not acknowledged, delta-compressed against the ones it has, and
+    // the despawns it has not acknowledged.  There is no area of interest:
+    // every client hears about every entity.
+    //
+    // A new entity's id; 0 if not a server or every id is taken.  Clients
+    // hear of it with its first state.
+    NetEntityId CreateNetEntity();
+    // False if there is no such entity or the state is too long.  Setting
+    // the state it already has sends nothing.
+    bool SetNetEntityState(NetEntityId id, const void* data, size_t len);
+    void DestroyNetEntity(NetEntityId id);
+
+    // Client, invoked from Update(): an entity's first state, each later
+    // one, and its despawn.  Disconnecting despawns them all.
+    std::function<void(NetEntityId id, const uint8_t* state, size_t len)> OnEntitySpawned;
+    std::function<void(NetEntityId id, const uint8_t* state, size_t len)> OnEntityUpdated;
+    std::function<void(NetEntityId id)>                                    OnEntityDespawned;
+
     // ── Shared API ────────────────────────────────────────────────────────────
-    void    Update();  // Must be called once per game frame from the main thread
-    Mode    GetMode()    const;
-    uint8_t GetLocalId() const;
-    const std::unordered_map<uint8_t, RemotePlayer>& GetRemotePlayers() const;
+    void     Update();  // Must be called once per game frame from the main thread
+    Mode     GetMode()    const;
+    PlayerId GetLocalId() const;
+    // Every known remote player, packed densely (order changes as players
+    // leave); FindRemotePlayer() looks one up by id, nullptr if absent.
+    // Poses are interpolated by Update(), see SetRenderDelay().
+    std::span<const RemotePlayer> GetRemotePlayers() const;
+    const RemotePlayer*           FindRemotePlayer(PlayerId id) const;
+    // Datagrams dropped because the receive ring was full (Update() not
+    // keeping up); should stay 0.
+    uint64_t GetRecvOverflowCount() const;
+    // Packet and byte counters, rates, round trip and loss, overall and
+    // per connection.  Round trips come from PINGs each side sends the
+    // other once a second.
+    NetStats GetStats() const;
+    // Remote players are drawn this far behind the newest received state
+    // (default 100 ms, two server snapshots), interpolating between states
+    // and briefly extrapolating past a late one.  A longer delay rides out
+    // more jitter and loss; 0 shows each state as it arrives.
+    void SetRenderDelay(int ms);
+    int  GetRenderDelay() const;
+
+    // Testing: delay, jitter, drop and duplicate received datagrams as a
+    // bad network would (server/LinkConditioner.hpp).  Only this end's
+    // receiving is affected; condition both ends to shape both directions.
+    // Takes effect at the next StartServer() / Connect().
+    void SetLinkConditions(const LinkConditions& conditions);
 
     // Callbacks – invoked from Update() on the main thread
-    std::function<void(uint8_t id, const char* name)> OnPlayerJoined;
-    std::function<void(uint8_t id)>                    OnPlayerLeft;
+    std::function<void(PlayerId id, const char* name)> OnPlayerJoined;
+    std::function<void(PlayerId id)>                    OnPlayerLeft;
+
+    // ── Session replay (Replay/SessionLog.hpp) ────────────────────────────────
+    // Invoked from Update() with each received datagram just before it is
+    // handled; the sender's `ip` and `port` are in host byte order.
+    std::function<void(uint32_t ip, uint16_t port, const uint8_t* data, size_t len)> OnDatagram;
+
+    // Act as a Server or Client without a socket or receive thread: what it
+    // sends goes nowhere, and datagrams only arrive through InjectDatagram().
+    // Leave it with StopServer() / Disconnect() as usual.
+    bool StartReplay(Mode mode, uint16_t maxPlayers = DEFAULT_MAX_PLAYERS);
+    // Replay: hand the next Update() a datagram from ip:port as though it
+    // had been received.  False outside StartReplay() or if the ring is full.
+    bool InjectDatagram(uint32_t ip, uint16_t port, const uint8_t* data, size_t len);
 
     // ── Server-browser ping API ───────────────────────────────────────────────
-    // Send a fire-and-forget SERVER_INFO_REQ to host:port from a temporary socket.
-    // Result (if server responds within ~600 ms) is delivered via OnServerInfo on
-    // the next Update() call.  Safe to call in Mode::None (before any connection).
+    // Send a SERVER_INFO_REQ to every server in the list.  One background
+    // thread sends them all from a single socket and gathers the replies as
+    // they come; each reply is delivered via OnServerInfo on the next
+    // Update() call, and a server silent for timeoutMs is given up on.  May be
+    // called again while earlier queries are out.  Safe to call in Mode::None
+    // (before any connection).
+    void PingServers(std::span<const ServerEndpoint> servers, int timeoutMs = 600);
+
+    // PingServers() for a single server.
     void PingServer(const std::string& host, uint16_t port);
 
     // Set the pack name this server will advertise in SERVER_INFO_RESP replies.
     // Call after loading a pack in server mode.  Empty string = no pack.
     void SetHostedPakName(const char* name);
 
+    // Server info replies are built on the main thread when something they
+    // report changes (start, join, leave, pack name) and sent by the receive
+    // thread, so queries never reach Update().
+
+    // ── Master server list ────────────────────────────────────────────────────
+    // Server: announce this server to the master list at host:port every
+    // MASTER_HEARTBEAT_MS while it runs, and withdraw it on StopServer().
+    // Set before StartServer(); an empty host (the default) announces nowhere.
+    void SetMasterServer(const std::string& host, uint16_t port = DEFAULT_MASTER_PORT);
+
+    // Run as a master list on `port` (Mode::Master): keep the servers that
+    // send heartbeats, forget those silent for MASTER_EXPIRY_MS, and send the
+    // list to whoever asks.  Drive with Update(); stop with StopServer().
+    bool StartMaster(uint16_t port = DEFAULT_MASTER_PORT);
+
+    // Browser: ask the master at host:port for its list.  Every server on it
+    // is delivered through OnServerInfo, as the master last heard from it,
+    // without probing the servers themselves.  Runs on the PingServers()
+    // thread.
+    void QueryMasterServer(const std::string& host, uint16_t port = DEFAULT_MASTER_PORT,
+                           int timeoutMs = 1000);
+
+    static constexpr int MASTER_HEARTBEAT_MS = 10000;
+    static constexpr int MASTER_EXPIRY_MS    = 3 * MASTER_HEARTBEAT_MS + 5000;
+
     // Callback invoked from Update() when a PingServer() reply arrives.
     std::function<void(const std::string& host, uint16_t port,
-                       uint8_t playerCount, uint8_t maxPlayers,
+                       uint16_t playerCount, uint16_t maxPlayers,
                        const char* pakName, const char* gameVersion,
                        const char* pakVersion)> OnServerInfo;
 
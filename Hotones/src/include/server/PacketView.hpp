@@ -0,0 +1,92 @@
+#pragma once
+
+#include <server/BitStream.hpp>
+#include <server/Packets.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace Hotones::Net {
+
+// ---------------------------------------------------------------------------
+// PacketView — a received datagram, read where it lies.
+//
+// Parse() checks a datagram once against the least its type can be on the
+// wire (MinPacketSize): fixed-layout packets must be whole, bit-stream ones
+// (PLAYER_STATE, INPUT_CMD, RELIABLE, ENTITY_STATE) need only their header
+// since BitReader bounds-checks the rest as it goes, and a MASTER_LIST_RESP
+// needs its page header (its entries are checked against its count).
+// Unknown types are refused.  Handlers then read the packet as a const
+// reference into the receive buffer (As<P>()) or a BitReader over its
+// payload (Bits()); nothing is copied.  Packet structs are packed, so any
+// offset is aligned for them.
+//
+// A view does not own its bytes: it is good for as long as the buffer is,
+// which for NetworkManager means until its ring slot is popped.
+// ---------------------------------------------------------------------------
+
+// Smallest valid datagram of `type`, 0 for a type that is not one.
+constexpr size_t MinPacketSize(PacketType type) {
+    switch (type) {
+    case PacketType::CONNECT:           return sizeof(ConnectPacket);
+    case PacketType::CONNECT_ACK:       return sizeof(ConnectAckPacket);
+    case PacketType::DISCONNECT:        return sizeof(DisconnectPacket);
+    case PacketType::PLAYER_UPDATE:     return sizeof(PlayerUpdatePacket);
+    case PacketType::PLAYER_STATE:
+    case PacketType::INPUT_CMD:
+    case PacketType::RELIABLE:
+    case PacketType::ENTITY_STATE:      return sizeof(PacketHeader);
+    case PacketType::PLAYER_CORRECTION: return sizeof(CorrectionPacket);
+    case PacketType::PING:
+    case PacketType::PONG:              return sizeof(PingPacket);
+    case PacketType::SERVER_INFO_REQ:   return sizeof(ServerInfoReqPacket);
+    case PacketType::SERVER_INFO_RESP:  return sizeof(ServerInfoRespPacket);
+    case PacketType::MASTER_HEARTBEAT:  return sizeof(MasterHeartbeatPacket);
+    case PacketType::MASTER_LIST_REQ:   return sizeof(MasterListReqPacket);
+    case PacketType::MASTER_LIST_RESP:  return offsetof(MasterListRespPacket, entries);
+    }
+    return 0;
+}
+
+class PacketView {
+public:
+    PacketView() = default;
+
+    // False, leaving `out` alone, for a datagram too short for its type or
+    // of no known type.
+    static bool Parse(const uint8_t* data, size_t len, PacketView& out) {
+        if (len < sizeof(PacketHeader)) return false;
+        const size_t need = MinPacketSize(reinterpret_cast<const PacketHeader*>(data)->type);
+        if (need == 0 || len < need) return false;
+        out.m_data = data;
+        out.m_len  = len;
+        return true;
+    }
+
+    [[nodiscard]] const PacketHeader& Header() const { return *reinterpret_cast<const PacketHeader*>(m_data); }
+    [[nodiscard]] PacketType          Type()   const { return Header().type; }
+    [[nodiscard]] PlayerId            Sender() const { return Header().playerId; }
+
+    // The whole packet as P; P must fit in what was received, which Parse()
+    // guarantees for the fixed-layout struct of Type().
+    template<typename P>
+    [[nodiscard]] const P& As() const {
+        assert(sizeof(P) <= m_len && "PacketView::As — packet shorter than the struct");
+        return *reinterpret_cast<const P*>(m_data);
+    }
+
+    // The bit stream after the header.
+    [[nodiscard]] BitReader Bits() const {
+        return BitReader(m_data + sizeof(PacketHeader), m_len - sizeof(PacketHeader));
+    }
+
+    [[nodiscard]] const uint8_t* Data() const { return m_data; }
+    [[nodiscard]] size_t         Size() const { return m_len; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t         m_len  = 0;
+};
+
+} // namespace Hotones::Net
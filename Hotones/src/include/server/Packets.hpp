@@ -6,17 +6,34 @@ namespace Hotones::Net {
 // Current game version string — update when releasing incompatible builds.
 static constexpr char GAME_VERSION[] = "alpha v0.1";
 
+// Player handle carried in every header: slot index plus a reuse
+// generation (see server/PlayerIds.hpp).  0 = unassigned / server.
+using PlayerId = uint16_t;
+
+// Replicated entity handle, assigned by the server (see
+// server/EntitySnapshot.hpp).  0 = none.
+using NetEntityId = uint16_t;
+
 // ─── Packet type IDs ─────────────────────────────────────────────────────────
 enum class PacketType : uint8_t {
     CONNECT       = 0x01, // Client → Server: request to join
     CONNECT_ACK   = 0x02, // Server → Client: assign ID & accept
     DISCONNECT    = 0x03, // Either direction: graceful leave
     PLAYER_UPDATE = 0x10, // Client → Server own state; Server → All clients
+    PLAYER_STATE  = 0x11, // Compressed, delta-encoded states + acks (server/Snapshot.hpp)
+    INPUT_CMD     = 0x12, // Client → Server: movement inputs (server/InputCommand.hpp)
+    PLAYER_CORRECTION = 0x13, // Server → Client: authoritative body after an input
+    RELIABLE      = 0x14, // Either direction: ordered messages + acks (server/ReliableChannel.hpp)
+    ENTITY_STATE  = 0x15, // Server → Client entity states; Client → Server their acks
     PING          = 0x20,
     PONG          = 0x21,
     // ── Server-info query (no connection needed) ──────────────────────────
     SERVER_INFO_REQ  = 0x30, // Anyone → Server: request server info
     SERVER_INFO_RESP = 0x31, // Server → requester: server info response
+    // ── Master server list ────────────────────────────────────────────────
+    MASTER_HEARTBEAT = 0x32, // Server → Master: still up, with its info
+    MASTER_LIST_REQ  = 0x33, // Anyone → Master: request the server list
+    MASTER_LIST_RESP = 0x34, // Master → requester: one page of the list
 };
 
 // ─── Packet structures (no padding) ──────────────────────────────────────────
@@ -24,7 +41,7 @@ enum class PacketType : uint8_t {
 
 struct PacketHeader {
     PacketType type;
-    uint8_t    playerId; // sender's ID (0 = unassigned / server)
+    PlayerId   playerId; // sender's ID (0 = unassigned / server)
 };
 
 // Client → Server: join request
@@ -35,8 +52,10 @@ struct ConnectPacket {
 
 // Server → Client: join accepted
 struct ConnectAckPacket {
-    PacketHeader header;     // type = CONNECT_ACK, playerId = assigned ID
-    uint8_t      assignedId; // mirrors header.playerId for clarity
+    PacketHeader header;       // type = CONNECT_ACK, playerId = assigned ID
+    PlayerId     assignedId;   // mirrors header.playerId for clarity
+    float        positionGrid; // PLAYER_STATE position quantum, metres
+    uint8_t      serverMovement; // 1 = send INPUT_CMD, the server moves you
 };
 
 // Either direction: graceful leave
@@ -51,6 +70,53 @@ struct PlayerUpdatePacket {
     float        rotX, rotY; // yaw, pitch
 };
 
+// Compressed snapshot: the header, then a bit stream (server/BitStream.hpp)
+//   ackCount:8   × { subject:16, seq:8 }    states of `subject` now held
+//   stateCount:8 × { subject:16, state }    see Snapshot.hpp for `state`
+//   goneCount:8  × { subject:16 }           left the receiver's area of interest
+// Clients send their own state; the server sends one per client per flush
+// carrying the other players near it, split over several packets when it
+// does not fit one.
+struct PlayerStatePacket {
+    PacketHeader header;       // type = PLAYER_STATE, playerId = sender's ID
+    uint8_t      bits[480];    // only the used bytes go on the wire
+};
+
+// Client → Server: the newest unacknowledged input commands, a bit stream
+//   firstSeq:16, count:4, count × command    see InputCommand.hpp
+struct InputPacket {
+    PacketHeader header;       // type = INPUT_CMD, playerId = sender's ID
+    uint8_t      bits[60];     // only the used bytes go on the wire
+};
+
+// Server → Client: where the server's simulation put you
+struct CorrectionPacket {
+    PacketHeader header;       // type = PLAYER_CORRECTION, playerId = 0
+    uint16_t     seq;          // last input command applied
+    float        position[3];
+    float        velocity[3];
+    float        dir[2];       // smoothed move direction, x and z
+    uint8_t      grounded;
+};
+
+// Either direction: reliable messages and acks, a bit stream laid out in
+// ReliableChannel.hpp
+struct ReliablePacket {
+    PacketHeader header;       // type = RELIABLE, playerId = sender's ID
+    uint8_t      bits[480];    // only the used bytes go on the wire
+};
+
+// Replicated entities: the header, then a bit stream
+//   Server → Client:  goneCount:8  × { entity:16 }           despawned
+//                     stateCount:8 × { entity:16, state }    see EntitySnapshot.hpp
+//   Client → Server:  ackCount:8   × { entity:16, version:8 }
+//                     goneCount:8  × { entity:16 }           despawns received
+// Despawns come first, so a packet never despawns what it also updates.
+struct EntityStatePacket {
+    PacketHeader header;       // type = ENTITY_STATE, playerId = sender's ID
+    uint8_t      bits[480];    // only the used bytes go on the wire
+};
+
 struct PingPacket {
     PacketHeader header;
     uint32_t     seq;
@@ -66,8 +132,8 @@ struct ServerInfoReqPacket {
 // Server → requester: advertise current state
 struct ServerInfoRespPacket {
     PacketHeader header;        // type = SERVER_INFO_RESP, playerId = 0
-    uint8_t      playerCount;   // active connected players
-    uint8_t      maxPlayers;    // maximum allowed
+    uint16_t     playerCount;   // active connected players
+    uint16_t     maxPlayers;    // maximum allowed
     uint16_t     port;          // bound port (mirrors what was queried)
     char         pakName[32];   // pack display name, empty = no pack loaded
     char         serverName[32];// optional server display name
@@ -75,6 +141,45 @@ struct ServerInfoRespPacket {
     char         pakVersion[16];  // optional pack version/hash
 };
 
+// ── Master server list ───────────────────────────────────────────────────────
+
+// Server → Master: the ServerInfoRespPacket layout with type =
+// MASTER_HEARTBEAT, sent from the game socket so the master learns the
+// address players should use.  maxPlayers = 0 withdraws the server.
+using MasterHeartbeatPacket = ServerInfoRespPacket;
+
+// Master → requester: one page of the list.
+struct MasterListEntry {
+    uint32_t     ipv4;          // network byte order, as the master saw it
+    uint16_t     port;          // game port
+    uint16_t     playerCount;
+    uint16_t     maxPlayers;
+    char         pakName[32];
+    char         serverName[32];
+    char         gameVersion[16];
+    char         pakVersion[16];
+};
+
+// Entries per page; a page fits the 512-byte receive buffer
+static constexpr int MASTER_LIST_PAGE = 4;
+
+struct MasterListRespPacket {
+    PacketHeader    header;     // type = MASTER_LIST_RESP, playerId = 0
+    uint8_t         page;       // 0 .. pageCount - 1
+    uint8_t         pageCount;  // 0 = the list is empty
+    uint8_t         count;      // entries in this page
+    MasterListEntry entries[MASTER_LIST_PAGE]; // only `count` go on the wire
+};
+
+// Anyone → Master: ask for one page.  Padded to a full page's size, so a
+// reply is never bigger than the request it answers (a forged sender
+// address gets nothing out of the master it didn't put in).
+struct MasterListReqPacket {
+    PacketHeader header;        // type = MASTER_LIST_REQ, playerId = 0
+    uint8_t      page;          // wanted, 0 .. pageCount - 1
+    uint8_t      padding[sizeof(MasterListRespPacket) - sizeof(PacketHeader) - 1];
+};
+
 #pragma pack(pop)
 
 } // namespace Hotones::Net
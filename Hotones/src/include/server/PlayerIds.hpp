@@ -0,0 +1,63 @@
+#pragma once
+
+#include <server/Packets.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace Hotones::Net {
+
+// ---------------------------------------------------------------------------
+// PlayerIdAllocator — hands out PlayerIds for server slots.
+//
+// A PlayerId's low INDEX_BITS select the slot (index 0 is the host, so a
+// client id is never 0); the high bits are a generation bumped every time
+// the slot is freed.  A packet or script still holding a departed player's
+// id therefore never matches whoever takes the slot next.  Freed slots are
+// reused oldest-first, which keeps a generation from wrapping quickly.
+// ---------------------------------------------------------------------------
+class PlayerIdAllocator {
+public:
+    static constexpr int      INDEX_BITS   = 10;
+    static constexpr uint16_t INDEX_MASK   = (1u << INDEX_BITS) - 1;
+    static constexpr uint16_t GEN_MASK     = (1u << (16 - INDEX_BITS)) - 1;
+    static constexpr uint16_t MAX_CAPACITY = INDEX_MASK;   // client slots 1..1023
+
+    [[nodiscard]] static uint16_t Index(PlayerId id) { return id & INDEX_MASK; }
+
+    // Forget every id and make slots 1..capacity free.
+    void Reset(uint16_t capacity) {
+        if (capacity > MAX_CAPACITY) capacity = MAX_CAPACITY;
+        m_generation.assign(capacity + 1u, 0);
+        m_free.clear();
+        for (uint16_t i = 1; i <= capacity; ++i) m_free.push_back(i);
+    }
+
+    // False when every slot is taken.
+    bool Allocate(PlayerId& out) {
+        if (m_free.empty()) return false;
+        const uint16_t index = m_free.front();
+        m_free.pop_front();
+        out = static_cast<PlayerId>((m_generation[index] << INDEX_BITS) | index);
+        return true;
+    }
+
+    void Release(PlayerId id) {
+        const uint16_t index = Index(id);
+        if (index == 0 || index >= m_generation.size()) return;
+        m_generation[index] = (m_generation[index] + 1) & GEN_MASK;
+        m_free.push_back(index);
+    }
+
+    [[nodiscard]] uint16_t Capacity() const {
+        return m_generation.empty() ? 0 : static_cast<uint16_t>(m_generation.size() - 1);
+    }
+    [[nodiscard]] uint16_t InUse() const { return static_cast<uint16_t>(Capacity() - m_free.size()); }
+
+private:
+    std::vector<uint16_t> m_generation;   // by slot index
+    std::deque<uint16_t>  m_free;
+};
+
+} // namespace Hotones::Net
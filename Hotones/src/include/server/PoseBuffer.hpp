@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace Hotones::Net {
+
+// ---------------------------------------------------------------------------
+// PoseBuffer — timestamped recent poses of one remote player, for drawing
+// it smoothly between (and shortly past) the snapshots that arrive.
+//
+// Poses are pushed with their arrival time and sampled at a render time
+// held a fixed delay behind the clock, so there is normally a pose on each
+// side of it to interpolate between.  When the render time runs past the
+// newest pose the last velocity carries it on for up to `maxExtrapolate`
+// seconds, then eases back: a stopped player (who, with delta-encoded
+// states, simply stops being sent) overshoots a little instead of freezing
+// short of where it stopped.
+//
+// Arrival times carry network jitter, and interpolating on them makes the
+// speed wobble.  Each pose is instead stamped where the running average
+// spacing says it should have arrived, pulled a tenth of the way towards
+// where it did; the stamps then follow the sender's steady rate and still
+// track the real clock.
+//
+// A pose arriving after a silence longer than the render delay would
+// otherwise be blended in from the stale one over the whole silence, which
+// shows up as a jump; the stale pose is re-stamped `holdGap` before the new
+// one so the move plays out over one render delay instead.
+// ---------------------------------------------------------------------------
+struct Pose {
+    float posX = 0.f, posY = 0.f, posZ = 0.f;
+    float rotX = 0.f, rotY = 0.f;   // yaw, pitch (radians)
+};
+
+class PoseBuffer {
+public:
+    static constexpr size_t CAPACITY = 16;
+
+    // A pose that arrived at time t (seconds).
+    void Push(double t, const Pose& p, double holdGap) {
+        double stamp = t;
+        if (m_count > 0) {
+            const Entry& last = At(m_count - 1);
+            const double gap  = t - m_lastArrival;
+            if (gap <= 0.0) {   // same frame: keep the latest
+                At(m_count - 1).pose = p;
+                return;
+            }
+            if (gap > holdGap) {
+                Append({ t - holdGap, last.pose });
+                m_spacing = 0.0;
+            } else {
+                m_spacing = m_spacing > 0.0 ? m_spacing + (gap - m_spacing) * 0.1 : gap;
+                const double expected = last.t + m_spacing;
+                stamp = std::fmax(expected + (t - expected) * 0.1, last.t + m_spacing * 0.5);
+            }
+        }
+        m_lastArrival = t;
+        Append({ stamp, p });
+    }
+
+    // Pose at `renderTime`; false while empty.
+    bool Sample(double renderTime, double maxExtrapolate, Pose& out) const {
+        if (m_count == 0) return false;
+        const Entry& oldest = At(0);
+        if (renderTime <= oldest.t || m_count == 1) {
+            out = (renderTime <= oldest.t ? oldest : At(m_count - 1)).pose;
+            return true;
+        }
+        for (size_t i = m_count - 1; i > 0; --i) {
+            const Entry& a = At(i - 1);
+            const Entry& b = At(i);
+            if (renderTime >= a.t && renderTime < b.t) {
+                out = Blend(a.pose, b.pose, (float)((renderTime - a.t) / (b.t - a.t)));
+                return true;
+            }
+        }
+        // Past the newest: extrapolate, then ease back
+        const Entry& a = At(m_count - 2);
+        const Entry& b = At(m_count - 1);
+        const double over  = renderTime - b.t;
+        const double ahead = over <= maxExtrapolate ? over : std::fmax(0.0, 2.0 * maxExtrapolate - over);
+        out = Blend(a.pose, b.pose, (float)(1.0 + ahead / (b.t - a.t)));
+        return true;
+    }
+
+    void Clear() { *this = PoseBuffer{}; }
+
+private:
+    struct Entry {
+        double t = 0.0;
+        Pose   pose;
+    };
+
+    const Entry& At(size_t i) const { return m_samples[(m_head + i) % CAPACITY]; }
+    Entry&       At(size_t i)       { return m_samples[(m_head + i) % CAPACITY]; }
+
+    void Append(const Entry& s) {
+        if (m_count == CAPACITY) {
+            m_head = (m_head + 1) % CAPACITY;
+            --m_count;
+        }
+        At(m_count++) = s;
+    }
+
+    // Linear blend; f > 1 extrapolates.  Angles take the short way round.
+    static Pose Blend(const Pose& a, const Pose& b, float f) {
+        constexpr float TAU = 6.28318530718f;
+        auto lerp  = [f](float x, float y) { return x + (y - x) * f; };
+        auto angle = [f](float x, float y) { return x + std::remainder(y - x, TAU) * f; };
+        return { lerp(a.posX, b.posX), lerp(a.posY, b.posY), lerp(a.posZ, b.posZ),
+                 angle(a.rotX, b.rotX), angle(a.rotY, b.rotY) };
+    }
+
+    std::array<Entry, CAPACITY> m_samples{};
+    size_t                      m_head  = 0;
+    size_t                      m_count = 0;
+    double                      m_lastArrival = 0.0;
+    double                      m_spacing     = 0.0;   // smoothed arrival interval
+};
+
+} // namespace Hotones::Net
@@ -0,0 +1,298 @@
+#pragma once
+
+#include <server/BitStream.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace Hotones::Net {
+
+// ---------------------------------------------------------------------------
+// ReliableChannel — messages delivered exactly once and in order over UDP
+// (PacketType::RELIABLE).  One per peer on each end.
+//
+// Every RELIABLE datagram carries a 16-bit packet sequence number and acks
+// for what came the other way: the newest sequence received plus a 32-bit
+// field for the 32 before it.  One lost ack costs nothing, the next datagram
+// repeats it.  Acking a packet acks every message in it.
+//
+// Messages still unacked are sent again on their own (selective resend):
+// at once when their packet is reported lost, i.e. a packet sent LOSS_GAP
+// or more after it is acked and it is not, otherwise once they have been
+// out about one and a half round trips.  All due messages
+// share one datagram, so a burst of events costs one packet, not one each.
+// Message ids are 16-bit; the receiver holds early arrivals until the gap
+// before them fills and hands messages over in send order.
+//
+// A peer that owes acks but has nothing to say sends an ack-only datagram
+// after ACK_DELAY; any datagram going its way sooner takes the acks along.
+// Ack-only datagrams are never acked themselves.
+//
+// Times are seconds on any steady clock; the channel has no socket or
+// clock of its own.
+// ---------------------------------------------------------------------------
+
+// Largest message payload, in bytes
+static constexpr size_t RELIABLE_MAX_MESSAGE = 400;
+
+class ReliableChannel {
+public:
+    // Messages in flight at once; more wait in a backlog of at most
+    // MAX_BACKLOG, beyond which Send() refuses.  Kept small: every server
+    // slot carries a channel.
+    static constexpr uint16_t WINDOW      = 64;
+    static constexpr size_t   MAX_BACKLOG = 1024;
+    static constexpr int      LOSS_GAP    = 3;
+    static constexpr double   ACK_DELAY   = 0.02;
+
+    // Wire layout: seq:16, hasAck:1, [ack:16, ackBits:32], count:8,
+    // then count × { id:16, len:9, len × byte:8 }.
+    static constexpr int HEADER_BITS  = 16 + 1 + 16 + 32 + 8;
+    static constexpr int MESSAGE_BITS = 16 + 9;
+
+    // Queue a message; false if it is empty, too large or the backlog is full.
+    bool Send(const uint8_t* data, size_t len) {
+        if (len == 0 || len > RELIABLE_MAX_MESSAGE || m_backlog.size() >= MAX_BACKLOG) return false;
+        m_backlog.emplace_back(data, data + len);
+        return true;
+    }
+
+    // True when a datagram should go out now: a message is due, or acks
+    // have waited ACK_DELAY.
+    [[nodiscard]] bool NeedsSend(double now) {
+        Admit();
+        if (m_ackOwed && now - m_ackOwedSince >= ACK_DELAY) return true;
+        for (uint16_t id = m_oldest; id != m_nextId; ++id)
+            if (Due(m_out[id % WINDOW], now)) return true;
+        return false;
+    }
+
+    // Write a datagram body: the acks, then as many due messages as fit,
+    // oldest first.  Clears the ack debt.
+    void Write(BitWriter& w, double now) {
+        Admit();
+        const uint16_t seq  = m_nextSeq++;
+        SentPacket&    sent = m_sent[seq % SENT_HISTORY];
+        sent = SentPacket{ seq, now, true, false, false, std::move(sent.messages) };
+        sent.messages.clear();
+
+        size_t room = w.BitsLeft() > HEADER_BITS ? w.BitsLeft() - HEADER_BITS : 0;
+        for (uint16_t id = m_oldest; id != m_nextId && sent.messages.size() < 255; ++id) {
+            OutMessage& m = m_out[id % WINDOW];
+            if (!Due(m, now)) continue;
+            const size_t bits = MESSAGE_BITS + m.data.size() * 8;
+            if (bits > room) break;
+            room -= bits;
+            m.sentAt = now;
+            m.sent   = true;
+            sent.messages.push_back(id);
+        }
+
+        w.Write(seq, 16);
+        w.WriteBool(m_hasRecv);
+        if (m_hasRecv) {
+            w.Write(m_recvLatest, 16);
+            w.Write(m_recvBits, 32);
+        }
+        w.Write(static_cast<uint32_t>(sent.messages.size()), 8);
+        for (uint16_t id : sent.messages) {
+            const OutMessage& m = m_out[id % WINDOW];
+            w.Write(id, 16);
+            w.Write(static_cast<uint32_t>(m.data.size()), 9);
+            for (uint8_t b : m.data) w.Write(b, 8);
+        }
+        // An ack-only datagram expects no ack and can never be reported lost
+        if (sent.messages.empty()) sent.live = false;
+        m_ackOwed = false;
+    }
+
+    // Read a datagram body; deliver(data, len) for every message that is
+    // next in order, including held ones it releases.  False if malformed,
+    // and then the datagram is neither acked nor taken in part: its sender
+    // would drop messages we never stored, and the stream would wait on them.
+    template <typename Fn>
+    bool Read(BitReader& r, double now, Fn&& deliver) {
+        const uint16_t seq     = static_cast<uint16_t>(r.Read(16));
+        const bool     hasAck  = r.ReadBool();
+        const uint16_t ack     = hasAck ? static_cast<uint16_t>(r.Read(16)) : 0;
+        const uint32_t ackBits = hasAck ? r.Read(32) : 0;
+        const uint32_t count   = r.Read(8);
+        if (r.Overflowed() || !MessagesWhole(r, count)) return false;
+
+        if (hasAck) ProcessAcks(ack, ackBits, now);
+
+        MarkReceived(seq);
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint16_t id  = static_cast<uint16_t>(r.Read(16));
+            const uint32_t len = r.Read(9);
+            const uint16_t ahead = static_cast<uint16_t>(id - m_nextDeliver);
+            InMessage*     slot  = ahead < WINDOW ? &m_in[id % WINDOW] : nullptr;
+            const bool     keep  = slot && !(slot->held && slot->id == id);
+            if (keep) slot->data.resize(len);
+            for (uint32_t b = 0; b < len; ++b) {
+                const uint8_t byte = static_cast<uint8_t>(r.Read(8));
+                if (keep) slot->data[b] = byte;
+            }
+            if (keep) { slot->id = id; slot->held = true; }
+        }
+        // Packets with messages are acked; duplicates too, the first ack may be lost
+        if (count > 0 && !m_ackOwed) {
+            m_ackOwed      = true;
+            m_ackOwedSince = now;
+        }
+
+        for (InMessage* m = &m_in[m_nextDeliver % WINDOW]; m->held && m->id == m_nextDeliver;
+             m = &m_in[m_nextDeliver % WINDOW]) {
+            m->held = false;
+            ++m_nextDeliver;
+            deliver(m->data.data(), m->data.size());
+        }
+        return true;
+    }
+
+    // Smoothed round trip from acked packets, seconds; 0 until the first.
+    [[nodiscard]] double Rtt() const { return m_rtt; }
+    // Messages sent or queued but not yet acked.
+    [[nodiscard]] size_t Unacked() const {
+        return static_cast<uint16_t>(m_nextId - m_oldest) + m_backlog.size();
+    }
+
+    void Reset() { *this = ReliableChannel{}; }
+
+private:
+    // Acks reach 33 packets back; older packets only time out
+    static constexpr uint16_t SENT_HISTORY = 64;
+
+    struct OutMessage {
+        std::vector<uint8_t> data;
+        double sentAt = 0.0;
+        bool   sent   = false;
+        bool   acked  = false;
+    };
+    struct InMessage {
+        std::vector<uint8_t> data;
+        uint16_t id   = 0;
+        bool     held = false;
+    };
+    struct SentPacket {
+        uint16_t seq   = 0;
+        double   time  = 0.0;
+        bool     live  = false;   // awaiting an ack or a loss report
+        bool     acked = false;
+        bool     lost  = false;
+        std::vector<uint16_t> messages;
+    };
+
+    // Move backlog into the window while it has room.
+    void Admit() {
+        while (!m_backlog.empty() && static_cast<uint16_t>(m_nextId - m_oldest) < WINDOW) {
+            OutMessage& m = m_out[m_nextId % WINDOW];
+            m.data  = std::move(m_backlog.front());
+            m.sent  = false;
+            m.acked = false;
+            m_backlog.pop_front();
+            ++m_nextId;
+        }
+    }
+
+    double ResendDelay() const {
+        return m_rtt > 0.0 ? std::clamp(m_rtt * 1.5, 0.05, 1.0) : 0.2;
+    }
+
+    bool Due(const OutMessage& m, double now) const {
+        return !m.acked && (!m.sent || now - m.sentAt >= ResendDelay());
+    }
+
+    void ProcessAcks(uint16_t ack, uint32_t ackBits, double now) {
+        // Only acks newer than the last change anything
+        if (m_hasPeerAck && static_cast<int16_t>(ack - m_peerAck) < 0) return;
+        m_peerAck    = ack;
+        m_hasPeerAck = true;
+        for (int i = 0; i <= 32; ++i) {
+            const uint16_t seq   = static_cast<uint16_t>(ack - i);
+            SentPacket&    p     = m_sent[seq % SENT_HISTORY];
+            if (!p.live || p.seq != seq) continue;
+            const bool     gotIt = i == 0 || (ackBits >> (i - 1)) & 1u;
+            if (gotIt) {
+                p.live  = false;
+                p.acked = true;
+                const double sample = now - p.time;
+                m_rtt = m_rtt > 0.0 ? m_rtt + (sample - m_rtt) * 0.125 : sample;
+                for (uint16_t id : p.messages) {
+                    OutMessage& m = m_out[id % WINDOW];
+                    if (static_cast<uint16_t>(id - m_oldest) < static_cast<uint16_t>(m_nextId - m_oldest))
+                        m.acked = true;
+                }
+            } else if (i >= LOSS_GAP && !p.lost) {
+                // Later packets got through and this one did not: resend now
+                p.lost = true;
+                for (uint16_t id : p.messages) {
+                    OutMessage& m = m_out[id % WINDOW];
+                    if (static_cast<uint16_t>(id - m_oldest) < static_cast<uint16_t>(m_nextId - m_oldest))
+                        m.sent = false;
+                }
+            }
+        }
+        while (m_oldest != m_nextId && m_out[m_oldest % WINDOW].acked) {
+            m_out[m_oldest % WINDOW].data.clear();
+            ++m_oldest;
+        }
+    }
+
+    // Whether `count` messages of legal length follow, read from a copy of
+    // the reader so `r` is left where it was.
+    static bool MessagesWhole(const BitReader& r, uint32_t count) {
+        BitReader probe = r;
+        for (uint32_t i = 0; i < count; ++i) {
+            probe.Read(16);
+            const uint32_t len = probe.Read(9);
+            if (probe.Overflowed() || len == 0 || len > RELIABLE_MAX_MESSAGE) return false;
+            for (uint32_t b = 0; b < len; ++b) probe.Read(8);
+        }
+        return !probe.Overflowed();
+    }
+
+    // Note packet `seq` for the acks we send.
+    void MarkReceived(uint16_t seq) {
+        if (!m_hasRecv) {
+            m_recvLatest = seq;
+            m_recvBits   = 0;
+            m_hasRecv    = true;
+            return;
+        }
+        const int16_t diff = static_cast<int16_t>(seq - m_recvLatest);
+        if (diff > 0) {
+            m_recvBits = diff >= 32 ? 0 : (m_recvBits << diff);
+            if (diff <= 32) m_recvBits |= 1u << (diff - 1);
+            m_recvLatest = seq;
+        } else if (diff < 0 && diff >= -32) {
+            m_recvBits |= 1u << (-diff - 1);
+        }
+    }
+
+    // Sending
+    std::deque<std::vector<uint8_t>>    m_backlog;
+    std::array<OutMessage, WINDOW>      m_out{};
+    std::array<SentPacket, SENT_HISTORY> m_sent{};
+    uint16_t m_oldest  = 0;   // oldest unacked message id
+    uint16_t m_nextId  = 0;
+    uint16_t m_nextSeq = 0;
+    uint16_t m_peerAck = 0;
+    bool     m_hasPeerAck = false;
+    double   m_rtt     = 0.0;
+
+    // Receiving
+    std::array<InMessage, WINDOW> m_in{};
+    uint16_t m_nextDeliver  = 0;
+    uint16_t m_recvLatest   = 0;
+    uint32_t m_recvBits     = 0;
+    bool     m_hasRecv      = false;
+    bool     m_ackOwed      = false;
+    double   m_ackOwedSince = 0.0;
+};
+
+} // namespace Hotones::Net
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Hotones::Net {
+
+// ---------------------------------------------------------------------------
+// SendBudget — how fast the server may send to one client.
+//
+// A token bucket refilled at Rate() bytes per second and holding a couple of
+// snapshot ticks' worth.  Every datagram to the client is Spend()t,
+// whatever it carries; each snapshot tick then fills what is Available()
+// with the most overdue states and leaves the rest for later ticks.  A
+// client on a thin link gets fewer, fresher updates instead of a queue
+// that grows until something on the path drops it.
+//
+// The rate is found the way TCP finds its window: additive-ish increase,
+// multiplicative decrease, driven by the answer to each keepalive PING.
+// A lost PING, or a round trip well above the best one seen (a queue
+// building somewhere on the path), cuts it by DECREASE.  A clean answer
+// while the client was using at least BUSY_SHARE of its rate raises it by
+// an eighth.  An idle client's rate does not grow, so it cannot later
+// burst on credit the link never proved.
+// ---------------------------------------------------------------------------
+class SendBudget {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Limits {
+        float minRate   = 16.f * 1024.f;     // bytes/s; never cut below
+        float startRate = 64.f * 1024.f;     // until the first round trips
+        float maxRate   = 1024.f * 1024.f;   // never raised above; 0 = no budget
+    };
+
+    static constexpr float BURST_SECONDS = 0.1f;   // bucket depth at least this much of Rate()
+    static constexpr float DECREASE      = 0.75f;
+    static constexpr float BUSY_SHARE    = 0.5f;
+    static constexpr float QUEUED_RTT    = 2.f;    // × best round trip, plus QUEUED_SLACK_MS, is congestion
+    static constexpr float QUEUED_SLACK_MS = 20.f;
+
+    void Reset(const Limits& limits, Clock::time_point now) {
+        m_limits   = limits;
+        m_rate     = std::clamp(limits.startRate, limits.minRate, std::max(limits.minRate, limits.maxRate));
+        m_tokens   = m_rate * BURST_SECONDS;
+        m_spent    = 0.f;
+        m_bestRtt  = 0.f;
+        m_refilled = m_window = now;
+    }
+
+    [[nodiscard]] bool Enabled() const { return m_limits.maxRate > 0.f; }
+
+    // Add what accrued since the last call; the bucket holds the larger of
+    // BURST_SECONDS and two calls' worth, so a slow snapshot rate can still
+    // fill a tick
+    void Refill(Clock::time_point now) {
+        const float seconds = std::chrono::duration<float>(now - m_refilled).count();
+        m_refilled = now;
+        if (seconds <= 0.f) return;
+        const float depth = m_rate * std::max(BURST_SECONDS, 2.f * seconds);
+        m_tokens = std::min(m_tokens + m_rate * seconds, depth);
+    }
+
+    void Spend(size_t bytes) {
+        m_tokens -= static_cast<float>(bytes);
+        m_spent  += static_cast<float>(bytes);
+    }
+
+    // Bytes that may go out now; negative after an overdraft
+    [[nodiscard]] float Available() const { return Enabled() ? m_tokens : 1e30f; }
+    [[nodiscard]] float Rate()      const { return Enabled() ? m_rate : 0.f; }
+
+    // A PING was answered after rttMs, `missed` earlier ones never were
+    void OnRoundTrip(float rttMs, uint32_t missed, Clock::time_point now) {
+        if (!Enabled()) return;
+        if (m_bestRtt <= 0.f || rttMs < m_bestRtt) m_bestRtt = rttMs;
+        else m_bestRtt += (rttMs - m_bestRtt) * 0.01f;   // the path may have changed
+        const float seconds = std::chrono::duration<float>(now - m_window).count();
+        const bool  busy    = seconds > 0.f && m_spent >= m_rate * seconds * BUSY_SHARE;
+        m_window = now;
+        m_spent  = 0.f;
+
+        if (missed > 0 || rttMs > m_bestRtt * QUEUED_RTT + QUEUED_SLACK_MS)
+            m_rate = std::max(m_rate * DECREASE, m_limits.minRate);
+        else if (busy)
+            m_rate = std::min(m_rate + std::max(m_rate * 0.125f, m_limits.minRate * 0.25f), m_limits.maxRate);
+    }
+
+private:
+    Limits            m_limits;
+    float             m_rate    = 0.f;
+    float             m_tokens  = 0.f;
+    float             m_spent   = 0.f;   // since the last round trip
+    float             m_bestRtt = 0.f;   // ms
+    Clock::time_point m_refilled {};
+    Clock::time_point m_window   {};
+};
+
+} // namespace Hotones::Net
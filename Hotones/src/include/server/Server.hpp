@@ -1,4 +1,8 @@
 #pragma once
+#include <server/BotSwarm.hpp>
+#include <server/LinkConditioner.hpp>
+#include <server/MetricsExporter.hpp>
+#include <server/NetworkManager.hpp>
 #include <cstdint>
 #include <string>
 
@@ -10,7 +14,47 @@ namespace Hotones {
 // port    – UDP port to listen on (default 27015)
 // pakPath – path to a .cup archive or an extracted directory; if non-empty
 //           the pack's Lua :Update() is called every server tick.
-void RunHeadlessServer(uint16_t           port    = 27015,
-                       const std::string& pakPath = {});
+// maxPlayers – client slots (default 16, at most 1023)
+// tickRate – server ticks per second (default 100); overruns are logged
+// link    – simulated network conditions for testing (default: none)
+// bots    – load test: this many simulated players join from inside the
+//           process, and tick time and bandwidth are printed every second
+// master  – master list to announce the server to (empty host: none)
+// metrics – statsd collector for tick, player, traffic, Lua, memory and
+//           physics gauges, sent every second (empty host: none)
+void RunHeadlessServer(uint16_t                  port       = 27015,
+                       const std::string&        pakPath    = {},
+                       uint16_t                  maxPlayers = 16,
+                       int                       tickRate   = 100,
+                       const Net::LinkConditions& link      = {},
+                       const Net::BotOptions&    bots       = {},
+                       const Net::ServerEndpoint& master    = { {}, 0 },
+                       const Net::MetricsOptions& metrics   = {});
+
+// Host `matches` independent matches in this process, on UDP ports port
+// to port + matches - 1.  Each has its own socket and Lua state; the pack is
+// opened (extracted) once for all of them.  `threads` workers (0 = one per
+// core, never more than matches) tick them, match i on worker i % threads.
+// With metrics, each match's gauges are named "match<i>." and each worker's
+// tick times "worker<n>.".  Blocks until SIGINT / SIGTERM.
+void RunMatchServer(uint16_t                  port,
+                    const std::string&        pakPath,
+                    uint16_t                  maxPlayers,
+                    int                       tickRate,
+                    int                       matches,
+                    int                       threads = 0,
+                    const Net::LinkConditions& link   = {},
+                    const Net::ServerEndpoint& master = { {}, 0 },
+                    const Net::MetricsOptions& metrics = {});
+
+// Run a master server list on `port`: servers started with a master
+// announce themselves to it, and browsers fetch the list from it instead
+// of probing every server.  Blocks until SIGINT / SIGTERM.
+void RunMasterServer(uint16_t port = Net::DEFAULT_MASTER_PORT);
+
+// Load test a server elsewhere: run bots.count simulated players against
+// host:port, printing their traffic every second.  Blocks until SIGINT /
+// SIGTERM.
+void RunBotClients(const std::string& host, uint16_t port, const Net::BotOptions& bots);
 
 } // namespace Hotones
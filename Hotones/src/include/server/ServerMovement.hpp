@@ -0,0 +1,48 @@
+#pragma once
+
+#include <GFX/Player.hpp>
+#include <server/NetworkManager.hpp>
+
+#include <memory>
+#include <unordered_map>
+
+namespace Hotones {
+
+class CollidableModel;
+
+// ---------------------------------------------------------------------------
+// ServerMovement — the server half of client prediction.
+//
+// Keeps a Player::Body per client the server moves and steps it with
+// Player::StepBody for every input command NetworkManager hands over, then
+// reports the result back with SetPlayerBody().  A body starts from where
+// the client last said it was.
+//
+// Simulating needs the same collision the clients walk on, so the owner
+// passes the level in with SetWorld() and enables the simulation once it is
+// loaded; until then inputs are ignored and clients keep reporting their own
+// position.  Movement rules that a pack can change (Source bhop) are copied
+// from the host's player, which runs the same pack.
+// ---------------------------------------------------------------------------
+class ServerMovement {
+public:
+    // Take over nm.OnPlayerInput and offer server movement to joiners.
+    void Attach(Net::NetworkManager& nm);
+
+    void SetWorld(std::shared_ptr<CollidableModel> world) { m_world = std::move(world); }
+    void SetSourceBhop(bool enabled) { m_sourceBhop = enabled; }
+    void SetEnabled(bool enabled) { m_enabled = enabled; }
+    bool IsEnabled() const { return m_enabled; }
+
+    void Clear() { m_bodies.clear(); }
+
+private:
+    void Step(Net::NetworkManager& nm, Net::PlayerId id, const Net::InputCommand& cmd);
+
+    std::shared_ptr<CollidableModel>                m_world;
+    bool                                            m_enabled    = false;
+    bool                                            m_sourceBhop = false;
+    std::unordered_map<Net::PlayerId, Player::Body> m_bodies;
+};
+
+} // namespace Hotones
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <server/BitStream.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace Hotones::Net {
+
+// ---------------------------------------------------------------------------
+// Compressed player snapshots (PacketType::PLAYER_STATE).
+//
+// A pose is quantized before it is sent: positions to a grid (1/64 m by
+// default, set by the server and carried in ConnectAckPacket) and yaw/pitch
+// to 16-bit fractions of a turn.  Each state is then written as a delta
+// against the newest state the receiver has acknowledged; with no usable
+// baseline it is written against the zero state (a keyframe).  Unchanged
+// fields cost one bit, so an idle player costs a handful of bytes and,
+// once acknowledged, nothing at all.
+//
+// One StateSender / StateReceiver pair exists per (peer, subject player)
+// stream.  Sequence numbers are 8-bit and wrap; the last HISTORY states are
+// kept on both ends so any baseline the sender picks is still present on
+// the receiver.
+// ---------------------------------------------------------------------------
+
+static constexpr float DEFAULT_POSITION_GRID = 1.f / 64.f;
+
+struct QuantizedState {
+    int32_t  x = 0, y = 0, z = 0;   // grid cells
+    uint16_t yaw = 0, pitch = 0;    // 65536 = one turn
+
+    bool operator==(const QuantizedState&) const = default;
+};
+
+inline QuantizedState Quantize(float px, float py, float pz, float rotX, float rotY, float grid) {
+    // ±2^29 cells keeps every delta inside a 32-bit zigzag
+    constexpr float LIMIT = 536870911.f;
+    auto cell = [grid](float v) {
+        return (int32_t)std::lround(std::fmax(-LIMIT, std::fmin(LIMIT, v / grid)));
+    };
+    auto turn = [](float radians) {
+        constexpr float TAU = 6.28318530718f;
+        return (uint16_t)(int32_t)std::lround(radians / TAU * 65536.f);
+    };
+    return { cell(px), cell(py), cell(pz), turn(rotX), turn(rotY) };
+}
+
+inline float GridToPosition(int32_t cells, float grid) { return (float)cells * grid; }
+
+// Back to radians in [-pi, pi).
+inline float TurnToRadians(uint16_t turn) {
+    return (float)(int16_t)turn * (6.28318530718f / 65536.f);
+}
+
+namespace Detail {
+    inline void WriteField(BitWriter& w, int32_t delta) {
+        w.WriteBool(delta != 0);
+        if (delta != 0) w.WriteVarInt(delta);
+    }
+    inline int32_t ReadField(BitReader& r) { return r.ReadBool() ? r.ReadVarInt() : 0; }
+
+    inline void WriteState(BitWriter& w, const QuantizedState& s, const QuantizedState& base) {
+        WriteField(w, s.x - base.x);
+        WriteField(w, s.y - base.y);
+        WriteField(w, s.z - base.z);
+        WriteField(w, (int16_t)(uint16_t)(s.yaw   - base.yaw));
+        WriteField(w, (int16_t)(uint16_t)(s.pitch - base.pitch));
+    }
+    inline QuantizedState ReadState(BitReader& r, const QuantizedState& base) {
+        QuantizedState s;
+        s.x     = base.x + ReadField(r);
+        s.y     = base.y + ReadField(r);
+        s.z     = base.z + ReadField(r);
+        s.yaw   = (uint16_t)(base.yaw   + ReadField(r));
+        s.pitch = (uint16_t)(base.pitch + ReadField(r));
+        return s;
+    }
+} // namespace Detail
+
+// Wire layout of one state: seq:8, keyframe:1, [seq - baseSeq:5], then five
+// fields of changed:1 [varint delta].
+static constexpr int STATE_MAX_BITS = 8 + 1 + 5 + 3 * (1 + 2 + 32) + 2 * (1 + 2 + 16);
+
+class StateSender {
+public:
+    static constexpr uint8_t HISTORY = 32;
+
+    // True while the receiver has not acknowledged exactly `s`.
+    [[nodiscard]] bool NeedsSend(const QuantizedState& s) const {
+        return !m_hasAck || (uint8_t)(m_nextSeq - m_acked) >= HISTORY
+            || !(m_history[m_acked % HISTORY] == s);
+    }
+
+    void Encode(BitWriter& w, const QuantizedState& s) {
+        const uint8_t seq   = m_nextSeq++;
+        const uint8_t delta = (uint8_t)(seq - m_acked);
+        const bool    key   = !m_hasAck || delta >= HISTORY;
+        w.Write(seq, 8);
+        w.WriteBool(key);
+        if (!key) w.Write(delta, 5);
+        Detail::WriteState(w, s, key ? QuantizedState{} : m_history[m_acked % HISTORY]);
+        m_history[seq % HISTORY] = s;
+        m_seqs[seq % HISTORY]    = seq;
+    }
+
+    // The receiver holds state `seq`; newer acks move the baseline forward.
+    void Ack(uint8_t seq) {
+        const uint8_t age = (uint8_t)(m_nextSeq - seq);
+        if (age == 0 || age >= HISTORY || m_seqs[seq % HISTORY] != seq) return;
+        if (m_hasAck && (int8_t)(seq - m_acked) <= 0) return;
+        m_acked  = seq;
+        m_hasAck = true;
+    }
+
+    void Reset() { *this = StateSender{}; }
+
+    // The receiver may have dropped its copy: send the next state whole.
+    // Unlike Reset() the sequence keeps counting, so a receiver that did
+    // keep its stream still takes the keyframe as the newest state.
+    void ForceKeyframe() { m_hasAck = false; }
+
+private:
+    std::array<QuantizedState, HISTORY> m_history{};
+    std::array<uint8_t, HISTORY>        m_seqs{};
+    uint8_t m_nextSeq = 0;
+    uint8_t m_acked   = 0;
+    bool    m_hasAck  = false;
+};
+
+class StateReceiver {
+public:
+    static constexpr uint8_t HISTORY = StateSender::HISTORY;
+
+    // Read one state.  False if its baseline is gone (or the stream is
+    // truncated); the bits are consumed either way so the next state in
+    // the packet still lines up.
+    bool Decode(BitReader& r) {
+        const uint8_t seq = (uint8_t)r.Read(8);
+        const bool    key = r.ReadBool();
+        const uint8_t back = key ? 0 : (uint8_t)r.Read(5);
+        const uint8_t base = (uint8_t)(seq - back);
+        const bool haveBase = key || (back != 0 && m_valid[base % HISTORY] && m_seqs[base % HISTORY] == base);
+        const QuantizedState s = Detail::ReadState(r, haveBase && !key ? m_history[base % HISTORY] : QuantizedState{});
+        if (!haveBase || r.Overflowed()) return false;
+        if (m_hasLatest && (int8_t)(m_latest - seq) >= (int)HISTORY / 2) return false;   // far too old
+
+        m_history[seq % HISTORY] = s;
+        m_seqs[seq % HISTORY]    = seq;
+        m_valid[seq % HISTORY]   = true;
+        if (!m_hasLatest || (int8_t)(seq - m_latest) > 0) {
+            m_latest     = seq;
+            m_hasLatest  = true;
+            m_ackPending = true;
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool                  HasLatest() const { return m_hasLatest; }
+    [[nodiscard]] const QuantizedState& Latest()    const { return m_history[m_latest % HISTORY]; }
+
+    // Sequence number to acknowledge, once per new latest state.
+    bool TakeAck(uint8_t& seq) {
+        if (!m_ackPending) return false;
+        m_ackPending = false;
+        seq = m_latest;
+        return true;
+    }
+
+    void Reset() { *this = StateReceiver{}; }
+
+private:
+    std::array<QuantizedState, HISTORY> m_history{};
+    std::array<uint8_t, HISTORY>        m_seqs{};
+    std::array<bool, HISTORY>           m_valid{};
+    uint8_t m_latest     = 0;
+    bool    m_hasLatest  = false;
+    bool    m_ackPending = false;
+};
+
+} // namespace Hotones::Net
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Hotones::Net {
+
+// ---------------------------------------------------------------------------
+// SpscRing — fixed-capacity single-producer / single-consumer queue.
+//
+// Elements live by value in a preallocated array, so neither side ever
+// allocates or locks.  The producer owns `head`, the consumer `tail`; each
+// sits on its own cache line together with a cached copy of the other
+// side's index, so the hot path reads the shared index only when the ring
+// looks full (producer) or empty (consumer).
+//
+// A push onto a full ring fails and counts an overflow instead of waiting.
+// A producer that fills elements in place instead claims free slots, writes
+// them through Claim() and makes them visible with Publish().
+//
+//   recv thread:  if (!ring.TryPush(pkt)) { /* dropped, counted */ }
+//   main thread:  while (T* p = ring.Front()) { Use(*p); ring.Pop(); }
+// ---------------------------------------------------------------------------
+template<typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    static constexpr size_t CACHE_LINE = 64;
+
+    // Producer side.  False (and one more overflow) when the ring is full.
+    bool TryPush(const T& value) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tailCache == Capacity) {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head - m_tailCache == Capacity) {
+                m_overflows.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        m_slots[head & MASK] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer side, in place: how many slots, up to `max`, are free to be
+    // written through Claim(0 .. n-1) before Publish().
+    [[nodiscard]] size_t Claimable(size_t max) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (Capacity - (head - m_tailCache) < max) m_tailCache = m_tail.load(std::memory_order_acquire);
+        return std::min(max, Capacity - (head - m_tailCache));
+    }
+
+    // Producer side: the i-th free slot, as last left by the consumer.
+    [[nodiscard]] T& Claim(size_t i) {
+        return m_slots[(m_head.load(std::memory_order_relaxed) + i) & MASK];
+    }
+
+    // Producer side: hand the first `count` claimed slots to the consumer.
+    void Publish(size_t count) {
+        m_head.store(m_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // Producer side: an element dropped without a TryPush (no room claimed).
+    void CountOverflow() { m_overflows.fetch_add(1, std::memory_order_relaxed); }
+
+    // Consumer side: the oldest element, or nullptr when empty.  It stays
+    // valid, in place, until Pop().
+    [[nodiscard]] T* Front() {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_headCache) {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail == m_headCache) return nullptr;
+        }
+        return &m_slots[tail & MASK];
+    }
+
+    // Consumer side: release the element Front() returned.
+    void Pop() {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer side: elements waiting, possibly more by the time it returns.
+    [[nodiscard]] size_t Size() const {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_relaxed);
+    }
+
+    // Pushes refused because the ring was full, since construction.
+    [[nodiscard]] uint64_t Overflows() const { return m_overflows.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    // Producer line
+    alignas(CACHE_LINE) std::atomic<size_t> m_head{0};
+    size_t                                  m_tailCache = 0;
+    std::atomic<uint64_t>                   m_overflows{0};
+    // Consumer line
+    alignas(CACHE_LINE) std::atomic<size_t> m_tail{0};
+    size_t                                  m_headCache = 0;
+
+    alignas(CACHE_LINE) std::array<T, Capacity> m_slots{};
+};
+
+} // namespace Hotones::Net
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <initializer_list>
+#include <thread>
+#include <vector>
+
+namespace Hotones::Net {
+
+// ---------------------------------------------------------------------------
+// TickScheduler — runs a loop at an exact rate.
+//
+// Tick n is due at start + n periods.  Deadlines are fixed, so time spent
+// working does not push later ticks back.  A tick that finishes late is
+// followed at once by the next.  A loop more than a whole period behind
+// skips the ticks it missed instead of bursting through them.
+//
+// Waiting sleeps in 1 ms steps while the time left is longer than a sleep
+// has recently been seen to take (a running mean plus two deviations; about
+// 1 ms on Linux, up to the 15.6 ms timer tick on Windows), then yields in a
+// loop for the rest.  Ticks therefore start within microseconds of their
+// deadline without spinning a core for the whole wait.
+//
+// Each tick's work can be split into named phases: call Mark(i) when phase
+// i ends, and it is charged the time since the tick began or the previous
+// Mark.  Last() describes the tick just finished and TakeWindow() sums every
+// tick since the previous call, for logging; its percentiles are of the
+// first MAX_WINDOW_SAMPLES ticks of the window.
+// ---------------------------------------------------------------------------
+class TickScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t MAX_PHASES         = 4;
+    static constexpr size_t MAX_WINDOW_SAMPLES = 8192;   // tick times kept for the percentiles
+
+    struct Tick {
+        double workMs = 0.0;                        // BeginTick() to EndTick()
+        std::array<double, MAX_PHASES> phaseMs{};
+        bool   overran = false;                     // work took longer than a period
+    };
+
+    struct Window {
+        int    ticks    = 0;
+        int    overruns = 0;
+        int    skipped  = 0;                        // ticks dropped to catch up
+        double avgMs    = 0.0, maxMs = 0.0;         // work per tick
+        double p50Ms    = 0.0, p95Ms = 0.0, p99Ms = 0.0;
+        double maxLateMs = 0.0;                     // worst wake-up after its deadline
+        std::array<double, MAX_PHASES> phaseAvgMs{};
+    };
+
+    TickScheduler(int rateHz, std::initializer_list<const char*> phases) {
+        m_period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / std::max(1, rateHz)));
+        m_rate = std::max(1, rateHz);
+        for (const char* name : phases)
+            if (m_phaseCount < MAX_PHASES) m_phaseNames[m_phaseCount++] = name;
+        m_next = Clock::now();
+        m_samples.reserve(std::min<size_t>(MAX_WINDOW_SAMPLES, static_cast<size_t>(m_rate) * 2));
+    }
+
+    [[nodiscard]] int    Rate()     const { return m_rate; }
+    [[nodiscard]] double PeriodMs() const { return ToMs(m_period); }
+
+    // Wait for the next deadline, then start timing the tick.
+    void BeginTick() {
+        const bool early = Clock::now() < m_next;
+        WaitUntil(m_next);
+        m_tickStart = m_mark = Clock::now();
+        // Ticks catching up after an overrun start late on purpose
+        if (early) m_window.maxLateMs = std::max(m_window.maxLateMs, ToMs(m_tickStart - m_next));
+        m_last = Tick{};
+    }
+
+    // Phase `phase` ended now.
+    void Mark(size_t phase) {
+        const auto now = Clock::now();
+        if (phase < m_phaseCount) m_last.phaseMs[phase] += ToMs(now - m_mark);
+        m_mark = now;
+    }
+
+    // The tick's work is done; true if it overran its period.
+    bool EndTick() {
+        const auto now = Clock::now();
+        m_last.workMs  = ToMs(now - m_tickStart);
+        m_last.overran = now - m_tickStart > m_period;
+
+        m_window.ticks++;
+        m_window.overruns += m_last.overran ? 1 : 0;
+        m_window.maxMs     = std::max(m_window.maxMs, m_last.workMs);
+        m_workTotal       += m_last.workMs;
+        if (m_samples.size() < MAX_WINDOW_SAMPLES) m_samples.push_back(m_last.workMs);
+        for (size_t i = 0; i < m_phaseCount; ++i) m_phaseTotal[i] += m_last.phaseMs[i];
+
+        m_next += m_period;
+        if (now - m_next > m_period) {
+            const auto behind = (now - m_next) / m_period;
+            m_window.skipped += static_cast<int>(behind);
+            m_next += behind * m_period;
+        }
+        return m_last.overran;
+    }
+
+    [[nodiscard]] const Tick& Last() const { return m_last; }
+
+    // Totals since the previous call, then start a new window.
+    Window TakeWindow() {
+        Window w = m_window;
+        if (w.ticks > 0) {
+            w.avgMs = m_workTotal / w.ticks;
+            for (size_t i = 0; i < m_phaseCount; ++i) w.phaseAvgMs[i] = m_phaseTotal[i] / w.ticks;
+        }
+        if (!m_samples.empty()) {
+            w.p50Ms = Percentile(0.50);
+            w.p95Ms = Percentile(0.95);
+            w.p99Ms = Percentile(0.99);
+        }
+        m_samples.clear();
+        m_window    = Window{};
+        m_workTotal = 0.0;
+        m_phaseTotal.fill(0.0);
+        return w;
+    }
+
+    // "net 1.20 lua 3.40" for the given per-phase times.
+    void FormatPhases(const std::array<double, MAX_PHASES>& ms, char* out, size_t size) const {
+        if (size == 0) return;
+        out[0] = '\0';
+        size_t used = 0;
+        for (size_t i = 0; i < m_phaseCount && used < size; ++i) {
+            const int n = std::snprintf(out + used, size - used, "%s%s %.2f",
+                                        i ? " " : "", m_phaseNames[i], ms[i]);
+            if (n < 0) break;
+            used += static_cast<size_t>(n);
+        }
+    }
+
+private:
+    static double ToMs(Clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    }
+
+    // Nearest-rank percentile of m_samples; reorders them
+    double Percentile(double q) {
+        const size_t rank = std::min(m_samples.size() - 1,
+                                     static_cast<size_t>(std::ceil(q * static_cast<double>(m_samples.size()))) - 1);
+        std::nth_element(m_samples.begin(), m_samples.begin() + static_cast<std::ptrdiff_t>(rank), m_samples.end());
+        return m_samples[rank];
+    }
+
+    void WaitUntil(Clock::time_point deadline) {
+        for (auto now = Clock::now(); now < deadline; now = Clock::now()) {
+            if (ToMs(deadline - now) <= m_sleepMean + 2.0 * std::sqrt(m_sleepVar)) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            const double took = ToMs(Clock::now() - now);
+            const double diff = took - m_sleepMean;
+            m_sleepMean += diff * 0.05;
+            m_sleepVar  += (diff * diff - m_sleepVar) * 0.05;
+        }
+        while (Clock::now() < deadline) std::this_thread::yield();
+    }
+
+    Clock::duration   m_period{};
+    int               m_rate = 0;
+    Clock::time_point m_next, m_tickStart, m_mark;
+
+    std::array<const char*, MAX_PHASES> m_phaseNames{};
+    size_t m_phaseCount = 0;
+
+    Tick   m_last;
+    Window m_window;
+    double m_workTotal = 0.0;
+    std::array<double, MAX_PHASES> m_phaseTotal{};
+    std::vector<double> m_samples;   // work per tick this window
+
+    // Observed length of sleep_for(1 ms)
+    double m_sleepMean = 1.0;
+    double m_sleepVar  = 0.0;
+};
+
+} // namespace Hotones::Net
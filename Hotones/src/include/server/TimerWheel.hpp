@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Hotones::Net {
+
+// ---------------------------------------------------------------------------
+// TimerWheel — hashed timing wheel for network retries and keepalives.
+//
+// Time is cut into TICK-long ticks; a timer due at tick t waits in slot
+// t % SLOTS, so scheduling is O(1) and Advance() only looks at the slots of
+// the ticks that passed.  Timers more than one revolution out simply stay
+// in their slot until their tick comes round.
+//
+// Single-threaded: the owning thread schedules, cancels and advances.
+// Callbacks run inside Advance() and may schedule further timers (that is
+// how periodic timers re-arm).
+//
+//   TimerWheel wheel;
+//   wheel.Schedule(500ms, [&] { Retry(); });
+//   poll(fds, n, wheel.MsUntilNext(now));   // sleep until the next timer
+//   wheel.Advance(Clock::now());
+// ---------------------------------------------------------------------------
+class TimerWheel {
+public:
+    using Clock    = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+
+    static constexpr std::chrono::milliseconds TICK{ 10 };
+    static constexpr size_t                    SLOTS = 256;   // one revolution = 2.56 s
+
+    explicit TimerWheel(Clock::time_point start = Clock::now()) : m_start(start) {}
+
+    // Run fn once, `delay` from now.  Returns an id for Cancel().
+    uint32_t Schedule(std::chrono::milliseconds delay, Callback fn, Clock::time_point now = Clock::now()) {
+        // Round up so a timer never fires early
+        const uint64_t due = std::max(TickAt(now) + (uint64_t)((delay + TICK - std::chrono::milliseconds(1)) / TICK),
+                                      m_current + 1);
+        const uint32_t id = m_nextId++;
+        m_slots[due % SLOTS].push_back({ id, due, std::move(fn) });
+        ++m_count;
+        return id;
+    }
+
+    // Drop a pending timer; false if it already ran or was cancelled.
+    bool Cancel(uint32_t id) {
+        for (auto& slot : m_slots)
+            for (size_t i = 0; i < slot.size(); ++i)
+                if (slot[i].id == id) {
+                    slot[i] = std::move(slot.back());
+                    slot.pop_back();
+                    --m_count;
+                    return true;
+                }
+        return false;
+    }
+
+    void Clear() {
+        for (auto& slot : m_slots) slot.clear();
+        m_count = 0;
+    }
+
+    // Run every timer due at or before `now`, in tick order.
+    void Advance(Clock::time_point now = Clock::now()) {
+        const uint64_t target = TickAt(now);
+        std::vector<Callback> due;
+        while (m_current < target && m_count > 0) {
+            // Past one revolution every slot has been seen; jump ahead
+            if (target - m_current > SLOTS) m_current = target - SLOTS;
+            ++m_current;
+            auto& slot = m_slots[m_current % SLOTS];
+            for (size_t i = 0; i < slot.size();) {
+                if (slot[i].due <= m_current) {
+                    due.push_back(std::move(slot[i].fn));
+                    slot[i] = std::move(slot.back());
+                    slot.pop_back();
+                    --m_count;
+                } else {
+                    ++i;
+                }
+            }
+            // Callbacks run after the slot is settled so they can re-arm
+            for (Callback& fn : due) fn();
+            due.clear();
+        }
+        if (m_current < target) m_current = target;
+    }
+
+    // Milliseconds until the earliest timer is due (0 if overdue), or -1
+    // with nothing scheduled: a ready-made poll() timeout.
+    [[nodiscard]] int MsUntilNext(Clock::time_point now = Clock::now()) const {
+        if (m_count == 0) return -1;
+        uint64_t next = UINT64_MAX;
+        for (const auto& slot : m_slots)
+            for (const Entry& e : slot) next = std::min(next, e.due);
+        const auto dueAt = m_start + TICK * (int64_t)next;
+        if (dueAt <= now) return 0;
+        const auto ms = std::chrono::ceil<std::chrono::milliseconds>(dueAt - now);
+        return (int)ms.count();
+    }
+
+    [[nodiscard]] size_t Pending() const { return m_count; }
+
+private:
+    struct Entry {
+        uint32_t id;
+        uint64_t due;   // tick
+        Callback fn;
+    };
+
+    uint64_t TickAt(Clock::time_point t) const {
+        if (t <= m_start) return 0;
+        return (uint64_t)((t - m_start) / TICK);
+    }
+
+    Clock::time_point                   m_start;
+    uint64_t                            m_current = 0;   // last tick Advance() processed
+    uint32_t                            m_nextId  = 1;
+    size_t                              m_count   = 0;
+    std::array<std::vector<Entry>, SLOTS> m_slots;
+};
+
+} // namespace Hotones::Net
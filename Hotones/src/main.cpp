@@ -2,7 +2,11 @@
 #include <raymath.h>
 #include <Input/Input.hpp>
 #include <GFX/Player.hpp>
+#include <GFX/DynamicResolution.hpp>
+#include <GFX/FramePipeline.hpp>
 #include <GFX/SceneManager.hpp>
+#include <GFX/RenderTargetPool.hpp>
+#include <GFX/ShaderCache.hpp>
 #include <GFX/LoadingScene.hpp>
 #include <GFX/SimpleScene.hpp>
 #include <GFX/GameScene.hpp>
@@ -11,12 +15,24 @@
 #include <imgui/imgui.h>
 #include <imgui/rlImGui.h>
 #include <SFX/AudioSystem.hpp>
+#include <Assets/AssetCache.hpp>
 #include <Assets/AssetLoader.hpp>
 #include <server/NetworkManager.hpp>
 #include <server/Server.hpp>
+#include <server/ServerMovement.hpp>
 #include <Scripting/CupLoader.hpp>
 #include <Scripting/CupPackage.hpp>
+#include <Scripting/LuaBytecode.hpp>
 #include <Physics/PhysicsSystem.hpp>
+#include <Time/FixedTimestep.hpp>
+#include <Time/FrameClock.hpp>
+#include <Profile/Profiler.hpp>
+#include <Profile/StartupReport.hpp>
+#include <Jobs/TaskGraph.hpp>
+#include <Memory/FrameArena.hpp>
+#include <Memory/MemoryTracker.hpp>
+#include <Logging/Log.hpp>
+#include <Replay/SessionLog.hpp>
 #include <PakRegistry.hpp>
 #include <GFX/BuiltInScene.hpp>
 #include <filesystem>
@@ -26,6 +42,7 @@
 #include <atomic>
 #include <mutex>
 #include <fstream>
+#include <random>
 #if defined(_WIN32)
 #include <crtdbg.h>
 #endif
@@ -42,13 +59,35 @@ static void DrawLevel(void);
 
 int main(int argc, char** argv)
 {
+    Hotones::Log::Install();   // TraceLog() output off the calling thread
+    Hotones::Profile::BeginStartup();
+
     // ── Command-line argument parsing ───────────────────────────────────────
     bool        isServer    = false;
     uint16_t    serverPort  = Hotones::Net::DEFAULT_PORT;
+    uint16_t    maxPlayers  = Hotones::Net::DEFAULT_MAX_PLAYERS;
+    int         tickRate    = 100;
+    int         matches     = 1;
+    int         matchThreads = 0;
     std::string connectHost;
     uint16_t    connectPort = Hotones::Net::DEFAULT_PORT;
     std::string playerName  = "Player";
     std::string pakPath;
+    std::string compileLuaDir;                    // --compile-lua: precompile a pack's scripts and exit
+    bool        startupReport = false;            // --startup-report: print stage timings at the first frame
+    std::string recordPath;                       // --record: log the session for --replay
+    std::string replayPath;                       // --replay: drive the session from a log, then exit
+    bool        benchmark   = false;              // --benchmark: uncapped frame rate, frame time report
+    bool        noRender    = false;              // --no-render: hidden window, nothing drawn
+    int         inputHz     = 500;                // --input-hz: device polls per second while waiting out a frame
+    bool        pipelineFrames = false;           // --pipeline: simulate the next frame while this one draws
+    bool        dynamicResolution = false;        // --dynres: scale the 3-D pass to keep the frame rate
+    Hotones::Net::LinkConditions netConditions;   // --net-* test flags
+    Hotones::Net::BotOptions     bots;            // --bots load test
+    bool        isMaster    = false;
+    bool        portGiven   = false;
+    Hotones::Net::ServerEndpoint masterServer { {}, Hotones::Net::DEFAULT_MASTER_PORT };
+    Hotones::Net::MetricsOptions metrics;         // --metrics statsd collector
 
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -56,6 +95,33 @@ int main(int argc, char** argv)
             isServer = true;
         } else if (arg == "--port" && i + 1 < argc) {
             serverPort = static_cast<uint16_t>(std::stoi(argv[++i]));
+            portGiven  = true;
+        } else if (arg == "--master") {
+            isMaster = true;
+        } else if (arg == "--master-server" && i + 1 < argc) {
+            // host or host:port
+            const std::string spec  = argv[++i];
+            const size_t      colon = spec.rfind(':');
+            masterServer.host = spec.substr(0, colon);
+            if (colon != std::string::npos)
+                masterServer.port = static_cast<uint16_t>(std::stoi(spec.substr(colon + 1)));
+        } else if (arg == "--metrics" && i + 1 < argc) {
+            // host or host:port
+            const std::string spec  = argv[++i];
+            const size_t      colon = spec.rfind(':');
+            metrics.host = spec.substr(0, colon);
+            if (colon != std::string::npos)
+                metrics.port = static_cast<uint16_t>(std::stoi(spec.substr(colon + 1)));
+        } else if (arg == "--metrics-prefix" && i + 1 < argc) {
+            metrics.prefix = argv[++i];
+        } else if (arg == "--max-players" && i + 1 < argc) {
+            maxPlayers = static_cast<uint16_t>(std::stoi(argv[++i]));
+        } else if (arg == "--tick-rate" && i + 1 < argc) {
+            tickRate = std::stoi(argv[++i]);
+        } else if (arg == "--matches" && i + 1 < argc) {
+            matches = std::stoi(argv[++i]);
+        } else if (arg == "--match-threads" && i + 1 < argc) {
+            matchThreads = std::stoi(argv[++i]);
         } else if (arg == "--connect" && i + 1 < argc) {
             connectHost = argv[++i];
         } else if (arg == "--cport" && i + 1 < argc) {
@@ -64,31 +130,90 @@ int main(int argc, char** argv)
             playerName = argv[++i];
         } else if (arg == "--pak" && i + 1 < argc) {
             pakPath = argv[++i];
+        } else if (arg == "--compile-lua" && i + 1 < argc) {
+            compileLuaDir = argv[++i];
+        } else if (arg == "--startup-report") {
+            startupReport = true;
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (arg == "--benchmark") {
+            benchmark = true;
+        } else if (arg == "--no-render") {
+            noRender = true;
+        } else if (arg == "--input-hz" && i + 1 < argc) {
+            inputHz = std::max(std::stoi(argv[++i]), 0);
+        } else if (arg == "--pipeline") {
+            pipelineFrames = true;
+        } else if (arg == "--dynres") {
+            dynamicResolution = true;
+        } else if (arg == "--net-latency" && i + 1 < argc) {
+            netConditions.latencyMs = std::stoi(argv[++i]);
+        } else if (arg == "--net-jitter" && i + 1 < argc) {
+            netConditions.jitterMs = std::stoi(argv[++i]);
+        } else if (arg == "--net-loss" && i + 1 < argc) {
+            netConditions.lossPercent = std::stof(argv[++i]);
+        } else if (arg == "--net-dup" && i + 1 < argc) {
+            netConditions.duplicatePercent = std::stof(argv[++i]);
+        } else if (arg == "--net-seed" && i + 1 < argc) {
+            netConditions.seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--bots" && i + 1 < argc) {
+            bots.count = std::stoi(argv[++i]);
+        } else if (arg == "--bot-rate" && i + 1 < argc) {
+            bots.sendHz = std::stoi(argv[++i]);
+        } else if (arg == "--bot-area" && i + 1 < argc) {
+            bots.areaRadius = std::stof(argv[++i]);
         }
     }
-    TraceLog(LOG_DEBUG, "CLI args: isServer=%d serverPort=%d connectHost=%s connectPort=%d playerName=%s pak=%s",
+    HOTONES_LOG(LOG_DEBUG, "CLI args: isServer=%d serverPort=%d connectHost=%s connectPort=%d playerName=%s pak=%s",
              isServer ? 1 : 0, (int)serverPort, connectHost.c_str(), (int)connectPort, playerName.c_str(), pakPath.c_str());
-    SetTraceLogLevel(LOG_WARNING); // Reduce raylib log spam (can be set to LOG_INFO for more details)
+    // Pack build step: needs neither a window nor the trace level below
+    if (!compileLuaDir.empty())
+        return Hotones::Scripting::CompilePackScripts(compileLuaDir) == 0 ? 0 : 1;
+    Hotones::Log::SetLevel(LOG_WARNING); // Reduce raylib log spam (can be set to LOG_INFO for more details)
 
     // Temporary startup tracing to a file to diagnose early exit/crash locations
     std::ofstream __startup_log("hotones_startup.log", std::ios::app);
     if (__startup_log) __startup_log << "args parsed\n";
     // ── Headless server mode (no window needed) ─────────────────────────────
+    if (isMaster) {
+        Hotones::RunMasterServer(portGiven ? serverPort : Hotones::Net::DEFAULT_MASTER_PORT);
+        return 0;
+    }
+    if (isServer && matches > 1) {
+        if (bots.count > 0) TraceLog(LOG_WARNING, "--bots is ignored with --matches");
+        Hotones::RunMatchServer(serverPort, pakPath, maxPlayers, tickRate, matches, matchThreads,
+                                netConditions, masterServer, metrics);
+        return 0;
+    }
     if (isServer) {
-        Hotones::RunHeadlessServer(serverPort, pakPath);
+        Hotones::RunHeadlessServer(serverPort, pakPath, maxPlayers, tickRate, netConditions, bots, masterServer,
+                                   metrics);
+        return 0;
+    }
+    // Bots against a remote server need no window either
+    if (bots.count > 0 && !connectHost.empty()) {
+        bots.link = netConditions;
+        Hotones::RunBotClients(connectHost, connectPort, bots);
         return 0;
     }
+    // A replay plays the recorded pack, unless told another
+    Hotones::Replay::SessionPlayer sessionPlayer;
+    const bool replaying = !replayPath.empty();
+    if (replaying) {
+        if (!sessionPlayer.Open(replayPath)) return 1;
+        if (pakPath.empty()) pakPath = sessionPlayer.Header().pakPath;
+        if (!recordPath.empty()) {
+            TraceLog(LOG_WARNING, "--record is ignored with --replay");
+            recordPath.clear();
+        }
+    }
     // Initialization
     //--------------------------------------------------------------------------------------
     const int screenWidth = 1280;
     const int screenHeight = 768;
 
-    InitWindow(screenWidth, screenHeight, "Habanero");
-    TraceLog(LOG_INFO, "Window initialized %dx%d", screenWidth, screenHeight);
-    // Disable raylib's default behavior of closing the window when ESC is pressed.
-    SetExitKey(KEY_NULL);
-    if (__startup_log) __startup_log << "after InitWindow\n";
-
     // Enable CRT debug heap checks on Windows to catch heap corruption early
 #if defined(_WIN32) && defined(_DEBUG)
     int dbgFlags = _CrtSetDbgFlag(_CRTDBG_REPORT_FLAG);
@@ -98,14 +223,72 @@ int main(int argc, char** argv)
     _CrtSetReportMode(_CRT_ERROR, _CRTDBG_MODE_DEBUG);
     _CrtSetReportMode(_CRT_ASSERT, _CRTDBG_MODE_DEBUG);
 #endif
-    // Initialize audio subsystem so game systems can play sounds (footsteps etc.)
-    bool audioOk = Ho_tones::InitAudioSystem();
-    TraceLog(audioOk ? LOG_INFO : LOG_WARNING, "Audio system %s", audioOk ? "initialized" : "failed to initialize");
-    if (__startup_log) __startup_log << "audioOk=" << (audioOk ? "1" : "0") << "\n";
 
-    TraceLog(LOG_INFO, "Initializing physics subsystem");
-    Hotones::Physics::InitPhysics();
-    TraceLog(LOG_INFO, "Physics subsystem initialized");
+    Hotones::Player player;
+
+    // ── Startup graph ────────────────────────────────────────────────────────
+    // Anything touching the GL context runs on this thread (AddOnCaller);
+    // the rest runs on the job system while the window comes up.
+    bool audioOk = false;
+    {
+        using Hotones::Profile::TimeStage;
+        Hotones::Jobs::TaskGraph init;
+
+        auto window = init.AddOnCaller([&] {
+            TimeStage("Window", [&] {
+                // Nothing is drawn, but scenes still load GPU resources
+                if (noRender) SetConfigFlags(FLAG_WINDOW_HIDDEN);
+                InitWindow(screenWidth, screenHeight, "Habanero");
+                TraceLog(LOG_INFO, "Window initialized %dx%d", screenWidth, screenHeight);
+                // Disable raylib's default behavior of closing the window when ESC is pressed.
+                SetExitKey(KEY_NULL);
+                HOTONES_THREAD("Main");
+            });
+            if (__startup_log) __startup_log << "after InitWindow\n";
+        });
+        auto gpu = init.AddOnCaller([&] {
+            TimeStage("Render targets", [&] {
+                // A scene transition holds two screen-sized targets (outgoing, incoming)
+                Hotones::GFX::RenderTargetPool::Get().Reserve(screenWidth, screenHeight, 2);
+                // Linked shader programs from earlier runs load instead of compiling
+                Hotones::GFX::ShaderCache::Get().SetDirectory("cache/shaders");
+                if (!Hotones::Profile::InitGpuTimers())
+                    TraceLog(LOG_INFO, "Profiler: no GL timestamp queries, GPU zones are off");
+                if (!Hotones::GFX::DynamicResolution::Get().Init())
+                    TraceLog(LOG_INFO, "DynamicResolution: no GL timestamp queries, the 3-D pass keeps its scale");
+            });
+        });
+        auto imgui = init.AddOnCaller([&] {
+            // Builds and uploads ImGui's font atlas
+            TimeStage("ImGui", [&] { rlImGuiSetup(true); });
+        });
+        init.Precede(window, gpu);
+        init.Precede(window, imgui);
+
+        // Initialize audio subsystem so game systems can play sounds (footsteps etc.)
+        auto audio = init.Add([&] {
+            TimeStage("Audio device", [&] { audioOk = Ho_tones::InitAudioSystem(); });
+            TraceLog(audioOk ? LOG_INFO : LOG_WARNING, "Audio system %s", audioOk ? "initialized" : "failed to initialize");
+        });
+        // Decodes the footstep set; needs the device up
+        auto sounds = init.Add([&] { TimeStage("Player sounds", [&] { player.RegisterSounds(); }); });
+        init.Precede(audio, sounds);
+
+        init.Add([&] {
+            TimeStage("Physics", [&] {
+                TraceLog(LOG_INFO, "Initializing physics subsystem");
+                Hotones::Physics::InitPhysics();
+                Hotones::Physics::SetBVHCacheDirectory("cache/bvh");
+                TraceLog(LOG_INFO, "Physics subsystem initialized");
+            });
+        });
+        // Scan ./paks for file-based packs so UI can list them.  Built-in C++ packs
+        // should self-register (static registration in their translation units).
+        init.Add([&] { TimeStage("Pack scan", [&] { Hotones::PakRegistry::Get().ScanPaksDir(); }); });
+
+        init.Run();
+    }
+    if (__startup_log) __startup_log << "audioOk=" << (audioOk ? "1" : "0") << "\n";
 
     // ── Cup pack state variables ─────────────────────────────────────────────
     // setupPack() (defined below near the scene manager) handles initialisation.
@@ -114,13 +297,11 @@ int main(int argc, char** argv)
     std::thread              g_packThread;
     std::atomic<bool>        g_packLoaded{false};
     std::atomic<bool>        g_packFailed{false};
-    std::atomic<bool>        g_pakExtracted{false};
+    std::atomic<bool>        g_pakOpened{false};
     std::mutex               g_packErrMutex;
     std::string              g_packError;
 
-    // Initialize player and camera
-    Hotones::Player player;
-    player.RegisterSounds();
+    // Initialize camera
     Camera camera = { 0 };
     camera.fovy = 60.0f;
     camera.projection = CAMERA_PERSPECTIVE;
@@ -132,17 +313,57 @@ int main(int argc, char** argv)
     };
 
     player.AttachCamera(&camera);
-    TraceLog(LOG_DEBUG, "Player and camera initialized; camera pos=(%.2f,%.2f,%.2f)",
+    HOTONES_LOG(LOG_DEBUG, "Player and camera initialized; camera pos=(%.2f,%.2f,%.2f)",
              camera.position.x, camera.position.y, camera.position.z);
 
     // ── Network manager (declared BEFORE scene manager so menu can use it) ──
     Hotones::Net::NetworkManager netMgr;
-    if (!connectHost.empty()) {
-        netMgr.Connect(connectHost, connectPort, playerName);
+    // Host only: simulates joined players' movement on the current level
+    Hotones::ServerMovement serverMovement;
+    // network.send() messages go to whichever pack is loaded
+    netMgr.OnReliableMessage = [&g_script](Hotones::Net::PlayerId from, const uint8_t* data, size_t len) {
+        if (g_script) g_script->fireMessage(from, data, len);
+    };
+    netMgr.SetLinkConditions(netConditions);
+    // A replay's network is the recorded datagrams, fed in by sessionPlayer
+    Hotones::Replay::SessionRecorder sessionRecorder;
+    if (replaying) {
+        const auto mode = sessionPlayer.Header().netMode;
+        if (mode == Hotones::Net::NetworkManager::Mode::Server || mode == Hotones::Net::NetworkManager::Mode::Client)
+            netMgr.StartReplay(mode);
+        if (mode == Hotones::Net::NetworkManager::Mode::Server) serverMovement.Attach(netMgr);
+    } else {
+        if (!recordPath.empty() && sessionRecorder.Open(recordPath)) sessionRecorder.Attach(netMgr);
+        if (!connectHost.empty()) {
+            netMgr.Connect(connectHost, connectPort, playerName);
+        }
     }
     // Rate-limit player-update sends to ~20 Hz
     float netSendTimer = 0.f;
     static constexpr float NET_SEND_INTERVAL = 1.f / 20.f;
+    // SceneManager generation the network was last attached for
+    uint64_t netSceneGeneration = 0;
+
+    // ── Session recording / replay (Replay/SessionLog.hpp) ──────────────────
+    // Both start where the loading screen hands over to gameplay, before the
+    // pack's Init() runs; from the next frame on a replay takes each frame's
+    // time, input and datagrams from the log.
+    bool sessionStarted = false;
+    auto startSession = [&]() {
+        if (sessionStarted) return;
+        sessionStarted = true;
+        if (replaying) {
+            if (g_script) g_script->setRandomSeed(sessionPlayer.Header().seed);
+            sessionPlayer.Start(netMgr);
+            TraceLog(LOG_INFO, "Replaying %s", replayPath.c_str());
+        } else if (sessionRecorder.IsOpen()) {
+            std::random_device rd;
+            const uint64_t seed = (uint64_t)rd() << 32 | rd();
+            if (g_script) g_script->setRandomSeed(seed);
+            sessionRecorder.Anchor(pakPath, netMgr.GetMode(), seed);
+            TraceLog(LOG_INFO, "Recording to %s", recordPath.c_str());
+        }
+    };
 
     // ── setupPack — initialise async pack loading (callable at any point) ───
     // Can be called either at startup (--pak) or after the menu selects a pack.
@@ -155,7 +376,7 @@ int main(int argc, char** argv)
         }
         g_pak.reset();
         g_script.reset();
-        g_pakExtracted.store(false);
+        g_pakOpened.store(false);
         g_packLoaded.store(false);
         g_packFailed.store(false);
         {
@@ -174,21 +395,27 @@ int main(int argc, char** argv)
             g_packError = "Failed to open pack: " + pathCopy;
             g_packFailed.store(true);
         } else {
-            g_pakExtracted.store(true);
-            TraceLog(LOG_INFO, "Pack extracted: %s", pathCopy.c_str());
+            g_pakOpened.store(true);
+            TraceLog(LOG_INFO, "Pack opened: %s", pathCopy.c_str());
         }
     };
 
     // Scene manager + scenes
     Hotones::SceneManager sceneMgr;
-    sceneMgr.Add("menu",    [&netMgr](){ return std::make_unique<Hotones::MainMenuScene>(&netMgr); });
-    // Loading scene receives callbacks to display pack extraction / init progress
-    sceneMgr.Add("loading", [&g_pakExtracted, &g_packLoaded, &g_packFailed, &g_packErrMutex, &g_packError, &g_script]() {
-        auto progressCb = [&g_pakExtracted, &g_packLoaded, &g_packFailed]() -> float {
+    sceneMgr.Add("menu",    [&netMgr, &masterServer](){
+        auto menu = std::make_unique<Hotones::MainMenuScene>(&netMgr);
+        menu->SetMasterServer(masterServer);
+        return menu;
+    });
+    // Loading scene receives callbacks to display pack open / init progress
+    sceneMgr.Add("loading", [&g_pakOpened, &g_packLoaded, &g_packFailed, &g_packErrMutex, &g_packError, &g_script]() {
+        auto progressCb = [&g_pakOpened, &g_packLoaded, &g_packFailed]() -> float {
             if (g_packFailed.load()) return 0.0f;
-            if (!g_pakExtracted.load()) return 0.05f;
+            if (!g_pakOpened.load()) return 0.05f;
             if (!g_packLoaded.load()) return 0.6f;
-            return 1.0f;
+            // Collision meshes registered during load keep the bar short of full
+            const auto builds = Hotones::Physics::GetBVHBuildProgress();
+            return builds.Idle() ? 1.0f : 0.6f + 0.4f * builds.Fraction();
         };
         auto errorCb = [&g_packErrMutex, &g_packError, &g_script]() -> std::string {
             {
@@ -205,16 +432,12 @@ int main(int argc, char** argv)
     });
     sceneMgr.Add("game",    [](){ return std::make_unique<Hotones::GameScene>(); });
 
-    // Scan ./paks for file-based packs so UI can list them.  Built-in C++ packs
-    // should self-register (static registration in their translation units).
-    Hotones::PakRegistry::Get().ScanPaksDir();
-
     // When a pack was given on the command line, set it up now and register the
     // scripted scene.  If the pack comes from the menu, setupPack + scene
     // registration happen inside the menu→loading transition below.
     if (!pakPath.empty()) {
         TraceLog(LOG_INFO, "Pak requested from CLI: %s", pakPath.c_str());
-        setupPack(pakPath);
+        Hotones::Profile::TimeStage("Pack open", [&] { setupPack(pakPath); });
     }
     if (g_script) {
         Hotones::Scripting::CupLoader* rawScript = g_script.get();
@@ -222,33 +445,99 @@ int main(int argc, char** argv)
             return std::make_unique<Hotones::ScriptedScene>(rawScript);
         });
         TraceLog(LOG_INFO, "Registered scripted scene; switching to loading screen");
-        sceneMgr.SwitchTo("loading");
+        Hotones::Profile::TimeStage("First scene", [&] { sceneMgr.SwitchTo("loading"); });
+    } else if (replaying) {
+        // A session on the built-in level; the loading screen leads to it
+        Hotones::Profile::TimeStage("First scene", [&] { sceneMgr.SwitchTo("loading"); });
     } else {
         TraceLog(LOG_INFO, "No pack provided; switching to main menu");
-        sceneMgr.SwitchTo("menu");
+        Hotones::Profile::TimeStage("First scene", [&] { sceneMgr.SwitchTo("menu"); });
     }
 
     // Cursor starts enabled (menu). GameScene::Init() calls DisableCursor().
 
-    SetTargetFPS(60);       // Set our game to run at 60 frames-per-second
-    TraceLog(LOG_DEBUG, "Target FPS set to 60");
-    // Initialize rlImGui (optional system-installed integration)
-    rlImGuiSetup(true);
+    // 60 frames per second (uncapped to benchmark).  With --input-hz the
+    // loop waits out each frame itself, polling the devices as it goes.
+    const int  targetFps  = benchmark ? 0 : 60;
+    const bool paceFrames = targetFps > 0 && inputHz > 0;
+    SetTargetFPS(paceFrames ? 0 : targetFps);
+    HOTONES_LOG(LOG_DEBUG, "Target FPS set to %d (input polled at %d Hz)", targetFps, paceFrames ? inputHz : targetFps);
+
+    // --dynres: the 3-D pass renders smaller when the GPU can't keep up
+    auto& resolution = Hotones::GFX::DynamicResolution::Get();
+    {
+        Hotones::GFX::DynamicResolution::Settings settings;
+        settings.enabled = dynamicResolution && !noRender;
+        if (targetFps > 0) settings.targetMs = 1000.f / (float)targetFps;
+        resolution.SetSettings(settings);
+    }
     //--------------------------------------------------------------------------------------
     bool showDebugUI = false;
+
+    // --pipeline: scenes that support it simulate on a thread of their own
+    // while the main thread draws their last snapshot
+    Hotones::GFX::FramePipeline framePipeline;
+    if (pipelineFrames) framePipeline.Start();
+    uint64_t pipelinedGeneration = 0;             // scene generation told SetPipelined(true)
+
+    auto& frameClock = Hotones::Time::FrameClock::Get();
+    Hotones::Replay::SessionFrame replayFrame;
+    std::vector<double> replayFrameMs;            // --benchmark
+    int64_t frameStart    = Hotones::Profile::Now();
+    bool    frameReplayed = false;                // taken from the log, so timed for --benchmark
+    bool    waitPolled    = false;                // the last frame wait polled input (paceFrames)
+    // Once a frame is over, drawn or not
+    auto endFrame = [&]() {
+        if (sessionRecorder.IsOpen())
+            sessionRecorder.EndFrame(frameClock.Delta(), Hotones::Input::InputHandler::Get().Current());
+        if (frameReplayed && benchmark)
+            replayFrameMs.push_back((double)(Hotones::Profile::Now() - frameStart) / 1.0e6);
+    };
     
     TraceLog(LOG_INFO, "Entering main loop");
     if (__startup_log) __startup_log << "entering main loop\n";
     // Main game loop
     while (!WindowShouldClose())    // Detect window close button or ESC key
     {
+        // raylib measures frame time in EndDrawing(); without drawing, we do
+        const int64_t lastFrameStart = frameStart;
+        frameStart    = Hotones::Profile::Now();
+        frameReplayed = replaying && sessionStarted;
+        if (frameReplayed && !sessionPlayer.Next(replayFrame)) {
+            TraceLog(LOG_INFO, "Replay finished after %llu frames", (unsigned long long)sessionPlayer.FramesRead());
+            break;
+        }
+        HOTONES_FRAME();
+        auto& input = Hotones::Input::InputHandler::Get();
+        {
+            auto& arena = Hotones::Memory::FrameArena::Get();
+            arena.NextFrame();
+            HOTONES_COUNTER("Frame arena KB", (double)arena.GetStats().lastFrame / 1024.0);
+            auto& memory = Hotones::Memory::MemoryTracker::Get();
+            memory.NextFrame();
+            HOTONES_COUNTER("Allocations", (double)memory.GetStats().total.frameAllocs);
+        }
         // if (__startup_log) __startup_log << "main loop iter\n";
-        TraceLog(LOG_DEBUG, "Main loop iteration start — frameTime=%.6f scene=%s", GetFrameTime(), sceneMgr.GetCurrentName().c_str());
+        HOTONES_LOG(LOG_DEBUG, "Main loop iteration start — frameTime=%.6f scene=%s", GetFrameTime(), sceneMgr.GetCurrentName().c_str());
         // Update
         //----------------------------------------------------------------------------------
-        if (IsKeyPressed(KEY_F1)) {
+        // Refresh input state before scenes/scripts run so Lua can query it.
+        // A replayed frame runs on the recorded time, input and datagrams.
+        if (frameReplayed) {
+            frameClock.BeginFrame(replayFrame.dt);
+            input.Replay(replayFrame.input);
+            Hotones::Replay::SessionPlayer::Inject(netMgr, replayFrame.packets);
+        } else {
+            frameClock.BeginFrame(noRender ? (float)((double)(frameStart - lastFrameStart) / 1.0e9) : GetFrameTime());
+            // Ticks take the events polled during the frame wait at their
+            // time.  Recordings keep whole frames, so not while recording.
+            input.SetTickSampling(waitPolled && !sessionRecorder.IsOpen());
+            input.Update();
+        }
+
+        if (input.IsKeyPressed(KEY_F1)) {
             showDebugUI = !showDebugUI;
-            TraceLog(LOG_DEBUG, "F1 pressed — debug UI=%d", showDebugUI ? 1 : 0);
+            HOTONES_LOG(LOG_DEBUG, "F1 pressed — debug UI=%d", showDebugUI ? 1 : 0);
             // When opening the debug UI ensure the mouse is visible; when
             // closing restore cursor capture for gameplay scenes.
             if (showDebugUI) {
@@ -261,17 +550,68 @@ int main(int argc, char** argv)
             }
         }
 
-        // Only tick the standalone player while actually playing
-        if (sceneMgr.GetCurrentName() == "game") {
-            TraceLog(LOG_TRACE, "Player.Update() about to run");
-            player.Update();
-            TraceLog(LOG_TRACE, "Player.Update() finished");
+        // Simulation runs on the fixed-step clock: 0..N ticks this frame,
+        // independent of render rate.  Update()/Draw() then interpolate.
+        auto& simClock = Hotones::Time::FixedTimestep::Get();
+        const int simTicks = simClock.Advance(frameClock.Delta());
+        const bool playing = sceneMgr.GetCurrentName() == "game";
+        auto simulate = [&]() {
+            for (int i = 0; i < simTicks; ++i) {
+                input.BeginTick((float)(i + 1) / (float)simTicks);
+                // Only tick the standalone player while actually playing
+                if (playing) player.FixedUpdate(simClock.TickDt());
+                sceneMgr.FixedUpdate(simClock.TickDt());
+            }
+
+            if (playing) {
+                HOTONES_LOG(LOG_TRACE, "Player.Update() about to run");
+                player.Update();
+                HOTONES_LOG(LOG_TRACE, "Player.Update() finished");
+            }
+            HOTONES_LOG(LOG_TRACE, "SceneManager.Update() about to run (current=%s)", sceneMgr.GetCurrentName().c_str());
+            sceneMgr.Update();
+            HOTONES_LOG(LOG_TRACE, "SceneManager.Update() finished (current=%s)", sceneMgr.GetCurrentName().c_str());
+        };
+        // The scene's 3-D pass (if it exposes a camera), then its 2-D / HUD pass
+        auto drawScene = [&]() {
+            // Scenes that manage their own BeginMode3D inside Draw() (e.g. GameScene)
+            // return nullptr from GetCamera() and are left untouched here.
+            if (Hotones::Scene* cur = sceneMgr.GetCurrent()) {
+                if (Camera3D* cam = cur->GetCamera()) {
+                    if (resolution.Begin3D()) ClearBackground(BLACK);   // last frame's otherwise
+                    BeginMode3D(*cam);
+                        sceneMgr.Draw3D();
+                    EndMode3D();
+                    resolution.End3D();
+                }
+            }
+            // (also the full-pipeline path for scenes without GetCamera)
+            sceneMgr.Draw();
+        };
+
+        // Pipelined, the last step's snapshot is drawn while this frame's
+        // step runs on the pipeline's thread; transitions, networking and
+        // the debug UI below then run with the simulation idle, as always.
+        Hotones::Scene* const stepScene = sceneMgr.GetCurrent();
+        const bool pipelined = framePipeline.IsRunning() && !noRender
+                            && stepScene && stepScene->SupportsPipelining();
+        if (pipelined) {
+            if (pipelinedGeneration != sceneMgr.GetGeneration()) {
+                pipelinedGeneration = sceneMgr.GetGeneration();
+                stepScene->SetPipelined(true);   // captures its first snapshot
+            }
+            framePipeline.Begin(simulate);
+            HOTONES_LOG(LOG_TRACE, "BeginDrawing() about to run");
+            BeginDrawing();
+            resolution.BeginFrame();
+            drawScene();
+            framePipeline.Finish();
+            stepScene->PublishRenderState();
+            HOTONES_COUNTER("Simulation ms", framePipeline.GetStats().simMs);
+            HOTONES_COUNTER("Simulation wait ms", framePipeline.GetStats().waitMs);
+        } else {
+            simulate();
         }
-        TraceLog(LOG_TRACE, "SceneManager.Update() about to run (current=%s)", sceneMgr.GetCurrentName().c_str());
-        // Refresh input state before scenes/scripts run so Lua can query it
-        Hotones::Input::InputHandler::Get().Update();
-        sceneMgr.Update();
-        TraceLog(LOG_TRACE, "SceneManager.Update() finished (current=%s)", sceneMgr.GetCurrentName().c_str());
 
         // ── Scene transitions ────────────────────────────────────────────────
         // Menu finished → start networking then fade to loading screen
@@ -302,6 +642,7 @@ int main(int argc, char** argv)
                     }
                     TraceLog(LOG_INFO, "Starting server on port %d", serverPort);
                     netMgr.StartServer(serverPort);
+                    serverMovement.Attach(netMgr);
                 } else if (menu->GetAction() == Hotones::MainMenuScene::Action::Join) {
                     connectHost = menu->GetConnectHost();
                     connectPort = menu->GetConnectPort();
@@ -349,9 +690,10 @@ int main(int argc, char** argv)
                     TraceLog(LOG_ERROR, "%s", g_packError.c_str());
                     break; // exit game loop
                 }
-                // If the package extraction finished but Lua hasn't been
+                startSession();
+                // If the package is open but Lua hasn't been
                 // initialised/loaded yet, do it now on the main thread.
-                if (g_pakExtracted.load() && !g_packLoaded.load()) {
+                if (g_pakOpened.load() && !g_packLoaded.load()) {
                     // Perform Lua init/load on main thread
                     if (!g_script->init() || !g_script->loadPak(*g_pak)) {
                         std::lock_guard<std::mutex> lk(g_packErrMutex);
@@ -364,68 +706,71 @@ int main(int argc, char** argv)
                     TraceLog(LOG_INFO, "Pack initialised on main thread and marked loaded");
                 }
                     if (!g_packLoaded.load()) {
-                        // still extracting/initialising; keep showing loading screen
-                        TraceLog(LOG_DEBUG, "Pack still loading/extracting");
+                        // still initialising; keep showing loading screen
+                        HOTONES_LOG(LOG_DEBUG, "Pack still loading");
                     } else {
                         TraceLog(LOG_INFO, "Switching to scripted scene");
                         sceneMgr.SwitchWithTransition("scripted", 1.0f);
                     }
             } else {
+                    startSession();
                     TraceLog(LOG_INFO, "Switching to game scene");
                     sceneMgr.SwitchWithTransition("game", 1.0f);
             }
         }
 
         // ── Network tick ────────────────────────────────────────────────────
-        TraceLog(LOG_TRACE, "Network.Update() about to run");
+        HOTONES_LOG(LOG_TRACE, "Network.Update() about to run");
         netMgr.Update();
-        TraceLog(LOG_TRACE, "Network.Update() finished");
-        netSendTimer += GetFrameTime();
+        HOTONES_LOG(LOG_TRACE, "Network.Update() finished");
+        netSendTimer += frameClock.Delta();
         bool netActive = netMgr.IsConnected()
                        || netMgr.GetMode() == Hotones::Net::NetworkManager::Mode::Server;
         if (netActive && netSendTimer >= NET_SEND_INTERVAL) {
             netSendTimer = 0.f;
-            Hotones::Player* p = nullptr;
-            if (auto* gs = dynamic_cast<Hotones::GameScene*>(sceneMgr.GetCurrent()))
-                p = gs->GetPlayer();
-            else if (auto* ss = dynamic_cast<Hotones::ScriptedScene*>(sceneMgr.GetCurrent()))
-                p = ss->GetPlayer();
-            if (p) {
+            Hotones::Scene* scene = sceneMgr.GetCurrent();
+            if (Hotones::Player* p = scene ? scene->GetPlayer() : nullptr) {
                 netMgr.SendPlayerUpdate(
                     p->body.position.x, p->body.position.y, p->body.position.z,
                     p->lookRotation.x,  p->lookRotation.y
                 );
             }
         }
-        // Pass NetworkManager to GameScene / ScriptedScene every frame
+        // Pass NetworkManager to the current scene once, when it changes
         {
-            Hotones::GameScene* gs = dynamic_cast<Hotones::GameScene*>(sceneMgr.GetCurrent());
-            if (gs) gs->SetNetworkManager(&netMgr);
-            Hotones::ScriptedScene* ss = dynamic_cast<Hotones::ScriptedScene*>(sceneMgr.GetCurrent());
-            if (ss) ss->SetNetworkManager(&netMgr);
+            Hotones::Scene* scene = sceneMgr.GetCurrent();
+            if (sceneMgr.GetGeneration() != netSceneGeneration) {
+                netSceneGeneration = sceneMgr.GetGeneration();
+                if (scene) scene->SetNetworkManager(&netMgr);
+            }
+            // Server movement runs on the level the host is playing
+            std::shared_ptr<Hotones::CollidableModel> world = scene ? scene->GetWorld() : nullptr;
+            serverMovement.SetWorld(world);
+            if (Hotones::Player* p = scene ? scene->GetPlayer() : nullptr)
+                serverMovement.SetSourceBhop(p->IsSourceBhopEnabled());
+            serverMovement.SetEnabled(world != nullptr);
+        }
+        if (noRender) {
+            PollInputEvents();   // the one part of EndDrawing() the window still needs
+            input.Poll();
+            endFrame();
+            continue;
         }
         //----------------------------------------------------------------------------------
         // Draw
         //----------------------------------------------------------------------------------
-        TraceLog(LOG_TRACE, "BeginDrawing() about to run");
-        BeginDrawing();
-
-            // If the current scene exposes a camera, run the 3-D pass first.
-            // Scenes that manage their own BeginMode3D inside Draw() (e.g. GameScene)
-            // return nullptr from GetCamera() and are left untouched here.
-            if (Hotones::Scene* cur = sceneMgr.GetCurrent()) {
-                if (Camera3D* cam = cur->GetCamera()) {
-                    BeginMode3D(*cam);
-                        sceneMgr.Draw3D();
-                    EndMode3D();
-                }
-            }
-
-            // 2-D / HUD pass (also the full-pipeline path for scenes without GetCamera)
-            sceneMgr.Draw();
+        // A pipelined frame drew its scene while the simulation ran
+        if (!pipelined) {
+            HOTONES_LOG(LOG_TRACE, "BeginDrawing() about to run");
+            BeginDrawing();
+            resolution.BeginFrame();
+            drawScene();
+        }
 
             // ImGui debug overlay
             if (showDebugUI) {
+                HOTONES_ZONE("ImGui");
+                HOTONES_GPU_ZONE("ImGui");
                 rlImGuiBegin();
                 ImGui::SetNextWindowSize({520, 340}, ImGuiCond_FirstUseEver);
                 ImGui::Begin("Debug (F1 to toggle)");
@@ -447,16 +792,26 @@ int main(int argc, char** argv)
                             ImGui::SameLine();
                             if (ImGui::Button("Scripted")) sceneMgr.SwitchWithTransition("scripted", 0.5f);
                         }
+
+                        ImGui::SeparatorText("Dynamic resolution");
+                        auto settings = resolution.GetSettings();
+                        bool changed  = ImGui::Checkbox("Enabled", &settings.enabled);
+                        changed |= ImGui::SliderFloat("Target ms", &settings.targetMs, 4.f, 50.f, "%.1f");
+                        changed |= ImGui::SliderFloat("Min scale", &settings.minScale, 0.25f, 1.f, "%.2f");
+                        if (changed) resolution.SetSettings(settings);
+                        const auto& res = resolution.GetStats();
+                        if (!resolution.HasTimers())
+                            ImGui::TextDisabled("No GPU timers: the scale stays put");
+                        ImGui::Text("Scale: %.2f  (%dx%d)  GPU: %.2f ms  changes: %d", res.scale,
+                                    res.width ? res.width : GetScreenWidth(),
+                                    res.width ? res.height : GetScreenHeight(), res.gpuMs, res.changes);
                         ImGui::EndTabItem();
                     }
 
                     // ── Player ───────────────────────────────────────────────
                     if (ImGui::BeginTabItem("Player")) {
-                        Hotones::Player* p = nullptr;
-                        if (auto* gs = dynamic_cast<Hotones::GameScene*>(sceneMgr.GetCurrent()))
-                            p = gs->GetPlayer();
-                        else if (auto* ss = dynamic_cast<Hotones::ScriptedScene*>(sceneMgr.GetCurrent()))
-                            p = ss->GetPlayer();
+                        Hotones::Scene*  scene = sceneMgr.GetCurrent();
+                        Hotones::Player* p     = scene ? scene->GetPlayer() : nullptr;
 
                         if (p) {
                             Vector3 pos = p->body.position;
@@ -508,14 +863,47 @@ int main(int argc, char** argv)
                             ImGui::TextDisabled("Offline  (launch with --connect <ip> or --server)");
                         }
 
+                        if (mode != Hotones::Net::NetworkManager::Mode::None) {
+                            const Hotones::Net::NetStats stats = netMgr.GetStats();
+                            const auto& t = stats.total;
+                            ImGui::SeparatorText("Traffic");
+                            ImGui::Text("In : %6.0f pkt/s  %7.1f KB/s  (%llu pkts)",
+                                        t.packetsInPerSec, t.bytesInPerSec / 1024.f, (unsigned long long)t.packetsIn);
+                            ImGui::Text("Out: %6.0f pkt/s  %7.1f KB/s  (%llu pkts)",
+                                        t.packetsOutPerSec, t.bytesOutPerSec / 1024.f, (unsigned long long)t.packetsOut);
+                            ImGui::Text("RTT %.1f ms   Loss %.1f%%   Reliable pending %zu",
+                                        t.rttMs, t.lossPercent, t.reliablePending);
+                            ImGui::Text("Recv queue peak %zu   Overflows %llu   Send overflows %llu",
+                                        stats.recvQueuePeak, (unsigned long long)stats.recvOverflows,
+                                        (unsigned long long)stats.sendOverflows);
+                            if (mode == Hotones::Net::NetworkManager::Mode::Server && !stats.connections.empty()
+                                    && ImGui::BeginTable("##netconns", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+                                ImGui::TableSetupColumn("ID");
+                                ImGui::TableSetupColumn("RTT ms");
+                                ImGui::TableSetupColumn("Loss %");
+                                ImGui::TableSetupColumn("In KB/s");
+                                ImGui::TableSetupColumn("Out KB/s");
+                                ImGui::TableHeadersRow();
+                                for (const auto& c : stats.connections) {
+                                    ImGui::TableNextRow();
+                                    ImGui::TableNextColumn(); ImGui::Text("%d", (int)c.id);
+                                    ImGui::TableNextColumn(); ImGui::Text("%.1f", c.rttMs);
+                                    ImGui::TableNextColumn(); ImGui::Text("%.1f", c.lossPercent);
+                                    ImGui::TableNextColumn(); ImGui::Text("%.1f", c.bytesInPerSec / 1024.f);
+                                    ImGui::TableNextColumn(); ImGui::Text("%.1f", c.bytesOutPerSec / 1024.f);
+                                }
+                                ImGui::EndTable();
+                            }
+                        }
+
                         const auto& remotes = netMgr.GetRemotePlayers();
                         if (!remotes.empty()) {
                             ImGui::SeparatorText("Remote Players");
                             ImGui::BeginChild("##remoteplayers", {0, 120}, ImGuiChildFlags_Borders);
-                            for (const auto& [id, rp] : remotes) {
+                            for (const auto& rp : remotes) {
                                 if (rp.active)
                                     ImGui::Text("[%2d] %-16s  (%.1f, %.1f, %.1f)",
-                                                (int)id, rp.name, rp.posX, rp.posY, rp.posZ);
+                                                (int)rp.id, rp.name, rp.posX, rp.posY, rp.posZ);
                             }
                             ImGui::EndChild();
                         }
@@ -535,6 +923,21 @@ int main(int argc, char** argv)
                             Ho_tones::GetSoundBus().SetVolume(vol);
                         if (ImGui::Button("Stop All Sounds"))
                             Ho_tones::GetSoundBus().StopAll();
+
+                        const Ho_tones::SoundBus::MixStats mix = Ho_tones::GetSoundBus().GetMixStats();
+                        ImGui::SeparatorText("Mixer");
+                        const float load = mix.budgetMs > 0.f ? mix.lastMs / mix.budgetMs : 0.f;
+                        ImGui::Text("Mix %.3f ms  peak %.3f ms  budget %.2f ms", mix.lastMs, mix.peakMs, mix.budgetMs);
+                        ImGui::ProgressBar(Clamp(load, 0.f, 1.f), {-1, 0}, TextFormat("%.1f%% of budget", load * 100.f));
+                        ImGui::Text("Voices %d  peak %d / %d", mix.activeVoices, mix.peakVoices,
+                                    (int)Ho_tones::SoundBus::MAX_VOICES);
+                        if (mix.underruns > 0)
+                            ImGui::TextColored({1,0.4f,0.4f,1}, "Underruns %llu of %llu mixes",
+                                               (unsigned long long)mix.underruns, (unsigned long long)mix.mixes);
+                        else
+                            ImGui::Text("Underruns 0 of %llu mixes", (unsigned long long)mix.mixes);
+                        if (ImGui::Button("Reset##mixstats"))
+                            Ho_tones::GetSoundBus().ResetMixStats();
                         ImGui::EndTabItem();
                     }
 
@@ -556,6 +959,22 @@ int main(int argc, char** argv)
                             }
                             ImGui::EndTabItem();
                         }
+                        if (ImGui::BeginTabItem("Lua Profiler")) {
+                            g_script->profiler().DrawPanel();
+                            ImGui::EndTabItem();
+                        }
+                    }
+
+                    // ── Profiler ─────────────────────────────────────────────
+                    if (ImGui::BeginTabItem("Profiler")) {
+                        Hotones::Profile::DrawPanel();
+                        ImGui::EndTabItem();
+                    }
+
+                    // ── Memory ───────────────────────────────────────────────
+                    if (ImGui::BeginTabItem("Memory")) {
+                        Hotones::Memory::DrawPanel();
+                        ImGui::EndTabItem();
                     }
 
                     ImGui::EndTabBar();
@@ -565,18 +984,44 @@ int main(int argc, char** argv)
                 rlImGuiEnd();
             }
 
+        resolution.EndFrame();
         EndDrawing();
-        TraceLog(LOG_TRACE, "EndDrawing() finished");
-        TraceLog(LOG_DEBUG, "Main loop iteration end — scene=%s", sceneMgr.GetCurrentName().c_str());
+        HOTONES_LOG(LOG_TRACE, "EndDrawing() finished");
+        input.Poll();
+        endFrame();
+        if (paceFrames) {
+            // Wait out the frame.  While ImGui (which reads raylib's input
+            // itself, once a frame) is hidden, poll the devices every slice
+            // so input events carry the time they happened.
+            const bool    pollWait   = !showDebugUI;
+            const int64_t frameEndNs = frameStart + 1000000000LL / targetFps;
+            const int64_t sliceNs    = pollWait ? 1000000000LL / inputHz : frameEndNs - frameStart;
+            for (int64_t now = Hotones::Profile::Now(); now < frameEndNs; now = Hotones::Profile::Now()) {
+                WaitTime((double)std::min(sliceNs, frameEndNs - now) / 1.0e9);
+                if (pollWait) {
+                    PollInputEvents();
+                    input.Poll();
+                }
+            }
+            waitPolled = pollWait;
+        }
+        if (startupReport) {
+            Hotones::Profile::EndStartup();
+            Hotones::Profile::PrintStartupReport();
+            startupReport = false;
+        }
+        HOTONES_LOG(LOG_DEBUG, "Main loop iteration end — scene=%s", sceneMgr.GetCurrentName().c_str());
         //----------------------------------------------------------------------------------
     }
+    sessionRecorder.Close();
+    if (replaying && benchmark) Hotones::Replay::PrintFrameTimes(std::move(replayFrameMs));
     // De-Initialization
     //--------------------------------------------------------------------------------------
     // Ensure background pack loader finished before tearing down subsystems
     if (g_packThread.joinable()) {
-        TraceLog(LOG_INFO, "Waiting for pack extraction thread to finish");
+        TraceLog(LOG_INFO, "Waiting for pack thread to finish");
         g_packThread.join();
-        TraceLog(LOG_INFO, "Pack extraction thread joined");
+        TraceLog(LOG_INFO, "Pack thread joined");
     }
     TraceLog(LOG_INFO, "Shutting down physics subsystem");
     Hotones::Physics::ShutdownPhysics();
@@ -587,6 +1032,10 @@ int main(int argc, char** argv)
     TraceLog(LOG_INFO, "Audio shutdown complete");
     if (__startup_log) __startup_log << "shutdown\n";
     rlImGuiShutdown();
+    Hotones::Profile::ShutdownGpuTimers();
+    resolution.Unload();
+    Hotones::GFX::RenderTargetPool::Get().Clear();
+    Hotones::Assets::AssetCache::Get().Clear();   // what scenes let go of; held handles skip the GPU once the window closes
 
     CloseWindow();        // Close window and OpenGL context
     //--------------------------------------------------------------------------------------